@@ -25,7 +25,11 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <mutex>
+#include <type_traits>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -53,8 +57,56 @@
 
 #define MASK_3D_CACHE "3D_CACHE"
 
+// Guards the cache map and list.  Each entry has its own mutex held while it is loaded.
 static std::mutex mutex3D_cache;
 
+// The plugins and the scene graph I/O keep global state, so only one model is read from a
+// model file or a cache file at a time.
+static std::mutex mutex3D_sceneGraph;
+
+
+// ".3dm" render cache files hold the arrays of an S3DMODEL in native layout, so they can be
+// read back with a few block reads.  The header records the element sizes so that a file
+// written by a build with a different layout is ignored.
+static const char RENDER_CACHE_MAGIC[8] = { 'K', 'I', 'C', 'A', 'D', '3', 'D', 'M' };
+
+struct RENDER_CACHE_HEADER
+{
+    char     magic[8];
+    uint32_t materialSize;
+    uint32_t vec3Size;
+    uint32_t vec2Size;
+    uint32_t materialCount;
+    uint32_t meshCount;
+};
+
+enum RENDER_CACHE_ARRAYS : uint32_t
+{
+    RCA_POSITIONS = 1 << 0,
+    RCA_NORMALS   = 1 << 1,
+    RCA_TEXCOORDS = 1 << 2,
+    RCA_COLORS    = 1 << 3,
+    RCA_FACES     = 1 << 4
+};
+
+struct RENDER_CACHE_MESH
+{
+    uint32_t vertexCount;
+    uint32_t faceIdxCount;
+    uint32_t materialIdx;
+    uint32_t arrays;            // RENDER_CACHE_ARRAYS present in the file
+};
+
+
+static FILE* openCacheFile( const wxString& aFileName, bool aWrite )
+{
+#ifdef _WIN32
+    return _wfopen( aFileName.wc_str(), aWrite ? L"wb" : L"rb" );
+#else
+    return fopen( aFileName.ToUTF8(), aWrite ? "wb" : "rb" );
+#endif
+}
+
 
 static bool checkTag( const char* aTag, void* aPluginMgrPtr )
 {
@@ -81,6 +133,8 @@ public:
     std::string   pluginInfo;   // PluginName:Version string
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
+    std::mutex    mutex;        // held while the entry is loaded or its render data built
+    bool          sceneDataDeferred;    // only the render data was read from the cache dir
 
 private:
     // prohibit assignment and default copy constructor
@@ -95,6 +149,7 @@ S3D_CACHE_ENTRY::S3D_CACHE_ENTRY()
 {
     sceneData = nullptr;
     renderData = nullptr;
+    sceneDataDeferred = false;
     m_hash.Clear();
 }
 
@@ -142,7 +197,8 @@ S3D_CACHE::~S3D_CACHE()
 
 SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePath,
                              S3D_CACHE_ENTRY** aCachePtr,
-                             std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack )
+                             std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack,
+                             bool aRenderDataOnly )
 {
     if( aCachePtr )
         *aCachePtr = nullptr;
@@ -157,58 +213,86 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
         return nullptr;
     }
 
-    // check cache if file is already loaded
-    std::lock_guard<std::mutex> lock( mutex3D_cache );
+    S3D_CACHE_ENTRY*             ep = nullptr;
+    std::unique_lock<std::mutex> entryLock;
+    bool                         isNew = false;
 
-    std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
-    mi = m_CacheMap.find( full3Dpath );
-
-    if( mi != m_CacheMap.end() )
     {
-        wxFileName fname( full3Dpath );
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
 
-        if( fname.FileExists() )    // Only check if file exists. If not, it will
-        {                           // use the same model in cache.
-            bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
-            wxDateTime fmdate = fname.GetModificationTime();
+        auto mi = m_CacheMap.find( full3Dpath );
 
-            if( fmdate != mi->second->modTime )
-            {
-                HASH_128 hashSum;
-                getHash( full3Dpath, hashSum );
-                mi->second->modTime = fmdate;
+        if( mi != m_CacheMap.end() )
+        {
+            ep = mi->second;
+        }
+        else
+        {
+            ep = new S3D_CACHE_ENTRY;
+            m_CacheList.push_back( ep );
+            m_CacheMap.emplace( full3Dpath, ep );
+            isNew = true;
+
+            // Lock the new entry before it is visible to other threads, so that concurrent
+            // requests for the same file wait for this load instead of repeating it.
+            entryLock = std::unique_lock<std::mutex>( ep->mutex );
+        }
+    }
 
-                if( hashSum != mi->second->m_hash )
-                {
-                    mi->second->SetHash( hashSum );
-                    reload = true;
-                }
-            }
+    if( !isNew )
+        entryLock = std::unique_lock<std::mutex>( ep->mutex );
 
-            if( reload )
-            {
-                if( nullptr != mi->second->sceneData )
-                {
-                    S3D::DestroyNode( mi->second->sceneData );
-                    mi->second->sceneData = nullptr;
-                }
+    if( aCachePtr )
+        *aCachePtr = ep;
+
+    // a cache item does not exist; search the Filename->Cachename map
+    if( isNew )
+        return checkCache( full3Dpath, ep, aRenderDataOnly );
 
-                if( nullptr != mi->second->renderData )
-                    S3D::Destroy3DModel( &mi->second->renderData );
+    wxFileName fname( full3Dpath );
 
-                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
-                                                                mi->second->pluginInfo );
+    if( fname.FileExists() )    // Only check if file exists. If not, it will
+    {                           // use the same model in cache.
+        bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
+        wxDateTime fmdate = fname.GetModificationTime();
+
+        if( fmdate != ep->modTime )
+        {
+            HASH_128 hashSum;
+            getHash( full3Dpath, hashSum );
+            ep->modTime = fmdate;
+
+            if( hashSum != ep->m_hash )
+            {
+                ep->SetHash( hashSum );
+                reload = true;
             }
         }
 
-        if( nullptr != aCachePtr )
-            *aCachePtr = mi->second;
+        if( reload )
+        {
+            if( nullptr != ep->sceneData )
+            {
+                S3D::DestroyNode( ep->sceneData );
+                ep->sceneData = nullptr;
+            }
+
+            if( nullptr != ep->renderData )
+                S3D::Destroy3DModel( &ep->renderData );
 
-        return mi->second->sceneData;
+            std::lock_guard<std::mutex> lock( mutex3D_sceneGraph );
+            ep->sceneData = m_Plugins->Load3DModel( full3Dpath, ep->pluginInfo );
+            ep->sceneDataDeferred = false;
+        }
     }
 
-    // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    if( ep->sceneDataDeferred && !aRenderDataOnly )
+    {
+        ep->sceneDataDeferred = false;
+        return loadSceneData( full3Dpath, ep );
+    }
+
+    return ep->sceneData;
 }
 
 
@@ -219,70 +303,51 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile, const wxString& aBasePa
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem,
+                                   bool aRenderDataOnly )
 {
-    if( aCachePtr )
-        *aCachePtr = nullptr;
-
-    HASH_128    hashSum;
-    S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
+    HASH_128   hashSum;
     wxFileName fname( aFileName );
-    ep->modTime = fname.GetModificationTime();
+    aCacheItem->modTime = fname.GetModificationTime();
 
+    // just in case we can't get a hash digest (for example, on access issues)
+    // or we do not have a configured cache file directory, we keep the empty
+    // entry to prevent further attempts at loading the file
     if( !getHash( aFileName, hashSum ) || m_CacheDir.empty() )
-    {
-        // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
-        // entry to prevent further attempts at loading the file
-
-        if( m_CacheMap.emplace( aFileName, ep ).second == false )
-        {
-            wxLogTrace( MASK_3D_CACHE,
-                        wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-            m_CacheList.pop_back();
-            delete ep;
-        }
-        else
-        {
-            if( aCachePtr )
-                *aCachePtr = ep;
-        }
-
         return nullptr;
-    }
 
-    if( m_CacheMap.emplace( aFileName, ep ).second == false )
-    {
-        wxLogTrace( MASK_3D_CACHE,
-                    wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+    aCacheItem->SetHash( hashSum );
 
-        m_CacheList.pop_back();
-        delete ep;
+    // The renderers only need the tessellated meshes, which are read back as they are instead
+    // of rebuilding the scene graph and tessellating it again.
+    if( aRenderDataOnly && !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache
+            && loadRenderData( aCacheItem ) )
+    {
+        aCacheItem->sceneDataDeferred = true;
         return nullptr;
     }
 
-    if( aCachePtr )
-        *aCachePtr = ep;
+    return loadSceneData( aFileName, aCacheItem );
+}
 
-    ep->SetHash( hashSum );
 
-    wxString bname = ep->GetCacheBaseName();
+SCENEGRAPH* S3D_CACHE::loadSceneData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
+    std::lock_guard<std::mutex> lock( mutex3D_sceneGraph );
+
     if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && wxFileName::FileExists( cachename )
-        && loadCacheData( ep ) )
-        return ep->sceneData;
+        && loadCacheData( aCacheItem ) )
+        return aCacheItem->sceneData;
 
-    ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
+    aCacheItem->sceneData = m_Plugins->Load3DModel( aFileName, aCacheItem->pluginInfo );
 
-    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != ep->sceneData )
-        saveCacheData( ep );
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != aCacheItem->sceneData )
+        saveCacheData( aCacheItem );
 
-    return ep->sceneData;
+    return aCacheItem->sceneData;
 }
 
 
@@ -412,6 +477,231 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
 }
 
 
+bool S3D_CACHE::loadRenderData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    FILE* fp = openCacheFile( fname, false );
+
+    if( nullptr == fp )
+        return false;
+
+    fseek( fp, 0, SEEK_END );
+    const uint64_t fileSize = static_cast<uint64_t>( std::max( 0L, ftell( fp ) ) );
+    fseek( fp, 0, SEEK_SET );
+
+    S3DMODEL* model = nullptr;
+
+    // Array sizes are checked against the file size before allocating, so a damaged file is
+    // rejected instead of asking for huge buffers.
+    auto readArray =
+            [&]( auto*& aArray, uint64_t aCount ) -> bool
+            {
+                using ELEM = std::remove_reference_t<decltype( *aArray )>;
+
+                if( aCount == 0 || aCount * sizeof( ELEM ) > fileSize )
+                    return false;
+
+                aArray = new ELEM[aCount];
+                return fread( aArray, sizeof( ELEM ), aCount, fp ) == aCount;
+            };
+
+    auto readModel =
+            [&]() -> bool
+            {
+                RENDER_CACHE_HEADER header;
+
+                if( fread( &header, sizeof( header ), 1, fp ) != 1
+                        || memcmp( header.magic, RENDER_CACHE_MAGIC, sizeof( header.magic ) ) != 0
+                        || header.materialSize != sizeof( SMATERIAL )
+                        || header.vec3Size != sizeof( SFVEC3F )
+                        || header.vec2Size != sizeof( SFVEC2F ) )
+                {
+                    return false;
+                }
+
+                model = S3D::New3DModel();
+
+                if( !readArray( model->m_Materials, header.materialCount ) )
+                    return false;
+
+                model->m_MaterialsSize = header.materialCount;
+
+                if( header.meshCount == 0
+                        || header.meshCount * uint64_t( sizeof( RENDER_CACHE_MESH ) ) > fileSize )
+                {
+                    return false;
+                }
+
+                model->m_Meshes = new SMESH[header.meshCount];
+                model->m_MeshesSize = header.meshCount;
+
+                // Cleared first, so that a failure part way only frees what was allocated
+                for( uint32_t i = 0; i < header.meshCount; ++i )
+                    S3D::Init3DMesh( model->m_Meshes[i] );
+
+                for( uint32_t i = 0; i < header.meshCount; ++i )
+                {
+                    SMESH&            mesh = model->m_Meshes[i];
+                    RENDER_CACHE_MESH meshHeader;
+
+                    if( fread( &meshHeader, sizeof( meshHeader ), 1, fp ) != 1
+                            || meshHeader.materialIdx >= header.materialCount )
+                    {
+                        return false;
+                    }
+
+                    mesh.m_VertexSize = meshHeader.vertexCount;
+                    mesh.m_FaceIdxSize = meshHeader.faceIdxCount;
+                    mesh.m_MaterialIdx = meshHeader.materialIdx;
+
+                    if( ( meshHeader.arrays & RCA_POSITIONS )
+                            && !readArray( mesh.m_Positions, meshHeader.vertexCount ) )
+                    {
+                        return false;
+                    }
+
+                    if( ( meshHeader.arrays & RCA_NORMALS )
+                            && !readArray( mesh.m_Normals, meshHeader.vertexCount ) )
+                    {
+                        return false;
+                    }
+
+                    if( ( meshHeader.arrays & RCA_TEXCOORDS )
+                            && !readArray( mesh.m_Texcoords, meshHeader.vertexCount ) )
+                    {
+                        return false;
+                    }
+
+                    if( ( meshHeader.arrays & RCA_COLORS )
+                            && !readArray( mesh.m_Color, meshHeader.vertexCount ) )
+                    {
+                        return false;
+                    }
+
+                    if( ( meshHeader.arrays & RCA_FACES )
+                            && !readArray( mesh.m_FaceIdx, meshHeader.faceIdxCount ) )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            };
+
+    bool ok = readModel();
+
+    fclose( fp );
+
+    if( !ok )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] ignoring invalid render cache '%s'" ),
+                    fname );
+
+        S3D::Destroy3DModel( &model );
+        return false;
+    }
+
+    if( nullptr != aCacheItem->renderData )
+        S3D::Destroy3DModel( &aCacheItem->renderData );
+
+    aCacheItem->renderData = model;
+    return true;
+}
+
+
+bool S3D_CACHE::saveRenderData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    const S3DMODEL* model = aCacheItem->renderData;
+    wxString        bname = aCacheItem->GetCacheBaseName();
+
+    if( nullptr == model || bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+    FILE*    fp = openCacheFile( fname, true );
+
+    if( nullptr == fp )
+    {
+        wxLogTrace( MASK_3D_CACHE, wxT( " * [3D model] cannot open file '%s'" ), fname );
+        return false;
+    }
+
+    RENDER_CACHE_HEADER header;
+
+    memcpy( header.magic, RENDER_CACHE_MAGIC, sizeof( header.magic ) );
+    header.materialSize = sizeof( SMATERIAL );
+    header.vec3Size = sizeof( SFVEC3F );
+    header.vec2Size = sizeof( SFVEC2F );
+    header.materialCount = model->m_MaterialsSize;
+    header.meshCount = model->m_MeshesSize;
+
+    auto writeArray =
+            [&]( const auto* aArray, uint64_t aCount ) -> bool
+            {
+                return fwrite( aArray, sizeof( *aArray ), aCount, fp ) == aCount;
+            };
+
+    bool ok = fwrite( &header, sizeof( header ), 1, fp ) == 1
+              && writeArray( model->m_Materials, model->m_MaterialsSize );
+
+    for( unsigned int i = 0; ok && i < model->m_MeshesSize; ++i )
+    {
+        const SMESH&      mesh = model->m_Meshes[i];
+        RENDER_CACHE_MESH meshHeader;
+
+        meshHeader.vertexCount = mesh.m_VertexSize;
+        meshHeader.faceIdxCount = mesh.m_FaceIdxSize;
+        meshHeader.materialIdx = mesh.m_MaterialIdx;
+        meshHeader.arrays = 0;
+
+        if( mesh.m_VertexSize > 0 )
+        {
+            meshHeader.arrays |= mesh.m_Positions ? RCA_POSITIONS : 0;
+            meshHeader.arrays |= mesh.m_Normals ? RCA_NORMALS : 0;
+            meshHeader.arrays |= mesh.m_Texcoords ? RCA_TEXCOORDS : 0;
+            meshHeader.arrays |= mesh.m_Color ? RCA_COLORS : 0;
+        }
+
+        if( mesh.m_FaceIdxSize > 0 && mesh.m_FaceIdx )
+            meshHeader.arrays |= RCA_FACES;
+
+        ok = fwrite( &meshHeader, sizeof( meshHeader ), 1, fp ) == 1;
+
+        if( ok && ( meshHeader.arrays & RCA_POSITIONS ) )
+            ok = writeArray( mesh.m_Positions, mesh.m_VertexSize );
+
+        if( ok && ( meshHeader.arrays & RCA_NORMALS ) )
+            ok = writeArray( mesh.m_Normals, mesh.m_VertexSize );
+
+        if( ok && ( meshHeader.arrays & RCA_TEXCOORDS ) )
+            ok = writeArray( mesh.m_Texcoords, mesh.m_VertexSize );
+
+        if( ok && ( meshHeader.arrays & RCA_COLORS ) )
+            ok = writeArray( mesh.m_Color, mesh.m_VertexSize );
+
+        if( ok && ( meshHeader.arrays & RCA_FACES ) )
+            ok = writeArray( mesh.m_FaceIdx, mesh.m_FaceIdxSize );
+    }
+
+    if( fclose( fp ) != 0 )
+        ok = false;
+
+    if( !ok )
+        wxRemoveFile( fname );
+
+    return ok;
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -552,34 +842,33 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
                                std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack )
 {
     S3D_CACHE_ENTRY* cp = nullptr;
-    SCENEGRAPH*      sp = load( aModelFileName, aBasePath, &cp, std::move( aEmbeddedFilesStack ) );
-
-    if( !sp )
-        return nullptr;
+    SCENEGRAPH*      sp = load( aModelFileName, aBasePath, &cp, std::move( aEmbeddedFilesStack ),
+                                true );
 
     if( !cp )
-    {
-        wxLogTrace( MASK_3D_CACHE,
-                    wxT( "%s:%s:%d\n  * [BUG] model loaded with no associated S3D_CACHE_ENTRY" ),
-                    __FILE__, __FUNCTION__, __LINE__ );
-
         return nullptr;
-    }
+
+    std::lock_guard<std::mutex> lock( cp->mutex );
 
     if( cp->renderData )
         return cp->renderData;
 
+    if( !sp )
+        return nullptr;
+
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( nullptr != mp && !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache )
+        saveRenderData( cp );
+
     return mp;
 }
 
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
-    wxString      fileSpec = wxT( "*.3dc" );
-    wxArrayString fileList; // Holds list of ".3dc" files found in cache directory
+    wxArrayString fileList; // Holds list of ".3dc" and ".3dm" files found in cache directory
     size_t        numFilesFound = 0;
 
     wxFileName thisFile;
@@ -595,8 +884,10 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
     {
         thisFile.SetPath( m_CacheDir ); // Set the base path to the cache folder
 
-        // Get a list of all the ".3dc" files in the cache directory
-        numFilesFound = dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        // Get a list of all the cache files in the cache directory
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dc" ) );
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dm" ) );
+        numFilesFound = fileList.GetCount();
 
         for( unsigned int i = 0; i < numFilesFound; i++ )
         {
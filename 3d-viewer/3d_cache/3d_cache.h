@@ -132,6 +132,8 @@ public:
      * @param aEmbeddedFilesStack is a stack of pointers to the embedded files lists.  They will
      *                            be searched from the bottom of the stack.
      * @return is a pointer to the render data or NULL if not available.
+     *
+     * May be called from several threads at once; each file is only loaded once.
      */
     S3DMODEL* GetModel( const wxString& aModelFileName, const wxString& aBasePath,
                         std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack );
@@ -139,24 +141,32 @@ public:
     /**
      * Delete up old cache files in cache directory.
      *
-     * Deletes ".3dc" files in the cache directory that are older than \a aNumDaysOld.
+     * Deletes ".3dc" and ".3dm" files in the cache directory that are older than
+     * \a aNumDaysOld.
      *
-     * @param aNumDaysOld is age threshold to delete ".3dc" cache files.
+     * @param aNumDaysOld is age threshold to delete cache files.
      */
     void CleanCacheDir( int aNumDaysOld );
 
 private:
     /**
-     * Find or create cache entry for file name
+     * Fill a new cache entry for file name
      *
-     * Searches the cache list for the given filename and retrieves the cache data; a cache
-     * entry is created if one does not already exist.
+     * Retrieves the scene data from the cache file directory if possible, otherwise loads it
+     * through the plugins and saves it to the cache file directory.
      *
-     * @param aFileName  is the file name (full or partial path).
-     * @param aCachePtr is an optional return address for cache entry pointer.
-     * @return SCENEGRAPH object associated with file name or NULL on error.
+     * @param aFileName  is the full path of the model file.
+     * @param aCacheItem is the new entry, locked by the caller.
+     * @param aRenderDataOnly allows reading only the render data, when it is in the cache file
+     *                        directory.  The scene data is then read when first needed.
+     * @return SCENEGRAPH object associated with file name or NULL on error or if only the
+     *         render data was read.
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = nullptr );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem,
+                            bool aRenderDataOnly );
+
+    // load scene data from a cache file or else through the plugins
+    SCENEGRAPH* loadSceneData( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
 
     /**
      * Calculate the SHA1 hash of the given file.
@@ -173,10 +183,17 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
+    // load render data (tessellated meshes) from a ".3dm" cache file
+    bool loadRenderData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a ".3dm" cache file
+    bool saveRenderData( S3D_CACHE_ENTRY* aCacheItem );
+
     // the real load function (can supply a cache entry pointer to member functions)
     SCENEGRAPH* load( const wxString& aModelFile, const wxString& aBasePath,
                       S3D_CACHE_ENTRY** aCachePtr = nullptr,
-                      std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack = {} );
+                      std::vector<const EMBEDDED_FILES*> aEmbeddedFilesStack = {},
+                      bool aRenderDataOnly = false );
 
     /// Cache entries.
     std::list< S3D_CACHE_ENTRY* > m_CacheList;
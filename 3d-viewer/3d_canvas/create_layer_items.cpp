@@ -33,11 +33,11 @@
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
 #include <vector>
-#include <thread>
 #include <algorithm>
-#include <atomic>
+#include <map>
 #include <wx/log.h>
 #include <pcb_barcode.h>
+#include <thread_pool.h>
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
 #include <core/profile.h>
@@ -305,28 +305,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Create tracks and vias" ) );
 
-    // Create tracks as objects and add it to container
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.contains( layer ) );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        for( const PCB_TRACK* track : trackList )
-        {
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( layer ) )
-                continue;
-
-            // Skip vias annulus when not flashed on this layer
-            if( track->Type() == PCB_VIA_T && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-                continue;
-
-            // Add object item to layer container
-            createTrackWithMargin( track, layerContainer, layer );
-        }
-    }
-
     // Create VIAS and THTs objects and add it to holes containers
     for( PCB_LAYER_ID layer : layer_ids )
     {
@@ -981,278 +959,267 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Add footprints copper items (pads, shapes and text) to containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.contains( layer ) );
+    if( aStatusReporter )
+        aStatusReporter->Report( _( "Create copper layers" ) );
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+    // Zones are filled layer by layer below, so sort them by layer first
+    std::map<PCB_LAYER_ID, std::vector<ZONE*>> layerZones;
 
-        for( FOOTPRINT* fp : m_board->Footprints() )
+    if( cfg.show_zones )
+    {
+        for( ZONE* zone : m_board->Zones() )
         {
-            addPads( fp, layerContainer, layer );
-            addFootprintShapes( fp, layerContainer, layer, visibilityFlags );
-
-            // Add copper item to the plated copper polygon list if required
-            if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
-            {
-                SHAPE_POLY_SET* layerPoly = layer == F_Cu ? m_frontPlatedCopperPolys : m_backPlatedCopperPolys;
-
-                fp->TransformPadsToPolySet( *layerPoly, layer, 0, fp->GetMaxError(), ERROR_INSIDE );
-                transformFPTextToPolySet( fp, layer, visibilityFlags, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
-                transformFPShapesToPolySet( fp, layer, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
-            }
-
-            // Add copper item to poly contours (vertical outlines) if required
-            if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
             {
-                wxASSERT( m_layers_poly.contains( layer ) );
+                layerZones[layer].push_back( zone );
 
-                SHAPE_POLY_SET* layerPoly = m_layers_poly[layer];
+                if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
+                {
+                    SHAPE_POLY_SET* copperPolys = layer == F_Cu ? m_frontPlatedCopperPolys : m_backPlatedCopperPolys;
 
-                fp->TransformPadsToPolySet( *layerPoly, layer, 0, fp->GetMaxError(), ERROR_INSIDE );
-                transformFPTextToPolySet( fp, layer, visibilityFlags, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
-                transformFPShapesToPolySet( fp, layer, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
+                    zone->TransformShapeToPolygon( *copperPolys, layer, 0, zone->GetMaxError(), ERROR_INSIDE );
+                }
             }
         }
     }
 
-    // Add graphic item on copper layers to object containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.contains( layer ) );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        // Add graphic items on copper layers (texts and other graphics)
-        for( BOARD_ITEM* item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+    // Add tracks, footprint copper items (pads, shapes and text), graphic items and zones to the
+    // copper layer containers.  Each task only writes its own layer's container and polygon set
+    // (F_Cu and B_Cu have separate plated copper sets), so the layers need no locking.
+    thread_pool& tp = GetKiCadThreadPool();
 
-            switch( item->Type() )
+    tp.submit_loop( 0, layer_ids.size(),
+            [&]( const int ii )
             {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item, layer );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXTBOX_T:
-                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TABLE_T:
-                addTable( static_cast<PCB_TABLE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_BARCODE_T:
-                addBarCode( static_cast<PCB_BARCODE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_REFERENCE_IMAGE_T:     // ignore
-                break;
-
-            default:
-                wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ), item->Type() );
-                break;
-            }
+                const PCB_LAYER_ID layer = layer_ids[ii];
 
-            // Add copper item to the plated copper polygon list if required
-            if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
-            {
-                SHAPE_POLY_SET* copperPolys = layer == F_Cu ? m_frontPlatedCopperPolys : m_backPlatedCopperPolys;
+                wxASSERT( m_layerMap.contains( layer ) );
 
-                // Note: for TEXT and TEXTBOX, TransformShapeToPolygon returns the bounding
-                // box shape, not the exact text shape. So it is not used for these items
-                if( item->Type() == PCB_TEXTBOX_T )
-                {
-                    PCB_TEXTBOX* text_box = static_cast<PCB_TEXTBOX*>( item );
-                    text_box->TransformTextToPolySet( *copperPolys, 0, text_box->GetMaxError(), ERROR_INSIDE );
+                BVH_CONTAINER_2D* layerContainer = m_layerMap.at( layer );
 
-                    // Add box outlines
-                    text_box->PCB_SHAPE::TransformShapeToPolygon( *copperPolys, layer, 0, text_box->GetMaxError(),
-                                                                  ERROR_INSIDE );
-                }
-                else if( item->Type() == PCB_TEXT_T )
+                // Tracks and vias
+                for( const PCB_TRACK* track : trackList )
                 {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
-                    text->TransformTextToPolySet( *copperPolys, 0, text->GetMaxError(), ERROR_INSIDE );
+                    // NOTE: Vias can be on multiple layers
+                    if( !track->IsOnLayer( layer ) )
+                        continue;
+
+                    // Skip vias annulus when not flashed on this layer
+                    if( track->Type() == PCB_VIA_T && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
+                        continue;
+
+                    // Add object item to layer container
+                    createTrackWithMargin( track, layerContainer, layer );
                 }
-                else if( item->Type() != PCB_REFERENCE_IMAGE_T )
+
+                // Footprint copper items (pads, shapes and text)
+                for( FOOTPRINT* fp : m_board->Footprints() )
                 {
-                    item->TransformShapeToPolySet( *copperPolys, layer, 0, item->GetMaxError(), ERROR_INSIDE );
-                }
-            }
+                    addPads( fp, layerContainer, layer );
+                    addFootprintShapes( fp, layerContainer, layer, visibilityFlags );
 
-            // Add copper item to poly contours (vertical outlines) if required
-            if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-            {
-                wxASSERT( m_layers_poly.contains( layer ) );
+                    // Add copper item to the plated copper polygon list if required
+                    if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
+                    {
+                        SHAPE_POLY_SET* layerPoly = layer == F_Cu ? m_frontPlatedCopperPolys : m_backPlatedCopperPolys;
 
-                SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                        fp->TransformPadsToPolySet( *layerPoly, layer, 0, fp->GetMaxError(), ERROR_INSIDE );
+                        transformFPTextToPolySet( fp, layer, visibilityFlags, *layerPoly, fp->GetMaxError(),
+                                                  ERROR_INSIDE );
+                        transformFPShapesToPolySet( fp, layer, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
+                    }
 
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolySet( *layerPoly, layer, 0, item->GetMaxError(), ERROR_INSIDE );
-                    break;
+                    // Add copper item to poly contours (vertical outlines) if required
+                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
+                    {
+                        wxASSERT( m_layers_poly.contains( layer ) );
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                        SHAPE_POLY_SET* layerPoly = m_layers_poly.at( layer );
 
-                    text->TransformTextToPolySet( *layerPoly, 0, text->GetMaxError(), ERROR_INSIDE );
-                    break;
+                        fp->TransformPadsToPolySet( *layerPoly, layer, 0, fp->GetMaxError(), ERROR_INSIDE );
+                        transformFPTextToPolySet( fp, layer, visibilityFlags, *layerPoly, fp->GetMaxError(),
+                                                  ERROR_INSIDE );
+                        transformFPShapesToPolySet( fp, layer, *layerPoly, fp->GetMaxError(), ERROR_INSIDE );
+                    }
                 }
 
-                case PCB_TEXTBOX_T:
+                // Add graphic items on copper layers (texts and other graphics)
+                for( BOARD_ITEM* item : m_board->Drawings() )
                 {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+                    if( !item->IsOnLayer( layer ) )
+                        continue;
 
-                    if( textbox->IsBorderEnabled() )
+                    switch( item->Type() )
                     {
-                        textbox->PCB_SHAPE::TransformShapeToPolygon( *layerPoly, layer, 0, textbox->GetMaxError(),
-                                                                     ERROR_INSIDE );
-                    }
+                    case PCB_SHAPE_T:
+                        addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item, layer );
+                        break;
 
-                    textbox->TransformTextToPolySet( *layerPoly, 0, textbox->GetMaxError(), ERROR_INSIDE );
-                    break;
-                }
+                    case PCB_TEXT_T:
+                        addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
+                        break;
 
-                case PCB_TABLE_T:
-                {
-                    PCB_TABLE* table = static_cast<PCB_TABLE*>( item );
+                    case PCB_TEXTBOX_T:
+                        addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        break;
 
-                    for( PCB_TABLECELL* cell : table->GetCells() )
-                        cell->TransformTextToPolySet( *layerPoly, 0, cell->GetMaxError(), ERROR_INSIDE );
+                    case PCB_TABLE_T:
+                        addTable( static_cast<PCB_TABLE*>( item ), layerContainer, item );
+                        break;
 
-                    table->DrawBorders(
-                            [&]( const VECTOR2I& ptA, const VECTOR2I& ptB,
-                                 const STROKE_PARAMS& stroke )
-                            {
-                                SHAPE_SEGMENT seg( ptA, ptB, stroke.GetWidth()  );
-                                seg.TransformToPolygon( *layerPoly, table->GetMaxError(), ERROR_INSIDE );
-                            } );
-                    break;
-                }
+                    case PCB_BARCODE_T:
+                        addBarCode( static_cast<PCB_BARCODE*>( item ), layerContainer, item );
+                        break;
 
-                case PCB_BARCODE_T:
-                {
-                    PCB_BARCODE* bar_code = static_cast<PCB_BARCODE*>( item );
+                    case PCB_DIM_ALIGNED_T:
+                    case PCB_DIM_CENTER_T:
+                    case PCB_DIM_RADIAL_T:
+                    case PCB_DIM_ORTHOGONAL_T:
+                    case PCB_DIM_LEADER_T:
+                        addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
+                        break;
 
-                    bar_code->TransformShapeToPolySet( *layerPoly, layer, 0, 0, ERROR_INSIDE );
-                    break;
-                }
+                    case PCB_REFERENCE_IMAGE_T:     // ignore
+                        break;
 
-                case PCB_DIM_ALIGNED_T:
-                case PCB_DIM_CENTER_T:
-                case PCB_DIM_RADIAL_T:
-                case PCB_DIM_ORTHOGONAL_T:
-                case PCB_DIM_LEADER_T:
-                {
-                    PCB_DIMENSION_BASE* dimension = static_cast<PCB_DIMENSION_BASE*>( item );
+                    default:
+                        wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ), item->Type() );
+                        break;
+                    }
 
-                    dimension->TransformTextToPolySet( *layerPoly, 0, dimension->GetMaxError(), ERROR_INSIDE );
+                    // Add copper item to the plated copper polygon list if required
+                    if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
+                    {
+                        SHAPE_POLY_SET* copperPolys = layer == F_Cu ? m_frontPlatedCopperPolys
+                                                                    : m_backPlatedCopperPolys;
 
-                    for( const std::shared_ptr<SHAPE>& shape : dimension->GetShapes() )
-                        shape->TransformToPolygon( *layerPoly, dimension->GetMaxError(), ERROR_INSIDE );
+                        // Note: for TEXT and TEXTBOX, TransformShapeToPolygon returns the bounding
+                        // box shape, not the exact text shape. So it is not used for these items
+                        if( item->Type() == PCB_TEXTBOX_T )
+                        {
+                            PCB_TEXTBOX* text_box = static_cast<PCB_TEXTBOX*>( item );
+                            text_box->TransformTextToPolySet( *copperPolys, 0, text_box->GetMaxError(), ERROR_INSIDE );
 
-                    break;
-                }
+                            // Add box outlines
+                            text_box->PCB_SHAPE::TransformShapeToPolygon( *copperPolys, layer, 0,
+                                                                          text_box->GetMaxError(), ERROR_INSIDE );
+                        }
+                        else if( item->Type() == PCB_TEXT_T )
+                        {
+                            PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                            text->TransformTextToPolySet( *copperPolys, 0, text->GetMaxError(), ERROR_INSIDE );
+                        }
+                        else if( item->Type() != PCB_REFERENCE_IMAGE_T )
+                        {
+                            item->TransformShapeToPolySet( *copperPolys, layer, 0, item->GetMaxError(), ERROR_INSIDE );
+                        }
+                    }
 
-                case PCB_REFERENCE_IMAGE_T:     // ignore
-                    break;
+                    // Add copper item to poly contours (vertical outlines) if required
+                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
+                    {
+                        wxASSERT( m_layers_poly.contains( layer ) );
 
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ), item->Type() );
-                    break;
-                }
-            }
-        }
-    }
+                        SHAPE_POLY_SET *layerPoly = m_layers_poly.at( layer );
 
-    if( cfg.show_zones )
-    {
-        if( aStatusReporter )
-            aStatusReporter->Report( _( "Create zones" ) );
+                        switch( item->Type() )
+                        {
+                        case PCB_SHAPE_T:
+                            item->TransformShapeToPolySet( *layerPoly, layer, 0, item->GetMaxError(), ERROR_INSIDE );
+                            break;
 
-        std::vector<std::pair<ZONE*, PCB_LAYER_ID>> zones;
-        std::unordered_map<PCB_LAYER_ID, std::unique_ptr<std::mutex>> layer_lock;
+                        case PCB_TEXT_T:
+                        {
+                            PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
 
-        for( ZONE* zone : m_board->Zones() )
-        {
-            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
-            {
-                zones.emplace_back( std::make_pair( zone, layer ) );
-                layer_lock.emplace( layer, std::make_unique<std::mutex>() );
+                            text->TransformTextToPolySet( *layerPoly, 0, text->GetMaxError(), ERROR_INSIDE );
+                            break;
+                        }
 
-                if( cfg.DifferentiatePlatedCopper() && IsExternalCopperLayer( layer ) )
-                {
-                    SHAPE_POLY_SET* copperPolys = layer == F_Cu ? m_frontPlatedCopperPolys : m_backPlatedCopperPolys;
+                        case PCB_TEXTBOX_T:
+                        {
+                            PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
 
-                    zone->TransformShapeToPolygon( *copperPolys, layer, 0, zone->GetMaxError(), ERROR_INSIDE );
-                }
-            }
-        }
+                            if( textbox->IsBorderEnabled() )
+                            {
+                                textbox->PCB_SHAPE::TransformShapeToPolygon( *layerPoly, layer, 0,
+                                                                             textbox->GetMaxError(), ERROR_INSIDE );
+                            }
 
-        // Add zones objects
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
+                            textbox->TransformTextToPolySet( *layerPoly, 0, textbox->GetMaxError(), ERROR_INSIDE );
+                            break;
+                        }
 
-        size_t parallelThreadCount = std::min<size_t>( zones.size(),
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
+                        case PCB_TABLE_T:
+                        {
+                            PCB_TABLE* table = static_cast<PCB_TABLE*>( item );
+
+                            for( PCB_TABLECELL* cell : table->GetCells() )
+                                cell->TransformTextToPolySet( *layerPoly, 0, cell->GetMaxError(), ERROR_INSIDE );
+
+                            table->DrawBorders(
+                                    [&]( const VECTOR2I& ptA, const VECTOR2I& ptB,
+                                         const STROKE_PARAMS& stroke )
+                                    {
+                                        SHAPE_SEGMENT seg( ptA, ptB, stroke.GetWidth()  );
+                                        seg.TransformToPolygon( *layerPoly, table->GetMaxError(), ERROR_INSIDE );
+                                    } );
+                            break;
+                        }
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < zones.size();
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    ZONE* zone = zones[areaId].first;
+                        case PCB_BARCODE_T:
+                        {
+                            PCB_BARCODE* bar_code = static_cast<PCB_BARCODE*>( item );
 
-                    if( zone == nullptr )
-                        break;
+                            bar_code->TransformShapeToPolySet( *layerPoly, layer, 0, 0, ERROR_INSIDE );
+                            break;
+                        }
+
+                        case PCB_DIM_ALIGNED_T:
+                        case PCB_DIM_CENTER_T:
+                        case PCB_DIM_RADIAL_T:
+                        case PCB_DIM_ORTHOGONAL_T:
+                        case PCB_DIM_LEADER_T:
+                        {
+                            PCB_DIMENSION_BASE* dimension = static_cast<PCB_DIMENSION_BASE*>( item );
 
-                    PCB_LAYER_ID layer = zones[areaId].second;
+                            dimension->TransformTextToPolySet( *layerPoly, 0, dimension->GetMaxError(), ERROR_INSIDE );
 
-                    if( m_layerMap.contains( layer ) )
-                        addSolidAreasShapes( zone, m_layerMap[layer], layer );
+                            for( const std::shared_ptr<SHAPE>& shape : dimension->GetShapes() )
+                                shape->TransformToPolygon( *layerPoly, dimension->GetMaxError(), ERROR_INSIDE );
 
-                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
-                            && m_layers_poly.contains( layer ) )
-                    {
-                        auto mut_it = layer_lock.find( layer );
+                            break;
+                        }
 
-                        if( mut_it != layer_lock.end() )
-                        {
-                            std::lock_guard< std::mutex > lock( *( mut_it->second ) );
-                            zone->TransformSolidAreasShapesToPolygon( layer, *m_layers_poly[layer] );
+                        case PCB_REFERENCE_IMAGE_T:     // ignore
+                            break;
+
+                        default:
+                            wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
+                                        item->Type() );
+                            break;
                         }
                     }
                 }
 
-                threadsFinished++;
-            } );
+                // Zones
+                auto zonesIt = layerZones.find( layer );
 
-            t.detach();
-        }
+                if( zonesIt == layerZones.end() )
+                    return;
+
+                for( ZONE* zone : zonesIt->second )
+                {
+                    addSolidAreasShapes( zone, layerContainer, layer );
+
+                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
+                            && m_layers_poly.contains( layer ) )
+                    {
+                        zone->TransformSolidAreasShapesToPolygon( layer, *m_layers_poly.at( layer ) );
+                    }
+                }
+            } ).wait();
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-    }
     // End Build Copper layers
 
     // This will make a union of all added contours
@@ -1712,38 +1679,18 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                                                            (int) selected_layer_id.size() ) );
             }
 
-            std::atomic<size_t> nextItem( 0 );
-            std::atomic<size_t> threadsFinished( 0 );
-
-            size_t parallelThreadCount = std::min<size_t>(
-                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                    selected_layer_id.size() );
+            tp.submit_loop( 0, selected_layer_id.size(),
+                    [&]( const int ii )
+                    {
+                        auto it = m_layers_poly.find( selected_layer_id[ii] );
 
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            {
-                std::thread t = std::thread(
-                        [&nextItem, &threadsFinished, &selected_layer_id, this]()
+                        if( it != m_layers_poly.end() )
                         {
-                            for( size_t i = nextItem.fetch_add( 1 );
-                                        i < selected_layer_id.size();
-                                        i = nextItem.fetch_add( 1 ) )
-                            {
-                                if( m_layers_poly.contains( selected_layer_id[i] ) )
-                                {
-                                    // This will make a union of all added contours
-                                    m_layers_poly[ selected_layer_id[i] ]->ClearArcs();
-                                    m_layers_poly[ selected_layer_id[i] ]->Simplify();
-                                }
-                            }
-
-                            threadsFinished++;
-                        } );
-
-                t.detach();
-            }
-
-            while( threadsFinished < parallelThreadCount )
-                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                            // This will make a union of all added contours
+                            it->second->ClearArcs();
+                            it->second->Simplify();
+                        }
+                    } ).wait();
         }
     }
 
@@ -1751,20 +1698,20 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Simplify holes contours" ) );
 
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        if( m_layerHoleOdPolys.contains( layer ) )
-        {
-            // found
-            SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify();
+    tp.submit_loop( 0, layer_ids.size(),
+            [&]( const int ii )
+            {
+                const PCB_LAYER_ID layer = layer_ids[ii];
 
-            wxASSERT( m_layerHoleIdPolys.contains( layer ) );
+                if( m_layerHoleOdPolys.contains( layer ) )
+                {
+                    m_layerHoleOdPolys.at( layer )->Simplify();
 
-            polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify();
-        }
-    }
+                    wxASSERT( m_layerHoleIdPolys.contains( layer ) );
+
+                    m_layerHoleIdPolys.at( layer )->Simplify();
+                }
+            } ).wait();
 
     // Build BVH (Bounding volume hierarchy) for holes and vias
 
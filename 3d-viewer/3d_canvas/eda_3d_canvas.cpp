@@ -316,6 +316,15 @@ void EDA_3D_CANVAS::ReloadRequest( BOARD* aBoard , S3D_CACHE* aCachePointer )
 }
 
 
+void EDA_3D_CANVAS::ReloadRequest( const LSET& aLayers )
+{
+    m_boardAdapter.ReloadColorSettings();
+
+    if( m_3d_render )
+        m_3d_render->ReloadRequest( aLayers );
+}
+
+
 void EDA_3D_CANVAS::RenderRaytracingRequest()
 {
     m_3d_render = m_3d_render_raytracing;
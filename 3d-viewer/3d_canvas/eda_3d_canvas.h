@@ -85,6 +85,13 @@ public:
 
     void ReloadRequest( BOARD* aBoard = nullptr, S3D_CACHE* aCachePointer = nullptr );
 
+    /**
+     * Request a reload of the scene after the board items of \a aLayers were edited.
+     *
+     * The OpenGL render only rebuilds these layers; the ray tracing render reloads everything.
+     */
+    void ReloadRequest( const LSET& aLayers );
+
     /**
      * Query if there is a pending reload request.
      *
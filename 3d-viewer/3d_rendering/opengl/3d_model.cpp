@@ -423,29 +423,7 @@ void MODEL_3D::Draw( bool aTransparent, float aOpacity, bool aUseSelectedMateria
     if( aOpacity <= FLT_EPSILON )
         return;
 
-    if( !glBindBuffer )
-        throw std::runtime_error( "The OpenGL context no longer exists: unable to draw" );
-
-    glBindBuffer( GL_ARRAY_BUFFER, m_vertex_buffer );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_index_buffer );
-
-    glVertexPointer( 3, GL_FLOAT, sizeof( VERTEX ),
-                     reinterpret_cast<const void*>( offsetof( VERTEX, m_pos ) ) );
-
-    glNormalPointer( GL_BYTE, sizeof( VERTEX ),
-                     reinterpret_cast<const void*>( offsetof( VERTEX, m_nrm ) ) );
-
-    glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( VERTEX ),
-                    reinterpret_cast<const void*>( m_materialMode == MATERIAL_MODE::CAD_MODE
-                                                         ? offsetof( VERTEX, m_cad_color )
-                                                         : offsetof( VERTEX, m_color ) ) );
-
-    glTexCoordPointer( 2, GL_FLOAT, sizeof( VERTEX ),
-                       reinterpret_cast<const void*>( offsetof( VERTEX, m_tex_uv ) ) );
-
-    const SFVEC4F param = SFVEC4F( 1.0f, 1.0f, 1.0f, aOpacity );
-
-    glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, (const float*)&param.x );
+    bindBuffers( aOpacity );
 
     std::vector<const MODEL_3D::MATERIAL *> materialsToRender;
 
@@ -529,33 +507,101 @@ void MODEL_3D::Draw( bool aTransparent, float aOpacity, bool aUseSelectedMateria
 
     for( const MODEL_3D::MATERIAL* mat : materialsToRender )
     {
-        switch( m_materialMode )
+        setMaterial( *mat, aOpacity, aUseSelectedMaterial, aSelectionColor );
+        drawMaterial( *mat );
+    }
+}
+
+
+void MODEL_3D::DrawInstances( const std::vector<glm::mat4>& aModelViewMatrices,
+                              bool aUseSelectedMaterial, const SFVEC3F& aSelectionColor ) const
+{
+    if( aModelViewMatrices.empty() )
+        return;
+
+    bindBuffers( 1.0f );
+
+    // Material major, so each material is set once for all the instances
+    for( const MODEL_3D::MATERIAL& mat : m_materials )
+    {
+        if( mat.m_render_idx_count == 0 )
+            continue;
+
+        if( mat.IsTransparent() && m_materialMode != MATERIAL_MODE::DIFFUSE_ONLY )
+            continue;
+
+        setMaterial( mat, 1.0f, aUseSelectedMaterial, aSelectionColor );
+
+        for( const glm::mat4& modelviewMatrix : aModelViewMatrices )
         {
-        case MATERIAL_MODE::NORMAL:
-            OglSetMaterial( *mat, aOpacity, aUseSelectedMaterial, aSelectionColor );
-            break;
-
-        case MATERIAL_MODE::DIFFUSE_ONLY:
-            OglSetDiffuseMaterial( mat->m_Diffuse, aOpacity, aUseSelectedMaterial,
-                                   aSelectionColor );
-            break;
-
-        case MATERIAL_MODE::CAD_MODE:
-            OglSetDiffuseMaterial( MaterialDiffuseToColorCAD( mat->m_Diffuse ), aOpacity,
-                                   aUseSelectedMaterial, aSelectionColor );
-            break;
-
-        default:
-            break;
+            glLoadMatrixf( glm::value_ptr( modelviewMatrix ) );
+            drawMaterial( mat );
         }
+    }
+}
+
+
+void MODEL_3D::bindBuffers( float aOpacity ) const
+{
+    if( !glBindBuffer )
+        throw std::runtime_error( "The OpenGL context no longer exists: unable to draw" );
+
+    glBindBuffer( GL_ARRAY_BUFFER, m_vertex_buffer );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_index_buffer );
 
-        glDrawElements( GL_TRIANGLES, mat->m_render_idx_count, m_index_buffer_type,
-                        reinterpret_cast<const void*>(
-                                static_cast<uintptr_t>( mat->m_render_idx_buffer_offset ) ) );
+    glVertexPointer( 3, GL_FLOAT, sizeof( VERTEX ),
+                     reinterpret_cast<const void*>( offsetof( VERTEX, m_pos ) ) );
+
+    glNormalPointer( GL_BYTE, sizeof( VERTEX ),
+                     reinterpret_cast<const void*>( offsetof( VERTEX, m_nrm ) ) );
+
+    glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( VERTEX ),
+                    reinterpret_cast<const void*>( m_materialMode == MATERIAL_MODE::CAD_MODE
+                                                         ? offsetof( VERTEX, m_cad_color )
+                                                         : offsetof( VERTEX, m_color ) ) );
+
+    glTexCoordPointer( 2, GL_FLOAT, sizeof( VERTEX ),
+                       reinterpret_cast<const void*>( offsetof( VERTEX, m_tex_uv ) ) );
+
+    const SFVEC4F param = SFVEC4F( 1.0f, 1.0f, 1.0f, aOpacity );
+
+    glTexEnvfv( GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, (const float*)&param.x );
+}
+
+
+void MODEL_3D::setMaterial( const MATERIAL& aMaterial, float aOpacity, bool aUseSelectedMaterial,
+                            const SFVEC3F& aSelectionColor ) const
+{
+    switch( m_materialMode )
+    {
+    case MATERIAL_MODE::NORMAL:
+        OglSetMaterial( aMaterial, aOpacity, aUseSelectedMaterial, aSelectionColor );
+        break;
+
+    case MATERIAL_MODE::DIFFUSE_ONLY:
+        OglSetDiffuseMaterial( aMaterial.m_Diffuse, aOpacity, aUseSelectedMaterial,
+                               aSelectionColor );
+        break;
+
+    case MATERIAL_MODE::CAD_MODE:
+        OglSetDiffuseMaterial( MaterialDiffuseToColorCAD( aMaterial.m_Diffuse ), aOpacity,
+                               aUseSelectedMaterial, aSelectionColor );
+        break;
+
+    default:
+        break;
     }
 }
 
 
+void MODEL_3D::drawMaterial( const MATERIAL& aMaterial ) const
+{
+    glDrawElements( GL_TRIANGLES, aMaterial.m_render_idx_count, m_index_buffer_type,
+                    reinterpret_cast<const void*>(
+                            static_cast<uintptr_t>( aMaterial.m_render_idx_buffer_offset ) ) );
+}
+
+
 MODEL_3D::~MODEL_3D()
 {
     if( glDeleteBuffers )
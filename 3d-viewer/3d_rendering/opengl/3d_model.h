@@ -76,6 +76,15 @@ public:
                const glm::mat4 *aModelWorldMatrix,
                const SFVEC3F *aCameraWorldPos ) const;
 
+    /**
+     * Render the opaque meshes of the model once for each of \a aModelViewMatrices.
+     *
+     * The buffers are bound and each material is set up only once for all the instances,
+     * instead of once per instance as with repeated Draw() calls.
+     */
+    void DrawInstances( const std::vector<glm::mat4>& aModelViewMatrices,
+                        bool aUseSelectedMaterial, const SFVEC3F& aSelectionColor ) const;
+
     /**
      * Return true if have opaque meshes to render.
      */
@@ -170,6 +179,13 @@ private:
     GLuint m_bbox_index_buffer = 0;
     GLenum m_bbox_index_buffer_type = GL_INVALID_ENUM;
 
+    void bindBuffers( float aOpacity ) const;
+
+    void setMaterial( const MATERIAL& aMaterial, float aOpacity, bool aUseSelectedMaterial,
+                      const SFVEC3F& aSelectionColor ) const;
+
+    void drawMaterial( const MATERIAL& aMaterial ) const;
+
     static void MakeBbox( const BBOX_3D& aBox, unsigned int aIdxOffset, VERTEX* aVtxOut,
                           GLuint* aIdxOut, const glm::vec4& aColor );
 };
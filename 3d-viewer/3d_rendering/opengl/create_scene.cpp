@@ -37,6 +37,9 @@
 #include <footprint_library_adapter.h>
 #include <eda_3d_viewer_frame.h>
 #include <project_pcb.h>
+#include <thread_pool.h>
+
+#include <set>
 
 
 void RENDER_3D_OPENGL::addObjectTriangles( const FILLED_CIRCLE_2D* aCircle,
@@ -689,7 +692,14 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
 {
     m_reloadRequested = false;
 
-    freeAllLists();
+    bool fullReload = m_fullReloadRequested || m_layerZPositions.empty();
+    LSET editedLayers = m_reloadLayers;
+
+    m_fullReloadRequested = false;
+    m_reloadLayers.reset();
+
+    if( fullReload )
+        freeAllLists();
 
     OBJECT_2D_STATS::Instance().ResetStats();
 
@@ -697,6 +707,27 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
 
     m_boardAdapter.InitSettings( aStatusReporter, aWarningReporter );
 
+    // Edits only need their layers rebuilt, unless the stackup moved every layer
+    if( updateLayerZPositions() && !fullReload )
+    {
+        freeAllLists();
+        fullReload = true;
+    }
+
+    if( !fullReload )
+    {
+        reloadLayers( editedLayers, aStatusReporter );
+
+        if( aStatusReporter )
+        {
+            double calculation_time = (double)( GetRunningMicroSecs() - stats_startReloadTime) / 1e6;
+
+            aStatusReporter->Report( wxString::Format( _( "Reload time %.3f s" ), calculation_time ) );
+        }
+
+        return;
+    }
+
     SFVEC3F camera_pos = m_boardAdapter.GetBoardCenter();
     m_camera.SetBoardLookAtPos( camera_pos );
 
@@ -805,13 +836,111 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
     if( aStatusReporter )
         aStatusReporter->Report( _( "Load OpenGL: layers" ) );
 
+    generateLayers( LSET::AllLayersMask(), aStatusReporter );
+    generateOuterPads( true, true );
+
+    // Load 3D models
+    if( aStatusReporter )
+        aStatusReporter->Report( _( "Loading 3D models..." ) );
+
+    load3dModels( aStatusReporter );
+
+    if( aStatusReporter )
+    {
+        // Calculation time in seconds
+        double calculation_time = (double)( GetRunningMicroSecs() - stats_startReloadTime) / 1e6;
+
+        aStatusReporter->Report( wxString::Format( _( "Reload time %.3f s" ), calculation_time ) );
+    }
+}
+
+
+void RENDER_3D_OPENGL::reloadLayers( const LSET& aLayers, REPORTER* aStatusReporter )
+{
+    const EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_boardAdapter.m_Cfg->m_Render;
+    LSET                                           layers = aLayers;
+
+    // The silkscreen is clipped by the solder mask, and the plated copper is trimmed to it
+    if( cfg.subtract_mask_from_silk )
+    {
+        if( layers.Contains( F_Mask ) )
+            layers.set( F_SilkS );
+
+        if( layers.Contains( B_Mask ) )
+            layers.set( B_SilkS );
+    }
+
+    if( cfg.DifferentiatePlatedCopper() )
+    {
+        if( layers.Contains( F_Mask ) )
+            layers.set( F_Cu );
+
+        if( layers.Contains( B_Mask ) )
+            layers.set( B_Cu );
+    }
+
+    // The display lists are compiled, so the triangles of the rebuilt layers can be freed once
+    // they are generated; only the ones of the last full reload are kept in m_triangles.
+    size_t trianglesCount = m_triangles.size();
+
+    if( aStatusReporter )
+        aStatusReporter->Report( _( "Load OpenGL: layers" ) );
+
+    generateLayers( layers, aStatusReporter );
+    generateOuterPads( layers.Contains( F_Cu ), layers.Contains( B_Cu ) );
+
+    while( m_triangles.size() > trianglesCount )
+    {
+        delete m_triangles.back();
+        m_triangles.pop_back();
+    }
+
+    // Models are placed when rendering, so only the ones of new footprints need loading
+    load3dModels( aStatusReporter );
+}
+
+
+bool RENDER_3D_OPENGL::updateLayerZPositions()
+{
+    std::vector<float> zPositions;
+
+    for( PCB_LAYER_ID layer : LSET::AllLayersMask().Seq() )
+    {
+        float zTop = 0.0f;
+        float zBot = 0.0f;
+
+        getLayerZPos( layer, zTop, zBot );
+        zPositions.push_back( zTop );
+        zPositions.push_back( zBot );
+    }
+
+    bool changed = zPositions != m_layerZPositions;
+
+    m_layerZPositions = std::move( zPositions );
+    return changed;
+}
+
+
+void RENDER_3D_OPENGL::generateLayers( const LSET& aLayers, REPORTER* aStatusReporter )
+{
     std::bitset<LAYER_3D_END> visibilityFlags = m_boardAdapter.GetVisibleLayers();
     const MAP_POLY&           map_poly = m_boardAdapter.GetPolyMap();
     wxString                  msg;
 
+    for( PCB_LAYER_ID layer : aLayers.Seq() )
+    {
+        auto it = m_layers.find( layer );
+
+        if( it != m_layers.end() )
+        {
+            delete it->second;
+            m_layers.erase( it );
+        }
+    }
+
     for( const auto& [ layer, container2d ] : m_boardAdapter.GetLayerMap() )
     {
-        if( !m_boardAdapter.Is3dLayerEnabled( layer, visibilityFlags ) )
+        if( !aLayers.Contains( layer ) || !m_boardAdapter.Is3dLayerEnabled( layer, visibilityFlags ) )
             continue;
 
         if( aStatusReporter )
@@ -876,13 +1005,33 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
         if( oglList != nullptr )
             m_layers[layer] = oglList;
     }
+}
+
+
+void RENDER_3D_OPENGL::generateOuterPads( bool aFront, bool aBack )
+{
+    if( aFront )
+    {
+        delete m_platedPadsFront;
+        delete m_offboardPadsFront;
+        m_platedPadsFront = nullptr;
+        m_offboardPadsFront = nullptr;
+    }
+
+    if( aBack )
+    {
+        delete m_platedPadsBack;
+        delete m_offboardPadsBack;
+        m_platedPadsBack = nullptr;
+        m_offboardPadsBack = nullptr;
+    }
 
     if( m_boardAdapter.m_Cfg->m_Render.DifferentiatePlatedCopper() )
     {
         const SHAPE_POLY_SET* frontPlatedCopperPolys = m_boardAdapter.GetFrontPlatedCopperPolys();
         const SHAPE_POLY_SET* backPlatedCopperPolys = m_boardAdapter.GetBackPlatedCopperPolys();
 
-        if( frontPlatedCopperPolys )
+        if( aFront && frontPlatedCopperPolys )
         {
             SHAPE_POLY_SET poly = frontPlatedCopperPolys->CloneDropTriangulation();
             poly.BooleanIntersection( m_boardAdapter.GetBoardPoly() );
@@ -900,7 +1049,7 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
                 m_layers[F_Cu] = generateEmptyLayerList( F_Cu );
         }
 
-        if( backPlatedCopperPolys )
+        if( aBack && backPlatedCopperPolys )
         {
             SHAPE_POLY_SET poly = backPlatedCopperPolys->CloneDropTriangulation();
             poly.BooleanIntersection( m_boardAdapter.GetBoardPoly() );
@@ -920,26 +1069,15 @@ void RENDER_3D_OPENGL::reload( REPORTER* aStatusReporter, REPORTER* aWarningRepo
 
     if( m_boardAdapter.m_Cfg->m_Render.show_off_board_silk )
     {
-        if( const BVH_CONTAINER_2D* padsFront = m_boardAdapter.GetOffboardPadsFront() )
+        const BVH_CONTAINER_2D* padsFront = m_boardAdapter.GetOffboardPadsFront();
+        const BVH_CONTAINER_2D* padsBack = m_boardAdapter.GetOffboardPadsBack();
+
+        if( aFront && padsFront )
             m_offboardPadsFront = generateLayerList( padsFront, nullptr, F_Cu );
 
-        if( const BVH_CONTAINER_2D* padsBack = m_boardAdapter.GetOffboardPadsBack() )
+        if( aBack && padsBack )
             m_offboardPadsBack = generateLayerList( padsBack, nullptr, B_Cu );
     }
-
-    // Load 3D models
-    if( aStatusReporter )
-        aStatusReporter->Report( _( "Loading 3D models..." ) );
-
-    load3dModels( aStatusReporter );
-
-    if( aStatusReporter )
-    {
-        // Calculation time in seconds
-        double calculation_time = (double)( GetRunningMicroSecs() - stats_startReloadTime) / 1e6;
-
-        aStatusReporter->Report( wxString::Format( _( "Reload time %.3f s" ), calculation_time ) );
-    }
 }
 
 
@@ -1621,7 +1759,18 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
 
     S3D_CACHE* cacheMgr = m_boardAdapter.Get3dCacheManager();
 
-    // Go for all footprints
+    struct MODEL_REQUEST
+    {
+        wxString                           m_filename;
+        wxString                           m_basePath;
+        std::vector<const EMBEDDED_FILES*> m_embeddedFilesStack;
+        const S3DMODEL*                    m_model = nullptr;
+    };
+
+    std::vector<MODEL_REQUEST> requests;
+    std::set<wxString>         requested;
+
+    // Go for all footprints, collecting each model file not already loaded in memory once
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
         wxString libraryName = footprint->GetFPID().GetLibNickname();
@@ -1647,39 +1796,47 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
 
         for( const FP_3DMODEL& fp_model : footprint->Models() )
         {
-            if( fp_model.m_Show && !fp_model.m_Filename.empty() )
+            if( fp_model.m_Show && !fp_model.m_Filename.empty()
+                    && !m_3dModelMap.contains( fp_model.m_Filename )
+                    && requested.insert( fp_model.m_Filename ).second )
             {
-                if( aStatusReporter )
-                {
-                    // Display the short filename of the 3D fp_model loaded:
-                    // (the full name is usually too long to be displayed)
-                    wxFileName fn( fp_model.m_Filename );
-                    aStatusReporter->Report( wxString::Format( _( "Loading %s..." ),
-                                                               fn.GetFullName() ) );
-                }
+                MODEL_REQUEST& request = requests.emplace_back();
 
-                // Check if the fp_model is not present in our cache map
-                // (Not already loaded in memory)
-                if( !m_3dModelMap.contains( fp_model.m_Filename ) )
-                {
-                    // It is not present, try get it from cache
-                    std::vector<const EMBEDDED_FILES*> embeddedFilesStack;
-                    embeddedFilesStack.push_back( footprint->GetEmbeddedFiles() );
-                    embeddedFilesStack.push_back( m_boardAdapter.GetBoard()->GetEmbeddedFiles() );
+                request.m_filename = fp_model.m_Filename;
+                request.m_basePath = footprintBasePath;
+                request.m_embeddedFilesStack.push_back( footprint->GetEmbeddedFiles() );
+                request.m_embeddedFilesStack.push_back( m_boardAdapter.GetBoard()->GetEmbeddedFiles() );
+            }
+        }
+    }
 
-                    const S3DMODEL* modelPtr = cacheMgr->GetModel( fp_model.m_Filename, footprintBasePath,
-                                                                   std::move( embeddedFilesStack ) );
+    if( requests.empty() )
+        return;
 
-                    // only add it if the return is not NULL
-                    if( modelPtr )
-                    {
-                        MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
-                        MODEL_3D*     model        = new MODEL_3D( *modelPtr, materialMode );
+    if( aStatusReporter )
+        aStatusReporter->Report( wxString::Format( _( "Loading %zu 3D models..." ), requests.size() ) );
 
-                        m_3dModelMap[ fp_model.m_Filename ] = model;
-                    }
-                }
-            }
-        }
+    // Reading and converting the model files is done in parallel; the cache loads each
+    // file only once.  The OpenGL buffers must be built on this thread.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.submit_loop( 0, requests.size(),
+            [&]( const int ii )
+            {
+                MODEL_REQUEST& request = requests[ii];
+
+                request.m_model = cacheMgr->GetModel( request.m_filename, request.m_basePath,
+                                                      request.m_embeddedFilesStack );
+            } );
+
+    results.wait();
+
+    MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
+
+    for( const MODEL_REQUEST& request : requests )
+    {
+        // only add it if the return is not NULL
+        if( request.m_model )
+            m_3dModelMap[ request.m_filename ] = new MODEL_3D( *request.m_model, materialMode );
     }
 }
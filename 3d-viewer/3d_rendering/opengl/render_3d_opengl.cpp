@@ -949,6 +949,7 @@ void RENDER_3D_OPENGL::freeAllLists()
     DELETE_AND_FREE_MAP( m_3dModelMap )
 
     m_3dModelMatrixMap.clear();
+    m_modelInstances.clear();
 
     DELETE_AND_FREE( m_board )
     DELETE_AND_FREE( m_boardWithHoles )
@@ -1158,10 +1159,7 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
         if( !renderList.empty() )
         {
             MODEL_3D::BeginDrawMulti( false );
-
-            for( const MODELTORENDER& mtr : renderList )
-                renderModel( aCameraViewMatrix, mtr, selColor, nullptr );
-
+            renderModelInstances( aCameraViewMatrix, renderList, selColor );
             MODEL_3D::EndDrawMulti();
         }
     }
@@ -1172,10 +1170,7 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
     if( !renderList.empty() )
     {
         MODEL_3D::BeginDrawMulti( true );
-
-        for( const MODELTORENDER& mtr : renderList )
-            renderModel( aCameraViewMatrix, mtr, selColor, nullptr );
-
+        renderModelInstances( aCameraViewMatrix, renderList, selColor );
         MODEL_3D::EndDrawMulti();
     }
 
@@ -1183,6 +1178,35 @@ void RENDER_3D_OPENGL::renderOpaqueModels( const glm::mat4 &aCameraViewMatrix )
 }
 
 
+void RENDER_3D_OPENGL::renderModelInstances( const glm::mat4& aCameraViewMatrix,
+                                             const std::list<MODELTORENDER>& aRenderList,
+                                             const SFVEC3F& aSelColor )
+{
+    // The bounding boxes are drawn per model
+    if( m_boardAdapter.m_Cfg->m_Render.show_model_bbox )
+    {
+        for( const MODELTORENDER& mtr : aRenderList )
+            renderModel( aCameraViewMatrix, mtr, aSelColor, nullptr );
+
+        return;
+    }
+
+    // Boards repeat the same few models many times, so draw all the copies of a model
+    // together.  The instance vectors are kept between frames to reuse their storage.
+    for( auto& [key, matrices] : m_modelInstances )
+        matrices.clear();
+
+    for( const MODELTORENDER& mtr : aRenderList )
+    {
+        m_modelInstances[{ mtr.m_model, mtr.m_isSelected }].push_back( aCameraViewMatrix
+                                                                      * mtr.m_modelWorldMat );
+    }
+
+    for( const auto& [key, matrices] : m_modelInstances )
+        key.first->DrawInstances( matrices, key.second, aSelColor );
+}
+
+
 void RENDER_3D_OPENGL::renderTransparentModels( const glm::mat4 &aCameraViewMatrix )
 {
     EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_boardAdapter.m_Cfg->m_Render;
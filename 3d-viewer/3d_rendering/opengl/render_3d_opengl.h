@@ -194,6 +194,14 @@ private:
     void renderModel( const glm::mat4 &aCameraViewMatrix, const MODELTORENDER &aModelToRender,
                       const SFVEC3F &aSelColor, const SFVEC3F *aCameraWorldPos );
 
+    /**
+     * Render a list of opaque models grouped by #MODEL_3D, so each model's buffers and
+     * materials are set up once for all its copies.
+     */
+    void renderModelInstances( const glm::mat4& aCameraViewMatrix,
+                               const std::list<MODELTORENDER>& aRenderList,
+                               const SFVEC3F& aSelColor );
+
 
     void get3dModelsSelected( std::list<MODELTORENDER> &aDstRenderList, bool aGetTop, bool aGetBot,
                               bool aRenderTransparentOnly, bool aRenderSelectedOnly );
@@ -235,6 +243,29 @@ private:
 
     void reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter );
 
+    /**
+     * Rebuild the render lists of \a aLayers from the board adapter, leaving the other layers,
+     * the board body, the holes and the 3D models untouched.
+     */
+    void reloadLayers( const LSET& aLayers, REPORTER* aStatusReporter );
+
+    /**
+     * (Re)generate the render lists of the given layers.
+     */
+    void generateLayers( const LSET& aLayers, REPORTER* aStatusReporter );
+
+    /**
+     * (Re)generate the plated and the off-board pad render lists of the front and/or back side.
+     */
+    void generateOuterPads( bool aFront, bool aBack );
+
+    /**
+     * Store the Z positions of all the layers.
+     *
+     * @return true if any of them changed since the previous call.
+     */
+    bool updateLayerZPositions();
+
     void setArrowMaterial();
 
     void freeAllLists();
@@ -270,6 +301,7 @@ private:
     OPENGL_RENDER_LIST* m_outerThroughHoleRings;
 
     LIST_TRIANGLES      m_triangles;       ///< store pointers so can be deleted latter
+    std::vector<float>  m_layerZPositions; ///< Top and bottom of each layer at the last reload
     GLuint              m_circleTexture;
 
     GLuint              m_grid;             ///< oGL list that stores current grid
@@ -284,6 +316,10 @@ private:
     std::map<wxString, MODEL_3D*>           m_3dModelMap;
     std::map<std::vector<float>, glm::mat4> m_3dModelMatrixMap;
 
+    /// Model view matrices of the copies of each model and selection state, reused between
+    /// frames
+    std::map<std::pair<const MODEL_3D*, bool>, std::vector<glm::mat4>> m_modelInstances;
+
     BOARD_ITEM*         m_currentRollOverItem;
 
     SHAPE_POLY_SET m_antiBoardPolys; ///< The negative polygon representation of the board
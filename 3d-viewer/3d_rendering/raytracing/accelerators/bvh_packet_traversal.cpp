@@ -29,6 +29,10 @@
 
 #include "bvh_pbrt.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+
 
 #define BVH_RANGED_TRAVERSAL
 //#define BVH_PARTITION_TRAVERSAL
@@ -44,22 +48,81 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                        unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+#ifdef BVH_RANGED_TRAVERSAL
+
+/**
+ * The rays of a packet in structure of arrays layout, so a box is tested against all of them
+ * with one branch-free loop the compiler can vectorize.
+ */
+struct RAYPACKET_SOA
 {
-    float hitT;
+    explicit RAYPACKET_SOA( const RAYPACKET& aRayPacket, const HITINFO_PACKET* aHitInfoPacket )
+    {
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        {
+            const RAY& ray = aRayPacket.m_ray[i];
+
+            m_orgX[i] = ray.m_Origin.x;
+            m_orgY[i] = ray.m_Origin.y;
+            m_orgZ[i] = ray.m_Origin.z;
 
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT )
-      && ( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit ) )
-        return ia;
+            // Axis aligned rays have infinite inverse components, and 0 * inf is a NaN that
+            // would make the slab test miss.  FLT_MAX keeps the products finite or infinite.
+            m_invDirX[i] = std::clamp( ray.m_InvDir.x, -FLT_MAX, FLT_MAX );
+            m_invDirY[i] = std::clamp( ray.m_InvDir.y, -FLT_MAX, FLT_MAX );
+            m_invDirZ[i] = std::clamp( ray.m_InvDir.z, -FLT_MAX, FLT_MAX );
 
+            m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+        }
+    }
+
+    /**
+     * Set \a aHits[i] for each ray that enters \a aBBox before its current nearest hit.
+     */
+    void Intersect( const BBOX_3D& aBBox, uint8_t* aHits ) const
+    {
+        const SFVEC3F& bmin = aBBox.Min();
+        const SFVEC3F& bmax = aBBox.Max();
+
+        for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        {
+            const float tx0 = ( bmin.x - m_orgX[i] ) * m_invDirX[i];
+            const float tx1 = ( bmax.x - m_orgX[i] ) * m_invDirX[i];
+            const float ty0 = ( bmin.y - m_orgY[i] ) * m_invDirY[i];
+            const float ty1 = ( bmax.y - m_orgY[i] ) * m_invDirY[i];
+            const float tz0 = ( bmin.z - m_orgZ[i] ) * m_invDirZ[i];
+            const float tz1 = ( bmax.z - m_orgZ[i] ) * m_invDirZ[i];
+
+            const float tNear = std::max( std::max( std::min( tx0, tx1 ), std::min( ty0, ty1 ) ),
+                                          std::min( tz0, tz1 ) );
+            const float tFar = std::min( std::min( std::max( tx0, tx1 ), std::max( ty0, ty1 ) ),
+                                         std::max( tz0, tz1 ) );
+
+            aHits[i] = ( tNear <= tFar ) & ( tFar >= 0.0f ) & ( tNear < m_tHit[i] );
+        }
+    }
+
+    float m_orgX[RAYPACKET_RAYS_PER_PACKET];
+    float m_orgY[RAYPACKET_RAYS_PER_PACKET];
+    float m_orgZ[RAYPACKET_RAYS_PER_PACKET];
+    float m_invDirX[RAYPACKET_RAYS_PER_PACKET];
+    float m_invDirY[RAYPACKET_RAYS_PER_PACKET];
+    float m_invDirZ[RAYPACKET_RAYS_PER_PACKET];
+    float m_tHit[RAYPACKET_RAYS_PER_PACKET];   ///< Nearest hit of each ray so far
+};
+
+
+static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const RAYPACKET_SOA& aRays,
+                                        const BBOX_3D& aBBox, unsigned int ia, uint8_t* aHits )
+{
     if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
         return RAYPACKET_RAYS_PER_PACKET;
 
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    aRays.Intersect( aBBox, aHits );
+
+    for( unsigned int i = ia; i < RAYPACKET_RAYS_PER_PACKET; ++i )
     {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT )
-          && ( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit ) )
+        if( aHits[i] )
             return i;
     }
 
@@ -67,17 +130,11 @@ static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_
 }
 
 
-#ifdef BVH_RANGED_TRAVERSAL
-
-static inline unsigned int getLastHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                       unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+static inline unsigned int getLastHit( unsigned int ia, const uint8_t* aHits )
 {
     for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
     {
-        float hitT;
-
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT )
-          && ( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit ) )
+        if( aHits[ie] )
             return ie + 1;
     }
 
@@ -101,13 +158,16 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
     int todoOffset = 0, nodeNum = 0;
     StackNode todo[MAX_TODOS];
 
+    RAYPACKET_SOA rays( aRayPacket, aHitInfoPacket );
+    uint8_t       hits[RAYPACKET_RAYS_PER_PACKET];
+
     unsigned int ia = 0;
 
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        ia = getFirstHit( aRayPacket, rays, curCell->bounds, ia, hits );
 
         if( ia < RAYPACKET_RAYS_PER_PACKET )
         {
@@ -121,8 +181,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket, curCell->bounds, ia,
-                                                    aHitInfoPacket );
+                const unsigned int ie = getLastHit( ia, hits );
 
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
@@ -132,6 +191,10 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
                     {
                         for( unsigned int i = ia; i < ie; ++i )
                         {
+                            // Rays missing the leaf cannot hit the primitives inside it
+                            if( !hits[i] )
+                                continue;
+
                             const bool hit = obj->Intersect( aRayPacket.m_ray[i],
                                                              aHitInfoPacket[i].m_HitInfo );
 
@@ -140,6 +203,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
                                 anyHit |= hit;
                                 aHitInfoPacket[i].m_hitresult |= hit;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                rays.m_tHit[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                             }
                         }
                     }
@@ -393,7 +393,10 @@ extern void buildBoardBoundingBoxPoly( const BOARD* aBoard, SHAPE_POLY_SET& aOut
 void RENDER_3D_RAYTRACE_BASE::Reload( REPORTER* aStatusReporter, REPORTER* aWarningReporter,
                                  bool aOnlyLoadCopperAndShapes )
 {
+    // The ray tracing scene is always rebuilt entirely
     m_reloadRequested = false;
+    m_fullReloadRequested = false;
+    m_reloadLayers.reset();
 
     m_modelMaterialMap.clear();
 
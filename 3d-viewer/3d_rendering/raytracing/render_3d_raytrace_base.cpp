@@ -25,7 +25,6 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <thread>
 
 #include "render_3d_raytrace_base.h"
 #include "mortoncodes.h"
@@ -108,6 +107,7 @@ RENDER_3D_RAYTRACE_BASE::RENDER_3D_RAYTRACE_BASE( BOARD_ADAPTER& aAdapter, CAMER
 
     m_is_canvas_initialized = false;
     m_isPreview = false;
+    m_progressiveRender = true;
     m_renderState = RT_RENDER_STATE_MAX; // Set to an initial invalid state
     m_renderStartTime = 0;
     m_blockRenderProgressCount = 0;
@@ -212,25 +212,29 @@ void RENDER_3D_RAYTRACE_BASE::render( uint8_t* ptrPBO, REPORTER* aStatusReporter
                 ConvertSRGBAToLinear( premultiplyAlpha( m_boardAdapter.m_BgColorBot ) );
     }
 
-    switch( m_renderState )
+    // Progressive renders return after each step so the canvas can show the partial image
+    do
     {
-    case RT_RENDER_STATE_TRACING:
-        renderTracing( ptrPBO, aStatusReporter );
-        break;
+        switch( m_renderState )
+        {
+        case RT_RENDER_STATE_TRACING:
+            renderTracing( ptrPBO, aStatusReporter );
+            break;
 
-    case RT_RENDER_STATE_POST_PROCESS_SHADE:
-        postProcessShading( ptrPBO, aStatusReporter );
-        break;
+        case RT_RENDER_STATE_POST_PROCESS_SHADE:
+            postProcessShading( ptrPBO, aStatusReporter );
+            break;
 
-    case RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH:
-        postProcessBlurFinish( ptrPBO, aStatusReporter );
-        break;
+        case RT_RENDER_STATE_POST_PROCESS_BLUR_AND_FINISH:
+            postProcessBlurFinish( ptrPBO, aStatusReporter );
+            break;
 
-    default:
-        wxASSERT_MSG( false, wxT( "Invalid state on m_renderState" ) );
-        restartRenderState();
-        break;
-    }
+        default:
+            wxASSERT_MSG( false, wxT( "Invalid state on m_renderState" ) );
+            restartRenderState();
+            break;
+        }
+    } while( !m_progressiveRender && m_renderState != RT_RENDER_STATE_FINISH );
 
     if( aStatusReporter && ( m_renderState == RT_RENDER_STATE_FINISH ) )
     {
@@ -267,6 +271,9 @@ void RENDER_3D_RAYTRACE_BASE::renderTracing( uint8_t* ptrPBO, REPORTER* aStatusR
                         numBlocksRendered++;
                     }
 
+                    if( !m_progressiveRender )
+                        continue;
+
                     auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(
                             std::chrono::steady_clock::now() - startTime );
 
@@ -705,17 +712,10 @@ void RENDER_3D_RAYTRACE_BASE::postProcessShading( uint8_t* /* ptrPBO */, REPORTE
 
         m_postShaderSsao.SetShadowsEnabled( m_boardAdapter.m_Cfg->m_Render.raytrace_shadows );
 
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
+        thread_pool& tp = GetKiCadThreadPool();
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        tp.submit_loop( 0, m_realBufferSize.y,
+                [&]( const unsigned int y )
                 {
                     SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
@@ -724,16 +724,7 @@ void RENDER_3D_RAYTRACE_BASE::postProcessShading( uint8_t* /* ptrPBO */, REPORTE
                         *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
                         ptr++;
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                } ).wait();
 
         m_postShaderSsao.SetShadedBuffer( m_shaderBuffer );
 
@@ -754,17 +745,10 @@ void RENDER_3D_RAYTRACE_BASE::postProcessBlurFinish( uint8_t* ptrPBO,
     if( m_boardAdapter.m_Cfg->m_Render.raytrace_post_processing )
     {
         // Now blurs the shader result and compute the final color
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+        thread_pool& tp = GetKiCadThreadPool();
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+        tp.submit_loop( 0, m_realBufferSize.y,
+                [&]( const unsigned int y )
                 {
                     uint8_t* ptr = &ptrPBO[ y * m_realBufferSize.x * 4 ];
 
@@ -786,16 +770,7 @@ void RENDER_3D_RAYTRACE_BASE::postProcessBlurFinish( uint8_t* ptrPBO,
 
                         ptr += 4;
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                } ).wait();
 
         // Debug code
         //m_postShaderSsao.DebugBuffersOutputAsImages();
@@ -814,16 +789,16 @@ void RENDER_3D_RAYTRACE_BASE::renderPreview( uint8_t* ptrPBO )
     m_backgroundColorBottom =
             ConvertSRGBAToLinear( premultiplyAlpha( m_boardAdapter.m_BgColorBot ) );
 
-    std::atomic<size_t> nextBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+    thread_pool&           tp = GetKiCadThreadPool();
+    BS::multi_future<void> futures;
+    std::atomic<size_t>    nextBlock( 0 );
 
-    size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-            m_blockPositions.size() );
+    size_t parallelThreadCount = std::min<size_t>( tp.get_thread_count(),
+                                                   m_blockPositionsFast.size() );
 
     for( size_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        std::thread t = std::thread( [&]()
+        futures.push_back( tp.submit_task( [&]()
         {
             for( size_t iBlock = nextBlock.fetch_add( 1 ); iBlock < m_blockPositionsFast.size();
                  iBlock = nextBlock.fetch_add( 1 ) )
@@ -1400,14 +1375,10 @@ void RENDER_3D_RAYTRACE_BASE::renderPreview( uint8_t* ptrPBO )
                 }
             }
 
-            threadsFinished++;
-        } );
-
-        t.detach();
+        } ) );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    futures.wait();
 }
 
 
@@ -154,6 +154,10 @@ protected:
     bool m_is_canvas_initialized;
     bool m_isPreview;
 
+    /// Render in time slices, returning after each step so the partial image can be shown.
+    /// When false, render() runs the tracing and post processing to the end in one call.
+    bool m_progressiveRender;
+
     /// State used on quality render
     RT_RENDER_STATE m_renderState;
 
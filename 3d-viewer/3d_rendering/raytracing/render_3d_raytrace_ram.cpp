@@ -32,6 +32,8 @@ RENDER_3D_RAYTRACE_RAM::RENDER_3D_RAYTRACE_RAM( BOARD_ADAPTER& aAdapter, CAMERA&
     m_outputBuffer( nullptr ),
     m_pboDataSize( 0 )
 {
+    // Off-screen renders have no canvas to update, so render each image in one go
+    m_progressiveRender = false;
 }
 
 
@@ -120,6 +122,11 @@ bool RENDER_3D_RAYTRACE_RAM::Redraw( bool aIsMoving, REPORTER* aStatusReporter,
         m_renderState = RT_RENDER_STATE_MAX; // Set to an invalid state,
                                              // so it will restart again latter
 
+    // Loading the board moves the camera to it, so callers can only set up their view after
+    // this call.  Rendering a whole image for the default view would be wasted.
+    if( requestRedraw )
+        return true;
+
     // This will only render if need, otherwise it will redraw the PBO on the screen again
     if( aIsMoving || was_camera_changed )
     {
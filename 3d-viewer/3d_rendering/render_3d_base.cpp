@@ -52,6 +52,7 @@ RENDER_3D_BASE::RENDER_3D_BASE( BOARD_ADAPTER& aBoardAdapter, CAMERA& aCamera )
     m_canvasInitialized     = false;
     m_windowSize            = wxSize( -1, -1 );
     m_reloadRequested       = true;
+    m_fullReloadRequested   = true;
 }
 
 
@@ -65,9 +65,24 @@ public:
                          REPORTER* aWarningReporter = nullptr ) = 0;
 
     /**
-     * @todo This must be reviewed to add flags to improve specific render.
+     * Request a reload of the whole scene.
      */
-    void ReloadRequest() { m_reloadRequested = true; }
+    void ReloadRequest()
+    {
+        m_reloadRequested = true;
+        m_fullReloadRequested = true;
+    }
+
+    /**
+     * Request a reload of the scene after the items of \a aLayers were edited.
+     *
+     * Renderers which cannot rebuild part of their scene reload all of it.
+     */
+    void ReloadRequest( const LSET& aLayers )
+    {
+        m_reloadRequested = true;
+        m_reloadLayers |= aLayers;
+    }
 
     /**
      * Query if there is a pending reload request.
@@ -106,9 +121,14 @@ protected:
     /// Flag if the canvas specific for this render was already initialized.
     bool m_canvasInitialized;
 
-    /// @todo This must be reviewed in order to flag change types.
     bool m_reloadRequested;
 
+    /// The pending reload must rebuild the whole scene, not only #m_reloadLayers.
+    bool m_fullReloadRequested;
+
+    /// Layers whose items were edited since the last reload.
+    LSET m_reloadLayers;
+
     /// The window size that this camera is working.
     wxSize m_windowSize;
 
@@ -45,6 +45,7 @@
 #include <board_design_settings.h>
 #include <core/arraydim.h>
 #include <dpi_scaling_common.h>
+#include <footprint.h>
 #include <pgm_base.h>
 #include <project.h>
 #include <project/project_file.h>
@@ -58,7 +59,9 @@
 #include <widgets/wx_infobar.h>
 #include <widgets/wx_aui_utils.h>
 #include <wildcards_and_files_ext.h>
+#include <zone.h>
 #include <project_pcb.h>
+#include <pcb_track.h>
 #include <toolbars_3d.h>
 
 #ifdef __linux__
@@ -99,7 +102,10 @@ EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent
                       wxDefaultSize, style, QUALIFIED_VIEWER3D_FRAMENAME( aParent ), unityScale ),
         m_canvas( nullptr ),
         m_currentCamera( m_trackBallCamera ),
-        m_trackBallCamera( 2 * RANGE_SCALE_3D )
+        m_trackBallCamera( 2 * RANGE_SCALE_3D ),
+        m_trackedBoard( nullptr ),
+        m_boardEdited( false ),
+        m_editsNeedFullReload( false )
 {
     wxLogTrace( m_logTrace, wxT( "EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME %s" ), aTitle );
 
@@ -212,6 +218,8 @@ EDA_3D_VIEWER_FRAME::EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent
     // in order to receive mouse events.  Otherwise, the user has to click somewhere on
     // the canvas before it will respond to mouse wheel events.
     m_canvas->SetFocus();
+
+    trackBoardEdits();
 }
 
 
@@ -410,13 +418,176 @@ void EDA_3D_VIEWER_FRAME::ReloadRequest()
     // This will schedule a request to load later
     // ReloadRequest also updates the board pointer so always call it first
     if( m_canvas )
-        m_canvas->ReloadRequest( GetBoard(), PROJECT_PCB::Get3DCacheManager( &Prj() ) );
+    {
+        if( m_boardEdited && !m_editsNeedFullReload && m_trackedBoard == GetBoard() )
+        {
+            // Nothing but board edits since the last request: only rebuild the edited layers
+            if( m_editedLayers.any() )
+                m_canvas->ReloadRequest( m_editedLayers );
+        }
+        else
+        {
+            m_canvas->ReloadRequest( GetBoard(), PROJECT_PCB::Get3DCacheManager( &Prj() ) );
+            trackBoardEdits();
+        }
+
+        m_editedLayers.reset();
+        m_boardEdited = false;
+        m_editsNeedFullReload = false;
+    }
 
     if( m_appearancePanel )
         m_appearancePanel->UpdateLayerCtls();
 }
 
 
+/**
+ * @return the layers of \a aItem and of its children, e.g. the pads and graphics of a footprint.
+ * @param aHasHoles is set if any of them has a hole.
+ */
+static LSET itemLayers( const BOARD_ITEM* aItem, bool& aHasHoles )
+{
+    LSET layers;
+
+    auto addItem =
+            [&]( const BOARD_ITEM* aChild )
+            {
+                layers |= aChild->GetLayerSet();
+                aHasHoles |= aChild->HasHole();
+            };
+
+    addItem( aItem );
+    aItem->RunOnChildren( addItem, RECURSE_MODE::RECURSE );
+
+    return layers;
+}
+
+
+void EDA_3D_VIEWER_FRAME::trackBoardEdits()
+{
+    BOARD* board = GetBoard();
+
+    m_trackedBoard = board;
+    m_itemLayers.clear();
+
+    if( !board )
+        return;
+
+    board->AddListener( this );
+
+    auto addItem =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                bool hasHoles = false;
+                LSET layers = itemLayers( aItem, hasHoles );
+
+                m_itemLayers[aItem] = { layers, hasHoles };
+            };
+
+    for( const PCB_TRACK* track : board->Tracks() )
+        addItem( track );
+
+    for( const FOOTPRINT* footprint : board->Footprints() )
+        addItem( footprint );
+
+    for( const BOARD_ITEM* item : board->Drawings() )
+        addItem( item );
+
+    for( const ZONE* zone : board->Zones() )
+        addItem( zone );
+}
+
+
+void EDA_3D_VIEWER_FRAME::onItemEdited( const BOARD_ITEM* aItem, bool aRemoved )
+{
+    m_boardEdited = true;
+
+    if( !aItem || aItem->Type() == PCB_MARKER_T || aItem->Type() == PCB_NETINFO_T )
+        return;
+
+    bool hasHoles = false;
+    LSET layers = itemLayers( aItem, hasHoles );
+    auto it = m_itemLayers.find( aItem );
+
+    m_editedLayers |= layers;
+
+    // An edit can move the item off layers, which must be rebuilt too
+    if( it != m_itemLayers.end() )
+    {
+        m_editedLayers |= it->second.first;
+        hasHoles |= it->second.second;
+    }
+
+    // Holes and the board outline are part of every layer, and of the board body
+    if( hasHoles || m_editedLayers.Contains( Edge_Cuts ) )
+        m_editsNeedFullReload = true;
+
+    if( aRemoved )
+    {
+        if( it != m_itemLayers.end() )
+            m_itemLayers.erase( it );
+    }
+    else
+    {
+        m_itemLayers[aItem] = { layers, hasHoles };
+    }
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    onItemEdited( aBoardItem, false );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        onItemEdited( item, false );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    onItemEdited( aBoardItem, true );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        onItemEdited( item, true );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    onItemEdited( aBoardItem, false );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        onItemEdited( item, false );
+}
+
+
+void EDA_3D_VIEWER_FRAME::OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                                  std::vector<BOARD_ITEM*>& aRemovedItems,
+                                                  std::vector<BOARD_ITEM*>& aChangedItems )
+{
+    for( BOARD_ITEM* item : aAddedItems )
+        onItemEdited( item, false );
+
+    for( BOARD_ITEM* item : aRemovedItems )
+        onItemEdited( item, true );
+
+    for( BOARD_ITEM* item : aChangedItems )
+        onItemEdited( item, false );
+}
+
+
 void EDA_3D_VIEWER_FRAME::NewDisplay( bool aForceImmediateRedraw )
 {
     if( m_canvas )
@@ -466,6 +637,12 @@ void EDA_3D_VIEWER_FRAME::OnCloseWindow( wxCloseEvent &event )
     if( m_canvas )
         m_canvas->Close();
 
+    // The board outlives this frame
+    if( m_trackedBoard && m_trackedBoard == GetBoard() )
+        m_trackedBoard->RemoveListener( this );
+
+    m_trackedBoard = nullptr;
+
     Destroy();
     event.Skip( true );
 }
@@ -36,6 +36,7 @@
 #include "3d_canvas/board_adapter.h"
 #include "3d_canvas/eda_3d_canvas.h"
 #include "3d_rendering/track_ball.h"
+#include <board.h>
 #include <kiway_player.h>
 #include <wx/colourdata.h>
 #include <dialogs/dialog_color_picker.h>  // for CUSTOM_COLORS_LIST definition
@@ -72,7 +73,7 @@ enum class EDA_3D_VIEWER_EXPORT_FORMAT
 /**
  * Create and handle a window for the 3d viewer connected to a Kiway and a pcbboard
  */
-class EDA_3D_VIEWER_FRAME : public KIWAY_PLAYER
+class EDA_3D_VIEWER_FRAME : public KIWAY_PLAYER, public BOARD_LISTENER
 {
 public:
     EDA_3D_VIEWER_FRAME( KIWAY* aKiway, PCB_BASE_FRAME* aParent, const wxString& aTitle,
@@ -93,6 +94,9 @@ public:
      * one to prepare changes and request for 3D rebuild only when all changes are committed.
      * This is made because the 3D rebuild can take a long time, and this rebuild cannot
      * always made after each change, for calculation time reason.
+     *
+     * If the board was only edited since the previous request, and the edits did not touch
+     * holes or the board outline, only the layers of the edited items are rebuilt.
      */
     void ReloadRequest();
 
@@ -131,6 +135,17 @@ public:
 
     APPEARANCE_CONTROLS_3D* GetAppearanceManager() { return m_appearancePanel; }
 
+    ///< @copydoc BOARD_LISTENER::OnBoardItemAdded
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                 std::vector<BOARD_ITEM*>& aRemovedItems,
+                                 std::vector<BOARD_ITEM*>& aChangedItems ) override;
+
     void ToggleAppearanceManager();
 
     void OnDarkModeToggle();
@@ -177,6 +192,17 @@ private:
 
     void refreshRender();
 
+    /**
+     * Start listening to the edits of the current board, and record the layers of its items so
+     * an edit moving an item to other layers also rebuilds the layers it left.
+     */
+    void trackBoardEdits();
+
+    /**
+     * Record the layers touched by an added, removed or changed item.
+     */
+    void onItemEdited( const BOARD_ITEM* aItem, bool aRemoved );
+
     DECLARE_EVENT_TABLE()
 
     /**
@@ -280,6 +306,15 @@ private:
 
     bool                           m_disable_ray_tracing;
 
+    BOARD*                         m_trackedBoard;         ///< Board whose edits are recorded
+
+    /// Layers of the board items as last seen, and whether they have holes
+    std::unordered_map<const BOARD_ITEM*, std::pair<LSET, bool>> m_itemLayers;
+
+    LSET                           m_editedLayers;         ///< Layers edited since the last request
+    bool                           m_boardEdited;          ///< The board was edited since then
+    bool                           m_editsNeedFullReload;  ///< An edit moved holes or the outline
+
 #ifdef __linux__
     std::unique_ptr<SPNAV_VIEWER_PLUGIN> m_spaceMouse;
 #else
@@ -130,6 +130,8 @@ static const wxChar MinParallelAngle[] = wxT( "MinParallelAngle" );
 static const wxChar HoleWallPaintingMultiplier[] = wxT( "HoleWallPaintingMultiplier" );
 static const wxChar MsgPanelShowUuids[] = wxT( "MsgPanelShowUuids" );
 static const wxChar MaximumThreads[] = wxT( "MaximumThreads" );
+static const wxChar UndoMemoryBudgetMB[] = wxT( "UndoMemoryBudgetMB" );
+static const wxChar ShowMemoryUsage[] = wxT( "ShowMemoryUsage" );
 static const wxChar NetInspectorBulkUpdateOptimisationThreshold[] =
         wxT( "NetInspectorBulkUpdateOptimisationThreshold" );
 static const wxChar ExcludeFromSimulationLineWidth[] = wxT( "ExcludeFromSimulationLineWidth" );
@@ -138,12 +140,26 @@ static const wxChar GitIconRefreshInterval[] = wxT( "GitIconRefreshInterval" );
 static const wxChar MaxPastedTextLength[] = wxT( "MaxPastedTextLength" );
 static const wxChar PNSProcessClusterTimeout[] = wxT( "PNSProcessClusterTimeout" );
 static const wxChar FollowBranchTimeout[] = wxT( "FollowBranchTimeoutMs" );
+static const wxChar PNSParallelShove[] = wxT( "PNSParallelShove" );
+static const wxChar ParallelBoardLoad[] = wxT( "ParallelBoardLoad" );
+static const wxChar ParallelSchematicLoad[] = wxT( "ParallelSchematicLoad" );
+static const wxChar BoardFillSidecar[] = wxT( "BoardFillSidecar" );
+static const wxChar ParallelBoardSave[] = wxT( "ParallelBoardSave" );
 static const wxChar ImportSkipComponentBodies[] = wxT( "ImportSkipComponentBodies" );
 static const wxChar ScreenDPI[] = wxT( "ScreenDPI" );
 static const wxChar EnableVariantsUI[] = wxT( "EnableVariantsUI" );
 static const wxChar EnableUseAuiPerspective[] = wxT( "EnableUseAuiPerspective" );
 static const wxChar HistoryLockStaleTimeout[] = wxT( "HistoryLockStaleTimeout" );
 static const wxChar ZoneFillIterativeRefill[] = wxT( "ZoneFillIterativeRefill" );
+static const wxChar ZoneFillTileSize[] = wxT( "ZoneFillTileSize" );
+static const wxChar ZoneFillCache[] = wxT( "ZoneFillCache" );
+static const wxChar IncrementalDRC[] = wxT( "IncrementalDRC" );
+static const wxChar DRCProviderThreads[] = wxT( "DRCProviderThreads" );
+static const wxChar ViewCoalesceSubPixelItems[] = wxT( "ViewCoalesceSubPixelItems" );
+static const wxChar ShowFrameProfile[] = wxT( "ShowFrameProfile" );
+static const wxChar FrameProfileTraceFile[] = wxT( "FrameProfileTraceFile" );
+static const wxChar AgentEmbeddingModel[] = wxT( "AgentEmbeddingModel" );
+static const wxChar AgentDraftModel[] = wxT( "AgentDraftModel" );
 
 } // namespace AC_KEYS
 
@@ -314,6 +330,8 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_HoleWallPaintingMultiplier = 1.5;
 
     m_MaximumThreads = 0;
+    m_UndoMemoryBudgetMB = 1024;
+    m_ShowMemoryUsage = false;
 
     m_NetInspectorBulkUpdateOptimisationThreshold = 100;
 
@@ -326,6 +344,11 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_PNSProcessClusterTimeout = 100; // Default: 100 ms
     m_FollowBranchTimeout = 500; // Default: 500 ms
+    m_PNSParallelShove = false;
+    m_ParallelBoardLoad = true;
+    m_ParallelSchematicLoad = true;
+    m_BoardFillSidecar = false;
+    m_ParallelBoardSave = true;
 
     m_ImportSkipComponentBodies = false;
 
@@ -336,6 +359,15 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_EnableUseAuiPerspective = false;
     m_HistoryLockStaleTimeout = 300; // 5 minutes default
     m_ZoneFillIterativeRefill = false;
+    m_ZoneFillTileSize = 0.0;
+    m_ZoneFillCache = true;
+    m_IncrementalDRC = false;
+    m_DRCProviderThreads = 0;
+    m_ViewCoalesceSubPixelItems = true;
+    m_ShowFrameProfile = false;
+    m_FrameProfileTraceFile = wxEmptyString;
+    m_AgentEmbeddingModel = wxEmptyString;
+    m_AgentDraftModel = wxEmptyString;
 
     loadFromConfigFile();
 }
@@ -611,6 +643,14 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::MaximumThreads, &m_MaximumThreads,
                                                           m_MaximumThreads, 0, 500 ) );
 
+    m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::UndoMemoryBudgetMB,
+                                                          &m_UndoMemoryBudgetMB,
+                                                          m_UndoMemoryBudgetMB, 0, 65536 ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ShowMemoryUsage,
+                                                           &m_ShowMemoryUsage,
+                                                           m_ShowMemoryUsage ) );
+
     m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::NetInspectorBulkUpdateOptimisationThreshold,
                                                           &m_NetInspectorBulkUpdateOptimisationThreshold,
                                                           m_NetInspectorBulkUpdateOptimisationThreshold, 0, 1000 ) );
@@ -635,6 +675,21 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::FollowBranchTimeout,
                                                           &m_FollowBranchTimeout, 500, 50, 5000 ) );
 
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::PNSParallelShove,
+                                                           &m_PNSParallelShove, m_PNSParallelShove ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ParallelBoardLoad,
+                                                           &m_ParallelBoardLoad, m_ParallelBoardLoad ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ParallelSchematicLoad,
+                                                           &m_ParallelSchematicLoad, m_ParallelSchematicLoad ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::BoardFillSidecar,
+                                                           &m_BoardFillSidecar, m_BoardFillSidecar ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ParallelBoardSave,
+                                                           &m_ParallelBoardSave, m_ParallelBoardSave ) );
+
     m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ImportSkipComponentBodies,
                                                            &m_ImportSkipComponentBodies, m_ImportSkipComponentBodies ) );
 
@@ -653,6 +708,40 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ZoneFillIterativeRefill,
                                                            &m_ZoneFillIterativeRefill, m_ZoneFillIterativeRefill ) );
 
+    m_entries.push_back( std::make_unique<PARAM_CFG_DOUBLE>( true, AC_KEYS::ZoneFillTileSize,
+                                                             &m_ZoneFillTileSize, m_ZoneFillTileSize,
+                                                             0.0, 1000.0 ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ZoneFillCache,
+                                                           &m_ZoneFillCache, m_ZoneFillCache ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::IncrementalDRC,
+                                                           &m_IncrementalDRC, m_IncrementalDRC ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_INT>( true, AC_KEYS::DRCProviderThreads,
+                                                          &m_DRCProviderThreads, m_DRCProviderThreads,
+                                                          0, 500 ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ViewCoalesceSubPixelItems,
+                                                           &m_ViewCoalesceSubPixelItems,
+                                                           m_ViewCoalesceSubPixelItems ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_BOOL>( true, AC_KEYS::ShowFrameProfile,
+                                                           &m_ShowFrameProfile,
+                                                           m_ShowFrameProfile ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::FrameProfileTraceFile,
+                                                               &m_FrameProfileTraceFile,
+                                                               m_FrameProfileTraceFile ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::AgentEmbeddingModel,
+                                                               &m_AgentEmbeddingModel,
+                                                               m_AgentEmbeddingModel ) );
+
+    m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::AgentDraftModel,
+                                                               &m_AgentDraftModel,
+                                                               m_AgentDraftModel ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     m_entries.push_back( std::make_unique<PARAM_CFG_WXSTRING>( true, AC_KEYS::TraceMasks, &m_traceMasks, wxS( "" ) ) );
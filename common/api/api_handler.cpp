@@ -59,3 +59,17 @@ API_RESULT API_HANDLER::Handle( ApiRequest& aMsg )
     // This response is used internally; no need for an error message
     return tl::unexpected( status );
 }
+
+
+bool API_HANDLER::IsThreadSafe( const ApiRequest& aMsg ) const
+{
+    if( m_threadSafeHandlers.empty() || !aMsg.has_message() )
+        return false;
+
+    std::string typeName;
+
+    if( !google::protobuf::Any::ParseAnyTypeUrl( aMsg.message().type_url(), &typeName ) )
+        return false;
+
+    return m_threadSafeHandlers.contains( typeName );
+}
@@ -44,18 +44,19 @@ using google::protobuf::Empty;
 API_HANDLER_COMMON::API_HANDLER_COMMON() :
         API_HANDLER()
 {
-    registerHandler<commands::GetVersion, GetVersionResponse>( &API_HANDLER_COMMON::handleGetVersion );
-    registerHandler<GetKiCadBinaryPath, PathResponse>(
+    registerThreadSafeHandler<commands::GetVersion, GetVersionResponse>(
+            &API_HANDLER_COMMON::handleGetVersion );
+    registerThreadSafeHandler<GetKiCadBinaryPath, PathResponse>(
             &API_HANDLER_COMMON::handleGetKiCadBinaryPath );
     registerHandler<GetNetClasses, NetClassesResponse>( &API_HANDLER_COMMON::handleGetNetClasses );
     registerHandler<SetNetClasses, Empty>( &API_HANDLER_COMMON::handleSetNetClasses );
-    registerHandler<Ping, Empty>( &API_HANDLER_COMMON::handlePing );
+    registerThreadSafeHandler<Ping, Empty>( &API_HANDLER_COMMON::handlePing );
     registerHandler<GetTextExtents, types::Box2>( &API_HANDLER_COMMON::handleGetTextExtents );
     registerHandler<GetTextAsShapes, GetTextAsShapesResponse>(
             &API_HANDLER_COMMON::handleGetTextAsShapes );
     registerHandler<ExpandTextVariables, ExpandTextVariablesResponse>(
             &API_HANDLER_COMMON::handleExpandTextVariables );
-    registerHandler<GetPluginSettingsPath, StringResponse>(
+    registerThreadSafeHandler<GetPluginSettingsPath, StringResponse>(
             &API_HANDLER_COMMON::handleGetPluginSettingsPath );
     registerHandler<GetTextVariables, project::TextVariables>(
             &API_HANDLER_COMMON::handleGetTextVariables );
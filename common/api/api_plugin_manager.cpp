@@ -264,6 +264,7 @@ void API_PLUGIN_MANAGER::InvokeAction( const wxString& aIdentifier )
         wxExecuteEnv   env;
         wxGetEnvMap( &env.env );
         env.env[wxS( "KICAD_API_SOCKET" )] = Pgm().GetApiServer().SocketPath();
+        env.env[wxS( "KICAD_API_EVENTS_SOCKET" )] = Pgm().GetApiServer().EventSocketPath();
         env.env[wxS( "KICAD_API_TOKEN" )] = Pgm().GetApiServer().Token();
         env.cwd = pluginFile.GetPath();
 
@@ -347,6 +348,7 @@ void API_PLUGIN_MANAGER::InvokeAction( const wxString& aIdentifier )
         wxExecuteEnv env;
         wxGetEnvMap( &env.env );
         env.env[wxS( "KICAD_API_SOCKET" )] = Pgm().GetApiServer().SocketPath();
+        env.env[wxS( "KICAD_API_EVENTS_SOCKET" )] = Pgm().GetApiServer().EventSocketPath();
         env.env[wxS( "KICAD_API_TOKEN" )] = Pgm().GetApiServer().Token();
         env.cwd = pluginFile.GetPath();
 
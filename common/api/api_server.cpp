@@ -18,7 +18,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cmath>
+
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 #include <wx/app.h>
 #include <wx/datetime.h>
 #include <wx/event.h>
@@ -46,6 +49,8 @@ using kiapi::common::ApiRequest, kiapi::common::ApiResponse, kiapi::common::ApiS
 
 wxString KICAD_API_SERVER::s_logFileName = "api.log";
 
+const std::string KICAD_API_SERVER::API_STATS_REQUEST( "\0stats", 6 );
+
 
 wxDEFINE_EVENT( API_REQUEST_EVENT, wxCommandEvent );
 
@@ -109,6 +114,11 @@ void KICAD_API_SERVER::Start()
                                                     socket.GetFullPath() ) );
             wxRemoveFile( socket.GetFullPath() );
         }
+
+        wxFileName eventSocket( socket.GetPath(), wxS( "api-events.sock" ) );
+
+        if( eventSocket.Exists() )
+            wxRemoveFile( eventSocket.GetFullPath() );
     }
 #endif
 
@@ -128,6 +138,12 @@ void KICAD_API_SERVER::Start()
             fmt::format( "ipc://{}", socket.GetFullPath().ToStdString() ) );
     m_server->SetCallback( [&]( std::string* aRequest ) { onApiRequest( aRequest ); } );
 
+    wxFileName eventSocket( socket );
+    eventSocket.SetName( socket.GetName() + wxS( "-events" ) );
+
+    m_publisher = std::make_unique<KINNG_PUBLISHER>(
+            fmt::format( "ipc://{}", eventSocket.GetFullPath().ToStdString() ) );
+
     m_logFilePath.AssignDir( PATHS::GetLogsPath() );
     m_logFilePath.SetName( s_logFileName );
 
@@ -153,6 +169,7 @@ void KICAD_API_SERVER::Stop()
 
     m_server->Stop();
     m_server.reset( nullptr );
+    m_publisher.reset( nullptr );
 }
 
 
@@ -165,12 +182,16 @@ bool KICAD_API_SERVER::Running() const
 void KICAD_API_SERVER::RegisterHandler( API_HANDLER* aHandler )
 {
     wxCHECK( aHandler, /* void */ );
+
+    std::lock_guard<std::recursive_mutex> lock( m_handlersMutex );
     m_handlers.insert( aHandler );
 }
 
 
 void KICAD_API_SERVER::DeregisterHandler( API_HANDLER* aHandler )
 {
+    // Waits for a request running on the server thread to finish with the handler
+    std::lock_guard<std::recursive_mutex> lock( m_handlersMutex );
     m_handlers.erase( aHandler );
 }
 
@@ -181,8 +202,43 @@ std::string KICAD_API_SERVER::SocketPath() const
 }
 
 
+std::string KICAD_API_SERVER::EventSocketPath() const
+{
+    return m_publisher ? m_publisher->SocketPath() : "";
+}
+
+
+bool KICAD_API_SERVER::CanPublish() const
+{
+    return m_publisher && m_publisher->HasSubscribers();
+}
+
+
+void KICAD_API_SERVER::Publish( const std::string& aTopic, const std::string& aPayload )
+{
+    if( !CanPublish() )
+        return;
+
+    std::string message;
+    message.reserve( aTopic.size() + 1 + aPayload.size() );
+    message.append( aTopic );
+    message.push_back( '\0' );
+    message.append( aPayload );
+
+    m_publisher->Publish( message );
+}
+
+
 void KICAD_API_SERVER::onApiRequest( std::string* aRequest )
 {
+    if( *aRequest == API_STATS_REQUEST )
+    {
+        m_server->Reply( GetStats() );
+        return;
+    }
+
+    m_requestTimer.Start();
+
     if( !m_readyToReply )
     {
         ApiResponse notHandled;
@@ -193,6 +249,23 @@ void KICAD_API_SERVER::onApiRequest( std::string* aRequest )
         return;
     }
 
+    ApiRequest request;
+
+    if( request.ParseFromString( *aRequest ) )
+    {
+        std::lock_guard<std::recursive_mutex> lock( m_handlersMutex );
+
+        for( API_HANDLER* handler : m_handlers )
+        {
+            if( handler->IsThreadSafe( request ) )
+            {
+                // No need to wait for the event loop, which may be busy for a while
+                handleRequest( request );
+                return;
+            }
+        }
+    }
+
     wxCommandEvent* evt = new wxCommandEvent( API_REQUEST_EVENT );
 
     // We don't actually need write access to this string, but client data is non-const
@@ -214,36 +287,43 @@ void KICAD_API_SERVER::handleApiEvent( wxCommandEvent& aEvent )
         error.mutable_header()->set_kicad_token( m_token );
         error.mutable_status()->set_status( ApiStatusCode::AS_BAD_REQUEST );
         error.mutable_status()->set_error_message( "request could not be parsed" );
-        m_server->Reply( error.SerializeAsString() );
-
-        if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
-            log( "Response (ERROR): " + error.Utf8DebugString() );
+        reply( error, "<unparseable request>", m_requestTimer.msecs(), 0.0, true );
+        return;
     }
 
+    std::lock_guard<std::recursive_mutex> lock( m_handlersMutex );
+    handleRequest( request );
+}
+
+
+void KICAD_API_SERVER::handleRequest( ApiRequest& aRequest )
+{
+    double queueWait = m_requestTimer.msecs();
+
     if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
-        log( "Request: " + request.Utf8DebugString() );
+        log( "Request: " + aRequest.Utf8DebugString() );
 
-    if( !request.header().kicad_token().empty() &&
-        request.header().kicad_token().compare( m_token ) != 0 )
+    std::string type = "<unparseable Any>";
+    google::protobuf::Any::ParseAnyTypeUrl( aRequest.message().type_url(), &type );
+
+    if( !aRequest.header().kicad_token().empty() &&
+        aRequest.header().kicad_token().compare( m_token ) != 0 )
     {
         ApiResponse error;
         error.mutable_header()->set_kicad_token( m_token );
         error.mutable_status()->set_status( ApiStatusCode::AS_TOKEN_MISMATCH );
         error.mutable_status()->set_error_message(
                 "the provided kicad_token did not match this KiCad instance's token" );
-        m_server->Reply( error.SerializeAsString() );
-
-        if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
-            log( "Response (ERROR): " + error.Utf8DebugString() );
-
+        reply( error, type, queueWait, 0.0, true );
         return;
     }
 
+    PROF_TIMER handlerTimer;
     API_RESULT result;
 
     for( API_HANDLER* handler : m_handlers )
     {
-        result = handler->Handle( request );
+        result = handler->Handle( aRequest );
 
         if( result.has_value() )
             break;
@@ -251,15 +331,12 @@ void KICAD_API_SERVER::handleApiEvent( wxCommandEvent& aEvent )
             break;
     }
 
-    // Note: at the point we call Reply(), we no longer own requestString.
+    handlerTimer.Stop();
 
     if( result.has_value() )
     {
         result->mutable_header()->set_kicad_token( m_token );
-        m_server->Reply( result->SerializeAsString() );
-
-        if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
-            log( "Response: " + result->Utf8DebugString() );
+        reply( *result, type, queueWait, handlerTimer.msecs(), false );
     }
     else
     {
@@ -269,17 +346,99 @@ void KICAD_API_SERVER::handleApiEvent( wxCommandEvent& aEvent )
 
         if( result.error().status() == ApiStatusCode::AS_UNHANDLED )
         {
-            std::string type = "<unparseable Any>";
-            google::protobuf::Any::ParseAnyTypeUrl( request.message().type_url(), &type );
             std::string msg = fmt::format( "no handler available for request of type {}", type );
             error.mutable_status()->set_error_message( msg );
         }
 
-        m_server->Reply( error.SerializeAsString() );
+        reply( error, type, queueWait, handlerTimer.msecs(), true );
+    }
+}
+
+
+void KICAD_API_SERVER::reply( ApiResponse& aResponse, const std::string& aType,
+                              double aQueueWait, double aHandlerTime, bool aError )
+{
+    PROF_TIMER  serializeTimer;
+    std::string response = aResponse.SerializeAsString();
+
+    serializeTimer.Stop();
+
+    size_t size = response.size();
+    m_server->Reply( std::move( response ) );
+
+    {
+        std::lock_guard<std::mutex> lock( m_statsMutex );
+        COMMAND_STATS&              stats = m_stats[aType];
+
+        stats.count++;
+        stats.errors += aError ? 1 : 0;
+        stats.queueWait.Add( aQueueWait );
+        stats.handler.Add( aHandlerTime );
+        stats.serialization.Add( serializeTimer.msecs() );
+    }
+
+    wxLogTrace( traceApi, wxString::Format( "Server: %s took %0.3f ms (queued %0.3f ms, handler "
+                                            "%0.3f ms, serialization %0.3f ms, %zu bytes)",
+                                            aType, aQueueWait + aHandlerTime
+                                                           + serializeTimer.msecs(),
+                                            aQueueWait, aHandlerTime, serializeTimer.msecs(),
+                                            size ) );
+
+    if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
+    {
+        log( ( aError ? "Response (ERROR): " : "Response: " ) + aResponse.Utf8DebugString() );
+        log( fmt::format( "Timing: queued {:.3f} ms, handler {:.3f} ms, serialization {:.3f} ms\n",
+                          aQueueWait, aHandlerTime, serializeTimer.msecs() ) );
+    }
+}
+
+
+void KICAD_API_SERVER::LATENCY_HISTOGRAM::Add( double aMsecs )
+{
+    double micros = std::max( aMsecs * 1000.0, 0.0 );
+    size_t bucket = 0;
+
+    // Bucket i holds the samples below 2^i us
+    if( micros >= 1.0 )
+        bucket = static_cast<size_t>( std::floor( std::log2( micros ) ) ) + 1;
+
+    buckets[ std::min( bucket, buckets.size() - 1 ) ]++;
+    count++;
+    total += aMsecs;
+    max = std::max( max, aMsecs );
+}
 
-        if( ADVANCED_CFG::GetCfg().m_EnableAPILogging )
-            log( "Response (ERROR): " + error.Utf8DebugString() );
+
+std::string KICAD_API_SERVER::GetStats() const
+{
+    auto histogram =
+            []( const LATENCY_HISTOGRAM& aHistogram )
+            {
+                nlohmann::json js;
+
+                js["count"] = aHistogram.count;
+                js["mean_ms"] = aHistogram.count ? aHistogram.total / aHistogram.count : 0.0;
+                js["max_ms"] = aHistogram.max;
+                js["buckets_log2_us"] = aHistogram.buckets;
+                return js;
+            };
+
+    nlohmann::json commands = nlohmann::json::object();
+
+    std::lock_guard<std::mutex> lock( m_statsMutex );
+
+    for( const auto& [type, stats] : m_stats )
+    {
+        nlohmann::json& js = commands[type];
+
+        js["count"] = stats.count;
+        js["errors"] = stats.errors;
+        js["queue_wait"] = histogram( stats.queueWait );
+        js["handler"] = histogram( stats.handler );
+        js["serialization"] = histogram( stats.serialization );
     }
+
+    return nlohmann::json( { { "commands", commands } } ).dump();
 }
 
 
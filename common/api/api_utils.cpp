@@ -118,12 +118,27 @@ KICOMMON_API BOX2I UnpackBox2( const types::Box2& aInput )
 
 KICOMMON_API void PackPolyLine( types::PolyLine& aOutput, const SHAPE_LINE_CHAIN& aSlc )
 {
+    google::protobuf::RepeatedPtrField<types::PolyLineNode>* nodes = aOutput.mutable_nodes();
+
+    // An arc takes one node for several points, so this can over-reserve a little
+    nodes->Reserve( nodes->size() + aSlc.PointCount() );
+
+    // Zone fills and most other polygons have no arcs: skip the per-vertex arc lookups
+    if( aSlc.ArcCount() == 0 )
+    {
+        for( const VECTOR2I& point : aSlc.CPoints() )
+            PackVector2( *nodes->Add()->mutable_point(), point );
+
+        aOutput.set_closed( aSlc.IsClosed() );
+        return;
+    }
+
     for( int vertex = 0; vertex < aSlc.PointCount(); vertex = aSlc.NextShape( vertex ) )
     {
         if( vertex < 0 )
             break;
 
-        types::PolyLineNode* node = aOutput.mutable_nodes()->Add();
+        types::PolyLineNode* node = nodes->Add();
 
         if( aSlc.IsPtOnArc( vertex ) )
         {
@@ -150,6 +165,8 @@ KICOMMON_API SHAPE_LINE_CHAIN UnpackPolyLine( const types::PolyLine& aInput )
 {
     SHAPE_LINE_CHAIN slc;
 
+    slc.ReservePoints( aInput.nodes_size() );
+
     for( const types::PolyLineNode& node : aInput.nodes() )
     {
         if( node.has_point() )
@@ -173,6 +190,8 @@ KICOMMON_API SHAPE_LINE_CHAIN UnpackPolyLine( const types::PolyLine& aInput )
 
 KICOMMON_API void PackPolySet( types::PolySet& aOutput, const SHAPE_POLY_SET& aInput )
 {
+    aOutput.mutable_polygons()->Reserve( aOutput.polygons_size() + aInput.OutlineCount() );
+
     for( int idx = 0; idx < aInput.OutlineCount(); ++idx )
     {
         const SHAPE_POLY_SET::POLYGON& poly = aInput.Polygon( idx );
@@ -185,6 +204,8 @@ KICOMMON_API void PackPolySet( types::PolySet& aOutput, const SHAPE_POLY_SET& aI
 
         if( poly.size() > 1 )
         {
+            polyMsg->mutable_holes()->Reserve( static_cast<int>( poly.size() ) - 1 );
+
             for( size_t hole = 1; hole < poly.size(); ++hole )
             {
                 types::PolyLine* pl = polyMsg->mutable_holes()->Add();
@@ -202,6 +223,7 @@ KICOMMON_API SHAPE_POLY_SET UnpackPolySet( const types::PolySet& aInput )
     for( const types::PolygonWithHoles& polygonWithHoles : aInput.polygons() )
     {
         SHAPE_POLY_SET::POLYGON polygon;
+        polygon.reserve( 1 + polygonWithHoles.holes_size() );
 
         polygon.emplace_back( UnpackPolyLine( polygonWithHoles.outline() ) );
 
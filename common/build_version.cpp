@@ -29,6 +29,8 @@
 #include <kiplatform/app.h>
 #include <font/version_info.h>
 #include <build_version.h>
+#include <advanced_config.h>
+#include <memory_usage.h>
 
 #include <tuple>
 #include <mutex>
@@ -395,5 +397,12 @@ wxString GetVersionInfoData( const wxString& aTitle, bool aHtml, bool aBrief )
                                         locale->GetCanonicalName() ) );
     }
 
+    if( ADVANCED_CFG::GetCfg().m_ShowMemoryUsage )
+    {
+        aMsg << eol;
+        aMsg << "Memory usage (estimated):" << eol;
+        aMsg << MEMORY_USAGE::Report( indent4, eol );
+    }
+
     return aMsg;
 }
@@ -18,6 +18,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <mutex>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/locale.hpp>
 #include <fmt/core.h>
@@ -40,6 +42,7 @@
 #endif
 
 #include <sql.h> // SQL_IDENTIFIER_QUOTE_CHAR
+#include <sqlext.h> // SQL_ATTR_CONNECTION_POOLING
 
 #include <wx/log.h>
 
@@ -121,6 +124,19 @@ DATABASE_CONNECTION::~DATABASE_CONNECTION()
 
 void DATABASE_CONNECTION::init()
 {
+    // Let the driver manager keep closed connections around, so reconnecting or opening the
+    // same database from another library doesn't pay for a new login.  This is process wide and
+    // must be set before nanodbc allocates its first environment.
+    static std::once_flag enablePooling;
+
+    std::call_once( enablePooling,
+                    []()
+                    {
+                        SQLSetEnvAttr( SQL_NULL_HANDLE, SQL_ATTR_CONNECTION_POOLING,
+                                       reinterpret_cast<SQLPOINTER>( SQL_CP_ONE_PER_DRIVER ),
+                                       SQL_IS_INTEGER );
+                    } );
+
     m_cache = std::make_unique<DB_CACHE_TYPE>( 10, 1 );
 }
 
@@ -341,11 +357,11 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
     if( m_cache->Get( tableName, cacheEntry ) )
     {
-        if( cacheEntry.count( aWhere.second ) )
+        if( cacheEntry->count( aWhere.second ) )
         {
             wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                         tableName, aWhere.second );
-            aResult = cacheEntry.at( aWhere.second );
+            aResult = cacheEntry->at( aWhere.second );
             return true;
         }
     }
@@ -358,11 +374,11 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
         if( m_cache->Get( tableName, cacheEntry ) )
         {
-            if( cacheEntry.count( aWhere.second ) )
+            if( cacheEntry->count( aWhere.second ) )
             {
                 wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - cache hit" ),
                             tableName, aWhere.second );
-                aResult = cacheEntry.at( aWhere.second );
+                aResult = cacheEntry->at( aWhere.second );
                 return true;
             }
         }
@@ -545,7 +561,7 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
 
         timer.Stop();
 
-        DB_CACHE_TYPE::CACHE_VALUE cacheEntry;
+        std::map<std::string, ROW> cacheEntry;
 
         auto handleException =
                 [&]( std::runtime_error& aException, const std::string& aExtraContext = "" )
@@ -644,7 +660,8 @@ bool DATABASE_CONNECTION::selectAllAndCache( const std::string& aTable, const st
         wxLogTrace( traceDatabase, wxT( "selectAllAndCache from %s completed in %0.1f ms" ), aTable,
                     timer.msecs() );
 
-        m_cache->Put( aTable, cacheEntry );
+        m_cache->Put( aTable,
+                      std::make_shared<const std::map<std::string, ROW>>( std::move( cacheEntry ) ) );
         return true;
     }
     catch( std::exception& e )
@@ -698,9 +715,9 @@ bool DATABASE_CONNECTION::SelectAll( const std::string& aTable, const std::strin
 
     wxLogTrace( traceDatabase, wxT( "SelectAll: `%s` - returning cached results" ), aTable );
 
-    aResults.reserve( cacheEntry.size() );
+    aResults.reserve( cacheEntry->size() );
 
-    for( auto &[ key, row ] : cacheEntry )
+    for( auto &[ key, row ] : *cacheEntry )
         aResults.emplace_back( row );
 
     return true;
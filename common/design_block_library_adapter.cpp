@@ -26,6 +26,7 @@
 #include <design_block_io.h>
 #include <env_vars.h>
 #include <ki_exception.h>
+#include <libraries/library_metadata_cache.h>
 #include <thread_pool.h>
 #include <trace_helpers.h>
 
@@ -258,7 +259,7 @@ void DESIGN_BLOCK_LIBRARY_ADAPTER::AsyncLoad()
                     }
 
                     ++m_loadCount;
-                }, BS::pr::lowest ) );
+                }, PoolPriority( TASK_PRIORITY::BACKGROUND ) ) );
     }
 
     // Cleanup libraries that were removed from the table
@@ -296,6 +297,29 @@ std::vector<DESIGN_BLOCK*> DESIGN_BLOCK_LIBRARY_ADAPTER::GetDesignBlocks( const
     std::map<std::string, UTF8> options = lib->row->GetOptionsMap();
     wxArrayString blockNames;
 
+    LIBRARY_METADATA_CACHE& cache = m_manager.MetadataCache();
+    wxString                path = getUri( lib->row );
+    long long               stamp = LIBRARY_METADATA_CACHE::LibraryStamp( path );
+
+    std::vector<LIBRARY_METADATA_CACHE::ITEM> items;
+
+    // An unchanged library is listed without reading the metadata of each of its blocks
+    if( cache.GetItems( LIBRARY_TABLE_TYPE::DESIGN_BLOCK, path, stamp, items ) )
+    {
+        for( const LIBRARY_METADATA_CACHE::ITEM& item : items )
+        {
+            DESIGN_BLOCK* block = new DESIGN_BLOCK();
+            block->SetLibId( LIB_ID( wxEmptyString, item.m_name ) );
+            block->SetLibDescription( item.m_description );
+            block->SetKeywords( item.m_keywords );
+            blocks.emplace_back( block );
+        }
+
+        return blocks;
+    }
+
+    bool complete = true;
+
     try
     {
         dbplugin( lib )->DesignBlockEnumerate( blockNames, getUri( lib->row ), false, &options );
@@ -303,6 +327,7 @@ std::vector<DESIGN_BLOCK*> DESIGN_BLOCK_LIBRARY_ADAPTER::GetDesignBlocks( const
     catch( IO_ERROR& e )
     {
         wxLogTrace( traceLibraries, "DB: Exception enumerating library %s: %s", lib->row->Nickname(), e.What() );
+        complete = false;
     }
 
     for( const wxString& blockName : blockNames )
@@ -314,9 +339,19 @@ std::vector<DESIGN_BLOCK*> DESIGN_BLOCK_LIBRARY_ADAPTER::GetDesignBlocks( const
         catch( IO_ERROR& e )
         {
             wxLogTrace( traceLibraries, "DB: Exception enumerating design block %s: %s", blockName, e.What() );
+            complete = false;
         }
     }
 
+    // Don't remember a partial listing: the failing blocks must be retried next time
+    if( complete && stamp )
+    {
+        for( const DESIGN_BLOCK* block : blocks )
+            items.push_back( { block->GetName(), block->GetLibDescription(), block->GetKeywords() } );
+
+        cache.SetItems( LIBRARY_TABLE_TYPE::DESIGN_BLOCK, path, stamp, std::move( items ) );
+    }
+
     return blocks;
 }
 
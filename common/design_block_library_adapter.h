@@ -49,7 +49,13 @@ public:
     // Currently unused for design blocks
     std::optional<LIB_STATUS> GetLibraryStatus( const wxString& aNickname ) const override { return std::nullopt; }
 
-    /// @return all the design blocks in the given library, if it exists and is loaded (or an empty list)
+    /**
+     * @return all the design blocks in the given library, if it exists and is loaded (or an empty list).
+     *
+     * Libraries unchanged since they were last listed are served from the library metadata cache;
+     * such blocks only carry their name, description and keywords.  Use LoadDesignBlock() to get
+     * the files and fields of a block.
+     */
     std::vector<DESIGN_BLOCK*> GetDesignBlocks( const wxString& aNickname );
 
     /// @return all the names of design blocks in the given library, if it exists and is loaded (or an empty list)
@@ -27,6 +27,8 @@
 #include <wx/tokenzr.h>
 #include <settings/app_settings.h>
 #include <string_utils.h>
+#include <thread_pool.h>
+#include <libraries/library_metadata_cache.h>
 #include <eda_pattern_match.h>
 #include <design_block.h>
 #include <design_block_library_adapter.h>
@@ -60,19 +62,37 @@ void DESIGN_BLOCK_TREE_MODEL_ADAPTER::AddLibraries( EDA_BASE_FRAME* aParent )
     PROJECT_FILE&    project = aParent->Prj().GetProjectFile();
     LIBRARY_MANAGER& manager = Pgm().GetLibraryManager();
 
+    std::vector<const LIBRARY_TABLE_ROW*> rows;
+
     for( const LIBRARY_TABLE_ROW* row : manager.Rows( LIBRARY_TABLE_TYPE::DESIGN_BLOCK ) )
     {
-        if( row->Hidden() )
-            continue;
+        if( !row->Hidden() )
+            rows.push_back( row );
+    }
+
+    // Each library has its own plugin, so libraries are read in parallel; the tree itself is
+    // only built on this thread, in table order.
+    std::vector<std::vector<LIB_TREE_ITEM*>> libBlocks( rows.size() );
+    thread_pool&                             tp = GetKiCadThreadPool();
 
-        wxString libName = row->Nickname();
+    tp.submit_loop( size_t( 0 ), rows.size(),
+            [&]( size_t aIdx )
+            {
+                libBlocks[aIdx] = getDesignBlocks( aParent, rows[aIdx]->Nickname() );
+            } ).wait();
+
+    for( size_t ii = 0; ii < rows.size(); ++ii )
+    {
+        wxString libName = rows[ii]->Nickname();
 
         bool pinned = alg::contains( cfg->m_Session.pinned_design_block_libs, libName )
                       || alg::contains( project.m_PinnedDesignBlockLibs, libName );
 
-        DoAddLibrary( libName, row->Description(), getDesignBlocks( aParent, libName ), pinned, true );
+        DoAddLibrary( libName, rows[ii]->Description(), libBlocks[ii], pinned, true );
     }
 
+    manager.MetadataCache().Save();
+
     m_tree.AssignIntrinsicRanks( m_shownColumns );
 }
 
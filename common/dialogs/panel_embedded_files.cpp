@@ -490,6 +490,8 @@ void PANEL_EMBEDDED_FILES::onExportFiles( wxCommandEvent& event )
             continue;
 
 
+        EMBEDDED_FILES::EnsureDecompressed( *file );
+
         wxFFileOutputStream out( fileName.GetFullPath() );
 
         if( !out.IsOk() )
@@ -24,6 +24,7 @@
  * or you may write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
+#include <advanced_config.h>
 #include <eda_draw_frame.h>
 #include <kiface_base.h>
 #include <macros.h>
@@ -37,6 +38,7 @@
 #include <gal/painter.h>
 #include <base_screen.h>
 #include <gal/cursors.h>
+#include <gal/frame_profiler.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/opengl/opengl_gal.h>
 #include <gal/cairo/cairo_gal.h>
@@ -85,7 +87,8 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
         m_eventDispatcher( nullptr ),
         m_lostFocus( false ),
         m_stealsFocus( true ),
-        m_statusPopup( nullptr )
+        m_statusPopup( nullptr ),
+        m_showFrameProfile( false )
 {
 #ifdef _WIN32
     // need to fix broken cairo rendering on Windows with wx 3.3
@@ -165,6 +168,9 @@ EDA_DRAW_PANEL_GAL::EDA_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
              wxTimerEventHandler( EDA_DRAW_PANEL_GAL::onRefreshTimer ), nullptr, this );
 
     Connect( wxEVT_SHOW, wxShowEventHandler( EDA_DRAW_PANEL_GAL::onShowEvent ), nullptr, this );
+
+    if( ADVANCED_CFG::GetCfg().m_ShowFrameProfile )
+        SetShowFrameProfile( true );
 }
 
 
@@ -176,6 +182,14 @@ EDA_DRAW_PANEL_GAL::~EDA_DRAW_PANEL_GAL()
 
     wxASSERT( !m_drawing );
 
+    const wxString& traceFile = ADVANCED_CFG::GetCfg().m_FrameProfileTraceFile;
+
+    if( m_showFrameProfile && !traceFile.IsEmpty() )
+    {
+        if( !KIGFX::FRAME_PROFILER::Get().ExportChromeTrace( traceFile ) )
+            wxLogTrace( traceDrawPanel, wxS( "Could not write frame trace to %s" ), traceFile );
+    }
+
     delete m_viewControls;
     delete m_view;
     delete m_gal;
@@ -244,6 +258,9 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
 
     bool isDirty = false;
 
+    KIGFX::FRAME_PROFILER& profiler = KIGFX::FRAME_PROFILER::Get();
+    profiler.BeginFrame();
+
     cntTotal.Start();
 
     try
@@ -252,6 +269,7 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
 
         try
         {
+            KIGFX::FRAME_PROFILER::SCOPE scope( "view-update-items" );
             m_view->UpdateItems();
         }
         catch( std::out_of_range& err )
@@ -270,6 +288,10 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
             KIGFX::GAL_DRAWING_CONTEXT ctx( m_gal );
             cntCtx.Stop();
 
+            // The timings change every frame, so the overlay holding them is always redrawn
+            if( m_showFrameProfile )
+                m_view->MarkTargetDirty( KIGFX::TARGET_OVERLAY );
+
             if( m_view->IsTargetDirty( KIGFX::TARGET_OVERLAY )
                 && !m_gal->HasTarget( KIGFX::TARGET_OVERLAY ) )
             {
@@ -304,6 +326,9 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
                 m_view->Redraw();
                 cntRedraw.Stop();
                 isDirty = true;
+
+                if( m_showFrameProfile )
+                    drawFrameProfile();
             }
 
             m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
@@ -346,12 +371,55 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
         );
     }
 
+    profiler.EndFrame();
+
     m_lastRepaintEnd = wxGetLocalTimeMillis();
 
     return true;
 }
 
 
+void EDA_DRAW_PANEL_GAL::SetShowFrameProfile( bool aShow )
+{
+    m_showFrameProfile = aShow;
+
+    if( aShow )
+        KIGFX::FRAME_PROFILER::Get().SetEnabled( true );
+
+    Refresh();
+}
+
+
+void EDA_DRAW_PANEL_GAL::drawFrameProfile()
+{
+    KIGFX::GAL_SCOPED_ATTRS attrs( *m_gal, KIGFX::GAL_SCOPED_ATTRS::ALL_ATTRS );
+
+    const double lineHeight = m_view->ToWorld( 14.0 );
+    VECTOR2D     pos = m_view->ToWorld( VECTOR2D( 10.0, 10.0 ) );
+
+    KIGFX::RENDER_TARGET target = m_gal->GetTarget();
+
+    m_gal->SetTarget( KIGFX::TARGET_OVERLAY );
+    m_gal->SetLayerDepth( m_gal->GetMinDepth() );
+    m_gal->SetIsFill( false );
+    m_gal->SetIsStroke( true );
+    m_gal->SetStrokeColor( m_painter->GetSettings()->GetCursorColor() );
+    m_gal->SetLineWidth( m_view->ToWorld( 1.0 ) );
+    m_gal->SetGlyphSize( VECTOR2I( KiROUND( lineHeight * 0.7 ), KiROUND( lineHeight * 0.7 ) ) );
+    m_gal->SetHorizontalJustify( GR_TEXT_H_ALIGN_LEFT );
+    m_gal->SetVerticalJustify( GR_TEXT_V_ALIGN_TOP );
+
+    for( const auto& [stage, msecs] : KIGFX::FRAME_PROFILER::Get().GetLastFrameSummary() )
+    {
+        m_gal->BitmapText( wxString::Format( wxS( "%s: %.2f ms" ), stage, msecs ), pos,
+                           ANGLE_HORIZONTAL );
+        pos.y += lineHeight;
+    }
+
+    m_gal->SetTarget( target );
+}
+
+
 void EDA_DRAW_PANEL_GAL::onSize( wxSizeEvent& aEvent )
 {
     // If we get a second wx update call before the first finishes, don't crash
@@ -30,7 +30,6 @@
 #include <wx/log.h>
 
 #include <eda_item.h>
-#include <locale_io.h>
 #include <string_utils.h>
 #include <drawing_sheet/ds_data_item.h>
 #include <drawing_sheet/ds_data_model.h>
@@ -202,7 +201,6 @@ wxString convertLegacyVariableRefs( const wxString& aTextbase )
 void DRAWING_SHEET_PARSER::Parse( DS_DATA_MODEL* aLayout )
 {
     DS_DATA_ITEM* item;
-    LOCALE_IO     toggle;
 
     NeedLEFT();
     T token = NextTok();
@@ -888,7 +886,7 @@ int DRAWING_SHEET_PARSER::parseInt()
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    return atoi( CurText() );
+    return (int) parseLong();
 }
 
 
@@ -23,6 +23,7 @@
  */
 
 #include <fast_float/fast_float.h>
+#include <charconv>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>         // bsearch()
@@ -64,7 +65,9 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const
     commentsAreTokens( false ),
     keywords( aKeywordTable ),
     keywordCount( aKeywordCount ),
-    keywordsLookup( aKeywordMap )
+    keywordsLookup( aKeywordMap ),
+    viewLines( false ),
+    curTextPending( false )
 {
     PushReader( new FILE_LINE_READER( aFile, aFilename ) );
     init();
@@ -84,7 +87,9 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const
         commentsAreTokens( false ),
         keywords( aKeywordTable ),
         keywordCount( aKeywordCount ),
-        keywordsLookup( aKeywordMap )
+        keywordsLookup( aKeywordMap ),
+        viewLines( false ),
+        curTextPending( false )
 {
     PushReader( new STRING_LINE_READER( aClipboardTxt, aSource.IsEmpty() ? wxString( FMT_CLIPBOARD )
                                                                          : aSource ) );
@@ -105,7 +110,9 @@ DSNLEXER::DSNLEXER( const KEYWORD* aKeywordTable, unsigned aKeywordCount, const
         commentsAreTokens( false ),
         keywords( aKeywordTable ),
         keywordCount( aKeywordCount ),
-        keywordsLookup( aKeywordMap )
+        keywordsLookup( aKeywordMap ),
+        viewLines( false ),
+        curTextPending( false )
 {
     if( aLineReader )
         PushReader( aLineReader );
@@ -128,7 +135,9 @@ DSNLEXER::DSNLEXER( const std::string& aSExpression, const wxString& aSource ) :
         commentsAreTokens( false ),
         keywords( empty_keywords ),
         keywordCount( 0 ),
-        keywordsLookup( nullptr )
+        keywordsLookup( nullptr ),
+        viewLines( false ),
+        curTextPending( false )
 {
     PushReader( new STRING_LINE_READER( aSExpression, aSource.IsEmpty() ? wxString( FMT_CLIPBOARD )
                                                                         : aSource ) );
@@ -190,7 +199,8 @@ bool DSNLEXER::SyncLineReaderWith( DSNLEXER& aLexer )
 
     // Sync these parameters is not mandatory, but could help
     // for instance in debug
-    curText = aLexer.curText;
+    curText = aLexer.CurStr();
+    curTextPending = false;
     curOffset = aLexer.curOffset;
 
     return true;
@@ -202,6 +212,7 @@ void DSNLEXER::PushReader( LINE_READER* aLineReader )
     readerStack.push_back( aLineReader );
     reader = aLineReader;
     start  = (const char*) (*reader);
+    viewLines = reader->CanViewLines();
 
     // force a new readLine() as first thing.
     limit = start;
@@ -222,6 +233,7 @@ LINE_READER* DSNLEXER::PopReader()
         {
             reader = readerStack.back();
             start  = reader->Line();
+            viewLines = reader->CanViewLines();
 
             // force a new readLine() as first thing.
             limit = start;
@@ -232,6 +244,7 @@ LINE_READER* DSNLEXER::PopReader()
             reader = nullptr;
             start  = dummy;
             limit  = dummy;
+            viewLines = false;
         }
     }
     return ret;
@@ -542,6 +555,7 @@ int DSNLEXER::NextTok()
 {
     const char*   cur  = next;
     const char*   head = cur;
+    bool          numberPending = false;
 
     prevTok = curTok;
     curSeparator.clear();
@@ -674,7 +688,7 @@ L_read:
                     case 'v':   c = '\x0b';     break;
 
                     case 'x':   // 1 or 2 byte hex escape sequence
-                        for( i = 0; i < 2; ++i )
+                        for( i = 0; i < 2 && head + i < limit; ++i )
                         {
                             if( !isxdigit( head[i] ) )
                                 break;
@@ -695,7 +709,7 @@ L_read:
                     default:    // 1-3 byte octal escape sequence
                         --head;
 
-                        for( i=0; i<3; ++i )
+                        for( i = 0; i < 3 && head + i < limit; ++i )
                         {
                             if( head[i] < '0' || head[i] > '7' )
                                 break;
@@ -725,7 +739,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the run up to the next escape or quote at once
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -806,18 +828,32 @@ L_read:
     }           // specctraMode
 
     // non-quoted token, read it into curText.
-    curText.clear();
-
     head = cur;
+
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
 
-    if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
+    if( isNumber( cur, head ) )
     {
         curTok = DSN_NUMBER;
+
+        // Numbers are mostly converted by parseDouble() and parseLong(), which read them
+        // from the line: when the line outlives the token, copy the text only if asked to.
+        if( viewLines )
+        {
+            curNumber = std::string_view( cur, head - cur );
+            numberPending = true;
+        }
+        else
+        {
+            curText.assign( cur, head );
+        }
+
         goto exit;
     }
 
+    curText.assign( cur, head );
+
     if( specctraMode && curText == "string_quote" )
     {
         curTok = DSN_STRING_QUOTE;
@@ -828,6 +864,10 @@ L_read:
 
 exit:   // single point of exit, no returns elsewhere please.
 
+    // like curText, a pending number stays the current text at EOF
+    if( curTok != DSN_EOF )
+        curTextPending = numberPending;
+
     curOffset = cur - start;
 
     next = head;
@@ -863,7 +903,7 @@ double DSNLEXER::parseDouble()
 {
     // Use fast_float::from_chars which is designed to be locale independent and significantly
     // faster than strtod and std::from_chars
-    const std::string& str = CurStr();
+    std::string_view str = CurStrView();
 
     double                 dval{};
     fast_float::from_chars_result res = fast_float::from_chars( str.data(), str.data() + str.size(), dval,
@@ -877,3 +917,39 @@ double DSNLEXER::parseDouble()
 
     return dval;
 }
+
+
+long DSNLEXER::parseLong()
+{
+    std::string_view str = CurStrView();
+    const char*      first = str.data();
+    const char*      last = first + str.size();
+    long             val = 0;
+
+    if( first < last && *first == '+' )
+        ++first;
+
+    if( std::from_chars( first, last, val ).ec == std::errc() )
+        return val;
+
+    // out of range or not a number, strtol() knows what to return
+    return strtol( CurText(), nullptr, 10 );
+}
+
+
+long DSNLEXER::parseHex()
+{
+    std::string_view str = CurStrView();
+    const char*      first = str.data();
+    const char*      last = first + str.size();
+    long             val = 0;
+
+    // from_chars() doesn't take the prefix strtol() allows for base 16
+    if( last - first > 2 && first[0] == '0' && ( first[1] == 'x' || first[1] == 'X' ) )
+        first += 2;
+
+    if( std::from_chars( first, last, val, 16 ).ec == std::errc() )
+        return val;
+
+    return strtol( CurText(), nullptr, 16 );
+}
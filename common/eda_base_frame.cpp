@@ -1653,6 +1653,24 @@ void EDA_BASE_FRAME::PushCommandToUndoList( PICKED_ITEMS_LIST* aNewitem )
         if( extraitems > 0 )
             ClearUndoORRedoList( UNDO_LIST, extraitems );
     }
+
+    // Then drop the oldest commands while over the memory budget, always keeping the new one
+    if( int budgetMB = ADVANCED_CFG::GetCfg().m_UndoMemoryBudgetMB; budgetMB > 0 )
+    {
+        const size_t budget = static_cast<size_t>( budgetMB ) * 1024 * 1024;
+        size_t       total = 0;
+
+        for( PICKED_ITEMS_LIST* command : m_undoList.m_CommandsList )
+            total += command->GetMemoryEstimate();
+
+        int extraitems = 0;
+
+        while( total > budget && extraitems + 1 < (int) m_undoList.m_CommandsList.size() )
+            total -= m_undoList.m_CommandsList[extraitems++]->GetMemoryEstimate();
+
+        if( extraitems > 0 )
+            ClearUndoORRedoList( UNDO_LIST, extraitems );
+    }
 }
 
 
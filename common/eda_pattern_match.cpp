@@ -389,7 +389,8 @@ const std::map<wxString, double> EDA_PATTERN_MATCH_RELATIONAL::m_units = {
 
 EDA_COMBINED_MATCHER::EDA_COMBINED_MATCHER( const wxString& aPattern,
                                             COMBINED_MATCHER_CONTEXT aContext ) :
-        m_pattern( aPattern )
+        m_pattern( aPattern ),
+        m_context( aContext )
 {
     switch( aContext )
     {
@@ -191,13 +191,76 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
+/**
+ * Append the decimal form of \a aValue / 10^aDecimals to \a aBuf, without trailing zeros.
+ */
+static void appendDecimal( std::string& aBuf, int aValue, int aDecimals )
+{
+    static constexpr uint32_t powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                                10000000, 100000000, 1000000000 };
+
+    char      digits[16];
+    uint32_t  magnitude = aValue < 0 ? 0u - (uint32_t) aValue : (uint32_t) aValue;
+    uint32_t  integer = magnitude / powersOfTen[aDecimals];
+    uint32_t  fraction = magnitude % powersOfTen[aDecimals];
+
+    if( aValue < 0 )
+        aBuf.push_back( '-' );
+
+    aBuf.append( digits, std::to_chars( digits, digits + sizeof( digits ), integer ).ptr );
+
+    if( fraction == 0 )
+        return;
+
+    while( fraction % 10 == 0 )
+    {
+        fraction /= 10;
+        aDecimals--;
+    }
+
+    char* end = std::to_chars( digits, digits + sizeof( digits ), fraction ).ptr;
+
+    aBuf.push_back( '.' );
+    aBuf.append( aDecimals - ( end - digits ), '0' );
+    aBuf.append( digits, end );
+}
+
+
+/**
+ * @return the number of decimals of values at \a aScale when it is an exact power of ten that
+ *         appendDecimal() can handle, or -1.
+ */
+static int powerOfTenDecimals( double aScale )
+{
+    double power = 1.0;
+
+    for( int decimals = 0; decimals <= 9; ++decimals, power *= 10.0 )
+    {
+        if( aScale == power )
+            return decimals;
+    }
+
+    return -1;
+}
+
+
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, const int aValue,
                                                  const EDA_DATA_TYPE aDataType )
 {
     std::string buf;
+    double      scale = GetScaleForInternalUnitType( aIuScale, aDataType );
+
+    // Integers at a power of ten scale have an exact decimal form, which is what the formats
+    // below produce.  Write it straight from the integer: this is the hot path of file saving.
+    if( int decimals = powerOfTenDecimals( scale ); decimals >= 0 )
+    {
+        appendDecimal( buf, aValue, decimals );
+        return buf;
+    }
+
     double engUnits = aValue;
 
-    engUnits /= GetScaleForInternalUnitType( aIuScale, aDataType );
+    engUnits /= scale;
 
     if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
     {
@@ -228,8 +291,22 @@ std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, c
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const VECTOR2I&     aPoint )
 {
-    return FormatInternalUnits( aIuScale, aPoint.x ) + " "
-           + FormatInternalUnits( aIuScale, aPoint.y );
+    int decimals = powerOfTenDecimals( aIuScale.IU_PER_MM );
+
+    if( decimals < 0 )
+    {
+        return FormatInternalUnits( aIuScale, aPoint.x ) + " "
+               + FormatInternalUnits( aIuScale, aPoint.y );
+    }
+
+    std::string buf;
+
+    buf.reserve( 24 );
+    appendDecimal( buf, aPoint.x, decimals );
+    buf.push_back( ' ' );
+    appendDecimal( buf, aPoint.y, decimals );
+
+    return buf;
 }
 
 
@@ -27,8 +27,10 @@
 #include <wx/mstream.h>
 #include <wx/wfstream.h>
 
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 #include <zstd.h>
@@ -36,6 +38,105 @@
 #include <kiid.h>
 #include <mmh3_hash.h>
 #include <paths.h>
+#include <thread_pool.h>
+
+
+namespace
+{
+
+/**
+ * The decompressed data of embedded files, keyed on their checksum.  The least recently used
+ * entries are dropped once the cache holds more than MAX_BYTES.
+ */
+class DECOMPRESSED_CACHE
+{
+public:
+    static DECOMPRESSED_CACHE& Get()
+    {
+        static DECOMPRESSED_CACHE cache;
+        return cache;
+    }
+
+    bool Find( const std::string& aHash, std::vector<char>& aData )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto                        it = m_index.find( aHash );
+
+        if( it == m_index.end() )
+            return false;
+
+        m_entries.splice( m_entries.begin(), m_entries, it->second );
+        aData = it->second->second;
+        return true;
+    }
+
+    void Add( const std::string& aHash, const std::vector<char>& aData )
+    {
+        if( aData.size() > MAX_BYTES / 4 )
+            return;
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_index.count( aHash ) )
+            return;
+
+        m_entries.emplace_front( aHash, aData );
+        m_index[aHash] = m_entries.begin();
+        m_bytes += aData.size();
+
+        while( m_bytes > MAX_BYTES )
+        {
+            m_bytes -= m_entries.back().second.size();
+            m_index.erase( m_entries.back().first );
+            m_entries.pop_back();
+        }
+    }
+
+private:
+    static constexpr size_t MAX_BYTES = 256 * 1024 * 1024;
+
+    using ENTRY = std::pair<std::string, std::vector<char>>;
+
+    std::mutex                                          m_mutex;
+    std::list<ENTRY>                                    m_entries;
+    std::map<std::string, std::list<ENTRY>::iterator>   m_index;
+    size_t                                              m_bytes = 0;
+};
+
+
+/// Serializes the on demand decompression of files that may be shared between threads
+std::mutex g_decompressMutex;
+
+
+EMBEDDED_FILES::RETURN_CODE decompressShared( EMBEDDED_FILES::EMBEDDED_FILE& aFile )
+{
+    if( aFile.IsDecompressed() )
+        return EMBEDDED_FILES::RETURN_CODE::OK;
+
+    std::string hash = aFile.data_hash;
+
+    if( DECOMPRESSED_CACHE::Get().Find( hash, aFile.decompressedData ) )
+    {
+        // Same conversion of legacy checksums as DecompressAndDecode()
+        MMH3_HASH mmh3( EMBEDDED_FILES::Seed() );
+        mmh3.add( aFile.decompressedData );
+        aFile.data_hash = mmh3.digest().ToString();
+        aFile.is_valid = true;
+        return EMBEDDED_FILES::RETURN_CODE::OK;
+    }
+
+    EMBEDDED_FILES::RETURN_CODE result = EMBEDDED_FILES::DecompressAndDecode( aFile );
+
+    if( result == EMBEDDED_FILES::RETURN_CODE::OK )
+    {
+        aFile.is_valid = true;
+        DECOMPRESSED_CACHE::Get().Add( hash, aFile.decompressedData );
+    }
+
+    return result;
+}
+
+} // namespace
 
 
 
@@ -349,19 +450,9 @@ void EMBEDDED_FILES_PARSER::ParseEmbedded( EMBEDDED_FILES* aFiles )
         if( token != T_file )
             Expecting( "file" );
 
+        // The data is decompressed and checked on first access
         if( file )
-        {
-            if( !file->compressedEncodedData.empty() )
-            {
-                EMBEDDED_FILES::DecompressAndDecode( *file );
-
-                if( !file->Validate() )
-                    THROW_PARSE_ERROR( "Checksum error in embedded file " + file->name, CurSource(),
-                                        CurLine(), CurLineNumber(), CurOffset() );
-            }
-
             aFiles->AddFile( file.release() );
-        }
 
         file = std::unique_ptr<EMBEDDED_FILES::EMBEDDED_FILE>( nullptr );
 
@@ -468,27 +559,59 @@ void EMBEDDED_FILES_PARSER::ParseEmbedded( EMBEDDED_FILES* aFiles )
 
     // Add the last file in the collection
     if( file )
-    {
-        if( !file->compressedEncodedData.empty() )
-        {
-            if( EMBEDDED_FILES::DecompressAndDecode( *file ) == EMBEDDED_FILES::RETURN_CODE::CHECKSUM_ERROR )
-                THROW_PARSE_ERROR( "Checksum error in embedded file " + file->name, CurSource(),
-                                    CurLine(), CurLineNumber(), CurOffset() );
-        }
-
         aFiles->AddFile( file.release() );
+}
+
+
+EMBEDDED_FILES::RETURN_CODE EMBEDDED_FILES::EnsureDecompressed( EMBEDDED_FILE& aFile )
+{
+    std::lock_guard<std::mutex> lock( g_decompressMutex );
+
+    RETURN_CODE result = decompressShared( aFile );
+
+    if( result != RETURN_CODE::OK )
+    {
+        wxLogTrace( wxT( "KICAD_EMBED" ), wxT( "Embedded file '%s' could not be decompressed" ),
+                    aFile.name );
     }
+
+    return result;
 }
 
 
-wxFileName EMBEDDED_FILES::GetTemporaryFileName( const wxString& aName ) const
+void EMBEDDED_FILES::DecompressFiles( const std::vector<EMBEDDED_FILE*>& aFiles )
 {
-    wxFileName cacheFile;
+    std::vector<EMBEDDED_FILE*> files;
 
-    auto it = m_files.find( aName );
+    for( EMBEDDED_FILE* file : aFiles )
+    {
+        if( !file->IsDecompressed() )
+            files.push_back( file );
+    }
 
-    if( it == m_files.end() )
-        return cacheFile;
+    // Already on a worker thread (e.g. a library being loaded in the background), or nothing
+    // worth the hand-off
+    if( files.size() < 2 || BS::this_thread::get_pool().has_value() )
+    {
+        for( EMBEDDED_FILE* file : files )
+            EnsureDecompressed( *file );
+
+        return;
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, files.size(),
+                    [&]( const int ii )
+                    {
+                        decompressShared( *files[ii] );
+                    } ).wait();
+}
+
+
+wxFileName EMBEDDED_FILES::cacheFileName( const EMBEDDED_FILE& aFile )
+{
+    wxFileName cacheFile;
 
     cacheFile.AssignDir( PATHS::GetUserCachePath() );
     cacheFile.AppendDir( wxT( "embed" ) );
@@ -502,13 +625,39 @@ wxFileName EMBEDDED_FILES::GetTemporaryFileName( const wxString& aName ) const
         cacheFile.SetPath( wxFileName::GetTempDir() );
     }
 
-    wxFileName inputName( aName );
+    wxFileName inputName( aFile.name );
 
     // Store the cache file name using the data hash to allow for shared data between
     // multiple projects using the same files as well as deconflicting files with the same name
-    cacheFile.SetName( "kicad_embedded_" + it->second->data_hash );
+    cacheFile.SetName( "kicad_embedded_" + aFile.data_hash );
     cacheFile.SetExt( inputName.GetExt() );
 
+    return cacheFile;
+}
+
+
+wxFileName EMBEDDED_FILES::GetTemporaryFileName( const wxString& aName ) const
+{
+    auto it = m_files.find( aName );
+
+    if( it == m_files.end() )
+        return wxFileName();
+
+    wxFileName cacheFile = cacheFileName( *it->second );
+
+    // Written by an earlier session; the data doesn't even need to be decompressed
+    if( cacheFile.FileExists() && cacheFile.IsFileReadable() )
+        return cacheFile;
+
+    if( EnsureDecompressed( *it->second ) != RETURN_CODE::OK )
+    {
+        cacheFile.Clear();
+        return cacheFile;
+    }
+
+    // Decompressing converts legacy checksums, which renames the cache file
+    cacheFile = cacheFileName( *it->second );
+
     if( cacheFile.FileExists() && cacheFile.IsFileReadable() )
         return cacheFile;
 
@@ -536,6 +685,17 @@ const std::vector<wxString>* EMBEDDED_FILES::UpdateFontFiles()
 {
     m_fontFiles.clear();
 
+    // Fonts are needed as soon as the item is drawn, so don't leave them to first access
+    std::vector<EMBEDDED_FILE*> fonts;
+
+    for( const auto& [name, entry] : m_files )
+    {
+        if( entry->type == EMBEDDED_FILE::FILE_TYPE::FONT && !cacheFileName( *entry ).FileExists() )
+            fonts.push_back( entry );
+    }
+
+    DecompressFiles( fonts );
+
     for( const auto& [name, entry] : m_files )
     {
         if( entry->type == EMBEDDED_FILE::FILE_TYPE::FONT )
@@ -22,6 +22,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cmath>
 #include <limits>
 #include <harfbuzz/hb.h>
 #include <harfbuzz/hb-ft.h>
@@ -363,28 +364,27 @@ static const HARFBUZZ_CACHE_ENTRY& getHarfbuzzShape( FT_Face aFace, const wxStri
 }
 
 
+/**
+ * The outline contours of a glyph only depend on the face, the character size it was loaded at
+ * and the fake styles applied by FreeType.  Scaling, rotating, mirroring and placing the glyph
+ * all happen afterwards, so every text using the glyph shares the same cache entry.
+ */
 struct GLYPH_CACHE_KEY {
     FT_Face        face;
     hb_codepoint_t codepoint;
-    VECTOR2D       scale;
+    double         charSize;
     bool           forDrawingSheet;
     bool           fakeItalic;
     bool           fakeBold;
-    bool           mirror;
-    bool           supersub;
-    EDA_ANGLE      angle;
 
     bool operator==(const GLYPH_CACHE_KEY& rhs ) const
     {
         return face == rhs.face
                 && codepoint == rhs.codepoint
-                && scale == rhs.scale
+                && charSize == rhs.charSize
                 && forDrawingSheet == rhs.forDrawingSheet
                 && fakeItalic == rhs.fakeItalic
-                && fakeBold == rhs.fakeBold
-                && mirror == rhs.mirror
-                && supersub == rhs.supersub
-                && angle == rhs.angle;
+                && fakeBold == rhs.fakeBold;
     }
 };
 
@@ -396,8 +396,8 @@ namespace std
     {
         std::size_t operator()( const GLYPH_CACHE_KEY& k ) const
         {
-            return hash_val( k.face, k.codepoint, k.scale.x, k.scale.y, k.forDrawingSheet,
-                             k.fakeItalic, k.fakeBold, k.mirror, k.supersub, k.angle.AsDegrees() );
+            return hash_val( k.face, k.codepoint, k.charSize, k.forDrawingSheet, k.fakeItalic,
+                             k.fakeBold );
         }
     };
 }
@@ -432,6 +432,10 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
 
     VECTOR2I cursor( 0, 0 );
 
+    // Glyphs within a factor of two in size share their triangulation hints
+    const int sizeBucket = std::ilogb( std::max( std::abs( scaleFactor.x ),
+                                                 std::abs( scaleFactor.y ) ) );
+
     if( aGlyphs )
         aGlyphs->reserve( glyphCount );
 
@@ -443,8 +447,8 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
     {
         if( aGlyphs )
         {
-            GLYPH_CACHE_KEY key = { face, glyphInfo[i].codepoint, scaleFactor, m_forDrawingSheet,
-                                    m_fakeItal, m_fakeBold, aMirror, supersub, aAngle };
+            GLYPH_CACHE_KEY key = { face, glyphInfo[i].codepoint, scaler, m_forDrawingSheet,
+                                    m_fakeItal, m_fakeBold };
             GLYPH_DATA&     glyphData = s_glyphCache[ key ];
 
             if( glyphData.m_Contours.empty() )
@@ -503,14 +507,13 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
             std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>();
             std::vector<SHAPE_LINE_CHAIN>  holes;
 
-            for( CONTOUR& c : glyphData.m_Contours )
+            for( const CONTOUR& c : glyphData.m_Contours )
             {
-                std::vector<VECTOR2D> points = c.m_Points;
-                SHAPE_LINE_CHAIN      shape;
+                SHAPE_LINE_CHAIN shape;
 
-                shape.ReservePoints( points.size() );
+                shape.ReservePoints( c.m_Points.size() );
 
-                for( const VECTOR2D& v : points )
+                for( const VECTOR2D& v : c.m_Points )
                 {
                     VECTOR2D pt( v + cursor );
 
@@ -563,14 +566,17 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
                 }
             }
 
-            if( glyphData.m_TriangulationData.empty() )
+            std::vector<std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>>& hints =
+                    glyphData.m_TriangulationData[sizeBucket];
+
+            if( hints.empty() )
             {
                 glyph->CacheTriangulation( false, false );
-                glyphData.m_TriangulationData = glyph->GetTriangulationData();
+                hints = glyph->GetTriangulationData();
             }
             else
             {
-                glyph->CacheTriangulation( glyphData.m_TriangulationData );
+                glyph->CacheTriangulation( hints );
             }
 
             aGlyphs->push_back( std::move( glyph ) );
@@ -33,11 +33,13 @@
 #include <gal/cairo/cairo_gal.h>
 #include <gal/cairo/cairo_compositor.h>
 #include <gal/definitions.h>
+#include <gal/frame_profiler.h>
 #include <geometry/shape_poly_set.h>
 #include <math/vector2wx.h>
 #include <math/util.h> // for KiROUND
 #include <trigo.h>
 #include <bitmap_base.h>
+#include <thread_pool.h>
 
 #include <algorithm>
 #include <cmath>
@@ -1427,6 +1429,8 @@ CAIRO_GAL::~CAIRO_GAL()
 
 void CAIRO_GAL::BeginDrawing()
 {
+    FRAME_PROFILER::SCOPE profile( "cairo-begin-drawing" );
+
     initSurface();
 
     CAIRO_GAL_BASE::BeginDrawing();
@@ -1441,6 +1445,8 @@ void CAIRO_GAL::BeginDrawing()
 
 void CAIRO_GAL::EndDrawing()
 {
+    FRAME_PROFILER::SCOPE profile( "cairo-end-drawing" );
+
     CAIRO_GAL_BASE::EndDrawing();
 
     // Merge buffers on the screen
@@ -1449,34 +1455,61 @@ void CAIRO_GAL::EndDrawing()
 
     // Now translate the raw context data from the format stored
     // by cairo into a format understood by wxImage.
-    int height = m_screenSize.y;
-    int stride = m_stride;
-
-    unsigned char* srcRow = m_bitmapBuffer;
-    unsigned char* dst = m_wxOutput;
+    const int      height = m_screenSize.y;
+    const int      stride = m_stride;
+    const int      rowBytes = m_wxBufferWidth * 3;
+    unsigned char* srcBuffer = m_bitmapBuffer;
+    unsigned char* dstBuffer = m_wxOutput;
+
+    auto convertRows =
+            [=]( int aFirstRow, int aLastRow )
+            {
+                for( int y = aFirstRow; y < aLastRow; y++ )
+                {
+                    const unsigned char* srcRow = srcBuffer + (size_t) y * stride;
+                    unsigned char*       dst = dstBuffer + (size_t) y * rowBytes;
 
-    for( int y = 0; y < height; y++ )
-    {
-        for( int x = 0; x < stride; x += 4 )
-        {
-            const unsigned char* src = srcRow + x;
+                    for( int x = 0; x < stride; x += 4 )
+                    {
+                        const unsigned char* src = srcRow + x;
 
 #if defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
-            // XRGB
-            dst[0] = src[1];
-            dst[1] = src[2];
-            dst[2] = src[3];
+                        // XRGB
+                        dst[0] = src[1];
+                        dst[1] = src[2];
+                        dst[2] = src[3];
 #else
-            // BGRX
-            dst[0] = src[2];
-            dst[1] = src[1];
-            dst[2] = src[0];
+                        // BGRX
+                        dst[0] = src[2];
+                        dst[1] = src[1];
+                        dst[2] = src[0];
 #endif
 
-            dst += 3;
-        }
+                        dst += 3;
+                    }
+                }
+            };
 
-        srcRow += stride;
+    // The conversion touches every pixel of the screen on each frame, which is a noticeable
+    // part of a repaint on large displays.  Rows are independent, so split them over the
+    // thread pool.
+    constexpr int ROWS_PER_BAND = 64;
+    const int     bandCount = ( height + ROWS_PER_BAND - 1 ) / ROWS_PER_BAND;
+
+    if( bandCount > 1 )
+    {
+        thread_pool& tp = GetKiCadThreadPool();
+
+        tp.submit_loop( 0, bandCount,
+                        [&]( int aBand )
+                        {
+                            convertRows( aBand * ROWS_PER_BAND,
+                                         std::min( height, ( aBand + 1 ) * ROWS_PER_BAND ) );
+                        } ).wait();
+    }
+    else
+    {
+        convertRows( 0, height );
     }
 
     wxImage    img( m_wxBufferWidth, m_screenSize.y, m_wxOutput, true );
@@ -0,0 +1,184 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gal/frame_profiler.h>
+
+#include <core/profile.h>
+#include <json_common.h>
+
+#include <wx/string.h>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace KIGFX;
+
+
+FRAME_PROFILER::SCOPE::SCOPE( const char* aName ) :
+        m_name( aName ),
+        m_start( -1 )
+{
+    if( FRAME_PROFILER::Get().IsEnabled() )
+        m_start = GetRunningMicroSecs();
+}
+
+
+FRAME_PROFILER::SCOPE::~SCOPE()
+{
+    if( m_start >= 0 )
+        FRAME_PROFILER::Get().AddEvent( m_name, m_start, GetRunningMicroSecs() - m_start );
+}
+
+
+FRAME_PROFILER& FRAME_PROFILER::Get()
+{
+    static FRAME_PROFILER instance;
+    return instance;
+}
+
+
+FRAME_PROFILER::FRAME_PROFILER() :
+        m_enabled( false ),
+        m_inFrame( false )
+{
+}
+
+
+void FRAME_PROFILER::SetEnabled( bool aEnabled )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_enabled.store( aEnabled );
+    m_inFrame = false;
+
+    if( !aEnabled )
+        m_frames.clear();
+}
+
+
+void FRAME_PROFILER::BeginFrame()
+{
+    if( !IsEnabled() )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_current.m_Start = GetRunningMicroSecs();
+    m_current.m_Events.clear();
+    m_inFrame = true;
+}
+
+
+void FRAME_PROFILER::EndFrame()
+{
+    if( !IsEnabled() )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_inFrame )
+        return;
+
+    m_current.m_Duration = GetRunningMicroSecs() - m_current.m_Start;
+    m_inFrame = false;
+
+    if( m_frames.size() >= MAX_FRAMES )
+        m_frames.pop_front();
+
+    m_frames.push_back( std::move( m_current ) );
+    m_current = FRAME();
+}
+
+
+void FRAME_PROFILER::AddEvent( const char* aName, int64_t aStart, int64_t aDuration )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_inFrame )
+        m_current.m_Events.push_back( { aName, aStart, aDuration } );
+}
+
+
+std::vector<std::pair<std::string, double>> FRAME_PROFILER::GetLastFrameSummary() const
+{
+    std::lock_guard<std::mutex>                 lock( m_mutex );
+    std::vector<std::pair<std::string, double>> summary;
+
+    if( m_frames.empty() )
+        return summary;
+
+    const FRAME& frame = m_frames.back();
+
+    summary.emplace_back( "frame", frame.m_Duration / 1000.0 );
+
+    for( const EVENT& event : frame.m_Events )
+    {
+        auto it = std::find_if( summary.begin() + 1, summary.end(),
+                                [&]( const std::pair<std::string, double>& aEntry )
+                                {
+                                    return aEntry.first == event.m_Name;
+                                } );
+
+        if( it == summary.end() )
+            summary.emplace_back( event.m_Name, event.m_Duration / 1000.0 );
+        else
+            it->second += event.m_Duration / 1000.0;
+    }
+
+    return summary;
+}
+
+
+bool FRAME_PROFILER::ExportChromeTrace( const wxString& aFilename ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    nlohmann::json events = nlohmann::json::array();
+
+    auto addEvent =
+            [&]( const char* aName, int64_t aStart, int64_t aDuration )
+            {
+                events.push_back( { { "name", aName },
+                                    { "cat", "gal" },
+                                    { "ph", "X" },
+                                    { "ts", aStart },
+                                    { "dur", aDuration },
+                                    { "pid", 1 },
+                                    { "tid", 1 } } );
+            };
+
+    // Stages are all on the GUI thread, so the viewer nests them under their frame
+    for( const FRAME& frame : m_frames )
+    {
+        addEvent( "frame", frame.m_Start, frame.m_Duration );
+
+        for( const EVENT& event : frame.m_Events )
+            addEvent( event.m_Name, event.m_Start, event.m_Duration );
+    }
+
+    std::ofstream traceFile( aFilename.fn_str() );
+
+    if( !traceFile.is_open() )
+        return false;
+
+    nlohmann::json trace = { { "traceEvents", events }, { "displayTimeUnit", "ms" } };
+    traceFile << trace << std::endl;
+
+    return traceFile.good();
+}
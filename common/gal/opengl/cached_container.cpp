@@ -35,9 +35,10 @@
 #include <gal/opengl/vertex_manager.h>
 #include <gal/opengl/vertex_item.h>
 #include <gal/opengl/utils.h>
+#include <gal/frame_profiler.h>
 
-#include <list>
 #include <algorithm>
+#include <iterator>
 #include <cassert>
 
 #ifdef __WIN32__
@@ -59,7 +60,7 @@ CACHED_CONTAINER::CACHED_CONTAINER( unsigned int aSize ) :
         m_maxIndex( 0 )
 {
     // In the beginning there is only free space
-    m_freeChunks.insert( std::make_pair( aSize, 0 ) );
+    resetFreeChunks( 0, aSize );
 }
 
 
@@ -91,8 +92,6 @@ void CACHED_CONTAINER::FinishItem()
         // Add the not used memory back to the pool
         addFreeChunk( itemOffset + itemSize, m_chunkSize - itemSize );
 
-        // mergeFreeChunks();   // veery slow and buggy
-
         m_maxIndex = std::max( itemOffset + itemSize, m_maxIndex );
     }
 
@@ -205,8 +204,7 @@ void CACHED_CONTAINER::Clear()
     m_items.clear();
 
     // Now there is only free space left
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, 0 ) );
+    resetFreeChunks( 0, m_freeSpace );
 }
 
 
@@ -217,30 +215,46 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
 
     unsigned int itemSize = m_item->GetSize();
 
-    // Find a free space chunk >= aSize
-    FREE_CHUNK_MAP::iterator newChunk = m_freeChunks.lower_bound( aSize );
+    // Grow in place if the chunk is directly followed by enough free space
+    if( itemSize > 0 && growChunk( aSize ) )
+        return true;
+
+    // Find the smallest free space chunk >= aSize
+    FREE_CHUNK_MAP::iterator newChunk = m_freeChunks.lower_bound( std::make_pair( aSize, 0u ) );
 
     // Is there enough space to store vertices?
     if( newChunk == m_freeChunks.end() )
     {
-        bool result;
-
-        // Would it be enough to double the current space?
-        if( aSize < m_freeSpace + m_currentSize )
+        FRAME_PROFILER::SCOPE profile( "cached-container-resize" );
+        bool                  result;
+
+        // Free chunks are merged as they are released, so running out of room almost always
+        // means the container is full rather than fragmented.  Growing keeps every item in
+        // place, which is a single block copy instead of moving each item in turn.  Only
+        // compact when most of the container is free but scattered.
+        if( m_freeSpace >= aSize && m_freeSpace > m_currentSize / 2 )
         {
-            // Yes: exponential growing
-            result = defragmentResize( m_currentSize * 2 );
+            result = defragmentResize( m_currentSize );
+        }
+        else if( aSize < m_freeSpace + m_currentSize )
+        {
+            // Exponential growing
+            result = resize( m_currentSize * 2 );
         }
         else
         {
-            // No: grow to the nearest greater power of 2
-            result = defragmentResize( pow( 2, ceil( log2( m_currentSize * 2 + aSize ) ) ) );
+            // Grow to the nearest greater power of 2
+            result = resize( pow( 2, ceil( log2( m_currentSize * 2 + aSize ) ) ) );
         }
 
         if( !result )
             return false;
 
-        newChunk = m_freeChunks.lower_bound( aSize );
+        // The added space may directly follow the current chunk
+        if( itemSize > 0 && growChunk( aSize ) )
+            return true;
+
+        newChunk = m_freeChunks.lower_bound( std::make_pair( aSize, 0u ) );
         assert( newChunk != m_freeChunks.end() );
     }
 
@@ -251,6 +265,11 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
     assert( newChunkSize >= aSize );
     assert( newChunkOffset < m_currentSize );
 
+    // Remove the new allocated chunk from the free space pool.  This has to happen before the
+    // previous chunk is released, as that may merge with its neighbours.
+    removeFreeChunk( newChunk );
+    m_freeSpace -= newChunkSize;
+
     // Check if the item was previously stored in the container
     if( itemSize > 0 )
     {
@@ -261,10 +280,6 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
         addFreeChunk( m_chunkOffset, m_chunkSize );
     }
 
-    // Remove the new allocated chunk from the free space pool
-    m_freeChunks.erase( newChunk );
-    m_freeSpace -= newChunkSize;
-
     m_chunkSize = newChunkSize;
     m_chunkOffset = newChunkOffset;
 
@@ -274,6 +289,23 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
 }
 
 
+bool CACHED_CONTAINER::growChunk( unsigned int aSize )
+{
+    auto next = m_freeChunkOffsets.find( m_chunkOffset + m_chunkSize );
+
+    if( next == m_freeChunkOffsets.end() || m_chunkSize + next->second < aSize )
+        return false;
+
+    unsigned int nextSize = next->second;
+
+    removeFreeChunk( m_freeChunks.find( std::make_pair( nextSize, next->first ) ) );
+    m_freeSpace -= nextSize;
+    m_chunkSize += nextSize;
+
+    return true;
+}
+
+
 void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 {
     // Defragmentation
@@ -335,68 +367,61 @@ void CACHED_CONTAINER::defragment( VERTEX* aTarget )
 }
 
 
-void CACHED_CONTAINER::mergeFreeChunks()
+void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
 {
-    if( m_freeChunks.size() <= 1 ) // There are no chunks that can be merged
-        return;
-
-#ifdef KICAD_GAL_PROFILE
-    PROF_TIMER totalTime;
-#endif /* KICAD_GAL_PROFILE */
+    assert( aOffset + aSize <= m_currentSize );
+    assert( aSize > 0 );
 
-    // Reversed free chunks map - this one stores chunk size with its offset as the key
-    std::list<CHUNK> freeChunks;
+    m_freeSpace += aSize;
 
-    FREE_CHUNK_MAP::const_iterator it, it_end;
+    // Merge with the free chunk ending where this one starts
+    auto next = m_freeChunkOffsets.lower_bound( aOffset );
 
-    for( it = m_freeChunks.begin(), it_end = m_freeChunks.end(); it != it_end; ++it )
+    if( next != m_freeChunkOffsets.begin() )
     {
-        freeChunks.emplace_back( it->second, it->first );
-    }
-
-    m_freeChunks.clear();
-    freeChunks.sort();
-
-    std::list<CHUNK>::const_iterator itf, itf_end;
-    unsigned int                     offset = freeChunks.front().first;
-    unsigned int                     size = freeChunks.front().second;
-    freeChunks.pop_front();
+        auto prev = std::prev( next );
 
-    for( itf = freeChunks.begin(), itf_end = freeChunks.end(); itf != itf_end; ++itf )
-    {
-        if( itf->first == offset + size )
+        if( prev->first + prev->second == aOffset )
         {
-            // These chunks can be merged, so just increase the current chunk size and go on
-            size += itf->second;
+            aOffset = prev->first;
+            aSize += prev->second;
+            m_freeChunks.erase( std::make_pair( prev->second, prev->first ) );
+            m_freeChunkOffsets.erase( prev );
         }
-        else
-        {
-            // These chunks cannot be merged
-            // So store the previous one
-            m_freeChunks.insert( std::make_pair( size, offset ) );
+    }
 
-            // and let's check the next chunk
-            offset = itf->first;
-            size = itf->second;
-        }
+    // Merge with the free chunk starting where this one ends
+    if( next != m_freeChunkOffsets.end() && next->first == aOffset + aSize )
+    {
+        aSize += next->second;
+        m_freeChunks.erase( std::make_pair( next->second, next->first ) );
+        m_freeChunkOffsets.erase( next );
     }
 
-    // Add the last one
-    m_freeChunks.insert( std::make_pair( size, offset ) );
+    m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
+    m_freeChunkOffsets.emplace( aOffset, aSize );
+}
 
-#if CACHED_CONTAINER_TEST > 0
-    test();
-#endif
+
+void CACHED_CONTAINER::removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk )
+{
+    assert( aChunk != m_freeChunks.end() );
+
+    m_freeChunkOffsets.erase( getChunkOffset( *aChunk ) );
+    m_freeChunks.erase( aChunk );
 }
 
 
-void CACHED_CONTAINER::addFreeChunk( unsigned int aOffset, unsigned int aSize )
+void CACHED_CONTAINER::resetFreeChunks( unsigned int aOffset, unsigned int aSize )
 {
-    assert( aOffset + aSize <= m_currentSize );
-    assert( aSize > 0 );
+    m_freeChunks.clear();
+    m_freeChunkOffsets.clear();
 
-    m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
-    m_freeSpace += aSize;
+    if( aSize > 0 )
+    {
+        m_freeChunks.insert( std::make_pair( aSize, aOffset ) );
+        m_freeChunkOffsets.emplace( aOffset, aSize );
+    }
 }
 
 
@@ -223,8 +223,7 @@ bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
     KI_TRACE( traceGalProfile, "VBO size %d used %d\n", m_currentSize, AllItemsSize() );
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
 
     return true;
 }
@@ -291,8 +290,81 @@ bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
     KI_TRACE( traceGalProfile, "VBO size %d used: %d \n", m_currentSize, AllItemsSize() );
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
+
+    return true;
+}
+
+
+bool CACHED_CONTAINER_GPU::resize( unsigned int aNewSize )
+{
+    wxCHECK( IsMapped(), false );
+
+    if( aNewSize <= m_currentSize )
+        return defragmentResize( aNewSize );
+
+    wxLogTrace( traceGalCachedContainerGpu, wxT( "Resizing container from %d to %d" ),
+                m_currentSize, aNewSize );
+
+#ifdef KICAD_GAL_PROFILE
+    PROF_TIMER totalTime;
+#endif /* KICAD_GAL_PROFILE */
+
+    GLuint newBuffer;
+
+    // Create a new destination buffer.  It would be best to use GL_COPY_WRITE_BUFFER here,
+    // but it is not available everywhere
+    glGenBuffers( 1, &newBuffer );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, newBuffer );
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, aNewSize * VERTEX_SIZE, nullptr, GL_DYNAMIC_DRAW );
+    checkGlError( "creating buffer during resize", __FILE__, __LINE__ );
+
+    // The items keep their offsets, so the whole buffer moves in a single copy
+    if( m_useCopyBuffer )
+    {
+        // glCopyBufferSubData requires a buffer to be unmapped
+        glUnmapBuffer( GL_ARRAY_BUFFER );
+        glCopyBufferSubData( GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, 0, 0,
+                             m_currentSize * VERTEX_SIZE );
+
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        m_isMapped = false;
+    }
+    else
+    {
+        VERTEX* newBufferMem = static_cast<VERTEX*>( glMapBuffer( GL_ELEMENT_ARRAY_BUFFER,
+                                                                  GL_WRITE_ONLY ) );
+        checkGlError( "mapping buffer during resize", __FILE__, __LINE__ );
+
+        memcpy( newBufferMem, m_vertices, m_currentSize * VERTEX_SIZE );
+
+        glUnmapBuffer( GL_ELEMENT_ARRAY_BUFFER );
+        glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+        Unmap();
+    }
+
+    glDeleteBuffers( 1, &m_glBufferHandle );
+
+    // Switch to the new vertex buffer
+    m_glBufferHandle = newBuffer;
+    Map();
+    checkGlError( "switching buffers during resize", __FILE__, __LINE__ );
+
+#ifdef KICAD_GAL_PROFILE
+    totalTime.Stop();
+
+    wxLogTrace( traceGalCachedContainerGpu, "Resized container storing %d vertices / %.1f ms",
+                m_currentSize - m_freeSpace, totalTime.msecs() );
+#endif /* KICAD_GAL_PROFILE */
+
+    unsigned int oldSize = m_currentSize;
+    m_currentSize = aNewSize;
+
+    // The added space follows all the stored items
+    addFreeChunk( oldSize, aNewSize - oldSize );
+
+    KI_TRACE( traceGalProfile, "VBO size %d used %d\n", m_currentSize, AllItemsSize() );
 
     return true;
 }
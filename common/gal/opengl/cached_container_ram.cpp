@@ -126,8 +126,33 @@ bool CACHED_CONTAINER_RAM::defragmentResize( unsigned int aNewSize )
     m_currentSize = aNewSize;
 
     // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+    resetFreeChunks( m_currentSize - m_freeSpace, m_freeSpace );
+    m_dirty = true;
+
+    return true;
+}
+
+
+bool CACHED_CONTAINER_RAM::resize( unsigned int aNewSize )
+{
+    wxLogTrace( traceGalCachedContainer, wxT( "Resizing container from %d to %d" ),
+                m_currentSize, aNewSize );
+
+    if( aNewSize <= m_currentSize )
+        return defragmentResize( aNewSize );
+
+    VERTEX* newBufferMem = static_cast<VERTEX*>( realloc( m_vertices, aNewSize * VERTEX_SIZE ) );
+
+    if( !newBufferMem )
+        throw std::bad_alloc();
+
+    m_vertices = newBufferMem;
+
+    unsigned int oldSize = m_currentSize;
+    m_currentSize = aNewSize;
+
+    // The added space follows all the stored items
+    addFreeChunk( oldSize, aNewSize - oldSize );
     m_dirty = true;
 
     return true;
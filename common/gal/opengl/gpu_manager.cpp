@@ -85,12 +85,7 @@ void GPU_MANAGER::SetShader( SHADER& aShader )
 GPU_CACHED_MANAGER::GPU_CACHED_MANAGER( VERTEX_CONTAINER* aContainer ) :
         GPU_MANAGER( aContainer ),
         m_buffersInitialized( false ),
-        m_indicesCapacity( 0 ),
-        m_totalHuge( 0 ),
-        m_totalNormal( 0 ),
-        m_indexBufSize( 0 ),
-        m_indexBufMaxSize( 0 ),
-        m_curVrangeSize( 0 )
+        m_itemCount( 0 )
 {
 }
 
@@ -104,10 +99,10 @@ void GPU_CACHED_MANAGER::BeginDrawing()
 {
     wxASSERT( !m_isDrawing );
 
-    m_curVrangeSize = 0;
-    m_indexBufMaxSize = 0;
-    m_indexBufSize = 0;
-    m_vranges.clear();
+    // Keep the capacity, the next frame usually draws about as many ranges
+    m_rangeFirst.clear();
+    m_rangeCount.clear();
+    m_itemCount = 0;
 
     m_isDrawing = true;
 }
@@ -124,19 +119,19 @@ void GPU_CACHED_MANAGER::DrawIndices( const VERTEX_ITEM* aItem )
     if( size == 0 )
         return;
 
-    if( size <= 1000 )
-    {
-        m_totalNormal += size;
-        m_vranges.emplace_back( offset, offset + size - 1, false );
-        m_curVrangeSize += size;
-    }
-    else
+    m_itemCount++;
+
+    // Items cached one after another are usually drawn one after another too, so most of
+    // them just extend the previous range
+    if( !m_rangeFirst.empty()
+            && (unsigned int) ( m_rangeFirst.back() + m_rangeCount.back() ) == offset )
     {
-        m_totalHuge += size;
-        m_vranges.emplace_back( offset, offset + size - 1, true );
-        m_indexBufSize = std::max( m_curVrangeSize, m_indexBufSize );
-        m_curVrangeSize = 0;
+        m_rangeCount.back() += size;
+        return;
     }
+
+    m_rangeFirst.push_back( offset );
+    m_rangeCount.push_back( size );
 }
 
 
@@ -149,11 +144,6 @@ void GPU_CACHED_MANAGER::EndDrawing()
     if( cached->IsMapped() )
         cached->Unmap();
 
-    m_indexBufSize = std::max( m_curVrangeSize, m_indexBufSize );
-    m_indexBufMaxSize = std::max( 2*m_indexBufSize, m_indexBufMaxSize );
-
-    resizeIndices( m_indexBufMaxSize );
-
     if( m_enableDepthTest )
         glEnable( GL_DEPTH_TEST );
     else
@@ -176,56 +166,19 @@ void GPU_CACHED_MANAGER::EndDrawing()
                                (GLvoid*) SHADER_OFFSET );
     }
 
-    PROF_TIMER cntDraw( "gl-draw-elements" );
-
-    int     n_ranges = m_vranges.size();
-    int     n = 0;
-    GLuint* iptr = m_indices.get();
-    GLuint  icnt = 0;
-
-    int drawCalls = 0;
+    PROF_TIMER cntDraw( "gl-multi-draw-arrays" );
 
-    while( n < n_ranges )
+    // A single call draws all the ranges in order, without building an index buffer
+    if( !m_rangeFirst.empty() )
     {
-        VRANGE* cur = &m_vranges[n];
-
-        if( cur->m_isContinuous )
-        {
-            if( icnt > 0 )
-            {
-                glDrawElements( GL_TRIANGLES, icnt, GL_UNSIGNED_INT, m_indices.get() );
-                drawCalls++;
-            }
-
-            icnt = 0;
-            iptr = m_indices.get();
-
-            glDrawArrays( GL_TRIANGLES, cur->m_start, cur->m_end - cur->m_start + 1 );
-            drawCalls++;
-        }
-        else
-        {
-            for( GLuint i = cur->m_start; i <= cur->m_end; i++ )
-            {
-                *iptr++ = i;
-                icnt++;
-            }
-        }
-
-        n++;
-    }
-
-    if( icnt > 0 )
-    {
-        glDrawElements( GL_TRIANGLES, icnt, GL_UNSIGNED_INT, m_indices.get() );
-        drawCalls++;
+        glMultiDrawArrays( GL_TRIANGLES, m_rangeFirst.data(), m_rangeCount.data(),
+                           (GLsizei) m_rangeFirst.size() );
     }
 
     cntDraw.Stop();
 
-    KI_TRACE( traceGalProfile,
-              "Cached manager size: VBO size %u iranges %zu max elt size %u drawcalls %u\n",
-              cached->AllItemsSize(), m_vranges.size(), m_indexBufMaxSize, drawCalls );
+    KI_TRACE( traceGalProfile, "Cached manager size: VBO size %u items %u ranges %zu\n",
+              cached->AllItemsSize(), m_itemCount, m_rangeFirst.size() );
     KI_TRACE( traceGalProfile, "Timing: %s\n", cntDraw.to_string() );
 
     glBindBuffer( GL_ARRAY_BUFFER, 0 );
@@ -245,16 +198,6 @@ void GPU_CACHED_MANAGER::EndDrawing()
 }
 
 
-void GPU_CACHED_MANAGER::resizeIndices( unsigned int aNewSize )
-{
-    if( aNewSize > m_indicesCapacity )
-    {
-        m_indicesCapacity = aNewSize;
-        m_indices.reset( new GLuint[m_indicesCapacity] );
-    }
-}
-
-
 // Noncached manager
 GPU_NONCACHED_MANAGER::GPU_NONCACHED_MANAGER( VERTEX_CONTAINER* aContainer ) :
         GPU_MANAGER( aContainer )
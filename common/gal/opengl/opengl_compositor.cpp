@@ -32,6 +32,7 @@
 
 #include <gal/opengl/opengl_compositor.h>
 #include <gal/opengl/utils.h>
+#include <gal/frame_profiler.h>
 
 #include <gal/color4d.h>
 
@@ -321,6 +322,8 @@ void OPENGL_COMPOSITOR::Begin()
 
 void OPENGL_COMPOSITOR::DrawBuffer( unsigned int aBufferHandle )
 {
+    FRAME_PROFILER::SCOPE profile( "compositor-draw-buffer" );
+
     m_antialiasing->DrawBuffer( aBufferHandle );
 }
 
@@ -373,6 +376,8 @@ void OPENGL_COMPOSITOR::DrawBuffer( unsigned int aSourceHandle, unsigned int aDe
 
 void OPENGL_COMPOSITOR::Present()
 {
+    FRAME_PROFILER::SCOPE profile( "compositor-present" );
+
     m_antialiasing->Present();
 }
 
@@ -31,6 +31,7 @@
 #include <gal/opengl/opengl_gal.h>
 #include <gal/opengl/utils.h>
 #include <gal/definitions.h>
+#include <gal/frame_profiler.h>
 #include <gal/opengl/gl_context_mgr.h>
 #include <geometry/shape_poly_set.h>
 #include <math/vector2wx.h>
@@ -418,11 +419,22 @@ OPENGL_GAL::OPENGL_GAL( const KIGFX::VC_SETTINGS& aVcSettings, GAL_DISPLAY_OPTIO
     ufm_fontTexture = -1;
     ufm_fontTextureWidth = -1;
     m_swapInterval  = 0;
+
+    m_memoryUsage = std::make_unique<MEMORY_USAGE_PROVIDER>( wxS( "Graphics vertex buffers" ),
+            [this]() -> size_t
+            {
+                if( !m_isInitialized )
+                    return 0;
+
+                return m_cachedManager->GetMemorySize() + m_nonCachedManager->GetMemorySize()
+                       + m_overlayManager->GetMemorySize() + m_tempManager->GetMemorySize();
+            } );
 }
 
 
 OPENGL_GAL::~OPENGL_GAL()
 {
+    m_memoryUsage.reset();
 
     GL_CONTEXT_MANAGER* gl_mgr = Pgm().GetGLContextManager();
     gl_mgr->LockCtx( m_glPrivContext, this );
@@ -550,6 +562,8 @@ VECTOR2D OPENGL_GAL::getScreenPixelSize() const
 
 void OPENGL_GAL::BeginDrawing()
 {
+    FRAME_PROFILER::SCOPE profile( "gl-begin-drawing" );
+
 #ifdef KICAD_GAL_PROFILE
     PROF_TIMER totalRealTime( "OPENGL_GAL::beginDrawing()", true );
 #endif /* KICAD_GAL_PROFILE */
@@ -733,17 +747,25 @@ void OPENGL_GAL::EndDrawing()
     PROF_TIMER cntComposite( "gl-composite" );
     PROF_TIMER cntSwap( "gl-swap" );
 
+    FRAME_PROFILER::SCOPE profile( "gl-end-drawing" );
+
     cntTotal.Start();
 
     // Cached & non-cached containers are rendered to the same buffer
     m_compositor->SetBuffer( m_mainBuffer );
 
     cntEndNoncached.Start();
-    m_nonCachedManager->EndDrawing();
+    {
+        FRAME_PROFILER::SCOPE profileNoncached( "gl-draw-noncached" );
+        m_nonCachedManager->EndDrawing();
+    }
     cntEndNoncached.Stop();
 
     cntEndCached.Start();
-    m_cachedManager->EndDrawing();
+    {
+        FRAME_PROFILER::SCOPE profileCached( "gl-draw-cached" );
+        m_cachedManager->EndDrawing();
+    }
     cntEndCached.Stop();
 
     cntEndOverlay.Start();
@@ -751,7 +773,10 @@ void OPENGL_GAL::EndDrawing()
     if( m_overlayBuffer )
         m_compositor->SetBuffer( m_overlayBuffer );
 
-    m_overlayManager->EndDrawing();
+    {
+        FRAME_PROFILER::SCOPE profileOverlay( "gl-draw-overlay" );
+        m_overlayManager->EndDrawing();
+    }
     cntEndOverlay.Stop();
 
     cntComposite.Start();
@@ -771,7 +796,10 @@ void OPENGL_GAL::EndDrawing()
     cntComposite.Stop();
 
     cntSwap.Start();
-    SwapBuffers();
+    {
+        FRAME_PROFILER::SCOPE profileSwap( "gl-swap" );
+        SwapBuffers();
+    }
     cntSwap.Stop();
 
     cntTotal.Stop();
@@ -933,6 +961,30 @@ void OPENGL_GAL::DrawHoleWall( const VECTOR2D& aCenterPoint, double aHoleRadius,
 
 void OPENGL_GAL::drawCircle( const VECTOR2D& aCenterPoint, double aRadius, bool aReserve )
 {
+    // A filled and stroked circle of a single colour covers the same pixels as one filled
+    // circle reaching the outer edge of the stroke.  Vias and hole walls are drawn this way,
+    // so emitting a single shaded triangle halves their share of the cached container.
+    // Callers that reserved space themselves expect both triangles, so leave those alone.
+    if( aReserve && m_isFillEnabled && m_isStrokeEnabled && m_fillColor == m_strokeColor
+            && m_lineWidth > 0.0 )
+    {
+        m_currentManager->Reserve( 3 );
+        m_currentManager->Color( m_fillColor.r, m_fillColor.g, m_fillColor.b, m_fillColor.a );
+
+        const double outerRadius = aRadius + m_lineWidth / 2.0;
+
+        m_currentManager->Shader( SHADER_FILLED_CIRCLE, 1.0, outerRadius );
+        m_currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, m_layerDepth );
+
+        m_currentManager->Shader( SHADER_FILLED_CIRCLE, 2.0, outerRadius );
+        m_currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, m_layerDepth );
+
+        m_currentManager->Shader( SHADER_FILLED_CIRCLE, 3.0, outerRadius );
+        m_currentManager->Vertex( aCenterPoint.x, aCenterPoint.y, m_layerDepth );
+
+        return;
+    }
+
     if( m_isFillEnabled )
     {
         if( aReserve )
@@ -1012,14 +1064,20 @@ void OPENGL_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius,
 
     if( m_isFillEnabled )
     {
-        double alpha;
+        double       alpha;
+        unsigned int triangleCount = 1;     // The last missing triangle
+
+        for( alpha = startAngle; ( alpha + alphaIncrement ) < endAngle; alpha += alphaIncrement )
+            triangleCount++;
+
+        // Reserve the whole fan at once rather than one container allocation per triangle
+        m_currentManager->Reserve( 3 * triangleCount );
         m_currentManager->Color( m_fillColor.r, m_fillColor.g, m_fillColor.b, m_fillColor.a );
         m_currentManager->Shader( SHADER_NONE );
 
         // Triangle fan
         for( alpha = startAngle; ( alpha + alphaIncrement ) < endAngle; )
         {
-            m_currentManager->Reserve( 3 );
             m_currentManager->Vertex( 0.0, 0.0, m_layerDepth );
             m_currentManager->Vertex( cos( alpha ) * aRadius, sin( alpha ) * aRadius,
                                       m_layerDepth );
@@ -1031,7 +1089,6 @@ void OPENGL_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius,
         // The last missing triangle
         const VECTOR2D endPoint( cos( endAngle ) * aRadius, sin( endAngle ) * aRadius );
 
-        m_currentManager->Reserve( 3 );
         m_currentManager->Vertex( 0.0, 0.0, m_layerDepth );
         m_currentManager->Vertex( cos( alpha ) * aRadius, sin( alpha ) * aRadius, m_layerDepth );
         m_currentManager->Vertex( endPoint.x, endPoint.y, m_layerDepth );
@@ -247,6 +247,12 @@ VERTEX* VERTEX_MANAGER::GetVertices( const VERTEX_ITEM& aItem ) const
 }
 
 
+size_t VERTEX_MANAGER::GetMemorySize() const
+{
+    return static_cast<size_t>( m_container->GetSize() ) * VERTEX_SIZE;
+}
+
+
 void VERTEX_MANAGER::SetShader( SHADER& aShader ) const
 {
     m_gpu->SetShader( aShader );
@@ -83,6 +83,11 @@ public:
     virtual std::map<wxString, FileStatus> GetFileStatus( GIT_STATUS_HANDLER* aHandler,
                                                           const wxString& aPathspec ) = 0;
 
+    virtual bool UpdateFileStatus( GIT_STATUS_HANDLER* aHandler, const std::set<wxString>& aFiles,
+                                   std::map<wxString, FileStatus>& aFileStatus ) = 0;
+
+    virtual wxString GetIndexPath( GIT_STATUS_HANDLER* aHandler ) = 0;
+
     virtual wxString GetCurrentBranchName( GIT_STATUS_HANDLER* aHandler ) = 0;
 
     virtual void UpdateRemoteStatus( GIT_STATUS_HANDLER* aHandler,
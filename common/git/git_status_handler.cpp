@@ -41,6 +41,17 @@ std::map<wxString, FileStatus> GIT_STATUS_HANDLER::GetFileStatus( const wxString
     return GetGitBackend()->GetFileStatus( this, aPathspec );
 }
 
+bool GIT_STATUS_HANDLER::UpdateFileStatus( const std::set<wxString>& aFiles,
+                                           std::map<wxString, FileStatus>& aFileStatus )
+{
+    return GetGitBackend()->UpdateFileStatus( this, aFiles, aFileStatus );
+}
+
+wxString GIT_STATUS_HANDLER::GetIndexPath()
+{
+    return GetGitBackend()->GetIndexPath( this );
+}
+
 wxString GIT_STATUS_HANDLER::GetCurrentBranchName()
 {
     return GetGitBackend()->GetCurrentBranchName( this );
@@ -58,6 +58,24 @@ public:
      */
     std::map<wxString, FileStatus> GetFileStatus( const wxString& aPathspec = wxEmptyString );
 
+    /**
+     * Refresh the status of a few files in a map returned by GetFileStatus(), without scanning
+     * the rest of the working tree.
+     * @param aFiles Absolute paths of the files to refresh
+     * @param aFileStatus Map to update; files unknown to git are removed from it
+     * @return False if a path could not be handled as a single file (e.g. a directory): the
+     *         map must then be rebuilt with GetFileStatus()
+     */
+    bool UpdateFileStatus( const std::set<wxString>& aFiles,
+                           std::map<wxString, FileStatus>& aFileStatus );
+
+    /**
+     * Get the path of the index file, whose modification time changes when files are staged,
+     * committed or checked out
+     * @return Index file path, or empty string if not available
+     */
+    wxString GetIndexPath();
+
     /**
      * Get the current branch name
      * @return Current branch name, or empty string if not available
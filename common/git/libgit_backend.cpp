@@ -417,6 +417,57 @@ std::map<wxString, FileStatus> LIBGIT_BACKEND::GetFileStatus( GIT_STATUS_HANDLER
     return fileStatusMap;
 }
 
+bool LIBGIT_BACKEND::UpdateFileStatus( GIT_STATUS_HANDLER* aHandler,
+                                       const std::set<wxString>& aFiles,
+                                       std::map<wxString, FileStatus>& aFileStatus )
+{
+    git_repository* repo = aHandler->GetRepo();
+
+    if( !repo || !git_repository_workdir( repo ) )
+        return false;
+
+    wxString repoWorkDir( git_repository_workdir( repo ) );
+
+    for( const wxString& absPath : aFiles )
+    {
+        if( !absPath.StartsWith( repoWorkDir ) )
+            return false;
+
+        std::string  path( absPath.Mid( repoWorkDir.length() ).mb_str() );
+        unsigned int status = 0;
+        int          rc = git_status_file( &status, repo, path.c_str() );
+
+        if( rc == GIT_ENOTFOUND || ( rc == GIT_OK && ( status & GIT_STATUS_IGNORED ) ) )
+        {
+            // Not listed by GetFileStatus() either
+            aFileStatus.erase( absPath );
+        }
+        else if( rc == GIT_OK )
+        {
+            aFileStatus[absPath] = FileStatus{ absPath, aHandler->ConvertStatus( status ), status };
+        }
+        else
+        {
+            // E.g. a directory, which needs a pathspec match
+            wxLogTrace( traceGit, "Failed to get status of %s: %s", absPath,
+                        KIGIT_COMMON::GetLastGitError() );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+wxString LIBGIT_BACKEND::GetIndexPath( GIT_STATUS_HANDLER* aHandler )
+{
+    git_repository* repo = aHandler->GetRepo();
+
+    if( !repo )
+        return wxEmptyString;
+
+    return wxString( git_repository_path( repo ) ) + wxS( "index" );
+}
+
 wxString LIBGIT_BACKEND::GetCurrentBranchName( GIT_STATUS_HANDLER* aHandler )
 {
     git_repository* repo = aHandler->GetRepo();
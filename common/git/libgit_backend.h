@@ -52,6 +52,11 @@ public:
     std::map<wxString, FileStatus> GetFileStatus( GIT_STATUS_HANDLER* aHandler,
                                                   const wxString& aPathspec ) override;
 
+    bool UpdateFileStatus( GIT_STATUS_HANDLER* aHandler, const std::set<wxString>& aFiles,
+                           std::map<wxString, FileStatus>& aFileStatus ) override;
+
+    wxString GetIndexPath( GIT_STATUS_HANDLER* aHandler ) override;
+
     wxString GetCurrentBranchName( GIT_STATUS_HANDLER* aHandler ) override;
 
     void UpdateRemoteStatus( GIT_STATUS_HANDLER* aHandler,
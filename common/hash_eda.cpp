@@ -103,6 +103,38 @@ size_t hash_fp_item( const EDA_ITEM* aItem, int aFlags )
                     hash_combine( ret, via->FlashLayer( layer ) );
                 } );
 
+        if( aFlags & HASH_POS )
+            hash_combine( ret, via->GetPosition().x, via->GetPosition().y );
+
+        if( aFlags & HASH_NET )
+            hash_combine( ret, via->GetNetCode() );
+
+        break;
+    }
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        const PCB_TRACK* track = static_cast<const PCB_TRACK*>( aItem );
+
+        ret = hash_board_item( track, aFlags );
+        hash_combine( ret, track->GetWidth() );
+
+        if( aFlags & HASH_POS )
+        {
+            hash_combine( ret, track->GetStart().x, track->GetStart().y );
+            hash_combine( ret, track->GetEnd().x, track->GetEnd().y );
+
+            if( aItem->Type() == PCB_ARC_T )
+            {
+                const VECTOR2I& mid = static_cast<const PCB_ARC*>( track )->GetMid();
+                hash_combine( ret, mid.x, mid.y );
+            }
+        }
+
+        if( aFlags & HASH_NET )
+            hash_combine( ret, track->GetNetCode() );
+
         break;
     }
 
@@ -18,10 +18,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <wx/filefn.h>
+#include <wx/filename.h>
 #include <wx/log.h>
 #include <fmt/core.h>
 #include <wx/translation.h>
 #include <ctime>
+#include <fstream>
 
 #include <boost/algorithm/string.hpp>
 #include <json_common.h>
@@ -31,7 +34,11 @@
 #include <curl/curl.h>
 
 #include <http_lib/http_lib_connection.h>
+#include <ki_exception.h>
 #include <lib_id.h>
+#include <mmh3_hash.h>
+#include <paths.h>
+#include <thread_pool.h>
 
 const char* const traceHTTPLib = "KICAD_HTTP_LIB";
 
@@ -49,19 +56,16 @@ bool HTTP_LIB_CONNECTION::validateHttpLibraryEndpoints()
 {
     m_endpointValid = false;
     std::string res = "";
+    wxString    error;
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url );
+    if( !fetch( m_source.root_url, res, error ) )
+    {
+        m_lastError += error + "\n";
+        return false;
+    }
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-            return false;
-
         if( res.length() == 0 )
         {
             m_lastError += wxString::Format( _( "KiCad received an empty response!" ) + "\n" );
@@ -102,19 +106,16 @@ bool HTTP_LIB_CONNECTION::syncCategories()
     }
 
     std::string res = "";
+    wxString    error;
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url + "categories.json" );
+    if( !fetch( m_source.root_url + "categories.json", res, error ) )
+    {
+        m_lastError += error + "\n";
+        return false;
+    }
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-            return false;
-
         nlohmann::json response = nlohmann::json::parse( res );
 
         // collect the categories in vector
@@ -239,20 +240,16 @@ bool HTTP_LIB_CONNECTION::SelectOne( const std::string& aPartID, HTTP_LIB_PART&
     }
 
     std::string res = "";
+    wxString    error;
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    std::string url = m_source.root_url + fmt::format( "parts/{}.json", aPartID );
-    curl->SetURL( url );
+    if( !fetch( m_source.root_url + fmt::format( "parts/{}.json", aPartID ), res, error ) )
+    {
+        m_lastError += error + "\n";
+        return false;
+    }
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-            return false;
-
         nlohmann::ordered_json response = nlohmann::ordered_json::parse( res );
         std::string    key = "";
         std::string    value = "";
@@ -334,6 +331,21 @@ bool HTTP_LIB_CONNECTION::SelectOne( const std::string& aPartID, HTTP_LIB_PART&
 
 
 bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts )
+{
+    std::map<std::string, std::vector<HTTP_LIB_PART>> parts;
+
+    if( !SelectAll( { aCategory }, parts ) )
+        return false;
+
+    for( HTTP_LIB_PART& part : parts[aCategory.id] )
+        aParts.emplace_back( std::move( part ) );
+
+    return true;
+}
+
+
+bool HTTP_LIB_CONNECTION::SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                                     std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts )
 {
     if( !IsValidEndpoint() )
     {
@@ -341,62 +353,197 @@ bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::ve
         return false;
     }
 
-    std::string res = "";
+    std::vector<std::vector<HTTP_LIB_PART>> parts( aCategories.size() );
+    std::vector<wxString>                   errors( aCategories.size() );
+    thread_pool&                            tp = GetKiCadThreadPool();
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
+    // Most of the time is spent waiting for the server, so all the categories are requested
+    // at once.  Results are merged into the connection state afterwards, on this thread.
+    tp.submit_loop( size_t( 0 ), aCategories.size(),
+            [&]( size_t aIdx )
+            {
+                const HTTP_LIB_CATEGORY& category = aCategories[aIdx];
+                std::string              url = fmt::format( "parts/category/{}.json", category.id );
+                std::string              res = "";
 
-    curl->SetURL( m_source.root_url + fmt::format( "parts/category/{}.json", aCategory.id ) );
+                try
+                {
+                    if( !fetch( m_source.root_url + url, res, errors[aIdx] ) )
+                        return;
 
-    try
-    {
-        curl->Perform();
+                    nlohmann::json response = nlohmann::json::parse( res );
 
-        res = curl->GetBuffer();
+                    for( nlohmann::json& item : response )
+                    {
+                        HTTP_LIB_PART part;
 
-        nlohmann::json response = nlohmann::json::parse( res );
+                        setPartIdNameAndMetadata( item, part );
+                        parts[aIdx].emplace_back( std::move( part ) );
+                    }
+                }
+                catch( const std::exception& e )
+                {
+                    parts[aIdx].clear();
+                    errors[aIdx] = wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response: %s" ),
+                                                     e.what(), res );
+                }
+                catch( const IO_ERROR& e )
+                {
+                    errors[aIdx] = e.What();
+                }
+            } ).wait();
 
-        for( nlohmann::json& item : response )
+    bool ok = true;
+
+    for( size_t ii = 0; ii < aCategories.size(); ++ii )
+    {
+        if( !errors[ii].IsEmpty() )
         {
-            //PART result;
-            HTTP_LIB_PART part;
+            m_lastError += errors[ii] + "\n";
+            ok = false;
+
+            wxLogTrace( traceHTTPLib, wxT( "Exception occurred while syncing parts of %s: %s" ),
+                        aCategories[ii].name, errors[ii] );
+            continue;
+        }
+
+        // add to cache
+        for( const HTTP_LIB_PART& part : parts[ii] )
+            m_cache[part.name] = std::make_tuple( part.id, aCategories[ii].id );
+
+        aParts[aCategories[ii].id] = std::move( parts[ii] );
+    }
 
-            setPartIdNameAndMetadata( item, part );
+    return ok;
+}
 
-            // add to cache
-            m_cache[part.name] = std::make_tuple( part.id, aCategory.id );
 
-            aParts.emplace_back( std::move( part ) );
+bool HTTP_LIB_CONNECTION::fetch( const std::string& aUrl, std::string& aResponse, wxString& aError )
+{
+    wxString       cacheFile = responseCacheFile( aUrl );
+    nlohmann::json cached;
+
+    if( wxFileExists( cacheFile ) )
+    {
+        try
+        {
+            std::ifstream stream( cacheFile.fn_str() );
+            cached = nlohmann::json::parse( stream );
+
+            if( !cached.is_object() || cached.value( "url", "" ) != aUrl )
+                cached = nlohmann::json();
+        }
+        catch( const std::exception& e )
+        {
+            wxLogTrace( traceHTTPLib, wxT( "fetch: ignoring cached response %s: %s" ), cacheFile,
+                        e.what() );
+            cached = nlohmann::json();
         }
     }
-    catch( const std::exception& e )
+
+    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
+    curl->SetURL( aUrl );
+
+    if( cached.is_object() )
     {
-        m_lastError += wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response: %s" ) + "\n",
-                                         e.what(), res );
+        std::string etag = cached.value( "etag", "" );
+        std::string lastModified = cached.value( "last_modified", "" );
 
-        wxLogTrace( traceHTTPLib, wxT( "Exception occurred while syncing parts: %s" ), m_lastError );
+        if( !etag.empty() )
+            curl->SetHeader( "If-None-Match", etag );
 
-        return false;
+        if( !lastModified.empty() )
+            curl->SetHeader( "If-Modified-Since", lastModified );
     }
 
-    return true;
-}
+    int result = curl->Perform();
 
+    if( result != CURLE_OK )
+    {
+        aError = wxString::Format( _( "Error: %s" ), curl->GetErrorText( result ) );
+        return false;
+    }
 
-bool HTTP_LIB_CONNECTION::checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl )
-{
-    int statusCode = aCurl->GetResponseStatusCode();
+    int statusCode = curl->GetResponseStatusCode();
+
+    if( statusCode == 304 && cached.is_object() )
+    {
+        wxLogTrace( traceHTTPLib, wxT( "fetch: %s not modified" ), aUrl );
+        aResponse = cached.value( "body", "" );
+        return true;
+    }
 
     if( statusCode != 200 )
     {
-        m_lastError += wxString::Format( _( "API responded with error code: %s" ) + "\n",
-                                         httpErrorCodeDescription( statusCode ) );
+        aError = wxString::Format( _( "API responded with error code: %s" ),
+                                   httpErrorCodeDescription( statusCode ) );
         return false;
     }
 
+    aResponse = curl->GetBuffer();
+
+    std::string etag = curl->GetResponseHeader( "ETag" );
+    std::string lastModified = curl->GetResponseHeader( "Last-Modified" );
+
+    if( etag.empty() && lastModified.empty() )
+    {
+        // Nothing to revalidate it with
+        if( cached.is_object() )
+            wxRemoveFile( cacheFile );
+
+        return true;
+    }
+
+    try
+    {
+        nlohmann::json entry = { { "url", aUrl },
+                                 { "etag", etag },
+                                 { "last_modified", lastModified },
+                                 { "body", aResponse } };
+
+        wxFileName fn( cacheFile );
+
+        if( !fn.DirExists() )
+            fn.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+        // Written aside first, so a concurrent session never reads half a file
+        wxString tmpFile = cacheFile + wxS( ".tmp" );
+
+        {
+            std::ofstream stream( tmpFile.fn_str(), std::ios::binary | std::ios::trunc );
+            stream << entry.dump();
+
+            if( !stream )
+                return true;
+        }
+
+        wxRenameFile( tmpFile, cacheFile, true );
+    }
+    catch( const std::exception& e )
+    {
+        wxLogTrace( traceHTTPLib, wxT( "fetch: could not cache response to %s: %s" ), aUrl,
+                    e.what() );
+    }
+
     return true;
 }
 
 
+wxString HTTP_LIB_CONNECTION::responseCacheFile( const std::string& aUrl ) const
+{
+    // The token is part of the key: responses may differ between users
+    MMH3_HASH hash;
+    hash.add( m_source.token );
+    hash.add( aUrl );
+
+    wxFileName fn( PATHS::GetUserCachePath() + wxS( "http-lib" ), wxEmptyString );
+    fn.SetName( hash.digest().ToString() );
+    fn.SetExt( wxS( "json" ) );
+
+    return fn.GetFullPath();
+}
+
+
 wxString HTTP_LIB_CONNECTION::httpErrorCodeDescription( uint16_t aHttpCode )
 {
     auto codeDescription =
@@ -28,6 +28,7 @@
 #include <compoundfilereader.h>
 #include <charconv>
 #include <ki_exception.h>
+#include <kiplatform/io.h>
 #include <math/util.h>
 #include <numeric>
 #include <sstream>
@@ -52,8 +53,32 @@ ALTIUM_COMPOUND_FILE::ALTIUM_COMPOUND_FILE()
 }
 
 
+ALTIUM_COMPOUND_FILE::~ALTIUM_COMPOUND_FILE()
+{
+}
+
+
 ALTIUM_COMPOUND_FILE::ALTIUM_COMPOUND_FILE( const wxString& aFilePath )
 {
+    // Large boards are hundreds of megabytes: read the streams straight from the mapping
+    // rather than copying the whole file first
+    auto mapped = std::make_unique<KIPLATFORM::IO::MAPPED_FILE>( aFilePath );
+
+    if( mapped->IsMapped() && mapped->Size() > 0 )
+    {
+        try
+        {
+            m_reader = std::make_unique<CFB::CompoundFileReader>( mapped->Data(), mapped->Size() );
+        }
+        catch( CFB::CFBException& exception )
+        {
+            THROW_IO_ERROR( exception.what() );
+        }
+
+        m_mappedFile = std::move( mapped );
+        return;
+    }
+
     // Open file
     FILE* fp = wxFopen( aFilePath, "rb" );
 
@@ -71,7 +96,7 @@ ALTIUM_COMPOUND_FILE::ALTIUM_COMPOUND_FILE( const wxString& aFilePath )
         THROW_IO_ERROR( _( "Error reading file: cannot determine length." ) );
     }
 
-    // Read into buffer (TODO: add support for memory-mapped files to avoid this copy!)
+    // Read into buffer
     m_buffer.resize( len );
 
     fseek( fp, 0, SEEK_SET );
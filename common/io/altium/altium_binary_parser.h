@@ -46,6 +46,14 @@ class CompoundFileReader;
 struct COMPOUND_FILE_ENTRY;
 } // namespace CFB
 
+namespace KIPLATFORM
+{
+namespace IO
+{
+class MAPPED_FILE;
+} // namespace IO
+} // namespace KIPLATFORM
+
 /**
  * Helper for debug logging (vector -> string)
  * @param aVectorPath path
@@ -76,6 +84,9 @@ public:
     /**
      * Open a CFB file. Constructor might throw an IO_ERROR.
      *
+     * The file is memory mapped when the platform allows it, and only read into memory
+     * otherwise.
+     *
      * @param aFilePath path to file to open
      */
     ALTIUM_COMPOUND_FILE( const wxString& aFilePath );
@@ -91,7 +102,7 @@ public:
 
     ALTIUM_COMPOUND_FILE( const ALTIUM_COMPOUND_FILE& temp_obj ) = delete;
     ALTIUM_COMPOUND_FILE& operator=( const ALTIUM_COMPOUND_FILE& temp_obj ) = delete;
-    ~ALTIUM_COMPOUND_FILE() = default;
+    ~ALTIUM_COMPOUND_FILE();
 
     /**
      * Load a CFB file from memory; may throw an IO_ERROR.
@@ -121,8 +132,9 @@ public:
 
 private:
 
-    std::unique_ptr<CFB::CompoundFileReader> m_reader;
-    std::vector<char>                        m_buffer;
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> m_mappedFile;   ///< Must outlive m_reader
+    std::unique_ptr<CFB::CompoundFileReader>     m_reader;
+    std::vector<char>                            m_buffer;
 };
 
 
@@ -94,7 +94,11 @@ void FormatStreamData( OUTPUTFORMATTER& aOut, const wxStreamBuffer& aStream )
  *  )
  * )
  */
-void Prettify( std::string& aSource, FORMAT_MODE aMode )
+/**
+ * @param aInOuterList the text starts inside the outer list, after a complete list.
+ * @param aAtEnd the text ends with the end of the file.
+ */
+static void prettify( std::string& aSource, FORMAT_MODE aMode, bool aInOuterList, bool aAtEnd )
 {
     // Configuration
     const char quoteChar = '"';
@@ -119,9 +123,9 @@ void Prettify( std::string& aSource, FORMAT_MODE aMode )
     auto cursor = aSource.begin();
     auto seek = cursor;
 
-    int  listDepth = 0;
+    int  listDepth = aInOuterList ? 1 : 0;
     int  libDepth = 0;
-    char lastNonWhitespace = 0;
+    char lastNonWhitespace = aInOuterList ? ')' : 0;
     bool inQuote = false;
     bool hasInsertedSpace = false;
     bool inMultiLineList = false;
@@ -145,8 +149,9 @@ void Prettify( std::string& aSource, FORMAT_MODE aMode )
                 while( seek != aSource.end() && isWhitespace( *seek ) )
                     seek++;
 
+                // A part which doesn't end the file is followed by the next list
                 if( seek == aSource.end() )
-                    return (char)0;
+                    return aAtEnd ? (char)0 : '(';
 
                 return *seek;
             };
@@ -237,7 +242,7 @@ void Prettify( std::string& aSource, FORMAT_MODE aMode )
                 bool currentIsShortForm = textSpecialCase && isShortForm( cursor );
                 bool currentIsLib = libSpecialCase && isLib( cursor );
 
-                if( formatted.empty() )
+                if( formatted.empty() && !aInOuterList )
                 {
                     formatted.push_back( '(' );
                     column++;
@@ -333,9 +338,22 @@ void Prettify( std::string& aSource, FORMAT_MODE aMode )
     }
 
     // newline required at end of line / file for POSIX compliance. Keeps git diffs clean.
-    formatted += '\n';
+    if( aAtEnd )
+        formatted += '\n';
 
     aSource = std::move( formatted );
 }
 
+
+void Prettify( std::string& aSource, FORMAT_MODE aMode )
+{
+    prettify( aSource, aMode, false, true );
+}
+
+
+void PrettifyPart( std::string& aSource, PRETTIFY_PART aPart, FORMAT_MODE aMode )
+{
+    prettify( aSource, aMode, aPart != PRETTIFY_PART::BEGIN, aPart == PRETTIFY_PART::END );
+}
+
 } // namespace KICAD_FORMAT
@@ -0,0 +1,42 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_PCB_ROUTE_H
+#define JOB_PCB_ROUTE_H
+
+#include <kicommon.h>
+#include <vector>
+#include "job.h"
+
+/**
+ * Route the unconnected pad to pad connections of a board with the interactive router.
+ */
+class KICOMMON_API JOB_PCB_ROUTE : public JOB
+{
+public:
+    JOB_PCB_ROUTE();
+
+    wxString              m_filename;
+    wxString              m_outputFile;  ///< Board to write, the input board if empty
+    std::vector<wxString> m_nets;        ///< Nets to route, all nets if empty
+    bool                  m_shove;       ///< Shove obstacles instead of walking around them
+    bool                  m_globalRoute; ///< Guide the router with a coarse global route
+};
+
+#endif
@@ -43,6 +43,13 @@ public:
      * @return true if the output process can proceed
      */
     virtual bool OutputPrecheck() { return true; }
+
+    /**
+     * @return true if the outputs written by a previous run can still be found at the output
+     *         path, so they can be kept when nothing they depend on has changed
+     */
+    virtual bool HasOutputs( PROJECT* aProject ) const { return false; }
+
     virtual bool HandleOutputs( const wxString&                aBaseTempPath,
                                 PROJECT*                       aProject,
                                 const std::vector<JOB_OUTPUT>& aOutputsToHandle,
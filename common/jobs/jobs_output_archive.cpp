@@ -19,6 +19,7 @@
  */
 
 #include <jobs/jobs_output_archive.h>
+#include <wx/filename.h>
 #include <wx/fs_zip.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
@@ -42,6 +43,27 @@ bool JOBS_OUTPUT_ARCHIVE::OutputPrecheck()
 }
 
 
+wxString JOBS_OUTPUT_ARCHIVE::resolveOutputPath( PROJECT* aProject ) const
+{
+    wxString outputPath = ExpandTextVars( m_outputPath, aProject );
+    outputPath = ExpandEnvVarSubstitutions( outputPath, aProject );
+
+    if( outputPath.StartsWith( "~" ) )
+        outputPath.Replace( "~", wxGetHomeDir(), false );
+
+    return EnsureFileExtension( outputPath, FILEEXT::ArchiveFileExtension );
+}
+
+
+bool JOBS_OUTPUT_ARCHIVE::HasOutputs( PROJECT* aProject ) const
+{
+    if( m_outputPath.IsEmpty() )
+        return false;
+
+    return wxFileName::FileExists( resolveOutputPath( aProject ) );
+}
+
+
 bool JOBS_OUTPUT_ARCHIVE::HandleOutputs( const wxString&                baseTempPath,
                                          PROJECT*                       aProject,
                                          const std::vector<JOB_OUTPUT>& aOutputsToHandle,
@@ -50,13 +72,7 @@ bool JOBS_OUTPUT_ARCHIVE::HandleOutputs( const wxString&                baseTemp
     bool success = true;
     aResolvedOutputPath.reset();
 
-    wxString outputPath = ExpandTextVars( m_outputPath, aProject );
-    outputPath = ExpandEnvVarSubstitutions( outputPath, aProject );
-
-    if( outputPath.StartsWith( "~" ) )
-        outputPath.Replace( "~", wxGetHomeDir(), false );
-
-    outputPath = EnsureFileExtension( outputPath, FILEEXT::ArchiveFileExtension );
+    wxString outputPath = resolveOutputPath( aProject );
 
     wxFFileOutputStream ostream( outputPath );
 
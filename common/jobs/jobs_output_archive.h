@@ -37,6 +37,7 @@ public:
                         const std::vector<JOB_OUTPUT>& aOutputsToHandle,
                         std::optional<wxString>&       aResolvedOutputPath ) override;
     bool OutputPrecheck() override;
+    bool HasOutputs( PROJECT* aProject ) const override;
 
     void FromJson( const nlohmann::json& j ) override;
     void ToJson( nlohmann::json& j ) const override;
@@ -46,6 +47,9 @@ public:
 
     wxString GetDefaultDescription() const override;
 
+private:
+    wxString resolveOutputPath( PROJECT* aProject ) const;
+
 private:
     FORMAT m_format;
 };
\ No newline at end of file
@@ -37,11 +37,7 @@ bool JOBS_OUTPUT_FOLDER::HandleOutputs( const wxString&                baseTempP
 {
     aResolvedOutputPath.reset();
 
-    wxString outputPath = ExpandTextVars( m_outputPath, aProject );
-    outputPath = ExpandEnvVarSubstitutions( outputPath, aProject );
-
-    if( outputPath.StartsWith( "~" ) )
-        outputPath.Replace( "~", wxGetHomeDir(), false );
+    wxString outputPath = resolveOutputPath( aProject );
 
     if( !wxFileName::DirExists( outputPath ) )
     {
@@ -66,6 +62,29 @@ bool JOBS_OUTPUT_FOLDER::HandleOutputs( const wxString&                baseTempP
 }
 
 
+wxString JOBS_OUTPUT_FOLDER::resolveOutputPath( PROJECT* aProject ) const
+{
+    wxString outputPath = ExpandTextVars( m_outputPath, aProject );
+    outputPath = ExpandEnvVarSubstitutions( outputPath, aProject );
+
+    if( outputPath.StartsWith( "~" ) )
+        outputPath.Replace( "~", wxGetHomeDir(), false );
+
+    return outputPath;
+}
+
+
+bool JOBS_OUTPUT_FOLDER::HasOutputs( PROJECT* aProject ) const
+{
+    if( m_outputPath.IsEmpty() )
+        return false;
+
+    wxString outputPath = resolveOutputPath( aProject );
+
+    return wxFileName::DirExists( outputPath ) && !wxFileName::IsDirEmpty( outputPath );
+}
+
+
 bool JOBS_OUTPUT_FOLDER::OutputPrecheck()
 {
     if( m_outputPath.IsEmpty() )
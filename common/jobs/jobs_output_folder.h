@@ -33,9 +33,13 @@ public:
                         std::optional<wxString>&       aResolvedOutputPath ) override;
 
     bool OutputPrecheck() override;
+    bool HasOutputs( PROJECT* aProject ) const override;
 
     void FromJson( const nlohmann::json& j ) override;
     void ToJson( nlohmann::json& j ) const override;
 
     wxString GetDefaultDescription() const override;
+
+private:
+    wxString resolveOutputPath( PROJECT* aProject ) const;
 };
\ No newline at end of file
@@ -29,6 +29,8 @@
 #include <kicad_curl/kicad_curl.h>
 #include <kicad_curl/kicad_curl_easy.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdarg>
 #include <cstddef>
 #include <exception>
@@ -73,6 +75,45 @@ static size_t write_callback( void* aContents, size_t aSize, size_t aNmemb, void
 }
 
 
+static size_t header_callback( char* aBuffer, size_t aSize, size_t aNmemb, void* aUserp )
+{
+    size_t realsize = aSize * aNmemb;
+
+    auto*       headers = static_cast<std::map<std::string, std::string>*>( aUserp );
+    std::string line( aBuffer, realsize );
+    size_t      colon = line.find( ':' );
+
+    // A status line starts the headers of each response, including redirects and 100-continue
+    if( line.rfind( "HTTP/", 0 ) == 0 )
+    {
+        headers->clear();
+    }
+    else if( colon != std::string::npos )
+    {
+        std::string name = line.substr( 0, colon );
+        std::string value = line.substr( colon + 1 );
+
+        std::transform( name.begin(), name.end(), name.begin(),
+                        []( unsigned char c )
+                        {
+                            return std::tolower( c );
+                        } );
+
+        size_t first = value.find_first_not_of( " \t" );
+        size_t last = value.find_last_not_of( " \t\r\n" );
+
+        if( first == std::string::npos )
+            value.clear();
+        else
+            value = value.substr( first, last - first + 1 );
+
+        ( *headers )[name] = value;
+    }
+
+    return realsize;
+}
+
+
 static size_t stream_write_callback( void* aContents, size_t aSize, size_t aNmemb, void* aUserp )
 {
     size_t realsize = aSize * aNmemb;
@@ -131,6 +172,8 @@ KICAD_CURL_EASY::KICAD_CURL_EASY() :
 
     curl_easy_setopt( m_CURL, CURLOPT_WRITEFUNCTION, write_callback );
     curl_easy_setopt( m_CURL, CURLOPT_WRITEDATA, static_cast<void*>( &m_buffer ) );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERFUNCTION, header_callback );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERDATA, static_cast<void*>( &m_responseHeaders ) );
 
     // Only allow HTTP and HTTPS protocols
 #if LIBCURL_VERSION_NUM >= 0x075500     // version 7.85.0
@@ -204,6 +247,7 @@ int KICAD_CURL_EASY::Perform()
 
     // bonus: retain worst case memory allocation, should re-use occur
     m_buffer.clear();
+    m_responseHeaders.clear();
 
     return curl_easy_perform( m_CURL );
 }
@@ -368,3 +412,19 @@ int KICAD_CURL_EASY::GetResponseStatusCode()
 
     return static_cast<int>( http_code );
 }
+
+
+std::string KICAD_CURL_EASY::GetResponseHeader( const std::string& aName ) const
+{
+    std::string name = aName;
+
+    std::transform( name.begin(), name.end(), name.begin(),
+                    []( unsigned char c )
+                    {
+                        return std::tolower( c );
+                    } );
+
+    auto it = m_responseHeaders.find( name );
+
+    return it != m_responseHeaders.end() ? it->second : std::string();
+}
@@ -35,22 +35,70 @@
 
 #include <json_common.h>
 
+#include <atomic>
 #include <cctype>
-#include <mutex>
+#include <memory>
 #include <utility>
 #include <stdlib.h>
 
 #include <wx/log.h>
 
-// boost:mt19937 is not thread-safe
-static std::mutex                                           rng_mutex;
+/**
+ * Per-thread UUID generator.  boost::mt19937 is not thread-safe, and sharing one generator
+ * behind a mutex serialized every item creation of parallel loaders and large pastes.
+ *
+ * Generators are created on first use (seeding is too expensive to do per UUID).  Without a
+ * call to SeedGenerator() each one gets its seed from basic_random_generator's default
+ * constructor.  After SeedGenerator(), the calling thread restarts the sequence from the given
+ * seed, and other threads reseed deterministically from it on their next UUID.
+ */
+struct UUID_GENERATOR
+{
+    std::unique_ptr<boost::mt19937>                                       m_rng;
+    std::unique_ptr<boost::uuids::basic_random_generator<boost::mt19937>> m_generator;
+    unsigned                                                              m_epoch = 0;
+};
+
+static std::atomic<unsigned>        g_seedEpoch( 0 );
+static std::atomic<unsigned>        g_seed( 0 );
+static std::atomic<unsigned>        g_reseededThreads( 0 );
+static thread_local UUID_GENERATOR  t_generator;
+
+
+static void seedThreadGenerator( unsigned aSeed, unsigned aEpoch )
+{
+    t_generator.m_generator.reset();
+    t_generator.m_rng = std::make_unique<boost::mt19937>( aSeed );
+    t_generator.m_generator =
+            std::make_unique<boost::uuids::basic_random_generator<boost::mt19937>>( *t_generator.m_rng );
+    t_generator.m_epoch = aEpoch;
+}
+
+
+static boost::uuids::uuid generateUuid()
+{
+    unsigned epoch = g_seedEpoch.load( std::memory_order_acquire );
+
+    if( !t_generator.m_generator || t_generator.m_epoch != epoch )
+    {
+        if( epoch == 0 )
+        {
+            t_generator.m_generator =
+                    std::make_unique<boost::uuids::basic_random_generator<boost::mt19937>>();
+            t_generator.m_rng.reset();
+            t_generator.m_epoch = 0;
+        }
+        else
+        {
+            // Distinct seeds per thread, or they would all produce the same UUIDs
+            unsigned threadIdx = g_reseededThreads.fetch_add( 1, std::memory_order_relaxed ) + 1;
+            seedThreadGenerator( g_seed.load( std::memory_order_relaxed ) + threadIdx * 0x9E3779B9u,
+                                 epoch );
+        }
+    }
 
-// Static rng and generators are used because the overhead of constant seeding is expensive
-// We rely on the default non-arg constructor of basic_random_generator to provide a random seed.
-// We use a separate rng object for cases where we want to control the basic_random_generator
-// initial seed by calling SeedGenerator from unit tests and other special cases.
-static boost::mt19937                                       rng;
-static boost::uuids::basic_random_generator<boost::mt19937> randomGenerator;
+    return ( *t_generator.m_generator )();
+}
 
 // These don't have the same performance penalty, but we might as well be consistent
 static boost::uuids::string_generator                       stringGenerator;
@@ -86,8 +134,7 @@ KIID::KIID()
         }
         else
         {
-            std::lock_guard<std::mutex> lock( rng_mutex );
-            m_uuid = randomGenerator();
+            m_uuid = generateUuid();
         }
 
 #if BOOST_VERSION >= 106700
@@ -148,7 +195,7 @@ KIID::KIID( const std::string& aString ) :
             {
 #endif
 
-                m_uuid = randomGenerator();
+                m_uuid = generateUuid();
 
 #if BOOST_VERSION >= 106700
             }
@@ -231,12 +278,6 @@ timestamp_t KIID::AsLegacyTimestamp() const
 }
 
 
-size_t KIID::Hash() const
-{
-    return boost::uuids::hash_value( m_uuid );
-}
-
-
 void KIID::Clone( const KIID& aUUID )
 {
     m_uuid = aUUID.m_uuid;
@@ -266,7 +307,7 @@ void KIID::ConvertTimestampToUuid()
     if( !IsLegacyTimestamp() )
         return;
 
-    m_uuid = randomGenerator();
+    m_uuid = generateUuid();
 }
 
 
@@ -293,8 +334,12 @@ void KIID::CreateNilUuids( bool aNil )
 
 void KIID::SeedGenerator( unsigned int aSeed )
 {
-    rng.seed( aSeed );
-    randomGenerator = boost::uuids::basic_random_generator<boost::mt19937>( rng );
+    g_seed.store( aSeed, std::memory_order_relaxed );
+    g_reseededThreads.store( 0, std::memory_order_relaxed );
+
+    unsigned epoch = g_seedEpoch.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+
+    seedThreadGenerator( aSeed, epoch );
 }
 
 
@@ -28,12 +28,13 @@
 #include <lib_tree_item.h>
 #include <pgm_base.h>
 #include <string_utils.h>
-
+#include <thread_pool.h>
 
 
 void LIB_TREE_NODE::RebuildSearchTerms( const std::vector<wxString>& aShownColumns )
 {
     m_SearchTerms = m_sourceSearchTerms;
+    m_MatchFailed = false;
 
     for( const auto& [name, value] : m_Fields )
     {
@@ -139,6 +140,7 @@ LIB_TREE_NODE::LIB_TREE_NODE()
       m_Type( TYPE::INVALID ),
       m_IntrinsicRank( 0 ),
       m_Score( 0 ),
+      m_MatchFailed( false ),
       m_Pinned( false ),
       m_PinCount( 0 ),
       m_Unit( 0 ),
@@ -221,6 +223,7 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
     aItem->GetChooserFields( m_Fields );
 
     m_sourceSearchTerms = aItem->GetSearchTerms();
+    m_MatchFailed = false;
 
     m_IsRoot = aItem->IsRoot();
     m_Children.clear();
@@ -233,21 +236,23 @@ void LIB_TREE_NODE_ITEM::Update( LIB_TREE_ITEM* aItem )
 void LIB_TREE_NODE_ITEM::UpdateScore( const std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>>& aMatchers,
                                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
-    m_Score = 1;
+    m_Score = m_MatchFailed ? 0 : 1;
 
     for( const std::unique_ptr<EDA_COMBINED_MATCHER>& matcher : aMatchers )
     {
+        if( m_Score == 0 )
+            break;
+
         int score = matcher->ScoreTerms( m_SearchTerms );
 
         if( score == 0 )
-        {
             m_Score = 0;
-            break;
-        }
-
-        m_Score += score;
+        else
+            m_Score += score;
     }
 
+    m_MatchFailed = !aMatchers.empty() && m_Score == 0;
+
     if( aFilter && !(*aFilter)(*this) )
         m_Score = 0;
 
@@ -350,7 +355,81 @@ void LIB_TREE_NODE_ROOT::Clear()
 void LIB_TREE_NODE_ROOT::UpdateScore( const std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>>& aMatchers,
                                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
-    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
-        child->UpdateScore( aMatchers, aFilter );
+    std::vector<wxString> patterns;
+
+    for( const std::unique_ptr<EDA_COMBINED_MATCHER>& matcher : aMatchers )
+        patterns.push_back( matcher->GetPattern() );
+
+    // Typing more characters of a plain or wildcard term can only reject more items.  Regular
+    // expressions and relational terms (e.g. "pins:<8" -> "pins:<80") give no such guarantee.
+    bool refines = !m_lastPatterns.empty() && patterns.size() >= m_lastPatterns.size();
+
+    for( size_t ii = 0; refines && ii < patterns.size(); ++ii )
+    {
+        if( patterns[ii].find_first_of( wxS( "/^$:<>=" ) ) != wxString::npos )
+            refines = false;
+        else if( ii < m_lastPatterns.size() && !patterns[ii].StartsWith( m_lastPatterns[ii] ) )
+            refines = false;
+    }
+
+    m_lastPatterns = std::move( patterns );
+
+    std::function<void( LIB_TREE_NODE& )> resetMatchFailed =
+            [&]( LIB_TREE_NODE& aNode )
+            {
+                aNode.m_MatchFailed = false;
+
+                for( std::unique_ptr<LIB_TREE_NODE>& child : aNode.m_Children )
+                    resetMatchFailed( *child );
+            };
+
+    if( !refines )
+        resetMatchFailed( *this );
+
+    // The matchers keep the state of their last match, so each block gets its own.  Filters
+    // look up library caches and are left to the serial pass below.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_blocks( size_t( 0 ), m_Children.size(),
+            [&]( size_t aStart, size_t aEnd )
+            {
+                std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>> matchers;
+
+                for( const std::unique_ptr<EDA_COMBINED_MATCHER>& m : aMatchers )
+                {
+                    matchers.push_back( std::make_unique<EDA_COMBINED_MATCHER>( m->GetPattern(),
+                                                                                m->GetContext() ) );
+                }
+
+                for( size_t ii = aStart; ii < aEnd; ++ii )
+                    m_Children[ii]->UpdateScore( matchers, nullptr );
+            } ).wait();
+
+    if( !aFilter )
+        return;
+
+    for( std::unique_ptr<LIB_TREE_NODE>& lib : m_Children )
+    {
+        if( lib->m_Children.empty() )
+            continue;
+
+        lib->m_Score = 0;
+
+        for( std::unique_ptr<LIB_TREE_NODE>& item : lib->m_Children )
+        {
+            if( item->m_Score > 0 && !(*aFilter)( *item ) )
+                item->m_Score = 0;
+
+            for( std::unique_ptr<LIB_TREE_NODE>& unit : item->m_Children )
+            {
+                unit->m_Score = aMatchers.empty() ? 1 : item->m_Score;
+
+                if( !(*aFilter)( *unit ) )
+                    unit->m_Score = 0;
+            }
+
+            lib->m_Score = std::max( lib->m_Score, item->m_Score );
+        }
+    }
 }
 
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <vector>
 #include <algorithm>
 
@@ -989,6 +990,7 @@ bool COMPILER::generateUCode( UCODE* aCode, CONTEXT* aPreflightContext )
                         stack.push_back( pnode );
 
                     node->leaf[1]->SetUop( TR_OP_METHOD_CALL, std::move( func ), std::move( vref ) );
+                    node->leaf[1]->uop->SetArgCount( (int) params.size() );
                     node->isTerminal = false;
                     break;
                 }
@@ -1345,4 +1347,288 @@ VALUE* UCODE::Run( CONTEXT* ctx )
 }
 
 
+double UCODE::RunAsDouble( CONTEXT* ctx )
+{
+    if( !m_closure || ctx->HasErrorCallback() )
+    {
+        VALUE* result = Run( ctx );
+        return result ? result->AsDouble() : 0.0;
+    }
+
+    try
+    {
+        return m_closure( ctx );
+    }
+    catch(...)
+    {
+        // rules which fail outright should not be fired; return 0/false
+        return 0.0;
+    }
+}
+
+
+bool UCODE::Optimize()
+{
+    // A symbolic version of the value stack.  Constants are kept as such for folding, and
+    // references until their use tells us how to specialize them.
+    struct OPERAND
+    {
+        const VALUE* constant = nullptr;
+        VAR_REF*     ref = nullptr;
+        CLOSURE      closure;
+    };
+
+    std::vector<OPERAND> stack;
+
+    m_closure = nullptr;
+    m_foldedValues.clear();
+
+    auto makeConstant =
+            [&]( double aValue ) -> OPERAND
+            {
+                m_foldedValues.push_back( std::make_unique<VALUE>( aValue ) );
+
+                OPERAND operand;
+                operand.constant = m_foldedValues.back().get();
+                return operand;
+            };
+
+    // Lower an operand used through AsDouble()
+    auto asDouble =
+            [&]( const OPERAND& aOperand ) -> CLOSURE
+            {
+                if( aOperand.constant )
+                {
+                    double value = aOperand.constant->AsDouble();
+                    return [value]( CONTEXT* ) { return value; };
+                }
+
+                if( aOperand.ref )
+                    return lowerNumericRef( aOperand.ref );
+
+                return aOperand.closure;
+            };
+
+    for( UOP* op : m_ucode )
+    {
+        int opcode = op->GetOp();
+
+        if( opcode == TR_UOP_PUSH_VALUE )
+        {
+            if( !op->GetValue() )
+                return false;
+
+            OPERAND operand;
+            operand.constant = op->GetValue();
+            stack.push_back( operand );
+        }
+        else if( opcode == TR_UOP_PUSH_VAR )
+        {
+            if( !op->GetRef() )
+                return false;
+
+            OPERAND operand;
+            operand.ref = op->GetRef();
+            stack.push_back( operand );
+        }
+        else if( opcode == TR_OP_METHOD_CALL )
+        {
+            // Method calls are pre-bound to their (constant) parameters
+            std::vector<VALUE*> args;
+
+            if( !op->GetFunc() || (int) stack.size() < op->GetArgCount() )
+                return false;
+
+            for( auto ii = stack.end() - op->GetArgCount(); ii != stack.end(); ++ii )
+            {
+                if( !ii->constant )
+                    return false;
+
+                args.push_back( const_cast<VALUE*>( ii->constant ) );
+            }
+
+            stack.resize( stack.size() - op->GetArgCount() );
+
+            OPERAND operand;
+            operand.closure =
+                    [func = op->GetFunc(), ref = op->GetRef(), args]( CONTEXT* aCtx ) -> double
+                    {
+                        int sp = aCtx->SP();
+
+                        for( VALUE* arg : args )
+                            aCtx->Push( arg );
+
+                        func( aCtx, ref );
+
+                        if( aCtx->SP() != sp + 1 )
+                            throw std::runtime_error( "malformed method call" );
+
+                        return aCtx->Pop()->AsDouble();
+                    };
+
+            // NB: the result may be a string, so unlike references it is never compared as such
+            stack.push_back( operand );
+        }
+        else if( opcode & TR_OP_BINARY_MASK )
+        {
+            if( stack.size() < 2 )
+                return false;
+
+            OPERAND arg2 = stack.back();
+            stack.pop_back();
+            OPERAND arg1 = stack.back();
+            stack.pop_back();
+
+            if( opcode == TR_OP_EQUAL || opcode == TR_OP_NOT_EQUAL )
+            {
+                if( arg1.constant && arg2.constant )
+                {
+                    bool equal = opcode == TR_OP_EQUAL ? arg1.constant->EqualTo( nullptr, arg2.constant )
+                                                       : arg1.constant->NotEqualTo( nullptr, arg2.constant );
+                    stack.push_back( makeConstant( equal ? 1.0 : 0.0 ) );
+                    continue;
+                }
+
+                if( !arg1.ref || !arg2.constant )
+                    return false;
+
+                OPERAND operand;
+                operand.closure = lowerComparison( opcode, arg1.ref, arg2.constant );
+
+                if( !operand.closure )
+                    return false;
+
+                stack.push_back( operand );
+                continue;
+            }
+
+            if( arg1.constant && arg2.constant )
+            {
+                double a = arg1.constant->AsDouble();
+                double b = arg2.constant->AsDouble();
+                double result;
+
+                switch( opcode )
+                {
+                case TR_OP_ADD:           result = a + b;                              break;
+                case TR_OP_SUB:           result = a - b;                              break;
+                case TR_OP_MUL:           result = a * b;                              break;
+                case TR_OP_DIV:           result = a / b;                              break;
+                case TR_OP_LESS_EQUAL:    result = a <= b ? 1 : 0;                     break;
+                case TR_OP_GREATER_EQUAL: result = a >= b ? 1 : 0;                     break;
+                case TR_OP_LESS:          result = a < b ? 1 : 0;                      break;
+                case TR_OP_GREATER:       result = a > b ? 1 : 0;                      break;
+                case TR_OP_BOOL_AND:      result = a != 0.0 && b != 0.0 ? 1 : 0;       break;
+                case TR_OP_BOOL_OR:       result = a != 0.0 || b != 0.0 ? 1 : 0;       break;
+                default:                  return false;
+                }
+
+                stack.push_back( makeConstant( result ) );
+                continue;
+            }
+
+            CLOSURE a = asDouble( arg1 );
+            CLOSURE b = asDouble( arg2 );
+
+            if( !a || !b )
+                return false;
+
+            OPERAND operand;
+
+            switch( opcode )
+            {
+            case TR_OP_ADD:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) + b( aCtx ); };
+                break;
+
+            case TR_OP_SUB:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) - b( aCtx ); };
+                break;
+
+            case TR_OP_MUL:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) * b( aCtx ); };
+                break;
+
+            case TR_OP_DIV:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) / b( aCtx ); };
+                break;
+
+            case TR_OP_LESS_EQUAL:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) <= b( aCtx ) ? 1.0 : 0.0; };
+                break;
+
+            case TR_OP_GREATER_EQUAL:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) >= b( aCtx ) ? 1.0 : 0.0; };
+                break;
+
+            case TR_OP_LESS:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) < b( aCtx ) ? 1.0 : 0.0; };
+                break;
+
+            case TR_OP_GREATER:
+                operand.closure = [a, b]( CONTEXT* aCtx ) { return a( aCtx ) > b( aCtx ) ? 1.0 : 0.0; };
+                break;
+
+            // Short-circuiting matches the interpreter, which doesn't evaluate the deferred
+            // result of the second operand either when the first one decides.
+            case TR_OP_BOOL_AND:
+                operand.closure =
+                        [a, b]( CONTEXT* aCtx )
+                        {
+                            return a( aCtx ) != 0.0 && b( aCtx ) != 0.0 ? 1.0 : 0.0;
+                        };
+                break;
+
+            case TR_OP_BOOL_OR:
+                operand.closure =
+                        [a, b]( CONTEXT* aCtx )
+                        {
+                            return a( aCtx ) != 0.0 || b( aCtx ) != 0.0 ? 1.0 : 0.0;
+                        };
+                break;
+
+            default:
+                return false;
+            }
+
+            stack.push_back( operand );
+        }
+        else if( opcode == TR_OP_BOOL_NOT )
+        {
+            if( stack.empty() )
+                return false;
+
+            OPERAND arg = stack.back();
+            stack.pop_back();
+
+            if( arg.constant )
+            {
+                stack.push_back( makeConstant( arg.constant->AsDouble() != 0.0 ? 0.0 : 1.0 ) );
+                continue;
+            }
+
+            CLOSURE a = asDouble( arg );
+
+            if( !a )
+                return false;
+
+            OPERAND operand;
+            operand.closure = [a]( CONTEXT* aCtx ) { return a( aCtx ) != 0.0 ? 0.0 : 1.0; };
+            stack.push_back( operand );
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if( stack.size() != 1 )
+        return false;
+
+    m_closure = asDouble( stack.back() );
+
+    return m_closure != nullptr;
+}
+
+
 } // namespace LIBEVAL
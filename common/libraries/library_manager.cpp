@@ -18,8 +18,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <common.h>
 #include <env_vars.h>
+#include <fstream>
 #include <list>
 #include <magic_enum.hpp>
 #include <unordered_set>
@@ -31,6 +33,7 @@
 #include <wildcards_and_files_ext.h>
 
 #include <libraries/library_manager.h>
+#include <libraries/library_metadata_cache.h>
 #include <settings/kicad_settings.h>
 #include <settings/settings_manager.h>
 #include <wx/dir.h>
@@ -761,6 +764,20 @@ bool LIBRARY_MANAGER::UrisAreEquivalent( const wxString& aURI1, const wxString&
 }
 
 
+LIBRARY_METADATA_CACHE& LIBRARY_MANAGER::MetadataCache()
+{
+    std::lock_guard<std::mutex> lock( m_metadataCacheMutex );
+
+    if( !m_metadataCache )
+    {
+        m_metadataCache =
+                std::make_unique<LIBRARY_METADATA_CACHE>( LIBRARY_METADATA_CACHE::DefaultFileName() );
+    }
+
+    return *m_metadataCache;
+}
+
+
 //////  LIBRARY_MANAGER_ADAPTER
 ///
 ///
@@ -968,6 +985,73 @@ void LIBRARY_MANAGER_ADAPTER::abortLoad()
 }
 
 
+void LIBRARY_MANAGER_ADAPTER::SetPreferredLibraries( const std::set<wxString>& aNicknames )
+{
+    m_preferredLibraries = aNicknames;
+}
+
+
+std::set<wxString> LIBRARY_MANAGER_ADAPTER::ReferencedLibraries( const wxString& aProjectPath,
+                                                                 const wxString& aFileSpec,
+                                                                 const std::vector<std::string>& aTokens )
+{
+    std::set<wxString> nicknames;
+    wxArrayString      files;
+
+    if( aProjectPath.IsEmpty() || !wxDirExists( aProjectPath ) )
+        return nicknames;
+
+    wxDir::GetAllFiles( aProjectPath, &files, aFileSpec, wxDIR_FILES | wxDIR_DIRS );
+
+    for( const wxString& file : files )
+    {
+        std::ifstream stream( file.fn_str(), std::ios::binary );
+        std::string   text( ( std::istreambuf_iterator<char>( stream ) ),
+                            std::istreambuf_iterator<char>() );
+
+        for( const std::string& token : aTokens )
+        {
+            size_t pos = 0;
+
+            while( ( pos = text.find( token, pos ) ) != std::string::npos )
+            {
+                pos += token.size();
+
+                size_t end = text.find( '"', pos );
+                size_t colon = text.find( ':', pos );
+
+                if( end == std::string::npos )
+                    break;
+
+                if( colon > pos && colon < end )
+                    nicknames.insert( wxString::FromUTF8( text.substr( pos, colon - pos ) ) );
+
+                pos = end;
+            }
+        }
+    }
+
+    wxLogTrace( traceLibraries, "ReferencedLibraries: %zu libraries used by %zu %s files",
+                nicknames.size(), files.size(), aFileSpec );
+
+    return nicknames;
+}
+
+
+void LIBRARY_MANAGER_ADAPTER::sortRowsForLoad( std::vector<LIBRARY_TABLE_ROW*>& aRows ) const
+{
+    if( m_preferredLibraries.empty() )
+        return;
+
+    // Tasks of a priority lane start in submission order
+    std::stable_partition( aRows.begin(), aRows.end(),
+                           [&]( const LIBRARY_TABLE_ROW* aRow )
+                           {
+                               return m_preferredLibraries.contains( aRow->Nickname() );
+                           } );
+}
+
+
 std::optional<float> LIBRARY_MANAGER_ADAPTER::AsyncLoadProgress() const
 {
     if( m_loadTotal == 0 )
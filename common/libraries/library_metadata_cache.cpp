@@ -0,0 +1,357 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libraries/library_metadata_cache.h>
+
+#include <cstring>
+
+#include <common.h>
+#include <kiplatform/io.h>
+#include <paths.h>
+#include <trace_helpers.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+
+namespace
+{
+
+const char     CACHE_MAGIC[8] = { 'K', 'I', 'C', 'A', 'D', 'L', 'M', 'C' };
+const uint32_t CACHE_VERSION = 1;
+const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+
+struct CACHE_HEADER
+{
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byteOrder;
+    uint32_t m_libraryCount;
+    uint32_t m_reserved;
+    uint64_t m_indexOffset;     ///< The library index follows the item records
+};
+
+
+/**
+ * Bounds checked reads from the cache file.
+ */
+struct CACHE_READER
+{
+    const char* m_data;
+    size_t      m_size;
+    size_t      m_pos;
+
+    template <typename T>
+    bool Read( T& aValue )
+    {
+        if( m_size - m_pos < sizeof( T ) )
+            return false;
+
+        memcpy( &aValue, m_data + m_pos, sizeof( T ) );
+        m_pos += sizeof( T );
+        return true;
+    }
+
+    bool ReadString( wxString& aValue )
+    {
+        uint32_t size;
+
+        if( !Read( size ) || m_size - m_pos < size )
+            return false;
+
+        aValue = wxString::FromUTF8( m_data + m_pos, size );
+        m_pos += size;
+        return true;
+    }
+};
+
+
+template <typename T>
+void append( std::string& aBuffer, const T& aValue )
+{
+    aBuffer.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+}
+
+
+void appendString( std::string& aBuffer, const wxString& aValue )
+{
+    wxScopedCharBuffer utf8 = aValue.utf8_str();
+
+    append( aBuffer, (uint32_t) utf8.length() );
+    aBuffer.append( utf8.data(), utf8.length() );
+}
+
+} // namespace
+
+
+LIBRARY_METADATA_CACHE::LIBRARY_METADATA_CACHE( const wxString& aFileName ) :
+        m_fileName( aFileName ),
+        m_opened( false ),
+        m_modified( false )
+{
+}
+
+
+LIBRARY_METADATA_CACHE::~LIBRARY_METADATA_CACHE()
+{
+}
+
+
+wxString LIBRARY_METADATA_CACHE::DefaultFileName()
+{
+    return PATHS::GetUserCachePath() + wxS( "library-metadata" );
+}
+
+
+long long LIBRARY_METADATA_CACHE::LibraryStamp( const wxString& aPath )
+{
+    if( aPath.IsEmpty() )
+        return 0;
+
+    // Directory libraries keep one item per file, so any edit shows in the sum of the files
+    if( wxFileName::DirExists( aPath ) )
+        return TimestampDir( aPath, wxS( "*" ) );
+
+    wxFileName fn( aPath );
+
+    if( !fn.FileExists() )
+        return 0;
+
+    return fn.GetModificationTime().GetValue().GetValue() + fn.GetSize().GetValue();
+}
+
+
+void LIBRARY_METADATA_CACHE::open()
+{
+    m_opened = true;
+    m_libraries.clear();
+    m_file.reset();
+
+    if( !wxFileExists( m_fileName ) )
+        return;
+
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> file =
+            std::make_unique<KIPLATFORM::IO::MAPPED_FILE>( m_fileName );
+
+    if( !file->IsMapped() )
+        return;
+
+    CACHE_READER reader{ file->Data(), file->Size(), 0 };
+    CACHE_HEADER header;
+
+    if( !reader.Read( header )
+            || memcmp( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) != 0
+            || header.m_version != CACHE_VERSION
+            || header.m_byteOrder != CACHE_BYTE_ORDER
+            || header.m_indexOffset > file->Size() )
+    {
+        wxLogTrace( traceLibraries, "Library metadata cache %s is not usable", m_fileName );
+        return;
+    }
+
+    std::map<KEY, LIBRARY> libraries;
+
+    reader.m_pos = header.m_indexOffset;
+
+    for( uint32_t ii = 0; ii < header.m_libraryCount; ++ii )
+    {
+        uint32_t type;
+        wxString path;
+        LIBRARY  library;
+        uint64_t offset;
+        uint64_t size;
+
+        if( !reader.Read( type ) || !reader.ReadString( path ) || !reader.Read( library.m_stamp )
+                || !reader.Read( library.m_itemCount ) || !reader.Read( offset )
+                || !reader.Read( size ) || offset > header.m_indexOffset
+                || size > header.m_indexOffset - offset )
+        {
+            return;
+        }
+
+        library.m_offset = offset;
+        library.m_size = size;
+        libraries[KEY( static_cast<LIBRARY_TABLE_TYPE>( type ), path )] = std::move( library );
+    }
+
+    m_file = std::move( file );
+    m_libraries = std::move( libraries );
+}
+
+
+bool LIBRARY_METADATA_CACHE::decode( const LIBRARY& aLibrary, std::vector<ITEM>& aItems ) const
+{
+    if( aLibrary.m_items )
+    {
+        aItems = *aLibrary.m_items;
+        return true;
+    }
+
+    if( !m_file )
+        return false;
+
+    CACHE_READER reader{ m_file->Data(), aLibrary.m_offset + aLibrary.m_size, aLibrary.m_offset };
+
+    aItems.clear();
+    aItems.reserve( aLibrary.m_itemCount );
+
+    for( uint32_t ii = 0; ii < aLibrary.m_itemCount; ++ii )
+    {
+        ITEM     item;
+        uint32_t count;
+        uint32_t uniqueCount;
+
+        if( !reader.ReadString( item.m_name ) || !reader.ReadString( item.m_description )
+                || !reader.ReadString( item.m_keywords ) || !reader.Read( count )
+                || !reader.Read( uniqueCount ) )
+        {
+            aItems.clear();
+            return false;
+        }
+
+        item.m_count = count;
+        item.m_uniqueCount = uniqueCount;
+        aItems.push_back( std::move( item ) );
+    }
+
+    return true;
+}
+
+
+void LIBRARY_METADATA_CACHE::encode( std::string& aBuffer, const std::vector<ITEM>& aItems )
+{
+    for( const ITEM& item : aItems )
+    {
+        appendString( aBuffer, item.m_name );
+        appendString( aBuffer, item.m_description );
+        appendString( aBuffer, item.m_keywords );
+        append( aBuffer, (uint32_t) item.m_count );
+        append( aBuffer, (uint32_t) item.m_uniqueCount );
+    }
+}
+
+
+bool LIBRARY_METADATA_CACHE::GetItems( LIBRARY_TABLE_TYPE aType, const wxString& aPath,
+                                       long long aStamp, std::vector<ITEM>& aItems )
+{
+    if( aStamp == 0 )
+        return false;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_opened )
+        open();
+
+    auto it = m_libraries.find( KEY( aType, aPath ) );
+
+    if( it == m_libraries.end() || it->second.m_stamp != aStamp )
+        return false;
+
+    return decode( it->second, aItems );
+}
+
+
+void LIBRARY_METADATA_CACHE::SetItems( LIBRARY_TABLE_TYPE aType, const wxString& aPath,
+                                       long long aStamp, std::vector<ITEM> aItems )
+{
+    if( aStamp == 0 )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_opened )
+        open();
+
+    LIBRARY& library = m_libraries[KEY( aType, aPath )];
+
+    library.m_stamp = aStamp;
+    library.m_itemCount = aItems.size();
+    library.m_items = std::move( aItems );
+    m_modified = true;
+}
+
+
+bool LIBRARY_METADATA_CACHE::Save()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( !m_modified )
+        return true;
+
+    std::string buffer( sizeof( CACHE_HEADER ), '\0' );
+    std::string index;
+
+    for( const auto& [key, library] : m_libraries )
+    {
+        size_t offset = buffer.size();
+
+        if( library.m_items )
+            encode( buffer, *library.m_items );
+        else if( m_file )
+            buffer.append( m_file->Data() + library.m_offset, library.m_size );
+
+        append( index, (uint32_t) key.first );
+        appendString( index, key.second );
+        append( index, library.m_stamp );
+        append( index, library.m_itemCount );
+        append( index, (uint64_t) offset );
+        append( index, (uint64_t) ( buffer.size() - offset ) );
+    }
+
+    CACHE_HEADER header = {};
+
+    memcpy( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+    header.m_version = CACHE_VERSION;
+    header.m_byteOrder = CACHE_BYTE_ORDER;
+    header.m_libraryCount = m_libraries.size();
+    header.m_indexOffset = buffer.size();
+
+    memcpy( buffer.data(), &header, sizeof( header ) );
+    buffer.append( index );
+
+    // The mapping has to be released before the file can be replaced
+    m_file.reset();
+    m_modified = false;
+
+    PATHS::EnsurePathExists( m_fileName, true );
+
+    wxFileName tmpFileName = wxFileName::CreateTempFileName( m_fileName );
+    wxFFile    file( tmpFileName.GetFullPath(), wxS( "wb" ) );
+    bool       ok = file.IsOpened() && file.Write( buffer.data(), buffer.size() ) == buffer.size();
+
+    ok &= file.Close();
+
+    if( ok )
+    {
+        KIPLATFORM::IO::DuplicatePermissions( m_fileName, tmpFileName.GetFullPath() );
+        ok = wxRenameFile( tmpFileName.GetFullPath(), m_fileName, true );
+    }
+
+    if( !ok )
+    {
+        // Not fatal; the libraries are simply enumerated again next session
+        wxRemoveFile( tmpFileName.GetFullPath() );
+    }
+
+    open();
+    return ok;
+}
@@ -26,6 +26,7 @@
 #include <lockfile.h>
 #include <settings/common_settings.h>
 #include <pgm_base.h>
+#include <thread_pool.h>
 #include <trace_helpers.h>
 #include <wildcards_and_files_ext.h>
 
@@ -48,6 +49,10 @@
 #include <functional>
 #include <cstring>
 
+/// Autosave commits between two repacks of the history repository
+static const int HISTORY_PACK_INTERVAL = 16;
+
+
 static wxString historyPath( const wxString& aProjectPath )
 {
     wxFileName p( aProjectPath, wxEmptyString );
@@ -61,6 +66,16 @@ LOCAL_HISTORY::LOCAL_HISTORY()
 
 LOCAL_HISTORY::~LOCAL_HISTORY()
 {
+    waitForPendingCommit();
+}
+
+
+bool LOCAL_HISTORY::waitForPendingCommit()
+{
+    if( !m_pendingCommit.valid() )
+        return true;
+
+    return m_pendingCommit.get();
 }
 
 void LOCAL_HISTORY::NoteFileChange( const wxString& aFile )
@@ -107,56 +122,105 @@ void LOCAL_HISTORY::ClearAllSavers()
 }
 
 
-bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath, const wxString& aTitle )
+/**
+ * Stage a file of the history mirror, unless the index already holds the same content.
+ *
+ * git_index_add_bypath() compresses every file it is given, even when the blob exists; hashing
+ * first is much cheaper for the unchanged files of a snapshot.
+ */
+static void stageMirroredFile( git_index* aIndex, const wxString& aHistoryPath,
+                               const std::string& aRelPath )
 {
-    if( !Pgm().GetCommonSettings()->m_Backup.enabled )
+    if( const git_index_entry* entry = git_index_get_bypath( aIndex, aRelPath.c_str(), 0 ) )
     {
-        wxLogTrace( traceAutoSave, wxS("Autosave disabled, returning" ) );
-        return true;
+        wxString path = aHistoryPath + wxFILE_SEP_PATH + wxString( aRelPath );
+        git_oid  oid;
+
+        if( git_odb_hashfile( &oid, path.mb_str().data(), GIT_OBJECT_BLOB ) == 0
+                && git_oid_equal( &oid, &entry->id ) )
+        {
+            return;
+        }
     }
 
-    wxLogTrace( traceAutoSave, wxS("[history] RunRegisteredSaversAndCommit start project='%s' title='%s' savers=%zu"),
-                aProjectPath, aTitle, m_savers.size() );
+    git_index_add_bypath( aIndex, aRelPath.c_str() );
+}
 
-    if( m_savers.empty() )
-    {
-        wxLogTrace( traceAutoSave, wxS("[history] no savers registered; skipping") );
+
+/**
+ * Replace the loose objects and earlier packs of the history repository by a single pack.
+ *
+ * Loose objects hold a whole compressed copy of every version of every file; in a pack the
+ * successive versions of a file are stored as deltas, so a snapshot of a large board where a
+ * few items moved costs little more than the items themselves.  Everything reachable from HEAD
+ * and the save tags is packed.  The caller holds the history lock, so no other writer can add
+ * objects meanwhile.
+ */
+static bool packLooseObjects( git_repository* aRepo )
+{
+    wxString objectsDir = wxString::FromUTF8( git_repository_path( aRepo ) ) + wxS( "objects" );
+    wxString packDir = objectsDir + wxFILE_SEP_PATH + wxS( "pack" );
+
+    wxArrayString oldPacks;
+
+    if( wxDirExists( packDir ) )
+        wxDir::GetAllFiles( packDir, &oldPacks, wxEmptyString, wxDIR_FILES );
+
+    git_packbuilder* rawBuilder = nullptr;
+    git_revwalk*     rawWalk = nullptr;
+
+    if( git_packbuilder_new( &rawBuilder, aRepo ) != 0 )
         return false;
-    }
 
-    std::vector<wxString> files;
+    std::unique_ptr<git_packbuilder, decltype( &git_packbuilder_free )> builder( rawBuilder,
+                                                                               &git_packbuilder_free );
 
-    for( const auto& [saverObject, saver] : m_savers )
+    if( git_revwalk_new( &rawWalk, aRepo ) != 0 )
+        return false;
+
+    std::unique_ptr<git_revwalk, decltype( &git_revwalk_free )> walk( rawWalk, &git_revwalk_free );
+
+    if( git_revwalk_push_head( walk.get() ) != 0 )
+        return false;
+
+    git_revwalk_push_glob( walk.get(), "refs/tags/*" );
+
+    if( git_packbuilder_insert_walk( builder.get(), walk.get() ) != 0
+            || git_packbuilder_write( builder.get(), nullptr, 0, nullptr, nullptr ) != 0 )
     {
-        size_t before = files.size();
-        saver( aProjectPath, files );
-        wxLogTrace( traceAutoSave, wxS("[history] saver %p added %zu files (total=%zu)"),
-                    saverObject, files.size() - before, files.size() );
+        wxLogTrace( traceAutoSave, wxS( "[history] packing failed" ) );
+        return false;
     }
 
-    // Filter out any files not within the project directory
-    wxString projectDir = aProjectPath;
-    if( !projectDir.EndsWith( wxFileName::GetPathSeparator() ) )
-        projectDir += wxFileName::GetPathSeparator();
+    for( const wxString& file : oldPacks )
+        wxRemoveFile( file );
 
-    auto it = std::remove_if( files.begin(), files.end(),
-        [&projectDir]( const wxString& file )
-        {
-            if( !file.StartsWith( projectDir ) )
-            {
-                wxLogTrace( traceAutoSave, wxS("[history] filtered out file outside project: %s"), file );
-                return true;
-            }
-            return false;
-        } );
-    files.erase( it, files.end() );
+    // Loose objects live in directories named after the first two hex digits of their id
+    wxDir    dir( objectsDir );
+    wxString name;
 
-    if( files.empty() )
+    for( bool cont = dir.GetFirst( &name, wxEmptyString, wxDIR_DIRS ); cont;
+         cont = dir.GetNext( &name ) )
     {
-        wxLogTrace( traceAutoSave, wxS("[history] saver set produced no files; skipping") );
-        return false;
+        if( name.length() != 2 || !wxIsxdigit( name[0] ) || !wxIsxdigit( name[1] ) )
+            continue;
+
+        wxFileName::Rmdir( objectsDir + wxFILE_SEP_PATH + name, wxPATH_RMDIR_RECURSIVE );
     }
 
+    wxLogTrace( traceAutoSave, wxS( "[history] packed %zu objects" ),
+                git_packbuilder_object_count( builder.get() ) );
+    return true;
+}
+
+
+/**
+ * Stage the given files into the history mirror and commit them if anything differs from HEAD.
+ * Runs on a worker thread; it only touches files, never the documents they were saved from.
+ */
+static bool commitMirroredFiles( const wxString& aProjectPath, const std::vector<wxString>& aFiles,
+                                 const wxString& aTitle, bool aPack )
+{
     // Acquire locks using hybrid locking strategy
     HISTORY_LOCK_MANAGER lock( aProjectPath );
 
@@ -171,7 +235,7 @@ bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath,
     wxString hist = historyPath( aProjectPath );
 
     // Stage selected files (mirroring logic from CommitSnapshot but limited to given files)
-    for( const wxString& file : files )
+    for( const wxString& file : aFiles )
     {
         wxFileName src( file );
 
@@ -185,7 +249,7 @@ bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath,
         if( src.GetFullPath().StartsWith( hist + wxFILE_SEP_PATH ) )
         {
             std::string relHist = src.GetFullPath().ToStdString().substr( hist.length() + 1 );
-            git_index_add_bypath( index, relHist.c_str() );
+            stageMirroredFile( index, hist, relHist );
             wxLogTrace( traceAutoSave, wxS("[history] staged pre-mirrored '%s'"), file );
             continue;
         }
@@ -204,7 +268,7 @@ bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath,
         wxFileName::Mkdir( dstDir.GetPath(), 0777, wxPATH_MKDIR_FULL );
         wxCopyFile( src.GetFullPath(), dst.GetFullPath(), true );
         std::string rel = dst.GetFullPath().ToStdString().substr( hist.length() + 1 );
-        git_index_add_bypath( index, rel.c_str() );
+        stageMirroredFile( index, hist, rel );
         wxLogTrace( traceAutoSave, wxS("[history] staged '%s' as '%s'"), file, wxString::FromUTF8( rel ) );
     }
 
@@ -278,17 +342,91 @@ bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath,
 
     if( rc == 0 )
         wxLogTrace( traceAutoSave, wxS("[history] commit created %s (%s files=%zu)"),
-                    wxString::FromUTF8( git_oid_tostr_s( &commit_id ) ), msg, files.size() );
+                    wxString::FromUTF8( git_oid_tostr_s( &commit_id ) ), msg, aFiles.size() );
     else
         wxLogTrace( traceAutoSave, wxS("[history] commit failed rc=%d"), rc );
 
     if( parent ) git_commit_free( parent );
 
     git_index_write( index );
+
+    if( rc == 0 && aPack )
+        packLooseObjects( repo );
+
     return rc == 0;
 }
 
 
+bool LOCAL_HISTORY::RunRegisteredSaversAndCommit( const wxString& aProjectPath, const wxString& aTitle )
+{
+    if( !Pgm().GetCommonSettings()->m_Backup.enabled )
+    {
+        wxLogTrace( traceAutoSave, wxS("Autosave disabled, returning" ) );
+        return true;
+    }
+
+    wxLogTrace( traceAutoSave, wxS("[history] RunRegisteredSaversAndCommit start project='%s' title='%s' savers=%zu"),
+                aProjectPath, aTitle, m_savers.size() );
+
+    // The savers write into the mirror the previous commit may still be reading
+    waitForPendingCommit();
+
+    if( m_savers.empty() )
+    {
+        wxLogTrace( traceAutoSave, wxS("[history] no savers registered; skipping") );
+        return false;
+    }
+
+    std::vector<wxString> files;
+
+    for( const auto& [saverObject, saver] : m_savers )
+    {
+        size_t before = files.size();
+        saver( aProjectPath, files );
+        wxLogTrace( traceAutoSave, wxS("[history] saver %p added %zu files (total=%zu)"),
+                    saverObject, files.size() - before, files.size() );
+    }
+
+    // Filter out any files not within the project directory
+    wxString projectDir = aProjectPath;
+    if( !projectDir.EndsWith( wxFileName::GetPathSeparator() ) )
+        projectDir += wxFileName::GetPathSeparator();
+
+    auto it = std::remove_if( files.begin(), files.end(),
+        [&projectDir]( const wxString& file )
+        {
+            if( !file.StartsWith( projectDir ) )
+            {
+                wxLogTrace( traceAutoSave, wxS("[history] filtered out file outside project: %s"), file );
+                return true;
+            }
+            return false;
+        } );
+    files.erase( it, files.end() );
+
+    if( files.empty() )
+    {
+        wxLogTrace( traceAutoSave, wxS("[history] saver set produced no files; skipping") );
+        return false;
+    }
+
+    // Hashing and compressing the snapshot is left to a worker so that the editor never waits
+    // for it; the next history operation waits instead.
+    bool pack = ++m_commitsSincePack >= HISTORY_PACK_INTERVAL;
+
+    if( pack )
+        m_commitsSincePack = 0;
+
+    m_pendingCommit = GetKiCadThreadPool().submit_task(
+            [aProjectPath, files, aTitle, pack]()
+            {
+                return commitMirroredFiles( aProjectPath, files, aTitle, pack );
+            } );
+
+    return true;
+}
+
+
 bool LOCAL_HISTORY::CommitPending()
 {
     std::vector<wxString> files( m_pendingFiles.begin(), m_pendingFiles.end() );
@@ -299,6 +437,8 @@ bool LOCAL_HISTORY::CommitPending()
 
 bool LOCAL_HISTORY::Init( const wxString& aProjectPath )
 {
+    waitForPendingCommit();
+
     if( aProjectPath.IsEmpty() )
         return false;
 
@@ -459,7 +599,7 @@ static bool commitSnapshotWithLock( git_repository* repo, git_index* index,
 
         // Path inside repo (strip hist + '/').
         std::string rel = dst.GetFullPath().ToStdString().substr( aHistoryPath.length() + 1 );
-        git_index_add_bypath( index, rel.c_str() );
+        stageMirroredFile( index, aHistoryPath, rel );
     }
 
     git_oid tree_id;
@@ -535,6 +675,8 @@ static bool commitSnapshotWithLock( git_repository* repo, git_index* index,
 
 bool LOCAL_HISTORY::CommitSnapshot( const std::vector<wxString>& aFiles, const wxString& aTitle )
 {
+    waitForPendingCommit();
+
     if( aFiles.empty() || !Pgm().GetCommonSettings()->m_Backup.enabled )
         return true;
 
@@ -624,6 +766,8 @@ bool LOCAL_HISTORY::HistoryExists( const wxString& aProjectPath )
 
 bool LOCAL_HISTORY::TagSave( const wxString& aProjectPath, const wxString& aFileType )
 {
+    waitForPendingCommit();
+
     HISTORY_LOCK_MANAGER lock( aProjectPath );
 
     if( !lock.IsLocked() )
@@ -674,6 +818,8 @@ bool LOCAL_HISTORY::TagSave( const wxString& aProjectPath, const wxString& aFile
 
 bool LOCAL_HISTORY::HeadNewerThanLastSave( const wxString& aProjectPath )
 {
+    waitForPendingCommit();
+
     wxString hist = historyPath( aProjectPath );
     git_repository* repo = nullptr;
 
@@ -730,6 +876,8 @@ bool LOCAL_HISTORY::HeadNewerThanLastSave( const wxString& aProjectPath )
 bool LOCAL_HISTORY::CommitDuplicateOfLastSave( const wxString& aProjectPath, const wxString& aFileType,
                                                const wxString& aMessage )
 {
+    waitForPendingCommit();
+
     HISTORY_LOCK_MANAGER lock( aProjectPath );
 
     if( !lock.IsLocked() )
@@ -821,6 +969,8 @@ static size_t dirSizeRecursive( const wxString& path )
 
 bool LOCAL_HISTORY::EnforceSizeLimit( const wxString& aProjectPath, size_t aMaxBytes )
 {
+    waitForPendingCommit();
+
     if( aMaxBytes == 0 )
         return false;
 
@@ -1178,6 +1328,8 @@ bool LOCAL_HISTORY::EnforceSizeLimit( const wxString& aProjectPath, size_t aMaxB
 
 wxString LOCAL_HISTORY::GetHeadHash( const wxString& aProjectPath )
 {
+    waitForPendingCommit();
+
     wxString hist = historyPath( aProjectPath );
     git_repository* repo = nullptr;
 
@@ -1679,6 +1831,8 @@ bool recordRestoreInHistory( git_repository* aRepo, git_commit* aCommit, git_tre
 bool LOCAL_HISTORY::RestoreCommit( const wxString& aProjectPath, const wxString& aHash,
                                    wxWindow* aParent )
 {
+    waitForPendingCommit();
+
     // STEP 1: Verify no files are open by checking for LOCKFILEs
     wxLogTrace( traceAutoSave, wxS( "[history] RestoreCommit: Checking for open files in %s" ),
                aProjectPath );
@@ -1857,6 +2011,8 @@ bool LOCAL_HISTORY::RestoreCommit( const wxString& aProjectPath, const wxString&
 
 void LOCAL_HISTORY::ShowRestoreDialog( const wxString& aProjectPath, wxWindow* aParent )
 {
+    waitForPendingCommit();
+
     if( !HistoryExists( aProjectPath ) )
         return;
 
@@ -0,0 +1,111 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include <memory_usage.h>
+
+
+namespace
+{
+struct REGISTRY
+{
+    struct ENTRY
+    {
+        wxString               m_Subsystem;
+        MEMORY_USAGE::PROVIDER m_Provider;
+    };
+
+    std::mutex           m_mutex;
+    std::map<int, ENTRY> m_entries;     // by id, so by registration order
+    int                  m_nextId = 0;
+};
+
+
+REGISTRY& registry()
+{
+    static REGISTRY reg;
+    return reg;
+}
+} // namespace
+
+
+int MEMORY_USAGE::Register( const wxString& aSubsystem, PROVIDER aProvider )
+{
+    REGISTRY&                   reg = registry();
+    std::lock_guard<std::mutex> lock( reg.m_mutex );
+
+    int id = reg.m_nextId++;
+    reg.m_entries[id] = { aSubsystem, std::move( aProvider ) };
+    return id;
+}
+
+
+void MEMORY_USAGE::Unregister( int aId )
+{
+    REGISTRY&                   reg = registry();
+    std::lock_guard<std::mutex> lock( reg.m_mutex );
+
+    reg.m_entries.erase( aId );
+}
+
+
+std::vector<std::pair<wxString, size_t>> MEMORY_USAGE::Collect()
+{
+    REGISTRY&                                reg = registry();
+    std::lock_guard<std::mutex>              lock( reg.m_mutex );
+    std::vector<std::pair<wxString, size_t>> usage;
+
+    for( const auto& [id, entry] : reg.m_entries )
+    {
+        size_t bytes = entry.m_Provider ? entry.m_Provider() : 0;
+        auto   it = std::find_if( usage.begin(), usage.end(),
+                                  [&]( const std::pair<wxString, size_t>& aUsage )
+                                  {
+                                      return aUsage.first == entry.m_Subsystem;
+                                  } );
+
+        if( it != usage.end() )
+            it->second += bytes;
+        else
+            usage.emplace_back( entry.m_Subsystem, bytes );
+    }
+
+    return usage;
+}
+
+
+wxString MEMORY_USAGE::Report( const wxString& aIndent, const wxString& aEol )
+{
+    wxString report;
+
+    for( const auto& [subsystem, bytes] : Collect() )
+    {
+        report << aIndent << subsystem << ": "
+               << wxString::Format( wxS( "%.1f MB" ), bytes / ( 1024.0 * 1024.0 ) ) << aEol;
+    }
+
+    return report;
+}
@@ -17,7 +17,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "ollama_client.h"
+#include <ollama_client.h>
 #include <curl/curl.h>
 #include <cstring>
 #include <kicad_curl/kicad_curl_easy.h>
@@ -25,9 +25,57 @@
 #include <sstream>
 #include <wx/log.h>
 #include <atomic>
+#include <array>
+#include <core/profile.h>
 
 using json = nlohmann::json;
 
+
+/**
+ * A curl share object letting every handle of a client reuse the same connections, DNS
+ * lookups and TLS sessions.  Handles may run on different threads, so access is serialized
+ * per data type.
+ */
+struct OLLAMA_CURL_SHARE
+{
+    OLLAMA_CURL_SHARE()
+    {
+        m_share = curl_share_init();
+
+        if( !m_share )
+            return;
+
+        curl_share_setopt( m_share, CURLSHOPT_LOCKFUNC, lock );
+        curl_share_setopt( m_share, CURLSHOPT_UNLOCKFUNC, unlock );
+        curl_share_setopt( m_share, CURLSHOPT_USERDATA, this );
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS );
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION );
+#if LIBCURL_VERSION_NUM >= 0x073900     // version 7.57.0
+        curl_share_setopt( m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT );
+#endif
+    }
+
+    ~OLLAMA_CURL_SHARE()
+    {
+        if( m_share )
+            curl_share_cleanup( m_share );
+    }
+
+    static void lock( CURL*, curl_lock_data aData, curl_lock_access, void* aUser )
+    {
+        static_cast<OLLAMA_CURL_SHARE*>( aUser )->m_locks[aData].lock();
+    }
+
+    static void unlock( CURL*, curl_lock_data aData, void* aUser )
+    {
+        static_cast<OLLAMA_CURL_SHARE*>( aUser )->m_locks[aData].unlock();
+    }
+
+    CURLSH*                                     m_share;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> m_locks;
+};
+
+
 namespace
 {
     std::string TrimWhitespace( const std::string& aValue )
@@ -47,6 +95,9 @@ namespace
         std::string eventPayload;
         std::string lastResponse;
         bool done = false;
+
+        PROF_TIMER                   timer;
+        OLLAMA_CLIENT::STREAM_STATS* stats = nullptr;
     };
 
     void ProcessStreamEvent( StreamContext& aContext )
@@ -65,10 +116,14 @@ namespace
             json chunk = json::parse( payload );
             auto sendChunk = [&]( const std::string& aText )
             {
-                if( aText.empty() || !aContext.callback )
+                if( aText.empty() )
                     return;
 
-                aContext.callback( wxString::FromUTF8( aText ) );
+                if( aContext.stats && aContext.stats->chunks++ == 0 )
+                    aContext.stats->firstChunkMsecs = aContext.timer.msecs();
+
+                if( aContext.callback )
+                    aContext.callback( wxString::FromUTF8( aText ) );
             };
 
             // Ollama /api/generate streaming mode returns one JSON object per line.
@@ -80,6 +135,20 @@ namespace
             if( chunk.contains( "done" ) && chunk["done"].is_boolean() && chunk["done"].get<bool>() )
             {
                 aContext.done = true;
+
+                // The final object carries the server's token accounting
+                if( aContext.stats )
+                {
+                    if( chunk.contains( "prompt_eval_count" ) && chunk["prompt_eval_count"].is_number_integer() )
+                        aContext.stats->promptTokens = chunk["prompt_eval_count"].get<long long>();
+
+                    if( chunk.contains( "eval_count" ) && chunk["eval_count"].is_number_integer() )
+                        aContext.stats->responseTokens = chunk["eval_count"].get<long long>();
+
+                    if( chunk.contains( "eval_duration" ) && chunk["eval_duration"].is_number() )
+                        aContext.stats->evalSecs = chunk["eval_duration"].get<double>() / 1e9;
+                }
+
                 // Final chunk may still contain a response field with the last piece of text
                 if( chunk.contains( "response" ) && chunk["response"].is_string() )
                 {
@@ -189,8 +258,31 @@ namespace
 
 OLLAMA_CLIENT::OLLAMA_CLIENT( const wxString& aBaseUrl ) :
     m_baseUrl( aBaseUrl ),
-    m_curl( std::make_unique<KICAD_CURL_EASY>() )
+    m_keepAlive( wxS( "30m" ) ),
+    m_share( std::make_unique<OLLAMA_CURL_SHARE>() )
+{
+    m_curl = createHandle();
+    m_streamCurl = createHandle();
+
+    // Ollama streams newline-delimited JSON rather than classic SSE.
+    m_streamCurl->SetHeader( "Accept", "application/json" );
+}
+
+
+std::unique_ptr<KICAD_CURL_EASY> OLLAMA_CLIENT::createHandle()
 {
+    std::unique_ptr<KICAD_CURL_EASY> curl = std::make_unique<KICAD_CURL_EASY>();
+
+    // KICAD_CURL_EASY appends headers, so only set them once per handle
+    curl->SetHeader( "Content-Type", "application/json" );
+
+    if( m_share && m_share->m_share )
+        curl_easy_setopt( curl->GetCurl(), CURLOPT_SHARE, m_share->m_share );
+
+    // Keep idle connections to the agent server alive between turns
+    curl_easy_setopt( curl->GetCurl(), CURLOPT_TCP_KEEPALIVE, 1L );
+
+    return curl;
 }
 
 
@@ -212,15 +304,20 @@ bool OLLAMA_CLIENT::ChatCompletion( const wxString& aModel, const wxString& aPro
     request["stream"] = false;
     if( !aSystemPrompt.IsEmpty() )
         request["system"] = aSystemPrompt.ToStdString();
+    if( !m_keepAlive.IsEmpty() )
+        request["keep_alive"] = m_keepAlive.ToStdString();
 
     std::string requestBody = request.dump();
 
     // Set up curl
     wxString url = m_baseUrl + wxS( "/api/generate" );
     m_curl->SetURL( url.ToUTF8().data() );
-    m_curl->SetHeader( "Content-Type", "application/json" );
     m_curl->SetPostFields( requestBody );
 
+    // IsAvailable() may have shortened the timeouts on this handle
+    curl_easy_setopt( m_curl->GetCurl(), CURLOPT_TIMEOUT, 0L );
+    curl_easy_setopt( m_curl->GetCurl(), CURLOPT_CONNECTTIMEOUT, 0L );
+
     // Perform request
     int result = m_curl->Perform();
 
@@ -262,9 +359,21 @@ bool OLLAMA_CLIENT::ChatCompletion( const wxString& aModel, const wxString& aPro
 bool OLLAMA_CLIENT::StreamChatCompletion( const wxString& aModel, const wxString& aPrompt,
                                          StreamCallback aChunkCallback, wxString& aResponse,
                                          const std::atomic<bool>* aCancelFlag,
-                                         const wxString& aSystemPrompt )
+                                         const wxString& aSystemPrompt,
+                                         STREAM_STATS* aStats )
 {
-    KICAD_CURL_EASY streamCurl;
+    // Reuse the persistent handle (and its open connection) unless another stream is already
+    // using it, in which case a temporary handle still shares the connection cache.
+    std::unique_lock<std::mutex>     streamLock( m_streamMutex, std::try_to_lock );
+    std::unique_ptr<KICAD_CURL_EASY> tempCurl;
+
+    if( !streamLock.owns_lock() )
+    {
+        tempCurl = createHandle();
+        tempCurl->SetHeader( "Accept", "application/json" );
+    }
+
+    KICAD_CURL_EASY& streamCurl = tempCurl ? *tempCurl : *m_streamCurl;
 
     json request;
     request["model"] = aModel.ToStdString();
@@ -272,27 +381,30 @@ bool OLLAMA_CLIENT::StreamChatCompletion( const wxString& aModel, const wxString
     request["stream"] = true;
     if( !aSystemPrompt.IsEmpty() )
         request["system"] = aSystemPrompt.ToStdString();
+    if( !m_keepAlive.IsEmpty() )
+        request["keep_alive"] = m_keepAlive.ToStdString();
 
     std::string requestBody = request.dump();
 
     wxString url = m_baseUrl + wxS( "/api/generate" );
     streamCurl.SetURL( url.ToUTF8().data() );
-    streamCurl.SetHeader( "Content-Type", "application/json" );
-    // Ollama streams newline-delimited JSON rather than classic SSE.
-    streamCurl.SetHeader( "Accept", "application/json" );
     streamCurl.SetPostFields( requestBody );
 
-    if( aCancelFlag )
+    // Always (re)install the callback since the handle outlives the previous call's flag
+    streamCurl.SetTransferCallback( [aCancelFlag]( size_t, size_t, size_t, size_t ) -> int
     {
-        streamCurl.SetTransferCallback( [aCancelFlag]( size_t, size_t, size_t, size_t ) -> int
-        {
-            return aCancelFlag->load( std::memory_order_relaxed ) ? 1 : 0;
-        }, 100 );
-    }
+        return aCancelFlag && aCancelFlag->load( std::memory_order_relaxed ) ? 1 : 0;
+    }, 100 );
 
     StreamContext context;
     context.callback = std::move( aChunkCallback );
 
+    if( aStats )
+    {
+        *aStats = STREAM_STATS();
+        context.stats = aStats;
+    }
+
     curl_easy_setopt( streamCurl.GetCurl(), CURLOPT_WRITEFUNCTION, StreamWriteCallback );
     curl_easy_setopt( streamCurl.GetCurl(), CURLOPT_WRITEDATA, static_cast<void*>( &context ) );
 
@@ -300,7 +412,10 @@ bool OLLAMA_CLIENT::StreamChatCompletion( const wxString& aModel, const wxString
 
     if( result != 0 )
     {
-        wxLogError( wxS( "Python agent streaming request failed with code: %d" ), result );
+        // A cancelled request is not an error worth reporting
+        if( !aCancelFlag || !aCancelFlag->load( std::memory_order_relaxed ) )
+            wxLogError( wxS( "Python agent streaming request failed with code: %d" ), result );
+
         return false;
     }
 
@@ -322,7 +437,10 @@ bool OLLAMA_CLIENT::StreamChatCompletion( const wxString& aModel, const wxString
     }
 
     aResponse = wxString::FromUTF8( context.lastResponse );
-    
+
+    if( aStats )
+        aStats->totalMsecs = context.timer.msecs();
+
     if( context.done )
     {
         wxLogMessage( wxS( "Stream completed successfully. Total response length: %zu characters" ),
@@ -338,6 +456,125 @@ bool OLLAMA_CLIENT::StreamChatCompletion( const wxString& aModel, const wxString
 }
 
 
+bool OLLAMA_CLIENT::Embed( const wxString& aModel, const std::vector<wxString>& aInputs,
+                           std::vector<std::vector<float>>& aEmbeddings )
+{
+    aEmbeddings.clear();
+
+    if( aInputs.empty() )
+        return true;
+
+    json request;
+    request["model"] = aModel.ToStdString();
+    request["input"] = json::array();
+
+    for( const wxString& input : aInputs )
+        request["input"].push_back( input.ToUTF8().data() );
+
+    std::string                      requestBody = request.dump();
+    std::unique_ptr<KICAD_CURL_EASY> curl = createHandle();
+    wxString                         url = m_baseUrl + wxS( "/api/embed" );
+
+    curl->SetURL( url.ToUTF8().data() );
+    curl->SetPostFields( requestBody );
+
+    int result = curl->Perform();
+
+    if( result != 0 )
+    {
+        wxLogTrace( wxS( "KICAD_OLLAMA" ), wxS( "Embedding request failed with code: %d" ), result );
+        return false;
+    }
+
+    try
+    {
+        json response = json::parse( curl->GetBuffer() );
+
+        if( !response.contains( "embeddings" ) || !response["embeddings"].is_array()
+                || response["embeddings"].size() != aInputs.size() )
+        {
+            return false;
+        }
+
+        for( const json& vector : response["embeddings"] )
+            aEmbeddings.push_back( vector.get<std::vector<float>>() );
+    }
+    catch( const json::exception& e )
+    {
+        wxLogTrace( wxS( "KICAD_OLLAMA" ), wxS( "Failed to parse embedding response: %s" ),
+                    wxString::FromUTF8( e.what() ) );
+        aEmbeddings.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+size_t OLLAMA_CLIENT::responseKey( const wxString& aModel, const wxString& aPrompt,
+                                   const wxString& aSystemPrompt )
+{
+    std::string key = aModel.ToStdString();
+
+    key.push_back( '\0' );
+    key += aSystemPrompt.ToUTF8().data();
+    key.push_back( '\0' );
+    key += aPrompt.ToUTF8().data();
+
+    return std::hash<std::string>()( key );
+}
+
+
+bool OLLAMA_CLIENT::FindCachedResponse( const wxString& aModel, const wxString& aPrompt,
+                                        const wxString& aSystemPrompt, wxString& aResponse )
+{
+    size_t                      key = responseKey( aModel, aPrompt, aSystemPrompt );
+    std::lock_guard<std::mutex> lock( m_responseMutex );
+    auto                        it = m_responseIndex.find( key );
+
+    if( it == m_responseIndex.end() )
+        return false;
+
+    m_responses.splice( m_responses.begin(), m_responses, it->second );
+    aResponse = it->second->second;
+    return true;
+}
+
+
+void OLLAMA_CLIENT::RememberResponse( const wxString& aModel, const wxString& aPrompt,
+                                      const wxString& aSystemPrompt, const wxString& aResponse )
+{
+    size_t                      key = responseKey( aModel, aPrompt, aSystemPrompt );
+    std::lock_guard<std::mutex> lock( m_responseMutex );
+    auto                        it = m_responseIndex.find( key );
+
+    if( it != m_responseIndex.end() )
+    {
+        it->second->second = aResponse;
+        m_responses.splice( m_responses.begin(), m_responses, it->second );
+        return;
+    }
+
+    m_responses.emplace_front( key, aResponse );
+    m_responseIndex[key] = m_responses.begin();
+
+    if( m_responses.size() > RESPONSE_CACHE_SIZE )
+    {
+        m_responseIndex.erase( m_responses.back().first );
+        m_responses.pop_back();
+    }
+}
+
+
+void OLLAMA_CLIENT::ClearResponseCache()
+{
+    std::lock_guard<std::mutex> lock( m_responseMutex );
+
+    m_responses.clear();
+    m_responseIndex.clear();
+}
+
+
 bool OLLAMA_CLIENT::IsAvailable()
 {
     if( !m_curl )
@@ -350,6 +587,9 @@ bool OLLAMA_CLIENT::IsAvailable()
     // The agent will proxy to Ollama, so this checks both agent and Ollama availability
     wxString url = m_baseUrl + wxS( "/api/tags" );
     m_curl->SetURL( url.ToUTF8().data() );
+
+    // The handle may still be set up for a POST from a previous completion
+    curl_easy_setopt( m_curl->GetCurl(), CURLOPT_HTTPGET, 1L );
     
     // Set a reasonable timeout for availability check
     curl_easy_setopt( m_curl->GetCurl(), CURLOPT_TIMEOUT, 5L );
@@ -51,6 +51,7 @@
 #include <common.h>
 #include <confirm.h>
 #include <core/arraydim.h>
+#include <core/profile.h>
 #include <id.h>
 #include <kicad_curl/kicad_curl.h>
 #include <kiplatform/policy.h>
@@ -322,6 +323,8 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     loc.Init();
 #endif
 
+    PROF_TIMER startupTimer;
+
     // Just make sure we init precreate any folders early for later code
     // In particular, the user cache path is the most likely to be hit by startup code
     PATHS::EnsureUserPathsExist();
@@ -377,6 +380,9 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     m_pgm_checker = std::make_unique<wxSingleInstanceChecker>();
     m_pgm_checker->Create( instanceCheckerName, instanceCheckerDir );
 
+    wxLogTrace( traceStartup, wxT( "InitPgm: paths, curl, sentry and instance checker %0.1f ms" ),
+                startupTimer.msecs( true ) );
+
     // Init KiCad environment
     // the environment variable KICAD (if exists) gives the kicad path:
     // something like set KICAD=d:\kicad
@@ -435,6 +441,9 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     m_plugin_manager = std::make_unique<API_PLUGIN_MANAGER>( &App() );
 #endif
 
+    wxLogTrace( traceStartup, wxT( "InitPgm: settings, library and plugin managers %0.1f ms" ),
+                startupTimer.msecs( true ) );
+
     // Our unit test mocks break if we continue
     // A bug caused InitPgm to terminate early in unit tests and the mocks are...simplistic
     // TODO fix the unit tests so this can be removed
@@ -455,11 +464,8 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     // Load common settings from disk after setting up env vars
     GetSettingsManager().Load( commonSettings );
 
-#ifdef KICAD_IPC_API
-    // If user doesn't have a saved Python interpreter, try (potentially again) to find one
-    if( commonSettings->m_Api.python_interpreter.IsEmpty() )
-        commonSettings->m_Api.python_interpreter = PYTHON_MANAGER::FindPythonInterpreter();
-#endif
+    wxLogTrace( traceStartup, wxT( "InitPgm: environment, color and common settings %0.1f ms" ),
+                startupTimer.msecs( true ) );
 
     // Init user language *before* calling loadSettings, because
     // env vars could be incorrectly initialized on Linux
@@ -475,18 +481,52 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
 
     GetNotificationsManager().Load();
 
+    wxLogTrace( traceStartup, wxT( "InitPgm: language, settings and notifications %0.1f ms" ),
+                startupTimer.msecs( true ) );
+
     // Create the python scripting stuff
     // Skip it for applications that do not use it
     if( !aSkipPyInit )
+    {
         m_python_scripting = std::make_unique<SCRIPTING>();
 
+        wxLogTrace( traceStartup, wxT( "InitPgm: Python interpreter %0.1f ms" ),
+                    startupTimer.msecs( true ) );
+    }
+
     // TODO(JE): Remove this if apps are refactored to not assume Prj() always works
     // Need to create a project early for now (it can have an empty path for the moment)
     GetSettingsManager().LoadProject( "" );
 
 #ifdef KICAD_IPC_API
-    if( commonSettings->m_Api.enable_server )
-        m_plugin_manager->ReloadPlugins();
+    // Looking for a Python interpreter can spawn a process, and the plugin scan reads and
+    // validates every plugin manifest.  Neither is needed to show the first frame, so with a
+    // GUI they run once the event loop is up; the frames update their plugin buttons when the
+    // scan broadcasts EDA_EVT_PLUGIN_AVAILABILITY_CHANGED.
+    auto initApiPlugins =
+            [this]()
+            {
+                PROF_TIMER       apiTimer;
+                COMMON_SETTINGS* settings = GetCommonSettings();
+
+                if( !settings )
+                    return;
+
+                // If user doesn't have a saved Python interpreter, try (potentially again) to
+                // find one
+                if( settings->m_Api.python_interpreter.IsEmpty() )
+                    settings->m_Api.python_interpreter = PYTHON_MANAGER::FindPythonInterpreter();
+
+                if( settings->m_Api.enable_server )
+                    m_plugin_manager->ReloadPlugins();
+
+                wxLogTrace( traceStartup, wxT( "API plugins %0.1f ms" ), apiTimer.msecs() );
+            };
+
+    if( aHeadless )
+        initApiPlugins();
+    else
+        App().CallAfter( initApiPlugins );
 #endif
 
     // This sets the maximum tooltip display duration to 10s (up from 5) but only affects
@@ -500,6 +540,9 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     if( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval != 0 )
         wxUpdateUIEvent::SetUpdateInterval( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval );
 
+    wxLogTrace( traceStartup, wxT( "InitPgm: project setup %0.1f ms" ), startupTimer.msecs( true ) );
+    wxLogTrace( traceStartup, wxT( "InitPgm: total %0.1f ms" ), startupTimer.msecs() );
+
     // Now the application can safely start, show the splash screen
     if( !aHeadless )
         ShowSplash();
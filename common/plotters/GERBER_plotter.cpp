@@ -91,6 +91,10 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
 }
 
 
+// Size of the stdio buffers of the work and final files
+static constexpr size_t GERBER_FILE_BUFFER_SIZE = 1 << 20;
+
+
 GERBER_PLOTTER::GERBER_PLOTTER()
 {
     workFile  = nullptr;
@@ -121,6 +125,21 @@ GERBER_PLOTTER::GERBER_PLOTTER()
 }
 
 
+GERBER_PLOTTER::~GERBER_PLOTTER()
+{
+    // A plot that was not ended still has files using the buffers owned by this plotter, so
+    // they must be closed before the buffers are released.
+    if( m_outputFile == workFile || m_outputFile == finalFile )
+        m_outputFile = nullptr;
+
+    if( workFile )
+        fclose( workFile );
+
+    if( finalFile )
+        fclose( finalFile );
+}
+
+
 void GERBER_PLOTTER::SetViewport( const VECTOR2I& aOffset, double aIusPerDecimil,
                                   double aScale, bool aMirror )
 {
@@ -251,6 +270,12 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
 
     finalFile = m_outputFile;     // the actual gerber file will be created later
 
+    if( finalFile )
+    {
+        m_finalFileBuffer.resize( GERBER_FILE_BUFFER_SIZE );
+        setvbuf( finalFile, m_finalFileBuffer.data(), _IOFBF, m_finalFileBuffer.size() );
+    }
+
     // Create a temp file in system temp to avoid potential network share buffer issues for
     // the final read and save.
     m_workFilename = wxFileName::CreateTempFileName( "" );
@@ -261,6 +286,9 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
     if( m_outputFile == nullptr )
         return false;
 
+    m_workFileBuffer.resize( GERBER_FILE_BUFFER_SIZE );
+    setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -332,8 +360,12 @@ bool GERBER_PLOTTER::EndPlot()
     wxASSERT( workFile );
     m_outputFile = finalFile;
 
+    setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
+    bool apertureListWritten = false;
+
     // Placement of apertures in RS274X
-    while( fgets( line, 1024, workFile ) )
+    while( !apertureListWritten && fgets( line, 1024, workFile ) )
     {
         fmt::print( m_outputFile, "{}", line );
 
@@ -385,11 +417,25 @@ bool GERBER_PLOTTER::EndPlot()
 
             writeApertureList();
             fmt::println( m_outputFile, "G04 APERTURE END LIST*" );
+            apertureListWritten = true;
         }
     }
 
+    // The rest of the plot is copied as is
+    std::vector<char> block( 65536 );
+    size_t            count;
+
+    while( ( count = fread( block.data(), 1, block.size(), workFile ) ) > 0 )
+        fwrite( block.data(), 1, count, m_outputFile );
+
     fclose( workFile );
     fclose( finalFile );
+    workFile = nullptr;
+    finalFile = nullptr;
+    m_workFileBuffer.clear();
+    m_workFileBuffer.shrink_to_fit();
+    m_finalFileBuffer.clear();
+    m_finalFileBuffer.shrink_to_fit();
     ::wxRemoveFile( m_workFilename );
     m_outputFile = nullptr;
 
@@ -426,22 +472,15 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
                                          int                aApertureAttribute,
                                          const std::string& aCustomAttribute )
 {
-    int last_D_code = 9;
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+    auto key = std::make_tuple( (int) aType, aSize.x, aSize.y, aRadius, aRotation.AsDegrees(),
+                                aApertureAttribute, aCustomAttribute );
+    auto it = m_apertureIndex.find( key );
 
-        if( ( tool->m_Type == aType ) && ( tool->m_Size == aSize ) && ( tool->m_Radius == aRadius )
-            && ( tool->m_Rotation == aRotation )
-            && ( tool->m_ApertureAttribute == aApertureAttribute )
-            && ( tool->m_CustomAttribute == aCustomAttribute ) )
-        {
-            return idx;
-        }
-    }
+    if( it != m_apertureIndex.end() )
+        return it->second;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -454,6 +493,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
     new_tool.m_CustomAttribute = aCustomAttribute;
 
     m_apertures.push_back( std::move( new_tool ) );
+    m_apertureIndex.emplace( std::move( key ), m_apertures.size() - 1 );
 
     return m_apertures.size() - 1;
 }
@@ -478,25 +518,21 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     }
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
+    std::vector<int>& candidates = m_polyApertureIndex[std::make_tuple( (int) aType, aCorners.size(),
+                                                                        aRotation.AsDegrees(),
+                                                                        aApertureAttribute,
+                                                                        aCustomAttribute )];
 
-        last_D_code = tool->m_DCode;
-
-        if( ( tool->m_Type == aType ) && ( tool->m_Corners.size() == aCorners.size() )
-            && ( tool->m_Rotation == aRotation )
-            && ( tool->m_ApertureAttribute == aApertureAttribute )
-            && ( tool->m_CustomAttribute == aCustomAttribute ) )
-        {
-            // A candidate is found. the corner lists must be similar
-            bool is_same = polyCompare( tool->m_Corners, aCorners );
-
-            if( is_same )
-                return idx;
-        }
+    for( int idx : candidates )
+    {
+        // A candidate is found. the corner lists must be similar
+        if( polyCompare( m_apertures[idx].m_Corners, aCorners ) )
+            return idx;
     }
 
+    if( !m_apertures.empty() )
+        last_D_code = m_apertures.back().m_DCode;
+
     // Allocate a new aperture
     APERTURE new_tool;
 
@@ -510,6 +546,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     new_tool.m_CustomAttribute = aCustomAttribute;
 
     m_apertures.push_back( std::move( new_tool ) );
+    candidates.push_back( m_apertures.size() - 1 );
 
     return m_apertures.size() - 1;
 }
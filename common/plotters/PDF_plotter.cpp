@@ -44,6 +44,7 @@
 #include <trace_helpers.h>
 #include <trigo.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <core/utf8.h>
 #include <markup_parser.h>
 #include <fmt/format.h>
@@ -709,31 +710,38 @@ int PDF_PLOTTER::startPdfStream( int aHandle )
                      m_streamLengthHandle );
     }
 
+    openWorkFile();
+    return handle;
+}
+
+
+void PDF_PLOTTER::openWorkFile()
+{
     // Open a temporary file to accumulate the stream
     m_workFilename = wxFileName::CreateTempFileName( "" );
     m_workFile = wxFopen( m_workFilename, wxT( "w+b" ) );
     wxASSERT( m_workFile );
-    return handle;
 }
 
 
-void PDF_PLOTTER::closePdfStream()
+std::string PDF_PLOTTER::closeWorkFile()
 {
     wxASSERT( m_workFile );
 
-    long stream_len = ftell( m_workFile );
+    long        stream_len = ftell( m_workFile );
+    std::string data;
 
     if( stream_len < 0 )
     {
         wxASSERT( false );
-        return;
+        stream_len = 0;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file and read in the stream
     fseek( m_workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
+    data.resize( stream_len );
 
-    int rc = fread( inbuf, 1, stream_len, m_workFile );
+    int rc = fread( data.data(), 1, stream_len, m_workFile );
     wxASSERT( rc == stream_len );
     ignore_unused( rc );
 
@@ -742,48 +750,87 @@ void PDF_PLOTTER::closePdfStream()
     m_workFile = nullptr;
     ::wxRemoveFile( m_workFilename );
 
-    unsigned out_count;
+    return data;
+}
 
+
+std::string PDF_PLOTTER::deflateStream( const std::string& aData )
+{
     if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+        return aData;
+
+    // NULL means memos owns the memory, but provide a hint on optimum size needed.
+    wxMemoryOutputStream    memos( nullptr, std::max<size_t>( 2000, aData.size() ) );
+
     {
-        out_count = stream_len;
-        fwrite( inbuf, out_count, 1, m_outputFile );
-    }
-    else
-    {
-        // NULL means memos owns the memory, but provide a hint on optimum size needed.
-        wxMemoryOutputStream    memos( nullptr, std::max( 2000l, stream_len ) ) ;
+        /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
+         * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
+         * stream! (a DEFLATE stream would be generated with -15 instead of 15)
+         * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
+         *                    8, Z_DEFAULT_STRATEGY );
+         */
 
-        {
-            /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
-             * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
-             * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-             *                    8, Z_DEFAULT_STRATEGY );
-             */
+        wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
 
-            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+        zos.Write( aData.data(), aData.size() );
+    }   // flush the zip stream using zos destructor
 
-            zos.Write( inbuf, stream_len );
-        }   // flush the zip stream using zos destructor
+    wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
 
-        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+    return std::string( static_cast<const char*>( sb->GetBufferStart() ), sb->Tell() );
+}
 
-        out_count = sb->Tell();
-        fwrite( sb->GetBufferStart(), 1, out_count, m_outputFile );
-    }
 
-    delete[] inbuf;
+void PDF_PLOTTER::closePdfStream()
+{
+    std::string out = deflateStream( closeWorkFile() );
+
+    fwrite( out.data(), 1, out.size(), m_outputFile );
     fmt::print( m_outputFile, "\nendstream\n" );
     closePdfObject();
 
     // Writing the deferred length as an indirect object
     startPdfObject( m_streamLengthHandle );
-    fmt::println( m_outputFile, "{}", out_count );
+    fmt::println( m_outputFile, "{}", out.size() );
     closePdfObject();
 }
 
 
+void PDF_PLOTTER::closePageStream()
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    m_pendingPageStreams.emplace_back( m_pageStreamHandle,
+            tp.submit_task(
+                    [data = closeWorkFile()]()
+                    {
+                        return deflateStream( data );
+                    } ) );
+}
+
+
+void PDF_PLOTTER::flushPageStreams()
+{
+    for( auto& [handle, stream] : m_pendingPageStreams )
+    {
+        std::string out = stream.get();
+
+        startPdfObject( handle );
+
+        if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+            fmt::print( m_outputFile, "<< /Length {} >>\nstream\n", out.size() );
+        else
+            fmt::print( m_outputFile, "<< /Length {} /Filter /FlateDecode >>\nstream\n", out.size() );
+
+        fwrite( out.data(), 1, out.size(), m_outputFile );
+        fmt::print( m_outputFile, "\nendstream\n" );
+        closePdfObject();
+    }
+
+    m_pendingPageStreams.clear();
+}
+
+
 void PDF_PLOTTER::StartPage( const wxString& aPageNumber, const wxString& aPageName,
                              const wxString& aParentPageNumber, const wxString& aParentPageName )
 {
@@ -813,11 +860,12 @@ void PDF_PLOTTER::StartPage( const wxString& aPageNumber, const wxString& aPageN
 
     if( !m_3dExportMode )
     {
-        // Open the content stream; the page object will go later
-        m_pageStreamHandle = startPdfStream();
+        // Open the content stream; the stream and page objects will go later
+        m_pageStreamHandle = allocPdfObject();
+        openWorkFile();
 
         /* Now, until ClosePage *everything* must be wrote in workFile, to be
-           compressed later in closePdfStream */
+           compressed later in closePageStream */
 
         // Default graphic settings (coordinate system, default color and line style)
         fmt::println( m_workFile,
@@ -911,8 +959,8 @@ void PDF_PLOTTER::ClosePage()
     {
         wxASSERT( m_workFile );
 
-        // Close the page stream (and compress it)
-        closePdfStream();
+        // Close the page stream; it is compressed while the next pages are plotted
+        closePageStream();
     }
 
     // Page size is in 1/72 of inch (default user space units).  Works like the bbox in postscript
@@ -1141,6 +1189,7 @@ bool PDF_PLOTTER::StartPlot( const wxString& aPageNumber, const wxString& aPageN
     // First things first: the customary null object
     m_xrefTable.clear();
     m_xrefTable.push_back( 0 );
+    m_pendingPageStreams.clear();
     m_hyperlinksInPage.clear();
     m_hyperlinkMenusInPage.clear();
     m_hyperlinkHandles.clear();
@@ -1846,6 +1895,7 @@ bool PDF_PLOTTER::EndPlot()
 
     // Close the current page (often the only one)
     ClosePage();
+    flushPageStreams();
 
     if( !m_3dExportMode )
     {
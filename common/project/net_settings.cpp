@@ -61,7 +61,8 @@ static std::optional<int> getInSchUnits( const nlohmann::json& aObj, const std::
 
 
 NET_SETTINGS::NET_SETTINGS( JSON_SETTINGS* aParent, const std::string& aPath ) :
-        NESTED_SETTINGS( "net_settings", netSettingsSchemaVersion, aParent, aPath, false )
+        NESTED_SETTINGS( "net_settings", netSettingsSchemaVersion, aParent, aPath, false ),
+        m_patternIndexValid( false )
 {
     m_defaultNetClass = std::make_shared<NETCLASS>( NETCLASS::Default, true );
     m_defaultNetClass->SetDescription( _( "This is the default net class." ) );
@@ -308,6 +309,11 @@ NET_SETTINGS::NET_SETTINGS( JSON_SETTINGS* aParent, const std::string& aPath ) :
                     return;
 
                 m_netClassPatternAssignments.clear();
+                m_patternIndexValid = false;
+
+                // Large projects have thousands of patterns once buses are expanded: find the
+                // duplicates with a set rather than searching the list for each new pattern.
+                std::set<std::pair<wxString, wxString>> added;
 
                 for( const nlohmann::json& entry : aJson )
                 {
@@ -324,7 +330,13 @@ NET_SETTINGS::NET_SETTINGS( JSON_SETTINGS* aParent, const std::string& aPath ) :
                         ForEachBusMember( pattern,
                                           [&]( const wxString& memberPattern )
                                           {
-                                              addSinglePatternAssignment( memberPattern, netclass );
+                                              if( !added.emplace( memberPattern, netclass ).second )
+                                                  return;
+
+                                              m_netClassPatternAssignments.push_back(
+                                                      { std::make_unique<EDA_COMBINED_MATCHER>(
+                                                                memberPattern, CTX_NETCLASS ),
+                                                        netclass } );
                                           } );
                     }
                 }
@@ -607,6 +619,7 @@ void NET_SETTINGS::addSinglePatternAssignment( const wxString& pattern, const wx
     // No assignment, add a new one
     m_netClassPatternAssignments.push_back(
             { std::make_unique<EDA_COMBINED_MATCHER>( pattern, CTX_NETCLASS ), netclass } );
+    m_patternIndexValid = false;
 }
 
 
@@ -614,6 +627,7 @@ void NET_SETTINGS::SetNetclassPatternAssignments(
         std::vector<std::pair<std::unique_ptr<EDA_COMBINED_MATCHER>, wxString>>&& netclassPatterns )
 {
     m_netClassPatternAssignments = std::move( netclassPatterns );
+    m_patternIndexValid = false;
     ClearAllCaches();
 }
 
@@ -621,6 +635,8 @@ void NET_SETTINGS::SetNetclassPatternAssignments(
 std::vector<std::pair<std::unique_ptr<EDA_COMBINED_MATCHER>, wxString>>&
 NET_SETTINGS::GetNetclassPatternAssignments()
 {
+    // The caller may modify the assignments
+    m_patternIndexValid = false;
     return m_netClassPatternAssignments;
 }
 
@@ -628,6 +644,7 @@ NET_SETTINGS::GetNetclassPatternAssignments()
 void NET_SETTINGS::ClearNetclassPatternAssignments()
 {
     m_netClassPatternAssignments.clear();
+    m_patternIndexValid = false;
 }
 
 
@@ -646,6 +663,59 @@ void NET_SETTINGS::ClearAllCaches()
 {
     m_effectiveNetclassCache.clear();
     m_compositeNetClasses.clear();
+    m_patternIndexValid = false;
+}
+
+
+void NET_SETTINGS::buildPatternIndex()
+{
+    if( m_patternIndexValid )
+        return;
+
+    m_literalPatternIndex.clear();
+    m_prefixPatternIndex.clear();
+    m_patternPrefixLengths.clear();
+
+    // Netclass matchers are anchored, and a pattern is tried both as a regex and as a wildcard.
+    // The text before the first syntax character is a prefix of every net either form matches,
+    // except for a character repeated by a regex quantifier, or anything with an alternative.
+    static const wxString syntaxChars = wxS( ".*+?^${}()|[]\\" );
+    static const wxString quantifiers = wxS( "*+?{" );
+
+    std::set<size_t> prefixLengths;
+
+    for( const auto& [matcher, netclassName] : m_netClassPatternAssignments )
+    {
+        const wxString& pattern = matcher->GetPattern();
+        size_t          literalLength = 0;
+
+        while( literalLength < pattern.length()
+               && syntaxChars.Find( pattern[literalLength] ) == wxNOT_FOUND )
+        {
+            ++literalLength;
+        }
+
+        if( literalLength == pattern.length() )
+        {
+            // No syntax at all: the pattern only matches a net of the same name
+            m_literalPatternIndex[pattern].push_back( netclassName );
+            continue;
+        }
+
+        size_t prefixLength = literalLength;
+
+        if( pattern.Find( '|' ) != wxNOT_FOUND )
+            prefixLength = 0;
+        else if( prefixLength > 0 && quantifiers.Find( pattern[literalLength] ) != wxNOT_FOUND )
+            prefixLength--;
+
+        m_prefixPatternIndex[pattern.Left( prefixLength )].emplace_back( matcher.get(),
+                                                                          netclassName );
+        prefixLengths.insert( prefixLength );
+    }
+
+    m_patternPrefixLengths.assign( prefixLengths.begin(), prefixLengths.end() );
+    m_patternIndexValid = true;
 }
 
 
@@ -751,20 +821,41 @@ std::shared_ptr<NETCLASS> NET_SETTINGS::GetEffectiveNetClass( const wxString& aN
     }
 
     // Now find any pattern-matched netclass assignments
-    for( const auto& [matcher, netclassName] : m_netClassPatternAssignments )
+    auto addPatternNetclass =
+            [&]( const wxString& netclassName )
+            {
+                std::shared_ptr<NETCLASS> netclass = getExplicitNetclass( netclassName );
+
+                if( netclass )
+                    resolvedNetclasses.insert( std::move( netclass ) );
+                else
+                    resolvedNetclasses.insert( getOrAddImplicitNetcless( netclassName ) );
+            };
+
+    buildPatternIndex();
+
+    auto literalIt = m_literalPatternIndex.find( aNetName );
+
+    if( literalIt != m_literalPatternIndex.end() )
     {
-        if( matcher->StartsWith( aNetName ) )
-        {
-            std::shared_ptr<NETCLASS> netclass = getExplicitNetclass( netclassName );
+        for( const wxString& netclassName : literalIt->second )
+            addPatternNetclass( netclassName );
+    }
 
-            if( netclass )
-            {
-                resolvedNetclasses.insert( std::move( netclass ) );
-            }
-            else
-            {
-                resolvedNetclasses.insert( getOrAddImplicitNetcless( netclassName ) );
-            }
+    for( size_t prefixLength : m_patternPrefixLengths )
+    {
+        if( prefixLength > aNetName.length() )
+            break;
+
+        auto prefixIt = m_prefixPatternIndex.find( aNetName.Left( prefixLength ) );
+
+        if( prefixIt == m_prefixPatternIndex.end() )
+            continue;
+
+        for( const auto& [matcher, netclassName] : prefixIt->second )
+        {
+            if( matcher->StartsWith( aNetName ) )
+                addPatternNetclass( netclassName );
         }
     }
 
@@ -127,6 +127,31 @@ const void* PROPERTY_MANAGER::TypeCast( const void* aSource, TYPE_ID aBase, TYPE
 }
 
 
+const TYPE_CAST_BASE* PROPERTY_MANAGER::ResolveTypeCast( TYPE_ID aBase, TYPE_ID aTarget,
+                                                         bool& aValid ) const
+{
+    aValid = true;
+
+    if( aBase == aTarget )
+        return nullptr;
+
+    auto classDesc = m_classes.find( aBase );
+
+    if( classDesc == m_classes.end() )
+        return nullptr;
+
+    auto converter = classDesc->second.m_typeCasts.find( aTarget );
+
+    if( converter == classDesc->second.m_typeCasts.end() )
+    {
+        aValid = IsOfType( aBase, aTarget );
+        return nullptr;
+    }
+
+    return converter->second.get();
+}
+
+
 PROPERTY_BASE& PROPERTY_MANAGER::AddProperty( PROPERTY_BASE* aProperty, const wxString& aGroup )
 {
     const wxString& name = aProperty->Name();
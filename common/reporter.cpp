@@ -88,6 +88,29 @@ void WX_STRING_REPORTER::Clear()
 }
 
 
+REPORTER& BUFFERED_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
+{
+    REPORTER::Report( aText, aSeverity );
+
+    m_messages.emplace_back( aText, aSeverity );
+    return *this;
+}
+
+
+void BUFFERED_REPORTER::Replay( REPORTER& aReporter ) const
+{
+    for( const auto& [text, severity] : m_messages )
+        aReporter.Report( text, severity );
+}
+
+
+void BUFFERED_REPORTER::Clear()
+{
+    REPORTER::Clear();
+    m_messages.clear();
+}
+
+
 REPORTER& NULL_REPORTER::Report( const wxString& aText, SEVERITY aSeverity )
 {
     return REPORTER::Report( aText, aSeverity );
@@ -23,7 +23,9 @@
  */
 
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <config.h> // HAVE_FGETC_NOLOCK
 
 #include <kiplatform/io.h>
@@ -239,6 +241,97 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+STRING_VIEW_LINE_READER::STRING_VIEW_LINE_READER( std::string_view aText,
+                                                  const wxString& aSource,
+                                                  unsigned aStartingLineNumber,
+                                                  unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_text( aText ),
+        m_pos( 0 ),
+        m_startingLineNum( aStartingLineNumber )
+{
+    m_source = aSource;
+    m_lineNum = aStartingLineNumber;
+}
+
+
+std::string_view STRING_VIEW_LINE_READER::ReadLineView()
+{
+    size_t length = 0;
+
+    if( m_pos < m_text.size() )
+    {
+        size_t nlOffset = m_text.find( '\n', m_pos );
+
+        if( nlOffset == std::string_view::npos )
+            length = m_text.size() - m_pos;
+        else
+            length = nlOffset - m_pos + 1;     // include the newline, so +1
+
+        if( length > m_maxLineLength )
+            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+    }
+
+    std::string_view line = m_text.substr( m_pos, length );
+
+    m_pos += length;
+
+    // incremented even at EOF, as for the other readers
+    ++m_lineNum;
+
+    return line;
+}
+
+
+char* STRING_VIEW_LINE_READER::ReadLine()
+{
+    std::string_view line = ReadLineView();
+
+    if( line.size() + 1 > m_capacity )
+        expandCapacity( line.size() + 1 );
+
+    memcpy( m_line, line.data(), line.size() );
+    m_length = line.size();
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
+unsigned STRING_VIEW_LINE_READER::CountLines() const
+{
+    unsigned count = std::count( m_text.begin(), m_text.end(), '\n' );
+
+    // a last line without a newline
+    if( !m_text.empty() && m_text.back() != '\n' )
+        count++;
+
+    return count;
+}
+
+
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+        STRING_VIEW_LINE_READER( std::string_view(), aFileName, 0, aMaxLineLength )
+{
+    m_file = std::make_unique<KIPLATFORM::IO::MAPPED_FILE>( aFileName );
+
+    if( !m_file->IsMapped() )
+    {
+        wxString msg = wxString::Format( _( "Unable to map %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_text = std::string_view( m_file->Data(), m_file->Size() );
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -570,6 +663,7 @@ PRETTIFIED_FILE_OUTPUTFORMATTER::PRETTIFIED_FILE_OUTPUTFORMATTER( const wxString
                                                                   const wxChar* aMode,
                                                                   char aQuoteChar ) :
         OUTPUTFORMATTER( OUTPUTFMTBUFZ, aQuoteChar ),
+        m_hasPrettified( false ),
         m_mode( aFormatMode )
 {
     if( ADVANCED_CFG::GetCfg().m_CompactSave && m_mode == KICAD_FORMAT::FORMAT_MODE::NORMAL )
@@ -598,7 +692,17 @@ bool PRETTIFIED_FILE_OUTPUTFORMATTER::Finish()
     if( !m_fp )
         return false;
 
-    KICAD_FORMAT::Prettify( m_buf, m_mode );
+    if( m_hasPrettified )
+    {
+        KICAD_FORMAT::PrettifyPart( m_buf, KICAD_FORMAT::PRETTIFY_PART::END, m_mode );
+        m_prettified += m_buf;
+        m_buf = std::move( m_prettified );
+        m_hasPrettified = false;
+    }
+    else
+    {
+        KICAD_FORMAT::Prettify( m_buf, m_mode );
+    }
 
     if( fwrite( m_buf.c_str(), m_buf.length(), 1, m_fp ) != 1 )
         THROW_IO_ERROR( strerror( errno ) );
@@ -614,3 +718,21 @@ void PRETTIFIED_FILE_OUTPUTFORMATTER::write( const char* aOutBuf, int aCount )
 {
     m_buf.append( aOutBuf, aCount );
 }
+
+
+void PRETTIFIED_FILE_OUTPUTFORMATTER::WritePrettified( std::string&& aText )
+{
+    // Prettify what was written before, as the start of the file or as items following the
+    // previous prettified text
+    if( !m_buf.empty() || !m_hasPrettified )
+    {
+        KICAD_FORMAT::PrettifyPart( m_buf, m_hasPrettified ? KICAD_FORMAT::PRETTIFY_PART::ITEMS
+                                                           : KICAD_FORMAT::PRETTIFY_PART::BEGIN,
+                                    m_mode );
+        m_prettified += m_buf;
+        m_buf.clear();
+    }
+
+    m_prettified += aText;
+    m_hasPrettified = true;
+}
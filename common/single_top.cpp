@@ -60,6 +60,8 @@
 
 #include <git2.h>
 #include <thread_pool.h>
+#include <trace_helpers.h>
+#include <core/profile.h>
 
 #include <libraries/library_manager.h>
 #include <startwizard/startwizard.h>
@@ -363,6 +365,8 @@ bool PGM_SINGLE_TOP::OnPgmInit()
     skip_python_initialization = true;
 #endif
 
+    PROF_TIMER startupTimer;
+
     if( !InitPgm( false, skip_python_initialization ) )
     {
         // Clean up
@@ -370,6 +374,8 @@ bool PGM_SINGLE_TOP::OnPgmInit()
         return false;
     }
 
+    wxLogTrace( traceStartup, wxT( "OnPgmInit: InitPgm %0.1f ms" ), startupTimer.msecs( true ) );
+
 #if !defined(BUILD_KIWAY_DLL)
 
     // Only bitmap2component and pcb_calculator use this code currently, as they
@@ -413,6 +419,9 @@ bool PGM_SINGLE_TOP::OnPgmInit()
 
     Kiway.SetTop( frame );
 
+    wxLogTrace( traceStartup, wxT( "OnPgmInit: KIFACE and frame %0.1f ms" ),
+                startupTimer.msecs( true ) );
+
     STARTWIZARD startWizard;
     startWizard.CheckAndRun( frame );
 
@@ -425,6 +434,9 @@ bool PGM_SINGLE_TOP::OnPgmInit()
 
     PreloadDesignBlockLibraries( &Kiway );
 
+    wxLogTrace( traceStartup, wxT( "OnPgmInit: library tables %0.1f ms" ),
+                startupTimer.msecs( true ) );
+
     App().SetTopWindow( frame );      // wxApp gets a face.
     App().SetAppDisplayName( frame->GetAboutTitle() );
 
@@ -440,6 +452,9 @@ bool PGM_SINGLE_TOP::OnPgmInit()
     frame->Show();
     wxSafeYield();
 
+    wxLogTrace( traceStartup, wxT( "OnPgmInit: frame shown %0.1f ms" ), startupTimer.msecs( true ) );
+    wxLogTrace( traceStartup, wxT( "OnPgmInit: total %0.1f ms" ), startupTimer.msecs() );
+
     // Now after the frame processing, the rest of the positional args are files
     std::vector<wxString> fileArgs;
 
@@ -385,7 +385,7 @@ int STROKE_PARAMS_PARSER::parseInt( const char* aText )
     if( token != T_NUMBER )
         Expecting( aText );
 
-    return atoi( CurText() );
+    return (int) parseLong();
 }
 
 
@@ -46,6 +46,8 @@ namespace KI_EVAL
 
 #include <wx/log.h>
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <regex>
 #include <span>
 
@@ -1304,11 +1306,87 @@ void EXPRESSION_EVALUATOR::SetVariables( const std::unordered_map<wxString, wxSt
         SetVariable( name, value );
 }
 
+namespace
+{
+/**
+ * Results of evaluations that depend on nothing but the input text and the default units.
+ *
+ * Drawing sheets, title blocks and text items are evaluated again on every redraw and plot,
+ * mostly by evaluators without variables, so the same inputs are parsed over and over.
+ */
+struct PURE_RESULT_CACHE
+{
+    static constexpr size_t MAX_ENTRIES = 4096;
+
+    std::mutex                                                  m_mutex;
+    std::map<EDA_UNITS, std::unordered_map<wxString, wxString>> m_results;
+    size_t                                                      m_size = 0;
+};
+
+
+PURE_RESULT_CACHE& pureResultCache()
+{
+    static PURE_RESULT_CACHE cache;
+    return cache;
+}
+
+
+/**
+ * An input without variable references or functions of the clock or a random generator
+ * always evaluates to the same result.
+ */
+bool isPureInput( const wxString& aInput )
+{
+    if( aInput.Contains( wxS( "${" ) ) )
+        return false;
+
+    wxString lower = aInput.Lower();
+
+    return !lower.Contains( wxS( "today" ) ) && !lower.Contains( wxS( "now" ) )
+           && !lower.Contains( wxS( "random" ) );
+}
+} // namespace
+
+
 wxString EXPRESSION_EVALUATOR::Evaluate( const wxString& aInput )
 {
     std::unordered_map<wxString, double>   emptyNumVars;
     std::unordered_map<wxString, wxString> emptyStringVars;
-    return Evaluate( aInput, emptyNumVars, emptyStringVars );
+
+    if( !m_variables.empty() || HasVariableCallback() || !aInput.Contains( wxS( "@{" ) ) )
+        return Evaluate( aInput, emptyNumVars, emptyStringVars );
+
+    PURE_RESULT_CACHE& cache = pureResultCache();
+
+    {
+        std::lock_guard<std::mutex> lock( cache.m_mutex );
+        std::unordered_map<wxString, wxString>& results = cache.m_results[m_defaultUnits];
+
+        if( auto it = results.find( aInput ); it != results.end() )
+        {
+            ClearErrors();
+            return it->second;
+        }
+    }
+
+    wxString result = Evaluate( aInput, emptyNumVars, emptyStringVars );
+
+    // Failed evaluations are not cached so that their errors are reported each time
+    if( !HasErrors() && isPureInput( aInput ) )
+    {
+        std::lock_guard<std::mutex> lock( cache.m_mutex );
+
+        if( cache.m_size >= PURE_RESULT_CACHE::MAX_ENTRIES )
+        {
+            cache.m_results.clear();
+            cache.m_size = 0;
+        }
+
+        if( cache.m_results[m_defaultUnits].emplace( aInput, result ).second )
+            cache.m_size++;
+    }
+
+    return result;
 }
 
 wxString EXPRESSION_EVALUATOR::Evaluate( const wxString&                             aInput,
@@ -25,6 +25,15 @@
 #include <pgm_base.h>
 #include <thread_pool.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 static thread_pool* tp = nullptr;
 static bool         tp_owned = false;  // True if we created the thread pool ourselves
 
@@ -62,3 +71,225 @@ void InvalidateKiCadThreadPool()
     tp = nullptr;
     tp_owned = false;
 }
+
+
+void KiCadParallelFor( size_t aCount, const std::function<void( size_t )>& aJob )
+{
+    if( aCount == 0 )
+        return;
+
+    if( aCount == 1 )
+    {
+        aJob( 0 );
+        return;
+    }
+
+    struct STATE
+    {
+        std::atomic<size_t>     m_next = 0;
+        std::atomic<size_t>     m_done = 0;
+        std::mutex              m_mutex;
+        std::condition_variable m_finished;
+        std::exception_ptr      m_error;
+    };
+
+    // Helpers which only start after the caller returned must not touch its stack, so the
+    // state is shared and aJob is only called for an index claimed before the last job ended.
+    std::shared_ptr<STATE> state = std::make_shared<STATE>();
+
+    auto work =
+            [state, aCount, &aJob]()
+            {
+                for( size_t ii = state->m_next++; ii < aCount; ii = state->m_next++ )
+                {
+                    try
+                    {
+                        aJob( ii );
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                        if( !state->m_error )
+                            state->m_error = std::current_exception();
+                    }
+
+                    if( ++state->m_done == aCount )
+                    {
+                        std::lock_guard<std::mutex> lock( state->m_mutex );
+                        state->m_finished.notify_all();
+                    }
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       helpers = std::min<size_t>( aCount - 1, tp.get_thread_count() );
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+        tp.detach_task( work );
+
+    work();
+
+    std::unique_lock<std::mutex> lock( state->m_mutex );
+
+    state->m_finished.wait( lock,
+                            [&]()
+                            {
+                                return state->m_done == aCount;
+                            } );
+
+    if( state->m_error )
+        std::rethrow_exception( state->m_error );
+}
+
+
+struct TASK_GROUP::STATE
+{
+    BS::priority_t                    m_priority = 0;
+    std::atomic<bool>                 m_cancelled = false;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_idle;
+    std::deque<std::function<void()>> m_queue;
+    size_t                            m_outstanding = 0;    // queued and running tasks
+    std::exception_ptr                m_error;
+
+    /**
+     * Run the oldest queued task of the group, if any.  Pool workers and waiting threads both
+     * call this, so a task is never waited for before it has started.
+     */
+    bool RunNext()
+    {
+        std::function<void()> task;
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( m_queue.empty() )
+                return false;
+
+            task = std::move( m_queue.front() );
+            m_queue.pop_front();
+        }
+
+        if( !m_cancelled )
+        {
+            try
+            {
+                task();
+            }
+            catch( ... )
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+
+                if( !m_error )
+                    m_error = std::current_exception();
+            }
+        }
+
+        // Release the captures before the group may be considered done
+        task = nullptr;
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( --m_outstanding == 0 )
+            m_idle.notify_all();
+
+        return true;
+    }
+};
+
+
+TASK_GROUP::TASK_GROUP( TASK_PRIORITY aPriority ) :
+        m_state( std::make_shared<STATE>() )
+{
+    m_state->m_priority = PoolPriority( aPriority );
+}
+
+
+TASK_GROUP::~TASK_GROUP()
+{
+    Cancel();
+
+    std::unique_lock<std::mutex> lock( m_state->m_mutex );
+
+    m_state->m_idle.wait( lock,
+                          [&]()
+                          {
+                              return m_state->m_outstanding == 0;
+                          } );
+}
+
+
+void TASK_GROUP::Submit( std::function<void()> aTask )
+{
+    if( m_state->m_cancelled )
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock( m_state->m_mutex );
+
+        m_state->m_queue.push_back( std::move( aTask ) );
+        m_state->m_outstanding++;
+    }
+
+    // The worker may start after the group is gone, so it only holds the shared state
+    GetKiCadThreadPool().detach_task(
+            [state = m_state]()
+            {
+                state->RunNext();
+            },
+            m_state->m_priority );
+}
+
+
+void TASK_GROUP::Cancel()
+{
+    m_state->m_cancelled = true;
+
+    std::lock_guard<std::mutex> lock( m_state->m_mutex );
+
+    m_state->m_outstanding -= m_state->m_queue.size();
+    m_state->m_queue.clear();
+
+    if( m_state->m_outstanding == 0 )
+        m_state->m_idle.notify_all();
+}
+
+
+bool TASK_GROUP::IsCancelled() const
+{
+    return m_state->m_cancelled;
+}
+
+
+void TASK_GROUP::Wait()
+{
+    while( m_state->RunNext() )
+        ;
+
+    std::unique_lock<std::mutex> lock( m_state->m_mutex );
+
+    m_state->m_idle.wait( lock,
+                          [&]()
+                          {
+                              return m_state->m_outstanding == 0;
+                          } );
+
+    if( std::exception_ptr error = std::exchange( m_state->m_error, nullptr ) )
+    {
+        lock.unlock();
+        std::rethrow_exception( error );
+    }
+}
+
+
+bool TASK_GROUP::WaitFor( std::chrono::milliseconds aTimeout )
+{
+    std::unique_lock<std::mutex> lock( m_state->m_mutex );
+
+    return m_state->m_idle.wait_for( lock, aTimeout,
+                                     [&]()
+                                     {
+                                         return m_state->m_outstanding == 0;
+                                     } );
+}
@@ -64,6 +64,7 @@ const wxChar* const traceStackedPins = wxT( "KICAD_STACKED_PINS" );
 const wxChar* const traceLibWatch = wxT( "KICAD_LIB_WATCH" );
 const wxChar* const traceKiCad2Step = wxT( "KICAD2STEP" );
 const wxChar* const traceUiProfile = wxT( "KICAD_UI_PROFILE" );
+const wxChar* const traceAgentProfile = wxT( "KICAD_AGENT_PROFILE" );
 const wxChar* const traceGit = wxT( "KICAD_GIT" );
 const wxChar* const traceEagleIo = wxT( "KICAD_EAGLE_IO" );
 const wxChar* const traceDesignBlocks = wxT( "KICAD_DESIGN_BLOCK" );
@@ -71,6 +72,7 @@ const wxChar* const traceLibFieldTable = wxT( "KICAD_LIB_FIELD_TABLE" );
 const wxChar* const tracePdfPlotter = wxT( "KICAD_PDF_PLOTTER" );
 const wxChar* const traceSnap = wxT( "KICAD_SNAP" );
 const wxChar* const traceLibraries = wxT( "KICAD_LIBRARIES" );
+const wxChar* const traceStartup = wxT( "KICAD_STARTUP" );
 const wxChar* const traceSchMove = wxT( "KICAD_SCH_MOVE" );
 const wxChar* const traceSymbolInheritance = wxT( "KICAD_SYMBOL_INHERITANCE" );
 
@@ -36,11 +36,14 @@
 #include <view/view_overlay.h>
 
 #include <gal/definitions.h>
+#include <gal/frame_profiler.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/painter.h>
 #include <algorithm>
 
+#include <advanced_config.h>
 #include <core/profile.h>
+#include <thread_pool.h>
 
 #ifdef KICAD_GAL_PROFILE
 #include <wx/log.h>
@@ -937,13 +940,15 @@ void VIEW::UpdateAllLayersOrder()
 
 struct VIEW::DRAW_ITEM_VISITOR
 {
-    DRAW_ITEM_VISITOR( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder ) :
+    DRAW_ITEM_VISITOR( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder,
+                       SUBPIXEL_GRID* aSubPixelGrid = nullptr ) :
         view( aView ),
         layer( aLayer ),
         useDrawPriority( aUseDrawPriority ),
         reverseDrawOrder( aReverseDrawOrder ),
         drawForcedTransparent( false ),
-        foundForcedTransparent( false )
+        foundForcedTransparent( false ),
+        subPixelGrid( aSubPixelGrid )
     {
     }
 
@@ -965,6 +970,12 @@ struct VIEW::DRAW_ITEM_VISITOR
         if( !drawCondition )
             return true;
 
+        if( subPixelGrid && !drawForcedTransparent
+                && subPixelGrid->Covered( aItem->viewPrivData()->m_bbox ) )
+        {
+            return true;
+        }
+
         if( useDrawPriority )
             drawItems.push_back( aItem );
         else
@@ -1004,16 +1015,83 @@ struct VIEW::DRAW_ITEM_VISITOR
     std::vector<VIEW_ITEM*> drawItems;
     bool drawForcedTransparent;
     bool foundForcedTransparent;
+    SUBPIXEL_GRID* subPixelGrid;
 };
 
 
+void VIEW::SUBPIXEL_GRID::Reset( const BOX2I& aViewport, double aCellSize )
+{
+    m_viewport = aViewport;
+    m_cellSize = aCellSize;
+
+    int cols = 0;
+    int rows = 0;
+
+    if( aCellSize > 0.0 )
+    {
+        cols = (int) std::min( 4096.0, std::ceil( aViewport.GetWidth() / aCellSize ) );
+        rows = (int) std::min( 4096.0, std::ceil( aViewport.GetHeight() / aCellSize ) );
+    }
+
+    if( cols != m_cols || rows != m_rows )
+    {
+        m_cols = cols;
+        m_rows = rows;
+        m_stamps.assign( (size_t) std::max( cols, 0 ) * std::max( rows, 0 ), 0 );
+        m_generation = 0;
+    }
+
+    // A new generation releases every cell without having to clear the stamps
+    if( ++m_generation == 0 )
+    {
+        std::fill( m_stamps.begin(), m_stamps.end(), 0 );
+        m_generation = 1;
+    }
+}
+
+
+bool VIEW::SUBPIXEL_GRID::Covered( const BOX2I& aBBox )
+{
+    if( m_stamps.empty()
+            || std::max( aBBox.GetWidth(), aBBox.GetHeight() ) >= m_cellSize )
+    {
+        return false;
+    }
+
+    const VECTOR2I center = aBBox.GetCenter();
+    const double   col = std::floor( ( (double) center.x - m_viewport.GetX() ) / m_cellSize );
+    const double   row = std::floor( ( (double) center.y - m_viewport.GetY() ) / m_cellSize );
+
+    // Items hanging over the edge of the viewport are always drawn
+    if( col < 0 || row < 0 || col >= m_cols || row >= m_rows )
+        return false;
+
+    uint32_t& stamp = m_stamps[(size_t) row * m_cols + (size_t) col];
+
+    if( stamp == m_generation )
+        return true;
+
+    stamp = m_generation;
+    return false;
+}
+
+
 void VIEW::redrawRect( const BOX2I& aRect )
 {
     for( VIEW_LAYER* l : m_orderedLayers )
     {
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
-            DRAW_ITEM_VISITOR drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
+            // Only coalesce the cached board contents, never previews or overlays, and not
+            // when the draw priority decides which of the overlapping items ends up on top.
+            bool coalesce = ADVANCED_CFG::GetCfg().m_ViewCoalesceSubPixelItems
+                            && l->target == TARGET_CACHED && !m_useDrawPriority;
+
+            if( coalesce )
+                m_subPixelGrid.Reset( aRect, ToWorld( SUBPIXEL_CELL_PIXELS ) );
+
+            DRAW_ITEM_VISITOR drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder,
+                                        coalesce ? &m_subPixelGrid : nullptr );
 
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
@@ -1176,6 +1254,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    FRAME_PROFILER::SCOPE profile( "view-redraw" );
+
 #ifdef KICAD_GAL_PROFILE
     PROF_TIMER totalRealTime;
 #endif /* KICAD_GAL_PROFILE */
@@ -1470,8 +1550,9 @@ void VIEW::UpdateItems()
     if( !m_gal->IsVisible() || !m_gal->IsInitialized() )
         return;
 
-    unsigned int cntGeomUpdate = 0;
-    bool         anyUpdated = false;
+    unsigned int            cntGeomUpdate = 0;
+    bool                    anyUpdated = false;
+    std::vector<VIEW_ITEM*> redrawItems;
 
     for( VIEW_ITEM* item : *m_allItems )
     {
@@ -1491,9 +1572,30 @@ void VIEW::UpdateItems()
             {
                 cntGeomUpdate++;
             }
+
+            if( vpd->m_requiredUpdate & ( INITIAL_ADD | GEOMETRY | LAYERS | REPAINT ) )
+                redrawItems.push_back( item );
         }
     }
 
+    // Recaching everything (theme or display option changes, board load) is dominated by
+    // building the shapes and triangulations the painter draws from.  Build those on the
+    // thread pool first so that the serial pass below only has to feed the GAL.
+    if( m_painter && redrawItems.size() >= PARALLEL_PREPARE_THRESHOLD )
+    {
+        PROF_TIMER   prepareTimer;
+        thread_pool& tp = GetKiCadThreadPool();
+
+        tp.submit_loop( 0, redrawItems.size(),
+                        [&]( size_t ii )
+                        {
+                            m_painter->PrepareDraw( redrawItems[ii] );
+                        } ).wait();
+
+        KI_TRACE( traceGalProfile, wxS( "View update: prepared %zu items in %0.3f ms\n" ),
+                  redrawItems.size(), prepareTimer.msecs() );
+    }
+
     unsigned int cntTotal = m_allItems->size();
 
     double ratio = (double) cntGeomUpdate / (double) cntTotal;
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <cmath>
 #include <magic_enum.hpp>
+#include <set>
 #include <unordered_map>
 #include <vector>
 #include <sch_commit.h>
@@ -92,6 +93,20 @@ int orientationFromRequest( double aRotation, bool aMirrorX, bool aMirrorY )
 
     return orientation;
 }
+
+/**
+ * Looking items up one at a time walks the whole screen for each id, so requests naming many
+ * items index the screen once instead.
+ */
+std::unordered_map<KIID, SCH_ITEM*> indexItemsById( SCH_SCREEN* aScreen )
+{
+    std::unordered_map<KIID, SCH_ITEM*> index;
+
+    for( SCH_ITEM* item : aScreen->Items() )
+        index.emplace( item->m_Uuid, item );
+
+    return index;
+}
 } // namespace
 
 
@@ -110,6 +125,8 @@ API_HANDLER_SCH::API_HANDLER_SCH( SCH_EDIT_FRAME* aFrame ) :
     registerHandler<kiapi::schematic::commands::PlaceWire,
                     kiapi::schematic::commands::PlaceWireResponse>(
             &API_HANDLER_SCH::handlePlaceWire );
+    registerHandler<GetItems, GetItemsResponse>( &API_HANDLER_SCH::handleGetItems );
+    registerHandler<GetItemsById, GetItemsResponse>( &API_HANDLER_SCH::handleGetItemsById );
 }
 
 
@@ -445,6 +462,147 @@ HANDLER_RESULT<kiapi::schematic::commands::PlaceWireResponse> API_HANDLER_SCH::h
 }
 
 
+HANDLER_RESULT<GetItemsResponse> API_HANDLER_SCH::handleGetItems(
+        const HANDLER_CONTEXT<GetItems>& aCtx )
+{
+    if( std::optional<ApiResponseStatus> busy = checkForBusy() )
+        return tl::unexpected( *busy );
+
+    if( !validateItemHeaderDocument( aCtx.Request.header() ) )
+    {
+        ApiResponseStatus e;
+        // No message needed for AS_UNHANDLED; this is an internal flag for the API server
+        e.set_status( ApiStatusCode::AS_UNHANDLED );
+        return tl::unexpected( e );
+    }
+
+    SCH_SCREEN* screen = m_frame->GetScreen();
+
+    if( !screen )
+    {
+        ApiResponseStatus e;
+        e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+        e.set_error_message( "No schematic document is currently active" );
+        return tl::unexpected( e );
+    }
+
+    GetItemsResponse       response;
+    std::vector<SCH_ITEM*> items;
+    std::set<KICAD_T>      typesInserted;
+
+    for( int typeRaw : aCtx.Request.types() )
+    {
+        auto    typeMessage = static_cast<common::types::KiCadObjectType>( typeRaw );
+        KICAD_T type = FromProtoEnum<KICAD_T>( typeMessage );
+
+        switch( type )
+        {
+        case SCH_SYMBOL_T:
+        case SCH_LINE_T:
+        case SCH_LABEL_T:
+        case SCH_GLOBAL_LABEL_T:
+        case SCH_HIER_LABEL_T:
+        case SCH_DIRECTIVE_LABEL_T:
+            if( !typesInserted.insert( type ).second )
+                break;
+
+            for( SCH_ITEM* item : screen->Items().OfType( type ) )
+                items.emplace_back( item );
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if( typesInserted.empty() )
+    {
+        ApiResponseStatus e;
+        e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+        e.set_error_message( "none of the requested types are valid for a Schematic object" );
+        return tl::unexpected( e );
+    }
+
+    serializeItems( items, response.mutable_items() );
+
+    response.set_status( ItemRequestStatus::IRS_OK );
+    return response;
+}
+
+
+HANDLER_RESULT<GetItemsResponse> API_HANDLER_SCH::handleGetItemsById(
+        const HANDLER_CONTEXT<GetItemsById>& aCtx )
+{
+    if( std::optional<ApiResponseStatus> busy = checkForBusy() )
+        return tl::unexpected( *busy );
+
+    if( !validateItemHeaderDocument( aCtx.Request.header() ) )
+    {
+        ApiResponseStatus e;
+        e.set_status( ApiStatusCode::AS_UNHANDLED );
+        return tl::unexpected( e );
+    }
+
+    SCH_SCREEN* screen = m_frame->GetScreen();
+
+    if( !screen )
+    {
+        ApiResponseStatus e;
+        e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+        e.set_error_message( "No schematic document is currently active" );
+        return tl::unexpected( e );
+    }
+
+    GetItemsResponse                    response;
+    std::vector<SCH_ITEM*>              items;
+    std::unordered_map<KIID, SCH_ITEM*> itemsById = indexItemsById( screen );
+
+    for( const kiapi::common::types::KIID& id : aCtx.Request.items() )
+    {
+        auto it = itemsById.find( KIID( id.value() ) );
+
+        if( it != itemsById.end() )
+            items.emplace_back( it->second );
+    }
+
+    if( items.empty() )
+    {
+        ApiResponseStatus e;
+        e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+        e.set_error_message( "none of the requested IDs were found or valid" );
+        return tl::unexpected( e );
+    }
+
+    serializeItems( items, response.mutable_items() );
+
+    response.set_status( ItemRequestStatus::IRS_OK );
+    return response;
+}
+
+
+void API_HANDLER_SCH::serializeItems( const std::vector<SCH_ITEM*>& aItems,
+        google::protobuf::RepeatedPtrField<google::protobuf::Any>* aOutput ) const
+{
+    const SCH_SHEET_PATH& sheetPath = m_frame->Schematic().CurrentSheet();
+
+    aOutput->Reserve( aOutput->size() + static_cast<int>( aItems.size() ) );
+
+    for( const SCH_ITEM* item : aItems )
+    {
+        if( item->Type() == SCH_SYMBOL_T )
+        {
+            const SCH_SYMBOL* symbol = static_cast<const SCH_SYMBOL*>( item );
+            aOutput->Add()->PackFrom( buildSymbolMessage( *symbol, sheetPath ) );
+        }
+        else
+        {
+            item->Serialize( *aOutput->Add() );
+        }
+    }
+}
+
+
 HANDLER_RESULT<std::unique_ptr<EDA_ITEM>> API_HANDLER_SCH::createItemForType( KICAD_T aType,
         EDA_ITEM* aContainer )
 {
@@ -611,10 +769,12 @@ HANDLER_RESULT<ItemRequestStatus> API_HANDLER_SCH::handleCreateUpdateItemsIntern
         if( aCreate )
         {
             item->Serialize( newItem );
-            commit->Add( item.release(), screen );
 
-            if( !m_activeClients.count( aClientName ) )
-                pushCurrentCommit( aClientName, _( "Added items via API" ) );
+            // Add it to the screen here: when the commit does it, it first searches the whole
+            // screen for the item to avoid adding it twice, which is quadratic for bulk requests
+            SCH_ITEM* schItem = static_cast<SCH_ITEM*>( item.release() );
+            m_frame->AddToScreen( schItem, screen );
+            commit->Added( schItem, screen );
         }
         else
         {
@@ -622,22 +782,26 @@ HANDLER_RESULT<ItemRequestStatus> API_HANDLER_SCH::handleCreateUpdateItemsIntern
 
             if( SCH_ITEM* schItem = dynamic_cast<SCH_ITEM*>( edaItem ) )
             {
+                // Stage before changing it, so the undo copy holds the old data
+                commit->Modify( schItem, screen );
                 schItem->SwapItemData( static_cast<SCH_ITEM*>( item.get() ) );
                 schItem->Serialize( newItem );
-                commit->Modify( schItem, screen );
             }
             else
             {
                 wxASSERT( false );
             }
-
-            if( !m_activeClients.count( aClientName ) )
-                pushCurrentCommit( aClientName, _( "Created items via API" ) );
         }
 
         aItemHandler( status, newItem );
     }
 
+    // One commit for the whole request, so the connectivity and the view are only updated once
+    if( !m_activeClients.count( aClientName ) )
+    {
+        pushCurrentCommit( aClientName, aCreate ? _( "Added items via API" )
+                                                : _( "Modified items via API" ) );
+    }
 
     return ItemRequestStatus::IRS_OK;
 }
@@ -651,13 +815,16 @@ void API_HANDLER_SCH::deleteItemsInternal( std::map<KIID, ItemDeletionStatus>& a
     if( !screen )
         return;
 
-    std::vector<SCH_ITEM*> itemsToRemove;
+    std::vector<SCH_ITEM*>              itemsToRemove;
+    std::unordered_map<KIID, SCH_ITEM*> itemsById = indexItemsById( screen );
 
     for( auto& [id, status] : aItemsToDelete )
     {
-        if( std::optional<SCH_ITEM*> item = getItemById( id ) )
+        auto it = itemsById.find( id );
+
+        if( it != itemsById.end() )
         {
-            itemsToRemove.push_back( *item );
+            itemsToRemove.push_back( it->second );
             status = ItemDeletionStatus::IDS_OK;
         }
     }
@@ -79,6 +79,19 @@ private:
     HANDLER_RESULT<kiapi::schematic::commands::PlaceWireResponse> handlePlaceWire(
             const HANDLER_CONTEXT<kiapi::schematic::commands::PlaceWire>& aCtx );
 
+    HANDLER_RESULT<commands::GetItemsResponse> handleGetItems(
+            const HANDLER_CONTEXT<commands::GetItems>& aCtx );
+
+    HANDLER_RESULT<commands::GetItemsResponse> handleGetItemsById(
+            const HANDLER_CONTEXT<commands::GetItemsById>& aCtx );
+
+    /**
+     * Serialize \a aItems, which must be on the current sheet, into \a aOutput.  Symbols have no
+     * serializer of their own and are packed from buildSymbolMessage().
+     */
+    void serializeItems( const std::vector<SCH_ITEM*>& aItems,
+                         google::protobuf::RepeatedPtrField<google::protobuf::Any>* aOutput ) const;
+
     std::optional<SCH_ITEM*> getItemById( const KIID& aId ) const;
 
     kiapi::schematic::types::Symbol buildSymbolMessage( const SCH_SYMBOL& aSymbol,
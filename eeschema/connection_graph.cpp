@@ -25,6 +25,7 @@
 #include <future>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <app_monitor.h>
 #include <core/profile.h>
 #include <core/kicad_algo.h>
@@ -741,6 +742,8 @@ void CONNECTION_GRAPH::Reset()
     m_item_to_subgraph_map.clear();
     m_local_label_cache.clear();
     m_global_label_cache.clear();
+    m_erc_cache.clear();
+    m_erc_cache_tests.clear();
     m_last_net_code = 1;
     m_last_bus_code = 1;
     m_last_subgraph_code = 1;
@@ -763,6 +766,7 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
 
     m_sheetList = aSheetList;
     std::set<SCH_ITEM*> dirty_items;
+    std::unordered_map<SCH_SCREEN*, BOX2I> touched_screens;
 
     int count = aSheetList.size() * 2;
     int done = 0;
@@ -847,6 +851,26 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
             }
         }
 
+        // An incremental update only has to visit the sheets holding changed items.  The
+        // others keep both their connectivity and their dangling state, and re-testing every
+        // screen is what made small edits slow on large hierarchies.
+        if( !aUnconditional && items.empty() )
+        {
+            for( const auto& [ symbol, originalUnit ] : symbolsChanged )
+                symbol->SetUnit( originalUnit );
+
+            done++;
+            continue;
+        }
+
+        // Every connection point changed by the edit is on an item flagged dirty, so the
+        // dangling state only has to be re-tested around them.
+        BOX2I dirtyArea = items.empty() ? BOX2I() : items.front()->GetBoundingBox();
+
+        for( SCH_ITEM* item : items )
+            dirtyArea.Merge( item->GetBoundingBox() );
+
+        touched_screens[sheet.LastScreen()] = dirtyArea;
         m_items.reserve( m_items.size() + items.size() );
 
         updateItemConnectivity( sheet, items );
@@ -858,7 +882,10 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
         }
 
         // UpdateDanglingState() also adds connected items for SCH_TEXT
-        sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+        if( aUnconditional )
+            sheet.LastScreen()->TestDanglingEnds( &sheet, aChangedItemHandler );
+        else
+            sheet.LastScreen()->TestDanglingEnds( dirtyArea, &sheet, aChangedItemHandler );
 
         // Restore the m_unit member variables where we had to change them
         for( const auto& [ symbol, originalUnit ] : symbolsChanged )
@@ -869,8 +896,15 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     // SCH_SHEET_PATH.
     SCH_SCREEN* currentScreen = m_schematic->CurrentSheet().LastScreen();
 
-    if( currentScreen )
+    if( currentScreen && aUnconditional )
+    {
         currentScreen->TestDanglingEnds( &m_schematic->CurrentSheet(), aChangedItemHandler );
+    }
+    else if( currentScreen && touched_screens.contains( currentScreen ) )
+    {
+        currentScreen->TestDanglingEnds( touched_screens[currentScreen],
+                                         &m_schematic->CurrentSheet(), aChangedItemHandler );
+    }
 
     for( SCH_ITEM* item : dirty_items )
         item->SetConnectivityDirty( false );
@@ -883,7 +917,9 @@ void CONNECTION_GRAPH::Recalculate( const SCH_SHEET_LIST& aSheetList, bool aUnco
     PROF_TIMER build_graph( "buildConnectionGraph" );
     monitorTrans.StartSpan( "BuildConnectionGraph", "" );
 
-    buildConnectionGraph( aChangedItemHandler, aUnconditional );
+    // Nothing changed, so there is nothing to resolve or propagate
+    if( aUnconditional || !dirty_items.empty() )
+        buildConnectionGraph( aChangedItemHandler, aUnconditional );
 
     if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
         build_graph.Show();
@@ -1716,31 +1752,68 @@ void CONNECTION_GRAPH::collectAllDriverValues()
 
 void CONNECTION_GRAPH::generateBusAliasMembers()
 {
-    std::vector<CONNECTION_SUBGRAPH*> new_subgraphs;
-
-    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+    // Resolving and parsing the bus labels is the expensive part, and is independent for each
+    // subgraph, so it runs on the thread pool.  The member subgraphs and their net codes are
+    // then created serially, in driver subgraph order, so the result does not depend on the
+    // scheduling.
+    struct BUS_LABEL_MEMBERS
     {
-        SCH_ITEM_VEC vec = subgraph->GetAllBusLabels();
+        SCH_ITEM*             m_label;
+        std::vector<wxString> m_names;
+    };
 
-        for( SCH_ITEM* item : vec )
-        {
-            SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
+    std::vector<std::vector<BUS_LABEL_MEMBERS>> bus_members( m_driver_subgraphs.size() );
+
+    auto parse_labels =
+            [&]( size_t ii )
+            {
+                CONNECTION_SUBGRAPH* subgraph = m_driver_subgraphs[ii];
 
-            SCH_CONNECTION dummy( item, subgraph->m_sheet );
-            dummy.SetGraph( this );
-            dummy.ConfigureFromLabel( label->GetShownText( &subgraph->m_sheet, false ) );
+                for( SCH_ITEM* item : subgraph->GetAllBusLabels() )
+                {
+                    SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
+                    wxString        text = label->GetShownText( &subgraph->m_sheet, false );
 
-            wxLogTrace( ConnTrace, wxS( "new bus label (%s)" ),
-                        label->GetShownText( &subgraph->m_sheet, false ) );
+                    SCH_CONNECTION dummy( item, subgraph->m_sheet );
+                    dummy.SetGraph( this );
+                    dummy.ConfigureFromLabel( text );
 
-            for( const auto& conn : dummy.Members() )
-            {
-                // Only create subgraphs for NET members, not nested buses
-                if( !conn->IsNet() )
-                    continue;
+                    wxLogTrace( ConnTrace, wxS( "new bus label (%s)" ), text );
 
-                wxString name = conn->FullLocalName();
+                    BUS_LABEL_MEMBERS& entry = bus_members[ii].emplace_back();
+                    entry.m_label = item;
 
+                    // Only create subgraphs for NET members, not nested buses
+                    for( const auto& conn : dummy.Members() )
+                    {
+                        if( conn->IsNet() )
+                            entry.m_names.push_back( conn->FullLocalName() );
+                    }
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.submit_loop( 0, m_driver_subgraphs.size(),
+                                   [&]( const int ii )
+                                   {
+                                       parse_labels( ii );
+                                   } );
+
+    results.wait();
+
+    std::vector<CONNECTION_SUBGRAPH*> new_subgraphs;
+
+    for( size_t ii = 0; ii < m_driver_subgraphs.size(); ++ii )
+    {
+        CONNECTION_SUBGRAPH* subgraph = m_driver_subgraphs[ii];
+
+        for( const BUS_LABEL_MEMBERS& entry : bus_members[ii] )
+        {
+            SCH_ITEM* item = entry.m_label;
+
+            for( const wxString& name : entry.m_names )
+            {
                 CONNECTION_SUBGRAPH* new_sg = new CONNECTION_SUBGRAPH( this );
 
                 // This connection cannot form a part of the item because the item is not, itself
@@ -2172,13 +2245,38 @@ void CONNECTION_GRAPH::processSubGraphs()
         }
     }
 
-    // Update any subgraph that was invalidated above
+    // Update any subgraph that was invalidated above.  Drivers are resolved in parallel, then
+    // net codes are assigned serially in subgraph code order so they are reproducible.
+    std::vector<CONNECTION_SUBGRAPH*> to_resolve;
+
     for( CONNECTION_SUBGRAPH* subgraph : invalidated_subgraphs )
     {
-        if( subgraph->m_absorbed )
-            continue;
+        if( !subgraph->m_absorbed )
+            to_resolve.push_back( subgraph );
+    }
+
+    std::sort( to_resolve.begin(), to_resolve.end(),
+               []( const CONNECTION_SUBGRAPH* a, const CONNECTION_SUBGRAPH* b )
+               {
+                   return a->m_code < b->m_code;
+               } );
+
+    std::vector<uint8_t> resolved( to_resolve.size(), 0 );
+    thread_pool&         tp = GetKiCadThreadPool();
 
-        if( !subgraph->ResolveDrivers() )
+    auto results = tp.submit_loop( 0, to_resolve.size(),
+                                   [&]( const int ii )
+                                   {
+                                       resolved[ii] = to_resolve[ii]->ResolveDrivers();
+                                   } );
+
+    results.wait();
+
+    for( size_t ii = 0; ii < to_resolve.size(); ++ii )
+    {
+        CONNECTION_SUBGRAPH* subgraph = to_resolve[ii];
+
+        if( !resolved[ii] )
             continue;
 
         if( subgraph->m_driver_connection->IsBus() )
@@ -3309,6 +3407,43 @@ int CONNECTION_GRAPH::RunERC()
 
     ERC_SETTINGS& settings = m_schematic->ErcSettings();
 
+    // The cached results are only good for the set of tests that produced them
+    std::vector<bool> enabledTests;
+
+    for( int code = ERCE_FIRST; code <= ERCE_LAST; ++code )
+        enabledTests.push_back( settings.IsTestEnabled( code ) );
+
+    if( enabledTests != m_erc_cache_tests )
+    {
+        m_erc_cache.clear();
+        m_erc_cache_tests = std::move( enabledTests );
+    }
+
+    // Subgraphs rebuilt by an incremental update have new codes and so miss the cache.  The
+    // net-wide checks (no-connects, lonely labels) of a subgraph also depend on the other
+    // subgraphs of its net, so any net which gained or lost a subgraph is tested again in full.
+    std::set<long>     liveCodes;
+    std::set<wxString> dirtyNets;
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_subgraphs )
+    {
+        if( !subgraph || subgraph->m_absorbed )
+            continue;
+
+        liveCodes.insert( subgraph->m_code );
+
+        if( !m_erc_cache.count( subgraph->m_code ) )
+            dirtyNets.insert( subgraph->GetNetName() );
+    }
+
+    for( const auto& [code, entry] : m_erc_cache )
+    {
+        if( !liveCodes.count( code ) )
+            dirtyNets.insert( entry.m_netName );
+    }
+
+    std::map<long, ERC_CACHE_ENTRY> cache;
+
     // We don't want to run many ERC checks more than once on a given screen even though it may
     // represent multiple sheets with multiple subgraphs.  We can tell these apart by drivers.
     std::set<SCH_ITEM*> seenDriverInstances;
@@ -3325,12 +3460,42 @@ int CONNECTION_GRAPH::RunERC()
         if( subgraph->m_absorbed )
             continue;
 
+        ERC_CACHE_ENTRY& entry = cache[subgraph->m_code];
+        entry.m_netName = subgraph->GetNetName();
+
         if( seenDriverInstances.count( subgraph->m_driver ) )
+        {
+            entry.m_skipped = true;
             continue;
+        }
 
         if( subgraph->m_driver )
             seenDriverInstances.insert( subgraph->m_driver );
 
+        auto cached = m_erc_cache.find( subgraph->m_code );
+
+        if( cached != m_erc_cache.end() && !cached->second.m_skipped
+                && !dirtyNets.count( entry.m_netName ) )
+        {
+            subgraph->ResolveDrivers( false );
+
+            for( const ERC_CACHED_MARKER& cachedMarker : cached->second.m_markers )
+            {
+                // Each marker owns its item, so the cached one is kept as a template
+                auto        ercItem = std::make_shared<ERC_ITEM>( *cachedMarker.m_item );
+                SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), cachedMarker.m_position );
+                cachedMarker.m_screen->Append( marker );
+            }
+
+            error_count += cached->second.m_errorCount;
+            entry.m_errorCount = cached->second.m_errorCount;
+            entry.m_markers = std::move( cached->second.m_markers );
+            continue;
+        }
+
+        int subgraphErrors = error_count;
+        m_erc_marker_sink = &entry.m_markers;
+
         /**
          * NOTE:
          *
@@ -3393,8 +3558,14 @@ int CONNECTION_GRAPH::RunERC()
             if( !ercCheckLabels( subgraph ) )
                 error_count++;
         }
+
+        m_erc_marker_sink = nullptr;
+        entry.m_errorCount = error_count - subgraphErrors;
     }
 
+    // Entries of subgraphs which no longer exist are dropped here
+    m_erc_cache = std::move( cache );
+
     if( settings.IsTestEnabled( ERCE_LABEL_NOT_CONNECTED ) )
     {
         error_count += ercCheckDirectiveLabels();
@@ -3416,6 +3587,19 @@ int CONNECTION_GRAPH::RunERC()
 }
 
 
+void CONNECTION_GRAPH::addErcMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    aScreen->Append( aMarker );
+
+    if( m_erc_marker_sink )
+    {
+        m_erc_marker_sink->push_back( { aScreen,
+                                        std::static_pointer_cast<ERC_ITEM>( aMarker->GetRCItem() ),
+                                        aMarker->GetPosition() } );
+    }
+}
+
+
 bool CONNECTION_GRAPH::ercCheckMultipleDrivers( const CONNECTION_SUBGRAPH* aSubgraph )
 {
     wxCHECK( aSubgraph, false );
@@ -3449,7 +3633,7 @@ bool CONNECTION_GRAPH::ercCheckMultipleDrivers( const CONNECTION_SUBGRAPH* aSubg
                 ercItem->SetErrorMessage( msg );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), driver->GetPosition() );
-                aSubgraph->m_sheet.LastScreen()->Append( marker );
+                addErcMarker( aSubgraph->m_sheet.LastScreen(), marker );
 
                 return false;
             }
@@ -3511,7 +3695,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
         ercItem->SetItems( net_item, bus_item );
 
         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), net_item->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -3575,7 +3759,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
             ercItem->SetItems( label, port );
 
             SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), label->GetPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             return false;
         }
@@ -3680,7 +3864,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
         ercItem->SetErrorMessage( msg );
 
         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), bus_entry->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -3805,7 +3989,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             }
 
             SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pos );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3819,7 +4003,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             ercItem->SetItemsSheetPaths( sheet );
 
             SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), aSubgraph->m_no_connect->GetPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3913,7 +4097,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
             ercItem->SetItems( pin );
 
             SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-            screen->Append( marker );
+            addErcMarker( screen, marker );
 
             ok = false;
         }
@@ -3938,7 +4122,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
                     ercItem->SetItems( testPin );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), testPin->GetPosition() );
-                    screen->Append( marker );
+                    addErcMarker( screen, marker );
 
                     ok = false;
                 }
@@ -3976,7 +4160,7 @@ bool CONNECTION_GRAPH::ercCheckDanglingWireEndpoints( const CONNECTION_SUBGRAPH*
                 ercItem->SetErrorMessage( _( "Unconnected wire endpoint" ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), location );
-                sheet.LastScreen()->Append( marker );
+                addErcMarker( sheet.LastScreen(), marker );
 
                 err_count++;
             };
@@ -4000,7 +4184,7 @@ bool CONNECTION_GRAPH::ercCheckDanglingWireEndpoints( const CONNECTION_SUBGRAPH*
                 ercItem->SetErrorMessage( _( "Unconnected wire to bus entry" ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), location );
-                sheet.LastScreen()->Append( marker );
+                addErcMarker( sheet.LastScreen(), marker );
 
                 err_count++;
             };
@@ -4048,7 +4232,7 @@ bool CONNECTION_GRAPH::ercCheckFloatingWires( const CONNECTION_SUBGRAPH* aSubgra
                            wires.size() > 3 ? wires[3] : nullptr );
 
         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), wires[0]->GetPosition() );
-        screen->Append( marker );
+        addErcMarker( screen, marker );
 
         return false;
     }
@@ -4102,7 +4286,7 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
                     ercItem->SetItems( aText );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), aText->GetPosition() );
-                    aSubgraph->m_sheet.LastScreen()->Append( marker );
+                    addErcMarker( aSubgraph->m_sheet.LastScreen(), marker );
                 }
             };
 
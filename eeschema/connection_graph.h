@@ -22,7 +22,10 @@
 #ifndef _CONNECTION_GRAPH_H
 #define _CONNECTION_GRAPH_H
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -41,10 +44,13 @@
 
 
 class CONNECTION_GRAPH;
+class ERC_ITEM;
 class SCHEMATIC;
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
+class SCH_MARKER;
 class SCH_PIN;
+class SCH_SCREEN;
 class SCH_SHEET_PIN;
 
 
@@ -424,6 +430,11 @@ public:
     /**
      * Run electrical rule checks on the connectivity graph.
      *
+     * The markers raised by the per-subgraph checks are cached by subgraph code.  After an
+     * incremental update only the subgraphs it rebuilt, and the other subgraphs on their nets,
+     * are tested again; the markers of the rest are re-raised from the cache.  A full
+     * recalculation or a change to the enabled tests drops the cache.
+     *
      * Precondition: graph is up-to-date
      *
      * @return the number of errors found
@@ -795,6 +806,12 @@ private:
      */
     size_t hasPins( const CONNECTION_SUBGRAPH* aLocSubgraph );
 
+    /**
+     * Add an ERC marker to a screen, and record it for the ERC cache if the checks of a
+     * subgraph are being recorded.
+     */
+    void addErcMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker );
+
 
 private:
     /// All the sheets in the schematic (as long as we don't have partial updates).
@@ -831,6 +848,32 @@ private:
 
     NET_MAP m_net_code_to_subgraphs_map;
 
+    /// A marker raised by the per-subgraph ERC checks, as needed to raise it again.
+    struct ERC_CACHED_MARKER
+    {
+        SCH_SCREEN*               m_screen;
+        std::shared_ptr<ERC_ITEM> m_item;
+        VECTOR2I                  m_position;
+    };
+
+    /// The results of the per-subgraph ERC checks for one subgraph.
+    struct ERC_CACHE_ENTRY
+    {
+        wxString                       m_netName;
+        int                            m_errorCount = 0;
+        std::vector<ERC_CACHED_MARKER> m_markers;
+        bool                           m_skipped = false;   ///< Driver was already tested
+    };
+
+    /// ERC results by subgraph code.  Codes are never reused until the next Reset().
+    std::map<long, ERC_CACHE_ENTRY> m_erc_cache;
+
+    /// The tests that were enabled when #m_erc_cache was filled.
+    std::vector<bool> m_erc_cache_tests;
+
+    /// Where addErcMarker() records markers, if the checks of a subgraph are being recorded.
+    std::vector<ERC_CACHED_MARKER>* m_erc_marker_sink = nullptr;
+
     int m_last_net_code;
 
     int m_last_bus_code;
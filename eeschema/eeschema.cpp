@@ -501,6 +501,11 @@ void IFACE::PreloadLibraries( KIWAY* aKiway )
             int elapsed = 0;
 
             reporter->Report( _( "Loading Symbol Libraries" ) );
+
+            // The libraries the project uses are loaded first
+            adapter->SetPreferredLibraries( LIBRARY_MANAGER_ADAPTER::ReferencedLibraries(
+                    aKiway->Prj().GetProjectPath(), wxS( "*.kicad_sch" ), { "(lib_id \"" } ) );
+
             adapter->AsyncLoad();
 
             while( true )
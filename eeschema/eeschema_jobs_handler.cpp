@@ -52,6 +52,7 @@
 #include <paths.h>
 #include <reporter.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 
 #include <settings/settings_manager.h>
 
@@ -918,7 +919,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportPythonBom( JOB* aJob )
 
 
 int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, SCH_RENDER_SETTINGS* aRenderSettings,
-                                           LIB_SYMBOL* symbol )
+                                           LIB_SYMBOL* symbol, REPORTER& aReporter )
 {
     wxCHECK( symbol, CLI::EXIT_CODES::ERR_UNKNOWN );
 
@@ -967,11 +968,11 @@ int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, SCH_REND
             }
 
             fn.SetName( filename );
-            m_reporter->Report( wxString::Format( _( "Plotting symbol '%s' unit %d to '%s'\n" ),
-                                                  symbol->GetName(),
-                                                  unit,
-                                                  fn.GetFullPath() ),
-                                RPT_SEVERITY_ACTION );
+            aReporter.Report( wxString::Format( _( "Plotting symbol '%s' unit %d to '%s'\n" ),
+                                                symbol->GetName(),
+                                                unit,
+                                                fn.GetFullPath() ),
+                              RPT_SEVERITY_ACTION );
 
             // Get the symbol bounding box to fit the plot page to it
             BOX2I symbolBB = symbol->Flatten()->GetUnitBoundingBox( unit, bodyStyle,
@@ -995,15 +996,14 @@ int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, SCH_REND
 
             if( !plotter->OpenFile( fn.GetFullPath() ) )
             {
-                m_reporter->Report( wxString::Format( _( "Unable to open destination '%s'" ) + wxS( "\n" ),
-                                                      fn.GetFullPath() ),
-                                    RPT_SEVERITY_ERROR );
+                aReporter.Report( wxString::Format( _( "Unable to open destination '%s'" ) + wxS( "\n" ),
+                                                    fn.GetFullPath() ),
+                                  RPT_SEVERITY_ERROR );
 
                 delete plotter;
                 return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
             }
 
-            LOCALE_IO     toggle;
             SCH_PLOT_OPTS plotOpts;
 
             plotter->StartPlot( wxT( "1" ) );
@@ -1024,7 +1024,7 @@ int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, SCH_REND
         }
     }
 
-    if( m_reporter->HasMessageOfSeverity( RPT_SEVERITY_ERROR ) )
+    if( aReporter.HasMessageOfSeverity( RPT_SEVERITY_ERROR ) )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
     return CLI::EXIT_CODES::OK;
@@ -1090,27 +1090,68 @@ int EESCHEMA_JOBS_HANDLER::JobSymExportSvg( JOB* aJob )
 
     int exitCode = CLI::EXIT_CODES::OK;
 
+    // The plotters need the C locale; the workers below must not switch it themselves
+    LOCALE_IO toggle;
+
     if( symbol )
     {
-        exitCode = doSymExportSvg( svgJob, &renderSettings, symbol );
+        exitCode = doSymExportSvg( svgJob, &renderSettings, symbol, *m_reporter );
     }
     else
     {
-        // Just plot all the symbols we can
-        const LIB_SYMBOL_MAP& libSymMap = schLibrary.GetSymbolMap();
+        // Just plot all the symbols we can, in parallel.  Derived symbols are drawn with the
+        // items of their root symbol, so a root and the symbols derived from it are plotted by
+        // the same task.
+        const LIB_SYMBOL_MAP&                  libSymMap = schLibrary.GetSymbolMap();
+        std::vector<std::vector<LIB_SYMBOL*>>  groups;
+        std::map<const LIB_SYMBOL*, size_t>    groupByRoot;
 
         for( const auto& [name, libSymbol] : libSymMap )
+        {
+            std::shared_ptr<LIB_SYMBOL> root = libSymbol->IsDerived() ? libSymbol->GetRootSymbol()
+                                                                      : nullptr;
+            const LIB_SYMBOL*           key = root ? root.get() : libSymbol;
+            auto                        it = groupByRoot.find( key );
+
+            if( it == groupByRoot.end() )
+            {
+                it = groupByRoot.emplace( key, groups.size() ).first;
+                groups.emplace_back();
+            }
+
+            groups[it->second].push_back( libSymbol );
+        }
+
+        std::vector<BUFFERED_REPORTER> reporters( groups.size() );
+        std::vector<int>               results( groups.size(), CLI::EXIT_CODES::OK );
+
+        GetKiCadThreadPool().submit_loop( size_t( 0 ), groups.size(),
+                [&]( size_t ii )
+                {
+                    // The plot updates the render settings (e.g. the transform)
+                    SCH_RENDER_SETTINGS taskSettings( renderSettings );
+
+                    for( LIB_SYMBOL* libSymbol : groups[ii] )
+                    {
+                        results[ii] = doSymExportSvg( svgJob, &taskSettings, libSymbol,
+                                                      reporters[ii] );
+
+                        if( results[ii] != CLI::EXIT_CODES::OK )
+                            break;
+                    }
+                } ).wait();
+
+        for( size_t ii = 0; ii < groups.size() && exitCode == CLI::EXIT_CODES::OK; ++ii )
         {
             if( m_progressReporter )
             {
-                m_progressReporter->AdvancePhase( wxString::Format( _( "Exporting %s" ), name ) );
+                m_progressReporter->AdvancePhase( wxString::Format( _( "Exporting %s" ),
+                                                                    groups[ii].front()->GetName() ) );
                 m_progressReporter->KeepRefreshing();
             }
 
-            exitCode = doSymExportSvg( svgJob, &renderSettings, libSymbol );
-
-            if( exitCode != CLI::EXIT_CODES::OK )
-                break;
+            reporters[ii].Replay( *m_reporter );
+            exitCode = results[ii];
         }
     }
 
@@ -65,8 +65,12 @@ public:
 private:
     SCHEMATIC* getSchematic( const wxString& aPath );
 
+    /**
+     * Plot every unit and body style of \a symbol.  Safe to call from the thread pool as long
+     * as no other task plots the same symbol or uses the same render settings.
+     */
     int doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, SCH_RENDER_SETTINGS* aRenderSettings,
-                        LIB_SYMBOL* symbol );
+                        LIB_SYMBOL* symbol, REPORTER& aReporter );
 
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( SCHEMATIC* aSch );
 
@@ -24,6 +24,9 @@
  */
 
 #include <algorithm>
+#include <deque>
+#include <functional>
+#include <future>
 #include <numeric>
 
 #include "connection_graph.h"
@@ -49,6 +52,7 @@
 #include <sch_textbox.h>
 #include <sch_line.h>
 #include <schematic.h>
+#include <thread_pool.h>
 #include <drawing_sheet/ds_draw_item.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
 #include <vector>
@@ -139,6 +143,22 @@ const std::set<ELECTRICAL_PINTYPE> DrivenPinTypes =
 extern void CheckDuplicatePins( LIB_SYMBOL* aSymbol, std::vector<wxString>& aMessages,
                                 UNITS_PROVIDER* aUnitsProvider );
 
+/**
+ * While checks run concurrently, each one collects its markers here instead of adding them to
+ * the screens, whose item trees the other checks are reading.
+ */
+static thread_local std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>>* s_pendingMarkers = nullptr;
+
+
+static void appendMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( s_pendingMarkers )
+        s_pendingMarkers->emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
+
 int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
 {
     int err_count = 0;
@@ -169,7 +189,7 @@ int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
                         ercItem->SetItems( sheet, test_item );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), sheet->GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
 
                     err_count++;
@@ -214,7 +234,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( ercText );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pos );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
 
                     return true;
                 }
@@ -233,7 +253,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetErrorMessage( ercText );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pos );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
 
                     return true;
                 }
@@ -271,7 +291,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), field.GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText(), field.GetPosition() );
@@ -301,7 +321,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                         VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pos );
-                                        screen->Append( marker );
+                                        appendMarker( screen, marker );
                                     }
 
                                     testAssertion( symbol, sheet, screen, textItem->GetText(),
@@ -322,7 +342,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                                         VECTOR2I pos = bbox.Centre() + symbol->GetPosition();
 
                                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pos );
-                                        screen->Append( marker );
+                                        appendMarker( screen, marker );
                                     }
 
                                     testAssertion( symbol, sheet, screen, textboxItem->GetText(),
@@ -343,7 +363,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), field.GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText(), field.GetPosition() );
@@ -362,7 +382,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), field.GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
 
                     testAssertion( &field, sheet, screen, field.GetText(), field.GetPosition() );
@@ -380,7 +400,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
                 }
             }
@@ -393,7 +413,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), text->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
 
                 testAssertion( text, sheet, screen, text->GetText(), text->GetPosition() );
@@ -407,7 +427,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), textBox->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
 
                 testAssertion( textBox, sheet, screen, textBox->GetText(), textBox->GetPosition() );
@@ -429,7 +449,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), text->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
             }
         }
@@ -487,7 +507,7 @@ int ERC_TESTER::TestMultiunitFootprints()
                 ercItem->SetItems( unit, secondUnit );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), secondUnit->GetPosition() );
-                secondRef.GetSheetPath().LastScreen()->Append( marker );
+                appendMarker( secondRef.GetSheetPath().LastScreen(), marker );
 
                 ++errors;
             }
@@ -550,7 +570,7 @@ int ERC_TESTER::TestMissingUnits()
                     ercItem->SetItemsSheetPaths( base_ref.GetSheetPath() );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), unit->GetPosition() );
-                    base_ref.GetSheetPath().LastScreen()->Append( marker );
+                    appendMarker( base_ref.GetSheetPath().LastScreen(), marker );
 
                     ++errors;
                 };
@@ -649,7 +669,7 @@ int ERC_TESTER::TestMissingNetclasses()
                 ercItem->SetErrorMessage( wxString::Format( _( "Netclass %s is not defined" ), netclass ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             };
 
     for( const SCH_SHEET_PATH& sheet : m_sheetList )
@@ -731,7 +751,7 @@ int ERC_TESTER::TestLabelMultipleWires()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pair.first );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -810,7 +830,7 @@ int ERC_TESTER::TestFourWayJunction()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pair.first );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -901,7 +921,7 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pair.first );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -910,59 +930,88 @@ int ERC_TESTER::TestNoConnectPins()
 }
 
 
-int ERC_TESTER::TestPinToPin()
+const std::vector<ERC_TESTER::NET_PINS>& ERC_TESTER::getNetPins()
 {
-    int errors = 0;
+    if( m_netPinsValid )
+        return m_netPins;
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
-    {
-        using iterator_t = std::vector<ERC_SCH_PIN_CONTEXT>::iterator;
-        std::vector<ERC_SCH_PIN_CONTEXT>           pins;
-        std::unordered_map<EDA_ITEM*, SCH_SCREEN*> pinToScreenMap;
-        bool has_noconnect = false;
+    std::vector<const std::vector<CONNECTION_SUBGRAPH*>*> nets;
 
-        for( CONNECTION_SUBGRAPH* subgraph: net.second )
-        {
-            if( subgraph->GetNoConnect() )
-                has_noconnect = true;
+    for( const auto& [key, subgraphs] : m_nets )
+        nets.push_back( &subgraphs );
 
-            for( SCH_ITEM* item : subgraph->GetItems() )
+    m_netPins.clear();
+    m_netPins.resize( nets.size() );
+
+    auto collect =
+            [&]( size_t ii )
             {
-                if( item->Type() == SCH_PIN_T )
+                NET_PINS& netPins = m_netPins[ii];
+
+                for( CONNECTION_SUBGRAPH* subgraph : *nets[ii] )
                 {
-                    pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
-                    pinToScreenMap[item] = subgraph->GetSheet().LastScreen();
+                    if( subgraph->GetNoConnect() )
+                        netPins.m_hasNoConnect = true;
+
+                    for( SCH_ITEM* item : subgraph->GetItems() )
+                    {
+                        if( item->Type() == SCH_PIN_T )
+                            netPins.m_pins.emplace_back( static_cast<SCH_PIN*>( item ), subgraph->GetSheet() );
+                    }
                 }
-            }
-        }
 
-        std::sort( pins.begin(), pins.end(),
-                   []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
-                   {
-                       int ret = StrNumCmp( lhs.Pin()->GetParentSymbol()->GetRef( &lhs.Sheet() ),
-                                            rhs.Pin()->GetParentSymbol()->GetRef( &rhs.Sheet() ) );
+                std::sort( netPins.m_pins.begin(), netPins.m_pins.end(),
+                           []( const ERC_SCH_PIN_CONTEXT& lhs, const ERC_SCH_PIN_CONTEXT& rhs )
+                           {
+                               int ret = StrNumCmp( lhs.Ref(), rhs.Ref() );
+
+                               if( ret == 0 )
+                                   ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
+
+                               if( ret == 0 )
+                                   ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
+
+                               return ret < 0;
+                           } );
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.submit_loop( 0, nets.size(),
+                                   [&]( const int ii )
+                                   {
+                                       collect( ii );
+                                   } );
 
-                       if( ret == 0 )
-                           ret = StrNumCmp( lhs.Pin()->GetNumber(), rhs.Pin()->GetNumber() );
+    results.wait();
 
-                       if( ret == 0 )
-                           ret = lhs < rhs; // Fallback to hash to guarantee deterministic sort
+    m_netPinsValid = true;
+    return m_netPins;
+}
 
-                       return ret < 0;
-                   } );
+
+int ERC_TESTER::TestPinToPin()
+{
+    int errors = 0;
+
+    for( const NET_PINS& netPins : getNetPins() )
+    {
+        using iterator_t = std::vector<ERC_SCH_PIN_CONTEXT>::const_iterator;
+        const std::vector<ERC_SCH_PIN_CONTEXT>& pins = netPins.m_pins;
+        bool has_noconnect = netPins.m_hasNoConnect;
 
         ERC_SCH_PIN_CONTEXT needsDriver;
         ELECTRICAL_PINTYPE  needsDriverType = ELECTRICAL_PINTYPE::PT_UNSPECIFIED;
         bool                hasDriver = false;
-        std::vector<ERC_SCH_PIN_CONTEXT*> pinsNeedingDrivers;
-        std::vector<ERC_SCH_PIN_CONTEXT*> nonPowerPinsNeedingDrivers;
+        std::vector<const ERC_SCH_PIN_CONTEXT*> pinsNeedingDrivers;
+        std::vector<const ERC_SCH_PIN_CONTEXT*> nonPowerPinsNeedingDrivers;
 
         // We need different drivers for power nets and normal nets.
         // A power net has at least one pin having the ELECTRICAL_PINTYPE::PT_POWER_IN
         // and power nets can be driven only by ELECTRICAL_PINTYPE::PT_POWER_OUT pins
         bool     ispowerNet  = false;
 
-        for( ERC_SCH_PIN_CONTEXT& refPin : pins )
+        for( const ERC_SCH_PIN_CONTEXT& refPin : pins )
         {
             if( refPin.Pin()->GetType() == ELECTRICAL_PINTYPE::PT_POWER_IN )
             {
@@ -976,7 +1025,7 @@ int ERC_TESTER::TestPinToPin()
 
         for( auto refIt = pins.begin(); refIt != pins.end(); ++refIt )
         {
-            ERC_SCH_PIN_CONTEXT& refPin = *refIt;
+            const ERC_SCH_PIN_CONTEXT& refPin = *refIt;
             ELECTRICAL_PINTYPE refType = refPin.Pin()->GetType();
 
             if( DrivenPinTypes.contains( refType ) )
@@ -1006,7 +1055,7 @@ int ERC_TESTER::TestPinToPin()
 
             for( auto testIt = refIt + 1; testIt != pins.end(); ++testIt )
             {
-                ERC_SCH_PIN_CONTEXT& testPin = *testIt;
+                const ERC_SCH_PIN_CONTEXT& testPin = *testIt;
 
                 // Multiple pins in the same symbol that share a type,
                 // name and position are considered
@@ -1122,7 +1171,7 @@ int ERC_TESTER::TestPinToPin()
                                                             ElectricalPinTypeGetText( other_pin->GetType() ) ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-                pinToScreenMap[pin]->Append( marker );
+                appendMarker( ( *pinIt ).Sheet().LastScreen(), marker );
                 errors++;
             }
         }
@@ -1133,7 +1182,7 @@ int ERC_TESTER::TestPinToPin()
 
             if( m_settings.IsTestEnabled( err_code ) )
             {
-                std::vector<ERC_SCH_PIN_CONTEXT*> pinsToMark;
+                std::vector<const ERC_SCH_PIN_CONTEXT*> pinsToMark;
 
                 if( m_showAllErrors )
                 {
@@ -1150,7 +1199,7 @@ int ERC_TESTER::TestPinToPin()
                         pinsToMark.push_back( &needsDriver );
                 }
 
-                for( ERC_SCH_PIN_CONTEXT* pinCtx : pinsToMark )
+                for( const ERC_SCH_PIN_CONTEXT* pinCtx : pinsToMark )
                 {
                     std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( err_code );
 
@@ -1159,7 +1208,7 @@ int ERC_TESTER::TestPinToPin()
                     ercItem->SetItemsSheetPaths( pinCtx->Sheet() );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pinCtx->Pin()->GetPosition() );
-                    pinToScreenMap[pinCtx->Pin()]->Append( marker );
+                    appendMarker( pinCtx->Sheet().LastScreen(), marker );
                     errors++;
                 }
             }
@@ -1212,7 +1261,7 @@ int ERC_TESTER::TestMultUnitPinConflicts()
                         ercItem->SetItemsSheetPaths( sheet, sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-                        sheet.LastScreen()->Append( marker );
+                        appendMarker( sheet.LastScreen(), marker );
                         errors += 1;
                     }
                 }
@@ -1278,7 +1327,7 @@ int ERC_TESTER::TestGroundPins()
                     ercItem->SetItemsSheetPaths( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                     errors++;
                 }
             }
@@ -1314,7 +1363,7 @@ int ERC_TESTER::TestStackedPinNotation()
                     ercItem->SetItemsSheetPaths( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), pin->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                     warnings++;
                 }
             }
@@ -1368,7 +1417,7 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
                 ercItem->SetItemsSheetPaths( globalItem.second, localItem.second );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), globalItem.first->GetPosition() );
-                globalItem.second.LastScreen()->Append( marker );
+                appendMarker( globalItem.second.LastScreen(), marker );
 
                 errCount++;
             }
@@ -1381,8 +1430,14 @@ int ERC_TESTER::TestSameLocalGlobalLabel()
 
 int ERC_TESTER::TestSimilarLabels()
 {
+    using LABEL_ENTRY = std::tuple<wxString, SCH_ITEM*, SCH_SHEET_PATH>;
+
     int errors = 0;
-    std::unordered_map<wxString, std::vector<std::tuple<wxString, SCH_ITEM*, SCH_SHEET_PATH>>> generalMap;
+
+    // Items by lower-cased text, split into groups of identical text.  Only items in different
+    // groups are similar, so the many instances of a common name (GND, +3V3, ...) are never
+    // compared with each other.
+    std::unordered_map<wxString, std::vector<std::vector<LABEL_ENTRY>>> generalMap;
 
     auto logError =
             [&]( const wxString& normalized, SCH_ITEM* item, const SCH_SHEET_PATH& sheet,
@@ -1413,7 +1468,44 @@ int ERC_TESTER::TestSimilarLabels()
                 ercItem->SetItemsSheetPaths( sheet, otherSheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( std::move( ercItem ), item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
+            };
+
+    auto testAndAdd =
+            [&]( const wxString& unnormalized, SCH_ITEM* item, const SCH_SHEET_PATH& sheet )
+            {
+                wxString                               normalized = unnormalized.Lower();
+                std::vector<std::vector<LABEL_ENTRY>>& groups = generalMap[normalized];
+                std::vector<LABEL_ENTRY>*              ownGroup = nullptr;
+
+                for( std::vector<LABEL_ENTRY>& group : groups )
+                {
+                    if( std::get<0>( group.front() ) == unnormalized )
+                    {
+                        ownGroup = &group;
+                        continue;
+                    }
+
+                    for( const LABEL_ENTRY& otherTuple : group )
+                    {
+                        const auto& [otherText, otherItem, otherSheet] = otherTuple;
+
+                        // Similar local labels on different sheets are fine
+                        if( item->Type() == SCH_LABEL_T && otherItem->Type() == SCH_LABEL_T
+                                && sheet != otherSheet )
+                        {
+                            continue;
+                        }
+
+                        logError( normalized, item, sheet, otherTuple );
+                        errors += 1;
+                    }
+                }
+
+                if( !ownGroup )
+                    ownGroup = &groups.emplace_back();
+
+                ownGroup->emplace_back( unnormalized, item, sheet );
             };
 
     for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : m_nets )
@@ -1431,29 +1523,8 @@ int ERC_TESTER::TestSimilarLabels()
                 case SCH_GLOBAL_LABEL_T:
                 {
                     SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
-                    wxString        unnormalized = label->GetShownText( &sheet, false );
-                    wxString        normalized = unnormalized.Lower();
-
-                    generalMap[normalized].emplace_back( std::make_tuple( unnormalized, label, sheet ) );
-
-                    for( const auto& otherTuple : generalMap.at( normalized ) )
-                    {
-                        const auto& [otherText, otherItem, otherSheet] = otherTuple;
-
-                        if( unnormalized != otherText )
-                        {
-                            // Similar local labels on different sheets are fine
-                            if( item->Type() == SCH_LABEL_T && otherItem->Type() == SCH_LABEL_T
-                                    && sheet != otherSheet )
-                            {
-                                continue;
-                            }
-
-                            logError( normalized, label, sheet, otherTuple );
-                            errors += 1;
-                        }
-                    }
 
+                    testAndAdd( label->GetShownText( &sheet, false ), label, sheet );
                     break;
                 }
                 case SCH_PIN_T:
@@ -1464,22 +1535,8 @@ int ERC_TESTER::TestSimilarLabels()
                         continue;
 
                     SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( pin->GetParentSymbol() );
-                    wxString    unnormalized = symbol->GetValue( true, &sheet, false );
-                    wxString    normalized = unnormalized.Lower();
-
-                    generalMap[normalized].emplace_back( std::make_tuple( unnormalized, pin, sheet ) );
-
-                    for( const auto& otherTuple : generalMap.at( normalized ) )
-                    {
-                        const auto& [otherText, otherItem, otherSheet] = otherTuple;
-
-                        if( unnormalized != otherText )
-                        {
-                            logError( normalized, pin, sheet, otherTuple );
-                            errors += 1;
-                        }
-                    }
 
+                    testAndAdd( symbol->GetValue( true, &sheet, false ), pin, sheet );
                     break;
                 }
 
@@ -1610,7 +1667,7 @@ int ERC_TESTER::TestLibSymbolIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            appendMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1690,7 +1747,7 @@ int ERC_TESTER::TestFootprintLinkIssues( KIFACE* aCvPcb, PROJECT* aProject )
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            appendMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1760,7 +1817,7 @@ int ERC_TESTER::TestFootprintFilters()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            appendMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1842,7 +1899,7 @@ int ERC_TESTER::TestOffGridEndpoints()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            appendMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1895,7 +1952,7 @@ int ERC_TESTER::TestSimModelIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            appendMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1954,25 +2011,46 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         TestMissingUnits();
     }
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking pins..." ) );
+    // The checks below only read the schematic and the connection graph, so they run
+    // concurrently on the thread pool.  Each one collects its markers, which are added to the
+    // screens afterwards in the order of this list so the results do not depend on scheduling.
+    struct CONCURRENT_CHECK
+    {
+        wxString                                         m_phase;
+        std::function<void()>                            m_test;
+        std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> m_markers;
+        std::future<void>                                m_done;
+    };
+
+    std::deque<CONCURRENT_CHECK> checks;
+
+    auto addCheck =
+            [&]( bool aEnabled, const wxString& aPhase, std::function<void()> aTest )
+            {
+                if( !aEnabled )
+                    aTest = nullptr;
+
+                // A disabled check is kept when it owns a progress phase, so the phase count
+                // does not change
+                if( aTest || !aPhase.IsEmpty() )
+                    checks.push_back( { aPhase, std::move( aTest ), {}, {} } );
+            };
 
-    if( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ) )
-        TestMultUnitPinConflicts();
+    addCheck( m_settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ), _( "Checking pins..." ),
+              [&]() { TestMultUnitPinConflicts(); } );
 
     // Test pins on each net against the pin connection table
-    if( m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
-        || m_settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
-        || m_settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ) )
-    {
-        TestPinToPin();
-    }
+    bool testPinToPin = m_settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
+                        || m_settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
+                        || m_settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN );
 
-    if( m_settings.IsTestEnabled( ERCE_GROUND_PIN_NOT_GROUND ) )
-        TestGroundPins();
+    addCheck( testPinToPin, wxEmptyString, [&]() { TestPinToPin(); } );
 
-    if( m_settings.IsTestEnabled( ERCE_STACKED_PIN_SYNTAX ) )
-        TestStackedPinNotation();
+    addCheck( m_settings.IsTestEnabled( ERCE_GROUND_PIN_NOT_GROUND ), wxEmptyString,
+              [&]() { TestGroundPins(); } );
+
+    addCheck( m_settings.IsTestEnabled( ERCE_STACKED_PIN_SYNTAX ), wxEmptyString,
+              [&]() { TestStackedPinNotation(); } );
 
     // Test similar labels (i;e. labels which are identical when
     // using case insensitive comparisons)
@@ -1980,18 +2058,90 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         || m_settings.IsTestEnabled( ERCE_SIMILAR_POWER )
         || m_settings.IsTestEnabled( ERCE_SIMILAR_LABEL_AND_POWER ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking similar labels..." ) );
-
-        TestSimilarLabels();
+        addCheck( true, _( "Checking similar labels..." ), [&]() { TestSimilarLabels(); } );
     }
 
     if( m_settings.IsTestEnabled( ERCE_SAME_LOCAL_GLOBAL_LABEL ) )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking local and global labels..." ) );
+        addCheck( true, _( "Checking local and global labels..." ),
+                  [&]() { TestSameLocalGlobalLabel(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
+    {
+        addCheck( true, _( "Checking no connect pins for connections..." ),
+                  [&]() { TestNoConnectPins(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
+    {
+        addCheck( true, _( "Checking for off grid pins and wires..." ),
+                  [&]() { TestOffGridEndpoints(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
+    {
+        addCheck( true, _( "Checking for four way junctions..." ),
+                  [&]() { TestFourWayJunction(); } );
+    }
+
+    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
+    {
+        addCheck( true, _( "Checking for labels on more than one wire..." ),
+                  [&]() { TestLabelMultipleWires(); } );
+    }
+
+    // Built up front, as it uses the thread pool itself and a check must not wait on the pool
+    if( testPinToPin )
+        getNetPins();
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    for( CONCURRENT_CHECK& check : checks )
+    {
+        if( !check.m_test )
+            continue;
+
+        check.m_done = tp.submit_task(
+                [&check]()
+                {
+                    s_pendingMarkers = &check.m_markers;
+
+                    try
+                    {
+                        check.m_test();
+                    }
+                    catch( ... )
+                    {
+                        s_pendingMarkers = nullptr;
+                        throw;
+                    }
+
+                    s_pendingMarkers = nullptr;
+                } );
+    }
+
+    for( CONCURRENT_CHECK& check : checks )
+    {
+        if( aProgressReporter && !check.m_phase.IsEmpty() )
+            aProgressReporter->AdvancePhase( check.m_phase );
+
+        if( !check.m_done.valid() )
+            continue;
+
+        while( check.m_done.wait_for( std::chrono::milliseconds( 100 ) ) != std::future_status::ready )
+        {
+            if( aProgressReporter )
+                aProgressReporter->KeepRefreshing();
+        }
+
+        check.m_done.get();
+    }
 
-        TestSameLocalGlobalLabel();
+    for( CONCURRENT_CHECK& check : checks )
+    {
+        for( const auto& [screen, marker] : check.m_markers )
+            screen->Append( marker );
     }
 
     if( m_settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
@@ -2010,14 +2160,6 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         TestSimModelIssues();
     }
 
-    if( m_settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
-
-        TestNoConnectPins();
-    }
-
     if( m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES )
         || m_settings.IsTestEnabled( ERCE_LIB_SYMBOL_MISMATCH ) )
     {
@@ -2043,30 +2185,6 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
         TestFootprintFilters();
     }
 
-    if( m_settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
-
-        TestOffGridEndpoints();
-    }
-
-    if( m_settings.IsTestEnabled( ERCE_FOUR_WAY_JUNCTION ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for four way junctions..." ) );
-
-        TestFourWayJunction();
-    }
-
-    if( m_settings.IsTestEnabled( ERCE_LABEL_MULTIPLE_WIRES ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for labels on more than one wire..." ) );
-
-        TestLabelMultipleWires();
-    }
-
     if( m_settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
     {
         if( aProgressReporter )
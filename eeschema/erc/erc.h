@@ -31,6 +31,7 @@
 #include <sch_screen.h>
 #include <sch_reference_list.h>
 #include <connection_graph.h>
+#include <erc/erc_sch_pin_context.h>
 #include <vector>
 #include <map>
 
@@ -185,6 +186,22 @@ public:
     void RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aEditFrame,
                    KIFACE* aCvPcb, PROJECT* aProject, PROGRESS_REPORTER* aProgressReporter );
 
+private:
+    /**
+     * The pins of one net with their sheets, sorted by reference and pin number.
+     */
+    struct NET_PINS
+    {
+        std::vector<ERC_SCH_PIN_CONTEXT> m_pins;
+        bool                             m_hasNoConnect = false;
+    };
+
+    /**
+     * Collect and sort the pins of every net, one net per thread pool task.  The result is
+     * kept so the per-net checks do not each rebuild it.
+     */
+    const std::vector<NET_PINS>& getNetPins();
+
 private:
     SCHEMATIC*                   m_schematic;
     ERC_SETTINGS&                m_settings;
@@ -193,6 +210,9 @@ private:
     SCH_MULTI_UNIT_REFERENCE_MAP m_refMap;
     const NET_MAP&               m_nets;
     bool                         m_showAllErrors;
+
+    std::vector<NET_PINS>        m_netPins;
+    bool                         m_netPinsValid = false;
 };
 
 
@@ -56,17 +56,31 @@ ERC_REPORT::ERC_REPORT( SCHEMATIC* aSchematic, EDA_UNITS aReportUnits,
 
 
 wxString ERC_REPORT::GetTextReport()
+{
+    wxString msg;
+
+    formatTextReport(
+            [&]( const wxString& aText )
+            {
+                msg << aText;
+            } );
+
+    return msg;
+}
+
+
+void ERC_REPORT::formatTextReport( const std::function<void( const wxString& )>& aOutput )
 {
     // We need the global LOCALE_IO here in order to
     // write the report in the c-locale.
     LOCALE_IO      locale;
     UNITS_PROVIDER unitsProvider( schIUScale, m_reportUnits );
 
-    wxString msg = wxString::Format( wxT( "ERC report (%s, Encoding UTF8)\n" ),
-                                     GetISO8601CurrentDateTime() );
+    aOutput( wxString::Format( wxT( "ERC report (%s, Encoding UTF8)\n" ),
+                               GetISO8601CurrentDateTime() ) );
 
-    msg += wxString::Format( wxT( "Report includes: %s\n" ),
-                             formatSeverities( m_reportedSeverities ) );
+    aOutput( wxString::Format( wxT( "Report includes: %s\n" ),
+                               formatSeverities( m_reportedSeverities ) ) );
 
     std::map<KIID, EDA_ITEM*> itemMap;
 
@@ -94,7 +108,7 @@ wxString ERC_REPORT::GetTextReport()
 
     for( unsigned i = 0; i < sheetList.size(); i++ )
     {
-        msg << wxString::Format( wxT( "\n***** Sheet %s\n" ), sheetList[i].PathHumanReadable() );
+        aOutput( wxString::Format( wxT( "\n***** Sheet %s\n" ), sheetList[i].PathHumanReadable() ) );
 
         for( ERC_ITEM* item : orderedItems[sheetList[i]] )
         {
@@ -109,16 +123,16 @@ wxString ERC_REPORT::GetTextReport()
             default:                                 break;
             }
 
-            msg << item->ShowReport( &unitsProvider, severity, itemMap );
+            aOutput( item->ShowReport( &unitsProvider, severity, itemMap ) );
         }
     }
 
-    msg << wxString::Format( wxT( "\n ** ERC messages: %d  Errors %d  Warnings %d\n" ),
-                             total_count,
-                             err_count,
-                             warn_count );
+    aOutput( wxString::Format( wxT( "\n ** ERC messages: %d  Errors %d  Warnings %d\n" ),
+                               total_count,
+                               err_count,
+                               warn_count ) );
 
-    msg << wxT( "\n ** Ignored checks:\n" );
+    aOutput( wxT( "\n ** Ignored checks:\n" ) );
 
     bool hasIgnored = false;
 
@@ -128,15 +142,13 @@ wxString ERC_REPORT::GetTextReport()
 
         if( code > 0 && settings.GetSeverity( code ) == RPT_SEVERITY_IGNORE )
         {
-            msg << wxString::Format( wxT( "    - %s\n" ), item.GetErrorMessage( false ) );
+            aOutput( wxString::Format( wxT( "    - %s\n" ), item.GetErrorMessage( false ) ) );
             hasIgnored = true;
         }
     }
 
     if( !hasIgnored )
-        msg << wxT( "    - " ) << wxT( "None" ) << wxT( "\n" );
-
-    return msg;
+        aOutput( wxT( "    - None\n" ) );
 }
 
 
@@ -147,7 +159,11 @@ bool ERC_REPORT::WriteTextReport( const wxString& aFullFileName )
     if( !file.IsOpened() )
         return false;
 
-    file.Write( GetTextReport() );
+    formatTextReport(
+            [&]( const wxString& aText )
+            {
+                file.Write( aText );
+            } );
 
     // wxFFile dtor will close the file.
     return true;
@@ -161,24 +177,6 @@ bool ERC_REPORT::WriteJsonReport( const wxString& aFullFileName )
     UNITS_PROVIDER            unitsProvider( pcbIUScale, m_reportUnits );
     std::map<KIID, EDA_ITEM*> itemMap;
 
-    RC_JSON::ERC_REPORT reportHead;
-    wxFileName          fn( m_sch->GetFileName() );
-    reportHead.$schema = "https://schemas.kicad.org/erc.v1.json";
-    reportHead.source = fn.GetFullName();
-    reportHead.date = GetISO8601CurrentDateTime();
-    reportHead.kicad_version = GetMajorMinorPatchVersion();
-    reportHead.coordinate_units = EDA_UNIT_UTILS::GetLabel( m_reportUnits );
-
-    // Document which severities are included in this report
-    if( m_reportedSeverities & RPT_SEVERITY_ERROR )
-        reportHead.included_severities.push_back( wxS( "error" ) );
-
-    if( m_reportedSeverities & RPT_SEVERITY_WARNING )
-        reportHead.included_severities.push_back( wxS( "warning" ) );
-
-    if( m_reportedSeverities & RPT_SEVERITY_EXCLUSION )
-        reportHead.included_severities.push_back( wxS( "exclusion" ) );
-
     SCH_SHEET_LIST sheetList = m_sch->Hierarchy();
     sheetList.FillItemMap( itemMap );
 
@@ -197,24 +195,16 @@ bool ERC_REPORT::WriteJsonReport( const wxString& aFullFileName )
         }
     }
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        RC_JSON::ERC_SHEET jsonSheet;
-        jsonSheet.path = sheetList[i].PathHumanReadable();
-        jsonSheet.uuid_path = sheetList[i].Path().AsString();
-
-        for( ERC_ITEM* item : orderedItems[sheetList[i]] )
-        {
-            SEVERITY severity = settings.GetSeverity( item->GetErrorCode() );
+    // Violations are written as they are converted rather than gathered in one document
+    RC_JSON::STREAM_WRITER writer( jsonFileStream );
+    wxFileName             fn( m_sch->GetFileName() );
 
-            RC_JSON::VIOLATION violation;
-            item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+    // Members in alphabetical order, as nlohmann::json would write them
+    writer.Member( "$schema", wxString( wxS( "https://schemas.kicad.org/erc.v1.json" ) ) );
+    writer.Member( "coordinate_units", EDA_UNIT_UTILS::GetLabel( m_reportUnits ) );
+    writer.Member( "date", GetISO8601CurrentDateTime() );
 
-            jsonSheet.violations.push_back( violation );
-        }
-
-        reportHead.sheets.push_back( jsonSheet );
-    }
+    std::vector<RC_JSON::IGNORED_CHECK> ignoredChecks;
 
     for( const RC_ITEM& item : ERC_ITEM::GetItemsWithSeverities() )
     {
@@ -225,12 +215,53 @@ bool ERC_REPORT::WriteJsonReport( const wxString& aFullFileName )
             RC_JSON::IGNORED_CHECK ignoredCheck;
             ignoredCheck.key = item.GetSettingsKey();
             ignoredCheck.description = item.GetErrorMessage( false );
-            reportHead.ignored_checks.push_back( ignoredCheck );
+            ignoredChecks.push_back( ignoredCheck );
         }
     }
 
-    nlohmann::json saveJson = nlohmann::json( reportHead );
-    jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
+    writer.Member( "ignored_checks", ignoredChecks );
+
+    // Document which severities are included in this report
+    std::vector<wxString> includedSeverities;
+
+    if( m_reportedSeverities & RPT_SEVERITY_ERROR )
+        includedSeverities.push_back( wxS( "error" ) );
+
+    if( m_reportedSeverities & RPT_SEVERITY_WARNING )
+        includedSeverities.push_back( wxS( "warning" ) );
+
+    if( m_reportedSeverities & RPT_SEVERITY_EXCLUSION )
+        includedSeverities.push_back( wxS( "exclusion" ) );
+
+    writer.Member( "included_severities", includedSeverities );
+    writer.Member( "kicad_version", GetMajorMinorPatchVersion() );
+    writer.BeginArray( "sheets" );
+
+    for( unsigned i = 0; i < sheetList.size(); i++ )
+    {
+        writer.BeginObject();
+        writer.Member( "path", sheetList[i].PathHumanReadable() );
+        writer.Member( "uuid_path", sheetList[i].Path().AsString() );
+        writer.BeginArray( "violations" );
+
+        for( ERC_ITEM* item : orderedItems[sheetList[i]] )
+        {
+            SEVERITY severity = settings.GetSeverity( item->GetErrorCode() );
+
+            RC_JSON::VIOLATION violation;
+            item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+
+            writer.Element( violation );
+        }
+
+        writer.Close();
+        writer.Close();
+    }
+
+    writer.Close();
+    writer.Member( "source", fn.GetFullName() );
+    writer.Close();
+
     jsonFileStream.flush();
     jsonFileStream.close();
 
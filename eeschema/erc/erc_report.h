@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <eda_units.h>
+#include <functional>
 #include <wx/string.h>
 
 class SCHEMATIC;
@@ -55,6 +56,11 @@ public:
     bool WriteJsonReport( const wxString& aFullFileName );
 
 private:
+    /**
+     * Format the text report, handing it to \a aOutput a piece at a time.
+     */
+    void formatTextReport( const std::function<void( const wxString& )>& aOutput );
+
     SCHEMATIC*                         m_sch;
     EDA_UNITS                          m_reportUnits;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_markersProvider;
@@ -30,6 +30,18 @@
 #include "erc/erc_sch_pin_context.h"
 
 #include <hash.h>
+#include <symbol.h>
+
+
+ERC_SCH_PIN_CONTEXT::ERC_SCH_PIN_CONTEXT( SCH_PIN* pin, const SCH_SHEET_PATH& sheet ) :
+        m_pin( pin ),
+        m_sheet( sheet )
+{
+    if( const SYMBOL* symbol = pin->GetParentSymbol() )
+        m_ref = symbol->GetRef( &sheet );
+
+    rehash();
+}
 
 
 SCH_PIN* ERC_SCH_PIN_CONTEXT::Pin() const
@@ -44,6 +56,12 @@ const SCH_SHEET_PATH& ERC_SCH_PIN_CONTEXT::Sheet() const
 }
 
 
+const wxString& ERC_SCH_PIN_CONTEXT::Ref() const
+{
+    return m_ref;
+}
+
+
 bool ERC_SCH_PIN_CONTEXT::operator==( const ERC_SCH_PIN_CONTEXT& other ) const
 {
     return m_hash == other.m_hash;
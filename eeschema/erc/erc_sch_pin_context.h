@@ -45,12 +45,7 @@ public:
             m_hash( 0 )
     {}
 
-    ERC_SCH_PIN_CONTEXT( SCH_PIN* pin, const SCH_SHEET_PATH& sheet ) :
-            m_pin( pin ),
-            m_sheet( sheet )
-    {
-        rehash();
-    }
+    ERC_SCH_PIN_CONTEXT( SCH_PIN* pin, const SCH_SHEET_PATH& sheet );
 
     ERC_SCH_PIN_CONTEXT( const ERC_SCH_PIN_CONTEXT& other ) = default;
 
@@ -68,6 +63,13 @@ public:
      */
     const SCH_SHEET_PATH& Sheet() const;
 
+    /**
+     * Get the reference of the parent symbol of the pin on the paired sheet.
+     *
+     * It is resolved once when the context is created, as pins are sorted by reference.
+     */
+    const wxString& Ref() const;
+
     /**
      * Test two pin contexts for equality based on the deterministic hash.
      */
@@ -86,6 +88,7 @@ protected:
 
     SCH_PIN*       m_pin;
     SCH_SHEET_PATH m_sheet;
+    wxString       m_ref;
     size_t         m_hash;
 };
 
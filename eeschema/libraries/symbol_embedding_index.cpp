@@ -0,0 +1,546 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libraries/symbol_embedding_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+#include <kiplatform/io.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+
+/// Bump whenever the cache file layout changes
+static const uint64_t SYMBOL_EMBEDDING_CACHE_VERSION = 1;
+
+static const char SYMBOL_EMBEDDING_CACHE_MAGIC[8] = { 'K', 'I', 'S', 'Y', 'M', 'E', 'M', 'B' };
+
+/// k-means passes when partitioning; the lists only need to be roughly balanced
+static const int KMEANS_ITERATIONS = 4;
+
+/// Training samples per centroid.  Partitioning is single threaded, as updates are expected to
+/// run on a worker already, and this keeps it to a few seconds for the full libraries.
+static const size_t KMEANS_SAMPLES_PER_LIST = 32;
+
+
+static float dot( const float* aA, const float* aB, size_t aDim )
+{
+    float sum = 0.0f;
+
+    for( size_t ii = 0; ii < aDim; ++ii )
+        sum += aA[ii] * aB[ii];
+
+    return sum;
+}
+
+
+SYMBOL_EMBEDDING_INDEX::SYMBOL_EMBEDDING_INDEX() :
+        m_data( std::make_shared<DATA>() )
+{
+}
+
+
+void SYMBOL_EMBEDDING_INDEX::Normalize( std::vector<float>& aVector )
+{
+    double norm = 0.0;
+
+    for( float v : aVector )
+        norm += double( v ) * v;
+
+    if( norm <= 0.0 )
+        return;
+
+    float scale = float( 1.0 / std::sqrt( norm ) );
+
+    for( float& v : aVector )
+        v *= scale;
+}
+
+
+uint64_t SYMBOL_EMBEDDING_INDEX::hashText( const wxString& aText )
+{
+    // FNV-1a, stable across sessions unlike std::hash
+    uint64_t hash = 14695981039346656037ULL;
+
+    for( const char* c = aText.utf8_str(); *c; ++c )
+    {
+        hash ^= static_cast<unsigned char>( *c );
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+
+size_t SYMBOL_EMBEDDING_INDEX::Size() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_data->keys.size();
+}
+
+
+wxString SYMBOL_EMBEDDING_INDEX::GetModel() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_data->model;
+}
+
+
+bool SYMBOL_EMBEDDING_INDEX::Update( const std::vector<DOCUMENT>& aDocuments,
+                                     const wxString& aModel, const EMBED_FUNC& aEmbed,
+                                     const std::atomic<bool>* aCancel )
+{
+    std::shared_ptr<const DATA> old;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        old = m_data;
+    }
+
+    std::map<wxString, size_t> oldRows;
+
+    if( old->model == aModel )
+    {
+        for( size_t ii = 0; ii < old->keys.size(); ++ii )
+            oldRows[old->keys[ii]] = ii;
+    }
+
+    auto data = std::make_shared<DATA>();
+
+    data->model = aModel;
+    data->dim = oldRows.empty() ? 0 : old->dim;
+    data->keys.reserve( aDocuments.size() );
+    data->textHashes.reserve( aDocuments.size() );
+
+    std::vector<std::vector<float>> rows( aDocuments.size() );
+    std::vector<size_t>             pending;
+
+    for( size_t ii = 0; ii < aDocuments.size(); ++ii )
+    {
+        const DOCUMENT& doc = aDocuments[ii];
+        uint64_t        hash = hashText( doc.text );
+        auto            it = oldRows.find( doc.key );
+
+        data->keys.push_back( doc.key );
+        data->textHashes.push_back( hash );
+
+        if( it != oldRows.end() && old->textHashes[it->second] == hash )
+        {
+            const float* row = old->Row( it->second );
+            rows[ii].assign( row, row + old->dim );
+        }
+        else
+        {
+            pending.push_back( ii );
+        }
+    }
+
+    for( size_t first = 0; first < pending.size(); first += BATCH_SIZE )
+    {
+        if( aCancel && aCancel->load() )
+            return false;
+
+        size_t                          last = std::min( first + BATCH_SIZE, pending.size() );
+        std::vector<wxString>           texts;
+        std::vector<std::vector<float>> vectors;
+
+        for( size_t ii = first; ii < last; ++ii )
+            texts.push_back( aDocuments[pending[ii]].text );
+
+        if( !aEmbed( texts, vectors ) || vectors.size() != texts.size() )
+            return false;
+
+        for( size_t ii = first; ii < last; ++ii )
+        {
+            std::vector<float>& vector = vectors[ii - first];
+
+            if( data->dim == 0 )
+                data->dim = vector.size();
+
+            if( vector.empty() || vector.size() != data->dim )
+                return false;
+
+            Normalize( vector );
+            rows[pending[ii]] = std::move( vector );
+        }
+    }
+
+    data->vectors.reserve( rows.size() * data->dim );
+
+    for( const std::vector<float>& row : rows )
+        data->vectors.insert( data->vectors.end(), row.begin(), row.end() );
+
+    partition( *data );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_data = std::move( data );
+    return true;
+}
+
+
+void SYMBOL_EMBEDDING_INDEX::partition( DATA& aData )
+{
+    const size_t count = aData.keys.size();
+    const size_t dim = aData.dim;
+
+    aData.centroids.clear();
+    aData.lists.clear();
+
+    if( count < MIN_PARTITIONED_SIZE || dim == 0 )
+        return;
+
+    const size_t listCount = static_cast<size_t>( std::lround( std::sqrt( double( count ) ) ) );
+    const size_t stride = std::max<size_t>( 1, count / ( listCount * KMEANS_SAMPLES_PER_LIST ) );
+
+    std::vector<uint32_t> samples;
+
+    for( size_t ii = 0; ii < count; ii += stride )
+        samples.push_back( static_cast<uint32_t>( ii ) );
+
+    // Deterministic seeds spread over the documents, which are grouped by library
+    std::vector<float>& centroids = aData.centroids;
+
+    centroids.resize( listCount * dim );
+
+    for( size_t c = 0; c < listCount; ++c )
+    {
+        const float* row = aData.Row( c * count / listCount );
+        std::copy( row, row + dim, centroids.begin() + c * dim );
+    }
+
+    auto nearest =
+            [&]( const float* aRow )
+            {
+                uint32_t best = 0;
+                float    bestScore = -2.0f;
+
+                for( size_t c = 0; c < listCount; ++c )
+                {
+                    float score = dot( aRow, centroids.data() + c * dim, dim );
+
+                    if( score > bestScore )
+                    {
+                        bestScore = score;
+                        best = static_cast<uint32_t>( c );
+                    }
+                }
+
+                return best;
+            };
+
+    std::vector<uint32_t> assignment( samples.size() );
+
+    for( int iter = 0; iter < KMEANS_ITERATIONS; ++iter )
+    {
+        for( size_t ii = 0; ii < samples.size(); ++ii )
+            assignment[ii] = nearest( aData.Row( samples[ii] ) );
+
+        std::vector<double> sums( listCount * dim, 0.0 );
+        std::vector<size_t> sizes( listCount, 0 );
+
+        for( size_t ii = 0; ii < samples.size(); ++ii )
+        {
+            const float* row = aData.Row( samples[ii] );
+            double*      sum = sums.data() + assignment[ii] * dim;
+
+            for( size_t d = 0; d < dim; ++d )
+                sum[d] += row[d];
+
+            sizes[assignment[ii]]++;
+        }
+
+        // Spherical k-means: the centroids are kept at unit length.  An empty list keeps its
+        // previous centroid.
+        for( size_t c = 0; c < listCount; ++c )
+        {
+            if( sizes[c] == 0 )
+                continue;
+
+            std::vector<float> centroid( sums.begin() + c * dim, sums.begin() + ( c + 1 ) * dim );
+            Normalize( centroid );
+            std::copy( centroid.begin(), centroid.end(), centroids.begin() + c * dim );
+        }
+    }
+
+    std::vector<uint32_t> owner( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+        owner[ii] = nearest( aData.Row( ii ) );
+
+    aData.lists.resize( listCount );
+
+    for( size_t ii = 0; ii < count; ++ii )
+        aData.lists[owner[ii]].push_back( static_cast<uint32_t>( ii ) );
+}
+
+
+std::vector<SYMBOL_EMBEDDING_INDEX::MATCH>
+SYMBOL_EMBEDDING_INDEX::Search( const std::vector<float>& aQuery, size_t aLimit ) const
+{
+    std::shared_ptr<const DATA> data;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        data = m_data;
+    }
+
+    std::vector<MATCH> matches;
+
+    if( data->keys.empty() || aQuery.size() != data->dim || aLimit == 0 )
+        return matches;
+
+    std::vector<float> query = aQuery;
+    Normalize( query );
+
+    const size_t                          dim = data->dim;
+    std::vector<std::pair<float, size_t>> scored;
+
+    auto scan =
+            [&]( size_t aRow )
+            {
+                scored.emplace_back( dot( query.data(), data->Row( aRow ), dim ), aRow );
+            };
+
+    if( data->lists.empty() )
+    {
+        scored.reserve( data->keys.size() );
+
+        for( size_t ii = 0; ii < data->keys.size(); ++ii )
+            scan( ii );
+    }
+    else
+    {
+        // Probe the lists of the nearest centroids; a tenth of them finds nearly all of the
+        // true nearest neighbours for typical embeddings
+        const size_t listCount = data->lists.size();
+        const size_t probes = std::min( listCount, std::max<size_t>( 8, listCount / 10 ) );
+
+        std::vector<std::pair<float, size_t>> centroidScores;
+
+        for( size_t c = 0; c < listCount; ++c )
+            centroidScores.emplace_back( dot( query.data(), data->centroids.data() + c * dim, dim ), c );
+
+        std::partial_sort( centroidScores.begin(), centroidScores.begin() + probes,
+                           centroidScores.end(),
+                           []( const auto& a, const auto& b )
+                           {
+                               return a.first > b.first;
+                           } );
+
+        for( size_t p = 0; p < probes; ++p )
+        {
+            for( uint32_t row : data->lists[centroidScores[p].second] )
+                scan( row );
+        }
+    }
+
+    size_t limit = std::min( aLimit, scored.size() );
+
+    std::partial_sort( scored.begin(), scored.begin() + limit, scored.end(),
+                       []( const auto& a, const auto& b )
+                       {
+                           return a.first > b.first || ( a.first == b.first && a.second < b.second );
+                       } );
+
+    for( size_t ii = 0; ii < limit; ++ii )
+        matches.push_back( { data->keys[scored[ii].second], scored[ii].first } );
+
+    return matches;
+}
+
+
+bool SYMBOL_EMBEDDING_INDEX::WriteCacheToFile( const wxString& aFilePath ) const
+{
+    std::shared_ptr<const DATA> data;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        data = m_data;
+    }
+
+    wxFileName tmpFileName = wxFileName::CreateTempFileName( aFilePath );
+    wxFFile    file( tmpFileName.GetFullPath(), wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    bool ok = true;
+
+    auto writeU64 =
+            [&]( uint64_t aValue )
+            {
+                ok = ok && file.Write( &aValue, sizeof( aValue ) ) == sizeof( aValue );
+            };
+
+    auto writeString =
+            [&]( const wxString& aValue )
+            {
+                wxScopedCharBuffer utf8 = aValue.utf8_str();
+
+                writeU64( utf8.length() );
+                ok = ok && file.Write( utf8.data(), utf8.length() ) == utf8.length();
+            };
+
+    auto writeFloats =
+            [&]( const std::vector<float>& aValues )
+            {
+                writeU64( aValues.size() );
+                size_t bytes = aValues.size() * sizeof( float );
+                ok = ok && file.Write( aValues.data(), bytes ) == bytes;
+            };
+
+    ok = file.Write( SYMBOL_EMBEDDING_CACHE_MAGIC, sizeof( SYMBOL_EMBEDDING_CACHE_MAGIC ) )
+            == sizeof( SYMBOL_EMBEDDING_CACHE_MAGIC );
+
+    writeU64( SYMBOL_EMBEDDING_CACHE_VERSION );
+    writeString( data->model );
+    writeU64( data->dim );
+    writeU64( data->keys.size() );
+
+    for( size_t ii = 0; ii < data->keys.size(); ++ii )
+    {
+        writeString( data->keys[ii] );
+        writeU64( data->textHashes[ii] );
+    }
+
+    writeFloats( data->vectors );
+    writeFloats( data->centroids );
+    writeU64( data->lists.size() );
+
+    for( const std::vector<uint32_t>& list : data->lists )
+    {
+        writeU64( list.size() );
+        size_t bytes = list.size() * sizeof( uint32_t );
+        ok = ok && file.Write( list.data(), bytes ) == bytes;
+    }
+
+    ok = file.Close() && ok;
+
+    if( ok )
+    {
+        KIPLATFORM::IO::DuplicatePermissions( aFilePath, tmpFileName.GetFullPath() );
+        ok = wxRenameFile( tmpFileName.GetFullPath(), aFilePath, true );
+    }
+
+    // Not fatal; the embeddings are simply requested again next session
+    if( !ok )
+        wxRemoveFile( tmpFileName.GetFullPath() );
+
+    return ok;
+}
+
+
+bool SYMBOL_EMBEDDING_INDEX::ReadCacheFromFile( const wxString& aFilePath )
+{
+    if( !wxFileName::FileExists( aFilePath ) )
+        return false;
+
+    wxFFile file( aFilePath, wxS( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    const uint64_t fileSize = static_cast<uint64_t>( file.Length() );
+    bool           ok = true;
+
+    auto readU64 =
+            [&]() -> uint64_t
+            {
+                uint64_t value = 0;
+                ok = ok && file.Read( &value, sizeof( value ) ) == sizeof( value );
+                return ok ? value : 0;
+            };
+
+    // Sizes are checked against the file size so a damaged file can't cause a huge allocation
+    auto readCount =
+            [&]( size_t aItemSize ) -> size_t
+            {
+                uint64_t count = readU64();
+                ok = ok && count <= fileSize / aItemSize;
+                return ok ? static_cast<size_t>( count ) : 0;
+            };
+
+    auto readString =
+            [&]() -> wxString
+            {
+                std::string utf8( readCount( 1 ), '\0' );
+                ok = ok && file.Read( utf8.data(), utf8.size() ) == utf8.size();
+                return ok ? wxString::FromUTF8( utf8 ) : wxString();
+            };
+
+    auto readFloats =
+            [&]( std::vector<float>& aValues )
+            {
+                aValues.resize( readCount( sizeof( float ) ) );
+                size_t bytes = aValues.size() * sizeof( float );
+                ok = ok && file.Read( aValues.data(), bytes ) == bytes;
+            };
+
+    char magic[sizeof( SYMBOL_EMBEDDING_CACHE_MAGIC )] = {};
+
+    ok = file.Read( magic, sizeof( magic ) ) == sizeof( magic )
+            && memcmp( magic, SYMBOL_EMBEDDING_CACHE_MAGIC, sizeof( magic ) ) == 0;
+
+    if( !ok || readU64() != SYMBOL_EMBEDDING_CACHE_VERSION )
+        return false;
+
+    auto data = std::make_shared<DATA>();
+
+    data->model = readString();
+    data->dim = readCount( sizeof( float ) );
+
+    size_t count = readCount( 2 * sizeof( uint64_t ) );
+
+    for( size_t ii = 0; ok && ii < count; ++ii )
+    {
+        data->keys.push_back( readString() );
+        data->textHashes.push_back( readU64() );
+    }
+
+    readFloats( data->vectors );
+    readFloats( data->centroids );
+
+    size_t listCount = readCount( sizeof( uint64_t ) );
+
+    data->lists.resize( listCount );
+
+    for( std::vector<uint32_t>& list : data->lists )
+    {
+        list.resize( readCount( sizeof( uint32_t ) ) );
+        size_t bytes = list.size() * sizeof( uint32_t );
+        ok = ok && file.Read( list.data(), bytes ) == bytes;
+
+        for( uint32_t row : list )
+            ok = ok && row < count;
+    }
+
+    ok = ok && data->vectors.size() == count * data->dim
+            && data->centroids.size() == listCount * data->dim;
+
+    if( !ok )
+        return false;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_data = std::move( data );
+    return true;
+}
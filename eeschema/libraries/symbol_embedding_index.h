@@ -0,0 +1,124 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_EMBEDDING_INDEX_H
+#define SYMBOL_EMBEDDING_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <wx/string.h>
+
+
+/**
+ * A vector index over text descriptions of library symbols, for searches by meaning ("low
+ * noise LDO 3.3V") rather than by name.
+ *
+ * The embeddings are computed by a caller supplied function (normally an Ollama embedding
+ * model) and normalized, so the dot product is the cosine similarity.  Large indexes are
+ * partitioned with k-means into inverted lists and a query only scans the lists of its
+ * nearest centroids, an approximate search that avoids a scan of every vector.
+ *
+ * Updating keeps the vectors of documents whose text did not change, and the index can be
+ * written to and restored from a cache file.  Searches may run while an update is in
+ * progress on another thread: they see the previous content until the update completes.
+ */
+class SYMBOL_EMBEDDING_INDEX
+{
+public:
+    struct DOCUMENT
+    {
+        wxString key;       ///< e.g. "Regulator_Linear:LP5907MFX-3.3"
+        wxString text;      ///< What is embedded: name, description, keywords, datasheet
+    };
+
+    struct MATCH
+    {
+        wxString key;
+        float    score = 0.0f;   ///< Cosine similarity
+    };
+
+    using EMBED_FUNC = std::function<bool( const std::vector<wxString>& aTexts,
+                                           std::vector<std::vector<float>>& aVectors )>;
+
+    /// Number of texts sent per embedding request
+    static constexpr size_t BATCH_SIZE = 64;
+
+    /// Below this many documents, searches scan every vector
+    static constexpr size_t MIN_PARTITIONED_SIZE = 1024;
+
+    SYMBOL_EMBEDDING_INDEX();
+
+    /**
+     * Replace the indexed documents with \a aDocuments.
+     *
+     * Vectors of documents already indexed with the same model and text are reused; the
+     * others are requested from \a aEmbed in batches of #BATCH_SIZE.
+     *
+     * @return false if embedding failed or was cancelled, in which case the index is unchanged.
+     */
+    bool Update( const std::vector<DOCUMENT>& aDocuments, const wxString& aModel,
+                 const EMBED_FUNC& aEmbed, const std::atomic<bool>* aCancel = nullptr );
+
+    /**
+     * Return up to \a aLimit documents ordered by descending similarity to \a aQuery, which
+     * must come from the same model as the index.
+     */
+    std::vector<MATCH> Search( const std::vector<float>& aQuery, size_t aLimit ) const;
+
+    size_t Size() const;
+
+    wxString GetModel() const;
+
+    bool WriteCacheToFile( const wxString& aFilePath ) const;
+
+    bool ReadCacheFromFile( const wxString& aFilePath );
+
+    /// Scale \a aVector to unit length.  A null vector is left unchanged.
+    static void Normalize( std::vector<float>& aVector );
+
+private:
+    struct DATA
+    {
+        wxString              model;
+        size_t                dim = 0;
+        std::vector<wxString> keys;
+        std::vector<uint64_t> textHashes;
+        std::vector<float>    vectors;     ///< keys.size() rows of dim values
+
+        std::vector<float>                 centroids;   ///< lists.size() rows of dim values
+        std::vector<std::vector<uint32_t>> lists;       ///< Document rows per centroid
+
+        const float* Row( size_t aIdx ) const { return vectors.data() + aIdx * dim; }
+    };
+
+    static uint64_t hashText( const wxString& aText );
+
+    /// Cluster the vectors of \a aData into inverted lists, if there are enough of them.
+    static void partition( DATA& aData );
+
+private:
+    mutable std::mutex          m_mutex;
+    std::shared_ptr<const DATA> m_data;
+};
+
+#endif // SYMBOL_EMBEDDING_INDEX_H
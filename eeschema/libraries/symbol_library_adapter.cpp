@@ -299,6 +299,7 @@ void SYMBOL_LIBRARY_ADAPTER::AsyncLoad()
     }
 
     std::vector<LIBRARY_TABLE_ROW*> rows = m_manager.Rows( LIBRARY_TABLE_TYPE::SYMBOL );
+    sortRowsForLoad( rows );
 
     m_loadTotal = rows.size();
     m_loadCount.store( 0 );
@@ -408,7 +409,7 @@ void SYMBOL_LIBRARY_ADAPTER::AsyncLoad()
                     }
 
                     ++m_loadCount;
-                }, BS::pr::lowest ) );
+                }, PoolPriority( TASK_PRIORITY::BACKGROUND ) ) );
     }
 
     if( m_loadTotal )
@@ -416,6 +417,15 @@ void SYMBOL_LIBRARY_ADAPTER::AsyncLoad()
 }
 
 
+void SYMBOL_LIBRARY_ADAPTER::ProjectChanged()
+{
+    LIBRARY_MANAGER_ADAPTER::ProjectChanged();
+
+    // Project libraries may shadow global ones, so nothing indexed so far can be trusted
+    m_searchIndex.Clear();
+}
+
+
 std::optional<LIB_STATUS> SYMBOL_LIBRARY_ADAPTER::GetLibraryStatus( const wxString& aNickname ) const
 {
     if( m_libraries.contains( aNickname ) )
@@ -25,6 +25,7 @@
 #include <future>
 #include <lib_id.h>
 #include <libraries/library_manager.h>
+#include <libraries/symbol_search_index.h>
 #include <sch_io/sch_io.h>
 
 class LIB_SYMBOL;
@@ -61,6 +62,8 @@ public:
 
     void AsyncLoad() override;
 
+    void ProjectChanged() override;
+
     /// Loads or reloads the given library, if it exists
     std::optional<LIB_STATUS> LoadOne( LIB_DATA* aLib ) override;
 
@@ -158,6 +161,9 @@ public:
 
     int GetModifyHash() const;
 
+    /// Name index over the loaded libraries; see SYMBOL_SEARCH_INDEX::Synchronize()
+    SYMBOL_SEARCH_INDEX& SearchIndex() { return m_searchIndex; }
+
 protected:
     std::map<wxString, LIB_DATA>& globalLibs() override { return GlobalLibraries; }
     std::map<wxString, LIB_DATA>& globalLibs() const override { return GlobalLibraries; }
@@ -176,6 +182,8 @@ private:
     static std::map<wxString, LIB_DATA> GlobalLibraries;
 
     static std::mutex GlobalLibraryMutex;
+
+    SYMBOL_SEARCH_INDEX m_searchIndex;
 };
 
 #endif //SYMBOL_LIBRARY_MANAGER_ADAPTER_H
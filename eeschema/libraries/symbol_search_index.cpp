@@ -0,0 +1,556 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libraries/symbol_search_index.h>
+
+#include <algorithm>
+#include <set>
+
+#include <kiplatform/io.h>
+#include <lib_symbol.h>
+#include <libraries/library_metadata_cache.h>
+#include <libraries/library_table.h>
+#include <libraries/symbol_library_adapter.h>
+#include <project.h>
+#include <string_utils.h>
+#include <trace_helpers.h>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+#include <wx/textfile.h>
+#include <wx/wfstream.h>
+#include <wx/txtstrm.h>
+
+
+/// Bump whenever the cache file layout or the normalization rules change
+static const long long SYMBOL_SEARCH_CACHE_VERSION = 1;
+
+
+wxString SYMBOL_SEARCH_INDEX::Normalize( const wxString& aName )
+{
+    wxString in = aName.Lower();
+    wxString out;
+    wxString num;
+
+    out.reserve( in.length() );
+
+    auto flushNumber =
+            [&]()
+            {
+                if( num.IsEmpty() )
+                    return;
+
+                // Strip leading zeros but keep a single zero if the number is all zeros.
+                size_t i = 0;
+
+                while( i + 1 < num.length() && num[i] == '0' )
+                    i++;
+
+                out << num.Mid( i );
+                num.Clear();
+            };
+
+    for( wxUniChar c : in )
+    {
+        if( wxIsdigit( c ) )
+        {
+            num << c;
+            continue;
+        }
+
+        flushNumber();
+
+        if( wxIsalnum( c ) )
+            out << c;
+    }
+
+    flushNumber();
+    return out;
+}
+
+
+void SYMBOL_SEARCH_INDEX::buildLibrary( LIBRARY& aLib, const std::vector<wxString>& aNames )
+{
+    aLib.names = aNames;
+    aLib.lower.clear();
+    aLib.norm.clear();
+    aLib.trigrams.clear();
+
+    aLib.lower.reserve( aNames.size() );
+    aLib.norm.reserve( aNames.size() );
+
+    auto addTrigrams =
+            [&]( const wxString& aText, unsigned aIndex )
+            {
+                for( size_t i = 0; i + 3 <= aText.length(); ++i )
+                {
+                    std::vector<unsigned>& postings = aLib.trigrams[aText.Mid( i, 3 )];
+
+                    // Entries are visited in order, so postings stay sorted and unique
+                    if( postings.empty() || postings.back() != aIndex )
+                        postings.push_back( aIndex );
+                }
+            };
+
+    for( unsigned ii = 0; ii < aNames.size(); ++ii )
+    {
+        aLib.lower.push_back( aNames[ii].Lower() );
+        aLib.norm.push_back( Normalize( aNames[ii] ) );
+
+        addTrigrams( aLib.lower.back(), ii );
+        addTrigrams( aLib.norm.back(), ii );
+    }
+}
+
+
+void SYMBOL_SEARCH_INDEX::SetLibrary( const wxString& aNickname, long long aTimestamp,
+                                      const std::vector<wxString>& aNames )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    LIBRARY& lib = m_libraries[aNickname];
+    lib.timestamp = aTimestamp;
+    lib.validated = true;
+    buildLibrary( lib, aNames );
+
+    m_modified = true;
+}
+
+
+void SYMBOL_SEARCH_INDEX::RemoveLibrary( const wxString& aNickname )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    if( m_libraries.erase( aNickname ) )
+        m_modified = true;
+}
+
+
+void SYMBOL_SEARCH_INDEX::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_libraries.clear();
+    m_modified = false;
+}
+
+
+bool SYMBOL_SEARCH_INDEX::HasLibrary( const wxString& aNickname ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_libraries.contains( aNickname );
+}
+
+
+size_t SYMBOL_SEARCH_INDEX::GetSymbolCount() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    size_t count = 0;
+
+    for( const auto& [nickname, lib] : m_libraries )
+        count += lib.names.size();
+
+    return count;
+}
+
+
+long long SYMBOL_SEARCH_INDEX::LibraryTimestamp( const wxString& aPath )
+{
+    if( aPath.IsEmpty() )
+        return 0;
+
+    if( wxFileName::DirExists( aPath ) )
+    {
+        // Directory libraries (.kicad_symdir) store one symbol per file; adding or removing a
+        // file touches the directory but editing one does not, so take the newest of both.
+        long long newest = wxFileName::DirName( aPath ).GetModificationTime().GetValue().GetValue();
+        wxDir     dir( aPath );
+        wxString  filename;
+
+        if( dir.IsOpened() && dir.GetFirst( &filename, wxEmptyString, wxDIR_FILES ) )
+        {
+            do
+            {
+                wxFileName fn( aPath, filename );
+                newest = std::max( newest, fn.GetModificationTime().GetValue().GetValue() );
+            } while( dir.GetNext( &filename ) );
+        }
+
+        return newest;
+    }
+
+    wxFileName fn( aPath );
+
+    if( !fn.FileExists() )
+        return 0;
+
+    return fn.GetModificationTime().GetValue().GetValue();
+}
+
+
+bool SYMBOL_SEARCH_INDEX::Synchronize( SYMBOL_LIBRARY_ADAPTER& aAdapter, const PROJECT& aProject )
+{
+    std::vector<wxString> nicknames = aAdapter.GetLibraryNames();
+    std::set<wxString>    present( nicknames.begin(), nicknames.end() );
+    std::vector<wxString> stale;
+    bool                  changed = false;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        for( auto it = m_libraries.begin(); it != m_libraries.end(); )
+        {
+            if( !present.contains( it->first ) )
+            {
+                it = m_libraries.erase( it );
+                m_modified = true;
+                changed = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    LIBRARY_METADATA_CACHE& cache = aAdapter.Manager().MetadataCache();
+
+    for( const wxString& nickname : nicknames )
+    {
+        long long timestamp = 0;
+        wxString  path;
+
+        if( std::optional<LIBRARY_TABLE_ROW*> row = aAdapter.GetRow( nickname ) )
+        {
+            path = LIBRARY_MANAGER::ExpandURI( ( *row )->URI(), aProject );
+            timestamp = LibraryTimestamp( path );
+        }
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            auto it = m_libraries.find( nickname );
+
+            if( it != m_libraries.end() )
+            {
+                LIBRARY& lib = it->second;
+
+                // Libraries without a file timestamp can only be trusted once they have been
+                // enumerated in this session.
+                if( ( timestamp != 0 && lib.timestamp == timestamp ) || ( timestamp == 0 && lib.validated ) )
+                {
+                    lib.validated = true;
+                    continue;
+                }
+            }
+        }
+
+        long long             stamp = LIBRARY_METADATA_CACHE::LibraryStamp( path );
+        std::vector<wxString> names;
+
+        std::vector<LIBRARY_METADATA_CACHE::ITEM> items;
+
+        // Another project may already have enumerated the library, even in an earlier session
+        if( cache.GetItems( LIBRARY_TABLE_TYPE::SYMBOL, path, stamp, items ) )
+        {
+            wxLogTrace( traceLibraries, "Sym: search index using cached %s", nickname );
+        }
+        else
+        {
+            wxLogTrace( traceLibraries, "Sym: search index refreshing %s", nickname );
+
+            std::optional<LIB_STATUS> status = aAdapter.LoadOne( nickname );
+
+            for( LIB_SYMBOL* symbol : aAdapter.GetSymbols( nickname ) )
+            {
+                items.push_back( { symbol->GetName(), symbol->GetDescription(), symbol->GetKeyWords(),
+                                   (unsigned) symbol->GetPinCount(), 0 } );
+            }
+
+            if( status && status->load_status == LOAD_STATUS::LOADED )
+                cache.SetItems( LIBRARY_TABLE_TYPE::SYMBOL, path, stamp, items );
+        }
+
+        for( const LIBRARY_METADATA_CACHE::ITEM& item : items )
+            names.push_back( item.m_name );
+
+        SetLibrary( nickname, timestamp, names );
+        changed = true;
+    }
+
+    if( changed )
+        cache.Save();
+
+    return changed;
+}
+
+
+void SYMBOL_SEARCH_INDEX::collectCandidates( const LIBRARY& aLib, const wxString& aQuery,
+                                             std::vector<unsigned>& aCandidates )
+{
+    if( aQuery.IsEmpty() )
+        return;
+
+    // Too short to have a trigram; the caller's scoring pass handles every entry.
+    if( aQuery.length() < 3 )
+    {
+        for( unsigned ii = 0; ii < aLib.names.size(); ++ii )
+            aCandidates.push_back( ii );
+
+        return;
+    }
+
+    std::vector<const std::vector<unsigned>*> lists;
+
+    for( size_t i = 0; i + 3 <= aQuery.length(); ++i )
+    {
+        auto it = aLib.trigrams.find( aQuery.Mid( i, 3 ) );
+
+        if( it == aLib.trigrams.end() )
+            return;
+
+        lists.push_back( &it->second );
+    }
+
+    std::sort( lists.begin(), lists.end(),
+               []( const std::vector<unsigned>* a, const std::vector<unsigned>* b )
+               {
+                   return a->size() < b->size();
+               } );
+
+    std::vector<unsigned> result = *lists.front();
+    std::vector<unsigned> scratch;
+
+    for( size_t i = 1; i < lists.size() && !result.empty(); ++i )
+    {
+        scratch.clear();
+        std::set_intersection( result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                               std::back_inserter( scratch ) );
+        result.swap( scratch );
+    }
+
+    aCandidates.insert( aCandidates.end(), result.begin(), result.end() );
+}
+
+
+std::vector<SYMBOL_SEARCH_INDEX::MATCH> SYMBOL_SEARCH_INDEX::Search( const wxString& aQuery,
+                                                                     size_t aLimit ) const
+{
+    std::vector<MATCH> matches;
+
+    wxString query = aQuery;
+    query.Trim( true ).Trim( false );
+
+    if( query.IsEmpty() )
+        return matches;
+
+    wxString qLower = query.Lower();
+    wxString qNorm = Normalize( query );
+    wxString qAfterLower;
+    wxString qAfterNorm;
+
+    if( query.Contains( wxS( ":" ) ) )
+    {
+        wxString after = query.AfterFirst( ':' ).Trim();
+        qAfterLower = after.Lower();
+        qAfterNorm = Normalize( after );
+    }
+
+    auto scoreAgainst =
+            []( const wxString& aLower, const wxString& aNorm, const wxString& q,
+                const wxString& qn ) -> int
+            {
+                int s = 0;
+
+                if( !q.IsEmpty() )
+                {
+                    if( aLower == q )
+                        s = std::max( s, 1000 );
+                    else if( aLower.StartsWith( q ) )
+                        s = std::max( s, 900 );
+                    else if( aLower.Find( q ) != wxNOT_FOUND )
+                        s = std::max( s, 700 );
+                }
+
+                if( !qn.IsEmpty() )
+                {
+                    if( aNorm == qn )
+                        s = std::max( s, 980 );
+                    else if( aNorm.StartsWith( qn ) )
+                        s = std::max( s, 880 );
+                    else if( aNorm.Find( qn ) != wxNOT_FOUND )
+                        s = std::max( s, 680 );
+                }
+
+                return s;
+            };
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    std::vector<unsigned>       candidates;
+
+    for( const auto& [nickname, lib] : m_libraries )
+    {
+        candidates.clear();
+        collectCandidates( lib, qLower, candidates );
+        collectCandidates( lib, qNorm, candidates );
+        collectCandidates( lib, qAfterLower, candidates );
+        collectCandidates( lib, qAfterNorm, candidates );
+
+        std::sort( candidates.begin(), candidates.end() );
+        candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+        for( unsigned ii : candidates )
+        {
+            int score = std::max( scoreAgainst( lib.lower[ii], lib.norm[ii], qLower, qNorm ),
+                                  scoreAgainst( lib.lower[ii], lib.norm[ii], qAfterLower,
+                                                qAfterNorm ) );
+
+            if( score > 0 )
+                matches.push_back( MATCH{ score, nickname, lib.names[ii] } );
+        }
+    }
+
+    auto byRank =
+            []( const MATCH& a, const MATCH& b )
+            {
+                if( a.score != b.score )
+                    return a.score > b.score;
+
+                if( a.library != b.library )
+                    return a.library < b.library;
+
+                return a.name < b.name;
+            };
+
+    if( matches.size() > aLimit )
+    {
+        std::partial_sort( matches.begin(), matches.begin() + aLimit, matches.end(), byRank );
+        matches.resize( aLimit );
+    }
+    else
+    {
+        std::sort( matches.begin(), matches.end(), byRank );
+    }
+
+    return matches;
+}
+
+
+void SYMBOL_SEARCH_INDEX::WriteCacheToFile( const wxString& aFilePath ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    wxFileName          tmpFileName = wxFileName::CreateTempFileName( aFilePath );
+    wxFFileOutputStream outStream( tmpFileName.GetFullPath() );
+    wxTextOutputStream  txtStream( outStream );
+
+    if( !outStream.IsOk() )
+        return;
+
+    txtStream << wxString::Format( wxT( "%lld" ), SYMBOL_SEARCH_CACHE_VERSION ) << endl;
+
+    for( const auto& [nickname, lib] : m_libraries )
+    {
+        // Without a timestamp the entry can never be validated on reload
+        if( lib.timestamp == 0 )
+            continue;
+
+        txtStream << EscapeString( nickname, CTX_LINE ) << endl;
+        txtStream << wxString::Format( wxT( "%lld" ), lib.timestamp ) << endl;
+        txtStream << wxString::Format( wxT( "%zu" ), lib.names.size() ) << endl;
+
+        for( const wxString& name : lib.names )
+            txtStream << EscapeString( name, CTX_LINE ) << endl;
+    }
+
+    txtStream.Flush();
+    outStream.Close();
+
+    KIPLATFORM::IO::DuplicatePermissions( aFilePath, tmpFileName.GetFullPath() );
+
+    if( !wxRenameFile( tmpFileName.GetFullPath(), aFilePath, true ) )
+    {
+        // Not fatal; the index is simply rebuilt next session
+        wxRemoveFile( tmpFileName.GetFullPath() );
+        return;
+    }
+
+    m_modified = false;
+}
+
+
+void SYMBOL_SEARCH_INDEX::ReadCacheFromFile( const wxString& aFilePath )
+{
+    wxTextFile cacheFile( aFilePath );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_libraries.clear();
+    m_modified = false;
+
+    try
+    {
+        if( cacheFile.Exists() && cacheFile.Open() )
+        {
+            long long version = 0;
+
+            if( !cacheFile.GetFirstLine().ToLongLong( &version )
+                || version != SYMBOL_SEARCH_CACHE_VERSION )
+            {
+                return;
+            }
+
+            while( cacheFile.GetCurrentLine() + 3 < cacheFile.GetLineCount() )
+            {
+                wxString      nickname = UnescapeString( cacheFile.GetNextLine() );
+                long long     timestamp = 0;
+                unsigned long count = 0;
+
+                if( !cacheFile.GetNextLine().ToLongLong( &timestamp )
+                    || !cacheFile.GetNextLine().ToULong( &count )
+                    || cacheFile.GetCurrentLine() + count >= cacheFile.GetLineCount() )
+                {
+                    m_libraries.clear();
+                    break;
+                }
+
+                std::vector<wxString> names;
+                names.reserve( count );
+
+                for( unsigned long ii = 0; ii < count; ++ii )
+                    names.push_back( UnescapeString( cacheFile.GetNextLine() ) );
+
+                LIBRARY& lib = m_libraries[nickname];
+                lib.timestamp = timestamp;
+                lib.validated = false;
+                buildLibrary( lib, names );
+            }
+        }
+    }
+    catch( ... )
+    {
+        // whatever went wrong, invalidate the cache
+        m_libraries.clear();
+    }
+
+    if( cacheFile.IsOpened() )
+        cacheFile.Close();
+}
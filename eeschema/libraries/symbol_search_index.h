@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOL_SEARCH_INDEX_H
+#define SYMBOL_SEARCH_INDEX_H
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <wx/string.h>
+#include <core/wx_stl_compat.h>
+
+class PROJECT;
+class SYMBOL_LIBRARY_ADAPTER;
+
+
+/**
+ * A name index over the symbols of every loaded symbol library.
+ *
+ * Each library keeps its symbol names in lowercase and normalized form together with
+ * trigram postings, so a query only scores the names that can possibly contain it.  Libraries
+ * are re-enumerated only when their file timestamp changes, and the index can be written to
+ * and restored from a cache file so a new session does not have to touch the library files.
+ */
+class SYMBOL_SEARCH_INDEX
+{
+public:
+    struct MATCH
+    {
+        int      score = 0;
+        wxString library;
+        wxString name;
+    };
+
+    SYMBOL_SEARCH_INDEX() = default;
+
+    /**
+     * Lowercase \a aName, strip anything that is not alphanumeric and strip leading zeros
+     * from numeric runs (so "LM-0358" and "lm358" normalize identically).
+     */
+    static wxString Normalize( const wxString& aName );
+
+    /**
+     * Replace the indexed content of a library.
+     *
+     * @param aTimestamp is the modification time of the library source, or 0 if the library
+     *                   has no file backing (database/http libraries).
+     */
+    void SetLibrary( const wxString& aNickname, long long aTimestamp,
+                     const std::vector<wxString>& aNames );
+
+    void RemoveLibrary( const wxString& aNickname );
+
+    void Clear();
+
+    bool HasLibrary( const wxString& aNickname ) const;
+
+    size_t GetSymbolCount() const;
+
+    /**
+     * Bring the index up to date with the libraries currently loaded by \a aAdapter.
+     *
+     * Only libraries that are new or whose source timestamp changed are enumerated.
+     *
+     * @return true if the index content changed.
+     */
+    bool Synchronize( SYMBOL_LIBRARY_ADAPTER& aAdapter, const PROJECT& aProject );
+
+    /**
+     * Return up to \a aLimit matches ordered by descending score, then library, then name.
+     *
+     * A query of the form "lib:name" is matched both as a whole and by its name part.
+     */
+    std::vector<MATCH> Search( const wxString& aQuery, size_t aLimit ) const;
+
+    void WriteCacheToFile( const wxString& aFilePath ) const;
+
+    void ReadCacheFromFile( const wxString& aFilePath );
+
+    /// True if the content changed since the cache was last read or written.
+    bool IsModified() const { return m_modified; }
+
+    /// Return the modification time of a library file or directory, or 0 if unavailable.
+    static long long LibraryTimestamp( const wxString& aPath );
+
+private:
+    struct LIBRARY
+    {
+        long long             timestamp = 0;
+        bool                  validated = false;    ///< Checked against its source this session
+        std::vector<wxString> names;
+        std::vector<wxString> lower;
+        std::vector<wxString> norm;
+
+        /// Trigram -> ascending indices into names, built from both lower and norm forms
+        std::unordered_map<wxString, std::vector<unsigned>> trigrams;
+    };
+
+    static void buildLibrary( LIBRARY& aLib, const std::vector<wxString>& aNames );
+
+    static void collectCandidates( const LIBRARY& aLib, const wxString& aQuery,
+                                   std::vector<unsigned>& aCandidates );
+
+private:
+    mutable std::mutex          m_mutex;
+    std::map<wxString, LIBRARY> m_libraries;
+    mutable bool                m_modified = false;
+};
+
+#endif // SYMBOL_SEARCH_INDEX_H
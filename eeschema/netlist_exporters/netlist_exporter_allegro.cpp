@@ -142,7 +142,7 @@ void NETLIST_EXPORTER_ALLEGRO::extractComponentsInfo()
     m_referencesAlreadyFound.Clear();
     m_libParts.clear();
 
-    for( const SCH_SHEET_PATH& sheet : m_schematic->Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *m_schematic->HierarchySnapshot() )
     {
         m_schematic->SetCurrentSheet( sheet );
 
@@ -69,7 +69,7 @@ bool NETLIST_EXPORTER_CADSTAR::WriteNetlist( const wxString& aOutFileName,
         // Create netlist footprints section
         m_referencesAlreadyFound.Clear();
 
-        for( const SCH_SHEET_PATH& sheet : m_schematic->Hierarchy() )
+        for( const SCH_SHEET_PATH& sheet : *m_schematic->HierarchySnapshot() )
         {
             // The rtree returns items in a non-deterministic order (platform-dependent)
             // Therefore we need to sort them before outputting to ensure file stability for version
@@ -54,7 +54,61 @@ bool NETLIST_EXPORTER_KICAD::WriteNetlist( const wxString& aOutFileName, unsigne
 
 void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
 {
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // This writes the same text as XNODE::Format() of the tree built by makeRoot(), but each
+    // section is freed once written, and components and nets are written one at a time, so
+    // the whole tree is never held in memory.
+    auto writeNode =
+            [&]( XNODE* aNode )
+            {
+                std::unique_ptr<XNODE> owner( aNode );
 
-    xroot->Format( aOut );
+                aOut->Print( 0, "\n" );
+                aNode->Format( aOut );
+            };
+
+    auto writeList =
+            [&]( const char* aName,
+                 const std::function<void( const std::function<void( XNODE* )>& )>& aVisit )
+            {
+                aOut->Print( 0, "\n(%s", aName );
+                aVisit( writeNode );
+                aOut->Print( 0, ")" );
+            };
+
+    aOut->Print( "(export (version %s)", aOut->Quotew( wxT( "E" ) ).c_str() );
+
+    if( aCtl & GNL_HEADER )
+        writeNode( makeDesignHeader() );
+
+    if( aCtl & GNL_SYMBOLS )
+    {
+        writeList( "components",
+                   [&]( const std::function<void( XNODE* )>& aVisitor )
+                   {
+                       visitSymbols( aCtl, aVisitor );
+                   } );
+
+        if( aCtl & GNL_OPT_KICAD )
+        {
+            writeNode( makeGroups() );
+            writeNode( makeVariants() );
+        }
+    }
+
+    if( aCtl & GNL_PARTS )
+        writeNode( makeLibParts() );
+
+    if( aCtl & GNL_LIBRARIES )
+        writeNode( makeLibraries() );
+
+    if( aCtl & GNL_NETS )
+    {
+        writeList( "nets",
+                   [&]( const std::function<void( XNODE* )>& aVisitor )
+                   {
+                       visitNets( aCtl, aVisitor );
+                   } );
+    }
+
+    aOut->Print( 0, ")" );
 }
@@ -447,7 +447,7 @@ wxString NETLIST_EXPORTER_SPICE::collectMergedSimPins( SCH_SYMBOL& aSymbol,
         parsePins( pinsField->GetShownText( &aSheet, false ) );
 
     // Then, find all other units with the same reference and collect their Sim.Pins
-    for( const SCH_SHEET_PATH& sheet : m_schematic->Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *m_schematic->HierarchySnapshot() )
     {
         for( SCH_ITEM* item : sheet.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
         {
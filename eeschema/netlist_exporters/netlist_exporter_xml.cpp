@@ -255,6 +255,19 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
 {
     XNODE* xcomps = node( wxT( "components" ) );
 
+    visitSymbols( aCtl,
+                  [&]( XNODE* aComp )
+                  {
+                      xcomps->AddChild( aComp );
+                  } );
+
+    return xcomps;
+}
+
+
+void NETLIST_EXPORTER_XML::visitSymbols( unsigned aCtl,
+                                         const std::function<void( XNODE* )>& aVisitor )
+{
     m_referencesAlreadyFound.Clear();
     m_libParts.clear();
     getSheetComponentClasses();
@@ -320,8 +333,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // not always look best, but it will allow faster execution under XSL processing
             // systems which do sequential searching within an element.
 
-            XNODE* xcomp;  // current symbol being constructed
-            xcomps->AddChild( xcomp = node( wxT( "comp" ) ) );
+            XNODE* xcomp = node( wxT( "comp" ) );  // current symbol being constructed
 
             xcomp->AddAttribute( wxT( "ref" ), symbol->GetRef( &sheet ) );
             addSymbolFields( xcomp, symbol, sheet, sheetList );
@@ -622,12 +634,12 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
                     }
                 }
             }
+
+            aVisitor( xcomp );
         }
     }
 
     m_schematic->SetCurrentSheet( currentSheet );
-
-    return xcomps;
 }
 
 
@@ -794,7 +806,7 @@ XNODE* NETLIST_EXPORTER_XML::makeDesignHeader()
      */
     unsigned sheetIndex = 1;     // Human readable index
 
-    for( const SCH_SHEET_PATH& sheet : m_schematic->Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *m_schematic->HierarchySnapshot() )
     {
         screen = sheet.LastScreen();
 
@@ -1022,9 +1034,22 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
 
 
 XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
+{
+    XNODE* xnets = node( wxT( "nets" ) ); // auto_ptr if exceptions ever get used.
+
+    visitNets( aCtl,
+               [&]( XNODE* aNet )
+               {
+                   xnets->AddChild( aNet );
+               } );
+
+    return xnets;
+}
+
+
+void NETLIST_EXPORTER_XML::visitNets( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor )
 {
     wxString netCodeTxt;
-    XNODE*   xnets = node( wxT( "nets" ) ); // auto_ptr if exceptions ever get used.
     XNODE*   xnet = nullptr;
 
     /*  output:
@@ -1182,7 +1207,7 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
             {
                 netCodeTxt.Printf( wxT( "%d" ), i + 1 );
 
-                xnets->AddChild( xnet = node( wxT( "net" ) ) );
+                xnet = node( wxT( "net" ) );
                 xnet->AddAttribute( wxT( "code" ), netCodeTxt );
                 xnet->AddAttribute( wxT( "name" ), net_record->m_Name );
                 xnet->AddAttribute( wxT( "class" ), net_record->m_Class );
@@ -1224,12 +1249,13 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
                 xnode->AddAttribute( wxT( "pintype" ), typeAttr );
             }
         }
+
+        if( added )
+            aVisitor( xnet );
     }
 
     for( NET_RECORD* record : nets )
         delete record;
-
-    return xnets;
 }
 
 
@@ -26,6 +26,8 @@
 #ifndef NETLIST_EXPORT_XML_H
 #define NETLIST_EXPORT_XML_H
 
+#include <functional>
+
 #include <netlist_exporter_base.h>
 
 #include <project.h>
@@ -104,6 +106,12 @@ protected:
      */
     XNODE* makeSymbols( unsigned aCtl );
 
+    /**
+     * Build the node of each schematic symbol in output order and pass it to \a aVisitor,
+     * which takes ownership of it.
+     */
+    void visitSymbols( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor );
+
     /**
      * @return a sub-tree holding all the schematic groups.
      */
@@ -132,6 +140,12 @@ protected:
      */
     XNODE* makeListOfNets( unsigned aCtl );
 
+    /**
+     * Build the node of each net in output order and pass it to \a aVisitor, which takes
+     * ownership of it.
+     */
+    void visitNets( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor );
+
     /**
      * Fill out an XML node with a list of used libraries and returns it.
      * Must have called makeGenericLibParts() before this function.
@@ -132,8 +132,13 @@ int REFDES_TRACKER::GetNextRefDesForUnits( const SCH_REFERENCE& aRef,
             // Currently in use - check if required units are available
             if( validUnits.empty() )
             {
-                // Need completely unused reference, but this one is in use
-                candidate++;
+                // Need completely unused reference, so skip the whole run of numbers in use
+                while( mapIt != aRefNumberMap.end() && mapIt->first == candidate )
+                {
+                    ++mapIt;
+                    candidate++;
+                }
+
                 continue;
             }
 
@@ -335,6 +335,9 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
             // Expected request:
             //   {"command":"GET_SCHEMATIC_CONTEXT","message_id":1,"parameters":{"max_chars":50000}}
             //
+            // Pass "delta":true in the parameters to receive only the sheets and nets that
+            // changed since the previous GET_SCHEMATIC_CONTEXT.
+            //
             // Response:
             //   {"command":"GET_SCHEMATIC_CONTEXT","response_to":1,"status":"OK","data":"..."}
             m_ollamaAgentPane->AddMessageHandler( wxS( "kicad" ),
@@ -348,6 +351,18 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
                             return s;
                         };
 
+                        auto postResponse =
+                                [this, sanitizeForScript]( const json& aResponse )
+                                {
+                                    if( !m_ollamaAgentPane || m_ollamaAgentPane->HasLoadError() )
+                                        return;
+
+                                    wxString script = wxString::Format(
+                                            wxS( "window.kiclient && window.kiclient.postMessage('%s');" ),
+                                            sanitizeForScript( aResponse.dump() ) );
+                                    m_ollamaAgentPane->RunScriptAsync( script );
+                                };
+
                         wxScopedCharBuffer utf8 = aPayload.ToUTF8();
                         if( !utf8 || utf8.length() == 0 )
                             return;
@@ -377,25 +392,58 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
 
                         if( command == "GET_SCHEMATIC_CONTEXT" )
                         {
-                            size_t maxChars = 50000;
+                            size_t   maxChars = 50000;
+                            bool     delta = false;
+                            wxString userRequest;
 
                             if( request.contains( "parameters" ) && request["parameters"].is_object() )
                             {
                                 const json& params = request["parameters"];
                                 if( params.contains( "max_chars" ) && params["max_chars"].is_number_integer() )
                                     maxChars = static_cast<size_t>( params["max_chars"].get<long long>() );
+
+                                if( params.contains( "delta" ) && params["delta"].is_boolean() )
+                                    delta = params["delta"].get<bool>();
+
+                                if( params.contains( "request" ) && params["request"].is_string() )
+                                    userRequest = wxString::FromUTF8( params["request"].get<std::string>() );
                             }
 
                             wxString context;
                             if( m_toolManager )
                             {
                                 if( SCH_OLLAMA_AGENT_TOOL* tool = m_toolManager->GetTool<SCH_OLLAMA_AGENT_TOOL>() )
-                                    context = tool->GetFullSchematicContext( maxChars );
+                                {
+                                    if( delta )
+                                        context = tool->GetSchematicContextDelta( maxChars );
+                                    else if( !userRequest.IsEmpty() )
+                                        context = tool->GetRankedSchematicContext( userRequest, maxChars );
+                                    else
+                                        context = tool->GetFullSchematicContext( maxChars );
+                                }
                             }
 
                             response["status"] = "OK";
                             response["data"] = context.ToUTF8().data();
                         }
+                        else if( command == "GET_AGENT_PROFILE" )
+                        {
+                            // Timing breakdown of the last agent turn
+                            SCH_OLLAMA_AGENT_TOOL* tool =
+                                    m_toolManager ? m_toolManager->GetTool<SCH_OLLAMA_AGENT_TOOL>()
+                                                  : nullptr;
+
+                            if( tool )
+                            {
+                                response["status"] = "OK";
+                                response["data"] = json::parse( tool->Profile().ToJson().ToStdString() );
+                            }
+                            else
+                            {
+                                response["status"] = "ERROR";
+                                response["error_message"] = "Agent tool is not available";
+                            }
+                        }
                         else if( command == "GET_PROJECT_PATH" )
                         {
                             wxString projectPath;
@@ -560,6 +608,30 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
                                 response["status"] = "ERROR";
                                 response["error_message"] = "Tool manager not available";
                             }
+                            else if( SCH_OLLAMA_AGENT_TOOL::IsBackgroundTool( wxString::FromUTF8( toolName.c_str() ) )
+                                     && m_toolManager->GetTool<SCH_OLLAMA_AGENT_TOOL>() )
+                            {
+                                // Library lookups can take a while; answer once the worker is done
+                                // instead of blocking the editor.
+                                m_toolManager->GetTool<SCH_OLLAMA_AGENT_TOOL>()->RunToolCommandAsync(
+                                        wxString::FromUTF8( toolName.c_str() ),
+                                        wxString::FromUTF8( payloadStr.c_str() ),
+                                        [postResponse, response]( bool aOk, const wxString& aResult,
+                                                                  const wxString& aError ) mutable
+                                        {
+                                            response["status"] = aOk ? "OK" : "ERROR";
+
+                                            if( aOk && !aResult.IsEmpty() )
+                                                response["data"] = aResult.ToUTF8().data();
+                                            else if( !aOk )
+                                                response["error_message"] = aError.IsEmpty() ? std::string( "Tool execution failed" )
+                                                                                             : std::string( aError.ToUTF8().data() );
+
+                                            postResponse( response );
+                                        } );
+
+                                return;
+                            }
                             else
                             {
                                 bool ok = false;
@@ -588,6 +660,83 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
                                     response["error_message"] = "Tool execution failed";
                             }
                         }
+                        else if( command == "RUN_TOOL_BATCH" )
+                        {
+                            // Runs every command as one undoable change; nothing is applied if any fails.
+                            //   "parameters":{"commands":[{"tool_name":"...","payload":{...}}, ...],
+                            //                 "description":"..."}
+                            std::vector<std::pair<wxString, wxString>> commands;
+                            wxString description = _( "Agent plan" );
+                            bool     valid = false;
+
+                            if( request.contains( "parameters" ) && request["parameters"].is_object() )
+                            {
+                                const json& params = request["parameters"];
+
+                                if( params.contains( "description" ) && params["description"].is_string() )
+                                    description = wxString::FromUTF8( params["description"].get<std::string>().c_str() );
+
+                                if( params.contains( "commands" ) && params["commands"].is_array() )
+                                {
+                                    valid = true;
+
+                                    for( const json& cmd : params["commands"] )
+                                    {
+                                        if( !cmd.is_object() || !cmd.contains( "tool_name" )
+                                            || !cmd["tool_name"].is_string() )
+                                        {
+                                            valid = false;
+                                            break;
+                                        }
+
+                                        std::string payloadStr;
+
+                                        if( cmd.contains( "payload" ) )
+                                        {
+                                            if( cmd["payload"].is_string() )
+                                                payloadStr = cmd["payload"].get<std::string>();
+                                            else if( cmd["payload"].is_object() )
+                                                payloadStr = cmd["payload"].dump();
+                                        }
+
+                                        commands.emplace_back( wxString::FromUTF8( cmd["tool_name"].get<std::string>().c_str() ),
+                                                               wxString::FromUTF8( payloadStr.c_str() ) );
+                                    }
+                                }
+                            }
+
+                            SCH_OLLAMA_AGENT_TOOL* tool = m_toolManager ? m_toolManager->GetTool<SCH_OLLAMA_AGENT_TOOL>()
+                                                                        : nullptr;
+
+                            if( !valid )
+                            {
+                                response["status"] = "ERROR";
+                                response["error_message"] = "parameters.commands must be an array of {tool_name, payload}";
+                            }
+                            else if( !tool )
+                            {
+                                response["status"] = "ERROR";
+                                response["error_message"] = "Tool manager not available";
+                            }
+                            else if( tool->RunToolBatch( commands, description ) )
+                            {
+                                response["status"] = "OK";
+
+                                try
+                                {
+                                    response["data"] = json::parse( tool->GetLastToolResult().ToUTF8().data() );
+                                }
+                                catch( const std::exception& )
+                                {
+                                    response["data"] = tool->GetLastToolResult().ToUTF8().data();
+                                }
+                            }
+                            else
+                            {
+                                response["status"] = "ERROR";
+                                response["error_message"] = tool->GetLastToolError().ToUTF8().data();
+                            }
+                        }
                         else if( command == "REPLACE_SCHEMATIC" )
                         {
                             wxString filePath;
@@ -713,13 +862,7 @@ SCH_EDIT_FRAME::SCH_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
                             response["error_message"] = "Unknown command";
                         }
 
-                        if( !m_ollamaAgentPane || m_ollamaAgentPane->HasLoadError() )
-                            return;
-
-                        wxString script = wxString::Format(
-                                wxS( "window.kiclient && window.kiclient.postMessage('%s');" ),
-                                sanitizeForScript( response.dump() ) );
-                        m_ollamaAgentPane->RunScriptAsync( script );
+                        postResponse( response );
                     } );
 
             // Script message handlers are registered on load; ensure loaded is bound.
@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sch_free_slot_finder.h>
+
+#include <cstdlib>
+
+
+SCH_FREE_SLOT_FINDER::SCH_FREE_SLOT_FINDER( const EE_RTREE& aItems,
+                                            std::vector<KICAD_T> aObstacleTypes, int aMargin ) :
+        m_items( aItems ),
+        m_types( std::move( aObstacleTypes ) ),
+        m_margin( aMargin ),
+        m_ignored( nullptr )
+{
+}
+
+
+const BOX2I& SCH_FREE_SLOT_FINDER::obstacleBox( const SCH_ITEM* aItem ) const
+{
+    auto it = m_boxCache.find( aItem );
+
+    if( it == m_boxCache.end() )
+    {
+        BOX2I bbox = aItem->GetBoundingBox();
+        bbox.Inflate( m_margin );
+        it = m_boxCache.emplace( aItem, bbox ).first;
+    }
+
+    return it->second;
+}
+
+
+bool SCH_FREE_SLOT_FINDER::IsFree( const BOX2I& aBox ) const
+{
+    BOX2I test = aBox;
+    test.Inflate( m_margin );
+
+    // Tree entries hold the raw bounding box (plus pen width), so widen the query by the
+    // obstacle margin to catch everything whose inflated box could intersect.
+    BOX2I query = test;
+    query.Inflate( m_margin );
+
+    for( KICAD_T type : m_types )
+    {
+        for( SCH_ITEM* item : m_items.Overlapping( type, query ) )
+        {
+            if( item == m_ignored )
+                continue;
+
+            if( test.Intersects( obstacleBox( item ) ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::optional<VECTOR2I> SCH_FREE_SLOT_FINDER::FindNearest( const BOX2I& aBox, int aStep,
+                                                           int aMaxRings ) const
+{
+    if( IsFree( aBox ) )
+        return VECTOR2I( 0, 0 );
+
+    for( int r = 1; r <= aMaxRings; ++r )
+    {
+        for( int dx = -r; dx <= r; ++dx )
+        {
+            for( int dy = -r; dy <= r; ++dy )
+            {
+                // Only check the perimeter of this square "ring"
+                if( std::abs( dx ) != r && std::abs( dy ) != r )
+                    continue;
+
+                VECTOR2I offset( dx * aStep, dy * aStep );
+                BOX2I    candidate = aBox;
+                candidate.Move( offset );
+
+                if( IsFree( candidate ) )
+                    return offset;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
@@ -0,0 +1,76 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_FREE_SLOT_FINDER_H
+#define SCH_FREE_SLOT_FINDER_H
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <math/box2.h>
+#include <math/vector2d.h>
+#include <sch_rtree.h>
+
+
+/**
+ * Answer "where is the nearest place this box fits" queries against the items of a screen.
+ *
+ * Candidate positions are tested with range queries on the screen's #EE_RTREE, so each test
+ * only looks at the handful of items near the candidate instead of every item on the sheet.
+ * Bounding boxes of obstacles are computed once per finder and reused across candidates.
+ */
+class SCH_FREE_SLOT_FINDER
+{
+public:
+    /**
+     * @param aItems is the item tree to place into (usually SCH_SCREEN::Items()).
+     * @param aObstacleTypes are the item types that must not be overlapped.
+     * @param aMargin is the clearance kept around both the placed box and every obstacle.
+     */
+    SCH_FREE_SLOT_FINDER( const EE_RTREE& aItems, std::vector<KICAD_T> aObstacleTypes,
+                          int aMargin );
+
+    /// Exclude an item from the obstacles, e.g. the item being placed if already on the screen.
+    void IgnoreItem( const SCH_ITEM* aItem ) { m_ignored = aItem; }
+
+    /// Return true if \a aBox (plus margin) does not touch any obstacle (plus margin).
+    bool IsFree( const BOX2I& aBox ) const;
+
+    /**
+     * Search outward from \a aBox, ring by ring on a grid of \a aStep, for the nearest offset
+     * at which the box is free.
+     *
+     * @param aMaxRings is the number of grid rings to search around the starting position.
+     * @return the offset to apply to the box, or nullopt if no free slot was found.
+     */
+    std::optional<VECTOR2I> FindNearest( const BOX2I& aBox, int aStep, int aMaxRings ) const;
+
+private:
+    const BOX2I& obstacleBox( const SCH_ITEM* aItem ) const;
+
+    const EE_RTREE&      m_items;
+    std::vector<KICAD_T> m_types;
+    int                  m_margin;
+    const SCH_ITEM*      m_ignored;
+
+    mutable std::unordered_map<const SCH_ITEM*, BOX2I> m_boxCache;
+};
+
+#endif // SCH_FREE_SLOT_FINDER_H
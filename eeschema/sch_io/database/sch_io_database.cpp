@@ -32,6 +32,7 @@
 #include <fmt.h>
 #include <ki_exception.h>
 #include <lib_symbol.h>
+#include <thread_pool.h>
 
 #include "sch_io_database.h"
 
@@ -46,11 +47,15 @@ SCH_IO_DATABASE::SCH_IO_DATABASE() :
 {
     m_cacheTimestamp = 0;
     m_cacheModifyHash = 0;
+    m_refreshTimestamp = 0;
+    m_refreshModifyHash = 0;
 }
 
 
 SCH_IO_DATABASE::~SCH_IO_DATABASE()
 {
+    if( m_refresh.valid() )
+        m_refresh.wait();
 }
 
 
@@ -133,6 +138,12 @@ LIB_SYMBOL* SCH_IO_DATABASE::LoadSymbol( const wxString&   aLibraryPath,
         }
     }
 
+    // Served from the library cache when possible: no round trip to the database
+    auto cacheIt = m_nameToSymbolcache.find( aAliasName );
+
+    if( cacheIt != m_nameToSymbolcache.end() )
+        return cacheIt->second->Duplicate();
+
     std::vector<const DATABASE_LIB_TABLE*> tablesToTry;
 
     for( const DATABASE_LIB_TABLE& tableIter : m_settings->m_Tables )
@@ -223,25 +234,63 @@ void SCH_IO_DATABASE::cacheLib()
 {
     long long currentTimestampSeconds = wxDateTime::Now().GetValue().GetValue() / 1000;
 
-    if( m_adapter->GetModifyHash() == m_cacheModifyHash
+    if( m_refresh.valid()
+            && m_refresh.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready )
+    {
+        std::optional<LIB_CONTENTS> contents = m_refresh.get();
+
+        // Dropped if the libraries changed while it was running
+        if( contents && m_refreshModifyHash == m_cacheModifyHash )
+        {
+            m_nameToSymbolcache = std::move( contents->m_Symbols );
+            m_sanitizedNameMap = std::move( contents->m_SanitizedNames );
+            m_cacheTimestamp = m_refreshTimestamp;
+        }
+    }
+
+    bool librariesChanged = m_adapter->GetModifyHash() != m_cacheModifyHash;
+
+    if( !librariesChanged
         && ( currentTimestampSeconds - m_cacheTimestamp ) < m_settings->m_Cache.max_age )
     {
         return;
     }
 
-    std::map<wxString, std::unique_ptr<LIB_SYMBOL>> newSymbolCache;
-    std::map<wxString, std::pair<std::string, std::string>> newSanitizedNameMap;
+    // Expired contents are still good enough to browse while the tables are read again, which
+    // can take a while for large tables on a remote server.  If the libraries the database
+    // symbols are built from changed, the contents must be rebuilt right away.
+    if( !librariesChanged && !m_nameToSymbolcache.empty() )
+    {
+        if( !m_refresh.valid() )
+            startRefresh( currentTimestampSeconds );
+
+        return;
+    }
+
+    LIB_CONTENTS contents = readTables( *m_conn );
+
+    m_nameToSymbolcache = std::move( contents.m_Symbols );
+    m_sanitizedNameMap = std::move( contents.m_SanitizedNames );
+
+    m_cacheTimestamp = currentTimestampSeconds;
+    m_cacheModifyHash = m_adapter->GetModifyHash();
+}
+
+
+SCH_IO_DATABASE::LIB_CONTENTS SCH_IO_DATABASE::readTables( DATABASE_CONNECTION& aConn )
+{
+    LIB_CONTENTS contents;
 
     for( const DATABASE_LIB_TABLE& table : m_settings->m_Tables )
     {
         std::vector<DATABASE_CONNECTION::ROW> results;
 
-        if( !m_conn->SelectAll( table.table, table.key_col, results ) )
+        if( !aConn.SelectAll( table.table, table.key_col, results ) )
         {
-            if( !m_conn->GetLastError().empty() )
+            if( !aConn.GetLastError().empty() )
             {
                 wxString msg = wxString::Format( _( "Error reading database table %s: %s" ),
-                                                 table.table, m_conn->GetLastError() );
+                                                 table.table, aConn.GetLastError() );
                 THROW_IO_ERROR( msg );
             }
 
@@ -261,20 +310,47 @@ void SCH_IO_DATABASE::cacheLib()
             std::string sanitizedDisplayName = fmt::format( "{}{}", prefix, sanitizedKey );
             wxString    name( sanitizedDisplayName );
 
-            newSanitizedNameMap[name] = std::make_pair( table.name, rawName );
+            contents.m_SanitizedNames[name] = std::make_pair( table.name, rawName );
 
             std::unique_ptr<LIB_SYMBOL> symbol = loadSymbolFromRow( name, table, result );
 
             if( symbol )
-                newSymbolCache[symbol->GetName()] = std::move( symbol );
+                contents.m_Symbols[symbol->GetName()] = std::move( symbol );
         }
     }
 
-    m_nameToSymbolcache = std::move( newSymbolCache );
-    m_sanitizedNameMap = std::move( newSanitizedNameMap );
+    return contents;
+}
 
-    m_cacheTimestamp = currentTimestampSeconds;
-    m_cacheModifyHash = m_adapter->GetModifyHash();
+
+void SCH_IO_DATABASE::startRefresh( long long aTimestamp )
+{
+    m_refreshTimestamp = aTimestamp;
+    m_refreshModifyHash = m_cacheModifyHash;
+
+    m_refresh = GetKiCadThreadPool().submit_task(
+            [this]() -> std::optional<LIB_CONTENTS>
+            {
+                if( !m_refreshConn || !m_refreshConn->IsConnected() )
+                    m_refreshConn = createConnection();
+
+                if( !m_refreshConn->IsConnected() )
+                {
+                    wxLogTrace( traceDatabase, wxT( "startRefresh: could not connect: %s" ),
+                                m_refreshConn->GetLastError() );
+                    return std::nullopt;
+                }
+
+                try
+                {
+                    return readTables( *m_refreshConn );
+                }
+                catch( const IO_ERROR& e )
+                {
+                    wxLogTrace( traceDatabase, wxT( "startRefresh: %s" ), e.What() );
+                    return std::nullopt;
+                }
+            } );
 }
 
 void SCH_IO_DATABASE::ensureSettings( const wxString& aSettingsPath )
@@ -343,55 +419,67 @@ void SCH_IO_DATABASE::connect()
 
     if( !m_conn )
     {
-        if( m_settings->m_Source.connection_string.empty() )
-        {
-            m_conn = std::make_unique<DATABASE_CONNECTION>( m_settings->m_Source.dsn,
-                                                            m_settings->m_Source.username,
-                                                            m_settings->m_Source.password,
-                                                            m_settings->m_Source.timeout );
-        }
-        else
-        {
-            std::string cs = m_settings->m_Source.connection_string;
-            std::string basePath( wxFileName( m_settings->GetFilename() ).GetPath().ToUTF8() );
-
-            // Database drivers that use files operate on absolute paths, so provide a mechanism
-            // for specifying on-disk databases that live next to the kicad_dbl file
-            boost::replace_all( cs, "${CWD}", basePath );
-
-            m_conn = std::make_unique<DATABASE_CONNECTION>( cs, m_settings->m_Source.timeout );
-        }
+        m_conn = createConnection();
 
         if( !m_conn->IsConnected() )
         {
             m_lastError = m_conn->GetLastError();
             m_conn.reset();
-            return;
         }
+    }
+}
 
-        for( const DATABASE_LIB_TABLE& tableIter : m_settings->m_Tables )
-        {
-            std::set<std::string> columns;
 
-            columns.insert( boost::to_lower_copy( tableIter.key_col ) );
-            columns.insert( boost::to_lower_copy( tableIter.footprints_col ) );
-            columns.insert( boost::to_lower_copy( tableIter.symbols_col ) );
+std::unique_ptr<DATABASE_CONNECTION> SCH_IO_DATABASE::createConnection()
+{
+    std::unique_ptr<DATABASE_CONNECTION> conn;
 
-            columns.insert( boost::to_lower_copy( tableIter.properties.description ) );
-            columns.insert( boost::to_lower_copy( tableIter.properties.footprint_filters ) );
-            columns.insert( boost::to_lower_copy( tableIter.properties.keywords ) );
-            columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_sim ) );
-            columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_bom ) );
-            columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_board ) );
+    if( m_settings->m_Source.connection_string.empty() )
+    {
+        conn = std::make_unique<DATABASE_CONNECTION>( m_settings->m_Source.dsn,
+                                                      m_settings->m_Source.username,
+                                                      m_settings->m_Source.password,
+                                                      m_settings->m_Source.timeout );
+    }
+    else
+    {
+        std::string cs = m_settings->m_Source.connection_string;
+        std::string basePath( wxFileName( m_settings->GetFilename() ).GetPath().ToUTF8() );
 
-            for( const DATABASE_FIELD_MAPPING& field : tableIter.fields )
-                columns.insert( boost::to_lower_copy( field.column ) );
+        // Database drivers that use files operate on absolute paths, so provide a mechanism
+        // for specifying on-disk databases that live next to the kicad_dbl file
+        boost::replace_all( cs, "${CWD}", basePath );
 
-            m_conn->CacheTableInfo( tableIter.table, columns );
-        }
+        conn = std::make_unique<DATABASE_CONNECTION>( cs, m_settings->m_Source.timeout );
+    }
 
-        m_conn->SetCacheParams( m_settings->m_Cache.max_size, m_settings->m_Cache.max_age );
+    if( !conn->IsConnected() )
+        return conn;
+
+    for( const DATABASE_LIB_TABLE& tableIter : m_settings->m_Tables )
+    {
+        std::set<std::string> columns;
+
+        columns.insert( boost::to_lower_copy( tableIter.key_col ) );
+        columns.insert( boost::to_lower_copy( tableIter.footprints_col ) );
+        columns.insert( boost::to_lower_copy( tableIter.symbols_col ) );
+
+        columns.insert( boost::to_lower_copy( tableIter.properties.description ) );
+        columns.insert( boost::to_lower_copy( tableIter.properties.footprint_filters ) );
+        columns.insert( boost::to_lower_copy( tableIter.properties.keywords ) );
+        columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_sim ) );
+        columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_bom ) );
+        columns.insert( boost::to_lower_copy( tableIter.properties.exclude_from_board ) );
+
+        for( const DATABASE_FIELD_MAPPING& field : tableIter.fields )
+            columns.insert( boost::to_lower_copy( field.column ) );
+
+        conn->CacheTableInfo( tableIter.table, columns );
     }
+
+    conn->SetCacheParams( m_settings->m_Cache.max_size, m_settings->m_Cache.max_age );
+
+    return conn;
 }
 
 
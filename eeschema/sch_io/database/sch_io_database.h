@@ -25,6 +25,7 @@
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
 #include <wildcards_and_files_ext.h>
+#include <future>
 #include <optional>
 
 
@@ -91,14 +92,37 @@ public:
     bool TestConnection( wxString* aErrorMsg = nullptr );
 
 private:
+    /// Symbols built from the database tables, by display name
+    struct LIB_CONTENTS
+    {
+        std::map<wxString, std::unique_ptr<LIB_SYMBOL>>         m_Symbols;
+        std::map<wxString, std::pair<std::string, std::string>> m_SanitizedNames;
+    };
+
     void cacheLib();
 
+    /**
+     * Read all the tables of the library through \a aConn.
+     *
+     * @throw IO_ERROR if a table can't be read.
+     */
+    LIB_CONTENTS readTables( DATABASE_CONNECTION& aConn );
+
+    /**
+     * Read the tables again on a second connection, in the background.  The expired contents
+     * stay in use until cacheLib() picks up the result.
+     */
+    void startRefresh( long long aTimestamp );
+
     void ensureSettings( const wxString& aSettingsPath );
 
     void ensureConnection();
 
     void connect();
 
+    /// @return a connection set up from the settings, which may have failed to connect
+    std::unique_ptr<DATABASE_CONNECTION> createConnection();
+
     std::unique_ptr<LIB_SYMBOL> loadSymbolFromRow( const wxString& aSymbolName,
                                                    const DATABASE_LIB_TABLE& aTable,
                                                    const DATABASE_CONNECTION::ROW& aRow );
@@ -123,6 +147,15 @@ private:
 
     int m_cacheModifyHash;
 
+    /// Only used by the background refresh, so it never shares a connection with the caller
+    std::unique_ptr<DATABASE_CONNECTION> m_refreshConn;
+
+    std::future<std::optional<LIB_CONTENTS>> m_refresh;
+
+    long long m_refreshTimestamp;
+
+    int m_refreshModifyHash;
+
 
 
     wxString m_lastError;
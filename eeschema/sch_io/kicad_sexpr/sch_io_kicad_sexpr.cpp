@@ -27,6 +27,7 @@
 #include <wx/log.h>
 #include <wx/mstream.h>
 
+#include <advanced_config.h>
 #include <base_units.h>
 #include <bitmap_base.h>
 #include <build_version.h>
@@ -62,6 +63,8 @@
 #include <string_utils.h>
 #include <trace_helpers.h>
 #include <reporter.h>
+#include <richio.h>
+#include <thread_pool.h>
 
 using namespace TSCHEMATIC_T;
 
@@ -140,6 +143,8 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
     m_currentPath.push( m_path );
     init( aSchematic, aProperties );
 
+    m_embeddedSymbols = std::make_unique<SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE>();
+
     if( aAppendToMe == nullptr )
     {
         // Clean up any allocated memory if an exception occurs loading the schematic.
@@ -167,6 +172,8 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
         loadHierarchy( SCH_SHEET_PATH(), sheet );
     }
 
+    m_embeddedSymbols.reset();
+
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
 
     m_currentPath.pop(); // Clear the path stack for next call to Load
@@ -182,8 +189,9 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
     m_currentSheetPath.push_back( aSheet );
 
     SCH_SCREEN* screen = nullptr;
+    auto        preloaded = m_preloadedSheets.find( aSheet );
 
-    if( !aSheet->GetScreen() )
+    if( !aSheet->GetScreen() || preloaded != m_preloadedSheets.end() )
     {
         // SCH_SCREEN objects store the full path and file name where the SCH_SHEET object only
         // stores the file name and extension.  Add the project path to the file name and
@@ -223,7 +231,8 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
             ancestorSheetPath.pop_back();
         }
 
-        if( ancestorSheetPath.empty() )
+        // preloadSheets() already checked preloaded sheets against the hierarchy
+        if( ancestorSheetPath.empty() && preloaded == m_preloadedSheets.end() )
         {
             // Existing schematics could be either in the root sheet path or the current sheet
             // load path so we have to check both.
@@ -239,12 +248,25 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
         }
         else
         {
-            aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
-            aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
-
             try
             {
-                loadFile( fileName.GetFullPath(), aSheet );
+                if( preloaded != m_preloadedSheets.end() )
+                {
+                    PRELOADED_SHEET sheetLoad = std::move( preloaded->second );
+                    m_preloadedSheets.erase( preloaded );
+
+                    if( sheetLoad.m_error )
+                        std::rethrow_exception( sheetLoad.m_error );
+
+                    sheetLoad.m_parser->ApplyDeferredChanges( aSheet );
+                }
+                else
+                {
+                    aSheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                    aSheet->GetScreen()->SetFileName( fileName.GetFullPath() );
+
+                    loadFile( fileName.GetFullPath(), aSheet );
+                }
             }
             catch( const IO_ERROR& ioe )
             {
@@ -273,6 +295,8 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
             SCH_SHEET_PATH currentSheetPath = aParentSheetPath;
             currentSheetPath.push_back( aSheet );
 
+            preloadSheets( currentSheetPath );
+
             // This was moved out of the try{} block so that any sheet definitions that
             // the plugin fully parsed before the exception was raised will be loaded.
             for( SCH_ITEM* aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
@@ -293,9 +317,139 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 }
 
 
+void SCH_IO_KICAD_SEXPR::preloadSheets( const SCH_SHEET_PATH& aSheetPath )
+{
+    // Nested pool tasks could deadlock, so loads made on pool threads stay sequential.
+    if( !ADVANCED_CFG::GetCfg().m_ParallelSchematicLoad
+            || BS::this_thread::get_pool().has_value() )
+    {
+        return;
+    }
+
+    std::vector<std::pair<SCH_SHEET*, wxString>> sheets;
+
+    for( SCH_ITEM* item : aSheetPath.LastScreen()->Items().OfType( SCH_SHEET_T ) )
+    {
+        SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
+
+        if( sheet->GetScreen() )
+            continue;
+
+        wxFileName fileName = sheet->GetFileName();
+
+        if( !fileName.IsAbsolute() )
+            fileName.MakeAbsolute( m_currentPath.top() );
+
+        wxString fullPath = fileName.GetFullPath();
+
+        // Leave recursive sheets, shared screens and the sheets already loaded elsewhere in
+        // the hierarchy to loadHierarchy()
+        SCH_SHEET_PATH ancestorSheetPath = aSheetPath;
+        bool           isAncestor = false;
+
+        while( !ancestorSheetPath.empty() && !isAncestor )
+        {
+            isAncestor = ancestorSheetPath.LastScreen()->GetFileName() == fullPath;
+            ancestorSheetPath.pop_back();
+        }
+
+        if( isAncestor || !fileName.FileExists() )
+            continue;
+
+        if( std::any_of( sheets.begin(), sheets.end(),
+                         [&]( const std::pair<SCH_SHEET*, wxString>& aEntry )
+                         {
+                             return aEntry.second == fullPath;
+                         } ) )
+        {
+            continue;
+        }
+
+        SCH_SCREEN* screen = nullptr;
+
+        if( m_rootSheet->SearchHierarchy( fullPath, &screen )
+                || m_currentSheetPath.at( 0 )->SearchHierarchy( fullPath, &screen ) )
+        {
+            continue;
+        }
+
+        sheets.emplace_back( sheet, fullPath );
+    }
+
+    if( sheets.size() < 2 )
+        return;
+
+    // Screens are created here: they register with the schematic
+    for( const auto& [sheet, fullPath] : sheets )
+    {
+        sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+        sheet->GetScreen()->SetFileName( fullPath );
+        m_preloadedSheets[sheet];
+    }
+
+    if( m_progressReporter )
+    {
+        m_progressReporter->Report( wxString::Format( _( "Loading %s..." ),
+                                                      aSheetPath.LastScreen()->GetFileName() ) );
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    auto results = tp.submit_loop( 0, sheets.size(),
+            [&]( const int ii )
+            {
+                SCH_SHEET*       sheet = sheets[ii].first;
+                PRELOADED_SHEET& sheetLoad = m_preloadedSheets.at( sheet );
+
+                try
+                {
+                    sheetLoad.m_reader = openSheetFile( sheets[ii].second );
+                    sheetLoad.m_parser = std::make_unique<SCH_IO_KICAD_SEXPR_PARSER>(
+                            sheetLoad.m_reader.get(), nullptr, 0, m_rootSheet, m_appending );
+
+                    sheetLoad.m_parser->SetEmbeddedSymbolCache( m_embeddedSymbols.get() );
+                    sheetLoad.m_parser->SetDeferSchematicChanges( true );
+                    sheetLoad.m_parser->ParseSchematic( sheet );
+                }
+                catch( ... )
+                {
+                    sheetLoad.m_error = std::current_exception();
+                }
+            } );
+
+    bool canceled = false;
+
+    while( !results.wait_for( std::chrono::milliseconds( 100 ) ) )
+    {
+        if( m_progressReporter && !canceled && !m_progressReporter->KeepRefreshing() )
+            canceled = true;
+    }
+
+    if( canceled )
+    {
+        m_preloadedSheets.clear();
+        THROW_IO_ERROR( _( "Open canceled by user." ) );
+    }
+}
+
+
+std::unique_ptr<LINE_READER> SCH_IO_KICAD_SEXPR::openSheetFile( const wxString& aFileName )
+{
+    try
+    {
+        return std::make_unique<MAPPED_FILE_LINE_READER>( aFileName );
+    }
+    catch( const IO_ERROR& )
+    {
+        // Empty files, or a platform without mappings
+        return std::make_unique<FILE_LINE_READER>( aFileName );
+    }
+}
+
+
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    std::unique_ptr<LINE_READER> reader = openSheetFile( aFileName );
 
     size_t lineCount = 0;
 
@@ -306,15 +460,26 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open canceled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
+        if( STRING_VIEW_LINE_READER* viewReader =
+                    dynamic_cast<STRING_VIEW_LINE_READER*>( reader.get() ) )
+        {
+            lineCount = viewReader->CountLines();
+        }
+        else
+        {
+            FILE_LINE_READER* fileReader = static_cast<FILE_LINE_READER*>( reader.get() );
+
+            while( fileReader->ReadLine() )
+                lineCount++;
 
-        reader.Rewind();
+            fileReader->Rewind();
+        }
     }
 
-    SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount, m_rootSheet,
+    SCH_IO_KICAD_SEXPR_PARSER parser( reader.get(), m_progressReporter, lineCount, m_rootSheet,
                                       m_appending );
 
+    parser.SetEmbeddedSymbolCache( m_embeddedSymbols.get() );
     parser.ParseSchematic( aSheet );
 }
 
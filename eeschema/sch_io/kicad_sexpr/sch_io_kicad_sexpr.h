@@ -23,6 +23,8 @@
 #ifndef SCH_IO_KICAD_SEXPR_H_
 #define SCH_IO_KICAD_SEXPR_H_
 
+#include <exception>
+#include <map>
 #include <memory>
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
@@ -54,6 +56,8 @@ class SCH_FIELD;
 struct SCH_SYMBOL_INSTANCE;
 class SCH_SELECTION;
 class SCH_IO_KICAD_SEXPR_LIB_CACHE;
+class SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE;
+class SCH_IO_KICAD_SEXPR_PARSER;
 class LIB_SYMBOL;
 class LEGACY_SYMBOL_LIB;
 class BUS_ALIAS;
@@ -144,6 +148,17 @@ private:
     void loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet );
     void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
 
+    /**
+     * Parse the files of the sub-sheets of \a aSheetPath that are not loaded yet concurrently,
+     * ahead of loadHierarchy() which then completes them in hierarchy order.
+     */
+    void preloadSheets( const SCH_SHEET_PATH& aSheetPath );
+
+    /**
+     * @return a reader for \a aFileName, from a memory mapping when possible.
+     */
+    std::unique_ptr<LINE_READER> openSheetFile( const wxString& aFileName );
+
     void saveSymbol( SCH_SYMBOL* aSymbol, const SCHEMATIC& aSchematic,
                      const SCH_SHEET_LIST& aSheetList, bool aForClipboard,
                      const SCH_SHEET_PATH* aRelativePath = nullptr );
@@ -179,6 +194,19 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
 
+    /// The lib_symbols already parsed by the current load.
+    std::unique_ptr<SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE> m_embeddedSymbols;
+
+    /// A sheet parsed by preloadSheets(), waiting for loadHierarchy().
+    struct PRELOADED_SHEET
+    {
+        std::unique_ptr<LINE_READER>                m_reader;
+        std::unique_ptr<SCH_IO_KICAD_SEXPR_PARSER>  m_parser;
+        std::exception_ptr                          m_error;
+    };
+
+    std::map<SCH_SHEET*, PRELOADED_SHEET> m_preloadedSheets;
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const std::map<std::string, UTF8>* aProperties = nullptr );
 
@@ -770,3 +770,45 @@ bool SCH_IO_KICAD_SEXPR_LIB_CACHE::isLibraryPathValid() const
     else
         return m_libFileName.DirExists();
 }
+
+
+SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE::SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE()
+{
+}
+
+
+SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE::~SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE()
+{
+}
+
+
+std::unique_ptr<LIB_SYMBOL>
+SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE::Find( const std::string& aKey ) const
+{
+    const LIB_SYMBOL* symbol = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_symbols.find( aKey );
+
+        if( it == m_symbols.end() )
+            return nullptr;
+
+        symbol = it->second.get();
+    }
+
+    // Cached symbols are never changed or removed, so they can be copied without the lock
+    return std::make_unique<LIB_SYMBOL>( *symbol );
+}
+
+
+void SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE::Add( const std::string& aKey,
+                                                    const LIB_SYMBOL& aSymbol )
+{
+    std::unique_ptr<LIB_SYMBOL> copy = std::make_unique<LIB_SYMBOL>( aSymbol );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_symbols.try_emplace( aKey, std::move( copy ) );
+}
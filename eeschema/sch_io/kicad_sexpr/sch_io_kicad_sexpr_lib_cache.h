@@ -22,6 +22,10 @@
 #ifndef SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 #define SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "sch_io/sch_io_lib_cache.h"
 
 class FILE_LINE_READER;
@@ -85,4 +89,32 @@ private:
     static void saveDcmInfoAsFields( LIB_SYMBOL* aSymbol, OUTPUTFORMATTER& aFormatter );
 };
 
+
+/**
+ * The symbols embedded in the lib_symbols of the sheets of a schematic being loaded, by their
+ * file text.  A symbol used by many sheets is parsed once and copied for the other sheets.
+ *
+ * Safe to use from sheets parsed concurrently.
+ */
+class SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE
+{
+public:
+    SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE();
+    ~SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE();
+
+    /**
+     * @return a copy of the symbol parsed from @a aKey, or nullptr if it wasn't cached yet.
+     */
+    std::unique_ptr<LIB_SYMBOL> Find( const std::string& aKey ) const;
+
+    /**
+     * Cache a copy of @a aSymbol as parsed from @a aKey.
+     */
+    void Add( const std::string& aKey, const LIB_SYMBOL& aSymbol );
+
+private:
+    mutable std::mutex                                           m_mutex;
+    std::unordered_map<std::string, std::unique_ptr<LIB_SYMBOL>> m_symbols;
+};
+
 #endif    // SCH_IO_KICAD_SEXPR_LIB_CACHE_H_
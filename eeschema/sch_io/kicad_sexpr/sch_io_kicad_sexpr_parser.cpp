@@ -63,6 +63,7 @@
 #include <sch_shape.h>
 #include <sch_sheet_pin.h>
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_parser.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
 #include <stroke_params_parser.h>
 #include <template_fieldnames.h>
 #include <trigo.h>
@@ -87,7 +88,9 @@ SCH_IO_KICAD_SEXPR_PARSER::SCH_IO_KICAD_SEXPR_PARSER( LINE_READER* aLineReader,
         m_lastProgressLine( 0 ),
         m_lineCount( aLineCount ),
         m_rootSheet( aRootSheet ),
-        m_maxError( ARC_LOW_DEF_MM * schIUScale.IU_PER_MM )
+        m_maxError( ARC_LOW_DEF_MM * schIUScale.IU_PER_MM ),
+        m_embeddedSymbolCache( nullptr ),
+        m_deferSchematicChanges( false )
 {
 }
 
@@ -650,6 +653,43 @@ LIB_SYMBOL* SCH_IO_KICAD_SEXPR_PARSER::parseLibSymbol( LIB_SYMBOL_MAP& aSymbolLi
 }
 
 
+LIB_SYMBOL* SCH_IO_KICAD_SEXPR_PARSER::parseEmbeddedLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap )
+{
+    STRING_VIEW_LINE_READER* viewReader = dynamic_cast<STRING_VIEW_LINE_READER*>( reader );
+
+    if( !m_embeddedSymbolCache || !viewReader )
+        return parseLibSymbol( aSymbolLibMap );
+
+    // The lines of a STRING_VIEW_LINE_READER stay put, so the text of the whole definition
+    // can be used as the key without copying it line by line.
+    const char* keyword = start + curOffset;
+    size_t      lineOffset = start - viewReader->Text().data();
+    int         lineNumber = CurLineNumber();
+
+    skipToBlockEnd();
+
+    std::string key = fmt::format( "{}:", m_requiredVersion );
+    key.append( keyword, next - keyword );
+
+    if( std::unique_ptr<LIB_SYMBOL> cached = m_embeddedSymbolCache->Find( key ) )
+        return cached.release();
+
+    // Not seen yet: go back to the symbol keyword and parse it
+    viewReader->SetPosition( lineOffset, lineNumber );
+    readLine();
+    next = keyword;
+    NextTok();
+
+    LIB_SYMBOL* symbol = parseLibSymbol( aSymbolLibMap );
+
+    // Derived symbols point to their parent in this screen's map and can't be shared
+    if( symbol && !symbol->IsDerived() )
+        m_embeddedSymbolCache->Add( key, *symbol );
+
+    return symbol;
+}
+
+
 SCH_ITEM* SCH_IO_KICAD_SEXPR_PARSER::ParseSymbolDrawItem()
 {
     switch( CurTok() )
@@ -2864,7 +2904,7 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
                 switch( token )
                 {
                 case T_symbol:
-                    symbol = parseLibSymbol( symbolLibMap );
+                    symbol = parseEmbeddedLibSymbol( symbolLibMap );
                     screen->AddLibSymbol( symbol );
                     break;
 
@@ -3012,7 +3052,11 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
                 THROW_PARSE_ERROR( _( "No schematic object" ), CurSource(), CurLine(),
                                    CurLineNumber(), CurOffset() );
 
-            schematic->GetEmbeddedFiles()->SetAreFontsEmbedded( parseBool() );
+            if( m_deferSchematicChanges )
+                m_deferredFontsEmbedded = parseBool();
+            else
+                schematic->GetEmbeddedFiles()->SetAreFontsEmbedded( parseBool() );
+
             NeedRIGHT();
             break;
         }
@@ -3030,7 +3074,8 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
 
             try
             {
-                embeddedFilesParser.ParseEmbedded( schematic->GetEmbeddedFiles() );
+                embeddedFilesParser.ParseEmbedded( m_deferSchematicChanges ? &m_deferredEmbeddedFiles
+                                                                           : schematic->GetEmbeddedFiles() );
             }
             catch( const PARSE_ERROR& e )
             {
@@ -3058,7 +3103,10 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
     }
 
     screen->UpdateLocalLibSymbolLinks();
-    screen->FixupEmbeddedData();
+
+    // The embedded files belong to the schematic; wait for ApplyDeferredChanges()
+    if( !m_deferSchematicChanges )
+        screen->FixupEmbeddedData();
 
     resolveGroups( screen );
 
@@ -3068,14 +3116,49 @@ void SCH_IO_KICAD_SEXPR_PARSER::ParseSchematic( SCH_SHEET* aSheet, bool aIsCopya
         THROW_PARSE_ERROR( _( "No schematic object" ), CurSource(), CurLine(),
                             CurLineNumber(), CurOffset() );
 
+    if( !m_deferSchematicChanges )
+        cacheFonts( schematic );
+
+    if( m_requiredVersion < 20200828 )
+        screen->SetLegacySymbolInstanceData();
+}
+
+
+void SCH_IO_KICAD_SEXPR_PARSER::ApplyDeferredChanges( SCH_SHEET* aSheet )
+{
+    SCH_SCREEN* screen = aSheet->GetScreen();
+
+    wxCHECK( screen && screen->Schematic(), /* void */ );
+
+    EMBEDDED_FILES* embeddedFiles = screen->Schematic()->GetEmbeddedFiles();
+
+    if( m_deferredFontsEmbedded )
+        embeddedFiles->SetAreFontsEmbedded( *m_deferredFontsEmbedded );
+
+    // As when parsed straight into the schematic, the first file of a name is kept
+    for( const auto& [name, file] : m_deferredEmbeddedFiles.EmbeddedFileMap() )
+    {
+        if( embeddedFiles->HasFile( name ) )
+            delete file;
+        else
+            embeddedFiles->AddFile( file );
+    }
+
+    m_deferredEmbeddedFiles.ClearEmbeddedFiles( false );
+    m_deferredFontsEmbedded.reset();
+
+    screen->FixupEmbeddedData();
+    cacheFonts( screen->Schematic() );
+}
+
+
+void SCH_IO_KICAD_SEXPR_PARSER::cacheFonts( SCHEMATIC* aSchematic )
+{
     // When loading the schematic, take a moment to cache the fonts so that the font
     // picker can show the embedded fonts immediately.
     std::vector<std::string> fontNames;
     Fontconfig()->ListFonts( fontNames, std::string( Pgm().GetLanguageTag().utf8_str() ),
-                             schematic->GetEmbeddedFiles()->GetFontFiles(), true );
-
-    if( m_requiredVersion < 20200828 )
-        screen->SetLegacySymbolInstanceData();
+                             aSchematic->GetEmbeddedFiles()->GetFontFiles(), true );
 }
 
 
@@ -36,9 +36,14 @@
 #include <schematic_lexer.h>
 #include <sch_file_versions.h>
 #include <default_values.h>    // For some default values
+#include <embedded_files.h>
 
+#include <optional>
 
+
+class SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE;
 class SCH_PIN;
+class SCHEMATIC;
 class PAGE_INFO;
 class SCH_BITMAP;
 class SCH_BUS_WIRE_ENTRY;
@@ -111,6 +116,27 @@ public:
     void ParseSchematic( SCH_SHEET* aSheet, bool aIsCopyablyOnly = false,
                          int aFileVersion = SEXPR_SCHEMATIC_FILE_VERSION );
 
+    /**
+     * Parse the embedded lib_symbols through \a aCache, so that the symbols shared by the
+     * sheets of a schematic are only parsed once.  Only used with a #STRING_VIEW_LINE_READER.
+     */
+    void SetEmbeddedSymbolCache( SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE* aCache )
+    {
+        m_embeddedSymbolCache = aCache;
+    }
+
+    /**
+     * Leave the data the sheets of a schematic share, such as its embedded files, alone in
+     * ParseSchematic() so that sheets can be parsed concurrently.  ApplyDeferredChanges()
+     * then completes the sheet.
+     */
+    void SetDeferSchematicChanges( bool aDefer ) { m_deferSchematicChanges = aDefer; }
+
+    /**
+     * Apply the changes to the schematic deferred while parsing \a aSheet.
+     */
+    void ApplyDeferredChanges( SCH_SHEET* aSheet );
+
     int GetParsedRequiredVersion() const { return m_requiredVersion; }
 
     /**
@@ -143,12 +169,12 @@ private:
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), nullptr, 16 );
+        return DSNLEXER::parseHex();
     }
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        return (int) parseLong();
     }
 
     inline int parseInt( const char* aExpected )
@@ -193,6 +219,12 @@ private:
 
     LIB_SYMBOL* parseLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap );
 
+    /**
+     * Same as parseLibSymbol(), for the lib_symbols of a schematic, through the embedded symbol
+     * cache if there is one.
+     */
+    LIB_SYMBOL* parseEmbeddedLibSymbol( LIB_SYMBOL_MAP& aSymbolLibMap );
+
     /**
      * Parse stroke definition \a aStroke.
      *
@@ -258,6 +290,12 @@ private:
 
     void resolveGroups( SCH_SCREEN* aParent );
 
+    /**
+     * Cache the fonts so that the font picker can show the embedded fonts of \a aSchematic
+     * immediately.
+     */
+    void cacheFonts( SCHEMATIC* aSchematic );
+
     /**
      * Skip tokens until we reach the end of the current S-expression block.
      *
@@ -295,6 +333,12 @@ private:
     std::vector<GROUP_INFO> m_groupInfos;
 
     std::vector<wxString>   m_parseWarnings;    ///< Non-fatal warnings collected during parsing
+
+    SCH_IO_KICAD_SEXPR_EMBEDDED_SYMBOL_CACHE* m_embeddedSymbolCache;
+
+    bool                    m_deferSchematicChanges;
+    std::optional<bool>     m_deferredFontsEmbedded;
+    EMBEDDED_FILES          m_deferredEmbeddedFiles;
 };
 
 #endif    // SCH_IO_KICAD_SEXPR_PARSER_H_
@@ -33,7 +33,9 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <string_utils.h>
@@ -446,6 +448,104 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         AddItem( additionalRef ); //add to this container
     }
 
+    // The references already annotated, by case-folded prefix and number.  This is what
+    // FindFirstUnusedReference() collects by scanning the whole list; keeping it up to date as
+    // numbers are assigned saves that scan for every symbol.
+    struct PREFIX_REFS
+    {
+        std::map<int, std::vector<SCH_REFERENCE>> m_byNumber;
+
+        /// Lower bound on the first number not in #m_byNumber at or after a given minimum.
+        std::map<int, int>                        m_runEnd;
+    };
+
+    std::unordered_map<wxString, PREFIX_REFS> usedRefs;
+
+    auto recordRef =
+            [&]( const SCH_REFERENCE& aRef )
+            {
+                if( !aRef.m_isNew )
+                    usedRefs[aRef.GetRef().Lower()].m_byNumber[aRef.m_numRef].push_back( aRef );
+            };
+
+    auto forgetRef =
+            [&]( const SCH_REFERENCE& aRef )
+            {
+                if( aRef.m_isNew )
+                    return;
+
+                PREFIX_REFS& prefix = usedRefs[aRef.GetRef().Lower()];
+                auto         it = prefix.m_byNumber.find( aRef.m_numRef );
+
+                if( it == prefix.m_byNumber.end() )
+                    return;
+
+                std::vector<SCH_REFERENCE>& refs = it->second;
+
+                auto match = std::find_if( refs.begin(), refs.end(),
+                                           [&]( const SCH_REFERENCE& aOther )
+                                           {
+                                               return aOther.IsSameInstance( aRef )
+                                                      && aOther.m_unit == aRef.m_unit;
+                                           } );
+
+                if( match != refs.end() )
+                    refs.erase( match );
+
+                if( refs.empty() )
+                {
+                    prefix.m_byNumber.erase( it );
+                    prefix.m_runEnd.clear();
+                }
+            };
+
+    auto nextRefNumber =
+            [&]( const SCH_REFERENCE& aRef, int aMinValue, const std::vector<int>& aUnits )
+            {
+                PREFIX_REFS& prefix = usedRefs[aRef.GetRef().Lower()];
+
+                // Without units to share, every number in use is skipped anyway, so start
+                // after the run of used numbers following the minimum
+                if( aUnits.empty() )
+                {
+                    int& runEnd = prefix.m_runEnd.try_emplace( aMinValue, aMinValue ).first->second;
+                    auto it = prefix.m_byNumber.lower_bound( runEnd );
+
+                    while( it != prefix.m_byNumber.end() && it->first == runEnd )
+                    {
+                        ++it;
+                        ++runEnd;
+                    }
+
+                    aMinValue = runEnd;
+                }
+
+                return m_refDesTracker->GetNextRefDesForUnits( aRef, prefix.m_byNumber, aUnits,
+                                                               aMinValue );
+            };
+
+    // The locked list holding each symbol instance, and the position of each instance in the
+    // flat list, by symbol.  Both replace scans of every locked list or of the flat list.
+    std::unordered_map<const SCH_SYMBOL*,
+                       std::vector<std::pair<const SCH_REFERENCE*,
+                                             const SCH_REFERENCE_LIST*>>> lockedBySymbol;
+    std::unordered_map<const SCH_SYMBOL*, std::vector<unsigned>>         indicesBySymbol;
+
+    for( const SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned ii = 0; ii < pair.second.GetCount(); ++ii )
+        {
+            const SCH_REFERENCE& lockedRef = pair.second[ii];
+            lockedBySymbol[lockedRef.GetSymbol()].emplace_back( &lockedRef, &pair.second );
+        }
+    }
+
+    for( unsigned ii = 0; ii < m_flatList.size(); ii++ )
+    {
+        recordRef( m_flatList[ii] );
+        indicesBySymbol[m_flatList[ii].GetSymbol()].push_back( ii );
+    }
+
     int LastReferenceNumber = 0;
 
     /* calculate index of the first symbol with the same reference prefix
@@ -475,23 +575,18 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         // Check whether this symbol is in aLockedUnitMap.
         const SCH_REFERENCE_LIST* lockedList = nullptr;
 
-        for( const SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
+        auto locked = lockedBySymbol.find( ref_unit.GetSymbol() );
 
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+        if( locked != lockedBySymbol.end() )
+        {
+            for( const auto& [thisRef, thisList] : locked->second )
             {
-                const SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
+                if( thisRef->IsSameInstance( ref_unit ) )
                 {
-                    lockedList = &pair.second;
+                    lockedList = thisList;
                     break;
                 }
             }
-
-            if( lockedList != nullptr )
-                break;
         }
 
         if(  ( m_flatList[first].CompareRef( ref_unit ) != 0 )
@@ -518,13 +613,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, {} );
+                LastReferenceNumber = nextRefNumber( ref_unit, minRefId, {} );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
+                ref_unit.m_isNew = false;
+                recordRef( ref_unit );
             }
 
             ref_unit.m_flag  = 1;
-            ref_unit.m_isNew = false;
             continue;
         }
 
@@ -535,9 +631,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             unsigned n_refs = lockedList->GetCount();
             std::vector<int> units = lockedList->GetUnitsMatchingRef( ref_unit );
 
+            // The number and unit of this reference may change below
+            forgetRef( ref_unit );
+
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+                LastReferenceNumber = nextRefNumber( ref_unit, minRefId, units );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
                 ref_unit.m_isNew = false;
@@ -564,9 +663,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching symbol
-                for( unsigned jj = ii + 1; jj < m_flatList.size(); jj++ )
+                for( unsigned jj : indicesBySymbol[lockedRef.GetSymbol()] )
                 {
-                    if( !lockedRef.IsSameInstance( m_flatList[jj] ) )
+                    if( jj <= ii || !lockedRef.IsSameInstance( m_flatList[jj] ) )
                         continue;
 
                     wxString ref_candidate = buildFullReference( ref_unit, lockedRef.m_unit );
@@ -576,10 +675,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits symbols have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        forgetRef( m_flatList[jj] );
                         m_flatList[jj].m_numRef = ref_unit.m_numRef;
                         m_flatList[jj].m_numRefStr = ref_unit.m_numRefStr;
                         m_flatList[jj].m_isNew = false;
                         m_flatList[jj].m_flag = 1;
+                        recordRef( m_flatList[jj] );
 
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
@@ -587,6 +688,8 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     }
                 }
             }
+
+            recordRef( ref_unit );
         }
         else if( ref_unit.m_isNew )
         {
@@ -594,11 +697,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             // know what group this might belong to, so just find the first unused reference for
             // this specific unit. The other units will be annotated in the following passes.
             std::vector<int> units = { ref_unit.GetUnit() };
-            LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+            LastReferenceNumber = nextRefNumber( ref_unit, minRefId, units );
             ref_unit.m_numRef = LastReferenceNumber;
             ref_unit.m_numRefStr = ref_unit.formatRefStr( LastReferenceNumber );
             ref_unit.m_isNew = false;
             ref_unit.m_flag = 1;
+            recordRef( ref_unit );
         }
     }
 
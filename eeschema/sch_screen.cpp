@@ -1261,6 +1261,64 @@ void SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath,
 }
 
 
+void SCH_SCREEN::TestDanglingEnds( const BOX2I& aDirtyArea, const SCH_SHEET_PATH* aPath,
+                                   std::function<void( SCH_ITEM* )>* aChangedHandler ) const
+{
+    PROF_TIMER timer( "SCH_SCREEN::TestDanglingEnds (area)" );
+
+    std::vector<DANGLING_END_ITEM> endPointsByPos;
+    std::vector<DANGLING_END_ITEM> endPointsByType;
+    std::vector<SCH_ITEM*>         candidates;
+    BOX2I                          contextArea = aDirtyArea;
+
+    auto get_ends =
+            [&]( SCH_ITEM* item )
+            {
+                if( item->IsConnectable() )
+                    item->GetEndPoints( endPointsByType );
+            };
+
+    auto update_state =
+            [&]( SCH_ITEM* item )
+            {
+                if( item->UpdateDanglingState( endPointsByType, endPointsByPos, aPath ) )
+                {
+                    if( aChangedHandler )
+                        ( *aChangedHandler )( item );
+                }
+            };
+
+    // A candidate's state depends on the end points of anything touching it, including outside
+    // the dirty area, so gather them over the union of the candidates' boxes.
+    for( SCH_ITEM* item : Items().Overlapping( aDirtyArea ) )
+    {
+        candidates.push_back( item );
+        contextArea.Merge( item->GetBoundingBox() );
+    }
+
+    if( candidates.empty() )
+        return;
+
+    for( SCH_ITEM* item : Items().Overlapping( contextArea ) )
+    {
+        get_ends( item );
+        item->RunOnChildren( get_ends, RECURSE_MODE::NO_RECURSE );
+    }
+
+    endPointsByPos = endPointsByType;
+    DANGLING_END_ITEM_HELPER::sort_dangling_end_items( endPointsByType, endPointsByPos );
+
+    for( SCH_ITEM* item : candidates )
+    {
+        update_state( item );
+        item->RunOnChildren( update_state, RECURSE_MODE::NO_RECURSE );
+    }
+
+    if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
+        timer.Show();
+}
+
+
 SCH_LINE* SCH_SCREEN::GetLine( const VECTOR2I& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType ) const
 {
@@ -308,6 +308,16 @@ public:
     void TestDanglingEnds( const SCH_SHEET_PATH* aPath = nullptr,
                            std::function<void( SCH_ITEM* )>* aChangedHandler = nullptr ) const;
 
+    /**
+     * Test only the connectable objects overlapping \a aDirtyArea for unused connection points.
+     *
+     * The end points of every object touching one of them are gathered, so the result is the
+     * same as a full test for these objects; objects outside the area are left untouched.  Use
+     * it when the area covers all the connection points changed since the last full test.
+     */
+    void TestDanglingEnds( const BOX2I& aDirtyArea, const SCH_SHEET_PATH* aPath = nullptr,
+                           std::function<void( SCH_ITEM* )>* aChangedHandler = nullptr ) const;
+
     /**
      * Return all wires and junctions connected to \a aItem which are not connected any
      * symbol pin or all graphical segments lines connected to \a aItem.
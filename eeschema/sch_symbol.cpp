@@ -315,6 +315,12 @@ void SCH_SYMBOL::UpdatePins()
     std::set<SCH_PIN*>                     unassignedSchPins;
     std::set<SCH_PIN*>                     unassignedLibPins;
 
+    // The library symbol may have been replaced by one allocated at the same address
+    {
+        std::lock_guard<std::mutex> lock( m_bodyBBoxCacheMutex );
+        m_bodyBBoxCache = BODY_BBOX_CACHE();
+    }
+
     for( const std::unique_ptr<SCH_PIN>& pin : m_pins )
     {
         pinUuidMap[pin->GetNumber()].insert( pin.get() );
@@ -2542,12 +2548,31 @@ void SCH_SYMBOL::Show( int nestLevel, std::ostream& os ) const
 
 BOX2I SCH_SYMBOL::doGetBoundingBox( bool aIncludePins, bool aIncludeFields ) const
 {
-    BOX2I bBox;
+    const LIB_SYMBOL* libSymbol = m_part ? m_part.get() : LIB_SYMBOL::GetDummy();
+    BOX2I             bBox;
 
-    if( m_part )
-        bBox = m_part->GetBodyBoundingBox( m_unit, m_bodyStyle, aIncludePins, false );
-    else
-        bBox = LIB_SYMBOL::GetDummy()->GetBodyBoundingBox( m_unit, m_bodyStyle, aIncludePins, false );
+    {
+        std::lock_guard<std::mutex> lock( m_bodyBBoxCacheMutex );
+        BODY_BBOX_CACHE&            cache = m_bodyBBoxCache;
+
+        if( cache.m_libSymbol != libSymbol || cache.m_unit != m_unit
+                || cache.m_bodyStyle != m_bodyStyle )
+        {
+            cache = BODY_BBOX_CACHE();
+            cache.m_libSymbol = libSymbol;
+            cache.m_unit = m_unit;
+            cache.m_bodyStyle = m_bodyStyle;
+        }
+
+        if( !cache.m_valid[aIncludePins] )
+        {
+            cache.m_bbox[aIncludePins] = libSymbol->GetBodyBoundingBox( m_unit, m_bodyStyle,
+                                                                        aIncludePins, false );
+            cache.m_valid[aIncludePins] = true;
+        }
+
+        bBox = cache.m_bbox[aIncludePins];
+    }
 
     bBox = m_transform.TransformCoordinate( bBox );
     bBox.Normalize();
@@ -2587,6 +2612,17 @@ BOX2I SCH_SYMBOL::GetBodyAndPinsBoundingBox() const
 }
 
 
+void SCH_SYMBOL::ClearCaches()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_bodyBBoxCacheMutex );
+        m_bodyBBoxCache = BODY_BBOX_CACHE();
+    }
+
+    SCH_ITEM::ClearCaches();
+}
+
+
 const BOX2I SCH_SYMBOL::GetBoundingBox() const
 {
     return doGetBoundingBox( true, true );
@@ -34,6 +34,7 @@
 #include <lib_id.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -418,6 +419,8 @@ public:
      */
     BOX2I GetBodyAndPinsBoundingBox() const override;
 
+    void ClearCaches() override;
+
 
     //-----<Fields>-----------------------------------------------------------
 
@@ -1017,6 +1020,24 @@ private:
      */
     std::vector<SCH_SYMBOL_INSTANCE>       m_instanceReferences;
 
+    /**
+     * Untransformed body boxes of the current unit and body style, without and with pins.
+     *
+     * They only depend on the library symbol, so they are kept until the library symbol, the
+     * unit or the body style changes and placement only applies #m_transform and #m_pos.
+     */
+    struct BODY_BBOX_CACHE
+    {
+        const LIB_SYMBOL* m_libSymbol = nullptr;
+        int               m_unit = 0;
+        int               m_bodyStyle = 0;
+        bool              m_valid[2] = { false, false };
+        BOX2I             m_bbox[2];
+    };
+
+    mutable BODY_BBOX_CACHE m_bodyBBoxCache;
+    mutable std::mutex      m_bodyBBoxCacheMutex;
+
     /// @see SCH_SYMBOL::GetOrientation
     static std::unordered_map<TRANSFORM, int> s_transformToOrientationCache;
 };
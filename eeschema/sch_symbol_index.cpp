@@ -0,0 +1,322 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sch_symbol_index.h>
+
+#include <algorithm>
+
+#include <sch_field.h>
+#include <sch_screen.h>
+#include <sch_symbol.h>
+
+
+SCH_SYMBOL_INDEX::SCH_SYMBOL_INDEX() :
+        m_schematic( nullptr ),
+        m_dirty( true )
+{
+}
+
+
+void SCH_SYMBOL_INDEX::SetSchematic( SCHEMATIC* aSchematic )
+{
+    m_schematic = aSchematic;
+
+    // AddListener() ignores duplicates, so this is safe after a schematic reload
+    if( m_schematic )
+        m_schematic->AddListener( this );
+
+    m_dirty = true;
+}
+
+
+SCH_SYMBOL_INDEX::TEXT_MAP& SCH_SYMBOL_INDEX::map( KEY aKey )
+{
+    switch( aKey )
+    {
+    case KEY::REFERENCE: return m_byRef;
+    case KEY::VALUE:     return m_byValue;
+    case KEY::LIB_ID:    return m_byLibId;
+    }
+
+    return m_byRef;
+}
+
+
+void SCH_SYMBOL_INDEX::rebuild()
+{
+    m_sheets.clear();
+    m_byRef.clear();
+    m_byValue.clear();
+    m_byLibId.clear();
+    m_byUuid.clear();
+    m_screenSheets.clear();
+    m_symbolKeys.clear();
+    m_dirty = false;
+
+    if( !m_schematic )
+        return;
+
+    for( const SCH_SHEET_PATH& sheet : *m_schematic->HierarchySnapshot() )
+    {
+        if( !sheet.LastScreen() )
+            continue;
+
+        m_screenSheets[sheet.LastScreen()].push_back( m_sheets.size() );
+        m_sheets.push_back( sheet );
+    }
+
+    std::vector<const SCH_SCREEN*> screens;
+
+    for( const SCH_SHEET_PATH& sheet : m_sheets )
+    {
+        const SCH_SCREEN* screen = sheet.LastScreen();
+
+        if( std::find( screens.begin(), screens.end(), screen ) != screens.end() )
+            continue;
+
+        screens.push_back( screen );
+
+        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
+            addSymbol( static_cast<SCH_SYMBOL*>( item ) );
+    }
+}
+
+
+void SCH_SYMBOL_INDEX::addSymbol( SCH_SYMBOL* aSymbol )
+{
+    // Adding something already indexed (e.g. reported again when its commit is pushed) must
+    // not duplicate it.
+    removeSymbol( aSymbol );
+
+    EDA_ITEM* parent = aSymbol->GetParent();
+
+    if( !parent || parent->Type() != SCH_SCREEN_T )
+        return;
+
+    auto sheetsIt = m_screenSheets.find( static_cast<SCH_SCREEN*>( parent ) );
+
+    if( sheetsIt == m_screenSheets.end() )
+    {
+        // A screen we have not seen; the hierarchy changed under us
+        m_dirty = true;
+        return;
+    }
+
+    std::vector<std::pair<KEY, wxString>>& keys = m_symbolKeys[aSymbol];
+
+    auto add =
+            [&]( KEY aKey, const wxString& aText, size_t aSheetIndex )
+            {
+                if( aText.IsEmpty() )
+                    return;
+
+                wxString lower = aText.Lower();
+                map( aKey )[lower].push_back( { aSymbol, aSheetIndex } );
+                keys.emplace_back( aKey, lower );
+            };
+
+    wxString value = aSymbol->GetValue( false, nullptr, false );
+    wxString libId = aSymbol->GetLibId().Format();
+    wxString itemName = wxString::FromUTF8( aSymbol->GetLibId().GetLibItemName().c_str() );
+
+    for( size_t sheetIndex : sheetsIt->second )
+    {
+        add( KEY::REFERENCE, aSymbol->GetRef( &m_sheets[sheetIndex], false ), sheetIndex );
+        add( KEY::VALUE, value, sheetIndex );
+        add( KEY::LIB_ID, libId, sheetIndex );
+
+        if( itemName.CmpNoCase( libId ) != 0 )
+            add( KEY::LIB_ID, itemName, sheetIndex );
+
+        m_byUuid[aSymbol->m_Uuid].push_back( { aSymbol, sheetIndex } );
+    }
+}
+
+
+void SCH_SYMBOL_INDEX::removeSymbol( SCH_SYMBOL* aSymbol )
+{
+    auto keysIt = m_symbolKeys.find( aSymbol );
+
+    if( keysIt == m_symbolKeys.end() )
+        return;
+
+    auto eraseFrom =
+            [aSymbol]( std::vector<ENTRY>& aEntries )
+            {
+                std::erase_if( aEntries,
+                               [aSymbol]( const ENTRY& aEntry )
+                               {
+                                   return aEntry.symbol == aSymbol;
+                               } );
+            };
+
+    for( const auto& [key, text] : keysIt->second )
+    {
+        TEXT_MAP& textMap = map( key );
+        auto      it = textMap.find( text );
+
+        if( it == textMap.end() )
+            continue;
+
+        eraseFrom( it->second );
+
+        if( it->second.empty() )
+            textMap.erase( it );
+    }
+
+    auto uuidIt = m_byUuid.find( aSymbol->m_Uuid );
+
+    if( uuidIt != m_byUuid.end() )
+    {
+        eraseFrom( uuidIt->second );
+
+        if( uuidIt->second.empty() )
+            m_byUuid.erase( uuidIt );
+    }
+
+    m_symbolKeys.erase( keysIt );
+}
+
+
+SCH_SYMBOL* SCH_SYMBOL_INDEX::symbolOf( SCH_ITEM* aItem )
+{
+    if( !aItem )
+        return nullptr;
+
+    if( aItem->Type() == SCH_SYMBOL_T )
+        return static_cast<SCH_SYMBOL*>( aItem );
+
+    // Reference and value live in fields, which may be committed on their own
+    if( aItem->Type() == SCH_FIELD_T && aItem->GetParent()
+        && aItem->GetParent()->Type() == SCH_SYMBOL_T )
+    {
+        return static_cast<SCH_SYMBOL*>( aItem->GetParent() );
+    }
+
+    return nullptr;
+}
+
+
+bool SCH_SYMBOL_INDEX::checkHierarchy( const std::vector<SCH_ITEM*>& aItems )
+{
+    for( const SCH_ITEM* item : aItems )
+    {
+        if( item && item->Type() == SCH_SHEET_T )
+        {
+            m_dirty = true;
+            return true;
+        }
+    }
+
+    return m_dirty;
+}
+
+
+void SCH_SYMBOL_INDEX::OnSchItemsAdded( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    if( checkHierarchy( aItems ) )
+        return;
+
+    for( SCH_ITEM* item : aItems )
+    {
+        if( SCH_SYMBOL* symbol = symbolOf( item ) )
+            addSymbol( symbol );
+    }
+}
+
+
+void SCH_SYMBOL_INDEX::OnSchItemsRemoved( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    if( checkHierarchy( aItems ) )
+        return;
+
+    for( SCH_ITEM* item : aItems )
+    {
+        if( item && item->Type() == SCH_SYMBOL_T )
+            removeSymbol( static_cast<SCH_SYMBOL*>( item ) );
+        else if( SCH_SYMBOL* symbol = symbolOf( item ) )
+            addSymbol( symbol );    // A field was removed from a symbol that is still there
+    }
+}
+
+
+void SCH_SYMBOL_INDEX::OnSchItemsChanged( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    if( checkHierarchy( aItems ) )
+        return;
+
+    for( SCH_ITEM* item : aItems )
+    {
+        if( SCH_SYMBOL* symbol = symbolOf( item ) )
+            addSymbol( symbol );
+    }
+}
+
+
+SCH_SYMBOL_INDEX::MATCH SCH_SYMBOL_INDEX::Find( KEY aKey, const wxString& aText,
+                                                const SCH_SHEET_PATH* aSheet )
+{
+    if( m_dirty )
+        rebuild();
+
+    MATCH match;
+
+    TEXT_MAP& textMap = map( aKey );
+    auto      it = textMap.find( aText.Lower() );
+
+    if( it == textMap.end() )
+        return match;
+
+    const ENTRY* best = nullptr;
+
+    for( const ENTRY& entry : it->second )
+    {
+        if( aSheet && m_sheets[entry.sheetIndex] != *aSheet )
+            continue;
+
+        if( !best || entry.sheetIndex < best->sheetIndex )
+            best = &entry;
+    }
+
+    if( best )
+    {
+        match.symbol = best->symbol;
+        match.sheet = m_sheets[best->sheetIndex];
+    }
+
+    return match;
+}
+
+
+std::vector<SCH_SYMBOL_INDEX::MATCH> SCH_SYMBOL_INDEX::FindByUuid( const KIID& aUuid )
+{
+    if( m_dirty )
+        rebuild();
+
+    std::vector<MATCH> matches;
+    auto               it = m_byUuid.find( aUuid );
+
+    if( it != m_byUuid.end() )
+    {
+        for( const ENTRY& entry : it->second )
+            matches.push_back( { entry.symbol, m_sheets[entry.sheetIndex] } );
+    }
+
+    return matches;
+}
@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_SYMBOL_INDEX_H
+#define SCH_SYMBOL_INDEX_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <core/wx_stl_compat.h>
+#include <kiid.h>
+#include <schematic.h>
+#include <sch_sheet_path.h>
+
+class SCH_SCREEN;
+class SCH_SYMBOL;
+
+
+/**
+ * Hash lookup of the symbols of a schematic by reference, value, library id and UUID.
+ *
+ * The index listens to the schematic and updates the entries of added, removed and changed
+ * symbols in place.  Changes to sheets alter the hierarchy itself, so they cause a rebuild on
+ * the next query instead.  Text keys are matched case-insensitively.
+ *
+ * Items that are put on a screen before their commit is pushed (e.g. inside a batch) are not
+ * reported by the schematic yet; pass them to OnSchItemsAdded() directly to make them findable.
+ */
+class SCH_SYMBOL_INDEX : public SCHEMATIC_LISTENER
+{
+public:
+    enum class KEY
+    {
+        REFERENCE,
+        VALUE,
+        LIB_ID      ///< Either the full "lib:name" or just the item name
+    };
+
+    struct MATCH
+    {
+        SCH_SYMBOL*    symbol = nullptr;
+        SCH_SHEET_PATH sheet;
+    };
+
+    SCH_SYMBOL_INDEX();
+
+    /// Start listening to \a aSchematic and drop everything indexed for a previous one.
+    void SetSchematic( SCHEMATIC* aSchematic );
+
+    /// Force a rebuild on the next query.
+    void Invalidate() { m_dirty = true; }
+
+    /**
+     * Return the first symbol (in hierarchy order) whose \a aKey matches \a aText.
+     *
+     * @param aSheet restricts the search to one sheet when not null.
+     */
+    MATCH Find( KEY aKey, const wxString& aText, const SCH_SHEET_PATH* aSheet = nullptr );
+
+    /// Return every instance of the symbol with the given UUID.
+    std::vector<MATCH> FindByUuid( const KIID& aUuid );
+
+    void OnSchItemsAdded( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+    void OnSchItemsRemoved( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+    void OnSchItemsChanged( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+
+private:
+    struct ENTRY
+    {
+        SCH_SYMBOL* symbol;
+        size_t      sheetIndex;     ///< Position of the sheet in m_sheets
+    };
+
+    using TEXT_MAP = std::unordered_map<wxString, std::vector<ENTRY>>;
+
+    void rebuild();
+
+    void addSymbol( SCH_SYMBOL* aSymbol );
+    void removeSymbol( SCH_SYMBOL* aSymbol );
+
+    /// Map an added/changed item to the symbol owning it, or null.
+    static SCH_SYMBOL* symbolOf( SCH_ITEM* aItem );
+
+    /// Mark the index dirty if \a aItems contains anything changing the hierarchy.
+    bool checkHierarchy( const std::vector<SCH_ITEM*>& aItems );
+
+    TEXT_MAP& map( KEY aKey );
+
+private:
+    SCHEMATIC*                  m_schematic;
+    bool                        m_dirty;
+
+    std::vector<SCH_SHEET_PATH> m_sheets;       ///< Hierarchy order
+    TEXT_MAP                    m_byRef;
+    TEXT_MAP                    m_byValue;
+    TEXT_MAP                    m_byLibId;
+    std::unordered_map<KIID, std::vector<ENTRY>> m_byUuid;
+
+    /// Indices into m_sheets of every sheet showing a screen
+    std::unordered_map<const SCH_SCREEN*, std::vector<size_t>> m_screenSheets;
+
+    /// Keys each symbol was indexed under, so it can be removed again
+    std::unordered_map<const SCH_SYMBOL*, std::vector<std::pair<KEY, wxString>>> m_symbolKeys;
+};
+
+#endif // SCH_SYMBOL_INDEX_H
@@ -0,0 +1,362 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sch_wire_router.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <queue>
+
+#include <sch_label.h>
+#include <sch_line.h>
+#include <sch_rtree.h>
+#include <sch_sheet.h>
+#include <sch_sheet_pin.h>
+#include <sch_symbol.h>
+
+
+/// Largest grid Build() will allocate; bigger areas are left to the caller's fallback
+static const size_t MAX_CELLS = 8 * 1024 * 1024;
+
+// Directions, ordered so that d ^ 1 is the opposite of d
+static const int DIR_X[4] = { 1, -1, 0, 0 };
+static const int DIR_Y[4] = { 0, 0, 1, -1 };
+
+
+static int floorDiv( int aValue, int aDivisor )
+{
+    int q = aValue / aDivisor;
+    return ( aValue % aDivisor != 0 && ( aValue < 0 ) != ( aDivisor < 0 ) ) ? q - 1 : q;
+}
+
+
+SCH_WIRE_ROUTER::SCH_WIRE_ROUTER( int aGrid ) :
+        m_grid( std::max( 1, aGrid ) ),
+        m_width( 0 ),
+        m_height( 0 )
+{
+}
+
+
+bool SCH_WIRE_ROUTER::toCell( const VECTOR2I& aPoint, int& aX, int& aY ) const
+{
+    aX = floorDiv( aPoint.x - m_origin.x + m_grid / 2, m_grid );
+    aY = floorDiv( aPoint.y - m_origin.y + m_grid / 2, m_grid );
+
+    return aX >= 0 && aY >= 0 && aX < m_width && aY < m_height;
+}
+
+
+bool SCH_WIRE_ROUTER::Covers( const VECTOR2I& aStart, const VECTOR2I& aEnd ) const
+{
+    int x, y;
+
+    for( const VECTOR2I& pt : { aStart, aEnd } )
+    {
+        if( ( pt.x - m_origin.x ) % m_grid != 0 || ( pt.y - m_origin.y ) % m_grid != 0 )
+            return false;
+
+        if( !toCell( pt, x, y ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+void SCH_WIRE_ROUTER::markBox( const BOX2I& aBox, uint8_t aFlag )
+{
+    BOX2I box = aBox;
+    box.Normalize();
+
+    // Every grid point inside the box or on its outline
+    int x0 = std::max( 0, -floorDiv( m_origin.x - box.GetLeft(), m_grid ) );
+    int y0 = std::max( 0, -floorDiv( m_origin.y - box.GetTop(), m_grid ) );
+    int x1 = std::min( m_width - 1, floorDiv( box.GetRight() - m_origin.x, m_grid ) );
+    int y1 = std::min( m_height - 1, floorDiv( box.GetBottom() - m_origin.y, m_grid ) );
+
+    for( int y = y0; y <= y1; ++y )
+    {
+        for( int x = x0; x <= x1; ++x )
+            cell( x, y ) |= aFlag;
+    }
+}
+
+
+void SCH_WIRE_ROUTER::markPoint( const VECTOR2I& aPoint, uint8_t aFlag )
+{
+    int x, y;
+
+    if( toCell( aPoint, x, y ) )
+        cell( x, y ) |= aFlag;
+}
+
+
+void SCH_WIRE_ROUTER::markSegment( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+{
+    int x0, y0, x1, y1;
+
+    toCell( aStart, x0, y0 );
+    toCell( aEnd, x1, y1 );
+
+    if( aStart.y == aEnd.y )
+    {
+        if( y0 >= 0 && y0 < m_height )
+        {
+            for( int x = std::max( 0, std::min( x0, x1 ) ); x <= std::min( m_width - 1, std::max( x0, x1 ) ); ++x )
+                cell( x, y0 ) |= WIRE_H;
+        }
+    }
+    else if( aStart.x == aEnd.x )
+    {
+        if( x0 >= 0 && x0 < m_width )
+        {
+            for( int y = std::max( 0, std::min( y0, y1 ) ); y <= std::min( m_height - 1, std::max( y0, y1 ) ); ++y )
+                cell( x0, y ) |= WIRE_V;
+        }
+    }
+    else
+    {
+        // Not expected on a schematic, but don't route through it
+        markBox( BOX2I( aStart, aEnd - aStart ), SOFT );
+    }
+
+    markPoint( aStart, POINT );
+    markPoint( aEnd, POINT );
+}
+
+
+void SCH_WIRE_ROUTER::Build( const EE_RTREE& aItems, const BOX2I& aArea )
+{
+    BOX2I area = aArea;
+    area.Normalize();
+    area.Inflate( MARGIN_CELLS * m_grid );
+
+    m_origin = VECTOR2I( floorDiv( area.GetLeft(), m_grid ) * m_grid,
+                         floorDiv( area.GetTop(), m_grid ) * m_grid );
+    m_width = ( area.GetRight() - m_origin.x ) / m_grid + 1;
+    m_height = ( area.GetBottom() - m_origin.y ) / m_grid + 1;
+
+    if( size_t( m_width ) * m_height > MAX_CELLS )
+    {
+        m_width = 0;
+        m_height = 0;
+        m_cells.clear();
+        return;
+    }
+
+    m_cells.assign( size_t( m_width ) * m_height, 0 );
+
+    for( SCH_ITEM* item : aItems.Overlapping( area ) )
+    {
+        switch( item->Type() )
+        {
+        case SCH_SYMBOL_T:
+        {
+            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+            markBox( symbol->GetBodyAndPinsBoundingBox(), SOFT );
+            markBox( symbol->GetBodyBoundingBox(), BLOCKED );
+            break;
+        }
+
+        case SCH_SHEET_T:
+        {
+            SCH_SHEET* sheet = static_cast<SCH_SHEET*>( item );
+
+            markBox( sheet->GetBodyBoundingBox(), BLOCKED );
+
+            for( SCH_SHEET_PIN* pin : sheet->GetPins() )
+                markPoint( pin->GetPosition(), POINT );
+
+            break;
+        }
+
+        case SCH_LINE_T:
+        {
+            SCH_LINE* line = static_cast<SCH_LINE*>( item );
+
+            if( line->IsWire() || line->IsBus() )
+                markSegment( line->GetStartPoint(), line->GetEndPoint() );
+
+            break;
+        }
+
+        case SCH_LABEL_T:
+        case SCH_GLOBAL_LABEL_T:
+        case SCH_HIER_LABEL_T:
+        case SCH_DIRECTIVE_LABEL_T:
+            markBox( item->GetBoundingBox(), SOFT );
+            break;
+
+        default:
+            break;
+        }
+
+        for( const VECTOR2I& pt : item->GetConnectionPoints() )
+            markPoint( pt, POINT );
+    }
+}
+
+
+void SCH_WIRE_ROUTER::AddWire( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+{
+    if( !m_cells.empty() )
+        markSegment( aStart, aEnd );
+}
+
+
+std::vector<VECTOR2I> SCH_WIRE_ROUTER::Route( const VECTOR2I& aStart, const VECTOR2I& aEnd ) const
+{
+    std::vector<VECTOR2I> path;
+    int                   sx, sy, ex, ey;
+
+    if( aStart == aEnd || !Covers( aStart, aEnd ) )
+        return path;
+
+    toCell( aStart, sx, sy );
+    toCell( aEnd, ex, ey );
+
+    const size_t cellCount = size_t( m_width ) * m_height;
+    const size_t startCell = size_t( sy ) * m_width + sx;
+
+    // One state per (cell, direction of arrival), so that bends can be charged
+    std::vector<int>     cost( cellCount * 4, INT_MAX );
+    std::vector<int32_t> from( cellCount * 4, -1 );
+
+    using NODE = std::pair<int, int32_t>;    // (estimated total cost, state)
+    std::priority_queue<NODE, std::vector<NODE>, std::greater<NODE>> open;
+
+    auto heuristic =
+            [&]( int aX, int aY )
+            {
+                return ( std::abs( aX - ex ) + std::abs( aY - ey ) ) * STEP_COST;
+            };
+
+    for( int d = 0; d < 4; ++d )
+    {
+        cost[startCell * 4 + d] = 0;
+        open.emplace( heuristic( sx, sy ), int32_t( startCell * 4 + d ) );
+    }
+
+    int32_t goal = -1;
+
+    while( !open.empty() )
+    {
+        auto [estimate, state] = open.top();
+        open.pop();
+
+        const size_t c = size_t( state ) / 4;
+        const int    d = state % 4;
+        const int    x = int( c % m_width );
+        const int    y = int( c / m_width );
+        const int    g = cost[state];
+
+        if( estimate > g + heuristic( x, y ) )
+            continue;   // Superseded by a cheaper path
+
+        if( x == ex && y == ey )
+        {
+            goal = state;
+            break;
+        }
+
+        const uint8_t here = cell( x, y );
+
+        for( int nd = 0; nd < 4; ++nd )
+        {
+            const bool atStart = c == startCell;
+            const bool bend = !atStart && nd != d;
+
+            if( !atStart && nd == ( d ^ 1 ) )
+                continue;
+
+            // A corner on an existing wire would connect to it
+            if( bend && ( here & ( WIRE_H | WIRE_V ) ) )
+                continue;
+
+            const int nx = x + DIR_X[nd];
+            const int ny = y + DIR_Y[nd];
+
+            if( nx < 0 || ny < 0 || nx >= m_width || ny >= m_height )
+                continue;
+
+            const uint8_t next = cell( nx, ny );
+            const bool    horizontal = nd < 2;
+            const bool    isEnd = nx == ex && ny == ey;
+            int           ng = g + STEP_COST + ( bend ? BEND_COST : 0 );
+
+            if( !isEnd )
+            {
+                if( next & ( BLOCKED | POINT ) )
+                    continue;
+
+                // Running along a wire would merge the nets
+                if( next & ( horizontal ? WIRE_H : WIRE_V ) )
+                    continue;
+
+                if( next & ( horizontal ? WIRE_V : WIRE_H ) )
+                    ng += CROSS_COST;
+            }
+
+            if( next & SOFT )
+                ng += SOFT_COST;
+
+            const int32_t ns = int32_t( ( size_t( ny ) * m_width + nx ) * 4 + nd );
+
+            if( ng < cost[ns] )
+            {
+                cost[ns] = ng;
+                from[ns] = state;
+                open.emplace( ng + heuristic( nx, ny ), ns );
+            }
+        }
+    }
+
+    if( goal < 0 )
+        return path;
+
+    // Walk back, keeping only the cells where the direction changes
+    std::vector<int32_t> states;
+
+    for( int32_t s = goal; s >= 0; s = from[s] )
+        states.push_back( s );
+
+    std::reverse( states.begin(), states.end() );
+
+    auto toPoint =
+            [&]( int32_t aState )
+            {
+                size_t c = size_t( aState ) / 4;
+                return VECTOR2I( m_origin.x + int( c % m_width ) * m_grid,
+                                 m_origin.y + int( c / m_width ) * m_grid );
+            };
+
+    path.push_back( aStart );
+
+    for( size_t ii = 1; ii + 1 < states.size(); ++ii )
+    {
+        if( states[ii] % 4 != states[ii + 1] % 4 )
+            path.push_back( toPoint( states[ii] ) );
+    }
+
+    path.push_back( aEnd );
+    return path;
+}
@@ -0,0 +1,113 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_WIRE_ROUTER_H
+#define SCH_WIRE_ROUTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <math/box2.h>
+#include <math/vector2d.h>
+
+class EE_RTREE;
+
+
+/**
+ * Orthogonal wire router on the connection grid of a sheet.
+ *
+ * The items of a screen are rasterized once into an occupancy grid: symbol bodies and sheets
+ * are blocked, the pin area around symbol bodies and labels cost extra, and existing wires and
+ * connection points are recorded so a route never runs along a wire or touches a point it
+ * would connect to.  Routes are found with A* over (cell, direction) states, so bends are
+ * penalized and the result has few corners.
+ *
+ * The grid is only rebuilt by Build(); wires placed by the caller afterwards are added with
+ * AddWire(), so a batch of routes costs one rasterization plus one search per wire.
+ */
+class SCH_WIRE_ROUTER
+{
+public:
+    /**
+     * @param aGrid is the routing grid, normally the connection grid of the schematic.
+     */
+    SCH_WIRE_ROUTER( int aGrid );
+
+    /**
+     * Rasterize \a aItems over \a aArea (extended by a margin so routes can go around the
+     * outermost items).
+     */
+    void Build( const EE_RTREE& aItems, const BOX2I& aArea );
+
+    /// @return true if both points lie on the routing grid inside the built area.
+    bool Covers( const VECTOR2I& aStart, const VECTOR2I& aEnd ) const;
+
+    /// Record a wire added after Build(), e.g. an earlier route of the same batch.
+    void AddWire( const VECTOR2I& aStart, const VECTOR2I& aEnd );
+
+    /**
+     * Find the cheapest orthogonal route from \a aStart to \a aEnd.
+     *
+     * @return the start point, the corners and the end point, or an empty list if the points
+     *         are not covered by the grid or no route exists.
+     */
+    std::vector<VECTOR2I> Route( const VECTOR2I& aStart, const VECTOR2I& aEnd ) const;
+
+    int GetGrid() const { return m_grid; }
+
+    // Costs, in tenths of a grid step
+    static constexpr int STEP_COST = 10;
+    static constexpr int BEND_COST = 30;
+    static constexpr int CROSS_COST = 50;     ///< Crossing an existing wire
+    static constexpr int SOFT_COST = 40;      ///< Entering a pin area or a label
+
+    /// Free cells kept around the area given to Build()
+    static constexpr int MARGIN_CELLS = 10;
+
+private:
+    enum CELL : uint8_t
+    {
+        BLOCKED = 1 << 0,
+        SOFT    = 1 << 1,
+        WIRE_H  = 1 << 2,     ///< A horizontal wire runs through the cell
+        WIRE_V  = 1 << 3,
+        POINT   = 1 << 4      ///< A connection point: pin, wire end, junction, label
+    };
+
+    bool toCell( const VECTOR2I& aPoint, int& aX, int& aY ) const;
+
+    void markBox( const BOX2I& aBox, uint8_t aFlag );
+
+    void markPoint( const VECTOR2I& aPoint, uint8_t aFlag );
+
+    void markSegment( const VECTOR2I& aStart, const VECTOR2I& aEnd );
+
+    uint8_t& cell( int aX, int aY ) { return m_cells[size_t( aY ) * m_width + aX]; }
+
+    uint8_t cell( int aX, int aY ) const { return m_cells[size_t( aY ) * m_width + aX]; }
+
+private:
+    int                  m_grid;
+    VECTOR2I             m_origin;
+    int                  m_width;
+    int                  m_height;
+    std::vector<uint8_t> m_cells;
+};
+
+#endif // SCH_WIRE_ROUTER_H
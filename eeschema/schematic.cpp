@@ -159,7 +159,8 @@ void SCHEMATIC::Reset()
 
     m_rootSheet = nullptr;
     m_topLevelSheets.clear();
-    m_hierarchy.clear();
+    m_hierarchy.reset();
+    m_hierarchyGeneration++;
 
     m_connectionGraph->Reset();
     m_currentSheet->clear();
@@ -391,16 +392,64 @@ SCH_SCREEN* SCHEMATIC::RootScreen() const
 
 SCH_SHEET_LIST SCHEMATIC::Hierarchy() const
 {
-    wxCHECK( !m_hierarchy.empty(), m_hierarchy );
+    wxCHECK( HasHierarchy(), SCH_SHEET_LIST() );
 
-    return m_hierarchy;
+    return *m_hierarchy;
+}
+
+
+std::shared_ptr<const SCH_SHEET_LIST> SCHEMATIC::HierarchySnapshot() const
+{
+    static const std::shared_ptr<const SCH_SHEET_LIST> empty = std::make_shared<SCH_SHEET_LIST>();
+
+    return m_hierarchy ? m_hierarchy : empty;
+}
+
+
+/**
+ * @return true if both lists hold the same paths in the same order, with the same page numbers.
+ *         Sheets are compared by address: undo and redo recreate sheets with the same UUID.
+ */
+static bool sameHierarchy( const SCH_SHEET_LIST& aA, const SCH_SHEET_LIST& aB )
+{
+    if( aA.size() != aB.size() )
+        return false;
+
+    for( size_t ii = 0; ii < aA.size(); ++ii )
+    {
+        const SCH_SHEET_PATH& a = aA[ii];
+        const SCH_SHEET_PATH& b = aB[ii];
+
+        if( a.size() != b.size() || a.GetVirtualPageNumber() != b.GetVirtualPageNumber()
+                || a.GetCachedPageNumber() != b.GetCachedPageNumber() )
+        {
+            return false;
+        }
+
+        for( size_t jj = 0; jj < a.size(); ++jj )
+        {
+            if( a.at( jj ) != b.at( jj ) )
+                return false;
+        }
+    }
+
+    return true;
 }
 
 
 void SCHEMATIC::RefreshHierarchy()
 {
     ensureDefaultTopLevelSheet();
-    m_hierarchy = BuildSheetListSortedByPageNumbers();
+
+    SCH_SHEET_LIST hierarchy = BuildSheetListSortedByPageNumbers();
+
+    // This runs on every connectivity update; keep the snapshot (and what callers derived from
+    // it) unless something actually changed
+    if( m_hierarchy && sameHierarchy( *m_hierarchy, hierarchy ) )
+        return;
+
+    m_hierarchy = std::make_shared<const SCH_SHEET_LIST>( std::move( hierarchy ) );
+    m_hierarchyGeneration++;
 }
 
 
@@ -868,7 +917,7 @@ std::map<int, wxString> SCHEMATIC::GetVirtualPageToSheetNamesMap() const
 {
     std::map<int, wxString> namesMap;
 
-    for( const SCH_SHEET_PATH& sheet : Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *HierarchySnapshot() )
     {
         if( sheet.size() == 1 )
             namesMap[sheet.GetVirtualPageNumber()] = _( "<root sheet>" );
@@ -884,7 +933,7 @@ std::map<int, wxString> SCHEMATIC::GetVirtualPageToSheetPagesMap() const
 {
     std::map<int, wxString> pagesMap;
 
-    for( const SCH_SHEET_PATH& sheet : Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *HierarchySnapshot() )
         pagesMap[sheet.GetVirtualPageNumber()] = sheet.GetPageNumber();
 
     return pagesMap;
@@ -1133,7 +1182,7 @@ void SCHEMATIC::SetSheetNumberAndCount()
 
     // @todo Remove all pseudo page number system is left over from prior to real page number
     //       implementation.
-    for( const SCH_SHEET_PATH& sheet : Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *HierarchySnapshot() )
     {
         if( sheet.Path() == current_sheetpath ) // Current sheet path found
             break;
@@ -1156,7 +1205,7 @@ void SCHEMATIC::RecomputeIntersheetRefs()
 
     pageRefsMap.clear();
 
-    for( const SCH_SHEET_PATH& sheet : Hierarchy() )
+    for( const SCH_SHEET_PATH& sheet : *HierarchySnapshot() )
     {
         for( SCH_ITEM* item : sheet.LastScreen()->Items().OfType( SCH_GLOBAL_LABEL_T ) )
         {
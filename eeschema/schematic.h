@@ -114,12 +114,27 @@ public:
      */
     SCH_SHEET_LIST Hierarchy() const;
 
+    /**
+     * Return the cached hierarchy, sorted by page number, without copying it.
+     *
+     * A snapshot is never modified: RefreshHierarchy() replaces it with a new one when the
+     * sheets or their order changed, so it can be kept and iterated while the schematic is
+     * edited.  Empty if the hierarchy has not been built.
+     */
+    std::shared_ptr<const SCH_SHEET_LIST> HierarchySnapshot() const;
+
+    /**
+     * @return a counter bumped each time the hierarchy snapshot is replaced, for caches derived
+     *         from the hierarchy to check whether they are stale.
+     */
+    uint64_t GetHierarchyGeneration() const { return m_hierarchyGeneration; }
+
     /**
      * Check if the hierarchy has been built.
      *
      * @return true if RefreshHierarchy() has been called and the hierarchy is populated.
      */
-    bool HasHierarchy() const { return !m_hierarchy.empty(); }
+    bool HasHierarchy() const { return m_hierarchy && !m_hierarchy->empty(); }
 
     void RefreshHierarchy();
 
@@ -597,7 +612,8 @@ private:
     /**
      * Cache of the entire schematic hierarchy sorted by sheet page number.
      */
-    SCH_SHEET_LIST m_hierarchy;
+    std::shared_ptr<const SCH_SHEET_LIST> m_hierarchy;
+    uint64_t                              m_hierarchyGeneration = 0;
 
     /**
      * Currently installed listeners.
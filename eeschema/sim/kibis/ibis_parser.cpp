@@ -36,6 +36,7 @@
 #include <cstring> //for memcmp
 #include <iterator>
 #include <locale_io.h> // KiCad header
+#include <kiplatform/io.h>
 #include <wx/log.h>
 
 // _() is used here to mark translatable strings in IBIS_REPORTER::Report()
@@ -988,20 +989,43 @@ bool IbisParser::ParseFile( const std::string& aFileName )
 {
     std::stringstream err_msg;
 
-    std::ifstream ibisFile;
-    ibisFile.open( aFileName );
+    // Copy the file once from a mapping, dropping the carriage returns a text mode stream
+    // would have dropped, instead of going through a string stream and two more copies.
+    KIPLATFORM::IO::MAPPED_FILE mappedFile( wxString( aFileName ) );
 
-    if( !ibisFile.is_open() )
+    if( mappedFile.IsMapped() )
     {
-        err_msg << _( "Cannot open file " ) << aFileName;
-        Report( err_msg.str(), RPT_SEVERITY_ERROR );
-        return false;
+        const char* data = mappedFile.Data();
+        size_t      fileSize = mappedFile.Size();
+
+        m_buffer.clear();
+        m_buffer.reserve( fileSize + 1 );
+
+        for( size_t ii = 0; ii < fileSize; ++ii )
+        {
+            if( data[ii] == '\r' && ii + 1 < fileSize && data[ii + 1] == '\n' )
+                continue;
+
+            m_buffer.push_back( data[ii] );
+        }
+    }
+    else
+    {
+        // Empty files can't be mapped
+        std::ifstream ibisFile;
+        ibisFile.open( aFileName );
+
+        if( !ibisFile.is_open() )
+        {
+            err_msg << _( "Cannot open file " ) << aFileName;
+            Report( err_msg.str(), RPT_SEVERITY_ERROR );
+            return false;
+        }
+
+        m_buffer.assign( std::istreambuf_iterator<char>( ibisFile ),
+                         std::istreambuf_iterator<char>() );
     }
 
-    std::ostringstream ss;
-    ss << ibisFile.rdbuf();
-    const std::string& s = ss.str();
-    m_buffer = std::vector<char>( s.begin(), s.end() );
     m_buffer.push_back( 0 );
 
     long size = m_buffer.size();
@@ -24,12 +24,15 @@
 
 #include <filename_resolver.h>
 #include <pgm_base.h>
+#include <algorithm>
+#include <mutex>
 #include <string>
 #include <string_utils.h>
 #include <common.h>
 #include <functional>
 #include <sch_symbol.h>
 #include <schematic.h>
+#include <wx/filefn.h>
 
 // Include simulator headers after wxWidgets headers to avoid conflicts with Windows headers
 // (especially on msys2 + wxWidgets 3.0.x)
@@ -41,6 +44,25 @@
 using namespace std::placeholders;
 
 
+/// A library read by some manager, along with the modification times of the files it was
+/// read from (the library file itself, then its includes).
+struct CACHED_SIM_LIBRARY
+{
+    std::shared_ptr<SIM_LIBRARY>             m_library;
+    std::vector<std::pair<wxString, time_t>> m_files;
+};
+
+// Keyed by resolved path and whether the library was fully parsed
+static std::mutex                                              s_libraryCacheMutex;
+static std::map<std::pair<wxString, bool>, CACHED_SIM_LIBRARY> s_libraryCache;
+
+
+static time_t fileModificationTime( const wxString& aPath )
+{
+    return wxFileName::FileExists( aPath ) ? wxFileModificationTime( aPath ) : 0;
+}
+
+
 SIM_LIB_MGR::SIM_LIB_MGR( const PROJECT* aPrj ) :
         m_project( aPrj ),
         m_forceFullParse( false )
@@ -146,14 +168,62 @@ void SIM_LIB_MGR::SetLibrary( const wxString& aLibraryPath, REPORTER& aReporter
         return;
     }
 
-    std::unique_ptr<SIM_LIBRARY> library = SIM_LIBRARY::Create( path, m_forceFullParse, aReporter,
+    std::shared_ptr<SIM_LIBRARY> library = loadLibrary( path, aReporter );
+
+    Clear();
+    m_libraries[path] = std::move( library );
+}
+
+
+std::shared_ptr<SIM_LIBRARY> SIM_LIB_MGR::loadLibrary( const wxString& aPath, REPORTER& aReporter )
+{
+    const std::pair<wxString, bool> key( aPath, m_forceFullParse );
+
+    {
+        std::lock_guard<std::mutex> lock( s_libraryCacheMutex );
+        auto                        it = s_libraryCache.find( key );
+
+        if( it != s_libraryCache.end() )
+        {
+            const std::vector<std::pair<wxString, time_t>>& files = it->second.m_files;
+
+            if( std::all_of( files.begin(), files.end(),
+                             []( const std::pair<wxString, time_t>& file )
+                             {
+                                 return fileModificationTime( file.first ) == file.second;
+                             } ) )
+            {
+                return it->second.m_library;
+            }
+
+            s_libraryCache.erase( it );
+        }
+    }
+
+    CACHED_SIM_LIBRARY entry;
+    REDIRECT_REPORTER  reporter( &aReporter );
+
+    // Timestamps are taken before the files are read, so that a file modified while it is being
+    // parsed is read again next time.
+    entry.m_files.emplace_back( aPath, fileModificationTime( aPath ) );
+
+    entry.m_library = SIM_LIBRARY::Create( aPath, m_forceFullParse, reporter,
             [&]( const wxString& libPath, const wxString& relativeLib ) -> wxString
             {
-                return ResolveEmbeddedLibraryPath( libPath, relativeLib, aReporter );
+                wxString resolved = ResolveEmbeddedLibraryPath( libPath, relativeLib, reporter );
+
+                entry.m_files.emplace_back( resolved, fileModificationTime( resolved ) );
+                return resolved;
             } );
 
-    Clear();
-    m_libraries[path] = std::move( library );
+    // Don't cache libraries with problems; their messages would not be reported again.
+    if( !reporter.HasMessage() )
+    {
+        std::lock_guard<std::mutex> lock( s_libraryCacheMutex );
+        s_libraryCache[key] = entry;
+    }
+
+    return entry.m_library;
 }
 
 
@@ -300,11 +370,7 @@ SIM_LIBRARY::MODEL SIM_LIB_MGR::CreateModel( const wxString& aLibraryPath,
 
     if( it == m_libraries.end() )
     {
-        it = m_libraries.emplace( path, SIM_LIBRARY::Create( path, m_forceFullParse, aReporter,
-                [&]( const wxString& libPath, const wxString& relativeLib ) -> wxString
-                {
-                    return ResolveEmbeddedLibraryPath( libPath, relativeLib, aReporter );
-                } ) ).first;
+        it = m_libraries.emplace( path, loadLibrary( path, aReporter ) ).first;
     }
 
     library = &*it->second;
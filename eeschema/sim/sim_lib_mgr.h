@@ -25,6 +25,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 
 #include <sim/sim_library.h>
@@ -85,11 +86,18 @@ public:
     wxString ResolveEmbeddedLibraryPath( const wxString& aLibPath, const wxString& aRelativeLib,
                                          REPORTER& aReporter );
 
+private:
+    /**
+     * Return the library at \a aPath, reusing the one read by any other manager as long as
+     * neither the file nor the files it includes have been modified since.
+     */
+    std::shared_ptr<SIM_LIBRARY> loadLibrary( const wxString& aPath, REPORTER& aReporter );
+
 private:
     std::vector<EMBEDDED_FILES*>                     m_embeddedFilesStack;  // no ownership
     const PROJECT*                                   m_project;             // no ownership
     bool                                             m_forceFullParse;
-    std::map<wxString, std::unique_ptr<SIM_LIBRARY>> m_libraries;
+    std::map<wxString, std::shared_ptr<SIM_LIBRARY>> m_libraries;
     std::vector<std::unique_ptr<SIM_MODEL>>          m_models;
 };
 
@@ -25,11 +25,77 @@
 #include <sim/sim_model_ibis.h>
 #include <sim/sim_library_ibis.h>
 #include <fmt/core.h>
+#include <wx/filefn.h>
 #include <wx/filename.h>
 #include <kiway.h>
 #include <schematic.h>
 #include "sim_lib_mgr.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+
+namespace
+{
+/**
+ * A parsed IBIS file and the devices already generated from it.  Vendor IBIS files of large
+ * parts take seconds to parse, and every IBIS symbol of a schematic used to parse its file
+ * again each time a netlist was generated.
+ */
+struct IBIS_FILE_CACHE_ENTRY
+{
+    time_t                             m_modTime = 0;
+    wxULongLong                        m_size = 0;
+    std::shared_ptr<KIBIS>             m_kibis;
+    std::map<std::string, std::string> m_devices;   ///< Device lines, by generation inputs
+    uint64_t                           m_lastUse = 0;
+};
+
+
+const size_t MAX_CACHED_IBIS_FILES = 8;
+
+std::mutex                                g_ibisCacheMutex;
+std::map<wxString, IBIS_FILE_CACHE_ENTRY> g_ibisCache;
+uint64_t                                  g_ibisCacheUse = 0;
+
+
+/**
+ * Return the cache entry of \a aPath, parsing the file again if it changed on disk.
+ * g_ibisCacheMutex must be held.
+ */
+IBIS_FILE_CACHE_ENTRY& cachedIbisFile( const wxString& aPath )
+{
+    time_t      modTime = wxFileModificationTime( aPath );
+    wxULongLong size = wxFileName::GetSize( aPath );
+    auto        it = g_ibisCache.find( aPath );
+
+    if( it == g_ibisCache.end() && g_ibisCache.size() >= MAX_CACHED_IBIS_FILES )
+    {
+        auto oldest = std::min_element( g_ibisCache.begin(), g_ibisCache.end(),
+                                        []( const auto& a, const auto& b )
+                                        {
+                                            return a.second.m_lastUse < b.second.m_lastUse;
+                                        } );
+
+        g_ibisCache.erase( oldest );
+    }
+
+    IBIS_FILE_CACHE_ENTRY& entry = g_ibisCache[aPath];
+
+    if( !entry.m_kibis || entry.m_modTime != modTime || entry.m_size != size )
+    {
+        entry.m_modTime = modTime;
+        entry.m_size = size;
+        entry.m_kibis = std::make_shared<KIBIS>( std::string( aPath.c_str() ) );
+        entry.m_devices.clear();
+    }
+
+    entry.m_lastUse = ++g_ibisCacheUse;
+    return entry;
+}
+} // namespace
+
 std::string SPICE_GENERATOR_IBIS::ModelName( const SPICE_ITEM& aItem ) const
 {
     return fmt::format( "{}.{}", aItem.refName, aItem.baseModelName );
@@ -73,9 +139,9 @@ std::string SPICE_GENERATOR_IBIS::IbisDevice( const SPICE_ITEM& aItem, SCHEMATIC
     if( reporter.HasMessage() )
         THROW_IO_ERROR( reporter.GetMessages() );
 
-    KIBIS kibis( std::string( path.c_str() ) );
-    kibis.m_cacheDir = std::string( aCacheDir.c_str() );
-    kibis.m_Reporter = &aReporter;
+    std::lock_guard<std::mutex> lock( g_ibisCacheMutex );
+    IBIS_FILE_CACHE_ENTRY&      cached = cachedIbisFile( path );
+    KIBIS&                      kibis = *cached.m_kibis;
 
     if( !kibis.m_valid )
         THROW_IO_ERROR( wxString::Format( _( "Invalid IBIS file '%s'" ), ibisLibFilename ) );
@@ -129,6 +195,21 @@ std::string SPICE_GENERATOR_IBIS::IbisDevice( const SPICE_ITEM& aItem, SCHEMATIC
 
     //kparams.SetCornerFromString( kparams.m_Ccomp, FindParam( "ccomp" )->value );
 
+    // The device only depends on these and on the model parameters
+    std::string deviceKey = fmt::format( "{}\n{}\n{}\n{}\n{}\n{}", ibisCompName, ibisPinName,
+                                         ibisModelName, diffMode, (int) m_model.GetType(),
+                                         aItem.modelName );
+
+    for( int ii = 0; ii < m_model.GetParamCount(); ++ii )
+        deviceKey += "\n" + m_model.GetParam( ii ).value;
+
+    if( auto it = cached.m_devices.find( deviceKey ); it != cached.m_devices.end() )
+        return it->second;
+
+    kibis.m_cacheDir = std::string( aCacheDir.c_str() );
+    kibis.m_Reporter = &aReporter;
+
+    bool        hadMessages = aReporter.HasMessage();
     std::string result;
 
     switch( m_model.GetType() )
@@ -214,9 +295,16 @@ std::string SPICE_GENERATOR_IBIS::IbisDevice( const SPICE_ITEM& aItem, SCHEMATIC
 
     default:
         wxFAIL_MSG( "Unknown IBIS model type" );
-        return "";
+        break;
     }
 
+    // The cached file outlives the reporter
+    kibis.m_Reporter = nullptr;
+
+    // Don't cache a device whose generation reported something: it would not be reported again
+    if( !result.empty() && !hadMessages && !aReporter.HasMessage() )
+        cached.m_devices[deviceKey] = result;
+
     return result;
 }
 
@@ -484,6 +484,15 @@ void SIMULATOR_FRAME::StartSimulation()
 }
 
 
+void SIMULATOR_FRAME::StopSimulation()
+{
+    m_ui->CancelMultiRun();
+
+    if( m_simulator->IsRunning() )
+        m_simulator->Stop();
+}
+
+
 SIM_TAB* SIMULATOR_FRAME::NewSimTab( const wxString& aSimCommand )
 {
     return m_ui->NewSimTab( aSimCommand );
@@ -650,8 +659,7 @@ bool SIMULATOR_FRAME::canCloseWindow( wxCloseEvent& aEvent )
 
 void SIMULATOR_FRAME::doCloseWindow()
 {
-    if( m_simulator->IsRunning() )
-        m_simulator->Stop();
+    StopSimulation();
 
     // Prevent memory leak on exit by deleting all simulation vectors
     m_simulator->Clean();
@@ -99,6 +99,11 @@ public:
 
     void StartSimulation();
 
+    /**
+     * Halt the running simulation, including any remaining runs of a multi-run sweep.
+     */
+    void StopSimulation();
+
     /**
      * Create a new plot tab for a given simulation type.
      *
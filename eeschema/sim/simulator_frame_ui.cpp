@@ -3524,20 +3524,33 @@ void SIMULATOR_FRAME_UI::OnSimRefresh( bool aFinal )
         }
         else
         {
-            m_multiRunState.active = false;
-            m_multiRunState.steps.clear();
-            m_multiRunState.currentStep = 0;
-            m_multiRunState.storePending = false;
-            m_tunerOverrides.clear();
+            finishMultiRun();
+        }
+    }
+}
 
-            if( !m_multiRunState.traces.empty() )
-            {
-                auto iter = m_multiRunState.traces.begin();
 
-                if( iter != m_multiRunState.traces.end() )
-                    m_multiRunState.storedSteps = iter->second.yValues.size();
-            }
-        }
+void SIMULATOR_FRAME_UI::CancelMultiRun()
+{
+    if( m_multiRunState.active )
+        finishMultiRun();
+}
+
+
+void SIMULATOR_FRAME_UI::finishMultiRun()
+{
+    m_multiRunState.active = false;
+    m_multiRunState.steps.clear();
+    m_multiRunState.currentStep = 0;
+    m_multiRunState.storePending = false;
+    m_tunerOverrides.clear();
+
+    if( !m_multiRunState.traces.empty() )
+    {
+        auto iter = m_multiRunState.traces.begin();
+
+        if( iter != m_multiRunState.traces.end() )
+            m_multiRunState.storedSteps = iter->second.yValues.size();
     }
 }
 
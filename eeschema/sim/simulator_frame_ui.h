@@ -251,6 +251,12 @@ public:
     void OnSimReport( const wxString& aMsg );
     void OnSimRefresh( bool aFinal );
 
+    /**
+     * Stop stepping through the multi-run tuner values.  The runs already completed stay
+     * plotted; the run in progress is not stored.
+     */
+    void CancelMultiRun();
+
     void OnModify();
 
 private:
@@ -340,6 +346,7 @@ private:
     struct MULTI_RUN_STEP;
 
     void clearMultiRunState( bool aClearTraces );
+    void finishMultiRun();
     void prepareMultiRunState();
     std::vector<MULTI_RUN_STEP> calculateMultiRunSteps( const std::vector<TUNER_SLIDER*>& aTuners ) const;
     std::string multiRunTraceKey( const wxString& aVectorName, int aTraceType ) const;
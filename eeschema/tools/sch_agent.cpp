@@ -141,3 +141,12 @@ void SCH_AGENT::EndBatch( const wxString& aMessage )
     m_inBatch = false;
 }
 
+
+void SCH_AGENT::CancelBatch()
+{
+    if( m_inBatch && m_commit )
+        m_commit->Revert();
+
+    m_commit = std::make_unique<SCH_COMMIT>( m_frame );
+    m_inBatch = false;
+}
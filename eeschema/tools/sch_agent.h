@@ -83,6 +83,16 @@ public:
      */
     void EndBatch( const wxString& aMessage = _( "Batch operation" ) );
 
+    /**
+     * Abandon the current batch, reverting every change made since BeginBatch()
+     */
+    void CancelBatch();
+
+    /**
+     * @return true between BeginBatch() and EndBatch()/CancelBatch()
+     */
+    bool InBatch() const { return m_inBatch; }
+
     /**
      * Get the current commit (for advanced operations)
      */
@@ -0,0 +1,832 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sch_agent_context.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <base_units.h>
+#include <hash.h>
+#include <sch_connection.h>
+#include <sch_field.h>
+#include <sch_pin.h>
+#include <sch_screen.h>
+#include <sch_sheet.h>
+#include <sch_sheet_path.h>
+#include <sch_symbol.h>
+
+
+static const wxString TRUNCATED_MSG = wxS( "\n[TRUNCATED: schematic context exceeded size limit]\n" );
+
+// Relevance of a symbol for a ranked context.  Whatever the request names comes first, then the
+// selection and what it connects to, then what is on screen.
+static constexpr double SCORE_NAMED = 100.0;
+static constexpr double SCORE_SELECTED = 80.0;
+static constexpr double SCORE_ON_NAMED_NET = 60.0;
+static constexpr double SCORE_ON_NAMED_SHEET = 40.0;
+static constexpr double SCORE_NEIGHBOUR = 30.0;
+static constexpr double SCORE_NEAR_SELECTION = 20.0;
+static constexpr double SCORE_VISIBLE = 20.0;
+static constexpr double SCORE_CURRENT_SHEET = 10.0;
+
+// Nets with more symbols than this (power rails, mostly) don't make their symbols neighbours
+static constexpr size_t MAX_NEIGHBOUR_NET_SIZE = 16;
+
+// Share of the budget kept for the nets when the symbols don't fit
+static constexpr double NET_BUDGET_SHARE = 0.3;
+
+
+/**
+ * Split a request into upper case words, keeping the characters found in references and net
+ * names (e.g. "R12", "+3V3", "SDA_1").
+ */
+static std::set<wxString> requestWords( const wxString& aRequest )
+{
+    std::set<wxString> words;
+    wxString           word;
+
+    for( wxUniChar c : aRequest )
+    {
+        if( wxIsalnum( c ) || c == '_' || c == '+' )
+        {
+            word << c;
+        }
+        else if( !word.IsEmpty() )
+        {
+            words.insert( word.Upper() );
+            word.clear();
+        }
+    }
+
+    if( !word.IsEmpty() )
+        words.insert( word.Upper() );
+
+    return words;
+}
+
+
+/**
+ * @return true if \a aName (a net name or a sheet path) is mentioned by its full name or its
+ *         last path component.
+ */
+static bool isNamed( const std::set<wxString>& aWords, const wxString& aName )
+{
+    wxString name = aName;
+
+    if( name.EndsWith( wxS( "/" ) ) )
+        name.RemoveLast();
+
+    name = name.AfterLast( '/' ).Upper();
+
+    return !name.IsEmpty() && ( aWords.contains( name ) || aWords.contains( aName.Upper() ) );
+}
+
+
+SCH_AGENT_CONTEXT::SCH_AGENT_CONTEXT() :
+        m_schematic( nullptr ),
+        m_allDirty( true ),
+        m_netsDirty( true ),
+        m_netMapDirty( true ),
+        m_haveBaseline( false )
+{
+}
+
+
+void SCH_AGENT_CONTEXT::SetSchematic( SCHEMATIC* aSchematic )
+{
+    m_schematic = aSchematic;
+
+    // AddListener() ignores duplicates, so this is safe after a schematic reload
+    if( m_schematic )
+        m_schematic->AddListener( this );
+
+    Invalidate();
+}
+
+
+void SCH_AGENT_CONTEXT::Invalidate()
+{
+    m_sheets.clear();
+    m_order.clear();
+    m_nets.clear();
+    m_netText.clear();
+    m_dirtyScreens.clear();
+    m_allDirty = true;
+    m_netsDirty = true;
+    m_netMapDirty = true;
+
+    m_haveBaseline = false;
+    m_baselineSheets.clear();
+    m_baselineNets.clear();
+}
+
+
+void SCH_AGENT_CONTEXT::OnSchItemsAdded( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    markChanged( aItems );
+}
+
+
+void SCH_AGENT_CONTEXT::OnSchItemsRemoved( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    markChanged( aItems );
+}
+
+
+void SCH_AGENT_CONTEXT::OnSchItemsChanged( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems )
+{
+    markChanged( aItems );
+}
+
+
+void SCH_AGENT_CONTEXT::markChanged( const std::vector<SCH_ITEM*>& aItems )
+{
+    for( const SCH_ITEM* item : aItems )
+    {
+        if( !item )
+            continue;
+
+        // Sheets carry page numbers and names shown in their children's sections, and adding
+        // or removing one changes the hierarchy itself.
+        if( item->Type() == SCH_SHEET_T || item->Type() == SCH_SHEET_PIN_T )
+        {
+            m_allDirty = true;
+            m_netsDirty = true;
+            continue;
+        }
+
+        const EDA_ITEM* parent = item;
+
+        while( parent && parent->Type() != SCH_SCREEN_T )
+            parent = parent->GetParent();
+
+        if( parent )
+            m_dirtyScreens.insert( static_cast<const SCH_SCREEN*>( parent ) );
+        else
+            m_allDirty = true;
+
+        if( item->IsConnectable() )
+            m_netsDirty = true;
+    }
+}
+
+
+void SCH_AGENT_CONTEXT::formatSheet( const SCH_SHEET_PATH& aSheet, SHEET_ENTRY& aEntry )
+{
+    SCH_SCREEN* screen = aSheet.LastScreen();
+    wxString    out;
+    size_t      signature = 0;
+
+    aEntry.nodes.clear();
+    aEntry.humanPath = aSheet.PathHumanReadable();
+
+    aEntry.symbols.clear();
+
+    out << wxS( "=== SHEET ===\n" );
+    out << wxS( "Path: " ) << aEntry.humanPath << wxS( "\n" );
+    out << wxS( "Page: " ) << aSheet.GetPageNumber() << wxS( "\n" );
+
+    if( aSheet.Last() )
+        out << wxS( "File: " ) << aSheet.Last()->GetFileName() << wxS( "\n" );
+
+    aEntry.header = out;
+
+    int componentCount = 0;
+
+    for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
+    {
+        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+        if( !symbol )
+            continue;
+
+        componentCount++;
+
+        wxString ref = symbol->GetRef( &aSheet, true );
+        wxString libId = symbol->GetLibId().Format();
+        VECTOR2I symPos = symbol->GetPosition();
+        double   sx = schIUScale.IUTomm( symPos.x );
+        double   sy = schIUScale.IUTomm( symPos.y );
+        int      orientProp = static_cast<int>( symbol->GetOrientationProp() ); // 0/90/180/270
+
+        wxString value;
+        wxString footprint;
+        wxString datasheet;
+
+        for( const SCH_FIELD& field : symbol->GetFields() )
+        {
+            if( field.GetText().IsEmpty() )
+                continue;
+
+            wxString name = field.GetName();
+
+            if( name.IsEmpty() )
+                continue;
+
+            if( name.CmpNoCase( wxS( "Value" ) ) == 0 )
+                value = field.GetText();
+            else if( name.CmpNoCase( wxS( "Footprint" ) ) == 0 )
+                footprint = field.GetText();
+            else if( name.CmpNoCase( wxS( "Datasheet" ) ) == 0 )
+                datasheet = field.GetText();
+        }
+
+        BOX2I  bbox = symbol->GetBoundingBox();
+        double bxmin = schIUScale.IUTomm( bbox.GetX() );
+        double bymin = schIUScale.IUTomm( bbox.GetY() );
+        double bxmax = schIUScale.IUTomm( bbox.GetRight() );
+        double bymax = schIUScale.IUTomm( bbox.GetBottom() );
+        double width = bxmax - bxmin;
+        double height = bymax - bymin;
+
+        SYMBOL_ENTRY& symEntry = aEntry.symbols.emplace_back();
+
+        symEntry.uuid = symbol->m_Uuid;
+        symEntry.ref = ref;
+        symEntry.bbox = bbox;
+        symEntry.text = wxString::Format( wxS( " - %s (%s) value=%s footprint=%s datasheet=%s pos=(%.2f, %.2f) rot=%d size=(%.2f, %.2f)mm bbox=(%.2f, %.2f, %.2f, %.2f)\n" ),
+                                          ref, libId, value, footprint, datasheet, sx, sy,
+                                          orientProp, width, height, bxmin, bymin, bxmax, bymax );
+        out << symEntry.text;
+
+        for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
+        {
+            if( !pin )
+                continue;
+
+            wxString pinNumber = pin->GetShownNumber();
+            wxString pinName = pin->GetShownName();
+            VECTOR2I pinPos = pin->GetPosition();
+            double   px = schIUScale.IUTomm( pinPos.x );
+            double   py = schIUScale.IUTomm( pinPos.y );
+
+            wxString pinOrient = wxS( "UNKNOWN" );
+
+            switch( pin->GetOrientation() )
+            {
+            default:
+                break;
+            case PIN_ORIENTATION::PIN_RIGHT: pinOrient = wxS( "RIGHT" ); break;
+            case PIN_ORIENTATION::PIN_LEFT:  pinOrient = wxS( "LEFT" ); break;
+            case PIN_ORIENTATION::PIN_UP:    pinOrient = wxS( "UP" ); break;
+            case PIN_ORIENTATION::PIN_DOWN:  pinOrient = wxS( "DOWN" ); break;
+            }
+
+            wxString netName = wxS( "<unconnected>" );
+
+            if( SCH_CONNECTION* conn = pin->Connection( &aSheet ) )
+            {
+                netName = conn->Name();
+
+                if( netName.IsEmpty() )
+                    netName = wxS( "<unnamed>" );
+            }
+
+            hash_combine( signature, netName );
+
+            wxString node = ref + wxS( ":" ) + pinNumber;
+
+            if( !pinName.IsEmpty() )
+                node << wxS( "(" ) << pinName << wxS( ")" );
+
+            node << wxString::Format( wxS( "@(%.2f,%.2f,%s)" ), px, py, pinOrient );
+
+            aEntry.nodes.emplace_back( netName, node );
+
+            if( symEntry.nets.empty() || symEntry.nets.back() != netName )
+                symEntry.nets.push_back( netName );
+        }
+    }
+
+    if( componentCount == 0 )
+        out << wxS( "(no components)\n" );
+
+    out << wxS( "\n" );
+
+    aEntry.text = out;
+    aEntry.textHash = std::hash<wxString>{}( out );
+    aEntry.netSignature = signature;
+    aEntry.dirty = false;
+}
+
+
+size_t SCH_AGENT_CONTEXT::netSignature( const SCH_SHEET_PATH& aSheet )
+{
+    size_t signature = 0;
+
+    for( SCH_ITEM* item : aSheet.LastScreen()->Items().OfType( SCH_SYMBOL_T ) )
+    {
+        SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
+
+        for( SCH_PIN* pin : symbol->GetPins( &aSheet ) )
+        {
+            if( !pin )
+                continue;
+
+            wxString netName = wxS( "<unconnected>" );
+
+            if( SCH_CONNECTION* conn = pin->Connection( &aSheet ) )
+            {
+                netName = conn->Name();
+
+                if( netName.IsEmpty() )
+                    netName = wxS( "<unnamed>" );
+            }
+
+            hash_combine( signature, netName );
+        }
+    }
+
+    return signature;
+}
+
+
+void SCH_AGENT_CONTEXT::update()
+{
+    if( !m_schematic )
+        return;
+
+    // Already sorted by page number
+    std::shared_ptr<const SCH_SHEET_LIST> sheets = m_schematic->HierarchySnapshot();
+
+    std::vector<wxString> order;
+    std::set<wxString>    live;
+
+    for( const SCH_SHEET_PATH& sheetPath : *sheets )
+    {
+        SCH_SCREEN* screen = sheetPath.LastScreen();
+
+        if( !screen )
+            continue;
+
+        wxString     key = sheetPath.PathAsString();
+        SHEET_ENTRY& entry = m_sheets[key];
+
+        order.push_back( key );
+        live.insert( key );
+
+        if( m_allDirty || m_dirtyScreens.contains( screen ) )
+            entry.dirty = true;
+
+        if( !entry.dirty && m_netsDirty && netSignature( sheetPath ) != entry.netSignature )
+            entry.dirty = true;
+
+        if( entry.dirty )
+        {
+            formatSheet( sheetPath, entry );
+            m_netMapDirty = true;
+        }
+    }
+
+    for( auto it = m_sheets.begin(); it != m_sheets.end(); )
+    {
+        if( !live.contains( it->first ) )
+        {
+            it = m_sheets.erase( it );
+            m_netMapDirty = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if( order != m_order )
+    {
+        m_order = std::move( order );
+        m_netMapDirty = true;
+    }
+
+    if( m_netMapDirty )
+    {
+        m_nets.clear();
+        m_netText.clear();
+
+        for( const wxString& key : m_order )
+        {
+            for( const auto& [net, node] : m_sheets[key].nodes )
+                m_nets[net].push_back( node );
+        }
+
+        for( const auto& [net, nodes] : m_nets )
+            m_netText[net] = formatNet( net, nodes );
+    }
+
+    m_dirtyScreens.clear();
+    m_allDirty = false;
+    m_netsDirty = false;
+    m_netMapDirty = false;
+}
+
+
+wxString SCH_AGENT_CONTEXT::formatNet( const wxString& aNet, const std::vector<wxString>& aNodes )
+{
+    wxString line;
+
+    line << wxS( "* " ) << aNet << wxS( ": " );
+
+    for( size_t i = 0; i < aNodes.size(); i++ )
+    {
+        line << aNodes[i];
+
+        if( i + 1 < aNodes.size() )
+            line << wxS( ", " );
+    }
+
+    line << wxS( "\n" );
+    return line;
+}
+
+
+wxString SCH_AGENT_CONTEXT::header( const wxString& aTitle, const wxString& aCurrentSheet ) const
+{
+    wxString out;
+
+    out << aTitle << wxS( "\n" );
+    out << wxS( "Coordinate system: mm. +X is right. +Y is down. Values are schematic sheet coordinates.\n" );
+    out << wxS( "Current sheet: " ) << aCurrentSheet << wxS( "\n" );
+    out << wxS( "Sheet count: " ) << wxString::Format( wxS( "%d" ), (int) m_order.size() ) << wxS( "\n" );
+
+    return out;
+}
+
+
+void SCH_AGENT_CONTEXT::setBaseline()
+{
+    m_baselineSheets.clear();
+
+    for( const wxString& key : m_order )
+    {
+        const SHEET_ENTRY& entry = m_sheets.at( key );
+        m_baselineSheets[key] = { entry.humanPath, entry.textHash };
+    }
+
+    m_baselineNets = m_netText;
+    m_haveBaseline = true;
+}
+
+
+wxString SCH_AGENT_CONTEXT::GetSnapshot( const wxString& aCurrentSheet, size_t aMaxChars )
+{
+    update();
+
+    wxString out = header( wxS( "KICAD_SCHEMATIC_CONTEXT (all sheets)" ), aCurrentSheet );
+    out << wxS( "\n" );
+
+    auto append =
+            [&]( const wxString& aText ) -> bool
+            {
+                if( aMaxChars > 0 && (size_t) out.length() + aText.length() > aMaxChars )
+                {
+                    out << aText.Left( aMaxChars > (size_t) out.length() ? aMaxChars - out.length() : 0 );
+                    out << TRUNCATED_MSG;
+
+                    // The receiver did not get everything, so a delta would be meaningless
+                    m_haveBaseline = false;
+                    return false;
+                }
+
+                out << aText;
+                return true;
+            };
+
+    for( const wxString& key : m_order )
+    {
+        if( !append( m_sheets.at( key ).text ) )
+            return out;
+    }
+
+    out << wxS( "=== NETS (from pin connections) ===\n" );
+
+    for( const auto& [net, line] : m_netText )
+    {
+        if( !append( line ) )
+            return out;
+    }
+
+    setBaseline();
+    return out;
+}
+
+
+wxString SCH_AGENT_CONTEXT::GetDelta( const wxString& aCurrentSheet, size_t aMaxChars )
+{
+    if( !m_haveBaseline )
+        return GetSnapshot( aCurrentSheet, aMaxChars );
+
+    update();
+
+    wxString out = header( wxS( "KICAD_SCHEMATIC_CONTEXT_DELTA (changes since previous context)" ),
+                           aCurrentSheet );
+    wxString body;
+    int      unchanged = 0;
+
+    for( const wxString& key : m_order )
+    {
+        const SHEET_ENTRY& entry = m_sheets.at( key );
+        auto               it = m_baselineSheets.find( key );
+
+        if( it != m_baselineSheets.end() && it->second.second == entry.textHash )
+            unchanged++;
+        else
+            body << entry.text;
+    }
+
+    for( const auto& [key, pathAndHash] : m_baselineSheets )
+    {
+        if( !m_sheets.contains( key ) )
+            body << wxS( "=== REMOVED SHEET ===\n" ) << wxS( "Path: " ) << pathAndHash.first << wxS( "\n\n" );
+    }
+
+    wxString changedNets;
+    wxString removedNets;
+
+    for( const auto& [net, line] : m_netText )
+    {
+        auto it = m_baselineNets.find( net );
+
+        if( it == m_baselineNets.end() || it->second != line )
+            changedNets << line;
+    }
+
+    for( const auto& [net, line] : m_baselineNets )
+    {
+        if( !m_netText.contains( net ) )
+            removedNets << wxS( "* " ) << net << wxS( "\n" );
+    }
+
+    if( !changedNets.IsEmpty() )
+        body << wxS( "=== NETS CHANGED ===\n" ) << changedNets;
+
+    if( !removedNets.IsEmpty() )
+        body << wxS( "=== NETS REMOVED ===\n" ) << removedNets;
+
+    out << wxS( "Unchanged sheets: " ) << wxString::Format( wxS( "%d" ), unchanged ) << wxS( "\n\n" );
+
+    if( body.IsEmpty() )
+        out << wxS( "(no changes since previous context)\n" );
+
+    if( aMaxChars > 0 && (size_t) out.length() + body.length() > aMaxChars )
+    {
+        // A partial delta cannot be applied reliably; resend everything instead.
+        m_haveBaseline = false;
+        return GetSnapshot( aCurrentSheet, aMaxChars );
+    }
+
+    out << body;
+    setBaseline();
+    return out;
+}
+
+
+wxString SCH_AGENT_CONTEXT::GetRankedSnapshot( const wxString& aCurrentSheet, const FOCUS& aFocus,
+                                               size_t aMaxChars )
+{
+    update();
+
+    size_t fullSize = 0;
+
+    for( const wxString& key : m_order )
+        fullSize += m_sheets.at( key ).text.length();
+
+    for( const auto& [net, line] : m_netText )
+        fullSize += line.length();
+
+    // When everything fits the complete snapshot is more useful, and it is a delta baseline
+    if( aMaxChars == 0 || fullSize + 512 < aMaxChars )
+        return GetSnapshot( aCurrentSheet, aMaxChars );
+
+    struct RANKED
+    {
+        double              score;
+        size_t              sheet;    ///< Index in m_order
+        const SYMBOL_ENTRY* symbol;
+    };
+
+    std::set<wxString>   words = requestWords( aFocus.request );
+    std::vector<RANKED>  ranked;
+    std::vector<size_t>  focusSymbols;        // Indices in ranked of named or selected symbols
+    std::vector<VECTOR2I> selectionCentres;
+
+    for( size_t ii = 0; ii < m_order.size(); ++ii )
+    {
+        const SHEET_ENTRY& entry = m_sheets.at( m_order[ii] );
+        bool               current = m_order[ii] == aFocus.sheetKey;
+        bool               namedSheet = isNamed( words, entry.humanPath );
+
+        for( const SYMBOL_ENTRY& symbol : entry.symbols )
+        {
+            double score = 0.0;
+            bool   focus = false;
+
+            if( words.contains( symbol.ref.Upper() ) )
+            {
+                score += SCORE_NAMED;
+                focus = true;
+            }
+
+            if( aFocus.selection.contains( symbol.uuid ) )
+            {
+                score += SCORE_SELECTED;
+                focus = true;
+
+                if( current )
+                    selectionCentres.push_back( symbol.bbox.Centre() );
+            }
+
+            for( const wxString& net : symbol.nets )
+            {
+                if( isNamed( words, net ) )
+                {
+                    score += SCORE_ON_NAMED_NET;
+                    break;
+                }
+            }
+
+            if( namedSheet )
+                score += SCORE_ON_NAMED_SHEET;
+
+            if( current )
+            {
+                score += SCORE_CURRENT_SHEET;
+
+                if( aFocus.viewBox.GetWidth() > 0 && aFocus.viewBox.Intersects( symbol.bbox ) )
+                    score += SCORE_VISIBLE;
+            }
+
+            if( focus )
+                focusSymbols.push_back( ranked.size() );
+
+            ranked.push_back( { score, ii, &symbol } );
+        }
+    }
+
+    // Symbols sharing a small net with a named or selected symbol are probably part of the
+    // same circuit
+    if( !focusSymbols.empty() )
+    {
+        std::map<wxString, std::vector<size_t>> netSymbols;
+
+        for( size_t ii = 0; ii < ranked.size(); ++ii )
+        {
+            for( const wxString& net : ranked[ii].symbol->nets )
+                netSymbols[net].push_back( ii );
+        }
+
+        std::set<size_t> neighbours;
+
+        for( size_t idx : focusSymbols )
+        {
+            for( const wxString& net : ranked[idx].symbol->nets )
+            {
+                const std::vector<size_t>& members = netSymbols[net];
+
+                if( net == wxS( "<unconnected>" ) || members.size() > MAX_NEIGHBOUR_NET_SIZE )
+                    continue;
+
+                neighbours.insert( members.begin(), members.end() );
+            }
+        }
+
+        for( size_t idx : neighbours )
+            ranked[idx].score += SCORE_NEIGHBOUR;
+    }
+
+    // Closer to the selection ranks higher, fading out over the size of the view
+    if( !selectionCentres.empty() )
+    {
+        VECTOR2D centre;
+
+        for( const VECTOR2I& pt : selectionCentres )
+            centre += VECTOR2D( pt ) / double( selectionCentres.size() );
+
+        double range = aFocus.viewBox.GetWidth() > 0 ? VECTOR2D( aFocus.viewBox.GetSize() ).EuclideanNorm()
+                                                     : schIUScale.mmToIU( 100.0 );
+
+        for( RANKED& item : ranked )
+        {
+            if( m_order[item.sheet] != aFocus.sheetKey )
+                continue;
+
+            double dist = ( VECTOR2D( item.symbol->bbox.Centre() ) - centre ).EuclideanNorm();
+            item.score += SCORE_NEAR_SELECTION * std::max( 0.0, 1.0 - dist / range );
+        }
+    }
+
+    // Ties keep page order
+    std::stable_sort( ranked.begin(), ranked.end(),
+                      []( const RANKED& a, const RANKED& b )
+                      {
+                          return a.score > b.score;
+                      } );
+
+    wxString out = header( wxS( "KICAD_SCHEMATIC_CONTEXT (most relevant content only)" ),
+                           aCurrentSheet );
+    size_t   budget = aMaxChars > out.length() + 256 ? aMaxChars - out.length() - 256 : 0;
+    size_t   symbolBudget = budget - size_t( budget * NET_BUDGET_SHARE );
+    size_t   used = 0;
+
+    std::vector<std::vector<const SYMBOL_ENTRY*>> chosen( m_order.size() );
+    std::map<wxString, double>                    chosenNets;
+    size_t                                        symbolCount = 0;
+
+    for( const RANKED& item : ranked )
+    {
+        size_t cost = item.symbol->text.length();
+
+        if( chosen[item.sheet].empty() )
+            cost += m_sheets.at( m_order[item.sheet] ).header.length() + 1;
+
+        if( used + cost > symbolBudget )
+            break;
+
+        used += cost;
+        chosen[item.sheet].push_back( item.symbol );
+        symbolCount++;
+
+        // A net ranks as high as the best of its shown symbols
+        for( const wxString& net : item.symbol->nets )
+        {
+            double& netScore = chosenNets[net];
+            netScore = std::max( netScore, item.score );
+        }
+    }
+
+    std::vector<std::pair<double, wxString>> nets;
+
+    for( const auto& [net, score] : chosenNets )
+    {
+        if( m_netText.contains( net ) )
+            nets.emplace_back( score + ( isNamed( words, net ) ? SCORE_NAMED : 0.0 ), net );
+    }
+
+    std::stable_sort( nets.begin(), nets.end(),
+                      []( const std::pair<double, wxString>& a, const std::pair<double, wxString>& b )
+                      {
+                          return a.first > b.first;
+                      } );
+
+    std::set<wxString> shownNets;
+
+    for( const auto& [score, net] : nets )
+    {
+        const wxString& line = m_netText.at( net );
+
+        if( used + line.length() > budget )
+            break;
+
+        used += line.length();
+        shownNets.insert( net );
+    }
+
+    out << wxString::Format( wxS( "Shown: %d of %d symbols, %d of %d nets\n\n" ), (int) symbolCount,
+                             (int) ranked.size(), (int) shownNets.size(), (int) m_netText.size() );
+
+    for( size_t ii = 0; ii < m_order.size(); ++ii )
+    {
+        if( chosen[ii].empty() )
+            continue;
+
+        const SHEET_ENTRY& entry = m_sheets.at( m_order[ii] );
+
+        // Back to sheet order within the section
+        std::sort( chosen[ii].begin(), chosen[ii].end() );
+
+        out << entry.header;
+
+        for( const SYMBOL_ENTRY* symbol : chosen[ii] )
+            out << symbol->text;
+
+        out << wxS( "\n" );
+    }
+
+    out << wxS( "=== NETS (from pin connections) ===\n" );
+
+    for( const wxString& net : shownNets )
+        out << m_netText.at( net );
+
+    out << wxString::Format( wxS( "\n[OMITTED: %d symbols and %d nets of lower relevance]\n" ),
+                             (int) ( ranked.size() - symbolCount ),
+                             (int) ( m_netText.size() - shownNets.size() ) );
+
+    // The receiver did not get everything, so a delta would be meaningless
+    m_haveBaseline = false;
+    return out;
+}
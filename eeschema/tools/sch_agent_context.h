@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_AGENT_CONTEXT_H
+#define SCH_AGENT_CONTEXT_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <wx/string.h>
+
+#include <kiid.h>
+#include <math/box2.h>
+#include <schematic.h>
+
+class SCH_SCREEN;
+class SCH_SHEET_PATH;
+
+
+/**
+ * Incrementally maintained text description of a schematic for LLM prompts.
+ *
+ * Every sheet is serialized once and kept until a commit touches its screen.  Connectivity
+ * changes can rename nets on sheets that were not edited, so after such a change the other
+ * sheets are only re-checked against a hash of their pin net names rather than rebuilt.
+ *
+ * Besides the full snapshot, a delta against the last text handed out can be produced so
+ * that follow-up turns only resend the sheets and nets that actually changed.
+ */
+class SCH_AGENT_CONTEXT : public SCHEMATIC_LISTENER
+{
+public:
+    SCH_AGENT_CONTEXT();
+
+    /// Start listening to \a aSchematic and drop anything cached for a previous one.
+    void SetSchematic( SCHEMATIC* aSchematic );
+
+    /// Drop all cached sheets and the delta baseline.
+    void Invalidate();
+
+    /**
+     * Return the full context text.
+     *
+     * @param aCurrentSheet is the human readable description of the sheet being edited.
+     * @param aMaxChars truncates the output when non-zero.
+     */
+    wxString GetSnapshot( const wxString& aCurrentSheet, size_t aMaxChars );
+
+    /**
+     * Return only what changed since the last snapshot or delta.  Falls back to a full
+     * snapshot when there is no (complete) previous output to diff against.
+     */
+    wxString GetDelta( const wxString& aCurrentSheet, size_t aMaxChars );
+
+    /**
+     * What the user is working on, used to rank the content of a context that doesn't fit.
+     */
+    struct FOCUS
+    {
+        wxString       request;    ///< Searched for references, net names and sheet names
+        wxString       sheetKey;   ///< KIID path of the sheet being edited
+        BOX2I          viewBox;    ///< Visible area of that sheet
+        std::set<KIID> selection;  ///< Selected symbols
+    };
+
+    /**
+     * Return the full snapshot if it fits in \a aMaxChars, otherwise the most relevant symbols
+     * and nets for \a aFocus.
+     *
+     * Symbols are ranked by whether the request names them, their net or their sheet, whether
+     * they are selected or connected to a selected or named symbol, and how close they are to
+     * the selection and the view.  They are emitted in rank order until the budget is spent,
+     * then the nets the same way, and the rest is not visited.
+     */
+    wxString GetRankedSnapshot( const wxString& aCurrentSheet, const FOCUS& aFocus,
+                                size_t aMaxChars );
+
+    void OnSchItemsAdded( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+    void OnSchItemsRemoved( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+    void OnSchItemsChanged( SCHEMATIC& aSch, std::vector<SCH_ITEM*>& aItems ) override;
+
+private:
+    struct SYMBOL_ENTRY
+    {
+        KIID                  uuid;
+        wxString              ref;
+        wxString              text;   ///< The symbol's line in the sheet section
+        BOX2I                 bbox;
+        std::vector<wxString> nets;   ///< Nets of its pins, without consecutive duplicates
+    };
+
+    struct SHEET_ENTRY
+    {
+        wxString humanPath;
+        wxString header;           ///< The section up to the first symbol
+        wxString text;             ///< The formatted "=== SHEET ===" section
+        size_t   textHash = 0;
+        size_t   netSignature = 0; ///< Hash of the net names of every pin on the sheet
+        bool     dirty = true;
+
+        /// (net name, node description) for every pin, in sheet order
+        std::vector<std::pair<wxString, wxString>> nodes;
+
+        std::vector<SYMBOL_ENTRY> symbols;
+    };
+
+    void markChanged( const std::vector<SCH_ITEM*>& aItems );
+
+    /// Bring every cached sheet up to date and rebuild the net map if anything changed.
+    void update();
+
+    static void formatSheet( const SCH_SHEET_PATH& aSheet, SHEET_ENTRY& aEntry );
+
+    static size_t netSignature( const SCH_SHEET_PATH& aSheet );
+
+    wxString header( const wxString& aTitle, const wxString& aCurrentSheet ) const;
+
+    static wxString formatNet( const wxString& aNet, const std::vector<wxString>& aNodes );
+
+    /// Record what was emitted so the next delta can be computed against it.
+    void setBaseline();
+
+private:
+    SCHEMATIC*                      m_schematic;
+    std::map<wxString, SHEET_ENTRY> m_sheets;       ///< Keyed by KIID path
+    std::vector<wxString>           m_order;        ///< Sheet keys in page order
+    std::map<wxString, wxString>    m_netText;      ///< Net name -> formatted line
+
+    /// Net name -> nodes
+    std::map<wxString, std::vector<wxString>> m_nets;
+
+    std::set<const SCH_SCREEN*>     m_dirtyScreens;
+    bool                            m_allDirty;
+    bool                            m_netsDirty;
+    bool                            m_netMapDirty;
+
+    bool                            m_haveBaseline;
+    std::map<wxString, wxString>    m_baselineNets;
+
+    /// Sheet key -> (human readable path, text hash) as last handed out
+    std::map<wxString, std::pair<wxString, size_t>> m_baselineSheets;
+};
+
+#endif // SCH_AGENT_CONTEXT_H
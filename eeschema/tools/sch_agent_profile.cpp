@@ -0,0 +1,167 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sch_agent_profile.h"
+
+#include <nlohmann/json.hpp>
+
+
+void SCH_AGENT_PROFILE::Reset()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    for( double& phase : m_phases )
+        phase = 0.0;
+
+    m_tools.clear();
+    m_tokensSent = 0;
+    m_tokensReceived = 0;
+    m_generationSecs = 0.0;
+}
+
+
+void SCH_AGENT_PROFILE::AddPhase( PHASE aPhase, double aMsecs )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_phases[(int) aPhase] += aMsecs;
+}
+
+
+void SCH_AGENT_PROFILE::AddTool( const wxString& aToolName, double aMsecs )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    TOOL_STATS& stats = m_tools[aToolName.Lower()];
+    stats.calls++;
+    stats.msecs += aMsecs;
+}
+
+
+void SCH_AGENT_PROFILE::SetTokens( long long aSent, long long aReceived, double aGenerationSecs )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_tokensSent = aSent;
+    m_tokensReceived = aReceived;
+    m_generationSecs = aGenerationSecs;
+}
+
+
+double SCH_AGENT_PROFILE::GetPhase( PHASE aPhase ) const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    return m_phases[(int) aPhase];
+}
+
+
+double SCH_AGENT_PROFILE::TokensPerSecond() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    double secs = m_generationSecs > 0.0 ? m_generationSecs
+                                         : m_phases[(int) PHASE::GENERATION] / 1000.0;
+
+    return secs > 0.0 ? m_tokensReceived / secs : 0.0;
+}
+
+
+wxString SCH_AGENT_PROFILE::PhaseName( PHASE aPhase )
+{
+    switch( aPhase )
+    {
+    case PHASE::CONTEXT:     return wxS( "context" );
+    case PHASE::DRAFT:       return wxS( "draft" );
+    case PHASE::FIRST_TOKEN: return wxS( "first_token" );
+    case PHASE::GENERATION:  return wxS( "generation" );
+    case PHASE::EXECUTION:   return wxS( "execution" );
+    case PHASE::COMMIT:      return wxS( "commit" );
+    case PHASE::COUNT:       break;
+    }
+
+    return wxEmptyString;
+}
+
+
+wxString SCH_AGENT_PROFILE::Summary() const
+{
+    double total = 0.0;
+
+    for( int ii = 0; ii < (int) PHASE::COUNT; ++ii )
+        total += GetPhase( (PHASE) ii );
+
+    return wxString::Format( wxS( "%.0f ms (first token %.0f ms, %.1f tok/s, execute %.0f ms)" ),
+                             total, GetPhase( PHASE::FIRST_TOKEN ), TokensPerSecond(),
+                             GetPhase( PHASE::EXECUTION ) );
+}
+
+
+wxString SCH_AGENT_PROFILE::Format() const
+{
+    wxString out;
+
+    for( int ii = 0; ii < (int) PHASE::COUNT; ++ii )
+    {
+        out << wxString::Format( wxS( "%-12s %9.1f ms\n" ), PhaseName( (PHASE) ii ),
+                                 GetPhase( (PHASE) ii ) );
+    }
+
+    double tokensPerSecond = TokensPerSecond();
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    out << wxString::Format( wxS( "tokens       %lld sent, %lld received, %.1f tok/s\n" ),
+                             m_tokensSent, m_tokensReceived, tokensPerSecond );
+
+    for( const auto& [name, stats] : m_tools )
+    {
+        out << wxString::Format( wxS( "  %s: %d call(s), %.1f ms\n" ), name, stats.calls,
+                                 stats.msecs );
+    }
+
+    return out;
+}
+
+
+wxString SCH_AGENT_PROFILE::ToJson() const
+{
+    nlohmann::json out = nlohmann::json::object();
+    nlohmann::json phases = nlohmann::json::object();
+
+    for( int ii = 0; ii < (int) PHASE::COUNT; ++ii )
+        phases[PhaseName( (PHASE) ii ).ToStdString()] = GetPhase( (PHASE) ii );
+
+    out["phases_ms"] = phases;
+    out["tokens_per_second"] = TokensPerSecond();
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    out["tokens_sent"] = m_tokensSent;
+    out["tokens_received"] = m_tokensReceived;
+
+    nlohmann::json tools = nlohmann::json::object();
+
+    for( const auto& [name, stats] : m_tools )
+    {
+        tools[name.ToStdString()] = { { "calls", stats.calls }, { "ms", stats.msecs } };
+    }
+
+    out["tools"] = tools;
+
+    return wxString::FromUTF8( out.dump( 2 ) );
+}
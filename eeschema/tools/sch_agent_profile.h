@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_AGENT_PROFILE_H
+#define SCH_AGENT_PROFILE_H
+
+#include <map>
+#include <mutex>
+#include <wx/string.h>
+
+
+/**
+ * Timing and token statistics of one agent turn.
+ *
+ * Phases are accumulated in milliseconds, so a phase that runs several times in a turn (e.g.
+ * one commit per tool outside of a batch) reports its total.  Background tools may report
+ * from worker threads.
+ */
+class SCH_AGENT_PROFILE
+{
+public:
+    enum class PHASE
+    {
+        CONTEXT,        ///< Building the schematic context sent with the prompt
+        DRAFT,          ///< Drafting a plan with the small model and validating it
+        FIRST_TOKEN,    ///< Request sent until the first streamed text (network + prompt eval)
+        GENERATION,     ///< First streamed text until the response was complete
+        EXECUTION,      ///< Parsing the response and running its commands
+        COMMIT,         ///< Pushing commits, including the connectivity update
+        COUNT
+    };
+
+    SCH_AGENT_PROFILE() { Reset(); }
+
+    /// Forget the previous turn.
+    void Reset();
+
+    void AddPhase( PHASE aPhase, double aMsecs );
+
+    void AddTool( const wxString& aToolName, double aMsecs );
+
+    /**
+     * @param aSent is the number of prompt tokens (or an estimate).
+     * @param aReceived is the number of generated tokens (or an estimate).
+     * @param aGenerationSecs is the generation time used for the tokens/s figure; when not
+     *                        positive, the GENERATION phase is used.
+     */
+    void SetTokens( long long aSent, long long aReceived, double aGenerationSecs = 0.0 );
+
+    double GetPhase( PHASE aPhase ) const;
+
+    double TokensPerSecond() const;
+
+    /// One line summary for status bars.
+    wxString Summary() const;
+
+    /// Multi-line human readable breakdown.
+    wxString Format() const;
+
+    /// The whole breakdown as a JSON object.
+    wxString ToJson() const;
+
+    static wxString PhaseName( PHASE aPhase );
+
+private:
+    struct TOOL_STATS
+    {
+        int    calls = 0;
+        double msecs = 0.0;
+    };
+
+    mutable std::mutex                 m_mutex;
+    double                             m_phases[(int) PHASE::COUNT];
+    std::map<wxString, TOOL_STATS>     m_tools;
+    long long                          m_tokensSent;
+    long long                          m_tokensReceived;
+    double                             m_generationSecs;
+};
+
+#endif // SCH_AGENT_PROFILE_H
@@ -0,0 +1,151 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sch_agent_tool_call_parser.h"
+
+
+/**
+ * If \a aLine is "TOOL <name>" (and nothing else), return the name; otherwise empty.
+ */
+static wxString toolNameFromLine( const wxString& aLine )
+{
+    wxString line = aLine;
+    line.Trim( false );
+
+    if( line.length() < 5 || line.Left( 4 ).Upper() != wxS( "TOOL" ) )
+        return wxEmptyString;
+
+    if( line[4] != ' ' && line[4] != '\t' )
+        return wxEmptyString;
+
+    wxString name = line.Mid( 5 );
+    name.Trim( true ).Trim( false );
+
+    if( name.IsEmpty() || name.find_first_of( wxS( " \t" ) ) != wxString::npos )
+        return wxEmptyString;
+
+    return name;
+}
+
+
+void SCH_AGENT_TOOL_CALL_PARSER::Reset()
+{
+    m_state = STATE::LINE;
+    m_line.clear();
+    m_name.clear();
+    m_payload.clear();
+    m_depth = 0;
+    m_inString = false;
+    m_escape = false;
+}
+
+
+void SCH_AGENT_TOOL_CALL_PARSER::endLine( std::vector<TOOL_CALL>& aCalls )
+{
+    wxString line = m_line;
+    line.Trim( true );
+
+    if( !line.IsEmpty() && line[0] != '#' )
+    {
+        wxString name = toolNameFromLine( line );
+
+        if( !name.IsEmpty() )
+            aCalls.push_back( { name, wxEmptyString, wxEmptyString } );
+        else if( m_keepOtherLines )
+            aCalls.push_back( { wxEmptyString, wxEmptyString, line } );
+    }
+
+    m_line.clear();
+}
+
+
+void SCH_AGENT_TOOL_CALL_PARSER::Feed( const wxString& aChunk, std::vector<TOOL_CALL>& aCalls )
+{
+    for( wxUniChar c : aChunk )
+    {
+        switch( m_state )
+        {
+        case STATE::LINE:
+            if( c == '\n' )
+            {
+                endLine( aCalls );
+            }
+            else if( c == '{' && !( m_name = toolNameFromLine( m_line ) ).IsEmpty() )
+            {
+                m_state = STATE::PAYLOAD;
+                m_payload = c;
+                m_depth = 1;
+                m_inString = false;
+                m_escape = false;
+                m_line.clear();
+            }
+            else
+            {
+                m_line << c;
+            }
+
+            break;
+
+        case STATE::PAYLOAD:
+            m_payload << c;
+
+            if( m_inString )
+            {
+                if( m_escape )
+                    m_escape = false;
+                else if( c == '\\' )
+                    m_escape = true;
+                else if( c == '"' )
+                    m_inString = false;
+            }
+            else if( c == '"' )
+            {
+                m_inString = true;
+            }
+            else if( c == '{' )
+            {
+                m_depth++;
+            }
+            else if( c == '}' && --m_depth == 0 )
+            {
+                aCalls.push_back( { m_name, m_payload, wxEmptyString } );
+                m_payload.clear();
+                m_state = STATE::SKIP_LINE;
+            }
+
+            break;
+
+        case STATE::SKIP_LINE:
+            if( c == '\n' )
+                m_state = STATE::LINE;
+
+            break;
+        }
+    }
+}
+
+
+void SCH_AGENT_TOOL_CALL_PARSER::Finish( std::vector<TOOL_CALL>& aCalls )
+{
+    // An unterminated payload cannot be valid JSON and is dropped
+    if( m_state == STATE::LINE )
+        endLine( aCalls );
+
+    Reset();
+}
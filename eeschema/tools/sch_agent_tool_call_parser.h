@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCH_AGENT_TOOL_CALL_PARSER_H
+#define SCH_AGENT_TOOL_CALL_PARSER_H
+
+#include <vector>
+#include <wx/string.h>
+
+
+/**
+ * Incrementally extract "TOOL <name> <json>" calls from a streamed agent response.
+ *
+ * Chunks can be fed as they arrive; a call is reported as soon as its JSON payload is
+ * balanced (braces inside strings are ignored), which is usually well before the model has
+ * finished the whole response.  Payloads may span several lines.  A TOOL line without a
+ * payload is reported when its line ends.
+ *
+ * When other lines are kept, every non-empty line that is neither a tool call nor a comment
+ * is reported too, in order with the calls, so a whole response can be executed from one pass.
+ */
+class SCH_AGENT_TOOL_CALL_PARSER
+{
+public:
+    struct TOOL_CALL
+    {
+        wxString name;      ///< Empty for a kept line that is not a tool call
+        wxString payload;   ///< The JSON object text, or empty
+        wxString line;      ///< The text of a kept line that is not a tool call
+    };
+
+    explicit SCH_AGENT_TOOL_CALL_PARSER( bool aKeepOtherLines = false ) :
+            m_keepOtherLines( aKeepOtherLines )
+    {
+        Reset();
+    }
+
+    void Reset();
+
+    /// Consume \a aChunk and append every call it completes to \a aCalls.
+    void Feed( const wxString& aChunk, std::vector<TOOL_CALL>& aCalls );
+
+    /// Flush a call left open by the end of the response.
+    void Finish( std::vector<TOOL_CALL>& aCalls );
+
+private:
+    enum class STATE
+    {
+        LINE,       ///< Reading a line, not yet known to be a tool call
+        PAYLOAD,    ///< Inside the JSON payload of a tool call
+        SKIP_LINE   ///< Discarding the rest of a line after a completed call
+    };
+
+    void endLine( std::vector<TOOL_CALL>& aCalls );
+
+    bool     m_keepOtherLines;
+    STATE    m_state;
+    wxString m_line;
+    wxString m_name;
+    wxString m_payload;
+    int      m_depth;
+    bool     m_inString;
+    bool     m_escape;
+};
+
+#endif // SCH_AGENT_TOOL_CALL_PARSER_H
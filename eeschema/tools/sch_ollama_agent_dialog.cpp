@@ -19,6 +19,10 @@
 
 #include "sch_ollama_agent_dialog.h"
 #include "sch_ollama_agent_tool.h"
+#include <advanced_config.h>
+#include <core/profile.h>
+#include <thread_pool.h>
+#include <wx/log.h>
 #include <wx/sizer.h>
 #include <wx/textctrl.h>
 #include <wx/button.h>
@@ -32,6 +36,7 @@
 #include <wx/dcclient.h>
 #include <wx/dcmemory.h>
 #include <algorithm>
+#include <trace_helpers.h>
 
 // Message bubble panel for chat messages
 class MESSAGE_BUBBLE : public wxPanel
@@ -89,10 +94,16 @@ public:
 SCH_OLLAMA_AGENT_DIALOG::SCH_OLLAMA_AGENT_DIALOG( wxWindow* aParent, SCH_OLLAMA_AGENT_TOOL* aTool ) :
     wxDialog( aParent, wxID_ANY, _( "Ollama Schematic Agent" ), 
              wxDefaultPosition, wxSize( 600, 700 ),
-             wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER | wxMAXIMIZE_BOX ),
+             wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER | wxMAXIMIZE_BOX,
+             DIALOG_OLLAMA_AGENT_WINDOW_NAME ),
     m_tool( aTool ),
+    m_statusText( nullptr ),
     m_isProcessing( false ),
-    m_currentBubble( nullptr )
+    m_currentBubble( nullptr ),
+    m_chunkCount( 0 ),
+    m_requestCached( false ),
+    m_requestSerial( 0 ),
+    m_cancelRequest( false )
 {
     // Main sizer
     wxBoxSizer* mainSizer = new wxBoxSizer( wxVERTICAL );
@@ -159,10 +170,9 @@ SCH_OLLAMA_AGENT_DIALOG::SCH_OLLAMA_AGENT_DIALOG( wxWindow* aParent, SCH_OLLAMA_
     statusPanel->SetBackgroundColour( wxColour( 250, 250, 250 ) );
     wxBoxSizer* statusSizer = new wxBoxSizer( wxHORIZONTAL );
     
-    wxStaticText* statusText = new wxStaticText( statusPanel, wxID_ANY, 
-                                                _( "Connected to Python agent" ) );
-    statusText->SetForegroundColour( wxColour( 100, 100, 100 ) );
-    statusSizer->Add( statusText, 0, wxALL, 5 );
+    m_statusText = new wxStaticText( statusPanel, wxID_ANY, _( "Connected to Python agent" ) );
+    m_statusText->SetForegroundColour( wxColour( 100, 100, 100 ) );
+    statusSizer->Add( m_statusText, 0, wxALL, 5 );
     statusSizer->AddStretchSpacer();
     
     statusPanel->SetSizer( statusSizer );
@@ -186,6 +196,17 @@ SCH_OLLAMA_AGENT_DIALOG::SCH_OLLAMA_AGENT_DIALOG( wxWindow* aParent, SCH_OLLAMA_
 
 SCH_OLLAMA_AGENT_DIALOG::~SCH_OLLAMA_AGENT_DIALOG()
 {
+    // The worker posts back to this window, so it must be gone before we are.
+    cancelRequest();
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::cancelRequest()
+{
+    m_cancelRequest.store( true );
+
+    if( m_requestTask.valid() )
+        m_requestTask.wait();
 }
 
 
@@ -271,8 +292,11 @@ void SCH_OLLAMA_AGENT_DIALOG::onClose( wxCloseEvent& aEvent )
             return;
         }
     }
-    
-    aEvent.Skip();
+
+    cancelRequest();
+
+    // The dialog is modeless; nothing else owns it.
+    Destroy();
 }
 
 
@@ -301,127 +325,276 @@ void SCH_OLLAMA_AGENT_DIALOG::sendMessage()
     // Initialize streaming state
     m_currentResponse.Clear();
     m_currentBubble = nullptr;
-    
-    // Process request with streaming
-    wxString fullResponse;
-    bool success = false;
-    
-    if( m_tool && m_tool->GetOllama() )
+    m_chunkCount = 0;
+    m_callParser.Reset();
+    m_tool->Profile().Reset();
+
+    // Shared with the worker, which must not touch the tool
+    std::shared_ptr<OLLAMA_CLIENT> client = m_tool ? m_tool->GetOllama() : nullptr;
+
+    if( !client )
     {
-        // Create a streaming callback that updates the UI incrementally
-        auto chunkCallback = [this]( const wxString& chunk )
-        {
-            if( chunk.IsEmpty() )
-                return;
-            
-            // Accumulate response
-            m_currentResponse += chunk;
-            
-            // Create or update the streaming bubble
-            if( !m_currentBubble )
-            {
-                // Create a new bubble for streaming
-                m_currentBubble = new MESSAGE_BUBBLE( m_chatPanel, m_currentResponse, false );
-                m_chatSizer->Add( m_currentBubble, 0, wxALIGN_LEFT | wxALL, 5 );
-                m_chatSizer->Layout();
-                m_chatPanel->Layout();
-            }
-            else
+        onStreamFinished( false, wxEmptyString );
+        return;
+    }
+
+    // Prepend the schematic context, ranked for the message if it doesn't fit whole.  It
+    // changes less between turns than the message, so the server can reuse the prompt prefix.
+    // This reads the schematic, so it has to happen here rather than on the worker.
+    wxString prompt;
+    wxString context = m_tool->GetRankedSchematicContext( message );
+
+    if( !context.IsEmpty() )
+        prompt << context << wxS( "\n\n" );
+
+    prompt << message;
+
+    wxString model = m_tool->GetModel();
+    wxString cachedResponse;
+
+    m_requestPrompt = prompt;
+    m_requestCached = client->FindCachedResponse( model, prompt, wxEmptyString, cachedResponse );
+
+    if( m_requestCached )
+    {
+        onStreamFinished( true, cachedResponse );
+        return;
+    }
+
+    // Routine commands are first drafted by the small model, if there is one
+    wxString draftModel;
+
+    if( SCH_OLLAMA_AGENT_TOOL::IsSimpleRequest( message ) )
+        draftModel = ADVANCED_CFG::GetCfg().m_AgentDraftModel;
+
+    m_cancelRequest.store( false );
+
+    unsigned serial = ++m_requestSerial;
+
+    m_requestTask = GetKiCadThreadPool().submit_task(
+            [this, client, model, draftModel, prompt, serial]()
             {
-                // Update the bubble text by finding the text control inside
-                wxWindowList& children = m_currentBubble->GetChildren();
-                for( wxWindowList::iterator it = children.begin(); it != children.end(); ++it )
+                wxString fullResponse;
+
+                if( !draftModel.IsEmpty() )
                 {
-                    wxTextCtrl* textCtrl = dynamic_cast<wxTextCtrl*>( *it );
-                    if( textCtrl )
+                    PROF_TIMER draftTimer;
+                    wxString   draft;
+
+                    if( client->StreamChatCompletion( draftModel, prompt, nullptr, draft,
+                                                      &m_cancelRequest )
+                        && !m_cancelRequest.load() )
                     {
-                        textCtrl->SetValue( m_currentResponse );
-                        // Force a refresh and layout update
-                        textCtrl->Refresh();
-                        m_currentBubble->Layout();
-                        break;
+                        double msecs = draftTimer.msecs();
+
+                        // Checked against the schematic on the UI thread while the main model
+                        // already works on the request below
+                        CallAfter( [this, draft, msecs, serial]()
+                                   {
+                                       if( serial == m_requestSerial )
+                                           onDraftReceived( draft, msecs );
+                                   } );
                     }
                 }
-            }
-            
-            // Process events frequently to keep UI responsive during streaming
-            // This is critical to prevent freezing
-            wxYield();
-            
-            // Scroll to bottom periodically (not on every chunk to reduce overhead)
-            static int scrollCounter = 0;
-            if( (++scrollCounter % 10) == 0 )  // Scroll every 10 chunks
-            {
-                scrollToBottom();
-            }
-        };
-        
-        // Append full schematic context before sending to Python pcb_agent.
-        wxString prompt = message;
-        wxString context = m_tool->GetFullSchematicContext();
-        if( !context.IsEmpty() )
-            prompt << wxS( "\n\n" ) << context;
-
-        success = m_tool->GetOllama()->StreamChatCompletion(
-            m_tool->GetModel(), prompt, chunkCallback, fullResponse );
-        
-        if( success )
-        {
-            // Finalize the bubble with the complete response
-            if( m_currentBubble )
-            {
-                // Update with final response
-                wxWindowList& children = m_currentBubble->GetChildren();
-                for( wxWindowList::iterator it = children.begin(); it != children.end(); ++it )
+
+                auto chunkCallback =
+                        [this, serial]( const wxString& aChunk )
+                        {
+                            if( aChunk.IsEmpty() )
+                                return;
+
+                            CallAfter( [this, aChunk, serial]()
+                                       {
+                                           if( serial == m_requestSerial && m_isProcessing )
+                                               onStreamChunk( aChunk );
+                                       } );
+                        };
+
+                OLLAMA_CLIENT::STREAM_STATS stats;
+                bool success = client->StreamChatCompletion( model, prompt, chunkCallback,
+                                                             fullResponse, &m_cancelRequest,
+                                                             wxString(), &stats );
+
+                if( !m_cancelRequest.load() )
                 {
-                    wxTextCtrl* textCtrl = dynamic_cast<wxTextCtrl*>( *it );
-                    if( textCtrl )
-                    {
-                        textCtrl->SetValue( fullResponse );
-                        textCtrl->Refresh();
-                        break;
-                    }
+                    CallAfter( [this, success, fullResponse, stats, serial]()
+                               {
+                                   if( serial == m_requestSerial )
+                                       onStreamFinished( success, fullResponse, &stats );
+                               } );
                 }
-                m_chatSizer->Layout();
-                m_chatPanel->Layout();
-                m_currentBubble = nullptr;
-            }
-            else
-            {
-                // No streaming happened, add as normal message
-                AddAgentMessage( fullResponse );
-            }
-            
-            m_tool->ParseAndExecute( fullResponse );
-        }
-        else
-        {
-            // Clean up streaming bubble on error
-            if( m_currentBubble )
-            {
-                m_chatSizer->Detach( m_currentBubble );
-                m_currentBubble->Destroy();
-                m_currentBubble = nullptr;
-                m_chatSizer->Layout();
-                m_chatPanel->Layout();
-            }
-            
-            AddAgentMessage( _( "Error: Failed to communicate with Python agent. Make sure the agent is running (default: http://127.0.0.1:5001)" ) );
-        }
+            } );
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::onDraftReceived( const wxString& aDraft, double aMsecs )
+{
+    if( !m_isProcessing || m_cancelRequest.load() )
+        return;
+
+    PROF_TIMER timer;
+    bool       applied = m_tool->ApplyDraftPlan( aDraft );
+
+    m_tool->Profile().AddPhase( SCH_AGENT_PROFILE::PHASE::DRAFT, aMsecs + timer.msecs() );
+
+    // Otherwise the main model's answer is already on its way
+    if( !applied )
+        return;
+
+    cancelRequest();
+
+    if( m_currentBubble )
+    {
+        m_chatSizer->Detach( m_currentBubble );
+        m_currentBubble->Destroy();
+        m_currentBubble = nullptr;
     }
-    
-    // Process pending events to update UI
-    wxYield();
-    
-    // Re-enable send button
+
+    AddAgentMessage( aDraft );
+    showProfile();
+    endRequest();
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::showProfile()
+{
+    const SCH_AGENT_PROFILE& profile = m_tool->Profile();
+
+    m_statusText->SetLabel( profile.Summary() );
+    m_statusText->SetToolTip( profile.Format() );
+    wxLogTrace( traceAgentProfile, wxS( "Agent turn profile:\n%s" ), profile.ToJson() );
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::endRequest()
+{
     m_isProcessing = false;
     m_sendButton->Enable( true );
     m_sendButton->SetLabel( _( "Send" ) );
-    
+
     scrollToBottom();
 }
 
 
+void SCH_OLLAMA_AGENT_DIALOG::setBubbleText( const wxString& aText )
+{
+    if( !m_currentBubble )
+        return;
+
+    // Update the bubble text by finding the text control inside
+    for( wxWindow* child : m_currentBubble->GetChildren() )
+    {
+        if( wxTextCtrl* textCtrl = dynamic_cast<wxTextCtrl*>( child ) )
+        {
+            textCtrl->SetValue( aText );
+            textCtrl->Refresh();
+            m_currentBubble->Layout();
+            break;
+        }
+    }
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::onStreamChunk( const wxString& aChunk )
+{
+    // Accumulate response
+    m_currentResponse += aChunk;
+
+    // Create or update the streaming bubble
+    if( !m_currentBubble )
+    {
+        m_currentBubble = new MESSAGE_BUBBLE( m_chatPanel, m_currentResponse, false );
+        m_chatSizer->Add( m_currentBubble, 0, wxALIGN_LEFT | wxALL, 5 );
+        m_chatSizer->Layout();
+        m_chatPanel->Layout();
+    }
+    else
+    {
+        setBubbleText( m_currentResponse );
+    }
+
+    // Start read-only tool calls (symbol searches, lookups) as soon as they are complete
+    // rather than after the model has finished the whole plan.
+    std::vector<SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL> calls;
+    m_callParser.Feed( aChunk, calls );
+
+    for( const SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL& call : calls )
+        m_tool->PrefetchToolCall( call.name, call.payload );
+
+    // Scroll to bottom periodically (not on every chunk to reduce overhead)
+    if( ( ++m_chunkCount % 10 ) == 0 )
+        scrollToBottom();
+}
+
+
+void SCH_OLLAMA_AGENT_DIALOG::onStreamFinished( bool aSuccess, const wxString& aResponse,
+                                                const OLLAMA_CLIENT::STREAM_STATS* aStats )
+{
+    if( m_requestTask.valid() )
+        m_requestTask.wait();
+
+    if( aSuccess && aStats )
+    {
+        SCH_AGENT_PROFILE& profile = m_tool->Profile();
+
+        profile.AddPhase( SCH_AGENT_PROFILE::PHASE::FIRST_TOKEN, aStats->firstChunkMsecs );
+        profile.AddPhase( SCH_AGENT_PROFILE::PHASE::GENERATION,
+                          aStats->totalMsecs - aStats->firstChunkMsecs );
+
+        // Fall back to estimates when the server does not report token counts
+        long long sent = aStats->promptTokens >= 0 ? aStats->promptTokens
+                                                   : m_requestPrompt.length() / 4;
+        long long received = aStats->responseTokens >= 0 ? aStats->responseTokens
+                                                         : aStats->chunks;
+
+        profile.SetTokens( sent, received, aStats->evalSecs );
+    }
+
+    if( aSuccess )
+    {
+        if( m_currentBubble )
+        {
+            // Finalize the bubble with the complete response
+            setBubbleText( aResponse );
+            m_chatSizer->Layout();
+            m_chatPanel->Layout();
+            m_currentBubble = nullptr;
+        }
+        else
+        {
+            // No streaming happened, add as normal message
+            AddAgentMessage( aResponse );
+        }
+
+        // Schematic edits must happen on the UI thread
+        if( m_tool->ParseAndExecute( aResponse ) && !m_requestCached && !m_tool->LastRunChanged() )
+        {
+            if( std::shared_ptr<OLLAMA_CLIENT> client = m_tool->GetOllama() )
+                client->RememberResponse( m_tool->GetModel(), m_requestPrompt, wxEmptyString,
+                                          aResponse );
+        }
+
+        showProfile();
+    }
+    else
+    {
+        // Clean up streaming bubble on error
+        if( m_currentBubble )
+        {
+            m_chatSizer->Detach( m_currentBubble );
+            m_currentBubble->Destroy();
+            m_currentBubble = nullptr;
+            m_chatSizer->Layout();
+            m_chatPanel->Layout();
+        }
+
+        AddAgentMessage( _( "Error: Failed to communicate with Python agent. Make sure the agent is running (default: http://127.0.0.1:5001)" ) );
+    }
+
+    endRequest();
+}
+
+
 void SCH_OLLAMA_AGENT_DIALOG::scrollToBottom()
 {
     wxSize size = m_chatPanel->GetVirtualSize();
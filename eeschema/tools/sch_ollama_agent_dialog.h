@@ -20,11 +20,19 @@
 #ifndef SCH_OLLAMA_AGENT_DIALOG_H
 #define SCH_OLLAMA_AGENT_DIALOG_H
 
+#include <atomic>
+#include <future>
 #include <wx/dialog.h>
 #include <wx/string.h>
 
+#include "sch_agent_tool_call_parser.h"
+#include <ollama_client.h>
+
+#define DIALOG_OLLAMA_AGENT_WINDOW_NAME "DialogOllamaAgentWindowName"
+
 class wxTextCtrl;
 class wxButton;
+class wxStaticText;
 class wxPanel;
 class wxBoxSizer;
 class wxScrolledWindow;
@@ -36,6 +44,9 @@ class MESSAGE_BUBBLE;
 /**
  * Chat-style dialog for interacting with Ollama agent.
  * Similar to Cursor's chat interface with message history.
+ *
+ * The dialog is modeless and requests are streamed on a worker thread, so the editor stays
+ * usable while the model is generating.  Only the resulting commands run on the UI thread.
  */
 class SCH_OLLAMA_AGENT_DIALOG : public wxDialog
 {
@@ -66,15 +77,51 @@ private:
     void scrollToBottom();
     void addMessageToChat( const wxString& aMessage, bool aIsUser );
 
+    /// Called on the UI thread for every piece of text streamed by the worker.
+    void onStreamChunk( const wxString& aChunk );
+
+    /**
+     * Called on the UI thread once the worker has finished.  \a aStats is null for a response
+     * replayed from the cache.
+     */
+    void onStreamFinished( bool aSuccess, const wxString& aResponse,
+                           const OLLAMA_CLIENT::STREAM_STATS* aStats = nullptr );
+
+    /**
+     * Called on the UI thread with the plan the draft model produced in \a aMsecs, while the
+     * worker already streams the main model's answer.  An applied draft cancels that answer.
+     */
+    void onDraftReceived( const wxString& aDraft, double aMsecs );
+
+    /// Show the profile of the finished turn in the status line.
+    void showProfile();
+
+    /// Make the dialog ready for the next message.
+    void endRequest();
+
+    /// Abort the running request (if any) and wait for its worker to exit.
+    void cancelRequest();
+
+    void setBubbleText( const wxString& aText );
+
     SCH_OLLAMA_AGENT_TOOL* m_tool;
     wxScrolledWindow* m_chatPanel;
     wxBoxSizer* m_chatSizer;
     wxTextCtrl* m_inputCtrl;
     wxButton* m_sendButton;
     wxButton* m_clearButton;
+    wxStaticText* m_statusText;
     bool m_isProcessing;
     wxString m_currentResponse;  // Accumulated response during streaming
     MESSAGE_BUBBLE* m_currentBubble;  // Current streaming bubble
+    int m_chunkCount;
+    SCH_AGENT_TOOL_CALL_PARSER m_callParser;  // Spots tool calls while the response streams
+    wxString m_requestPrompt;    // Prompt of the pending request, for the response cache
+    bool m_requestCached;        // The pending response was replayed from the cache
+    unsigned m_requestSerial;    // Lets events queued for an earlier request be ignored
+
+    std::atomic<bool> m_cancelRequest;
+    std::future<void> m_requestTask;
 };
 
 #endif // SCH_OLLAMA_AGENT_DIALOG_H
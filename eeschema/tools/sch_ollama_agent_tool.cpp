@@ -19,6 +19,7 @@
 
 #include "sch_ollama_agent_tool.h"
 #include "sch_ollama_agent_dialog.h"
+#include "sch_agent_tool_call_parser.h"
 #include <sch_edit_frame.h>
 #include <dialogs/dialog_text_entry.h>
 #include <confirm.h>
@@ -35,6 +36,9 @@
 #include <sch_pin.h>
 #include <sch_field.h>
 #include <sch_connection.h>
+#include <tools/sch_selection_tool.h>
+#include <view/view.h>
+#include <sch_free_slot_finder.h>
 #include <stroke_params.h>
 #include <math/box2.h>
 #include <project_sch.h>
@@ -44,6 +48,11 @@
 #include <map>
 #include <vector>
 #include <limits>
+#include <thread_pool.h>
+#include <advanced_config.h>
+#include <lib_symbol.h>
+#include <core/profile.h>
+#include <trace_helpers.h>
 
 using json = nlohmann::json;
 #include <sch_commit.h>
@@ -57,6 +66,52 @@ SCH_OLLAMA_AGENT_TOOL::SCH_OLLAMA_AGENT_TOOL() :
 }
 
 
+SCH_OLLAMA_AGENT_TOOL::~SCH_OLLAMA_AGENT_TOOL()
+{
+    cancelRequest();
+
+    m_cancelEmbedding.store( true );
+
+    if( m_embeddingTask.valid() )
+        m_embeddingTask.wait();
+
+    waitForBackgroundTasks();
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::cancelRequest()
+{
+    if( m_cancelRequest )
+        m_cancelRequest->store( true );
+
+    if( m_requestTask.valid() )
+        m_requestTask.wait();
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::waitForBackgroundTasks()
+{
+    // Background tools use this object until they finish
+    for( std::future<void>& task : m_backgroundTasks )
+    {
+        if( task.valid() )
+            task.wait();
+    }
+
+    m_backgroundTasks.clear();
+
+    clearPrefetched();
+
+    for( std::shared_future<TOOL_OUTCOME>& outcome : m_droppedPrefetches )
+    {
+        if( outcome.valid() )
+            outcome.wait();
+    }
+
+    m_droppedPrefetches.clear();
+}
+
+
 bool SCH_OLLAMA_AGENT_TOOL::Init()
 {
     if( !SCH_TOOL_BASE<SCH_EDIT_FRAME>::Init() )
@@ -66,10 +121,43 @@ bool SCH_OLLAMA_AGENT_TOOL::Init()
     // to avoid potential exceptions during tool initialization
     m_agent = std::make_unique<SCH_AGENT>( m_frame );
 
+    m_context = std::make_unique<SCH_AGENT_CONTEXT>();
+    m_context->SetSchematic( &m_frame->Schematic() );
+
+    m_symbolIndex = std::make_unique<SCH_SYMBOL_INDEX>();
+    m_symbolIndex->SetSchematic( &m_frame->Schematic() );
+
     return true;
 }
 
 
+void SCH_OLLAMA_AGENT_TOOL::Reset( RESET_REASON aReason )
+{
+    if( aReason != MODEL_RELOAD )
+        return;
+
+    if( m_context )
+        m_context->SetSchematic( &m_frame->Schematic() );
+
+    if( m_symbolIndex )
+        m_symbolIndex->SetSchematic( &m_frame->Schematic() );
+
+    // The semantic index belongs to the previous project's libraries
+    m_cancelEmbedding.store( true );
+
+    if( m_embeddingTask.valid() )
+        m_embeddingTask.wait();
+
+    // So do the lookups still running
+    waitForBackgroundTasks();
+
+    std::lock_guard<std::mutex> lock( m_searchMutex );
+    m_embeddingIndex.reset();
+    m_embeddingClient.reset();
+    m_cancelEmbedding.store( false );
+}
+
+
 int SCH_OLLAMA_AGENT_TOOL::ProcessRequest( const TOOL_EVENT& aEvent )
 {
     wxString userRequest;
@@ -93,67 +181,176 @@ int SCH_OLLAMA_AGENT_TOOL::ProcessRequest( const TOOL_EVENT& aEvent )
     if( userRequest.IsEmpty() )
         return 0;
 
-    // Initialize ollama client lazily if needed
-    if( !m_ollama )
+    std::shared_ptr<OLLAMA_CLIENT> client = GetOllama();
+
+    if( !client )
     {
-        try
-        {
-            m_ollama = std::make_unique<OLLAMA_CLIENT>();
-        }
-        catch( ... )
-        {
-            DisplayError( m_frame, _( "Failed to initialize Python agent client. Please check your network configuration." ) );
-            return 0;
-        }
+        DisplayError( m_frame, _( "Failed to initialize Python agent client. Please check your network configuration." ) );
+        return 0;
     }
 
-    // Append full schematic context before sending to Python pcb_agent.
-    wxString context = GetFullSchematicContext();
-    wxString prompt = userRequest;
+    // Its answer would be executed on top of this one
+    cancelRequest();
+
+    m_profile.Reset();
+
+    // The schematic context (ranked for the request if it doesn't fit whole) changes less
+    // between turns than the request, so it goes first for the server to reuse its prefix.
+    wxString context = GetRankedSchematicContext( userRequest );
+    wxString prompt;
     if( !context.IsEmpty() )
-        prompt << wxS( "\n\n" ) << context;
+        prompt << context << wxS( "\n\n" );
+    prompt << userRequest;
 
-    // Send request to Python agent (which handles prompt building, RAG, etc.)
     wxString response;
-    if( !m_ollama->ChatCompletion( m_model, prompt, response ) )
+
+    if( client->FindCachedResponse( m_model, prompt, wxEmptyString, response ) )
     {
-        DisplayError( m_frame, _( "Failed to communicate with Python agent server." ) );
+        onResponseReceived( prompt, true, response, nullptr );
         return 0;
     }
 
+    // Routine commands are first drafted by the small model, if there is one
+    wxString draftModel;
+
+    if( IsSimpleRequest( userRequest ) )
+        draftModel = ADVANCED_CFG::GetCfg().m_AgentDraftModel;
+
+    std::shared_ptr<std::atomic<bool>> cancel = std::make_shared<std::atomic<bool>>( false );
+    wxString                           model = m_model;
+    SCH_EDIT_FRAME*                    frame = m_frame;
+
+    m_cancelRequest = cancel;
+
+    // The worker itself only uses the client and the request.  The callbacks it posts to the
+    // UI thread check the cancel flag before touching the tool, which sets the flag and waits
+    // for the worker before it goes away.
+    m_requestTask = GetKiCadThreadPool().submit_task(
+            [this, client, cancel, frame, model, draftModel, prompt]()
+            {
+                if( !draftModel.IsEmpty() )
+                {
+                    PROF_TIMER draftTimer;
+                    wxString   draft;
+
+                    if( client->StreamChatCompletion( draftModel, prompt, nullptr, draft,
+                                                      cancel.get() ) )
+                    {
+                        double msecs = draftTimer.msecs();
+
+                        // Checked against the schematic on the UI thread while the main model
+                        // already works on the request below
+                        frame->CallAfter( [this, cancel, draft, msecs]()
+                                          {
+                                              if( !cancel->load() )
+                                                  onDraftReceived( draft, msecs );
+                                          } );
+                    }
+                }
+
+                OLLAMA_CLIENT::STREAM_STATS stats;
+                wxString                    mainResponse;
+                bool ok = client->StreamChatCompletion( model, prompt, nullptr, mainResponse,
+                                                        cancel.get(), wxString(), &stats );
+
+                if( cancel->load() )
+                    return;
+
+                frame->CallAfter( [this, cancel, prompt, ok, mainResponse, stats]()
+                                  {
+                                      if( !cancel->load() )
+                                          onResponseReceived( prompt, ok, mainResponse, &stats );
+                                  } );
+            } );
+
+    return 0;
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::onDraftReceived( const wxString& aDraft, double aMsecs )
+{
+    PROF_TIMER timer;
+    bool       applied = ApplyDraftPlan( aDraft );
+
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::DRAFT, aMsecs + timer.msecs() );
+
+    // Otherwise the main model's answer is already on its way
+    if( !applied )
+        return;
+
+    m_cancelRequest->store( true );
+    wxLogTrace( traceAgentProfile, wxS( "Agent turn profile:\n%s" ), m_profile.ToJson() );
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::onResponseReceived( const wxString& aPrompt, bool aSuccess,
+                                                const wxString& aResponse,
+                                                const OLLAMA_CLIENT::STREAM_STATS* aStats )
+{
+    if( !aSuccess )
+    {
+        DisplayError( m_frame, _( "Failed to communicate with Python agent server." ) );
+        return;
+    }
+
+    if( aStats )
+    {
+        m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::FIRST_TOKEN, aStats->firstChunkMsecs );
+        m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::GENERATION,
+                            aStats->totalMsecs - aStats->firstChunkMsecs );
+
+        // Fall back to the usual ~4 characters per token when the server reports no counts
+        long long sent = aStats->promptTokens >= 0 ? aStats->promptTokens : aPrompt.length() / 4;
+        long long received = aStats->responseTokens >= 0 ? aStats->responseTokens
+                                                         : aResponse.length() / 4;
+
+        m_profile.SetTokens( sent, received, aStats->evalSecs );
+    }
+
     // Parse and execute
-    if( !ParseAndExecute( response ) )
+    if( !ParseAndExecute( aResponse ) )
     {
         DisplayInfoMessage( m_frame, _( "Agent response received but could not parse commands." ),
                            _( "Ollama Agent" ) );
     }
+    else if( aStats && !LastRunChanged() )
+    {
+        // A read-only answer stays valid as long as the same context would be sent again
+        m_ollama->RememberResponse( m_model, aPrompt, wxEmptyString, aResponse );
+    }
 
-    return 0;
+    wxLogTrace( traceAgentProfile, wxS( "Agent turn profile:\n%s" ), m_profile.ToJson() );
 }
 
 
 int SCH_OLLAMA_AGENT_TOOL::ShowAgentDialog( const TOOL_EVENT& aEvent )
 {
-    SCH_OLLAMA_AGENT_DIALOG dlg( m_frame, this );
-    dlg.ShowModal();
+    // Modeless, so the schematic can still be edited while the agent is working
+    wxWindow* dlg = wxWindow::FindWindowByName( DIALOG_OLLAMA_AGENT_WINDOW_NAME, m_frame );
+
+    if( !dlg )
+        dlg = new SCH_OLLAMA_AGENT_DIALOG( m_frame, this );
+
+    dlg->Show( true );
+    dlg->Raise();
     return 0;
 }
 
 
-OLLAMA_CLIENT* SCH_OLLAMA_AGENT_TOOL::GetOllama()
+std::shared_ptr<OLLAMA_CLIENT> SCH_OLLAMA_AGENT_TOOL::GetOllama()
 {
     if( !m_ollama )
     {
         try
         {
-            m_ollama = std::make_unique<OLLAMA_CLIENT>();
+            m_ollama = std::make_shared<OLLAMA_CLIENT>();
         }
         catch( ... )
         {
             return nullptr;
         }
     }
-    return m_ollama.get();
+    return m_ollama;
 }
 
 
@@ -445,218 +642,107 @@ wxString SCH_OLLAMA_AGENT_TOOL::GetCurrentSchematicContent()
 
 wxString SCH_OLLAMA_AGENT_TOOL::GetFullSchematicContext( size_t aMaxChars )
 {
-    if( !m_frame )
+    if( !m_frame || !m_context )
         return wxEmptyString;
 
-    SCHEMATIC& schematic = m_frame->Schematic();
-    SCH_SHEET_LIST sheets = schematic.Hierarchy();
-    sheets.SortByPageNumbers();
-
-    wxString out;
-    out << wxS( "KICAD_SCHEMATIC_CONTEXT (all sheets)\n" );
-    out << wxS( "Coordinate system: mm. +X is right. +Y is down. Values are schematic sheet coordinates.\n" );
-    out << wxS( "Current sheet: " ) << m_frame->GetFullScreenDesc() << wxS( "\n" );
-    out << wxS( "Sheet count: " ) << wxString::Format( wxS( "%d" ), (int) sheets.size() ) << wxS( "\n\n" );
-
-    // Netlist-ish view built from per-pin connections.
-    std::map<wxString, std::vector<wxString>> netToNodes;
-
-    for( const SCH_SHEET_PATH& sheetPath : sheets )
-    {
-        SCH_SCREEN* screen = sheetPath.LastScreen();
-        if( !screen )
-            continue;
-
-        out << wxS( "=== SHEET ===\n" );
-        out << wxS( "Path: " ) << sheetPath.PathHumanReadable() << wxS( "\n" );
-        out << wxS( "Page: " ) << sheetPath.GetPageNumber() << wxS( "\n" );
-        if( sheetPath.Last() )
-            out << wxS( "File: " ) << sheetPath.Last()->GetFileName() << wxS( "\n" );
+    PROF_TIMER timer;
+    wxString   context = m_context->GetSnapshot( m_frame->GetFullScreenDesc(), aMaxChars );
 
-        int componentCount = 0;
-        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
-        {
-            SCH_SYMBOL* symbol = static_cast<SCH_SYMBOL*>( item );
-            if( !symbol )
-                continue;
-
-            componentCount++;
-
-            wxString ref = symbol->GetRef( &sheetPath, true );
-            wxString libId = symbol->GetLibId().Format();
-            VECTOR2I symPos = symbol->GetPosition();
-            double sx = schIUScale.IUTomm( symPos.x );
-            double sy = schIUScale.IUTomm( symPos.y );
-            int orientProp = static_cast<int>( symbol->GetOrientationProp() ); // 0/90/180/270
-
-            wxString value;
-            wxString footprint;
-            wxString datasheet;
-
-            SCH_FIELDS fields = symbol->GetFields();
-            for( const SCH_FIELD& field : fields )
-            {
-                if( field.GetText().IsEmpty() )
-                    continue;
-
-                wxString name = field.GetName();
-                if( name.IsEmpty() )
-                    continue;
-
-                if( name.CmpNoCase( wxS( "Value" ) ) == 0 )
-                    value = field.GetText();
-                else if( name.CmpNoCase( wxS( "Footprint" ) ) == 0 )
-                    footprint = field.GetText();
-                else if( name.CmpNoCase( wxS( "Datasheet" ) ) == 0 )
-                    datasheet = field.GetText();
-            }
-
-            BOX2I bbox = symbol->GetBoundingBox();
-            double bxmin = schIUScale.IUTomm( bbox.GetX() );
-            double bymin = schIUScale.IUTomm( bbox.GetY() );
-            double bxmax = schIUScale.IUTomm( bbox.GetRight() );
-            double bymax = schIUScale.IUTomm( bbox.GetBottom() );
-            double width = bxmax - bxmin;
-            double height = bymax - bymin;
-
-            out << wxString::Format( wxS( " - %s (%s) value=%s footprint=%s datasheet=%s pos=(%.2f, %.2f) rot=%d size=(%.2f, %.2f)mm bbox=(%.2f, %.2f, %.2f, %.2f)\n" ),
-                                     ref, libId, value, footprint, datasheet, sx, sy, orientProp, width, height, bxmin, bymin, bxmax, bymax );
-
-            std::vector<SCH_PIN*> pins = symbol->GetPins( &sheetPath );
-            for( SCH_PIN* pin : pins )
-            {
-                if( !pin )
-                    continue;
-
-                wxString pinNumber = pin->GetShownNumber();
-                wxString pinName = pin->GetShownName();
-                VECTOR2I pinPos = pin->GetPosition();
-                double px = schIUScale.IUTomm( pinPos.x );
-                double py = schIUScale.IUTomm( pinPos.y );
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::CONTEXT, timer.msecs() );
+    return context;
+}
 
-                wxString pinOrient = wxS( "UNKNOWN" );
-                switch( pin->GetOrientation() )
-                {
-                default:
-                    break;
-                case PIN_ORIENTATION::PIN_RIGHT: pinOrient = wxS( "RIGHT" ); break;
-                case PIN_ORIENTATION::PIN_LEFT:  pinOrient = wxS( "LEFT" ); break;
-                case PIN_ORIENTATION::PIN_UP:    pinOrient = wxS( "UP" ); break;
-                case PIN_ORIENTATION::PIN_DOWN:  pinOrient = wxS( "DOWN" ); break;
-                }
 
-                wxString netName = wxS( "<unconnected>" );
-                if( SCH_CONNECTION* conn = pin->Connection( &sheetPath ) )
-                {
-                    netName = conn->Name();
-                    if( netName.IsEmpty() )
-                        netName = wxS( "<unnamed>" );
-                }
+wxString SCH_OLLAMA_AGENT_TOOL::GetRankedSchematicContext( const wxString& aRequest,
+                                                          size_t aMaxChars )
+{
+    if( !m_frame || !m_context )
+        return wxEmptyString;
 
-                wxString node = ref + wxS( ":" ) + pinNumber;
-                if( !pinName.IsEmpty() )
-                    node << wxS( "(" ) << pinName << wxS( ")" );
-                node << wxString::Format( wxS( "@(%.2f,%.2f,%s)" ), px, py, pinOrient );
+    PROF_TIMER                timer;
+    SCH_AGENT_CONTEXT::FOCUS focus;
 
-                netToNodes[netName].push_back( node );
-            }
+    focus.request = aRequest;
+    focus.sheetKey = m_frame->GetCurrentSheet().PathAsString();
+    focus.viewBox = BOX2ISafe( getView()->GetViewport() );
+    focus.viewBox.Normalize();
 
-            if( aMaxChars > 0 && (size_t) out.length() > aMaxChars )
-            {
-                out << wxS( "\n[TRUNCATED: schematic context exceeded size limit]\n" );
-                return out;
-            }
-        }
+    for( EDA_ITEM* item : m_selectionTool->GetSelection() )
+    {
+        if( item->Type() == SCH_SYMBOL_T )
+            focus.selection.insert( item->m_Uuid );
+    }
 
-        if( componentCount == 0 )
-            out << wxS( "(no components)\n" );
+    wxString context = m_context->GetRankedSnapshot( m_frame->GetFullScreenDesc(), focus,
+                                                     aMaxChars );
 
-        out << wxS( "\n" );
-    }
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::CONTEXT, timer.msecs() );
+    return context;
+}
 
-    out << wxS( "=== NETS (from pin connections) ===\n" );
-    for( const auto& kv : netToNodes )
-    {
-        const wxString& netName = kv.first;
-        const std::vector<wxString>& nodes = kv.second;
 
-        out << wxS( "* " ) << netName << wxS( ": " );
-        for( size_t i = 0; i < nodes.size(); i++ )
-        {
-            out << nodes[i];
-            if( i + 1 < nodes.size() )
-                out << wxS( ", " );
-        }
-        out << wxS( "\n" );
+wxString SCH_OLLAMA_AGENT_TOOL::GetSchematicContextDelta( size_t aMaxChars )
+{
+    if( !m_frame || !m_context )
+        return wxEmptyString;
 
-        if( aMaxChars > 0 && (size_t) out.length() > aMaxChars )
-        {
-            out << wxS( "\n[TRUNCATED: schematic context exceeded size limit]\n" );
-            return out;
-        }
-    }
+    PROF_TIMER timer;
+    wxString   context = m_context->GetDelta( m_frame->GetFullScreenDesc(), aMaxChars );
 
-    return out;
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::CONTEXT, timer.msecs() );
+    return context;
 }
 
 
+/**
+ * @return true for the (lower case) names of every tool ExecuteToolCommand() handles.
+ */
+static bool isSupportedTool( const wxString& aLowerName )
+{
+    return aLowerName == wxS( "schematic.place_component" )
+           || aLowerName == wxS( "schematic.move_component" )
+           || aLowerName == wxS( "schematic.add_wire" )
+           || aLowerName == wxS( "schematic.add_net_label" )
+           || aLowerName == wxS( "schematic.add_global_label" )
+           || aLowerName == wxS( "schematic.add_label" )
+           || aLowerName == wxS( "schematic.connect_with_net_label" )
+           || aLowerName == wxS( "schematic.connect_with_global_label" )
+           || aLowerName == wxS( "schematic.get_datasheet" )
+           || aLowerName == wxS( "schematic.get_symbol_info" )
+           || aLowerName == wxS( "schematic.search_symbol" )
+           || aLowerName == wxS( "mock.selection_inspector" );
+}
 
 
 bool SCH_OLLAMA_AGENT_TOOL::ParseAndExecute( const wxString& aResponse )
 {
-    bool success = false;
+    bool       success = false;
+    PROF_TIMER executeTimer;
+
+    m_batchItems.clear();
     m_agent->BeginBatch();
+    m_wireRouter.reset();
 
-    wxStringTokenizer tokenizer( aResponse, wxS( "\n" ) );
-    std::set<std::string> unknownToolsLogged;
-    
-    while( tokenizer.HasMoreTokens() )
-    {
-        wxString line = tokenizer.GetNextToken().Trim();
-        
-        if( line.IsEmpty() || line.StartsWith( wxS( "#" ) ) )
-            continue;
+    // The same parser as the one spotting calls for prefetching while the response streams, so
+    // multi-line payloads run once and match their prefetched results.
+    SCH_AGENT_TOOL_CALL_PARSER                         parser( true );
+    std::vector<SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL> calls;
+    std::set<std::string>                              unknownToolsLogged;
 
-        wxString upperLine = line.Upper();
+    parser.Feed( aResponse, calls );
+    parser.Finish( calls );
 
-        if( upperLine.StartsWith( wxS( "TOOL" ) ) )
+    for( const SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL& call : calls )
+    {
+        if( !call.name.IsEmpty() )
         {
-            wxString rest = line.Mid( 4 );
-            rest.Trim();
-            rest.Trim( false );
-
-            wxString toolName = rest.BeforeFirst( ' ' ).Trim();
-            wxString payload;
-
-            if( rest.Contains( wxS( " " ) ) )
-            {
-                payload = rest.AfterFirst( ' ' );
-                payload.Trim();
-                payload.Trim( false );
-            }
-
-            if( toolName.IsEmpty() )
-                continue;
+            const wxString& toolName = call.name;
+            const wxString& payload = call.payload;
 
             wxString lowerTool = toolName;
             lowerTool.MakeLower();
 
-            // Bug fix: Updated to include all tools that ExecuteToolCommand actually handles
-            bool supportedTool =
-                    lowerTool == wxS( "schematic.place_component" )
-                    || lowerTool == wxS( "schematic.move_component" )
-                    || lowerTool == wxS( "schematic.add_wire" )
-                    || lowerTool == wxS( "schematic.add_net_label" )
-                    || lowerTool == wxS( "schematic.add_global_label" )
-                    || lowerTool == wxS( "schematic.add_label" )
-                    || lowerTool == wxS( "schematic.connect_with_net_label" )
-                    || lowerTool == wxS( "schematic.connect_with_global_label" )
-                    || lowerTool == wxS( "schematic.get_datasheet" )
-            || lowerTool == wxS( "schematic.get_symbol_info" )
-                    || lowerTool == wxS( "schematic.search_symbol" )
-                    || lowerTool == wxS( "mock.selection_inspector" );
-
-            if( !supportedTool )
+            if( !isSupportedTool( lowerTool ) )
             {
                 std::string normalizedTool = lowerTool.ToStdString();
 
@@ -674,6 +760,13 @@ bool SCH_OLLAMA_AGENT_TOOL::ParseAndExecute( const wxString& aResponse )
                 m_toolCallHandler->HandleToolCall( toolName, payload );
                 success = true;
             }
+            else if( IsBackgroundTool( toolName ) )
+            {
+                // Lookups only read the libraries and nothing here uses their answer, so start
+                // them on the thread pool (unless already prefetched) rather than block the UI.
+                PrefetchToolCall( toolName, payload );
+                success = true;
+            }
             else if( ExecuteToolCommand( toolName, payload ) )
             {
                 success = true;
@@ -682,6 +775,9 @@ bool SCH_OLLAMA_AGENT_TOOL::ParseAndExecute( const wxString& aResponse )
             continue;
         }
 
+        const wxString& line = call.line;
+        wxString        upperLine = line.Upper();
+
         // Parse JUNCTION command
         if( upperLine.StartsWith( wxS( "JUNCTION" ) ) )
         {
@@ -767,18 +863,70 @@ bool SCH_OLLAMA_AGENT_TOOL::ParseAndExecute( const wxString& aResponse )
         }
     }
 
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::EXECUTION, executeTimer.msecs() );
+
+    PROF_TIMER commitTimer;
+
+    m_lastRunChanged = !m_agent->GetCommit()->Empty();
     m_agent->EndBatch( _( "Ollama agent operation" ) );
+    m_wireRouter.reset();
+    updateAndSelect( m_batchItems );
+    m_batchItems.clear();
+
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::COMMIT, commitTimer.msecs() );
+
+    // Speculative calls the final response did not contain anymore, and the lookups above
+    clearPrefetched();
+
     return success;
 }
 
 
 
 
+static wxString prefetchKey( const wxString& aToolName, const wxString& aPayload )
+{
+    wxString payload = aPayload;
+    payload.Trim( true ).Trim( false );
+
+    return aToolName.Lower() + wxS( "\n" ) + payload;
+}
+
+
 bool SCH_OLLAMA_AGENT_TOOL::ExecuteToolCommand( const wxString& aToolName, const wxString& aPayload )
+{
+    PROF_TIMER timer;
+    bool       ok = dispatchToolCommand( aToolName, aPayload );
+
+    m_profile.AddTool( aToolName, timer.msecs() );
+    return ok;
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::dispatchToolCommand( const wxString& aToolName, const wxString& aPayload )
 {
     m_lastToolError.clear();
     m_lastToolResult.clear();
 
+    // Other tools may move or add items the cached routing grid doesn't know about
+    if( aToolName.CmpNoCase( wxS( "schematic.add_wire" ) ) != 0 )
+        m_wireRouter.reset();
+
+    if( !m_prefetched.empty() && IsBackgroundTool( aToolName ) )
+    {
+        auto it = m_prefetched.find( prefetchKey( aToolName, aPayload ) );
+
+        if( it != m_prefetched.end() )
+        {
+            TOOL_OUTCOME outcome = it->second.get();
+            m_prefetched.erase( it );
+
+            m_lastToolResult = outcome.result;
+            m_lastToolError = outcome.error;
+            return outcome.ok;
+        }
+    }
+
     if( aToolName.CmpNoCase( wxS( "mock.selection_inspector" ) ) == 0 )
     {
         wxLogMessage( wxS( "[OllamaAgent] mock tool '%s' invoked with payload: %s" ),
@@ -872,7 +1020,8 @@ bool SCH_OLLAMA_AGENT_TOOL::ExecuteToolCommand( const wxString& aToolName, const
         try
         {
             json payload = aPayload.IsEmpty() ? json::object() : json::parse( aPayload.ToStdString() );
-            return HandleSearchSymbolTool( payload );
+            return HandleSearchSymbolTool( libraryAccess(), payload, m_lastToolResult,
+                                           m_lastToolError );
         }
         catch( const json::exception& e )
         {
@@ -888,7 +1037,8 @@ bool SCH_OLLAMA_AGENT_TOOL::ExecuteToolCommand( const wxString& aToolName, const
         try
         {
             json payload = aPayload.IsEmpty() ? json::object() : json::parse( aPayload.ToStdString() );
-            return HandleGetSymbolInfoTool( payload );
+            return HandleGetSymbolInfoTool( libraryAccess(), payload, m_lastToolResult,
+                                            m_lastToolError );
         }
         catch( const json::exception& e )
         {
@@ -976,9 +1126,25 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleGetDatasheetTool( const json& aPayload )
 }
 
 
-bool SCH_OLLAMA_AGENT_TOOL::HandleSearchSymbolTool( const json& aPayload )
+SCH_OLLAMA_AGENT_TOOL::LIBRARY_ACCESS SCH_OLLAMA_AGENT_TOOL::libraryAccess() const
 {
-    if( !m_frame || !aPayload.is_object() )
+    LIBRARY_ACCESS libs;
+
+    if( m_frame )
+    {
+        libs.project = &m_frame->Prj();
+        libs.adapter = PROJECT_SCH::SymbolLibAdapter( libs.project );
+    }
+
+    return libs;
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::HandleSearchSymbolTool( const LIBRARY_ACCESS& aLibs,
+                                                    const json& aPayload, wxString& aResult,
+                                                    wxString& aError )
+{
+    if( !aLibs.project || !aPayload.is_object() )
         return false;
 
     wxString query;
@@ -993,172 +1159,187 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleSearchSymbolTool( const json& aPayload )
 
     if( query.IsEmpty() )
     {
-        m_lastToolError = _( "search_symbol requires \"query\" (string)." );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        aError = _( "search_symbol requires \"query\" (string)." );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
-    SYMBOL_LIBRARY_ADAPTER* adapter = PROJECT_SCH::SymbolLibAdapter( &m_frame->Prj() );
+    SYMBOL_LIBRARY_ADAPTER* adapter = aLibs.adapter;
     if( !adapter )
     {
-        m_lastToolError = _( "search_symbol: symbol library adapter not available." );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        aError = _( "search_symbol: symbol library adapter not available." );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
-    auto normalize = [&]( const wxString& s ) -> wxString
+    // Names are served from the adapter's persistent index; only libraries whose files
+    // changed since the last query (or the last session) are re-enumerated.
+    SYMBOL_SEARCH_INDEX& index = adapter->SearchIndex();
+    PROJECT&             project = *aLibs.project;
+    wxString             cachePath;
+
+    if( !project.IsNullProject() )
+        cachePath = project.GetProjectPath() + wxS( "sym-search-cache" );
+
+    std::vector<SYMBOL_SEARCH_INDEX::MATCH> matches;
+
     {
-        // Lowercase, strip non-alnum, and normalize numeric runs by stripping leading zeros.
-        wxString in = s.Lower();
-        wxString out;
-        out.reserve( in.length() );
+        // May run on a worker thread; keep concurrent searches from syncing the index twice
+        std::lock_guard<std::mutex> lock( m_searchMutex );
 
-        auto flushNumber = [&]( wxString& num )
+        if( !cachePath.IsEmpty() && cachePath != m_symbolIndexCachePath )
         {
-            if( num.IsEmpty() )
-                return;
+            index.ReadCacheFromFile( cachePath );
+            m_symbolIndexCachePath = cachePath;
+        }
 
-            // Strip leading zeros but keep a single zero if the number is all zeros.
-            size_t i = 0;
-            while( i + 1 < num.length() && num[i] == '0' )
-                i++;
-            out << num.Mid( i );
-            num.Clear();
-        };
+        if( index.Synchronize( *adapter, project ) && !cachePath.IsEmpty() )
+            index.WriteCacheToFile( cachePath );
 
-        wxString num;
-        for( size_t i = 0; i < in.length(); i++ )
-        {
-            const wxChar c = in[i];
-            if( wxIsdigit( c ) )
-            {
-                num << c;
-                continue;
-            }
+        matches = index.Search( query, limit );
+    }
+
+    std::vector<SYMBOL_EMBEDDING_INDEX::MATCH> semantic = semanticSearch( query, limit, *adapter,
+                                                                          cachePath );
 
-            flushNumber( num );
+    json out = json::object();
+    out["query"] = query.ToStdString();
+    out["count"] = (int) matches.size();
+    out["matches"] = json::array();
 
-            if( wxIsalnum( c ) )
-                out << c;
+    for( const SYMBOL_SEARCH_INDEX::MATCH& m : matches )
+    {
+        json row = json::object();
+        row["library"] = m.library.ToStdString();
+        row["name"] = m.name.ToStdString();
+        row["lib_id"] = ( m.library + wxS( ":" ) + m.name ).ToStdString();
+        row["score"] = m.score;
+        out["matches"].push_back( row );
+    }
+
+    // Matches by meaning, from names, descriptions, keywords and datasheets
+    if( !semantic.empty() )
+    {
+        out["semantic_matches"] = json::array();
+
+        for( const SYMBOL_EMBEDDING_INDEX::MATCH& m : semantic )
+        {
+            json row = json::object();
+            row["lib_id"] = m.key.ToStdString();
+            row["similarity"] = m.score;
+            out["semantic_matches"].push_back( row );
         }
+    }
 
-        flushNumber( num );
-        return out;
-    };
+    aResult = wxString::FromUTF8( out.dump( 2 ) );
+    return true;
+}
 
-    wxString qLower = query.Lower();
-    wxString qAfterColon;
-    if( query.Contains( wxS( ":" ) ) )
-        qAfterColon = query.AfterFirst( ':' ).Trim();
 
-    wxString qNorm = normalize( query );
-    wxString qAfterNorm;
-    if( !qAfterColon.IsEmpty() )
-        qAfterNorm = normalize( qAfterColon );
+std::vector<SYMBOL_EMBEDDING_INDEX::MATCH>
+SCH_OLLAMA_AGENT_TOOL::semanticSearch( const wxString& aQuery, size_t aLimit,
+                                       SYMBOL_LIBRARY_ADAPTER& aAdapter,
+                                       const wxString& aCachePath )
+{
+    const wxString model = ADVANCED_CFG::GetCfg().m_AgentEmbeddingModel;
 
-    struct MATCH
-    {
-        int score = 0;
-        wxString lib;
-        wxString name;
-    };
+    if( model.IsEmpty() )
+        return {};
 
-    std::vector<MATCH> matches;
+    // Shared, so a search still running when the index is dropped keeps it alive
+    std::shared_ptr<SYMBOL_EMBEDDING_INDEX> index;
+    std::shared_ptr<OLLAMA_CLIENT>          client;
 
-    // Enumerate libraries and symbol names (can be expensive; keep limit small).
-    std::vector<wxString> libs = adapter->GetLibraryNames();
-    for( const wxString& lib : libs )
     {
-        // Load if needed so enumeration works.
-        adapter->LoadOne( lib );
+        std::lock_guard<std::mutex> lock( m_searchMutex );
 
-        std::vector<wxString> names = adapter->GetSymbolNames( lib );
-        for( const wxString& name : names )
+        if( !m_embeddingIndex )
         {
-            wxString nLower = name.Lower();
-            wxString nNorm = normalize( name );
+            wxString cacheFile = aCachePath.IsEmpty() ? wxString() : aCachePath + wxS( "-embeddings" );
 
-            auto scoreAgainst = [&]( const wxString& q, const wxString& qn ) -> int
-            {
-                if( q.IsEmpty() && qn.IsEmpty() )
-                    return 0;
+            m_embeddingIndex = std::make_shared<SYMBOL_EMBEDDING_INDEX>();
+            m_embeddingClient = std::make_shared<OLLAMA_CLIENT>();
 
-                int s = 0;
+            if( !cacheFile.IsEmpty() )
+                m_embeddingIndex->ReadCacheFromFile( cacheFile );
 
-                if( !q.IsEmpty() )
-                {
-                    if( nLower == q )
-                        s = std::max( s, 1000 );
-                    else if( nLower.StartsWith( q ) )
-                        s = std::max( s, 900 );
-                    else if( nLower.Find( q ) != wxNOT_FOUND )
-                        s = std::max( s, 700 );
-                }
+            // Embedding every symbol takes a while; until it is done the cached index (if any)
+            // answers, and only symbols whose text changed are embedded again.
+            m_embeddingTask = GetKiCadThreadPool().submit_task(
+                    [this, &aAdapter, model, cacheFile, index = m_embeddingIndex,
+                     client = m_embeddingClient]()
+                    {
+                        std::vector<SYMBOL_EMBEDDING_INDEX::DOCUMENT> docs;
 
-                if( !qn.IsEmpty() )
-                {
-                    if( nNorm == qn )
-                        s = std::max( s, 980 );
-                    else if( nNorm.StartsWith( qn ) )
-                        s = std::max( s, 880 );
-                    else if( nNorm.Find( qn ) != wxNOT_FOUND )
-                        s = std::max( s, 680 );
-                }
+                        for( const wxString& nickname : aAdapter.GetLibraryNames() )
+                        {
+                            if( m_cancelEmbedding.load() )
+                                return;
 
-                return s;
-            };
+                            for( LIB_SYMBOL* symbol : aAdapter.GetSymbols( nickname ) )
+                            {
+                                wxString text = symbol->GetName();
 
-            int score = 0;
-            score = std::max( score, scoreAgainst( qLower, qNorm ) );
-            score = std::max( score, scoreAgainst( qAfterColon.Lower(), qAfterNorm ) );
+                                if( !symbol->GetDescription().IsEmpty() )
+                                    text << wxS( "\n" ) << symbol->GetDescription();
 
-            if( score > 0 )
-                matches.push_back( MATCH{ score, lib, name } );
-        }
-    }
+                                if( !symbol->GetKeyWords().IsEmpty() )
+                                    text << wxS( "\nKeywords: " ) << symbol->GetKeyWords();
 
-    std::sort( matches.begin(), matches.end(),
-               []( const MATCH& a, const MATCH& b )
-               {
-                   if( a.score != b.score )
-                       return a.score > b.score;
-                   if( a.lib != b.lib )
-                       return a.lib < b.lib;
-                   return a.name < b.name;
-               } );
+                                if( !symbol->GetDatasheetField().GetText().IsEmpty() )
+                                    text << wxS( "\nDatasheet: " ) << symbol->GetDatasheetField().GetText();
 
-    if( (int) matches.size() > limit )
-        matches.resize( limit );
+                                docs.push_back( { nickname + wxS( ":" ) + symbol->GetName(), text } );
+                            }
+                        }
 
-    json out = json::object();
-    out["query"] = query.ToStdString();
-    out["count"] = (int) matches.size();
-    out["matches"] = json::array();
+                        auto embed =
+                                [&]( const std::vector<wxString>& aTexts,
+                                     std::vector<std::vector<float>>& aVectors )
+                                {
+                                    return client->Embed( model, aTexts, aVectors );
+                                };
 
-    for( const MATCH& m : matches )
-    {
-        json row = json::object();
-        row["library"] = m.lib.ToStdString();
-        row["name"] = m.name.ToStdString();
-        row["lib_id"] = ( m.lib + wxS( ":" ) + m.name ).ToStdString();
-        row["score"] = m.score;
-        out["matches"].push_back( row );
+                        PROF_TIMER timer;
+
+                        if( index->Update( docs, model, embed, &m_cancelEmbedding ) )
+                        {
+                            wxLogTrace( traceAgentProfile, wxS( "Symbol embedding index: %zu symbols, %0.1f ms" ),
+                                        docs.size(), timer.msecs() );
+
+                            if( !cacheFile.IsEmpty() )
+                                index->WriteCacheToFile( cacheFile );
+                        }
+                    } );
+        }
+
+        index = m_embeddingIndex;
+        client = m_embeddingClient;
     }
 
-    m_lastToolResult = wxString::FromUTF8( out.dump( 2 ) );
-    return true;
+    if( index->Size() == 0 || index->GetModel() != model )
+        return {};
+
+    std::vector<std::vector<float>> query;
+
+    if( !client->Embed( model, { aQuery }, query ) || query.empty() )
+        return {};
+
+    return index->Search( query.front(), aLimit );
 }
 
 
-bool SCH_OLLAMA_AGENT_TOOL::HandleGetSymbolInfoTool( const json& aPayload )
+bool SCH_OLLAMA_AGENT_TOOL::HandleGetSymbolInfoTool( const LIBRARY_ACCESS& aLibs,
+                                                     const json& aPayload, wxString& aResult,
+                                                     wxString& aError )
 {
-    if( !m_frame || !aPayload.is_object() )
+    if( !aLibs.adapter || !aPayload.is_object() )
         return false;
 
     if( !aPayload.contains( "symbol" ) || !aPayload["symbol"].is_string() )
     {
-        m_lastToolError = _( "get_symbol_info requires \"symbol\" (string), e.g. {\"symbol\":\"Device:R\"}." );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        aError = _( "get_symbol_info requires \"symbol\" (string), e.g. {\"symbol\":\"Device:R\"}." );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
@@ -1167,8 +1348,8 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleGetSymbolInfoTool( const json& aPayload )
 
     if( symbolId.IsEmpty() )
     {
-        m_lastToolError = _( "get_symbol_info requires a non-empty symbol identifier (libnick:symbol_name)." );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        aError = _( "get_symbol_info requires a non-empty symbol identifier (libnick:symbol_name)." );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
@@ -1177,17 +1358,18 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleGetSymbolInfoTool( const json& aPayload )
 
     if( libId.Parse( utfSymbol ) >= 0 || !libId.IsValid() )
     {
-        m_lastToolError = wxString::Format( _( "Unable to parse library identifier \"%s\". Use libnick:symbol_name." ),
+        aError = wxString::Format( _( "Unable to parse library identifier \"%s\". Use libnick:symbol_name." ),
                                             symbolId );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
-    LIB_SYMBOL* libSymbol = m_frame->GetLibSymbol( libId );
+    // Straight from the adapter: the frame may only be used on the UI thread
+    LIB_SYMBOL* libSymbol = SchGetLibSymbol( libId, aLibs.adapter );
     if( !libSymbol )
     {
-        m_lastToolError = wxString::Format( _( "Symbol \"%s\" not found in the current library tables." ), symbolId );
-        wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+        aError = wxString::Format( _( "Symbol \"%s\" not found in the current library tables." ), symbolId );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
         return false;
     }
 
@@ -1219,7 +1401,7 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleGetSymbolInfoTool( const json& aPayload )
     out["pin_count"] = (int) pins.size();
     out["pins"] = pins;
 
-    m_lastToolResult = wxString::FromUTF8( out.dump( 2 ) );
+    aResult = wxString::FromUTF8( out.dump( 2 ) );
     return true;
 }
 
@@ -1259,7 +1441,8 @@ bool SCH_OLLAMA_AGENT_TOOL::HandlePlaceComponentTool( const json& aPayload )
             q["query"] = symbolId.ToStdString();
             q["limit"] = 10;
 
-            if( HandleSearchSymbolTool( q ) && !m_lastToolResult.IsEmpty() )
+            if( HandleSearchSymbolTool( libraryAccess(), q, m_lastToolResult, m_lastToolError )
+                && !m_lastToolResult.IsEmpty() )
             {
                 json r = json::parse( m_lastToolResult.ToStdString() );
                 if( r.contains( "matches" ) && r["matches"].is_array() && !r["matches"].empty()
@@ -1305,8 +1488,11 @@ bool SCH_OLLAMA_AGENT_TOOL::HandlePlaceComponentTool( const json& aPayload )
             json q = json::object();
             q["query"] = symbolId.ToStdString();
             q["limit"] = 8;
-            if( HandleSearchSymbolTool( q ) && !m_lastToolResult.IsEmpty() )
+            if( HandleSearchSymbolTool( libraryAccess(), q, m_lastToolResult, m_lastToolError )
+                && !m_lastToolResult.IsEmpty() )
+            {
                 hint = wxS( "\nSuggestions (use the exact lib_id):\n" ) + m_lastToolResult;
+            }
 
             // If the user/model provided "LibNick:SymbolName" but the lib nickname is wrong,
             // also try searching by just the symbol name portion.
@@ -1315,8 +1501,12 @@ bool SCH_OLLAMA_AGENT_TOOL::HandlePlaceComponentTool( const json& aPayload )
                 json q2 = json::object();
                 q2["query"] = symbolId.AfterFirst( ':' ).ToStdString();
                 q2["limit"] = 8;
-                if( HandleSearchSymbolTool( q2 ) && !m_lastToolResult.IsEmpty() )
+                if( HandleSearchSymbolTool( libraryAccess(), q2, m_lastToolResult,
+                                            m_lastToolError )
+                    && !m_lastToolResult.IsEmpty() )
+                {
                     hint = wxS( "\nSuggestions (use the exact lib_id):\n" ) + m_lastToolResult;
+                }
             }
         }
         catch( ... )
@@ -1395,102 +1585,39 @@ bool SCH_OLLAMA_AGENT_TOOL::HandlePlaceComponentTool( const json& aPayload )
     {
         const int stepIU = schIUScale.mmToIU( 5.08 );      // 0.2" grid-ish
         const int marginIU = schIUScale.mmToIU( 1.0 );     // keep a small clearance
-        const int maxRadius = 30;                          // search radius in steps (~150mm)
-
-        auto overlapsExisting = [&]( const BOX2I& aBox ) -> bool
-        {
-            BOX2I test = aBox;
-            test.Inflate( marginIU );
-
-            for( SCH_ITEM* item : screen->Items() )
-            {
-                if( !item )
-                    continue;
-
-                // Only avoid obvious clutter: other symbols and visible text/labels.
-                const KICAD_T t = item->Type();
-                if( t != SCH_SYMBOL_T && t != SCH_TEXT_T && t != SCH_LABEL_T && t != SCH_GLOBAL_LABEL_T )
-                    continue;
-
-                BOX2I bb = item->GetBoundingBox();
-                bb.Inflate( marginIU );
-
-                if( test.Intersects( bb ) )
-                    return true;
-            }
-
-            return false;
-        };
-
-        const VECTOR2I basePos = newSymbol->GetPosition();
-        VECTOR2I chosenPos = basePos;
-        bool found = false;
-
-        // Quick check at the requested position first.
-        if( !overlapsExisting( newSymbol->GetBoundingBox() ) )
-        {
-            found = true;
-        }
-        else
-        {
-            // Spiral search on a grid, perimeter by perimeter.
-            for( int r = 1; r <= maxRadius && !found; ++r )
-            {
-                for( int dx = -r; dx <= r && !found; ++dx )
-                {
-                    for( int dy = -r; dy <= r && !found; ++dy )
-                    {
-                        // Only check the perimeter of this square "ring"
-                        if( std::abs( dx ) != r && std::abs( dy ) != r )
-                            continue;
-
-                        VECTOR2I cand = basePos + VECTOR2I( dx * stepIU, dy * stepIU );
-                        newSymbol->SetPosition( cand );
-
-                        if( !overlapsExisting( newSymbol->GetBoundingBox() ) )
-                        {
-                            chosenPos = cand;
-                            found = true;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
+        const int maxRadius = 30;                          // search radius in steps (~150mm)
+
+        // Only avoid obvious clutter: other symbols and visible text/labels.
+        SCH_FREE_SLOT_FINDER finder( screen->Items(),
+                                     { SCH_SYMBOL_T, SCH_TEXT_T, SCH_LABEL_T, SCH_GLOBAL_LABEL_T },
+                                     marginIU );
 
-        newSymbol->SetPosition( chosenPos );
+        if( std::optional<VECTOR2I> offset =
+                    finder.FindNearest( newSymbol->GetBoundingBox(), stepIU, maxRadius ) )
+        {
+            newSymbol->SetPosition( newSymbol->GetPosition() + *offset );
+        }
     }
 
-    SCH_COMMIT commit( m_frame );
+    SCH_COMMIT  localCommit( m_frame );
+    SCH_COMMIT& commit = toolCommit( localCommit );
+
     // Ensure the symbol is permanently added to the screen and view.
     m_frame->AddToScreen( newSymbol, screen );
     commit.Added( newSymbol, screen );
-    commit.Push( _( "Place component" ) );
-    
-    // Ensure the canvas refreshes so the new component is visible immediately.
-    if( m_frame->GetCanvas() )
-    {
-        if( auto view = m_frame->GetCanvas()->GetView() )
-        {
-            view->Update( newSymbol );
-        }
 
-        m_frame->GetCanvas()->Refresh();
-    }
+    // Inside a batch the schematic only reports the symbol once the batch is pushed, but the
+    // following steps need to find it by reference already.
+    std::vector<SCH_ITEM*> added = { newSymbol };
+    m_symbolIndex->OnSchItemsAdded( m_frame->Schematic(), added );
+    finishToolCommit( commit, _( "Place component" ), { newSymbol } );
 
-    m_frame->OnModify();
-    
     // Return the assigned reference so the agent can use it for labels/wiring.
     json res = json::object();
     res["reference"] = newSymbol->GetRef( &sheet, false ).ToStdString();
     res["symbol"] = symbolId.ToStdString();
     m_lastToolResult = wxString::FromUTF8( res.dump( 2 ) );
 
-    if( m_frame->GetToolManager() )
-    {
-        m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, newSymbol );
-    }
-
     return true;
 }
 
@@ -1505,74 +1632,22 @@ SCH_OLLAMA_AGENT_TOOL::SYMBOL_MATCH SCH_OLLAMA_AGENT_TOOL::findSymbolByRefOrValu
     if( id.IsEmpty() || !m_frame )
         return bestMatch;
 
-    SCH_SHEET_LIST hierarchy = m_frame->Schematic().Hierarchy();
-    SCH_SHEET_PATH currentSheet = m_frame->GetCurrentSheet();
-
-    // Strategy 1: Exact Reference Match (e.g. "U1")
-    for( SCH_SHEET_PATH& sheet : hierarchy )
-    {
-        if( aCurrentSheetOnly && sheet != currentSheet )
-            continue;
-
-        SCH_SCREEN* screen = sheet.LastScreen();
-        if( !screen )
-            continue;
-
-        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
-        {
-            SCH_SYMBOL* sym = static_cast<SCH_SYMBOL*>( item );
-            if( sym->GetRef( &sheet, false ).CmpNoCase( id ) == 0 )
-            {
-                bestMatch.symbol = sym;
-                bestMatch.sheet = sheet;
-                return bestMatch; // Perfect match found
-            }
-        }
-    }
-
-    // Strategy 2: Match by Value (e.g. "MCP2551")
-    for( SCH_SHEET_PATH& sheet : hierarchy )
-    {
-        if( aCurrentSheetOnly && sheet != currentSheet )
-            continue;
-
-        SCH_SCREEN* screen = sheet.LastScreen();
-        if( !screen )
-            continue;
-
-        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
-        {
-            SCH_SYMBOL* sym = static_cast<SCH_SYMBOL*>( item );
-            if( sym->GetValue( false, nullptr, false ).CmpNoCase( id ) == 0 )
-            {
-                bestMatch.symbol = sym;
-                bestMatch.sheet = sheet;
-                return bestMatch;
-            }
-        }
-    }
+    SCH_SHEET_PATH        currentSheet = m_frame->GetCurrentSheet();
+    const SCH_SHEET_PATH* sheetFilter = aCurrentSheetOnly ? &currentSheet : nullptr;
 
-    // Strategy 3: Match by Symbol Name (e.g. "Device:R" or "R")
-    for( SCH_SHEET_PATH& sheet : hierarchy )
+    // Exact reference (e.g. "U1"), then value (e.g. "MCP2551"), then symbol name (e.g.
+    // "Device:R" or "R").
+    for( SCH_SYMBOL_INDEX::KEY key : { SCH_SYMBOL_INDEX::KEY::REFERENCE,
+                                       SCH_SYMBOL_INDEX::KEY::VALUE,
+                                       SCH_SYMBOL_INDEX::KEY::LIB_ID } )
     {
-        if( aCurrentSheetOnly && sheet != currentSheet )
-            continue;
-
-        SCH_SCREEN* screen = sheet.LastScreen();
-        if( !screen )
-            continue;
+        SCH_SYMBOL_INDEX::MATCH match = m_symbolIndex->Find( key, id, sheetFilter );
 
-        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
+        if( match.symbol )
         {
-            SCH_SYMBOL* sym = static_cast<SCH_SYMBOL*>( item );
-            wxString libId = sym->GetLibId().Format();
-            wxString itemName = wxString::FromUTF8( sym->GetLibId().GetLibItemName().c_str() );
-            if( libId.CmpNoCase( id ) == 0 || itemName.CmpNoCase( id ) == 0 )
-            {
-                bestMatch.symbol = sym;
-                bestMatch.sheet = sheet;
-                return bestMatch;
-            }
+            bestMatch.symbol = match.symbol;
+            bestMatch.sheet = match.sheet;
+            return bestMatch;
         }
     }
 
@@ -1630,17 +1705,13 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleMoveComponentTool( const json& aPayload )
     if( !screen )
         return false;
 
-    SCH_COMMIT commit( m_frame );
+    SCH_COMMIT  localCommit( m_frame );
+    SCH_COMMIT& commit = toolCommit( localCommit );
+
     commit.Modify( symbol, screen );
     symbol->Move( delta );
 
-    commit.Push( wxString::Format( _( "Move component %s" ), reference ) );
-
-    if( m_frame->GetToolManager() )
-    {
-        m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, symbol );
-    }
-
+    finishToolCommit( commit, wxString::Format( _( "Move component %s" ), reference ), { symbol } );
     return true;
 }
 
@@ -1833,7 +1904,9 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddNetLabelTool( const json& aPayload )
     label->SetParent( targetScreen );
     label->SetSpinStyle( spinStyle );
 
-    SCH_COMMIT commit( m_frame );
+    SCH_COMMIT  localCommit( m_frame );
+    SCH_COMMIT& commit = toolCommit( localCommit );
+
     // In pin-mode, drop a short wire stub from the pin to the label anchor so it's electrically connected.
     SCH_LINE* stub = nullptr;
     if( pinMode && pinPos != pos )
@@ -1850,28 +1923,15 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddNetLabelTool( const json& aPayload )
 
     m_frame->AddToScreen( label, targetScreen );
     commit.Added( label, targetScreen );
-    commit.Push( isLocal ? _( "Add net label" ) : _( "Add global label" ) );
-
-    if( m_frame->GetCanvas() )
-    {
-        if( auto view = m_frame->GetCanvas()->GetView() )
-        {
-            if( stub ) view->Update( stub );
-            view->Update( label );
-        }
 
-        m_frame->GetCanvas()->Refresh();
-    }
+    std::vector<EDA_ITEM*> newItems;
 
-    m_frame->OnModify();
+    if( stub )
+        newItems.push_back( stub );
 
-    if( m_frame->GetToolManager() )
-    {
-        if( stub )
-            m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, stub );
-        m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, label );
-    }
+    newItems.push_back( label );
 
+    finishToolCommit( commit, isLocal ? _( "Add net label" ) : _( "Add global label" ), newItems );
     return true;
 }
 
@@ -2173,35 +2233,15 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddWireTool( const json& aPayload )
         l2->SetText( netName );
         l2->SetParent( targetScreen );
 
-        SCH_COMMIT commit( m_frame );
+        SCH_COMMIT  localCommit( m_frame );
+        SCH_COMMIT& commit = toolCommit( localCommit );
+
         // Ensure items are actually on the screen/view (commit only records undo/redo).
         m_frame->AddToScreen( l1, targetScreen );
         m_frame->AddToScreen( l2, targetScreen );
         commit.Added( l1, targetScreen );
         commit.Added( l2, targetScreen );
-        commit.Push( _( "Add net labels" ) );
-
-        if( m_frame->GetCanvas() )
-        {
-            if( auto view = m_frame->GetCanvas()->GetView() )
-            {
-                view->Update( l1 );
-                view->Update( l2 );
-            }
-
-            m_frame->GetCanvas()->Refresh();
-        }
-
-        m_frame->OnModify();
-
-        if( m_frame->GetToolManager() )
-        {
-            m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, l1 );
-            m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, l2 );
-        }
-
-        if( m_frame->GetCanvas() )
-            m_frame->GetCanvas()->Refresh();
+        finishToolCommit( commit, _( "Add net labels" ), { l1, l2 } );
 
         return true;
     }
@@ -2221,6 +2261,35 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddWireTool( const json& aPayload )
         return w;
     };
 
+    // Route on the connection grid around symbols and existing wires when possible; the
+    // escape heuristic below handles off-grid points and unroutable cases.
+    SCH_WIRE_ROUTER* router = wireRouter( targetScreen, start, end );
+
+    if( router )
+    {
+        std::vector<VECTOR2I> path = router->Route( start, end );
+
+        if( path.size() >= 2 )
+        {
+            SCH_COMMIT             localCommit( m_frame );
+            SCH_COMMIT&            commit = toolCommit( localCommit );
+            std::vector<EDA_ITEM*> newWires;
+
+            for( size_t ii = 1; ii < path.size(); ++ii )
+            {
+                newWires.push_back( addWireSeg( commit, path[ii - 1], path[ii] ) );
+                router->AddWire( path[ii - 1], path[ii] );
+            }
+
+            finishToolCommit( commit, _( "Add wire" ), newWires );
+
+            if( !m_agent || !m_agent->InBatch() )
+                m_wireRouter.reset();
+
+            return true;
+        }
+    }
+
     auto segmentHitsSymbol = [&]( const VECTOR2I& aA, const VECTOR2I& aB ) -> int
     {
         if( aA == aB )
@@ -2352,7 +2421,8 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddWireTool( const json& aPayload )
         }
     }
 
-    SCH_COMMIT commit( m_frame );
+    SCH_COMMIT             localCommit( m_frame );
+    SCH_COMMIT&            commit = toolCommit( localCommit );
     std::vector<SCH_LINE*> newWires;
 
     auto addSegmentIfNeeded = [&]( const VECTOR2I& aA, const VECTOR2I& aB )
@@ -2390,39 +2460,366 @@ bool SCH_OLLAMA_AGENT_TOOL::HandleAddWireTool( const json& aPayload )
         addSegmentIfNeeded( bend, endEsc );
     }
 
-    commit.Push( _( "Add wire" ) );
+    if( router && m_agent && m_agent->InBatch() )
+    {
+        for( SCH_LINE* wire : newWires )
+            router->AddWire( wire->GetStartPoint(), wire->GetEndPoint() );
+    }
+    else
+    {
+        m_wireRouter.reset();
+    }
 
-    if( m_frame->GetCanvas() )
+    finishToolCommit( commit, _( "Add wire" ),
+                      std::vector<EDA_ITEM*>( newWires.begin(), newWires.end() ) );
+    return true;
+}
+
+
+SCH_WIRE_ROUTER* SCH_OLLAMA_AGENT_TOOL::wireRouter( SCH_SCREEN* aScreen, const VECTOR2I& aStart,
+                                                    const VECTOR2I& aEnd )
+{
+    if( m_wireRouter && m_wireRouterScreen == aScreen && m_wireRouter->Covers( aStart, aEnd ) )
+        return m_wireRouter.get();
+
+    int grid = m_frame->Schematic().Settings().m_ConnectionGridSize;
+
+    if( grid <= 0 )
+        grid = schIUScale.MilsToIU( 50 );
+
+    BOX2I area( VECTOR2I( 0, 0 ), aScreen->GetPageSettings().GetSizeIU( schIUScale.IU_PER_MILS ) );
+    area.Merge( aStart );
+    area.Merge( aEnd );
+
+    m_wireRouter = std::make_unique<SCH_WIRE_ROUTER>( grid );
+    m_wireRouter->Build( aScreen->Items(), area );
+    m_wireRouterScreen = aScreen;
+
+    if( !m_wireRouter->Covers( aStart, aEnd ) )
+        return nullptr;
+
+    return m_wireRouter.get();
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::setTransitions()
+{
+    Go( &SCH_OLLAMA_AGENT_TOOL::ProcessRequest, SCH_ACTIONS::ollamaAgentRequest.MakeEvent() );
+    Go( &SCH_OLLAMA_AGENT_TOOL::ShowAgentDialog, SCH_ACTIONS::ollamaAgentDialog.MakeEvent() );
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::RunToolCommand( const wxString& aToolName, const wxString& aPayload )
+{
+    return ExecuteToolCommand( aToolName, aPayload );
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::IsBackgroundTool( const wxString& aToolName )
+{
+    return aToolName.CmpNoCase( wxS( "schematic.search_symbol" ) ) == 0
+           || aToolName.CmpNoCase( wxS( "schematic.get_symbol_info" ) ) == 0;
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::IsSimpleRequest( const wxString& aRequest )
+{
+    // Anything longer than a sentence or two is unlikely to be a single routine edit
+    static const size_t MAX_WORDS = 20;
+
+    // Design work, reviews and questions need the main model whatever their length
+    static const std::vector<wxString> complexWords = {
+        wxS( "design" ),   wxS( "circuit" ),  wxS( "review" ), wxS( "explain" ),
+        wxS( "why" ),      wxS( "how" ),      wxS( "analy" ),  wxS( "optimi" ),
+        wxS( "calculat" ), wxS( "every" ),    wxS( "entire" ), wxS( "whole" )
+    };
+
+    wxString request = aRequest.Lower();
+    request.Trim( true ).Trim( false );
+
+    if( request.IsEmpty() || request.Contains( wxS( "\n" ) ) || request.EndsWith( wxS( "?" ) ) )
+        return false;
+
+    wxStringTokenizer tokenizer( request, wxS( " \t" ), wxTOKEN_STRTOK );
+
+    if( tokenizer.CountTokens() > MAX_WORDS )
+        return false;
+
+    for( const wxString& word : complexWords )
+    {
+        if( request.Contains( word ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::ApplyDraftPlan( const wxString& aResponse )
+{
+    SCH_AGENT_TOOL_CALL_PARSER                         parser;
+    std::vector<SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL> calls;
+
+    parser.Feed( aResponse, calls );
+    parser.Finish( calls );
+
+    if( calls.empty() )
+        return false;
+
+    // The legacy line commands are not checked; leave such plans to the main model
+    wxStringTokenizer tokenizer( aResponse, wxS( "\n" ) );
+
+    while( tokenizer.HasMoreTokens() )
     {
-        if( auto view = m_frame->GetCanvas()->GetView() )
+        wxString line = tokenizer.GetNextToken().Trim( false ).Upper();
+
+        for( const wxString& command : { wxS( "JUNCTION" ), wxS( "WIRE" ), wxS( "LABEL" ),
+                                         wxS( "TEXT" ) } )
         {
-            for( SCH_LINE* w : newWires )
-                view->Update( w );
+            if( line.StartsWith( command ) )
+                return false;
         }
+    }
 
-        m_frame->GetCanvas()->Refresh();
+    std::vector<std::pair<wxString, wxString>> commands;
+
+    for( const SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL& call : calls )
+    {
+        if( !isSupportedTool( call.name.Lower() ) )
+            return false;
+
+        if( !call.payload.IsEmpty() )
+        {
+            json payload = json::parse( call.payload.ToStdString(), nullptr, false );
+
+            if( !payload.is_object() )
+                return false;
+        }
+
+        commands.emplace_back( call.name, call.payload );
     }
 
-    m_frame->OnModify();
+    if( !RunToolBatch( commands, _( "Ollama agent operation" ) ) )
+    {
+        wxLogTrace( traceAgentProfile, wxS( "Draft plan rejected: %s" ), m_lastToolError );
+        return false;
+    }
 
-    if( m_frame->GetToolManager() )
+    return true;
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::executeBackgroundTool( const LIBRARY_ACCESS& aLibs,
+                                                   const wxString& aToolName,
+                                                   const wxString& aPayload, wxString& aResult,
+                                                   wxString& aError )
+{
+    try
+    {
+        json payload = aPayload.IsEmpty() ? json::object() : json::parse( aPayload.ToStdString() );
+
+        if( aToolName.CmpNoCase( wxS( "schematic.search_symbol" ) ) == 0 )
+            return HandleSearchSymbolTool( aLibs, payload, aResult, aError );
+
+        if( aToolName.CmpNoCase( wxS( "schematic.get_symbol_info" ) ) == 0 )
+            return HandleGetSymbolInfoTool( aLibs, payload, aResult, aError );
+    }
+    catch( const json::exception& e )
+    {
+        aError = wxString::Format( _( "%s payload parse error: %s" ), aToolName,
+                                   wxString::FromUTF8( e.what() ) );
+        wxLogWarning( wxS( "[OllamaAgent] %s" ), aError );
+        return false;
+    }
+
+    aError = wxString::Format( _( "Unknown tool requested: %s" ), aToolName );
+    return false;
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::PrefetchToolCall( const wxString& aToolName, const wxString& aPayload )
+{
+    if( !IsBackgroundTool( aToolName ) )
+        return;
+
+    wxString key = prefetchKey( aToolName, aPayload );
+
+    if( m_prefetched.contains( key ) )
+        return;
+
+    m_prefetched[key] = GetKiCadThreadPool().submit_task(
+            [this, libs = libraryAccess(), aToolName, aPayload]()
+            {
+                PROF_TIMER   timer;
+                TOOL_OUTCOME outcome;
+
+                outcome.ok = executeBackgroundTool( libs, aToolName, aPayload, outcome.result,
+                                                    outcome.error );
+
+                m_profile.AddTool( aToolName + wxS( " (prefetch)" ), timer.msecs() );
+                return outcome;
+            } ).share();
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::clearPrefetched()
+{
+    std::erase_if( m_droppedPrefetches,
+                   []( const std::shared_future<TOOL_OUTCOME>& aOutcome )
+                   {
+                       return !aOutcome.valid()
+                              || aOutcome.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+                   } );
+
+    for( auto& [key, outcome] : m_prefetched )
+    {
+        if( outcome.valid()
+            && outcome.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+        {
+            m_droppedPrefetches.push_back( outcome );
+        }
+    }
+
+    m_prefetched.clear();
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::RunToolCommandAsync( const wxString& aToolName,
+                                                 const wxString& aPayload,
+                                                 TOOL_DONE_CALLBACK aOnDone )
+{
+    if( !IsBackgroundTool( aToolName ) )
+    {
+        bool ok = ExecuteToolCommand( aToolName, aPayload );
+        aOnDone( ok, m_lastToolResult, m_lastToolError );
+        return;
+    }
+
+    std::erase_if( m_backgroundTasks,
+                   []( const std::future<void>& aTask )
+                   {
+                       return !aTask.valid()
+                              || aTask.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+                   } );
+
+    m_backgroundTasks.emplace_back( GetKiCadThreadPool().submit_task(
+            [this, libs = libraryAccess(), aToolName, aPayload, aOnDone]()
+            {
+                PROF_TIMER timer;
+                wxString   result;
+                wxString   error;
+                bool       ok = executeBackgroundTool( libs, aToolName, aPayload, result, error );
+
+                m_profile.AddTool( aToolName, timer.msecs() );
+
+                m_frame->CallAfter( [aOnDone, ok, result, error]()
+                                    {
+                                        aOnDone( ok, result, error );
+                                    } );
+            } ) );
+}
+
+
+bool SCH_OLLAMA_AGENT_TOOL::RunToolBatch( const std::vector<std::pair<wxString, wxString>>& aCommands,
+                                          const wxString& aMessage )
+{
+    json       results = json::array();
+    PROF_TIMER executeTimer;
+
+    m_batchItems.clear();
+    m_agent->BeginBatch();
+    m_wireRouter.reset();
+
+    for( size_t ii = 0; ii < aCommands.size(); ++ii )
     {
-        for( SCH_LINE* w : newWires )
-            m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, w );
+        const auto& [toolName, payload] = aCommands[ii];
+
+        if( !ExecuteToolCommand( toolName, payload ) )
+        {
+            wxString error = m_lastToolError;
+
+            if( error.IsEmpty() )
+                error = _( "Tool execution failed" );
+
+            m_agent->CancelBatch();
+            m_batchItems.clear();
+            m_wireRouter.reset();
+
+            m_lastToolResult.clear();
+            m_lastToolError = wxString::Format( _( "Step %d (%s) failed; no changes were made: %s" ),
+                                                (int) ii + 1, toolName, error );
+            return false;
+        }
+
+        results.push_back( m_lastToolResult.ToUTF8().data() );
     }
 
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::EXECUTION, executeTimer.msecs() );
+
+    // A single push means a single connectivity update, undo entry and redraw for the plan
+    PROF_TIMER commitTimer;
+
+    m_lastRunChanged = !m_agent->GetCommit()->Empty();
+    m_agent->EndBatch( aMessage );
+    m_wireRouter.reset();
+    updateAndSelect( m_batchItems );
+    m_batchItems.clear();
+
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::COMMIT, commitTimer.msecs() );
+
+    m_lastToolError.clear();
+    m_lastToolResult = wxString::FromUTF8( results.dump( 2 ) );
     return true;
 }
 
 
-void SCH_OLLAMA_AGENT_TOOL::setTransitions()
+SCH_COMMIT& SCH_OLLAMA_AGENT_TOOL::toolCommit( SCH_COMMIT& aLocalCommit )
 {
-    Go( &SCH_OLLAMA_AGENT_TOOL::ProcessRequest, SCH_ACTIONS::ollamaAgentRequest.MakeEvent() );
-    Go( &SCH_OLLAMA_AGENT_TOOL::ShowAgentDialog, SCH_ACTIONS::ollamaAgentDialog.MakeEvent() );
+    if( m_agent && m_agent->InBatch() )
+        return *m_agent->GetCommit();
+
+    return aLocalCommit;
 }
 
 
-bool SCH_OLLAMA_AGENT_TOOL::RunToolCommand( const wxString& aToolName, const wxString& aPayload )
+void SCH_OLLAMA_AGENT_TOOL::finishToolCommit( SCH_COMMIT& aCommit, const wxString& aMessage,
+                                              const std::vector<EDA_ITEM*>& aItems )
 {
-    return ExecuteToolCommand( aToolName, aPayload );
+    if( m_agent && m_agent->InBatch() )
+    {
+        m_batchItems.insert( m_batchItems.end(), aItems.begin(), aItems.end() );
+        return;
+    }
+
+    PROF_TIMER timer;
+
+    aCommit.Push( aMessage );
+    updateAndSelect( aItems );
+
+    m_profile.AddPhase( SCH_AGENT_PROFILE::PHASE::COMMIT, timer.msecs() );
+}
+
+
+void SCH_OLLAMA_AGENT_TOOL::updateAndSelect( const std::vector<EDA_ITEM*>& aItems )
+{
+    if( aItems.empty() )
+        return;
+
+    // Ensure the canvas refreshes so new items are visible immediately.
+    if( m_frame->GetCanvas() )
+    {
+        if( KIGFX::VIEW* view = m_frame->GetCanvas()->GetView() )
+        {
+            for( EDA_ITEM* item : aItems )
+                view->Update( item );
+        }
+
+        m_frame->GetCanvas()->Refresh();
+    }
+
+    if( m_frame->GetToolManager() )
+    {
+        for( EDA_ITEM* item : aItems )
+            m_frame->GetToolManager()->RunAction<EDA_ITEM*>( ACTIONS::selectItem, item );
+    }
 }
@@ -22,7 +22,18 @@
 
 #include "sch_tool_base.h"
 #include "sch_agent.h"
-#include "ollama_client.h"
+#include "sch_agent_context.h"
+#include "sch_agent_profile.h"
+#include <sch_symbol_index.h>
+#include <ollama_client.h>
+#include <libraries/symbol_embedding_index.h>
+#include <sch_wire_router.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <optional>
 #include <nlohmann/json.hpp>
@@ -30,6 +41,9 @@
 class SCH_OLLAMA_AGENT_DIALOG;
 
 class SCH_EDIT_FRAME;
+class SCH_SCREEN;
+class PROJECT;
+class SYMBOL_LIBRARY_ADAPTER;
 
 class SCH_OLLAMA_TOOL_CALL_HANDLER
 {
@@ -47,15 +61,19 @@ class SCH_OLLAMA_AGENT_TOOL : public SCH_TOOL_BASE<SCH_EDIT_FRAME>
 public:
 
     SCH_OLLAMA_AGENT_TOOL();
-    ~SCH_OLLAMA_AGENT_TOOL() override {}
+    ~SCH_OLLAMA_AGENT_TOOL() override;
 
     /// @copydoc TOOL_INTERACTIVE::Init()
     bool Init() override;
 
-    void Reset( RESET_REASON aReason ) override {}
+    /// @copydoc TOOL_INTERACTIVE::Reset()
+    void Reset( RESET_REASON aReason ) override;
 
     /**
-     * Process a natural language request and execute schematic operations
+     * Process a natural language request and execute schematic operations.
+     *
+     * The completion runs on the thread pool; the response is parsed and executed on the UI
+     * thread once it arrives.  A new request cancels one still running.
      */
     int ProcessRequest( const TOOL_EVENT& aEvent );
 
@@ -71,9 +89,10 @@ public:
 
     /**
      * Get Ollama client (for dialog access)
-     * Creates the client lazily if it doesn't exist
+     * Creates the client lazily if it doesn't exist.  Shared, so a worker still using it keeps
+     * it alive when the tool goes away.
      */
-    OLLAMA_CLIENT* GetOllama();
+    std::shared_ptr<OLLAMA_CLIENT> GetOllama();
 
     /**
      * Get current model name
@@ -88,11 +107,52 @@ public:
      */
     wxString GetFullSchematicContext( size_t aMaxChars = 50000 );
 
+    /**
+     * Build the context for \a aRequest.  It is the full snapshot when that fits in
+     * \a aMaxChars; otherwise the symbols and nets most relevant to the request, the selection
+     * and the visible area are kept, instead of an arbitrary prefix of the snapshot.
+     */
+    wxString GetRankedSchematicContext( const wxString& aRequest, size_t aMaxChars = 50000 );
+
+    /**
+     * Describe only what changed since the last context returned by this method or by
+     * GetFullSchematicContext().  Returns a full snapshot if there is nothing to diff against.
+     */
+    wxString GetSchematicContextDelta( size_t aMaxChars = 50000 );
+
+    /**
+     * Timing breakdown of the current (or last) agent turn.
+     */
+    SCH_AGENT_PROFILE& Profile() { return m_profile; }
+
     /**
      * Parse and execute response (for dialog access)
      */
     bool ParseAndExecute( const wxString& aResponse );
 
+    /**
+     * @return true if the last ParseAndExecute() changed the schematic.  Responses that only
+     *         read it can be replayed from the client's response cache.
+     */
+    bool LastRunChanged() const { return m_lastRunChanged; }
+
+    /**
+     * Estimate whether \a aRequest is a routine command (a part, a label, a wire) that the
+     * draft model can plan, rather than a design task or a question for the main model.
+     */
+    static bool IsSimpleRequest( const wxString& aRequest );
+
+    /**
+     * Apply a plan drafted by the small model, if it checks out against the schematic.
+     *
+     * The draft is rejected without touching the schematic if it holds anything but TOOL calls
+     * of known tools with well-formed payloads, or if any call fails when executed (e.g. an
+     * unknown reference or pin); the calls run as one change, reverted on the first failure.
+     *
+     * @return true if the draft was applied.
+     */
+    bool ApplyDraftPlan( const wxString& aResponse );
+
 
     /**
      * Register a handler that will be notified when TOOL lines are encountered.
@@ -104,9 +164,46 @@ public:
      * Execute a tool command immediately (used by asynchronous handlers).
      */
     bool RunToolCommand( const wxString& aToolName, const wxString& aPayload );
+
+    /**
+     * Execute a list of (tool name, payload) commands as a single undoable change.
+     *
+     * Connectivity is recalculated and the canvas refreshed once, after the last command.  If
+     * any command fails, everything done by the earlier ones is reverted and the last tool
+     * error names the failing step.  On success the last tool result is a JSON array holding
+     * the result of each command.
+     */
+    bool RunToolBatch( const std::vector<std::pair<wxString, wxString>>& aCommands,
+                       const wxString& aMessage );
     wxString GetLastToolError() const { return m_lastToolError; }
     wxString GetLastToolResult() const { return m_lastToolResult; }
 
+    /**
+     * @return true for tools that neither read nor modify the schematic and can therefore
+     *         run on a worker thread (library searches and lookups).
+     */
+    static bool IsBackgroundTool( const wxString& aToolName );
+
+    using TOOL_DONE_CALLBACK =
+            std::function<void( bool aSuccess, const wxString& aResult, const wxString& aError )>;
+
+    /**
+     * Execute a tool command without blocking the UI for slow library lookups.
+     *
+     * Background tools run on the KiCad thread pool; every other tool runs immediately.  In
+     * both cases \a aOnDone is invoked on the UI thread.
+     */
+    void RunToolCommandAsync( const wxString& aToolName, const wxString& aPayload,
+                              TOOL_DONE_CALLBACK aOnDone );
+
+    /**
+     * Start a background tool call spotted in a response that is still streaming.
+     *
+     * When the same call is executed later (e.g. by ParseAndExecute()), the precomputed
+     * result is used instead of running it again.  Calls to other tools are ignored.
+     */
+    void PrefetchToolCall( const wxString& aToolName, const wxString& aPayload );
+
 private:
     /**
      * Finds a symbol by its reference (e.g. "U1"), or if not found, its value (e.g. "MCP2551")
@@ -122,22 +219,128 @@ private:
     SYMBOL_MATCH findSymbolByRefOrValue( const wxString& aIdentifier, bool aCurrentSheetOnly = false );
 
     bool ExecuteToolCommand( const wxString& aToolName, const wxString& aPayload );
+    bool dispatchToolCommand( const wxString& aToolName, const wxString& aPayload );
     bool HandlePlaceComponentTool( const nlohmann::json& aPayload );
     bool HandleMoveComponentTool( const nlohmann::json& aPayload );
     bool HandleAddWireTool( const nlohmann::json& aPayload );
     bool HandleAddNetLabelTool( const nlohmann::json& aPayload );
     bool HandleConnectWithNetLabelTool( const nlohmann::json& aPayload );
     bool HandleGetDatasheetTool( const nlohmann::json& aPayload );
-    bool HandleGetSymbolInfoTool( const nlohmann::json& aPayload );
-    bool HandleSearchSymbolTool( const nlohmann::json& aPayload );
+
+    /**
+     * What the library lookup tools read, taken from the frame on the UI thread so that the
+     * lookups themselves can run on a worker without touching the frame.
+     */
+    struct LIBRARY_ACCESS
+    {
+        SYMBOL_LIBRARY_ADAPTER* adapter = nullptr;
+        PROJECT*                project = nullptr;
+    };
+
+    /// UI thread only.
+    LIBRARY_ACCESS libraryAccess() const;
+
+    bool HandleGetSymbolInfoTool( const LIBRARY_ACCESS& aLibs, const nlohmann::json& aPayload,
+                                  wxString& aResult, wxString& aError );
+    bool HandleSearchSymbolTool( const LIBRARY_ACCESS& aLibs, const nlohmann::json& aPayload,
+                                 wxString& aResult, wxString& aError );
+
+    /**
+     * Search the semantic symbol index, starting its background build on first use.
+     *
+     * Returns nothing when no embedding model is configured or while the first build of the
+     * index is still running.  Thread safe.
+     */
+    std::vector<SYMBOL_EMBEDDING_INDEX::MATCH> semanticSearch( const wxString& aQuery,
+                                                               size_t aLimit,
+                                                               SYMBOL_LIBRARY_ADAPTER& aAdapter,
+                                                               const wxString& aCachePath );
+
+    /// Thread-safe dispatch for IsBackgroundTool() tools.
+    bool executeBackgroundTool( const LIBRARY_ACCESS& aLibs, const wxString& aToolName,
+                                const wxString& aPayload, wxString& aResult, wxString& aError );
+
+    /// Apply \a aDraft, drafted in \a aMsecs; if it checks out, the main request is cancelled.
+    void onDraftReceived( const wxString& aDraft, double aMsecs );
+
+    /**
+     * Parse and execute the main model's answer to \a aPrompt.  \a aStats is null for an
+     * answer replayed from the response cache.
+     */
+    void onResponseReceived( const wxString& aPrompt, bool aSuccess, const wxString& aResponse,
+                             const OLLAMA_CLIENT::STREAM_STATS* aStats );
+
+    /// Cancel the completion started by ProcessRequest() and wait for its worker.
+    void cancelRequest();
+
+    /// Wait for the lookups running on the thread pool.
+    void waitForBackgroundTasks();
     wxString GetCurrentSchematicContent();
 
+    /// Return the batch commit while a batch is open, otherwise \a aLocalCommit.
+    SCH_COMMIT& toolCommit( SCH_COMMIT& aLocalCommit );
+
+    /**
+     * Push \a aCommit and show the new items, or when inside a batch just remember the items
+     * so they are shown once the batch is pushed.
+     */
+    void finishToolCommit( SCH_COMMIT& aCommit, const wxString& aMessage,
+                           const std::vector<EDA_ITEM*>& aItems );
+
+    void updateAndSelect( const std::vector<EDA_ITEM*>& aItems );
+
+    /**
+     * Return the routing grid of \a aScreen, rasterized on first use and then kept until the
+     * batch ends or another tool changes the schematic.
+     *
+     * @return nullptr if \a aStart or \a aEnd cannot be routed on the grid (e.g. off-grid).
+     */
+    SCH_WIRE_ROUTER* wireRouter( SCH_SCREEN* aScreen, const VECTOR2I& aStart, const VECTOR2I& aEnd );
+
     std::unique_ptr<SCH_AGENT> m_agent;
-    std::unique_ptr<OLLAMA_CLIENT> m_ollama;
+    std::shared_ptr<OLLAMA_CLIENT> m_ollama;
+    std::unique_ptr<SCH_AGENT_CONTEXT> m_context;
+    std::unique_ptr<SCH_SYMBOL_INDEX> m_symbolIndex;
+    SCH_AGENT_PROFILE m_profile;
+    std::vector<EDA_ITEM*> m_batchItems;  ///< Items created or moved by the open batch
+    bool m_lastRunChanged = false;
     wxString m_model;  // Default model name
     SCH_OLLAMA_TOOL_CALL_HANDLER* m_toolCallHandler = nullptr;
     wxString m_lastToolError;
     wxString m_lastToolResult;
+    wxString m_symbolIndexCachePath;    ///< Cache file the symbol search index was read from
+    std::mutex m_searchMutex;           ///< Guards m_symbolIndexCachePath and index syncing
+
+    std::shared_ptr<SYMBOL_EMBEDDING_INDEX> m_embeddingIndex;   ///< Guarded by m_searchMutex
+    std::shared_ptr<OLLAMA_CLIENT>          m_embeddingClient;  ///< Guarded by m_searchMutex
+    std::future<void>                       m_embeddingTask;    ///< Background index build
+    std::atomic<bool>                       m_cancelEmbedding = false;
+
+    std::vector<std::future<void>> m_backgroundTasks;
+
+    /// Completion started by ProcessRequest(); the flag is replaced for every request, so
+    /// callbacks queued by an earlier one see it set and do nothing.
+    std::future<void>                  m_requestTask;
+    std::shared_ptr<std::atomic<bool>> m_cancelRequest;
+
+    std::unique_ptr<SCH_WIRE_ROUTER> m_wireRouter;        ///< Cached by wireRouter()
+    const SCH_SCREEN*                m_wireRouterScreen = nullptr;
+
+    struct TOOL_OUTCOME
+    {
+        bool     ok = false;
+        wxString result;
+        wxString error;
+    };
+
+    /// Drop every prefetched result that was not used, without waiting for those still running.
+    void clearPrefetched();
+
+    /// Prefetched background tool results, keyed by tool name and payload
+    std::map<wxString, std::shared_future<TOOL_OUTCOME>> m_prefetched;
+
+    /// Dropped prefetches still running; they use this object until they finish
+    std::vector<std::shared_future<TOOL_OUTCOME>> m_droppedPrefetches;
 };
 
 #endif // SCH_OLLAMA_AGENT_TOOL_H
@@ -471,7 +471,7 @@ int SIMULATOR_CONTROL::RunSimulation( const TOOL_EVENT& aEvent )
 {
     if( m_simulator->IsRunning() )
     {
-        m_simulator->Stop();
+        m_simulatorFrame->StopSimulation();
         return 0;
     }
 
@@ -31,6 +31,7 @@
 #include <gerbview.h>
 #include <aperture_macro.h>
 #include <gerber_draw_item.h>
+#include <dcode.h>
 
 void APERTURE_MACRO::InitLocalParams( const D_CODE* aDcode )
 {
@@ -103,40 +104,56 @@ AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
 SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
                                                        const VECTOR2I& aShapePos )
 {
-    SHAPE_POLY_SET holeBuffer;
+    D_CODE*             dcode = aParent->GetDcodeDescr();
+    std::vector<double> params;
 
-    m_shape.RemoveAllContours();
-    D_CODE* dcode = aParent->GetDcodeDescr();
-    InitLocalParams( dcode );
+    params.reserve( dcode->GetParamCount() );
 
-    for( AM_PRIMITIVE& prim_macro : m_primitivesList )
+    for( unsigned id_param = 1; id_param <= dcode->GetParamCount(); id_param++ )
+        params.push_back( dcode->GetParam( id_param ) );
+
+    auto it = m_shapeCache.find( params );
+
+    if( it == m_shapeCache.end() )
     {
-        if( prim_macro.m_Primitive_id == AMP_COMMENT )
-            continue;
+        SHAPE_POLY_SET shape;
+        SHAPE_POLY_SET holeBuffer;
 
-        if( prim_macro.IsAMPrimitiveExposureOn( this ) )
-        {
-            prim_macro.ConvertBasicShapeToPolygon( this, m_shape );
-        }
-        else
+        InitLocalParams( dcode );
+
+        for( AM_PRIMITIVE& prim_macro : m_primitivesList )
         {
-            prim_macro.ConvertBasicShapeToPolygon( this, holeBuffer );
+            if( prim_macro.m_Primitive_id == AMP_COMMENT )
+                continue;
 
-            if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+            if( prim_macro.IsAMPrimitiveExposureOn( this ) )
+            {
+                prim_macro.ConvertBasicShapeToPolygon( this, shape );
+            }
+            else
             {
-                m_shape.BooleanSubtract( holeBuffer );
-                holeBuffer.RemoveAllContours();
+                prim_macro.ConvertBasicShapeToPolygon( this, holeBuffer );
+
+                if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
+                {
+                    shape.BooleanSubtract( holeBuffer );
+                    holeBuffer.RemoveAllContours();
+                }
             }
         }
-    }
 
-    // Merge and cleanup basic shape polygons
-    m_shape.Simplify();
+        // Merge and cleanup basic shape polygons
+        shape.Simplify();
+
+        // A hole can be is defined inside a polygon, or the polygons themselve can create
+        // a hole when merged, so we must fracture the polygon to be able to drawn it
+        // (i.e link holes by overlapping edges)
+        shape.Fracture();
+
+        it = m_shapeCache.emplace( std::move( params ), std::move( shape ) ).first;
+    }
 
-    // A hole can be is defined inside a polygon, or the polygons themselve can create
-    // a hole when merged, so we must fracture the polygon to be able to drawn it
-    // (i.e link holes by overlapping edges)
-    m_shape.Fracture();
+    m_shape = it->second;
 
     // Move m_shape to the actual draw position:
     for( int icnt = 0; icnt < m_shape.OutlineCount(); icnt++ )
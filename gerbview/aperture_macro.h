@@ -31,6 +31,7 @@
 #define APERTURE_MACRO_H
 
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -166,6 +167,13 @@ private:
     int m_paramLevelEval;
 
     SHAPE_POLY_SET m_shape;         ///< The shape of the item, calculated by GetApertureMacroShape
+
+    /**
+     * The evaluated shapes at the origin, before the item's position and layer transforms.
+     * They only depend on the macro parameters, so all the flashes of D-codes with the same
+     * parameter values share one.
+     */
+    std::map<std::vector<double>, SHAPE_POLY_SET> m_shapeCache;
 };
 
 
@@ -39,6 +39,7 @@ public: DIALOG_MAP_GERBER_LAYERS_TO_PCB( GERBVIEW_FRAME* parent );
 
     int* GetLayersLookUpTable() { return m_layersLookUpTable; }
     static int GetCopperLayersCount() { return m_exportBoardCopperLayersCount; }
+    bool GetMergePolygons() const { return m_cbMergePolygons->GetValue(); }
 
 protected:
     bool TransferDataFromWindow() override;
@@ -88,6 +88,11 @@ DIALOG_MAP_GERBER_LAYERS_TO_PCB_BASE::DIALOG_MAP_GERBER_LAYERS_TO_PCB_BASE( wxWi
 
 	bRightSizer->Add( bSizerLyrCnt, 0, wxEXPAND, 5 );
 
+	m_cbMergePolygons = new wxCheckBox( this, wxID_ANY, _("Merge shapes into polygons"), wxDefaultPosition, wxDefaultSize, 0 );
+	m_cbMergePolygons->SetToolTip( _("Merge the shapes of each layer into as few filled polygons as possible instead of exporting one item per Gerber primitive.") );
+
+	bRightSizer->Add( m_cbMergePolygons, 0, wxTOP|wxRIGHT|wxLEFT, 5 );
+
 
 	bRightSizer->Add( 5, 15, 1, wxEXPAND, 5 );
 
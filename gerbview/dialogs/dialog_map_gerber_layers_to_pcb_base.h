@@ -20,6 +20,7 @@
 #include <wx/sizer.h>
 #include <wx/statline.h>
 #include <wx/combobox.h>
+#include <wx/checkbox.h>
 #include <wx/button.h>
 #include <wx/bitmap.h>
 #include <wx/image.h>
@@ -43,6 +44,7 @@ class DIALOG_MAP_GERBER_LAYERS_TO_PCB_BASE : public DIALOG_SHIM
 		wxFlexGridSizer* m_flexRightColumnBoxSizer;
 		wxStaticText* m_staticTextCopperlayerCount;
 		wxComboBox* m_comboCopperLayersCount;
+		wxCheckBox* m_cbMergePolygons;
 		wxButton* m_buttonStore;
 		wxButton* m_buttonRetrieve;
 		wxButton* m_buttonReset;
@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <future>
+#include <map>
 #include <vector>
 
 #include <export_to_pcbnew.h>
@@ -34,11 +36,13 @@
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <gerber_diff.h>
 #include <build_version.h>
 #include <wildcards_and_files_ext.h>
 #include "excellon_image.h"
 #include <wx/log.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <thread_pool.h>
 
 
 GBR_TO_PCB_EXPORTER::GBR_TO_PCB_EXPORTER( GERBVIEW_FRAME* aFrame, const wxString& aFileName )
@@ -55,7 +59,8 @@ GBR_TO_PCB_EXPORTER::~GBR_TO_PCB_EXPORTER()
 }
 
 
-bool GBR_TO_PCB_EXPORTER::ExportPcb( const int* aLayerLookUpTable, int aCopperLayers )
+bool GBR_TO_PCB_EXPORTER::ExportPcb( const int* aLayerLookUpTable, int aCopperLayers,
+                                     bool aMergePolygons )
 {
     m_fp = wxFopen( m_pcb_file_name, wxT( "wt" ) );
 
@@ -98,38 +103,45 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( const int* aLayerLookUpTable, int aCopperLa
         }
     }
 
-    // Next: non copper layers:
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+    if( aMergePolygons )
     {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+        export_merged_layers( aLayerLookUpTable );
+    }
+    else
+    {
+        // Next: non copper layers:
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-        if( gerber == nullptr )    // Graphic layer not yet used
-            continue;
+            if( gerber == nullptr )    // Graphic layer not yet used
+                continue;
 
-        int pcb_layer_number = aLayerLookUpTable[layer];
+            int pcb_layer_number = aLayerLookUpTable[layer];
 
-        if( !IsPcbLayer( pcb_layer_number ) || IsCopperLayer( pcb_layer_number ) )
-            continue;
+            if( !IsPcbLayer( pcb_layer_number ) || IsCopperLayer( pcb_layer_number ) )
+                continue;
 
-        for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
-            export_non_copper_item( gerb_item, pcb_layer_number );
-    }
+            for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
+                export_non_copper_item( gerb_item, pcb_layer_number );
+        }
 
-    // Copper layers
-    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
-    {
-        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+        // Copper layers
+        for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+        {
+            GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
 
-        if( gerber == nullptr )    // Graphic layer not yet used
-            continue;
+            if( gerber == nullptr )    // Graphic layer not yet used
+                continue;
 
-        int pcb_layer_number = aLayerLookUpTable[layer];
+            int pcb_layer_number = aLayerLookUpTable[layer];
 
-        if( !IsCopperLayer( pcb_layer_number ) )
-            continue;
+            if( !IsCopperLayer( pcb_layer_number ) )
+                continue;
 
-        for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
-            export_copper_item( gerb_item, pcb_layer_number );
+            for( GERBER_DRAW_ITEM* gerb_item : gerber->GetItems() )
+                export_copper_item( gerb_item, pcb_layer_number );
+        }
     }
 
     // Now write out the holes we collected earlier as vias
@@ -147,6 +159,73 @@ bool GBR_TO_PCB_EXPORTER::ExportPcb( const int* aLayerLookUpTable, int aCopperLa
 }
 
 
+void GBR_TO_PCB_EXPORTER::export_merged_layers( const int* aLayerLookUpTable )
+{
+    GERBER_FILE_IMAGE_LIST*         images = m_gerbview_frame->GetGerberLayout()->GetImagesList();
+    std::vector<GERBER_FILE_IMAGE*> sources;
+    std::vector<int>                sourceLayers;
+
+    for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+    {
+        GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+
+        if( gerber && IsPcbLayer( aLayerLookUpTable[layer] ) )
+        {
+            sources.push_back( gerber );
+            sourceLayers.push_back( aLayerLookUpTable[layer] );
+        }
+    }
+
+    // Same accuracy as the painter uses for arcs
+    const int                      maxError = gerbIUScale.mmToIU( 0.005 );
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<SHAPE_POLY_SET>    flat( sources.size() );
+    std::vector<std::future<void>> pending;
+
+    for( size_t ii = 0; ii < sources.size(); ++ii )
+    {
+        pending.push_back( tp.submit_task(
+                [&, ii]()
+                {
+                    GERBER_DIFF::FlattenImage( sources[ii], flat[ii], maxError );
+                } ) );
+    }
+
+    for( std::future<void>& task : pending )
+        task.wait();
+
+    std::map<int, SHAPE_POLY_SET> merged;
+
+    for( size_t ii = 0; ii < sources.size(); ++ii )
+    {
+        auto it = merged.find( sourceLayers[ii] );
+
+        if( it == merged.end() )
+            merged.emplace( sourceLayers[ii], std::move( flat[ii] ) );
+        else
+            it->second.BooleanAdd( flat[ii] );
+    }
+
+    // gr_poly items have no holes
+    std::vector<SHAPE_POLY_SET*> layerPolys;
+
+    for( auto& [pcbLayer, polys] : merged )
+        layerPolys.push_back( &polys );
+
+    tp.submit_loop( size_t( 0 ), layerPolys.size(),
+            [&]( size_t aIdx )
+            {
+                layerPolys[aIdx]->Fracture();
+            } ).wait();
+
+    for( const auto& [pcbLayer, polys] : merged )
+    {
+        for( int ii = 0; ii < polys.OutlineCount(); ++ii )
+            writePcbPolygon( polys.COutline( ii ), pcbLayer );
+    }
+}
+
+
 void GBR_TO_PCB_EXPORTER::export_non_copper_item( const GERBER_DRAW_ITEM* aGbrItem, int aLayer )
 {
     if( aGbrItem->GetLayerPolarity() )
@@ -590,16 +669,24 @@ void GBR_TO_PCB_EXPORTER::writePcbPolygon( const SHAPE_POLY_SET& aPolys, int aLa
 
     // aPolys is expected having only one outline and no hole
     // (because it comes from a gerber file or is built from a aperture )
-    const SHAPE_LINE_CHAIN& poly = aPolys.COutline( 0 );
+    writePcbPolygon( aPolys.COutline( 0 ), aLayer, aOffset );
+}
+
+
+void GBR_TO_PCB_EXPORTER::writePcbPolygon( const SHAPE_LINE_CHAIN& aPoly, int aLayer,
+                                           const VECTOR2I& aOffset )
+{
+    if( aPoly.PointCount() < 3 )
+        return;
 
     fprintf( m_fp, "\t(gr_poly\n\t\t(pts\n\t\t\t" );
 
     #define MAX_COORD_CNT 4
     int jj = MAX_COORD_CNT;
-    int cnt_max = poly.PointCount() -1;
+    int cnt_max = aPoly.PointCount() -1;
 
     // Do not generate last corner, if it is the same point as the first point:
-    if( poly.CPoint( 0 ) == poly.CPoint( cnt_max ) )
+    if( aPoly.CPoint( 0 ) == aPoly.CPoint( cnt_max ) )
         cnt_max--;
 
     for( int ii = 0; ii <= cnt_max; ii++ )
@@ -611,8 +698,8 @@ void GBR_TO_PCB_EXPORTER::writePcbPolygon( const SHAPE_POLY_SET& aPolys, int aLa
         }
 
         fprintf( m_fp, " (xy %s %s)",
-                 FormatDouble2Str( MapToPcbUnits( poly.CPoint( ii ).x + aOffset.x ) ).c_str(),
-                 FormatDouble2Str( MapToPcbUnits( -poly.CPoint( ii ).y + aOffset.y ) ).c_str() );
+                 FormatDouble2Str( MapToPcbUnits( aPoly.CPoint( ii ).x + aOffset.x ) ).c_str(),
+                 FormatDouble2Str( MapToPcbUnits( -aPoly.CPoint( ii ).y + aOffset.y ) ).c_str() );
     }
 
     fprintf( m_fp, ")" );
@@ -69,8 +69,12 @@ public:
 
     /**
      * Save a board from a set of Gerber images.
+     *
+     * @param aMergePolygons set to merge the shapes of each board layer into filled polygons
+     *                       instead of writing one item per Gerber primitive.
      */
-    bool ExportPcb( const int* aLayerLookUpTable, int aCopperLayers );
+    bool ExportPcb( const int* aLayerLookUpTable, int aCopperLayers,
+                    bool aMergePolygons = false );
 
 private:
     /**
@@ -96,6 +100,14 @@ private:
 
     void export_slot( const EXPORT_SLOT& aSlot );
 
+    /**
+     * Flatten the images mapped to each board layer and write the result as filled polygons.
+     *
+     * Images are flattened in parallel, one task per image, then the images sharing a board
+     * layer are merged.  Clear (negative) items are honoured, unlike in the per item export.
+     */
+    void export_merged_layers( const int* aLayerLookUpTable );
+
     /**
      * Write a non copper line or arc to the board file.
      *
@@ -127,6 +139,9 @@ private:
     void writePcbPolygon( const SHAPE_POLY_SET& aPolys, int aLayer,
                           const VECTOR2I& aOffset = { 0, 0 } );
 
+    void writePcbPolygon( const SHAPE_LINE_CHAIN& aPoly, int aLayer,
+                          const VECTOR2I& aOffset = { 0, 0 } );
+
     /**
      * Write a filled circle to the board file (with line thickness = 0).
      *
@@ -33,12 +33,19 @@
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
 #include <excellon_image.h>
+#include <excellon_defaults.h>
+#include <gerbview_settings.h>
 #include <lset.h>
 #include <wildcards_and_files_ext.h>
 #include <view/view.h>
 #include <widgets/wx_progress_reporters.h>
 #include "widgets/gerbview_layer_widget.h"
 #include <tool/tool_manager.h>
+#include <thread_pool.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
 
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER _( "<b>No more available layers</b> in GerbView to load files" )
@@ -266,15 +273,34 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
 
     // Read gerber files: each file is loaded on a new GerbView layer
     bool success = true;
-    int layer = GetActiveLayer();
+    int  layer = NO_AVAILABLE_LAYERS;
     int  firstLoadedLayer = NO_AVAILABLE_LAYERS;
     LSET visibility = GetVisibleLayers();
 
     // Manage errors when loading files
     WX_STRING_REPORTER reporter;
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    // A file to read, and the empty layer reserved for it
+    struct PENDING_FILE
+    {
+        wxString fullPath;
+        unsigned index;
+        int      layer;
+    };
+
+    std::vector<PENDING_FILE> files;
+
+    auto nextAvailableLayer =
+            [&]( int aFrom )
+            {
+                for( int ii = aFrom; ii < (int) ImagesMaxCount(); ++ii )
+                {
+                    if( GetGbrImage( ii ) == nullptr )
+                        return ii;
+                }
+
+                return (int) NO_AVAILABLE_LAYERS;
+            };
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -307,30 +333,8 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             continue;
         }
 
-
-        m_lastFileName = filename.GetFullPath();
-
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Load Files" ), 1, PR_CAN_ABORT );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-        }
-        else if( progress )
-        {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-            progress->KeepRefreshing();
-        }
-
-
         // Make sure we have a layer available to load into
-        layer = getNextAvailableLayer();
+        layer = nextAvailableLayer( layer + 1 );
 
         if( layer == NO_AVAILABLE_LAYERS )
         {
@@ -347,65 +351,147 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             break;
         }
 
-        SetActiveLayer( layer, false );
-        visibility[ layer ] = true;
+        m_lastFileName = filename.GetFullPath();
+        files.push_back( { filename.GetFullPath(), ii, layer } );
+    }
 
-        try
-        {
-            // 2 = Autodetect
-            if( ( *aFileType )[ii] == 2 )
-            {
-                if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 1;
-                else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 0;
-            }
+    EXCELLON_DEFAULTS nc_defaults;
+    static_cast<GERBVIEW_SETTINGS*>( config() )->GetExcellonDefaults( nc_defaults );
 
-            switch( ( *aFileType )[ii] )
+    // The files are independent: parse them all at once, each into its own image, and show
+    // each one as soon as it is read.
+    auto readFile =
+            [&]( const PENDING_FILE& aFile ) -> std::unique_ptr<GERBER_FILE_IMAGE>
             {
-            case 0:
+                int fileType = ( *aFileType )[aFile.index];
 
-                if( Read_GERBER_File( filename.GetFullPath() ) )
+                // 2 = Autodetect
+                if( fileType == 2 )
                 {
-                    UpdateFileHistory( filename.GetFullPath() );
-
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
+                    if( EXCELLON_IMAGE::TestFileIsExcellon( aFile.fullPath ) )
+                        fileType = 1;
+                    else if( GERBER_FILE_IMAGE::TestFileIsRS274( aFile.fullPath ) )
+                        fileType = 0;
                 }
 
-                break;
-
-            case 1:
+                if( fileType == 0 )
+                {
+                    auto gerber = std::make_unique<GERBER_FILE_IMAGE>( aFile.layer );
 
-                if( Read_EXCELLON_File( filename.GetFullPath() ) )
+                    if( gerber->LoadGerberFile( aFile.fullPath ) )
+                        return gerber;
+                }
+                else if( fileType == 1 )
                 {
-                    UpdateFileHistory( filename.GetFullPath(), &m_drillFileHistory );
+                    auto              drill = std::make_unique<EXCELLON_IMAGE>( aFile.layer );
+                    EXCELLON_DEFAULTS defaults = nc_defaults;
 
-                    // Select the first added layer by default when done loading
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
+                    if( drill->LoadFile( aFile.fullPath, &defaults ) )
+                        return drill;
                 }
 
-                break;
-            default:
+                return nullptr;
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    std::vector<std::future<std::unique_ptr<GERBER_FILE_IMAGE>>> returns;
+
+    for( const PENDING_FILE& file : files )
+        returns.push_back( tp.submit_task( [&readFile, &file]() { return readFile( file ); } ) );
+
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+
+    if( files.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Load Files" ), 1, PR_CAN_ABORT );
+        progress->SetMaxProgress( files.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files..." ), files.size() ) );
+    }
+
+    std::vector<bool> done( files.size(), false );
+    size_t            doneCount = 0;
+    bool              cancelled = false;
+
+    while( doneCount < files.size() )
+    {
+        bool loaded = false;
+
+        for( size_t ii = 0; ii < files.size(); ++ii )
+        {
+            if( done[ii] || returns[ii].wait_for( std::chrono::milliseconds( 0 ) )
+                                    != std::future_status::ready )
+            {
+                continue;
+            }
+
+            const PENDING_FILE& file = files[ii];
+            filename = file.fullPath;
+
+            done[ii] = true;
+            doneCount++;
+
+            std::unique_ptr<GERBER_FILE_IMAGE> image;
+
+            try
+            {
+                image = returns[ii].get();
+            }
+            catch( const std::bad_alloc& )
+            {
+                wxString txt = wxString::Format( MSG_OOM, filename.GetFullName() );
+                reporter.Report( txt, RPT_SEVERITY_ERROR );
+                success = false;
+                continue;
+            }
+
+            // The remaining files are still read, but only to be discarded
+            if( cancelled )
+                continue;
+
+            if( !image )
+            {
                 wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
                 reporter.Report( txt, RPT_SEVERITY_ERROR );
+                success = false;
+                continue;
+            }
+
+            bool isDrill = dynamic_cast<EXCELLON_IMAGE*>( image.get() ) != nullptr;
+
+            ( *aFileType )[file.index] = isDrill ? 1 : 0;
+
+            if( !addLoadedImage( std::move( image ) ) )
+                continue;
+
+            UpdateFileHistory( file.fullPath, isDrill ? &m_drillFileHistory : nullptr );
+
+            // Select the first added layer by default when done loading
+            if( firstLoadedLayer == NO_AVAILABLE_LAYERS || file.layer < firstLoadedLayer )
+                firstLoadedLayer = file.layer;
+
+            visibility[ file.layer ] = true;
+            loaded = true;
+
+            if( progress )
+            {
+                progress->Report( wxString::Format( _( "Loaded %zu/%zu %s..." ), doneCount,
+                                                    files.size(), filename.GetFullName() ) );
+                progress->AdvanceProgress();
             }
         }
-        catch( const std::bad_alloc& )
+
+        if( loaded )
         {
-            wxString txt = wxString::Format( MSG_OOM, filename.GetFullName() );
-            reporter.Report( txt, RPT_SEVERITY_ERROR );
-            success = false;
-            continue;
+            SetVisibleLayers( visibility );
+            GetCanvas()->Refresh();
         }
 
-        if( progress )
-            progress->AdvanceProgress();
+        if( progress && !progress->KeepRefreshing() )
+            cancelled = true;
+
+        if( !loaded && doneCount < files.size() )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
     }
 
     if( !success )
@@ -0,0 +1,327 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_rect.h>
+#include <thread_pool.h>
+
+#include <gerber_diff.h>
+#include <gerber_file_image.h>
+#include <gerber_draw_item.h>
+#include <aperture_macro.h>
+#include <dcode.h>
+
+
+/**
+ * Append the outline of \a aPolygon to \a aOutput, moved by \a aOffset and mapped to the
+ * AB axis of \a aItem.
+ */
+static void appendABOutline( const GERBER_DRAW_ITEM* aItem, const SHAPE_POLY_SET& aPolygon,
+                             const VECTOR2I& aOffset, SHAPE_POLY_SET& aOutput )
+{
+    if( aPolygon.OutlineCount() == 0 )
+        return;
+
+    SHAPE_LINE_CHAIN outline;
+
+    for( const VECTOR2I& pt : aPolygon.COutline( 0 ).CPoints() )
+        outline.Append( aItem->GetABPosition( pt + aOffset ) );
+
+    outline.SetClosed( true );
+
+    if( outline.PointCount() >= 3 )
+        aOutput.AddOutline( outline );
+}
+
+
+/**
+ * Convert one draw item to polygons in AB coordinates, following what GERBVIEW_PAINTER
+ * draws for it in filled mode.
+ */
+static void itemToPolygon( GERBER_DRAW_ITEM* aItem, SHAPE_POLY_SET& aOutput, int aMaxError )
+{
+    const int width = aItem->m_Size.x;
+    D_CODE*   code = aItem->GetDcodeDescr();
+
+    switch( aItem->m_ShapeType )
+    {
+    case GBR_POLYGON:
+        appendABOutline( aItem, aItem->m_ShapeAsPolygon, VECTOR2I( 0, 0 ), aOutput );
+        break;
+
+    case GBR_CIRCLE:
+        TransformCircleToPolygon( aOutput, aItem->GetABPosition( aItem->m_Start ),
+                                  KiROUND( aItem->m_Start.Distance( aItem->m_End ) ), aMaxError,
+                                  ERROR_INSIDE );
+        break;
+
+    case GBR_SEGMENT:
+        if( code && code->m_ApertType == APT_RECT )
+        {
+            SHAPE_POLY_SET local;
+            aItem->ConvertSegmentToPolygon( &local );
+            appendABOutline( aItem, local, VECTOR2I( 0, 0 ), aOutput );
+        }
+        else
+        {
+            TransformOvalToPolygon( aOutput, aItem->GetABPosition( aItem->m_Start ),
+                                    aItem->GetABPosition( aItem->m_End ), width, aMaxError,
+                                    ERROR_INSIDE );
+        }
+
+        break;
+
+    case GBR_ARC:
+    {
+        // Same orientation rules as the painter: the arc runs from m_End to m_Start with an
+        // increasing angle, and a full circle is stored with both ends equal.
+        VECTOR2I  center = aItem->GetABPosition( aItem->m_ArcCentre );
+        VECTOR2I  arcStart = aItem->GetABPosition( aItem->m_End );
+        VECTOR2I  arcEnd = aItem->GetABPosition( aItem->m_Start );
+        int       radius = KiROUND( aItem->m_End.Distance( aItem->m_ArcCentre ) );
+        EDA_ANGLE startAngle( VECTOR2D( arcStart - center ) );
+        EDA_ANGLE endAngle( VECTOR2D( arcEnd - center ) );
+
+        if( aItem->m_End == aItem->m_Start )
+        {
+            TransformRingToPolygon( aOutput, center, radius, width, aMaxError, ERROR_INSIDE );
+            break;
+        }
+
+        if( startAngle > endAngle )
+            endAngle += ANGLE_360;
+
+        EDA_ANGLE midAngle = ( startAngle + endAngle ) / 2;
+        VECTOR2I  mid = center + VECTOR2I( KiROUND( radius * midAngle.Cos() ),
+                                           KiROUND( radius * midAngle.Sin() ) );
+
+        TransformArcToPolygon( aOutput, arcStart, mid, arcEnd, width, aMaxError, ERROR_INSIDE );
+        break;
+    }
+
+    case GBR_SPOT_MACRO:
+        if( code && code->GetMacro() )
+        {
+            SHAPE_POLY_SET* shape = code->GetMacro()->GetApertureMacroShape( aItem,
+                                                                             aItem->m_Start );
+
+            if( shape )
+                aOutput.Append( *shape );
+        }
+
+        break;
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+        if( code )
+        {
+            if( code->m_Polygon.OutlineCount() == 0 )
+                code->ConvertShapeToPolygon( aItem );
+
+            appendABOutline( aItem, code->m_Polygon, aItem->m_Start, aOutput );
+        }
+
+        break;
+    }
+}
+
+
+void GERBER_DIFF::FlattenImage( GERBER_FILE_IMAGE* aImage, SHAPE_POLY_SET& aOutput,
+                                int aMaxError )
+{
+    aOutput.RemoveAllContours();
+
+    // Consecutive items of the same polarity are merged in one boolean operation, so a
+    // typical file with no clear items costs a single union.
+    SHAPE_POLY_SET batch;
+    bool           batchNegative = false;
+
+    auto flush =
+            [&]()
+            {
+                if( batch.OutlineCount() == 0 )
+                    return;
+
+                if( batchNegative )
+                    aOutput.BooleanSubtract( batch );
+                else
+                    aOutput.BooleanAdd( batch );
+
+                batch.RemoveAllContours();
+            };
+
+    for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+    {
+        if( item->GetLayerPolarity() != batchNegative )
+        {
+            flush();
+            batchNegative = item->GetLayerPolarity();
+        }
+
+        int first = batch.OutlineCount();
+
+        itemToPolygon( item, batch, aMaxError );
+
+        // The booleans use the non-zero fill rule: overlapping outlines wound in opposite
+        // directions would cancel each other, so give them all the same orientation.
+        for( int ii = first; ii < batch.OutlineCount(); ++ii )
+        {
+            if( batch.COutline( ii ).Area( false ) < 0 )
+                batch.Outline( ii ) = batch.COutline( ii ).Reverse();
+        }
+    }
+
+    flush();
+}
+
+
+int GERBER_DIFF::TiledXor( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB,
+                           SHAPE_POLY_SET& aOutput )
+{
+    aOutput.RemoveAllContours();
+
+    BOX2I extent = aA.BBox();
+    extent.Merge( aB.BBox() );
+
+    if( extent.GetWidth() <= 0 || extent.GetHeight() <= 0 )
+        return 0;
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    // A few tiles per thread, so uneven tiles still keep all threads busy
+    int    side = std::max( 1, KiROUND( std::sqrt( 4.0 * tp.get_thread_count() ) ) );
+    size_t tileCount = static_cast<size_t>( side ) * side;
+    int    tileW = ( extent.GetWidth() + side - 1 ) / side;
+    int    tileH = ( extent.GetHeight() + side - 1 ) / side;
+
+    auto outlineBoxes =
+            []( const SHAPE_POLY_SET& aSet )
+            {
+                std::vector<BOX2I> boxes;
+                boxes.reserve( aSet.OutlineCount() );
+
+                for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+                    boxes.push_back( aSet.COutline( ii ).BBox() );
+
+                return boxes;
+            };
+
+    const std::vector<BOX2I> boxesA = outlineBoxes( aA );
+    const std::vector<BOX2I> boxesB = outlineBoxes( aB );
+
+    std::vector<SHAPE_POLY_SET> tiles( tileCount );
+
+    auto clipToTile =
+            []( const SHAPE_POLY_SET& aSet, const std::vector<BOX2I>& aBoxes,
+                const BOX2I& aTile, const SHAPE_POLY_SET& aTilePoly )
+            {
+                SHAPE_POLY_SET local;
+
+                for( int ii = 0; ii < aSet.OutlineCount(); ++ii )
+                {
+                    if( aBoxes[ii].Intersects( aTile ) )
+                        local.AddPolygon( aSet.CPolygon( ii ) );
+                }
+
+                if( local.OutlineCount() )
+                    local.BooleanIntersection( aTilePoly );
+
+                return local;
+            };
+
+    tp.submit_loop( size_t( 0 ), tileCount,
+            [&]( size_t aIdx )
+            {
+                int   col = static_cast<int>( aIdx % side );
+                int   row = static_cast<int>( aIdx / side );
+                BOX2I tile( VECTOR2I( extent.GetX() + col * tileW, extent.GetY() + row * tileH ),
+                            VECTOR2I( tileW, tileH ) );
+
+                SHAPE_POLY_SET tilePoly;
+                SHAPE_RECT( tile ).TransformToPolygon( tilePoly, 0, ERROR_INSIDE );
+
+                SHAPE_POLY_SET localA = clipToTile( aA, boxesA, tile, tilePoly );
+                SHAPE_POLY_SET localB = clipToTile( aB, boxesB, tile, tilePoly );
+
+                if( localA.OutlineCount() || localB.OutlineCount() )
+                    tiles[aIdx].BooleanXor( localA, localB );
+            } ).wait();
+
+    for( SHAPE_POLY_SET& tile : tiles )
+        aOutput.Append( tile );
+
+    // Merge the pieces of differences split by the tile borders before counting them
+    aOutput.Simplify();
+
+    int regionCount = aOutput.OutlineCount();
+
+    aOutput.Fracture();
+
+    return regionCount;
+}
+
+
+std::vector<GERBER_DIFF::RESULT>
+GERBER_DIFF::Compare( const std::vector<std::pair<GERBER_FILE_IMAGE*, GERBER_FILE_IMAGE*>>& aPairs,
+                      int aMaxError )
+{
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<SHAPE_POLY_SET>    flat( aPairs.size() * 2 );
+    std::vector<std::future<void>> pending;
+
+    // An image is only touched by a single task: D-code and macro caches are not shared
+    for( size_t ii = 0; ii < aPairs.size(); ++ii )
+    {
+        pending.push_back( tp.submit_task(
+                [&, ii]()
+                {
+                    FlattenImage( aPairs[ii].first, flat[2 * ii], aMaxError );
+                } ) );
+
+        pending.push_back( tp.submit_task(
+                [&, ii]()
+                {
+                    FlattenImage( aPairs[ii].second, flat[2 * ii + 1], aMaxError );
+                } ) );
+    }
+
+    for( std::future<void>& task : pending )
+        task.wait();
+
+    std::vector<RESULT> results( aPairs.size() );
+
+    // The XOR is already parallel inside, so the pairs are processed one after the other
+    for( size_t ii = 0; ii < aPairs.size(); ++ii )
+    {
+        results[ii].m_RegionCount = TiledXor( flat[2 * ii], flat[2 * ii + 1],
+                                              results[ii].m_Differences );
+    }
+
+    return results;
+}
@@ -0,0 +1,76 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GERBER_DIFF_H
+#define GERBER_DIFF_H
+
+#include <utility>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+
+class GERBER_FILE_IMAGE;
+
+
+/**
+ * Geometric comparison of Gerber images, e.g. the same layer of two revisions of a board.
+ *
+ * Each image is flattened to the area it covers, then the XOR of the two areas is computed
+ * tile by tile on the thread pool, so that full board planes compare in reasonable time.
+ */
+class GERBER_DIFF
+{
+public:
+    struct RESULT
+    {
+        SHAPE_POLY_SET m_Differences;      ///< Fractured areas covered by only one image
+        int            m_RegionCount = 0;  ///< Number of separate difference areas
+    };
+
+    /**
+     * Build the area covered by \a aImage, in the order of its items so that clear (negative)
+     * items remove what was drawn before them.
+     *
+     * Not thread safe for a given image: the D-code and aperture macro shape caches are filled
+     * on the way.  Different images can be flattened concurrently.
+     */
+    static void FlattenImage( GERBER_FILE_IMAGE* aImage, SHAPE_POLY_SET& aOutput, int aMaxError );
+
+    /**
+     * Compute \a aA XOR \a aB on a grid of tiles in parallel.
+     *
+     * @return the number of separate difference areas.
+     */
+    static int TiledXor( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB,
+                         SHAPE_POLY_SET& aOutput );
+
+    /**
+     * Compare each pair of images.  The images are flattened in parallel; an image must not
+     * appear in more than one pair.
+     */
+    static std::vector<RESULT>
+    Compare( const std::vector<std::pair<GERBER_FILE_IMAGE*, GERBER_FILE_IMAGE*>>& aPairs,
+             int aMaxError );
+};
+
+#endif // GERBER_DIFF_H
@@ -67,7 +67,11 @@ public:
     ~GERBER_DRAW_ITEM();
 
     void SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
-    const GBR_NETLIST_METADATA& GetNetAttributes() const { return m_netAttributes; }
+    const GBR_NETLIST_METADATA& GetNetAttributes() const
+    {
+        static const GBR_NETLIST_METADATA noAttributes;
+        return m_netAttributes ? *m_netAttributes : noAttributes;
+    }
 
     /**
      * Return the layer this item is on.
@@ -270,9 +274,10 @@ private:
     VECTOR2I    m_drawScale;                // A and B scaling factor
     VECTOR2I    m_layerOffset;              // Offset for A and B axis, from OF parameter
     double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
-    GBR_NETLIST_METADATA m_netAttributes;   ///< the string given by a %TO attribute set in aperture
-                                            ///< (dcode). Stored in each item, because %TO is
-                                            ///< a dynamic object attribute
+    const GBR_NETLIST_METADATA* m_netAttributes; ///< the string given by a %TO attribute set in
+                                            ///< aperture (dcode). Set for each item, because %TO
+                                            ///< is a dynamic object attribute, but owned and
+                                            ///< shared by the items of the gerber image
 };
 
 
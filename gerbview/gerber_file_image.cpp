@@ -85,6 +85,7 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
     EDA_ITEM( nullptr, GERBER_IMAGE_T )
 {
     m_GraphicLayer = aLayer;        // Graphic layer Number
+    m_LineBuffer = nullptr;
     m_PositiveDrawColor  = WHITE;   // The color used to draw positive items for this image
 
     m_Selected_Tool = 0;
@@ -385,6 +386,27 @@ void GERBER_FILE_IMAGE::DisplayImageInfo(  GERBVIEW_FRAME* aMainFrame  )
 }
 
 
+const GBR_NETLIST_METADATA*
+GERBER_FILE_IMAGE::InternNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes )
+{
+    if( !m_itemNetAttributes.empty() && m_itemNetAttributes.back() == aNetAttributes )
+        return &m_itemNetAttributes.back();
+
+    const GBR_NETLIST_METADATA& attributes = m_itemNetAttributes.emplace_back( aNetAttributes );
+
+    if( ( attributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP )
+        || ( attributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+    {
+        m_ComponentsList.insert( std::make_pair( attributes.m_Cmpref, 0 ) );
+    }
+
+    if( ( attributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+        m_NetnamesList.insert( std::make_pair( attributes.m_Netname, 0 ) );
+
+    return &attributes;
+}
+
+
 void GERBER_FILE_IMAGE::RemoveAttribute( X2_ATTRIBUTE& aAttribute )
 {
     /* Called when a %TD command is found
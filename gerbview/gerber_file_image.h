@@ -25,6 +25,7 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <deque>
 #include <vector>
 #include <set>
 
@@ -199,6 +200,15 @@ public:
      */
     bool HasNegativeItems();
 
+    /**
+     * Return the shared copy of \a aNetAttributes for an item of this image.
+     *
+     * Consecutive items almost always have the same %TO attributes, so the items only keep a
+     * pointer to one copy per change of attributes instead of a copy each.  The component and
+     * net name lists are updated when new attributes are seen.
+     */
+    const GBR_NETLIST_METADATA* InternNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
+
     /**
      * Clear the message list.
      *
@@ -474,12 +484,17 @@ public:
     VECTOR2I           m_DisplayOffset;
     EDA_ANGLE          m_DisplayRotation;
 
-    // A large buffer to store one line
-    static char m_LineBuffer[GERBER_BUFZ+1];
+    // A large buffer to store one line, GERBER_BUFZ+1 long, only allocated while a file is
+    // read.  Each image has its own so that several files can be read at the same time.
+    char*              m_LineBuffer;
 
 private:
     wxArrayString      m_messagesList;         // A list of messages created when reading a file
 
+    // The net attributes of the items (see InternNetAttributes()).  A deque so that the
+    // items' pointers stay valid as it grows.
+    std::deque<GBR_NETLIST_METADATA> m_itemNetAttributes;
+
     /**
      * True if the image is negative or has some negative items.
      *
@@ -166,6 +166,14 @@ public:
      */
     int getNextAvailableLayer() const;
 
+    /**
+     * Put a loaded Gerber or drill image on the (empty) layer it was loaded for, show its
+     * read errors and add its items to the view.
+     *
+     * @return false if the image could not be added, in which case it is deleted.
+     */
+    bool addLoadedImage( std::unique_ptr<GERBER_FILE_IMAGE> aImage );
+
     /**
      * Update the currently "selected" layer within the #GERBER_LAYER_WIDGET.
      * The currently active layer is defined by the return value of GetActiveLayer().
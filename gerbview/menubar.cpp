@@ -213,6 +213,7 @@ void GERBVIEW_FRAME::doReCreateMenuBar()
     toolsMenu->Add( ACTIONS::measureTool );
 
     toolsMenu->AppendSeparator();
+    toolsMenu->Add( GERBVIEW_ACTIONS::compareLayers );
     toolsMenu->Add( GERBVIEW_ACTIONS::clearLayer );
 
 
@@ -28,6 +28,7 @@
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <excellon_image.h>
 #include <richio.h>
 #include <view/view.h>
 
@@ -43,7 +44,6 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
     wxString msg;
 
     int layer = GetActiveLayer();
-    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
     GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
 
     if( gerber != nullptr )
@@ -66,14 +66,29 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
         return false;
     }
 
-    gerber = gerber_uptr.release();
-    wxASSERT( gerber != nullptr );
-    images->AddGbrImage( gerber, layer );
+    return addLoadedImage( std::move( gerber_uptr ) );
+}
+
+
+bool GERBVIEW_FRAME::addLoadedImage( std::unique_ptr<GERBER_FILE_IMAGE> aImage )
+{
+    GERBER_FILE_IMAGE_LIST* images = GetImagesList();
+    bool                    isDrill = dynamic_cast<EXCELLON_IMAGE*>( aImage.get() ) != nullptr;
+
+    if( images->AddGbrImage( aImage.get(), aImage->m_GraphicLayer ) < 0 )
+    {
+        ShowInfoBarError( _( "No empty layers to load file into." ) );
+        return false;
+    }
+
+    GERBER_FILE_IMAGE* gerber = aImage.release();
+    wxString           msg;
 
     // Display errors list
     if( gerber->GetMessages().size() > 0 )
     {
-        HTML_MESSAGE_BOX dlg( this, _( "Errors" ) );
+        HTML_MESSAGE_BOX dlg( this, isDrill ? _( "Error reading EXCELLON drill file" )
+                                            : _( "Errors" ) );
         dlg.ListSet( gerber->GetMessages() );
         dlg.ShowModal();
     }
@@ -83,7 +98,7 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
      * or has missing definitions,
      * warn the user:
      */
-    if( gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
+    if( !isDrill && gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
     {
         if( !gerber->m_Has_DCode )
             msg = _("Warning: this file has no D-Code definition\n"
@@ -226,9 +241,6 @@ bool GERBER_FILE_IMAGE::TestFileIsRS274( const wxString& aFullFileName )
 }
 
 
-// A large buffer to store one line
-char GERBER_FILE_IMAGE::m_LineBuffer[GERBER_BUFZ+1];
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -246,7 +258,10 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     m_FileName = aFullFileName;
 
-    wxString msg;
+    wxString          msg;
+    std::vector<char> lineBuffer( GERBER_BUFZ + 1 );
+
+    m_LineBuffer = lineBuffer.data();
 
     while( true )
     {
@@ -342,6 +357,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     fclose( m_Current_File );
 
+    m_LineBuffer = nullptr;
     m_InUse = true;
 
     return true;
@@ -104,6 +104,13 @@ TOOL_ACTION GERBVIEW_ACTIONS::clearLayer( TOOL_ACTION_ARGS()
         .FriendlyName( _( "Clear Current Layer..." ) )
         .Icon( BITMAPS::delete_sheet ) );
 
+TOOL_ACTION GERBVIEW_ACTIONS::compareLayers( TOOL_ACTION_ARGS()
+        .Name( "gerbview.Control.compareLayers" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Compare With Layer..." ) )
+        .Tooltip( _( "Add a layer showing the areas covered by only one of the current layer "
+                     "and another layer." ) ) );
+
 TOOL_ACTION GERBVIEW_ACTIONS::clearAllLayers( TOOL_ACTION_ARGS()
         .Name( "gerbview.Control.clearAllLayers" )
         .Scope( AS_GLOBAL )
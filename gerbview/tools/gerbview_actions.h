@@ -57,6 +57,7 @@ public:
     static TOOL_ACTION moveLayerUp;
     static TOOL_ACTION moveLayerDown;
     static TOOL_ACTION clearLayer;
+    static TOOL_ACTION compareLayers;
     static TOOL_ACTION clearAllLayers;
     static TOOL_ACTION reloadAllLayers;
 
@@ -22,6 +22,8 @@
 #include <common.h>
 #include <dialogs/dialog_map_gerber_layers_to_pcb.h>
 #include <export_to_pcbnew.h>
+#include <gerber_diff.h>
+#include <gerber_draw_item.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
 #include <gerbview_painter.h>
@@ -33,6 +35,7 @@
 #include <project.h>
 #include <view/view.h>
 #include <wildcards_and_files_ext.h>
+#include <wx/choicdlg.h>
 #include <wx/filedlg.h>
 
 #include "gerbview_actions.h"
@@ -140,7 +143,8 @@ int GERBVIEW_CONTROL::ExportToPcbnew( const TOOL_EVENT& aEvent )
 
     GBR_TO_PCB_EXPORTER gbr_exporter( m_frame, fileName.GetFullPath() );
 
-    gbr_exporter.ExportPcb( layerdlg.GetLayersLookUpTable(), layerdlg.GetCopperLayersCount() );
+    gbr_exporter.ExportPcb( layerdlg.GetLayersLookUpTable(), layerdlg.GetCopperLayersCount(),
+                            layerdlg.GetMergePolygons() );
 
     return 0;
 }
@@ -389,6 +393,104 @@ int GERBVIEW_CONTROL::ClearLayer( const TOOL_EVENT& aEvent )
 }
 
 
+int GERBVIEW_CONTROL::CompareLayers( const TOOL_EVENT& aEvent )
+{
+    GERBER_FILE_IMAGE_LIST* list = m_frame->GetImagesList();
+    int                     activeLayer = m_frame->GetActiveLayer();
+    GERBER_FILE_IMAGE*      active = m_frame->GetGbrImage( activeLayer );
+
+    if( !active )
+    {
+        m_frame->ShowInfoBarError( _( "The current layer is empty." ) );
+        return 0;
+    }
+
+    wxArrayString    names;
+    std::vector<int> layers;
+
+    for( unsigned ii = 0; ii < list->ImagesMaxCount(); ii++ )
+    {
+        if( (int) ii == activeLayer || !list->GetGbrImage( ii ) )
+            continue;
+
+        names.Add( list->GetDisplayName( ii ) );
+        layers.push_back( ii );
+    }
+
+    if( layers.empty() )
+    {
+        m_frame->ShowInfoBarError( _( "No other layer to compare with." ) );
+        return 0;
+    }
+
+    wxSingleChoiceDialog dlg( m_frame, _( "Layer to compare with the current layer:" ),
+                              _( "Compare With Layer" ), names );
+
+    if( dlg.ShowModal() != wxID_OK )
+        return 0;
+
+    int                other = layers[dlg.GetSelection()];
+    GERBER_DIFF::RESULT result;
+
+    {
+        wxBusyCursor dummy;
+
+        // 5 microns, the same as the painter uses for arcs
+        std::vector<GERBER_DIFF::RESULT> results =
+                GERBER_DIFF::Compare( { { active, m_frame->GetGbrImage( other ) } },
+                                      gerbIUScale.mmToIU( 0.005 ) );
+
+        result = std::move( results.front() );
+    }
+
+    if( result.m_RegionCount == 0 )
+    {
+        m_frame->ShowInfoBarMsg( _( "The layers are identical." ) );
+        return 0;
+    }
+
+    int layer = m_frame->getNextAvailableLayer();
+
+    if( layer == NO_AVAILABLE_LAYERS )
+    {
+        m_frame->ShowInfoBarError( _( "No empty layers to load file into." ) );
+        return 0;
+    }
+
+    // The differences are already in AB coordinates, so the new image keeps default
+    // layer parameters.
+    auto image = std::make_unique<GERBER_FILE_IMAGE>( layer );
+
+    image->m_InUse = true;
+    image->m_FileName = wxString::Format( _( "Diff %s / %s" ),
+                                          list->GetDisplayName( activeLayer, true ),
+                                          list->GetDisplayName( other, true ) );
+
+    for( int ii = 0; ii < result.m_Differences.OutlineCount(); ii++ )
+    {
+        GERBER_DRAW_ITEM* item = new GERBER_DRAW_ITEM( image.get() );
+
+        item->m_ShapeType = GBR_POLYGON;
+        item->m_ShapeAsPolygon.AddOutline( result.m_Differences.COutline( ii ) );
+        item->m_Start = item->m_ShapeAsPolygon.CVertex( 0 );
+        item->m_End = item->m_Start;
+        image->AddItemToList( item );
+    }
+
+    if( !m_frame->addLoadedImage( std::move( image ) ) )
+        return 0;
+
+    m_frame->SetActiveLayer( layer, true );
+    m_frame->ReFillLayerWidget();
+    canvas()->Refresh();
+
+    m_frame->ShowInfoBarMsg( wxString::Format( _( "%d differing areas found." ),
+                                               result.m_RegionCount ) );
+
+    return 0;
+}
+
+
 int GERBVIEW_CONTROL::ClearAllLayers( const TOOL_EVENT& aEvent )
 {
     m_frame->Clear_DrawLayers( false );
@@ -526,6 +628,7 @@ void GERBVIEW_CONTROL::setTransitions()
     Go( &GERBVIEW_CONTROL::MoveLayerUp,        GERBVIEW_ACTIONS::moveLayerUp.MakeEvent() );
     Go( &GERBVIEW_CONTROL::MoveLayerDown,      GERBVIEW_ACTIONS::moveLayerDown.MakeEvent() );
     Go( &GERBVIEW_CONTROL::ClearLayer,         GERBVIEW_ACTIONS::clearLayer.MakeEvent() );
+    Go( &GERBVIEW_CONTROL::CompareLayers,      GERBVIEW_ACTIONS::compareLayers.MakeEvent() );
     Go( &GERBVIEW_CONTROL::ClearAllLayers,     GERBVIEW_ACTIONS::clearAllLayers.MakeEvent() );
     Go( &GERBVIEW_CONTROL::ReloadAllLayers,    GERBVIEW_ACTIONS::reloadAllLayers.MakeEvent() );
 
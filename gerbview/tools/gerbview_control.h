@@ -48,6 +48,7 @@ public:
     int MoveLayerUp( const TOOL_EVENT& aEvent );
     int MoveLayerDown( const TOOL_EVENT& aEvent );
     int ClearLayer( const TOOL_EVENT& aEvent );
+    int CompareLayers( const TOOL_EVENT& aEvent );
     int ClearAllLayers( const TOOL_EVENT& aEvent );
     int ReloadAllLayers( const TOOL_EVENT& aEvent );
 
@@ -797,6 +797,26 @@ public:
      */
     int m_MaximumThreads;
 
+    /**
+     * Memory budget of the undo history, in megabytes.  The oldest commands are dropped once
+     * the history is estimated to take more, in addition to the undo count limit.  Only the
+     * editors which estimate their command sizes (pcbnew) use it.  0 disables the budget.
+     *
+     * Setting name: "UndoMemoryBudgetMB"
+     * Valid values: 0 to 65536
+     * Default value: 1024
+     */
+    int m_UndoMemoryBudgetMB;
+
+    /**
+     * Add the memory estimates of the open editors (zone fills, undo history, graphics buffers,
+     * connectivity) to the version information, to help tune memory budgets.
+     *
+     * Setting name: "ShowMemoryUsage"
+     * Default value: false
+     */
+    bool m_ShowMemoryUsage;
+
     /**
      * When updating the net inspector, it either recalculates all nets or iterates through items
      * one-by-one. This value controls the threshold at which all nets are recalculated rather than
@@ -863,6 +883,55 @@ public:
      */
     int m_FollowBranchTimeout;
 
+    /**
+     * Evaluate the alternative ways of walking a shoved line around its obstacles concurrently
+     * on the thread pool instead of one after the other.
+     *
+     * Setting name: "PNSParallelShove"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_PNSParallelShove;
+
+    /**
+     * Parse the tracks, footprints, zones and other items of large boards concurrently on the
+     * thread pool when loading a .kicad_pcb file in the current format.
+     *
+     * Setting name: "ParallelBoardLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardLoad;
+
+    /**
+     * Load the sub-sheets of a schematic sheet concurrently on the thread pool.
+     *
+     * Setting name: "ParallelSchematicLoad"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelSchematicLoad;
+
+    /**
+     * Keep a binary snapshot of the zone fills next to each saved .kicad_pcb file, used to
+     * reopen the board without parsing the fills while the board file is unchanged.
+     *
+     * Setting name: "BoardFillSidecar"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_BoardFillSidecar;
+
+    /**
+     * Format the tracks and zones of large boards concurrently on the thread pool when saving
+     * a .kicad_pcb file.
+     *
+     * Setting name: "ParallelBoardSave"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_ParallelBoardSave;
+
     /**
      * Skip importing component bodies when importing some format files, such as Altium.
      *
@@ -934,6 +1003,100 @@ public:
      */
     bool m_ZoneFillIterativeRefill;
 
+    /**
+     * Fill large copper zones in square tiles of this size, in parallel.
+     *
+     * Each tile is filled on its own with a margin and the results are merged, which spreads
+     * a single large pour over all cores and bounds the size of the intermediate polygons.
+     * Zones that fit in a single tile are filled as a whole.  0 disables tiling.
+     *
+     * Setting name: "ZoneFillTileSize"
+     * Valid values: 0.0 to 1000.0 (mm)
+     * Default value: 0.0
+     */
+    double m_ZoneFillTileSize;
+
+    /**
+     * Keep the zone fills of headless (CLI) zone fills in a cache file next to the board, and
+     * reuse the cached fills whose inputs did not change.
+     *
+     * Setting name: "ZoneFillCache"
+     * Valid values: true or false
+     * Default value: true
+     */
+    bool m_ZoneFillCache;
+
+    /**
+     * After each board edit, re-run the DRC tests which support it on the changed items and
+     * their neighbours, updating the markers of the last full DRC run.
+     *
+     * Setting name: "IncrementalDRC"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_IncrementalDRC;
+
+    /**
+     * Maximum number of DRC test providers run concurrently.  Providers which don't depend on
+     * each other's state run side by side; 1 runs them one after another.  0 uses one per core.
+     *
+     * Setting name: "DRCProviderThreads"
+     * Valid values: 0 to 500
+     * Default value: 0
+     */
+    int m_DRCProviderThreads;
+
+    /**
+     * When zoomed out, draw only one of the items smaller than a pixel and a half falling in
+     * the same screen cell of a layer.  The skipped items would be hidden under the drawn one.
+     *
+     * Setting name: "ViewCoalesceSubPixelItems"
+     * Valid values: true or false
+     * Default value: true
+     */
+    bool m_ViewCoalesceSubPixelItems;
+
+    /**
+     * Show the time spent by each drawing stage of the last frame on the canvases.
+     *
+     * Setting name: "ShowFrameProfile"
+     * Valid values: true or false
+     * Default value: false
+     */
+    bool m_ShowFrameProfile;
+
+    /**
+     * File to write the frame timings to, in the Chrome trace event format, when a canvas
+     * showing the frame profile is closed.  Open it with chrome://tracing or Perfetto.
+     *
+     * Setting name: "FrameProfileTraceFile"
+     * Valid values: a file path, or empty to not write the trace
+     * Default value: empty
+     */
+    wxString m_FrameProfileTraceFile;
+
+    /**
+     * Ollama embedding model used to build a semantic index of the symbol libraries for the
+     * schematic agent's symbol search.  The index is built in the background on first use and
+     * cached in the project.
+     *
+     * Setting name: "AgentEmbeddingModel"
+     * Valid values: an embedding model name (e.g. "nomic-embed-text"), or empty
+     * Default value: empty, only the name search is used
+     */
+    wxString m_AgentEmbeddingModel;
+
+    /**
+     * Small Ollama model drafting the plan of simple schematic agent requests (e.g. "add a
+     * 10k pull-up on SDA").  A draft is applied only if all its tool calls succeed against the
+     * schematic; otherwise the request goes to the main model.
+     *
+     * Setting name: "AgentDraftModel"
+     * Valid values: a model name (e.g. "qwen2.5:1.5b"), or empty
+     * Default value: empty, every request goes to the main model
+     */
+    wxString m_AgentDraftModel;
+
     wxString m_traceMasks; ///< Trace masks for wxLogTrace, loaded from the config file.
     ///@}
 
@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <optional>
+#include <set>
 
 #include <fmt/format.h>
 #include <tl/expected.hpp>
@@ -67,6 +68,12 @@ public:
      */
     API_RESULT Handle( ApiRequest& aMsg );
 
+    /**
+     * @return true if this class handles \a aMsg without touching any editor or document state,
+     *         so the server may run it on its own thread instead of waiting for the event loop.
+     */
+    bool IsThreadSafe( const ApiRequest& aMsg ) const;
+
 protected:
 
     /**
@@ -125,9 +132,26 @@ protected:
                 };
     }
 
+    /**
+     * Registers a handler like registerHandler, and marks it as safe to run on the API server
+     * thread.  Only use this for handlers that read nothing but immutable or internally locked
+     * state: there is no lock on the documents, and the UI thread keeps editing them while the
+     * handler runs.
+     */
+    template <class RequestType, class ResponseType, class HandlerType>
+    void registerThreadSafeHandler( HANDLER_RESULT<ResponseType> ( HandlerType::*aHandler )(
+            const HANDLER_CONTEXT<RequestType>& ) )
+    {
+        registerHandler<RequestType, ResponseType, HandlerType>( aHandler );
+        m_threadSafeHandlers.insert( std::string( RequestType().GetTypeName() ) );
+    }
+
     /// Maps type name (without the URL prefix) to a handler method
     std::map<std::string, REQUEST_HANDLER> m_handlers;
 
+    /// Type names of the handlers that may run off the main thread
+    std::set<std::string> m_threadSafeHandlers;
+
     static const wxString m_defaultCommitMessage;
 
 private:
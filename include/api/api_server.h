@@ -21,17 +21,28 @@
 #ifndef KICAD_API_SERVER_H
 #define KICAD_API_SERVER_H
 
+#include <array>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
 #include <wx/event.h>
 #include <wx/filename.h>
 
+#include <core/profile.h>
 #include <kicommon.h>
 
 class API_HANDLER;
+class KINNG_PUBLISHER;
 class KINNG_REQUEST_SERVER;
+
+namespace kiapi::common
+{
+class ApiRequest;
+class ApiResponse;
+}
 class wxEvtHandler;
 
 
@@ -69,15 +80,71 @@ public:
 
     std::string SocketPath() const;
 
+    /**
+     * @return the URL of the socket that change notifications are published on, for clients
+     *         that want to follow edits without polling.
+     */
+    std::string EventSocketPath() const;
+
+    /**
+     * Send a notification to every subscriber of the event socket.  The message is the topic,
+     * a NUL separator, then the serialized protobuf payload, so subscribers can filter on the
+     * topic prefix.
+     */
+    void Publish( const std::string& aTopic, const std::string& aPayload );
+
+    /// @return true if someone is subscribed, so publishing is worth the serialization cost
+    bool CanPublish() const;
+
     const std::string& Token() const { return m_token; }
 
+    /**
+     * @return the request counters and latency histograms of each command handled so far, as
+     *         a JSON document.  Clients get the same document by sending #API_STATS_REQUEST.
+     */
+    std::string GetStats() const;
+
+    /// Control request answered with GetStats() on the server thread, even while busy
+    static const std::string API_STATS_REQUEST;
+
 private:
+    /**
+     * Request latencies in power of two buckets: bucket i counts the samples of less than 2^i
+     * microseconds (and at least 2^(i-1)); the last one also counts everything slower.
+     */
+    struct LATENCY_HISTOGRAM
+    {
+        void Add( double aMsecs );
+
+        uint64_t                 count = 0;
+        double                   total = 0.0;
+        double                   max = 0.0;
+        std::array<uint64_t, 24> buckets = {};
+    };
+
+    struct COMMAND_STATS
+    {
+        uint64_t          count = 0;
+        uint64_t          errors = 0;
+        LATENCY_HISTOGRAM queueWait;       ///< From receipt to the start of handling
+        LATENCY_HISTOGRAM handler;
+        LATENCY_HISTOGRAM serialization;   ///< Serialization of the response
+    };
+
+    /**
+     * Serialize and send \a aResponse to the request of type \a aType, and account for it in
+     * the stats.
+     */
+    void reply( kiapi::common::ApiResponse& aResponse, const std::string& aType,
+                double aQueueWait, double aHandlerTime, bool aError );
 
     /**
      * Callback that executes on the server thread and generates an event that will be handled by
      * the wxWidgets event loop to process an incoming request.  Temporarily takes ownership of the
      * request pointer so that it can be passed through the event system.
      *
+     * Requests that a handler declares thread safe are answered directly on the server thread.
+     *
      * @param aRequest is a pointer to a string containing bytes that came in over the wire
      */
     void onApiRequest( std::string* aRequest );
@@ -88,16 +155,34 @@ private:
      */
     void handleApiEvent( wxCommandEvent& aEvent );
 
+    /**
+     * Pass a parsed request to the handlers and reply with the result.  The caller must hold
+     * m_handlersMutex.
+     */
+    void handleRequest( kiapi::common::ApiRequest& aRequest );
+
     void log( const std::string& aOutput );
 
     std::unique_ptr<KINNG_REQUEST_SERVER> m_server;
 
+    std::unique_ptr<KINNG_PUBLISHER> m_publisher;
+
     std::set<API_HANDLER*> m_handlers;
 
+    /// Guards m_handlers, which is also read from the server thread.  Recursive because handlers
+    /// running on the main thread may register or deregister handlers.
+    std::recursive_mutex m_handlersMutex;
+
     std::string m_token;
 
     bool m_readyToReply;
 
+    /// Started when a request arrives; only one request is in flight at a time
+    PROF_TIMER m_requestTimer;
+
+    std::map<std::string, COMMAND_STATS> m_stats;
+    mutable std::mutex                   m_statsMutex;
+
     static wxString s_logFileName;
 
     wxFileName m_logFilePath;
@@ -235,6 +235,12 @@ public:
      */
     bool DoRePaint();
 
+    /**
+     * Show the time spent by each drawing stage of the last frame in the canvas corner.
+     */
+    void SetShowFrameProfile( bool aShow );
+    bool GetShowFrameProfile() const { return m_showFrameProfile; }
+
     /**
      * Create an overlay for rendering debug graphics.
      */
@@ -270,6 +276,9 @@ protected:
     void onRefreshTimer( wxTimerEvent& aEvent );
     void onShowEvent( wxShowEvent& aEvent );
 
+    /// Draw the last frame timings on the overlay target.
+    void drawFrameProfile();
+
     wxWindow*                m_parent;           ///< Pointer to the parent window
     EDA_DRAW_FRAME*          m_edaFrame;         ///< Parent EDA_DRAW_FRAME (if available)
 
@@ -319,6 +328,9 @@ protected:
 
     /// Optional overlay for drawing transient debug objects
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
+
+    /// True if the frame timings are drawn on the canvas
+    bool                     m_showFrameProfile;
 };
 
 #endif
@@ -116,7 +116,8 @@ private:
 
     char m_quoteChar;
 
-    typedef DATABASE_CACHE<std::map<std::string, ROW>> DB_CACHE_TYPE;
+    /// Rows are shared with the callers of SelectOne() so a lookup doesn't copy the whole table
+    typedef DATABASE_CACHE<std::shared_ptr<const std::map<std::string, ROW>>> DB_CACHE_TYPE;
 
     std::unique_ptr<DB_CACHE_TYPE> m_cache;
 };
@@ -29,6 +29,7 @@
 #include <cstdio>
 #include <hashtables.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <richio.h>
@@ -253,7 +254,7 @@ public:
      */
     int GetCurStrAsToken() const
     {
-        return findToken( curText );
+        return findToken( CurStr() );
     }
 
     /**
@@ -416,7 +417,7 @@ public:
      */
     const char* CurText() const
     {
-        return curText.c_str();
+        return CurStr().c_str();
     }
 
     /**
@@ -424,6 +425,25 @@ public:
      */
     const std::string& CurStr() const
     {
+        if( curTextPending )
+        {
+            curText.assign( curNumber );
+            curTextPending = false;
+        }
+
+        return curText;
+    }
+
+    /**
+     * Return the current token without copying it, where the #LINE_READER allows it.
+     *
+     * The view is only valid until the next call to NextTok().
+     */
+    std::string_view CurStrView() const
+    {
+        if( curTextPending )
+            return curNumber;
+
         return curText;
     }
 
@@ -438,7 +458,7 @@ public:
      */
     wxString FromUTF8() const
     {
-        return wxString::FromUTF8( curText.c_str() );
+        return wxString::FromUTF8( CurStr().c_str() );
     }
 
     /**
@@ -454,6 +474,13 @@ public:
      */
     const char* CurLine() const
     {
+        // a viewed line is not nul terminated
+        if( viewLines )
+        {
+            curLineText.assign( start, limit );
+            return curLineText.c_str();
+        }
+
         return (const char*)(*reader);
     }
 
@@ -488,18 +515,16 @@ protected:
     {
         if( reader )
         {
-            reader->ReadLine();
-
-            unsigned len = reader->Length();
+            std::string_view line = reader->ReadLineView();
 
             // start may have changed in ReadLine(), which can resize and
             // relocate reader's line buffer.
-            start = reader->Line();
+            start = line.data();
 
             next  = start;
-            limit = next + len;
+            limit = next + line.size();
 
-            return len;
+            return line.size();
         }
         return 0;
     }
@@ -533,6 +558,22 @@ protected:
      */
     double parseDouble();
 
+    /**
+     * Parse the current token as a base 10 integer, without copying it where possible.
+     *
+     * As with strtol(), parsing stops at the first character which is not part of the number.
+     *
+     * @return the parsed value, clamped to the range of long, or 0 if it is not a number.
+     */
+    long parseLong();
+
+    /**
+     * Parse the current token as a base 16 integer, without copying it where possible.
+     *
+     * @return the parsed value, clamped to the range of long, or 0 if it is not a number.
+     */
+    long parseHex();
+
     double parseDouble( const char* aExpected )
     {
         NeedNUMBER( aExpected );
@@ -576,12 +617,17 @@ protected:
     int                 curOffset;              ///< Offset within current line of the current token
 
     int                 curTok;                 ///< The current token obtained on last NextTok().
-    std::string         curText;                ///< The text of the current token.
+    mutable std::string curText;                ///< The text of the current token.
     std::string         curSeparator;           ///< The text of the separator preceeding the current text.
 
     const KEYWORD*      keywords;               ///< Table sorted by CMake for bsearch().
     unsigned            keywordCount;           ///< Count of keywords table.
     const KEYWORD_MAP*  keywordsLookup;         ///< Fast, specialized "C string" hashtable.
+
+    bool                viewLines;              ///< The reader's lines outlive the tokens.
+    mutable bool        curTextPending;         ///< curText of a number is still in curNumber.
+    std::string_view    curNumber;              ///< The number token in the viewed line.
+    mutable std::string curLineText;            ///< The copy returned by CurLine() for views.
 #endif // SWIG
 };
 
@@ -242,6 +242,8 @@ public:
 
     const wxString& GetPattern() const;
 
+    COMBINED_MATCHER_CONTEXT GetContext() const { return m_context; }
+
     int ScoreTerms( std::vector<SEARCH_TERM>& aWeightedTerms );
 
 private:
@@ -249,7 +251,8 @@ private:
     void AddMatcher( const wxString& aPattern, std::unique_ptr<EDA_PATTERN_MATCH> aMatcher );
 
     std::vector<std::unique_ptr<EDA_PATTERN_MATCH>> m_matchers;
-    wxString m_pattern;
+    wxString                                        m_pattern;
+    COMBINED_MATCHER_CONTEXT                        m_context;
 };
 
 #endif  // EDA_PATTERN_MATCH_H
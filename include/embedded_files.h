@@ -59,6 +59,8 @@ public:
 
         bool Validate()
         {
+            EMBEDDED_FILES::EnsureDecompressed( *this );
+
             MMH3_HASH hash( EMBEDDED_FILES::Seed() );
             hash.add( decompressedData );
 
@@ -77,6 +79,12 @@ public:
             return is_valid;
         }
 
+        /// Files are loaded compressed; see EMBEDDED_FILES::EnsureDecompressed()
+        bool IsDecompressed() const
+        {
+            return !decompressedData.empty() || compressedEncodedData.empty();
+        }
+
         wxString GetLink() const
         {
             return wxString::Format( "%s://%s", FILEEXT::KiCadUriPrefix, name );
@@ -222,6 +230,22 @@ public:
      */
     static RETURN_CODE  DecompressAndDecode( EMBEDDED_FILE& aFile );
 
+    /**
+     * Decompress the data of a file on its first access.
+     *
+     * The parsers keep embedded files compressed, since most of them (3D models, datasheets)
+     * are never opened in a session.  Decompressed data is kept in a process wide cache keyed
+     * on the file checksum, so the same font or model embedded in several boards, symbols or
+     * footprints is only decoded once.
+     */
+    static RETURN_CODE  EnsureDecompressed( EMBEDDED_FILE& aFile );
+
+    /**
+     * Decompress the files that are not decompressed yet on the thread pool.  The files must
+     * not be accessed by other threads meanwhile.
+     */
+    static void         DecompressFiles( const std::vector<EMBEDDED_FILE*>& aFiles );
+
     /**
      * Returns the embedded file with the given name or nullptr if it does not exist.
      */
@@ -277,6 +301,10 @@ public:
     EMBEDDED_FILES& operator=( EMBEDDED_FILES&& other ) noexcept;
     EMBEDDED_FILES& operator=( const EMBEDDED_FILES& other );
 
+private:
+    /// @return the name of the file holding \a aFile in the user's embed cache directory
+    static wxFileName cacheFileName( const EMBEDDED_FILE& aFile );
+
 private:
     std::map<wxString, EMBEDDED_FILE*> m_files;
     std::vector<wxString>              m_fontFiles;
@@ -27,6 +27,7 @@
 #ifndef OUTLINE_DECOMPOSER_H
 #define OUTLINE_DECOMPOSER_H
 
+#include <map>
 #include <vector>
 #ifdef _MSC_VER
 #include <ft2build.h>
@@ -60,9 +61,12 @@ struct GLYPH_DATA
 {
     std::vector<CONTOUR> m_Contours;
 
-    // Cache of the triangulation data.  We'll use this as a hint for triangulating the actual
-    // OUTLINE_GLYPHs.
-    std::vector<std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>> m_TriangulationData;
+    // Cache of the triangulation data, per size bucket of the drawn glyph.  We'll use this as
+    // a hint for triangulating the actual OUTLINE_GLYPHs.  The triangles only index the contour
+    // points, so they stay valid whatever the glyph position, rotation or mirroring; the size
+    // bucket keeps glyphs whose points collapse differently once rounded apart.
+    std::map<int, std::vector<std::unique_ptr<SHAPE_POLY_SET::TRIANGULATED_POLYGON>>>
+            m_TriangulationData;
 };
 
 
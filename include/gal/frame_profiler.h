@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <gal/gal.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class wxString;
+
+namespace KIGFX
+{
+
+/**
+ * Collect the time spent by each stage of the drawing pipeline (view update and redraw, GAL
+ * begin/end drawing, vertex container reallocations, compositor passes) for every frame.
+ *
+ * Nothing is measured unless the profiler is enabled.  The last #MAX_FRAMES frames are kept, so
+ * they can be shown on the canvas or exported as a Chrome trace (chrome://tracing or Perfetto).
+ */
+class GAL_API FRAME_PROFILER
+{
+public:
+    struct EVENT
+    {
+        const char* m_Name;         ///< Stage name, must outlive the profiler (string literal)
+        int64_t     m_Start;        ///< Start time in microseconds, see GetRunningMicroSecs()
+        int64_t     m_Duration;     ///< Duration in microseconds
+    };
+
+    struct FRAME
+    {
+        int64_t            m_Start = 0;
+        int64_t            m_Duration = 0;
+        std::vector<EVENT> m_Events;
+    };
+
+    /**
+     * Record the lifetime of the scope as a stage of the current frame.
+     */
+    class GAL_API SCOPE
+    {
+    public:
+        SCOPE( const char* aName );
+        ~SCOPE();
+
+    private:
+        const char* m_name;
+        int64_t     m_start;
+    };
+
+    static FRAME_PROFILER& Get();
+
+    void SetEnabled( bool aEnabled );
+    bool IsEnabled() const { return m_enabled.load( std::memory_order_relaxed ); }
+
+    /**
+     * Start and finish a frame.  Stages recorded outside of a frame are dropped.
+     */
+    void BeginFrame();
+    void EndFrame();
+
+    void AddEvent( const char* aName, int64_t aStart, int64_t aDuration );
+
+    /**
+     * @return the total time in milliseconds spent by each stage in the last finished frame,
+     *         in the order the stages first appeared, preceded by the whole frame time.
+     */
+    std::vector<std::pair<std::string, double>> GetLastFrameSummary() const;
+
+    /**
+     * Write the kept frames in the Chrome trace event JSON format.
+     *
+     * @return false if the file could not be written.
+     */
+    bool ExportChromeTrace( const wxString& aFilename ) const;
+
+    static constexpr size_t MAX_FRAMES = 600;
+
+private:
+    FRAME_PROFILER();
+
+    std::atomic<bool>  m_enabled;
+    mutable std::mutex m_mutex;
+    bool               m_inFrame;
+    FRAME              m_current;
+    std::deque<FRAME>  m_frames;
+};
+
+} // namespace KIGFX
+
+#endif // FRAME_PROFILER_H
@@ -97,9 +97,14 @@ public:
     virtual unsigned int AllItemsSize() const { return 0; }
 
 protected:
-    ///< Maps size of free memory chunks to their offsets
+    ///< Size and offset of a memory chunk
     typedef std::pair<unsigned int, unsigned int> CHUNK;
-    typedef std::multimap<unsigned int, unsigned int> FREE_CHUNK_MAP;
+
+    ///< Free memory chunks ordered by size, then offset, for best fit lookups
+    typedef std::set<CHUNK> FREE_CHUNK_MAP;
+
+    ///< Maps offsets of free memory chunks to their sizes, for merging neighbouring chunks
+    typedef std::map<unsigned int, unsigned int> FREE_CHUNK_OFFSETS;
 
     /// List of all the stored items
     typedef std::set<VERTEX_ITEM*> ITEMS;
@@ -114,6 +119,15 @@ protected:
      */
     bool reallocate( unsigned int aSize );
 
+    /**
+     * Extend the chunk of the current item over the free chunk that directly follows it,
+     * if that gives at least the requested size.  Nothing has to be copied in that case.
+     *
+     * @param aSize is the requested chunk size.
+     * @return true if the chunk was extended.
+     */
+    bool growChunk( unsigned int aSize );
+
     /**
      * Remove empty spaces between chunks and optionally resizes the container.
      *
@@ -125,6 +139,17 @@ protected:
      */
     virtual bool defragmentResize( unsigned int aNewSize ) = 0;
 
+    /**
+     * Grow the container, leaving all the stored items where they are.
+     *
+     * This is a single block copy of the buffer, so it is much cheaper than
+     * defragmentResize().  The added space becomes a free chunk at the end of the container.
+     *
+     * @param aNewSize is the new size of container, expressed in number of vertices.
+     * @return false in case of failure (e.g. memory shortage).
+     */
+    virtual bool resize( unsigned int aNewSize ) = 0;
+
     /**
      * Transfer all stored data to a new buffer, removing empty spaces between the data chunks
      * in the container.
@@ -133,12 +158,6 @@ protected:
      */
     void defragment( VERTEX* aTarget );
 
-    /**
-     * Look for consecutive free memory chunks and merges them, decreasing fragmentation of
-     * memory.
-     */
-    void mergeFreeChunks();
-
     /**
      * Return the size of a chunk.
      *
@@ -160,13 +179,27 @@ protected:
     }
 
     /**
-     * Add a chunk marked as a free space.
+     * Add a chunk marked as a free space, merging it with the free chunks directly before
+     * and after it.
      */
     void addFreeChunk( unsigned int aOffset, unsigned int aSize );
 
+    /**
+     * Remove a chunk from the free space pool (without changing the free space counter).
+     */
+    void removeFreeChunk( FREE_CHUNK_MAP::iterator aChunk );
+
+    /**
+     * Replace the free space pool with a single chunk.
+     */
+    void resetFreeChunks( unsigned int aOffset, unsigned int aSize );
+
     ///< Store size & offset of free chunks.
     FREE_CHUNK_MAP  m_freeChunks;
 
+    ///< Store offset & size of free chunks.
+    FREE_CHUNK_OFFSETS m_freeChunkOffsets;
+
     ///< Stored VERTEX_ITEMs
     ITEMS m_items;
 
@@ -73,6 +73,9 @@ protected:
     bool defragmentResize( unsigned int aNewSize ) override;
     bool defragmentResizeMemcpy( unsigned int aNewSize );
 
+    ///< @copydoc CACHED_CONTAINER::resize()
+    bool resize( unsigned int aNewSize ) override;
+
     ///< Flag saying if vertex buffer is currently mapped
     bool m_isMapped;
 
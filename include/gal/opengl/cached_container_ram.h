@@ -78,6 +78,9 @@ protected:
      */
     bool defragmentResize( unsigned int aNewSize ) override;
 
+    ///< @copydoc CACHED_CONTAINER::resize()
+    bool resize( unsigned int aNewSize ) override;
+
     ///< Handle to vertices buffer
     GLuint  m_verticesBuffer;
 };
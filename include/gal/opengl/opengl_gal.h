@@ -40,6 +40,7 @@
 #include <gal/opengl/noncached_container.h>
 #include <gal/opengl/opengl_compositor.h>
 #include <gal/hidpi_gl_canvas.h>
+#include <memory_usage.h>
 
 #include <unordered_map>
 #include <memory>
@@ -379,6 +380,8 @@ private:
     bool                    m_isGrouping;               ///< Was a group started?
     bool                    m_isContextLocked;          ///< Used for assertion checking
     int                     m_lockClientCookie;
+
+    std::unique_ptr<MEMORY_USAGE_PROVIDER> m_memoryUsage;
     GLint                   ufm_worldPixelSize;
     GLint                   ufm_screenPixelSize;
     GLint                   ufm_pixelSizeMultiplier;
@@ -308,6 +308,11 @@ public:
      */
     VERTEX* GetVertices( const VERTEX_ITEM& aItem ) const;
 
+    /**
+     * @return the number of bytes reserved by the vertex container.
+     */
+    size_t GetMemorySize() const;
+
     const glm::mat4& GetTransformation() const
     {
         return m_transform;
@@ -96,6 +96,18 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Build the lazily computed geometry (effective shapes, triangulations, etc.) that Draw()
+     * will need for an item, without touching the GAL.
+     *
+     * The VIEW calls this from the thread pool ahead of a mass recache so that the serial
+     * Draw() pass only has to emit vertices.  Implementations must be safe to call
+     * concurrently for distinct items.
+     *
+     * @param aItem is an item that is about to be drawn on all of its layers.
+     */
+    virtual void PrepareDraw( const VIEW_ITEM* aItem ) {}
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
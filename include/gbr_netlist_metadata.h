@@ -125,6 +125,12 @@ public:
 
     bool IsEmpty() const { return m_field.IsEmpty(); }
 
+    bool operator==( const GBR_DATA_FIELD& aOther ) const
+    {
+        return m_field == aOther.m_field && m_useUTF8 == aOther.m_useUTF8
+               && m_escapeString == aOther.m_escapeString;
+    }
+
     std::string GetGerberString() const;
 
 private:
@@ -234,6 +240,15 @@ public:
         }
     }
 
+    bool operator==( const GBR_NETLIST_METADATA& aOther ) const
+    {
+        return m_NetAttribType == aOther.m_NetAttribType && m_NotInNet == aOther.m_NotInNet
+               && m_Padname == aOther.m_Padname && m_PadPinFunction == aOther.m_PadPinFunction
+               && m_Cmpref == aOther.m_Cmpref && m_Netname == aOther.m_Netname
+               && m_ExtraData == aOther.m_ExtraData
+               && m_TryKeepPreviousAttributes == aOther.m_TryKeepPreviousAttributes;
+    }
+
     // these members are used in the %TO object attributes command.
     int      m_NetAttribType;   ///< the type of net info
                                 ///< (used to define the gerber string to create)
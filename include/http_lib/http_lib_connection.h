@@ -57,6 +57,17 @@ public:
      */
     bool SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts );
 
+    /**
+     * Retrieve all parts from several categories, requesting the categories concurrently.
+     *
+     * @param aCategories are the categories to fetch parts from
+     * @param aParts will be filled with the parts of each category that could be fetched, by
+     *               category id
+     * @return true if all the categories were fetched, false otherwise
+     */
+    bool SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                    std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts );
+
     std::string GetLastError() const { return m_lastError; }
 
     std::vector<HTTP_LIB_CATEGORY> getCategories() const { return m_categories; }
@@ -91,7 +102,23 @@ private:
 
     bool syncCategories();
 
-    bool checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl );
+    /**
+     * Send a GET request to \a aUrl.
+     *
+     * Responses carrying an ETag or a Last-Modified date are stored in the user cache folder
+     * and revalidated by the next request, possibly in a later session, so an unchanged
+     * response is not downloaded again.
+     *
+     * Doesn't modify the connection, so it can be called from several threads.
+     *
+     * @param aResponse will contain the body of the response
+     * @param aError will contain the reason of the failure, if any
+     * @return true if aResponse was filled
+     */
+    bool fetch( const std::string& aUrl, std::string& aResponse, wxString& aError );
+
+    /// @return the file storing the last response to \a aUrl
+    wxString responseCacheFile( const std::string& aUrl ) const;
 
     /**
      * HTTP response status codes indicate whether a specific HTTP request has been
@@ -106,7 +133,7 @@ private:
      *
      *    see: https://developer.mozilla.org/en-US/docs/Web/HTTP/Status
      */
-    wxString httpErrorCodeDescription( uint16_t aHttpCode );
+    static wxString httpErrorCodeDescription( uint16_t aHttpCode );
 
 private:
     HTTP_LIB_SOURCE m_source;
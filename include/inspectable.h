@@ -164,4 +164,60 @@ public:
     }
 };
 
+
+/**
+ * A property read from objects of one concrete class, with the class lookups INSPECTABLE::Get()
+ * does on every call resolved once.  Meant for code reading the same property of many objects,
+ * such as compiled rule expressions.
+ *
+ * Objects passed in must be of the class the accessor was made for.
+ */
+class PROPERTY_ACCESSOR
+{
+public:
+    PROPERTY_ACCESSOR( TYPE_ID aType, PROPERTY_BASE* aProperty ) :
+            m_property( aProperty ),
+            m_cast( nullptr ),
+            m_valid( false )
+    {
+        if( aProperty )
+        {
+            m_cast = PROPERTY_MANAGER::Instance().ResolveTypeCast( aType, aProperty->OwnerHash(),
+                                                                   m_valid );
+        }
+    }
+
+    PROPERTY_BASE* Property() const { return m_property; }
+
+    bool IsValid() const { return m_valid; }
+
+    wxAny Get( const INSPECTABLE* aObject ) const
+    {
+        return m_valid ? m_property->getter( object( aObject ) ) : wxAny();
+    }
+
+    /// @see PROPERTY_BASE::GetNumeric()
+    bool GetNumeric( const INSPECTABLE* aObject, std::optional<double>& aValue ) const
+    {
+        return m_valid && m_property->GetNumeric( object( aObject ), aValue );
+    }
+
+    /// @see PROPERTY_BASE::GetString()
+    bool GetString( const INSPECTABLE* aObject, wxString& aValue ) const
+    {
+        return m_valid && m_property->GetString( object( aObject ), aValue );
+    }
+
+private:
+    const void* object( const INSPECTABLE* aObject ) const
+    {
+        return m_cast ? ( *m_cast )( static_cast<const void*>( aObject ) )
+                      : static_cast<const void*>( aObject );
+    }
+
+    PROPERTY_BASE*        m_property;
+    const TYPE_CAST_BASE* m_cast;
+    bool                  m_valid;
+};
+
 #endif /* INSPECTABLE_H */
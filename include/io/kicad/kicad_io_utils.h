@@ -93,4 +93,22 @@ enum class KICOMMON_API FORMAT_MODE
  */
 KICOMMON_API void Prettify( std::string& aSource, FORMAT_MODE aMode = FORMAT_MODE::NORMAL );
 
+/**
+ * The part of a file passed to PrettifyPart()
+ */
+enum class KICOMMON_API PRETTIFY_PART
+{
+    BEGIN,      ///< The start of the file up to a complete list inside its outer list
+    ITEMS,      ///< Complete lists inside the outer list of the file
+    END         ///< Complete lists inside the outer list, followed by its closing parenthesis
+};
+
+/**
+ * Pretty-prints one part of s-expression text, so that the parts of a file can be prettified
+ * separately (e.g. concurrently) and concatenated.  The concatenation of a BEGIN part, any number
+ * of ITEMS parts and an END part is the same as Prettify() of the whole text.
+ */
+KICOMMON_API void PrettifyPart( std::string& aSource, PRETTIFY_PART aPart,
+                                FORMAT_MODE aMode = FORMAT_MODE::NORMAL );
+
 } // namespace KICAD_FORMAT
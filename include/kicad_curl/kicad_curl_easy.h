@@ -35,6 +35,7 @@
 
 #include <kicommon.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -153,6 +154,14 @@ public:
 
     int GetResponseStatusCode();
 
+    /**
+     * Return a header of the last response, e.g. "ETag".
+     *
+     * @param aName is the header name, matched without regard to case.
+     * @return the header value, or an empty string if the response didn't have it.
+     */
+    std::string GetResponseHeader( const std::string& aName ) const;
+
 private:
     /**
      * Set a curl option, only supports single parameter curl options.
@@ -167,6 +176,7 @@ private:
     CURL*                               m_CURL;
     curl_slist*                         m_headers;
     std::string                         m_buffer;
+    std::map<std::string, std::string>  m_responseHeaders;    ///< By lowercase name
     std::unique_ptr<CURL_PROGRESS>      progress;
     std::shared_lock<std::shared_mutex> m_curlSharedLock;
 };
@@ -31,6 +31,8 @@
 #include <macros_swig.h>
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 class wxString;
@@ -57,7 +59,30 @@ public:
 
     void Clone( const KIID& aUUID );
 
-    size_t Hash() const;
+    /**
+     * Hash of the 128 bits of the UUID.  Inline because it is on the path of every lookup in
+     * the item-by-id caches.
+     */
+    size_t Hash() const
+    {
+        uint64_t hi;
+        uint64_t lo;
+
+        std::memcpy( &hi, m_uuid.begin(), sizeof( hi ) );
+        std::memcpy( &lo, m_uuid.begin() + sizeof( hi ), sizeof( lo ) );
+
+        // Random UUIDs would hash fine with a plain fold, but legacy timestamps and
+        // Increment()ed ids only differ in a few bytes, so finish with a 64-bit mix.
+        uint64_t h = ( hi * 0x9E3779B97F4A7C15ULL ) ^ lo;
+
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+
+        return static_cast<size_t>( h );
+    }
 
     bool        IsLegacyTimestamp() const;
     timestamp_t AsLegacyTimestamp() const;
@@ -160,14 +185,29 @@ public:
 
     wxString AsString() const;
 
+    /**
+     * Combined hash of the steps of the path.  Paths are plain vectors and can be edited in
+     * place, so the hash is not cached; it costs a few multiplies per step.
+     */
+    size_t Hash() const
+    {
+        size_t h = size();
+
+        for( const KIID& step : *this )
+            h = ( h ^ step.Hash() ) * 0x100000001B3ULL;
+
+        return h;
+    }
+
     bool operator==( KIID_PATH const& rhs ) const
     {
         if( size() != rhs.size() )
             return false;
 
-        for( size_t i = 0; i < size(); ++i )
+        // Paths sharing a prefix (e.g. all the instances on one sheet) differ in the last steps
+        for( size_t i = size(); i > 0; --i )
         {
-            if( at( i ) != rhs.at( i ) )
+            if( (*this)[i - 1] != rhs[i - 1] )
                 return false;
         }
 
@@ -252,4 +292,12 @@ template<> struct KICOMMON_API std::hash<KIID>
     }
 };
 
+template<> struct KICOMMON_API std::hash<KIID_PATH>
+{
+    std::size_t operator()( const KIID_PATH& aPath ) const
+    {
+        return aPath.Hash();
+    }
+};
+
 #endif // KIID_H
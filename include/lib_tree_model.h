@@ -131,6 +131,7 @@ public:
     int         m_IntrinsicRank;
 
     int         m_Score;       // The score of an item resulting from the search algorithm.
+    bool        m_MatchFailed; // A matcher rejected the item for the last search string
     bool        m_Pinned;      // Item should appear at top when there is no search string
 
     wxString    m_Name;        // Actual name of the part
@@ -298,8 +299,17 @@ public:
      */
     void Clear();
 
+    /**
+     * Score the libraries in parallel, then apply \a aFilter on the UI thread.
+     *
+     * When the search terms extend the ones of the previous call (the user is typing), the
+     * items rejected then are rejected again without running the matchers.
+     */
     void UpdateScore( const std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>>& aMatchers,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
+
+private:
+    std::vector<wxString> m_lastPatterns;   // Search terms of the last UpdateScore() call
 };
 
 
@@ -336,7 +336,6 @@ public:
             m_stack(),
             m_stackPtr( 0 )
     {
-        m_ownedValues.reserve( 20 );
     }
 
     virtual ~CONTEXT()
@@ -352,12 +351,14 @@ public:
 
     VALUE* AllocValue()
     {
+        reserveOwnedValues();
         m_ownedValues.emplace_back( new VALUE );
         return m_ownedValues.back();
     }
 
     VALUE* StoreValue( VALUE* aValue )
     {
+        reserveOwnedValues();
         m_ownedValues.emplace_back( aValue );
         return m_ownedValues.back();
     }
@@ -392,6 +393,15 @@ public:
 
     void ReportError( const wxString& aErrorMsg );
 
+private:
+    // Reserved on first use only so that contexts evaluating lowered (closure) ucode, which
+    // never allocate values, don't allocate at all.
+    void reserveOwnedValues()
+    {
+        if( m_ownedValues.capacity() == 0 )
+            m_ownedValues.reserve( 20 );
+    }
+
 private:
     std::vector<VALUE*> m_ownedValues;
     VALUE*              m_stack[100];       // std::stack not performant enough
@@ -422,6 +432,29 @@ public:
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
 
+    /**
+     * A lowered expression: evaluates straight to the numeric result of Run(), without going
+     * through the value stack.
+     */
+    typedef std::function<double( CONTEXT* )> CLOSURE;
+
+    /**
+     * Lower the ucode to a tree of pre-bound closures, folding constant sub-expressions and
+     * specializing property accesses through lowerComparison() and lowerNumericRef().
+     *
+     * @return true if the whole expression could be lowered.  If not, RunAsDouble() keeps
+     *         interpreting the ucode.
+     */
+    bool Optimize();
+
+    bool IsOptimized() const { return m_closure != nullptr; }
+
+    /**
+     * Evaluate the expression as a number, using the lowered closures when there are some.
+     * Contexts with an error callback are always interpreted so that errors get reported.
+     */
+    double RunAsDouble( CONTEXT* ctx );
+
     virtual std::unique_ptr<VAR_REF> CreateVarRef( const wxString& var, const wxString& field )
     {
         return nullptr;
@@ -432,8 +465,34 @@ public:
         return nullptr;
     }
 
+protected:
+    /**
+     * Lower "aRef == aConstant" or "aRef != aConstant" (as given by \a aOp).
+     *
+     * @return a closure giving exactly the result of the interpreted comparison, or nullptr if
+     *         the comparison can't be specialized.
+     */
+    virtual CLOSURE lowerComparison( int aOp, VAR_REF* aRef, const VALUE* aConstant )
+    {
+        return nullptr;
+    }
+
+    /**
+     * Lower a reference used as a number (in arithmetic, relational or boolean operations).
+     *
+     * @return a closure giving GetValue()->AsDouble(), or nullptr if the reference can't be
+     *         specialized.
+     */
+    virtual CLOSURE lowerNumericRef( VAR_REF* aRef )
+    {
+        return nullptr;
+    }
+
 protected:
     std::vector<UOP*> m_ucode;
+
+    CLOSURE                             m_closure;
+    std::vector<std::unique_ptr<VALUE>> m_foldedValues;
 };
 
 
@@ -465,12 +524,22 @@ public:
 
     wxString Format() const;
 
+    int GetOp() const                    { return m_op; }
+    const FUNC_CALL_REF& GetFunc() const { return m_func; }
+    VAR_REF* GetRef() const              { return m_ref.get(); }
+    VALUE* GetValue() const              { return m_value.get(); }
+
+    /// Number of parameters pushed for a method call.
+    void SetArgCount( int aCount )       { m_argCount = aCount; }
+    int GetArgCount() const              { return m_argCount; }
+
 private:
     int                      m_op;
 
     FUNC_CALL_REF            m_func;
     std::unique_ptr<VAR_REF> m_ref;
     std::unique_ptr<VALUE>   m_value;
+    int                      m_argCount = 0;
 };
 
 class KICOMMON_API TOKENIZER
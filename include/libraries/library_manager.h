@@ -23,6 +23,7 @@
 
 #include <future>
 #include <memory>
+#include <set>
 
 #include <kicommon.h>
 #include <libraries/library_table.h>
@@ -30,6 +31,7 @@
 
 
 class LIBRARY_MANAGER;
+class LIBRARY_METADATA_CACHE;
 class PROJECT;
 
 
@@ -133,6 +135,23 @@ public:
     /// Loads all available libraries for this adapter type in the background
     virtual void AsyncLoad() = 0;
 
+    /**
+     * Set the libraries the next AsyncLoad() queues first, e.g. the ones the open project uses,
+     * so they are ready before the rest of the tables.  Call before AsyncLoad().
+     */
+    void SetPreferredLibraries( const std::set<wxString>& aNicknames );
+
+    /**
+     * Collect the library nicknames of the LIB_IDs quoted right after one of \a aTokens in the
+     * files of \a aProjectPath (and its subfolders) matching \a aFileSpec.
+     *
+     * This is a plain text scan, good enough to order the library preload without parsing the
+     * project, e.g. ReferencedLibraries( path, "*.kicad_sch", { "(lib_id \"" } ).
+     */
+    static std::set<wxString> ReferencedLibraries( const wxString& aProjectPath,
+                                                   const wxString& aFileSpec,
+                                                   const std::vector<std::string>& aTokens );
+
     virtual std::optional<LIB_STATUS> LoadOne( LIB_DATA* aLib ) = 0;
 
     /// Returns async load progress between 0.0 and 1.0, or nullopt if load is not in progress
@@ -188,6 +207,9 @@ protected:
     /// Aborts any async load in progress; blocks until fully done aborting
     void abortLoad();
 
+    /// Move the preferred libraries to the front of \a aRows, keeping the table order otherwise
+    void sortRowsForLoad( std::vector<LIBRARY_TABLE_ROW*>& aRows ) const;
+
     /// Creates a concrete plugin for the given row
     virtual LIBRARY_RESULT<IO_BASE*> createPlugin( const LIBRARY_TABLE_ROW* row ) = 0;
 
@@ -208,6 +230,8 @@ protected:
 
     std::atomic<size_t> m_loadCount;
     size_t              m_loadTotal;
+
+    std::set<wxString>  m_preferredLibraries;
 };
 
 
@@ -310,6 +334,12 @@ public:
 
     static bool UrisAreEquivalent( const wxString& aURI1, const wxString& aURI2 );
 
+    /**
+     * @return the session independent cache of library item names and metadata, created on
+     *         first use.
+     */
+    LIBRARY_METADATA_CACHE& MetadataCache();
+
 private:
     void loadTables( const wxString& aTablePath, LIBRARY_TABLE_SCOPE aScope,
                      std::vector<LIBRARY_TABLE_TYPE> aTablesToLoad = {} );
@@ -331,6 +361,9 @@ private:
     std::map<LIBRARY_TABLE_TYPE, std::unique_ptr<LIBRARY_MANAGER_ADAPTER>> m_adapters;
 
     mutable std::mutex m_adaptersMutex;
+
+    std::unique_ptr<LIBRARY_METADATA_CACHE> m_metadataCache;
+    std::mutex                              m_metadataCacheMutex;
 };
 
 #endif //LIBRARY_MANAGER_H
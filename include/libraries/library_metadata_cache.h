@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBRARY_METADATA_CACHE_H
+#define LIBRARY_METADATA_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <kicommon.h>
+#include <libraries/library_table.h>
+#include <wx/string.h>
+
+namespace KIPLATFORM
+{
+    namespace IO
+    {
+        class MAPPED_FILE;
+    }
+}
+
+
+/**
+ * A project independent store of the names, descriptions, keywords and pin or pad counts of
+ * the items of symbol and footprint libraries.
+ *
+ * Libraries are keyed on their type and full path, and an entry is only returned while the
+ * library still has the stamp (modification time and size) it was stored with.  The file is
+ * an index of libraries followed by their item records; it is mapped when first used and an
+ * item record is only decoded when its library is asked for.
+ */
+class KICOMMON_API LIBRARY_METADATA_CACHE
+{
+public:
+    struct ITEM
+    {
+        wxString m_name;
+        wxString m_description;
+        wxString m_keywords;
+        unsigned m_count = 0;          ///< Pins of a symbol or pads of a footprint
+        unsigned m_uniqueCount = 0;    ///< Pads with a distinct number; unused for symbols
+    };
+
+    LIBRARY_METADATA_CACHE( const wxString& aFileName );
+    ~LIBRARY_METADATA_CACHE();
+
+    /// @return the cache file in the user cache directory.
+    static wxString DefaultFileName();
+
+    /**
+     * @return the stamp of a library file or directory, or 0 if the library has no file
+     *         backing and can't be cached.
+     */
+    static long long LibraryStamp( const wxString& aPath );
+
+    /**
+     * Fetch the items of a library.
+     *
+     * @return false if the library isn't cached or was stored with a different stamp.
+     */
+    bool GetItems( LIBRARY_TABLE_TYPE aType, const wxString& aPath, long long aStamp,
+                   std::vector<ITEM>& aItems );
+
+    void SetItems( LIBRARY_TABLE_TYPE aType, const wxString& aPath, long long aStamp,
+                   std::vector<ITEM> aItems );
+
+    /**
+     * Write the cache file if a library was stored since it was read.
+     *
+     * @return false if the file could not be written.
+     */
+    bool Save();
+
+private:
+    struct LIBRARY
+    {
+        long long m_stamp = 0;
+        uint32_t  m_itemCount = 0;
+        size_t    m_offset = 0;     ///< Item records in the mapped file, if not set in memory
+        size_t    m_size = 0;
+
+        std::optional<std::vector<ITEM>> m_items;
+    };
+
+    using KEY = std::pair<LIBRARY_TABLE_TYPE, wxString>;
+
+    void open();
+
+    bool decode( const LIBRARY& aLibrary, std::vector<ITEM>& aItems ) const;
+
+    static void encode( std::string& aBuffer, const std::vector<ITEM>& aItems );
+
+private:
+    wxString                                     m_fileName;
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> m_file;
+    std::map<KEY, LIBRARY>                       m_libraries;
+    bool                                         m_opened;
+    bool                                         m_modified;
+    std::mutex                                   m_mutex;
+};
+
+#endif // LIBRARY_METADATA_CACHE_H
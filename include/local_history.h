@@ -28,6 +28,7 @@
 #include <set>
 #include <map>
 #include <functional>
+#include <future>
 #include <wx/string.h>
 #include <wx/window.h>
 
@@ -69,7 +70,10 @@ public:
     /** Clear all registered savers. */
     void ClearAllSavers();
 
-    /** Run all registered savers and, if any staged changes differ from HEAD, create a commit. */
+    /** Run all registered savers and, if any staged changes differ from HEAD, create a commit.
+     *  The savers run on the calling thread; staging and committing their files runs on a
+     *  worker thread, which any later history operation waits for.
+     *  @return true if the commit was started. */
     bool RunRegisteredSaversAndCommit( const wxString& aProjectPath, const wxString& aTitle );
 
     /** Record that a file has been modified and should be included in the next snapshot. */
@@ -105,8 +109,15 @@ public:
     /** Show a dialog allowing the user to choose a snapshot to restore. */
     void ShowRestoreDialog( const wxString& aProjectPath, wxWindow* aParent );
 
+private:
+    /** Wait for the autosave commit started by RunRegisteredSaversAndCommit(), if any.
+     *  @return false if that commit failed or found nothing to commit. */
+    bool waitForPendingCommit();
+
 private:
     std::set<wxString> m_pendingFiles;
     std::map<const void*, std::function<void(const wxString&, std::vector<wxString>&)>> m_savers;
+    std::future<bool>  m_pendingCommit;
+    int                m_commitsSincePack = 0;
 };
 
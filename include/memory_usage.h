@@ -0,0 +1,92 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <kicommon.h>
+#include <wx/string.h>
+
+
+/**
+ * Registry of the subsystems able to estimate how much memory they hold.
+ *
+ * A subsystem registers a provider returning its current estimate in bytes.  Nothing is
+ * tracked while the application runs: the providers are only called when a report is asked
+ * for, e.g. for the version information when the "ShowMemoryUsage" advanced setting is on.
+ *
+ * Providers are called from the UI thread and must not take long.
+ */
+class KICOMMON_API MEMORY_USAGE
+{
+public:
+    using PROVIDER = std::function<size_t()>;
+
+    /**
+     * Add a provider for \a aSubsystem.  Several providers may share a subsystem name (e.g. one
+     * per open editor); their estimates are added up.
+     *
+     * @return an id to pass to Unregister() before the provider becomes invalid.
+     */
+    static int Register( const wxString& aSubsystem, PROVIDER aProvider );
+
+    static void Unregister( int aId );
+
+    /**
+     * @return the estimate of each subsystem, in the order they were first registered.
+     */
+    static std::vector<std::pair<wxString, size_t>> Collect();
+
+    /**
+     * Format the estimates, one subsystem per line.
+     */
+    static wxString Report( const wxString& aIndent, const wxString& aEol );
+};
+
+
+/**
+ * Registers a memory usage provider for the lifetime of the object.
+ */
+class KICOMMON_API MEMORY_USAGE_PROVIDER
+{
+public:
+    MEMORY_USAGE_PROVIDER( const wxString& aSubsystem, MEMORY_USAGE::PROVIDER aProvider ) :
+            m_id( MEMORY_USAGE::Register( aSubsystem, std::move( aProvider ) ) )
+    {
+    }
+
+    ~MEMORY_USAGE_PROVIDER() { MEMORY_USAGE::Unregister( m_id ); }
+
+    MEMORY_USAGE_PROVIDER( const MEMORY_USAGE_PROVIDER& ) = delete;
+    MEMORY_USAGE_PROVIDER& operator=( const MEMORY_USAGE_PROVIDER& ) = delete;
+
+private:
+    int m_id;
+};
+
+#endif // MEMORY_USAGE_H
@@ -0,0 +1,162 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OLLAMA_CLIENT_H
+#define OLLAMA_CLIENT_H
+
+#include <functional>
+#include <wx/string.h>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class KICAD_CURL_EASY;
+struct OLLAMA_CURL_SHARE;
+
+/**
+ * Client for communicating with the Python agent that wraps Ollama.
+ * Uses KICAD_CURL_EASY for HTTP requests.
+ * The Python agent then communicates with Ollama.
+ *
+ * The curl handles are kept for the lifetime of the client and share one connection, DNS and
+ * TLS session cache, so consecutive requests reuse the same keep-alive connection instead of
+ * paying for a new TCP (and TLS) handshake every turn.
+ *
+ * Every completion asks the server to keep the model loaded (see SetKeepAlive()), so that a
+ * follow-up turn whose prompt starts like the previous one only evaluates the new tail: put
+ * the parts of a prompt that change least first.
+ */
+class OLLAMA_CLIENT
+{
+public:
+    OLLAMA_CLIENT( const wxString& aBaseUrl = wxS( "http://127.0.0.1:5001" ) );
+    ~OLLAMA_CLIENT();
+
+    /**
+     * Send a chat completion request to Ollama
+     * @param aModel Model name (e.g., "llama2", "mistral")
+     * @param aPrompt User prompt
+     * @param aResponse Output response text
+     * @return true if successful
+     */
+    bool ChatCompletion( const wxString& aModel, const wxString& aPrompt, wxString& aResponse,
+                         const wxString& aSystemPrompt = wxString() );
+
+    /**
+     * Timings and token counts of a streamed completion.  Token counts are taken from the
+     * final message of the stream and are -1 if the server did not report them.
+     */
+    struct STREAM_STATS
+    {
+        double    firstChunkMsecs = 0.0;    ///< Request start until the first text arrived
+        double    totalMsecs = 0.0;
+        size_t    chunks = 0;
+        long long promptTokens = -1;
+        long long responseTokens = -1;
+        double    evalSecs = 0.0;           ///< Server side generation time, if reported
+    };
+
+    using StreamCallback = std::function<void( const wxString& )>;
+    bool StreamChatCompletion( const wxString& aModel, const wxString& aPrompt,
+                               StreamCallback aChunkCallback, wxString& aResponse,
+                               const std::atomic<bool>* aCancelFlag = nullptr,
+                               const wxString& aSystemPrompt = wxString(),
+                               STREAM_STATS* aStats = nullptr );
+
+    /**
+     * Compute an embedding vector for each of \a aInputs with the Ollama /api/embed endpoint.
+     *
+     * Uses its own handle, so it may run on a worker thread while a chat request is pending.
+     *
+     * @return true if one vector per input was received.
+     */
+    bool Embed( const wxString& aModel, const std::vector<wxString>& aInputs,
+                std::vector<std::vector<float>>& aEmbeddings );
+
+    /**
+     * Check if Ollama server is available
+     * @return true if server is reachable
+     */
+    bool IsAvailable();
+
+    /**
+     * Set how long the server keeps the model loaded after a request, as an Ollama duration
+     * ("30m", "1h", or "-1" for ever).  An empty string leaves the server default.
+     */
+    void SetKeepAlive( const wxString& aKeepAlive ) { m_keepAlive = aKeepAlive; }
+
+    /**
+     * Look up a response stored by RememberResponse() for the same model, prompt and system
+     * prompt.  Thread safe.
+     */
+    bool FindCachedResponse( const wxString& aModel, const wxString& aPrompt,
+                             const wxString& aSystemPrompt, wxString& aResponse );
+
+    /**
+     * Store \a aResponse for reuse by FindCachedResponse().  Only the caller knows whether
+     * replaying a response is safe, so nothing is cached unless this is called; the oldest of
+     * #RESPONSE_CACHE_SIZE entries is dropped first.  Thread safe.
+     */
+    void RememberResponse( const wxString& aModel, const wxString& aPrompt,
+                           const wxString& aSystemPrompt, const wxString& aResponse );
+
+    void ClearResponseCache();
+
+    static constexpr size_t RESPONSE_CACHE_SIZE = 32;
+
+    /**
+     * Set the base URL for Ollama API
+     */
+    void SetBaseUrl( const wxString& aBaseUrl ) { m_baseUrl = aBaseUrl; }
+
+    /**
+     * Get the base URL
+     */
+    wxString GetBaseUrl() const { return m_baseUrl; }
+
+private:
+    /// Create a handle attached to the shared connection cache.
+    std::unique_ptr<KICAD_CURL_EASY> createHandle();
+
+    static size_t responseKey( const wxString& aModel, const wxString& aPrompt,
+                               const wxString& aSystemPrompt );
+
+private:
+    wxString m_baseUrl;
+    wxString m_keepAlive;
+
+    // Must outlive every handle attached to it
+    std::unique_ptr<OLLAMA_CURL_SHARE> m_share;
+
+    std::unique_ptr<KICAD_CURL_EASY> m_curl;
+    std::unique_ptr<KICAD_CURL_EASY> m_streamCurl;
+    std::mutex                       m_streamMutex;    ///< Guards m_streamCurl
+
+    using RESPONSE_LIST = std::list<std::pair<size_t, wxString>>;
+
+    RESPONSE_LIST                                        m_responses;   ///< Most recent first
+    std::unordered_map<size_t, RESPONSE_LIST::iterator> m_responseIndex;
+    std::mutex                                           m_responseMutex;
+};
+
+#endif // OLLAMA_CLIENT_H
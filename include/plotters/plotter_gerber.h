@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include "plotter.h"
 #include "gbr_plotter_apertures.h"
 
@@ -30,6 +34,7 @@ class GERBER_PLOTTER : public PLOTTER
 {
 public:
     GERBER_PLOTTER();
+    ~GERBER_PLOTTER();
 
     virtual PLOT_FORMAT GetPlotterType() const override
     {
@@ -370,6 +375,19 @@ protected:
 
     std::vector<APERTURE> m_apertures;  // The list of available apertures
     int     m_currentApertureIdx;       // The index of the current aperture in m_apertures
+
+    // Apertures by type, size, radius, rotation (in degrees) and attributes, so an existing
+    // aperture is found without scanning the whole list
+    std::map<std::tuple<int, int, int, int, double, int, std::string>, int> m_apertureIndex;
+
+    // Polygonal apertures by type, corner count, rotation (in degrees) and attributes.  Their
+    // corners are compared with a tolerance, so each key holds all the candidates in list order.
+    std::map<std::tuple<int, size_t, double, int, std::string>, std::vector<int>> m_polyApertureIndex;
+
+    // Output buffers for the work and final files, which can be several hundred MB for plane
+    // layers
+    std::vector<char> m_workFileBuffer;
+    std::vector<char> m_finalFileBuffer;
     bool    m_hasApertureRoundRect;     // true is at least one round rect aperture is in use
     bool    m_hasApertureRotOval;       // true is at least one oval rotated aperture is in use
     bool    m_hasApertureRotRect;       // true is at least one rect. rotated aperture is in use
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "plotter.h"
+#include <future>
 #include <memory>
 #include <plotters/pdf_stroke_font.h>
 #include <plotters/pdf_outline_font.h>
@@ -552,6 +553,32 @@ protected:
      */
     void closePdfStream();
 
+    /**
+     * Finish the current page content stream.  It is compressed on the thread pool and its
+     * object is written later by flushPageStreams(), so plotting the next page doesn't wait.
+     */
+    void closePageStream();
+
+    /**
+     * Write the page content streams queued by closePageStream(), in page order.
+     */
+    void flushPageStreams();
+
+    void openWorkFile();
+
+    /**
+     * Close and delete the work file.
+     *
+     * @return the stream accumulated in it.
+     */
+    std::string closeWorkFile();
+
+    /**
+     * @return \a aData compressed for a /FlateDecode stream (or unchanged when debugging the
+     *         PDF writer).
+     */
+    static std::string deflateStream( const std::string& aData );
+
     /**
      * Starts emitting the outline object.
      */
@@ -593,6 +620,9 @@ protected:
     FILE* m_workFile;               ///< Temporary file to construct the stream before zipping.
     std::vector<long> m_xrefTable;  ///< The PDF xref offset table.
 
+    /// Page content streams still being compressed, with their object handles.
+    std::vector<std::pair<int, std::future<std::string>>> m_pendingPageStreams;
+
     /// List of user-space page numbers for resolving internal hyperlinks.
     std::vector<wxString>                                  m_pageNumbers;
 
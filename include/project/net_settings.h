@@ -26,6 +26,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include <netclass.h>
@@ -224,6 +225,9 @@ private:
     /// @brief Adds a single pattern assignment without bus expansion (internal helper)
     void addSinglePatternAssignment( const wxString& pattern, const wxString& netclass );
 
+    /// @brief Rebuilds the pattern index from the pattern assignments, if they have changed
+    void buildPatternIndex();
+
     /// @brief The default netclass
     std::shared_ptr<NETCLASS> m_defaultNetClass;
 
@@ -252,6 +256,23 @@ private:
     /// @brief Cache of nets to pattern-matched netclasses
     std::map<wxString, std::shared_ptr<NETCLASS>> m_effectiveNetclassCache;
 
+    /// @brief Netclasses of the patterns without any regex or wildcard syntax, by net name
+    ///
+    /// These patterns can only match a net of the same name, so they are found with a lookup
+    /// instead of running their matchers against every net.
+    std::unordered_map<wxString, std::vector<wxString>> m_literalPatternIndex;
+
+    /// @brief The remaining pattern assignments, by the literal text a matching net must start with
+    ///
+    /// A net is only run through the matchers filed under one of its own leading substrings, of
+    /// one of the lengths in #m_patternPrefixLengths.
+    std::unordered_map<wxString, std::vector<std::pair<EDA_COMBINED_MATCHER*, wxString>>>
+            m_prefixPatternIndex;
+
+    std::vector<size_t> m_patternPrefixLengths;
+
+    bool m_patternIndexValid;
+
     /**
      * A map of fully-qualified net names to colors used in the board context.
      * Since these color overrides are for the board, buses are not included here.
@@ -44,6 +44,7 @@
 #include <functional>
 #include <unordered_map>
 #include <memory>
+#include <optional>
 #include <typeindex>
 #include <type_traits>
 #include <wx/translation.h>
@@ -362,6 +363,27 @@ public:
         return std::nullopt;
     }
 
+    /**
+     * Read a numeric, boolean or optional numeric property without boxing it in a wxAny.
+     *
+     * @param aObject must already be cast to the property owner (see PROPERTY_ACCESSOR).
+     * @return false if the property is of another type; use get<T>() for those.
+     */
+    virtual bool GetNumeric( const void* aObject, std::optional<double>& aValue ) const
+    {
+        return false;
+    }
+
+    /**
+     * Read a wxString property without boxing it in a wxAny.
+     *
+     * @return false if the property is of another type.
+     */
+    virtual bool GetString( const void* aObject, wxString& aValue ) const
+    {
+        return false;
+    }
+
 protected:
     template<typename T>
     void set( void* aObject, T aValue )
@@ -457,6 +479,7 @@ private:
     PROPERTY_VALIDATOR_FN m_validator;
 
     friend class INSPECTABLE;
+    friend class PROPERTY_ACCESSOR;
 };
 
 
@@ -512,6 +535,46 @@ public:
         return m_setter && PROPERTY_BASE::Writeable( aObject );
     }
 
+    bool GetNumeric( const void* aObject, std::optional<double>& aValue ) const override
+    {
+        const Owner* o = reinterpret_cast<const Owner*>( aObject );
+
+        if constexpr( std::is_arithmetic<BASE_TYPE>::value )
+        {
+            aValue = static_cast<double>( (*m_getter)( o ) );
+            return true;
+        }
+        else if constexpr( std::is_same<BASE_TYPE, std::optional<int>>::value
+                           || std::is_same<BASE_TYPE, std::optional<double>>::value )
+        {
+            BASE_TYPE value = (*m_getter)( o );
+
+            if( value.has_value() )
+                aValue = static_cast<double>( value.value() );
+            else
+                aValue = std::nullopt;
+
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool GetString( const void* aObject, wxString& aValue ) const override
+    {
+        if constexpr( std::is_same<BASE_TYPE, wxString>::value )
+        {
+            aValue = (*m_getter)( reinterpret_cast<const Owner*>( aObject ) );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
 protected:
     PROPERTY( const wxString& aName,
               SETTER_BASE<Owner, T>* s,
@@ -128,6 +128,14 @@ public:
         return const_cast<void*>( TypeCast( (const void*) aSource, aBase, aTarget ) );
     }
 
+    /**
+     * Look up once the conversion TypeCast() applies from \a aBase to \a aTarget.
+     *
+     * @param aValid is set to false if \a aBase cannot be cast to \a aTarget.
+     * @return the converter, or nullptr if pointers are used unchanged.
+     */
+    const TYPE_CAST_BASE* ResolveTypeCast( TYPE_ID aBase, TYPE_ID aTarget, bool& aValid ) const;
+
     /**
      * Register a property.
      * Properties for a given item will be shown in the order they are added.
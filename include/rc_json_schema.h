@@ -22,6 +22,8 @@
 
 #include <json_common.h>
 #include <wx/string.h>
+#include <ostream>
+#include <string>
 #include <vector>
 #include <json_conversions.h>
 
@@ -145,6 +147,134 @@ struct ERC_REPORT : REPORT_BASE
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE( ERC_REPORT, $schema, source, date, kicad_version, sheets,
                                     coordinate_units, included_severities, ignored_checks )
 
+
+/**
+ * Write a report to a stream one value at a time, so that the violations never have to be
+ * held in a single json document.
+ *
+ * The output is the same as streaming the whole document with std::setw( 4 ), provided the
+ * members of each object are written in alphabetical order (the order nlohmann::json keeps
+ * them in).
+ */
+class STREAM_WRITER
+{
+public:
+    /**
+     * Open the top level object.
+     */
+    explicit STREAM_WRITER( std::ostream& aStream ) :
+            m_stream( aStream )
+    {
+        open( '{', '}' );
+    }
+
+    /**
+     * Write a complete member of the current object.
+     */
+    template <class T>
+    void Member( const std::string& aKey, const T& aValue )
+    {
+        key( aKey );
+        value( nlohmann::json( aValue ) );
+    }
+
+    /**
+     * Write a complete element of the current array.
+     */
+    template <class T>
+    void Element( const T& aValue )
+    {
+        next();
+        value( nlohmann::json( aValue ) );
+    }
+
+    /**
+     * Open an array member of the current object; its elements follow until Close().
+     */
+    void BeginArray( const std::string& aKey )
+    {
+        key( aKey );
+        open( '[', ']' );
+    }
+
+    /**
+     * Open an object element of the current array; its members follow until Close().
+     */
+    void BeginObject()
+    {
+        next();
+        open( '{', '}' );
+    }
+
+    /**
+     * Close the innermost array or object.  Closing the top level object ends the document.
+     */
+    void Close()
+    {
+        LEVEL level = m_levels.back();
+        m_levels.pop_back();
+
+        if( !level.empty )
+            m_stream << '\n' << indent();
+
+        m_stream << level.close;
+
+        if( m_levels.empty() )
+            m_stream << std::endl;
+    }
+
+private:
+    struct LEVEL
+    {
+        char close;
+        bool empty;
+    };
+
+    std::string indent() const { return std::string( 4 * m_levels.size(), ' ' ); }
+
+    void next()
+    {
+        if( !m_levels.back().empty )
+            m_stream << ',';
+
+        m_levels.back().empty = false;
+        m_stream << '\n' << indent();
+    }
+
+    void key( const std::string& aKey )
+    {
+        next();
+        m_stream << nlohmann::json( aKey ).dump() << ": ";
+    }
+
+    void open( char aOpen, char aClose )
+    {
+        m_stream << aOpen;
+        m_levels.push_back( { aClose, true } );
+    }
+
+    void value( const nlohmann::json& aValue )
+    {
+        // Line breaks in a dump only come from the formatting; string contents are escaped
+        std::string dump = aValue.dump( 4 );
+        std::string prefix = indent();
+        size_t      start = 0;
+        size_t      eol;
+
+        while( ( eol = dump.find( '\n', start ) ) != std::string::npos )
+        {
+            m_stream.write( dump.data() + start, eol + 1 - start );
+            m_stream << prefix;
+            start = eol + 1;
+        }
+
+        m_stream.write( dump.data() + start, dump.size() - start );
+    }
+
+    std::ostream&      m_stream;
+    std::vector<LEVEL> m_levels;
+};
+
 } // namespace RC_JSON
 
 #endif
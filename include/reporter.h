@@ -27,6 +27,8 @@
 
 #include <memory>
 #include <map>
+#include <utility>
+#include <vector>
 
 #include <eda_units.h>
 #include <widgets/report_severity.h>
@@ -207,6 +209,33 @@ private:
 };
 
 
+/**
+ * A reporter keeping the messages and their severity until they are replayed to another one.
+ *
+ * Gives each task running on the thread pool its own reporter, and keeps the messages of a
+ * task together in the final output.
+ */
+class KICOMMON_API BUFFERED_REPORTER : public REPORTER
+{
+public:
+    BUFFERED_REPORTER() :
+            REPORTER()
+    { }
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override;
+
+    /**
+     * Report the buffered messages to \a aReporter, in the order they were received.
+     */
+    void Replay( REPORTER& aReporter ) const;
+
+    void Clear() override;
+
+private:
+    std::vector<std::pair<wxString, SEVERITY>> m_messages;
+};
+
+
 /**
  * A singleton reporter that reports to nowhere.
  *
@@ -29,6 +29,8 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <memory>
+#include <string_view>
 #include <vector>
 #include <core/utf8.h>
 
@@ -42,6 +44,14 @@
 #include <kicommon.h>
 #include <io/kicad/kicad_io_utils.h>
 
+namespace KIPLATFORM
+{
+namespace IO
+{
+    class MAPPED_FILE;
+}
+}
+
 
 /**
  * Nominally opens a file and reads it into a string.  But unlike other facilities, this handles
@@ -85,6 +95,31 @@ public:
      */
     virtual char* ReadLine() = 0;
 
+    /**
+     * @return true if ReadLineView() hands out lines without copying them, and the returned
+     *         views stay valid for the lifetime of the reader.
+     */
+    virtual bool CanViewLines() const
+    {
+        return false;
+    }
+
+    /**
+     * Read a line of text and increment the line number counter.
+     *
+     * Readers which can view their lines return them in place and leave Line() and Length()
+     * untouched; the others read the line into the buffer and return a view of it, valid
+     * until the next read.  The view is not nul terminated.
+     *
+     * @return The read line, empty at EOF.
+     * @throw IO_ERROR when a line is too long.
+     */
+    virtual std::string_view ReadLineView()
+    {
+        ReadLine();
+        return std::string_view( m_line, m_length );
+    }
+
     /**
      * Returns the name of the source of the lines in an abstract sense.
      *
@@ -219,6 +254,94 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that reads from text kept in memory by its owner, e.g. a part of a
+ * #MAPPED_FILE_LINE_READER.
+ *
+ * ReadLineView() hands out the lines in place; ReadLine() copies them to the line buffer as
+ * for any other #LINE_READER.
+ */
+class KICOMMON_API STRING_VIEW_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * @param aText is the text to read, which must outlive the reader.
+     * @param aSource describes the text for error reporting purposes.
+     * @param aStartingLineNumber is the line number of the line before the first one of
+     *                            @a aText, for texts starting inside a larger one.
+     */
+    STRING_VIEW_LINE_READER( std::string_view aText, const wxString& aSource,
+                             unsigned aStartingLineNumber = 0,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    char* ReadLine() override;
+
+    bool CanViewLines() const override
+    {
+        return true;
+    }
+
+    std::string_view ReadLineView() override;
+
+    /**
+     * Go back to the start of the text and reset the line number to its starting value.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = m_startingLineNum;
+    }
+
+    /**
+     * Continue reading at @a aOffset in the text, which must be the start of a line.
+     *
+     * @param aLineNumber is the line number that line will be given.
+     */
+    void SetPosition( size_t aOffset, unsigned aLineNumber )
+    {
+        m_pos = aOffset;
+        m_lineNum = aLineNumber - 1;
+    }
+
+    /**
+     * @return the number of lines of the text, without reading them.
+     */
+    unsigned CountLines() const;
+
+    std::string_view Text() const { return m_text; }
+    size_t           CurPos() const { return m_pos; }
+
+protected:
+    std::string_view m_text;
+    size_t           m_pos;              ///< Offset of the next line
+    unsigned         m_startingLineNum;
+};
+
+
+/**
+ * A #STRING_VIEW_LINE_READER that reads from a read-only memory mapping of a whole file.
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public STRING_VIEW_LINE_READER
+{
+public:
+    /**
+     * Map @a aFileName for reading.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened or mapped, e.g. because it is empty.
+     *        A #FILE_LINE_READER should be used instead then.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    long int FileLength() const { return (long int) m_text.size(); }
+
+protected:
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> m_file;
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -505,12 +628,23 @@ public:
      */
     bool Finish() override;
 
+    /**
+     * Append text which was prettified by the caller, e.g. concurrently with
+     * KICAD_FORMAT::PrettifyPart( ..., PRETTIFY_PART::ITEMS, GetFormatMode() ).  It must be made
+     * of complete lists inside the outer list of the file, after at least one other list.
+     */
+    void WritePrettified( std::string&& aText );
+
+    KICAD_FORMAT::FORMAT_MODE GetFormatMode() const { return m_mode; }
+
 protected:
     void write( const char* aOutBuf, int aCount ) override;
 
 private:
     FILE* m_fp;
-    std::string m_buf;
+    std::string m_buf;              ///< Text not prettified yet
+    std::string m_prettified;       ///< Text before m_buf, already prettified
+    bool        m_hasPrettified;
     KICAD_FORMAT::FORMAT_MODE m_mode;
 };
 
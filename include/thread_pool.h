@@ -28,8 +28,29 @@
 #include <bs_thread_pool.hpp>
 #include <import_export.h>
 
+#include <chrono>
+#include <functional>
+#include <memory>
+
 using thread_pool = BS::priority_thread_pool;
 
+/**
+ * Priority lanes of the shared thread pool.  A queued task of a higher lane always starts
+ * before the queued tasks of the lower ones, so library loading cannot delay an interactive
+ * refill.
+ */
+enum class TASK_PRIORITY : BS::priority_t
+{
+    BACKGROUND  = BS::pr::lowest,   ///< Work the user is not waiting for (library loading)
+    BATCH       = BS::pr::normal,   ///< Long foreground jobs with a progress report (DRC, 3D)
+    INTERACTIVE = BS::pr::high      ///< Work blocking an edit (zone refill, connectivity)
+};
+
+inline constexpr BS::priority_t PoolPriority( TASK_PRIORITY aPriority )
+{
+    return static_cast<BS::priority_t>( aPriority );
+}
+
 /**
  * Get a reference to the current thread pool.  N.B., you cannot copy the thread pool
  * so if you accidentally write thread_pool tp = GetKiCadThreadPool(), you will break
@@ -48,5 +69,58 @@ APIEXPORT thread_pool& GetKiCadThreadPool();
  */
 APIEXPORT void InvalidateKiCadThreadPool();
 
+/**
+ * Run \a aJob for every index in [0, \a aCount) on the thread pool and return once all of them
+ * are done.
+ *
+ * The calling thread takes part in the work and never waits for a job which has not started, so
+ * this is safe to call from a task already running on the pool.  An exception thrown by a job is
+ * rethrown to the caller after the remaining jobs have run.
+ */
+APIEXPORT void KiCadParallelFor( size_t aCount, const std::function<void( size_t )>& aJob );
+
+
+/**
+ * A set of tasks submitted to the shared thread pool which can be waited for and cancelled
+ * together, without touching the tasks of other subsystems.
+ *
+ * Cancel() drops the tasks which have not started yet; running tasks should poll IsCancelled()
+ * to stop early.  Wait() runs the tasks still queued on the calling thread, so it is safe to
+ * call from a task already running on the pool.  The destructor cancels and waits, so a task
+ * never outlives the stack frame it captured.
+ */
+class APIEXPORT TASK_GROUP
+{
+public:
+    explicit TASK_GROUP( TASK_PRIORITY aPriority = TASK_PRIORITY::BATCH );
+    ~TASK_GROUP();
+
+    TASK_GROUP( const TASK_GROUP& ) = delete;
+    TASK_GROUP& operator=( const TASK_GROUP& ) = delete;
+
+    void Submit( std::function<void()> aTask );
+
+    void Cancel();
+
+    bool IsCancelled() const;
+
+    /**
+     * Wait for all the tasks of the group.  An exception thrown by a task is rethrown here.
+     */
+    void Wait();
+
+    /**
+     * Wait at most \a aTimeout for the running tasks, without helping.
+     *
+     * @return true if all the tasks are done.
+     */
+    bool WaitFor( std::chrono::milliseconds aTimeout );
+
+private:
+    struct STATE;
+
+    std::shared_ptr<STATE> m_state;
+};
+
 
 #endif /* INCLUDE_THREAD_POOL_H_ */
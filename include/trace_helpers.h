@@ -269,6 +269,13 @@ extern KICOMMON_API const wxChar* const traceKiCad2Step;
  */
 extern KICOMMON_API const wxChar* const traceUiProfile;
 
+/**
+ * Flag to enable agent turn profiling output.
+ *
+ * Use "KICAD_AGENT_PROFILE" to enable.
+ */
+extern KICOMMON_API const wxChar* const traceAgentProfile;
+
 /**
  * Flag to enable Git debugging output.
  *
@@ -331,6 +338,13 @@ extern KICOMMON_API const wxChar* const traceLibWatch;
  */
 extern KICOMMON_API const wxChar* const traceLibraries;
 
+/**
+ * Flag to enable application startup phase timings.
+ *
+ * Use "KICAD_STARTUP" to enable.
+ */
+extern KICOMMON_API const wxChar* const traceStartup;
+
 /**
  * Flag to watch how schematic move tool actions are handled.
  *
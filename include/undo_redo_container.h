@@ -277,9 +277,17 @@ public:
     wxString GetDescription() const                     { return m_description; }
     void SetDescription( const wxString& aDescription ) { m_description = aDescription; }
 
+    /**
+     * Approximate number of bytes kept alive by this command, used to keep the undo history
+     * within its memory budget.  0 when the editor does not estimate it.
+     */
+    size_t GetMemoryEstimate() const                    { return m_memoryEstimate; }
+    void SetMemoryEstimate( size_t aBytes )             { m_memoryEstimate = aBytes; }
+
 private:
     wxString                 m_description;
     std::vector<ITEM_PICKER> m_ItemsList;
+    size_t                   m_memoryEstimate = 0;
 };
 
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <gal/gal.h>
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <unordered_map>
@@ -747,6 +748,10 @@ public:
     /// Rendering order modifier for layers that are marked as top layers.
     static constexpr int TOP_LAYER_MODIFIER = -MAX_LAYERS_FOR_VIEW;
 
+    /// Number of items to redraw in one UpdateItems() call above which the painter's
+    /// PrepareDraw() is run on the thread pool.
+    static constexpr size_t PARALLEL_PREPARE_THRESHOLD = 256;
+
 protected:
     struct VIEW_LAYER
     {
@@ -855,6 +860,33 @@ protected:
     struct UPDATE_COLOR_VISITOR;
     struct UPDATE_DEPTH_VISITOR;
 
+    /**
+     * Screen-space grid used by redrawRect() to coalesce sub-pixel items.
+     *
+     * When zoomed out, thousands of items can fall within one pixel.  Once an item smaller
+     * than a cell has been drawn in a cell of the current layer, the following ones in that
+     * cell are skipped, bounding the number of such items drawn per layer by the cell count.
+     */
+    struct SUBPIXEL_GRID
+    {
+        /// Start a new layer, clearing all the claimed cells.
+        void Reset( const BOX2I& aViewport, double aCellSize );
+
+        /// @return true if \a aBBox is small enough to coalesce and its cell was already
+        ///         claimed by an earlier item of the current layer.
+        bool Covered( const BOX2I& aBBox );
+
+        BOX2I                 m_viewport;
+        double                m_cellSize = 0.0;
+        int                   m_cols = 0;
+        int                   m_rows = 0;
+        uint32_t              m_generation = 0;
+        std::vector<uint32_t> m_stamps;     ///< Generation of the last claim of each cell
+    };
+
+    /// Edge length of a SUBPIXEL_GRID cell, in screen pixels.
+    static constexpr double SUBPIXEL_CELL_PIXELS = 1.5;
+
     std::unique_ptr<KIGFX::VIEW_GROUP> m_preview;
     std::vector<VIEW_ITEM*>            m_ownedItems;
 
@@ -901,6 +933,9 @@ protected:
 
     /// Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    /// Sub-pixel item coalescing state of the current redraw.
+    SUBPIXEL_GRID m_subPixelGrid;
 };
 } // namespace KIGFX
 
@@ -37,6 +37,7 @@
 #define ARG_STOP_ON_ERROR "--stop-on-error"
 #define ARG_JOB_FILE "--file"
 #define ARG_OUTPUT "--output"
+#define ARG_SKIP_UNCHANGED "--skip-unchanged"
 
 CLI::JOBSET_RUN_COMMAND::JOBSET_RUN_COMMAND() : COMMAND( "run" )
 {
@@ -58,6 +59,11 @@ CLI::JOBSET_RUN_COMMAND::JOBSET_RUN_COMMAND() : COMMAND( "run" )
             .help( UTF8STDSTR( _( "Jobset file output to generate, leave blank for all outputs defined in the jobset" ) ) )
             .default_value( std::string( "" ) )
             .metavar( "OUTPUT" );
+
+    m_argParser.add_argument( ARG_SKIP_UNCHANGED )
+            .help( UTF8STDSTR( _( "Skip outputs whose jobs and project files are unchanged since "
+                                  "they were last generated" ) ) )
+            .flag();
 }
 
 
@@ -81,6 +87,7 @@ int CLI::JOBSET_RUN_COMMAND::doPerform( KIWAY& aKiway )
     jobFile.LoadFromFile();
 
     JOBS_RUNNER jobsRunner( &aKiway, &jobFile, project, CLI_REPORTER::GetInstance(), nullptr );
+    jobsRunner.SetSkipUnchanged( m_argParser.get<bool>( ARG_SKIP_UNCHANGED ) );
 
     int return_code = CLI::EXIT_CODES::SUCCESS;
 
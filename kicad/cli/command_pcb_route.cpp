@@ -0,0 +1,75 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_route.h"
+#include "jobs/job_pcb_route.h"
+#include "cli/exit_codes.h"
+#include <string_utils.h>
+#include <wx/crt.h>
+
+#define ARG_NET "--net"
+#define ARG_SHOVE "--shove"
+#define ARG_GLOBAL "--global"
+
+CLI::PCB_ROUTE_COMMAND::PCB_ROUTE_COMMAND() :
+        COMMAND( "route" )
+{
+    addCommonArgs( true, true, false, false );
+    m_argParser.add_description( UTF8STDSTR( _( "Route the unconnected pad to pad connections "
+                                                "of a board with the interactive router" ) ) );
+
+    m_argParser.add_argument( ARG_NET )
+            .default_value( std::vector<std::string>() )
+            .append()
+            .help( UTF8STDSTR( _( "Net to route, can be used multiple times. All nets are routed "
+                                  "if omitted" ) ) )
+            .metavar( "NET_NAME" );
+
+    m_argParser.add_argument( ARG_SHOVE )
+            .help( UTF8STDSTR( _( "Shove existing tracks instead of walking around them" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_GLOBAL )
+            .help( UTF8STDSTR( _( "Plan all connections on a coarse grid first and use the "
+                                  "result to guide the router" ) ) )
+            .flag();
+}
+
+int CLI::PCB_ROUTE_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_ROUTE> routeJob = std::make_unique<JOB_PCB_ROUTE>();
+
+    routeJob->m_filename = m_argInput;
+    routeJob->m_outputFile = m_argOutput;
+    routeJob->m_shove = m_argParser.get<bool>( ARG_SHOVE );
+    routeJob->m_globalRoute = m_argParser.get<bool>( ARG_GLOBAL );
+
+    for( const std::string& net : m_argParser.get<std::vector<std::string>>( ARG_NET ) )
+        routeJob->m_nets.push_back( From_UTF8( net ) );
+
+    if( !wxFile::Exists( routeJob->m_filename ) )
+    {
+        wxFprintf( stderr, _( "Board file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, routeJob.get() );
+
+    return exitCode;
+}
@@ -0,0 +1,335 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_server.h"
+#include <cli/exit_codes.h>
+#include <kinng.h>
+#include <pgm_base.h>
+#include <settings/settings_manager.h>
+#include <string_utils.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+
+#include <nlohmann/json.hpp>
+#include <wx/crt.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define fileno _fileno
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+
+#define ARG_SOCKET "--socket"
+#define ARG_ISOLATE "--isolate"
+
+
+namespace
+{
+
+/**
+ * Redirects stdout and stderr into a temporary file for as long as it lives.
+ */
+class OUTPUT_CAPTURE
+{
+public:
+    OUTPUT_CAPTURE() :
+            m_file( std::tmpfile() ),
+            m_savedOut( -1 ),
+            m_savedErr( -1 )
+    {
+        if( !m_file )
+            return;
+
+        std::fflush( stdout );
+        std::fflush( stderr );
+
+        m_savedOut = dup( fileno( stdout ) );
+        m_savedErr = dup( fileno( stderr ) );
+
+        dup2( fileno( m_file ), fileno( stdout ) );
+        dup2( fileno( m_file ), fileno( stderr ) );
+    }
+
+    ~OUTPUT_CAPTURE()
+    {
+        restore();
+
+        if( m_file )
+            std::fclose( m_file );
+    }
+
+    /**
+     * Stop capturing.
+     *
+     * @return everything written since the capture started.
+     */
+    std::string Finish()
+    {
+        restore();
+
+        std::string output;
+
+        if( !m_file )
+            return output;
+
+        std::rewind( m_file );
+
+        char   buffer[4096];
+        size_t count;
+
+        while( ( count = std::fread( buffer, 1, sizeof( buffer ), m_file ) ) > 0 )
+            output.append( buffer, count );
+
+        return output;
+    }
+
+private:
+    void restore()
+    {
+        if( m_savedOut < 0 )
+            return;
+
+        std::fflush( stdout );
+        std::fflush( stderr );
+
+        dup2( m_savedOut, fileno( stdout ) );
+        dup2( m_savedErr, fileno( stderr ) );
+        close( m_savedOut );
+        close( m_savedErr );
+
+        m_savedOut = -1;
+        m_savedErr = -1;
+    }
+
+    FILE* m_file;
+    int   m_savedOut;
+    int   m_savedErr;
+};
+
+}
+
+
+CLI::SERVER_COMMAND::SERVER_COMMAND( RUNNER aRunner ) :
+        COMMAND( "server" ),
+        m_runner( std::move( aRunner ) )
+{
+    m_argParser.add_description(
+            UTF8STDSTR( _( "Keeps running and executes the commands sent by other kicad-cli "
+                           "invocations. Set the KICAD_CLI_SERVER environment variable to the "
+                           "socket URL to send commands to the server." ) ) );
+
+    m_argParser.add_argument( ARG_SOCKET )
+            .help( UTF8STDSTR( _( "Socket URL to listen on" ) ) )
+            .default_value( DefaultSocketUrl() )
+            .metavar( "URL" );
+
+    m_argParser.add_argument( ARG_ISOLATE )
+            .help( UTF8STDSTR( _( "Unload projects after each command instead of keeping them "
+                                  "loaded for the next one" ) ) )
+            .flag();
+}
+
+
+std::string CLI::SERVER_COMMAND::DefaultSocketUrl()
+{
+    wxFileName socket( wxFileName::GetTempDir(),
+                       wxString::Format( wxS( "kicad-cli-%s.sock" ), wxGetUserId() ) );
+
+    return "ipc://" + std::string( socket.GetFullPath().utf8_str() );
+}
+
+
+bool CLI::SERVER_COMMAND::Forward( const std::string& aSocketUrl,
+                                   const std::vector<std::string>& aArgs, int& aExitCode )
+{
+    KINNG_REQUEST_CLIENT client( aSocketUrl );
+
+    if( !client.Connect() )
+        return false;
+
+    nlohmann::json request;
+    request["cwd"] = std::string( wxGetCwd().utf8_str() );
+    request["args"] = aArgs;
+
+    std::string replyStr;
+
+    // The command may have started by now, so it must not be run again locally
+    if( !client.Request( request.dump(), replyStr ) )
+    {
+        wxFprintf( stderr, _( "No reply from kicad-cli server at %s\n" ), aSocketUrl );
+        aExitCode = EXIT_CODES::ERR_UNKNOWN;
+        return true;
+    }
+
+    try
+    {
+        nlohmann::json reply = nlohmann::json::parse( replyStr );
+        std::string    output = reply.value( "output", "" );
+
+        std::fwrite( output.data(), 1, output.size(), stdout );
+        std::fflush( stdout );
+
+        aExitCode = reply.value( "exit_code", static_cast<int>( EXIT_CODES::ERR_UNKNOWN ) );
+    }
+    catch( const nlohmann::json::exception& )
+    {
+        wxFprintf( stderr, _( "Invalid reply from kicad-cli server at %s\n" ), aSocketUrl );
+        aExitCode = EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    return true;
+}
+
+
+std::string CLI::SERVER_COMMAND::handleRequest( const std::string& aRequest, bool aIsolate,
+                                                bool& aShutdown )
+{
+    nlohmann::json reply;
+    std::vector<std::string> args;
+    wxString cwd;
+
+    try
+    {
+        nlohmann::json request = nlohmann::json::parse( aRequest );
+
+        if( request.value( "shutdown", false ) )
+        {
+            aShutdown = true;
+            reply["exit_code"] = EXIT_CODES::OK;
+            return reply.dump();
+        }
+
+        args = request.at( "args" ).get<std::vector<std::string>>();
+        cwd = From_UTF8( request.value( "cwd", "" ).c_str() );
+    }
+    catch( const nlohmann::json::exception& e )
+    {
+        reply["exit_code"] = EXIT_CODES::ERR_ARGS;
+        reply["output"] = std::string( "Invalid request: " ) + e.what() + "\n";
+        return reply.dump();
+    }
+
+    if( !args.empty() && args[0] == GetName() )
+    {
+        reply["exit_code"] = EXIT_CODES::ERR_ARGS;
+        reply["output"] = "The server command cannot be forwarded to a server\n";
+        return reply.dump();
+    }
+
+    wxString previousCwd = wxGetCwd();
+
+    if( !cwd.IsEmpty() )
+        wxSetWorkingDirectory( cwd );
+
+    int exitCode = EXIT_CODES::ERR_UNKNOWN;
+
+    {
+        OUTPUT_CAPTURE capture;
+
+        try
+        {
+            exitCode = m_runner( args );
+        }
+        catch( const std::exception& e )
+        {
+            wxFprintf( stderr, wxS( "%s\n" ), e.what() );
+        }
+        catch( ... )
+        {
+            wxFprintf( stderr, _( "Unhandled exception\n" ) );
+        }
+
+        reply["output"] = capture.Finish();
+    }
+
+    wxSetWorkingDirectory( previousCwd );
+
+    if( aIsolate )
+    {
+        SETTINGS_MANAGER& mgr = Pgm().GetSettingsManager();
+
+        for( const wxString& path : mgr.GetOpenProjects() )
+        {
+            if( PROJECT* project = mgr.GetProject( path ) )
+                mgr.UnloadProject( project, false );
+        }
+    }
+
+    reply["exit_code"] = exitCode == EXIT_CODES::AVOID_CLOSING ? EXIT_CODES::OK : exitCode;
+
+    // Command output is not guaranteed to be valid UTF-8
+    return reply.dump( -1, ' ', false, nlohmann::json::error_handler_t::replace );
+}
+
+
+int CLI::SERVER_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::string socketUrl = m_argParser.get<std::string>( ARG_SOCKET );
+    bool        isolate = m_argParser.get<bool>( ARG_ISOLATE );
+
+    std::mutex                 mutex;
+    std::condition_variable    requestReady;
+    std::optional<std::string> pendingRequest;
+
+    KINNG_REQUEST_SERVER server( socketUrl );
+
+    // Called on the listener thread, which waits for our reply before taking the next request.
+    // The commands themselves run here on the main thread.
+    server.SetCallback(
+            [&]( std::string* aRequest )
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                pendingRequest = *aRequest;
+                requestReady.notify_one();
+            } );
+
+    wxPrintf( _( "kicad-cli server listening at %s\n" ), socketUrl );
+    std::fflush( stdout );
+
+    bool shutdown = false;
+
+    while( !shutdown )
+    {
+        std::string request;
+
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            requestReady.wait( lock, [&]() { return pendingRequest.has_value(); } );
+            request = std::move( *pendingRequest );
+            pendingRequest.reset();
+        }
+
+        server.Reply( handleRequest( request, isolate, shutdown ) );
+    }
+
+    server.Stop();
+
+    return EXIT_CODES::OK;
+}
@@ -0,0 +1,69 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "command.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/// When set, kicad-cli forwards its arguments to the server listening at this socket URL
+#define KICAD_CLI_SERVER_ENV_VAR wxS( "KICAD_CLI_SERVER" )
+
+namespace CLI
+{
+/**
+ * Keeps kicad-cli running and executes the command lines sent to it, so the program setup,
+ * KIFACEs, library tables and projects are loaded once instead of once per invocation.
+ *
+ * Each request is run like a normal invocation in the client's working directory, with the
+ * output captured and returned along with the exit code.
+ */
+class SERVER_COMMAND : public COMMAND
+{
+public:
+    using RUNNER = std::function<int( const std::vector<std::string>& aArgs )>;
+
+    /**
+     * @param aRunner parses and runs a command line; \a aArgs does not include the program name.
+     */
+    SERVER_COMMAND( RUNNER aRunner );
+
+    /**
+     * Run a command line on the server at \a aSocketUrl instead of in this process.
+     *
+     * @param aExitCode is set to the exit code of the command.
+     * @return false if no server could be reached, in which case the command was not run.
+     */
+    static bool Forward( const std::string& aSocketUrl, const std::vector<std::string>& aArgs,
+                         int& aExitCode );
+
+    static std::string DefaultSocketUrl();
+
+protected:
+    int doPerform( KIWAY& aKiway ) override;
+
+private:
+    std::string handleRequest( const std::string& aRequest, bool aIsolate, bool& aShutdown );
+
+    RUNNER m_runner;
+};
+}
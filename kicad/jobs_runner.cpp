@@ -18,6 +18,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <build_version.h>
 #include <common.h>
 #include <cli/exit_codes.h>
 #include <jobs_runner.h>
@@ -27,8 +28,13 @@
 #include <jobs/job_special_execute.h>
 #include <kiway.h>
 #include <kiway_express.h>
+#include <mmh3_hash.h>
+#include <paths.h>
 #include <reporter.h>
+#include <wildcards_and_files_ext.h>
 #include <optional>
+#include <wx/dir.h>
+#include <wx/ffile.h>
 #include <wx/process.h>
 #include <wx/txtstrm.h>
 #include <wx/sstream.h>
@@ -41,7 +47,8 @@ JOBS_RUNNER::JOBS_RUNNER( KIWAY* aKiway, JOBSET* aJobsFile, PROJECT* aProject,
         m_jobsFile( aJobsFile ),
         m_reporter( aReporter ),
         m_progressReporter( aProgressReporter ),
-        m_project( aProject )
+        m_project( aProject ),
+        m_skipUnchanged( false )
 {
 }
 
@@ -149,12 +156,120 @@ int JOBS_RUNNER::runSpecialCopyFiles( const JOBSET_JOB* aJob, PROJECT* aProject
 }
 
 
+wxString JOBS_RUNNER::destinationFingerprint( JOBSET_DESTINATION*            aDestination,
+                                              const std::vector<JOBSET_JOB>& aJobs ) const
+{
+    MMH3_HASH hash( 0 );
+
+    hash.add( GetBuildVersion().ToStdString() );
+
+    nlohmann::json destinationJson;
+    to_json( destinationJson, *aDestination );
+    hash.add( destinationJson.dump() );
+
+    for( const JOBSET_JOB& job : aJobs )
+    {
+        // Commands and file copies may read anything, so there is nothing to compare against
+        if( JOB_REGISTRY::GetKifaceType( job.m_type ) >= KIWAY::KIWAY_FACE_COUNT )
+            return wxEmptyString;
+
+        nlohmann::json jobJson;
+        to_json( jobJson, job );
+        hash.add( jobJson.dump() );
+    }
+
+    // The jobs only read the boards, schematics, project settings and the library tables, so
+    // hashing those catches every edit without having to load the design
+    wxArrayString files;
+    wxDir::GetAllFiles( m_project->GetProjectPath(), &files, wxEmptyString,
+                        wxDIR_FILES | wxDIR_DIRS );
+    files.Sort();
+
+    std::vector<uint8_t> buffer( 1 << 16 );
+
+    for( const wxString& file : files )
+    {
+        wxFileName fn( file );
+
+        if( fn.GetExt() != FILEEXT::KiCadPcbFileExtension
+                && fn.GetExt() != FILEEXT::KiCadSchematicFileExtension
+                && fn.GetExt() != FILEEXT::ProjectFileExtension
+                && fn.GetExt() != FILEEXT::DesignRulesFileExtension
+                && fn.GetFullName() != FILEEXT::SymbolLibraryTableFileName
+                && fn.GetFullName() != FILEEXT::FootprintLibraryTableFileName )
+        {
+            continue;
+        }
+
+        wxFFile input( file, wxS( "rb" ) );
+
+        if( !input.IsOpened() )
+            return wxEmptyString;
+
+        hash.add( file.ToStdString() );
+
+        while( !input.Eof() )
+        {
+            size_t count = input.Read( buffer.data(), buffer.size() );
+
+            if( count == 0 )
+                break;
+
+            hash.addData( buffer.data(), count );
+        }
+    }
+
+    return hash.digest().ToString();
+}
+
+
+wxString JOBS_RUNNER::fingerprintFilePath( JOBSET_DESTINATION* aDestination ) const
+{
+    MMH3_HASH hash( 0 );
+
+    hash.add( m_project->GetProjectFullName().ToStdString() );
+    hash.add( m_jobsFile->GetFullFilename().ToStdString() );
+    hash.add( aDestination->m_id.ToStdString() );
+
+    wxFileName fn;
+    fn.AssignDir( PATHS::GetUserCachePath() );
+    fn.AppendDir( wxS( "jobsets" ) );
+    fn.SetName( hash.digest().ToString() );
+
+    return fn.GetFullPath();
+}
+
+
 bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool aBail )
 {
     bool                    genOutputs = true;
     bool                    success = true;
     std::vector<JOBSET_JOB> jobsForDestination = m_jobsFile->GetJobsForDestination( aDestination );
     wxString msg;
+    wxString fingerprint;
+
+    if( m_skipUnchanged )
+    {
+        fingerprint = destinationFingerprint( aDestination, jobsForDestination );
+
+        wxFFile  previous( fingerprintFilePath( aDestination ), wxS( "rb" ) );
+        wxString previousFingerprint;
+
+        if( !fingerprint.IsEmpty() && previous.IsOpened() && previous.ReadAll( &previousFingerprint )
+                && previousFingerprint == fingerprint
+                && aDestination->m_outputHandler->HasOutputs( m_project ) )
+        {
+            msg = wxString::Format( wxT( "Destination %s is up to date, skipping its jobs\n" ),
+                                    aDestination->m_id );
+            m_reporter.Report( msg, RPT_SEVERITY_INFO );
+
+            aDestination->m_lastRunSuccessMap.clear();
+            aDestination->m_lastRunReporters.clear();
+            aDestination->m_lastResolvedOutputPath.reset();
+            aDestination->m_lastRunSuccess = true;
+            return true;
+        }
+    }
 
     wxFileName tmp;
     tmp.AssignDir( wxFileName::GetTempDir() );
@@ -320,6 +435,24 @@ bool JOBS_RUNNER::RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool
 
     aDestination->m_lastRunSuccess = success;
 
+    if( m_skipUnchanged )
+    {
+        wxFileName fingerprintFn( fingerprintFilePath( aDestination ) );
+
+        if( success && genOutputs && !fingerprint.IsEmpty()
+                && wxFileName::Mkdir( fingerprintFn.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        {
+            wxFFile output( fingerprintFn.GetFullPath(), wxS( "wb" ) );
+
+            if( output.IsOpened() )
+                output.Write( fingerprint );
+        }
+        else if( fingerprintFn.FileExists() )
+        {
+            wxRemoveFile( fingerprintFn.GetFullPath() );
+        }
+    }
+
     msg = wxString::Format( wxT( "\n\n\033[33;1m%d %s, %d %s\033[0m\n" ),
                             successCount,
                             wxT( "jobs succeeded" ),
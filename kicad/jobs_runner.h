@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <vector>
 #include <widgets/wx_progress_reporters.h>
 
 class JOBSET;
@@ -66,14 +67,30 @@ public:
     bool RunJobsAllDestinations( bool aBail = false );
     bool RunJobsForDestination( JOBSET_DESTINATION* aDestination, bool aBail = false );
 
+    /**
+     * Skip destinations whose jobs, settings and project files are unchanged since their last
+     * successful run, as long as the previous outputs are still in place.
+     */
+    void SetSkipUnchanged( bool aSkip ) { m_skipUnchanged = aSkip; }
+
 private:
     int runSpecialExecute( const JOBSET_JOB* aJob, REPORTER* aReporter, PROJECT* aProject );
     int runSpecialCopyFiles( const JOBSET_JOB* aJob, PROJECT* aProject );
 
+    /**
+     * @return a hash of everything the outputs of \a aDestination depend on, or an empty string
+     *         if they also depend on things outside the project (external commands or copies).
+     */
+    wxString destinationFingerprint( JOBSET_DESTINATION*            aDestination,
+                                     const std::vector<JOBSET_JOB>& aJobs ) const;
+
+    wxString fingerprintFilePath( JOBSET_DESTINATION* aDestination ) const;
+
 private:
     KIWAY*                  m_kiway;
     JOBSET*                 m_jobsFile;
     REPORTER&               m_reporter;
     JOBS_PROGRESS_REPORTER* m_progressReporter;
     PROJECT*                m_project;
+    bool                    m_skipUnchanged;
 };
\ No newline at end of file
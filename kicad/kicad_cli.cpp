@@ -72,6 +72,7 @@
 #include "cli/command_sch_export_pythonbom.h"
 #include "cli/command_sch_export_netlist.h"
 #include "cli/command_sch_export_plot.h"
+#include "cli/command_pcb_route.h"
 #include "cli/command_pcb_upgrade.h"
 #include "cli/command_fp.h"
 #include "cli/command_fp_export.h"
@@ -86,6 +87,9 @@
 #include "cli/command_sym_export_svg.h"
 #include "cli/command_sym_upgrade.h"
 #include "cli/command_version.h"
+#ifdef KICAD_IPC_API
+#include "cli/command_server.h"
+#endif
 #include "cli/exit_codes.h"
 
 // Add this header after all others, to avoid a collision name in a Windows header
@@ -119,171 +123,206 @@ struct COMMAND_ENTRY
             handler( aHandler ), subCommands( aSub ){};
 };
 
-static CLI::JOBSET_COMMAND               jobsetCmd{};
-static CLI::JOBSET_RUN_COMMAND           jobsetRunCmd{};
-static CLI::PCB_COMMAND                  pcbCmd{};
-static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
-static CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
-static CLI::PCB_UPGRADE_COMMAND          pcbUpgradeCmd{};
-static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
-static CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepCmd{ "step", UTF8STDSTR( _( "Export STEP" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEP };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbBrepCmd{ "brep", UTF8STDSTR( _( "Export BREP" ) ), JOB_EXPORT_PCB_3D::FORMAT::BREP };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbXaoCmd{ "xao", UTF8STDSTR( _( "Export XAO" ) ), JOB_EXPORT_PCB_3D::FORMAT::XAO };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbVrmlCmd{ "vrml", UTF8STDSTR( _( "Export VRML" ) ), JOB_EXPORT_PCB_3D::FORMAT::VRML };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbPlyCmd{ "ply", UTF8STDSTR( _( "Export PLY" ) ), JOB_EXPORT_PCB_3D::FORMAT::PLY };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbStlCmd{ "stl", UTF8STDSTR( _( "Export STL" ) ), JOB_EXPORT_PCB_3D::FORMAT::STL };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepzCmd{ "stpz", UTF8STDSTR( _( "Export STEPZ" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEPZ };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbU3DCmd{ "u3d", UTF8STDSTR( _( "Export U3D" ) ), JOB_EXPORT_PCB_3D::FORMAT::U3D };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcb3DPDFCmd{ "3dpdf", UTF8STDSTR( _( "Export PDF" ) ),
-                                                   JOB_EXPORT_PCB_3D::FORMAT::PDF };
-static CLI::PCB_EXPORT_SVG_COMMAND       exportPcbSvgCmd{};
-static CLI::PCB_EXPORT_PDF_COMMAND       exportPcbPdfCmd{};
-static CLI::PCB_EXPORT_POS_COMMAND       exportPcbPosCmd{};
-static CLI::PCB_EXPORT_PS_COMMAND        exportPcbPsCmd{};
-static CLI::PCB_EXPORT_STATS_COMMAND     exportPcbStatsCmd{};
-static CLI::PCB_EXPORT_GERBER_COMMAND    exportPcbGerberCmd{};
-static CLI::PCB_EXPORT_GERBERS_COMMAND   exportPcbGerbersCmd{};
-static CLI::PCB_EXPORT_HPGL_COMMAND      exportPcbHpglCmd{};
-static CLI::PCB_EXPORT_GENCAD_COMMAND    exportPcbGencadCmd{};
-static CLI::PCB_EXPORT_IPC2581_COMMAND   exportPcbIpc2581Cmd{};
-static CLI::PCB_EXPORT_IPCD356_COMMAND   exportPcbIpcD356Cmd{};
-static CLI::PCB_EXPORT_ODB_COMMAND       exportPcbOdbCmd{};
-static CLI::PCB_EXPORT_COMMAND           exportPcbCmd{};
-static CLI::SCH_EXPORT_COMMAND           exportSchCmd{};
-static CLI::SCH_COMMAND                  schCmd{};
-static CLI::SCH_ERC_COMMAND              schErcCmd{};
-static CLI::SCH_UPGRADE_COMMAND          schUpgradeCmd{};
-static CLI::SCH_EXPORT_BOM_COMMAND       exportSchBomCmd{};
-static CLI::SCH_EXPORT_PYTHONBOM_COMMAND exportSchPythonBomCmd{};
-static CLI::SCH_EXPORT_NETLIST_COMMAND   exportSchNetlistCmd{};
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchDxfCmd{ "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchHpglCmd{ "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPdfCmd{ "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPostscriptCmd{ "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchSvgCmd{ "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG };
-static CLI::FP_COMMAND                   fpCmd{};
-static CLI::FP_EXPORT_COMMAND            fpExportCmd{};
-static CLI::FP_EXPORT_SVG_COMMAND        fpExportSvgCmd{};
-static CLI::FP_UPGRADE_COMMAND           fpUpgradeCmd{};
-static CLI::SYM_COMMAND                  symCmd{};
-static CLI::SYM_EXPORT_COMMAND           symExportCmd{};
-static CLI::SYM_EXPORT_SVG_COMMAND       symExportSvgCmd{};
-static CLI::SYM_UPGRADE_COMMAND          symUpgradeCmd{};
-static CLI::VERSION_COMMAND              versionCmd{};
-
-
-// clang-format off
-static std::vector<COMMAND_ENTRY> commandStack = {
-    {
-        &jobsetCmd,
+static int runCommandLine( int aArgc, const char* const aArgv[] );
+
+
+/**
+ * The command handlers and their argument parsers.  Parsing changes their state, so every
+ * command line gets its own set.
+ */
+struct CLI_COMMANDS
+{
+    CLI_COMMANDS() = default;
+    CLI_COMMANDS( const CLI_COMMANDS& ) = delete;
+    CLI_COMMANDS& operator=( const CLI_COMMANDS& ) = delete;
+
+    // clang-format off
+    CLI::JOBSET_COMMAND               jobsetCmd{};
+    CLI::JOBSET_RUN_COMMAND           jobsetRunCmd{};
+    CLI::PCB_COMMAND                  pcbCmd{};
+    CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
+    CLI::PCB_RENDER_COMMAND           pcbRenderCmd{};
+    CLI::PCB_ROUTE_COMMAND            pcbRouteCmd{};
+    CLI::PCB_UPGRADE_COMMAND          pcbUpgradeCmd{};
+    CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
+    CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepCmd{ "step", UTF8STDSTR( _( "Export STEP" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEP };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbBrepCmd{ "brep", UTF8STDSTR( _( "Export BREP" ) ), JOB_EXPORT_PCB_3D::FORMAT::BREP };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbXaoCmd{ "xao", UTF8STDSTR( _( "Export XAO" ) ), JOB_EXPORT_PCB_3D::FORMAT::XAO };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbVrmlCmd{ "vrml", UTF8STDSTR( _( "Export VRML" ) ), JOB_EXPORT_PCB_3D::FORMAT::VRML };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbPlyCmd{ "ply", UTF8STDSTR( _( "Export PLY" ) ), JOB_EXPORT_PCB_3D::FORMAT::PLY };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbStlCmd{ "stl", UTF8STDSTR( _( "Export STL" ) ), JOB_EXPORT_PCB_3D::FORMAT::STL };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepzCmd{ "stpz", UTF8STDSTR( _( "Export STEPZ" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEPZ };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcbU3DCmd{ "u3d", UTF8STDSTR( _( "Export U3D" ) ), JOB_EXPORT_PCB_3D::FORMAT::U3D };
+    CLI::PCB_EXPORT_3D_COMMAND        exportPcb3DPDFCmd{ "3dpdf", UTF8STDSTR( _( "Export PDF" ) ),
+                                                JOB_EXPORT_PCB_3D::FORMAT::PDF };
+    CLI::PCB_EXPORT_SVG_COMMAND       exportPcbSvgCmd{};
+    CLI::PCB_EXPORT_PDF_COMMAND       exportPcbPdfCmd{};
+    CLI::PCB_EXPORT_POS_COMMAND       exportPcbPosCmd{};
+    CLI::PCB_EXPORT_PS_COMMAND        exportPcbPsCmd{};
+    CLI::PCB_EXPORT_STATS_COMMAND     exportPcbStatsCmd{};
+    CLI::PCB_EXPORT_GERBER_COMMAND    exportPcbGerberCmd{};
+    CLI::PCB_EXPORT_GERBERS_COMMAND   exportPcbGerbersCmd{};
+    CLI::PCB_EXPORT_HPGL_COMMAND      exportPcbHpglCmd{};
+    CLI::PCB_EXPORT_GENCAD_COMMAND    exportPcbGencadCmd{};
+    CLI::PCB_EXPORT_IPC2581_COMMAND   exportPcbIpc2581Cmd{};
+    CLI::PCB_EXPORT_IPCD356_COMMAND   exportPcbIpcD356Cmd{};
+    CLI::PCB_EXPORT_ODB_COMMAND       exportPcbOdbCmd{};
+    CLI::PCB_EXPORT_COMMAND           exportPcbCmd{};
+    CLI::SCH_EXPORT_COMMAND           exportSchCmd{};
+    CLI::SCH_COMMAND                  schCmd{};
+    CLI::SCH_ERC_COMMAND              schErcCmd{};
+    CLI::SCH_UPGRADE_COMMAND          schUpgradeCmd{};
+    CLI::SCH_EXPORT_BOM_COMMAND       exportSchBomCmd{};
+    CLI::SCH_EXPORT_PYTHONBOM_COMMAND exportSchPythonBomCmd{};
+    CLI::SCH_EXPORT_NETLIST_COMMAND   exportSchNetlistCmd{};
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchDxfCmd{ "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchHpglCmd{ "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPdfCmd{ "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPostscriptCmd{ "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST };
+    CLI::SCH_EXPORT_PLOT_COMMAND      exportSchSvgCmd{ "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG };
+    CLI::FP_COMMAND                   fpCmd{};
+    CLI::FP_EXPORT_COMMAND            fpExportCmd{};
+    CLI::FP_EXPORT_SVG_COMMAND        fpExportSvgCmd{};
+    CLI::FP_UPGRADE_COMMAND           fpUpgradeCmd{};
+    CLI::SYM_COMMAND                  symCmd{};
+    CLI::SYM_EXPORT_COMMAND           symExportCmd{};
+    CLI::SYM_EXPORT_SVG_COMMAND       symExportSvgCmd{};
+    CLI::SYM_UPGRADE_COMMAND          symUpgradeCmd{};
+    CLI::VERSION_COMMAND              versionCmd{};
+
+#ifdef KICAD_IPC_API
+    CLI::SERVER_COMMAND               serverCmd{
+            []( const std::vector<std::string>& aArgs )
+            {
+                std::vector<const char*> argv = { "kicad-cli" };
+
+                for( const std::string& arg : aArgs )
+                    argv.push_back( arg.c_str() );
+
+                return runCommandLine( static_cast<int>( argv.size() ), argv.data() );
+            } };
+#endif
+
+    std::vector<COMMAND_ENTRY> commandStack = {
         {
+            &jobsetCmd,
             {
-                &jobsetRunCmd
+                {
+                    &jobsetRunCmd
+                }
             }
-        }
-    },
-    {
-        &fpCmd,
+        },
         {
+            &fpCmd,
             {
-                &fpExportCmd,
                 {
-                    &fpExportSvgCmd
+                    &fpExportCmd,
+                    {
+                        &fpExportSvgCmd
+                    }
+                },
+                {
+                    &fpUpgradeCmd
                 }
-            },
-            {
-                &fpUpgradeCmd
             }
-        }
-    },
-    {
-        &pcbCmd,
+        },
         {
+            &pcbCmd,
             {
-                &pcbDrcCmd
-            },
-            {
-                &pcbRenderCmd
-            },
-            {
-                &exportPcbCmd,
                 {
-                    &exportPcbBrepCmd,
-                    &exportPcbDrillCmd,
-                    &exportPcbDxfCmd,
-                    &exportPcbGerberCmd,
-                    &exportPcbGerbersCmd,
-                    &exportPcbHpglCmd,
-                    &exportPcbGencadCmd,
-                    &exportPcbGlbCmd,
-                    &exportPcbIpc2581Cmd,
-                    &exportPcbIpcD356Cmd,
-                    &exportPcbOdbCmd,
-                    &exportPcbPdfCmd,
-                    &exportPcbPosCmd,
-                    &exportPcbPsCmd,
-                    &exportPcbStatsCmd,
-                    &exportPcbStepCmd,
-                    &exportPcbSvgCmd,
-                    &exportPcbVrmlCmd,
-                    &exportPcbXaoCmd,
-                    &exportPcbPlyCmd,
-                    &exportPcbStlCmd,
-                    &exportPcbStepzCmd,
-                    &exportPcbU3DCmd,
-                    &exportPcb3DPDFCmd
+                    &pcbDrcCmd
+                },
+                {
+                    &pcbRenderCmd
+                },
+                {
+                    &exportPcbCmd,
+                    {
+                        &exportPcbBrepCmd,
+                        &exportPcbDrillCmd,
+                        &exportPcbDxfCmd,
+                        &exportPcbGerberCmd,
+                        &exportPcbGerbersCmd,
+                        &exportPcbHpglCmd,
+                        &exportPcbGencadCmd,
+                        &exportPcbGlbCmd,
+                        &exportPcbIpc2581Cmd,
+                        &exportPcbIpcD356Cmd,
+                        &exportPcbOdbCmd,
+                        &exportPcbPdfCmd,
+                        &exportPcbPosCmd,
+                        &exportPcbPsCmd,
+                        &exportPcbStatsCmd,
+                        &exportPcbStepCmd,
+                        &exportPcbSvgCmd,
+                        &exportPcbVrmlCmd,
+                        &exportPcbXaoCmd,
+                        &exportPcbPlyCmd,
+                        &exportPcbStlCmd,
+                        &exportPcbStepzCmd,
+                        &exportPcbU3DCmd,
+                        &exportPcb3DPDFCmd
+                    }
+                },
+                {
+                    &pcbRouteCmd
+                },
+                {
+                    &pcbUpgradeCmd
                 }
-            },
-            {
-                &pcbUpgradeCmd
             }
-        }
-    },
-    {
-        &schCmd,
+        },
         {
+            &schCmd,
             {
-                &schErcCmd
-            },
-            {
-                &exportSchCmd,
                 {
-                    &exportSchDxfCmd,
-                    &exportSchHpglCmd,
-                    &exportSchNetlistCmd,
-                    &exportSchPdfCmd,
-                    &exportSchPostscriptCmd,
-                    &exportSchBomCmd,
-                    &exportSchPythonBomCmd,
-                    &exportSchSvgCmd
+                    &schErcCmd
+                },
+                {
+                    &exportSchCmd,
+                    {
+                        &exportSchDxfCmd,
+                        &exportSchHpglCmd,
+                        &exportSchNetlistCmd,
+                        &exportSchPdfCmd,
+                        &exportSchPostscriptCmd,
+                        &exportSchBomCmd,
+                        &exportSchPythonBomCmd,
+                        &exportSchSvgCmd
+                    }
+                },
+                {
+                    &schUpgradeCmd
                 }
-            },
-            {
-                &schUpgradeCmd
             }
-        }
-    },
-    {
-        &symCmd,
+        },
         {
+            &symCmd,
             {
-                &symExportCmd,
                 {
-                    &symExportSvgCmd
+                    &symExportCmd,
+                    {
+                        &symExportSvgCmd
+                    }
+                },
+                {
+                    &symUpgradeCmd
                 }
-            },
-            {
-                &symUpgradeCmd
             }
-        }
-    },
-    {
-            &versionCmd,
-    }
+        },
+        {
+                &versionCmd,
+        },
+#ifdef KICAD_IPC_API
+        {
+                &serverCmd,
+        },
+#endif
+    };
+    // clang-format on
 };
-// clang-format on
 
 
 static void recurseArgParserBuild( argparse::ArgumentParser& aArgParser, COMMAND_ENTRY& aEntry )
@@ -358,6 +397,15 @@ bool PGM_KICAD::OnPgmInit()
 
 int PGM_KICAD::OnPgmRun()
 {
+    return runCommandLine( m_argcUtf8, m_argvUtf8 );
+}
+
+
+static int runCommandLine( int aArgc, const char* const aArgv[] )
+{
+    CLI_COMMANDS                commands;
+    std::vector<COMMAND_ENTRY>& commandStack = commands.commandStack;
+
     argparse::ArgumentParser argParser( std::string( "kicad-cli" ), GetMajorMinorVersion().ToStdString(),
                                         argparse::default_arguments::none );
 
@@ -381,16 +429,16 @@ int PGM_KICAD::OnPgmRun()
         // Use the C locale to parse arguments
         // Otherwise the decimal separator for the locale will be applied
         LOCALE_IO dummy;
-        argParser.parse_args( m_argcUtf8, m_argvUtf8 );
+        argParser.parse_args( aArgc, aArgv );
     }
     // std::runtime_error doesn't seem to be enough for the scan<>()
     catch( const std::exception& err )
     {
         bool requestedHelp = false;
 
-        for( int i = 0; i < m_argcUtf8; ++i )
+        for( int i = 0; i < aArgc; ++i )
         {
-            if( std::string arg( m_argvUtf8[i] ); arg == ARG_HELP_SHORT || arg == ARG_HELP )
+            if( std::string arg( aArgv[i] ); arg == ARG_HELP_SHORT || arg == ARG_HELP )
             {
                 requestedHelp = true;
                 break;
@@ -437,7 +485,7 @@ int PGM_KICAD::OnPgmRun()
     // the version arg gets redirected to the version subcommand
     if( argParser[ARG_VERSION] == true )
     {
-        cliCmd = &versionCmd;
+        cliCmd = &commands.versionCmd;
     }
 
     if( !cliCmd )
@@ -527,7 +575,10 @@ static PGM_KICAD program;
  */
 struct APP_KICAD_CLI : public wxAppConsole
 {
-    APP_KICAD_CLI() : wxAppConsole()
+    APP_KICAD_CLI() :
+            wxAppConsole(),
+            m_forwarded( false ),
+            m_forwardedExitCode( 0 )
     {
         SetPgm( &program );
 
@@ -553,6 +604,26 @@ struct APP_KICAD_CLI : public wxAppConsole
         }
 #endif
 
+#ifdef KICAD_IPC_API
+        // Hand the command line to a running server, which skips all of the program setup below
+        wxString serverUrl;
+
+        if( wxGetEnv( KICAD_CLI_SERVER_ENV_VAR, &serverUrl ) && !serverUrl.IsEmpty()
+                && argc > 1 && argv[1] != wxS( "server" ) )
+        {
+            std::vector<std::string> args;
+
+            for( int ii = 1; ii < argc; ++ii )
+                args.emplace_back( argv[ii].utf8_str() );
+
+            m_forwarded = CLI::SERVER_COMMAND::Forward( std::string( serverUrl.utf8_str() ), args,
+                                                        m_forwardedExitCode );
+
+            if( m_forwarded )
+                return true;
+        }
+#endif
+
         if( !program.OnPgmInit() )
         {
             program.OnPgmExit();
@@ -564,7 +635,8 @@ struct APP_KICAD_CLI : public wxAppConsole
 
     int OnExit() override
     {
-        program.OnPgmExit();
+        if( !m_forwarded )
+            program.OnPgmExit();
 
 #if defined( __FreeBSD__ )
         // Avoid wxLog crashing when used in destructors.
@@ -576,6 +648,9 @@ struct APP_KICAD_CLI : public wxAppConsole
 
     int OnRun() override
     {
+        if( m_forwarded )
+            return m_forwardedExitCode;
+
         try
         {
             return program.OnPgmRun();
@@ -634,6 +709,10 @@ struct APP_KICAD_CLI : public wxAppConsole
         return false; // continue on. Return false to abort program
     }
 #endif
+
+private:
+    bool m_forwarded;
+    int  m_forwardedExitCode;
 };
 
 IMPLEMENT_APP_CONSOLE( APP_KICAD_CLI )
@@ -23,9 +23,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <stack>
 #include <git/git_backend.h>
 
+#include <wx/filename.h>
 #include <wx/regex.h>
 #include <wx/stdpaths.h>
 #include <wx/string.h>
@@ -233,6 +235,8 @@ PROJECT_TREE_PANE::PROJECT_TREE_PANE( KICAD_MANAGER_FRAME* parent ) :
     m_gitLastError = GIT_ERROR_NONE;
     m_watcher = nullptr;
     m_gitIconsInitialized = false;
+    m_gitIndexTimestamp = 0;
+    m_gitRescanNeeded = false;
 
     Bind( wxEVT_FSWATCHER,
              wxFileSystemWatcherEventHandler( PROJECT_TREE_PANE::onFileSystemEvent ), this );
@@ -648,6 +652,14 @@ void PROJECT_TREE_PANE::ReCreateTreePrj()
     m_gitSyncTimer.Stop();
     m_gitTreeCache.clear();
     m_gitStatusIcons.clear();
+    m_gitFileStatus.clear();
+    m_gitIndexTimestamp = 0;
+
+    {
+        std::lock_guard<std::mutex> lock( m_gitDirtyPathsMutex );
+        m_gitDirtyPaths.clear();
+        m_gitRescanNeeded = false;
+    }
 
     wxString pro_dir = m_Parent->GetProjectFileName();
 
@@ -769,6 +781,24 @@ bool PROJECT_TREE_PANE::hasChangedFiles()
     if( !m_TreeProject->GetGitRepo() )
         return false;
 
+    // Answer from the last background scan when there is one: a full status of a large
+    // repository would block the context menu.  Only project files can be committed from here.
+    {
+        std::unique_lock<std::mutex> lock( m_gitStatusMutex, std::try_to_lock );
+
+        if( lock.owns_lock() && !m_gitFileStatus.empty() )
+        {
+            return std::any_of( m_gitFileStatus.begin(), m_gitFileStatus.end(),
+                                []( const std::pair<const wxString, FileStatus>& aEntry )
+                                {
+                                    KIGIT_COMMON::GIT_STATUS status = aEntry.second.status;
+
+                                    return status != KIGIT_COMMON::GIT_STATUS::GIT_STATUS_CURRENT
+                                           && status != KIGIT_COMMON::GIT_STATUS::GIT_STATUS_IGNORED;
+                                } );
+        }
+    }
+
     GIT_STATUS_HANDLER statusHandler( m_TreeProject->GitCommon() );
     return statusHandler.HasChangedFiles();
 }
@@ -1364,6 +1394,27 @@ void PROJECT_TREE_PANE::onFileSystemEvent( wxFileSystemWatcherEvent& event )
     if( !root_id.IsOk() )
         return;
 
+    // Let the next git status update refresh just these files
+    {
+        std::lock_guard<std::mutex> lock( m_gitDirtyPathsMutex );
+        std::vector<wxString>       paths = { fn };
+
+        if( event.GetChangeType() == wxFSW_EVENT_RENAME )
+            paths.push_back( event.GetNewPath().GetFullPath() );
+
+        // A directory event can stand for any number of files
+        if( pathModified.GetFullName().IsEmpty() )
+            m_gitRescanNeeded = true;
+
+        for( wxString& path : paths )
+        {
+#ifdef _WIN32
+            path.Replace( wxS( "\\" ), wxS( "/" ) );
+#endif
+            m_gitDirtyPaths.insert( path );
+        }
+    }
+
     CallAfter( [this] ()
     {
         wxLogTrace( traceGit, wxS( "File system event detected, updating tree cache" ) );
@@ -2106,8 +2157,32 @@ void PROJECT_TREE_PANE::updateGitStatusIconMap()
     pathspecStr.Replace( wxS( "\\" ), wxS( "/" ) );
 #endif
 
-    // Get file status
-    auto fileStatusMap = statusHandler.GetFileStatus( pathspecStr );
+    // Staging, committing or checking out rewrites the index; otherwise only the files reported
+    // by the file system watcher since the last scan need to be queried again.
+    wxFileName indexFn( statusHandler.GetIndexPath() );
+    long long  indexTimestamp = 0;
+
+    if( indexFn.FileExists() )
+        indexTimestamp = indexFn.GetModificationTime().GetValue().GetValue();
+
+    std::set<wxString> dirtyPaths;
+    bool               rescan = false;
+
+    {
+        std::lock_guard<std::mutex> dirtyLock( m_gitDirtyPathsMutex );
+        dirtyPaths.swap( m_gitDirtyPaths );
+        std::swap( rescan, m_gitRescanNeeded );
+    }
+
+    if( rescan || m_gitFileStatus.empty() || indexTimestamp != m_gitIndexTimestamp
+            || !statusHandler.UpdateFileStatus( dirtyPaths, m_gitFileStatus ) )
+    {
+        wxLogTrace( traceGit, wxS( "updateGitStatusIconMap: Scanning '%s'" ), pathspecStr );
+        m_gitFileStatus = statusHandler.GetFileStatus( pathspecStr );
+        m_gitIndexTimestamp = indexTimestamp;
+    }
+
+    std::map<wxString, FileStatus> fileStatusMap = m_gitFileStatus;
     auto [localChanges, remoteChanges] = m_TreeProject->GitCommon()->GetDifferentFiles();
     statusHandler.UpdateRemoteStatus( localChanges, remoteChanges, fileStatusMap );
 
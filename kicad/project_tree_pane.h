@@ -32,6 +32,7 @@
 
 #include <map>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 #include <vector>
 #include <wx/datetime.h>
@@ -40,6 +41,7 @@
 #include <wx/timer.h>
 #include <wx/treebase.h>
 
+#include <git/git_status_handler.h>
 #include <git/kicad_git_common.h>
 #include "tree_file_type.h"
 
@@ -329,6 +331,15 @@ private:
     std::map<wxTreeItemId, KIGIT_COMMON::GIT_STATUS> m_gitStatusIcons;
     bool                                             m_gitIconsInitialized;
 
+    // Status of the project files from the last scan, guarded by m_gitStatusMutex.  It is kept
+    // up to date file by file from the file system events until the index file changes.
+    std::map<wxString, FileStatus>                   m_gitFileStatus;
+    long long                                        m_gitIndexTimestamp;
+
+    std::mutex                                       m_gitDirtyPathsMutex;
+    std::set<wxString>                               m_gitDirtyPaths;   // changed since the scan
+    bool                                             m_gitRescanNeeded; // e.g. a directory changed
+
     DECLARE_EVENT_TABLE()
 };
 
@@ -0,0 +1,316 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PACKED_RTREE_H
+#define PACKED_RTREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include <math/box2.h>
+#include <math/hilbert.h>
+
+/**
+ * A static R-tree, bulk loaded once and then only queried.
+ *
+ * Build() sorts the items along a Hilbert curve through their box centres and packs them
+ * bottom-up into nodes of #NODE_SIZE children.  The boxes of the items and of every node are
+ * kept in four contiguous coordinate arrays (items first, then each level up to the root), so
+ * visiting a node reads a few cache lines and its children are tested with a branch-free loop
+ * the compiler can vectorize.
+ *
+ * Use it instead of RTree when all items are known before the queries start.  Items added
+ * after Build() are not found until Build() is called again.
+ */
+template <class T>
+class PACKED_RTREE
+{
+public:
+    static constexpr size_t NODE_SIZE = 16;
+
+    void Clear()
+    {
+        m_items.clear();
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_firstChild.clear();
+        m_childEnd.clear();
+        m_built = false;
+    }
+
+    void Reserve( size_t aSize )
+    {
+        m_items.reserve( aSize );
+        m_minX.reserve( aSize );
+        m_minY.reserve( aSize );
+        m_maxX.reserve( aSize );
+        m_maxY.reserve( aSize );
+    }
+
+    void Add( const BOX2I& aBox, const T& aItem )
+    {
+        if( m_built )
+            dropNodes();
+
+        m_items.push_back( aItem );
+        m_minX.push_back( aBox.GetLeft() );
+        m_minY.push_back( aBox.GetTop() );
+        m_maxX.push_back( aBox.GetRight() );
+        m_maxY.push_back( aBox.GetBottom() );
+    }
+
+    /**
+     * Sort the items and build the node levels.  Queries are only valid after this call.
+     */
+    void Build()
+    {
+        if( m_built )
+            return;
+
+        const size_t count = m_items.size();
+
+        m_firstChild.clear();
+        m_childEnd.clear();
+
+        if( count > 1 )
+            sortItems();
+
+        size_t levelStart = 0;
+        size_t levelEnd = count;
+
+        while( levelEnd - levelStart > 1 )
+        {
+            for( size_t first = levelStart; first < levelEnd; first += NODE_SIZE )
+            {
+                size_t  last = std::min( first + NODE_SIZE, levelEnd );
+                int32_t minX = m_minX[first];
+                int32_t minY = m_minY[first];
+                int32_t maxX = m_maxX[first];
+                int32_t maxY = m_maxY[first];
+
+                for( size_t ii = first + 1; ii < last; ++ii )
+                {
+                    minX = std::min( minX, m_minX[ii] );
+                    minY = std::min( minY, m_minY[ii] );
+                    maxX = std::max( maxX, m_maxX[ii] );
+                    maxY = std::max( maxY, m_maxY[ii] );
+                }
+
+                m_minX.push_back( minX );
+                m_minY.push_back( minY );
+                m_maxX.push_back( maxX );
+                m_maxY.push_back( maxY );
+                m_firstChild.push_back( static_cast<uint32_t>( first ) );
+                m_childEnd.push_back( static_cast<uint32_t>( last ) );
+            }
+
+            levelStart = levelEnd;
+            levelEnd = m_minX.size();
+        }
+
+        m_built = true;
+    }
+
+    bool IsBuilt() const { return m_built; }
+
+    size_t Size() const { return m_items.size(); }
+
+    bool Empty() const { return m_items.empty(); }
+
+    /**
+     * @return the items, in Hilbert order once built.
+     */
+    const std::vector<T>& Items() const { return m_items; }
+
+    /**
+     * Call \a aVisitor for each item whose box overlaps (or touches) the query box, until it
+     * returns false.
+     *
+     * @return the number of items visited.
+     */
+    template <class VISITOR>
+    int Search( const int aMin[2], const int aMax[2], VISITOR& aVisitor ) const
+    {
+        if( !m_built || m_items.empty() )
+            return 0;
+
+        const int32_t qMinX = aMin[0];
+        const int32_t qMinY = aMin[1];
+        const int32_t qMaxX = aMax[0];
+        const int32_t qMaxY = aMax[1];
+        const size_t  count = m_items.size();
+        const size_t  root = m_minX.size() - 1;
+        int           found = 0;
+
+        if( m_minX[root] > qMaxX || m_maxX[root] < qMinX
+                || m_minY[root] > qMaxY || m_maxY[root] < qMinY )
+        {
+            return 0;
+        }
+
+        if( root < count )
+        {
+            aVisitor( m_items[root] );
+            return 1;
+        }
+
+        // Depth first, so the stack holds fewer than NODE_SIZE pending nodes per level, and a
+        // 32-bit item count never needs more than 8 levels.
+        uint32_t stack[8 * NODE_SIZE];
+        size_t   depth = 0;
+
+        stack[depth++] = static_cast<uint32_t>( root );
+
+        while( depth > 0 )
+        {
+            const size_t node = stack[--depth] - count;
+            const size_t first = m_firstChild[node];
+            const size_t last = m_childEnd[node];
+            const size_t n = last - first;
+            uint8_t      hits[NODE_SIZE];
+
+            for( size_t ii = 0; ii < n; ++ii )
+            {
+                hits[ii] = ( m_minX[first + ii] <= qMaxX ) & ( m_maxX[first + ii] >= qMinX )
+                         & ( m_minY[first + ii] <= qMaxY ) & ( m_maxY[first + ii] >= qMinY );
+            }
+
+            for( size_t ii = 0; ii < n; ++ii )
+            {
+                if( !hits[ii] )
+                    continue;
+
+                const size_t child = first + ii;
+
+                if( child < count )
+                {
+                    found++;
+
+                    if( !aVisitor( m_items[child] ) )
+                        return found;
+                }
+                else
+                {
+                    stack[depth++] = static_cast<uint32_t>( child );
+                }
+            }
+        }
+
+        return found;
+    }
+
+    template <class VISITOR>
+    int Search( const BOX2I& aBox, VISITOR& aVisitor ) const
+    {
+        const int min[2] = { aBox.GetLeft(), aBox.GetTop() };
+        const int max[2] = { aBox.GetRight(), aBox.GetBottom() };
+
+        return Search( min, max, aVisitor );
+    }
+
+private:
+    void dropNodes()
+    {
+        const size_t count = m_items.size();
+
+        m_minX.resize( count );
+        m_minY.resize( count );
+        m_maxX.resize( count );
+        m_maxY.resize( count );
+        m_firstChild.clear();
+        m_childEnd.clear();
+        m_built = false;
+    }
+
+    void sortItems()
+    {
+        const size_t count = m_items.size();
+        int64_t      minX = *std::min_element( m_minX.begin(), m_minX.end() );
+        int64_t      minY = *std::min_element( m_minY.begin(), m_minY.end() );
+        int64_t      maxX = *std::max_element( m_maxX.begin(), m_maxX.end() );
+        int64_t      maxY = *std::max_element( m_maxY.begin(), m_maxY.end() );
+
+        // Map the box centres onto a 65536 x 65536 grid over the whole extent
+        double scaleX = maxX > minX ? 65535.0 / ( 2.0 * ( maxX - minX ) ) : 0.0;
+        double scaleY = maxY > minY ? 65535.0 / ( 2.0 * ( maxY - minY ) ) : 0.0;
+
+        std::vector<uint32_t> keys( count );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            int64_t cx = int64_t( m_minX[ii] ) + m_maxX[ii] - 2 * minX;
+            int64_t cy = int64_t( m_minY[ii] ) + m_maxY[ii] - 2 * minY;
+
+            keys[ii] = HilbertIndex( static_cast<uint32_t>( cx * scaleX ),
+                                     static_cast<uint32_t>( cy * scaleY ) );
+        }
+
+        std::vector<uint32_t> order( count );
+        std::iota( order.begin(), order.end(), 0 );
+
+        std::stable_sort( order.begin(), order.end(),
+                          [&]( uint32_t a, uint32_t b )
+                          {
+                              return keys[a] < keys[b];
+                          } );
+
+        auto permute =
+                [&]( auto& aVector )
+                {
+                    std::remove_reference_t<decltype( aVector )> sorted;
+                    sorted.reserve( aVector.size() );
+
+                    for( uint32_t idx : order )
+                        sorted.push_back( aVector[idx] );
+
+                    aVector = std::move( sorted );
+                };
+
+        permute( m_items );
+        permute( m_minX );
+        permute( m_minY );
+        permute( m_maxX );
+        permute( m_maxY );
+    }
+
+    std::vector<T>        m_items;
+
+    // Boxes of the items, then of the nodes level by level; the root is the last one
+    std::vector<int32_t>  m_minX;
+    std::vector<int32_t>  m_minY;
+    std::vector<int32_t>  m_maxX;
+    std::vector<int32_t>  m_maxY;
+
+    // Children of node i (at box index item count + i) are the boxes [first, end)
+    std::vector<uint32_t> m_firstChild;
+    std::vector<uint32_t> m_childEnd;
+
+    bool                  m_built = false;
+};
+
+#endif // PACKED_RTREE_H
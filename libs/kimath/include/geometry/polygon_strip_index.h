@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef POLYGON_STRIP_INDEX_H
+#define POLYGON_STRIP_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include <math/vector2d.h>
+
+class SHAPE_LINE_CHAIN;
+
+/**
+ * A horizontal strip decomposition of a closed contour for testing many points against it.
+ *
+ * The non-horizontal edges are bucketed into strips of equal height, so a point is only tested
+ * against the edges crossing its strip.  The crossing-number test of a strip is a branch-free
+ * loop over structure-of-arrays edge data which the compiler can vectorize; points closer than
+ * a unit to an edge are tested again in exact integer arithmetic, so the results are the same
+ * as SHAPE_LINE_CHAIN::PointInside() with an accuracy of 0 or 1.
+ *
+ * The index is a snapshot: it must be rebuilt when the contour changes.
+ */
+class POLYGON_STRIP_INDEX
+{
+public:
+    POLYGON_STRIP_INDEX() = default;
+
+    explicit POLYGON_STRIP_INDEX( const SHAPE_LINE_CHAIN& aContour ) { Build( aContour ); }
+
+    void Build( const SHAPE_LINE_CHAIN& aContour );
+
+    bool PointInside( const VECTOR2I& aPt ) const;
+
+    /**
+     * Set \a aInside[i] if \a aPoints[i] is inside the contour.
+     */
+    void PointsInside( const std::vector<VECTOR2I>& aPoints, std::vector<uint8_t>& aInside ) const;
+
+private:
+    bool exactPointInside( const VECTOR2I& aPt, size_t aFirst, size_t aLast ) const;
+
+    bool    m_valid = false;
+    int     m_minY = 0;
+    int     m_maxY = 0;
+    int     m_maxX = 0;
+    int64_t m_stripHeight = 1;
+
+    // Edges of strip s are [m_stripStart[s], m_stripStart[s + 1]); an edge crossing several
+    // strips appears in each of them
+    std::vector<uint32_t> m_stripStart;
+
+    std::vector<double>   m_x1;
+    std::vector<double>   m_y1;
+    std::vector<double>   m_slope;  ///< dx / dy
+    std::vector<double>   m_yLow;
+    std::vector<double>   m_yHigh;
+
+    // Integer edge data, for the exact test
+    std::vector<VECTOR2I> m_p1;
+    std::vector<VECTOR2I> m_p2;
+};
+
+#endif // POLYGON_STRIP_INDEX_H
@@ -142,9 +142,12 @@ public:
       */
     int Side( const VECTOR2I& aP ) const
     {
-        const ecoord det = ( B - A ).Cross( aP - A );
+        // Differences are taken in 64 bits and the cross product compared in 128 bits, so the
+        // result is exact over the whole coordinate range
+        const VECTOR2L d = VECTOR2L( B ) - A;
+        const VECTOR2L p = VECTOR2L( aP ) - A;
 
-        return det < 0 ? -1 : ( det > 0 ? 1 : 0 );
+        return CompareProducts( d.x, p.y, d.y, p.x );
     }
 
     /**
@@ -0,0 +1,81 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SEG_BATCH_H
+#define SEG_BATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include <geometry/seg.h>
+
+/**
+ * A structure-of-arrays batch of segments, tested against one reference segment at a time.
+ *
+ * The kernels are branch-free loops over the coordinate arrays so that the compiler vectorizes
+ * them for whatever SIMD instruction set the build targets, falling back to scalar code
+ * otherwise.  They work in double precision, so their results are approximations; the
+ * collision mask is conservative, i.e. it may flag a segment which SEG::Collide() would
+ * reject, but never misses one it would accept.
+ */
+class SEG_BATCH
+{
+public:
+    void Clear();
+
+    void Reserve( size_t aSize );
+
+    /**
+     * Add a segment to the batch.
+     *
+     * @param aRadius is added to the clearance of the segment in Collide() (e.g. half the
+     *                width of a track).
+     */
+    void Add( const SEG& aSeg, int aRadius = 0 );
+
+    size_t Size() const { return m_ax.size(); }
+
+    bool Empty() const { return m_ax.empty(); }
+
+    /**
+     * Compute the squared distance (as SEG::SquaredDistance() would, in double precision)
+     * between \a aRef and each segment of the batch.
+     */
+    void SquaredDistances( const SEG& aRef, std::vector<double>& aDistances ) const;
+
+    /**
+     * Set \a aMask[i] if the segment i of the batch may be closer to \a aRef than \a aClearance
+     * plus its radius.
+     */
+    void Collide( const SEG& aRef, int aClearance, std::vector<uint8_t>& aMask ) const;
+
+private:
+    // Coordinates, as doubles so that the kernels only use one lane type
+    std::vector<double> m_ax;
+    std::vector<double> m_ay;
+    std::vector<double> m_bx;
+    std::vector<double> m_by;
+    std::vector<double> m_radius;
+};
+
+#endif // SEG_BATCH_H
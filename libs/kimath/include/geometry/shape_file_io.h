@@ -53,6 +53,12 @@ public:
     void BeginGroup( const std::string& aName = "<noname>");
     void EndGroup();
 
+    /**
+     * Read the next polygon set written by Write().  Other shapes are skipped, as their
+     * format cannot be read back.
+     *
+     * @return the shape, owned by the caller, or nullptr at the end of the file.
+     */
     SHAPE* Read();
 
     void Write( const SHAPE* aShape, const std::string& aName = "<noname>" );
@@ -31,6 +31,7 @@
 #include <atomic>
 #include <cstdio>
 #include <deque>                        // for deque
+#include <functional>
 #include <iosfwd>                       // for string, stringstream
 #include <memory>
 #include <mutex>
@@ -166,6 +167,7 @@ public:
             if( this != &aOther )
             {
                 m_sourceOutline = aOther.m_sourceOutline;
+                m_sourceHash = aOther.m_sourceHash;
                 m_triangles = std::move( aOther.m_triangles );
                 m_vertices = std::move( aOther.m_vertices );
 
@@ -188,6 +190,13 @@ public:
         int GetSourceOutlineIndex() const { return m_sourceOutline; }
         void SetSourceOutlineIndex( int aIndex ) { m_sourceOutline = aIndex; }
 
+        /**
+         * Hash of the outline (with its holes) this triangulation was built from, or an empty
+         * hash if unknown.  Used to keep the triangulation of unchanged outlines.
+         */
+        const HASH_128& GetSourceHash() const { return m_sourceHash; }
+        void SetSourceHash( const HASH_128& aHash ) { m_sourceHash = aHash; }
+
         const std::deque<TRI>& Triangles() const { return m_triangles; }
         void SetTriangles( const std::deque<TRI>& aTriangles )
         {
@@ -215,10 +224,13 @@ public:
         {
             for( VECTOR2I& vertex : m_vertices )
                 vertex += aVec;
+
+            m_sourceHash.Clear();
         }
 
     private:
         int                  m_sourceOutline;
+        HASH_128             m_sourceHash;
         std::deque<TRI>      m_triangles;
         std::deque<VECTOR2I> m_vertices;
     };
@@ -580,8 +592,30 @@ public:
      */
     virtual void CacheTriangulation( bool aPartition = true, bool aSimplify = false )
     {
-        cacheTriangulation( aPartition, aSimplify, nullptr );
+        cacheTriangulation( aPartition, aSimplify, nullptr, nullptr );
     }
+
+    /**
+     * Run a job for every index in [0, aCount) and return once all of them are done.  The jobs
+     * may run concurrently.
+     */
+    using PARALLEL_FOR = std::function<void( size_t aCount,
+                                             const std::function<void( size_t )>& aJob )>;
+
+    /**
+     * Same as CacheTriangulation(), but the outlines and their grid partitions are processed
+     * through \a aParallelFor.
+     */
+    void CacheTriangulation( bool aPartition, bool aSimplify, const PARALLEL_FOR& aParallelFor )
+    {
+        cacheTriangulation( aPartition, aSimplify, nullptr, &aParallelFor );
+    }
+
+    /**
+     * Keep a copy of the triangulation of \a aPrevious, so the next partitioned triangulation
+     * of this set only triangulates the outlines which are not identical in \a aPrevious.
+     */
+    void ReuseTriangulationFrom( const SHAPE_POLY_SET& aPrevious );
     bool IsTriangulationUpToDate() const;
 
     HASH_128 GetHash() const;
@@ -1065,11 +1099,24 @@ public:
     void Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError,
                   bool aSimplify = false );
 
+    /**
+     * Same as Inflate(), but outlines that cannot meet once inflated are offset in separate
+     * groups through \a aParallelFor.  The outlines of the result may come in another order.
+     */
+    void Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError, bool aSimplify,
+                  const PARALLEL_FOR& aParallelFor );
+
     void Deflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError )
     {
         Inflate( -aAmount, aCornerStrategy, aMaxError );
     }
 
+    void Deflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError,
+                  const PARALLEL_FOR& aParallelFor )
+    {
+        Inflate( -aAmount, aCornerStrategy, aMaxError, false, aParallelFor );
+    }
+
     /**
      * Perform offsetting of a line chain. Replaces this polygon set with the result.
      *
@@ -1280,6 +1327,16 @@ public:
     bool Contains( const VECTOR2I& aP, int aSubpolyIndex = -1, int aAccuracy = 0,
                    bool aUseBBoxCaches = false ) const;
 
+    /**
+     * Test many points at once: set \a aResult[i] to Contains( aPoints[i], -1, aAccuracy ).
+     *
+     * Each contour is indexed once (see POLYGON_STRIP_INDEX) and then only tested against the
+     * points inside its bounding box, which is much faster than calling Contains() in a loop
+     * when there are many points.
+     */
+    void ContainsPoints( const std::vector<VECTOR2I>& aPoints, std::vector<uint8_t>& aResult,
+                         int aAccuracy = 0 ) const;
+
     /// Return true if the set is empty (no polygons at all)
     bool IsEmpty() const
     {
@@ -1484,7 +1541,8 @@ public:
 
 protected:
     void cacheTriangulation( bool aPartition, bool aSimplify,
-                             std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData );
+                             std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData,
+                             const PARALLEL_FOR* aParallelFor );
 
 private:
     enum DROP_TRIANGULATION_FLAG { SINGLETON };
@@ -1587,6 +1645,9 @@ protected:
     std::atomic<bool> m_triangulationValid = false;
     std::mutex  m_triangulationMutex;
 
+    /// Triangulations of a previous version of this set, see ReuseTriangulationFrom()
+    std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_reusableTriangulation;
+
 private:
     HASH_128 m_hash;
     bool     m_hashValid = false;
@@ -208,6 +208,25 @@ public:
         m_radius = aRadius;
     }
 
+    /**
+     * A rounded rectangle is exactly its inner sharp rectangle inflated by the corner radius,
+     * so distances to it are the distances to the inner rectangle minus the radius.
+     *
+     * @param aRadius is set to the corner radius, clamped to half the minor dimension.
+     * @return the normalized inner rectangle, without rounded corners.
+     */
+    SHAPE_RECT GetRoundRectCore( int& aRadius ) const
+    {
+        const int w = std::abs( m_w );
+        const int h = std::abs( m_h );
+
+        aRadius = std::clamp( m_radius, 0, std::min( w, h ) / 2 );
+
+        return SHAPE_RECT( std::min( m_p0.x, m_p0.x + m_w ) + aRadius,
+                           std::min( m_p0.y, m_p0.y + m_h ) + aRadius,
+                           w - 2 * aRadius, h - 2 * aRadius );
+    }
+
     void Move( const VECTOR2I& aVector ) override
     {
         m_p0 += aVector;
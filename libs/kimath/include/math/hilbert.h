@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef HILBERT_H
+#define HILBERT_H
+
+#include <cstdint>
+
+/**
+ * Position of (x, y) along a 16-bit Hilbert curve, after the branch-free algorithm by
+ * Fabian Giesen.
+ *
+ * Sorting points by this index keeps points that are close on the plane mostly close in the
+ * sorted order.
+ *
+ * @param x, y are the coordinates on a 65536 x 65536 grid, so must be below 65536.
+ */
+inline uint32_t HilbertIndex( uint32_t x, uint32_t y )
+{
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ ( x | y );
+    uint32_t d = x & ( y ^ 0xFFFF );
+
+    uint32_t A = a | ( b >> 1 );
+    uint32_t B = ( a >> 1 ) ^ a;
+    uint32_t C = ( ( c >> 1 ) ^ ( b & ( d >> 1 ) ) ) ^ c;
+    uint32_t D = ( ( a & ( c >> 1 ) ) ^ ( d >> 1 ) ) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = ( a & ( a >> 2 ) ) ^ ( b & ( b >> 2 ) );
+    B = ( a & ( b >> 2 ) ) ^ ( b & ( ( a ^ b ) >> 2 ) );
+    C ^= ( a & ( c >> 2 ) ) ^ ( b & ( d >> 2 ) );
+    D ^= ( b & ( c >> 2 ) ) ^ ( ( a ^ b ) & ( d >> 2 ) );
+
+    a = A; b = B; c = C; d = D;
+    A = ( a & ( a >> 4 ) ) ^ ( b & ( b >> 4 ) );
+    B = ( a & ( b >> 4 ) ) ^ ( b & ( ( a ^ b ) >> 4 ) );
+    C ^= ( a & ( c >> 4 ) ) ^ ( b & ( d >> 4 ) );
+    D ^= ( b & ( c >> 4 ) ) ^ ( ( a ^ b ) & ( d >> 4 ) );
+
+    a = A; b = B; c = C; d = D;
+    C ^= ( a & ( c >> 8 ) ) ^ ( b & ( d >> 8 ) );
+    D ^= ( b & ( c >> 8 ) ) ^ ( ( a ^ b ) & ( d >> 8 ) );
+
+    a = C ^ ( C >> 1 );
+    b = D ^ ( D >> 1 );
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | ( 0xFFFF ^ ( i0 | a ) );
+
+    auto spread =
+            []( uint32_t v )
+            {
+                v = ( v | ( v << 8 ) ) & 0x00FF00FF;
+                v = ( v | ( v << 4 ) ) & 0x0F0F0F0F;
+                v = ( v | ( v << 2 ) ) & 0x33333333;
+                v = ( v | ( v << 1 ) ) & 0x55555555;
+                return v;
+            };
+
+    return ( spread( i1 ) << 1 ) | spread( i0 );
+}
+
+#endif // HILBERT_H
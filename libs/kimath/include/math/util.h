@@ -154,6 +154,27 @@ int rescale( int aNumerator, int aValue, int aDenominator );
 template <>
 int64_t rescale( int64_t aNumerator, int64_t aValue, int64_t aDenominator );
 
+/**
+ * Compare two products of 64-bit integers exactly, without overflow and without dividing.
+ *
+ * This is the building block of the exact geometric predicates: orientation tests are the
+ * sign of aA * aB - aC * aD, and "closer than" tests compare a squared cross product against
+ * a squared threshold times a squared length.
+ *
+ * @return -1, 0 or 1 when aA * aB is less than, equal to or greater than aC * aD.
+ */
+#if defined( __SIZEOF_INT128__ )
+inline int CompareProducts( int64_t aA, int64_t aB, int64_t aC, int64_t aD )
+{
+    const __int128_t lhs = (__int128_t) aA * aB;
+    const __int128_t rhs = (__int128_t) aC * aD;
+
+    return ( lhs > rhs ) - ( lhs < rhs );
+}
+#else
+int CompareProducts( int64_t aA, int64_t aB, int64_t aC, int64_t aD );
+#endif
+
 
 /**
  * Template to compare two floating point values for equality within a required epsilon.
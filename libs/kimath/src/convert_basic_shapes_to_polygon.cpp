@@ -57,6 +57,8 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCente
         radius += GetCircleToPolyCorrection( actual_delta_radius );
     }
 
+    aBuffer.ReservePoints( aBuffer.PointCount() + numSegs );
+
     for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
     {
         corner_position.x = radius;
@@ -92,7 +94,8 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter,
         radius += GetCircleToPolyCorrection( actual_delta_radius );
     }
 
-    aBuffer.NewOutline();
+    int idx = aBuffer.NewOutline();
+    aBuffer.Outline( idx ).ReservePoints( numSegs + 1 );
 
     for( EDA_ANGLE angle = delta / 2; angle < ANGLE_360; angle += delta )
     {
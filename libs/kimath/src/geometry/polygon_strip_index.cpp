@@ -0,0 +1,204 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry/polygon_strip_index.h>
+#include <geometry/shape_line_chain.h>
+#include <math/util.h>
+
+
+void POLYGON_STRIP_INDEX::Build( const SHAPE_LINE_CHAIN& aContour )
+{
+    m_valid = false;
+    m_stripStart.clear();
+    m_x1.clear();
+    m_y1.clear();
+    m_slope.clear();
+    m_yLow.clear();
+    m_yHigh.clear();
+    m_p1.clear();
+    m_p2.clear();
+
+    const std::vector<VECTOR2I>& points = aContour.CPoints();
+    const size_t                 pointCount = points.size();
+
+    if( !aContour.IsClosed() || pointCount < 3 )
+        return;
+
+    std::vector<size_t> edges;
+    edges.reserve( pointCount );
+
+    m_minY = std::numeric_limits<int>::max();
+    m_maxY = std::numeric_limits<int>::min();
+    m_maxX = std::numeric_limits<int>::min();
+
+    for( size_t ii = 0; ii < pointCount; ++ii )
+    {
+        const VECTOR2I& p1 = points[ii];
+        const VECTOR2I& p2 = points[ii + 1 == pointCount ? 0 : ii + 1];
+
+        m_maxX = std::max( { m_maxX, p1.x, p2.x } );
+
+        // Horizontal edges never change the crossing count
+        if( p1.y == p2.y )
+            continue;
+
+        m_minY = std::min( { m_minY, p1.y, p2.y } );
+        m_maxY = std::max( { m_maxY, p1.y, p2.y } );
+        edges.push_back( ii );
+    }
+
+    m_valid = true;
+
+    if( edges.empty() )
+        return;
+
+    // A few edges per strip keeps both the strip lists and the per-point loops short
+    const size_t stripCount = std::clamp<size_t>( edges.size() / 4, 1, 4096 );
+    const int64_t height = int64_t( m_maxY ) - m_minY;
+
+    m_stripHeight = std::max<int64_t>( 1, ( height + stripCount - 1 ) / stripCount );
+
+    // Strip s holds the points with y in ( minY + s * h, minY + ( s + 1 ) * h ], and an edge
+    // can only be crossed by points with y in ( yLow, yHigh ]
+    auto stripRange =
+            [&]( const VECTOR2I& p1, const VECTOR2I& p2 )
+            {
+                int64_t low = std::min( p1.y, p2.y );
+                int64_t high = std::max( p1.y, p2.y );
+
+                return std::make_pair( size_t( ( low - m_minY ) / m_stripHeight ),
+                                       size_t( ( high - m_minY - 1 ) / m_stripHeight ) );
+            };
+
+    std::vector<uint32_t> counts( stripCount + 1, 0 );
+
+    for( size_t edge : edges )
+    {
+        auto [first, last] = stripRange( points[edge], points[edge + 1 == pointCount ? 0 : edge + 1] );
+
+        for( size_t s = first; s <= last; ++s )
+            counts[s + 1]++;
+    }
+
+    for( size_t s = 0; s < stripCount; ++s )
+        counts[s + 1] += counts[s];
+
+    m_stripStart = counts;
+
+    const size_t total = counts.back();
+
+    m_x1.resize( total );
+    m_y1.resize( total );
+    m_slope.resize( total );
+    m_yLow.resize( total );
+    m_yHigh.resize( total );
+    m_p1.resize( total );
+    m_p2.resize( total );
+
+    for( size_t edge : edges )
+    {
+        const VECTOR2I& p1 = points[edge];
+        const VECTOR2I& p2 = points[edge + 1 == pointCount ? 0 : edge + 1];
+        auto [first, last] = stripRange( p1, p2 );
+
+        for( size_t s = first; s <= last; ++s )
+        {
+            uint32_t pos = counts[s]++;
+
+            m_x1[pos] = p1.x;
+            m_y1[pos] = p1.y;
+            m_slope[pos] = double( p2.x - p1.x ) / double( p2.y - p1.y );
+            m_yLow[pos] = std::min( p1.y, p2.y );
+            m_yHigh[pos] = std::max( p1.y, p2.y );
+            m_p1[pos] = p1;
+            m_p2[pos] = p2;
+        }
+    }
+}
+
+
+bool POLYGON_STRIP_INDEX::exactPointInside( const VECTOR2I& aPt, size_t aFirst, size_t aLast ) const
+{
+    // Same test as SHAPE_LINE_CHAIN_BASE::PointInside()
+    bool inside = false;
+
+    for( size_t ii = aFirst; ii < aLast; ++ii )
+    {
+        const VECTOR2I& p1 = m_p1[ii];
+        const VECTOR2I& p2 = m_p2[ii];
+        const VECTOR2I  diff = p2 - p1;
+        const int       d = rescale( diff.x, ( aPt.y - p1.y ), diff.y );
+
+        if( ( ( p1.y >= aPt.y ) != ( p2.y >= aPt.y ) ) && ( aPt.x - p1.x < d ) )
+            inside = !inside;
+    }
+
+    return inside;
+}
+
+
+bool POLYGON_STRIP_INDEX::PointInside( const VECTOR2I& aPt ) const
+{
+    if( !m_valid || m_stripStart.empty() )
+        return false;
+
+    if( aPt.y <= m_minY || aPt.y > m_maxY || aPt.x > m_maxX )
+        return false;
+
+    const size_t strip = size_t( ( int64_t( aPt.y ) - m_minY - 1 ) / m_stripHeight );
+    const size_t first = m_stripStart[strip];
+    const size_t last = m_stripStart[strip + 1];
+    const double px = aPt.x;
+    const double py = aPt.y;
+    int          crossings = 0;
+    int          ambiguous = 0;
+
+    for( size_t ii = first; ii < last; ++ii )
+    {
+        const double t = m_x1[ii] + ( py - m_y1[ii] ) * m_slope[ii] - px;
+        const int    crossed = ( m_yLow[ii] < py ) & ( py <= m_yHigh[ii] );
+
+        crossings += crossed & ( t > 0.0 );
+        ambiguous |= crossed & ( std::abs( t ) <= 1.0 );
+    }
+
+    // Within a unit of an edge the rounding of the exact test decides
+    if( ambiguous )
+        return exactPointInside( aPt, first, last );
+
+    return crossings & 1;
+}
+
+
+void POLYGON_STRIP_INDEX::PointsInside( const std::vector<VECTOR2I>& aPoints,
+                                        std::vector<uint8_t>&        aInside ) const
+{
+    aInside.resize( aPoints.size() );
+
+    for( size_t ii = 0; ii < aPoints.size(); ++ii )
+        aInside[ii] = PointInside( aPoints[ii] );
+}
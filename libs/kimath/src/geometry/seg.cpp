@@ -91,20 +91,94 @@ SEG::ecoord SEG::SquaredDistance( const SEG& aSeg ) const
     if( Intersects( aSeg ) )
         return 0;
 
-    const VECTOR2I pts[4] =
+    // Disjoint segments are closest at an endpoint of one of them.  Measuring the endpoints
+    // directly is exact, where going through the rounded NearestPoint() was not.
+    return std::min( { aSeg.SquaredDistance( A ), aSeg.SquaredDistance( B ),
+                       SquaredDistance( aSeg.A ), SquaredDistance( aSeg.B ) } );
+}
+
+
+/**
+ * Where the projection of \a aP falls along \a aSeg: -1 at or before A, 1 at or after B and 0
+ * strictly between them.
+ *
+ * The dot products ap.ab and bp.ab reach 2^65 on spans across the whole coordinate range, so
+ * their signs are taken from exact product comparisons rather than from 64-bit sums.
+ */
+static int projectionSide( const SEG& aSeg, const VECTOR2I& aP )
+{
+    const VECTOR2L ab = VECTOR2L( aSeg.B ) - aSeg.A;
+    const VECTOR2L ap = VECTOR2L( aP ) - aSeg.A;
+    const VECTOR2L bp = VECTOR2L( aP ) - aSeg.B;
+
+    if( CompareProducts( ap.x, ab.x, -ap.y, ab.y ) <= 0 )
+        return -1;
+
+    if( CompareProducts( bp.x, ab.x, -bp.y, ab.y ) >= 0 )
+        return 1;
+
+    return 0;
+}
+
+
+/**
+ * @return true if the cross product ab x ap and the squared length of ab fit in 64 bits, which
+ *         holds whenever the components of ab and ap are below 2^31.
+ */
+static bool fitsInt64( const VECTOR2L& aAB, const VECTOR2L& aAP )
+{
+    constexpr SEG::ecoord lim = SEG::ecoord( 1 ) << 31;
+
+    return std::abs( aAB.x ) < lim && std::abs( aAB.y ) < lim
+           && std::abs( aAP.x ) < lim && std::abs( aAP.y ) < lim;
+}
+
+
+/**
+ * Decide whether \a aP is strictly closer than sqrt( \a aDistSq ) to \a aSeg.
+ *
+ * Inside the span of the segment this compares cross^2 against aDistSq * length^2 instead of
+ * dividing, so the answer is exact and needs no rounding.
+ */
+static bool pointCloserThan( const SEG& aSeg, const VECTOR2I& aP, SEG::ecoord aDistSq )
+{
+    switch( projectionSide( aSeg, aP ) )
     {
-        aSeg.NearestPoint( A ) - A,
-        aSeg.NearestPoint( B ) - B,
-        NearestPoint( aSeg.A ) - aSeg.A,
-        NearestPoint( aSeg.B ) - aSeg.B
-    };
+    case -1: return ( VECTOR2L( aP ) - aSeg.A ).SquaredEuclideanNorm() < aDistSq;
+    case 1:  return ( VECTOR2L( aP ) - aSeg.B ).SquaredEuclideanNorm() < aDistSq;
+    default: break;
+    }
 
-    ecoord m = VECTOR2I::ECOORD_MAX;
+    if( aDistSq <= 0 )
+        return false;
 
-    for( int i = 0; i < 4; i++ )
-        m = std::min( m, pts[i].SquaredEuclideanNorm() );
+    const VECTOR2L ab = VECTOR2L( aSeg.B ) - aSeg.A;
+    const VECTOR2L ap = VECTOR2L( aP ) - aSeg.A;
+
+    if( fitsInt64( ab, ap ) )
+    {
+        const SEG::ecoord cross = ab.Cross( ap );
+
+        return CompareProducts( cross, cross, aDistSq, ab.SquaredEuclideanNorm() ) < 0;
+    }
+
+#if defined( __SIZEOF_INT128__ )
+    // |cross| and length^2 are below 2^65.  From |cross| >= 2^64 on, the squared distance
+    // cross^2 / length^2 is at least 2^63, beyond any aDistSq.
+    const __int128_t        cross = (__int128_t) ab.x * ap.y - (__int128_t) ab.y * ap.x;
+    const unsigned __int128 c = cross < 0 ? -cross : cross;
+    const unsigned __int128 f = (__int128_t) ab.x * ab.x + (__int128_t) ab.y * ab.y;
 
-    return m;
+    if( c >> 64 )
+        return false;
+
+    return c * c < (unsigned __int128) aDistSq * f;
+#else
+    const long double cross = (long double) ab.x * ap.y - (long double) ab.y * ap.x;
+    const long double f = (long double) ab.x * ab.x + (long double) ab.y * ab.y;
+
+    return cross * cross < aDistSq * f;
+#endif
 }
 
 
@@ -583,6 +657,16 @@ bool SEG::Collide( const SEG& aSeg, int aClearance, int* aActual ) const
     }
 
     const ecoord clearance_sq = static_cast<ecoord>( aClearance ) * aClearance;
+
+    // Without a distance to report, a division-free exact predicate is enough
+    if( !aActual && aClearance > 0 )
+    {
+        return pointCloserThan( *this, aSeg.A, clearance_sq )
+               || pointCloserThan( *this, aSeg.B, clearance_sq )
+               || pointCloserThan( aSeg, A, clearance_sq )
+               || pointCloserThan( aSeg, B, clearance_sq );
+    }
+
     ecoord min_dist_sq = VECTOR2I::ECOORD_MAX;
 
     auto checkDistance = [&]( ecoord dist, ecoord& min_dist ) -> bool
@@ -713,33 +797,58 @@ int SEG::Distance( const VECTOR2I& aP ) const
 
 SEG::ecoord SEG::SquaredDistance( const VECTOR2I& aP ) const
 {
-    VECTOR2<ecoord> ab( ecoord( B.x ) - A.x, ecoord( B.y ) - A.y );
-    VECTOR2<ecoord> ap( ecoord( aP.x ) - A.x, ecoord( aP.y ) - A.y );
+    switch( projectionSide( *this, aP ) )
+    {
+    case -1: return ( VECTOR2L( aP ) - A ).SquaredEuclideanNorm();
+    case 1:  return ( VECTOR2L( aP ) - B ).SquaredEuclideanNorm();
+    default: break;
+    }
 
-    ecoord e = ap.Dot( ab );
+    const VECTOR2L ab = VECTOR2L( B ) - A;
+    const VECTOR2L ap = VECTOR2L( aP ) - A;
 
-    if( e <= 0 )
-        return ap.SquaredEuclideanNorm();
+    // The squared distance to the line is cross^2 / f.  Computing it from the cross product
+    // rather than as |ap|^2 - e^2 / f avoids cancellation, and is exact: in plain 64 bits when
+    // the rounded numerator fits, through the 128-bit rescale() while cross and f fit in 64 bits
+    // and in 128-bit arithmetic beyond.
+    if( fitsInt64( ab, ap ) )
+    {
+        const ecoord cross = ab.Cross( ap );
+        const ecoord f = ab.SquaredEuclideanNorm();
 
-    ecoord f = ab.SquaredEuclideanNorm();
+        if( cross < ( ecoord( 1 ) << 31 ) && cross > -( ecoord( 1 ) << 31 ) )
+        {
+            const ecoord sq = cross * cross;
 
-    if( e >= f )
-    {
-        VECTOR2<ecoord> bp( ecoord( aP.x ) - B.x, ecoord( aP.y ) - B.y );
+            if( sq <= std::numeric_limits<ecoord>::max() - f / 2 )
+                return ( sq + f / 2 ) / f;
+        }
 
-        return bp.Dot( bp );
+        return rescale( cross, cross, f );
     }
 
-    const double g = ap.SquaredEuclideanNorm() - ( double( e ) * e ) / f;
+#if defined( __SIZEOF_INT128__ )
+    // Wider spans: |cross| and f are below 2^65.  From |cross| >= 2^64 on, the distance is at
+    // least 2^63 and saturates.
+    const __int128_t        cross = (__int128_t) ab.x * ap.y - (__int128_t) ab.y * ap.x;
+    const unsigned __int128 c = cross < 0 ? -cross : cross;
+    const unsigned __int128 f = (__int128_t) ab.x * ab.x + (__int128_t) ab.y * ab.y;
 
-    // The only way g can be negative is if there was a rounding error since
-    // e is the projection of aP onto ab and therefore cannot be greater than
-    // the length of ap and f is guaranteed to be greater than e, meaning
-    // e * e / f cannot be greater than ap.SquaredEuclideanNorm()
-    if( g < 0 || g > static_cast<double>( std::numeric_limits<ecoord>::max() ) )
-        return 0;
+    if( c >> 64 )
+        return std::numeric_limits<ecoord>::max();
+
+    const unsigned __int128 dist = ( c * c + f / 2 ) / f;
+
+    if( dist > (unsigned __int128) std::numeric_limits<ecoord>::max() )
+        return std::numeric_limits<ecoord>::max();
+
+    return (ecoord) dist;
+#else
+    const long double cross = (long double) ab.x * ap.y - (long double) ab.y * ap.x;
+    const long double f = (long double) ab.x * ab.x + (long double) ab.y * ab.y;
 
-    return KiROUND<double, ecoord>( g );
+    return KiROUND<long double, ecoord>( cross * cross / f, true );
+#endif
 }
 
 
@@ -0,0 +1,169 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+
+#include <geometry/seg_batch.h>
+
+
+void SEG_BATCH::Clear()
+{
+    m_ax.clear();
+    m_ay.clear();
+    m_bx.clear();
+    m_by.clear();
+    m_radius.clear();
+}
+
+
+void SEG_BATCH::Reserve( size_t aSize )
+{
+    m_ax.reserve( aSize );
+    m_ay.reserve( aSize );
+    m_bx.reserve( aSize );
+    m_by.reserve( aSize );
+    m_radius.reserve( aSize );
+}
+
+
+void SEG_BATCH::Add( const SEG& aSeg, int aRadius )
+{
+    m_ax.push_back( aSeg.A.x );
+    m_ay.push_back( aSeg.A.y );
+    m_bx.push_back( aSeg.B.x );
+    m_by.push_back( aSeg.B.y );
+    m_radius.push_back( aRadius );
+}
+
+
+/**
+ * Squared distance from the point \a aP (relative to \a aO) to the segment from \a aO along
+ * \a aW, whose squared length is \a aWW.
+ */
+static inline double pointToSegment( double aPx, double aPy, double aWx, double aWy, double aWW )
+{
+    double t = aWW > 0.0 ? ( aPx * aWx + aPy * aWy ) / aWW : 0.0;
+
+    t = std::clamp( t, 0.0, 1.0 );
+
+    double ex = aPx - t * aWx;
+    double ey = aPy - t * aWy;
+
+    return ex * ex + ey * ey;
+}
+
+
+/**
+ * Squared distance between the reference segment from the origin along \a aU, and the segment
+ * from \a aC to \a aD (relative to the start of the reference).
+ */
+static inline double segmentToSegment( double aCx, double aCy, double aDx, double aDy,
+                                       double aUx, double aUy, double aUU )
+{
+    const double vx = aDx - aCx;
+    const double vy = aDy - aCy;
+    const double vv = vx * vx + vy * vy;
+
+    // Endpoints of each segment against the other one
+    const double dist = std::min( std::min( pointToSegment( aCx, aCy, aUx, aUy, aUU ),
+                                            pointToSegment( aDx, aDy, aUx, aUy, aUU ) ),
+                                  std::min( pointToSegment( -aCx, -aCy, vx, vy, vv ),
+                                            pointToSegment( aUx - aCx, aUy - aCy, vx, vy, vv ) ) );
+
+    // Crossing segments.  Orientations within the rounding error count as both sides, so the
+    // test errs on the side of a (conservative) zero distance.
+    const double tol = 1e-12 * ( aUU + vv + aCx * aCx + aCy * aCy + aDx * aDx + aDy * aDy );
+
+    const double o1 = aUx * aCy - aUy * aCx;
+    const double o2 = aUx * aDy - aUy * aDx;
+    const double o3 = vy * aCx - vx * aCy;
+    const double o4 = vx * ( aUy - aCy ) - vy * ( aUx - aCx );
+
+    const bool straddles = std::min( o1, o2 ) <= tol && std::max( o1, o2 ) >= -tol
+                           && std::min( o3, o4 ) <= tol && std::max( o3, o4 ) >= -tol;
+
+    // Collinear segments straddle each other; they only cross if their extents overlap
+    const bool overlaps = std::min( aCx, aDx ) <= std::max( 0.0, aUx )
+                          && std::max( aCx, aDx ) >= std::min( 0.0, aUx )
+                          && std::min( aCy, aDy ) <= std::max( 0.0, aUy )
+                          && std::max( aCy, aDy ) >= std::min( 0.0, aUy );
+
+    return ( straddles && overlaps ) ? 0.0 : dist;
+}
+
+
+void SEG_BATCH::SquaredDistances( const SEG& aRef, std::vector<double>& aDistances ) const
+{
+    const size_t count = Size();
+
+    // Work relative to the start of the reference, which keeps the coordinates small enough
+    // for the products to be accurate.
+    const double ox = aRef.A.x;
+    const double oy = aRef.A.y;
+    const double ux = (double) aRef.B.x - ox;
+    const double uy = (double) aRef.B.y - oy;
+    const double uu = ux * ux + uy * uy;
+
+    const double* ax = m_ax.data();
+    const double* ay = m_ay.data();
+    const double* bx = m_bx.data();
+    const double* by = m_by.data();
+
+    aDistances.resize( count );
+    double* out = aDistances.data();
+
+    for( size_t ii = 0; ii < count; ++ii )
+        out[ii] = segmentToSegment( ax[ii] - ox, ay[ii] - oy, bx[ii] - ox, by[ii] - oy, ux, uy, uu );
+}
+
+
+void SEG_BATCH::Collide( const SEG& aRef, int aClearance, std::vector<uint8_t>& aMask ) const
+{
+    const size_t count = Size();
+
+    const double ox = aRef.A.x;
+    const double oy = aRef.A.y;
+    const double ux = (double) aRef.B.x - ox;
+    const double uy = (double) aRef.B.y - oy;
+    const double uu = ux * ux + uy * uy;
+
+    const double* ax = m_ax.data();
+    const double* ay = m_ay.data();
+    const double* bx = m_bx.data();
+    const double* by = m_by.data();
+    const double* radius = m_radius.data();
+
+    aMask.resize( count );
+    uint8_t* out = aMask.data();
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        double dist = segmentToSegment( ax[ii] - ox, ay[ii] - oy, bx[ii] - ox, by[ii] - oy,
+                                        ux, uy, uu );
+
+        // One extra unit absorbs the rounding of the double precision distance
+        double reach = aClearance + radius[ii] + 1.0;
+
+        out[ii] = dist < reach * reach ? 1 : 0;
+    }
+}
@@ -31,8 +31,13 @@
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <hash.h>
 #include <trigo.h>
 
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
 
 std::ostream& operator<<( std::ostream& aStream, const SHAPE_ARC& aArc )
 {
@@ -286,19 +291,23 @@ bool SHAPE_ARC::Collide( const SEG& aSeg, int aClearance, int* aActual, VECTOR2I
     // 3. Closest point on the segment to the end points of the arc
     // 4. End points of the segment
 
-    std::vector<VECTOR2I> candidatePts = circle.GetCircle().Intersect( aSeg );
+    VECTOR2I candidatePts[7];
+    size_t   candidateCount = 0;
+
+    for( const VECTOR2I& intersection : circle.GetCircle().Intersect( aSeg ) )
+        candidatePts[candidateCount++] = intersection;
 
-    candidatePts.push_back( aSeg.NearestPoint( center ) );
-    candidatePts.push_back( aSeg.NearestPoint( m_start ) );
-    candidatePts.push_back( aSeg.NearestPoint( m_end ) );
-    candidatePts.push_back( aSeg.A );
-    candidatePts.push_back( aSeg.B );
+    candidatePts[candidateCount++] = aSeg.NearestPoint( center );
+    candidatePts[candidateCount++] = aSeg.NearestPoint( m_start );
+    candidatePts[candidateCount++] = aSeg.NearestPoint( m_end );
+    candidatePts[candidateCount++] = aSeg.A;
+    candidatePts[candidateCount++] = aSeg.B;
 
     bool any_collides = false;
 
-    for( const VECTOR2I& candidate : candidatePts )
+    for( size_t ii = 0; ii < candidateCount; ++ii )
     {
-        bool collides = Collide( candidate, aClearance, aActual, aLocation );
+        bool collides = Collide( candidatePts[ii], aClearance, aActual, aLocation );
         any_collides |= collides;
 
         if( collides && ( !aActual || *aActual == 0 ) )
@@ -907,6 +916,88 @@ double SHAPE_ARC::GetRadius() const
 }
 
 
+namespace
+{
+
+/**
+ * Polylines of recently converted arcs.  The same arcs are converted again and again by the
+ * boolean ops, plotters, 3D builder and DRC, so the trigonometry is only done once per arc
+ * and error.  Arcs are keyed on their exact geometry, so a cached polyline is identical to a
+ * fresh conversion.
+ */
+class ARC_POLYLINE_CACHE
+{
+public:
+    struct KEY
+    {
+        VECTOR2I m_Start;
+        VECTOR2I m_Mid;
+        VECTOR2I m_End;
+        int      m_Width;
+        int      m_MaxError;
+
+        bool operator==( const KEY& aOther ) const = default;
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            return hash_val( aKey.m_Start.x, aKey.m_Start.y, aKey.m_Mid.x, aKey.m_Mid.y,
+                             aKey.m_End.x, aKey.m_End.y, aKey.m_Width, aKey.m_MaxError );
+        }
+    };
+
+    /// Arcs approximated by fewer segments are cheaper to compute than to look up
+    static constexpr int MIN_SEGMENTS = 8;
+
+    static ARC_POLYLINE_CACHE& Get()
+    {
+        static ARC_POLYLINE_CACHE cache;
+        return cache;
+    }
+
+    bool Find( const KEY& aKey, size_t aHash, std::vector<VECTOR2I>& aPoints )
+    {
+        SHARD&                      shard = m_shards[aHash % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock( shard.m_Mutex );
+        auto                        it = shard.m_Entries.find( aKey );
+
+        if( it == shard.m_Entries.end() )
+            return false;
+
+        aPoints = it->second;
+        return true;
+    }
+
+    void Store( const KEY& aKey, size_t aHash, const std::vector<VECTOR2I>& aPoints )
+    {
+        SHARD&                      shard = m_shards[aHash % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock( shard.m_Mutex );
+
+        // Crude but cheap bound on the memory used; the working set refills quickly
+        if( shard.m_Entries.size() >= MAX_SHARD_ENTRIES )
+            shard.m_Entries.clear();
+
+        shard.m_Entries.emplace( aKey, aPoints );
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t MAX_SHARD_ENTRIES = 4096;
+
+    struct SHARD
+    {
+        std::mutex                                                m_Mutex;
+        std::unordered_map<KEY, std::vector<VECTOR2I>, KEY_HASH> m_Entries;
+    };
+
+    std::array<SHARD, SHARD_COUNT> m_shards;
+};
+
+} // namespace
+
+
 const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( int aMaxError, int* aActualError ) const
 {
     SHAPE_LINE_CHAIN rv;
@@ -942,12 +1033,31 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( int aMaxError, int* aActual
         effectiveError = CircleToEndSegmentDeltaRadius( external_radius, seg360 );
     }
 
+    if( aActualError )
+        *aActualError = KiROUND( effectiveError );
+
+    const bool                     cacheable = n >= ARC_POLYLINE_CACHE::MIN_SEGMENTS;
+    const ARC_POLYLINE_CACHE::KEY key{ m_start, m_mid, m_end, m_width, aMaxError };
+    const size_t                   keyHash = cacheable ? ARC_POLYLINE_CACHE::KEY_HASH()( key ) : 0;
+    std::vector<VECTOR2I>          points;
+
+    if( cacheable && ARC_POLYLINE_CACHE::Get().Find( key, keyHash, points ) )
+    {
+        rv.ReservePoints( points.size() );
+
+        for( const VECTOR2I& pt : points )
+            rv.Append( pt );
+
+        return rv;
+    }
+
     // Split the error on either side of the arc.  Since we want the start and end points
     // to be exactly on the arc, the first and last segments need to be shorter to stay within
     // the error band (since segments normally start 1/2 the error band outside the arc).
     r += effectiveError / 2;
     n = n * 2;
 
+    rv.ReservePoints( n / 2 + 2 );
     rv.Append( m_start );
 
     for( int i = 1; i < n ; i += 2 )
@@ -965,8 +1075,8 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( int aMaxError, int* aActual
 
     rv.Append( m_end );
 
-    if( aActualError )
-        *aActualError = KiROUND( effectiveError );
+    if( cacheable )
+        ARC_POLYLINE_CACHE::Get().Store( key, keyHash, rv.CPoints() );
 
     return rv;
 }
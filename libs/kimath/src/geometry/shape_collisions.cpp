@@ -72,11 +72,18 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_CIRCLE& aB, int aC
 {
     if( aA.GetRadius() > 0 )
     {
-        wxASSERT_MSG( !aMTV, wxT( "MTV not implemented for SHAPE_RECT to SHAPE_CIRCLE collisions when rect "
-                                  "has rounded corners" ) );
+        // Rounded rect vs circle is the inner rect vs the circle grown by the corner radius
+        int                radius;
+        const SHAPE_RECT   core = aA.GetRoundRectCore( radius );
+        const SHAPE_CIRCLE grown( aB.GetCenter(), aB.GetRadius() + radius );
 
-        const SHAPE_LINE_CHAIN& outline = aA.Outline();
-        return outline.SHAPE::Collide( &aB, aClearance, aActual, aLocation );
+        if( !Collide( core, grown, aClearance, aActual, aLocation, aMTV ) )
+            return false;
+
+        if( aLocation && *aLocation != aB.GetCenter() )
+            *aLocation += ( aB.GetCenter() - *aLocation ).Resize( radius );
+
+        return true;
     }
 
     const VECTOR2I c = aB.GetCenter();
@@ -417,9 +424,24 @@ static inline bool Collide( const SHAPE_LINE_CHAIN_BASE& aA, const SHAPE_LINE_CH
 static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_LINE_CHAIN_BASE& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    if( aA.GetRadius() > 0 )
+    if( aA.GetRadius() > 0 && aMTV )
         return Collide( aA.Outline(), aB, aClearance, aActual, aLocation, aMTV );
 
+    if( aA.GetRadius() > 0 )
+    {
+        // The reported location stays on the inner rectangle
+        int              radius;
+        const SHAPE_RECT core = aA.GetRoundRectCore( radius );
+
+        if( !Collide( core, aB, aClearance + radius, aActual, aLocation, nullptr ) )
+            return false;
+
+        if( aActual )
+            *aActual = std::max( 0, *aActual - radius );
+
+        return true;
+    }
+
     wxASSERT_MSG( !aMTV, wxString::Format( wxT( "MTV not implemented for %s : %s collisions" ),
                                            aA.TypeName(),
                                            aB.TypeName() ) );
@@ -509,9 +531,6 @@ static inline bool Collide( const SHAPE_LINE_CHAIN_BASE& aA, const SHAPE_SEGMENT
 static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_SEGMENT& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    if( aA.GetRadius() > 0 )
-        return Collide( aA.Outline(), aB, aClearance, aActual, aLocation, aMTV );
-
     wxASSERT_MSG( !aMTV, wxString::Format( wxT( "MTV not implemented for %s : %s collisions" ),
                                            aA.TypeName(),
                                            aB.TypeName() ) );
@@ -528,17 +547,62 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_SEGMENT& aB, int a
 static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_RECT& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    if( aClearance || aActual || aLocation || aMTV || aA.GetRadius() > 0 || aB.GetRadius() > 0 )
-    {
+    if( aMTV )
         return Collide( aA.Outline(), aB.Outline(), aClearance, aActual, aLocation, aMTV );
-    }
-    else
-    {
-        BOX2I bboxa = aA.BBox();
-        BOX2I bboxb = aB.BBox();
 
-        return bboxa.Intersects( bboxb );
+    if( !aClearance && !aActual && !aLocation && !aA.GetRadius() && !aB.GetRadius() )
+        return aA.BBox().Intersects( aB.BBox() );
+
+    int         radiusA, radiusB;
+    const BOX2I a = aA.GetRoundRectCore( radiusA ).BBox();
+    const BOX2I b = aB.GetRoundRectCore( radiusB ).BBox();
+    VECTOR2I    ptA, ptB;
+
+    // Nearest points of the inner rectangles, one axis at a time
+    auto nearestOnAxis =
+            []( int aMinA, int aMaxA, int aMinB, int aMaxB, int& aPtA, int& aPtB )
+            {
+                if( aMaxA < aMinB )
+                {
+                    aPtA = aMaxA;
+                    aPtB = aMinB;
+                }
+                else if( aMaxB < aMinA )
+                {
+                    aPtA = aMinA;
+                    aPtB = aMaxB;
+                }
+                else
+                {
+                    aPtA = aPtB = ( int64_t( std::max( aMinA, aMinB ) )
+                                    + std::min( aMaxA, aMaxB ) ) / 2;
+                }
+            };
+
+    nearestOnAxis( a.GetLeft(), a.GetRight(), b.GetLeft(), b.GetRight(), ptA.x, ptB.x );
+    nearestOnAxis( a.GetTop(), a.GetBottom(), b.GetTop(), b.GetBottom(), ptA.y, ptB.y );
+
+    const VECTOR2I delta = ptB - ptA;
+    const ecoord   dist_sq = delta.SquaredEuclideanNorm();
+    const ecoord   radii = ecoord( radiusA ) + radiusB;
+
+    if( dist_sq != 0 && dist_sq > radii * radii && dist_sq >= SEG::Square( radii + aClearance ) )
+        return false;
+
+    const double dist = std::sqrt( dist_sq );
+
+    if( aActual )
+        *aActual = std::max( 0, KiROUND( dist - radii ) );
+
+    if( aLocation )
+    {
+        if( dist_sq == 0 )
+            *aLocation = ptA;
+        else
+            *aLocation = ( ptA + delta.Resize( radiusA ) + ptB - delta.Resize( radiusB ) ) / 2;
     }
+
+    return true;
 }
 
 
@@ -669,9 +733,24 @@ static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN& aB, int
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_RECT& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    if( aB.GetRadius() > 0 )
+    if( aB.GetRadius() > 0 && aMTV )
         return Collide( aA, aB.Outline(), aClearance, aActual, aLocation, aMTV );
 
+    if( aB.GetRadius() > 0 )
+    {
+        // The reported location stays between the arc and the inner rectangle
+        int              radius;
+        const SHAPE_RECT core = aB.GetRoundRectCore( radius );
+
+        if( !Collide( aA, core, aClearance + radius, aActual, aLocation, nullptr ) )
+            return false;
+
+        if( aActual )
+            *aActual = std::max( 0, *aActual - radius );
+
+        return true;
+    }
+
     if( aA.IsEffectiveLine() )
     {
         SHAPE_SEGMENT tmp( aA.GetP0(), aA.GetP1(), aA.GetWidth() );
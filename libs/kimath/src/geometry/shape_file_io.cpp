@@ -25,10 +25,12 @@
  */
 
 #include <cassert>
+#include <sstream>
 #include <string>
 
 #include <geometry/shape.h>
 #include <geometry/shape_file_io.h>
+#include <geometry/shape_poly_set.h>
 
 
 SHAPE_FILE_IO::SHAPE_FILE_IO()
@@ -81,39 +83,51 @@ SHAPE_FILE_IO::~SHAPE_FILE_IO()
 
 SHAPE* SHAPE_FILE_IO::Read()
 {
- /*   char tmp[1024];
+    assert( m_mode == IOM_READ );
 
-    do {
+    if( !m_file )
+        return nullptr;
+
+    std::string line;
+    char        buf[4096];
+
+    while( true )
+    {
+        line.clear();
+
+        while( fgets( buf, sizeof( buf ), m_file ) )
+        {
+            line += buf;
 
-        if (fscanf(m_file, "%s", tmp) != 1)
+            if( !line.empty() && line.back() == '\n' )
+                break;
+        }
+
+        if( line.empty() )
             return nullptr;
 
-        if( !strcmp( tmp, "shape" )
-            break;
-    }
+        std::stringstream ss( line );
+        std::string       keyword, name;
+        int               type = -1;
 
-    int type;
+        ss >> keyword;
 
-    SHAPE *rv = nullptr;
+        if( keyword != "shape" )
+            continue;
 
-    fscanf(m_file,"%d %s", &type, tmp);
+        ss >> type >> name;
 
-    switch(type)
-    {
-        case SHAPE::LINE_CHAIN:
-            rv = new SHAPE_LINE_CHAIN;
-            break;
-    }
+        // Only polygon sets are written in a format that can be read back
+        if( type != SH_POLY_SET )
+            continue;
 
-    if(!rv)
-        return nullptr;
+        SHAPE_POLY_SET* poly = new SHAPE_POLY_SET;
 
-    rv.Parse ( )
+        if( poly->Parse( ss ) )
+            return poly;
 
-    fprintf(m_file,"shape %d %s %s\n", aShape->Type(), aName.c_str(), sh.c_str() );
-*/
-    assert( false );
-    return nullptr;
+        delete poly;
+    }
 }
 
 
@@ -151,7 +165,7 @@ void SHAPE_FILE_IO::Write( const SHAPE* aShape, const std::string& aName )
     if( !m_groupActive )
         fprintf( m_file,"group default\n" );
 
-    std::string sh = aShape->Format();
+    std::string sh = aShape->Format( false );
 
     fprintf( m_file, "shape %d %s %s\n", aShape->Type(), aName.c_str(), sh.c_str() );
     fflush( m_file );
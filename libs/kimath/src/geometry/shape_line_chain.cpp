@@ -156,6 +156,27 @@ Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientati
     bool             orientation = Area( false ) >= 0;
     ssize_t          shape_offset = aArcBuffer.size();
 
+    // Plain polylines carry no arc information, so there is no need to copy the chain or to
+    // fill the Z buffer: the points are emitted directly in the required order.
+    if( m_arcs.empty() )
+    {
+        int pointCount = PointCount();
+        c_path.reserve( pointCount );
+
+        if( orientation == aRequiredOrientation )
+        {
+            for( const VECTOR2I& vertex : m_points )
+                c_path.emplace_back( vertex.x, vertex.y, -1 );
+        }
+        else
+        {
+            for( auto it = m_points.rbegin(); it != m_points.rend(); ++it )
+                c_path.emplace_back( it->x, it->y, -1 );
+        }
+
+        return c_path;
+    }
+
     if( orientation != aRequiredOrientation )
         input = Reverse();
     else
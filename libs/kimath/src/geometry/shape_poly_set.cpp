@@ -36,6 +36,7 @@
 #include <limits>                            // for numeric_limits
 #include <map>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <string> // for char_traits, operator!=
 #include <unordered_set>
@@ -45,6 +46,8 @@
 
 #include <clipper2/clipper.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/packed_rtree.h>
+#include <geometry/polygon_strip_index.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
 #include <geometry/shape.h>
@@ -758,8 +761,9 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                                 const SHAPE_POLY_SET& aOtherShape )
 {
-    if( ( aShape.OutlineCount() > 1 || aOtherShape.OutlineCount() > 0 )
-        && ( aShape.ArcCount() > 0 || aOtherShape.ArcCount() > 0 ) )
+    bool hasArcs = aShape.ArcCount() > 0 || aOtherShape.ArcCount() > 0;
+
+    if( ( aShape.OutlineCount() > 1 || aOtherShape.OutlineCount() > 0 ) && hasArcs )
     {
         wxFAIL_MSG( wxT( "Boolean ops on curved polygons are not supported. You should call "
                          "ClearArcs() before carrying out the boolean operation." ) );
@@ -805,6 +809,10 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
                     {
                         ssize_t retval;
 
+                        // Points coming from arc-free outlines carry no Z value
+                        if( aZvalue < 0 )
+                            return -1;
+
                         retval = zValues.at( aZvalue ).m_SecondArcIdx;
 
                         if( retval == -1 || ( aCompareVal > 0 && retval != aCompareVal ) )
@@ -854,7 +862,9 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
                 //@todo amend X,Y values to true intersection between arcs or arc and segment
             };
 
-    c.SetZCallback( std::move( callback ) ); // register callback
+    // Intersections only need tracking when an arc may pass through them
+    if( hasArcs )
+        c.SetZCallback( std::move( callback ) ); // register callback
 
     c.Execute( aType, Clipper2Lib::FillRule::NonZero, solution );
 
@@ -1130,6 +1140,135 @@ void SHAPE_POLY_SET::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int
 }
 
 
+void SHAPE_POLY_SET::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError,
+                              bool aSimplify, const PARALLEL_FOR& aParallelFor )
+{
+    // Below this many outlines per group, splitting costs more than it saves
+    const size_t minGroupSize = 16;
+    const size_t count = m_polys.size();
+
+    if( count < 2 * minGroupSize )
+    {
+        Inflate( aAmount, aCornerStrategy, aMaxError, aSimplify );
+        return;
+    }
+
+    // Outlines can only interact if their boxes, grown by the largest distance a corner may
+    // move, overlap.  Miter joins can move a corner by up to the miter limit times aAmount.
+    // Deflated outlines only shrink, but overlapping input outlines are still merged.
+    int64_t reach = 1;
+
+    if( aAmount > 0 )
+    {
+        int64_t limit = aCornerStrategy == CORNER_STRATEGY::ALLOW_ACUTE_CORNERS ? 10 : 2;
+        reach += aAmount * limit;
+    }
+
+    std::vector<BOX2I> boxes( count );
+    PACKED_RTREE<int>  tree;
+
+    tree.Reserve( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        if( !m_polys[ii].empty() )
+            boxes[ii] = m_polys[ii][0].BBox();
+
+        boxes[ii].Inflate( static_cast<int>( std::min<int64_t>( reach, INT_MAX / 4 ) ) );
+        tree.Add( boxes[ii], static_cast<int>( ii ) );
+    }
+
+    tree.Build();
+
+    std::vector<size_t> parent( count );
+    std::iota( parent.begin(), parent.end(), 0 );
+
+    auto findRoot =
+            [&]( size_t aIdx )
+            {
+                while( parent[aIdx] != aIdx )
+                {
+                    parent[aIdx] = parent[parent[aIdx]];
+                    aIdx = parent[aIdx];
+                }
+
+                return aIdx;
+            };
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        auto visitor =
+                [&]( int aOther )
+                {
+                    if( static_cast<size_t>( aOther ) > ii )
+                    {
+                        size_t a = findRoot( ii );
+                        size_t b = findRoot( aOther );
+
+                        if( a != b )
+                            parent[std::max( a, b )] = std::min( a, b );
+                    }
+
+                    return true;
+                };
+
+        tree.Search( boxes[ii], visitor );
+    }
+
+    // Gather the clusters, then pack whole clusters into groups of similar size
+    std::vector<std::vector<size_t>> clusters;
+    std::vector<size_t>              clusterOf( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        size_t root = findRoot( ii );
+
+        if( root == ii )
+        {
+            clusterOf[ii] = clusters.size();
+            clusters.emplace_back();
+        }
+
+        clusters[clusterOf[root]].push_back( ii );
+    }
+
+    const size_t groupSize = std::max( minGroupSize, count / 64 );
+    std::deque<SHAPE_POLY_SET> groups( 1 );
+
+    for( const std::vector<size_t>& cluster : clusters )
+    {
+        if( groups.back().m_polys.size() >= groupSize )
+            groups.emplace_back();
+
+        for( size_t idx : cluster )
+            groups.back().m_polys.push_back( std::move( m_polys[idx] ) );
+    }
+
+    int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
+
+    if( groups.size() > 1 )
+    {
+        aParallelFor( groups.size(),
+                      [&]( size_t aGroup )
+                      {
+                          groups[aGroup].inflate2( aAmount, segCount, aCornerStrategy, aSimplify );
+                      } );
+    }
+    else
+    {
+        groups[0].inflate2( aAmount, segCount, aCornerStrategy, aSimplify );
+    }
+
+    m_polys.clear();
+
+    for( SHAPE_POLY_SET& group : groups )
+    {
+        for( POLYGON& poly : group.m_polys )
+            m_polys.push_back( std::move( poly ) );
+    }
+}
+
+
 void SHAPE_POLY_SET::OffsetLineChain( const SHAPE_LINE_CHAIN& aLine, int aAmount,
                                   CORNER_STRATEGY aCornerStrategy, int aMaxError, bool aSimplify )
 {
@@ -2084,6 +2223,27 @@ const std::string SHAPE_POLY_SET::Format( bool aCplusPlus ) const
 {
     std::stringstream ss;
 
+    // The plain format is the one read back by Parse()
+    if( !aCplusPlus )
+    {
+        ss << "polyset " << m_polys.size();
+
+        for( const POLYGON& poly : m_polys )
+        {
+            ss << " poly " << poly.size();
+
+            for( const SHAPE_LINE_CHAIN& chain : poly )
+            {
+                ss << " " << chain.PointCount();
+
+                for( const VECTOR2I& pt : chain.CPoints() )
+                    ss << " " << pt.x << " " << pt.y;
+            }
+        }
+
+        return ss.str();
+    }
+
     ss << "SHAPE_LINE_CHAIN poly; \n";
 
     for( unsigned i = 0; i < m_polys.size(); i++ )
@@ -2587,6 +2747,70 @@ bool SHAPE_POLY_SET::Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccur
 }
 
 
+void SHAPE_POLY_SET::ContainsPoints( const std::vector<VECTOR2I>& aPoints,
+                                     std::vector<uint8_t>& aResult, int aAccuracy ) const
+{
+    aResult.assign( aPoints.size(), 0 );
+
+    std::vector<size_t> candidates;
+
+    for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
+    {
+        const SHAPE_LINE_CHAIN& outline = COutline( polygonIdx );
+        BOX2I                   bbox = outline.BBox();
+
+        // Points within aAccuracy of an edge count as inside
+        if( aAccuracy > 1 )
+            bbox.Inflate( aAccuracy );
+
+        candidates.clear();
+
+        for( size_t ii = 0; ii < aPoints.size(); ++ii )
+        {
+            if( !aResult[ii] && bbox.Contains( aPoints[ii] ) )
+                candidates.push_back( ii );
+        }
+
+        if( candidates.empty() )
+            continue;
+
+        POLYGON_STRIP_INDEX outlineIndex( outline );
+
+        // Keep only the points inside the outline; see containsSingle() for the accuracy rules
+        candidates.erase( std::remove_if( candidates.begin(), candidates.end(),
+                                          [&]( size_t ii )
+                                          {
+                                              const VECTOR2I& pt = aPoints[ii];
+
+                                              if( outlineIndex.PointInside( pt ) )
+                                                  return false;
+
+                                              return aAccuracy <= 1
+                                                     || !outline.PointOnEdge( pt, aAccuracy );
+                                          } ),
+                          candidates.end() );
+
+        for( int holeIdx = 0; holeIdx < HoleCount( polygonIdx ) && !candidates.empty(); holeIdx++ )
+        {
+            const SHAPE_LINE_CHAIN& hole = CHole( polygonIdx, holeIdx );
+            const BOX2I             holeBBox = hole.BBox();
+            POLYGON_STRIP_INDEX     holeIndex( hole );
+
+            candidates.erase( std::remove_if( candidates.begin(), candidates.end(),
+                                              [&]( size_t ii )
+                                              {
+                                                  return holeBBox.Contains( aPoints[ii] )
+                                                         && holeIndex.PointInside( aPoints[ii] );
+                                              } ),
+                              candidates.end() );
+        }
+
+        for( size_t ii : candidates )
+            aResult[ii] = 1;
+    }
+}
+
+
 void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 {
     VERTEX_INDEX index;
@@ -3002,15 +3226,56 @@ static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aP
 }
 
 
+static HASH_128 outlineChecksum( const SHAPE_POLY_SET::POLYGON& aPolygon, bool aSimplify )
+{
+    MMH3_HASH hash( 0x68AF835D ); // Same seed as SHAPE_POLY_SET::checksum()
+
+    hash.add( aSimplify );
+    hash.add( aPolygon.size() );
+
+    for( const SHAPE_LINE_CHAIN& lc : aPolygon )
+    {
+        hash.add( lc.PointCount() );
+
+        for( const VECTOR2I& pt : lc.CPoints() )
+        {
+            hash.add( pt.x );
+            hash.add( pt.y );
+        }
+    }
+
+    return hash.digest();
+}
+
+
+void SHAPE_POLY_SET::ReuseTriangulationFrom( const SHAPE_POLY_SET& aPrevious )
+{
+    if( &aPrevious == this || !aPrevious.IsTriangulationUpToDate() )
+        return;
+
+    m_reusableTriangulation.clear();
+
+    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : aPrevious.m_triangulatedPolys )
+    {
+        if( !( tri->GetSourceHash() == HASH_128() ) )
+            m_reusableTriangulation.push_back( std::make_unique<TRIANGULATED_POLYGON>( *tri ) );
+    }
+}
+
+
 void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
-                                         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData )
+                                         std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>* aHintData,
+                                         const PARALLEL_FOR* aParallelFor )
 {
     std::unique_lock<std::mutex> lock( m_triangulationMutex );
 
     if( m_triangulationValid && m_hashValid )
     {
         if( m_hash == checksum() )
+        {
+            m_reusableTriangulation.clear();
             return;
+        }
     }
 
     // Invalidate, in case anything goes wrong below
@@ -3068,44 +3333,213 @@ void SHAPE_POLY_SET::cacheTriangulation( bool aPartition, bool aSimplify,
                 return triangulationValid;
             };
 
-    m_triangulatedPolys.clear();
+    auto runJobs =
+            [&]( size_t aCount, const std::function<void( size_t )>& aJob )
+            {
+                if( aParallelFor && *aParallelFor )
+                {
+                    ( *aParallelFor )( aCount, aJob );
+                }
+                else
+                {
+                    for( size_t ii = 0; ii < aCount; ++ii )
+                        aJob( ii );
+                }
+            };
 
     if( aPartition )
     {
+        using TRI_LIST = std::vector<std::unique_ptr<TRIANGULATED_POLYGON>>;
+
+        // Previous triangulations, grouped by source outline and keyed by the outline hash
+        std::map<std::pair<uint64_t, uint64_t>, std::deque<TRI_LIST>> previous;
+
+        auto collectPrevious =
+                [&]( TRI_LIST& aList )
+                {
+                    TRI_LIST* group = nullptr;
+                    int       groupOutline = 0;
+
+                    for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : aList )
+                    {
+                        const HASH_128& hash = tri->GetSourceHash();
+
+                        if( hash == HASH_128() )
+                            continue;
+
+                        if( !group || tri->GetSourceOutlineIndex() != groupOutline )
+                        {
+                            group = &previous[{ hash.Value64[0], hash.Value64[1] }].emplace_back();
+                            groupOutline = tri->GetSourceOutlineIndex();
+                        }
+
+                        group->push_back( std::move( tri ) );
+                    }
+
+                    aList.clear();
+                };
+
+        collectPrevious( m_triangulatedPolys );
+        collectPrevious( m_reusableTriangulation );
+
+        struct OUTLINE_JOB
+        {
+            int            m_outline;
+            HASH_128       m_hash;
+            SHAPE_POLY_SET m_partitions;
+            TRI_LIST       m_result;
+            bool           m_valid = false;
+        };
+
+        // A deque, as the jobs hold move-only triangulations and cannot be reallocated
+        std::vector<TRI_LIST>   reused( OutlineCount() );
+        std::deque<OUTLINE_JOB> jobs;
+
         for( int ii = 0; ii < OutlineCount(); ++ii )
         {
-            // This partitions into regularly-sized grids (1cm in Pcbnew)
-            SHAPE_POLY_SET flattened( Outline( ii ) );
+            HASH_128 hash = outlineChecksum( CPolygon( ii ), aSimplify );
+            auto     it = previous.find( { hash.Value64[0], hash.Value64[1] } );
 
-            for( int jj = 0; jj < HoleCount( ii ); ++jj )
-                flattened.AddHole( Hole( ii, jj ) );
+            if( it != previous.end() && !it->second.empty() )
+            {
+                reused[ii] = std::move( it->second.front() );
+                it->second.pop_front();
+            }
+            else
+            {
+                jobs.push_back( { ii, hash, SHAPE_POLY_SET(), TRI_LIST() } );
+            }
+        }
+
+        previous.clear();
+
+        // This partitions into regularly-sized grids (1cm in Pcbnew)
+        runJobs( jobs.size(),
+                 [&]( size_t aJob )
+                 {
+                     OUTLINE_JOB&   job = jobs[aJob];
+                     SHAPE_POLY_SET flattened( COutline( job.m_outline ) );
+
+                     for( int jj = 0; jj < HoleCount( job.m_outline ); ++jj )
+                         flattened.AddHole( CHole( job.m_outline, jj ) );
+
+                     flattened.ClearArcs();
+
+                     if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
+                         flattened.Fracture();
+                     else if( aSimplify )
+                         flattened.Simplify();
+
+                     job.m_partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+                 } );
+
+        // The grid cells of all outlines are independent, so a single large outline can still
+        // be spread over several threads
+        std::vector<std::pair<size_t, int>> cells;
+
+        for( size_t jj = 0; jj < jobs.size(); ++jj )
+        {
+            OUTLINE_JOB& job = jobs[jj];
+
+            job.m_result.resize( job.m_partitions.OutlineCount() );
 
-            flattened.ClearArcs();
+            for( int cell = 0; cell < job.m_partitions.OutlineCount(); ++cell )
+                cells.emplace_back( jj, cell );
+        }
+
+        std::vector<char> cellFailed( cells.size(), 0 );
+
+        runJobs( cells.size(),
+                 [&]( size_t aCell )
+                 {
+                     OUTLINE_JOB& job = jobs[cells[aCell].first];
+                     int          cell = cells[aCell].second;
+
+                     auto tri = std::make_unique<TRIANGULATED_POLYGON>( job.m_outline );
+                     POLYGON_TRIANGULATION tess( *tri );
 
-            if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
-                flattened.Fracture();
-            else if( aSimplify )
-                flattened.Simplify();
+                     if( tess.TesselatePolygon( job.m_partitions.CPolygon( cell ).front(), nullptr ) )
+                         job.m_result[cell] = std::move( tri );
+                     else
+                         cellFailed[aCell] = 1;
+                 } );
 
-            SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+        std::vector<char> jobFailed( jobs.size(), 0 );
+
+        for( size_t ii = 0; ii < cells.size(); ++ii )
+        {
+            if( cellFailed[ii] )
+                jobFailed[cells[ii].first] = 1;
+        }
 
-            // This pushes the triangulation for all polys in partitions
-            // to be referenced to the ii-th polygon
-            if( !triangulate( partitions, ii , m_triangulatedPolys, aHintData ) )
+        for( size_t jj = 0; jj < jobs.size(); ++jj )
+        {
+            OUTLINE_JOB& job = jobs[jj];
+
+            if( !jobFailed[jj] && job.m_partitions.OutlineCount() > 0 )
             {
-                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d", ii );
+                job.m_valid = true;
+                continue;
+            }
+
+            // Retry the whole outline the slow way, which simplifies it on failure
+            job.m_result.clear();
+            job.m_valid = triangulate( job.m_partitions, job.m_outline, job.m_result, aHintData );
+
+            if( !job.m_valid )
+            {
+                wxLogTrace( TRIANGULATE_TRACE, "Failed to triangulate partitioned polygon %d",
+                            job.m_outline );
+            }
+        }
+
+        bool anyValid = false;
+        auto jobIt = jobs.begin();
+
+        for( int ii = 0; ii < OutlineCount(); ++ii )
+        {
+            if( jobIt != jobs.end() && jobIt->m_outline == ii )
+            {
+                for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : jobIt->m_result )
+                {
+                    if( !tri || tri->GetTriangleCount() == 0 )
+                        continue;
+
+                    // Only a complete triangulation may be reused later
+                    if( jobIt->m_valid )
+                        tri->SetSourceHash( jobIt->m_hash );
+
+                    m_triangulatedPolys.push_back( std::move( tri ) );
+                }
+
+                anyValid |= jobIt->m_valid;
+                ++jobIt;
             }
             else
             {
-                m_hash = checksum();
-                m_hashValid = true;
-                // Set valid flag only after everything has been updated
-                m_triangulationValid = true;
+                for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : reused[ii] )
+                {
+                    tri->SetSourceOutlineIndex( ii );
+                    m_triangulatedPolys.push_back( std::move( tri ) );
+                }
+
+                anyValid = true;
             }
         }
+
+        if( anyValid )
+        {
+            m_hash = checksum();
+            m_hashValid = true;
+            // Set valid flag only after everything has been updated
+            m_triangulationValid = true;
+        }
     }
     else
     {
+        m_triangulatedPolys.clear();
+        m_reusableTriangulation.clear();
+
         SHAPE_POLY_SET tmpSet( *this );
 
         tmpSet.ClearArcs();
@@ -3238,6 +3672,7 @@ void SHAPE_POLY_SET::TRIANGULATED_POLYGON::AddTriangle( int a, int b, int c )
 SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRIANGULATED_POLYGON( const TRIANGULATED_POLYGON& aOther )
 {
     m_sourceOutline = aOther.m_sourceOutline;
+    m_sourceHash = aOther.m_sourceHash;
     m_vertices = aOther.m_vertices;
     m_triangles = aOther.m_triangles;
 
@@ -3249,6 +3684,7 @@ SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRIANGULATED_POLYGON( const TRIANGULATED_P
 SHAPE_POLY_SET::TRIANGULATED_POLYGON& SHAPE_POLY_SET::TRIANGULATED_POLYGON::operator=( const TRIANGULATED_POLYGON& aOther )
 {
     m_sourceOutline = aOther.m_sourceOutline;
+    m_sourceHash = aOther.m_sourceHash;
     m_vertices = aOther.m_vertices;
     m_triangles = aOther.m_triangles;
 
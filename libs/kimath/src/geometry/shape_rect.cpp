@@ -32,8 +32,27 @@ bool SHAPE_RECT::Collide( const SEG& aSeg, int aClearance, int* aActual, VECTOR2
 {
     if( m_radius > 0 )
     {
-        SHAPE_LINE_CHAIN lineChain( Outline() );
-        return lineChain.Collide( aSeg, aClearance, aActual, aLocation );
+        int        radius;
+        SHAPE_RECT core = GetRoundRectCore( radius );
+
+        if( !core.Collide( aSeg, aClearance + radius, aActual, aLocation ) )
+            return false;
+
+        if( aActual )
+            *aActual = std::max( 0, *aActual - radius );
+
+        // Move the location from the inner rectangle to the rounded outline
+        if( aLocation )
+        {
+            VECTOR2I toSeg = aSeg.NearestPoint( *aLocation ) - *aLocation;
+
+            if( toSeg.SquaredEuclideanNorm() > SEG::Square( radius ) )
+                *aLocation += toSeg.Resize( radius );
+            else
+                *aLocation += toSeg;
+        }
+
+        return true;
     }
 
     BOX2I bbox( BBox() );
@@ -141,6 +160,7 @@ void SHAPE_RECT::TransformToPolygon( SHAPE_POLY_SET& aBuffer, int aError, ERROR_
     int idx = aBuffer.NewOutline();
     SHAPE_LINE_CHAIN& outline = aBuffer.Outline( idx );
 
+    outline.ReservePoints( 4 );
     outline.Append( m_p0 );
     outline.Append( { m_p0.x + m_w, m_p0.y } );
     outline.Append( { m_p0.x + m_w, m_p0.y + m_h } );
@@ -164,3 +164,53 @@ int64_t rescale( int64_t aNumerator, int64_t aValue, int64_t aDenominator )
     }
 #endif
 }
+
+
+#if !defined( __SIZEOF_INT128__ )
+/**
+ * Signed 128-bit product of two 64-bit integers, as a high signed and a low unsigned word.
+ */
+static void mulWide( int64_t aA, int64_t aB, int64_t& aHi, uint64_t& aLo )
+{
+    const uint64_t a = aA < 0 ? 0 - (uint64_t) aA : (uint64_t) aA;
+    const uint64_t b = aB < 0 ? 0 - (uint64_t) aB : (uint64_t) aB;
+
+    const uint64_t a0 = a & 0xFFFFFFFF;
+    const uint64_t a1 = a >> 32;
+    const uint64_t b0 = b & 0xFFFFFFFF;
+    const uint64_t b1 = b >> 32;
+
+    const uint64_t p00 = a0 * b0;
+    const uint64_t p01 = a0 * b1;
+    const uint64_t p10 = a1 * b0;
+    const uint64_t mid = ( p00 >> 32 ) + ( p01 & 0xFFFFFFFF ) + ( p10 & 0xFFFFFFFF );
+
+    uint64_t lo = ( mid << 32 ) | ( p00 & 0xFFFFFFFF );
+    uint64_t hi = a1 * b1 + ( p01 >> 32 ) + ( p10 >> 32 ) + ( mid >> 32 );
+
+    // Two's complement negation of the 128-bit magnitude
+    if( ( aA < 0 ) != ( aB < 0 ) )
+    {
+        lo = ~lo + 1;
+        hi = ~hi + ( lo == 0 );
+    }
+
+    aHi = (int64_t) hi;
+    aLo = lo;
+}
+
+
+int CompareProducts( int64_t aA, int64_t aB, int64_t aC, int64_t aD )
+{
+    int64_t  lhsHi, rhsHi;
+    uint64_t lhsLo, rhsLo;
+
+    mulWide( aA, aB, lhsHi, lhsLo );
+    mulWide( aC, aD, rhsHi, rhsLo );
+
+    if( lhsHi != rhsHi )
+        return lhsHi < rhsHi ? -1 : 1;
+
+    return ( lhsLo > rhsLo ) - ( lhsLo < rhsLo );
+}
+#endif
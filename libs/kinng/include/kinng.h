@@ -23,11 +23,27 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <mutex>
+#include <set>
+#include <string>
 #include <thread>
 
 
+/**
+ * Serves requests on a REQ/REP socket.
+ *
+ * Large replies can skip the socket: a client that sends the control request
+ * #KINNG_SHM_ENABLE_REQUEST (answered with #KINNG_SHM_ENABLED, or #KINNG_SHM_UNAVAILABLE where
+ * shared memory is not supported) then gets every reply of at least #KINNG_SHM_THRESHOLD bytes
+ * written into a POSIX shared memory segment.  The reply message is then only
+ * "\0shm:<segment name>:<size>".  The segment belongs to the client, which should unlink it
+ * once read; the server unlinks it anyway when the client sends its next request.
+ *
+ * Control messages start with a NUL byte, which no protobuf message can start with.
+ */
 class KINNG_REQUEST_SERVER
 {
 public:
@@ -43,13 +59,29 @@ public:
 
     void SetCallback( std::function<void(std::string*)> aFunc ) { m_callback = aFunc; }
 
-    void Reply( const std::string& aReply );
+    void Reply( std::string aReply );
 
     const std::string& SocketPath() const { return m_socketUrl; }
 
+    static constexpr size_t KINNG_SHM_THRESHOLD = 4 * 1024 * 1024;
+
+    static const std::string KINNG_SHM_ENABLE_REQUEST;
+    static const std::string KINNG_SHM_ENABLED;
+    static const std::string KINNG_SHM_UNAVAILABLE;
+
 private:
     void listenThread();
 
+    /**
+     * Write \a aReply into a new shared memory segment for \a aPipeId.
+     *
+     * @return the message pointing the client to the segment, or an empty string on failure.
+     */
+    std::string writeSegment( uint32_t aPipeId, const std::string& aReply );
+
+    /// Unlink the segment last handed to \a aPipeId, which the client is done with
+    void releaseSegment( uint32_t aPipeId );
+
     std::thread m_thread;
 
     std::atomic<bool> m_shutdown;
@@ -65,6 +97,82 @@ private:
     std::condition_variable m_replyReady;
 
     std::mutex m_mutex;
+
+    /// Only used by the listen thread
+    std::set<uint32_t> m_sharedMemoryPipes;
+    std::map<uint32_t, std::string> m_segments;
+    uint64_t m_segmentCount;
+};
+
+
+/**
+ * Sends requests to a KINNG_REQUEST_SERVER and waits for the replies.
+ */
+class KINNG_REQUEST_CLIENT
+{
+public:
+    KINNG_REQUEST_CLIENT( const std::string& aSocketUrl );
+
+    ~KINNG_REQUEST_CLIENT();
+
+    /**
+     * Dial the server.
+     *
+     * @return false if there is no server listening at the socket URL.
+     */
+    bool Connect();
+
+    /**
+     * Send \a aRequest and block until the server replies.
+     *
+     * @param aTimeoutMs is the time to wait for the reply, or -1 to wait forever.
+     * @return false if the request could not be sent or no reply was received.
+     */
+    bool Request( const std::string& aRequest, std::string& aReply, int aTimeoutMs = -1 );
+
+    /**
+     * Ask the server to pass large replies through shared memory.  Request() reads them back
+     * transparently.
+     *
+     * @return false if the server or this platform doesn't support it.
+     */
+    bool EnableSharedMemory();
+
+private:
+    std::string m_socketUrl;
+
+    uint32_t    m_socketId;
+
+    bool        m_connected;
+};
+
+
+/**
+ * Broadcasts messages to every connected subscriber.  Publishing never blocks: subscribers that
+ * do not keep up lose messages rather than slowing down the publisher.
+ */
+class KINNG_PUBLISHER
+{
+public:
+    KINNG_PUBLISHER( const std::string& aSocketUrl );
+
+    ~KINNG_PUBLISHER();
+
+    bool Running() const { return m_socketId != 0; }
+
+    /// @return true if at least one subscriber is connected
+    bool HasSubscribers() const { return m_subscribers > 0; }
+
+    bool Publish( const std::string& aMessage );
+
+    const std::string& SocketPath() const { return m_socketUrl; }
+
+private:
+    std::string m_socketUrl;
+
+    uint32_t    m_socketId;
+
+    std::atomic<int> m_subscribers;
 };
 
 #endif //KICAD_KINNG_H
@@ -18,11 +18,21 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cstring>
+
 #include <kinng.h>
 #include <nng/nng.h>
 #include <nng/protocol/reqrep0/rep.h>
+#include <nng/protocol/reqrep0/req.h>
+#include <nng/protocol/pubsub0/pub.h>
 #include <wx/log.h>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 
 /**
  * Trace nng server debug output
@@ -31,9 +41,17 @@
 static const wxChar TraceNng[] = wxT( "KINNG" );
 
 
+const std::string KINNG_REQUEST_SERVER::KINNG_SHM_ENABLE_REQUEST( "\0shm-enable", 11 );
+const std::string KINNG_REQUEST_SERVER::KINNG_SHM_ENABLED( "\0shm-enabled", 12 );
+const std::string KINNG_REQUEST_SERVER::KINNG_SHM_UNAVAILABLE( "\0shm-unavailable", 16 );
+
+static const std::string SHM_REPLY_PREFIX( "\0shm:", 5 );
+
+
 KINNG_REQUEST_SERVER::KINNG_REQUEST_SERVER( const std::string& aSocketUrl ) :
         m_socketUrl( aSocketUrl ),
-        m_callback()
+        m_callback(),
+        m_segmentCount( 0 )
 {
     Start();
 }
@@ -74,14 +92,69 @@ void KINNG_REQUEST_SERVER::Stop()
 }
 
 
-void KINNG_REQUEST_SERVER::Reply( const std::string& aReply )
+void KINNG_REQUEST_SERVER::Reply( std::string aReply )
 {
     std::lock_guard<std::mutex> lock( m_mutex );
-    m_pendingReply = aReply;
+    m_pendingReply = std::move( aReply );
     m_replyReady.notify_all();
 }
 
 
+std::string KINNG_REQUEST_SERVER::writeSegment( uint32_t aPipeId, const std::string& aReply )
+{
+#ifdef _WIN32
+    return std::string();
+#else
+    // Short enough for the 31 character limit on macOS
+    std::string name = "/kinng-" + std::to_string( getpid() ) + "-"
+                       + std::to_string( m_segmentCount++ );
+
+    int fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+
+    if( fd < 0 )
+    {
+        wxLogTrace( TraceNng, wxString::Format( wxS( "Could not create segment %s" ), name ) );
+        return std::string();
+    }
+
+    void* data = MAP_FAILED;
+
+    if( ftruncate( fd, static_cast<off_t>( aReply.size() ) ) == 0 )
+        data = mmap( nullptr, aReply.size(), PROT_WRITE, MAP_SHARED, fd, 0 );
+
+    close( fd );
+
+    if( data == MAP_FAILED )
+    {
+        shm_unlink( name.c_str() );
+        return std::string();
+    }
+
+    memcpy( data, aReply.data(), aReply.size() );
+    munmap( data, aReply.size() );
+
+    m_segments[aPipeId] = name;
+
+    return SHM_REPLY_PREFIX + name + ":" + std::to_string( aReply.size() );
+#endif
+}
+
+
+void KINNG_REQUEST_SERVER::releaseSegment( uint32_t aPipeId )
+{
+#ifndef _WIN32
+    auto it = m_segments.find( aPipeId );
+
+    if( it == m_segments.end() )
+        return;
+
+    // The client normally unlinked it already
+    shm_unlink( it->second.c_str() );
+    m_segments.erase( it );
+#endif
+}
+
+
 void KINNG_REQUEST_SERVER::listenThread()
 {
     nng_socket   socket;
@@ -111,30 +184,49 @@ void KINNG_REQUEST_SERVER::listenThread()
 
     nng_socket_set_ms( socket, NNG_OPT_RECVTIMEO, 500 );
 
+    // NNG drops messages over 1 MB by default, which bulk item requests easily exceed
+    nng_listener_set_size( listener, NNG_OPT_RECVMAXSZ, 0 );
+
     nng_listener_start( listener, 0 );
 
     wxLogTrace( TraceNng, wxS( "KINNG_REQUEST_SERVER listener has started" ) );
 
     while( !m_shutdown.load() )
     {
-        char*    buf = nullptr;
-        size_t   sz;
-        uint64_t val;
+        nng_msg* msg = nullptr;
 
-        retCode = nng_recv( socket, &buf, &sz, NNG_FLAG_ALLOC );
+        retCode = nng_recvmsg( socket, &msg, 0 );
 
         if( retCode == NNG_ETIMEDOUT )
             continue;
 
         if( retCode != 0 )
         {
-            nng_free( buf, sz );
             wxLogTrace( TraceNng,
                         wxString::Format( wxS( "Got error code %d from nngc_recv!" ), retCode ) );
             break;
         }
 
-        m_sharedMessage.assign( buf, sz );
+        uint32_t pipeId = nng_pipe_id( nng_msg_get_pipe( msg ) );
+
+        m_sharedMessage.assign( static_cast<const char*>( nng_msg_body( msg ) ), nng_msg_len( msg ) );
+        nng_msg_free( msg );
+
+        // A client only sends its next request once it has read the previous reply
+        releaseSegment( pipeId );
+
+        if( m_sharedMessage == KINNG_SHM_ENABLE_REQUEST )
+        {
+#ifdef _WIN32
+            const std::string& answer = KINNG_SHM_UNAVAILABLE;
+#else
+            const std::string& answer = KINNG_SHM_ENABLED;
+            m_sharedMemoryPipes.insert( pipeId );
+#endif
+            nng_send( socket, const_cast<std::string::value_type*>( answer.c_str() ),
+                      answer.length(), 0 );
+            continue;
+        }
 
         if( m_callback )
             m_callback( &m_sharedMessage );
@@ -142,6 +234,14 @@ void KINNG_REQUEST_SERVER::listenThread()
         std::unique_lock<std::mutex> lock( m_mutex );
         m_replyReady.wait( lock, [&]() { return !m_pendingReply.empty(); } );
 
+        if( m_pendingReply.length() >= KINNG_SHM_THRESHOLD && m_sharedMemoryPipes.count( pipeId ) )
+        {
+            std::string handle = writeSegment( pipeId, m_pendingReply );
+
+            if( !handle.empty() )
+                m_pendingReply = std::move( handle );
+        }
+
         retCode = nng_send( socket, const_cast<std::string::value_type*>( m_pendingReply.c_str() ),
                             m_pendingReply.length(), 0 );
 
@@ -156,5 +256,217 @@ void KINNG_REQUEST_SERVER::listenThread()
 
     wxLogTrace( TraceNng, wxS( "KINNG_REQUEST_SERVER shutting down" ) );
 
+    while( !m_segments.empty() )
+        releaseSegment( m_segments.begin()->first );
+
     nng_close( socket );
 }
+
+
+KINNG_REQUEST_CLIENT::KINNG_REQUEST_CLIENT( const std::string& aSocketUrl ) :
+        m_socketUrl( aSocketUrl ),
+        m_socketId( 0 ),
+        m_connected( false )
+{
+}
+
+
+KINNG_REQUEST_CLIENT::~KINNG_REQUEST_CLIENT()
+{
+    if( m_socketId != 0 )
+    {
+        nng_socket socket;
+        socket.id = m_socketId;
+        nng_close( socket );
+    }
+}
+
+
+bool KINNG_REQUEST_CLIENT::Connect()
+{
+    if( m_connected )
+        return true;
+
+    nng_socket socket;
+    int        retCode = 0;
+
+    if( m_socketId == 0 )
+    {
+        retCode = nng_req0_open( &socket );
+
+        if( retCode != 0 )
+        {
+            wxLogTrace( TraceNng, wxString::Format( wxS( "Got error code %d from nng_req0_open!" ),
+                                                    retCode ) );
+            return false;
+        }
+
+        m_socketId = socket.id;
+    }
+
+    socket.id = m_socketId;
+
+    retCode = nng_dial( socket, m_socketUrl.c_str(), nullptr, 0 );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_dial!" ), retCode ) );
+        return false;
+    }
+
+    m_connected = true;
+    return true;
+}
+
+
+bool KINNG_REQUEST_CLIENT::Request( const std::string& aRequest, std::string& aReply,
+                                    int aTimeoutMs )
+{
+    if( !Connect() )
+        return false;
+
+    nng_socket socket;
+    socket.id = m_socketId;
+
+    nng_socket_set_ms( socket, NNG_OPT_RECVTIMEO, aTimeoutMs < 0 ? NNG_DURATION_INFINITE
+                                                                 : aTimeoutMs );
+
+    int retCode = nng_send( socket, const_cast<std::string::value_type*>( aRequest.c_str() ),
+                            aRequest.length(), 0 );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_send!" ), retCode ) );
+        return false;
+    }
+
+    char*  buf = nullptr;
+    size_t sz = 0;
+
+    retCode = nng_recv( socket, &buf, &sz, NNG_FLAG_ALLOC );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_recv!" ), retCode ) );
+        return false;
+    }
+
+    aReply.assign( buf, sz );
+    nng_free( buf, sz );
+
+#ifndef _WIN32
+    if( aReply.compare( 0, SHM_REPLY_PREFIX.size(), SHM_REPLY_PREFIX ) == 0 )
+    {
+        size_t      separator = aReply.rfind( ':' );
+        std::string name = aReply.substr( SHM_REPLY_PREFIX.size(),
+                                          separator - SHM_REPLY_PREFIX.size() );
+        size_t      size = std::stoull( aReply.substr( separator + 1 ) );
+        int         fd = shm_open( name.c_str(), O_RDONLY, 0 );
+
+        if( fd < 0 )
+            return false;
+
+        void* data = mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+        close( fd );
+        shm_unlink( name.c_str() );
+
+        if( data == MAP_FAILED )
+            return false;
+
+        aReply.assign( static_cast<const char*>( data ), size );
+        munmap( data, size );
+    }
+#endif
+
+    return true;
+}
+
+
+bool KINNG_REQUEST_CLIENT::EnableSharedMemory()
+{
+    std::string reply;
+
+    if( !Request( KINNG_REQUEST_SERVER::KINNG_SHM_ENABLE_REQUEST, reply, 5000 ) )
+        return false;
+
+    return reply == KINNG_REQUEST_SERVER::KINNG_SHM_ENABLED;
+}
+
+
+KINNG_PUBLISHER::KINNG_PUBLISHER( const std::string& aSocketUrl ) :
+        m_socketUrl( aSocketUrl ),
+        m_socketId( 0 ),
+        m_subscribers( 0 )
+{
+    nng_socket socket;
+    int        retCode = nng_pub0_open( &socket );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_pub0_open!" ), retCode ) );
+        return;
+    }
+
+    retCode = nng_listen( socket, m_socketUrl.c_str(), nullptr, 0 );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_listen!" ), retCode ) );
+        nng_close( socket );
+        return;
+    }
+
+    auto onPipeEvent =
+            []( nng_pipe, nng_pipe_ev aEvent, void* aPublisher )
+            {
+                std::atomic<int>& count = static_cast<KINNG_PUBLISHER*>( aPublisher )->m_subscribers;
+
+                if( aEvent == NNG_PIPE_EV_ADD_POST )
+                    count++;
+                else if( aEvent == NNG_PIPE_EV_REM_POST )
+                    count--;
+            };
+
+    nng_pipe_notify( socket, NNG_PIPE_EV_ADD_POST, onPipeEvent, this );
+    nng_pipe_notify( socket, NNG_PIPE_EV_REM_POST, onPipeEvent, this );
+
+    m_socketId = socket.id;
+}
+
+
+KINNG_PUBLISHER::~KINNG_PUBLISHER()
+{
+    if( m_socketId != 0 )
+    {
+        nng_socket socket;
+        socket.id = m_socketId;
+        nng_close( socket );
+    }
+}
+
+
+bool KINNG_PUBLISHER::Publish( const std::string& aMessage )
+{
+    if( m_socketId == 0 )
+        return false;
+
+    nng_socket socket;
+    socket.id = m_socketId;
+
+    int retCode = nng_send( socket, const_cast<std::string::value_type*>( aMessage.c_str() ),
+                            aMessage.length(), 0 );
+
+    if( retCode != 0 )
+    {
+        wxLogTrace( TraceNng,
+                    wxString::Format( wxS( "Got error code %d from nng_send!" ), retCode ) );
+        return false;
+    }
+
+    return true;
+}
@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -65,6 +66,32 @@ namespace IO
      * This is a no-op on non-Windows platforms.
      */
     void LongPathAdjustment( wxFileName& aFilename );
+
+    /**
+     * A read-only memory mapping of a whole file, released on destruction.
+     *
+     * The mapping is hinted for sequential access where the platform supports it.  Empty files
+     * can't be mapped.
+     */
+    class MAPPED_FILE
+    {
+    public:
+        MAPPED_FILE( const wxString& aPath );
+        ~MAPPED_FILE();
+
+        MAPPED_FILE( const MAPPED_FILE& ) = delete;
+        MAPPED_FILE& operator=( const MAPPED_FILE& ) = delete;
+
+        bool IsMapped() const { return m_data != nullptr; }
+
+        const char* Data() const { return m_data; }
+        size_t      Size() const { return m_size; }
+
+    private:
+        const char* m_data;
+        size_t      m_size;
+        void*       m_handle;   ///< Platform mapping handle, if the platform needs one
+    };
 } // namespace IO
 } // namespace KIPLATFORM
 
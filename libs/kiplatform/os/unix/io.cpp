@@ -25,6 +25,7 @@
 #include <wx/filename.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -93,4 +94,40 @@ bool KIPLATFORM::IO::IsFileHidden( const wxString& aFileName )
 void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
 {
     // no-op
-}
\ No newline at end of file
+}
+
+
+KIPLATFORM::IO::MAPPED_FILE::MAPPED_FILE( const wxString& aPath ) :
+        m_data( nullptr ),
+        m_size( 0 ),
+        m_handle( nullptr )
+{
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) && fileStat.st_size > 0 )
+    {
+        void* data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        if( data != MAP_FAILED )
+        {
+            madvise( data, fileStat.st_size, MADV_SEQUENTIAL );
+            m_data = static_cast<const char*>( data );
+            m_size = fileStat.st_size;
+        }
+    }
+
+    // The mapping keeps its own reference to the file
+    close( fd );
+}
+
+
+KIPLATFORM::IO::MAPPED_FILE::~MAPPED_FILE()
+{
+    if( m_data )
+        munmap( const_cast<char*>( m_data ), m_size );
+}
@@ -176,4 +176,53 @@ void KIPLATFORM::IO::LongPathAdjustment( wxFileName& aFilename )
         aFilename.RemoveDir( 0 );
         aFilename.RemoveDir( 0 );
     }
-}
\ No newline at end of file
+}
+
+
+KIPLATFORM::IO::MAPPED_FILE::MAPPED_FILE( const wxString& aPath ) :
+        m_data( nullptr ),
+        m_size( 0 ),
+        m_handle( nullptr )
+{
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return;
+
+    LARGE_INTEGER size;
+
+    if( GetFileSizeEx( hFile, &size ) && size.QuadPart > 0 )
+    {
+        HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if( hMapping )
+        {
+            void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+            if( data )
+            {
+                m_data = static_cast<const char*>( data );
+                m_size = static_cast<size_t>( size.QuadPart );
+                m_handle = hMapping;
+            }
+            else
+            {
+                CloseHandle( hMapping );
+            }
+        }
+    }
+
+    // The mapping keeps its own reference to the file
+    CloseHandle( hFile );
+}
+
+
+KIPLATFORM::IO::MAPPED_FILE::~MAPPED_FILE()
+{
+    if( m_data )
+    {
+        UnmapViewOfFile( m_data );
+        CloseHandle( static_cast<HANDLE>( m_handle ) );
+    }
+}
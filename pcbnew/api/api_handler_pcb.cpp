@@ -24,6 +24,7 @@
 #include <api/api_pcb_utils.h>
 #include <api/api_enums.h>
 #include <api/api_utils.h>
+#include <api/api_server.h>
 #include <board_commit.h>
 #include <board_design_settings.h>
 #include <footprint.h>
@@ -31,6 +32,7 @@
 #include <netinfo.h>
 #include <pad.h>
 #include <pcb_edit_frame.h>
+#include <pcb_generator.h>
 #include <pcb_group.h>
 #include <pcb_reference_image.h>
 #include <pcb_shape.h>
@@ -38,13 +40,16 @@
 #include <pcb_textbox.h>
 #include <pcb_track.h>
 #include <pcbnew_id.h>
+#include <pgm_base.h>
 #include <pcb_marker.h>
 #include <drc/drc_item.h>
 #include <layer_ids.h>
 #include <project.h>
+#include <thread_pool.h>
 #include <tool/tool_manager.h>
 #include <tools/pcb_actions.h>
 #include <tools/pcb_selection_tool.h>
+#include <tools/zone_filler_tool.h>
 #include <zone.h>
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
@@ -122,6 +127,31 @@ API_HANDLER_PCB::API_HANDLER_PCB( PCB_EDIT_FRAME* aFrame ) :
             &API_HANDLER_PCB::handleSetBoardEditorAppearanceSettings );
     registerHandler<InjectDrcError, InjectDrcErrorResponse>(
             &API_HANDLER_PCB::handleInjectDrcError );
+
+    if( BOARD* board = frame()->GetBoard() )
+        board->AddListener( this );
+
+    // The old board is already gone when EDA_EVT_BOARD_CHANGED is sent, so there is nothing
+    // to remove the listener from; just follow the new one
+    frame()->Bind( EDA_EVT_BOARD_CHANGED, &API_HANDLER_PCB::onBoardChanged, this );
+}
+
+
+API_HANDLER_PCB::~API_HANDLER_PCB()
+{
+    frame()->Unbind( EDA_EVT_BOARD_CHANGED, &API_HANDLER_PCB::onBoardChanged, this );
+
+    if( BOARD* board = frame()->GetBoard() )
+        board->RemoveListener( this );
+}
+
+
+void API_HANDLER_PCB::onBoardChanged( wxCommandEvent& aEvent )
+{
+    if( BOARD* board = frame()->GetBoard() )
+        board->AddListener( this );
+
+    aEvent.Skip();
 }
 
 
@@ -160,7 +190,14 @@ HANDLER_RESULT<GetOpenDocumentsResponse> API_HANDLER_PCB::handleGetOpenDocuments
     }
 
     GetOpenDocumentsResponse response;
-    common::types::DocumentSpecifier doc;
+    response.mutable_documents()->Add( currentDocument() );
+    return response;
+}
+
+
+types::DocumentSpecifier API_HANDLER_PCB::currentDocument() const
+{
+    types::DocumentSpecifier doc;
 
     wxFileName fn( frame()->GetCurrentFileName() );
 
@@ -170,8 +207,7 @@ HANDLER_RESULT<GetOpenDocumentsResponse> API_HANDLER_PCB::handleGetOpenDocuments
     doc.mutable_project()->set_name( frame()->Prj().GetProjectName().ToStdString() );
     doc.mutable_project()->set_path( frame()->Prj().GetProjectDirectory().ToStdString() );
 
-    response.mutable_documents()->Add( std::move( doc ) );
-    return response;
+    return doc;
 }
 
 
@@ -349,6 +385,28 @@ HANDLER_RESULT<std::unique_ptr<BOARD_ITEM>> API_HANDLER_PCB::createItemForType(
 }
 
 
+/**
+ * BOARD::ResolveItem() walks the whole board when an id isn't in its cache, which is always the
+ * case for the ids of items being created.  Bulk requests index the board once instead.
+ */
+static std::unordered_map<KIID, BOARD_ITEM*> indexItemsById( const BOARD* aBoard )
+{
+    std::unordered_map<KIID, BOARD_ITEM*> index;
+
+    aBoard->RunOnChildren(
+            [&]( BOARD_ITEM* aItem )
+            {
+                index.emplace( aItem->m_Uuid, aItem );
+            },
+            RECURSE_MODE::RECURSE );
+
+    for( PCB_GENERATOR* generator : aBoard->Generators() )
+        index.emplace( generator->m_Uuid, generator );
+
+    return index;
+}
+
+
 HANDLER_RESULT<ItemRequestStatus> API_HANDLER_PCB::handleCreateUpdateItemsInternal( bool aCreate,
         const std::string& aClientName,
         const types::ItemHeader &aHeader,
@@ -404,6 +462,29 @@ HANDLER_RESULT<ItemRequestStatus> API_HANDLER_PCB::handleCreateUpdateItemsIntern
 
     BOARD_COMMIT* commit = static_cast<BOARD_COMMIT*>( getCurrentCommit( aClientName ) );
 
+    // Nothing is added to or removed from the board until the commit is pushed, so the index
+    // stays valid for the whole request
+    static constexpr int BULK_LOOKUP_THRESHOLD = 64;
+
+    std::optional<std::unordered_map<KIID, BOARD_ITEM*>> itemsById;
+
+    if( aItems.size() > BULK_LOOKUP_THRESHOLD )
+        itemsById = indexItemsById( board );
+
+    auto findItem =
+            [&]( const KIID& aId ) -> std::optional<BOARD_ITEM*>
+            {
+                if( !itemsById )
+                    return getItemById( aId );
+
+                auto it = itemsById->find( aId );
+
+                if( it == itemsById->end() )
+                    return std::nullopt;
+
+                return it->second;
+            };
+
     for( const google::protobuf::Any& anyItem : aItems )
     {
         ItemStatus status;
@@ -455,7 +536,7 @@ HANDLER_RESULT<ItemRequestStatus> API_HANDLER_PCB::handleCreateUpdateItemsIntern
             return tl::unexpected( e );
         }
 
-        std::optional<BOARD_ITEM*> optItem = getItemById( item->m_Uuid );
+        std::optional<BOARD_ITEM*> optItem = findItem( item->m_Uuid );
 
         if( aCreate && optItem )
         {
@@ -550,6 +631,40 @@ HANDLER_RESULT<ItemRequestStatus> API_HANDLER_PCB::handleCreateUpdateItemsIntern
 }
 
 
+/**
+ * Serialize \a aItems into \a aOutput, in order.  Large requests are serialized on the thread
+ * pool: each item only reads itself, and nothing edits the board while a handler runs.
+ */
+static void serializeItems( const std::vector<BOARD_ITEM*>&                          aItems,
+                            google::protobuf::RepeatedPtrField<google::protobuf::Any>* aOutput )
+{
+    // Below this, queueing the tasks costs more than it saves
+    static constexpr size_t PARALLEL_THRESHOLD = 1000;
+
+    aOutput->Reserve( aOutput->size() + static_cast<int>( aItems.size() ) );
+
+    if( aItems.size() < PARALLEL_THRESHOLD )
+    {
+        for( const BOARD_ITEM* item : aItems )
+            item->Serialize( *aOutput->Add() );
+
+        return;
+    }
+
+    std::vector<google::protobuf::Any> buffers( aItems.size() );
+    thread_pool&                       tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, aItems.size(),
+            [&]( const size_t ii )
+            {
+                aItems[ii]->Serialize( buffers[ii] );
+            } ).wait();
+
+    for( google::protobuf::Any& buffer : buffers )
+        aOutput->Add( std::move( buffer ) );
+}
+
+
 HANDLER_RESULT<GetItemsResponse> API_HANDLER_PCB::handleGetItems( const HANDLER_CONTEXT<GetItems>& aCtx )
 {
     if( std::optional<ApiResponseStatus> busy = checkForBusy() )
@@ -676,15 +791,14 @@ HANDLER_RESULT<GetItemsResponse> API_HANDLER_PCB::handleGetItems( const HANDLER_
         return tl::unexpected( e );
     }
 
-    for( const BOARD_ITEM* item : items )
-    {
-        if( !typesRequested.count( item->Type() ) )
-            continue;
+    // Tracks, arcs and vias are collected together, so drop the ones that were not asked for
+    std::erase_if( items,
+                   [&]( const BOARD_ITEM* aItem )
+                   {
+                       return !typesRequested.count( aItem->Type() );
+                   } );
 
-        google::protobuf::Any itemBuf;
-        item->Serialize( itemBuf );
-        response.mutable_items()->Add( std::move( itemBuf ) );
-    }
+    serializeItems( items, response.mutable_items() );
 
     response.set_status( ItemRequestStatus::IRS_OK );
     return response;
@@ -722,17 +836,131 @@ HANDLER_RESULT<GetItemsResponse> API_HANDLER_PCB::handleGetItemsById(
         return tl::unexpected( e );
     }
 
-    for( const BOARD_ITEM* item : items )
-    {
-        google::protobuf::Any itemBuf;
-        item->Serialize( itemBuf );
-        response.mutable_items()->Add( std::move( itemBuf ) );
-    }
+    serializeItems( items, response.mutable_items() );
 
     response.set_status( ItemRequestStatus::IRS_OK );
     return response;
 }
 
+/**
+ * Only the types GetItems can return are published; the others have no API representation.
+ */
+static bool isPublishedType( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    case PCB_FOOTPRINT_T:
+    case PCB_SHAPE_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+    case PCB_BARCODE_T:
+    case PCB_ZONE_T:
+    case PCB_GROUP_T:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+void API_HANDLER_PCB::publishChanges( const std::vector<BOARD_ITEM*>& aAdded,
+                                      const std::vector<BOARD_ITEM*>& aRemoved,
+                                      const std::vector<BOARD_ITEM*>& aChanged )
+{
+    KICAD_API_SERVER& server = Pgm().GetApiServer();
+
+    // Nobody can be listening, so don't pay for the serialization
+    if( !server.CanPublish() )
+        return;
+
+    auto published =
+            []( const std::vector<BOARD_ITEM*>& aItems )
+            {
+                std::vector<BOARD_ITEM*> result;
+                std::copy_if( aItems.begin(), aItems.end(), std::back_inserter( result ),
+                              isPublishedType );
+                return result;
+            };
+
+    if( std::vector<BOARD_ITEM*> added = published( aAdded ); !added.empty() )
+    {
+        CreateItems message;
+        *message.mutable_header()->mutable_document() = currentDocument();
+        serializeItems( added, message.mutable_items() );
+        server.Publish( "board.items_added", message.SerializeAsString() );
+    }
+
+    if( std::vector<BOARD_ITEM*> changed = published( aChanged ); !changed.empty() )
+    {
+        UpdateItems message;
+        *message.mutable_header()->mutable_document() = currentDocument();
+        serializeItems( changed, message.mutable_items() );
+        server.Publish( "board.items_changed", message.SerializeAsString() );
+    }
+
+    if( std::vector<BOARD_ITEM*> removed = published( aRemoved ); !removed.empty() )
+    {
+        DeleteItems message;
+        *message.mutable_header()->mutable_document() = currentDocument();
+
+        for( const BOARD_ITEM* item : removed )
+            message.add_item_ids()->set_value( item->m_Uuid.AsStdString() );
+
+        server.Publish( "board.items_removed", message.SerializeAsString() );
+    }
+}
+
+
+void API_HANDLER_PCB::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    publishChanges( { aBoardItem }, {}, {} );
+}
+
+
+void API_HANDLER_PCB::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    publishChanges( aBoardItems, {}, {} );
+}
+
+
+void API_HANDLER_PCB::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    publishChanges( {}, { aBoardItem }, {} );
+}
+
+
+void API_HANDLER_PCB::OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    publishChanges( {}, aBoardItems, {} );
+}
+
+
+void API_HANDLER_PCB::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    publishChanges( {}, {}, { aBoardItem } );
+}
+
+
+void API_HANDLER_PCB::OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    publishChanges( {}, {}, aBoardItems );
+}
+
+
+void API_HANDLER_PCB::OnBoardCompositeUpdate( BOARD& aBoard,
+                                              std::vector<BOARD_ITEM*>& aAddedItems,
+                                              std::vector<BOARD_ITEM*>& aRemovedItems,
+                                              std::vector<BOARD_ITEM*>& aChangedItems )
+{
+    publishChanges( aAddedItems, aRemovedItems, aChangedItems );
+}
+
+
 void API_HANDLER_PCB::deleteItemsInternal( std::map<KIID, ItemDeletionStatus>& aItemsToDelete,
                                            const std::string& aClientName )
 {
@@ -1560,22 +1788,48 @@ HANDLER_RESULT<Empty> API_HANDLER_PCB::handleRefillZones( const HANDLER_CONTEXT<
     if( !documentValidation )
         return tl::unexpected( documentValidation.error() );
 
+    // The fill runs after this request has been answered, so the client is not blocked by it.
+    // Until it is done, requests get AS_BUSY; the refilled zones are then published on the
+    // event socket like any other change.
+    TOOL_MANAGER* mgr = frame()->GetToolManager();
+
     if( aCtx.Request.zones().empty() )
     {
-        TOOL_MANAGER* mgr = frame()->GetToolManager();
         frame()->CallAfter( [mgr]()
                             {
                                 mgr->RunAction( PCB_ACTIONS::zoneFillAll );
                             } );
+
+        return Empty();
     }
-    else
+
+    std::vector<ZONE*> zones;
+
+    for( const kiapi::common::types::KIID& id : aCtx.Request.zones() )
     {
-        // TODO
-        ApiResponseStatus e;
-        e.set_status( ApiStatusCode::AS_UNIMPLEMENTED );
-        return tl::unexpected( e );
+        std::optional<BOARD_ITEM*> item = getItemById( KIID( id.value() ) );
+
+        if( !item || ( *item )->Type() != PCB_ZONE_T )
+        {
+            ApiResponseStatus e;
+            e.set_status( ApiStatusCode::AS_BAD_REQUEST );
+            e.set_error_message( fmt::format( "{} is not a zone on this board", id.value() ) );
+            return tl::unexpected( e );
+        }
+
+        zones.push_back( static_cast<ZONE*>( *item ) );
     }
 
+    ZONE_FILLER_TOOL* filler = mgr->GetTool<ZONE_FILLER_TOOL>();
+
+    for( ZONE* zone : zones )
+        filler->DirtyZone( zone );
+
+    frame()->CallAfter( [mgr]()
+                        {
+                            mgr->RunAction( PCB_ACTIONS::zoneFillDirty );
+                        } );
+
     return Empty();
 }
 
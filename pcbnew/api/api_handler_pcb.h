@@ -28,6 +28,7 @@
 #include <api/board/board_types.pb.h>
 #include <api/common/commands/editor_commands.pb.h>
 #include <api/common/commands/project_commands.pb.h>
+#include <board.h>
 #include <kiid.h>
 #include <properties/property_mgr.h>
 
@@ -47,11 +48,30 @@ class PCB_TRACK;
 class PROPERTY_BASE;
 
 
-class API_HANDLER_PCB : public API_HANDLER_EDITOR
+/**
+ * Besides answering requests, the handler listens to the board and publishes every change on
+ * the API event socket, so clients can follow the board without polling it with GetItems.
+ * Added items are published as a CreateItems message on the "board.items_added" topic,
+ * changed ones as UpdateItems on "board.items_changed" and removed ones as DeleteItems on
+ * "board.items_removed".
+ */
+class API_HANDLER_PCB : public API_HANDLER_EDITOR, public BOARD_LISTENER
 {
 public:
     API_HANDLER_PCB( PCB_EDIT_FRAME* aFrame );
 
+    ~API_HANDLER_PCB();
+
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardCompositeUpdate( BOARD& aBoard, std::vector<BOARD_ITEM*>& aAddedItems,
+                                 std::vector<BOARD_ITEM*>& aRemovedItems,
+                                 std::vector<BOARD_ITEM*>& aChangedItems ) override;
+
 private:
     typedef std::map<std::string, PROPERTY_BASE*> PROTO_PROPERTY_MAP;
 
@@ -174,6 +194,14 @@ protected:
 private:
     PCB_EDIT_FRAME* frame() const;
 
+    types::DocumentSpecifier currentDocument() const;
+
+    void onBoardChanged( wxCommandEvent& aEvent );
+
+    void publishChanges( const std::vector<BOARD_ITEM*>& aAdded,
+                         const std::vector<BOARD_ITEM*>& aRemoved,
+                         const std::vector<BOARD_ITEM*>& aChanged );
+
     void pushCurrentCommit( const std::string& aClientName, const wxString& aMessage ) override;
 
     std::optional<BOARD_ITEM*> getItemById( const KIID& aId ) const;
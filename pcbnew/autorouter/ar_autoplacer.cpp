@@ -41,6 +41,7 @@
 #include "ar_matrix.h"
 #include <memory>
 #include <ratsnest/ratsnest_data.h>
+#include <thread_pool.h>
 
 #define AR_GAIN            16
 #define AR_KEEPOUT_MARGIN  500
@@ -307,7 +308,7 @@ void AR_AUTOPLACER::buildFpAreas( FOOTPRINT* aFootprint, int aFpClearance )
     m_fpAreaTop.RemoveAllContours();
     m_fpAreaBottom.RemoveAllContours();
 
-    aFootprint->BuildCourtyardCaches();
+    aFootprint->EnsureCourtyardCaches();
     m_fpAreaTop = aFootprint->GetCourtyard( F_CrtYd );
     m_fpAreaBottom = aFootprint->GetCourtyard( B_CrtYd );
 
@@ -502,8 +503,8 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const BOX2I& aRect, int side )
 }
 
 
-int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide,
-                                         const VECTOR2I& aOffset )
+int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, const BOX2I& aFpBBox,
+                                         bool TstOtherSide )
 {
     int side = AR_SIDE_TOP;
     int otherside = AR_SIDE_BOTTOM;
@@ -513,8 +514,7 @@ int AR_AUTOPLACER::testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSid
         side = AR_SIDE_BOTTOM; otherside = AR_SIDE_TOP;
     }
 
-    BOX2I fpBBox = aFootprint->GetBoundingBox( false );
-    fpBBox.Move( -1*aOffset );
+    BOX2I fpBBox = aFpBBox;
 
     int diag = testRectangle( fpBBox, side );
 
@@ -540,7 +540,7 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
 {
     int     error = 1;
     VECTOR2I lastPosOK;
-    double  min_cost, curr_cost, Score;
+    double  min_cost;
     bool    testOtherSide;
 
     lastPosOK = m_matrix.m_BrdBox.GetOrigin();
@@ -561,9 +561,6 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
     initialPos.x    -= initialPos.x % m_matrix.m_GridRouting;
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
-    m_curPosition = initialPos;
-    VECTOR2I fpOffset = fpPos - m_curPosition;
-
     // Examine pads, and set testOtherSide to true if a footprint has at least 1 pad through.
     testOtherSide = false;
 
@@ -581,43 +578,67 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
+    // The ratsnest targets don't depend on the tested position: collect them once instead of
+    // scanning every pad of the board for each pad at each position.
+    const NET_PAD_POSITIONS netPads = collectNetPads( aFootprint );
 
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
+    const int grid = m_matrix.m_GridRouting;
+    int       colCount = 0;
 
+    if( xylimit.x > initialPos.x )
+        colCount = ( xylimit.x - initialPos.x + grid - 1 ) / grid;
 
-    for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
+    struct CANDIDATE
     {
-        m_curPosition.y = initialPos.y;
-
-        for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
+        VECTOR2I m_Pos;
+        double   m_Cost = -1.0;
+    };
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            fpOffset = fpPos - m_curPosition;
-            int keepOutCost = testFootprintOnBoard( aFootprint, testOtherSide, fpOffset );
+    // Each column of positions is tested on its own, keeping the last best position like the
+    // sequential scan did, so the columns can be merged in order to give the same result.
+    std::vector<CANDIDATE> columns( colCount );
+    thread_pool&           tp = GetKiCadThreadPool();
 
-            if( keepOutCost >= 0 )    // i.e. if the footprint can be put here
+    tp.submit_loop( 0, colCount,
+            [&]( int aCol )
             {
-                error = 0;
-                // m_frame->build_ratsnest_footprint( aFootprint ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aFootprint, fpOffset );
-                Score       = curr_cost + keepOutCost;
+                CANDIDATE& best = columns[aCol];
+                VECTOR2I   pos( initialPos.x + aCol * grid, initialPos.y );
 
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
+                for( ; pos.y < xylimit.y; pos.y += grid )
                 {
-                    lastPosOK   = m_curPosition;
-                    min_cost    = Score;
-/*
-                    wxString msg;
-                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                ::CoordinateToString( LastPosOK.x ),
-                                ::CoordinateToString( LastPosOK.y ) );
-                    m_frame->SetStatusText( msg );*/
+                    BOX2I bbox = fpBBox;
+                    bbox.SetOrigin( fpBBoxOrg + pos );
+
+                    int keepOutCost = testFootprintOnBoard( aFootprint, bbox, testOtherSide );
+
+                    if( keepOutCost < 0 )   // i.e. if the footprint cannot be put here
+                        continue;
+
+                    double score = computePlacementRatsnestCost( aFootprint, fpPos - pos, netPads )
+                                   + keepOutCost;
+
+                    if( best.m_Cost >= score || best.m_Cost < 0 )
+                    {
+                        best.m_Pos = pos;
+                        best.m_Cost = score;
+                    }
                 }
-            }
+            } ).wait();
+
+    min_cost = -1.0;
+
+    for( const CANDIDATE& candidate : columns )
+    {
+        if( candidate.m_Cost < 0 )
+            continue;
+
+        error = 0;
+
+        if( min_cost >= candidate.m_Cost || min_cost < 0 )
+        {
+            lastPosOK = candidate.m_Pos;
+            min_cost = candidate.m_Cost;
         }
     }
 
@@ -629,40 +650,39 @@ int AR_AUTOPLACER::getOptimalFPPlacement( FOOTPRINT* aFootprint )
 }
 
 
-const PAD* AR_AUTOPLACER::nearestPad( FOOTPRINT* aRefFP, PAD* aRefPad, const VECTOR2I& aOffset )
+AR_AUTOPLACER::NET_PAD_POSITIONS AR_AUTOPLACER::collectNetPads( FOOTPRINT* aFootprint ) const
 {
-    const PAD* nearest = nullptr;
-    int64_t    nearestDist = INT64_MAX;
+    NET_PAD_POSITIONS netPads;
+
+    for( PAD* pad : aFootprint->Pads() )
+    {
+        if( pad->GetNetCode() > 0 )
+            netPads[pad->GetNetCode()];
+    }
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
-        if ( footprint == aRefFP )
+        if( footprint == aFootprint )
             continue;
 
         if( !m_matrix.m_BrdBox.Contains( footprint->GetPosition() ) )
             continue;
 
-        for( PAD* pad: footprint->Pads() )
+        for( PAD* pad : footprint->Pads() )
         {
-            if( pad->GetNetCode() != aRefPad->GetNetCode() || pad->GetNetCode() <= 0 )
-                continue;
-
-            auto dist = ( VECTOR2I( aRefPad->GetPosition() - aOffset ) -
-                          VECTOR2I( pad->GetPosition() ) ).EuclideanNorm();
+            auto it = netPads.find( pad->GetNetCode() );
 
-            if ( dist < nearestDist )
-            {
-                nearestDist = dist;
-                nearest = pad;
-            }
+            if( it != netPads.end() )
+                it->second.push_back( pad->GetPosition() );
         }
     }
 
-    return nearest;
+    return netPads;
 }
 
 
-double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset )
+double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset,
+                                                    const NET_PAD_POSITIONS& aNetPads ) const
 {
     double  curr_cost;
     VECTOR2I start;      // start point of a ratsnest
@@ -673,13 +693,26 @@ double AR_AUTOPLACER::computePlacementRatsnestCost( FOOTPRINT* aFootprint, const
 
     for( PAD* pad : aFootprint->Pads() )
     {
-        const PAD* nearest = nearestPad( aFootprint, pad, aOffset );
+        auto netIt = aNetPads.find( pad->GetNetCode() );
 
-        if( !nearest )
+        if( netIt == aNetPads.end() || netIt->second.empty() )
             continue;
 
-        start   = VECTOR2I( pad->GetPosition() ) - VECTOR2I(aOffset);
-        end     = VECTOR2I( nearest->GetPosition() );
+        start = VECTOR2I( pad->GetPosition() ) - VECTOR2I( aOffset );
+
+        // Nearest pad of the same net; the first one wins a tie
+        int64_t nearestDist = INT64_MAX;
+
+        for( const VECTOR2I& candidate : netIt->second )
+        {
+            int64_t dist = ( start - candidate ).EuclideanNorm();
+
+            if( dist < nearestDist )
+            {
+                nearestDist = dist;
+                end = candidate;
+            }
+        }
 
         //m_overlay->SetIsStroke( true );
         //m_overlay->SetStrokeColor( COLOR4D(0.0, 1.0, 0.0, 1.0) );
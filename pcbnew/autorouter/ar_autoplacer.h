@@ -39,6 +39,9 @@
 
 #include <view/view_overlay.h>
 
+#include <unordered_map>
+#include <vector>
+
 enum AR_CELL_STATE
 {
     AR_OUT_OF_BOARD = -2,
@@ -96,11 +99,31 @@ private:
     bool fillMatrix();
     void genModuleOnRoutingMatrix( FOOTPRINT* aFootprint );
 
+    /// Positions of the pads of the footprints already on the board, by net code
+    using NET_PAD_POSITIONS = std::unordered_map<int, std::vector<VECTOR2I>>;
+
+    // The tests below only read m_matrix, so candidate positions can be evaluated concurrently
     int testRectangle( const BOX2I& aRect, int side );
     unsigned int calculateKeepOutArea( const  BOX2I& aRect, int side );
-    int testFootprintOnBoard( FOOTPRINT* aFootprint, bool TstOtherSide, const VECTOR2I& aOffset );
+
+    /**
+     * @param aFpBBox is the bounding box of \a aFootprint moved to the tested position.
+     */
+    int testFootprintOnBoard( FOOTPRINT* aFootprint, const BOX2I& aFpBBox, bool TstOtherSide );
     int getOptimalFPPlacement( FOOTPRINT* aFootprint );
-    double computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset );
+
+    /**
+     * Sum the cost of the connections of each pad of \a aFootprint, moved by -\a aOffset,
+     * to the nearest pad of the same net in \a aNetPads.
+     */
+    double computePlacementRatsnestCost( FOOTPRINT* aFootprint, const VECTOR2I& aOffset,
+                                         const NET_PAD_POSITIONS& aNetPads ) const;
+
+    /**
+     * Collect the pads the ratsnest of \a aFootprint can connect to: the pads with a net of
+     * the other footprints inside the board area, in board order.
+     */
+    NET_PAD_POSITIONS collectNetPads( FOOTPRINT* aFootprint ) const;
 
     /**
      * Find the "best" footprint place. The criteria are:
@@ -111,8 +134,6 @@ private:
 
     void placeFootprint( FOOTPRINT* aFootprint, bool aDoNotRecreateRatsnest, const VECTOR2I& aPos );
 
-    const PAD* nearestPad( FOOTPRINT* aRefFP, PAD* aRefPad, const VECTOR2I& aOffset );
-
     // Add a polygonal shape (rectangle) to m_fpAreaFront and/or m_fpAreaBack
     void addFpBody( const VECTOR2I& aStart, const VECTOR2I& aEnd, const LSET& aLayerMask );
 
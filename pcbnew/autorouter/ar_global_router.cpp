@@ -0,0 +1,546 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <footprint.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>      // for KiROUND
+#include <netclass.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <project/net_settings.h>
+#include <thread_pool.h>
+
+#include "ar_global_router.h"
+
+
+#define CELL_IS_BLOCKED 0x01
+
+// Search costs, in tenths of a grid step
+static const uint32_t STEP_COST = 10;
+static const uint32_t DIAGONAL_COST = 14;
+static const uint32_t VIA_COST = 80;
+static const uint32_t PRESENT_COST = 20;
+static const uint32_t HISTORY_COST = 10;
+
+static const uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+
+struct AR_GLOBAL_ROUTER::ENDPOINT
+{
+    bool Covers( int aRow, int aCol ) const
+    {
+        return aRow >= m_rowMin && aRow <= m_rowMax && aCol >= m_colMin && aCol <= m_colMax;
+    }
+
+    bool m_valid = false;
+    bool m_sides[AR_MAX_ROUTING_LAYERS_COUNT] = { false, false };
+    int  m_row = 0;
+    int  m_col = 0;
+
+    // Cells covered by the pad and its margin, which are free for this connection only
+    int  m_rowMin = 0;
+    int  m_rowMax = -1;
+    int  m_colMin = 0;
+    int  m_colMax = -1;
+};
+
+
+/**
+ * Per thread search state, reused by every search of the thread.  Cells are marked visited
+ * by stamping them with the current generation, so no clearing is needed between searches.
+ */
+struct AR_GLOBAL_ROUTER::WORKSPACE
+{
+    void Reset( size_t aCellCount )
+    {
+        if( m_visit.size() != aCellCount )
+        {
+            m_cost.assign( aCellCount, 0 );
+            m_parent.assign( aCellCount, NO_PARENT );
+            m_visit.assign( aCellCount, 0 );
+            m_generation = 0;
+        }
+
+        if( ++m_generation == 0 )
+        {
+            std::fill( m_visit.begin(), m_visit.end(), 0 );
+            m_generation = 1;
+        }
+    }
+
+    bool Visited( uint32_t aIdx ) const { return m_visit[aIdx] == m_generation; }
+
+    std::vector<uint32_t> m_cost;
+    std::vector<uint32_t> m_parent;
+    std::vector<uint32_t> m_visit;
+    uint32_t              m_generation = 0;
+};
+
+
+bool AR_GLOBAL_ROUTER::GUIDE::IsSingleSided() const
+{
+    return std::adjacent_find( m_sides.begin(), m_sides.end(), std::not_equal_to<int>() )
+                == m_sides.end();
+}
+
+
+std::vector<VECTOR2I> AR_GLOBAL_ROUTER::GUIDE::Corners() const
+{
+    std::vector<VECTOR2I> corners;
+
+    for( size_t ii = 1; ii + 1 < m_points.size(); ii++ )
+    {
+        if( m_sides[ii] != m_sides[ii + 1] )
+        {
+            corners.push_back( m_points[ii] );
+            continue;
+        }
+
+        if( m_sides[ii] != m_sides[ii - 1] )
+            continue;
+
+        if( m_points[ii] - m_points[ii - 1] != m_points[ii + 1] - m_points[ii] )
+            corners.push_back( m_points[ii] );
+    }
+
+    return corners;
+}
+
+
+AR_GLOBAL_ROUTER::AR_GLOBAL_ROUTER( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_gridSize( 0 ),
+        m_margin( 0 ),
+        m_passCount( 4 ),
+        m_overflowCount( 0 )
+{
+}
+
+
+AR_GLOBAL_ROUTER::~AR_GLOBAL_ROUTER()
+{
+    m_matrix.UnInitRoutingMatrix();
+}
+
+
+bool AR_GLOBAL_ROUTER::BuildMatrix()
+{
+    BOARD_DESIGN_SETTINGS&    bds = m_board->GetDesignSettings();
+    std::shared_ptr<NETCLASS> netclass = bds.m_NetSettings->GetDefaultNetclass();
+    int                       trackWidth = std::max( netclass->GetTrackWidth(), 1 );
+    int                       clearance = std::max( netclass->GetClearance(), 0 );
+
+    m_margin = trackWidth / 2 + clearance;
+
+    if( m_gridSize <= 0 )
+        m_gridSize = trackWidth + clearance;
+
+    BOX2I bbox = m_board->GetBoardEdgesBoundingBox();
+
+    if( bbox.GetWidth() == 0 || bbox.GetHeight() == 0 )
+        return false;
+
+    m_matrix.UnInitRoutingMatrix();
+    m_matrix.m_GridRouting = m_gridSize;
+    m_matrix.ComputeMatrixSize( bbox );
+    m_matrix.m_RoutingLayersCount = 2;
+    m_matrix.m_routeLayerBottom = B_Cu;
+    m_matrix.m_routeLayerTop = F_Cu;
+
+    if( m_matrix.InitRoutingMatrix() < 0 )
+        return false;
+
+    // Grid points where a track would not stay inside the board
+    SHAPE_POLY_SET outline;
+
+    m_board->GetBoardPolygonOutlines( outline, true );
+    outline.Deflate( trackWidth / 2 + bds.m_CopperEdgeClearance,
+                     CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, bds.m_MaxError );
+    outline.BuildBBoxCaches();
+
+    VECTOR2I origin = m_matrix.GetBrdCoordOrigin();
+
+    for( int row = 0; row < m_matrix.m_Nrows; row++ )
+    {
+        for( int col = 0; col < m_matrix.m_Ncols; col++ )
+        {
+            if( !outline.Contains( origin + VECTOR2I( col * m_gridSize, row * m_gridSize ) ) )
+            {
+                m_matrix.SetCell( row, col, AR_SIDE_BOTTOM, CELL_IS_BLOCKED );
+                m_matrix.SetCell( row, col, AR_SIDE_TOP, CELL_IS_BLOCKED );
+            }
+        }
+    }
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            m_matrix.PlacePad( pad, CELL_IS_BLOCKED, m_margin, AR_MATRIX::WRITE_OR_CELL );
+    }
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        int halfWidth = track->GetWidth() / 2 + m_margin;
+
+        switch( track->Type() )
+        {
+        case PCB_TRACE_T:
+            m_matrix.TraceSegment( track->GetStart(), track->GetEnd(), halfWidth,
+                                   track->GetLayer(), CELL_IS_BLOCKED, AR_MATRIX::WRITE_OR_CELL );
+            break;
+
+        case PCB_ARC_T:
+        {
+            PCB_ARC* arc = static_cast<PCB_ARC*>( track );
+
+            // Two chords are close enough at this resolution
+            m_matrix.TraceSegment( arc->GetStart(), arc->GetMid(), halfWidth, arc->GetLayer(),
+                                   CELL_IS_BLOCKED, AR_MATRIX::WRITE_OR_CELL );
+            m_matrix.TraceSegment( arc->GetMid(), arc->GetEnd(), halfWidth, arc->GetLayer(),
+                                   CELL_IS_BLOCKED, AR_MATRIX::WRITE_OR_CELL );
+            break;
+        }
+
+        case PCB_VIA_T:
+            m_matrix.TraceSegment( track->GetPosition(), track->GetPosition(), halfWidth,
+                                   UNDEFINED_LAYER, CELL_IS_BLOCKED, AR_MATRIX::WRITE_OR_CELL );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    m_matrix.PackCells( AR_SIDE_BOTTOM, CELL_IS_BLOCKED, m_blocked[AR_SIDE_BOTTOM] );
+    m_matrix.PackCells( AR_SIDE_TOP, CELL_IS_BLOCKED, m_blocked[AR_SIDE_TOP] );
+
+    // The searches only use the packed image
+    int rows = m_matrix.m_Nrows;
+    int cols = m_matrix.m_Ncols;
+
+    m_matrix.UnInitRoutingMatrix();
+    m_matrix.m_Nrows = rows;
+    m_matrix.m_Ncols = cols;
+
+    return true;
+}
+
+
+AR_GLOBAL_ROUTER::ENDPOINT AR_GLOBAL_ROUTER::makeEndpoint( PAD* aPad ) const
+{
+    ENDPOINT endpoint;
+    VECTOR2I origin = m_matrix.m_BrdBox.GetOrigin();
+
+    auto toRow =
+            [&]( int aY )
+            {
+                return std::clamp( KiROUND( double( aY - origin.y ) / m_gridSize ), 0,
+                                   m_matrix.m_Nrows - 1 );
+            };
+
+    auto toCol =
+            [&]( int aX )
+            {
+                return std::clamp( KiROUND( double( aX - origin.x ) / m_gridSize ), 0,
+                                   m_matrix.m_Ncols - 1 );
+            };
+
+    endpoint.m_sides[AR_SIDE_TOP] = aPad->IsOnLayer( F_Cu );
+    endpoint.m_sides[AR_SIDE_BOTTOM] = aPad->IsOnLayer( B_Cu );
+    endpoint.m_valid = endpoint.m_sides[AR_SIDE_TOP] || endpoint.m_sides[AR_SIDE_BOTTOM];
+
+    VECTOR2I pos = aPad->GetPosition();
+    BOX2I    bbox = aPad->GetBoundingBox();
+
+    bbox.Inflate( m_margin );
+
+    endpoint.m_row = toRow( pos.y );
+    endpoint.m_col = toCol( pos.x );
+    endpoint.m_rowMin = toRow( bbox.GetTop() );
+    endpoint.m_rowMax = toRow( bbox.GetBottom() );
+    endpoint.m_colMin = toCol( bbox.GetLeft() );
+    endpoint.m_colMax = toCol( bbox.GetRight() );
+
+    return endpoint;
+}
+
+
+bool AR_GLOBAL_ROUTER::search( const CONNECTION& aConnection,
+                               const std::vector<uint32_t>& aOwnCells, int aPass, bool aWindowed,
+                               GUIDE& aGuide, std::vector<uint32_t>& aCells ) const
+{
+    ENDPOINT start = makeEndpoint( aConnection.m_start );
+    ENDPOINT end = makeEndpoint( aConnection.m_end );
+
+    if( !start.m_valid || !end.m_valid )
+        return false;
+
+    int rowMin = 0;
+    int rowMax = m_matrix.m_Nrows - 1;
+    int colMin = 0;
+    int colMax = m_matrix.m_Ncols - 1;
+
+    if( aWindowed )
+    {
+        int extent = std::max( std::abs( start.m_row - end.m_row ),
+                               std::abs( start.m_col - end.m_col ) );
+        int slack = std::max( 16, extent / 2 );
+
+        rowMin = std::max( rowMin, std::min( start.m_row, end.m_row ) - slack );
+        rowMax = std::min( rowMax, std::max( start.m_row, end.m_row ) + slack );
+        colMin = std::max( colMin, std::min( start.m_col, end.m_col ) - slack );
+        colMax = std::min( colMax, std::max( start.m_col, end.m_col ) + slack );
+    }
+
+    auto passable =
+            [&]( int aSide, int aRow, int aCol )
+            {
+                return !isBlocked( aSide, aRow, aCol ) || start.Covers( aRow, aCol )
+                       || end.Covers( aRow, aCol );
+            };
+
+    auto heuristic =
+            [&]( int aRow, int aCol ) -> uint32_t
+            {
+                uint32_t dr = std::abs( aRow - end.m_row );
+                uint32_t dc = std::abs( aCol - end.m_col );
+
+                return STEP_COST * std::max( dr, dc )
+                       + ( DIAGONAL_COST - STEP_COST ) * std::min( dr, dc );
+            };
+
+    // Cost of sharing a cell with the other guides of the last pass
+    auto congestion =
+            [&]( uint32_t aIdx ) -> uint32_t
+            {
+                uint32_t usage = m_usage[aIdx];
+
+                if( usage && std::binary_search( aOwnCells.begin(), aOwnCells.end(), aIdx ) )
+                    usage--;
+
+                return usage * ( PRESENT_COST << std::min( aPass, 4 ) )
+                       + m_history[aIdx] * HISTORY_COST;
+            };
+
+    thread_local WORKSPACE ws;
+
+    ws.Reset( m_usage.size() );
+
+    using QUEUE_ENTRY = std::pair<uint32_t, uint32_t>;  // estimated total cost, cell
+
+    std::priority_queue<QUEUE_ENTRY, std::vector<QUEUE_ENTRY>, std::greater<QUEUE_ENTRY>> open;
+
+    auto relax =
+            [&]( uint32_t aIdx, uint32_t aCost, uint32_t aParent, int aRow, int aCol )
+            {
+                if( ws.Visited( aIdx ) && ws.m_cost[aIdx] <= aCost )
+                    return;
+
+                ws.m_visit[aIdx] = ws.m_generation;
+                ws.m_cost[aIdx] = aCost;
+                ws.m_parent[aIdx] = aParent;
+                open.emplace( aCost + heuristic( aRow, aCol ), aIdx );
+            };
+
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        if( start.m_sides[side] )
+            relax( cellIndex( side, start.m_row, start.m_col ), 0, NO_PARENT, start.m_row,
+                   start.m_col );
+    }
+
+    const int sideCells = m_matrix.m_Nrows * m_matrix.m_Ncols;
+    uint32_t  found = NO_PARENT;
+
+    while( !open.empty() )
+    {
+        auto [estimate, idx] = open.top();
+        open.pop();
+
+        int side = idx / sideCells;
+        int row = ( idx % sideCells ) / m_matrix.m_Ncols;
+        int col = idx % m_matrix.m_Ncols;
+
+        // Stale entry, the cell was reached more cheaply since
+        if( estimate != ws.m_cost[idx] + heuristic( row, col ) )
+            continue;
+
+        if( end.m_sides[side] && row == end.m_row && col == end.m_col )
+        {
+            found = idx;
+            break;
+        }
+
+        uint32_t cost = ws.m_cost[idx];
+
+        for( int dr = -1; dr <= 1; dr++ )
+        {
+            for( int dc = -1; dc <= 1; dc++ )
+            {
+                int nrow = row + dr;
+                int ncol = col + dc;
+
+                if( ( !dr && !dc ) || nrow < rowMin || nrow > rowMax || ncol < colMin
+                        || ncol > colMax || !passable( side, nrow, ncol ) )
+                {
+                    continue;
+                }
+
+                // Don't cut the corners of obstacles
+                if( dr && dc && ( !passable( side, row, ncol ) || !passable( side, nrow, col ) ) )
+                    continue;
+
+                uint32_t nidx = cellIndex( side, nrow, ncol );
+
+                relax( nidx, cost + ( dr && dc ? DIAGONAL_COST : STEP_COST ) + congestion( nidx ),
+                       idx, nrow, ncol );
+            }
+        }
+
+        int other = 1 - side;
+
+        if( !isBlocked( other, row, col ) )
+        {
+            uint32_t nidx = cellIndex( other, row, col );
+            relax( nidx, cost + VIA_COST + congestion( nidx ), idx, row, col );
+        }
+    }
+
+    if( found == NO_PARENT )
+        return false;
+
+    aGuide = GUIDE();
+    aCells.clear();
+
+    for( uint32_t idx = found; idx != NO_PARENT; idx = ws.m_parent[idx] )
+        aCells.push_back( idx );
+
+    std::reverse( aCells.begin(), aCells.end() );
+
+    VECTOR2I origin = m_matrix.m_BrdBox.GetOrigin();
+
+    for( uint32_t idx : aCells )
+    {
+        int side = idx / sideCells;
+        int row = ( idx % sideCells ) / m_matrix.m_Ncols;
+        int col = idx % m_matrix.m_Ncols;
+
+        aGuide.m_points.push_back( origin + VECTOR2I( col * m_gridSize, row * m_gridSize ) );
+        aGuide.m_sides.push_back( side );
+    }
+
+    aGuide.m_found = true;
+    return true;
+}
+
+
+std::vector<AR_GLOBAL_ROUTER::GUIDE>
+AR_GLOBAL_ROUTER::Route( const std::vector<CONNECTION>& aConnections )
+{
+    size_t cellCount = (size_t) AR_MAX_ROUTING_LAYERS_COUNT * m_matrix.m_Nrows * m_matrix.m_Ncols;
+
+    std::vector<GUIDE>                 guides( aConnections.size() );
+    std::vector<std::vector<uint32_t>> cells( aConnections.size() );  // sorted, per guide
+    std::vector<size_t>                pending( aConnections.size() );
+
+    m_usage.assign( cellCount, 0 );
+    m_history.assign( cellCount, 0 );
+    m_overflowCount = 0;
+
+    if( cellCount == 0 )
+        return guides;
+
+    for( size_t ii = 0; ii < pending.size(); ii++ )
+        pending[ii] = ii;
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    for( int pass = 0; pass < m_passCount && !pending.empty(); pass++ )
+    {
+        // The searches only read the usage of the previous pass, so they are independent
+        auto results = tp.submit_loop( 0, pending.size(),
+                [&]( const int ii )
+                {
+                    size_t                conn = pending[ii];
+                    GUIDE                 guide;
+                    std::vector<uint32_t> path;
+
+                    if( search( aConnections[conn], cells[conn], pass, true, guide, path )
+                            || search( aConnections[conn], cells[conn], pass, false, guide, path ) )
+                    {
+                        std::sort( path.begin(), path.end() );
+                    }
+
+                    guides[conn] = std::move( guide );
+                    cells[conn] = std::move( path );
+                } );
+        results.wait();
+
+        std::fill( m_usage.begin(), m_usage.end(), 0 );
+
+        for( const std::vector<uint32_t>& path : cells )
+        {
+            for( uint32_t idx : path )
+            {
+                if( m_usage[idx] < std::numeric_limits<uint8_t>::max() )
+                    m_usage[idx]++;
+            }
+        }
+
+        m_overflowCount = 0;
+
+        for( size_t idx = 0; idx < cellCount; idx++ )
+        {
+            if( m_usage[idx] > 1 )
+            {
+                m_overflowCount++;
+                m_history[idx] = std::min<int>( m_history[idx] + m_usage[idx] - 1,
+                                                std::numeric_limits<uint16_t>::max() );
+            }
+        }
+
+        // Only the guides through overused cells compete again
+        pending.clear();
+
+        for( size_t conn = 0; conn < cells.size(); conn++ )
+        {
+            for( uint32_t idx : cells[conn] )
+            {
+                if( m_usage[idx] > 1 )
+                {
+                    pending.push_back( conn );
+                    break;
+                }
+            }
+        }
+    }
+
+    return guides;
+}
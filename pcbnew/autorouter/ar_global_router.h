@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __AR_GLOBAL_ROUTER_H
+#define __AR_GLOBAL_ROUTER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ar_matrix.h"
+
+class BOARD;
+class PAD;
+
+
+/**
+ * Coarse maze router working on the two sides of an AR_MATRIX.
+ *
+ * Every connection is searched with A* on a grid about one track pitch wide, against the pads,
+ * tracks and vias of the board.  Connections are searched concurrently; the paths then compete
+ * for grid cells over a few negotiation passes, where cells claimed by several paths become
+ * more expensive for the next pass.  The resulting paths are guides for the interactive router,
+ * not tracks: they ignore everything finer than the grid.
+ */
+class AR_GLOBAL_ROUTER
+{
+public:
+    struct CONNECTION
+    {
+        PAD* m_start = nullptr;
+        PAD* m_end = nullptr;
+    };
+
+    struct GUIDE
+    {
+        bool                  m_found = false;
+        std::vector<VECTOR2I> m_points;  ///< Grid points of the path, in board coordinates
+        std::vector<int>      m_sides;   ///< AR_SIDE_TOP or AR_SIDE_BOTTOM of each point
+
+        bool IsSingleSided() const;
+
+        /**
+         * @return the points where the path changes direction, without its two ends.
+         */
+        std::vector<VECTOR2I> Corners() const;
+    };
+
+    AR_GLOBAL_ROUTER( BOARD* aBoard );
+    ~AR_GLOBAL_ROUTER();
+
+    /**
+     * Set the grid pitch.  Defaults to the track width plus clearance of the default netclass.
+     */
+    void SetGridSize( int aGridSize ) { m_gridSize = aGridSize; }
+
+    void SetPassCount( int aPasses ) { m_passCount = aPasses; }
+
+    /**
+     * Rasterize the board outline and the copper of the board into the routing matrix.
+     *
+     * @return false if the board has no outline.
+     */
+    bool BuildMatrix();
+
+    /**
+     * Search a guide for every connection.
+     *
+     * @return one guide per connection.
+     */
+    std::vector<GUIDE> Route( const std::vector<CONNECTION>& aConnections );
+
+    /**
+     * @return the number of grid cells still claimed by more than one guide after Route().
+     */
+    int OverflowCount() const { return m_overflowCount; }
+
+private:
+    struct ENDPOINT;
+    struct WORKSPACE;
+
+    ENDPOINT makeEndpoint( PAD* aPad ) const;
+
+    bool search( const CONNECTION& aConnection, const std::vector<uint32_t>& aOwnCells,
+                 int aPass, bool aWindowed, GUIDE& aGuide, std::vector<uint32_t>& aCells ) const;
+
+    bool isBlocked( int aSide, int aRow, int aCol ) const
+    {
+        return m_blocked[aSide].Test( aRow, aCol );
+    }
+
+    uint32_t cellIndex( int aSide, int aRow, int aCol ) const
+    {
+        return ( (uint32_t) aSide * m_matrix.m_Nrows + aRow ) * m_matrix.m_Ncols + aCol;
+    }
+
+private:
+    BOARD*                m_board;
+    AR_MATRIX             m_matrix;
+    AR_CELL_BITMAP        m_blocked[AR_MAX_ROUTING_LAYERS_COUNT];
+    int                   m_gridSize;
+    int                   m_margin;        ///< Half track width plus clearance
+    int                   m_passCount;
+    int                   m_overflowCount;
+
+    std::vector<uint8_t>  m_usage;         ///< Guides through each cell in the last pass
+    std::vector<uint16_t> m_history;       ///< Accumulated overflow of each cell
+};
+
+#endif
@@ -758,6 +758,36 @@ void AR_MATRIX::TraceFilledRectangle( int ux0, int uy0, int ux1, int uy1, const
 }
 
 
+void AR_MATRIX::TraceSegment( const VECTOR2I& aStart, const VECTOR2I& aEnd, int aHalfWidth,
+                              int aLayer, int aColor, AR_MATRIX::CELL_OP op_logic )
+{
+    VECTOR2I start = aStart - GetBrdCoordOrigin();
+    VECTOR2I end = aEnd - GetBrdCoordOrigin();
+
+    drawSegmentQcq( start.x, start.y, end.x, end.y, aHalfWidth, aLayer, aColor, op_logic );
+}
+
+
+void AR_MATRIX::PackCells( int aSide, MATRIX_CELL aMask, AR_CELL_BITMAP& aBitmap ) const
+{
+    aBitmap.Resize( m_Nrows, m_Ncols );
+
+    const MATRIX_CELL* p = m_BoardSide[aSide];
+
+    if( !p )
+        return;
+
+    for( int row = 0; row < m_Nrows; row++ )
+    {
+        for( int col = 0; col < m_Ncols; col++ )
+        {
+            if( p[row * m_Ncols + col] & aMask )
+                aBitmap.Set( row, col );
+        }
+    }
+}
+
+
 void AR_MATRIX::TracePcbShape( PCB_SHAPE* aShape, int aColor, int aMargin, AR_MATRIX::CELL_OP op_logic )
 {
     int half_width = ( aShape->GetWidth() / 2 ) + aMargin;
@@ -29,6 +29,9 @@
 #ifndef __AR_MATRIX_H
 #define __AR_MATRIX_H
 
+#include <cstdint>
+#include <vector>
+
 #include <layer_ids.h>
 #include <math/box2.h>
 
@@ -42,6 +45,39 @@ class LSET;
 #define AR_SIDE_TOP 0
 #define AR_SIDE_BOTTOM 1
 
+/**
+ * One bit per cell image of one side of an AR_MATRIX.
+ *
+ * Routing searches only need to know whether a cell is blocked, so packing that into 64 cells
+ * per word keeps a fine grid of a large board in cache.
+ */
+class AR_CELL_BITMAP
+{
+public:
+    void Resize( int aRows, int aCols )
+    {
+        m_cols = aCols;
+        m_words.assign( ( (size_t) aRows * aCols + 63 ) / 64, 0 );
+    }
+
+    bool Test( int aRow, int aCol ) const
+    {
+        size_t idx = (size_t) aRow * m_cols + aCol;
+        return ( m_words[idx / 64] >> ( idx % 64 ) ) & 1;
+    }
+
+    void Set( int aRow, int aCol )
+    {
+        size_t idx = (size_t) aRow * m_cols + aCol;
+        m_words[idx / 64] |= uint64_t( 1 ) << ( idx % 64 );
+    }
+
+private:
+    int                   m_cols = 0;
+    std::vector<uint64_t> m_words;
+};
+
+
 /**
  * Handle the matrix routing that describes the actual board.
  */
@@ -111,6 +147,19 @@ public:
 
     void TracePcbShape( PCB_SHAPE* aShape, int aColor, int aMargin, AR_MATRIX::CELL_OP op_logic );
 
+    /**
+     * Fill the cells within \a aHalfWidth of a segment given in board coordinates.
+     *
+     * @param aLayer is the board layer of the segment, or UNDEFINED_LAYER for all sides.
+     */
+    void TraceSegment( const VECTOR2I& aStart, const VECTOR2I& aEnd, int aHalfWidth, int aLayer,
+                       int aColor, AR_MATRIX::CELL_OP op_logic );
+
+    /**
+     * Pack the cells of \a aSide which have any bit of \a aMask set into \a aBitmap.
+     */
+    void PackCells( int aSide, MATRIX_CELL aMask, AR_CELL_BITMAP& aBitmap ) const;
+
     void CreateKeepOutRectangle( int ux0, int uy0, int ux1, int uy1, int marge, int aKeepOut,
                                  const LSET& aLayerMask );
 
@@ -43,6 +43,7 @@
 #include <pcb_edit_frame.h>
 #include <board.h>
 #include <rectpack2d/finders_interface.h>
+#include <thread_pool.h>
 
 
 constexpr bool allow_flip = true;
@@ -56,27 +57,6 @@ using rect_vector = std::vector<rect_type>;
 const int scale = (int) ( 0.01 * pcbIUScale.IU_PER_MM );
 
 
-static bool compareFootprintsbyRef( FOOTPRINT* ref, FOOTPRINT* compare )
-{
-    const wxString& refPrefix = UTIL::GetRefDesPrefix( ref->GetReference() );
-    const wxString& cmpPrefix = UTIL::GetRefDesPrefix( compare->GetReference() );
-
-    if( refPrefix != cmpPrefix )
-    {
-        return refPrefix < cmpPrefix;
-    }
-    else
-    {
-        const int refInt = GetTrailingInt( ref->GetReference() );
-        const int cmpInt = GetTrailingInt( compare->GetReference() );
-
-        return refInt < cmpInt;
-    }
-
-    return false;
-}
-
-
 // Spread a list of rectangles inside a placement area
 std::optional<rectpack2D::rect_wh> spreadRectangles( rect_vector& vecSubRects, int areaSizeX,
                                                      int areaSizeY )
@@ -125,23 +105,55 @@ std::optional<rectpack2D::rect_wh> spreadRectangles( rect_vector& vecSubRects, i
 void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBoxPosition,
                        bool aGroupBySheet, int aComponentGap, int aGroupGap )
 {
-    using FpBBoxToFootprintsPair = std::pair<BOX2I, std::vector<FOOTPRINT*>>;
+    // The footprints are only moved once, at the end: until then the placement works on their
+    // bounding boxes, computed once, and on the offset each one has been given so far.
+    struct SPREAD_ITEM
+    {
+        FOOTPRINT* m_Footprint = nullptr;
+        BOX2I      m_BBox;
+        VECTOR2I   m_Offset;
+        wxString   m_RefPrefix;     // Reference split once, for sorting
+        int        m_RefNumber = 0;
+
+        void Move( const VECTOR2I& aDelta )
+        {
+            m_BBox.Move( aDelta );
+            m_Offset += aDelta;
+        }
+    };
+
+    using FpBBoxToFootprintsPair = std::pair<BOX2I, std::vector<SPREAD_ITEM*>>;
     using SheetBBoxToFootprintsMapPair =
             std::pair<BOX2I, std::map<VECTOR2I, FpBBoxToFootprintsPair>>;
 
+    std::vector<SPREAD_ITEM> items( aFootprints->size() );
+    thread_pool&             tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), items.size(),
+            [&]( size_t ii )
+            {
+                SPREAD_ITEM&    item = items[ii];
+                const wxString& ref = ( *aFootprints )[ii]->GetReference();
+
+                item.m_Footprint = ( *aFootprints )[ii];
+                item.m_BBox = item.m_Footprint->GetBoundingBox( false );
+                item.m_RefPrefix = UTIL::GetRefDesPrefix( ref );
+                item.m_RefNumber = GetTrailingInt( ref );
+            } ).wait();
+
     std::map<wxString, SheetBBoxToFootprintsMapPair> sheetsMap;
 
     // Fill in the maps
-    for( FOOTPRINT* footprint : *aFootprints )
+    for( SPREAD_ITEM& item : items )
     {
-        wxString path =
-                aGroupBySheet ? footprint->GetPath().AsString().BeforeLast( '/' ) : wxString( wxS( "" ) );
+        wxString path = aGroupBySheet ? item.m_Footprint->GetPath().AsString().BeforeLast( '/' )
+                                      : wxString( wxS( "" ) );
 
-        VECTOR2I size = footprint->GetBoundingBox( false ).GetSize();
+        VECTOR2I size = item.m_BBox.GetSize();
         size.x += aComponentGap;
         size.y += aComponentGap;
 
-        sheetsMap[path].second[size].second.push_back( footprint );
+        sheetsMap[path].second[size].second.push_back( &item );
     }
 
     for( auto& [sheetPath, sheetPair] : sheetsMap )
@@ -192,12 +204,19 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
                 }
             }
 
-            std::sort( footprints.begin(), footprints.end(), compareFootprintsbyRef );
+            std::sort( footprints.begin(), footprints.end(),
+                       []( const SPREAD_ITEM* a, const SPREAD_ITEM* b )
+                       {
+                           if( a->m_RefPrefix != b->m_RefPrefix )
+                               return a->m_RefPrefix < b->m_RefPrefix;
+
+                           return a->m_RefNumber < b->m_RefNumber;
+                       } );
 
             // Arrange footprints in rows or columns (blocks)
             for( unsigned i = 0; i < footprints.size(); i++ )
             {
-                FOOTPRINT* footprint = footprints[i];
+                SPREAD_ITEM* item = footprints[i];
 
                 VECTOR2I position = fpSize / 2;
 
@@ -212,10 +231,9 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
                     position.y += fpSize.y * ( i / optimalCountPerLine );
                 }
 
-                BOX2I old_fp_bbox = footprint->GetBoundingBox( false );
-                footprint->Move( position - old_fp_bbox.GetOrigin() );
+                item->Move( position - item->m_BBox.GetOrigin() );
 
-                BOX2I new_fp_bbox = footprint->GetBoundingBox( false );
+                BOX2I new_fp_bbox = item->m_BBox;
                 new_fp_bbox.Inflate( aComponentGap / 2 );
                 block_bbox.Merge( new_fp_bbox );
             }
@@ -259,10 +277,10 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
             if( (uint64_t) target_pos.y + (uint64_t) target_size.y > INT_MAX / 2 )
                 target_pos.y -= INT_MAX / 2;
 
-            for( FOOTPRINT* footprint : footprints )
+            for( SPREAD_ITEM* item : footprints )
             {
-                footprint->Move( target_pos - src_bbox.GetPosition() );
-                sheet_bbox.Merge( footprint->GetBoundingBox( false ) );
+                item->Move( target_pos - src_bbox.GetPosition() );
+                sheet_bbox.Merge( item->m_BBox );
             }
 
             block_i++;
@@ -314,12 +332,14 @@ void SpreadFootprints( std::vector<FOOTPRINT*>* aFootprints, VECTOR2I aTargetBox
         for( auto& [fpSize, fpPair] : sizeToFpMap )
         {
             auto& [block_bbox, footprints] = fpPair;
-            for( FOOTPRINT* footprint : footprints )
-            {
-                footprint->Move( target_pos - src_bbox.GetPosition() );
-            }
+
+            for( SPREAD_ITEM* item : footprints )
+                item->Move( target_pos - src_bbox.GetPosition() );
         }
 
         srect_i++;
     }
+
+    for( SPREAD_ITEM& item : items )
+        item.m_Footprint->Move( item.m_Offset );
 }
@@ -2670,6 +2670,7 @@ void BOARD::SynchronizeNetsAndNetClasses( bool aResetTrackAndViaSizes )
     const std::shared_ptr<NETCLASS>& defaultNetClass = bds.m_NetSettings->GetDefaultNetclass();
 
     bds.m_NetSettings->ClearAllCaches();
+    m_lengthDelayCalc->ClearNetCache();
 
     for( NETINFO_ITEM* net : m_NetInfo )
         net->SetNetClass( bds.m_NetSettings->GetEffectiveNetClass( net->GetNetname() ) );
@@ -2897,25 +2898,30 @@ BOARD_STACKUP BOARD::GetStackupOrDefault() const
 
 std::tuple<int, double, double, double, double> BOARD::GetTrackLength( const PCB_TRACK& aTrack ) const
 {
-    std::shared_ptr<CONNECTIVITY_DATA>         connectivity = GetBoard()->GetConnectivity();
-    std::vector<LENGTH_DELAY_CALCULATION_ITEM> items;
+    std::shared_ptr<CONNECTIVITY_DATA>       connectivity = GetBoard()->GetConnectivity();
+    std::vector<const BOARD_CONNECTED_ITEM*> items;
+    int                                      count = 0;
 
     for( BOARD_CONNECTED_ITEM* boardItem : connectivity->GetConnectedItems( &aTrack, EXCLUDE_ZONES ) )
     {
-        LENGTH_DELAY_CALCULATION_ITEM item = GetLengthCalculation()->GetLengthCalculationItem( boardItem );
+        items.push_back( boardItem );
 
-        if( item.Type() != LENGTH_DELAY_CALCULATION_ITEM::TYPE::UNKNOWN )
-            items.push_back( std::move( item ) );
+        // Items which make up a length calculation item
+        if( boardItem->Type() == PCB_TRACE_T || boardItem->Type() == PCB_ARC_T
+                || boardItem->Type() == PCB_VIA_T || boardItem->Type() == PCB_PAD_T )
+        {
+            count++;
+        }
     }
 
     constexpr PATH_OPTIMISATIONS opts = {
         .OptimiseViaLayers = true, .MergeTracks = true, .OptimiseTracesInPads = true, .InferViaInPad = false
     };
-    LENGTH_DELAY_STATS details = GetLengthCalculation()->CalculateLengthDetails(
-            items, opts, nullptr, nullptr, LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
+    LENGTH_DELAY_STATS details = GetLengthCalculation()->CalculateNetLengthDetails(
+            aTrack.GetNetCode(), items, opts, LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
             LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL );
 
-    return std::make_tuple( items.size(), details.TrackLength + details.ViaLength, details.PadToDieLength,
+    return std::make_tuple( count, details.TrackLength + details.ViaLength, details.PadToDieLength,
                             details.TrackDelay + details.ViaDelay, details.PadToDieDelay );
 }
 
@@ -3230,12 +3236,17 @@ void BOARD::RemoveAllListeners()
 
 void BOARD::OnItemChanged( BOARD_ITEM* aItem )
 {
+    // Cached lengths must be dropped before the listeners (e.g. the net inspector) query them
+    m_lengthDelayCalc->InvalidateNets( { aItem } );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemChanged, *this, aItem );
 }
 
 
 void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 {
+    m_lengthDelayCalc->InvalidateNets( aItems );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardItemsChanged, *this, aItems );
 }
 
@@ -3243,6 +3254,10 @@ void BOARD::OnItemsChanged( std::vector<BOARD_ITEM*>& aItems )
 void BOARD::OnItemsCompositeUpdate( std::vector<BOARD_ITEM*>& aAddedItems, std::vector<BOARD_ITEM*>& aRemovedItems,
                                     std::vector<BOARD_ITEM*>& aChangedItems )
 {
+    m_lengthDelayCalc->InvalidateNets( aAddedItems );
+    m_lengthDelayCalc->InvalidateNets( aRemovedItems );
+    m_lengthDelayCalc->InvalidateNets( aChangedItems );
+
     InvokeListeners( &BOARD_LISTENER::OnBoardCompositeUpdate, *this, aAddedItems, aRemovedItems, aChangedItems );
 }
 
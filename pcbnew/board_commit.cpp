@@ -25,16 +25,20 @@
 
 #include <macros.h>
 #include <pgm_base.h>
+#include <advanced_config.h>
 #include <settings/settings_manager.h>
 #include <board.h>
 #include <footprint.h>
+#include <pad.h>
 #include <lset.h>
 #include <pcb_group.h>
 #include <pcb_track.h>
 #include <pcb_shape.h>
+#include <zone.h>
 #include <tool/tool_manager.h>
 #include <tools/pcb_selection_tool.h>
 #include <tools/zone_filler_tool.h>
+#include <tools/drc_tool.h>
 #include <view/view.h>
 #include <board_commit.h>
 #include <tools/pcb_tool_base.h>
@@ -43,10 +47,10 @@
 #include <connectivity/connectivity_algo.h>
 #include <teardrop/teardrop.h>
 #include <pcb_board_outline.h>
+#include <geometry/packed_rtree.h>
 
-#include <functional>
+#include <unordered_set>
 #include <project/project_file.h>
-using namespace std::placeholders;
 
 
 BOARD_COMMIT::BOARD_COMMIT( TOOL_BASE* aTool ) :
@@ -129,7 +133,51 @@ COMMIT& BOARD_COMMIT::Stage( const PICKED_ITEMS_LIST& aItems, UNDO_REDO aModFlag
 }
 
 
+/**
+ * @return true if \a aAfter connects exactly like \a aBefore: same pads, in the same place, on the
+ * same nets, and still the pad objects known to \a aAlgo.  Changing anything else on a footprint
+ * (fields, graphics, 3D models...) then leaves the connectivity and the ratsnest of its nets
+ * untouched.
+ */
+static bool footprintConnectionsMatch( const FOOTPRINT* aBefore, const FOOTPRINT* aAfter,
+                                       const CN_CONNECTIVITY_ALGO& aAlgo )
+{
+    // Footprint zones are connected items too; don't bother comparing them
+    if( !aBefore->Zones().empty() || !aAfter->Zones().empty() )
+        return false;
+
+    if( aBefore->Pads().size() != aAfter->Pads().size()
+            || aBefore->GetAttributes() != aAfter->GetAttributes()
+            || aBefore->GetDuplicatePadNumbersAreJumpers()
+                       != aAfter->GetDuplicatePadNumbersAreJumpers()
+            || aBefore->JumperPadGroups() != aAfter->JumperPadGroups() )
+    {
+        return false;
+    }
+
+    for( size_t ii = 0; ii < aBefore->Pads().size(); ++ii )
+    {
+        const PAD* before = aBefore->Pads()[ii];
+        const PAD* after = aAfter->Pads()[ii];
+
+        // Assigning a footprint re-creates its pads
+        if( !aAlgo.ItemExists( after ) )
+            return false;
+
+        if( before->GetNetCode() != after->GetNetCode()
+                || before->GetNumber() != after->GetNumber()
+                || !( *before == *after ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>* aStaleZones,
+                                    std::vector<DAMAGE>& aDamage,
                                     std::vector<BOX2I>& aStaleRuleAreas )
 {
     wxCHECK( aChangedItem, /* void */ );
@@ -137,12 +185,14 @@ void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>
     if( aStaleZones && aChangedItem->Type() == PCB_ZONE_T )
         aStaleZones->push_back( static_cast<ZONE*>( aChangedItem ) );
 
-    aChangedItem->RunOnChildren( std::bind( &BOARD_COMMIT::propagateDamage, this, _1, aStaleZones, aStaleRuleAreas ),
-                                 RECURSE_MODE::NO_RECURSE );
+    aChangedItem->RunOnChildren(
+            [&]( BOARD_ITEM* aChild )
+            {
+                propagateDamage( aChild, aStaleZones, aDamage, aStaleRuleAreas );
+            },
+            RECURSE_MODE::NO_RECURSE );
 
-    BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() );
-    BOX2I  damageBBox = aChangedItem->GetBoundingBox();
-    LSET   damageLayers = aChangedItem->GetLayerSet();
+    BOX2I damageBBox = aChangedItem->GetBoundingBox();
 
     if( m_isBoardEditor && aChangedItem->Type() == PCB_ZONE_T )
     {
@@ -151,24 +201,81 @@ void BOARD_COMMIT::propagateDamage( BOARD_ITEM* aChangedItem, std::vector<ZONE*>
             aStaleRuleAreas.push_back( damageBBox );
     }
 
-    if( aStaleZones )
+    if( !aStaleZones )
+        return;
+
+    // Board outline changes move the zone outlines themselves, so those zones are refilled
+    // completely.  Copper items only affect the fill around them.
+    LSET damageLayers = aChangedItem->GetLayerSet();
+
+    bool outlineDamage = damageLayers.test( Edge_Cuts ) || damageLayers.test( Margin );
+
+    if( outlineDamage )
+        damageLayers = LSET::PhysicalLayersMask();
+    else
+        damageLayers &= LSET::AllCuMask();
+
+    // The bounding box and layers are taken now: modified copies are deleted before the
+    // damage is resolved.
+    if( damageLayers.any() )
+        aDamage.push_back( { aChangedItem, damageBBox, damageLayers, outlineDamage } );
+}
+
+
+void BOARD_COMMIT::resolveDamage( const std::vector<DAMAGE>& aDamage,
+                                  std::vector<ZONE*>& aStaleZones,
+                                  std::vector<std::pair<ZONE*, BOX2I>>& aStaleZoneRegions )
+{
+    if( aDamage.empty() )
+        return;
+
+    BOARD*              board = static_cast<BOARD*>( m_toolMgr->GetModel() );
+    PACKED_RTREE<ZONE*> zoneIndex;
+
+    for( ZONE* zone : board->Zones() )
     {
-        if( damageLayers.test( Edge_Cuts ) || damageLayers.test( Margin ) )
-            damageLayers = LSET::PhysicalLayersMask();
-        else
-            damageLayers &= LSET::AllCuMask();
+        if( !zone->GetIsRuleArea() )
+            zoneIndex.Add( zone->GetBoundingBox(), zone );
+    }
 
-        if( damageLayers.any() )
-        {
-            for( ZONE* zone : board->Zones() )
-            {
-                if( zone->GetIsRuleArea() )
-                    continue;
+    zoneIndex.Build();
 
-                if( ( zone->GetLayerSet() & damageLayers ).any() && zone->GetBoundingBox().Intersects( damageBBox ) )
-                    aStaleZones->push_back( zone );
-            }
-        }
+    // Large commits damage each zone many times over; a zone is only listed once, and regions
+    // are only worth keeping for zones that don't need a complete refill.
+    std::unordered_set<ZONE*>            fullRefill( aStaleZones.begin(), aStaleZones.end() );
+    std::vector<std::pair<ZONE*, BOX2I>> regions;
+
+    for( const DAMAGE& damage : aDamage )
+    {
+        auto visitor =
+                [&]( ZONE* aZone )
+                {
+                    if( !( aZone->GetLayerSet() & damage.m_Layers ).any()
+                            || !aZone->GetBoundingBox().Intersects( damage.m_BBox ) )
+                    {
+                        return true;
+                    }
+
+                    if( damage.m_OutlineDamage || aZone == damage.m_Item )
+                    {
+                        if( fullRefill.insert( aZone ).second )
+                            aStaleZones.push_back( aZone );
+                    }
+                    else
+                    {
+                        regions.emplace_back( aZone, damage.m_BBox );
+                    }
+
+                    return true;
+                };
+
+        zoneIndex.Search( damage.m_BBox, visitor );
+    }
+
+    for( const auto& [zone, damage] : regions )
+    {
+        if( !fullRefill.count( zone ) )
+            aStaleZoneRegions.emplace_back( zone, damage );
     }
 }
 
@@ -194,7 +301,11 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     std::set<PCB_TRACK*>     staleTeardropTracks;
     std::vector<ZONE*>       staleZonesStorage;
     std::vector<ZONE*>*      staleZones = nullptr;
+    std::vector<std::pair<ZONE*, BOX2I>> staleZoneRegions;
+    std::vector<DAMAGE>      damageList;
     std::vector<BOX2I>       staleRuleAreas;
+    std::set<KIID>           staleDRCItems;
+    bool                     incrementalDRC = false;
 
     if( Empty() )
         return;
@@ -209,6 +320,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     std::vector<BOARD_ITEM*> bulkAddedItems;
     std::vector<BOARD_ITEM*> bulkRemovedItems;
     std::vector<BOARD_ITEM*> itemsChanged;
+    std::vector<BOARD_ITEM*> connectivityChanged;
 
     if( m_isBoardEditor && !( aCommitFlags & ZONE_FILL_OP )
                         && ( frame && frame->GetPcbNewSettings()->m_AutoRefillZones ) )
@@ -220,6 +332,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             zone->CacheBoundingBox();
     }
 
+    if( m_isBoardEditor && frame && ADVANCED_CFG::GetCfg().m_IncrementalDRC )
+        incrementalDRC = true;
+
     for( COMMIT_LINE& entry : m_entries )
     {
         if( !entry.m_item || !entry.m_item->IsBOARD_ITEM() )
@@ -227,6 +342,22 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
 
         BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( entry.m_item );
 
+        // Markers are the output of DRC; don't let a DRC commit re-trigger it.
+        if( incrementalDRC && boardItem->Type() != PCB_MARKER_T )
+        {
+            staleDRCItems.insert( boardItem->m_Uuid );
+
+            if( boardItem->Type() == PCB_FOOTPRINT_T )
+            {
+                boardItem->RunOnChildren(
+                        [&]( BOARD_ITEM* child )
+                        {
+                            staleDRCItems.insert( child->m_Uuid );
+                        },
+                        RECURSE_MODE::NO_RECURSE );
+            }
+        }
+
         if( m_isBoardEditor )
         {
             if( boardItem->Type() == PCB_VIA_T || boardItem->Type() == PCB_FOOTPRINT_T
@@ -328,7 +459,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             }
 
             if( boardItem->Type() != PCB_MARKER_T )
-                propagateDamage( boardItem, staleZones, staleRuleAreas );
+                propagateDamage( boardItem, staleZones, damageList, staleRuleAreas );
 
             if( view && boardItem->Type() != PCB_NETINFO_T )
                 view->Add( boardItem );
@@ -361,7 +492,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 parentGroup->RemoveItem( boardItem );
 
             if( boardItem->Type() != PCB_MARKER_T )
-                propagateDamage( boardItem, staleZones, staleRuleAreas );
+                propagateDamage( boardItem, staleZones, damageList, staleRuleAreas );
 
             switch( boardItem->Type() )
             {
@@ -438,16 +569,31 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 undoList.PushItem( itemWrapper );
             }
 
-            if( !( aCommitFlags & SKIP_CONNECTIVITY ) )
+            // Don't rebuild the connectivity and ratsnest of every net of a footprint when only
+            // its fields or graphics were edited.
+            bool connectionsChanged = true;
+
+            if( boardItem->Type() == PCB_FOOTPRINT_T && boardItemCopy
+                    && boardItemCopy->Type() == PCB_FOOTPRINT_T )
+            {
+                connectionsChanged = !footprintConnectionsMatch(
+                        static_cast<FOOTPRINT*>( boardItemCopy ),
+                        static_cast<FOOTPRINT*>( boardItem ),
+                        *connectivity->GetConnectivityAlgo() );
+            }
+
+            // The copy is gone by the time the connectivity is updated, so its nets are
+            // marked now.
+            if( !( aCommitFlags & SKIP_CONNECTIVITY ) && connectionsChanged )
             {
                 connectivity->MarkItemNetAsDirty( boardItemCopy );
-                connectivity->Update( boardItem );
+                connectivityChanged.push_back( boardItem );
             }
 
             if( boardItem->Type() != PCB_MARKER_T )
             {
-                propagateDamage( boardItemCopy, staleZones, staleRuleAreas );   // before
-                propagateDamage( boardItem, staleZones, staleRuleAreas );       // after
+                propagateDamage( boardItemCopy, staleZones, damageList, staleRuleAreas ); // before
+                propagateDamage( boardItem, staleZones, damageList, staleRuleAreas );     // after
             }
 
             updateComponentClasses( boardItem );
@@ -477,6 +623,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 RECURSE_MODE::RECURSE );
     } // ... and regenerate them.
 
+    if( !connectivityChanged.empty() )
+        connectivity->Update( connectivityChanged );
+
+    if( staleZones )
+        resolveDamage( damageList, *staleZones, staleZoneRegions );
+
     // Invalidate component classes
     board->GetComponentClassManager().InvalidateComponentClasses();
 
@@ -602,9 +754,21 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
         for( ZONE* zone : *staleZones )
             zoneFillerTool->DirtyZone( zone );
 
+        for( const auto& [zone, damage] : staleZoneRegions )
+            zoneFillerTool->DirtyZone( zone, damage );
+
         m_toolMgr->PostAction( PCB_ACTIONS::zoneFillDirty );
     }
 
+    if( !staleDRCItems.empty() )
+    {
+        if( DRC_TOOL* drcTool = m_toolMgr->GetTool<DRC_TOOL>() )
+        {
+            drcTool->DirtyItems( staleDRCItems );
+            m_toolMgr->PostAction( PCB_ACTIONS::runIncrementalDRC );
+        }
+    }
+
     m_toolMgr->PostAction( PCB_ACTIONS::rehatchShapes );
 
     if( selectedModified )
@@ -658,7 +822,14 @@ EDA_ITEM* BOARD_COMMIT::makeImage( EDA_ITEM* aItem ) const
 
 EDA_ITEM* BOARD_COMMIT::MakeImage( EDA_ITEM* aItem )
 {
-    EDA_ITEM* clone = aItem->Clone();
+    EDA_ITEM* clone;
+
+    // Zone fills are large and rarely touched by an edit, so the image shares them
+    if( aItem->Type() == PCB_ZONE_T )
+        clone = static_cast<ZONE*>( aItem )->CloneSharingFills();
+    else
+        clone = aItem->Clone();
+
     clone->SetFlags( UR_TRANSIENT );
 
     return clone;
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <commit.h>
+#include <lset.h>
 
 class BOARD_ITEM;
 class PCB_SHAPE;
@@ -76,8 +77,30 @@ private:
 
     EDA_ITEM* makeImage( EDA_ITEM* aItem ) const override;
 
+    /// Area and layers changed by an item of the commit, resolved against the zones once the
+    /// whole commit has been applied.
+    struct DAMAGE
+    {
+        const BOARD_ITEM* m_Item;
+        BOX2I             m_BBox;
+        LSET              m_Layers;
+        bool              m_OutlineDamage;  ///< Board outline changed: refill zones completely
+    };
+
+    /**
+     * Record the damage done by a change of \a aItem and its children in \a aDamage.  Changed
+     * zones themselves go straight to \a aStaleZones.
+     */
     void propagateDamage( BOARD_ITEM* aItem, std::vector<ZONE*>* aStaleZones,
-                          std::vector<BOX2I>& aStaleRuleAreas );
+                          std::vector<DAMAGE>& aDamage, std::vector<BOX2I>& aStaleRuleAreas );
+
+    /**
+     * Collect the zones hit by \a aDamage.  Zones which only need refilling around the changed
+     * items go to \a aStaleZoneRegions with the damaged areas; the others need a complete
+     * refill and go to \a aStaleZones.
+     */
+    void resolveDamage( const std::vector<DAMAGE>& aDamage, std::vector<ZONE*>& aStaleZones,
+                        std::vector<std::pair<ZONE*, BOX2I>>& aStaleZoneRegions );
 
 private:
     TOOL_MANAGER*  m_toolMgr;
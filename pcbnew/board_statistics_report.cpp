@@ -31,11 +31,17 @@
 #include <i18n_utility.h>
 #include <nlohmann/json.hpp>
 #include <string_utils.h>
+#include <geometry/packed_rtree.h>
+#include <thread_pool.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <wx/datetime.h>
 
 BOARD_STATISTICS_DATA::BOARD_STATISTICS_DATA() :
@@ -152,15 +158,12 @@ static void updatePadCounts( FOOTPRINT* aFootprint, BOARD_STATISTICS_DATA& aData
 }
 
 
-void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOptions, BOARD_STATISTICS_DATA& aData )
+/**
+ * Count footprints, pads, vias and drills, and find the smallest track width and drill.
+ */
+static void computeCounts( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOptions,
+                           BOARD_STATISTICS_DATA& aData )
 {
-    aData.ResetCounts();
-
-    if( !aBoard )
-        return;
-
-    static const std::vector<KICAD_T> trackTypes = { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T };
-
     for( FOOTPRINT* footprint : aBoard->Footprints() )
     {
         if( aOptions.excludeFootprintsWithoutPads && footprint->Pads().empty() )
@@ -189,31 +192,6 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
         if( track->Type() == PCB_TRACE_T )
             aData.minTrackWidth = std::min( aData.minTrackWidth, track->GetWidth() );
 
-        if( !track->IsType( trackTypes ) )
-            continue;
-
-        PCB_LAYER_ID layer = track->GetLayer();
-        auto         trackShapeA = track->GetEffectiveShape( layer );
-
-        for( PCB_TRACK* otherTrack : aBoard->Tracks() )
-        {
-            if( layer != otherTrack->GetLayer() )
-                continue;
-
-            if( track->GetNetCode() == otherTrack->GetNetCode() )
-                continue;
-
-            if( !otherTrack->IsType( trackTypes ) )
-                continue;
-
-            int  actual = 0;
-            auto trackShapeB = otherTrack->GetEffectiveShape( layer );
-            bool collide = trackShapeA->Collide( trackShapeB.get(), aData.minClearanceTrackToTrack, &actual );
-
-            if( collide )
-                aData.minClearanceTrackToTrack = std::min( aData.minClearanceTrackToTrack, actual );
-        }
-
         if( track->Type() == PCB_VIA_T )
         {
             PCB_VIA* via = static_cast<PCB_VIA*>( track );
@@ -246,7 +224,98 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
         if( drill.shape == PAD_DRILL_SHAPE::CIRCLE )
             aData.minDrillSize = std::min( aData.minDrillSize, drill.xSize );
     }
+}
+
+
+/**
+ * Find the smallest distance between two tracks (or vias) of different nets on the same layer.
+ *
+ * Each track is only tested against the tracks of its layer whose boxes are within the best
+ * distance found so far, so the search shrinks as soon as two close tracks are found.
+ */
+static int computeMinTrackClearance( BOARD* aBoard )
+{
+    std::vector<PCB_TRACK*>                      tracks;
+    std::vector<std::shared_ptr<SHAPE>>          shapes;
+    std::map<PCB_LAYER_ID, PACKED_RTREE<size_t>> layerTrees;
+    std::map<PCB_LAYER_ID, BOX2I>                layerExtents;
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        if( track->Type() != PCB_TRACE_T && track->Type() != PCB_ARC_T
+                && track->Type() != PCB_VIA_T )
+        {
+            continue;
+        }
+
+        PCB_LAYER_ID layer = track->GetLayer();
+        BOX2I        bbox = track->GetBoundingBox();
+
+        layerTrees[layer].Add( bbox, tracks.size() );
+
+        if( layerExtents.count( layer ) )
+            layerExtents[layer].Merge( bbox );
+        else
+            layerExtents[layer] = bbox;
+
+        tracks.push_back( track );
+        shapes.push_back( track->GetEffectiveShape( layer ) );
+    }
+
+    for( auto& [layer, tree] : layerTrees )
+        tree.Build();
+
+    std::atomic<int> best( std::numeric_limits<int>::max() );
+    thread_pool&     tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), tracks.size(),
+            [&]( size_t ii )
+            {
+                PCB_TRACK*   track = tracks[ii];
+                PCB_LAYER_ID layer = track->GetLayer();
+                int          clearance = best.load();
+                BOX2I        query = track->GetBoundingBox();
+
+                // Until two tracks are close, look at the whole layer
+                if( clearance < std::numeric_limits<int>::max() / 4 )
+                    query.Inflate( clearance );
+                else
+                    query = layerExtents.at( layer );
+
+                auto visitor =
+                        [&]( size_t jj )
+                        {
+                            // Each pair once
+                            if( jj <= ii || tracks[jj]->GetNetCode() == track->GetNetCode() )
+                                return true;
+
+                            int current = best.load();
+                            int actual = 0;
+
+                            if( shapes[ii]->Collide( shapes[jj].get(), current, &actual ) )
+                            {
+                                while( actual < current
+                                       && !best.compare_exchange_weak( current, actual ) )
+                                {
+                                }
+                            }
+
+                            return true;
+                        };
+
+                layerTrees.at( layer ).Search( query, visitor );
+            } ).wait();
+
+    return best.load();
+}
 
+
+/**
+ * Compute the board size and area from its outline.
+ */
+static void computeBoardArea( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOptions,
+                              BOARD_STATISTICS_DATA& aData )
+{
     SHAPE_POLY_SET polySet;
     aData.hasOutline = aBoard->GetBoardPolygonOutlines( polySet, false );
 
@@ -303,16 +372,21 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
         aData.boardHeight = static_cast<int>( bbox.GetHeight() );
 
     }
+}
 
-    // Now determine the courtyard areas which reflects how much space is occupied by components
-    // This will always assume all components are populated as its intended for
-    // layout purposes and arguing with people saying theres not enough space.
+
+/**
+ * Determine the courtyard areas, which reflect how much space is occupied by components.
+ *
+ * This will always assume all components are populated as its intended for layout purposes
+ * and arguing with people saying theres not enough space.
+ */
+static void computeCourtyardAreas( BOARD* aBoard, int aMinPadClearanceOuter,
+                                   BOARD_STATISTICS_DATA& aData )
+{
     SHAPE_POLY_SET frontShapesForArea;
     SHAPE_POLY_SET backShapesForArea;
 
-    std::shared_ptr<NET_SETTINGS>& netSettings = aBoard->GetDesignSettings().m_NetSettings;
-    int                            minPadClearanceOuter = netSettings->GetDefaultNetclass()->GetClearance();
-
     for( FOOTPRINT* fp : aBoard->Footprints() )
     {
         const SHAPE_POLY_SET& frontA = fp->GetCourtyard( F_CrtYd );
@@ -334,10 +408,10 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
             if( pad->GetAttribute() != PAD_ATTRIB::NPTH )
             {
                 pad->TransformShapeToPolygon( frontShapesForArea, F_Cu,
-                                              std::min( minPadClearanceOuter, pad->GetOwnClearance( F_Cu ) ),
+                                              std::min( aMinPadClearanceOuter, pad->GetOwnClearance( F_Cu ) ),
                                               ARC_LOW_DEF, ERROR_INSIDE );
                 pad->TransformShapeToPolygon( backShapesForArea, B_Cu,
-                                              std::min( minPadClearanceOuter, pad->GetOwnClearance( B_Cu ) ),
+                                              std::min( aMinPadClearanceOuter, pad->GetOwnClearance( B_Cu ) ),
                                               ARC_LOW_DEF, ERROR_INSIDE );
             }
             else
@@ -355,13 +429,15 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
 
     aData.frontFootprintCourtyardArea = frontShapesForArea.Area();
     aData.backFootprintCourtyardArea = backShapesForArea.Area();
+}
 
-    if( aData.hasOutline )
-    {
-        aData.frontFootprintDensity = aData.frontFootprintCourtyardArea * 100 / aData.boardArea;
-        aData.backFootprintDensity = aData.backFootprintCourtyardArea * 100 / aData.boardArea;
-    }
 
+/**
+ * Compute the copper areas of the outer layers.
+ */
+static void computeCopperAreas( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOptions,
+                                BOARD_STATISTICS_DATA& aData )
+{
     SHAPE_POLY_SET frontCopper;
     SHAPE_POLY_SET backCopper;
     SHAPE_POLY_SET frontHoles;
@@ -416,8 +492,118 @@ void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOpt
 
     aData.frontCopperArea = frontCopper.Area();
     aData.backCopperArea = backCopper.Area();
+}
+
+
+/**
+ * The last statistics computed, reused while the board is not modified.
+ */
+struct BOARD_STATISTICS_CACHE
+{
+    bool                     m_valid = false;
+    KIID                     m_boardId;
+    int                      m_timeStamp = -1;
+    BOARD_STATISTICS_OPTIONS m_options;
+    int                      m_minPadClearance = 0;
+    BOARD_STATISTICS_DATA    m_data;
+};
+
+
+static std::mutex             s_statisticsCacheMutex;
+static BOARD_STATISTICS_CACHE s_statisticsCache;
+
+
+void ComputeBoardStatistics( BOARD* aBoard, const BOARD_STATISTICS_OPTIONS& aOptions, BOARD_STATISTICS_DATA& aData )
+{
+    aData.ResetCounts();
+
+    if( !aBoard )
+        return;
+
+    std::shared_ptr<NET_SETTINGS>& netSettings = aBoard->GetDesignSettings().m_NetSettings;
+    int                            minPadClearanceOuter = netSettings->GetDefaultNetclass()->GetClearance();
+
+    auto sameInputs =
+            [&]( const BOARD_STATISTICS_CACHE& aCache )
+            {
+                // Callers don't all ask for the same entries, so they are part of the key
+                return aCache.m_valid
+                       && aCache.m_boardId == aBoard->m_Uuid
+                       && aCache.m_timeStamp == aBoard->GetTimeStamp()
+                       && aCache.m_options.excludeFootprintsWithoutPads == aOptions.excludeFootprintsWithoutPads
+                       && aCache.m_options.subtractHolesFromBoardArea == aOptions.subtractHolesFromBoardArea
+                       && aCache.m_options.subtractHolesFromCopperAreas == aOptions.subtractHolesFromCopperAreas
+                       && aCache.m_minPadClearance == minPadClearanceOuter
+                       && aCache.m_data.footprintEntries.size() == aData.footprintEntries.size()
+                       && aCache.m_data.padEntries.size() == aData.padEntries.size()
+                       && aCache.m_data.padPropertyEntries.size() == aData.padPropertyEntries.size()
+                       && aCache.m_data.viaEntries.size() == aData.viaEntries.size();
+            };
+
+    {
+        std::lock_guard<std::mutex> lock( s_statisticsCacheMutex );
+
+        if( sameInputs( s_statisticsCache ) )
+        {
+            aData = s_statisticsCache.m_data;
+
+            // Stackup edits don't modify the board items
+            aData.boardThickness = aBoard->GetStackupOrDefault().BuildBoardThicknessFromStackup();
+            return;
+        }
+    }
+
+    // The passes below are independent and each write their own members of aData.  The track
+    // clearance search runs its own loop on the pool from this thread, after the others are
+    // queued, so no pool thread waits on the pool.
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> passes;
+
+    passes.push_back( tp.submit_task(
+            [&]()
+            {
+                computeCounts( aBoard, aOptions, aData );
+            } ) );
+
+    passes.push_back( tp.submit_task(
+            [&]()
+            {
+                computeBoardArea( aBoard, aOptions, aData );
+            } ) );
+
+    passes.push_back( tp.submit_task(
+            [&]()
+            {
+                computeCourtyardAreas( aBoard, minPadClearanceOuter, aData );
+            } ) );
+
+    passes.push_back( tp.submit_task(
+            [&]()
+            {
+                computeCopperAreas( aBoard, aOptions, aData );
+            } ) );
+
+    aData.minClearanceTrackToTrack = computeMinTrackClearance( aBoard );
+
+    for( std::future<void>& pass : passes )
+        pass.wait();
+
+    if( aData.hasOutline )
+    {
+        aData.frontFootprintDensity = aData.frontFootprintCourtyardArea * 100 / aData.boardArea;
+        aData.backFootprintDensity = aData.backFootprintCourtyardArea * 100 / aData.boardArea;
+    }
 
     aData.boardThickness = aBoard->GetStackupOrDefault().BuildBoardThicknessFromStackup();
+
+    std::lock_guard<std::mutex> lock( s_statisticsCacheMutex );
+
+    s_statisticsCache.m_valid = true;
+    s_statisticsCache.m_boardId = aBoard->m_Uuid;
+    s_statisticsCache.m_timeStamp = aBoard->GetTimeStamp();
+    s_statisticsCache.m_options = aOptions;
+    s_statisticsCache.m_minPadClearance = minPadClearanceOuter;
+    s_statisticsCache.m_data = aData;
 }
 
 
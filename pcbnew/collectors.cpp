@@ -22,7 +22,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <collectors.h>
+#include <board.h>
 #include <board_item.h>             // class BOARD_ITEM
 
 #include <footprint.h>
@@ -545,6 +549,87 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const std::vector<KICAD_T>&
 }
 
 
+void GENERAL_COLLECTOR::Collect( BOARD* aBoard, const KIGFX::VIEW* aView,
+                                 const std::vector<KICAD_T>& aScanTypes, const VECTOR2I& aRefPos,
+                                 const COLLECTORS_GUIDE& aGuide )
+{
+    Empty();
+    Empty2nd();
+    SetGuide( &aGuide );
+    SetScanTypes( aScanTypes );
+    SetRefPos( aRefPos );
+
+    wxCHECK_RET( aBoard && aView, "" );
+
+    // Inspect() accepts hits up to twice the accuracy away (zone corners)
+    BOX2I area( aRefPos, VECTOR2I( 0, 0 ) );
+    area.Inflate( 2 * aGuide.Accuracy() + 1 );
+
+    // Candidates are ranked by the position of their type in the scan list, so the collection
+    // comes out in the same order as with a full Visit()
+    std::unordered_set<EDA_ITEM*>              seen;
+    std::vector<std::pair<size_t, EDA_ITEM*>>  candidates;
+
+    auto addCandidate =
+            [&]( EDA_ITEM* aCandidate )
+            {
+                if( !seen.insert( aCandidate ).second )
+                    return;
+
+                auto it = std::find( aScanTypes.begin(), aScanTypes.end(), aCandidate->Type() );
+
+                if( it != aScanTypes.end() )
+                    candidates.emplace_back( it - aScanTypes.begin(), aCandidate );
+                else if( aCandidate->IsType( aScanTypes ) )
+                    candidates.emplace_back( aScanTypes.size(), aCandidate );
+            };
+
+    aView->Query( area,
+            [&]( KIGFX::VIEW_ITEM* aViewItem ) -> bool
+            {
+                if( !aViewItem->IsBOARD_ITEM() )
+                    return true;
+
+                BOARD_ITEM* item = static_cast<BOARD_ITEM*>( aViewItem );
+
+                addCandidate( item );
+
+                if( item->Type() == PCB_TABLE_T )
+                {
+                    item->RunOnChildren(
+                            [&]( BOARD_ITEM* aCell )
+                            {
+                                addCandidate( aCell );
+                            },
+                            RECURSE_MODE::NO_RECURSE );
+                }
+
+                return true;
+            } );
+
+    for( PCB_GROUP* group : aBoard->Groups() )
+    {
+        if( group->GetBoundingBox().Intersects( area ) )
+            addCandidate( group );
+    }
+
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      []( const std::pair<size_t, EDA_ITEM*>& a,
+                          const std::pair<size_t, EDA_ITEM*>& b )
+                      {
+                          return a.first < b.first;
+                      } );
+
+    for( const auto& [rank, item] : candidates )
+        Inspect( item, nullptr );
+
+    for( EDA_ITEM* item : m_List2nd )
+        Append( item );
+
+    Empty2nd();
+}
+
+
 INSPECT_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the the scanList,
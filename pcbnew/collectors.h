@@ -313,6 +313,17 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const std::vector<KICAD_T>& aScanList,
                   const VECTOR2I& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+    /**
+     * Same as above, but only inspect the items the spatial index of \a aView finds near
+     * \a aRefPos instead of walking every item of the board.
+     *
+     * Items on hidden view layers are not drawn and therefore not collected.  Board groups
+     * and table cells are not view items; they are taken from \a aBoard and from the tables
+     * found.
+     */
+    void Collect( BOARD* aBoard, const KIGFX::VIEW* aView, const std::vector<KICAD_T>& aScanList,
+                  const VECTOR2I& aRefPos, const COLLECTORS_GUIDE& aGuide );
 };
 
 
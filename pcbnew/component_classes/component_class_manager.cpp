@@ -496,12 +496,7 @@ std::unordered_set<wxString> COMPONENT_CLASS_MANAGER::GetClassNames() const
 void COMPONENT_CLASS_MANAGER::RebuildRequiredCaches( FOOTPRINT* aFootprint ) const
 {
     if( aFootprint )
-    {
-        aFootprint->BuildCourtyardCaches();
-    }
+        aFootprint->EnsureCourtyardCaches();
     else
-    {
-        for( FOOTPRINT* fp : m_board->Footprints() )
-            fp->BuildCourtyardCaches();
-    }
+        FOOTPRINT::EnsureCourtyardCaches( m_board->Footprints() );
 }
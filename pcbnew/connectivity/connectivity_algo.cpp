@@ -220,10 +220,36 @@ bool CN_CONNECTIVITY_ALGO::Add( BOARD_ITEM* aItem )
 }
 
 
+void CN_CONNECTIVITY_ALGO::ApplyChanges( const std::vector<BOARD_ITEM*>& aAdded,
+                                         const std::vector<BOARD_ITEM*>& aRemoved,
+                                         const std::vector<BOARD_ITEM*>& aModified )
+{
+    for( BOARD_ITEM* item : aRemoved )
+        Remove( item );
+
+    for( BOARD_ITEM* item : aModified )
+    {
+        Remove( item );
+        Add( item );
+    }
+
+    for( BOARD_ITEM* item : aAdded )
+        Add( item );
+}
+
+
 void CN_CONNECTIVITY_ALGO::RemoveInvalidRefs()
 {
     for( CN_ITEM* item : m_itemList )
+    {
+        size_t count = item->ConnectedItems().size();
+
         item->RemoveInvalidRefs();
+
+        // The item may have been split off its cluster
+        if( item->ConnectedItems().size() != count )
+            m_touchedItems.insert( item );
+    }
 }
 
 
@@ -244,7 +270,10 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     m_itemList.RemoveInvalidItems( garbage );
 
     for( CN_ITEM* item : garbage )
+    {
+        m_deletedItems.insert( item );
         delete item;
+    }
 
 #ifdef PROFILE
     garbage_collection.Show();
@@ -259,6 +288,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
                       return aItem->Dirty();
                   } );
 
+    m_touchedItems.insert( dirtyItems.begin(), dirtyItems.end() );
+
     if( m_progressReporter )
     {
         m_progressReporter->SetMaxProgress( dirtyItems.size() );
@@ -286,7 +317,8 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
                             m_progressReporter->AdvanceProgress();
 
                         return 1;
-                    } );
+                    },
+                    PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
         }
 
         for( const std::future<size_t>& ret : returns )
@@ -323,6 +355,21 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones, int aSingleNet )
+{
+    if( aSingleNet < 0 )
+        return searchClusters( aMode, aExcludeZones, nullptr );
+
+    return searchClusters( aMode, aExcludeZones,
+                           [aSingleNet]( const CN_ITEM* aItem )
+                           {
+                               return aItem->Net() == aSingleNet;
+                           } );
+}
+
+
+const CN_CONNECTIVITY_ALGO::CLUSTERS
+CN_CONNECTIVITY_ALGO::searchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones,
+                                      const std::function<bool( const CN_ITEM* )>& aSeedFilter )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
@@ -337,7 +384,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZo
     std::set<CN_ITEM*> visited;
 
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aExcludeZones]( CN_ITEM *aItem )
+            [&item_set, withinAnyNet, &aSeedFilter, &aExcludeZones]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -345,7 +392,7 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZo
                 if( !aItem->Valid() )
                     return;
 
-                if( aSingleNet >=0 && aItem->Net() != aSingleNet )
+                if( aSeedFilter && !aSeedFilter( aItem ) )
                     return;
 
                 if( aExcludeZones && aItem->Parent()->Type() == PCB_ZONE_T )
@@ -493,7 +540,8 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
     {
         CN_ZONE_LAYER* ptr = zitems[ii];
         returns[ii] = tp.submit_task(
-            [cache_zones, ptr] { return cache_zones( ptr ); } );
+            [cache_zones, ptr] { return cache_zones( ptr ); },
+            PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
     }
 
     for( const std::future<size_t>& ret : returns )
@@ -639,7 +687,17 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
 {
     updateJumperPads();
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+
+    // Clusters were propagated when last searched, so only the ones which gained, lost or
+    // changed items can propagate differently.
+    m_connClusters = searchClusters( CSM_PROPAGATE, true,
+                                     [this]( const CN_ITEM* aItem )
+                                     {
+                                         return m_touchedItems.contains( aItem )
+                                                || IsNetDirty( aItem->Net() );
+                                     } );
+    m_touchedItems.clear();
+
     propagateConnections( aCommit );
 }
 
@@ -702,7 +760,57 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    // Collect the garbage first so the clusters of the nets which lost items are known
+    if( m_itemList.IsDirty() )
+        searchConnections();
+
+    // Ratsnest clusters never span nets, so the clusters of clean nets are still valid unless
+    // they hold an item deleted without its net being marked dirty.
+    if( !m_deletedItems.empty() )
+    {
+        for( const std::shared_ptr<CN_CLUSTER>& cluster : m_ratsnestClusters )
+        {
+            if( IsNetDirty( cluster->OriginNet() ) )
+                continue;
+
+            for( CN_ITEM* item : *cluster )
+            {
+                if( m_deletedItems.contains( item ) )
+                {
+                    MarkNetAsDirty( cluster->OriginNet() );
+                    break;
+                }
+            }
+        }
+
+        m_deletedItems.clear();
+    }
+
+    CLUSTERS clusters = searchClusters( CSM_RATSNEST, false,
+                                        [this]( const CN_ITEM* aItem )
+                                        {
+                                            return IsNetDirty( aItem->Net() );
+                                        } );
+
+    CLUSTERS kept;
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_ratsnestClusters )
+    {
+        if( !IsNetDirty( cluster->OriginNet() ) )
+            kept.push_back( cluster );
+    }
+
+    // Both lists are already sorted by net
+    m_ratsnestClusters.clear();
+    m_ratsnestClusters.reserve( kept.size() + clusters.size() );
+
+    std::merge( kept.begin(), kept.end(), clusters.begin(), clusters.end(),
+                std::back_inserter( m_ratsnestClusters ),
+                []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
+                {
+                    return a->OriginNet() < b->OriginNet();
+                } );
+
     return m_ratsnestClusters;
 }
 
@@ -939,6 +1047,8 @@ void CN_CONNECTIVITY_ALGO::Clear()
 {
     m_ratsnestClusters.clear();
     m_connClusters.clear();
+    m_touchedItems.clear();
+    m_deletedItems.clear();
     m_itemMap.clear();
     m_itemList.Clear();
 
@@ -40,6 +40,7 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <unordered_set>
 #include <vector>
 #include <deque>
 
@@ -225,7 +226,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -262,6 +263,17 @@ public:
     bool Remove( BOARD_ITEM* aItem );
     bool Add( BOARD_ITEM* aItem );
 
+    /**
+     * Apply a batch of board changes.
+     *
+     * Only the items of the batch are rebuilt; clusters are repaired for the nets they touch
+     * the next time they are searched.  Removed items must still be alive, and the previous
+     * net of a modified item must have been marked dirty if its net changed.
+     */
+    void ApplyChanges( const std::vector<BOARD_ITEM*>& aAdded,
+                       const std::vector<BOARD_ITEM*>& aRemoved,
+                       const std::vector<BOARD_ITEM*>& aModified );
+
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones, int aSingleNet );
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
 
@@ -309,6 +321,13 @@ public:
 private:
     void searchConnections();
 
+    /**
+     * Search the clusters grown from the items accepted by \a aSeedFilter (all items if it
+     * is empty).
+     */
+    const CLUSTERS searchClusters( CLUSTER_SEARCH_MODE aMode, bool aExcludeZones,
+                                   const std::function<bool( const CN_ITEM* )>& aSeedFilter );
+
     void propagateConnections( BOARD_COMMIT* aCommit = nullptr );
 
     template <class Container, class BItem>
@@ -332,6 +351,11 @@ private:
     std::vector<std::shared_ptr<CN_CLUSTER>>              m_ratsnestClusters;
     std::vector<bool>                                     m_dirtyNets;
 
+    // Items whose connections changed, and items deleted, since the clusters were last searched.
+    // Deleted items are only compared by address.
+    std::unordered_set<const CN_ITEM*>                    m_touchedItems;
+    std::unordered_set<const CN_ITEM*>                    m_deletedItems;
+
     bool                                                  m_isLocal;
     std::shared_ptr<CONNECTIVITY_DATA>                    m_globalConnectivityData;
 
@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <future>
 #include <initializer_list>
+#include <set>
+#include <tuple>
 
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
@@ -96,6 +98,73 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 }
 
 
+void CONNECTIVITY_DATA::Update( const std::vector<BOARD_ITEM*>& aItems )
+{
+    m_connAlgo->ApplyChanges( {}, {}, aItems );
+}
+
+
+bool CONNECTIVITY_DATA::ApplyChanges( BOARD* aBoard, const std::vector<BOARD_ITEM*>& aAdded,
+                                      const std::vector<BOARD_ITEM*>& aRemoved,
+                                      const std::vector<BOARD_ITEM*>& aModified )
+{
+    std::unique_lock<KISPINLOCK> lock( m_lock, std::try_to_lock );
+
+    if( !lock )
+        return false;
+
+    m_connAlgo->ApplyChanges( aAdded, aRemoved, aModified );
+
+    RefreshNetcodeMap( aBoard );
+
+    internalRecalculateRatsnest();
+
+#ifdef DEBUG
+    verifyClusters( aBoard );
+#endif
+
+    return true;
+}
+
+
+#ifdef DEBUG
+void CONNECTIVITY_DATA::verifyClusters( BOARD* aBoard )
+{
+    using CLUSTER_KEY = std::set<std::tuple<const BOARD_CONNECTED_ITEM*, int, int>>;
+
+    auto keys =
+            []( const CN_CONNECTIVITY_ALGO::CLUSTERS& aClusters )
+            {
+                std::set<CLUSTER_KEY> rv;
+
+                for( const std::shared_ptr<CN_CLUSTER>& cluster : aClusters )
+                {
+                    CLUSTER_KEY key;
+
+                    for( CN_ITEM* item : *cluster )
+                    {
+                        CN_ZONE_LAYER* zoneLayer = dynamic_cast<CN_ZONE_LAYER*>( item );
+
+                        key.emplace( item->Parent(), item->GetBoardLayer(),
+                                     zoneLayer ? zoneLayer->SubpolyIndex() : -1 );
+                    }
+
+                    rv.insert( std::move( key ) );
+                }
+
+                return rv;
+            };
+
+    // GetClusters() only searches the dirty nets, and every net of a new algo is dirty
+    CN_CONNECTIVITY_ALGO reference( this );
+    reference.Build( aBoard );
+
+    wxASSERT_MSG( keys( m_connAlgo->GetClusters() ) == keys( reference.GetClusters() ),
+                  wxT( "Incremental connectivity differs from a full rebuild" ) );
+}
+#endif
+
+
 bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
     aBoard->CacheTriangulation( aReporter );
@@ -196,14 +265,14 @@ void CONNECTIVITY_DATA::updateRatsnest()
                             [&]( const int ii )
                             {
                                 dirty_nets[ii]->UpdateNet();
-                            } );
+                            }, 0, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
     results.wait();
 
     auto results2 = tp.submit_loop( 0, dirty_nets.size(),
                             [&]( const int ii )
                             {
                                 dirty_nets[ii]->OptimizeRNEdges();
-                            } );
+                            }, 0, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
     results2.wait();
 
 #ifdef PROFILE
@@ -373,7 +442,7 @@ void CONNECTIVITY_DATA::ComputeLocalRatsnest( const std::vector<BOARD_ITEM*>& aI
                             [&]( const int ii )
                             {
                                 update_lambda( ii );
-                            });
+                            }, 0, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
     results.wait();
 
     // This gets the ratsnest for internal connections in the moving set
@@ -569,6 +638,11 @@ void CONNECTIVITY_DATA::ClearRatsnest()
 {
     for( RN_NET* net : m_nets )
         net->Clear();
+
+    // Only the dirty nets are recalculated, so all of them must be for the ratsnest to be
+    // complete again
+    for( int net = 0; net < m_connAlgo->NetCount(); ++net )
+        m_connAlgo->MarkNetAsDirty( net );
 }
 
 
@@ -744,6 +818,9 @@ void CONNECTIVITY_DATA::RunOnUnconnectedEdges( std::function<bool( CN_EDGE& )> a
     {
         if( rnNet )
         {
+            // The callback may change edge visibility
+            rnNet->EdgesChanged();
+
             for( CN_EDGE& edge : rnNet->GetEdges() )
             {
                 if( !aFunc( edge ) )
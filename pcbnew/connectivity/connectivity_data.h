@@ -130,6 +130,25 @@ public:
      */
     bool Update( BOARD_ITEM* aItem );
 
+    /**
+     * Update the connectivity data for a batch of items, e.g. all the items modified by a
+     * commit.  The ratsnest is not recalculated.
+     */
+    void Update( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Update the connectivity for a batch of changes to \a aBoard and recalculate the ratsnest.
+     *
+     * Unlike Build(), only the changed items are rebuilt and only the clusters of the nets they
+     * touch are searched again.  Removed items must still be alive.  In debug builds the result
+     * is checked against a full rebuild.
+     *
+     * @return false if the connectivity is locked by another thread.
+     */
+    bool ApplyChanges( BOARD* aBoard, const std::vector<BOARD_ITEM*>& aAdded,
+                       const std::vector<BOARD_ITEM*>& aRemoved,
+                       const std::vector<BOARD_ITEM*>& aModified );
+
     /**
      * Moves the connectivity list anchors.  N.B., this does not move the bounding
      * boxes for the RTree, so the use of this function will invalidate the
@@ -302,6 +321,11 @@ private:
 
     void addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+#ifdef DEBUG
+    /// Check the clusters against the ones of a connectivity built from scratch for \a aBoard.
+    void verifyClusters( BOARD* aBoard );
+#endif
+
 private:
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
 
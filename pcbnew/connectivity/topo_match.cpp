@@ -36,6 +36,7 @@
 #include <footprint.h>
 #include <refdes_utils.h>
 #include <board.h>
+#include <hash.h>
 #include <wx/string.h>
 #include <wx/log.h>
 
@@ -93,92 +94,54 @@ bool PIN::IsIsomorphic( const PIN& b, TOPOLOGY_MISMATCH_REASON& aReason ) const
         return true;
     }
 
-    std::vector<bool> matches( m_conns.size() );
-
-    for( int i = 0; i < m_conns.size(); i++ )
-        matches[i] = false;
-
-    int nref = 0;
-
-    for( auto& cref : m_conns )
-    {
-        for( int i = 0; i < m_conns.size(); i++ )
-        {
-            if( b.m_conns[i]->IsTopologicallySimilar( *cref ) )
-            {
-                matches[nref] = true;
-                break;
-            }
-        }
-
-        nref++;
-    }
-
-    for( int i = 0; i < m_conns.size(); i++ )
+    // Each pin connected to this one needs a topologically similar pin among the connections
+    // of b.  Comparing the sorted kinds of both sides is linear instead of quadratic, which
+    // matters for large nets such as ground.
+    if( !std::includes( b.m_connKinds.begin(), b.m_connKinds.end(), m_connKinds.begin(),
+                        m_connKinds.end() ) )
     {
-        if( !matches[i] )
-        {
-            aReason.m_reference = m_parent->GetParent()->GetReferenceAsString();
-            aReason.m_candidate = b.m_parent->GetParent()->GetReferenceAsString();
-            aReason.m_reason = wxString::Format(
-                    _( "Pad %s of %s cannot match candidate pad %s of %s due to differing connectivity." ), m_ref,
-                    aReason.m_reference, b.m_ref, aReason.m_candidate );
+        aReason.m_reference = m_parent->GetParent()->GetReferenceAsString();
+        aReason.m_candidate = b.m_parent->GetParent()->GetReferenceAsString();
+        aReason.m_reason = wxString::Format(
+                _( "Pad %s of %s cannot match candidate pad %s of %s due to differing connectivity." ), m_ref,
+                aReason.m_reference, b.m_ref, aReason.m_candidate );
 
-            return false;
-        }
+        return false;
     }
 
     return true;
 }
 
 
-// fixme: terrible performance, but computers are fast these days, ain't they? :D
 bool checkIfPadNetsMatch( const BACKTRACK_STAGE& aMatches, CONNECTION_GRAPH* aRefGraph, COMPONENT* aRef,
                           COMPONENT* aTgt, TOPOLOGY_MISMATCH_REASON& aReason )
 {
-    std::map<PIN*, PIN*> pairs;
-    std::vector<PIN*>    pref, ptgt;
+    // Matched components pair their pins by index, as both are sorted by name
+    std::unordered_map<COMPONENT*, COMPONENT*> refToTgt;
+    size_t                                     refPinCount = aRef->Pins().size();
+    size_t                                     tgtPinCount = aTgt->Pins().size();
 
     // GetMatchingComponentPairs() returns target->reference map
-    for( auto& m : aMatches.GetMatchingComponentPairs() )
+    for( const auto& [tgt, ref] : aMatches.GetMatchingComponentPairs() )
     {
-        for( PIN* p : m.second->Pins() )
-        {
-            pref.push_back( p );
-        }
-
-        for( PIN* p : m.first->Pins() )
-        {
-            ptgt.push_back( p );
-        }
+        refToTgt[ref] = tgt;
+        refPinCount += ref->Pins().size();
+        tgtPinCount += tgt->Pins().size();
     }
 
-    for( PIN* p : aRef->Pins() )
-    {
-        pref.push_back( p );
-    }
+    refToTgt[aRef] = aTgt;
 
-    for( PIN* p : aTgt->Pins() )
-    {
-        ptgt.push_back( p );
-    }
-
-    if( pref.size() != ptgt.size() )
+    if( refPinCount != tgtPinCount )
     {
         aReason.m_reference = aRef->GetParent()->GetReferenceAsString();
         aReason.m_candidate = aTgt->GetParent()->GetReferenceAsString();
         aReason.m_reason =
                 wxString::Format( _( "Component %s expects %lu matching pads but candidate %s provides %lu." ),
-                                  aReason.m_reference, static_cast<unsigned long>( pref.size() ),
-                                  aReason.m_candidate, static_cast<unsigned long>( ptgt.size() ) );
+                                  aReason.m_reference, static_cast<unsigned long>( refPinCount ),
+                                  aReason.m_candidate, static_cast<unsigned long>( tgtPinCount ) );
         return false;
     }
 
-    for( unsigned int i = 0; i < pref.size(); i++ )
-    {
-        pairs[pref[i]] = ptgt[i];
-    }
-
     for( PIN* refPin : aRef->Pins() )
     {
         wxLogTrace( traceTopoMatch, wxT( "pad %s-%s: " ),
@@ -186,61 +149,56 @@ bool checkIfPadNetsMatch( const BACKTRACK_STAGE& aMatches, CONNECTION_GRAPH* aRe
 
         std::optional<int> prevNet;
 
-        for( COMPONENT* refCmp : aRefGraph->Components() )
+        // Only the pins of the same net can disagree
+        for( PIN* ppin : aRefGraph->PinsOnNet( refPin->GetNetCode() ) )
         {
-            for( PIN* ppin : refCmp->Pins() )
-            {
-                if ( ppin->GetNetCode() != refPin->GetNetCode() )
-                    continue;
+            wxLogTrace( traceTopoMatch, wxT( "{ref %s-%s:%d} " ),
+                        ppin->GetParent()->GetParent()->GetReferenceAsString(),
+                        ppin->GetReference(), ppin->GetNetCode() );
 
-                wxLogTrace( traceTopoMatch, wxT( "{ref %s-%s:%d} " ),
-                            ppin->GetParent()->GetParent()->GetReferenceAsString(),
-                            ppin->GetReference(), ppin->GetNetCode() );
+            auto tcmp = refToTgt.find( ppin->GetParent() );
 
-                auto tpin = pairs.find( ppin );
+            if( tcmp != refToTgt.end() )
+            {
+                int nc = tcmp->second->Pins()[ppin->GetIndex()]->GetNetCode();
 
-                if( tpin != pairs.end() )
+                if( prevNet && ( *prevNet != nc ) )
                 {
-                    int nc = tpin->second->GetNetCode();
-
-                    if( prevNet && ( *prevNet != nc ) )
-                    {
-                        wxLogTrace( traceTopoMatch, wxT( "nets inconsistent\n" ) );
+                    wxLogTrace( traceTopoMatch, wxT( "nets inconsistent\n" ) );
 
-                        aReason.m_reference = aRef->GetParent()->GetReferenceAsString();
-                        aReason.m_candidate = aTgt->GetParent()->GetReferenceAsString();
+                    aReason.m_reference = aRef->GetParent()->GetReferenceAsString();
+                    aReason.m_candidate = aTgt->GetParent()->GetReferenceAsString();
 
-                        wxString refNetName;
-                        wxString tgtNetName;
+                    wxString refNetName;
+                    wxString tgtNetName;
 
-                        if( const BOARD* refBoard = aRef->GetParent()->GetBoard() )
-                        {
-                            if( const NETINFO_ITEM* net = refBoard->FindNet( refPin->GetNetCode() ) )
-                                refNetName = net->GetNetname();
-                        }
-
-                        if( const BOARD* tgtBoard = aTgt->GetParent()->GetBoard() )
-                        {
-                            if( const NETINFO_ITEM* net = tgtBoard->FindNet( nc ) )
-                                tgtNetName = net->GetNetname();
-                        }
+                    if( const BOARD* refBoard = aRef->GetParent()->GetBoard() )
+                    {
+                        if( const NETINFO_ITEM* net = refBoard->FindNet( refPin->GetNetCode() ) )
+                            refNetName = net->GetNetname();
+                    }
 
-                        if( refNetName.IsEmpty() )
-                            refNetName = wxString::Format( _( "net %d" ), refPin->GetNetCode() );
+                    if( const BOARD* tgtBoard = aTgt->GetParent()->GetBoard() )
+                    {
+                        if( const NETINFO_ITEM* net = tgtBoard->FindNet( nc ) )
+                            tgtNetName = net->GetNetname();
+                    }
 
-                        if( tgtNetName.IsEmpty() )
-                            tgtNetName = wxString::Format( _( "net %d" ), nc );
+                    if( refNetName.IsEmpty() )
+                        refNetName = wxString::Format( _( "net %d" ), refPin->GetNetCode() );
 
-                        aReason.m_reason = wxString::Format(
-                                _( "Pad %s of %s is on net %s but its match in candidate %s is on net %s." ),
-                                refPin->GetReference(), aReason.m_reference, refNetName, aReason.m_candidate,
-                                tgtNetName );
+                    if( tgtNetName.IsEmpty() )
+                        tgtNetName = wxString::Format( _( "net %d" ), nc );
 
-                        return false;
-                    }
+                    aReason.m_reason = wxString::Format(
+                            _( "Pad %s of %s is on net %s but its match in candidate %s is on net %s." ),
+                            refPin->GetReference(), aReason.m_reference, refNetName, aReason.m_candidate,
+                            tgtNetName );
 
-                    prevNet = nc;
+                    return false;
                 }
+
+                prevNet = nc;
             }
         }
     }
@@ -256,42 +214,62 @@ CONNECTION_GRAPH::findMatchingComponents( CONNECTION_GRAPH* aRefGraph, COMPONENT
 {
     aMismatchReasons.clear();
     std::vector<COMPONENT*> matches;
-    for( auto cmpTarget : m_components )
-    {
-        // already matched to sth? move on.
-        if( partialMatches.m_locked.find( cmpTarget ) != partialMatches.m_locked.end() )
-        {
-            continue;
-        }
 
-        wxLogTrace( traceTopoMatch, wxT( "Check '%s'/'%s' " ), aRef->m_reference,
-                    cmpTarget->m_reference );
+    auto checkCandidate =
+            [&]( COMPONENT* cmpTarget )
+            {
+                // already matched to sth? move on.
+                if( partialMatches.m_locked.find( cmpTarget ) != partialMatches.m_locked.end() )
+                {
+                    return;
+                }
 
-        // first, a basic heuristic (reference prefix, pin count & footprint) followed by a pin
-        // connection topology check
-        TOPOLOGY_MISMATCH_REASON localReason;
-        localReason.m_reference = aRef->GetParent()->GetReferenceAsString();
-        localReason.m_candidate = cmpTarget->GetParent()->GetReferenceAsString();
+                wxLogTrace( traceTopoMatch, wxT( "Check '%s'/'%s' " ), aRef->m_reference,
+                            cmpTarget->m_reference );
 
-        if( aRef->MatchesWith( cmpTarget, localReason ) )
-        {
-            // then a net integrity check (expensive because of poor optimization)
-            if( checkIfPadNetsMatch( partialMatches, aRefGraph, aRef, cmpTarget, localReason ) )
-            {
-                wxLogTrace( traceTopoMatch, wxT("match!\n") );
-                matches.push_back( cmpTarget );
-            }
-            else
-            {
-                wxLogTrace( traceTopoMatch, wxT("Reject [net topo mismatch]\n") );
-                aMismatchReasons.push_back( localReason );
-            }
-        }
-        else
-        {
-            wxLogTrace( traceTopoMatch, wxT("reject\n") );
-            aMismatchReasons.push_back( localReason );
-        }
+                // first, a basic heuristic (reference prefix, pin count & footprint) followed by a pin
+                // connection topology check
+                TOPOLOGY_MISMATCH_REASON localReason;
+                localReason.m_reference = aRef->GetParent()->GetReferenceAsString();
+                localReason.m_candidate = cmpTarget->GetParent()->GetReferenceAsString();
+
+                if( aRef->MatchesWith( cmpTarget, localReason ) )
+                {
+                    // then a net integrity check against the components matched so far
+                    if( checkIfPadNetsMatch( partialMatches, aRefGraph, aRef, cmpTarget, localReason ) )
+                    {
+                        wxLogTrace( traceTopoMatch, wxT("match!\n") );
+                        matches.push_back( cmpTarget );
+                    }
+                    else
+                    {
+                        wxLogTrace( traceTopoMatch, wxT("Reject [net topo mismatch]\n") );
+                        aMismatchReasons.push_back( localReason );
+                    }
+                }
+                else
+                {
+                    wxLogTrace( traceTopoMatch, wxT("reject\n") );
+                    aMismatchReasons.push_back( localReason );
+                }
+            };
+
+    // Only the candidates with the same signature can match.  Scan them all only when none
+    // does, to report why each of them was rejected.
+    auto bucket = m_signatureBuckets.find( aRef->GetSignature() );
+
+    if( bucket != m_signatureBuckets.end() )
+    {
+        for( COMPONENT* cmpTarget : bucket->second )
+            checkCandidate( cmpTarget );
+    }
+
+    if( matches.empty() )
+    {
+        aMismatchReasons.clear();
+
+        for( COMPONENT* cmpTarget : m_components )
+            checkCandidate( cmpTarget );
     }
 
     auto padSimilarity = []( COMPONENT* a, COMPONENT* b ) -> double
@@ -362,38 +340,66 @@ void CONNECTION_GRAPH::sortByPinCount()
 
 void CONNECTION_GRAPH::BuildConnectivity()
 {
-    std::map<int, std::vector<PIN*>> nets;
-
     sortByPinCount();
 
+    m_netPins.clear();
+    m_signatureBuckets.clear();
+
     for( auto c : m_components )
     {
         c->sortPinsByName();
 
-        for( auto p : c->Pins() )
+        for( size_t i = 0; i < c->Pins().size(); i++ )
         {
-            if( p->GetNetCode() > 0 )
-                nets[p->GetNetCode()].push_back( p );
+            PIN* p = c->Pins()[i];
+
+            p->m_index = static_cast<int>( i );
+            m_netPins[p->GetNetCode()].push_back( p );
         }
     }
 
-    for( auto iter : nets )
+    for( auto& [netcode, pins] : m_netPins )
     {
-        wxLogTrace( traceTopoMatch, wxT( "net %d: %d connections\n" ), iter.first,
-                    (int) iter.second.size() );
+        if( netcode <= 0 )
+            continue;
+
+        wxLogTrace( traceTopoMatch, wxT( "net %d: %d connections\n" ), netcode,
+                    (int) pins.size() );
 
-        for( auto p : iter.second )
+        // A pin appears once per net, so the pairs are unique
+        for( auto p : pins )
         {
-            for( auto p2 : iter.second )
+            p->m_conns.reserve( pins.size() - 1 );
+
+            for( auto p2 : pins )
             {
-                if( p != p2 && !alg::contains( p->m_conns, p2 ) )
-                {
+                if( p != p2 )
                     p->m_conns.push_back( p2 );
-                }
             }
         }
     }
 
+    for( auto c : m_components )
+    {
+        c->m_signature = hash_val( c->m_kind, c->GetPinCount() );
+
+        for( auto p : c->Pins() )
+        {
+            hash_combine( c->m_signature, p->m_conns.size() );
+
+            p->m_connKinds.clear();
+
+            for( auto conn : p->m_conns )
+                p->m_connKinds.push_back( conn->m_parent->m_kind + wxT( "\n" ) + conn->m_ref );
+
+            std::sort( p->m_connKinds.begin(), p->m_connKinds.end() );
+            p->m_connKinds.erase( std::unique( p->m_connKinds.begin(), p->m_connKinds.end() ),
+                                  p->m_connKinds.end() );
+        }
+
+        m_signatureBuckets[c->m_signature].push_back( c );
+    }
+
 /*    for( auto c : m_components )
         for( auto p : c->Pins() )
         {
@@ -672,6 +678,9 @@ COMPONENT::COMPONENT( const wxString& aRef, FOOTPRINT* aParentFp,
         m_parentFootprint( aParentFp ), m_raOffset( aRaOffset )
 {
     m_prefix = UTIL::GetRefDesPrefix( aRef );
+
+    // IsSameKind() in a single string compare: components without a library link are all alike
+    m_kind = m_prefix + wxT( "\n" ) + aParentFp->GetFPIDAsString();
 }
 
 
@@ -770,6 +779,16 @@ void CONNECTION_GRAPH::AddFootprint( FOOTPRINT* aFp, const VECTOR2I& aOffset )
 }
 
 
+const std::vector<PIN*>& CONNECTION_GRAPH::PinsOnNet( int aNetCode ) const
+{
+    static const std::vector<PIN*> empty;
+
+    auto it = m_netPins.find( aNetCode );
+
+    return it != m_netPins.end() ? it->second : empty;
+}
+
+
 std::unique_ptr<CONNECTION_GRAPH>
 CONNECTION_GRAPH::BuildFromFootprintSet( const std::set<FOOTPRINT*>& aFps )
 {
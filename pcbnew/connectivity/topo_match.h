@@ -27,6 +27,7 @@
 #include <vector>
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 #include <wx/string.h>
 
@@ -68,6 +69,12 @@ public:
     bool HasRAOffset() const { return m_raOffset.has_value(); }
     const VECTOR2I GetRAOffset() const { return *m_raOffset; }
 
+    /**
+     * Hash of the kind, pin count and number of connections of each pin.  Two components with
+     * different signatures can never match, equal signatures still need MatchesWith().
+     */
+    size_t GetSignature() const { return m_signature; }
+
 private:
     void sortPinsByName();
 
@@ -75,6 +82,8 @@ private:
     std::optional<VECTOR2I> m_raOffset;
     wxString          m_reference;
     wxString          m_prefix;
+    wxString          m_kind;           ///< Prefix and library link, equal for IsSameKind()
+    size_t            m_signature = 0;
     FOOTPRINT*        m_parentFootprint = nullptr;
     std::vector<PIN*> m_pins;
 };
@@ -84,7 +93,7 @@ class PIN
     friend class CONNECTION_GRAPH;
 
 public:
-    PIN() : m_netcode( 0 ), m_parent( nullptr ) {}
+    PIN() : m_netcode( 0 ), m_index( 0 ), m_parent( nullptr ) {}
     ~PIN() {}
 
     void SetParent( COMPONENT* parent ) { m_parent = parent; }
@@ -111,12 +120,19 @@ public:
 
     COMPONENT* GetParent() const { return m_parent; }
 
+    /// Position of the pin in its (name sorted) component
+    int GetIndex() const { return m_index; }
+
 private:
 
     wxString          m_ref;
     int               m_netcode;
+    int               m_index;
     COMPONENT*        m_parent;
     std::vector<PIN*> m_conns;
+
+    /// Sorted, unique kinds of the connected pins (see IsTopologicallySimilar())
+    std::vector<wxString> m_connKinds;
 };
 
 class BACKTRACK_STAGE
@@ -170,6 +186,9 @@ public:
     static std::unique_ptr<CONNECTION_GRAPH> BuildFromFootprintSet( const std::set<FOOTPRINT*>& aFps );
     std::vector<COMPONENT*> &Components() { return m_components; }
 
+    /// @return the pins on \a aNetCode (net 0 included), in component order
+    const std::vector<PIN*>& PinsOnNet( int aNetCode ) const;
+
 private:
     void sortByPinCount();
 
@@ -181,6 +200,11 @@ private:
 
     std::vector<COMPONENT*> m_components;
 
+    /// Candidate buckets: components by signature
+    std::unordered_map<size_t, std::vector<COMPONENT*>> m_signatureBuckets;
+
+    /// Pins by net code
+    std::unordered_map<int, std::vector<PIN*>> m_netPins;
 };
 
 }; // namespace TMATCH
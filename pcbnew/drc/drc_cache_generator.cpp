@@ -169,6 +169,9 @@ bool DRC_CACHE_GENERATOR::Run()
                     m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
 
                 forEachGeometryItem( itemTypes, boardCopperLayers, addToCopperTree );
+
+                // The tree is only queried from here on
+                m_board->m_CopperItemRTreeCache->Build();
             } );
 
     std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
@@ -185,11 +188,10 @@ bool DRC_CACHE_GENERATOR::Run()
     // Cache zone bounding boxes, triangulation, copper zone rtrees, and footprint courtyards
     // before we start.
 
+    FOOTPRINT::EnsureCourtyardCaches( m_board->Footprints() );
+
     for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        footprint->BuildCourtyardCaches();
         footprint->BuildNetTieCache();
-    }
 
     std::vector<std::future<size_t>> returns;
 
@@ -215,6 +217,8 @@ bool DRC_CACHE_GENERATOR::Run()
                                    rtree->Insert( aZone, layer );
                            } );
 
+                   rtree->Build();
+
                    {
                        std::unique_lock<std::shared_mutex> writeLock( m_board->m_CachesMutex );
                        m_board->m_CopperZoneRTreeCache[ aZone ] = std::move( rtree );
@@ -1934,43 +1934,47 @@ double CREEPAGE_GRAPH::Solve( std::shared_ptr<GRAPH_NODE>& aFrom, std::shared_pt
     if( aFrom == aTo )
         return 0;
 
-    // Dijkstra's algorithm for shortest path
-    std::unordered_map<GRAPH_NODE*, double>     distances;
+    // Dijkstra's algorithm for shortest path.  Nodes never reached are absent from the maps
+    // and count as infinitely far, so the cost follows the part of the graph actually visited.
+    std::unordered_map<GRAPH_NODE*, double>      distances;
     std::unordered_map<GRAPH_NODE*, GRAPH_NODE*> previous;
 
-    auto cmp = [&distances]( GRAPH_NODE* left, GRAPH_NODE* right )
-    {
-        double distLeft = distances[left];
-        double distRight = distances[right];
+    auto distanceTo =
+            [&distances]( GRAPH_NODE* aNode )
+            {
+                auto it = distances.find( aNode );
+                return it == distances.end() ? std::numeric_limits<double>::infinity() : it->second;
+            };
 
-        if( distLeft == distRight )
-            return left > right; // Compare addresses to avoid ties.
-        return distLeft > distRight;
-    };
-    std::priority_queue<GRAPH_NODE*, std::vector<GRAPH_NODE*>, decltype( cmp )> pq( cmp );
+    // Queue entries carry the distance they were pushed with; an entry whose node has been
+    // reached by a shorter path since is stale and skipped.
+    using QUEUE_ENTRY = std::pair<double, GRAPH_NODE*>;
 
-    // Initialize distances to infinity for all nodes except the starting node
-    for( const std::shared_ptr<GRAPH_NODE>& node : m_nodes )
-    {
-        if( node != nullptr )
-            distances[node.get()] = std::numeric_limits<double>::infinity(); // Set to infinity
-    }
+    std::priority_queue<QUEUE_ENTRY, std::vector<QUEUE_ENTRY>, std::greater<QUEUE_ENTRY>> pq;
+
+    // Only paths shorter than the creepage target can be violations: give up past it
+    double limit = m_creepageTarget > 0 ? m_creepageTarget : std::numeric_limits<double>::infinity();
 
     distances[aFrom.get()] = 0.0;
-    distances[aTo.get()] = std::numeric_limits<double>::infinity();
-    pq.push( aFrom.get() );
+    pq.emplace( 0.0, aFrom.get() );
 
     // Dijkstra's main loop
     while( !pq.empty() )
     {
-        GRAPH_NODE* current = pq.top();
+        auto [currentDistance, current] = pq.top();
         pq.pop();
 
+        if( currentDistance > distanceTo( current ) )
+            continue;
+
         if( current == aTo.get() )
         {
             break; // Shortest path found
         }
 
+        if( currentDistance >= limit )
+            break;
+
         // Traverse neighbors
         for( const std::shared_ptr<GRAPH_CONNECTION>& connection : current->m_node_conns )
         {
@@ -1987,18 +1991,22 @@ double CREEPAGE_GRAPH::Solve( std::shared_ptr<GRAPH_NODE>& aFrom, std::shared_pt
                 continue;
             }
 
-            double alt = distances[current] + connection->m_path.weight; // Calculate alternative path cost
+            double alt = currentDistance + connection->m_path.weight; // Calculate alternative path cost
 
-            if( alt < distances[neighbor] )
+            if( alt < distanceTo( neighbor ) )
             {
                 distances[neighbor] = alt;
                 previous[neighbor] = current;
-                pq.push( neighbor );
+                pq.emplace( alt, neighbor );
             }
         }
     }
 
-    double pathWeight = distances[aTo.get()];
+    double pathWeight = distanceTo( aTo.get() );
+
+    // A path found while the search was cut short may not be the shortest one
+    if( pathWeight >= limit )
+        return std::numeric_limits<double>::infinity();
 
     // If aTo is unreachable, return infinity
     if( pathWeight == std::numeric_limits<double>::infinity() )
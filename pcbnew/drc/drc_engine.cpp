@@ -23,12 +23,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <atomic>
+#include <future>
+#include <thread>
 #include <wx/log.h>
+#include <wx/thread.h>
 #include <reporter.h>
 #include <common.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
+#include <advanced_config.h>
 #include <board_design_settings.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_rtree.h>
@@ -86,10 +91,15 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
         m_drawingSheet( nullptr ),
         m_schematicNetlist( nullptr ),
         m_rulesValid( false ),
+        m_cacheTimeStamp( -1 ),
         m_reportAllTrackErrors( false ),
         m_testFootprints( false ),
         m_logReporter( nullptr ),
-        m_progressReporter( nullptr )
+        m_progressReporter( nullptr ),
+        m_recordViolations( false ),
+        m_hasBaseline( false ),
+        m_incremental( false ),
+        m_ruleCacheTimeStamp( -1 )
 {
     m_errorLimits.resize( DRCE_LAST + 1 );
 
@@ -725,6 +735,37 @@ void DRC_ENGINE::compileRules()
             m_constraintMap[ constraint.m_Type ]->push_back( engineConstraint );
         }
     }
+
+    // Constraint types whose resolution doesn't depend on the items beyond their classes can
+    // be resolved once per class pair.  Disallow and hole-to-hole constraints test the items
+    // themselves.
+    std::unique_lock<std::shared_mutex> cacheLock( m_ruleCacheMutex );
+
+    m_classOnlyConstraints.clear();
+    m_ruleCache.clear();
+
+    for( const auto& [constraintType, ruleset] : m_constraintMap )
+    {
+        if( constraintType == DISALLOW_CONSTRAINT || constraintType == HOLE_TO_HOLE_CONSTRAINT
+                || constraintType == ASSERTION_CONSTRAINT )
+        {
+            continue;
+        }
+
+        bool classOnly = true;
+
+        for( const DRC_ENGINE_CONSTRAINT* c : *ruleset )
+        {
+            if( c->condition && !c->condition->DependsOnlyOnClasses() )
+            {
+                classOnly = false;
+                break;
+            }
+        }
+
+        if( classOnly )
+            m_classOnlyConstraints.insert( constraintType );
+    }
 }
 
 
@@ -786,16 +827,8 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
 }
 
 
-void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aTestFootprints,
-                           BOARD_COMMIT* aCommit )
+void DRC_ENGINE::resetErrorLimits()
 {
-    PROF_TIMER timer;
-
-    SetUserUnits( aUnits );
-
-    m_reportAllTrackErrors = aReportAllTrackErrors;
-    m_testFootprints = aTestFootprints;
-
     for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
     {
         if( m_designSettings->Ignore( ii ) )
@@ -805,6 +838,15 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
         else
             m_errorLimits[ ii ] = ERROR_LIMIT;
     }
+}
+
+
+bool DRC_ENGINE::prepareTests( bool aReportAllTrackErrors, bool aTestFootprints )
+{
+    m_reportAllTrackErrors = aReportAllTrackErrors;
+    m_testFootprints = aTestFootprints;
+
+    resetErrorLimits();
 
     DRC_TEST_PROVIDER::Init();
 
@@ -814,28 +856,473 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
     cacheGenerator.SetDRCEngine( this );
 
     if( !cacheGenerator.Run() )         // ... and regenerate them.
-        return;
+        return false;
 
     // Recompute component classes
     m_board->GetComponentClassManager().ForceComponentClassRecalculation();
 
+    m_cacheTimeStamp = m_board->GetTimeStamp();
+
+    return true;
+}
+
+
+void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aTestFootprints,
+                           BOARD_COMMIT* aCommit )
+{
+    PROF_TIMER timer;
+
+    SetUserUnits( aUnits );
+
+    m_incremental = false;
+    m_hasBaseline = false;
+    m_violationsByItem.clear();
+
+    if( !prepareTests( aReportAllTrackErrors, aTestFootprints ) )
+        return;
+
     int timestamp = m_board->GetTimeStamp();
 
+    m_recordViolations = true;
+
+    bool completed = runTestProviders( aUnits );
+
+    m_recordViolations = false;
+    m_hasBaseline = completed && !IsCancelled();
+
+    timer.Stop();
+    wxLogTrace( traceDrcProfile, "DRC took %0.3f ms", timer.msecs() );
+
+    // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
+    // caches while DRC is running is problematic.
+    wxASSERT( timestamp == m_board->GetTimeStamp() );
+}
+
+
+static bool providersConflict( const DRC_TEST_PROVIDER* aA, const DRC_TEST_PROVIDER* aB )
+{
+    int aUses = aA->GetDependencies() | aA->GetModifications();
+    int bUses = aB->GetDependencies() | aB->GetModifications();
+
+    return ( aA->GetModifications() & bUses ) || ( aB->GetModifications() & aUses );
+}
+
+
+bool DRC_ENGINE::runTestProviders( EDA_UNITS aUnits )
+{
+    int threads = ADVANCED_CFG::GetCfg().m_DRCProviderThreads;
+
+    if( threads <= 0 )
+        threads = std::max( 1, (int) std::thread::hardware_concurrency() );
+
+    // The log output of concurrent providers would be interleaved
+    if( m_logReporter )
+        threads = 1;
+
+    std::vector<DRC_TEST_PROVIDER*> providers = m_testProviders;
+    std::vector<double>             times( providers.size(), 0.0 );
+
+    m_providerTimes.clear();
+
+    auto runProvider =
+            [&]( size_t aIndex ) -> bool
+            {
+                PROF_TIMER timer;
+
+                if( m_logReporter )
+                {
+                    m_logReporter->Report( wxString::Format( wxT( "Run DRC provider: '%s'" ),
+                                                             providers[aIndex]->GetName() ) );
+                }
+
+                bool ok = providers[aIndex]->RunTests( aUnits );
+
+                timer.Stop();
+                times[aIndex] = timer.msecs();
+                return ok;
+            };
+
+    auto reportTimes =
+            [&]()
+            {
+                for( size_t ii = 0; ii < providers.size(); ++ii )
+                {
+                    m_providerTimes[ providers[ii]->GetName() ] = times[ii];
+                    wxLogTrace( traceDrcProfile, "DRC provider '%s' took %0.3f ms",
+                                providers[ii]->GetName(), times[ii] );
+                }
+            };
+
+    if( threads == 1 )
+    {
+        for( size_t ii = 0; ii < providers.size(); ++ii )
+        {
+            if( !runProvider( ii ) )
+            {
+                reportTimes();
+                return false;
+            }
+        }
+
+        reportTimes();
+        return true;
+    }
+
+    // Providers modifying shared state have to wait for, and hold back, the providers using
+    // it.  Run them first so that the others can then all run together.
+    std::stable_partition( providers.begin(), providers.end(),
+                           []( DRC_TEST_PROVIDER* provider )
+                           {
+                               return provider->GetModifications() != 0;
+                           } );
+
+    // Each provider waits for the earlier providers it conflicts with
+    std::vector<std::vector<size_t>> predecessors( providers.size() );
+
+    for( size_t ii = 0; ii < providers.size(); ++ii )
+    {
+        for( size_t jj = 0; jj < ii; ++jj )
+        {
+            if( providersConflict( providers[jj], providers[ii] ) )
+                predecessors[ii].push_back( jj );
+        }
+    }
+
+    enum PROVIDER_STATE { PENDING, RUNNING, DONE };
+
+    std::vector<PROVIDER_STATE>    state( providers.size(), PENDING );
+    std::vector<std::future<bool>> futures( providers.size() );
+    size_t                         running = 0;
+    size_t                         done = 0;
+    bool                           completed = true;
+
+    auto isReady =
+            [&]( size_t aIndex )
+            {
+                for( size_t pred : predecessors[aIndex] )
+                {
+                    if( state[pred] != DONE )
+                        return false;
+                }
+
+                return true;
+            };
+
+    while( done < providers.size() )
+    {
+        for( size_t ii = 0; completed && ii < providers.size(); ++ii )
+        {
+            if( state[ii] != PENDING || !isReady( ii ) )
+                continue;
+
+            if( providers[ii]->GetDependencies() & DRC_STATE_MAIN_THREAD )
+            {
+                state[ii] = RUNNING;
+                completed &= runProvider( ii );
+                state[ii] = DONE;
+                done++;
+            }
+            else if( (int) running < threads )
+            {
+                // Not on the thread pool: the providers themselves wait on tasks they submit to
+                // it, which could starve it.
+                state[ii] = RUNNING;
+                futures[ii] = std::async( std::launch::async, runProvider, ii );
+                running++;
+            }
+        }
+
+        if( running == 0 )
+        {
+            if( !completed )
+                break;
+
+            continue;
+        }
+
+        // The providers can't refresh the UI from their threads; do it for them while waiting
+        bool finished = false;
+
+        while( !finished )
+        {
+            for( size_t ii = 0; ii < providers.size(); ++ii )
+            {
+                if( state[ii] == RUNNING
+                        && futures[ii].wait_for( std::chrono::milliseconds( 0 ) )
+                                == std::future_status::ready )
+                {
+                    completed &= futures[ii].get();
+                    state[ii] = DONE;
+                    running--;
+                    done++;
+                    finished = true;
+                }
+            }
+
+            if( !finished )
+            {
+                KeepRefreshing( false );
+                std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+            }
+        }
+    }
+
+    reportTimes();
+
+    return completed && done == providers.size();
+}
+
+
+void DRC_ENGINE::buildIncrementalScope( const std::vector<BOARD_ITEM*>& aItems )
+{
+    DRC_RTREE* copperTree = m_board->m_CopperItemRTreeCache.get();
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        m_incrementalScope.insert( item );
+
+        if( item->Type() == PCB_FOOTPRINT_T )
+        {
+            std::vector<BOARD_ITEM*> children;
+
+            static_cast<FOOTPRINT*>( item )->RunOnChildren(
+                    [&]( BOARD_ITEM* child )
+                    {
+                        children.push_back( child );
+                    },
+                    RECURSE_MODE::NO_RECURSE );
+
+            buildIncrementalScope( children );
+            continue;
+        }
+
+        if( !copperTree )
+            continue;
+
+        ( item->GetLayerSet() & LSET::AllCuMask() ).RunOnLayers(
+                [&]( PCB_LAYER_ID layer )
+                {
+                    copperTree->QueryColliding( item, layer, layer, nullptr,
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                m_incrementalScope.insert( other );
+                                return true;
+                            },
+                            m_board->m_DRCMaxClearance );
+                } );
+    }
+}
+
+
+bool DRC_ENGINE::RunIncrementalTests( EDA_UNITS aUnits, const std::set<KIID>& aChangedItems,
+                                      std::vector<std::shared_ptr<DRC_ITEM>>& aStaleViolations )
+{
+    if( !m_hasBaseline )
+        return false;
+
+    PROF_TIMER timer;
+
+    SetUserUnits( aUnits );
+
+    if( !prepareTests( m_reportAllTrackErrors, m_testFootprints ) )
+        return false;
+
+    int timestamp = m_board->GetTimeStamp();
+
+    std::vector<BOARD_ITEM*> changedItems;
+
+    for( const KIID& id : aChangedItems )
+    {
+        if( BOARD_ITEM* item = m_board->ResolveItem( id, true ) )
+            changedItems.push_back( item );
+    }
+
+    m_incrementalScope.clear();
+    buildIncrementalScope( changedItems );
+
+    // A violation is stale if one of its items was deleted, or if it will be re-tested: it
+    // came from an incremental provider and refers to an item in scope.
+    std::set<std::shared_ptr<DRC_ITEM>> stale;
+
+    auto checkViolations =
+            [&]( const KIID& aId )
+            {
+                auto it = m_violationsByItem.find( aId );
+
+                if( it == m_violationsByItem.end() )
+                    return;
+
+                for( const std::shared_ptr<DRC_ITEM>& violation : it->second )
+                {
+                    if( stale.count( violation ) )
+                        continue;
+
+                    bool retest = violation->GetViolatingTest()
+                                        && violation->GetViolatingTest()->SupportsIncrementalTests();
+
+                    for( const KIID& itemId : violation->GetIDs() )
+                    {
+                        if( itemId == niluuid )
+                            continue;
+
+                        BOARD_ITEM* item = m_board->ResolveItem( itemId, true );
+
+                        if( !item || ( retest && m_incrementalScope.count( item ) ) )
+                        {
+                            stale.insert( violation );
+                            break;
+                        }
+                    }
+                }
+            };
+
+    for( const KIID& id : aChangedItems )
+        checkViolations( id );
+
+    for( const BOARD_ITEM* item : m_incrementalScope )
+        checkViolations( item->m_Uuid );
+
+    for( const std::shared_ptr<DRC_ITEM>& violation : stale )
+    {
+        for( const KIID& itemId : violation->GetIDs() )
+        {
+            auto it = m_violationsByItem.find( itemId );
+
+            if( it == m_violationsByItem.end() )
+                continue;
+
+            std::erase( it->second, violation );
+
+            if( it->second.empty() )
+                m_violationsByItem.erase( it );
+        }
+
+        aStaleViolations.push_back( violation );
+    }
+
+    bool completed = true;
+
+    m_incremental = true;
+    m_recordViolations = true;
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
+        if( !provider->SupportsIncrementalTests() )
+            continue;
+
         if( m_logReporter )
-            m_logReporter->Report( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
+            m_logReporter->Report( wxString::Format( wxT( "Run incremental DRC provider: '%s'" ), provider->GetName() ) );
 
         if( !provider->RunTests( aUnits ) )
+        {
+            completed = false;
             break;
+        }
     }
 
+    m_recordViolations = false;
+    m_incremental = false;
+    m_incrementalScope.clear();
+
+    // A partial run leaves the record out of step with the board; the next run must be a full one.
+    if( !completed || IsCancelled() )
+        m_hasBaseline = false;
+
     timer.Stop();
-    wxLogTrace( traceDrcProfile, "DRC took %0.3f ms", timer.msecs() );
+    wxLogTrace( traceDrcProfile, "Incremental DRC of %zu item(s) took %0.3f ms",
+                aChangedItems.size(), timer.msecs() );
 
-    // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
-    // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
+
+    return true;
+}
+
+
+bool DRC_ENGINE::TestItems( EDA_UNITS aUnits, const std::vector<BOARD_ITEM*>& aItems,
+                            const std::set<wxString>& aProviders, DRC_VIOLATION_HANDLER aHandler )
+{
+    PROF_TIMER timer;
+
+    SetUserUnits( aUnits );
+
+    if( m_cacheTimeStamp != m_board->GetTimeStamp() )
+    {
+        if( !prepareTests( m_reportAllTrackErrors, m_testFootprints ) )
+            return false;
+    }
+    else
+    {
+        resetErrorLimits();
+        DRC_TEST_PROVIDER::Init();
+    }
+
+    int timestamp = m_board->GetTimeStamp();
+
+    m_incrementalScope.clear();
+    buildIncrementalScope( aItems );
+
+    // The violations go to the caller only; they are not part of the full run's record
+    std::swap( m_violationHandler, aHandler );
+
+    bool completed = true;
+
+    m_incremental = true;
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        if( !provider->SupportsIncrementalTests() )
+            continue;
+
+        if( !aProviders.empty() && !aProviders.count( provider->GetName() ) )
+            continue;
+
+        if( !provider->RunTests( aUnits ) )
+        {
+            completed = false;
+            break;
+        }
+    }
+
+    m_incremental = false;
+    m_incrementalScope.clear();
+
+    std::swap( m_violationHandler, aHandler );
+
+    timer.Stop();
+    wxLogTrace( traceDrcProfile, "DRC of %zu item(s) took %0.3f ms", aItems.size(),
+                timer.msecs() );
+
+    wxASSERT( timestamp == m_board->GetTimeStamp() );
+
+    return completed && !IsCancelled();
+}
+
+
+bool DRC_ENGINE::TestRegion( EDA_UNITS aUnits, const BOX2I& aRegion,
+                             const std::set<wxString>& aProviders, DRC_VIOLATION_HANDLER aHandler )
+{
+    std::vector<BOARD_ITEM*> items;
+
+    auto collect =
+            [&]( BOARD_ITEM* aItem )
+            {
+                if( aItem->GetBoundingBox().Intersects( aRegion ) )
+                    items.push_back( aItem );
+            };
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+        collect( track );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+        collect( footprint );
+
+    for( ZONE* zone : m_board->Zones() )
+        collect( zone );
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        collect( item );
+
+    return TestItems( aUnits, items, aProviders, std::move( aHandler ) );
 }
 
 
@@ -1618,8 +2105,72 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
     {
         std::vector<DRC_ENGINE_CONSTRAINT*>* ruleset = m_constraintMap[ aConstraintType ];
 
-        for( DRC_ENGINE_CONSTRAINT* rule : *ruleset )
-            processConstraint( rule );
+        // Rule resolution is cached unless we're reporting on it
+        bool               useCache = !aReporter && m_classOnlyConstraints.count( aConstraintType );
+        bool               cached = false;
+        DRC_RULE_CACHE_KEY cacheKey;
+        int                timestamp = m_board->GetTimeStamp();
+
+        if( useCache )
+        {
+            auto itemClass =
+                    [&]( const BOARD_ITEM* aItem, const BOARD_CONNECTED_ITEM* aConnected,
+                         bool aNonCopper )
+                    {
+                        DRC_RULE_CACHE_KEY::ITEM_CLASS itemClass;
+
+                        if( !aItem )
+                            return itemClass;
+
+                        const FOOTPRINT* fp = aItem->Type() == PCB_FOOTPRINT_T
+                                                    ? static_cast<const FOOTPRINT*>( aItem )
+                                                    : aItem->GetParentFootprint();
+
+                        itemClass.m_present = true;
+                        itemClass.m_isFootprint = aItem->Type() == PCB_FOOTPRINT_T;
+                        itemClass.m_nonCopper = aNonCopper;
+                        itemClass.m_netclass = aConnected ? aConnected->GetEffectiveNetClass() : nullptr;
+                        itemClass.m_componentClass = fp ? fp->GetComponentClass() : nullptr;
+                        return itemClass;
+                    };
+
+            cacheKey.m_type = aConstraintType;
+            cacheKey.m_layer = aLayer;
+            cacheKey.m_a = itemClass( a, ac, a_is_non_copper );
+            cacheKey.m_b = itemClass( b, bc, b_is_non_copper );
+
+            std::shared_lock<std::shared_mutex> readLock( m_ruleCacheMutex );
+
+            if( m_ruleCacheTimeStamp == timestamp )
+            {
+                auto it = m_ruleCache.find( cacheKey );
+
+                if( it != m_ruleCache.end() )
+                {
+                    constraint = it->second;
+                    cached = true;
+                }
+            }
+        }
+
+        if( !cached )
+        {
+            for( DRC_ENGINE_CONSTRAINT* rule : *ruleset )
+                processConstraint( rule );
+        }
+
+        if( useCache && !cached )
+        {
+            std::unique_lock<std::shared_mutex> writeLock( m_ruleCacheMutex );
+
+            if( m_ruleCacheTimeStamp != timestamp )
+            {
+                m_ruleCache.clear();
+                m_ruleCacheTimeStamp = timestamp;
+            }
+
+            m_ruleCache[cacheKey] = constraint;
+        }
     }
 
     if( constraint.GetParentRule() && !constraint.GetParentRule()->IsImplicit() )
@@ -1941,10 +2492,21 @@ void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const
 
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
 
-    if( m_violationHandler )
+    if( m_violationHandler || m_recordViolations )
     {
         std::lock_guard<std::mutex> guard( globalLock );
-        m_violationHandler( aItem, aPos, aMarkerLayer, aPathGenerator );
+
+        if( m_recordViolations )
+        {
+            for( const KIID& id : aItem->GetIDs() )
+            {
+                if( id != niluuid )
+                    m_violationsByItem[id].push_back( aItem );
+            }
+        }
+
+        if( m_violationHandler )
+            m_violationHandler( aItem, aPos, aMarkerLayer, aPathGenerator );
     }
 
     if( m_logReporter )
@@ -1975,6 +2537,10 @@ bool DRC_ENGINE::KeepRefreshing( bool aWait )
     if( !m_progressReporter )
         return true;
 
+    // Providers run off the main thread; RunTests() refreshes the UI while waiting for them
+    if( !wxThread::IsMain() )
+        return !m_progressReporter->IsCancelled();
+
     return m_progressReporter->KeepRefreshing( aWait );
 }
 
@@ -1999,6 +2565,10 @@ bool DRC_ENGINE::ReportProgress( double aProgress )
         return true;
 
     m_progressReporter->SetCurrentProgress( aProgress );
+
+    if( !wxThread::IsMain() )
+        return !m_progressReporter->IsCancelled();
+
     return m_progressReporter->KeepRefreshing( false );
 }
 
@@ -2009,6 +2579,10 @@ bool DRC_ENGINE::ReportPhase( const wxString& aMessage )
         return true;
 
     m_progressReporter->AdvancePhase( aMessage );
+
+    if( !wxThread::IsMain() )
+        return !m_progressReporter->IsCancelled();
+
     bool retval = m_progressReporter->KeepRefreshing( false );
     wxSafeYield( nullptr, true ); // Force an update for the message
     return retval;
@@ -2032,6 +2606,15 @@ bool DRC_ENGINE::HasRulesForConstraintType( DRC_CONSTRAINT_T constraintID )
 }
 
 
+bool DRC_ENGINE::RulesDependOnlyOnClasses( DRC_CONSTRAINT_T aConstraintType ) const
+{
+    std::shared_lock<std::shared_mutex> readLock( m_ruleCacheMutex );
+
+    return !m_constraintMap.count( aConstraintType )
+            || m_classOnlyConstraints.count( aConstraintType );
+}
+
+
 bool DRC_ENGINE::QueryWorstConstraint( DRC_CONSTRAINT_T aConstraintId, DRC_CONSTRAINT& aConstraint )
 {
     int worst = 0;
@@ -23,9 +23,13 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <set>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <kiid.h>
 #include <layer_ids.h>
@@ -50,8 +54,75 @@ struct DRC_OWN_CLEARANCE_CACHE_KEY
 };
 
 
+class NETCLASS;
+class COMPONENT_CLASS;
+
+
+/**
+ * Cache key for rule resolution: the items are reduced to the attributes which class-only
+ * rule conditions can test (see DRC_RULE_CONDITION::DependsOnlyOnClasses()).
+ */
+struct DRC_RULE_CACHE_KEY
+{
+    struct ITEM_CLASS
+    {
+        bool                   m_present = false;
+        bool                   m_isFootprint = false;
+        bool                   m_nonCopper = false;
+        const NETCLASS*        m_netclass = nullptr;
+        const COMPONENT_CLASS* m_componentClass = nullptr;
+
+        bool operator==( const ITEM_CLASS& aOther ) const
+        {
+            return m_present == aOther.m_present && m_isFootprint == aOther.m_isFootprint
+                    && m_nonCopper == aOther.m_nonCopper && m_netclass == aOther.m_netclass
+                    && m_componentClass == aOther.m_componentClass;
+        }
+    };
+
+    DRC_CONSTRAINT_T m_type;
+    PCB_LAYER_ID     m_layer;
+    ITEM_CLASS       m_a;
+    ITEM_CLASS       m_b;
+
+    bool operator==( const DRC_RULE_CACHE_KEY& aOther ) const
+    {
+        return m_type == aOther.m_type && m_layer == aOther.m_layer && m_a == aOther.m_a
+                && m_b == aOther.m_b;
+    }
+};
+
+
 namespace std
 {
+    template <>
+    struct hash<DRC_RULE_CACHE_KEY>
+    {
+        std::size_t operator()( const DRC_RULE_CACHE_KEY& aKey ) const
+        {
+            std::size_t seed = 0xa82de1c0;
+
+            auto combine =
+                    [&]( std::size_t aValue )
+                    {
+                        seed ^= aValue + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+                    };
+
+            combine( std::hash<int>{}( static_cast<int>( aKey.m_type ) ) );
+            combine( std::hash<int>{}( static_cast<int>( aKey.m_layer ) ) );
+
+            for( const DRC_RULE_CACHE_KEY::ITEM_CLASS* item : { &aKey.m_a, &aKey.m_b } )
+            {
+                combine( ( item->m_present ? 1 : 0 ) | ( item->m_isFootprint ? 2 : 0 )
+                         | ( item->m_nonCopper ? 4 : 0 ) );
+                combine( std::hash<const void*>{}( item->m_netclass ) );
+                combine( std::hash<const void*>{}( item->m_componentClass ) );
+            }
+
+            return seed;
+        }
+    };
+
     template <>
     struct hash<DRC_OWN_CLEARANCE_CACHE_KEY>
     {
@@ -76,7 +147,6 @@ class DS_PROXY_VIEW_ITEM;
 class BOARD_ITEM;
 class BOARD;
 class PCB_MARKER;
-class NETCLASS;
 class NETLIST;
 class NETINFO_ITEM;
 class PROGRESS_REPORTER;
@@ -187,6 +257,58 @@ public:
     void RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aTestFootprints,
                    BOARD_COMMIT* aCommit = nullptr );
 
+    /**
+     * Re-run the DRC tests on the items changed since the last call to RunTests().
+     *
+     * Only the providers which support incremental tests are run, and they only test the
+     * changed items and the copper items within the board's maximum clearance of them.  The
+     * violations those providers previously reported against any of these items (or against
+     * items which no longer exist) are returned in \a aStaleViolations; the new ones are passed
+     * to the violation handler as usual.
+     *
+     * @return false if there is no previous full run to update.
+     */
+    bool RunIncrementalTests( EDA_UNITS aUnits, const std::set<KIID>& aChangedItems,
+                              std::vector<std::shared_ptr<DRC_ITEM>>& aStaleViolations );
+
+    /**
+     * Test \a aItems, and the copper items within the board's maximum clearance of them, with
+     * the providers which support incremental tests.
+     *
+     * Unlike RunIncrementalTests() this needs no previous full run and leaves its record of
+     * violations alone: it answers "is this legal?" for a few items, e.g. after each move of a
+     * scripted placement.  The violations are passed to \a aHandler rather than to the engine's
+     * violation handler.  The caches of the previous run are reused while the board has not
+     * changed since.
+     *
+     * @param aProviders are the names of the providers to run; all the incremental ones if
+     *                   empty.
+     * @return false if the tests were cancelled or could not run.
+     */
+    bool TestItems( EDA_UNITS aUnits, const std::vector<BOARD_ITEM*>& aItems,
+                    const std::set<wxString>& aProviders, DRC_VIOLATION_HANDLER aHandler );
+
+    /**
+     * Run TestItems() on the items whose bounding box intersects \a aRegion.
+     */
+    bool TestRegion( EDA_UNITS aUnits, const BOX2I& aRegion, const std::set<wxString>& aProviders,
+                     DRC_VIOLATION_HANDLER aHandler );
+
+    /**
+     * @return true if the providers are running on a subset of the board (see
+     *         RunIncrementalTests() and TestItems()).
+     */
+    bool IsIncremental() const { return m_incremental; }
+
+    /**
+     * @return true if \a aItem must be tested by the running providers.  Always true outside
+     *         of an incremental run.
+     */
+    bool IsInScope( const BOARD_ITEM* aItem ) const
+    {
+        return !m_incremental || m_incrementalScope.count( aItem );
+    }
+
     bool IsErrorLimitExceeded( int error_code );
 
     DRC_CONSTRAINT EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
@@ -240,6 +362,13 @@ public:
 
     bool HasRulesForConstraintType( DRC_CONSTRAINT_T constraintID );
 
+    /**
+     * @return true if the rule conditions of \a aConstraintType only test netclasses and
+     *         component classes, so that EvalRules() resolves it the same way for all items of
+     *         the same classes (local overrides aside).
+     */
+    bool RulesDependOnlyOnClasses( DRC_CONSTRAINT_T aConstraintType ) const;
+
     bool GetReportAllTrackErrors() const { return m_reportAllTrackErrors; }
     bool GetTestFootprints() const { return m_testFootprints; }
 
@@ -262,6 +391,9 @@ public:
 
     std::vector<DRC_TEST_PROVIDER*> GetTestProviders() const { return m_testProviders; };
 
+    /// @return the wall time, in milliseconds, taken by each provider during the last RunTests().
+    const std::map<wxString, double>& GetProviderTimes() const { return m_providerTimes; }
+
     DRC_TEST_PROVIDER* GetTestProvider( const wxString& name ) const;
 
     /**
@@ -320,6 +452,28 @@ private:
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name, DRC_IMPLICIT_SOURCE aImplicitSource );
 
+    /**
+     * Reset the error limits and rebuild the board caches before running the providers.
+     *
+     * @return false if cancelled.
+     */
+    bool prepareTests( bool aReportAllTrackErrors, bool aTestFootprints );
+
+    void resetErrorLimits();
+
+    /**
+     * Add \a aItems and the copper items within the maximum clearance of them to the scope of
+     * an incremental run.
+     */
+    void buildIncrementalScope( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Run all the providers, concurrently for those which don't depend on each other's state.
+     *
+     * @return false if a provider was cancelled.
+     */
+    bool runTestProviders( EDA_UNITS aUnits );
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -329,8 +483,10 @@ protected:
     std::vector<std::shared_ptr<DRC_RULE>>  m_rules;
     bool                                    m_rulesValid;
     std::vector<DRC_TEST_PROVIDER*>         m_testProviders;
+    std::map<wxString, double>              m_providerTimes;
 
     std::vector<int>           m_errorLimits;
+    int                        m_cacheTimeStamp;      // board timestamp the caches were built at
     bool                       m_reportAllTrackErrors;
     bool                       m_testFootprints;
 
@@ -343,6 +499,23 @@ protected:
 
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
 
+    // Violations reported by the last full run, updated by each incremental run.  Indexed by
+    // the KIIDs of the items they refer to.
+    bool                                  m_recordViolations;
+    bool                                  m_hasBaseline;
+    std::set<std::shared_ptr<DRC_ITEM>>   m_violations;
+    std::unordered_map<KIID, std::vector<std::shared_ptr<DRC_ITEM>>> m_violationsByItem;
+
+    bool                                  m_incremental;
+    std::unordered_set<const BOARD_ITEM*> m_incrementalScope;
+
+    // Rule resolution cache for the constraint types whose rule conditions only test classes.
+    // Valid for one board timestamp.
+    std::set<DRC_CONSTRAINT_T>                                 m_classOnlyConstraints;
+    std::unordered_map<DRC_RULE_CACHE_KEY, DRC_CONSTRAINT>     m_ruleCache;
+    int                                                        m_ruleCacheTimeStamp;
+    mutable std::shared_mutex                                  m_ruleCacheMutex;
+
     // Cache for GetOwnClearance lookups to improve rendering performance.
     // Key is (UUID, layer), value is clearance in internal units.
     std::unordered_map<DRC_OWN_CLEARANCE_CACHE_KEY, int> m_ownClearanceCache;
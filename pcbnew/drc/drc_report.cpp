@@ -149,61 +149,44 @@ bool DRC_REPORT::WriteJsonReport( const wxString& aFullFileName )
     std::map<KIID, EDA_ITEM*> itemMap;
     m_board->FillItemMap( itemMap );
 
-    RC_JSON::DRC_REPORT reportHead;
+    // Violations are written as they are converted: a board with a few hundred thousand of
+    // them would otherwise need the whole document in memory.
+    RC_JSON::STREAM_WRITER writer( jsonFileStream );
+    wxFileName             fn( m_board->GetFileName() );
 
-    wxFileName fn( m_board->GetFileName() );
-    reportHead.$schema = "https://schemas.kicad.org/drc.v1.json";
-    reportHead.source = fn.GetFullName();
-    reportHead.date = GetISO8601CurrentDateTime();
-    reportHead.kicad_version = GetMajorMinorPatchVersion();
-    reportHead.coordinate_units = EDA_UNIT_UTILS::GetLabel( m_reportUnits );
-
-    // Document which severities are included in this report
-    if( m_reportedSeverities & RPT_SEVERITY_ERROR )
-        reportHead.included_severities.push_back( wxS( "error" ) );
-
-    if( m_reportedSeverities & RPT_SEVERITY_WARNING )
-        reportHead.included_severities.push_back( wxS( "warning" ) );
-
-    if( m_reportedSeverities & RPT_SEVERITY_EXCLUSION )
-        reportHead.included_severities.push_back( wxS( "exclusion" ) );
-
-    for( int i = 0; i < m_markersProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_markersProvider->GetItem( i );
-        SEVERITY                        severity = item->GetParent()->GetSeverity();
-
-        if( severity == RPT_SEVERITY_EXCLUSION )
-            severity = bds.GetSeverity( item->GetErrorCode() );
-
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
-
-        reportHead.violations.push_back( violation );
-    }
+    auto writeViolations =
+            [&]( const std::string& aKey, const std::shared_ptr<RC_ITEMS_PROVIDER>& aProvider,
+                 bool aUseMarkerSeverity )
+            {
+                writer.BeginArray( aKey );
 
-    for( int i = 0; i < m_ratsnestProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_ratsnestProvider->GetItem( i );
-        SEVERITY                        severity = bds.GetSeverity( item->GetErrorCode() );
+                for( int i = 0; i < aProvider->GetCount(); ++i )
+                {
+                    const std::shared_ptr<RC_ITEM>& item = aProvider->GetItem( i );
+                    SEVERITY severity = bds.GetSeverity( item->GetErrorCode() );
 
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+                    // Markers carry their own severity unless they are excluded
+                    if( aUseMarkerSeverity
+                            && item->GetParent()->GetSeverity() != RPT_SEVERITY_EXCLUSION )
+                    {
+                        severity = item->GetParent()->GetSeverity();
+                    }
 
-        reportHead.unconnected_items.push_back( violation );
-    }
+                    RC_JSON::VIOLATION violation;
+                    item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
 
+                    writer.Element( violation );
+                }
 
-    for( int i = 0; i < m_fpWarningsProvider->GetCount(); ++i )
-    {
-        const std::shared_ptr<RC_ITEM>& item = m_fpWarningsProvider->GetItem( i );
-        SEVERITY                        severity = bds.GetSeverity( item->GetErrorCode() );
+                writer.Close();
+            };
 
-        RC_JSON::VIOLATION violation;
-        item->GetJsonViolation( violation, &unitsProvider, severity, itemMap );
+    // Members in alphabetical order, as nlohmann::json would write them
+    writer.Member( "$schema", wxString( wxS( "https://schemas.kicad.org/drc.v1.json" ) ) );
+    writer.Member( "coordinate_units", EDA_UNIT_UTILS::GetLabel( m_reportUnits ) );
+    writer.Member( "date", GetISO8601CurrentDateTime() );
 
-        reportHead.schematic_parity.push_back( violation );
-    }
+    std::vector<RC_JSON::IGNORED_CHECK> ignoredChecks;
 
     for( const RC_ITEM& item : DRC_ITEM::GetItemsWithSeverities() )
     {
@@ -214,12 +197,32 @@ bool DRC_REPORT::WriteJsonReport( const wxString& aFullFileName )
             RC_JSON::IGNORED_CHECK ignoredCheck;
             ignoredCheck.key = item.GetSettingsKey();
             ignoredCheck.description = item.GetErrorMessage( false );
-            reportHead.ignored_checks.push_back( ignoredCheck );
+            ignoredChecks.push_back( ignoredCheck );
         }
     }
 
-    nlohmann::json saveJson = nlohmann::json( reportHead );
-    jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
+    writer.Member( "ignored_checks", ignoredChecks );
+
+    // Document which severities are included in this report
+    std::vector<wxString> includedSeverities;
+
+    if( m_reportedSeverities & RPT_SEVERITY_ERROR )
+        includedSeverities.push_back( wxS( "error" ) );
+
+    if( m_reportedSeverities & RPT_SEVERITY_WARNING )
+        includedSeverities.push_back( wxS( "warning" ) );
+
+    if( m_reportedSeverities & RPT_SEVERITY_EXCLUSION )
+        includedSeverities.push_back( wxS( "exclusion" ) );
+
+    writer.Member( "included_severities", includedSeverities );
+    writer.Member( "kicad_version", GetMajorMinorPatchVersion() );
+    writeViolations( "schematic_parity", m_fpWarningsProvider, false );
+    writer.Member( "source", fn.GetFullName() );
+    writeViolations( "unconnected_items", m_ratsnestProvider, false );
+    writeViolations( "violations", m_markersProvider, true );
+    writer.Close();
+
     jsonFileStream.flush();
     jsonFileStream.close();
 
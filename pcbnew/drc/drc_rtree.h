@@ -33,6 +33,7 @@
 #include <set>
 #include <vector>
 
+#include <geometry/packed_rtree.h>
 #include <geometry/rtree.h>
 #include <geometry/shape.h>
 #include <geometry/shape_segment.h>
@@ -45,6 +46,9 @@
 /**
  * Implement an R-tree for fast spatial and layer indexing of connectable items.
  * Non-owning.
+ *
+ * Items are inserted in dynamic trees.  Trees which are filled once and then queried many times
+ * should call Build() after the last insertion, so that queries run on packed static trees.
  */
 class DRC_RTREE
 {
@@ -145,6 +149,7 @@ public:
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( parent, subshape, shape );
 
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
+            m_packed[aTargetLayer].Add( bbox, itemShape );
             m_count++;
         }
 
@@ -160,10 +165,21 @@ public:
             ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( parent, hole, shape );
 
             m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
+            m_packed[aTargetLayer].Add( bbox, itemShape );
             m_count++;
         }
     }
 
+    /**
+     * Pack the items inserted so far into static trees for the queries.  Items inserted later
+     * are found again once Build() is called anew; until then the dynamic trees are used.
+     */
+    void Build()
+    {
+        for( auto& [_, packed] : m_packed )
+            packed.Build();
+    }
+
     /**
      * Remove all items from the RTree.
      */
@@ -172,6 +188,7 @@ public:
         for( auto& [_, tree] : m_tree )
             tree->RemoveAll();
 
+        m_packed.clear();
         m_count = 0;
     }
 
@@ -203,8 +220,7 @@ public:
                     return true;
                 };
 
-        if( auto it = m_tree.find( aTargetLayer ); it != m_tree.end() )
-            it->second->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
 
         return count > 0;
     }
@@ -277,8 +293,7 @@ public:
                     return true;
                 };
 
-        if( auto it = m_tree.find( aTargetLayer ); it != m_tree.end() )
-            it->second->Search( min, max, visit );
+        search( aTargetLayer, min, max, visit );
 
         return count;
     }
@@ -326,8 +341,7 @@ public:
                     return true;
                 };
 
-        if( auto it = m_tree.find( aLayer ); it != m_tree.end() )
-            it->second->Search( min, max, visit );
+        search( aLayer, min, max, visit );
 
         if( collision )
         {
@@ -402,15 +416,10 @@ public:
 
                     return true;
                 };
-        auto it = m_tree.find( aLayer );
-
-        if( it == m_tree.end() )
-            return false;
-
         if( poly && poly->OutlineCount() == 1 && poly->HoleCount( 0 ) == 0 )
-            it->second->Search( min, max, polyVisitor );
+            search( aLayer, min, max, polyVisitor );
         else
-            it->second->Search( min, max, visitor );
+            search( aLayer, min, max, visitor );
 
         return collision;
     }
@@ -435,7 +444,7 @@ public:
                     return true;
                 };
 
-        m_tree[aLayer]->Search( min, max, visitor );
+        search( aLayer, min, max, visitor );
 
         return retval;
     }
@@ -487,10 +496,7 @@ public:
                             return true;
                         };
 
-                auto it = m_tree.find( targetLayer );
-
-                if( it != m_tree.end() )
-                    it->second->Search( min, max, visit );
+                search( targetLayer, min, max, visit );
             };
         }
 
@@ -604,8 +610,19 @@ public:
 
 
 private:
-    std::map<int, drc_rtree*> m_tree;
-    size_t                    m_count;
+    template <class VISITOR>
+    void search( int aLayer, const int aMin[2], const int aMax[2], VISITOR& aVisitor ) const
+    {
+        if( auto it = m_packed.find( aLayer ); it != m_packed.end() && it->second.IsBuilt() )
+            it->second.Search( aMin, aMax, aVisitor );
+        else if( auto it2 = m_tree.find( aLayer ); it2 != m_tree.end() )
+            it2->second->Search( aMin, aMax, aVisitor );
+    }
+
+private:
+    std::map<int, drc_rtree*>                     m_tree;
+    std::map<int, PACKED_RTREE<ITEM_WITH_SHAPE*>> m_packed;
+    size_t                                        m_count;
 };
 
 
@@ -27,6 +27,8 @@
 #include <drc/drc_rule_condition.h>
 #include <pcbexpr_evaluator.h>
 
+#include <set>
+
 
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
@@ -70,7 +72,7 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
 
     ctx.SetItems( a, b );
 
-    if( m_ucode->Run( &ctx )->AsDouble() != 0.0 )
+    if( m_ucode->RunAsDouble( &ctx ) != 0.0 )
     {
         return true;
     }
@@ -78,7 +80,7 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
     {
         ctx.SetItems( b, a );
 
-        if( m_ucode->Run( &ctx )->AsDouble() != 0.0 )
+        if( m_ucode->RunAsDouble( &ctx ) != 0.0 )
             return true;
     }
 
@@ -86,6 +88,74 @@ bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM
 }
 
 
+bool DRC_RULE_CONDITION::DependsOnlyOnClasses() const
+{
+    static const std::set<wxString> classMembers = { wxS( "netclass" ),
+                                                     wxS( "componentclass" ),
+                                                     wxS( "hasnetclass" ),
+                                                     wxS( "hasexactnetclass" ),
+                                                     wxS( "hascomponentclass" ) };
+
+    const wxString& expr = GetExpression();
+    size_t          ii = 0;
+
+    auto isIdentChar =
+            []( wxUniChar c )
+            {
+                return wxIsalnum( c ) || c == '_';
+            };
+
+    while( ii < expr.length() )
+    {
+        wxUniChar c = expr[ii];
+
+        if( c == '\'' || c == '"' )
+        {
+            // Skip string literals; they're the arguments of the functions checked below
+            size_t end = expr.find( c, ii + 1 );
+
+            if( end == wxString::npos )
+                return false;
+
+            ii = end + 1;
+        }
+        else if( wxIsdigit( c ) )
+        {
+            // Numbers, with their units
+            while( ii < expr.length() && ( isIdentChar( expr[ii] ) || expr[ii] == '.' ) )
+                ii++;
+        }
+        else if( isIdentChar( c ) )
+        {
+            size_t start = ii;
+
+            while( ii < expr.length() && isIdentChar( expr[ii] ) )
+                ii++;
+
+            wxString var = expr.Mid( start, ii - start );
+
+            // Only members of the A and B items are allowed (no AB, layer, etc.)
+            if( ( var != wxS( "A" ) && var != wxS( "B" ) ) || ii >= expr.length() || expr[ii] != '.' )
+                return false;
+
+            start = ++ii;
+
+            while( ii < expr.length() && isIdentChar( expr[ii] ) )
+                ii++;
+
+            if( !classMembers.count( expr.Mid( start, ii - start ).Lower() ) )
+                return false;
+        }
+        else
+        {
+            ii++;
+        }
+    }
+
+    return true;
+}
+
+
 bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSourceOffset )
 {
     PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
@@ -112,6 +182,11 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
     bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+
+    // Lower the common conditions to closures; anything else stays interpreted
+    if( ok )
+        m_ucode->Optimize();
+
     return ok;
 }
 
@@ -46,6 +46,12 @@ public:
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
+    /**
+     * @return true if the condition only tests the netclasses and component classes of the
+     *         items, so that it gives the same result for all items of the same classes.
+     */
+    bool DependsOnlyOnClasses() const;
+
 private:
     wxString                       m_expression;
     std::unique_ptr<PCBEXPR_UCODE> m_ucode;
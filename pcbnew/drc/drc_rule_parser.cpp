@@ -187,7 +187,7 @@ void DRC_RULES_PARSER::Parse( std::vector<std::shared_ptr<DRC_RULE>>& aRules, RE
             }
             else if( (int) token == DSN_NUMBER )
             {
-                m_requiredVersion = (int)strtol( CurText(), nullptr, 10 );
+                m_requiredVersion = (int) parseLong();
                 m_tooRecent = ( m_requiredVersion > DRC_RULE_FILE_VERSION );
 
                 if( (int) NextTok() != DSN_RIGHT )
@@ -253,7 +253,7 @@ void DRC_RULES_PARSER::ParseComponentClassAssignmentRules(
             }
             else if( (int) token == DSN_NUMBER )
             {
-                m_requiredVersion = (int) strtol( CurText(), nullptr, 10 );
+                m_requiredVersion = (int) parseLong();
                 m_tooRecent = ( m_requiredVersion > DRC_RULE_FILE_VERSION );
 
                 if( (int) NextTok() != DSN_RIGHT )
@@ -648,7 +648,7 @@ void DRC_RULES_PARSER::parseConstraint( DRC_RULE* aRule )
 
         if( (int) token == DSN_NUMBER )
         {
-            value = (int) strtol( CurText(), nullptr, 10 );
+            value = (int) parseLong();
             c.m_Value.SetMin( value );
 
             if( (int) NextTok() != DSN_RIGHT )
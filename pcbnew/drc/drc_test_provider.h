@@ -37,6 +37,25 @@ class DRC_TEST_PROVIDER;
 class DRC_RULE;
 class DRC_CONSTRAINT;
 
+
+/**
+ * Shared state the test providers depend on, used by DRC_ENGINE to schedule independent
+ * providers concurrently.
+ */
+enum DRC_PROVIDER_STATE
+{
+    DRC_STATE_CACHES        = 1 << 0,   ///< Item/zone rtrees and courtyards of DRC_CACHE_GENERATOR
+    DRC_STATE_ZONE_FILLS    = 1 << 1,
+    DRC_STATE_CONNECTIVITY  = 1 << 2,
+    DRC_STATE_FROM_TO_CACHE = 1 << 3,   ///< Connectivity's from-to cache
+    DRC_STATE_ITEM_FLAGS    = 1 << 4,   ///< Transient flags of the board items (e.g. HOLE_PROXY)
+    DRC_STATE_MAIN_THREAD   = 1 << 5,   ///< Needs the main thread (libraries, kiway, etc.)
+
+    /// Rule conditions can reach all of these
+    DRC_STATE_ALL_SHARED    = DRC_STATE_CACHES | DRC_STATE_ZONE_FILLS | DRC_STATE_CONNECTIVITY
+                                | DRC_STATE_FROM_TO_CACHE | DRC_STATE_ITEM_FLAGS
+};
+
 class DRC_TEST_PROVIDER_REGISTRY
 {
 public:
@@ -98,6 +117,25 @@ public:
 
     virtual const wxString GetName() const;
 
+    /**
+     * @return true if the provider can be run by DRC_ENGINE::RunIncrementalTests(), that is if
+     *         each of its violations is found by testing one of the items it refers to, and it
+     *         skips the items for which DRC_ENGINE::IsInScope() is false.
+     */
+    virtual bool SupportsIncrementalTests() const { return false; }
+
+    /**
+     * @return the #DRC_PROVIDER_STATE flags of the state read by the provider.  The state
+     *         built by DRC_CACHE_GENERATOR is always ready before any provider runs.
+     */
+    virtual int GetDependencies() const { return DRC_STATE_ALL_SHARED; }
+
+    /**
+     * @return the #DRC_PROVIDER_STATE flags of the state modified by the provider.  It won't
+     *         run concurrently with any provider depending on it.
+     */
+    virtual int GetModifications() const { return 0; }
+
 protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, const LSET& aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
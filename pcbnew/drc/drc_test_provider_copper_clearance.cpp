@@ -32,6 +32,7 @@
 #include <zone.h>
 
 #include <geometry/seg.h>
+#include <geometry/seg_batch.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
@@ -71,6 +72,8 @@ public:
 
     virtual const wxString GetName() const override { return wxT( "clearance" ); };
 
+    virtual bool SupportsIncrementalTests() const override { return true; }
+
 private:
     /**
      * Checks for track/via/hole <-> clearance
@@ -612,19 +615,27 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
             {
                 PCB_TRACK* track = m_board->Tracks()[trackIdx];
 
+                if( !m_drcEngine->IsInScope( track ) )
+                {
+                    done.fetch_add( 1 );
+                    return;
+                }
+
+                // Straight track pairs are deferred from the R-tree query and tested against
+                // the track in one batch
+                bool                    batchable = track->Type() == PCB_TRACE_T;
+                std::vector<PCB_TRACK*> deferred;
+                SEG_BATCH               batch;
+                std::vector<uint8_t>    mask;
+
                 for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & boardCopperLayers ) )
                 {
                     std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
+                    bool                   trackDone = false;
 
-                    m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
-                            // Filter:
+                    auto claimPair =
                             [&]( BOARD_ITEM* other ) -> bool
                             {
-                                BOARD_CONNECTED_ITEM* otherCItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other );
-
-                                if( otherCItem && otherCItem->GetNetCode() == track->GetNetCode() )
-                                    return false;
-
                                 BOARD_ITEM* a = track;
                                 BOARD_ITEM* b = other;
 
@@ -646,8 +657,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
                                     checkedPairs[ { a, b } ].layers.set( layer );
                                     return true;
                                 }
-                            },
-                            // Visitor:
+                            };
+
+                    auto visitor =
                             [&]( BOARD_ITEM* other ) -> bool
                             {
                                 if( m_drcEngine->IsCancelled() )
@@ -691,14 +703,67 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
                                         if( it != checkedPairs.end() )
                                             it->second.has_error = true;
 
+                                        trackDone = true;
                                         return false;   // We're done with this track
                                     }
                                 }
 
                                 return !m_drcEngine->IsCancelled();
+                            };
+
+                    deferred.clear();
+
+                    m_board->m_CopperItemRTreeCache->QueryColliding( track, layer, layer,
+                            // Filter:
+                            [&]( BOARD_ITEM* other ) -> bool
+                            {
+                                BOARD_CONNECTED_ITEM* otherCItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( other );
+
+                                if( otherCItem && otherCItem->GetNetCode() == track->GetNetCode() )
+                                    return false;
+
+                                if( batchable && other->Type() == PCB_TRACE_T )
+                                {
+                                    deferred.push_back( static_cast<PCB_TRACK*>( other ) );
+                                    return false;
+                                }
+
+                                return claimPair( other );
                             },
+                            // Visitor:
+                            visitor,
                             m_board->m_DRCMaxClearance );
 
+                    if( !deferred.empty() && !trackDone && !m_drcEngine->IsCancelled() )
+                    {
+                        batch.Clear();
+                        batch.Reserve( deferred.size() );
+
+                        for( PCB_TRACK* other : deferred )
+                            batch.Add( SEG( other->GetStart(), other->GetEnd() ), other->GetWidth() / 2 );
+
+                        // The mask is conservative: pairs it rejects are further apart than the
+                        // worst clearance, the ones it keeps get the exact test below.
+                        batch.Collide( SEG( track->GetStart(), track->GetEnd() ),
+                                       track->GetWidth() / 2 + m_board->m_DRCMaxClearance, mask );
+
+                        for( size_t ii = 0; ii < deferred.size(); ++ii )
+                        {
+                            PCB_TRACK* other = deferred[ii];
+
+                            if( !mask[ii] || !claimPair( other ) )
+                                continue;
+
+                            SHAPE_SEGMENT otherSeg( other->GetStart(), other->GetEnd(), other->GetWidth() );
+
+                            if( !trackShape->Collide( &otherSeg, m_board->m_DRCMaxClearance ) )
+                                continue;
+
+                            if( !visitor( other ) )
+                                break;
+                        }
+                    }
+
                     for( ZONE* zone : m_board->m_DRCCopperZones )
                     {
                         testItemAgainstZone( track, zone, layer );
@@ -960,6 +1025,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 
                 for( PAD* pad : footprint->Pads() )
                 {
+                    if( !m_drcEngine->IsInScope( pad ) )
+                        continue;
+
                     for( PCB_LAYER_ID layer : LSET( pad->GetLayerSet() & boardCopperLayers ) )
                     {
                         if( m_drcEngine->IsCancelled() )
@@ -1039,7 +1107,6 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
 
 void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
 {
-    thread_pool&        tp = GetKiCadThreadPool();
     size_t              count = m_board->Drawings().size();
     std::atomic<size_t> done( 1 );
 
@@ -1060,7 +1127,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
                 if( item->Type() == PCB_REFERENCE_IMAGE_T )
                     return;
 
-                if( !IsCopperLayer( item->GetLayer() ) )
+                if( !IsCopperLayer( item->GetLayer() ) || !m_drcEngine->IsInScope( item ) )
                     return;
 
                 // Knockout text is most often knocked-out of a zone, so it's presumed to
@@ -1088,6 +1155,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
             {
                 PCB_LAYER_ID layer = graphic->GetLayer();
 
+                if( !m_drcEngine->IsInScope( graphic ) )
+                    return;
+
                 m_board->m_CopperItemRTreeCache->QueryColliding( graphic, layer, layer,
                         // Filter:
                         [&]( BOARD_ITEM* other ) -> bool
@@ -1137,9 +1207,11 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
                         m_board->m_DRCMaxClearance );
             };
 
+    TASK_GROUP tasks;
+
     for( BOARD_ITEM* item : m_board->Drawings() )
     {
-        (void)tp.submit_task(
+        tasks.Submit(
                 [this, item, &done, testGraphicAgainstZone, testCopperGraphic]()
                 {
                     if( !m_drcEngine->IsCancelled() )
@@ -1159,7 +1231,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
-        (void)tp.submit_task(
+        tasks.Submit(
                 [this, footprint, &done, testGraphicAgainstZone, testCopperGraphic]()
                 {
                     for( BOARD_ITEM* item : footprint->GraphicalItems() )
@@ -1185,11 +1257,17 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances()
         reportProgress( done, count );
 
         if( m_drcEngine->IsCancelled() )
+        {
+            tasks.Cancel();
             break;
+        }
 
-        if( tp.wait_for( std::chrono::milliseconds( 250 ) ) )
+        if( tasks.WaitFor( std::chrono::milliseconds( 250 ) ) )
             break;
     }
+
+    // Only wait for our own tasks; the pool may be busy with unrelated work
+    tasks.Wait();
 }
 
 
@@ -1201,7 +1279,6 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
     std::vector<std::map<PCB_LAYER_ID, std::vector<SEG>>> poly_segments;
     poly_segments.resize( m_board->m_DRCCopperZones.size() );
 
-    thread_pool&        tp = GetKiCadThreadPool();
     std::atomic<size_t> done( 0 );
     size_t              count = 0;
 
@@ -1307,6 +1384,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
         }
     }
 
+    TASK_GROUP tasks;
+
     for( PCB_LAYER_ID layer : LAYER_RANGE( F_Cu, B_Cu, m_board->GetCopperLayerCount() ) )
     {
         // Skip over layers not used on the current board
@@ -1353,6 +1432,9 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                 if( zoneA->GetIsRuleArea() || zoneB->GetIsRuleArea() )
                     continue;
 
+                if( !m_drcEngine->IsInScope( zoneA ) && !m_drcEngine->IsInScope( zoneB ) )
+                    continue;
+
                 // Examine a candidate zone: compare zoneB to zoneA
                 SHAPE_POLY_SET* polyA = nullptr;
                 SHAPE_POLY_SET* polyB = nullptr;
@@ -1372,7 +1454,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 count++;
-                (void)tp.submit_task(
+                tasks.Submit(
                         [checkZones, ia, ia2, sameNet, layer]()
                         {
                             checkZones( ia, ia2, sameNet, layer );
@@ -1386,11 +1468,17 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
         reportProgress( done, count );
 
         if( m_drcEngine->IsCancelled() )
+        {
+            tasks.Cancel();
             break;
+        }
 
-        if( tp.wait_for( std::chrono::milliseconds( 250 ) ) )
+        if( tasks.WaitFor( std::chrono::milliseconds( 250 ) ) )
             break;
     }
+
+    // Only wait for our own tasks; the pool may be busy with unrelated work
+    tasks.Wait();
 }
 
 namespace detail
@@ -28,6 +28,7 @@
 #include <geometry/shape_segment.h>
 #include <drc/drc_test_provider.h>
 #include <footprint.h>
+#include <geometry/packed_rtree.h>
 
 /*
     Couartyard clearance. Tests for malformed component courtyards and overlapping footprints.
@@ -55,6 +56,9 @@ public:
 
     virtual const wxString GetName() const override { return wxT( "courtyard_clearance" ); }
 
+    // Rebuilds the courtyards of footprints with malformed courtyards to report them
+    virtual int GetModifications() const override { return DRC_STATE_CACHES; }
+
 private:
     bool testFootprintCourtyardDefinitions();
 
@@ -155,6 +159,37 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
                    return a->m_Uuid < b->m_Uuid;
                } );
 
+    // Every test of a pair needs the courtyard of one footprint, inflated by the largest
+    // clearance, to reach the other footprint.  Bulk load an R-tree of these reach boxes so
+    // each footprint is only paired with the ones it can reach.
+    std::vector<BOX2I>   reach( footprints.size() );
+    PACKED_RTREE<size_t> reachTree;
+
+    for( size_t idx = 0; idx < footprints.size(); ++idx )
+    {
+        FOOTPRINT* fp = footprints[idx];
+
+        reach[idx] = fp->GetBoundingBox();
+
+        for( PCB_LAYER_ID layer : { F_CrtYd, B_CrtYd } )
+        {
+            const SHAPE_POLY_SET& courtyard = fp->GetCourtyard( layer );
+
+            if( courtyard.OutlineCount() > 0 )
+            {
+                BOX2I worstCaseBBox = courtyard.BBoxFromCaches();
+                worstCaseBBox.Inflate( m_largestCourtyardClearance );
+                reach[idx].Merge( worstCaseBBox );
+            }
+        }
+
+        reachTree.Add( reach[idx], idx );
+    }
+
+    reachTree.Build();
+
+    std::vector<size_t> candidates;
+
     for( auto itA = footprints.begin(); itA != footprints.end(); itA++ )
     {
         if( !reportProgress( ii++, footprints.size(), progressDelta ) )
@@ -186,11 +221,28 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
         frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
         backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
 
-        BOX2I fpA_bbox = fpA->GetBoundingBox();
+        BOX2I  fpA_bbox = fpA->GetBoundingBox();
+        size_t idxA = itA - footprints.begin();
+
+        candidates.clear();
+
+        auto collectCandidate =
+                [&]( size_t aIdxB )
+                {
+                    if( aIdxB > idxA )
+                        candidates.push_back( aIdxB );
+
+                    return true;
+                };
+
+        reachTree.Search( reach[idxA], collectCandidate );
+
+        // Keep the pairs in the same order as a full scan for stable violation generation
+        std::sort( candidates.begin(), candidates.end() );
 
-        for( auto itB = itA + 1; itB != footprints.end(); itB++ )
+        for( size_t idxB : candidates )
         {
-            FOOTPRINT*            fpB = *itB;
+            FOOTPRINT*            fpB = footprints[idxB];
             const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
             const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
 
@@ -38,6 +38,7 @@
 #include <drc/drc_creepage_utils.h>
 
 #include <geometry/shape_circle.h>
+#include <geometry/packed_rtree.h>
 
 
 /*
@@ -69,7 +70,15 @@ private:
     void CollectBoardEdges( std::vector<BOARD_ITEM*>& aVector );
     void CollectNetCodes( std::vector<int>& aVector );
 
+    /**
+     * Find the pairs of nets whose bounding boxes are close enough for any creepage constraint
+     * to apply, and fill m_netBoxes on the way.
+     */
+    void collectCandidatePairs( const std::vector<int>& aNetCodes, double aMaxConstraint,
+                                std::vector<std::pair<int, int>>& aPairs );
+
     std::set<std::pair<const BOARD_ITEM*, const BOARD_ITEM*>> m_reportedPairs;
+    std::unordered_map<int, BOX2I>                            m_netBoxes;
 };
 
 
@@ -77,6 +86,13 @@ bool DRC_TEST_PROVIDER_CREEPAGE::Run()
 {
     m_board = m_drcEngine->GetBoard();
     m_reportedPairs.clear();
+    m_netBoxes.clear();
+
+    if( !m_drcEngine->HasRulesForConstraintType( CREEPAGE_CONSTRAINT ) )
+    {
+        REPORT_AUX( wxT( "No creepage constraints found. Tests not run." ) );
+        return true;    // continue with other tests
+    }
 
     if( !m_drcEngine->IsErrorLimitExceeded( DRCE_CREEPAGE ) )
     {
@@ -109,13 +125,13 @@ int DRC_TEST_PROVIDER_CREEPAGE::testCreepage( CREEPAGE_GRAPH& aGraph, int aNetCo
         return 0;
 
     // Let's make a quick "clearance test"
-    NETINFO_ITEM* netA = m_board->FindNet( aNetCodeA );
-    NETINFO_ITEM* netB = m_board->FindNet( aNetCodeB );
+    auto boxA = m_netBoxes.find( aNetCodeA );
+    auto boxB = m_netBoxes.find( aNetCodeB );
 
-    if ( !netA || !netB )
+    if( boxA == m_netBoxes.end() || boxB == m_netBoxes.end() )
         return 0;
 
-    if ( netA->GetBoundingBox().Distance( netB->GetBoundingBox() ) > creepageValue )
+    if( boxA->second.Distance( boxB->second ) > creepageValue )
         return 0;
 
     std::shared_ptr<GRAPH_NODE> NetA = aGraph.AddNetElements( aNetCodeA, aLayer, creepageValue );
@@ -251,6 +267,55 @@ void DRC_TEST_PROVIDER_CREEPAGE::CollectNetCodes( std::vector<int>& aVector )
 }
 
 
+void DRC_TEST_PROVIDER_CREEPAGE::collectCandidatePairs( const std::vector<int>& aNetCodes,
+                                                        double aMaxConstraint,
+                                                        std::vector<std::pair<int, int>>& aPairs )
+{
+    // A net bounding box walks all the items of the net, so only compute each one once
+    PACKED_RTREE<int> netIndex;
+
+    for( int netCode : aNetCodes )
+    {
+        NETINFO_ITEM* net = m_board->FindNet( netCode );
+
+        if( !net )
+            continue;
+
+        BOX2I box = net->GetBoundingBox();
+
+        if( box.GetWidth() == 0 && box.GetHeight() == 0 )
+            continue;   // no items
+
+        m_netBoxes[netCode] = box;
+        netIndex.Add( box, netCode );
+    }
+
+    netIndex.Build();
+
+    int margin = KiROUND( aMaxConstraint );
+
+    for( const auto& [netCode, box] : m_netBoxes )
+    {
+        BOX2I searchBox = box;
+        searchBox.Inflate( margin );
+
+        auto visitor =
+                [&]( int aOther )
+                {
+                    if( aOther > netCode && box.Distance( m_netBoxes.at( aOther ) ) <= aMaxConstraint )
+                        aPairs.emplace_back( netCode, aOther );
+
+                    return true;
+                };
+
+        netIndex.Search( searchBox, visitor );
+    }
+
+    // Keep the order of the markers independent of the hash map
+    std::sort( aPairs.begin(), aPairs.end() );
+}
+
+
 void DRC_TEST_PROVIDER_CREEPAGE::CollectBoardEdges( std::vector<BOARD_ITEM*>& aVector )
 {
     if( !m_board )
@@ -335,40 +400,42 @@ int DRC_TEST_PROVIDER_CREEPAGE::testCreepage()
     int  beConnectionsSize = graph.m_connections.size();
     bool prevTestChangedGraph = false;
 
+    // Most net pairs are much further apart than the largest creepage distance: don't evaluate
+    // the rules for them at all
+    std::vector<std::pair<int, int>> candidates;
+    collectCandidatePairs( netcodes, maxConstraint, candidates );
+
     size_t current = 0;
-    size_t total = ( netcodes.size() * ( netcodes.size() - 1 ) ) / 2 * m_board->GetCopperLayerCount();
+    size_t total = candidates.size() * m_board->GetCopperLayerCount();
     LSET layers = m_board->GetLayerSet();
 
-    alg::for_all_pairs( netcodes.begin(), netcodes.end(),
-                        [&]( int aNet1, int aNet2 )
-                        {
-                            if( aNet1 == aNet2 )
-                                return;
-
-                            for( auto it = layers.copper_layers_begin(); it != layers.copper_layers_end(); ++it )
-                            {
-                                PCB_LAYER_ID layer = *it;
+    for( const auto& [net1, net2] : candidates )
+    {
+        for( auto it = layers.copper_layers_begin(); it != layers.copper_layers_end(); ++it )
+        {
+            PCB_LAYER_ID layer = *it;
 
-                                reportProgress( current++, total );
+            if( !reportProgress( current++, total ) )
+                return 1;   // DRC cancelled
 
-                                if ( prevTestChangedGraph )
-                                {
-                                    size_t vectorSize = graph.m_connections.size();
+            if ( prevTestChangedGraph )
+            {
+                size_t vectorSize = graph.m_connections.size();
 
-                                    for( size_t i = beConnectionsSize; i < vectorSize; i++ )
-                                    {
-                                        // We need to remove the connection from its endpoints' lists.
-                                        graph.RemoveConnection( graph.m_connections[i], false );
-                                    }
-                                    graph.m_connections.resize( beConnectionsSize, nullptr );
+                for( size_t i = beConnectionsSize; i < vectorSize; i++ )
+                {
+                    // We need to remove the connection from its endpoints' lists.
+                    graph.RemoveConnection( graph.m_connections[i], false );
+                }
+                graph.m_connections.resize( beConnectionsSize, nullptr );
 
-                                    vectorSize = graph.m_nodes.size();
-                                    graph.m_nodes.resize( beNodeSize, nullptr );
-                                }
+                vectorSize = graph.m_nodes.size();
+                graph.m_nodes.resize( beNodeSize, nullptr );
+            }
 
-                                prevTestChangedGraph = testCreepage( graph, aNet1, aNet2, layer );
-                            }
-                        } );
+            prevTestChangedGraph = testCreepage( graph, net1, net2, layer );
+        }
+    }
 
     return 1;
 }
@@ -56,6 +56,8 @@ public:
 
     virtual const wxString GetName() const override { return wxT( "diff_pair_coupling" ); };
 
+    virtual int GetModifications() const override { return DRC_STATE_FROM_TO_CACHE; }
+
 private:
     BOARD* m_board;
 };
@@ -55,6 +55,9 @@ public:
     virtual bool Run() override;
 
     virtual const wxString GetName() const override { return wxT( "disallow" ); };
+
+    // Sets HOLE_PROXY on the items while testing their holes
+    virtual int GetModifications() const override { return DRC_STATE_ITEM_FLAGS; }
 };
 
 
@@ -51,6 +51,8 @@ public:
 
     virtual const wxString GetName() const override { return wxT( "hole_size" ); };
 
+    virtual bool SupportsIncrementalTests() const override { return true; }
+
 private:
     void checkViaHole( PCB_VIA* via, bool aExceedMicro, bool aExceedStd );
     void checkPadHole( PAD* aPad );
@@ -68,6 +70,9 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
         {
             for( PAD* pad : footprint->Pads() )
             {
+                if( !m_drcEngine->IsInScope( pad ) )
+                    continue;
+
                 if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
                     checkPadHole( pad );
             }
@@ -90,7 +95,7 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
 
         for( PCB_TRACK* track : m_drcEngine->GetBoard()->Tracks() )
         {
-            if( track->Type() == PCB_VIA_T )
+            if( track->Type() == PCB_VIA_T && m_drcEngine->IsInScope( track ) )
             {
                 bool exceedMicro = m_drcEngine->IsErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE );
                 bool exceedStd = m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE );
@@ -61,6 +61,11 @@ public:
     virtual bool Run() override;
 
     virtual const wxString GetName() const override { return wxT( "library_parity" ); };
+
+    virtual int GetDependencies() const override
+    {
+        return DRC_STATE_ALL_SHARED | DRC_STATE_MAIN_THREAD;
+    }
 };
 
 
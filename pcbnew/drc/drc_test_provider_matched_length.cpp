@@ -380,9 +380,6 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
 
         for( const auto& [netCode, netItems] : netMap )
         {
-            std::vector<LENGTH_DELAY_CALCULATION_ITEM> lengthItems;
-            lengthItems.reserve( netItems.size() );
-
             CONNECTION ent;
             ent.items = netItems;
             ent.netcode = netCode;
@@ -396,20 +393,14 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
             ent.fromItem = nullptr;
             ent.toItem = nullptr;
 
-            for( BOARD_CONNECTED_ITEM* item : netItems )
-            {
-                LENGTH_DELAY_CALCULATION_ITEM lengthItem = calc->GetLengthCalculationItem( item );
-
-                if( lengthItem.Type() != LENGTH_DELAY_CALCULATION_ITEM::TYPE::UNKNOWN )
-                    lengthItems.emplace_back( lengthItem );
-            }
-
             constexpr PATH_OPTIMISATIONS opts = {
                 .OptimiseViaLayers = true, .MergeTracks = true, .OptimiseTracesInPads = true, .InferViaInPad = false
             };
-            LENGTH_DELAY_STATS details = calc->CalculateLengthDetails( lengthItems, opts, nullptr, nullptr,
-                                                                       LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
-                                                                       LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL );
+
+            // Cached by the calculator: nets left untouched since the last run are not recomputed
+            LENGTH_DELAY_STATS details = calc->CalculateNetLengthDetails(
+                    netCode, std::vector<const BOARD_CONNECTED_ITEM*>( netItems.begin(), netItems.end() ), opts,
+                    LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL, LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL );
             ent.viaCount = details.NumVias;
             ent.totalVia = details.ViaLength;
             ent.totalViaDelay = details.ViaDelay;
@@ -182,8 +182,10 @@ void DRC_TEST_PROVIDER_SOLDER_MASK::buildRTrees()
 
     if( m_webWidth > 0 )
     {
-        solderMask->GetFill( F_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
-        solderMask->GetFill( B_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
+        solderMask->GetFill( F_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError,
+                                              KiCadParallelFor );
+        solderMask->GetFill( B_Mask )->Deflate( m_webWidth / 2, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError,
+                                              KiCadParallelFor );
     }
 
     solderMask->SetFillFlag( F_Mask, true );
@@ -45,6 +45,8 @@ public:
     virtual bool Run() override;
 
     virtual const wxString GetName() const override { return wxT( "width" ); };
+
+    virtual bool SupportsIncrementalTests() const override { return true; }
 };
 
 
@@ -71,6 +73,9 @@ bool DRC_TEST_PROVIDER_TRACK_WIDTH::Run()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_TRACK_WIDTH ) )
                     return false;
 
+                if( !m_drcEngine->IsInScope( item ) )
+                    return true;
+
                 int      actual;
                 VECTOR2I p0;
 
@@ -45,6 +45,8 @@ public:
     virtual bool Run() override;
 
     virtual const wxString GetName() const override { return wxT( "diameter" ); };
+
+    virtual bool SupportsIncrementalTests() const override { return true; }
 };
 
 
@@ -71,7 +73,7 @@ bool DRC_TEST_PROVIDER_VIA_DIAMETER::Run()
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_VIA_DIAMETER ) )
                     return false;
 
-                if( item->Type() != PCB_VIA_T )
+                if( item->Type() != PCB_VIA_T || !m_drcEngine->IsInScope( item ) )
                     return true;
 
                 PCB_VIA* via = static_cast<PCB_VIA*>( item );
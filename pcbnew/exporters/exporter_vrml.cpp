@@ -544,6 +544,9 @@ void EXPORTER_PCB_VRML::write_triangle_bag( std::ostream& aOut_file, const VRML_
 
 void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile )
 {
+    // Each layer is released as soon as it is written, so only one tesselated layer is held
+    // in memory at a time.
+
     // VRML_LAYER board;
     m_3D_board.Tesselate( &m_holes );
     double brdz = m_brd_thickness / 2.0
@@ -559,6 +562,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
         create_vrml_shell( m_OutputPCB, VRML_COLOR_PCB, &m_3D_board, brdz, -brdz );
     }
 
+    m_3D_board.Clear();
+
     // VRML_LAYER m_top_copper;
     m_top_copper.Tesselate( &m_holes );
 
@@ -573,6 +578,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            GetLayerZ( F_Cu ), true );
     }
 
+    m_top_copper.Clear();
+
     // VRML_LAYER m_top_paste;
     m_top_paste.Tesselate( &m_holes );
 
@@ -592,6 +599,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            true );
     }
 
+    m_top_paste.Clear();
+
     // VRML_LAYER m_top_soldermask;
     m_top_soldermask.Tesselate( &m_holes );
 
@@ -611,6 +620,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            true );
     }
 
+    m_top_soldermask.Clear();
+
     // VRML_LAYER m_bot_copper;
     m_bot_copper.Tesselate( &m_holes );
 
@@ -625,6 +636,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            GetLayerZ( B_Cu ), false );
     }
 
+    m_bot_copper.Clear();
+
     // VRML_LAYER m_bot_paste;
     m_bot_paste.Tesselate( &m_holes );
 
@@ -644,6 +657,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            false );
     }
 
+    m_bot_paste.Clear();
+
     // VRML_LAYER m_bot_mask:
     m_bot_soldermask.Tesselate( &m_holes );
 
@@ -663,6 +678,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            false );
     }
 
+    m_bot_soldermask.Clear();
+
     // VRML_LAYER PTH;
     m_plated_holes.Tesselate( nullptr, true );
 
@@ -684,6 +701,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            m_BoardToVrmlScale );
     }
 
+    m_plated_holes.Clear();
+
     // VRML_LAYER m_top_silk;
     m_top_silk.Tesselate( &m_holes );
 
@@ -698,6 +717,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            GetLayerZ( F_SilkS ), true );
     }
 
+    m_top_silk.Clear();
+
     // VRML_LAYER m_bot_silk;
     m_bot_silk.Tesselate( &m_holes );
 
@@ -712,6 +733,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            GetLayerZ( B_SilkS ), false );
     }
 
+    m_bot_silk.Clear();
+
     if( !m_UseInlineModelsInBrdfile )
         S3D::WriteVRML( aFileName, true, m_OutputPCB.GetRawPtr(), true, true );
 }
@@ -1118,14 +1141,19 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             dstFile.SetName( srcFile.GetName() );
             dstFile.SetExt( wxT( "wrl" ) );
 
+            // A model already written for a previous footprint is neither copied again nor
+            // inlined again: its first Inline node is DEFined and the others USE it.
+            auto modelDef = m_linkedModelDefs.find( dstFile.GetFullPath() );
+            bool reuseDef = m_ReuseDef && modelDef != m_linkedModelDefs.end();
+
             // copy the file if necessary
             wxDateTime srcModTime = srcFile.GetModificationTime();
             wxDateTime destModTime = wxDateTime();
 
-            if( dstFile.FileExists() )
+            if( !reuseDef && dstFile.FileExists() )
                 destModTime = dstFile.GetModificationTime();
 
-            if( srcModTime != destModTime )
+            if( !reuseDef && srcModTime != destModTime )
             {
                 wxString fileExt = srcFile.GetExt();
                 fileExt.LowerCase();
@@ -1193,7 +1221,27 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             (*aOutputFile) << sM->m_Scale.y << " ";
             (*aOutputFile) << sM->m_Scale.z << "\n";
 
-            (*aOutputFile) << "  children [\n    Inline {\n      url \"";
+            if( reuseDef )
+            {
+                (*aOutputFile) << "  children [ USE " << modelDef->second << " ]\n";
+                (*aOutputFile) << "  }\n";
+
+                aOutputFile->precision( old_precision );
+                ++sM;
+                continue;
+            }
+
+            (*aOutputFile) << "  children [\n    ";
+
+            if( m_ReuseDef )
+            {
+                std::string defName = "MODEL_" + std::to_string( m_linkedModelDefs.size() );
+
+                m_linkedModelDefs[dstFile.GetFullPath()] = defName;
+                (*aOutputFile) << "DEF " << defName << " ";
+            }
+
+            (*aOutputFile) << "Inline {\n      url \"";
 
             if( m_UseRelPathIn3DModelFilename )
             {
@@ -247,6 +247,10 @@ private:
     // true to reuse component definitions
     bool     m_ReuseDef;
 
+    // DEF names of the model files already inlined, by destination file path
+    // used only if m_UseInlineModelsInBrdfile = true
+    std::map<wxString, std::string> m_linkedModelDefs;
+
     // true if unspecified components should be included
     bool     m_includeUnspecified;
 
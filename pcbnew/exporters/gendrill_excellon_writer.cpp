@@ -457,9 +457,11 @@ void EXCELLON_WRITER::SetFormat( bool aMetric, ZEROS_FMT aZerosFmt, int aLeftDig
 void EXCELLON_WRITER::writeCoordinates( char* aLine, size_t aLineSize, double aCoordX,
                                         double aCoordY )
 {
-    wxString xs, ys;
-    int      xpad = m_precision.m_Lhs + m_precision.m_Rhs;
-    int      ypad = xpad;
+    // This is called for every hole, so format with fmt into std::string (which stays in its
+    // small string buffer for coordinates) rather than through wxString
+    std::string xs, ys;
+    int         xpad = m_precision.m_Lhs + m_precision.m_Rhs;
+    int         ypad = xpad;
 
     // if units are mm, the resolution is 0.001 mm (3 digits in mantissa)
     // if units are inches, the resolution is 0.1 mil (4 digits in mantissa)
@@ -480,19 +482,19 @@ void EXCELLON_WRITER::writeCoordinates( char* aLine, size_t aLineSize, double aC
         ys = fmt::format( "{:.{}f}", aCoordY, m_mantissaLenght );
 
         //Remove useless trailing 0
-        while( xs.Last() == '0' )
-            xs.RemoveLast();
+        while( xs.back() == '0' )
+            xs.pop_back();
 
-        if( xs.Last() == '.' )      // however keep a trailing 0 after the floating point separator
-            xs << '0';
+        if( xs.back() == '.' )      // however keep a trailing 0 after the floating point separator
+            xs += '0';
 
-        while( ys.Last() == '0' )
-            ys.RemoveLast();
+        while( ys.back() == '0' )
+            ys.pop_back();
 
-        if( ys.Last() == '.' )
-            ys << '0';
+        if( ys.back() == '.' )
+            ys += '0';
 
-        std::snprintf( aLine, aLineSize, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
+        std::snprintf( aLine, aLineSize, "X%sY%s\n", xs.c_str(), ys.c_str() );
         break;
 
     case SUPPRESS_LEADING:
@@ -518,20 +520,16 @@ void EXCELLON_WRITER::writeCoordinates( char* aLine, size_t aLineSize, double aC
         if( aCoordY < 0 )
             ypad++;
 
-        xs.Printf( wxT( "%0*d" ), xpad, KiROUND( aCoordX ) );
-        ys.Printf( wxT( "%0*d" ), ypad, KiROUND( aCoordY ) );
+        xs = fmt::format( "{:0{}d}", KiROUND( aCoordX ), xpad );
+        ys = fmt::format( "{:0{}d}", KiROUND( aCoordY ), ypad );
 
-        size_t j = xs.Len() - 1;
+        while( xs.size() > 1 && xs.back() == '0' )
+            xs.pop_back();
 
-        while( xs[j] == '0' && j )
-            xs.Truncate( j-- );
+        while( ys.size() > 1 && ys.back() == '0' )
+            ys.pop_back();
 
-        j = ys.Len() - 1;
-
-        while( ys[j] == '0' && j )
-            ys.Truncate( j-- );
-
-        std::snprintf( aLine, aLineSize, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
+        std::snprintf( aLine, aLineSize, "X%sY%s\n", xs.c_str(), ys.c_str() );
         break;
     }
 
@@ -547,9 +545,9 @@ void EXCELLON_WRITER::writeCoordinates( char* aLine, size_t aLineSize, double aC
         if( aCoordY < 0 )
             ypad++;
 
-        xs.Printf( wxT( "%0*d" ), xpad, KiROUND( aCoordX ) );
-        ys.Printf( wxT( "%0*d" ), ypad, KiROUND( aCoordY ) );
-        std::snprintf( aLine, aLineSize, "X%sY%s\n", TO_UTF8( xs ), TO_UTF8( ys ) );
+        xs = fmt::format( "{:0{}d}", KiROUND( aCoordX ), xpad );
+        ys = fmt::format( "{:0{}d}", KiROUND( aCoordY ), ypad );
+        std::snprintf( aLine, aLineSize, "X%sY%s\n", xs.c_str(), ys.c_str() );
         break;
     }
 }
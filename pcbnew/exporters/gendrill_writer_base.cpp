@@ -39,6 +39,7 @@
 #include <pcb_painter.h>
 #include <pcb_shape.h>
 #include <fmt.h>
+#include <math/hilbert.h>
 #include <wx/ffile.h>
 #include <reporter.h>
 
@@ -52,9 +53,8 @@
  * plated then not plated
  * then by increasing diameter value
  * then by attribute type (vias, pad, mechanical)
- * then by X then Y position
  */
-static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
+static bool cmpHoleTool( const HOLE_INFO& a, const HOLE_INFO& b )
 {
     if( a.m_Hole_NotPlated != b.m_Hole_NotPlated )
         return b.m_Hole_NotPlated;
@@ -64,16 +64,68 @@ static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 
     // At this point (same diameter, same plated type), group by attribute
     // type (via, pad, mechanical, although currently only not plated pads are mechanical)
-    if( a.m_HoleAttribute != b.m_HoleAttribute )
-        return a.m_HoleAttribute < b.m_HoleAttribute;
+    return a.m_HoleAttribute < b.m_HoleAttribute;
+}
+
+
+/* Sort the hole list by tool (see cmpHoleTool), then, for each tool, along a Hilbert curve
+ * through the hole positions so consecutive holes are close to each other on the board.
+ * This gives much shorter drill paths than sorting by X then Y position, and still makes
+ * the file reproducible as long as holes have not changed, even if the data order has changed.
+ */
+static void sortHoles( std::vector<HOLE_INFO>& aHoles )
+{
+    if( aHoles.size() < 2 )
+        return;
+
+    int64_t minX = aHoles[0].m_Hole_Pos.x;
+    int64_t minY = aHoles[0].m_Hole_Pos.y;
+    int64_t maxX = minX;
+    int64_t maxY = minY;
+
+    for( const HOLE_INFO& hole : aHoles )
+    {
+        minX = std::min<int64_t>( minX, hole.m_Hole_Pos.x );
+        minY = std::min<int64_t>( minY, hole.m_Hole_Pos.y );
+        maxX = std::max<int64_t>( maxX, hole.m_Hole_Pos.x );
+        maxY = std::max<int64_t>( maxY, hole.m_Hole_Pos.y );
+    }
+
+    // Map the positions onto a 65536 x 65536 grid over the holes extent
+    double scaleX = maxX > minX ? 65535.0 / ( maxX - minX ) : 0.0;
+    double scaleY = maxY > minY ? 65535.0 / ( maxY - minY ) : 0.0;
+
+    std::vector<std::pair<uint32_t, HOLE_INFO>> keyed;
+    keyed.reserve( aHoles.size() );
+
+    for( HOLE_INFO& hole : aHoles )
+    {
+        uint32_t x = static_cast<uint32_t>( ( hole.m_Hole_Pos.x - minX ) * scaleX );
+        uint32_t y = static_cast<uint32_t>( ( hole.m_Hole_Pos.y - minY ) * scaleY );
+
+        keyed.emplace_back( HilbertIndex( x, y ), std::move( hole ) );
+    }
+
+    std::sort( keyed.begin(), keyed.end(),
+               []( const auto& a, const auto& b )
+               {
+                   if( cmpHoleTool( a.second, b.second ) )
+                       return true;
+
+                   if( cmpHoleTool( b.second, a.second ) )
+                       return false;
+
+                   if( a.first != b.first )
+                       return a.first < b.first;
+
+                   if( a.second.m_Hole_Pos.x != b.second.m_Hole_Pos.x )
+                       return a.second.m_Hole_Pos.x < b.second.m_Hole_Pos.x;
 
-    // At this point (same diameter, same type), sort by X then Y position.
-    // This is optimal for drilling and make the file reproducible as long as holes
-    // have not changed, even if the data order has changed.
-    if( a.m_Hole_Pos.x != b.m_Hole_Pos.x )
-        return a.m_Hole_Pos.x < b.m_Hole_Pos.x;
+                   return a.second.m_Hole_Pos.y < b.second.m_Hole_Pos.y;
+               } );
 
-    return a.m_Hole_Pos.y < b.m_Hole_Pos.y;
+    for( size_t ii = 0; ii < aHoles.size(); ++ii )
+        aHoles[ii] = std::move( keyed[ii].second );
 }
 
 
@@ -292,7 +344,7 @@ void GENDRILL_WRITER_BASE::buildHolesList( const DRILL_SPAN& aSpan, bool aGenera
     }
 
     // Sort holes per increasing diameter value (and for each dimater, by position)
-    sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), cmpHoleSorting );
+    sortHoles( m_holeListBuffer );
 
     // build the tool list
     int last_hole = -1;     // Set to not initialized (this is a value not used
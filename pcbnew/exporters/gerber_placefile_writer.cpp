@@ -192,7 +192,7 @@ int PLACEFILE_GERBER_WRITER::CreatePlaceFile( const wxString& aFullFilename, PCB
         bool useFpPadsBbox = true;
         bool onBack = aLayer == B_Cu;
 
-        footprint->BuildCourtyardCaches();
+        footprint->EnsureCourtyardCaches();
 
         int checkFlag = onBack ? MALFORMED_B_COURTYARD : MALFORMED_F_COURTYARD;
 
@@ -47,6 +47,7 @@
 #include <filename_resolver.h>
 #include <trace_helpers.h>
 #include <project_pcb.h>
+#include <thread_pool.h>
 #include <wildcards_and_files_ext.h>
 
 #include <Message.hxx>                // OpenCascade messenger
@@ -1142,49 +1143,93 @@ bool EXPORTER_STEP::buildBoard3DShapes()
     if( m_params.m_ExportSoldermask && !m_params.m_ExportZones )
         buildZones3DShape( origin, true );
 
-    for( PCB_LAYER_ID pcblayer : m_layersToExport.Seq() )
+    // Each mask layer, and each net of the other layers, is an independent job.  The polygons
+    // are cleaned up and their solids built in parallel, then added to the model in job order
+    // so the output does not depend on the scheduling.
+    struct LAYER_JOB
     {
-        SHAPE_POLY_SET holes = m_poly_holes[pcblayer];
-        holes.Simplify();
-
-        if( pcblayer == F_Mask || pcblayer == B_Mask )
-        {
-            // Mask layer is negative
-            SHAPE_POLY_SET mask = pcbOutlinesNoArcs;
-
-            for( auto& [netname, poly] : m_poly_shapes[pcblayer] )
-            {
-                poly.Simplify();
+        PCB_LAYER_ID                        m_layer;
+        size_t                              m_layerIdx;  // Index in layerHoles
+        wxString                            m_netname;
+        SHAPE_POLY_SET*                     m_poly;      // Net polygons, except on masks
+        std::map<wxString, SHAPE_POLY_SET>* m_maskNets;  // All the openings of a mask
+        std::vector<TopoDS_Shape>           m_shapes;
+    };
 
-                poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
-                poly.Simplify();
+    thread_pool&                tp = GetKiCadThreadPool();
+    LSEQ                        layers = m_layersToExport.Seq();
+    std::vector<SHAPE_POLY_SET> layerHoles( layers.size() );
+    std::vector<LAYER_JOB>      jobs;
 
-                mask.BooleanSubtract( poly );
-            }
+    for( size_t ii = 0; ii < layers.size(); ++ii )
+    {
+        PCB_LAYER_ID pcblayer = layers[ii];
 
-            mask.BooleanSubtract( holes );
+        layerHoles[ii] = m_poly_holes[pcblayer];
 
-            m_pcbModel->AddPolygonShapes( &mask, pcblayer, origin, wxEmptyString );
+        if( pcblayer == F_Mask || pcblayer == B_Mask )
+        {
+            jobs.push_back( { pcblayer, ii, wxEmptyString, nullptr, &m_poly_shapes[pcblayer], {} } );
         }
         else
         {
             for( auto& [netname, poly] : m_poly_shapes[pcblayer] )
+                jobs.push_back( { pcblayer, ii, netname, &poly, nullptr, {} } );
+        }
+    }
+
+    tp.submit_loop( 0, layerHoles.size(),
+            [&]( const int ii )
             {
-                poly.Simplify();
+                layerHoles[ii].Simplify();
+            } ).wait();
 
-                poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
-                poly.Simplify();
+    tp.submit_loop( 0, jobs.size(),
+            [&]( const int ii )
+            {
+                LAYER_JOB&            job = jobs[ii];
+                const SHAPE_POLY_SET& holes = layerHoles[job.m_layerIdx];
 
-                // Subtract holes
-                poly.BooleanSubtract( holes );
+                if( job.m_maskNets )
+                {
+                    // Mask layer is negative
+                    SHAPE_POLY_SET mask = pcbOutlinesNoArcs;
 
-                // Clip to board outline
-                poly.BooleanIntersection( pcbOutlinesNoArcs );
+                    for( auto& [netname, poly] : *job.m_maskNets )
+                    {
+                        poly.Simplify();
 
-                m_pcbModel->AddPolygonShapes( &poly, pcblayer, origin, netname );
-            }
-        }
-    }
+                        poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
+                        poly.Simplify();
+
+                        mask.BooleanSubtract( poly );
+                    }
+
+                    mask.BooleanSubtract( holes );
+
+                    m_pcbModel->MakePolygonShapes( job.m_shapes, &mask, job.m_layer, origin );
+                }
+                else
+                {
+                    SHAPE_POLY_SET& poly = *job.m_poly;
+
+                    poly.Simplify();
+
+                    poly.SimplifyOutlines( pcbIUScale.mmToIU( 0.003 ) );
+                    poly.Simplify();
+
+                    // Subtract holes
+                    poly.BooleanSubtract( holes );
+
+                    // Clip to board outline
+                    poly.BooleanIntersection( pcbOutlinesNoArcs );
+
+                    m_pcbModel->MakePolygonShapes( job.m_shapes, &poly, job.m_layer, origin );
+                }
+            } ).wait();
+
+    for( const LAYER_JOB& job : jobs )
+        m_pcbModel->AddLayerShapes( job.m_shapes, job.m_layer, job.m_netname );
 
     m_reporter->Report( wxT( "Create PCB solid model.\n" ), RPT_SEVERITY_DEBUG );
 
@@ -26,6 +26,8 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -134,6 +136,9 @@
 #include <gp_Ax2.hxx>
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <TopLoc_Location.hxx>
 #include <GC_MakeArcOfCircle.hxx>
 #include <GC_MakeCircle.hxx>
 
@@ -781,6 +786,86 @@ static Standard_Boolean prefixNames( const TDF_Label&                  aLabel,
 }
 
 
+/**
+ * Documents of the model files read by previous exports.
+ *
+ * A jobset exporting several formats, or the same board exported again, reads and translates
+ * each model file only once.  A cached document is reused while its file keeps the same
+ * modification time and size; the entries not used by an export are dropped when it finishes,
+ * so the cache never holds more than the models of the last board.
+ */
+struct MODEL_DOC_CACHE_ENTRY
+{
+    Handle( TDocStd_Document ) m_doc;
+    wxDateTime                 m_modTime;
+    wxULongLong                m_size;
+    bool                       m_used = false;
+};
+
+static std::mutex                                   s_modelDocCacheMutex;
+static std::map<std::string, MODEL_DOC_CACHE_ENTRY> s_modelDocCache;
+
+
+static Handle( TDocStd_Document ) findCachedModelDoc( const std::string& aFileNameUTF8 )
+{
+    std::lock_guard<std::mutex> lock( s_modelDocCacheMutex );
+
+    auto it = s_modelDocCache.find( aFileNameUTF8 );
+
+    if( it == s_modelDocCache.end() )
+        return Handle( TDocStd_Document )();
+
+    wxFileName fn( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
+
+    if( !fn.FileExists() || fn.GetModificationTime() != it->second.m_modTime
+            || fn.GetSize() != it->second.m_size )
+    {
+        return Handle( TDocStd_Document )();
+    }
+
+    it->second.m_used = true;
+    return it->second.m_doc;
+}
+
+
+static void cacheModelDoc( const std::string& aFileNameUTF8, Handle( TDocStd_Document ) aDoc )
+{
+    wxFileName fn( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
+
+    std::lock_guard<std::mutex> lock( s_modelDocCacheMutex );
+
+    MODEL_DOC_CACHE_ENTRY& entry = s_modelDocCache[aFileNameUTF8];
+
+    if( !entry.m_doc.IsNull() && entry.m_doc != aDoc && entry.m_doc->CanClose() == CDM_CCS_OK )
+        entry.m_doc->Close();
+
+    entry.m_doc = aDoc;
+    entry.m_modTime = fn.GetModificationTime();
+    entry.m_size = fn.GetSize();
+    entry.m_used = true;
+}
+
+
+static void pruneModelDocCache()
+{
+    std::lock_guard<std::mutex> lock( s_modelDocCacheMutex );
+
+    for( auto it = s_modelDocCache.begin(); it != s_modelDocCache.end(); )
+    {
+        if( it->second.m_used )
+        {
+            it->second.m_used = false;
+            ++it;
+            continue;
+        }
+
+        if( it->second.m_doc->CanClose() == CDM_CCS_OK )
+            it->second.m_doc->Close();
+
+        it = s_modelDocCache.erase( it );
+    }
+}
+
 STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName, REPORTER* aReporter ) :
         m_reporter( aReporter )
 {
@@ -806,6 +891,8 @@ STEP_PCB_MODEL::~STEP_PCB_MODEL()
 {
     if( m_doc->CanClose() == CDM_CCS_OK )
         m_doc->Close();
+
+    pruneModelDocCache();
 }
 
 
@@ -850,11 +937,17 @@ bool STEP_PCB_MODEL::AddPadShape( const PAD* aPad, const VECTOR2D& aOrigin, bool
         {
             polySet.ClearArcs();
             polySet.BooleanIntersection( *aClipPolygon );
-        }
 
-        success &= MakeShapes( padShapes, polySet, m_simplifyShapes, thickness, Zpos, aOrigin );
+            success &= MakeShapes( padShapes, polySet, m_simplifyShapes, thickness, Zpos, aOrigin );
+        }
+        else
+        {
+            success &= makeShapesAt( padShapes, polySet, aPad->GetPosition(), thickness, Zpos,
+                                     aOrigin );
+        }
 
-        if( testShape.IsNull() )
+        // The pad surface is only needed for the pad face groups
+        if( !aVia && m_extraPadThickness && ( pcb_layer == F_Cu || pcb_layer == B_Cu ) )
         {
             std::vector<TopoDS_Shape> testShapes;
 
@@ -1635,6 +1728,19 @@ void STEP_PCB_MODEL::getBoardBodyZPlacement( double& aZPos, double& aThickness )
 
 bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
                                        const VECTOR2D& aOrigin, const wxString& aNetname )
+{
+    std::vector<TopoDS_Shape> shapes;
+    bool success = MakePolygonShapes( shapes, aPolyShapes, aLayer, aOrigin );
+
+    AddLayerShapes( shapes, aLayer, aNetname );
+
+    return success;
+}
+
+
+bool STEP_PCB_MODEL::MakePolygonShapes( std::vector<TopoDS_Shape>& aShapes,
+                                        const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
+                                        const VECTOR2D& aOrigin )
 {
     bool success = true;
 
@@ -1647,6 +1753,26 @@ bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LA
     double z_pos, thickness;
     getLayerZPlacement( aLayer, z_pos, thickness );
 
+    if( !MakeShapes( aShapes, *aPolyShapes, m_simplifyShapes, thickness, z_pos, aOrigin ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Could not add shape (%d points) to copper layer %s." ),
+                                              aPolyShapes->FullPointCount(),
+                                              LayerName( aLayer ) ),
+                            RPT_SEVERITY_ERROR );
+
+        success = false;
+    }
+
+    return success;
+}
+
+
+void STEP_PCB_MODEL::AddLayerShapes( const std::vector<TopoDS_Shape>& aShapes, PCB_LAYER_ID aLayer,
+                                     const wxString& aNetname )
+{
+    if( aShapes.empty() )
+        return;
+
     std::vector<TopoDS_Shape>* targetVec = nullptr;
 
     if( IsCopperLayer( aLayer ) )
@@ -1660,17 +1786,7 @@ bool STEP_PCB_MODEL::AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LA
     else
         targetVec = &m_board_back_mask;
 
-    if( !MakeShapes( *targetVec, *aPolyShapes, m_simplifyShapes, thickness, z_pos, aOrigin ) )
-    {
-        m_reporter->Report( wxString::Format( _( "Could not add shape (%d points) to copper layer %s." ),
-                                              aPolyShapes->FullPointCount(),
-                                              LayerName( aLayer ) ),
-                            RPT_SEVERITY_ERROR );
-
-        success = false;
-    }
-
-    return success;
+    targetVec->insert( targetVec->end(), aShapes.begin(), aShapes.end() );
 }
 
 
@@ -1796,9 +1912,50 @@ bool STEP_PCB_MODEL::isBoardOutlineValid()
 }
 
 
+/**
+ * @return the translation placing a shape built around the origin at \a aPosition.
+ */
+static TopLoc_Location locationAt( const VECTOR2D& aPosition, const VECTOR2D& aOrigin )
+{
+    gp_Trsf trsf;
+    trsf.SetTranslation( gp_Vec( pcbIUScale.IUTomm( aPosition.x - aOrigin.x ),
+                                 -pcbIUScale.IUTomm( aPosition.y - aOrigin.y ), 0.0 ) );
+
+    return TopLoc_Location( trsf );
+}
+
+
 bool STEP_PCB_MODEL::MakeShapeAsThickSegment( TopoDS_Shape& aShape, const VECTOR2D& aStartPoint,
                                               const VECTOR2D& aEndPoint, double aWidth, double aThickness,
                                               double aZposition, const VECTOR2D& aOrigin )
+{
+    // Holes and barrels repeat the same few drill sizes, so each segment shape is built once
+    // at the origin and shared by all its copies through a location
+    const VECTOR2D delta = aEndPoint - aStartPoint;
+    const auto     key = std::make_tuple( delta.x, delta.y, aWidth, aThickness, aZposition );
+    auto           it = m_thickSegmentShapes.find( key );
+
+    if( it == m_thickSegmentShapes.end() )
+    {
+        TopoDS_Shape shape;
+
+        if( !makeThickSegment( shape, VECTOR2D( 0.0, 0.0 ), delta, aWidth, aThickness, aZposition,
+                               VECTOR2D( 0.0, 0.0 ) ) )
+        {
+            return false;
+        }
+
+        it = m_thickSegmentShapes.emplace( key, shape ).first;
+    }
+
+    aShape = it->second.Moved( locationAt( aStartPoint, aOrigin ) );
+    return true;
+}
+
+
+bool STEP_PCB_MODEL::makeThickSegment( TopoDS_Shape& aShape, const VECTOR2D& aStartPoint,
+                                       const VECTOR2D& aEndPoint, double aWidth, double aThickness,
+                                       double aZposition, const VECTOR2D& aOrigin )
 {
     // make a wide segment from 2 lines and 2 180 deg arcs
     // We need 6 points (3 per arcs)
@@ -2333,6 +2490,59 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 }
 
 
+bool STEP_PCB_MODEL::makeShapesAt( std::vector<TopoDS_Shape>& aShapes,
+                                   const SHAPE_POLY_SET& aPolySet, const VECTOR2I& aPosition,
+                                   double aThickness, double aZposition, const VECTOR2D& aOrigin )
+{
+    SHAPE_POLY_SET relativePoly = aPolySet;
+    relativePoly.Move( -aPosition );
+
+    // The key is the exact geometry relative to the position, so only truly identical shapes
+    // are shared
+    std::vector<int> outline;
+
+    for( const SHAPE_POLY_SET::POLYGON& polygon : relativePoly.CPolygons() )
+    {
+        outline.push_back( static_cast<int>( polygon.size() ) );
+
+        for( const SHAPE_LINE_CHAIN& chain : polygon )
+        {
+            outline.push_back( chain.PointCount() );
+
+            for( const VECTOR2I& pt : chain.CPoints() )
+            {
+                outline.push_back( pt.x );
+                outline.push_back( pt.y );
+            }
+        }
+    }
+
+    const TopLoc_Location location = locationAt( aPosition, aOrigin );
+    auto                  key = std::make_tuple( std::move( outline ), aThickness, aZposition );
+    auto                  it = m_padShapes.find( key );
+
+    if( it == m_padShapes.end() )
+    {
+        std::vector<TopoDS_Shape> shapes;
+        bool success = MakeShapes( shapes, relativePoly, m_simplifyShapes, aThickness, aZposition,
+                                   VECTOR2D( 0.0, 0.0 ) );
+
+        for( const TopoDS_Shape& shape : shapes )
+            aShapes.push_back( shape.Moved( location ) );
+
+        if( success )
+            m_padShapes.emplace( std::move( key ), std::move( shapes ) );
+
+        return success;
+    }
+
+    for( const TopoDS_Shape& shape : it->second )
+        aShapes.push_back( shape.Moved( location ) );
+
+    return true;
+}
+
+
 // These colors are based on 3D viewer's colors and are different to "gbrjobColors"
 static std::vector<FAB_LAYER_COLOR> s_soldermaskColors = {
     { NotSpecifiedPrm(), wxColor( 20, 51, 36 ) },        // Not specified, not in .gbrjob file
@@ -3230,8 +3440,12 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, const VECT
 
     aLabel.Nullify();
 
-    Handle( TDocStd_Document )  doc;
-    m_app->NewDocument( "MDTV-XCAF", doc );
+    // The document read for this file by a previous export, if it is still up to date
+    Handle( TDocStd_Document ) doc = findCachedModelDoc( aFileNameUTF8 );
+    bool                       cached = !doc.IsNull();
+
+    if( !cached )
+        m_app->NewDocument( "MDTV-XCAF", doc );
 
     wxString            fileName( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
     MODEL3D_FORMAT_TYPE modelFmt = fileType( aFileNameUTF8.c_str() );
@@ -3243,7 +3457,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, const VECT
     switch( modelFmt )
     {
     case FMT_IGES:
-        if( !readIGES( doc, aFileNameUTF8.c_str() ) )
+        if( !cached && !readIGES( doc, aFileNameUTF8.c_str() ) )
         {
             m_reporter->Report( wxString::Format( wxT( "readIGES() failed on filename '%s'." ),
                                                   fileName ),
@@ -3254,7 +3468,7 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, const VECT
         break;
 
     case FMT_STEP:
-        if( !readSTEP( doc, aFileNameUTF8.c_str() ) )
+        if( !cached && !readSTEP( doc, aFileNameUTF8.c_str() ) )
         {
             m_reporter->Report( wxString::Format( wxT( "readSTEP() failed on filename '%s'." ),
                                                   fileName ),
@@ -3412,18 +3626,21 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, const VECT
             || m_outFmt == OUTPUT_FORMAT::FMT_OUT_PLY || m_outFmt == OUTPUT_FORMAT::FMT_OUT_U3D
             || m_outFmt == OUTPUT_FORMAT::FMT_OUT_PDF )
         {
-            if( readVRML( doc, aFileNameUTF8.c_str() ) )
+            // A cached document already has its names prefixed
+            if( !cached )
             {
+                if( !readVRML( doc, aFileNameUTF8.c_str() ) )
+                {
+                    m_reporter->Report( wxString::Format( wxT( "readVRML() failed on filename '%s'." ),
+                                                          fileName ),
+                                        RPT_SEVERITY_ERROR );
+                    return false;
+                }
+
                 Handle( XCAFDoc_ShapeTool ) shapeTool = XCAFDoc_DocumentTool::ShapeTool( doc->Main() );
 
                 prefixNames( shapeTool->Label(), partname );
             }
-            else
-            {
-                m_reporter->Report( wxString::Format( wxT( "readVRML() failed on filename '%s'." ), fileName ),
-                                    RPT_SEVERITY_ERROR );
-                return false;
-            }
         }
         else
         {
@@ -3444,6 +3661,9 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, const VECT
         return false;
     }
 
+    if( !cached )
+        cacheModelDoc( aFileNameUTF8, doc );
+
     aLabel = transferModel( doc, m_doc, aScale );
 
     if( aLabel.IsNull() )
@@ -28,6 +28,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -184,6 +185,17 @@ public:
     bool AddPolygonShapes( const SHAPE_POLY_SET* aPolyShapes, PCB_LAYER_ID aLayer,
                            const VECTOR2D& aOrigin, const wxString& aNetname );
 
+    /**
+     * Build the shapes of a set of polygons on \a aLayer without adding them to the model.
+     * This does not modify the model, so several layers can be built in parallel.
+     */
+    bool MakePolygonShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE_POLY_SET* aPolyShapes,
+                            PCB_LAYER_ID aLayer, const VECTOR2D& aOrigin );
+
+    // add shapes built by MakePolygonShapes() to the model
+    void AddLayerShapes( const std::vector<TopoDS_Shape>& aShapes, PCB_LAYER_ID aLayer,
+                         const wxString& aNetname );
+
     // add a component at the given position and orientation
     bool AddComponent( const std::string& aFileName, const std::string& aRefDes, bool aBottom,
                        const VECTOR2D& aPosition, double aRotation, const VECTOR3D& aOffset,
@@ -299,6 +311,19 @@ private:
 
     void getBoardBodyZPlacement( double& aZPos, double& aThickness );
 
+    bool makeThickSegment( TopoDS_Shape& aShape, const VECTOR2D& aStartPoint,
+                           const VECTOR2D& aEndPoint, double aWidth, double aThickness,
+                           double aZposition, const VECTOR2D& aOrigin );
+
+    /**
+     * Same as MakeShapes(), but shares the shapes between identical polygon sets placed at
+     * different positions.  The shapes are built once relative to \a aPosition and each copy
+     * is a located instance of them.
+     */
+    bool makeShapesAt( std::vector<TopoDS_Shape>& aShapes, const SHAPE_POLY_SET& aPolySet,
+                       const VECTOR2I& aPosition, double aThickness, double aZposition,
+                       const VECTOR2D& aOrigin );
+
     /**
      * Load a 3D model data.
      *
@@ -385,6 +410,11 @@ private:
     // Data for pads. Key example: Pad_F_U2_1_GND
     std::map<wxString, std::vector<std::pair<gp_Pnt, TopoDS_Shape>>> m_pad_points;
 
+    // Shapes built around the origin, shared by identical pads and holes.  Keys are the
+    // relative geometry and the Z placement.
+    std::map<std::tuple<double, double, double, double, double>, TopoDS_Shape> m_thickSegmentShapes;
+    std::map<std::tuple<std::vector<int>, double, double>, std::vector<TopoDS_Shape>> m_padShapes;
+
     /// Name of the PCB, which will most likely be the file name of the path.
     wxString m_pcbName;
 
@@ -48,6 +48,8 @@
 #include <geometry/shape_segment.h>
 #include <geometry/shape_simple.h>
 #include <geometry/geometry_utils.h>
+#include <hash.h>
+#include <hash_eda.h>
 #include <i18n_utility.h>
 #include <lset.h>
 #include <macros.h>
@@ -64,6 +66,7 @@
 #include <pcb_barcode.h>
 #include <refdes_utils.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <view/view.h>
 #include <zone.h>
 
@@ -814,6 +817,9 @@ FOOTPRINT& FOOTPRINT::operator=( FOOTPRINT&& aOther )
     m_cachedHull                     = aOther.m_cachedHull;
     m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp;
 
+    // The courtyard caches are not copied
+    m_courtyard_cache_valid          = false;
+
     m_clearance                      = aOther.m_clearance;
     m_solderMaskMargin               = aOther.m_solderMaskMargin;
     m_solderPasteMargin              = aOther.m_solderPasteMargin;
@@ -941,6 +947,9 @@ FOOTPRINT& FOOTPRINT::operator=( const FOOTPRINT& aOther )
     m_cachedHull                     = aOther.m_cachedHull;
     m_hullCacheTimeStamp             = aOther.m_hullCacheTimeStamp;
 
+    // The courtyard caches are not copied
+    m_courtyard_cache_valid          = false;
+
     m_clearance                      = aOther.m_clearance;
     m_solderMaskMargin               = aOther.m_solderMaskMargin;
     m_solderPasteMargin              = aOther.m_solderPasteMargin;
@@ -1077,6 +1086,7 @@ void FOOTPRINT::InvalidateGeometryCaches()
 
     m_courtyard_cache_back_hash.Clear();
     m_courtyard_cache_front_hash.Clear();
+    m_courtyard_cache_valid = false;
 }
 
 
@@ -2886,6 +2896,7 @@ void FOOTPRINT::SetPosition( const VECTOR2I& aPos )
     m_courtyard_cache_back_hash = m_courtyard_cache_back.GetHash();
     m_courtyard_cache_front.Move( delta );
     m_courtyard_cache_front_hash = m_courtyard_cache_front.GetHash();
+    m_courtyard_cache_pos = m_pos;
 }
 
 
@@ -3461,12 +3472,80 @@ const SHAPE_POLY_SET& FOOTPRINT::GetCachedCourtyard( PCB_LAYER_ID aLayer ) const
 }
 
 
+/**
+ * Hash the courtyard graphics of \a aFootprint relative to its position, together with its
+ * orientation: the courtyard caches depend on nothing else.
+ */
+static size_t courtyardSourceHash( const FOOTPRINT* aFootprint )
+{
+    size_t ret = 0;
+
+    hash_combine( ret, aFootprint->GetOrientation().AsDegrees() );
+
+    for( BOARD_ITEM* item : aFootprint->GraphicalItems() )
+    {
+        if( item->Type() != PCB_SHAPE_T )
+            continue;
+
+        if( item->GetLayer() != F_CrtYd && item->GetLayer() != B_CrtYd )
+            continue;
+
+        hash_combine( ret, hash_fp_item( item, HASH_POS | REL_COORD | HASH_LAYER ) );
+    }
+
+    return ret;
+}
+
+
+bool FOOTPRINT::EnsureCourtyardCaches()
+{
+    if( m_courtyard_cache_valid && m_courtyard_cache_source == courtyardSourceHash( this ) )
+    {
+        if( m_courtyard_cache_pos != m_pos )
+        {
+            VECTOR2I delta = m_pos - m_courtyard_cache_pos;
+
+            m_courtyard_cache_back.Move( delta );
+            m_courtyard_cache_back_hash = m_courtyard_cache_back.GetHash();
+            m_courtyard_cache_front.Move( delta );
+            m_courtyard_cache_front_hash = m_courtyard_cache_front.GetHash();
+            m_courtyard_cache_pos = m_pos;
+        }
+
+        // The flags may have been cleared along with others since the last build
+        ClearFlags( MALFORMED_COURTYARDS );
+        SetFlags( m_courtyard_cache_flags );
+        return false;
+    }
+
+    BuildCourtyardCaches();
+    return true;
+}
+
+
+void FOOTPRINT::EnsureCourtyardCaches( const FOOTPRINTS& aFootprints )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), aFootprints.size(),
+            [&]( size_t ii )
+            {
+                aFootprints[ii]->EnsureCourtyardCaches();
+            } ).wait();
+}
+
+
 void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
 {
     m_courtyard_cache_front.RemoveAllContours();
     m_courtyard_cache_back.RemoveAllContours();
     ClearFlags( MALFORMED_COURTYARDS );
 
+    m_courtyard_cache_valid = true;
+    m_courtyard_cache_source = courtyardSourceHash( this );
+    m_courtyard_cache_pos = m_pos;
+    m_courtyard_cache_flags = 0;
+
     // Build the courtyard area from graphic items on the courtyard.
     // Only PCB_SHAPE_T have meaning, graphic texts are ignored.
     // Collect items:
@@ -3527,6 +3606,7 @@ void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
     else
     {
         SetFlags( MALFORMED_F_COURTYARD );
+        m_courtyard_cache_flags |= MALFORMED_F_COURTYARD;
     }
 
     if( ConvertOutlineToPolygon( list_back, m_courtyard_cache_back, maxError, chainingEpsilon, true,
@@ -3556,6 +3636,7 @@ void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
     else
     {
         SetFlags( MALFORMED_B_COURTYARD );
+        m_courtyard_cache_flags |= MALFORMED_B_COURTYARD;
     }
 
     m_courtyard_cache_front_hash = m_courtyard_cache_front.GetHash();
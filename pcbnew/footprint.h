@@ -1186,6 +1186,20 @@ public:
      */
     void BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler = nullptr );
 
+    /**
+     * Build the courtyard caches only if the courtyard graphics changed since they were last
+     * built.  Moving the footprint only translates the caches.
+     *
+     * @return true if the caches were rebuilt.
+     */
+    bool EnsureCourtyardCaches();
+
+    /**
+     * Call EnsureCourtyardCaches() on each footprint, in parallel.  The footprints must not be
+     * used by other threads meanwhile.
+     */
+    static void EnsureCourtyardCaches( const FOOTPRINTS& aFootprints );
+
     // @copydoc BOARD_ITEM::GetEffectiveShape
     std::shared_ptr<SHAPE> GetEffectiveShape( PCB_LAYER_ID aLayer = UNDEFINED_LAYER,
                                               FLASHING aFlash = FLASHING::DEFAULT ) const override;
@@ -1372,6 +1386,12 @@ private:
     mutable HASH_128   m_courtyard_cache_back_hash;
     mutable std::mutex m_courtyard_cache_mutex;
 
+    // What the courtyard caches were built from, to only rebuild them when it changes
+    bool               m_courtyard_cache_valid = false;
+    size_t             m_courtyard_cache_source = 0;     // Hash of the courtyard graphics
+    VECTOR2I           m_courtyard_cache_pos;            // Footprint position of the caches
+    EDA_ITEM_FLAGS     m_courtyard_cache_flags = 0;      // MALFORMED_* flags of the last build
+
     std::unordered_set<wxString> m_transientComponentClassNames;
     std::unique_ptr<COMPONENT_CLASS_CACHE_PROXY> m_componentClassCacheProxy;
 
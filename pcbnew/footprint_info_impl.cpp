@@ -28,6 +28,7 @@
 #include <footprint_library_adapter.h>
 #include <kiway.h>
 #include <lib_id.h>
+#include <libraries/library_metadata_cache.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
 #include <thread_pool.h>
@@ -45,6 +46,19 @@ void FOOTPRINT_INFO_IMPL::load()
     FOOTPRINT_LIBRARY_ADAPTER* adapter = m_owner->GetAdapter();
     wxCHECK( adapter, /* void */ );
 
+    // The footprint itself is only parsed when it is placed or previewed
+    FOOTPRINT_SUMMARY summary;
+
+    if( adapter->LoadFootprintSummary( m_nickname, m_fpname, summary ) )
+    {
+        m_pad_count = summary.m_padCount;
+        m_unique_pad_count = summary.m_uniquePadCount;
+        m_keywords = summary.m_keywords;
+        m_doc = summary.m_description;
+        m_loaded = true;
+        return;
+    }
+
     try
     {
         std::unique_ptr<FOOTPRINT> footprint( adapter->LoadFootprint( m_nickname, m_fpname, false ) );
@@ -165,6 +179,8 @@ bool FOOTPRINT_LIST_IMPL::ReadFootprintFiles( FOOTPRINT_LIBRARY_ADAPTER* aAdapte
 
     loadFootprints();
 
+    aAdapter->Manager().MetadataCache().Save();
+
     if( m_progress_reporter )
         m_progress_reporter->AdvancePhase();
 
@@ -194,7 +210,35 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
                 if( m_cancelled || !m_queue.pop( nickname ) )
                     return 0;
 
+                LIBRARY_METADATA_CACHE& cache = m_adapter->Manager().MetadataCache();
+                wxString                path;
+
+                if( std::optional<LIBRARY_TABLE_ROW*> row = m_adapter->GetRow( nickname ) )
+                    path = LIBRARY_MANAGER::GetFullURI( *row, true );
+
+                long long stamp = LIBRARY_METADATA_CACHE::LibraryStamp( path );
+
+                std::vector<LIBRARY_METADATA_CACHE::ITEM> items;
+
+                // A library unchanged since any earlier session needn't be opened at all
+                if( cache.GetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, path, stamp, items ) )
+                {
+                    for( const LIBRARY_METADATA_CACHE::ITEM& item : items )
+                    {
+                        auto* fpinfo = new FOOTPRINT_INFO_IMPL( nickname, item.m_name, item.m_description,
+                                                                item.m_keywords, 0, item.m_count,
+                                                                item.m_uniqueCount );
+                        queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
+                    }
+
+                    if( m_progress_reporter )
+                        m_progress_reporter->AdvanceProgress();
+
+                    return 1;
+                }
+
                 std::vector<wxString> fpnames;
+                size_t                errorCount = m_errors.size();
 
                 CatchErrors(
                         [&]()
@@ -208,6 +252,9 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
                             [&]()
                             {
                                 auto* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
+
+                                items.push_back( { fpname, fpinfo->GetDesc(), fpinfo->GetKeywords(),
+                                                   fpinfo->GetPadCount(), fpinfo->GetUniquePadCount() } );
                                 queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
                             } );
 
@@ -215,6 +262,10 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
                         return 0;
                 }
 
+                // Errors are reported again next session rather than hidden behind the cache
+                if( m_errors.size() == errorCount )
+                    cache.SetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, path, stamp, std::move( items ) );
+
                 if( m_progress_reporter )
                     m_progress_reporter->AdvanceProgress();
 
@@ -222,7 +273,7 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
             };
 
     for( size_t ii = 0; ii < num_elements; ++ii )
-        returns[ii] = tp.submit_task( fp_thread );
+        returns[ii] = tp.submit_task( fp_thread, PoolPriority( TASK_PRIORITY::BACKGROUND ) );
 
     for( const std::future<size_t>& ret : returns )
     {
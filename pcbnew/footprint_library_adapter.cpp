@@ -62,6 +62,7 @@ void FOOTPRINT_LIBRARY_ADAPTER::AsyncLoad()
     }
 
     std::vector<LIBRARY_TABLE_ROW*> rows = m_manager.Rows( LIBRARY_TABLE_TYPE::FOOTPRINT );
+    sortRowsForLoad( rows );
 
     m_loadTotal = rows.size();
     m_loadCount.store( 0 );
@@ -173,7 +174,7 @@ void FOOTPRINT_LIBRARY_ADAPTER::AsyncLoad()
                 }
 
                 ++m_loadCount;
-            }, BS::pr::lowest ) );
+            }, PoolPriority( TASK_PRIORITY::BACKGROUND ) ) );
     }
 
     wxLogTrace( traceLibraries, "FP: Started async load of %zu libraries", m_loadTotal );
@@ -389,6 +390,26 @@ FOOTPRINT* FOOTPRINT_LIBRARY_ADAPTER::LoadFootprint( const wxString& aNickname,
 }
 
 
+bool FOOTPRINT_LIBRARY_ADAPTER::LoadFootprintSummary( const wxString& aNickname, const wxString& aName,
+                                                      FOOTPRINT_SUMMARY& aSummary )
+{
+    if( std::optional<const LIB_DATA*> lib = fetchIfLoaded( aNickname ) )
+    {
+        try
+        {
+            return pcbplugin( *lib )->GetFootprintSummary( getUri( ( *lib )->row ), aName, aSummary );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceLibraries, "LoadFootprintSummary: error reading %s:%s: %s",
+                        aNickname, aName, ioe.What() );
+        }
+    }
+
+    return false;
+}
+
+
 FOOTPRINT* FOOTPRINT_LIBRARY_ADAPTER::LoadFootprintWithOptionalNickname( const LIB_ID& aFootprintId, bool aKeepUUID )
 {
     wxString nickname = aFootprintId.GetLibNickname();
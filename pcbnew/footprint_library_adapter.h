@@ -100,6 +100,15 @@ public:
         return LoadFootprint( aLibId.GetLibNickname(), aLibId.GetLibItemName(), aKeepUUID );
     }
 
+    /**
+     * Read the description, keywords and pad counts of a footprint without loading it, if the
+     * library plugin supports that.
+     *
+     * @return false if the footprint has to be loaded to get them.
+     */
+    bool LoadFootprintSummary( const wxString& aNickname, const wxString& aName,
+                               FOOTPRINT_SUMMARY& aSummary );
+
     /**
      * Load a footprint having @a aFootprintId with possibly an empty nickname.
      *
@@ -22,11 +22,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <future>
+#include <memory>
+#include <mutex>
+
+#include <wx/app.h>
 #include <wx/clipbrd.h>
 #include <wx/log.h>
 
 #include <board.h>
 #include <build_version.h>
+#include <component_classes/component_class.h>
 #include <core/ignore.h>
 #include <font/fontconfig.h>
 #include <pad.h>
@@ -41,38 +47,73 @@
 #include <kicad_clipboard.h>
 #include <kidialog.h>
 #include <io/kicad/kicad_io_utils.h>
+#include <thread_pool.h>
 
-CLIPBOARD_IO::CLIPBOARD_IO():
-        PCB_IO_KICAD_SEXPR(CTL_FOR_CLIPBOARD ),
-        m_formatter(),
-        m_writer( &CLIPBOARD_IO::clipboardWriter ),
-        m_reader( &CLIPBOARD_IO::clipboardReader )
+
+/**
+ * The last board selection copied by this process.
+ *
+ * The items are clones owned by their own board, so the snapshot outlives the board they were
+ * copied from.  Pasting in the same session clones them again instead of parsing the clipboard
+ * text; the system clipboard only carries the snapshot id next to the text for the other
+ * applications.
+ */
+struct CLIPBOARD_SNAPSHOT
 {
-    m_out = &m_formatter;
-}
+    std::unique_ptr<BOARD>       m_board;
+    std::vector<BOARD_ITEM*>     m_items;    ///< Top level items, in selection order
+    wxString                     m_id;
 
+    /// Held while the items are formatted or cloned: both fill caches of the items
+    std::mutex                   m_mutex;
 
-CLIPBOARD_IO::~CLIPBOARD_IO()
+    /// The clipboard text, until it has been handed to the system clipboard
+    std::shared_future<wxString> m_text;
+};
+
+
+namespace
 {
-}
+const wxString SNAPSHOT_FORMAT_ID = wxS( "application/x-kicad-pcb-snapshot" );
 
+std::shared_ptr<CLIPBOARD_SNAPSHOT> s_snapshot;
 
-void CLIPBOARD_IO::SetBoard( BOARD* aBoard )
+
+/**
+ * Clipboard text of a snapshot, waiting for the background formatting only when the text is
+ * actually requested.
+ */
+class SNAPSHOT_TEXT_DATA_OBJECT : public wxTextDataObject
 {
-    m_board = aBoard;
-}
+public:
+    SNAPSHOT_TEXT_DATA_OBJECT( std::shared_future<wxString> aText ) :
+            m_text( std::move( aText ) )
+    {}
 
+    size_t GetTextLength() const override { return m_text.get().Len() + 1; }
+    wxString GetText() const override { return m_text.get(); }
 
-void CLIPBOARD_IO::clipboardWriter( const wxString& aData )
+private:
+    std::shared_future<wxString> m_text;
+};
+
+
+void setClipboardData( wxDataObject* aData, bool aFlush )
 {
     wxLogNull         doNotLog; // disable logging of failed clipboard actions
     auto clipboard = wxTheClipboard;
     wxClipboardLocker clipboardLock( clipboard );
 
     if( !clipboardLock || !clipboard->IsOpened() )
+    {
+        delete aData;
         return;
+    }
 
-    clipboard->SetData( new wxTextDataObject( aData ) );
+    clipboard->SetData( aData );
+
+    if( !aFlush )
+        return;
 
     clipboard->Flush();
 
@@ -94,6 +135,179 @@ void CLIPBOARD_IO::clipboardWriter( const wxString& aData )
 }
 
 
+/**
+ * Put the snapshot id and its text on the system clipboard.  Until the text is ready it is
+ * only rendered on request, so the clipboard is not flushed.
+ */
+void publishSnapshot( const CLIPBOARD_SNAPSHOT& aSnapshot, bool aTextReady )
+{
+    wxCustomDataObject* id = new wxCustomDataObject( wxDataFormat( SNAPSHOT_FORMAT_ID ) );
+    wxScopedCharBuffer  idBuffer = aSnapshot.m_id.utf8_str();
+
+    id->SetData( idBuffer.length(), idBuffer.data() );
+
+    wxDataObjectComposite* data = new wxDataObjectComposite();
+
+    if( aTextReady )
+        data->Add( new wxTextDataObject( aSnapshot.m_text.get() ), true );
+    else
+        data->Add( new SNAPSHOT_TEXT_DATA_OBJECT( aSnapshot.m_text ), true );
+
+    data->Add( id );
+
+    setClipboardData( data, aTextReady );
+}
+
+
+bool clipboardHoldsSnapshot( const CLIPBOARD_SNAPSHOT& aSnapshot )
+{
+    wxLogNull doNotLog; // disable logging of failed clipboard actions
+
+    auto clipboard = wxTheClipboard;
+    wxClipboardLocker clipboardLock( clipboard );
+    wxDataFormat      format( SNAPSHOT_FORMAT_ID );
+
+    if( !clipboardLock || !clipboard->IsSupported( format ) )
+        return false;
+
+    wxCustomDataObject data( format );
+
+    if( !clipboard->GetData( data ) )
+        return false;
+
+    return wxString::FromUTF8( static_cast<const char*>( data.GetData() ), data.GetSize() )
+           == aSnapshot.m_id;
+}
+
+
+void copyLayerSetup( const BOARD* aSource, BOARD* aDest )
+{
+    aDest->SetDesignSettings( aSource->GetDesignSettings() );
+
+    for( PCB_LAYER_ID layer : aSource->GetEnabledLayers().Seq() )
+    {
+        aDest->SetLayerName( layer, aSource->GetLayerName( layer ) );
+        aDest->SetLayerType( layer, aSource->GetLayerType( layer ) );
+    }
+}
+
+
+/**
+ * Add \a aItem and, for groups and generators, their descendants to \a aBoard, moving their
+ * nets and component classes to \a aBoard so they no longer refer to the source board.
+ */
+void addToBoard( BOARD* aBoard, BOARD_ITEM* aItem )
+{
+    auto adoptNet =
+            [&]( BOARD_ITEM* aChild )
+            {
+                BOARD_CONNECTED_ITEM* cItem = dynamic_cast<BOARD_CONNECTED_ITEM*>( aChild );
+
+                if( !cItem )
+                    return;
+
+                if( cItem->GetNetCode() <= 0 )
+                {
+                    cItem->SetNet( NETINFO_LIST::OrphanedItem() );
+                    return;
+                }
+
+                NETINFO_ITEM* net = aBoard->FindNet( cItem->GetNetname() );
+
+                if( !net )
+                {
+                    net = new NETINFO_ITEM( aBoard, cItem->GetNetname() );
+                    aBoard->Add( net );
+                }
+
+                cItem->SetNet( net );
+            };
+
+    auto add =
+            [&]( BOARD_ITEM* aChild )
+            {
+                aBoard->Add( aChild, ADD_MODE::BULK_APPEND, true );
+                adoptNet( aChild );
+
+                if( aChild->Type() != PCB_FOOTPRINT_T )
+                    return;
+
+                FOOTPRINT*                   footprint = static_cast<FOOTPRINT*>( aChild );
+                std::unordered_set<wxString> classNames;
+
+                if( const COMPONENT_CLASS* compClass = footprint->GetStaticComponentClass() )
+                {
+                    for( const COMPONENT_CLASS* constituent : compClass->GetConstituentClasses() )
+                        classNames.insert( constituent->GetName() );
+                }
+
+                // Same as after parsing: the paste resolves them against the destination board
+                footprint->SetTransientComponentClassNames( classNames );
+                footprint->ResolveComponentClassNames( aBoard, classNames );
+                footprint->RunOnChildren( adoptNet, RECURSE_MODE::NO_RECURSE );
+            };
+
+    add( aItem );
+
+    if( aItem->Type() == PCB_GROUP_T || aItem->Type() == PCB_GENERATOR_T )
+        aItem->RunOnChildren( add, RECURSE_MODE::RECURSE );
+}
+
+
+BOARD* cloneSnapshot( CLIPBOARD_SNAPSHOT& aSnapshot )
+{
+    std::lock_guard<std::mutex> lock( aSnapshot.m_mutex );
+
+    BOARD* board = new BOARD();
+    copyLayerSetup( aSnapshot.m_board.get(), board );
+
+    for( BOARD_ITEM* item : aSnapshot.m_items )
+    {
+        BOARD_ITEM* copy = nullptr;
+
+        if( item->Type() == PCB_GROUP_T )
+            copy = static_cast<PCB_GROUP*>( item )->DeepClone();
+        else if( item->Type() == PCB_GENERATOR_T )
+            copy = static_cast<PCB_GENERATOR*>( item )->DeepClone();
+        else
+            copy = static_cast<BOARD_ITEM*>( item->Clone() );
+
+        addToBoard( board, copy );
+    }
+
+    return board;
+}
+} // namespace
+
+
+CLIPBOARD_IO::CLIPBOARD_IO():
+        PCB_IO_KICAD_SEXPR(CTL_FOR_CLIPBOARD ),
+        m_formatter(),
+        m_writer( &CLIPBOARD_IO::clipboardWriter ),
+        m_reader( &CLIPBOARD_IO::clipboardReader ),
+        m_systemClipboard( true )
+{
+    m_out = &m_formatter;
+}
+
+
+CLIPBOARD_IO::~CLIPBOARD_IO()
+{
+}
+
+
+void CLIPBOARD_IO::SetBoard( BOARD* aBoard )
+{
+    m_board = aBoard;
+}
+
+
+void CLIPBOARD_IO::clipboardWriter( const wxString& aData )
+{
+    setClipboardData( new wxTextDataObject( aData ), true );
+}
+
+
 wxString CLIPBOARD_IO::clipboardReader()
 {
     wxLogNull doNotLog; // disable logging of failed clipboard actions
@@ -321,15 +535,11 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
     }
     else
     {
-        // we will fake being a .kicad_pcb to get the full parser kicking
-        // This means we also need layers and nets
-        LOCALE_IO io;
-
-        m_formatter.Print( "(kicad_pcb (version %d) (generator \"pcbnew\") (generator_version %s)",
-                           SEXPR_BOARD_FILE_VERSION,
-                           m_formatter.Quotew( GetMajorMinorVersion() ).c_str() );
+        std::shared_ptr<CLIPBOARD_SNAPSHOT> snapshot = std::make_shared<CLIPBOARD_SNAPSHOT>();
 
-        formatBoardLayers( m_board );
+        snapshot->m_board = std::make_unique<BOARD>();
+        snapshot->m_id = KIID().AsString();
+        copyLayerSetup( m_board, snapshot->m_board.get() );
 
         for( EDA_ITEM* item : aSelected )
         {
@@ -414,7 +624,6 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
                 }
 
                 copy->SetLocked( false );
-                copy->SetParent( m_board );
                 copy->SetParentGroup( nullptr );
 
                 // locate the reference point at (0, 0) in the copied items
@@ -428,36 +637,113 @@ void CLIPBOARD_IO::SaveSelection( const PCB_SELECTION& aSelected, bool isFootpri
                         deleteUnselectedCells( table );
                 }
 
-                Format( copy );
-
                 if( copy->Type() == PCB_GROUP_T || copy->Type() == PCB_GENERATOR_T )
                 {
                     copy->RunOnChildren(
                             [&]( BOARD_ITEM* descendant )
                             {
                                 descendant->SetLocked( false );
-                                Format( descendant );
                             },
                             RECURSE_MODE::RECURSE );
                 }
 
-                delete copy;
+                addToBoard( snapshot->m_board.get(), copy );
+                snapshot->m_items.push_back( copy );
             }
         }
 
-        m_formatter.Print( ")" );
+        if( !m_systemClipboard )
+        {
+            LOCALE_IO io;
+            formatSnapshot( *snapshot );
+            m_writer( prettyText() );
+            return;
+        }
+
+        // Formatting a large selection takes much longer than cloning it: do it in the
+        // background, and give the text to the system clipboard once ready unless something
+        // else has been copied in the meantime.
+        snapshot->m_text = GetKiCadThreadPool().submit_task(
+                [snapshot]()
+                {
+                    CLIPBOARD_IO io;
+
+                    {
+                        std::lock_guard<std::mutex> lock( snapshot->m_mutex );
+                        io.formatSnapshot( *snapshot );
+                    }
+
+                    if( wxTheApp )
+                    {
+                        wxTheApp->CallAfter(
+                                [snapshot]()
+                                {
+                                    if( s_snapshot != snapshot || !clipboardHoldsSnapshot( *snapshot ) )
+                                        return;
+
+                                    publishSnapshot( *snapshot, true );
+                                    snapshot->m_text = std::shared_future<wxString>();
+                                } );
+                    }
+
+                    return io.prettyText();
+                } ).share();
+
+        s_snapshot = snapshot;
+        publishSnapshot( *snapshot, false );
+        return;
+    }
+
+    // These are placed at the end to minimize the open time of the clipboard
+    m_writer( prettyText() );
+}
+
+
+void CLIPBOARD_IO::formatSnapshot( const CLIPBOARD_SNAPSHOT& aSnapshot )
+{
+    m_board = aSnapshot.m_board.get();
+
+    // we will fake being a .kicad_pcb to get the full parser kicking
+    // This means we also need layers and nets
+    m_formatter.Print( "(kicad_pcb (version %d) (generator \"pcbnew\") (generator_version %s)",
+                       SEXPR_BOARD_FILE_VERSION,
+                       m_formatter.Quotew( GetMajorMinorVersion() ).c_str() );
+
+    formatBoardLayers( m_board );
+
+    for( BOARD_ITEM* item : aSnapshot.m_items )
+    {
+        Format( item );
+
+        if( item->Type() == PCB_GROUP_T || item->Type() == PCB_GENERATOR_T )
+        {
+            item->RunOnChildren(
+                    [&]( BOARD_ITEM* descendant )
+                    {
+                        Format( descendant );
+                    },
+                    RECURSE_MODE::RECURSE );
+        }
     }
 
+    m_formatter.Print( ")" );
+}
+
+
+wxString CLIPBOARD_IO::prettyText()
+{
     std::string prettyData = m_formatter.GetString();
     KICAD_FORMAT::Prettify( prettyData, KICAD_FORMAT::FORMAT_MODE::COMPACT_TEXT_PROPERTIES );
 
-    // These are placed at the end to minimize the open time of the clipboard
-    m_writer( wxString( prettyData.c_str(), wxConvUTF8 ) );
+    return wxString( prettyData.c_str(), wxConvUTF8 );
 }
 
 
 BOARD_ITEM* CLIPBOARD_IO::Parse()
 {
+    if( m_systemClipboard && s_snapshot && clipboardHoldsSnapshot( *s_snapshot ) )
+        return cloneSnapshot( *s_snapshot );
+
     BOARD_ITEM* item;
     wxString result = m_reader();
 
@@ -489,10 +775,7 @@ void CLIPBOARD_IO::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     m_formatter.Print( ")" );
 
-    std::string prettyData = m_formatter.GetString();
-    KICAD_FORMAT::Prettify( prettyData, KICAD_FORMAT::FORMAT_MODE::COMPACT_TEXT_PROPERTIES );
-
-    m_writer( wxString( prettyData.c_str(), wxConvUTF8 ) );
+    m_writer( prettyText() );
 }
 
 
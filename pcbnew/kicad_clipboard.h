@@ -37,6 +37,8 @@
 #include <memory.h>
 #include <tools/pcb_selection.h>
 
+struct CLIPBOARD_SNAPSHOT;
+
 
 class CLIPBOARD_IO : public PCB_IO_KICAD_SEXPR
 {
@@ -44,8 +46,21 @@ public:
     CLIPBOARD_IO();
     ~CLIPBOARD_IO();
 
-    void SetWriter( std::function<void(const wxString&)> aWriter ) { m_writer = aWriter; }
-    void SetReader( std::function<wxString()> aReader ) { m_reader = aReader; }
+    /**
+     * Replace the system clipboard by \a aWriter (resp. \a aReader).  This also disables the
+     * in-process snapshot: the text is then always formatted and parsed synchronously.
+     */
+    void SetWriter( std::function<void(const wxString&)> aWriter )
+    {
+        m_writer = aWriter;
+        m_systemClipboard = false;
+    }
+
+    void SetReader( std::function<wxString()> aReader )
+    {
+        m_reader = aReader;
+        m_systemClipboard = false;
+    }
 
     /*
      * Saves the entire board to the clipboard formatted using the PCB_IO_KICAD_SEXPR formatting
@@ -56,9 +71,18 @@ public:
     /*
      * Write all the settings of the BOARD* set by setBoard() and then adds all the
      * BOARD_ITEMs found in selection formatted by PCB_IO_KICAD_SEXPR to clipboard as sexpr text
+     *
+     * In the board editor the copied items are also retained in memory.  The text is then
+     * formatted on the thread pool and only handed to the system clipboard when another
+     * application asks for it, or once it is ready.
      */
     void SaveSelection( const PCB_SELECTION& selected, bool isFootprintEditor );
 
+    /**
+     * @return the clipboard content, cloned from the retained snapshot when the system
+     *         clipboard still holds the last selection copied by this process, or parsed from
+     *         the clipboard text otherwise.
+     */
     BOARD_ITEM* Parse();
 
     BOARD* LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
@@ -70,9 +94,16 @@ private:
     static void clipboardWriter( const wxString& aData );
     static wxString clipboardReader();
 
+    /// Format the snapshot items as a fake kicad_pcb file, in the order they were copied.
+    void formatSnapshot( const CLIPBOARD_SNAPSHOT& aSnapshot );
+
+    /// Prettify the formatter content for the clipboard.
+    wxString prettyText();
+
     STRING_FORMATTER m_formatter;
     std::function<void(const wxString&)> m_writer;
     std::function<wxString()> m_reader;
+    bool m_systemClipboard;
 };
 
 
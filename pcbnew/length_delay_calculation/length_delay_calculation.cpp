@@ -25,6 +25,7 @@
 
 #include <board.h>
 #include <board_design_settings.h>
+#include <footprint.h>
 #include <geometry/geometry_utils.h>
 #include <wx/log.h>
 
@@ -660,16 +661,141 @@ LENGTH_DELAY_CALCULATION::GetLengthCalculationItem( const BOARD_CONNECTED_ITEM*
 }
 
 
+/**
+ * Deep copy of length statistics, including the optional layer detail maps.
+ */
+static LENGTH_DELAY_STATS copyStats( const LENGTH_DELAY_STATS& aStats )
+{
+    LENGTH_DELAY_STATS copy;
+
+    copy.NumPads = aStats.NumPads;
+    copy.NumVias = aStats.NumVias;
+    copy.ViaLength = aStats.ViaLength;
+    copy.TrackLength = aStats.TrackLength;
+    copy.PadToDieLength = aStats.PadToDieLength;
+    copy.ViaDelay = aStats.ViaDelay;
+    copy.TrackDelay = aStats.TrackDelay;
+    copy.PadToDieDelay = aStats.PadToDieDelay;
+
+    if( aStats.LayerLengths )
+        copy.LayerLengths = std::make_unique<std::map<PCB_LAYER_ID, int64_t>>( *aStats.LayerLengths );
+
+    if( aStats.LayerDelays )
+        copy.LayerDelays = std::make_unique<std::map<PCB_LAYER_ID, int64_t>>( *aStats.LayerDelays );
+
+    return copy;
+}
+
+
+LENGTH_DELAY_STATS
+LENGTH_DELAY_CALCULATION::CalculateNetLengthDetails( const int aNetCode,
+                                                     const std::vector<const BOARD_CONNECTED_ITEM*>& aItems,
+                                                     const PATH_OPTIMISATIONS      aOptimisations,
+                                                     const LENGTH_DELAY_LAYER_OPT  aLayerOpt,
+                                                     const LENGTH_DELAY_DOMAIN_OPT aDomain ) const
+{
+    // Maximum number of item sets remembered for one net
+    constexpr size_t maxEntriesPerNet = 8;
+
+    std::vector<const BOARD_CONNECTED_ITEM*> sortedItems( aItems );
+    std::sort( sortedItems.begin(), sortedItems.end() );
+
+    const int options = ( aOptimisations.OptimiseViaLayers ? 1 : 0 )
+                        | ( aOptimisations.MergeTracks ? 2 : 0 )
+                        | ( aOptimisations.OptimiseTracesInPads ? 4 : 0 )
+                        | ( aOptimisations.InferViaInPad ? 8 : 0 )
+                        | ( aLayerOpt == LENGTH_DELAY_LAYER_OPT::WITH_LAYER_DETAIL ? 16 : 0 )
+                        | ( aDomain == LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL ? 32 : 0 );
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_netCacheMutex );
+
+        if( auto it = m_netCache.find( aNetCode ); it != m_netCache.end() )
+        {
+            for( const NET_CACHE_ENTRY& entry : it->second )
+            {
+                if( entry.Options == options && entry.Items == sortedItems )
+                    return copyStats( entry.Stats );
+            }
+        }
+    }
+
+    std::vector<LENGTH_DELAY_CALCULATION_ITEM> lengthItems;
+    lengthItems.reserve( aItems.size() );
+
+    for( const BOARD_CONNECTED_ITEM* item : aItems )
+    {
+        LENGTH_DELAY_CALCULATION_ITEM lengthItem = GetLengthCalculationItem( item );
+
+        if( lengthItem.Type() != LENGTH_DELAY_CALCULATION_ITEM::TYPE::UNKNOWN )
+            lengthItems.emplace_back( std::move( lengthItem ) );
+    }
+
+    LENGTH_DELAY_STATS stats = CalculateLengthDetails( lengthItems, aOptimisations, nullptr, nullptr, aLayerOpt,
+                                                       aDomain );
+
+    std::unique_lock<std::shared_mutex> writeLock( m_netCacheMutex );
+    std::vector<NET_CACHE_ENTRY>&       entries = m_netCache[aNetCode];
+
+    // Another thread may have computed the same set in the meantime
+    for( const NET_CACHE_ENTRY& entry : entries )
+    {
+        if( entry.Options == options && entry.Items == sortedItems )
+            return stats;
+    }
+
+    if( entries.size() >= maxEntriesPerNet )
+        entries.erase( entries.begin() );
+
+    entries.push_back( { std::move( sortedItems ), options, copyStats( stats ) } );
+
+    return stats;
+}
+
+
+void LENGTH_DELAY_CALCULATION::InvalidateNets( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_netCacheMutex );
+
+    if( m_netCache.empty() )
+        return;
+
+    for( const BOARD_ITEM* item : aItems )
+    {
+        if( item->Type() == PCB_FOOTPRINT_T )
+        {
+            for( const PAD* pad : static_cast<const FOOTPRINT*>( item )->Pads() )
+                m_netCache.erase( pad->GetNetCode() );
+        }
+        else if( item->IsConnected() )
+        {
+            m_netCache.erase( static_cast<const BOARD_CONNECTED_ITEM*>( item )->GetNetCode() );
+        }
+    }
+}
+
+
+void LENGTH_DELAY_CALCULATION::ClearNetCache() const
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_netCacheMutex );
+    m_netCache.clear();
+}
+
+
 void LENGTH_DELAY_CALCULATION::SetTuningProfileParametersProvider(
         std::unique_ptr<TUNING_PROFILE_PARAMETERS_IFACE>&& aProvider )
 {
     m_tuningProfileParameters = std::move( aProvider );
+    ClearNetCache();
 }
 
 
 void LENGTH_DELAY_CALCULATION::SynchronizeTuningProfileProperties() const
 {
     m_tuningProfileParameters->OnSettingsChanged();
+
+    // Delays depend on the tuning profiles, and via lengths on the stackup
+    ClearNetCache();
 }
 
 
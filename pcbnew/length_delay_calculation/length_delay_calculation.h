@@ -30,6 +30,8 @@
 #include <board_design_settings.h>
 #include <connectivity/connectivity_data.h>
 #include <length_delay_calculation/length_delay_calculation_item.h>
+#include <shared_mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 class BOARD;
@@ -170,6 +172,32 @@ public:
                             LENGTH_DELAY_LAYER_OPT  aLayerOpt = LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
                             LENGTH_DELAY_DOMAIN_OPT aDomain = LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL ) const;
 
+    /**
+     * @brief Calculates the electrical length of board items which all belong to the given net
+     *
+     * Unlike CalculateLengthDetails(), the result is cached per net for the given set of items
+     * and options.  It is reused until an item of the net is reported changed through
+     * InvalidateNets(), so only the nets touched by a commit are recomputed.  Can be called
+     * from several threads at once.
+     *
+     * @param aNetCode is the net of all the items
+     * @param aItems are the board items making up the route
+     * @param aOptimisations details the electrical path optimisations that should be applied to the board items
+     * @param aLayerOpt determines whether the layer details map is populated
+     * @param aDomain determines whether calculations include time domain (delay) details
+     */
+    LENGTH_DELAY_STATS
+    CalculateNetLengthDetails( int aNetCode, const std::vector<const BOARD_CONNECTED_ITEM*>& aItems,
+                               PATH_OPTIMISATIONS      aOptimisations,
+                               LENGTH_DELAY_LAYER_OPT  aLayerOpt = LENGTH_DELAY_LAYER_OPT::NO_LAYER_DETAIL,
+                               LENGTH_DELAY_DOMAIN_OPT aDomain = LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL ) const;
+
+    /// Drops the cached net statistics of the nets of the given items (or of their pads for footprints)
+    void InvalidateNets( const std::vector<BOARD_ITEM*>& aItems );
+
+    /// Drops all cached net statistics, e.g. when the stackup or the tuning profiles change
+    void ClearNetCache() const;
+
     /**
   * Gets the propagation delay for the given shape line chain
   *
@@ -213,6 +241,18 @@ protected:
     /// The active provider of tuning profile parameters
     std::unique_ptr<TUNING_PROFILE_PARAMETERS_IFACE> m_tuningProfileParameters;
 
+    /// A cached CalculateNetLengthDetails() result
+    struct NET_CACHE_ENTRY
+    {
+        std::vector<const BOARD_CONNECTED_ITEM*> Items;    ///< Sorted, to compare item sets
+        int                                      Options;  ///< Packed optimisations and detail options
+        LENGTH_DELAY_STATS                       Stats;
+    };
+
+    /// Cached statistics by net code.  A net usually holds a few entries (whole net, DRC rule subsets, ...)
+    mutable std::unordered_map<int, std::vector<NET_CACHE_ENTRY>> m_netCache;
+    mutable std::shared_mutex                                     m_netCacheMutex;
+
     /// Enum to describe whether track merging is attempted from the start or end of a track segment
     enum class MERGE_POINT
     {
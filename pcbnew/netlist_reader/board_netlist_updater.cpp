@@ -27,6 +27,8 @@
  */
 
 
+#include <algorithm>
+
 #include <common.h>                         // for PAGE_INFO
 
 #include <base_units.h>
@@ -45,6 +47,7 @@
 #include <netlist_reader/pcb_netlist.h>
 #include <connectivity/connectivity_data.h>
 #include <reporter.h>
+#include <thread_pool.h>
 #include <wx/log.h>
 
 #include "board_netlist_updater.h"
@@ -157,7 +160,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::addNewFootprint( COMPONENT* aComponent, const
         return nullptr;
     }
 
-    FOOTPRINT* footprint = m_frame->LoadFootprint( aFootprintId );
+    FOOTPRINT* footprint = loadFootprint( aFootprintId );
 
     if( footprint == nullptr )
     {
@@ -322,7 +325,7 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
         return nullptr;
     }
 
-    FOOTPRINT* newFootprint = m_frame->LoadFootprint( aNewComponent->GetFPID() );
+    FOOTPRINT* newFootprint = loadFootprint( aNewComponent->GetFPID() );
 
     if( newFootprint == nullptr )
     {
@@ -391,6 +394,55 @@ FOOTPRINT* BOARD_NETLIST_UPDATER::replaceFootprint( NETLIST& aNetlist, FOOTPRINT
  }
 
 
+void BOARD_NETLIST_UPDATER::preloadFootprints( const std::set<LIB_ID>& aFpids )
+{
+    // A library plugin is not reentrant, so a library is only read by one task
+    std::map<wxString, std::vector<LIB_ID>> byLibrary;
+
+    for( const LIB_ID& fpid : aFpids )
+    {
+        // Footprints without a nickname are searched for in every library, when needed
+        if( !fpid.GetLibNickname().empty() && !m_libFootprints.count( fpid ) )
+            byLibrary[fpid.GetLibNickname()].push_back( fpid );
+    }
+
+    std::vector<const std::vector<LIB_ID>*> libraries;
+    std::vector<std::vector<FOOTPRINT*>>    loaded( byLibrary.size() );
+
+    for( const auto& [nickname, fpids] : byLibrary )
+        libraries.push_back( &fpids );
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), libraries.size(),
+            [&]( size_t aIdx )
+            {
+                for( const LIB_ID& fpid : *libraries[aIdx] )
+                    loaded[aIdx].push_back( m_frame->LoadFootprint( fpid ) );
+            } ).wait();
+
+    for( size_t ii = 0; ii < libraries.size(); ++ii )
+    {
+        for( size_t jj = 0; jj < libraries[ii]->size(); ++jj )
+            m_libFootprints[( *libraries[ii] )[jj]].reset( loaded[ii][jj] );
+    }
+}
+
+
+FOOTPRINT* BOARD_NETLIST_UPDATER::loadFootprint( const LIB_ID& aFpid )
+{
+    auto it = m_libFootprints.find( aFpid );
+
+    if( it == m_libFootprints.end() )
+        it = m_libFootprints.emplace( aFpid, m_frame->LoadFootprint( aFpid ) ).first;
+
+    if( !it->second )
+        return nullptr;
+
+    return static_cast<FOOTPRINT*>( it->second->Duplicate( IGNORE_PARENT_GROUP ) );
+}
+
+
 bool BOARD_NETLIST_UPDATER::updateFootprintParameters( FOOTPRINT* aPcbFootprint,
                                                        COMPONENT* aNetlistComponent )
 {
@@ -1845,7 +1897,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
     std::unordered_set<wxString> sheetPaths;
@@ -1857,8 +1908,91 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
+    // Index the footprints already on the board, so that matching a component doesn't walk the
+    // whole board.  The index holds board positions, to return the matches in board order.
+    std::vector<FOOTPRINT*> preexistingFootprints( m_board->Footprints().begin(),
+                                                   m_board->Footprints().end() );
+    std::unordered_map<KIID_PATH, std::vector<size_t>> footprintsByPath;
+    std::unordered_map<wxString, std::vector<size_t>>  footprintsByReference;
+
+    for( size_t ii = 0; ii < preexistingFootprints.size(); ++ii )
+    {
+        FOOTPRINT* footprint = preexistingFootprints[ii];
+
+        if( m_lookupByTimestamp )
+            footprintsByPath[footprint->GetPath()].push_back( ii );
+        else
+            footprintsByReference[footprint->GetReference().Lower()].push_back( ii );
+    }
+
+    auto findMatchingFootprints =
+            [&]( COMPONENT* aComponent )
+            {
+                std::vector<size_t> positions;
+
+                if( m_lookupByTimestamp )
+                {
+                    for( const KIID& uuid : aComponent->GetKIIDs() )
+                    {
+                        KIID_PATH path = aComponent->GetPath();
+                        path.push_back( uuid );
+
+                        auto it = footprintsByPath.find( path );
+
+                        if( it != footprintsByPath.end() )
+                        {
+                            positions.insert( positions.end(), it->second.begin(),
+                                              it->second.end() );
+                        }
+                    }
+
+                    std::sort( positions.begin(), positions.end() );
+                    positions.erase( std::unique( positions.begin(), positions.end() ),
+                                     positions.end() );
+                }
+                else
+                {
+                    auto it = footprintsByReference.find( aComponent->GetReference().Lower() );
+
+                    if( it != footprintsByReference.end() )
+                        positions = it->second;
+                }
+
+                std::vector<FOOTPRINT*> footprints;
+                footprints.reserve( positions.size() );
+
+                for( size_t pos : positions )
+                    footprints.push_back( preexistingFootprints[pos] );
+
+                return footprints;
+            };
+
+    // Load the library footprints of the components which have none on the board yet, several
+    // libraries at a time.  The others (e.g. variant footprints) are loaded when needed.
+    std::set<LIB_ID> missingFpids;
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        const LIB_ID& fpid = component->GetFPID();
+
+        if( fpid.empty() || component->GetProperties().count( wxT( "exclude_from_board" ) ) )
+            continue;
+
+        std::vector<FOOTPRINT*> matches = findMatchingFootprints( component );
+
+        if( std::none_of( matches.begin(), matches.end(),
+                          [&]( FOOTPRINT* aFootprint )
+                          {
+                              return aFootprint->GetFPID() == fpid;
+                          } ) )
+        {
+            missingFpids.insert( fpid );
+        }
+    }
+
+    preloadFootprints( missingFpids );
 
     cacheCopperZoneConnections();
 
@@ -1890,40 +2024,7 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
         const LIB_ID& baseFpid = component->GetFPID();
         const bool    hasBaseFpid = !baseFpid.empty();
-        std::vector<FOOTPRINT*> matchingFootprints;
-
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            bool match = false;
-
-            if( m_lookupByTimestamp )
-            {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
-
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
-            }
-
-            if( match )
-                matchingFootprints.push_back( footprint );
-
-            if( footprint == lastPreexistingFootprint )
-            {
-                // No sense going through the newly-created footprints: end of loop
-                break;
-            }
-        }
+        std::vector<FOOTPRINT*> matchingFootprints = findMatchingFootprints( component );
 
         std::vector<LIB_ID> expectedFpids;
         std::unordered_set<wxString> expectedFpidKeys;
@@ -2174,7 +2275,8 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         m_board->GetComponentClassManager().FinishNetlistUpdate();
         m_board->SynchronizeComponentClasses( sheetPaths );
 
-        m_board->BuildConnectivity();
+        // No connectivity rebuild here: the commit updates the connectivity of all the changed
+        // items in one batch when it is pushed.
         testConnectivity( aNetlist, footprintMap );
 
         for( NETINFO_ITEM* net : m_board->GetNetInfo() )
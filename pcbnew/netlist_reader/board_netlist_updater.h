@@ -37,6 +37,10 @@ class FOOTPRINT;
 class PCB_EDIT_FRAME;
 
 #include <board_commit.h>
+#include <lib_id.h>
+
+#include <memory>
+#include <set>
 
 /**
  * Update the #BOARD with a new netlist.
@@ -114,6 +118,18 @@ private:
     FOOTPRINT* replaceFootprint( NETLIST& aNetlist, FOOTPRINT* aFootprint,
                                  COMPONENT* aNewComponent );
 
+    /**
+     * Load the library footprints \a aFpids on the thread pool, one task per library, ahead of
+     * the update adding them.
+     */
+    void preloadFootprints( const std::set<LIB_ID>& aFpids );
+
+    /**
+     * @return a new copy of the library footprint \a aFpid, with its own UUIDs, or nullptr if
+     *         it cannot be loaded.  Each library footprint is only loaded once per update.
+     */
+    FOOTPRINT* loadFootprint( const LIB_ID& aFpid );
+
     bool updateFootprintParameters( FOOTPRINT* aPcbFootprint, COMPONENT* aNetlistComponent );
 
     bool updateFootprintGroup( FOOTPRINT* aPcbFootprint, COMPONENT* aNetlistComponent );
@@ -148,6 +164,8 @@ private:
     std::vector<FOOTPRINT*>            m_addedFootprints;
     std::map<wxString, NETINFO_ITEM*>  m_addedNets;
 
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> m_libFootprints;
+
     bool m_deleteUnusedFootprints;
     bool m_isDryRun;
     bool m_replaceFootprints;
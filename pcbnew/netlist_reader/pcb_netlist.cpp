@@ -323,20 +323,33 @@ NETLIST_GROUP* NETLIST::GetGroupByUuid( const KIID& aUuid )
 }
 
 
-COMPONENT* NETLIST::GetComponentByReference( const wxString& aReference )
+void NETLIST::updateIndex()
 {
-    COMPONENT* component = nullptr;
-
-    for( unsigned i = 0;  i < m_components.size();  i++ )
+    for( ; m_indexedCount < m_components.size(); ++m_indexedCount )
     {
-        if( m_components[i].GetReference() == aReference )
+        COMPONENT& component = m_components[m_indexedCount];
+
+        // emplace() keeps the first component when several share a key
+        m_componentsByReference.emplace( component.GetReference(), &component );
+
+        for( const KIID& uuid : component.GetKIIDs() )
         {
-            component = &m_components[i];
-            break;
+            KIID_PATH path = component.GetPath();
+            path.push_back( uuid );
+
+            m_componentsByPath.emplace( path, &component );
+            m_componentsByUuid.emplace( uuid, &component );
         }
     }
+}
+
+
+COMPONENT* NETLIST::GetComponentByReference( const wxString& aReference )
+{
+    updateIndex();
 
-    return component;
+    auto it = m_componentsByReference.find( aReference );
+    return it != m_componentsByReference.end() ? it->second : nullptr;
 }
 
 
@@ -345,24 +358,10 @@ COMPONENT* NETLIST::GetComponentByPath( const KIID_PATH& aUuidPath )
     if( aUuidPath.empty() )
         return nullptr;
 
-    KIID comp_uuid = aUuidPath.back();
-    KIID_PATH base = aUuidPath;
-
-    if( !base.empty() )
-        base.pop_back();
+    updateIndex();
 
-    for( COMPONENT& component : m_components )
-    {
-        const std::vector<KIID>& kiids = component.GetKIIDs();
-
-        if( base != component.GetPath() )
-            continue;
-
-        if( std::find( kiids.begin(), kiids.end(), comp_uuid ) != kiids.end() )
-            return &component;
-    }
-
-    return nullptr;
+    auto it = m_componentsByPath.find( aUuidPath );
+    return it != m_componentsByPath.end() ? it->second : nullptr;
 }
 
 
@@ -371,16 +370,10 @@ COMPONENT* NETLIST::GetComponentByUuid( const KIID& aUuid)
     if( aUuid == 0 )
         return nullptr;
 
-    for( COMPONENT& component : m_components )
-    {
-        for( const KIID& compUuid : component.GetKIIDs() )
-        {
-            if( aUuid == compUuid )
-                return &component;
-        }
-    }
+    updateIndex();
 
-    return nullptr;
+    auto it = m_componentsByUuid.find( aUuid );
+    return it != m_componentsByUuid.end() ? it->second : nullptr;
 }
 
 
@@ -396,6 +389,7 @@ static bool ByFPID( const COMPONENT& ref, const COMPONENT& cmp )
 void NETLIST::SortByFPID()
 {
     m_components.sort( ByFPID );
+    clearIndex();
 }
 
 
@@ -411,6 +405,7 @@ bool operator < ( const COMPONENT& item1, const COMPONENT& item2 )
 void NETLIST::SortByReference()
 {
     m_components.sort();
+    clearIndex();
 }
 
 
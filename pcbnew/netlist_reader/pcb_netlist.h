@@ -29,6 +29,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <wx/arrstr.h>
 #include <json_common.h>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <lib_id.h>
@@ -327,7 +328,11 @@ public:
     /**
      * Remove all components from the netlist.
      */
-    void Clear() { m_components.clear(); }
+    void Clear()
+    {
+        m_components.clear();
+        clearIndex();
+    }
 
     /**
      * @return the number of components in the netlist.
@@ -492,7 +497,27 @@ public:
     }
 
 private:
+    void clearIndex()
+    {
+        m_componentsByReference.clear();
+        m_componentsByPath.clear();
+        m_componentsByUuid.clear();
+        m_indexedCount = 0;
+    }
+
+    /**
+     * Add the components appended since the last lookup to the lookup tables.  Components are
+     * only ever appended, so the index is only rebuilt from scratch after a sort or a clear.
+     */
+    void updateIndex();
+
     COMPONENTS m_components;          // Components found in the netlist.
+
+    // Lookup tables for the GetComponentBy...() methods, to the first matching component
+    std::unordered_map<wxString, COMPONENT*>  m_componentsByReference;
+    std::unordered_map<KIID_PATH, COMPONENT*> m_componentsByPath;   // sheet path + symbol UUID
+    std::unordered_map<KIID, COMPONENT*>      m_componentsByUuid;
+    size_t                                    m_indexedCount = 0;
     NETLIST_GROUPS m_groups;          // Groups found in the netlist.
 
     std::vector<wxString>            m_variantNames;         // Variant names in order.
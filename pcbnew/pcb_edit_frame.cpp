@@ -21,6 +21,7 @@
  */
 
 #include <advanced_config.h>
+#include <connectivity/connectivity_algo.h>
 #include <connectivity/connectivity_data.h>
 #include <kiface_base.h>
 #include <kiway.h>
@@ -33,7 +34,9 @@
 #include <bitmaps.h>
 #include <confirm.h>
 #include <lset.h>
+#include <memory_usage.h>
 #include <trace_helpers.h>
+#include <zone.h>
 #include <algorithm>
 #include <type_traits>
 #include <unordered_map>
@@ -82,6 +85,7 @@
 #include <tools/edit_tool.h>
 #include <tools/pcb_edit_table_tool.h>
 #include <tools/pcb_group_tool.h>
+#include <tools/pcb_ollama_agent_tool.h>
 #include <tools/generator_tool.h>
 #include <tools/drc_tool.h>
 #include <tools/global_edit_tool.h>
@@ -589,6 +593,71 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     DragAcceptFiles( true );
 
     Bind( EDA_EVT_CLOSE_DIALOG_BOOK_REPORTER, &PCB_EDIT_FRAME::onCloseModelessBookReporterDialogs, this );
+
+    registerMemoryUsage();
+}
+
+
+void PCB_EDIT_FRAME::registerMemoryUsage()
+{
+    m_memoryUsage.push_back( std::make_unique<MEMORY_USAGE_PROVIDER>( wxS( "Zone fills" ),
+            [this]() -> size_t
+            {
+                size_t bytes = 0;
+
+                if( !GetBoard() )
+                    return bytes;
+
+                // Fills shared with undo images are only counted here
+                for( ZONE* zone : GetBoard()->Zones() )
+                {
+                    for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+                    {
+                        if( zone->HasFilledPolysForLayer( layer ) )
+                        {
+                            bytes += zone->GetFilledPolysList( layer )->FullPointCount()
+                                     * sizeof( VECTOR2I );
+                        }
+                    }
+                }
+
+                return bytes;
+            } ) );
+
+    m_memoryUsage.push_back( std::make_unique<MEMORY_USAGE_PROVIDER>( wxS( "Undo history" ),
+            [this]() -> size_t
+            {
+                size_t bytes = 0;
+
+                for( PICKED_ITEMS_LIST* command : m_undoList.m_CommandsList )
+                    bytes += command->GetMemoryEstimate();
+
+                for( PICKED_ITEMS_LIST* command : m_redoList.m_CommandsList )
+                    bytes += command->GetMemoryEstimate();
+
+                return bytes;
+            } ) );
+
+    m_memoryUsage.push_back( std::make_unique<MEMORY_USAGE_PROVIDER>( wxS( "Connectivity" ),
+            [this]() -> size_t
+            {
+                size_t bytes = 0;
+
+                if( !GetBoard() || !GetBoard()->GetConnectivity() )
+                    return bytes;
+
+                std::shared_ptr<CN_CONNECTIVITY_ALGO> algo =
+                        GetBoard()->GetConnectivity()->GetConnectivityAlgo();
+                const size_t anchorSize = sizeof( CN_ANCHOR ) + sizeof( std::shared_ptr<CN_ANCHOR> );
+
+                for( CN_ITEM* item : algo->ItemList() )
+                {
+                    bytes += sizeof( CN_ITEM ) + item->AnchorCount() * anchorSize
+                             + item->ConnectedItems().size() * sizeof( CN_ITEM* );
+                }
+
+                return bytes;
+            } ) );
 }
 
 void PCB_EDIT_FRAME::StartCrossProbeFlash( const std::vector<BOARD_ITEM*>& aItems )
@@ -688,6 +757,8 @@ void PCB_EDIT_FRAME::OnCrossProbeFlashTimer( wxTimerEvent& aEvent )
 
 PCB_EDIT_FRAME::~PCB_EDIT_FRAME()
 {
+    m_memoryUsage.clear();
+
     ScriptingOnDestructPcbEditFrame( this );
 
     if( ADVANCED_CFG::GetCfg().m_ShowEventCounters )
@@ -879,6 +950,7 @@ void PCB_EDIT_FRAME::setupTools()
     m_toolManager->RegisterTool( new PROPERTIES_TOOL );
     m_toolManager->RegisterTool( new MULTICHANNEL_TOOL );
     m_toolManager->RegisterTool( new EMBED_TOOL );
+    m_toolManager->RegisterTool( new PCB_OLLAMA_AGENT_TOOL );
     m_toolManager->InitTools();
 
     for( TOOL_BASE* tool : m_toolManager->Tools() )
@@ -57,6 +57,7 @@ struct PARSE_ERROR;
 class IO_ERROR;
 class FP_LIB_TABLE;
 class BOARD_NETLIST_UPDATER;
+class MEMORY_USAGE_PROVIDER;
 class ACTION_MENU;
 class TOOL_ACTION;
 class DIALOG_BOARD_SETUP;
@@ -824,6 +825,12 @@ protected:
 
     void onCloseModelessBookReporterDialogs( wxCommandEvent& aEvent );
 
+    /**
+     * Register the memory estimates of the board (zone fills, connectivity) and of the undo
+     * history for the memory usage report.
+     */
+    void registerMemoryUsage();
+
 #ifdef KICAD_IPC_API
     void onPluginAvailabilityChanged( wxCommandEvent& aEvt );
 #endif
@@ -882,6 +889,8 @@ private:
 
     wxTimer*     m_eventCounterTimer;
 
+    std::vector<std::unique_ptr<MEMORY_USAGE_PROVIDER>> m_memoryUsage;
+
 #ifdef KICAD_IPC_API
     std::unique_ptr<API_HANDLER_PCB> m_apiHandler;
     std::unique_ptr<API_HANDLER_COMMON> m_apiHandlerCommon;
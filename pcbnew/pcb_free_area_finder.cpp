@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pcb_free_area_finder.h>
+
+#include <cstdlib>
+
+#include <board.h>
+#include <footprint.h>
+
+
+PCB_FREE_AREA_FINDER::PCB_FREE_AREA_FINDER( BOARD* aBoard, int aMargin ) :
+        m_margin( aMargin ),
+        m_ignored( nullptr )
+{
+    FOOTPRINT::EnsureCourtyardCaches( aBoard->Footprints() );
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        PACKED_RTREE<const FOOTPRINT*>& side = footprint->GetSide() == B_Cu ? m_back : m_front;
+        side.Add( FootprintBox( footprint ), footprint );
+    }
+
+    m_front.Build();
+    m_back.Build();
+
+    m_area = aBoard->GetBoardEdgesBoundingBox();
+}
+
+
+BOX2I PCB_FREE_AREA_FINDER::FootprintBox( FOOTPRINT* aFootprint )
+{
+    PCB_LAYER_ID          layer = aFootprint->GetSide() == B_Cu ? B_CrtYd : F_CrtYd;
+    const SHAPE_POLY_SET& courtyard = aFootprint->GetCourtyard( layer );
+
+    if( courtyard.OutlineCount() )
+        return courtyard.BBox();
+
+    return aFootprint->GetBoundingBox( false );
+}
+
+
+void PCB_FREE_AREA_FINDER::AddObstacle( FOOTPRINT* aFootprint )
+{
+    aFootprint->EnsureCourtyardCaches();
+
+    PACKED_RTREE<const FOOTPRINT*>& side = aFootprint->GetSide() == B_Cu ? m_back : m_front;
+
+    side.Add( FootprintBox( aFootprint ), aFootprint );
+    side.Build();
+}
+
+
+bool PCB_FREE_AREA_FINDER::InsideBoard( const BOX2I& aBox ) const
+{
+    if( m_area.GetWidth() <= 0 || m_area.GetHeight() <= 0 )
+        return true;
+
+    return m_area.Contains( aBox );
+}
+
+
+bool PCB_FREE_AREA_FINDER::IsFree( const BOX2I& aBox, PCB_LAYER_ID aSide ) const
+{
+    if( !InsideBoard( aBox ) )
+        return false;
+
+    // The tree also reports boxes that only touch the query, and touching the margin is fine
+    BOX2I query = aBox;
+    query.Inflate( m_margin - 1 );
+
+    bool free = true;
+
+    auto visitor =
+            [&]( const FOOTPRINT* aFootprint )
+            {
+                if( aFootprint == m_ignored )
+                    return true;
+
+                free = false;
+                return false;
+            };
+
+    tree( aSide ).Search( query, visitor );
+
+    return free;
+}
+
+
+std::optional<VECTOR2I> PCB_FREE_AREA_FINDER::FindNearest( const BOX2I& aBox, PCB_LAYER_ID aSide,
+                                                           int aStep, int aMaxRings ) const
+{
+    if( IsFree( aBox, aSide ) )
+        return VECTOR2I( 0, 0 );
+
+    for( int r = 1; r <= aMaxRings; ++r )
+    {
+        for( int dx = -r; dx <= r; ++dx )
+        {
+            for( int dy = -r; dy <= r; ++dy )
+            {
+                // Only check the perimeter of this square "ring"
+                if( std::abs( dx ) != r && std::abs( dy ) != r )
+                    continue;
+
+                VECTOR2I offset( dx * aStep, dy * aStep );
+                BOX2I    candidate = aBox;
+                candidate.Move( offset );
+
+                if( IsFree( candidate, aSide ) )
+                    return offset;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
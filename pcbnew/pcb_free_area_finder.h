@@ -0,0 +1,92 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PCB_FREE_AREA_FINDER_H
+#define PCB_FREE_AREA_FINDER_H
+
+#include <optional>
+
+#include <geometry/packed_rtree.h>
+#include <layer_ids.h>
+#include <math/box2.h>
+#include <math/vector2d.h>
+
+class BOARD;
+class FOOTPRINT;
+
+
+/**
+ * Answer "where is the nearest place this footprint fits" queries against the footprints of
+ * a board.
+ *
+ * The courtyard (or, without one, the body) box of every footprint is put in a packed R-tree
+ * per board side when the finder is built, so testing a candidate position only looks at the
+ * few footprints around it.  When the board has an outline, candidates must stay inside it.
+ */
+class PCB_FREE_AREA_FINDER
+{
+public:
+    /**
+     * @param aMargin is the clearance kept between the placed box and every obstacle.
+     */
+    PCB_FREE_AREA_FINDER( BOARD* aBoard, int aMargin );
+
+    /// Exclude a footprint from the obstacles, e.g. the footprint being placed.
+    void IgnoreFootprint( const FOOTPRINT* aFootprint ) { m_ignored = aFootprint; }
+
+    /// Make \a aFootprint an obstacle at its current position, e.g. once it has been placed.
+    void AddObstacle( FOOTPRINT* aFootprint );
+
+    /// @return the box an obstacle footprint occupies: its courtyard, or its body without text.
+    static BOX2I FootprintBox( FOOTPRINT* aFootprint );
+
+    /// Return true if \a aBox is inside the board edges, or if the board has no edges.
+    bool InsideBoard( const BOX2I& aBox ) const;
+
+    /**
+     * Return true if \a aBox is inside the board and, plus margin, does not touch any
+     * footprint on side \a aSide.
+     */
+    bool IsFree( const BOX2I& aBox, PCB_LAYER_ID aSide ) const;
+
+    /**
+     * Search outward from \a aBox, ring by ring on a grid of \a aStep, for the nearest offset
+     * at which the box is free.
+     *
+     * @param aSide is F_Cu or B_Cu.
+     * @param aMaxRings is the number of grid rings to search around the starting position.
+     * @return the offset to apply to the box, or nullopt if no free area was found.
+     */
+    std::optional<VECTOR2I> FindNearest( const BOX2I& aBox, PCB_LAYER_ID aSide, int aStep,
+                                         int aMaxRings ) const;
+
+private:
+    const PACKED_RTREE<const FOOTPRINT*>& tree( PCB_LAYER_ID aSide ) const
+    {
+        return aSide == B_Cu ? m_back : m_front;
+    }
+
+    PACKED_RTREE<const FOOTPRINT*> m_front;
+    PACKED_RTREE<const FOOTPRINT*> m_back;
+    BOX2I                          m_area;      ///< Board edges; empty when there are none
+    int                            m_margin;
+    const FOOTPRINT*               m_ignored;
+};
+
+#endif // PCB_FREE_AREA_FINDER_H
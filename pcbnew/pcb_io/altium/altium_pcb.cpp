@@ -40,6 +40,7 @@
 #include <pcb_barcode.h>
 #include <core/profile.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <tools/pad_tool.h>
 #include <zone.h>
 
@@ -2891,6 +2892,19 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_PCB_COMPOUND_FILE&     aAltiumP
 
     ALTIUM_BINARY_PARSER reader( aAltiumPcbFile, aEntry );
 
+    // A poured polygon comes as many regions.  Collect the regions of each zone layer and merge
+    // them once at the end, on the thread pool, rather than merging every region into the fill
+    // built so far.
+    struct ZONE_LAYER_FILL
+    {
+        ZONE*          m_zone;
+        PCB_LAYER_ID   m_layer;
+        SHAPE_POLY_SET m_fill;
+    };
+
+    std::vector<ZONE_LAYER_FILL>                      fills;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, size_t> fillIndex;
+
     while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
     {
         checkpoint();
@@ -2927,7 +2941,17 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_PCB_COMPOUND_FILE&     aAltiumP
             linechain.Append( elem.outline.at( 0 ).position );
             linechain.SetClosed( true );
 
-            SHAPE_POLY_SET fill;
+            auto [it, inserted] = fillIndex.emplace( std::make_pair( zone, klayer ), fills.size() );
+
+            if( inserted )
+            {
+                fills.push_back( { zone, klayer, SHAPE_POLY_SET() } );
+
+                if( zone->HasFilledPolysForLayer( klayer ) )
+                    fills.back().m_fill = *zone->GetFill( klayer );
+            }
+
+            SHAPE_POLY_SET& fill = fills[it->second].m_fill;
             fill.AddOutline( linechain );
 
             for( const std::vector<ALTIUM_VERTICE>& hole : elem.holes )
@@ -2941,20 +2965,29 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_PCB_COMPOUND_FILE&     aAltiumP
                 hole_linechain.SetClosed( true );
                 fill.AddHole( hole_linechain );
             }
-
-            if( zone->HasFilledPolysForLayer( klayer ) )
-                fill.BooleanAdd( *zone->GetFill( klayer ) );
-
-            fill.Fracture();
-
-            zone->SetFilledPolysList( klayer, fill );
-            zone->SetIsFilled( true );
-            zone->SetNeedRefill( false );
         }
     }
 
     if( reader.GetRemainingBytes() != 0 )
         THROW_IO_ERROR( wxT( "Regions6 stream is not fully parsed" ) );
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), fills.size(),
+            [&]( size_t aIdx )
+            {
+                SHAPE_POLY_SET& fill = fills[aIdx].m_fill;
+
+                fill.Simplify();
+                fill.Fracture();
+            } ).wait();
+
+    for( ZONE_LAYER_FILL& zoneFill : fills )
+    {
+        zoneFill.m_zone->SetFilledPolysList( zoneFill.m_layer, zoneFill.m_fill );
+        zoneFill.m_zone->SetIsFilled( true );
+        zoneFill.m_zone->SetNeedRefill( false );
+    }
 }
 
 
@@ -55,10 +55,14 @@
  */
 static const wxChar traceIpc2581[] = wxT( "KICAD_IPC_2581" );
 
+// Amount of XML text collected before it is handed to the output stream
+static const size_t XML_WRITE_CHUNK = 1 << 20;
+
 
 PCB_IO_IPC2581::~PCB_IO_IPC2581()
 {
     clearLoadedFootprints();
+    delete m_xml_doc;
 }
 
 
@@ -124,19 +128,18 @@ void PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, wxXmlNode* aNode )
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
-
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_last_appended_node && m_last_appended_node->GetParent() == aParent
+            && m_last_appended_node->GetNext() == nullptr )
     {
         aNode->SetParent( aParent );
-        lastNode->SetNext( aNode );
+        m_last_appended_node->SetNext( aNode );
     }
     else
     {
         aParent->AddChild( aNode );
     }
 
-    lastNode = aNode;
+    m_last_appended_node = aNode;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aNode->GetName().size() + 5;
@@ -152,6 +155,139 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
 }
 
 
+static void appendEscaped( std::string& aBuffer, const wxString& aStr, bool aAttribute )
+{
+    const wxScopedCharBuffer utf8 = aStr.utf8_str();
+    const char*              str = utf8.data();
+
+    for( size_t ii = 0; ii < utf8.length(); ++ii )
+    {
+        switch( str[ii] )
+        {
+        case '&':  aBuffer += "&amp;";                      break;
+        case '<':  aBuffer += "&lt;";                       break;
+        case '>':  aBuffer += "&gt;";                       break;
+        case '\r': aBuffer += "&#xD;";                      break;
+        case '"':  aBuffer += aAttribute ? "&quot;" : "\""; break;
+        case '\t': aBuffer += aAttribute ? "&#x9;" : "\t";  break;
+        case '\n': aBuffer += aAttribute ? "&#xA;" : "\n";  break;
+        default:   aBuffer += str[ii];                      break;
+        }
+    }
+}
+
+
+void PCB_IO_IPC2581::writeNode( std::string& aBuffer, wxOutputStream* aStream,
+                                const wxXmlNode* aNode, int aDepth ) const
+{
+    if( auto it = m_flushed_nodes.find( aNode ); it != m_flushed_nodes.end() )
+    {
+        aBuffer += it->second;
+        return;
+    }
+
+    if( aNode->GetType() == wxXML_TEXT_NODE )
+    {
+        appendEscaped( aBuffer, aNode->GetContent(), false );
+        return;
+    }
+
+    // Same layout as wxXmlDocument::Save(): one element per line, indented by two spaces
+    aBuffer += '<';
+    aBuffer += aNode->GetName().utf8_str();
+
+    for( wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aBuffer += ' ';
+        aBuffer += attr->GetName().utf8_str();
+        aBuffer += "=\"";
+        appendEscaped( aBuffer, attr->GetValue(), true );
+        aBuffer += '"';
+    }
+
+    if( !aNode->GetChildren() )
+    {
+        aBuffer += "/>";
+    }
+    else
+    {
+        const wxXmlNode* last = nullptr;
+
+        aBuffer += '>';
+
+        for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+        {
+            if( child->GetType() != wxXML_TEXT_NODE )
+            {
+                aBuffer += '\n';
+                aBuffer.append( 2 * ( aDepth + 1 ), ' ' );
+            }
+
+            writeNode( aBuffer, aStream, child, aDepth + 1 );
+            last = child;
+        }
+
+        if( last->GetType() != wxXML_TEXT_NODE )
+        {
+            aBuffer += '\n';
+            aBuffer.append( 2 * aDepth, ' ' );
+        }
+
+        aBuffer += "</";
+        aBuffer += aNode->GetName().utf8_str();
+        aBuffer += '>';
+    }
+
+    if( aStream && aBuffer.size() >= XML_WRITE_CHUNK )
+    {
+        aStream->Write( aBuffer.data(), aBuffer.size() );
+        aBuffer.clear();
+    }
+}
+
+
+void PCB_IO_IPC2581::flushNode( wxXmlNode* aNode )
+{
+    int depth = 0;
+
+    for( const wxXmlNode* parent = aNode->GetParent();
+         parent && parent->GetType() == wxXML_ELEMENT_NODE; parent = parent->GetParent() )
+    {
+        depth++;
+    }
+
+    std::string text;
+    writeNode( text, nullptr, aNode, depth );
+    text.shrink_to_fit();
+    m_flushed_nodes.emplace( aNode, std::move( text ) );
+
+    wxXmlNode* child = aNode->GetChildren();
+    aNode->SetChildren( nullptr );
+
+    while( child )
+    {
+        wxXmlNode* next = child->GetNext();
+        delete child;
+        child = next;
+    }
+
+    // The last appended node was one of the children we just freed
+    m_last_appended_node = aNode;
+}
+
+
+bool PCB_IO_IPC2581::writeDocument( wxOutputStream& aStream ) const
+{
+    std::string buffer = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+    writeNode( buffer, &aStream, m_xml_root, 0 );
+    buffer += '\n';
+    aStream.Write( buffer.data(), buffer.size() );
+
+    return aStream.IsOk();
+}
+
+
 wxString PCB_IO_IPC2581::sanitizeId( const wxString& aStr ) const
 {
     wxString str;
@@ -2311,6 +2447,7 @@ void PCB_IO_IPC2581::pruneUnusedBackdrillSpecs()
             {
                 m_cad_header_node->RemoveChild( specNode );
                 delete specNode;
+                m_last_appended_node = nullptr;
             }
 
             it = m_backdrill_spec_nodes.erase( it );
@@ -3040,6 +3177,11 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
         {
             aStepNode->RemoveChild( layerNode );
             delete layerNode;
+            m_last_appended_node = nullptr;
+        }
+        else
+        {
+            flushNode( layerNode );
         }
     }
 }
@@ -3112,6 +3254,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
                 addBackdrillSpecRefs( holeNode, it->second );
             }
         }
+
+        flushNode( layerNode );
     }
 
     hole_count = 1;
@@ -3130,6 +3274,8 @@ void PCB_IO_IPC2581::generateLayerSetDrill( wxXmlNode* aLayerNode )
 
             addSlotCavity( padNode, *pad, wxString::Format( "SLOT%d", hole_count++ ) );
         }
+
+        flushNode( layerNode );
     }
 }
 
@@ -3517,6 +3663,8 @@ void PCB_IO_IPC2581::generateLayerSetAuxilliary( wxXmlNode* aStepNode )
                 addShape( padNode, shape );
             }
         }
+
+        flushNode( layerNode );
     }
 }
 
@@ -3676,6 +3824,10 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
             m_acceptable_chars.insert( c );
     }
 
+    delete m_xml_doc;
+    m_flushed_nodes.clear();
+    m_last_appended_node = nullptr;
+
     m_xml_doc = new wxXmlDocument();
     m_xml_root = generateXmlHeader();
 
@@ -3727,11 +3879,13 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
-    {
+    if( !writeDocument( out_stream ) )
         Report( _( "Failed to save IPC-2581 data to buffer." ), RPT_SEVERITY_ERROR );
-        return;
-    }
 
-    size_t size = out_stream.GetSize();
+    // Don't hold on to the document until the next export
+    delete m_xml_doc;
+    m_xml_doc = nullptr;
+    m_xml_root = nullptr;
+    m_last_appended_node = nullptr;
+    m_flushed_nodes.clear();
 }
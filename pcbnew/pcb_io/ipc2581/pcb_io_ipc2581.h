@@ -36,6 +36,8 @@
 #include <memory>
 #include <map>
 #include <set>
+#include <string>
+#include <unordered_map>
 
 class BOARD;
 class BOARD_ITEM;
@@ -73,6 +75,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_last_appended_node = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -282,6 +285,23 @@ private:
 
     void insertNodeAfter( wxXmlNode* aPrev, wxXmlNode* aNode );
 
+    /**
+     * Serialize a completed node and free its children.
+     *
+     * The LayerFeature nodes hold most of the document, and their text is much smaller than
+     * the node tree.  The text is copied to the file when the document is written.
+     */
+    void flushNode( wxXmlNode* aNode );
+
+    /**
+     * Append the XML text of \a aNode to \a aBuffer, handing the buffer to \a aStream
+     * whenever it grows large, if a stream is given.
+     */
+    void writeNode( std::string& aBuffer, wxOutputStream* aStream, const wxXmlNode* aNode,
+                    int aDepth ) const;
+
+    bool writeDocument( wxOutputStream& aStream ) const;
+
     void addLayerAttributes( wxXmlNode* aNode, PCB_LAYER_ID aLayer );
 
     bool isValidLayerFor2581( PCB_LAYER_ID aLayer );
@@ -307,18 +327,18 @@ private:
     std::vector<FOOTPRINT*> m_loaded_footprints;
     const std::map<std::string, UTF8>*  m_props;
 
-    std::map<size_t, wxString> m_user_shape_dict;   //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_user_node;   //<! Output XML node for reference shapes in UserDict
+    std::unordered_map<size_t, wxString> m_user_shape_dict; //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_user_node; //<! Output XML node for reference shapes in UserDict
 
-    std::map<size_t, wxString> m_std_shape_dict;    //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_std_node;    //<! Output XML node for reference shapes in StandardDict
+    std::unordered_map<size_t, wxString> m_std_shape_dict;  //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_std_node;  //<! Output XML node for reference shapes in StandardDict
 
-    std::map<size_t, wxString> m_line_dict;         //<! Map between line hash values and reference id string
-    wxXmlNode*                 m_line_node;         //<! Output XML node for reference lines in LineDict
+    std::unordered_map<size_t, wxString> m_line_dict;       //<! Map between line hash values and reference id string
+    wxXmlNode*                           m_line_node;       //<! Output XML node for reference lines in LineDict
 
-    std::map<size_t, wxString> m_padstack_dict;     //<! Map between padstack hash values and reference id string (PADSTACK_##)
-    std::vector<wxXmlNode*>    m_padstacks;         //<! Holding vector for padstacks.  These need to be inserted prior to the components
-    wxXmlNode*                 m_last_padstack;     //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
+    std::unordered_map<size_t, wxString> m_padstack_dict;   //<! Map between padstack hash values and reference id string (PADSTACK_##)
+    std::vector<wxXmlNode*>              m_padstacks;       //<! Holding vector for padstacks.  These need to be inserted prior to the components
+    wxXmlNode*                           m_last_padstack;   //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
 
     std::map<wxString, std::pair<wxString, wxString>> m_padstack_backdrill_specs;
     std::map<wxString, wxXmlNode*>                    m_backdrill_spec_nodes;
@@ -326,7 +346,7 @@ private:
     int                                               m_backdrill_spec_index;
     wxXmlNode*                                        m_cad_header_node;
 
-    std::map<size_t, wxString>
+    std::unordered_map<size_t, wxString>
             m_footprint_dict; //<! Map between the footprint hash values and reference id string (<fpid>_##)
 
     std::map<wxString, FOOTPRINT*>
@@ -362,6 +382,9 @@ private:
 
     wxXmlDocument*          m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_last_appended_node;   //<! Last node added by appendNode()
+
+    std::map<const wxXmlNode*, std::string> m_flushed_nodes; //<! XML text of nodes freed by flushNode()
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
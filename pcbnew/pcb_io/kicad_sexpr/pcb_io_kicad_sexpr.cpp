@@ -22,12 +22,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
+#include <chrono>
+
 #include <wx/dir.h>
 #include <wx/ffile.h>
 #include <wx/log.h>
 #include <wx/msgdlg.h>
 #include <wx/mstream.h>
 
+#include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <callback_gal.h>
@@ -37,6 +41,7 @@
 #include <font/fontconfig.h>
 #include <footprint.h>
 #include <io/kicad/kicad_io_utils.h>
+#include <kiplatform/io.h>
 #include <kiface_base.h>
 #include <layer_range.h>
 #include <macros.h>
@@ -46,6 +51,7 @@
 #include <pcb_group.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_sidecar.h>
 #include <pcb_point.h>
 #include <pcb_reference_image.h>
 #include <pcb_barcode.h>
@@ -61,6 +67,7 @@
 #include <progress_reporter.h>
 #include <reporter.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <trace_helpers.h>
 #include <wildcards_and_files_ext.h>
 #include <zone.h>
@@ -72,13 +79,83 @@
 
 using namespace PCB_KEYS_T;
 
+// Boards with fewer tracks and zones than this are not worth formatting concurrently.
+constexpr size_t MIN_CONCURRENT_ITEMS = 1000;
+
+// The fewest items formatted by each task when formatting concurrently.
+constexpr size_t MIN_ITEMS_PER_CHUNK = 100;
+
 
 FP_CACHE_ENTRY::FP_CACHE_ENTRY( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_deferred( false )
+{ }
+
+
+FP_CACHE_ENTRY::FP_CACHE_ENTRY( const FOOTPRINT_SUMMARY& aSummary,
+                                const WX_FILENAME& aFileName ) :
+        m_filename( aFileName ),
+        m_summary( aSummary ),
+        m_deferred( true )
 { }
 
 
+std::unique_ptr<FOOTPRINT>& FP_CACHE_ENTRY::GetFootprint()
+{
+    std::lock_guard<std::mutex> lock( m_parseMutex );
+
+    if( m_deferred )
+    {
+        m_deferred = false;
+
+        try
+        {
+            FILE_LINE_READER          reader( m_filename.GetFullPath() );
+            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+            BOARD_ITEM*               item = parser.Parse();
+
+            m_footprint.reset( dynamic_cast<FOOTPRINT*>( item ) );
+
+            if( m_footprint )
+                m_footprint->SetFPID( LIB_ID( wxEmptyString, m_filename.GetName() ) );
+            else
+                delete item;
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Unable to read file '%s': %s" ),
+                        m_filename.GetFullPath(), ioe.What() );
+        }
+    }
+
+    return m_footprint;
+}
+
+
+/**
+ * Read the library properties of a footprint file without parsing the footprint.
+ */
+static std::optional<FOOTPRINT_SUMMARY> scanFootprintFile( const wxString& aFileName )
+{
+    try
+    {
+        MAPPED_FILE_LINE_READER   reader( aFileName );
+        PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+        FOOTPRINT_SUMMARY         summary;
+
+        if( parser.ParseFootprintSummary( summary ) )
+            return summary;
+    }
+    catch( const IO_ERROR& )
+    {
+        // The file gets parsed right away then, which reports the error
+    }
+
+    return std::nullopt;
+}
+
+
 FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
 {
     m_owner = aOwner;
@@ -89,10 +166,8 @@ FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
 }
 
 
-void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
+void FP_CACHE::checkWritable()
 {
-    m_cache_timestamp = 0;
-
     if( !m_lib_path.DirExists() && !m_lib_path.Mkdir() )
     {
         THROW_IO_ERROR( wxString::Format( _( "Cannot create footprint library '%s'." ),
@@ -104,38 +179,55 @@ void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
         THROW_IO_ERROR( wxString::Format( _( "Footprint library '%s' is read only." ),
                                           m_lib_raw_path ) );
     }
+}
+
+
+void FP_CACHE::saveEntry( PCB_IO_KICAD_SEXPR* aIO, FP_CACHE_ENTRY* aEntry )
+{
+    std::unique_ptr<FOOTPRINT>& footprint = aEntry->GetFootprint();
+
+    // If we've requested to embed the fonts in the footprint, do so.  Otherwise, clear the
+    // embedded fonts from the footprint.  Embedded fonts will be used if available.
+    if( footprint->GetAreFontsEmbedded() )
+        footprint->EmbedFonts();
+    else
+        footprint->GetEmbeddedFiles()->ClearEmbeddedFonts();
+
+    wxString fileName = aEntry->GetFileName().GetFullPath();
+
+    wxLogTrace( traceKicadPcbPlugin, wxT( "Writing library file '%s'." ), fileName );
+
+    // Allow file output stream to go out of scope to close the file stream before
+    // renaming the file.
+    PRETTIFIED_FILE_OUTPUTFORMATTER formatter( fileName );
+
+    aIO->SetOutputFormatter( &formatter );
+    aIO->Format( footprint.get() );
+}
+
+
+void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
+{
+    m_cache_timestamp = 0;
+
+    checkWritable();
 
     for( auto it = m_footprints.begin(); it != m_footprints.end(); ++it )
     {
-        FP_CACHE_ENTRY*             fpCacheEntry = it->second;
-        std::unique_ptr<FOOTPRINT>& footprint = fpCacheEntry->GetFootprint();
+        FP_CACHE_ENTRY* fpCacheEntry = it->second;
 
-        if( aFootprintFilter && footprint.get() != aFootprintFilter )
+        // A footprint which was never parsed can't be the one to save
+        if( aFootprintFilter && !fpCacheEntry->IsParsed() )
             continue;
 
-        // If we've requested to embed the fonts in the footprint, do so.  Otherwise, clear the
-        // embedded fonts from the footprint.  Embedded fonts will be used if available.
-        if( footprint->GetAreFontsEmbedded() )
-            footprint->EmbedFonts();
-        else
-            footprint->GetEmbeddedFiles()->ClearEmbeddedFonts();
-
-        WX_FILENAME fn = fpCacheEntry->GetFileName();
-        wxString    fileName = fn.GetFullPath();
-
-        // Allow file output stream to go out of scope to close the file stream before
-        // renaming the file.
-        {
-            wxLogTrace( traceKicadPcbPlugin, wxT( "Writing library file '%s'." ),
-                        fileName );
+        std::unique_ptr<FOOTPRINT>& footprint = fpCacheEntry->GetFootprint();
 
-            PRETTIFIED_FILE_OUTPUTFORMATTER formatter( fileName );
+        if( !footprint || ( aFootprintFilter && footprint.get() != aFootprintFilter ) )
+            continue;
 
-            m_owner->SetOutputFormatter( &formatter );
-            m_owner->Format( footprint.get() );
-        }
+        saveEntry( m_owner, fpCacheEntry );
 
-        m_cache_timestamp += fn.GetTimestamp();
+        m_cache_timestamp += fpCacheEntry->GetFileName().GetTimestamp();
     }
 
     if( m_lib_path.IsFileReadable() && m_lib_path.GetModificationTime().IsValid() )
@@ -147,7 +239,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprintFilter )
 }
 
 
-void FP_CACHE::Load()
+void FP_CACHE::Load( bool aDeferParsing )
 {
     m_cache_dirty = false;
     m_cache_timestamp = 0;
@@ -176,6 +268,17 @@ void FP_CACHE::Load()
         {
             fn.SetFullName( fullName );
 
+            if( aDeferParsing )
+            {
+                if( std::optional<FOOTPRINT_SUMMARY> summary = scanFootprintFile( fn.GetFullPath() ) )
+                {
+                    wxString fpName = fn.GetName();
+
+                    m_footprints.insert( fpName, new FP_CACHE_ENTRY( *summary, fn ) );
+                    continue;
+                }
+            }
+
             // Queue I/O errors so only files that fail to parse don't get loaded.
             try
             {
@@ -246,6 +349,109 @@ bool FP_CACHE::IsPath( const wxString& aPath ) const
 }
 
 
+int FP_CACHE::Upgrade( bool aForce, const wxString& aNewPath, PROGRESS_REPORTER* aProgressReporter )
+{
+    std::vector<FP_CACHE_ENTRY*> entries;
+
+    for( auto it = m_footprints.begin(); it != m_footprints.end(); ++it )
+        entries.push_back( it->second );
+
+    std::vector<wxString> errors( entries.size() );
+    std::vector<char>     needsSave( entries.size(), 0 );
+    thread_pool&          tp = GetKiCadThreadPool();
+
+    if( aProgressReporter )
+        aProgressReporter->SetMaxProgress( static_cast<int>( entries.size() * 2 ) );
+
+    auto waitFor =
+            [&]( auto& aFutures )
+            {
+                while( !aFutures.wait_for( std::chrono::milliseconds( 100 ) ) )
+                {
+                    if( aProgressReporter )
+                        aProgressReporter->KeepRefreshing();
+                }
+            };
+
+    // Entries parse under their own lock, so the files can be read in any order
+    auto parsed = tp.submit_loop( size_t( 0 ), entries.size(),
+            [&]( size_t aIdx )
+            {
+                const std::unique_ptr<FOOTPRINT>& footprint = entries[aIdx]->GetFootprint();
+
+                if( !footprint )
+                {
+                    errors[aIdx] = wxString::Format( _( "Unable to read file '%s'" ),
+                                                     entries[aIdx]->GetFileName().GetFullPath() );
+                }
+                else if( aForce || !aNewPath.IsEmpty()
+                         || footprint->GetFileFormatVersionAtLoad() < SEXPR_BOARD_FILE_VERSION )
+                {
+                    needsSave[aIdx] = 1;
+                }
+
+                if( aProgressReporter )
+                    aProgressReporter->AdvanceProgress();
+            } );
+
+    waitFor( parsed );
+
+    int toSave = static_cast<int>( std::count( needsSave.begin(), needsSave.end(), 1 ) );
+
+    if( toSave > 0 )
+    {
+        if( !aNewPath.IsEmpty() )
+            SetPath( aNewPath );
+
+        checkWritable();
+
+        // The plugin holds the output formatter, so each footprint is formatted by its own
+        auto saved = tp.submit_loop( size_t( 0 ), entries.size(),
+                [&]( size_t aIdx )
+                {
+                    if( needsSave[aIdx] )
+                    {
+                        try
+                        {
+                            PCB_IO_KICAD_SEXPR io( m_owner->m_ctl );
+                            saveEntry( &io, entries[aIdx] );
+                        }
+                        catch( const IO_ERROR& ioe )
+                        {
+                            errors[aIdx] = ioe.What();
+                            needsSave[aIdx] = 0;
+                        }
+                    }
+
+                    if( aProgressReporter )
+                        aProgressReporter->AdvanceProgress();
+                } );
+
+        waitFor( saved );
+
+        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+    }
+
+    wxString errorMsg;
+
+    for( const wxString& error : errors )
+    {
+        if( error.IsEmpty() )
+            continue;
+
+        if( !errorMsg.IsEmpty() )
+            errorMsg += wxT( "\n" );
+
+        errorMsg += error;
+    }
+
+    if( !errorMsg.IsEmpty() )
+        THROW_IO_ERROR( errorMsg );
+
+    return static_cast<int>( std::count( needsSave.begin(), needsSave.end(), 1 ) );
+}
+
+
 void FP_CACHE::SetPath( const wxString& aPath )
 {
     m_lib_raw_path = aPath;
@@ -335,6 +541,20 @@ void PCB_IO_KICAD_SEXPR::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     m_out->Finish();
 
     m_out = nullptr;
+
+    if( ADVANCED_CFG::GetCfg().m_BoardFillSidecar )
+    {
+        // The snapshot is only a cache: failing to write it doesn't fail the save
+        wxString                    sidecarName = PCB_IO_KICAD_SEXPR_SIDECAR::FileNameFor( aFileName );
+        KIPLATFORM::IO::MAPPED_FILE saved( aFileName );
+        std::string_view            savedText( saved.Data(), saved.Size() );
+
+        if( !saved.IsMapped() || !PCB_IO_KICAD_SEXPR_SIDECAR::Write( sidecarName, savedText, aBoard ) )
+        {
+            wxLogTrace( traceKicadPcbPlugin, wxT( "Unable to write zone fill snapshot '%s'." ),
+                        sidecarName );
+        }
+    }
 }
 
 
@@ -822,13 +1042,15 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
 
     // Do not save PCB_MARKERs, they can be regenerated easily.
 
-    // Save the tracks and vias.
-    for( PCB_TRACK* track : sorted_tracks )
-        Format( track );
+    // Save the tracks and vias, then the polygon (which are the newer technology) zones.
+    std::vector<const BOARD_ITEM*> tracksAndZones( sorted_tracks.begin(), sorted_tracks.end() );
+    tracksAndZones.insert( tracksAndZones.end(), sorted_zones.begin(), sorted_zones.end() );
 
-    // Save the polygon (which are the newer technology) zones.
-    for( auto zone : sorted_zones )
-        Format( zone );
+    if( !formatConcurrently( tracksAndZones ) )
+    {
+        for( const BOARD_ITEM* item : tracksAndZones )
+            Format( item );
+    }
 
     // Save the groups
     for( BOARD_ITEM* group : sorted_groups )
@@ -865,6 +1087,75 @@ void PCB_IO_KICAD_SEXPR::format( const BOARD* aBoard ) const
 }
 
 
+bool PCB_IO_KICAD_SEXPR::formatConcurrently( const std::vector<const BOARD_ITEM*>& aItems ) const
+{
+    PRETTIFIED_FILE_OUTPUTFORMATTER* out = dynamic_cast<PRETTIFIED_FILE_OUTPUTFORMATTER*>( m_out );
+
+    if( !out || aItems.size() < MIN_CONCURRENT_ITEMS || !ADVANCED_CFG::GetCfg().m_ParallelBoardSave
+            || BS::this_thread::get_pool().has_value() )
+    {
+        return false;
+    }
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       chunkCount = std::min( aItems.size() / MIN_ITEMS_PER_CHUNK,
+                                        tp.get_thread_count() * 4 );
+
+    if( chunkCount < 2 )
+        return false;
+
+    struct CHUNK
+    {
+        std::string        m_text;
+        std::exception_ptr m_error;
+    };
+
+    std::vector<CHUNK> chunks( chunkCount );
+
+    // Each chunk is formatted and prettified on its own, so that the file formatter only has to
+    // append it.  Only items which don't touch shared state (text variables, fonts) go here.
+    auto formatChunk =
+            [&]( const int ii )
+            {
+                CHUNK& chunk = chunks[ii];
+                size_t begin = aItems.size() * ii / chunkCount;
+                size_t end = aItems.size() * ( ii + 1 ) / chunkCount;
+
+                try
+                {
+                    PCB_IO_KICAD_SEXPR io( m_ctl );
+                    STRING_FORMATTER   formatter;
+
+                    io.m_board = m_board;
+                    io.SetOutputFormatter( &formatter );
+
+                    for( size_t jj = begin; jj < end; ++jj )
+                        io.Format( aItems[jj] );
+
+                    chunk.m_text = std::move( formatter.MutableString() );
+                    KICAD_FORMAT::PrettifyPart( chunk.m_text, KICAD_FORMAT::PRETTIFY_PART::ITEMS,
+                                                out->GetFormatMode() );
+                }
+                catch( ... )
+                {
+                    chunk.m_error = std::current_exception();
+                }
+            };
+
+    tp.submit_loop( 0, chunkCount, formatChunk ).wait();
+
+    for( CHUNK& chunk : chunks )
+    {
+        if( chunk.m_error )
+            std::rethrow_exception( chunk.m_error );
+
+        out->WritePrettified( std::move( chunk.m_text ) );
+    }
+
+    return true;
+}
+
+
 void PCB_IO_KICAD_SEXPR::format( const PCB_DIMENSION_BASE* aDimension ) const
 {
     const PCB_DIM_ALIGNED*    aligned = dynamic_cast<const PCB_DIM_ALIGNED*>( aDimension );
@@ -3037,6 +3328,7 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE_LAYER_PROPERTIES& aZoneLayerProperti
 
 PCB_IO_KICAD_SEXPR::PCB_IO_KICAD_SEXPR( int aControlFlags ) : PCB_IO( wxS( "KiCad" ) ),
     m_cache( nullptr ),
+    m_fillSidecar( nullptr ),
     m_ctl( aControlFlags )
 {
     init( nullptr );
@@ -3054,7 +3346,19 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
                                       const std::map<std::string, UTF8>* aProperties,
                                       PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    // Boards are parsed straight from a mapping of the file, which spares copying every line
+    // and most numbers.  Files which can't be mapped (e.g. empty ones) are read as usual.
+    std::unique_ptr<MAPPED_FILE_LINE_READER> mappedReader;
+    std::unique_ptr<FILE_LINE_READER>        fileReader;
+
+    try
+    {
+        mappedReader = std::make_unique<MAPPED_FILE_LINE_READER>( aFileName );
+    }
+    catch( const IO_ERROR& )
+    {
+        fileReader = std::make_unique<FILE_LINE_READER>( aFileName );
+    }
 
     unsigned lineCount = 0;
 
@@ -3068,13 +3372,47 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open canceled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
+        if( mappedReader )
+        {
+            lineCount = mappedReader->CountLines();
+        }
+        else
+        {
+            while( fileReader->ReadLine() )
+                lineCount++;
+
+            fileReader->Rewind();
+        }
+    }
+
+    LINE_READER& reader = mappedReader ? static_cast<LINE_READER&>( *mappedReader )
+                                       : static_cast<LINE_READER&>( *fileReader );
 
-        reader.Rewind();
+    // Appending resets the UUIDs the snapshot is keyed by
+    PCB_IO_KICAD_SEXPR_SIDECAR sidecar;
+
+    if( ADVANCED_CFG::GetCfg().m_BoardFillSidecar && mappedReader && !aAppendToMe
+            && sidecar.Open( PCB_IO_KICAD_SEXPR_SIDECAR::FileNameFor( aFileName ),
+                             mappedReader->Text() ) )
+    {
+        wxLogTrace( traceKicadPcbPlugin, wxT( "Using the zone fill snapshot of '%s'." ),
+                    aFileName );
+        m_fillSidecar = &sidecar;
+    }
+
+    BOARD* board = nullptr;
+
+    try
+    {
+        board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    }
+    catch( ... )
+    {
+        m_fillSidecar = nullptr;
+        throw;
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    m_fillSidecar = nullptr;
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
@@ -3094,6 +3432,8 @@ BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe,
                                       aProgressReporter, aLineCount );
     BOARD* board;
 
+    parser.SetFillSidecar( m_fillSidecar );
+
     try
     {
         board = dynamic_cast<BOARD*>( parser.Parse() );
@@ -3140,7 +3480,7 @@ void PCB_IO_KICAD_SEXPR::validateCache( const wxString& aLibraryPath, bool check
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
-        m_cache->Load();
+        m_cache->Load( true );
     }
 }
 
@@ -3207,6 +3547,32 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::GetEnumeratedFootprint( const wxString& aLi
 }
 
 
+bool PCB_IO_KICAD_SEXPR::GetFootprintSummary( const wxString& aLibraryPath,
+                                              const wxString& aFootprintName,
+                                              FOOTPRINT_SUMMARY& aSummary,
+                                              const std::map<std::string, UTF8>* aProperties )
+{
+    init( aProperties );
+
+    try
+    {
+        validateCache( aLibraryPath, false );
+    }
+    catch( const IO_ERROR& )
+    {
+        // do nothing with the error
+    }
+
+    auto it = m_cache->GetFootprints().find( aFootprintName );
+
+    if( it == m_cache->GetFootprints().end() || !it->second->GetSummary() )
+        return false;
+
+    aSummary = *it->second->GetSummary();
+    return true;
+}
+
+
 bool PCB_IO_KICAD_SEXPR::FootprintExists( const wxString& aLibraryPath,
                                           const wxString& aFootprintName,
                                           const std::map<std::string, UTF8>* aProperties )
@@ -30,6 +30,7 @@
 #include <ctl_flags.h>
 
 #include <richio.h>
+#include <mutex>
 #include <string>
 #include <optional>
 #include <layer_ids.h>
@@ -44,6 +45,7 @@ class BOARD_ITEM;
 class FP_CACHE;
 class LSET;
 class PCB_IO_KICAD_SEXPR_PARSER;
+class PCB_IO_KICAD_SEXPR_SIDECAR;
 class BOARD_DESIGN_SETTINGS;
 class PCB_DIMENSION_BASE;
 class PCB_POINT;
@@ -230,15 +232,32 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
  */
 class FP_CACHE_ENTRY
 {
-    WX_FILENAME                m_filename;
-    std::unique_ptr<FOOTPRINT> m_footprint;
+    WX_FILENAME                      m_filename;
+    std::unique_ptr<FOOTPRINT>       m_footprint;
+    std::optional<FOOTPRINT_SUMMARY> m_summary;    ///< Only for entries parsed on demand
+    bool                             m_deferred;   ///< The file wasn't parsed yet
+    std::mutex                       m_parseMutex;
 
 public:
     FP_CACHE_ENTRY( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
 
+    /**
+     * An entry whose footprint file is only parsed the first time the footprint is needed.
+     */
+    FP_CACHE_ENTRY( const FOOTPRINT_SUMMARY& aSummary, const WX_FILENAME& aFileName );
+
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
-    std::unique_ptr<FOOTPRINT>& GetFootprint() { return m_footprint; }
+
+    /**
+     * @return the footprint, after parsing its file if it was deferred.  Empty if the deferred
+     *         file couldn't be parsed.
+     */
+    std::unique_ptr<FOOTPRINT>& GetFootprint();
+
+    bool IsParsed() const { return !m_deferred; }
+
+    const std::optional<FOOTPRINT_SUMMARY>& GetSummary() const { return m_summary; }
 };
 
 class FP_CACHE
@@ -277,7 +296,29 @@ public:
      */
     void Save( FOOTPRINT* aFootprintFilter = nullptr );
 
-    void Load();
+    /**
+     * Read the footprint files of the library.
+     *
+     * @param aDeferParsing only read the library properties of the footprints which allow it,
+     *                      and parse them when they are first needed.
+     */
+    void Load( bool aDeferParsing = false );
+
+    /**
+     * Rewrite the footprints of the library in the current file format.
+     *
+     * The footprints are parsed, then written, on the thread pool; load the library with
+     * deferred parsing first so that the files are only parsed here.  Footprints already in
+     * the current format are not written unless \a aForce is set or the library is written to
+     * \a aNewPath.
+     *
+     * @param aNewPath if not empty, the path of a new library receiving all the footprints.
+     * @return the number of footprints written.
+     * @throw IO_ERROR if some footprints could not be read or written.  The other footprints
+     *                 are still written.
+     */
+    int Upgrade( bool aForce, const wxString& aNewPath = wxEmptyString,
+                 PROGRESS_REPORTER* aProgressReporter = nullptr );
 
     void Remove( const wxString& aFootprintName );
 
@@ -307,6 +348,13 @@ public:
     bool IsPath( const wxString& aPath ) const;
 
     void SetPath( const wxString& aPath );
+
+private:
+    /// Check that the library directory exists or can be created, and can be written.
+    void checkWritable();
+
+    /// Write the footprint of \a aEntry to its file using the formatter of \a aIO.
+    static void saveEntry( PCB_IO_KICAD_SEXPR* aIO, FP_CACHE_ENTRY* aEntry );
 };
 
 
@@ -364,6 +412,10 @@ public:
                                              const std::map<std::string,
                                              UTF8>* aProperties = nullptr ) override;
 
+    bool GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                              FOOTPRINT_SUMMARY& aSummary,
+                              const std::map<std::string, UTF8>* aProperties = nullptr ) override;
+
     bool FootprintExists( const wxString& aLibraryPath, const wxString& aFootprintName,
                           const std::map<std::string, UTF8>* aProperties = nullptr ) override;
 
@@ -448,6 +500,13 @@ protected:
 private:
     void format( const BOARD* aBoard ) const;
 
+    /**
+     * Format a long run of items on the thread pool when writing to a prettified file.
+     *
+     * @return false if the items were not formatted and must be formatted sequentially.
+     */
+    bool formatConcurrently( const std::vector<const BOARD_ITEM*>& aItems ) const;
+
     void format( const PCB_DIMENSION_BASE* aDimension ) const;
 
     void format( const PCB_REFERENCE_IMAGE* aBitmap ) const;
@@ -498,6 +557,8 @@ protected:
     LINE_READER*           m_reader;     ///< no ownership
     wxString               m_filename;   ///< for saves only, name is in m_reader for loads
 
+    const PCB_IO_KICAD_SEXPR_SIDECAR* m_fillSidecar;   ///< for loads only, no ownership
+
     STRING_FORMATTER       m_sf;
     OUTPUTFORMATTER*       m_out;        ///< output any Format()s to this, no ownership
     int                    m_ctl;
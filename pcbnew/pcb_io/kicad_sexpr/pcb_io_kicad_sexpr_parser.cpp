@@ -65,6 +65,7 @@
 #include <pcb_plot_params.h>
 #include <zones.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_sidecar.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
 #include <math/util.h>                           // KiROUND, Clamp
 #include <string_utils.h>
@@ -74,6 +75,9 @@
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
 #include <trace_helpers.h>
+#include <advanced_config.h>
+#include <richio.h>
+#include <thread_pool.h>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code. Needed for PCB_REFERENCE_IMAGE
@@ -93,6 +97,174 @@ constexpr double INT_LIMIT = std::numeric_limits<int>::max() - 10;
 
 using namespace PCB_KEYS_T;
 
+// Runs of fewer item records than this are not worth parsing concurrently.
+constexpr size_t MIN_CONCURRENT_RECORDS = 1000;
+
+// The fewest item records given to each parser of a concurrently parsed run.
+constexpr size_t MIN_RECORDS_PER_PART = 100;
+
+
+namespace
+{
+
+/**
+ * A top level record of a board file, as found by parseItemsConcurrently().
+ */
+struct BOARD_RECORD
+{
+    size_t   m_begin;   ///< Offset of the opening parenthesis
+    size_t   m_end;     ///< Offset after the closing parenthesis
+    unsigned m_line;    ///< Line number of m_begin
+};
+
+
+bool isBlank( char cc )
+{
+    return cc == ' ' || cc == '\t' || cc == '\r' || cc == '\n' || cc == '\0';
+}
+
+
+bool isBoardItemToken( int aToken )
+{
+    switch( aToken )
+    {
+    case T_gr_arc:
+    case T_gr_curve:
+    case T_gr_line:
+    case T_gr_poly:
+    case T_gr_circle:
+    case T_gr_rect:
+    case T_image:
+    case T_barcode:
+    case T_gr_text:
+    case T_gr_text_box:
+    case T_table:
+    case T_dimension:
+    case T_module:
+    case T_footprint:
+    case T_segment:
+    case T_arc:
+    case T_via:
+    case T_zone:
+    case T_target:
+    case T_point:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/**
+ * Move @a aPos from the opening parenthesis of a record to after its closing one, counting
+ * lines in @a aLine.  Quoted strings and comment lines are skipped as the lexer does.
+ *
+ * @return false if the record isn't terminated.
+ */
+bool skipRecord( std::string_view aText, size_t& aPos, unsigned& aLine )
+{
+    int  depth = 0;
+    bool lineStart = false;
+
+    while( aPos < aText.size() )
+    {
+        char cc = aText[aPos++];
+
+        if( cc == '\n' )
+        {
+            aLine++;
+            lineStart = true;
+            continue;
+        }
+
+        if( isBlank( cc ) )
+            continue;
+
+        if( cc == '#' && lineStart )
+        {
+            while( aPos < aText.size() && aText[aPos] != '\n' )
+                aPos++;
+
+            continue;
+        }
+
+        lineStart = false;
+
+        if( cc == '(' )
+        {
+            depth++;
+        }
+        else if( cc == ')' )
+        {
+            if( --depth == 0 )
+                return true;
+        }
+        else if( cc == '"' )
+        {
+            // Quoted strings end on their own line and may contain escaped quotes
+            while( aPos < aText.size() && aText[aPos] != '"' )
+            {
+                if( aText[aPos] == '\n' )
+                    return false;
+
+                if( aText[aPos] == '\\' && aPos + 1 < aText.size() && aText[aPos + 1] != '\n' )
+                    aPos++;
+
+                aPos++;
+            }
+
+            if( aPos >= aText.size() )
+                return false;
+
+            aPos++;
+        }
+    }
+
+    return false;
+}
+
+
+/**
+ * Move @a aPos over blanks and comment lines, counting lines in @a aLine.
+ */
+void skipBlanks( std::string_view aText, size_t& aPos, unsigned& aLine )
+{
+    bool lineStart = false;
+
+    while( aPos < aText.size() )
+    {
+        if( aText[aPos] == '\n' )
+        {
+            aLine++;
+            lineStart = true;
+        }
+        else if( aText[aPos] == '#' && lineStart )
+        {
+            while( aPos < aText.size() && aText[aPos] != '\n' )
+                aPos++;
+
+            continue;
+        }
+        else if( !isBlank( aText[aPos] ) )
+        {
+            return;
+        }
+
+        aPos++;
+    }
+}
+
+} // namespace
+
+
+PCB_IO_KICAD_SEXPR_PARSER::~PCB_IO_KICAD_SEXPR_PARSER()
+{
+    // Nets of a part of the board which failed to parse and never made it to the board
+    for( NETINFO_ITEM* net : m_pendingNets )
+        delete net;
+}
+
 
 void PCB_IO_KICAD_SEXPR_PARSER::init()
 {
@@ -183,6 +355,50 @@ void PCB_IO_KICAD_SEXPR_PARSER::skipCurrent()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::skipCurrentRecord()
+{
+    STRING_VIEW_LINE_READER* viewReader = dynamic_cast<STRING_VIEW_LINE_READER*>( reader );
+
+    if( !viewReader )
+    {
+        skipCurrent();
+        return;
+    }
+
+    std::string_view text = viewReader->Text();
+
+    // The keyword of the record was just read; its parenthesis is before it on the same line
+    const char* cp = start + curOffset;
+
+    while( cp > start && isBlank( cp[-1] ) )
+        --cp;
+
+    if( cp == start || cp[-1] != '(' )
+    {
+        skipCurrent();
+        return;
+    }
+
+    size_t   pos = ( cp - 1 ) - text.data();
+    unsigned line = CurLineNumber();
+
+    if( !skipRecord( text, pos, line ) )
+    {
+        skipCurrent();
+        return;
+    }
+
+    // Continue lexing after the closing parenthesis
+    size_t lineStart = text.rfind( '\n', pos - 1 );
+
+    lineStart = ( lineStart == std::string_view::npos ) ? 0 : lineStart + 1;
+
+    viewReader->SetPosition( lineStart, line );
+    readLine();
+    next = text.data() + pos;
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::pushValueIntoMap( int aIndex, int aValue )
 {
     // Add aValue in netcode mapping (m_netCodes) at index aNetCode
@@ -325,18 +541,34 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseNet( BOARD_CONNECTED_ITEM* aItem )
         if( m_requiredVersion < 20210606 )
             netName = ConvertToNewOverbarNotation( netName );
 
-        NETINFO_ITEM* netinfo = m_board->FindNet( netName );
+        aItem->SetNet( findOrCreateNet( netName ) );
+    }
+
+    NeedRIGHT();
+}
+
+
+NETINFO_ITEM* PCB_IO_KICAD_SEXPR_PARSER::findOrCreateNet( const wxString& aName )
+{
+    if( NETINFO_ITEM* netinfo = m_board->FindNet( aName ) )
+        return netinfo;
+
+    if( m_deferBoardChanges )
+    {
+        NETINFO_ITEM*& netinfo = m_pendingNetsByName[aName];
 
         if( !netinfo )
         {
-            netinfo = new NETINFO_ITEM( m_board, netName );
-            m_board->Add( netinfo, ADD_MODE::INSERT, true );
+            netinfo = new NETINFO_ITEM( m_board, aName );
+            m_pendingNets.push_back( netinfo );
         }
 
-        aItem->SetNet( netinfo );
+        return netinfo;
     }
 
-    NeedRIGHT();
+    NETINFO_ITEM* netinfo = new NETINFO_ITEM( m_board, aName );
+    m_board->Add( netinfo, ADD_MODE::INSERT, true );
+    return netinfo;
 }
 
 
@@ -1036,6 +1268,127 @@ bool PCB_IO_KICAD_SEXPR_PARSER::IsValidBoardHeader()
 }
 
 
+bool PCB_IO_KICAD_SEXPR_PARSER::ParseFootprintSummary( FOOTPRINT_SUMMARY& aSummary )
+{
+    // See Parse()
+    std::unique_ptr<wxArrayString> initial_comments( ReadCommentLines() );
+
+    if( CurTok() != T_LEFT )
+        return false;
+
+    T token = NextTok();
+
+    if( token != T_footprint && token != T_module )
+        return false;
+
+    NeedSYMBOLorNUMBER();
+
+    std::set<wxString> padNumbers;
+
+    aSummary = FOOTPRINT_SUMMARY();
+
+    // Same numbers as FOOTPRINT::GetPadCount() and GetUniquePadCount() without NPTH pads
+    auto parsePad =
+            [&]()
+            {
+                NeedSYMBOLorNUMBER();
+                wxString number = FromUTF8();
+
+                token = NextTok();
+
+                if( token != T_thru_hole && token != T_smd && token != T_connect
+                        && token != T_np_thru_hole )
+                {
+                    return false;
+                }
+
+                bool npth = token == T_np_thru_hole;
+                bool onCopper = false;
+
+                for( token = NextTok(); token != T_RIGHT; token = NextTok() )
+                {
+                    if( token == T_EOF )
+                        return false;
+
+                    if( token != T_LEFT )
+                        continue;
+
+                    if( NextTok() != T_layers )
+                    {
+                        skipCurrentRecord();
+                        continue;
+                    }
+
+                    for( token = NextTok(); token != T_RIGHT; token = NextTok() )
+                    {
+                        if( token == T_EOF )
+                            return false;
+
+                        if( FromUTF8().EndsWith( wxT( ".Cu" ) ) )
+                            onCopper = true;
+                    }
+                }
+
+                if( !npth )
+                {
+                    aSummary.m_padCount++;
+
+                    if( onCopper && !number.IsEmpty() )
+                        padNumbers.insert( number );
+                }
+
+                return true;
+            };
+
+    for( token = NextTok(); token != T_RIGHT; token = NextTok() )
+    {
+        if( token == T_EOF )
+            return false;
+
+        if( token != T_LEFT )
+            continue;
+
+        switch( NextTok() )
+        {
+        case T_version:
+            m_requiredVersion = parseInt( FromUTF8().mb_str( wxConvUTF8 ) );
+            NeedRIGHT();
+
+            if( m_requiredVersion > SEXPR_BOARD_FILE_VERSION )
+                return false;
+
+            SetKnowsBar( m_requiredVersion >= 20240706 );
+            break;
+
+        case T_descr:
+            NeedSYMBOLorNUMBER();
+            aSummary.m_description = FromUTF8();
+            NeedRIGHT();
+            break;
+
+        case T_tags:
+            NeedSYMBOLorNUMBER();
+            aSummary.m_keywords = FromUTF8();
+            NeedRIGHT();
+            break;
+
+        case T_pad:
+            if( !parsePad() )
+                return false;
+
+            break;
+
+        default:
+            skipCurrentRecord();
+            break;
+        }
+    }
+
+    aSummary.m_uniquePadCount = padNumbers.size();
+    return true;
+}
+
+
 BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::Parse()
 {
     T               token;
@@ -1129,7 +1482,6 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             };
 
     std::vector<BOARD_ITEM*> bulkAddedItems;
-    BOARD_ITEM* item = nullptr;
 
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
@@ -1215,108 +1567,43 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             m_board->m_LegacyNetclassesLoaded = true;
             break;
 
+        case T_group:
+            parseGROUP( m_board );
+            break;
+
+        case T_generated:
+            parseGENERATOR( m_board );
+            break;
+
         case T_gr_arc:
         case T_gr_curve:
         case T_gr_line:
         case T_gr_poly:
         case T_gr_circle:
         case T_gr_rect:
-            item = parsePCB_SHAPE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_image:
-            item = parsePCB_REFERENCE_IMAGE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_barcode:
-            item = parsePCB_BARCODE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_gr_text:
-            item = parsePCB_TEXT( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_gr_text_box:
-            item = parsePCB_TEXTBOX( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_table:
-            item = parsePCB_TABLE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_dimension:
-            item = parseDIMENSION( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_module:      // legacy token
         case T_footprint:
-            item = parseFOOTPRINT();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_segment:
-            if( PCB_TRACK* track = parsePCB_TRACK() )
-            {
-                m_board->Add( track, ADD_MODE::BULK_APPEND, true );
-                bulkAddedItems.push_back( track );
-            }
-
-            break;
-
         case T_arc:
-            if( PCB_ARC* arc = parseARC() )
-            {
-                m_board->Add( arc, ADD_MODE::BULK_APPEND, true );
-                bulkAddedItems.push_back( arc );
-            }
-
-            break;
-
-        case T_group:
-            parseGROUP( m_board );
-            break;
-
-        case T_generated:
-            parseGENERATOR( m_board );
-            break;
-
         case T_via:
-            item = parsePCB_VIA();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_zone:
-            item = parseZONE( m_board );
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_target:
-            item = parsePCB_TARGET();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
-            break;
-
         case T_point:
-            item = parsePCB_POINT();
-            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
-            bulkAddedItems.push_back( item );
+            if( parseItemsConcurrently( bulkAddedItems ) )
+                break;
+
+            if( BOARD_ITEM* item = parseBoardItem( token ) )
+            {
+                m_board->Add( item, ADD_MODE::BULK_APPEND, true );
+                bulkAddedItems.push_back( item );
+            }
+
             break;
 
         case T_embedded_fonts:
@@ -1476,6 +1763,312 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+BOARD_ITEM* PCB_IO_KICAD_SEXPR_PARSER::parseBoardItem( T aToken )
+{
+    switch( aToken )
+    {
+    case T_gr_arc:
+    case T_gr_curve:
+    case T_gr_line:
+    case T_gr_poly:
+    case T_gr_circle:
+    case T_gr_rect:     return parsePCB_SHAPE( m_board );
+    case T_image:       return parsePCB_REFERENCE_IMAGE( m_board );
+    case T_barcode:     return parsePCB_BARCODE( m_board );
+    case T_gr_text:     return parsePCB_TEXT( m_board );
+    case T_gr_text_box: return parsePCB_TEXTBOX( m_board );
+    case T_table:       return parsePCB_TABLE( m_board );
+    case T_dimension:   return parseDIMENSION( m_board );
+    case T_module:      // legacy token
+    case T_footprint:   return parseFOOTPRINT();
+    case T_segment:     return parsePCB_TRACK();
+    case T_arc:         return parseARC();
+    case T_via:         return parsePCB_VIA();
+    case T_zone:        return parseZONE( m_board );
+    case T_target:      return parsePCB_TARGET();
+    case T_point:       return parsePCB_POINT();
+
+    default:
+        wxString err;
+        err.Printf( _( "Unknown token '%s'" ), FromUTF8() );
+        THROW_PARSE_ERROR( err, CurSource(), CurLine(), CurLineNumber(), CurOffset() );
+    }
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseBoardItems( std::vector<BOARD_ITEM*>& aItems,
+                                                 const std::atomic<bool>& aCancelled )
+{
+    for( T token = NextTok(); token != T_EOF && !aCancelled; token = NextTok() )
+    {
+        if( token != T_LEFT )
+            Expecting( T_LEFT );
+
+        if( BOARD_ITEM* item = parseBoardItem( NextTok() ) )
+            aItems.push_back( item );
+    }
+}
+
+
+bool PCB_IO_KICAD_SEXPR_PARSER::parseItemsConcurrently( std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    STRING_VIEW_LINE_READER* viewReader = dynamic_cast<STRING_VIEW_LINE_READER*>( reader );
+
+    // Files older than 20251028 refer to nets by their code, which the parsers of the parts
+    // couldn't agree on.  Nested pool tasks could deadlock, so loads on pool threads are
+    // left sequential too.
+    if( !ADVANCED_CFG::GetCfg().m_ParallelBoardLoad || !viewReader || readerStack.size() != 1
+            || m_appendToExisting || m_deferBoardChanges || m_requiredVersion < 20251028
+            || BS::this_thread::get_pool().has_value() )
+    {
+        return false;
+    }
+
+    std::string_view text = viewReader->Text();
+
+    if( start < text.data() || start + curOffset > text.data() + text.size() )
+        return false;
+
+    // The keyword was just read; its parenthesis is before it on the same line
+    const char* cp = start + curOffset;
+
+    while( cp > start && isBlank( cp[-1] ) )
+        --cp;
+
+    if( cp == start || cp[-1] != '(' )
+        return false;
+
+    size_t runBegin = ( cp - 1 ) - text.data();
+
+    // Already scanned: the run was too short
+    if( runBegin < m_parallelScanEnd )
+        return false;
+
+    std::vector<BOARD_RECORD> records;
+    size_t                    pos = runBegin;
+    unsigned                  line = CurLineNumber();
+    size_t                    runEnd = runBegin;
+    unsigned                  runEndLine = line;
+
+    while( pos < text.size() && text[pos] == '(' )
+    {
+        size_t kwEnd = pos + 1;
+
+        while( kwEnd < text.size() && !isBlank( text[kwEnd] ) && text[kwEnd] != '('
+                && text[kwEnd] != ')' )
+        {
+            kwEnd++;
+        }
+
+        if( !isBoardItemToken( findToken( std::string( text.substr( pos + 1, kwEnd - pos - 1 ) ) ) ) )
+            break;
+
+        BOARD_RECORD record{ pos, 0, line };
+
+        // Leave malformed records to the sequential parser, which reports them properly
+        if( !skipRecord( text, pos, line ) )
+            break;
+
+        record.m_end = pos;
+        records.push_back( record );
+        runEnd = pos;
+        runEndLine = line;
+
+        skipBlanks( text, pos, line );
+    }
+
+    m_parallelScanEnd = runEnd;
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       partCount = std::min( records.size() / MIN_RECORDS_PER_PART,
+                                       tp.get_thread_count() * 4 );
+
+    if( records.size() < MIN_CONCURRENT_RECORDS || partCount < 2 )
+        return false;
+
+    struct PART
+    {
+        size_t                                     m_firstRecord = 0;
+        std::unique_ptr<STRING_VIEW_LINE_READER>   m_reader;
+        std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER> m_parser;
+        std::vector<BOARD_ITEM*>                   m_items;
+        std::exception_ptr                         m_error;
+    };
+
+    // Parts of about the same size, each starting on a record
+    std::vector<PART> parts;
+    size_t            partSize = ( runEnd - runBegin ) / partCount;
+    size_t            partBegin = runBegin;
+
+    for( size_t ii = 0; ii < records.size(); ++ii )
+    {
+        if( ii == 0 || records[ii].m_begin - partBegin >= partSize )
+        {
+            parts.emplace_back();
+            parts.back().m_firstRecord = ii;
+            partBegin = records[ii].m_begin;
+        }
+    }
+
+    for( size_t ii = 0; ii < parts.size(); ++ii )
+    {
+        const BOARD_RECORD& first = records[parts[ii].m_firstRecord];
+        size_t              end = ii + 1 < parts.size() ? records[parts[ii + 1].m_firstRecord].m_begin
+                                                        : runEnd;
+        size_t              begin = first.m_begin;
+
+        // Start on the line of the record rather than at it, so that offsets in errors are
+        // the same as for the whole file
+        while( begin > 0 && ( text[begin - 1] == ' ' || text[begin - 1] == '\t' ) )
+            begin--;
+
+        if( begin > 0 && text[begin - 1] != '\n' )
+            begin = first.m_begin;
+
+        parts[ii].m_reader = std::make_unique<STRING_VIEW_LINE_READER>( text.substr( begin, end - begin ),
+                                                                         CurSource(), first.m_line - 1 );
+    }
+
+    std::atomic<bool> cancelled( false );
+
+    auto parsePart =
+            [&]( const int ii )
+            {
+                PART& part = parts[ii];
+
+                try
+                {
+                    part.m_parser = std::make_unique<PCB_IO_KICAD_SEXPR_PARSER>( part.m_reader.get(),
+                                                                                 nullptr, nullptr );
+
+                    PCB_IO_KICAD_SEXPR_PARSER& parser = *part.m_parser;
+
+                    parser.m_board = m_board;
+                    parser.m_layerIndices = m_layerIndices;
+                    parser.m_layerMasks = m_layerMasks;
+                    parser.m_netCodes = m_netCodes;
+                    parser.m_requiredVersion = m_requiredVersion;
+                    parser.m_generatorVersion = m_generatorVersion;
+                    parser.m_deferBoardChanges = true;
+                    parser.m_fillSidecar = m_fillSidecar;
+
+                    parser.parseBoardItems( part.m_items, cancelled );
+                }
+                catch( ... )
+                {
+                    part.m_error = std::current_exception();
+                }
+            };
+
+    auto returns = tp.submit_loop( 0, parts.size(), parsePart );
+
+    while( !returns.wait_for( std::chrono::milliseconds( 100 ) ) )
+    {
+        if( m_progressReporter && !m_progressReporter->KeepRefreshing() )
+            cancelled = true;
+    }
+
+    auto discardItems =
+            [&]()
+            {
+                for( PART& part : parts )
+                {
+                    for( BOARD_ITEM* item : part.m_items )
+                        delete item;
+
+                    part.m_items.clear();
+                }
+            };
+
+    // The first error in file order is the one the sequential parser would have thrown
+    for( PART& part : parts )
+    {
+        if( part.m_error )
+        {
+            discardItems();
+            std::rethrow_exception( part.m_error );
+        }
+    }
+
+    if( cancelled )
+    {
+        discardItems();
+        THROW_IO_ERROR( _( "Open canceled by user." ) );
+    }
+
+    // Nets are added to the board in the order the sequential parser would have created
+    // them, so that they get the same codes
+    for( PART& part : parts )
+    {
+        PCB_IO_KICAD_SEXPR_PARSER&                    parser = *part.m_parser;
+        std::unordered_map<NETINFO_ITEM*, NETINFO_ITEM*> duplicates;
+
+        for( NETINFO_ITEM* net : parser.m_pendingNets )
+        {
+            if( NETINFO_ITEM* existing = m_board->FindNet( net->GetNetname() ) )
+                duplicates[net] = existing;
+            else
+                m_board->Add( net, ADD_MODE::INSERT, true );
+        }
+
+        parser.m_pendingNets.clear();
+
+        if( !duplicates.empty() )
+        {
+            auto remapNet =
+                    [&]( BOARD_ITEM* aItem )
+                    {
+                        if( BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
+                        {
+                            auto it = duplicates.find( item->GetNet() );
+
+                            if( it != duplicates.end() )
+                                item->SetNet( it->second );
+                        }
+                    };
+
+            for( BOARD_ITEM* item : part.m_items )
+            {
+                remapNet( item );
+                item->RunOnChildren( remapNet, RECURSE_MODE::RECURSE );
+            }
+
+            for( const auto& [net, existing] : duplicates )
+                delete net;
+        }
+
+        for( const auto& [footprint, classNames] : parser.m_pendingComponentClasses )
+            footprint->ResolveComponentClassNames( m_board, classNames );
+
+        for( BOARD_ITEM* item : part.m_items )
+        {
+            m_board->Add( item, ADD_MODE::BULK_APPEND, true );
+            aBulkAddedItems.push_back( item );
+        }
+
+        part.m_items.clear();
+
+        m_undefinedLayers.insert( parser.m_undefinedLayers.begin(), parser.m_undefinedLayers.end() );
+        m_parseWarnings.insert( m_parseWarnings.end(), parser.m_parseWarnings.begin(),
+                                parser.m_parseWarnings.end() );
+        m_groupInfos.insert( m_groupInfos.end(), parser.m_groupInfos.begin(),
+                             parser.m_groupInfos.end() );
+        m_generatorInfos.insert( m_generatorInfos.end(), parser.m_generatorInfos.begin(),
+                                 parser.m_generatorInfos.end() );
+    }
+
+    // Carry on after the run
+    size_t lineStart = text.rfind( '\n', runEnd - 1 );
+
+    lineStart = ( lineStart == std::string_view::npos ) ? 0 : lineStart + 1;
+    viewReader->SetPosition( lineStart, runEndLine );
+    readLine();
+    next = start + ( runEnd - lineStart );
+
+    return true;
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem =
@@ -2278,7 +2871,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseLayers()
 
 LSET PCB_IO_KICAD_SEXPR_PARSER::lookUpLayerSet( const LSET_MAP& aMap )
 {
-    LSET_MAP::const_iterator it = aMap.find( curText );
+    LSET_MAP::const_iterator it = aMap.find( CurStr() );
 
     if( it == aMap.end() )
         return LSET( { Rescue } );
@@ -2290,17 +2883,17 @@ LSET PCB_IO_KICAD_SEXPR_PARSER::lookUpLayerSet( const LSET_MAP& aMap )
 PCB_LAYER_ID PCB_IO_KICAD_SEXPR_PARSER::lookUpLayer( const LAYER_ID_MAP& aMap )
 {
     // avoid constructing another std::string, use lexer's directly
-    LAYER_ID_MAP::const_iterator it = aMap.find( curText );
+    LAYER_ID_MAP::const_iterator it = aMap.find( CurStr() );
 
     if( it == aMap.end() )
     {
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
         return Rescue;
     }
 
     // Some files may have saved items to the Rescue Layer due to an issue in v5
     if( it->second == Rescue )
-        m_undefinedLayers.insert( curText );
+        m_undefinedLayers.insert( CurStr() );
 
     return it->second;
 }
@@ -5496,7 +6089,9 @@ FOOTPRINT* PCB_IO_KICAD_SEXPR_PARSER::parseFOOTPRINT_unchecked( wxArrayString* a
 
             footprint->SetTransientComponentClassNames( componentClassNames );
 
-            if( m_board )
+            if( m_board && m_deferBoardChanges )
+                m_pendingComponentClasses.emplace_back( footprint.get(), componentClassNames );
+            else if( m_board )
                 footprint->ResolveComponentClassNames( m_board, componentClassNames );
 
             break;
@@ -5958,15 +6553,7 @@ PAD* PCB_IO_KICAD_SEXPR_PARSER::parsePAD( FOOTPRINT* aParent )
                 }
                 else
                 {
-                    NETINFO_ITEM* netinfo = m_board->FindNet( netName );
-
-                    if( !netinfo )
-                    {
-                        netinfo = new NETINFO_ITEM( m_board, netName );
-                        m_board->Add( netinfo, ADD_MODE::INSERT, true );
-                    }
-
-                    pad->SetNet( netinfo );
+                    pad->SetNet( findOrCreateNet( netName ) );
                 }
             }
 
@@ -6484,7 +7071,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parsePadstack( PAD* aPad )
             NextTok();
             PCB_LAYER_ID curLayer = UNDEFINED_LAYER;
 
-            if( curText == "Inner" )
+            if( CurStr() == "Inner" )
             {
                 if( padstack.Mode() != PADSTACK::MODE::FRONT_INNER_BACK )
                 {
@@ -6504,7 +7091,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parsePadstack( PAD* aPad )
             {
                 wxString error;
                 error.Printf( _( "Invalid padstack layer '%s' in file '%s' at line %d, offset %d." ),
-                              curText, CurSource().GetData(), CurLineNumber(), CurOffset() );
+                              CurStr(), CurSource().GetData(), CurLineNumber(), CurOffset() );
                 THROW_IO_ERROR( error );
             }
 
@@ -7634,7 +8221,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseViastack( PCB_VIA* aVia )
             NextTok();
             PCB_LAYER_ID curLayer = UNDEFINED_LAYER;
 
-            if( curText == "Inner" )
+            if( CurStr() == "Inner" )
             {
                 if( padstack.Mode() != PADSTACK::MODE::FRONT_INNER_BACK )
                 {
@@ -7654,7 +8241,7 @@ void PCB_IO_KICAD_SEXPR_PARSER::parseViastack( PCB_VIA* aVia )
             {
                 wxString error;
                 error.Printf( _( "Invalid padstack layer '%s' in file '%s' at line %d, offset %d." ),
-                              curText, CurSource().GetData(), CurLineNumber(), CurOffset() );
+                              CurStr(), CurSource().GetData(), CurLineNumber(), CurOffset() );
                 THROW_IO_ERROR( error );
             }
 
@@ -7710,6 +8297,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     std::map<PCB_LAYER_ID, std::vector<SEG>> legacySegs;
     PCB_LAYER_ID filledLayer;
     bool         addedFilledPolygons = false;
+    bool         sidecarChecked = false;
+    bool         fillsFromSidecar = false;
 
     // This hasn't been supported since V6 or so, but we only stopped writing out the token
     // in V10.
@@ -8142,6 +8731,21 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         }
 
         case T_filled_polygon:
+            if( m_fillSidecar && !sidecarChecked )
+            {
+                sidecarChecked = true;
+                fillsFromSidecar = m_fillSidecar->GetZoneFills( *zone, pts );
+
+                for( const auto& [layer, poly] : pts )
+                    addedFilledPolygons |= !poly.IsEmpty();
+            }
+
+            if( fillsFromSidecar )
+            {
+                skipCurrentRecord();
+                break;
+            }
+
             {
                 // "(filled_polygon (pts"
                 NeedLEFT();
@@ -8385,6 +8989,11 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
         {
             zone->SetNetCode( net->GetNetCode() );
         }
+        else if( m_deferBoardChanges )
+        {
+            // Net codes are given when the net is added to the board
+            zone->SetNet( findOrCreateNet( legacyNetnameFromFile ) );
+        }
         else    // Not existing net: add a new net to keep track of the zone netname
         {
             int newnetcode = m_board->GetNetCount();
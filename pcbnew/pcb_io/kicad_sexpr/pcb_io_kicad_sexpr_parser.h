@@ -42,8 +42,10 @@
 #include <string_any_map.h>
 #include <padstack.h>
 
+#include <atomic>
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 
 
 class PCB_ARC;
@@ -51,6 +53,7 @@ class BOARD;
 class BOARD_ITEM;
 class ZONE_SETTINGS;
 class BOARD_CONNECTED_ITEM;
+class NETINFO_ITEM;
 class BOARD_ITEM_CONTAINER;
 class PAD;
 class BOARD_DESIGN_SETTINGS;
@@ -76,6 +79,8 @@ class SHAPE_LINE_CHAIN;
 struct LAYER;
 class PROGRESS_REPORTER;
 class TEARDROP_PARAMETERS;
+class PCB_IO_KICAD_SEXPR_SIDECAR;
+struct FOOTPRINT_SUMMARY;
 
 
 /**
@@ -96,6 +101,9 @@ public:
             PCB_LEXER( aReader ),
             m_board( aAppendToMe ),
             m_appendToExisting( aAppendToMe != nullptr ),
+            m_deferBoardChanges( false ),
+            m_parallelScanEnd( 0 ),
+            m_fillSidecar( nullptr ),
             m_progressReporter( aProgressReporter ),
             m_lastProgressTime( std::chrono::steady_clock::now() ),
             m_lineCount( aLineCount ),
@@ -104,10 +112,16 @@ public:
         init();
     }
 
-    // ~PCB_IO_KICAD_SEXPR_PARSER() {}
+    ~PCB_IO_KICAD_SEXPR_PARSER();
 
     BOARD_ITEM* Parse();
 
+    /**
+     * Take the zone fills from \a aSidecar, which must be the snapshot of the text being parsed,
+     * instead of parsing them.
+     */
+    void SetFillSidecar( const PCB_IO_KICAD_SEXPR_SIDECAR* aSidecar ) { m_fillSidecar = aSidecar; }
+
     /**
      * @param aInitialComments may be a pointer to a heap allocated initial comment block
      *                         or NULL.  If not NULL, then caller has given ownership of a
@@ -136,6 +150,14 @@ public:
      */
     bool IsValidBoardHeader();
 
+    /**
+     * Read the description, keywords and pad counts of a footprint file, parsing only its pads
+     * and skipping everything else.
+     *
+     * @return false if the input isn't a footprint in a supported format.
+     */
+    bool ParseFootprintSummary( FOOTPRINT_SUMMARY& aSummary );
+
     /**
      * Return any non-fatal parse warnings that occurred during parsing.
      * These are errors that were handled gracefully but should be reported to the user.
@@ -212,6 +234,11 @@ private:
      */
     void skipCurrent();
 
+    /**
+     * Same as skipCurrent(), straight in the text when it is read from memory.
+     */
+    void skipCurrentRecord();
+
     void parseHeader();
     void parseGeneralSection();
     void parsePAGE_INFO();
@@ -269,6 +296,37 @@ private:
     // Parse a board, but do not replace PARSE_ERROR with FUTURE_FORMAT_ERROR automatically.
     BOARD*      parseBOARD_unchecked();
 
+    /**
+     * Parse the board item whose keyword @a aToken has just been read.
+     *
+     * @return the item, not yet added to the board, or nullptr for a record without one such
+     *         as a legacy zero length track.
+     */
+    BOARD_ITEM* parseBoardItem( T aToken );
+
+    /**
+     * Parse the run of board item records starting with the current one on several threads,
+     * each with its own parser for a part of the text, and add the items to the board in
+     * file order.
+     *
+     * Only done for boards in the current format read from a #STRING_VIEW_LINE_READER, when
+     * the run is long enough to be worth it.  On success the lexer is left after the run.
+     *
+     * @return false if the run has to be parsed sequentially.
+     */
+    bool parseItemsConcurrently( std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
+    /**
+     * Parse board item records up to the end of the text, for parseItemsConcurrently().
+     */
+    void parseBoardItems( std::vector<BOARD_ITEM*>& aItems, const std::atomic<bool>& aCancelled );
+
+    /**
+     * @return the net named @a aName, created if the board doesn't have it.  Nets created
+     *         while board changes are deferred are kept in #m_pendingNets.
+     */
+    NETINFO_ITEM* findOrCreateNet( const wxString& aName );
+
     /**
      * Parse the current token for the layer definition of a #BOARD_ITEM object.
      *
@@ -379,7 +437,7 @@ private:
 
     inline int parseInt()
     {
-        return (int)strtol( CurText(), nullptr, 10 );
+        return (int) parseLong();
     }
 
     inline int parseInt( const char* aExpected )
@@ -391,7 +449,7 @@ private:
     inline long parseHex()
     {
         NextTok();
-        return strtol( CurText(), nullptr, 16 );
+        return DSNLEXER::parseHex();
     }
 
     bool parseBool();
@@ -447,6 +505,22 @@ private:
     ///< if resetting UUIDs, record new ones to update groups with.
     KIID_MAP            m_resetKIIDMap;
 
+    ///< Set on the parsers of parseItemsConcurrently(), which leave the board unchanged.
+    bool                m_deferBoardChanges;
+
+    ///< Nets created while deferring board changes, in creation order.
+    std::vector<NETINFO_ITEM*>                  m_pendingNets;
+    std::unordered_map<wxString, NETINFO_ITEM*> m_pendingNetsByName;
+
+    ///< Component classes to resolve once the footprints are on the board.
+    std::vector<std::pair<FOOTPRINT*, std::unordered_set<wxString>>> m_pendingComponentClasses;
+
+    ///< End of the text already scanned by parseItemsConcurrently().
+    size_t              m_parallelScanEnd;
+
+    ///< Snapshot of the zone fills of the text, if any.
+    const PCB_IO_KICAD_SEXPR_SIDECAR* m_fillSidecar;
+
     bool                m_showLegacySegmentZoneWarning;
     bool                m_showLegacy5ZoneWarning;
 
@@ -0,0 +1,359 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstring>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <kiplatform/io.h>
+#include <mmh3_hash.h>
+#include <zone.h>
+
+#include "pcb_io_kicad_sexpr_sidecar.h"
+
+
+namespace
+{
+
+const char     SIDECAR_MAGIC[8] = { 'K', 'I', 'C', 'A', 'D', 'Z', 'F', 'S' };
+const uint32_t SIDECAR_VERSION = 1;
+const uint32_t SIDECAR_BYTE_ORDER = 0x01020304;
+
+const uint32_t OUTLINE_ISLAND = 0x1;
+
+
+struct SIDECAR_HEADER
+{
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byteOrder;
+    uint64_t m_textSize;
+    uint64_t m_textHash[2];
+    uint32_t m_zoneCount;
+    uint32_t m_reserved;
+};
+
+
+HASH_128 hashText( std::string_view aText )
+{
+    MMH3_HASH hash( SIDECAR_VERSION );
+
+    hash.addData( reinterpret_cast<const uint8_t*>( aText.data() ), aText.size() );
+    return hash.digest();
+}
+
+
+/**
+ * Bounds checked reads from a snapshot.
+ */
+struct SIDECAR_READER
+{
+    const char* m_data;
+    size_t      m_size;
+    size_t      m_pos;
+
+    template <typename T>
+    bool Read( T& aValue )
+    {
+        if( m_size - m_pos < sizeof( T ) )
+            return false;
+
+        memcpy( &aValue, m_data + m_pos, sizeof( T ) );
+        m_pos += sizeof( T );
+        return true;
+    }
+
+    bool Skip( uint64_t aBytes )
+    {
+        if( m_size - m_pos < aBytes )
+            return false;
+
+        m_pos += aBytes;
+        return true;
+    }
+};
+
+
+template <typename T>
+void append( std::string& aBuffer, const T& aValue )
+{
+    aBuffer.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+}
+
+} // namespace
+
+
+PCB_IO_KICAD_SEXPR_SIDECAR::PCB_IO_KICAD_SEXPR_SIDECAR()
+{
+}
+
+
+PCB_IO_KICAD_SEXPR_SIDECAR::~PCB_IO_KICAD_SEXPR_SIDECAR()
+{
+}
+
+
+wxString PCB_IO_KICAD_SEXPR_SIDECAR::FileNameFor( const wxString& aBoardFileName )
+{
+    return aBoardFileName + wxS( "-fills" );
+}
+
+
+bool PCB_IO_KICAD_SEXPR_SIDECAR::Write( const wxString& aFileName, std::string_view aBoardText,
+                                        const BOARD* aBoard )
+{
+    std::vector<const ZONE*> zones( aBoard->Zones().begin(), aBoard->Zones().end() );
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+        zones.insert( zones.end(), footprint->Zones().begin(), footprint->Zones().end() );
+
+    // The parser finds zones by their UUID, so duplicates are left to the text
+    std::unordered_map<KIID, int> uuidCount;
+
+    for( const ZONE* zone : zones )
+        uuidCount[zone->m_Uuid]++;
+
+    std::string buffer;
+    uint32_t    zoneCount = 0;
+
+    for( const ZONE* zone : zones )
+    {
+        if( uuidCount[zone->m_Uuid] > 1 )
+            continue;
+
+        std::string zoneRecord;
+        uint32_t    layerCount = 0;
+        bool        hasArcs = false;
+        std::string uuid = zone->m_Uuid.AsStdString();
+
+        append( zoneRecord, (uint32_t) uuid.size() );
+        zoneRecord.append( uuid );
+
+        std::string layerRecords;
+
+        // Same order as PCB_IO_KICAD_SEXPR::format( const ZONE* )
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            if( !fill || fill->OutlineCount() == 0 )
+                continue;
+
+            append( layerRecords, (int32_t) layer );
+            append( layerRecords, (uint32_t) fill->OutlineCount() );
+
+            for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+            {
+                const SHAPE_LINE_CHAIN& chain = fill->COutline( ii );
+
+                hasArcs |= chain.ArcCount() > 0;
+
+                append( layerRecords, zone->IsIsland( layer, ii ) ? OUTLINE_ISLAND : 0u );
+                append( layerRecords, (uint32_t) chain.PointCount() );
+
+                for( const VECTOR2I& pt : chain.CPoints() )
+                {
+                    append( layerRecords, (int32_t) pt.x );
+                    append( layerRecords, (int32_t) pt.y );
+                }
+            }
+
+            layerCount++;
+        }
+
+        if( hasArcs )
+            continue;
+
+        append( zoneRecord, layerCount );
+        buffer.append( zoneRecord );
+        buffer.append( layerRecords );
+        zoneCount++;
+    }
+
+    HASH_128       hash = hashText( aBoardText );
+    SIDECAR_HEADER header = {};
+
+    memcpy( header.m_magic, SIDECAR_MAGIC, sizeof( SIDECAR_MAGIC ) );
+    header.m_version = SIDECAR_VERSION;
+    header.m_byteOrder = SIDECAR_BYTE_ORDER;
+    header.m_textSize = aBoardText.size();
+    header.m_textHash[0] = hash.Value64[0];
+    header.m_textHash[1] = hash.Value64[1];
+    header.m_zoneCount = zoneCount;
+
+    wxFFile file( aFileName, wxS( "wb" ) );
+
+    if( !file.IsOpened()
+            || file.Write( &header, sizeof( header ) ) != sizeof( header )
+            || file.Write( buffer.data(), buffer.size() ) != buffer.size()
+            || !file.Close() )
+    {
+        file.Close();
+        wxRemoveFile( aFileName );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_SIDECAR::Open( const wxString& aFileName, std::string_view aBoardText )
+{
+    m_zones.clear();
+    m_file.reset();
+
+    if( !wxFileExists( aFileName ) )
+        return false;
+
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> file =
+            std::make_unique<KIPLATFORM::IO::MAPPED_FILE>( aFileName );
+
+    if( !file->IsMapped() )
+        return false;
+
+    SIDECAR_READER reader{ file->Data(), file->Size(), 0 };
+    SIDECAR_HEADER header;
+
+    if( !reader.Read( header )
+            || memcmp( header.m_magic, SIDECAR_MAGIC, sizeof( SIDECAR_MAGIC ) ) != 0
+            || header.m_version != SIDECAR_VERSION
+            || header.m_byteOrder != SIDECAR_BYTE_ORDER
+            || header.m_textSize != aBoardText.size() )
+    {
+        return false;
+    }
+
+    HASH_128 hash = hashText( aBoardText );
+
+    if( header.m_textHash[0] != hash.Value64[0] || header.m_textHash[1] != hash.Value64[1] )
+        return false;
+
+    // Check the whole snapshot once, so that GetZoneFills() can trust it
+    std::unordered_map<KIID, size_t> zones;
+
+    for( uint32_t zoneIdx = 0; zoneIdx < header.m_zoneCount; ++zoneIdx )
+    {
+        uint32_t uuidSize;
+
+        if( !reader.Read( uuidSize ) || reader.m_size - reader.m_pos < uuidSize )
+            return false;
+
+        KIID uuid( std::string( reader.m_data + reader.m_pos, uuidSize ) );
+        reader.m_pos += uuidSize;
+
+        if( !zones.emplace( uuid, reader.m_pos ).second )
+            return false;
+
+        uint32_t layerCount;
+
+        if( !reader.Read( layerCount ) )
+            return false;
+
+        for( uint32_t layerIdx = 0; layerIdx < layerCount; ++layerIdx )
+        {
+            int32_t  layer;
+            uint32_t outlineCount;
+
+            if( !reader.Read( layer ) || !reader.Read( outlineCount )
+                    || layer < 0 || layer >= PCB_LAYER_ID_COUNT )
+            {
+                return false;
+            }
+
+            for( uint32_t outlineIdx = 0; outlineIdx < outlineCount; ++outlineIdx )
+            {
+                uint32_t flags;
+                uint32_t pointCount;
+
+                if( !reader.Read( flags ) || !reader.Read( pointCount )
+                        || !reader.Skip( (uint64_t) pointCount * 2 * sizeof( int32_t ) ) )
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    m_file = std::move( file );
+    m_zones = std::move( zones );
+    return true;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_SIDECAR::GetZoneFills( ZONE& aZone,
+                                               std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aFills ) const
+{
+    auto it = m_zones.find( aZone.m_Uuid );
+
+    if( it == m_zones.end() )
+        return false;
+
+    SIDECAR_READER reader{ m_file->Data(), m_file->Size(), it->second };
+    uint32_t       layerCount = 0;
+
+    reader.Read( layerCount );
+
+    for( uint32_t layerIdx = 0; layerIdx < layerCount; ++layerIdx )
+    {
+        int32_t  layerId = 0;
+        uint32_t outlineCount = 0;
+
+        reader.Read( layerId );
+        reader.Read( outlineCount );
+
+        PCB_LAYER_ID    layer = ToLAYER_ID( layerId );
+        SHAPE_POLY_SET& poly = aFills[layer];
+
+        for( uint32_t outlineIdx = 0; outlineIdx < outlineCount; ++outlineIdx )
+        {
+            uint32_t flags = 0;
+            uint32_t pointCount = 0;
+
+            reader.Read( flags );
+            reader.Read( pointCount );
+
+            int               idx = poly.NewOutline();
+            SHAPE_LINE_CHAIN& chain = poly.Outline( idx );
+
+            if( flags & OUTLINE_ISLAND )
+                aZone.SetIsIsland( layer, idx );
+
+            for( uint32_t ii = 0; ii < pointCount; ++ii )
+            {
+                int32_t x = 0;
+                int32_t y = 0;
+
+                reader.Read( x );
+                reader.Read( y );
+
+                // As the parser appends the points of the text
+                chain.Append( x, y );
+            }
+        }
+    }
+
+    return true;
+}
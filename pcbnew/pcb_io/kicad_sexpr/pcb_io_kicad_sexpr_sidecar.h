@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PCB_IO_KICAD_SEXPR_SIDECAR_H_
+#define PCB_IO_KICAD_SEXPR_SIDECAR_H_
+
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+#include <kiid.h>
+#include <layer_ids.h>
+#include <geometry/shape_poly_set.h>
+#include <wx/string.h>
+
+class BOARD;
+class ZONE;
+
+namespace KIPLATFORM
+{
+namespace IO
+{
+    class MAPPED_FILE;
+}
+}
+
+
+/**
+ * A binary snapshot of the zone fills of a .kicad_pcb file, kept next to it.
+ *
+ * Zone fills are most of the text of large boards.  The snapshot is written when the board is
+ * saved and records the size and hash of the board file it was written with; as long as the
+ * board file is unchanged, the parser takes the fills from the snapshot and skips their text.
+ * The board file stays authoritative: a snapshot which doesn't match it is ignored.
+ *
+ * The snapshot is a flat little endian file, read straight from a memory mapping.  Zones with
+ * arcs in their fills are left out and parsed from the text.
+ */
+class PCB_IO_KICAD_SEXPR_SIDECAR
+{
+public:
+    PCB_IO_KICAD_SEXPR_SIDECAR();
+    ~PCB_IO_KICAD_SEXPR_SIDECAR();
+
+    /**
+     * @return the name of the snapshot of \a aBoardFileName.
+     */
+    static wxString FileNameFor( const wxString& aBoardFileName );
+
+    /**
+     * Write the snapshot of the zone fills of \a aBoard, saved as \a aBoardText.
+     *
+     * @return false if the snapshot couldn't be written.
+     */
+    static bool Write( const wxString& aFileName, std::string_view aBoardText,
+                       const BOARD* aBoard );
+
+    /**
+     * Map \a aFileName and index its zones.
+     *
+     * @return false if there is no snapshot, or it doesn't belong to \a aBoardText.
+     */
+    bool Open( const wxString& aFileName, std::string_view aBoardText );
+
+    /**
+     * Read the fills of \a aZone, per layer in file order, and set its islands.  Safe to call
+     * from several threads.
+     *
+     * @return false if the snapshot doesn't have the zone.
+     */
+    bool GetZoneFills( ZONE& aZone, std::map<PCB_LAYER_ID, SHAPE_POLY_SET>& aFills ) const;
+
+private:
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> m_file;
+
+    /// Offset of the layer records of each zone.
+    std::unordered_map<KIID, size_t>             m_zones;
+};
+
+#endif // PCB_IO_KICAD_SEXPR_SIDECAR_H_
@@ -42,6 +42,7 @@
 #include <pgm_base.h>
 #include <progress_reporter.h>
 #include <settings/settings_manager.h>
+#include <thread_pool.h>
 #include <wx_fstream_progress.h>
 
 #include <geometry/shape_circle.h>
@@ -1034,11 +1035,24 @@ void ODB_STEP_ENTITY::InitEntityData()
 
     InitEdaData();
 
-    // Init Layer Entity Data
+    // Init Layer Entity Data.  Each layer only fills its own features, so they are built
+    // concurrently; the subnet links they share are added afterwards in layer order.
+    std::vector<ODB_LAYER_ENTITY*> layerEntities;
+    layerEntities.reserve( m_layerEntityMap.size() );
+
     for( const auto& [layerName, layer_entity_ptr] : m_layerEntityMap )
-    {
-        layer_entity_ptr->InitEntityData();
-    }
+        layerEntities.push_back( layer_entity_ptr.get() );
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( 0, layerEntities.size(),
+            [&]( const int ii )
+            {
+                layerEntities[ii]->InitEntityData();
+            } ).wait();
+
+    for( ODB_LAYER_ENTITY* layerEntity : layerEntities )
+        layerEntity->LinkSubnetFeatures();
 }
 
 
@@ -1080,6 +1094,10 @@ void ODB_LAYER_ENTITY::GenFeatures( ODB_TREE_WRITER& writer )
     auto fileproxy = writer.CreateFileProxy( "features" );
 
     m_featuresMgr->GenerateFeatureFile( fileproxy.GetStream() );
+
+    // The features are only needed for this file, so don't keep every layer's list in memory
+    // until the whole tree has been written
+    m_featuresMgr.reset();
 }
 
 
@@ -190,6 +190,7 @@ public:
     void                       InitFeatureData();
     void                       InitDrillData();
     void                       InitAuxilliaryData();
+    void                       LinkSubnetFeatures() { m_featuresMgr->LinkSubnetFeatures(); }
 
     ODB_COMPONENT& InitComponentData( const FOOTPRINT* aFp, const EDA_DATA::PACKAGE& aPkg );
 
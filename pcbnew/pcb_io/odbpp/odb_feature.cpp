@@ -390,8 +390,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             shape.SetWidth( track->GetWidth() );
 
             AddShape( shape );
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            deferSubnetFeature( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
         }
         else if( track->Type() == PCB_ARC_T )
         {
@@ -402,8 +401,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddShape( shape );
 
-            subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                  m_featuresList.size() - 1 );
+            deferSubnetFeature( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
         }
         else
         {
@@ -425,8 +423,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             if( hole )
             {
                 AddViaDrillHole( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                      m_featuresList.size() - 1 );
+                deferSubnetFeature( subnet, EDA_DATA::FEATURE_ID::TYPE::HOLE );
 
                 // TODO: confirm TOOLING_HOLE
                 // AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOOLING_HOLE );
@@ -443,8 +440,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
             {
                 // to draw via copper shape on copper layer
                 AddVia( via, aLayer );
-                subnet->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                      m_featuresList.size() - 1 );
+                deferSubnetFeature( subnet, EDA_DATA::FEATURE_ID::TYPE::COPPER );
 
                 if( !m_featuresList.empty() )
                 {
@@ -473,8 +469,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 return;
             }
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            deferSubnetFeature( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER );
 
             if( zone->IsTeardropArea() && !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::TEAR_DROP{ true } );
@@ -694,8 +689,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 
             AddPadShape( *pad, aLayer );
 
-            iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::COPPER, m_layerName,
-                                        m_featuresList.size() - 1 );
+            deferSubnetFeature( iter->second, EDA_DATA::FEATURE_ID::TYPE::COPPER );
             if( !m_featuresList.empty() )
                 AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::PAD_USAGE::TOEPRINT );
 
@@ -725,8 +719,7 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
                 if( pad->GetAttribute() == PAD_ATTRIB::PTH )
                 {
                     // only plated holes link to subnet
-                    iter->second->AddFeatureID( EDA_DATA::FEATURE_ID::TYPE::HOLE, m_layerName,
-                                                m_featuresList.size() - 1 );
+                    deferSubnetFeature( iter->second, EDA_DATA::FEATURE_ID::TYPE::HOLE );
 
                     if( !m_featuresList.empty() )
                         AddSystemAttribute( *m_featuresList.back(), ODB_ATTR::DRILL::PLATED );
@@ -798,6 +791,15 @@ void FEATURES_MANAGER::InitFeatureList( PCB_LAYER_ID aLayer, std::vector<BOARD_I
 }
 
 
+void FEATURES_MANAGER::LinkSubnetFeatures()
+{
+    for( const std::function<void()>& link : m_subnetLinks )
+        link();
+
+    m_subnetLinks.clear();
+}
+
+
 void FEATURES_MANAGER::AddVia( const PCB_VIA* aVia, PCB_LAYER_ID aLayer )
 {
     if( !aVia->FlashLayer( aLayer ) )
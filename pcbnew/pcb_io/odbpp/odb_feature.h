@@ -26,6 +26,7 @@
 #include "pad.h"
 #include "convert_basic_shapes_to_polygon.h"
 #include "footprint.h"
+#include <functional>
 #include <list>
 #include "math/vector2d.h"
 #include "odb_defines.h"
@@ -91,6 +92,14 @@ public:
 
     void GenerateProfileFeatures( std::ostream& ost ) const;
 
+    /**
+     * Record the features added by InitFeatureList() in their EDA data subnets.
+     *
+     * The subnets and the EDA layer index are shared by every layer, so InitFeatureList() only
+     * queues the links and they are added here, one layer at a time.
+     */
+    void LinkSubnetFeatures();
+
 private:
     inline uint32_t AddCircleSymbol( const wxString& aDiameter )
     {
@@ -187,6 +196,18 @@ private:
         m_featuresList.emplace_back( std::move( feature ) );
     }
 
+    template <typename SUBNET, typename TYPE>
+    void deferSubnetFeature( SUBNET* aSubnet, TYPE aType )
+    {
+        size_t featureId = m_featuresList.size() - 1;
+
+        m_subnetLinks.emplace_back(
+                [this, aSubnet, aType, featureId]()
+                {
+                    aSubnet->AddFeatureID( aType, m_layerName, featureId );
+                } );
+    }
+
     inline PCB_IO_ODBPP* GetODBPlugin() { return m_plugin; }
 
     BOARD*        m_board;
@@ -196,6 +217,7 @@ private:
 
     std::list<std::unique_ptr<ODB_FEATURE>>      m_featuresList;
     std::map<BOARD_ITEM*, std::vector<uint32_t>> m_featureIDMap;
+    std::vector<std::function<void()>>           m_subnetLinks;
 };
 
 
@@ -38,6 +38,20 @@ class FOOTPRINT;
 class PROJECT;
 class PROGRESS_REPORTER;
 
+
+/**
+ * The library properties of a footprint, which a plugin may be able to read without loading
+ * the whole footprint.
+ */
+struct FOOTPRINT_SUMMARY
+{
+    wxString m_description;
+    wxString m_keywords;
+    unsigned m_padCount = 0;            ///< Pads, without NPTH pads
+    unsigned m_uniquePadCount = 0;      ///< Numbered copper pads, without NPTH pads
+};
+
+
 /**
  * A base class that #BOARD loading and saving plugins should derive from.
  *
@@ -241,6 +255,19 @@ public:
     virtual const FOOTPRINT* GetEnumeratedFootprint( const wxString& aLibraryPath, const wxString& aFootprintName,
                                                      const std::map<std::string, UTF8>* aProperties = nullptr );
 
+    /**
+     * Read the library properties of a footprint without loading the footprint, for listing
+     * large libraries.
+     *
+     * @return false if the plugin can't, and the footprint has to be loaded to get them.
+     */
+    virtual bool GetFootprintSummary( const wxString& aLibraryPath, const wxString& aFootprintName,
+                                      FOOTPRINT_SUMMARY& aSummary,
+                                      const std::map<std::string, UTF8>* aProperties = nullptr )
+    {
+        return false;
+    }
+
     /**
      * Check for the existence of a footprint.
      */
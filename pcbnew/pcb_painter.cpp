@@ -808,6 +808,60 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
     return true;
 }
 
+void PCB_PAINTER::PrepareDraw( const VIEW_ITEM* aItem )
+{
+    if( !aItem->IsBOARD_ITEM() )
+        return;
+
+    const BOARD_ITEM* item = static_cast<const BOARD_ITEM*>( aItem );
+
+    switch( item->Type() )
+    {
+    case PCB_PAD_T:
+        // Builds the effective shapes of all padstack layers under the pad's own lock
+        static_cast<const PAD*>( item )->GetEffectiveHoleShape();
+        break;
+
+    case PCB_SHAPE_T:
+    {
+        PCB_SHAPE* shape = const_cast<PCB_SHAPE*>( static_cast<const PCB_SHAPE*>( item ) );
+
+        if( m_gal->IsOpenGlEngine() && shape->GetShape() == SHAPE_T::POLY && shape->IsSolidFill()
+                && shape->GetPolyShape().OutlineCount() > 0
+                && !shape->GetPolyShape().IsTriangulationUpToDate() )
+        {
+            shape->GetPolyShape().CacheTriangulation( true, true );
+        }
+
+        break;
+    }
+
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( item );
+
+        if( !m_gal->IsOpenGlEngine() )
+            break;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& polySet = zone->GetFilledPolysList( layer );
+
+            if( polySet->OutlineCount() > 0 && !polySet->IsTriangulationUpToDate() )
+                polySet->CacheTriangulation( true, true );
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
 
 void PCB_PAINTER::draw( const PCB_TRACK* aTrack, int aLayer )
 {
@@ -194,6 +194,9 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::PrepareDraw()
+    virtual void PrepareDraw( const VIEW_ITEM* aItem ) override;
+
 protected:
     PCB_VIEWERS_SETTINGS_BASE* viewer_settings();
 
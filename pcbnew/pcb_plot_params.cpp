@@ -826,7 +826,7 @@ int PCB_PLOT_PARAMS_PARSER::parseInt( int aMin, int aMax )
     if( token != T_NUMBER )
         Expecting( T_NUMBER );
 
-    int val = atoi( CurText() );
+    int val = (int) parseLong();
 
     if( val < aMin )
         val = aMin;
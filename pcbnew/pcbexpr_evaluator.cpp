@@ -26,6 +26,7 @@
 #include <cstdio>
 #include <memory>
 #include <mutex>
+#include <typeinfo>
 
 #include <board.h>
 #include <footprint.h>
@@ -50,49 +51,54 @@ BOARD_ITEM* PCBEXPR_VAR_REF::GetObject( const LIBEVAL::CONTEXT* aCtx ) const
 }
 
 
-class PCBEXPR_LAYER_VALUE : public LIBEVAL::VALUE
+static bool layerMatches( BOARD* aBoard, PCB_LAYER_ID aLayer, const wxString& aLayerName )
 {
-public:
-    PCBEXPR_LAYER_VALUE( PCB_LAYER_ID aLayer ) :
-        LIBEVAL::VALUE( LayerName( aLayer ) ),
-        m_layer( aLayer )
-    {};
+    // For boards with user-defined layer names there will be 2 entries for each layer
+    // in the ENUM_MAP: one for the canonical layer name and one for the user layer name.
+    // We need to check against both.
+
+    wxPGChoices& layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
 
-    virtual bool EqualTo( LIBEVAL::CONTEXT* aCtx, const VALUE* b ) const override
     {
-        // For boards with user-defined layer names there will be 2 entries for each layer
-        // in the ENUM_MAP: one for the canonical layer name and one for the user layer name.
-        // We need to check against both.
+        std::shared_lock<std::shared_mutex> readLock( aBoard->m_CachesMutex );
 
-        wxPGChoices&    layerMap = ENUM_MAP<PCB_LAYER_ID>::Instance().Choices();
-        const wxString& layerName = b->AsString();
-        BOARD*          board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
+        auto i = aBoard->m_LayerExpressionCache.find( aLayerName );
 
-        {
-            std::shared_lock<std::shared_mutex> readLock( board->m_CachesMutex );
+        if( i != aBoard->m_LayerExpressionCache.end() )
+            return i->second.Contains( aLayer );
+    }
 
-            auto i = board->m_LayerExpressionCache.find( layerName );
+    LSET mask;
 
-            if( i != board->m_LayerExpressionCache.end() )
-                return i->second.Contains( m_layer );
-        }
+    for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
+    {
+        wxPGChoiceEntry& entry = layerMap[ii];
 
-        LSET mask;
+        if( entry.GetText().Matches( aLayerName ) )
+            mask.set( ToLAYER_ID( entry.GetValue() ) );
+    }
 
-        for( unsigned ii = 0; ii < layerMap.GetCount(); ++ii )
-        {
-            wxPGChoiceEntry& entry = layerMap[ii];
+    {
+        std::unique_lock<std::shared_mutex> writeLock( aBoard->m_CachesMutex );
+        aBoard->m_LayerExpressionCache[ aLayerName ] = mask;
+    }
 
-            if( entry.GetText().Matches( layerName ) )
-                mask.set( ToLAYER_ID( entry.GetValue() ) );
-        }
+    return mask.Contains( aLayer );
+}
 
-        {
-            std::unique_lock<std::shared_mutex> writeLock( board->m_CachesMutex );
-            board->m_LayerExpressionCache[ layerName ] = mask;
-        }
 
-        return mask.Contains( m_layer );
+class PCBEXPR_LAYER_VALUE : public LIBEVAL::VALUE
+{
+public:
+    PCBEXPR_LAYER_VALUE( PCB_LAYER_ID aLayer ) :
+        LIBEVAL::VALUE( LayerName( aLayer ) ),
+        m_layer( aLayer )
+    {};
+
+    virtual bool EqualTo( LIBEVAL::CONTEXT* aCtx, const VALUE* b ) const override
+    {
+        return layerMatches( static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard(), m_layer,
+                             b->AsString() );
     }
 
 protected:
@@ -148,6 +154,36 @@ public:
 };
 
 
+/**
+ * Match the effective netclass of \a aItem against a netclass name (or wildcard pattern).
+ *
+ * Both the constituent netclasses and the effective netclass itself (whose name is the list of
+ * its constituents, e.g. CLASS1,CLASS2,OTHER_CLASS) are tested.
+ */
+static bool netclassMatches( const BOARD_CONNECTED_ITEM* aItem, const wxString& aName,
+                             bool aIsWildcard )
+{
+    auto matches =
+            [&]( const wxString& ncName )
+            {
+                if( aIsWildcard )
+                    return WildCompareString( aName, ncName, false );
+                else
+                    return ncName.IsSameAs( aName, false );
+            };
+
+    NETCLASS* effectiveNetclass = aItem->GetEffectiveNetClass();
+
+    for( const NETCLASS* nc : effectiveNetclass->GetConstituentNetclasses() )
+    {
+        if( matches( nc->GetName() ) )
+            return true;
+    }
+
+    return matches( effectiveNetclass->GetName() );
+}
+
+
 class PCBEXPR_NETCLASS_VALUE : public LIBEVAL::VALUE
 {
 public:
@@ -168,25 +204,7 @@ public:
             return *( m_item->GetEffectiveNetClass() ) == *( bValue->m_item->GetEffectiveNetClass() );
 
         if( b->GetType() == LIBEVAL::VT_STRING )
-        {
-            // Test constituent net class names. The effective net class name (e.g. CLASS1,CLASS2,OTHER_CLASS) is
-            // tested in the fallthrough condition.
-            for( const NETCLASS* nc : m_item->GetEffectiveNetClass()->GetConstituentNetclasses() )
-            {
-                const wxString& ncName = nc->GetName();
-
-                if( b->StringIsWildcard() )
-                {
-                    if( WildCompareString( b->AsString(), ncName, false ) )
-                        return true;
-                }
-                else
-                {
-                    if( ncName.IsSameAs( b->AsString(), false ) )
-                        return true;
-                }
-            }
-        }
+            return netclassMatches( m_item, b->AsString(), b->StringIsWildcard() );
 
         return LIBEVAL::VALUE::EqualTo( aCtx, b );
     }
@@ -197,37 +215,7 @@ public:
             return *( m_item->GetEffectiveNetClass() ) != *( bValue->m_item->GetEffectiveNetClass() );
 
         if( b->GetType() == LIBEVAL::VT_STRING )
-        {
-            // Test constituent net class names
-            bool isInConstituents = false;
-
-            for( const NETCLASS* nc : m_item->GetEffectiveNetClass()->GetConstituentNetclasses() )
-            {
-                const wxString& ncName = nc->GetName();
-
-                if( b->StringIsWildcard() )
-                {
-                    if( WildCompareString( b->AsString(), ncName, false ) )
-                    {
-                        isInConstituents = true;
-                        break;
-                    }
-                }
-                else
-                {
-                    if( ncName.IsSameAs( b->AsString(), false ) )
-                    {
-                        isInConstituents = true;
-                        break;
-                    }
-                }
-            }
-
-            // Test effective net class name
-            const bool isFullName = LIBEVAL::VALUE::EqualTo( aCtx, b );
-
-            return !isInConstituents && !isFullName;
-        }
+            return !netclassMatches( m_item, b->AsString(), b->StringIsWildcard() );
 
         return LIBEVAL::VALUE::NotEqualTo( aCtx, b );
     }
@@ -409,33 +397,16 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     }
     else
     {
-        if( m_type == LIBEVAL::VT_NUMERIC )
-        {
-            if( m_isOptional )
-            {
-                std::optional<int> val = item->Get<std::optional<int>>( it->second );
+        const PROPERTY_ACCESSOR& accessor = it->second;
 
-                if( val.has_value() )
-                    return new LIBEVAL::VALUE( static_cast<double>( val.value() ) );
-
-                return LIBEVAL::VALUE::MakeNullValue();
-            }
-
-            return new LIBEVAL::VALUE( static_cast<double>( item->Get<int>( it->second ) ) );
-        }
-        else if( m_type == LIBEVAL::VT_NUMERIC_DOUBLE )
+        if( m_type == LIBEVAL::VT_NUMERIC || m_type == LIBEVAL::VT_NUMERIC_DOUBLE )
         {
-            if( m_isOptional )
-            {
-                std::optional<double> val = item->Get<std::optional<double>>( it->second );
-
-                if( val.has_value() )
-                    return new LIBEVAL::VALUE( val.value() );
+            std::optional<double> val = numericValue( item, accessor );
 
-                return LIBEVAL::VALUE::MakeNullValue();
-            }
+            if( val.has_value() )
+                return new LIBEVAL::VALUE( val.value() );
 
-            return new LIBEVAL::VALUE( item->Get<double>( it->second ) );
+            return LIBEVAL::VALUE::MakeNullValue();
         }
         else
         {
@@ -443,9 +414,10 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 
             if( !m_isEnum )
             {
-                str = item->Get<wxString>( it->second );
+                if( !accessor.GetString( item, str ) )
+                    str = item->Get<wxString>( accessor.Property() );
 
-                if( it->second->Name() == wxT( "Pin Type" ) )
+                if( accessor.Property()->Name() == wxT( "Pin Type" ) )
                     return new PCBEXPR_PINTYPE_VALUE( str );
 
                 // If it quacks like a duck, it is a duck
@@ -456,11 +428,11 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 
                 return new LIBEVAL::VALUE( str );
             }
-            else if( it->second->Name() == wxT( "Layer" )
-                        || it->second->Name() == wxT( "Layer Top" )
-                        || it->second->Name() == wxT( "Layer Bottom" ) )
+            else if( accessor.Property()->Name() == wxT( "Layer" )
+                        || accessor.Property()->Name() == wxT( "Layer Top" )
+                        || accessor.Property()->Name() == wxT( "Layer Bottom" ) )
             {
-                const wxAny& any = item->Get( it->second );
+                const wxAny& any = accessor.Get( item );
                 PCB_LAYER_ID layer;
 
                 if( any.GetAs<PCB_LAYER_ID>( &layer ) )
@@ -470,7 +442,7 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
             }
             else
             {
-                const wxAny& any = item->Get( it->second );
+                const wxAny& any = accessor.Get( item );
 
                 if( any.GetAs<wxString>( &str ) )
                     return new LIBEVAL::VALUE( str );
@@ -482,6 +454,107 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 }
 
 
+bool PCBEXPR_VAR_REF::IsLayerProperty() const
+{
+    if( !m_isEnum || m_matchingTypes.empty() )
+        return false;
+
+    for( const auto& [type, accessor] : m_matchingTypes )
+    {
+        const wxString& name = accessor.Property()->Name();
+
+        if( name != wxT( "Layer" ) && name != wxT( "Layer Top" ) && name != wxT( "Layer Bottom" ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::optional<double> PCBEXPR_VAR_REF::GetNumericValue( const LIBEVAL::CONTEXT* aCtx ) const
+{
+    BOARD_ITEM* item = GetObject( aCtx );
+
+    if( !item )
+        return std::nullopt;
+
+    auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
+
+    if( it == m_matchingTypes.end() )
+        return std::nullopt;
+
+    if( m_type == LIBEVAL::VT_NUMERIC || m_type == LIBEVAL::VT_NUMERIC_DOUBLE )
+        return numericValue( item, it->second );
+
+    return std::nullopt;
+}
+
+
+std::optional<double> PCBEXPR_VAR_REF::numericValue( const BOARD_ITEM* aItem,
+                                                     const PROPERTY_ACCESSOR& aAccessor ) const
+{
+    std::optional<double> val;
+
+    // Typed read, without the wxAny and the class lookups of INSPECTABLE::Get()
+    if( aAccessor.GetNumeric( aItem, val ) )
+        return val;
+
+    PROPERTY_BASE* prop = aAccessor.Property();
+
+    if( m_type == LIBEVAL::VT_NUMERIC )
+    {
+        if( m_isOptional )
+        {
+            std::optional<int> intVal = aItem->Get<std::optional<int>>( prop );
+
+            if( intVal.has_value() )
+                return static_cast<double>( intVal.value() );
+
+            return std::nullopt;
+        }
+
+        return static_cast<double>( aItem->Get<int>( prop ) );
+    }
+
+    if( m_isOptional )
+        return aItem->Get<std::optional<double>>( prop );
+
+    return aItem->Get<double>( prop );
+}
+
+
+std::optional<PCB_LAYER_ID> PCBEXPR_VAR_REF::GetLayerValue( const LIBEVAL::CONTEXT* aCtx ) const
+{
+    const PCBEXPR_CONTEXT* context = static_cast<const PCBEXPR_CONTEXT*>( aCtx );
+
+    if( m_itemIndex == 2 )
+        return context->GetLayer();
+
+    BOARD_ITEM* item = GetObject( aCtx );
+
+    if( !item )
+        return std::nullopt;
+
+    auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
+
+    if( it == m_matchingTypes.end() )
+        return std::nullopt;
+
+    const wxAny& any = it->second.Get( item );
+    PCB_LAYER_ID layer;
+    wxString     str;
+
+    if( any.GetAs<PCB_LAYER_ID>( &layer ) )
+        return layer;
+    else if( any.GetAs<wxString>( &str ) )
+        return context->GetBoard()->GetLayerID( str );
+
+    return std::nullopt;
+}
+
+
 LIBEVAL::VALUE* PCBEXPR_NETCLASS_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 {
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
@@ -534,6 +607,99 @@ LIBEVAL::FUNC_CALL_REF PCBEXPR_UCODE::CreateFuncCall( const wxString& aName )
 }
 
 
+PCBEXPR_UCODE::CLOSURE PCBEXPR_UCODE::lowerComparison( int aOp, LIBEVAL::VAR_REF* aRef,
+                                                       const LIBEVAL::VALUE* aConstant )
+{
+    // Undefined values (missing items, or items without the property) compare neither equal
+    // nor unequal.
+    const bool equal = aOp == TR_OP_EQUAL;
+
+    if( PCBEXPR_NETCLASS_REF* ncRef = dynamic_cast<PCBEXPR_NETCLASS_REF*>( aRef ) )
+    {
+        if( aConstant->GetType() != LIBEVAL::VT_STRING )
+            return nullptr;
+
+        return [ncRef, equal, name = aConstant->AsString(),
+                wildcard = aConstant->StringIsWildcard()]( LIBEVAL::CONTEXT* aCtx ) -> double
+               {
+                   BOARD_CONNECTED_ITEM* item =
+                           dynamic_cast<BOARD_CONNECTED_ITEM*>( ncRef->GetObject( aCtx ) );
+
+                   if( !item )
+                       return 0.0;
+
+                   return netclassMatches( item, name, wildcard ) == equal ? 1.0 : 0.0;
+               };
+    }
+
+    // Only plain property references: the other specialized references have their own values
+    if( !aRef || typeid( *aRef ) != typeid( PCBEXPR_VAR_REF ) )
+        return nullptr;
+
+    PCBEXPR_VAR_REF* ref = static_cast<PCBEXPR_VAR_REF*>( aRef );
+
+    if( ref->GetType() == LIBEVAL::VT_NULL )
+        return nullptr;
+
+    if( ref->GetItemIndex() == 2 || ref->IsLayerProperty() )
+    {
+        if( aConstant->GetType() != LIBEVAL::VT_STRING )
+            return nullptr;
+
+        return [ref, equal, name = aConstant->AsString()]( LIBEVAL::CONTEXT* aCtx ) -> double
+               {
+                   std::optional<PCB_LAYER_ID> layer = ref->GetLayerValue( aCtx );
+
+                   if( !layer )
+                       return 0.0;
+
+                   BOARD* board = static_cast<PCBEXPR_CONTEXT*>( aCtx )->GetBoard();
+
+                   return layerMatches( board, *layer, name ) == equal ? 1.0 : 0.0;
+               };
+    }
+
+    // Optional properties can also give null values, which do compare unequal to numbers
+    if( ( ref->GetType() == LIBEVAL::VT_NUMERIC || ref->GetType() == LIBEVAL::VT_NUMERIC_DOUBLE )
+            && !ref->IsOptional() && aConstant->GetType() == LIBEVAL::VT_NUMERIC )
+    {
+        return [ref, equal, value = aConstant->AsDouble()]( LIBEVAL::CONTEXT* aCtx ) -> double
+               {
+                   std::optional<double> propValue = ref->GetNumericValue( aCtx );
+
+                   if( !propValue )
+                       return 0.0;
+
+                   return ( *propValue == value ) == equal ? 1.0 : 0.0;
+               };
+    }
+
+    return nullptr;
+}
+
+
+PCBEXPR_UCODE::CLOSURE PCBEXPR_UCODE::lowerNumericRef( LIBEVAL::VAR_REF* aRef )
+{
+    if( !aRef || typeid( *aRef ) != typeid( PCBEXPR_VAR_REF ) )
+        return nullptr;
+
+    PCBEXPR_VAR_REF* ref = static_cast<PCBEXPR_VAR_REF*>( aRef );
+
+    if( ref->GetItemIndex() == 2
+            || ( ref->GetType() != LIBEVAL::VT_NUMERIC
+                 && ref->GetType() != LIBEVAL::VT_NUMERIC_DOUBLE ) )
+    {
+        return nullptr;
+    }
+
+    // Undefined and null values are 0 as numbers
+    return [ref]( LIBEVAL::CONTEXT* aCtx ) -> double
+           {
+               return ref->GetNumericValue( aCtx ).value_or( 0.0 );
+           };
+}
+
+
 std::unique_ptr<LIBEVAL::VAR_REF> PCBEXPR_UCODE::CreateVarRef( const wxString& aVar,
                                                                const wxString& aField )
 {
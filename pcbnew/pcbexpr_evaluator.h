@@ -25,12 +25,14 @@
 #ifndef PCBEXPR_EVALUATOR_H
 #define PCBEXPR_EVALUATOR_H
 
+#include <optional>
 #include <unordered_map>
 
 #include <layer_ids.h>
 
 #include <properties/property.h>
 #include <properties/property_mgr.h>
+#include <inspectable.h>
 
 #include <libeval_compiler/libeval_compiler.h>
 
@@ -48,6 +50,11 @@ public:
     virtual std::unique_ptr<LIBEVAL::VAR_REF> CreateVarRef( const wxString& aVar,
                                                             const wxString& aField ) override;
     virtual LIBEVAL::FUNC_CALL_REF CreateFuncCall( const wxString& aName ) override;
+
+protected:
+    CLOSURE lowerComparison( int aOp, LIBEVAL::VAR_REF* aRef,
+                             const LIBEVAL::VALUE* aConstant ) override;
+    CLOSURE lowerNumericRef( LIBEVAL::VAR_REF* aRef ) override;
 };
 
 
@@ -104,19 +111,44 @@ public:
 
     void AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop )
     {
-        m_matchingTypes[type_hash] = prop;
+        m_matchingTypes.insert_or_assign( type_hash, PROPERTY_ACCESSOR( type_hash, prop ) );
     }
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
 
     BOARD_ITEM* GetObject( const LIBEVAL::CONTEXT* aCtx ) const;
 
+    int GetItemIndex() const { return m_itemIndex; }
+
+    /// @return true if the reference is to the layer (or top/bottom layer) of the item.
+    bool IsLayerProperty() const;
+
+    /**
+     * The value of a numeric property, as given by GetValue() but without allocating it.
+     *
+     * @return std::nullopt where GetValue() gives an undefined or null value.
+     */
+    std::optional<double> GetNumericValue( const LIBEVAL::CONTEXT* aCtx ) const;
+
+    /**
+     * The value of a layer property (or of "L"), as given by GetValue() but without allocating
+     * it.
+     *
+     * @return std::nullopt where GetValue() gives an undefined value.
+     */
+    std::optional<PCB_LAYER_ID> GetLayerValue( const LIBEVAL::CONTEXT* aCtx ) const;
+
 private:
-    std::unordered_map<TYPE_ID, PROPERTY_BASE*> m_matchingTypes;
-    int                                         m_itemIndex;
-    LIBEVAL::VAR_TYPE_T                         m_type;
-    bool                                        m_isEnum;
-    bool                                        m_isOptional;
+    /// Read a numeric property, through the typed getter when the property has one
+    std::optional<double> numericValue( const BOARD_ITEM* aItem,
+                                        const PROPERTY_ACCESSOR& aAccessor ) const;
+
+    /// The property for each item class it exists in, with the casts resolved at compile time
+    std::unordered_map<TYPE_ID, PROPERTY_ACCESSOR> m_matchingTypes;
+    int                                            m_itemIndex;
+    LIBEVAL::VAR_TYPE_T                            m_type;
+    bool                                           m_isEnum;
+    bool                                           m_isOptional;
 };
 
 
@@ -632,6 +632,18 @@ void IFACE::PreloadLibraries( KIWAY* aKiway )
             int elapsed = 0;
 
             reporter->Report( _( "Loading Footprint Libraries" ) );
+
+            // The libraries the project uses are loaded first: the board's footprints, and the
+            // footprints assigned in the schematic for a board not updated yet
+            wxString           projectPath = aKiway->Prj().GetProjectPath();
+            std::set<wxString> used = LIBRARY_MANAGER_ADAPTER::ReferencedLibraries(
+                    projectPath, wxS( "*.kicad_pcb" ), { "(footprint \"" } );
+            std::set<wxString> assigned = LIBRARY_MANAGER_ADAPTER::ReferencedLibraries(
+                    projectPath, wxS( "*.kicad_sch" ), { "(property \"Footprint\" \"" } );
+
+            used.insert( assigned.begin(), assigned.end() );
+            adapter->SetPreferredLibraries( used );
+
             adapter->AsyncLoad();
 
             while( true )
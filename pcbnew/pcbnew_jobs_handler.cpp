@@ -20,6 +20,7 @@
 
 #include <wx/dir.h>
 #include "pcbnew_jobs_handler.h"
+#include <autorouter/ar_global_router.h>
 #include <board_commit.h>
 #include <board_design_settings.h>
 #include <board_statistics_report.h>
@@ -46,10 +47,12 @@
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_render.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_route.h>
 #include <jobs/job_pcb_upgrade.h>
 #include <eda_units.h>
 #include <lset.h>
 #include <cli/exit_codes.h>
+#include <connectivity/connectivity_data.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
@@ -59,6 +62,7 @@
 #include <tools/drc_tool.h>
 #include <wx/crt.h>
 #include <filename_resolver.h>
+#include <footprint.h>
 #include <gerber_jobfile_writer.h>
 #include "gerber_placefile_writer.h"
 #include <gendrill_excellon_writer.h>
@@ -78,6 +82,8 @@
 #include <pcb_plotter.h>
 #include <pcb_edit_frame.h>
 #include <pgm_base.h>
+#include <ratsnest/ratsnest_data.h>
+#include <router/pns_batch_router.h>
 #include <3d_rendering/raytracing/render_3d_raytrace_ram.h>
 #include <3d_rendering/track_ball.h>
 #include <project_pcb.h>
@@ -102,6 +108,7 @@
 #include <dialogs/dialog_board_stats_job.h>
 #include <paths.h>
 #include <tools/zone_filler_tool.h>
+#include <thread_pool.h>
 
 #include "pcbnew_scripting_helpers.h"
 #include <locale_io.h>
@@ -118,7 +125,8 @@
 PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
         JOB_DISPATCHER( aKiway ),
         m_cliBoard( nullptr ),
-        m_toolManager( nullptr )
+        m_toolManager( nullptr ),
+        m_cliBoardFilledTimeStamp( -1 )
 {
     Register( "3d", std::bind( &PCBNEW_JOBS_HANDLER::JobExportStep, this, std::placeholders::_1 ),
               [aKiway]( JOB* job, wxWindow* aParent ) -> bool
@@ -149,6 +157,11 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER( KIWAY* aKiway ) :
               {
                   return true;
               } );
+    Register( "route", std::bind( &PCBNEW_JOBS_HANDLER::JobRoute, this, std::placeholders::_1 ),
+              []( JOB* job, wxWindow* aParent ) -> bool
+              {
+                  return true;
+              } );
     Register( "svg", std::bind( &PCBNEW_JOBS_HANDLER::JobExportSvg, this, std::placeholders::_1 ),
               [aKiway]( JOB* job, wxWindow* aParent ) -> bool
               {
@@ -441,6 +454,23 @@ BOARD* PCBNEW_JOBS_HANDLER::getBoard( const wxString& aPath )
 }
 
 
+void PCBNEW_JOBS_HANDLER::refillZones( BOARD* aBoard, TOOL_MANAGER* aToolManager )
+{
+    // The CLI board is loaded once and shared by all the jobs of a jobset, so its zones only
+    // need refilling again if an earlier job has modified it since they were last filled.
+    if( aBoard == m_cliBoard && aBoard->GetTimeStamp() == m_cliBoardFilledTimeStamp )
+        return;
+
+    if( !aToolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
+        aToolManager->RegisterTool( new ZONE_FILLER_TOOL );
+
+    aToolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
+
+    if( aBoard == m_cliBoard )
+        m_cliBoardFilledTimeStamp = aBoard->GetTimeStamp();
+}
+
+
 LSEQ PCBNEW_JOBS_HANDLER::convertLayerArg( wxString& aLayerString, BOARD* aBoard ) const
 {
     std::map<wxString, LSET> layerUserMasks;
@@ -925,12 +955,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     }
 
     if( aSvgJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     if( aSvgJob->m_argLayers )
         aSvgJob->m_plotLayerSequence = convertLayerArg( aSvgJob->m_argLayers.value(), brd );
@@ -991,12 +1016,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     TOOL_MANAGER* toolManager = getToolManager( brd );
 
     if( aDxfJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     if( aDxfJob->m_argLayers )
         aDxfJob->m_plotLayerSequence = convertLayerArg( aDxfJob->m_argLayers.value(), brd );
@@ -1078,12 +1098,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
     TOOL_MANAGER* toolManager = getToolManager( brd );
 
     if( pdfJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     if( pdfJob->m_argLayers )
         pdfJob->m_plotLayerSequence = convertLayerArg( pdfJob->m_argLayers.value(), brd );
@@ -1166,12 +1181,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPs( JOB* aJob )
     TOOL_MANAGER* toolManager = getToolManager( brd );
 
     if( psJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     if( psJob->m_argLayers )
         psJob->m_plotLayerSequence = convertLayerArg( psJob->m_argLayers.value(), brd );
@@ -1262,12 +1272,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     TOOL_MANAGER* toolManager = getToolManager( brd );
 
     if( aGerberJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     bool hasLayerListSpecified = false; // will be true if the user layer list is not empty
 
@@ -1314,29 +1319,50 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     // Ensure layers to plot are restricted to enabled layers of the board to plot
     LSET layersToPlot = LSET( { aGerberJob->m_plotLayerSequence } ) & brd->GetEnabledLayers();
 
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    m_layer;
+        LSEQ            m_plotSequence;
+        PCB_PLOT_PARAMS m_plotOpts;
+        wxFileName      m_fn;
+        GERBER_PLOTTER* m_plotter;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
+    // StartPlotBoard() is given the address of each layer's plot params, so they must not move
+    layerPlots.reserve( layersToPlot.count() );
+
+    // Files are opened (and any drawing sheet plotted) in layer order, then the layers are
+    // plotted concurrently, each into its own plotter, and finally closed in layer order.
     for( PCB_LAYER_ID layer : layersToPlot.UIOrder() )
     {
-        LSEQ plotSequence;
+        LAYER_PLOT& layerPlot = layerPlots.emplace_back();
+
+        layerPlot.m_layer = layer;
 
         // Base layer always gets plotted first.
-        plotSequence.push_back( layer );
+        layerPlot.m_plotSequence.push_back( layer );
 
         // Now all the "include on all" layers
         for( PCB_LAYER_ID layer_all : aGerberJob->m_plotOnAllLayersSequence )
         {
             // Don't plot the same layer more than once;
-            if( find( plotSequence.begin(), plotSequence.end(), layer_all ) != plotSequence.end() )
+            if( find( layerPlot.m_plotSequence.begin(), layerPlot.m_plotSequence.end(), layer_all )
+                    != layerPlot.m_plotSequence.end() )
+            {
                 continue;
+            }
 
-            plotSequence.push_back( layer_all );
+            layerPlot.m_plotSequence.push_back( layer_all );
         }
 
         // Pick the basename from the board file
-        wxFileName      fn( brd->GetFileName() );
-        wxString        layerName = brd->GetLayerName( layer );
-        wxString        sheetName;
-        wxString        sheetPath;
-        PCB_PLOT_PARAMS plotOpts;
+        wxFileName       fn( brd->GetFileName() );
+        wxString         layerName = brd->GetLayerName( layer );
+        wxString         sheetName;
+        wxString         sheetPath;
+        PCB_PLOT_PARAMS& plotOpts = layerPlot.m_plotOpts;
 
         if( aGerberJob->m_useBoardPlotParams )
             plotOpts = boardPlotOptions;
@@ -1369,26 +1395,45 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             sheetPath = aJob->GetVarOverrides().at( wxT( "SHEETPATH" ) );
 
         // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter;
-        plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer, layerName,
-                                                    fn.GetFullPath(), sheetName, sheetPath );
+        layerPlot.m_fn = fn;
+        layerPlot.m_plotter = (GERBER_PLOTTER*) StartPlotBoard( brd, &plotOpts, layer, layerName,
+                                                                fn.GetFullPath(), sheetName,
+                                                                sheetPath );
+    }
+
+    // Plotting only reads the board, and each layer has its own plotter and output file
+    thread_pool& tp = GetKiCadThreadPool();
 
-        if( plotter )
+    tp.submit_loop( 0, layerPlots.size(),
+            [&]( const int ii )
+            {
+                LAYER_PLOT& layerPlot = layerPlots[ii];
+
+                if( layerPlot.m_plotter )
+                {
+                    PlotBoardLayers( brd, layerPlot.m_plotter, layerPlot.m_plotSequence,
+                                     layerPlot.m_plotOpts );
+                    layerPlot.m_plotter->EndPlot();
+                }
+            } ).wait();
+
+    for( LAYER_PLOT& layerPlot : layerPlots )
+    {
+        if( layerPlot.m_plotter )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                  layerPlot.m_fn.GetFullPath() ),
                                 RPT_SEVERITY_ACTION );
-
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
-            m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
+                                                  layerPlot.m_fn.GetFullPath() ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
 
-        delete plotter;
+        delete layerPlot.m_plotter;
     }
 
     if( aGerberJob->m_createJobsFile )
@@ -1411,10 +1456,10 @@ int PCBNEW_JOBS_HANDLER::JobExportGencad( JOB* aJob )
     if( aGencadJob == nullptr )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    BOARD* brd = LoadBoard( aGencadJob->m_filename, true ); // Ensure m_board is of type BOARD*
+    BOARD* brd = getBoard( aGencadJob->m_filename );
 
-    if( brd == nullptr )
-        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
 
     GENCAD_EXPORTER exporter( brd );
 
@@ -1577,12 +1622,7 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     wxString outPath = resolveJobOutputPath( aJob, brd );
 
     if( aGerberJob->m_checkZonesBeforePlot )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     PCB_PLOT_PARAMS plotOpts;
     PCB_PLOTTER::PlotJobToPlotOpts( plotOpts, aGerberJob, *m_reporter );
@@ -2026,7 +2066,8 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
 
         try
         {
-            fpLib.Load();
+            // Only list the footprints; they are parsed in parallel by Upgrade()
+            fpLib.Load( true );
         }
         catch( ... )
         {
@@ -2037,28 +2078,24 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
         if( m_progressReporter )
             m_progressReporter->KeepRefreshing();
 
-        bool shouldSave = upgradeJob->m_force;
+        int updated = 0;
 
-        for( const auto& footprint : fpLib.GetFootprints() )
+        try
         {
-            if( footprint.second->GetFootprint()->GetFileFormatVersionAtLoad() < SEXPR_BOARD_FILE_VERSION )
-                shouldSave = true;
+            updated = fpLib.Upgrade( upgradeJob->m_force, upgradeJob->m_outputLibraryPath,
+                                     m_progressReporter );
         }
-
-        if( shouldSave )
+        catch( const IO_ERROR& ioe )
         {
-            try
-            {
-                if( !upgradeJob->m_outputLibraryPath.IsEmpty() )
-                    fpLib.SetPath( upgradeJob->m_outputLibraryPath );
+            m_reporter->Report( _( "Unable to save library\n" ), RPT_SEVERITY_ERROR );
+            m_reporter->Report( ioe.What() + wxS( "\n" ), RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_UNKNOWN;
+        }
 
-                fpLib.Save();
-            }
-            catch( ... )
-            {
-                m_reporter->Report( _( "Unable to save library\n" ), RPT_SEVERITY_ERROR );
-                return CLI::EXIT_CODES::ERR_UNKNOWN;
-            }
+        if( updated > 0 )
+        {
+            m_reporter->Report( wxString::Format( _( "%d footprints saved in updated format\n" ), updated ),
+                                RPT_SEVERITY_ACTION );
         }
         else
         {
@@ -2115,33 +2152,74 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
         return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
     }
 
-    int  exitCode = CLI::EXIT_CODES::OK;
-    bool singleFpPlotted = false;
+    std::vector<std::pair<wxString, const FOOTPRINT*>> footprints;
 
     for( const auto& [fpName, fpCacheEntry] : fpLib.GetFootprints() )
     {
-        if( m_progressReporter )
-        {
-            m_progressReporter->AdvancePhase( wxString::Format( _( "Exporting %s" ), fpName ) );
-            m_progressReporter->KeepRefreshing();
-        }
+        // skip until we find the right footprint
+        if( svgJob->m_footprint.IsEmpty() || fpName == svgJob->m_footprint )
+            footprints.emplace_back( fpName, fpCacheEntry->GetFootprint().get() );
+    }
 
-        if( !svgJob->m_footprint.IsEmpty() )
-        {
-            // skip until we find the right footprint
-            if( fpName != svgJob->m_footprint )
-                continue;
-            else
-                singleFpPlotted = true;
-        }
+    PCB_PLOT_PARAMS plotOpts;
+    PCB_PLOTTER::PlotJobToPlotOpts( plotOpts, svgJob, *m_reporter );
 
-        exitCode = doFpExportSvg( svgJob, fpCacheEntry->GetFootprint().get() );
+    // always fixed for the svg plot
+    plotOpts.SetPlotFrameRef( false );
+    plotOpts.SetSvgFitPageToBoard( true );
+    plotOpts.SetMirror( false );
+    plotOpts.SetSkipPlotNPTH_Pads( false );
 
-        if( exitCode != CLI::EXIT_CODES::OK )
-            break;
+    if( plotOpts.GetSketchPadsOnFabLayers() )
+        plotOpts.SetPlotPadNumbers( true );
+
+    // The footprints are plotted in parallel, a batch at a time.  The boards holding them are
+    // linked to the project, which isn't thread safe, so they are only created and destroyed
+    // here; the workers just plot them, each with its own plotter and reporter.
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       batchSize = std::max<size_t>( 1, 4 * tp.get_thread_count() );
+    int          exitCode = CLI::EXIT_CODES::OK;
+
+    // The plotters need the C locale, and switching it is only safe from here
+    LOCALE_IO toggle;
+
+    for( size_t first = 0; first < footprints.size() && exitCode == CLI::EXIT_CODES::OK;
+         first += batchSize )
+    {
+        size_t                              count = std::min( batchSize, footprints.size() - first );
+        std::vector<std::unique_ptr<BOARD>> boards;
+        std::vector<BUFFERED_REPORTER>      reporters( count );
+        std::vector<int>                    results( count, CLI::EXIT_CODES::ERR_UNKNOWN );
+
+        for( size_t ii = 0; ii < count; ++ii )
+            boards.push_back( createFpSvgBoard( svgJob, footprints[first + ii].second ) );
+
+        tp.submit_loop( size_t( 0 ), count,
+                [&]( size_t ii )
+                {
+                    if( boards[ii] )
+                    {
+                        results[ii] = doFpExportSvg( svgJob, boards[ii].get(),
+                                                     footprints[first + ii].second, plotOpts,
+                                                     reporters[ii] );
+                    }
+                } ).wait();
+
+        for( size_t ii = 0; ii < count && exitCode == CLI::EXIT_CODES::OK; ++ii )
+        {
+            if( m_progressReporter )
+            {
+                m_progressReporter->AdvancePhase( wxString::Format( _( "Exporting %s" ),
+                                                                    footprints[first + ii].first ) );
+                m_progressReporter->KeepRefreshing();
+            }
+
+            reporters[ii].Replay( *m_reporter );
+            exitCode = results[ii];
+        }
     }
 
-    if( !svgJob->m_footprint.IsEmpty() && !singleFpPlotted )
+    if( !svgJob->m_footprint.IsEmpty() && footprints.empty() )
     {
         m_reporter->Report( _( "The given footprint could not be found to export." ) + wxS( "\n" ),
                             RPT_SEVERITY_ERROR );
@@ -2151,19 +2229,24 @@ int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
 }
 
 
-int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint )
+std::unique_ptr<BOARD> PCBNEW_JOBS_HANDLER::createFpSvgBoard( JOB_FP_EXPORT_SVG* aSvgJob,
+                                                              const FOOTPRINT*   aFootprint )
 {
     // the hack for now is we create fake boards containing the footprint and plot the board
     // until we refactor better plot api later
     std::unique_ptr<BOARD> brd;
     brd.reset( CreateEmptyBoard() );
+
+    if( !brd )
+        return nullptr;
+
     brd->GetProject()->ApplyTextVars( aSvgJob->GetVarOverrides() );
     brd->SynchronizeProperties();
 
     FOOTPRINT* fp = dynamic_cast<FOOTPRINT*>( aFootprint->Clone() );
 
     if( fp == nullptr )
-        return CLI::EXIT_CODES::ERR_UNKNOWN;
+        return nullptr;
 
     fp->SetLink( niluuid );
     fp->SetFlags( IS_NEW );
@@ -2180,31 +2263,25 @@ int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPR
 
     brd->Add( fp, ADD_MODE::INSERT, true );
 
+    return brd;
+}
+
+
+int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, BOARD* aBoard,
+                                        const FOOTPRINT* aFootprint,
+                                        PCB_PLOT_PARAMS aPlotOpts, REPORTER& aReporter )
+{
     wxFileName outputFile;
     outputFile.SetPath( aSvgJob->GetFullOutputPath(nullptr) );
     outputFile.SetName( aFootprint->GetFPID().GetLibItemName().wx_str() );
     outputFile.SetExt( FILEEXT::SVGFileExtension );
 
-    m_reporter->Report( wxString::Format( _( "Plotting footprint '%s' to '%s'\n" ),
-                                          aFootprint->GetFPID().GetLibItemName().wx_str(),
-                                          outputFile.GetFullPath() ),
-                        RPT_SEVERITY_ACTION );
+    aReporter.Report( wxString::Format( _( "Plotting footprint '%s' to '%s'\n" ),
+                                        aFootprint->GetFPID().GetLibItemName().wx_str(),
+                                        outputFile.GetFullPath() ),
+                      RPT_SEVERITY_ACTION );
 
-    PCB_PLOT_PARAMS plotOpts;
-    PCB_PLOTTER::PlotJobToPlotOpts( plotOpts, aSvgJob, *m_reporter );
-
-    // always fixed for the svg plot
-    plotOpts.SetPlotFrameRef( false );
-    plotOpts.SetSvgFitPageToBoard( true );
-    plotOpts.SetMirror( false );
-    plotOpts.SetSkipPlotNPTH_Pads( false );
-
-    if( plotOpts.GetSketchPadsOnFabLayers() )
-    {
-        plotOpts.SetPlotPadNumbers( true );
-    }
-
-    PCB_PLOTTER plotter( brd.get(), m_reporter, plotOpts );
+    PCB_PLOTTER plotter( aBoard, &aReporter, aPlotOpts );
 
     if( !plotter.Plot( outputFile.GetFullPath(),
                        aSvgJob->m_plotLayerSequence,
@@ -2214,7 +2291,7 @@ int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPR
                        wxEmptyString, wxEmptyString,
                        wxEmptyString ) )
     {
-        m_reporter->Report( _( "Error creating svg file" ) + wxS( "\n" ), RPT_SEVERITY_ERROR );
+        aReporter.Report( _( "Error creating svg file" ) + wxS( "\n" ), RPT_SEVERITY_ERROR );
         return CLI::EXIT_CODES::ERR_UNKNOWN;
     }
 
@@ -2342,12 +2419,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
     }
 
     if( drcJob->m_refillZones )
-    {
-        if( !toolManager->FindTool( ZONE_FILLER_TOOL_NAME ) )
-            toolManager->RegisterTool( new ZONE_FILLER_TOOL );
-
-        toolManager->GetTool<ZONE_FILLER_TOOL>()->FillAllZones( nullptr, m_progressReporter, true );
-    }
+        refillZones( brd, toolManager );
 
     drcEngine->SetProgressReporter( m_progressReporter );
     drcEngine->SetViolationHandler(
@@ -2668,6 +2740,148 @@ int PCBNEW_JOBS_HANDLER::JobUpgrade( JOB* aJob )
     return CLI::EXIT_CODES::SUCCESS;
 }
 
+int PCBNEW_JOBS_HANDLER::JobRoute( JOB* aJob )
+{
+    JOB_PCB_ROUTE* job = dynamic_cast<JOB_PCB_ROUTE*>( aJob );
+
+    if( job == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    BOARD* brd = getBoard( job->m_filename );
+
+    if( !brd )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    std::vector<int> netCodes;
+
+    if( job->m_nets.empty() )
+    {
+        for( NETINFO_ITEM* net : brd->GetNetInfo() )
+        {
+            if( net->GetNetCode() > 0 )
+                netCodes.push_back( net->GetNetCode() );
+        }
+    }
+    else
+    {
+        for( const wxString& netName : job->m_nets )
+        {
+            if( NETINFO_ITEM* net = brd->FindNet( netName ) )
+            {
+                netCodes.push_back( net->GetNetCode() );
+            }
+            else
+            {
+                m_reporter->Report( wxString::Format( _( "Net '%s' not found.\n" ), netName ),
+                                    RPT_SEVERITY_ERROR );
+                return CLI::EXIT_CODES::ERR_ARGS;
+            }
+        }
+    }
+
+    // Only the pad to pad connections of the ratsnest; partially routed connections are left
+    // to the designer.
+    std::vector<PNS_BATCH_ROUTER::CONNECTION> connections;
+
+    for( int netCode : netCodes )
+    {
+        RN_NET* rnNet = brd->GetConnectivity()->GetRatsnestForNet( netCode );
+
+        if( !rnNet )
+            continue;
+
+        for( const CN_EDGE& edge : rnNet->GetEdges() )
+        {
+            BOARD_CONNECTED_ITEM* source = edge.GetSourceNode()->Parent();
+            BOARD_CONNECTED_ITEM* target = edge.GetTargetNode()->Parent();
+
+            if( source->Type() == PCB_PAD_T && target->Type() == PCB_PAD_T )
+                connections.push_back( { static_cast<PAD*>( source ), static_cast<PAD*>( target ) } );
+        }
+    }
+
+    if( job->m_globalRoute )
+    {
+        AR_GLOBAL_ROUTER                         globalRouter( brd );
+        std::vector<AR_GLOBAL_ROUTER::CONNECTION> globalConnections;
+
+        for( const PNS_BATCH_ROUTER::CONNECTION& connection : connections )
+            globalConnections.push_back( { connection.m_start, connection.m_end } );
+
+        if( globalRouter.BuildMatrix() )
+        {
+            std::vector<AR_GLOBAL_ROUTER::GUIDE> guides = globalRouter.Route( globalConnections );
+
+            // Guides which change sides only pick the start layer, the router places the vias
+            for( size_t ii = 0; ii < guides.size(); ++ii )
+            {
+                if( !guides[ii].m_found )
+                    continue;
+
+                connections[ii].m_layer = guides[ii].m_sides.front() == AR_SIDE_TOP ? F_Cu : B_Cu;
+
+                if( guides[ii].IsSingleSided() )
+                    connections[ii].m_waypoints = guides[ii].Corners();
+            }
+        }
+    }
+
+    // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
+    PNS_BATCH_ROUTER router( brd, getToolManager( brd ) );
+
+    if( job->m_shove )
+        router.SetMode( PNS::RM_Shove );
+
+    std::vector<PNS_BATCH_ROUTER::RESULT> results = router.Route( connections );
+    int                                   routed = 0;
+
+    auto padName =
+            []( PAD* aPad ) -> wxString
+            {
+                return aPad->GetParentFootprint()->GetReference() + wxT( "-" ) + aPad->GetNumber();
+            };
+
+    for( size_t ii = 0; ii < results.size(); ++ii )
+    {
+        if( results[ii].m_routed )
+        {
+            routed++;
+            continue;
+        }
+
+        m_reporter->Report( wxString::Format( _( "Unable to route %s to %s: %s\n" ),
+                                              padName( connections[ii].m_start ),
+                                              padName( connections[ii].m_end ),
+                                              results[ii].m_failureReason ),
+                            RPT_SEVERITY_WARNING );
+    }
+
+    m_reporter->Report( wxString::Format( _( "Routed %d of %d connections.\n" ), routed,
+                                          (int) connections.size() ),
+                        RPT_SEVERITY_INFO );
+
+    if( !router.Commit( _( "Batch Routing" ) ) )
+        return CLI::EXIT_CODES::SUCCESS;
+
+    wxString outputPath = job->m_outputFile.IsEmpty() ? brd->GetFileName() : job->m_outputFile;
+
+    try
+    {
+        IO_RELEASER<PCB_IO> pi( PCB_IO_MGR::FindPlugin( PCB_IO_MGR::KICAD_SEXP ) );
+        pi->SaveBoard( outputPath, brd );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        wxString msg = wxString::Format( _( "Error saving board file '%s'.\n%s" ), outputPath,
+                                         ioe.What().GetData() );
+        m_reporter->Report( msg, RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+    }
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
+
+
 // Most job handlers need to align the running job with the board before resolving any
 // output paths with variables in them like ${REVISION}.
 wxString PCBNEW_JOBS_HANDLER::resolveJobOutputPath( JOB* aJob, BOARD* aBoard, const wxString* aDrawingSheet )
@@ -21,6 +21,7 @@
 #ifndef PCBNEW_JOBS_HANDLER_H
 #define PCBNEW_JOBS_HANDLER_H
 
+#include <memory>
 #include <jobs/job_dispatcher.h>
 #include <pcb_plot_params.h>
 
@@ -31,6 +32,7 @@ class FOOTPRINT;
 class JOB_EXPORT_PCB_GERBER;
 class JOB_EXPORT_PCB_GERBERS;
 class JOB_FP_EXPORT_SVG;
+class REPORTER;
 class TOOL_MANAGER;
 
 class PCBNEW_JOBS_HANDLER : public JOB_DISPATCHER
@@ -58,6 +60,7 @@ public:
     int JobExportIpcD356( JOB* aJob );
     int JobExportStats( JOB* aJob );
     int JobUpgrade( JOB* aJob );
+    int JobRoute( JOB* aJob );
 
 private:
     BOARD* getBoard( const wxString& aPath = wxEmptyString );
@@ -67,7 +70,15 @@ private:
                                            JOB_EXPORT_PCB_GERBER* aJob );
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS& aPlotOpts,
                                            JOB_EXPORT_PCB_GERBERS* aJob );
-    int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
+    std::unique_ptr<BOARD> createFpSvgBoard( JOB_FP_EXPORT_SVG* aSvgJob,
+                                             const FOOTPRINT*   aFootprint );
+
+    /**
+     * Plot a board made by createFpSvgBoard().  Safe to call from the thread pool; the plot
+     * options are copied as the plotter updates them.
+     */
+    int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, BOARD* aBoard, const FOOTPRINT* aFootprint,
+                        PCB_PLOT_PARAMS aPlotOpts, REPORTER& aReporter );
     void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
     wxString resolveJobOutputPath( JOB* aJob, BOARD* aBoard, const wxString* aDrawingSheet = nullptr );
 
@@ -75,8 +86,15 @@ private:
 
     TOOL_MANAGER* getToolManager( BOARD* aBrd );
 
+    /**
+     * Refill all the zones of \a aBoard, unless it is the CLI board and its zones were already
+     * refilled by a previous job with no change to the board since.
+     */
+    void refillZones( BOARD* aBoard, TOOL_MANAGER* aToolManager );
+
     BOARD* m_cliBoard;
     std::unique_ptr<TOOL_MANAGER> m_toolManager;
+    int    m_cliBoardFilledTimeStamp;     ///< Board time stamp after the last CLI zone refill
 };
 
 #endif
@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <optional>
+
 #include <wx/log.h>
 #include <eda_item.h>
 #include <layer_ids.h>
@@ -436,13 +438,9 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, const LSET& aLayerMask
                     // Now offset the pad size by margin + width_adj
                     VECTOR2I padPlotsSize = pad->GetSize( aLayer ) + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-                    // Store these parameters that can be modified to plot inflated/deflated pads shape
                     PAD_SHAPE padShape = pad->GetShape( aLayer );
                     VECTOR2I  padSize = pad->GetSize( aLayer );
                     VECTOR2I  padDelta = pad->GetDelta( aLayer ); // has meaning only for trapezoidal pads
-                    // CornerRadius and CornerRadiusRatio can be modified
-                    // the radius is built from the ratio, so saving/restoring the ratio is enough
-                    double    padCornerRadiusRatio = pad->GetRoundRectRadiusRatio( aLayer );
 
                     // Don't draw a 0 sized pad.
                     // Note: a custom pad can have its pad anchor with size = 0
@@ -452,33 +450,42 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, const LSET& aLayerMask
                         return;
                     }
 
+                    // Inflated/deflated pads are plotted from a copy: the board's pads are only
+                    // read, so several layers can be plotted at the same time.
+                    std::optional<PAD> resizedPad;
+                    PAD*               plotPad = pad;
+
+                    if( padPlotsSize != padSize )
+                    {
+                        resizedPad.emplace( *pad );
+                        resizedPad->SetParentGroup( nullptr );
+                        resizedPad->SetSize( aLayer, padPlotsSize );
+                        plotPad = &resizedPad.value();
+                    }
+
                     switch( padShape )
                     {
                     case PAD_SHAPE::CIRCLE:
                     case PAD_SHAPE::OVAL:
-                        pad->SetSize( aLayer, padPlotsSize );
-
                         if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                             ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                            ( pad->GetSize(aLayer ) == pad->GetDrillSize() ) &&
+                            ( plotPad->GetSize( aLayer ) == pad->GetDrillSize() ) &&
                             ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
                         {
                             break;
                         }
 
-                        itemplotter.PlotPad( pad, aLayer, color, doSketchPads );
+                        itemplotter.PlotPad( plotPad, aLayer, color, doSketchPads );
                         break;
 
                     case PAD_SHAPE::RECTANGLE:
-                        pad->SetSize( aLayer, padPlotsSize );
-
                         if( mask_clearance > 0 )
                         {
-                            pad->SetShape( aLayer, PAD_SHAPE::ROUNDRECT );
-                            pad->SetRoundRectCornerRadius( aLayer, mask_clearance );
+                            plotPad->SetShape( aLayer, PAD_SHAPE::ROUNDRECT );
+                            plotPad->SetRoundRectCornerRadius( aLayer, mask_clearance );
                         }
 
-                        itemplotter.PlotPad( pad, aLayer, color, doSketchPads );
+                        itemplotter.PlotPad( plotPad, aLayer, color, doSketchPads );
                         break;
 
                     case PAD_SHAPE::TRAPEZOID:
@@ -530,11 +537,10 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, const LSET& aLayerMask
                         // rounding is stored as a percent, but we have to update this ratio
                         // to force recalculation of other values after size changing (we do not
                         // really change the rounding percent value)
-                        double radius_ratio = pad->GetRoundRectRadiusRatio( aLayer );
-                        pad->SetSize( aLayer, padPlotsSize );
-                        pad->SetRoundRectRadiusRatio( aLayer, radius_ratio );
+                        if( resizedPad )
+                            resizedPad->SetRoundRectRadiusRatio( aLayer, pad->GetRoundRectRadiusRatio( aLayer ) );
 
-                        itemplotter.PlotPad( pad, aLayer, color, doSketchPads );
+                        itemplotter.PlotPad( plotPad, aLayer, color, doSketchPads );
                         break;
                     }
 
@@ -544,8 +550,7 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, const LSET& aLayerMask
                         if( mask_clearance <= 0 )
                         {
                             // the size can be slightly inflated by width_adj (PS/PDF only)
-                            pad->SetSize( aLayer, padPlotsSize );
-                            itemplotter.PlotPad( pad, aLayer, color, doSketchPads );
+                            itemplotter.PlotPad( plotPad, aLayer, color, doSketchPads );
                         }
                         else
                         {
@@ -622,12 +627,6 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, const LSET& aLayerMask
                         break;
                     }
                     }
-
-                    // Restore the pad parameters modified by the plot code
-                    pad->SetSize( aLayer, padSize );
-                    pad->SetDelta( aLayer, padDelta );
-                    pad->SetShape( aLayer, padShape );
-                    pad->SetRoundRectRadiusRatio( aLayer, padCornerRadiusRatio );
                 };
 
             for( PCB_LAYER_ID layer : aLayerMask.SeqStackupForPlotting() )
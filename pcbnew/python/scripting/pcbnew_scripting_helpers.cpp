@@ -35,6 +35,9 @@
 #include <action_plugin.h>
 #include <board.h>
 #include <board_design_settings.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
 #include <pcb_marker.h>
 #include <cstdlib>
 #include <drawing_sheet/ds_data_model.h>
@@ -513,6 +516,91 @@ std::deque<BOARD_ITEM*> GetCurrentSelection()
     return items;
 }
 
+
+std::vector<int> GetTrackAttributes( BOARD* aBoard )
+{
+    std::vector<int> values;
+
+    if( !aBoard )
+        return values;
+
+    values.reserve( aBoard->Tracks().size() * TRACK_ATTR_COUNT );
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        size_t row = values.size();
+        values.resize( row + TRACK_ATTR_COUNT );
+
+        int* attrs = values.data() + row;
+
+        attrs[TRACK_ATTR_TYPE] = track->Type();
+        attrs[TRACK_ATTR_START_X] = track->GetStart().x;
+        attrs[TRACK_ATTR_START_Y] = track->GetStart().y;
+        attrs[TRACK_ATTR_END_X] = track->GetEnd().x;
+        attrs[TRACK_ATTR_END_Y] = track->GetEnd().y;
+        attrs[TRACK_ATTR_WIDTH] = track->GetWidth();
+        attrs[TRACK_ATTR_NETCODE] = track->GetNetCode();
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            PCB_VIA* via = static_cast<PCB_VIA*>( track );
+
+            attrs[TRACK_ATTR_LAYER] = via->TopLayer();
+            attrs[TRACK_ATTR_END_LAYER] = via->BottomLayer();
+            attrs[TRACK_ATTR_DRILL] = via->GetDrillValue();
+        }
+        else
+        {
+            attrs[TRACK_ATTR_LAYER] = track->GetLayer();
+            attrs[TRACK_ATTR_END_LAYER] = track->GetLayer();
+            attrs[TRACK_ATTR_DRILL] = 0;
+        }
+    }
+
+    return values;
+}
+
+
+std::vector<int> GetPadAttributes( BOARD* aBoard )
+{
+    std::vector<int> values;
+
+    if( !aBoard )
+        return values;
+
+    size_t padCount = 0;
+
+    for( FOOTPRINT* fp : aBoard->Footprints() )
+        padCount += fp->Pads().size();
+
+    values.reserve( padCount * PAD_ATTR_COUNT );
+
+    for( FOOTPRINT* fp : aBoard->Footprints() )
+    {
+        for( PAD* pad : fp->Pads() )
+        {
+            size_t row = values.size();
+            values.resize( row + PAD_ATTR_COUNT );
+
+            int* attrs = values.data() + row;
+
+            attrs[PAD_ATTR_X] = pad->GetPosition().x;
+            attrs[PAD_ATTR_Y] = pad->GetPosition().y;
+            attrs[PAD_ATTR_SIZE_X] = pad->GetSizeX();
+            attrs[PAD_ATTR_SIZE_Y] = pad->GetSizeY();
+            attrs[PAD_ATTR_DRILL_X] = pad->GetDrillSizeX();
+            attrs[PAD_ATTR_DRILL_Y] = pad->GetDrillSizeY();
+            attrs[PAD_ATTR_ORIENTATION] = pad->GetOrientation().AsTenthsOfADegree();
+            attrs[PAD_ATTR_NETCODE] = pad->GetNetCode();
+            attrs[PAD_ATTR_TYPE] = static_cast<int>( pad->GetAttribute() );
+            attrs[PAD_ATTR_LAYER] = fp->GetLayer();
+        }
+    }
+
+    return values;
+}
+
+
 void FocusOnItem( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer )
 {
     if( s_PcbEditFrame )
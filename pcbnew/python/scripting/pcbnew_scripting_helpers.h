@@ -26,6 +26,7 @@
 #define __PCBNEW_SCRIPTING_HELPERS_H
 
 #include <deque>
+#include <vector>
 #include <pcb_io/pcb_io_mgr.h>
 #include <layer_ids.h>
 
@@ -226,6 +227,61 @@ int GetUserUnits();
  */
 std::deque<BOARD_ITEM*> GetCurrentSelection();
 
+/**
+ * Columns of the rows returned by GetTrackAttributes().  Coordinates and sizes are in
+ * internal units (nm).
+ */
+enum TRACK_ATTRIBUTE
+{
+    TRACK_ATTR_TYPE,        ///< PCB_TRACE_T, PCB_ARC_T or PCB_VIA_T
+    TRACK_ATTR_START_X,
+    TRACK_ATTR_START_Y,
+    TRACK_ATTR_END_X,       ///< Same as the start for a via
+    TRACK_ATTR_END_Y,
+    TRACK_ATTR_WIDTH,       ///< Front width for a via
+    TRACK_ATTR_NETCODE,
+    TRACK_ATTR_LAYER,       ///< Top layer for a via
+    TRACK_ATTR_END_LAYER,   ///< Bottom layer for a via, same as TRACK_ATTR_LAYER otherwise
+    TRACK_ATTR_DRILL,       ///< 0 for tracks and arcs
+    TRACK_ATTR_COUNT
+};
+
+/**
+ * Columns of the rows returned by GetPadAttributes().
+ */
+enum PAD_ATTRIBUTE
+{
+    PAD_ATTR_X,
+    PAD_ATTR_Y,
+    PAD_ATTR_SIZE_X,
+    PAD_ATTR_SIZE_Y,
+    PAD_ATTR_DRILL_X,
+    PAD_ATTR_DRILL_Y,
+    PAD_ATTR_ORIENTATION,   ///< In tenths of a degree
+    PAD_ATTR_NETCODE,
+    PAD_ATTR_TYPE,          ///< PAD_ATTRIB value
+    PAD_ATTR_LAYER,         ///< Layer of the parent footprint
+    PAD_ATTR_COUNT
+};
+
+/**
+ * Get the attributes of all the tracks, arcs and vias of a board in one call.
+ *
+ * Reading a large board item by item from Python crosses into C++ several times per item;
+ * this returns a flat list of TRACK_ATTR_COUNT values per item, in the order of
+ * BOARD::Tracks(), e.g. `numpy.array( pcbnew.GetTrackAttributes( board ) ).reshape( -1,
+ * pcbnew.TRACK_ATTR_COUNT )`.
+ */
+std::vector<int> GetTrackAttributes( BOARD* aBoard );
+
+/**
+ * Get the attributes of all the pads of a board in one call, as a flat list of
+ * PAD_ATTR_COUNT values per pad, footprint by footprint.
+ *
+ * @see GetTrackAttributes()
+ */
+std::vector<int> GetPadAttributes( BOARD* aBoard );
+
 /**
  * Focus the view on the target item.
  *
@@ -35,6 +35,7 @@
 #endif
 
 #include <ratsnest/ratsnest_data.h>
+#include <atomic>
 #include <functional>
 using namespace std::placeholders;
 
@@ -282,6 +283,15 @@ public:
 RN_NET::RN_NET() : m_dirty( true )
 {
     m_triangulator.reset( new TRIANGULATOR_STATE );
+    EdgesChanged();
+}
+
+
+void RN_NET::EdgesChanged()
+{
+    static std::atomic<uint64_t> s_generation( 0 );
+
+    m_generation = ++s_generation;
 }
 
 
@@ -534,12 +544,17 @@ void RN_NET::OptimizeRNEdges()
                                        } );
         }
     }
+
+    // Sort while the other nets are optimized rather than on the next redraw
+    sortEdges( m_rnEdges );
+    EdgesChanged();
 }
 
 
 void RN_NET::UpdateNet()
 {
     compute();
+    EdgesChanged();
 
     m_dirty = false;
 }
@@ -561,6 +576,8 @@ void RN_NET::RemoveInvalidRefs()
     m_rnEdges.erase( std::remove_if( m_rnEdges.begin(), m_rnEdges.end(), is_invalid ), m_rnEdges.end() );
     m_boardEdges.erase( std::remove_if( m_boardEdges.begin(), m_boardEdges.end(), is_invalid ),
                         m_boardEdges.end() );
+
+    EdgesChanged();
 }
 
 
@@ -571,6 +588,7 @@ void RN_NET::Clear()
     m_nodes.clear();
 
     m_dirty = true;
+    EdgesChanged();
 }
 
 
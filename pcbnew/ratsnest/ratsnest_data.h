@@ -36,6 +36,7 @@
 #include <core/typeinfo.h>
 #include <math/box2.h>
 
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -73,6 +74,17 @@ public:
      */
     bool IsDirty() const { return m_dirty; }
 
+    /**
+     * Return a stamp that changes whenever the ratsnest edges of this net change.  Stamps are
+     * unique across all nets, so a stamp never matches one taken from a different RN_NET.
+     */
+    uint64_t GetGeneration() const { return m_generation; }
+
+    /**
+     * Take a new generation stamp.  Must be called by anything modifying the edges in place.
+     */
+    void EdgesChanged();
+
     /**
      * Recompute ratsnest for a net.
      */
@@ -99,21 +111,12 @@ public:
         // Use a const_cast to allow sorting in the const method
         // This is safe because we're not changing the logical content of the vector,
         // just the ordering of elements
-        std::stable_sort( const_cast<std::vector<CN_EDGE>&>( m_rnEdges ).begin(),
-                          const_cast<std::vector<CN_EDGE>&>( m_rnEdges ).end(),
-                          []( const CN_EDGE& a, const CN_EDGE& b )
-                          {
-                              return a.StableSortCompare( b );
-                          } );
+        sortEdges( const_cast<std::vector<CN_EDGE>&>( m_rnEdges ) );
         return m_rnEdges;
     }
     std::vector<CN_EDGE>& GetEdges()
     {
-        std::stable_sort( m_rnEdges.begin(), m_rnEdges.end(),
-                          []( const CN_EDGE& a, const CN_EDGE& b )
-                          {
-                              return a.StableSortCompare( b );
-                          } );
+        sortEdges( m_rnEdges );
         return m_rnEdges;
     }
 
@@ -123,6 +126,22 @@ protected:
     ///< Recompute ratsnest from scratch.
     void compute();
 
+    /**
+     * Sort \a aEdges in a stable order.  The edges are drawn every frame but rarely change,
+     * so they are only sorted again when they are out of order.
+     */
+    static void sortEdges( std::vector<CN_EDGE>& aEdges )
+    {
+        auto cmp =
+                []( const CN_EDGE& a, const CN_EDGE& b )
+                {
+                    return a.StableSortCompare( b );
+                };
+
+        if( !std::is_sorted( aEdges.begin(), aEdges.end(), cmp ) )
+            std::stable_sort( aEdges.begin(), aEdges.end(), cmp );
+    }
+
     ///< Compute the minimum spanning tree using Kruskal's algorithm
     void kruskalMST( const std::vector<CN_EDGE> &aEdges );
 
@@ -139,6 +158,9 @@ protected:
     ///< Flag indicating necessity of recalculation of ratsnest for a net.
     bool m_dirty;
 
+    ///< Stamp of the last change to the edges, see GetGeneration().
+    uint64_t m_generation;
+
     class TRIANGULATOR_STATE;
 
     std::shared_ptr<TRIANGULATOR_STATE> m_triangulator;
@@ -120,89 +120,114 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
 
     const bool curved_ratsnest = cfg->m_Display.m_DisplayRatsnestLinesCurved;
 
-    // Draw the "dynamic" ratsnest (i.e. for objects that may be currently being moved)
-    for( const RN_DYNAMIC_LINE& l : m_data->GetLocalRatsnest() )
-    {
-        if( hiddenNets.count( l.netCode ) )
-            continue;
+    auto drawLine =
+            [&]( const VECTOR2I& a, const VECTOR2I& b )
+            {
+                if( a == b )
+                {
+                    gal->DrawLine( VECTOR2I( a.x - CROSS_SIZE, a.y - CROSS_SIZE ),
+                                   VECTOR2I( b.x + CROSS_SIZE, b.y + CROSS_SIZE ) );
+                    gal->DrawLine( VECTOR2I( a.x - CROSS_SIZE, a.y + CROSS_SIZE ),
+                                   VECTOR2I( b.x + CROSS_SIZE, b.y - CROSS_SIZE ) );
+                }
+                else if( curved_ratsnest )
+                {
+                    int dx = b.x - a.x;
+                    int dy = b.y - a.y;
+                    const VECTOR2I center = VECTOR2I( a.x + 0.5 * dx - 0.1 * dy,
+                                                      a.y + 0.5 * dy + 0.1 * dx );
+                    gal->DrawCurve( a, center, center, b );
+                }
+                else
+                {
+                    gal->DrawLine( a, b );
+                }
+            };
 
-        const NETCLASS*     nc = nullptr;
-        const NET_SETTINGS* netSettings = m_data->GetNetSettings();
+    auto getNetColor =
+            [&]( int aNetCode )
+            {
+                const NETCLASS*     nc = nullptr;
+                const NET_SETTINGS* netSettings = m_data->GetNetSettings();
 
-        if( m_data->HasNetNameForNetCode( l.netCode ) )
-        {
-            const wxString& netName = m_data->GetNetNameForNetCode( l.netCode );
+                if( m_data->HasNetNameForNetCode( aNetCode ) )
+                {
+                    const wxString& netName = m_data->GetNetNameForNetCode( aNetCode );
 
-            if( netSettings && netSettings->HasEffectiveNetClass( netName ) )
-                nc = netSettings->GetCachedEffectiveNetClass( netName ).get();
-        }
+                    if( netSettings && netSettings->HasEffectiveNetClass( netName ) )
+                        nc = netSettings->GetCachedEffectiveNetClass( netName ).get();
+                }
 
-        if( colorByNet && netColors.count( l.netCode ) )
-            color = netColors.at( l.netCode );
-        else if( colorByNet && nc && nc->HasPcbColor() )
-            color = nc->GetPcbColor();
-        else
-            color = defaultColor;
+                COLOR4D netColor;
 
-        if( color == COLOR4D::UNSPECIFIED )
-            color = defaultColor;
+                if( colorByNet && netColors.count( aNetCode ) )
+                    netColor = netColors.at( aNetCode );
+                else if( colorByNet && nc && nc->HasPcbColor() )
+                    netColor = nc->GetPcbColor();
+                else
+                    netColor = defaultColor;
 
-        gal->SetStrokeColor( adjustColor( color, 0.5, color.a + 0.3 ) );
+                if( netColor == COLOR4D::UNSPECIFIED )
+                    netColor = defaultColor;
 
-        if( l.a == l.b )
-        {
-            gal->DrawLine( VECTOR2I( l.a.x - CROSS_SIZE, l.a.y - CROSS_SIZE ),
-                           VECTOR2I( l.b.x + CROSS_SIZE, l.b.y + CROSS_SIZE ) );
-            gal->DrawLine( VECTOR2I( l.a.x - CROSS_SIZE, l.a.y + CROSS_SIZE ),
-                           VECTOR2I( l.b.x + CROSS_SIZE, l.b.y - CROSS_SIZE ) );
-        }
-        else
-        {
-            if( curved_ratsnest )
-            {
-                int dx = l.b.x - l.a.x;
-                int dy = l.b.y - l.a.y;
-                const VECTOR2I center = VECTOR2I( l.a.x + 0.5 * dx - 0.1 * dy,
-                                                  l.a.y + 0.5 * dy + 0.1 * dx );
-                gal->DrawCurve( l.a, center, center, l.b );
-            }
-            else
-            {
-                gal->DrawLine( l.a, l.b );
-            }
-        }
+                return netColor;
+            };
+
+    // Draw the "dynamic" ratsnest (i.e. for objects that may be currently being moved)
+    for( const RN_DYNAMIC_LINE& l : m_data->GetLocalRatsnest() )
+    {
+        if( hiddenNets.count( l.netCode ) )
+            continue;
+
+        color = getNetColor( l.netCode );
+        gal->SetStrokeColor( adjustColor( color, 0.5, color.a + 0.3 ) );
+        drawLine( l.a, l.b );
     }
 
+    if( m_netCache.size() < (size_t) m_data->GetNetCount() )
+        m_netCache.resize( m_data->GetNetCount() );
+
     for( int i = 1 /* skip "No Net" at [0] */; i < m_data->GetNetCount(); ++i )
     {
         if( hiddenNets.count( i ) )
             continue;
 
-        RN_NET* net = m_data->GetRatsnestForNet( i );
+        const RN_NET* net = m_data->GetRatsnestForNet( i );
 
         if( !net || m_data->GetConnectivityAlgo()->IsNetDirty( i ) )
             continue;
 
-        const NETCLASS*     nc = nullptr;
-        const NET_SETTINGS* netSettings = m_data->GetNetSettings();
+        CACHED_NET& cache = m_netCache[i];
 
-        if( m_data->HasNetNameForNetCode( i ) )
+        // Walk the edges again only when the net has been recomputed since the last redraw
+        if( cache.generation != net->GetGeneration() )
         {
-            const wxString& netName = m_data->GetNetNameForNetCode( i );
+            cache.generation = net->GetGeneration();
+            cache.lines.clear();
+
+            for( const CN_EDGE& edge : net->GetEdges() )
+            {
+                if( !edge.IsVisible() )
+                    continue;
+
+                const std::shared_ptr<const CN_ANCHOR>& sourceNode = edge.GetSourceNode();
+                const std::shared_ptr<const CN_ANCHOR>& targetNode = edge.GetTargetNode();
+
+                if( !sourceNode || sourceNode->Dirty() || !targetNode || targetNode->Dirty() )
+                    continue;
 
-            if( netSettings && netSettings->HasEffectiveNetClass( netName ) )
-                nc = netSettings->GetCachedEffectiveNetClass( netName ).get();
+                if( sourceNode->GetNoLine() || targetNode->GetNoLine() )
+                    continue;
+
+                cache.lines.push_back( { sourceNode->Pos(), targetNode->Pos(),
+                                         sourceNode->Parent(), targetNode->Parent() } );
+            }
         }
 
-        if( colorByNet && netColors.count( i ) )
-            color = netColors.at( i );
-        else if( colorByNet && nc && nc->HasPcbColor() )
-            color = nc->GetPcbColor();
-        else
-            color = defaultColor;
+        if( cache.lines.empty() )
+            continue;
 
-        if( color == COLOR4D::UNSPECIFIED )
-            color = defaultColor;
+        color = getNetColor( i );
 
         if( dimStatic )
             color = adjustColor( color, 0.0, color.a / 2 );
@@ -213,21 +238,8 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
         else
             gal->SetStrokeColor( color );  // using the default ratsnest color for not highlighted
 
-        for( const CN_EDGE& edge : net->GetEdges() )
+        for( const CACHED_LINE& line : cache.lines )
         {
-            if( !edge.IsVisible() )
-                continue;
-
-            const std::shared_ptr<const CN_ANCHOR>& sourceNode = edge.GetSourceNode();
-            const std::shared_ptr<const CN_ANCHOR>& targetNode = edge.GetTargetNode();
-
-            if( !sourceNode || sourceNode->Dirty() || !targetNode || targetNode->Dirty() )
-                continue;
-
-            const VECTOR2I source( sourceNode->Pos() );
-            const VECTOR2I target( targetNode->Pos() );
-
-            bool enable =  !sourceNode->GetNoLine() && !targetNode->GetNoLine();
             bool show;
 
             // If the global ratsnest is currently enabled, the local ratsnest should be easy to
@@ -236,19 +248,19 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
             // so either element can enable it.
             if( cfg->m_Display.m_ShowGlobalRatsnest )
             {
-                show = sourceNode->Parent()->GetLocalRatsnestVisible() &&
-                       targetNode->Parent()->GetLocalRatsnestVisible();
+                show = line.sourceParent->GetLocalRatsnestVisible() &&
+                       line.targetParent->GetLocalRatsnestVisible();
             }
             else
             {
-                show = sourceNode->Parent()->GetLocalRatsnestVisible() ||
-                       targetNode->Parent()->GetLocalRatsnestVisible();
+                show = line.sourceParent->GetLocalRatsnestVisible() ||
+                       line.targetParent->GetLocalRatsnestVisible();
             }
 
             if( onlyVisibleLayers && show )
             {
-                LSET sourceLayers = sourceNode->Parent()->GetLayerSet();
-                LSET targetLayers = targetNode->Parent()->GetLayerSet();
+                LSET sourceLayers = line.sourceParent->GetLayerSet();
+                LSET targetLayers = line.targetParent->GetLayerSet();
 
                 if( !( sourceLayers & visibleLayers ).any() ||
                     !( targetLayers & visibleLayers ).any() )
@@ -257,31 +269,8 @@ void RATSNEST_VIEW_ITEM::ViewDraw( int aLayer, KIGFX::VIEW* aView ) const
                 }
             }
 
-            if ( enable && show )
-            {
-                if ( source == target )
-                {
-                    gal->DrawLine( VECTOR2I( source.x - CROSS_SIZE, source.y - CROSS_SIZE ),
-                                   VECTOR2I( source.x + CROSS_SIZE, source.y + CROSS_SIZE ) );
-                    gal->DrawLine( VECTOR2I( source.x - CROSS_SIZE, source.y + CROSS_SIZE ),
-                                   VECTOR2I( source.x + CROSS_SIZE, source.y - CROSS_SIZE ) );
-                }
-                else
-                {
-                    if( curved_ratsnest )
-                    {
-                        int dx = target.x - source.x;
-                        int dy = target.y - source.y;
-                        const VECTOR2I center = VECTOR2I( source.x + 0.5 * dx - 0.1 * dy,
-                                                          source.y + 0.5 * dy + 0.1 * dx );
-                        gal->DrawCurve( source, center, center, target );
-                    }
-                    else
-                    {
-                        gal->DrawLine( source, target );
-                    }
-                }
-            }
+            if( show )
+                drawLine( line.a, line.b );
         }
     }
 }
@@ -32,12 +32,14 @@
 #define RATSNEST_VIEW_ITEM_H
 
 #include <memory>
+#include <vector>
 #include <eda_item.h>
 #include <math/vector2d.h>
 #include <project/net_settings.h>
 
 class GAL;
 class CONNECTIVITY_DATA;
+class BOARD_CONNECTED_ITEM;
 
 
 class RATSNEST_VIEW_ITEM : public EDA_ITEM
@@ -70,7 +72,27 @@ public:
     }
 
 protected:
+    ///< A ratsnest line with the items at its ends, which decide whether it is shown.
+    struct CACHED_LINE
+    {
+        VECTOR2I                    a;
+        VECTOR2I                    b;
+        const BOARD_CONNECTED_ITEM* sourceParent;
+        const BOARD_CONNECTED_ITEM* targetParent;
+    };
+
+    ///< The drawable lines of a net, valid while the net keeps the same generation.
+    struct CACHED_NET
+    {
+        uint64_t                 generation = 0;
+        std::vector<CACHED_LINE> lines;
+    };
+
     std::shared_ptr<CONNECTIVITY_DATA> m_data;      ///< Object containing ratsnest data.
+
+    ///< Lines of the static ratsnest, indexed by net code.  Only nets whose edges changed since
+    ///< the last redraw are walked again.
+    mutable std::vector<CACHED_NET>    m_netCache;
 };
 
 
@@ -29,6 +29,7 @@
 
 #include "pns_line.h"
 #include "pns_linked_item.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -75,6 +76,8 @@ public:
 
     ARC* Clone() const override;
 
+    PNS_POOLED_ITEM( ARC )
+
     const SHAPE* Shape( int aLayer ) const override
     {
         return static_cast<const SHAPE*>( &m_arc );
@@ -0,0 +1,218 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <board.h>
+#include <board_commit.h>
+#include <pad.h>
+#include <tool/tool_manager.h>
+
+#include "pns_batch_router.h"
+#include "pns_kicad_iface.h"
+#include "pns_placement_algo.h"
+#include "pns_router.h"
+#include "pns_sizes_settings.h"
+
+
+/**
+ * A PNS_KICAD_IFACE without a view or a host tool, which keeps the changes of every routed
+ * connection in the same commit.
+ */
+class PNS_BATCH_IFACE : public PNS_KICAD_IFACE
+{
+public:
+    PNS_BATCH_IFACE( TOOL_MANAGER* aToolManager )
+    {
+        m_commit = std::make_unique<BOARD_COMMIT>( aToolManager );
+    }
+
+    void EraseView() override {}
+    bool IsAnyLayerVisible( const PNS_LAYER_RANGE& aLayer ) const override { return true; }
+    bool IsItemVisible( const PNS::ITEM* aItem ) const override { return true; }
+    void HideItem( PNS::ITEM* aItem ) override {}
+    void DisplayItem( const PNS::ITEM* aItem, int aClearance, bool aEdit = false,
+                      int aFlags = 0 ) override {}
+    void DisplayPathLine( const SHAPE_LINE_CHAIN& aLine, int aImportance ) override {}
+    void DisplayRatline( const SHAPE_LINE_CHAIN& aRatline, PNS::NET_HANDLE aNet ) override {}
+    EDA_UNITS GetUnits() const override { return EDA_UNITS::MM; }
+
+    // Called by the router after each connection; the batch is pushed by PNS_BATCH_ROUTER.
+    void Commit() override {}
+
+    BOARD_COMMIT* GetCommit() { return m_commit.get(); }
+};
+
+
+PNS_BATCH_ROUTER::PNS_BATCH_ROUTER( BOARD* aBoard, TOOL_MANAGER* aToolManager ) :
+        m_settings( nullptr, "" )
+{
+    m_iface = std::make_unique<PNS_BATCH_IFACE>( aToolManager );
+    m_iface->SetBoard( aBoard );
+
+    m_settings.SetMode( PNS::RM_Walkaround );
+
+    m_router = std::make_unique<PNS::ROUTER>();
+    m_router->SetInterface( m_iface.get() );
+    m_router->SyncWorld();
+    m_router->LoadSettings( &m_settings );
+}
+
+
+PNS_BATCH_ROUTER::~PNS_BATCH_ROUTER()
+{
+    // The router refers to the interface, so it has to go first
+    m_router.reset();
+}
+
+
+std::vector<PNS_BATCH_ROUTER::RESULT>
+PNS_BATCH_ROUTER::Route( const std::vector<CONNECTION>& aConnections )
+{
+    std::vector<RESULT> results;
+
+    results.reserve( aConnections.size() );
+
+    for( const CONNECTION& connection : aConnections )
+    {
+        RESULT result = routeConnection( connection, true );
+
+        if( !result.m_routed && !connection.m_waypoints.empty() )
+            result = routeConnection( connection, false );
+
+        results.push_back( result );
+    }
+
+    return results;
+}
+
+
+PNS_BATCH_ROUTER::RESULT PNS_BATCH_ROUTER::routeConnection( const CONNECTION& aConnection,
+                                                           bool aUseWaypoints )
+{
+    RESULT result;
+
+    if( !aConnection.m_start || !aConnection.m_end )
+    {
+        result.m_failureReason = _( "Missing pad." );
+        return result;
+    }
+
+    if( aConnection.m_start->GetNetCode() <= 0
+            || aConnection.m_start->GetNetCode() != aConnection.m_end->GetNetCode() )
+    {
+        result.m_failureReason = _( "Pads are not on the same net." );
+        return result;
+    }
+
+    PNS::NODE* world = m_router->GetWorld();
+    PNS::ITEM* startItem = world->FindItemByParent( aConnection.m_start );
+    PNS::ITEM* endItem = world->FindItemByParent( aConnection.m_end );
+
+    if( !startItem || !endItem )
+    {
+        result.m_failureReason = _( "Pad is not known to the router." );
+        return result;
+    }
+
+    PCB_LAYER_ID pcbLayer = aConnection.m_layer;
+
+    if( pcbLayer == UNDEFINED_LAYER || !aConnection.m_start->IsOnLayer( pcbLayer ) )
+        pcbLayer = aConnection.m_start->GetPrincipalLayer();
+
+    if( !IsCopperLayer( pcbLayer ) )
+    {
+        result.m_failureReason = _( "Start pad has no copper layer." );
+        return result;
+    }
+
+    int      pnsLayer = m_iface->GetPNSLayerFromBoardLayer( pcbLayer );
+    VECTOR2I start = aConnection.m_start->GetPosition();
+    VECTOR2I end = aConnection.m_end->GetPosition();
+
+    PNS::SIZES_SETTINGS sizes( m_router->Sizes() );
+
+    m_iface->SetStartLayerFromPNS( pnsLayer );
+    m_iface->ImportSizes( sizes, startItem, nullptr, start );
+    m_router->UpdateSizes( sizes );
+
+    if( !m_router->StartRouting( start, startItem, pnsLayer ) )
+    {
+        result.m_failureReason = m_router->FailureReason();
+        return result;
+    }
+
+    PNS::PLACEMENT_ALGO* placer = m_router->Placer();
+
+    // Same as ROUTER::Finish(): keep moving until the head stops changing
+    auto moveTo =
+            [&]( const VECTOR2I& aTarget, PNS::ITEM* aTargetItem )
+            {
+                int      triesLeft = 5;
+                VECTOR2I lastEnd;
+
+                do
+                {
+                    lastEnd = placer->CurrentEnd();
+                    m_router->Move( aTarget, aTargetItem );
+                    triesLeft--;
+                } while( placer->CurrentEnd() != lastEnd && triesLeft );
+
+                return placer->CurrentEnd() == aTarget;
+            };
+
+    if( aUseWaypoints )
+    {
+        for( const VECTOR2I& waypoint : aConnection.m_waypoints )
+        {
+            if( !moveTo( waypoint, nullptr )
+                    || m_router->FixRoute( waypoint, nullptr, false, false ) )
+            {
+                // Off the guide (or done early): let the caller retry without it
+                m_router->StopRouting();
+                result.m_failureReason = _( "Unable to follow the routing guide." );
+                return result;
+            }
+        }
+    }
+
+    if( moveTo( end, endItem ) && endItem->Layers().Overlaps( m_router->GetCurrentLayer() )
+            && m_router->FixRoute( end, endItem, false, false ) )
+    {
+        m_router->CommitRouting();
+        result.m_routed = true;
+    }
+    else
+    {
+        m_router->StopRouting();
+        result.m_failureReason = _( "No path found to the end pad." );
+    }
+
+    return result;
+}
+
+
+bool PNS_BATCH_ROUTER::Commit( const wxString& aMessage )
+{
+    BOARD_COMMIT* commit = m_iface->GetCommit();
+
+    if( commit->Empty() )
+        return false;
+
+    commit->Push( aMessage );
+    return true;
+}
@@ -0,0 +1,102 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PNS_BATCH_ROUTER_H
+#define PNS_BATCH_ROUTER_H
+
+#include <memory>
+#include <vector>
+
+#include <layer_ids.h>
+#include <math/vector2d.h>
+#include <wx/string.h>
+
+#include "pns_routing_settings.h"
+
+class BOARD;
+class PAD;
+class TOOL_MANAGER;
+class PNS_BATCH_IFACE;
+
+namespace PNS
+{
+    class ROUTER;
+}
+
+
+/**
+ * Routes a list of pad to pad connections with the PNS line placer, without an editor view.
+ *
+ * Each connection is routed as if the user had started a track on the first pad and asked the
+ * router to finish it on the second one.  The tracks of all routed connections are collected
+ * in a single BOARD_COMMIT, pushed by Commit(), so that the whole batch is one undo step.
+ */
+class PNS_BATCH_ROUTER
+{
+public:
+    struct CONNECTION
+    {
+        PAD*         m_start = nullptr;
+        PAD*         m_end = nullptr;
+        PCB_LAYER_ID m_layer = UNDEFINED_LAYER;  ///< Start layer, the pad's own if undefined
+
+        /// Points to pass on the way, e.g. the corners of a global routing guide.  The
+        /// connection is routed without them if they can't be followed.
+        std::vector<VECTOR2I> m_waypoints;
+    };
+
+    struct RESULT
+    {
+        bool     m_routed = false;
+        wxString m_failureReason;
+    };
+
+    PNS_BATCH_ROUTER( BOARD* aBoard, TOOL_MANAGER* aToolManager );
+    ~PNS_BATCH_ROUTER();
+
+    /**
+     * Set how the router deals with obstacles.  Defaults to walking around them, so that the
+     * existing tracks of the board are never moved by a batch.
+     */
+    void SetMode( PNS::PNS_MODE aMode ) { m_settings.SetMode( aMode ); }
+
+    /**
+     * Route the connections in the given order.  Later connections see the tracks of the
+     * earlier ones as obstacles.
+     *
+     * @return one result per connection.
+     */
+    std::vector<RESULT> Route( const std::vector<CONNECTION>& aConnections );
+
+    /**
+     * Push the tracks of all connections routed so far to the board.
+     *
+     * @return false if there was nothing to commit.
+     */
+    bool Commit( const wxString& aMessage );
+
+private:
+    RESULT routeConnection( const CONNECTION& aConnection, bool aUseWaypoints );
+
+    std::unique_ptr<PNS_BATCH_IFACE> m_iface;
+    std::unique_ptr<PNS::ROUTER>     m_router;
+    PNS::ROUTING_SETTINGS            m_settings;
+};
+
+#endif // PNS_BATCH_ROUTER_H
@@ -25,11 +25,14 @@
 #include <limits>
 
 #include <algorithm>
+#include <atomic>
 
 #include <geometry/shape_rect.h>
 
 #include "pns_diff_pair.h"
 #include "pns_router.h"
+#include "pns_utils.h"
+#include "time_limit.h"
 
 namespace PNS {
 
@@ -334,12 +337,22 @@ void DP_GATEWAYS::BuildOrthoProjections( DP_GATEWAYS& aEntries, const VECTOR2I&
 
 
 bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                               DIFF_PAIR& aDp )
+                               DIFF_PAIR& aDp, const TIME_LIMIT* aTimeLimit )
 {
-    DP_CANDIDATE best;
+    struct ATTEMPT
+    {
+        const DP_GATEWAY* m_entry;
+        const DP_GATEWAY* m_target;
+        bool              m_diagonal;
+        int               m_score;
+    };
+
+    // Below this many attempts of the same score, the thread pool costs more than it saves
+    const size_t c_parallelThreshold = 64;
+    const size_t c_chunkSize = 16;
 
-    int bestScore = -1000;
-    bool found = false;
+    std::vector<ATTEMPT> attempts;
+    attempts.reserve( 2 * aEntry.Gateways().size() * aTarget.Gateways().size() );
 
     for( const DP_GATEWAY& g_entry : aEntry.Gateways() )
     {
@@ -351,29 +364,93 @@ bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool a
                 score += g_entry.Priority();
                 score += g_target.Priority();
 
-                if( score >= bestScore )
-                {
-                    DIFF_PAIR l( m_gap );
-
-                    if( l.BuildInitial( g_entry, g_target, preferred ? aPrefDiagonal
-                                                                     : !aPrefDiagonal ) )
-                    {
-                        best.p = l.CP();
-                        best.n = l.CN();
-                        bestScore = score;
-                        found = true;
-                    }
-                }
+                attempts.push_back( { &g_entry, &g_target,
+                                      preferred ? aPrefDiagonal : !aPrefDiagonal, score } );
             }
         }
     }
 
+    // The result is the last attempt, in the order above, among those of the best score that
+    // can be built.  Sorting by decreasing score with equal scores in reverse order makes it the
+    // first one that builds, so the rest never needs to be built.
+    std::reverse( attempts.begin(), attempts.end() );
+    std::stable_sort( attempts.begin(), attempts.end(),
+                      []( const ATTEMPT& a, const ATTEMPT& b )
+                      {
+                          return a.m_score > b.m_score;
+                      } );
+
+    auto build =
+            [&]( const ATTEMPT& aAttempt, DIFF_PAIR& aPair )
+            {
+                return aPair.BuildInitial( *aAttempt.m_entry, *aAttempt.m_target,
+                                           aAttempt.m_diagonal );
+            };
 
-    if( found )
+    for( size_t first = 0; first < attempts.size(); )
     {
-        aDp.SetGap( m_gap );
-        aDp.SetShape( best.p, best.n );
-        return true;
+        if( first > 0 && aTimeLimit && aTimeLimit->Expired() )
+            break;
+
+        size_t last = first;
+
+        while( last < attempts.size() && attempts[last].m_score == attempts[first].m_score )
+            last++;
+
+        size_t found = last;
+
+        if( last - first < c_parallelThreshold )
+        {
+            for( size_t ii = first; ii < last && found == last; ii++ )
+            {
+                DIFF_PAIR l( m_gap );
+
+                if( build( attempts[ii], l ) )
+                    found = ii;
+            }
+        }
+        else
+        {
+            // Keep the lowest index that builds, so the result does not depend on the timing
+            std::atomic<size_t> winner( last );
+            int chunks = static_cast<int>( ( last - first + c_chunkSize - 1 ) / c_chunkSize );
+
+            ParallelAttempts( chunks,
+                    [&]( int aChunk )
+                    {
+                        size_t begin = first + aChunk * c_chunkSize;
+                        size_t end = std::min( begin + c_chunkSize, last );
+
+                        for( size_t ii = begin; ii < end && ii < winner; ii++ )
+                        {
+                            DIFF_PAIR l( m_gap );
+
+                            if( !build( attempts[ii], l ) )
+                                continue;
+
+                            size_t current = winner;
+
+                            while( ii < current && !winner.compare_exchange_weak( current, ii ) )
+                                ;
+
+                            break;
+                        }
+                    } );
+
+            found = winner;
+        }
+
+        if( found < last )
+        {
+            DIFF_PAIR l( m_gap );
+            build( attempts[found], l );
+
+            aDp.SetGap( m_gap );
+            aDp.SetShape( l.CP(), l.CN() );
+            return true;
+        }
+
+        first = last;
     }
 
     return false;
@@ -34,6 +34,7 @@
 namespace PNS {
 
 class DIFF_PAIR;
+class TIME_LIMIT;
 
 /**
  * Define a "gateway" for routing a differential pair - e.g. a pair of points (anchors) with
@@ -197,8 +198,16 @@ public:
                        bool aViaMode = false );
     void BuildFromPrimitivePair( const DP_PRIMITIVE_PAIR& aPair, bool aPreferDiagonal );
 
+    /**
+     * Find the best scoring pair of entry and target gateways that can be joined by a
+     * differential pair, and store that pair in \a aDp.
+     *
+     * The candidates are tried from the best score down, so the search stops at the first score
+     * for which a connection can be built.  Large sets of candidates with the same score are
+     * tried on the thread pool.  Once \a aTimeLimit has expired, no lower score is tried.
+     */
     bool FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                      DIFF_PAIR& aDp );
+                      DIFF_PAIR& aDp, const TIME_LIMIT* aTimeLimit = nullptr );
 
     std::vector<DP_GATEWAY>& Gateways() { return m_gateways; }
 
@@ -207,13 +216,6 @@ public:
     void FilterByOrientation( int aAngleMask, DIRECTION_45 aRefOrientation );
 
 private:
-    struct DP_CANDIDATE
-    {
-        SHAPE_LINE_CHAIN p, n;
-        VECTOR2I         gw_p, gw_n;
-        int              score;
-    };
-
     bool checkDiagonalAlignment( const VECTOR2I& a, const VECTOR2I& b ) const;
     void buildDpContinuation( const DP_PRIMITIVE_PAIR& aPair, bool aIsDiagonal );
     void buildEntries( const VECTOR2I& p0_p, const VECTOR2I& p0_n );
@@ -672,6 +672,40 @@ void DIFF_PAIR_PLACER::initPlacement()
     m_currentNode = rootNode;
 
     m_shove = std::make_unique<SHOVE>( m_currentNode, Router() );
+
+    // The primitives of the previous pair may have been freed, and their addresses reused
+    m_entryGateways.reset();
+}
+
+
+void DIFF_PAIR_PLACER::buildEntryGateways( DP_GATEWAYS& aGateways )
+{
+    ENTRY_GATEWAYS_KEY key{ m_prevPair->PrimP(), m_prevPair->PrimN(), m_prevPair->AnchorP(),
+                            m_prevPair->AnchorN(), m_startDiagonal, gap() };
+
+    if( !m_entryGateways || m_entryGateways->first != key )
+    {
+        aGateways.BuildFromPrimitivePair( *m_prevPair, m_startDiagonal );
+        m_entryGateways.emplace( key, aGateways.CGateways() );
+        return;
+    }
+
+    aGateways.Gateways() = m_entryGateways->second;
+}
+
+
+void DIFF_PAIR_PLACER::buildCursorGateways( DP_GATEWAYS& aGateways, const VECTOR2I& aCursor )
+{
+    CURSOR_GATEWAYS_KEY key{ aCursor, gap(), m_placingVia, m_sizes.ViaDiameter(), viaGap() };
+
+    if( !m_cursorGateways || m_cursorGateways->first != key )
+    {
+        aGateways.BuildForCursor( aCursor );
+        m_cursorGateways.emplace( key, aGateways.CGateways() );
+        return;
+    }
+
+    aGateways.Gateways() = m_cursorGateways->second;
 }
 
 
@@ -685,7 +719,7 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
     if( !m_prevPair )
         m_prevPair = m_start;
 
-    gwsEntry.BuildFromPrimitivePair( *m_prevPair, m_startDiagonal );
+    buildEntryGateways( gwsEntry );
 
     DP_PRIMITIVE_PAIR target;
 
@@ -715,13 +749,13 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
         // far from the initial segment extension line -> allow a 45-degree obtuse turn
         if( lead_dist > ( m_sizes.DiffPairGap() + m_sizes.DiffPairWidth() ) / 2 )
         {
-            gwsTarget.BuildForCursor( fp );
+            buildCursorGateways( gwsTarget, fp );
         }
         else
         {
             // close to the initial segment extension line -> keep straight part only, project
             // as close as possible to the cursor.
-            gwsTarget.BuildForCursor( fpProj );
+            buildCursorGateways( gwsTarget, fpProj );
             gwsTarget.FilterByOrientation( DIRECTION_45::ANG_STRAIGHT | DIRECTION_45::ANG_HALF_FULL,
                                            DIRECTION_45( dirV ) );
         }
@@ -732,7 +766,9 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
     m_currentTrace.SetGap( gap() );
     m_currentTrace.SetLayer( m_currentLayer );
 
-    bool result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace );
+    TIME_LIMIT timeLimit = Settings().ShoveTimeLimit();
+    bool       result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace,
+                                              &timeLimit );
 
     if( result )
     {
@@ -847,6 +883,7 @@ bool DIFF_PAIR_PLACER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForce
     topo.SimplifyLine( &lineN );
 
     m_prevPair = m_currentTrace.EndingPrimitives();
+    m_entryGateways.reset();
     m_lastFixNode = m_lastNode;
 
     // avoid an use-after-free error (CommitPlacement calls NODE::Commit which will invalidate the shove heads state. Need to rethink the memory management).
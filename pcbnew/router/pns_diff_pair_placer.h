@@ -197,6 +197,12 @@ private:
 
 
     bool routeHead( const VECTOR2I& aP );
+
+    ///< Gateways of the current starting primitive pair, built once per pair
+    void buildEntryGateways( DP_GATEWAYS& aGateways );
+
+    ///< Gateways around the cursor, reused while the cursor and sizes stay the same
+    void buildCursorGateways( DP_GATEWAYS& aGateways, const VECTOR2I& aCursor );
     bool tryWalkDp( NODE* aNode, DIFF_PAIR& aPair, bool aSolidsOnly );
 
     ///< route step, walk around mode
@@ -279,6 +285,34 @@ private:
 
     bool m_idle;
     bool m_hasFixedAnything;
+
+    struct ENTRY_GATEWAYS_KEY
+    {
+        const ITEM* m_primP;
+        const ITEM* m_primN;
+        VECTOR2I    m_anchorP;
+        VECTOR2I    m_anchorN;
+        bool        m_diagonal;
+        int         m_gap;
+
+        bool operator==( const ENTRY_GATEWAYS_KEY& aOther ) const = default;
+    };
+
+    struct CURSOR_GATEWAYS_KEY
+    {
+        VECTOR2I m_cursor;
+        int      m_gap;
+        bool     m_fitVias;
+        int      m_viaDiameter;
+        int      m_viaGap;
+
+        bool operator==( const CURSOR_GATEWAYS_KEY& aOther ) const = default;
+    };
+
+    ///< Gateway sets of the last routeHead() call: they are rebuilt on every mouse move
+    ///< otherwise, although the starting pair rarely changes while placing a pair.
+    std::optional<std::pair<ENTRY_GATEWAYS_KEY, std::vector<DP_GATEWAY>>>  m_entryGateways;
+    std::optional<std::pair<CURSOR_GATEWAYS_KEY, std::vector<DP_GATEWAY>>> m_cursorGateways;
 };
 
 }
@@ -19,23 +19,79 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "pns_index.h"
 #include "pns_router.h"
 
 namespace PNS {
 
 
-void INDEX::Add( ITEM* aItem )
+void INDEX::NET_BUCKET::Add( ITEM* aItem )
 {
     const PNS_LAYER_RANGE& range = aItem->Layers();
-    assert( range.Start() != -1 && range.End() != -1 );
+    BOX2I                  bbox;
+    bool                   hasShape = false;
 
-    if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
+    for( int i = range.Start(); i <= range.End(); ++i )
+    {
+        if( const SHAPE* shape = aItem->Shape( i ) )
+        {
+            if( hasShape )
+                bbox.Merge( shape->BBox() );
+            else
+                bbox = shape->BBox();
+
+            hasShape = true;
+        }
+    }
+
+    // Items without a shape can't be told apart by area; let every search see them
+    if( !hasShape )
+    {
+        bbox.SetMaximum();
+    }
+
+    m_items.push_back( aItem );
+    m_minX.push_back( bbox.GetLeft() );
+    m_minY.push_back( bbox.GetTop() );
+    m_maxX.push_back( bbox.GetRight() );
+    m_maxY.push_back( bbox.GetBottom() );
+    m_layerStart.push_back( range.Start() );
+    m_layerEnd.push_back( range.End() );
+}
+
+
+void INDEX::NET_BUCKET::Remove( ITEM* aItem )
+{
+    auto it = std::find( m_items.begin(), m_items.end(), aItem );
+
+    if( it == m_items.end() )
+        return;
+
+    // The order of the items of a net doesn't matter, so swap with the last one and pop
+    size_t idx = it - m_items.begin();
+    size_t last = m_items.size() - 1;
+
+    for( auto* column : { &m_minX, &m_minY, &m_maxX, &m_maxY, &m_layerStart, &m_layerEnd } )
     {
-        for( int i = 0; i <= range.End(); ++i )
-            m_subIndices.emplace_back( std::make_unique<ITEM_SHAPE_INDEX>( i ) );
+        ( *column )[idx] = ( *column )[last];
+        column->pop_back();
     }
 
+    m_items[idx] = m_items[last];
+    m_items.pop_back();
+}
+
+
+void INDEX::Add( ITEM* aItem )
+{
+    const PNS_LAYER_RANGE& range = aItem->Layers();
+    assert( range.Start() != -1 && range.End() != -1 );
+
+    while( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
+        m_subIndices.emplace_back( std::make_unique<ITEM_SHAPE_INDEX>( m_subIndices.size() ) );
+
     for( int i = range.Start(); i <= range.End(); ++i )
         m_subIndices[i]->Add( aItem );
 
@@ -43,7 +99,7 @@ void INDEX::Add( ITEM* aItem )
     NET_HANDLE net = aItem->Net();
 
     if( net )
-        m_netMap[net].push_back( aItem );
+        m_netMap[net].Add( aItem );
 }
 
 
@@ -61,8 +117,13 @@ void INDEX::Remove( ITEM* aItem )
     m_allItems.erase( aItem );
     NET_HANDLE net = aItem->Net();
 
-    if( net && m_netMap.find( net ) != m_netMap.end() )
-        m_netMap[net].remove( aItem );
+    if( !net )
+        return;
+
+    auto it = m_netMap.find( net );
+
+    if( it != m_netMap.end() )
+        it->second.Remove( aItem );
 }
 
 
@@ -75,10 +136,12 @@ void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 
 INDEX::NET_ITEMS_LIST* INDEX::GetItemsForNet( NET_HANDLE aNet )
 {
-    if( m_netMap.find( aNet ) == m_netMap.end() )
+    auto it = m_netMap.find( aNet );
+
+    if( it == m_netMap.end() )
         return nullptr;
 
-    return &m_netMap[aNet];
+    return &it->second.m_items;
 }
 
 };
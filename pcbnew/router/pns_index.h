@@ -23,9 +23,9 @@
 #define __PNS_INDEX_H
 
 #include <deque>
-#include <list>
-#include <map>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <layer_ids.h>
 #include <geometry/shape_index.h>
@@ -46,7 +46,7 @@ namespace PNS {
 class INDEX
 {
 public:
-    typedef std::list<ITEM*>            NET_ITEMS_LIST;
+    typedef std::vector<ITEM*>          NET_ITEMS_LIST;
     typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
@@ -95,6 +95,19 @@ public:
     template<class Visitor>
     int Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
+    /**
+     * Searches items of a single net whose bounding box overlaps aArea on any of aLayers.
+     * Only the items of the net are visited, whatever the number of items of other nets
+     * nearby.
+     *
+     * @param aVisitor function object called on each found item. Return false from the
+     *                 visitor to stop searching.
+     * @return number of items found.
+     */
+    template<class Visitor>
+    int QueryNet( NET_HANDLE aNet, const BOX2I& aArea, const PNS_LAYER_RANGE& aLayers,
+                  Visitor& aVisitor ) const;
+
     /**
      * Returns list of all items in a given net.
      */
@@ -119,13 +132,31 @@ public:
     ITEM_SET::iterator end() { return m_allItems.end(); }
 
 private:
+    /**
+     * Items of one net, with their bounding boxes (over all the layers they span) and layer
+     * ranges kept in parallel arrays so that net-restricted searches scan contiguous memory.
+     */
+    struct NET_BUCKET
+    {
+        void Add( ITEM* aItem );
+        void Remove( ITEM* aItem );
+
+        NET_ITEMS_LIST   m_items;
+        std::vector<int> m_minX;
+        std::vector<int> m_minY;
+        std::vector<int> m_maxX;
+        std::vector<int> m_maxY;
+        std::vector<int> m_layerStart;
+        std::vector<int> m_layerEnd;
+    };
+
     template <class Visitor>
     int querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
 private:
-    std::deque<std::unique_ptr<ITEM_SHAPE_INDEX>> m_subIndices;
-    std::map<NET_HANDLE, NET_ITEMS_LIST> m_netMap;
-    ITEM_SET                             m_allItems;
+    std::deque<std::unique_ptr<ITEM_SHAPE_INDEX>>  m_subIndices;
+    std::unordered_map<NET_HANDLE, NET_BUCKET>     m_netMap;
+    ITEM_SET                                       m_allItems;
 };
 
 
@@ -165,6 +196,40 @@ int INDEX::Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) con
     return total;
 }
 
+template<class Visitor>
+int INDEX::QueryNet( NET_HANDLE aNet, const BOX2I& aArea, const PNS_LAYER_RANGE& aLayers,
+                     Visitor& aVisitor ) const
+{
+    auto it = m_netMap.find( aNet );
+
+    if( it == m_netMap.end() )
+        return 0;
+
+    const NET_BUCKET& bucket = it->second;
+    const int         minX = aArea.GetLeft();
+    const int         minY = aArea.GetTop();
+    const int         maxX = aArea.GetRight();
+    const int         maxY = aArea.GetBottom();
+    int               total = 0;
+
+    for( size_t i = 0; i < bucket.m_items.size(); ++i )
+    {
+        if( bucket.m_maxX[i] < minX || bucket.m_minX[i] > maxX
+                || bucket.m_maxY[i] < minY || bucket.m_minY[i] > maxY
+                || bucket.m_layerEnd[i] < aLayers.Start() || bucket.m_layerStart[i] > aLayers.End() )
+        {
+            continue;
+        }
+
+        total++;
+
+        if( !aVisitor( bucket.m_items[i] ) )
+            break;
+    }
+
+    return total;
+}
+
 };
 
 #endif
@@ -0,0 +1,126 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PNS_ITEM_POOL_H
+#define PNS_ITEM_POOL_H
+
+#include <cstddef>
+#include <new>
+
+namespace PNS {
+
+/**
+ * Recycles the memory of router items of one size.
+ *
+ * The shove and walkaround algorithms clone and drop segments, arcs, vias and lines by the
+ * thousands for every iteration.  Freed blocks are kept on a per-thread free list and handed
+ * out again by the next allocation of the same size, so that in steady state branching and
+ * discarding nodes doesn't touch the heap.  Blocks of other sizes (derived classes) go straight
+ * to the global allocator.
+ */
+template <size_t Size>
+class ITEM_POOL
+{
+public:
+    static void* Allocate( size_t aSize )
+    {
+        FREE_LIST& list = freeList();
+
+        if( aSize == Size && list.m_head )
+        {
+            BLOCK* block = list.m_head;
+            list.m_head = block->m_next;
+            list.m_count--;
+            return block;
+        }
+
+        return ::operator new( aSize );
+    }
+
+    static void Free( void* aPtr, size_t aSize )
+    {
+        FREE_LIST& list = freeList();
+
+        if( aSize == Size && list.m_count < MAX_FREE_BLOCKS )
+        {
+            BLOCK* block = static_cast<BLOCK*>( aPtr );
+            block->m_next = list.m_head;
+            list.m_head = block;
+            list.m_count++;
+            return;
+        }
+
+        ::operator delete( aPtr );
+    }
+
+private:
+    ///< Bound on the memory kept after a large routing operation
+    static constexpr size_t MAX_FREE_BLOCKS = 16384;
+
+    struct BLOCK
+    {
+        BLOCK* m_next;
+    };
+
+    static_assert( Size >= sizeof( BLOCK ) );
+
+    struct FREE_LIST
+    {
+        ~FREE_LIST()
+        {
+            while( m_head )
+            {
+                BLOCK* next = m_head->m_next;
+                ::operator delete( m_head );
+                m_head = next;
+            }
+
+            // Items deleted during static destruction go straight to the heap
+            m_count = MAX_FREE_BLOCKS;
+        }
+
+        BLOCK* m_head = nullptr;
+        size_t m_count = 0;
+    };
+
+    static FREE_LIST& freeList()
+    {
+        // Per thread, so that no locking is needed.  Blocks freed by another thread than the
+        // one which allocated them simply join that thread's list.
+        thread_local FREE_LIST list;
+        return list;
+    }
+};
+
+}
+
+/**
+ * Route the allocations of a router item class through an ITEM_POOL.
+ */
+#define PNS_POOLED_ITEM( ClassName )                                                   \
+    static void* operator new( size_t aSize )                                          \
+    {                                                                                  \
+        return PNS::ITEM_POOL<sizeof( ClassName )>::Allocate( aSize );                 \
+    }                                                                                  \
+    static void operator delete( void* aPtr, size_t aSize )                            \
+    {                                                                                  \
+        PNS::ITEM_POOL<sizeof( ClassName )>::Free( aPtr, aSize );                      \
+    }
+
+#endif // PNS_ITEM_POOL_H
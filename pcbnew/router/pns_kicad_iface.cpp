@@ -96,6 +96,40 @@ struct CLEARANCE_CACHE_KEY
     }
 };
 
+/**
+ * Clearance cache key which doesn't depend on the PNS items themselves, only on what the
+ * clearance rules can see of them when they only test classes.  Temporary items created for
+ * every mouse move then share the cached clearances of their net.
+ */
+struct CLEARANCE_CLASS_KEY
+{
+    struct ITEM_DESC
+    {
+        int               Kind = 0;
+        PNS::NET_HANDLE   Net = nullptr;
+        const BOARD_ITEM* BoardItem = nullptr;   ///< Local overrides, pad/via/edge properties
+        bool              HasParent = false;
+        int               LayerStart = 0;
+        int               LayerEnd = 0;
+
+        bool operator==( const ITEM_DESC& other ) const
+        {
+            return Kind == other.Kind && Net == other.Net && BoardItem == other.BoardItem
+                    && HasParent == other.HasParent && LayerStart == other.LayerStart
+                    && LayerEnd == other.LayerEnd;
+        }
+    };
+
+    ITEM_DESC A;
+    ITEM_DESC B;
+    bool      Flag;
+
+    bool operator==( const CLEARANCE_CLASS_KEY& other ) const
+    {
+        return A == other.A && B == other.B && Flag == other.Flag;
+    }
+};
+
 namespace std
 {
     template <>
@@ -108,6 +142,25 @@ namespace std
             return retval;
         }
     };
+
+    template <>
+    struct hash<CLEARANCE_CLASS_KEY>
+    {
+        std::size_t operator()( const CLEARANCE_CLASS_KEY& k ) const
+        {
+            size_t retval = 0xBADC0FFEE0DDF00D;
+
+            for( const CLEARANCE_CLASS_KEY::ITEM_DESC* d : { &k.A, &k.B } )
+            {
+                hash_combine( retval, d->Kind, hash<const void*>()( d->Net ),
+                              hash<const void*>()( d->BoardItem ), d->HasParent, d->LayerStart,
+                              d->LayerEnd );
+            }
+
+            hash_combine( retval, k.Flag );
+            return retval;
+        }
+    };
 }
 
 
@@ -154,6 +207,11 @@ public:
 private:
     BOARD_ITEM* getBoardItem( const PNS::ITEM* aItem, PCB_LAYER_ID aBoardLayer, int aIdx = 0 );
 
+    /// @return true if clearances can be cached by class for this routing session.
+    bool classCacheEnabled();
+
+    int computeClearance( const PNS::ITEM* aA, const PNS::ITEM* aB, bool aUseClearanceEpsilon );
+
 private:
     PNS::ROUTER_IFACE* m_routerIface;
     BOARD*             m_board;
@@ -164,6 +222,12 @@ private:
 
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_tempClearanceCache;
+
+    // Clearances by item class, when the clearance rules allow it.  Valid for one routing
+    // session and one board timestamp.
+    std::optional<bool>                          m_classCacheEnabled;
+    int                                          m_classCacheTimeStamp;
+    std::unordered_map<CLEARANCE_CLASS_KEY, int> m_classClearanceCache;
 };
 
 
@@ -173,7 +237,8 @@ PNS_PCBNEW_RULE_RESOLVER::PNS_PCBNEW_RULE_RESOLVER( BOARD* aBoard,
     m_board( aBoard ),
     m_dummyTracks{ { aBoard }, { aBoard } },
     m_dummyArcs{ { aBoard }, { aBoard } },
-    m_dummyVias{ { aBoard }, { aBoard } }
+    m_dummyVias{ { aBoard }, { aBoard } },
+    m_classCacheTimeStamp( -1 )
 {
     for( PCB_TRACK& track : m_dummyTracks )
         track.SetFlags( ROUTER_TRANSIENT );
@@ -497,6 +562,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 {
     m_clearanceCache.clear();
     m_tempClearanceCache.clear();
+    m_classClearanceCache.clear();
+    m_classCacheEnabled.reset();
 }
 
 
@@ -506,6 +573,30 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 }
 
 
+bool PNS_PCBNEW_RULE_RESOLVER::classCacheEnabled()
+{
+    if( !m_classCacheEnabled.has_value() )
+    {
+        std::shared_ptr<DRC_ENGINE> drcEngine = m_board ? m_board->GetDesignSettings().m_DRCEngine
+                                                        : nullptr;
+
+        m_classCacheEnabled = drcEngine
+                && drcEngine->RulesDependOnlyOnClasses( CLEARANCE_CONSTRAINT )
+                && drcEngine->RulesDependOnlyOnClasses( HOLE_CLEARANCE_CONSTRAINT )
+                && drcEngine->RulesDependOnlyOnClasses( EDGE_CLEARANCE_CONSTRAINT )
+                && drcEngine->RulesDependOnlyOnClasses( PHYSICAL_CLEARANCE_CONSTRAINT );
+    }
+
+    if( *m_classCacheEnabled && m_classCacheTimeStamp != m_board->GetTimeStamp() )
+    {
+        m_classClearanceCache.clear();
+        m_classCacheTimeStamp = m_board->GetTimeStamp();
+    }
+
+    return *m_classCacheEnabled;
+}
+
+
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
@@ -523,6 +614,78 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
     if( it != m_tempClearanceCache.end() )
         return it->second;
 
+    // Items the rules can't tell apart have the same clearance.  Hole-to-hole rules test the
+    // holes themselves.
+    bool                classKeyed = classCacheEnabled()
+                                        && !( IsDrilledHole( aA ) && IsDrilledHole( aB ) );
+    CLEARANCE_CLASS_KEY classKey;
+    int                 rv;
+
+    if( classKeyed )
+    {
+        auto describe =
+                []( const PNS::ITEM* aItem )
+                {
+                    CLEARANCE_CLASS_KEY::ITEM_DESC desc;
+
+                    if( aItem )
+                    {
+                        desc.Kind = aItem->Kind();
+                        desc.Net = aItem->Net();
+                        desc.BoardItem = aItem->BoardItem();
+                        desc.HasParent = aItem->Parent() != nullptr;
+                        desc.LayerStart = aItem->Layers().Start();
+                        desc.LayerEnd = aItem->Layers().End();
+                    }
+
+                    return desc;
+                };
+
+        classKey = { describe( aA ), describe( aB ), aUseClearanceEpsilon };
+
+        auto classIt = m_classClearanceCache.find( classKey );
+
+        if( classIt != m_classClearanceCache.end() )
+        {
+            rv = classIt->second;
+        }
+        else
+        {
+            rv = computeClearance( aA, aB, aUseClearanceEpsilon );
+            m_classClearanceCache[ classKey ] = rv;
+        }
+    }
+    else
+    {
+        rv = computeClearance( aA, aB, aUseClearanceEpsilon );
+    }
+
+    /*
+     * It makes no sense to put items that have no owning NODE in the cache - they can be
+     * allocated on stack and we can't really invalidate them in the cache when they are
+     * destroyed.  Probably a better idea would be to use a static unique counter in PNS::ITEM
+     * constructor to generate the cache keys.
+     *
+     * However, algorithms DO greatly benefit from using the cache, so ownerless items need to be
+     * cached.  In order to easily clear those only, a temporary cache is created. If this doesn't
+     * seem nice, an alternative is clearing the full cache once it reaches a certain size. Also
+     * not pretty, but VERY effective to keep things interactive.
+     */
+    if( aA && aB )
+    {
+        if ( aA->Owner() && aB->Owner() )
+            m_clearanceCache[ key ] = rv;
+        else
+            m_tempClearanceCache[ key ] = rv;
+    }
+
+    return rv;
+}
+
+
+int PNS_PCBNEW_RULE_RESOLVER::computeClearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
+                                                bool aUseClearanceEpsilon )
+{
     PNS::CONSTRAINT constraint;
     int             rv = 0;
     PNS_LAYER_RANGE     layers;
@@ -588,25 +751,6 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
     if( aUseClearanceEpsilon && rv > 0 )
         rv = std::max( 0, rv - m_clearanceEpsilon );
 
-    /*
-     * It makes no sense to put items that have no owning NODE in the cache - they can be
-     * allocated on stack and we can't really invalidate them in the cache when they are
-     * destroyed.  Probably a better idea would be to use a static unique counter in PNS::ITEM
-     * constructor to generate the cache keys.
-     *
-     * However, algorithms DO greatly benefit from using the cache, so ownerless items need to be
-     * cached.  In order to easily clear those only, a temporary cache is created. If this doesn't
-     * seem nice, an alternative is clearing the full cache once it reaches a certain size. Also
-     * not pretty, but VERY effective to keep things interactive.
-     */
-    if( aA && aB )
-    {
-        if ( aA->Owner() && aB->Owner() )
-            m_clearanceCache[ key ] = rv;
-        else
-            m_tempClearanceCache[ key ] = rv;
-    }
-
     return rv;
 }
 
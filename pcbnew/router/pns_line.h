@@ -34,6 +34,7 @@
 #include "pns_item.h"
 #include "pns_via.h"
 #include "pns_link_holder.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -116,6 +117,8 @@ public:
     /// @copydoc ITEM::Clone()
     virtual LINE* Clone() const override;
 
+    PNS_POOLED_ITEM( LINE )
+
     // Copy operator
     LINE& operator=( const LINE& aOther );
 
@@ -31,6 +31,8 @@ MULTI_DRAGGER::MULTI_DRAGGER( ROUTER* aRouter ) : DRAG_ALGO( aRouter )
 {
     m_world = nullptr;
     m_lastNode = nullptr;
+    m_lastDragMode = RM_MarkObstacles;
+    m_lastWalkaroundAttempt = -1;
 }
 
 
@@ -44,6 +46,8 @@ bool MULTI_DRAGGER::Start( const VECTOR2I& aP, ITEM_SET& aPrimitives )
     m_lastNode = nullptr;
     m_dragStatus = false;
     m_dragStartPoint = aP;
+    m_lastDragPoint.reset();
+    m_lastWalkaroundAttempt = -1;
 
     // check if the initial ("leader") primitive set is empty...
     if( aPrimitives.Empty() )
@@ -450,7 +454,68 @@ void MULTI_DRAGGER::restoreLeaderSegments( std::vector<MDRAG_LINE>& aCompletedLi
     }
 }
 
-bool MULTI_DRAGGER::multidragWalkaround( std::vector<MDRAG_LINE>& aCompletedLines )
+std::vector<std::vector<int>>
+MULTI_DRAGGER::groupInteractingLines( const std::vector<MDRAG_LINE>& aLines ) const
+{
+    // Two lines interact when the areas swept by their drag, grown by a clearance and a track
+    // width for the detours of the walkaround, overlap
+    std::vector<BOX2I> areas;
+    std::vector<int>   parent( aLines.size() );
+
+    areas.reserve( aLines.size() );
+
+    for( const MDRAG_LINE& l : aLines )
+    {
+        BOX2I area = l.originalLine.CLine().BBox();
+        area.Merge( l.draggedLine.CLine().BBox() );
+        area.Inflate( m_world->GetMaxClearance() + 2 * l.draggedLine.Width() );
+        areas.push_back( area );
+    }
+
+    auto findRoot =
+            [&]( int aIdx ) -> int
+            {
+                while( parent[aIdx] != aIdx )
+                    aIdx = parent[aIdx] = parent[parent[aIdx]];
+
+                return aIdx;
+            };
+
+    for( int i = 0; i < (int) aLines.size(); i++ )
+        parent[i] = i;
+
+    for( int i = 0; i < (int) aLines.size(); i++ )
+    {
+        for( int j = i + 1; j < (int) aLines.size(); j++ )
+        {
+            if( areas[i].Intersects( areas[j] ) )
+                parent[findRoot( j )] = findRoot( i );
+        }
+    }
+
+    // Keep the drag distance order of the lines within each group
+    std::vector<std::vector<int>> groups;
+    std::vector<int>              groupOfRoot( aLines.size(), -1 );
+
+    for( int i = 0; i < (int) aLines.size(); i++ )
+    {
+        int root = findRoot( i );
+
+        if( groupOfRoot[root] < 0 )
+        {
+            groupOfRoot[root] = (int) groups.size();
+            groups.emplace_back();
+        }
+
+        groups[groupOfRoot[root]].push_back( i );
+    }
+
+    return groups;
+}
+
+
+bool MULTI_DRAGGER::multidragWalkaround( std::vector<MDRAG_LINE>& aCompletedLines,
+                                         bool aWarmStart )
 {
     // fixme: rewrite using shared_ptr...
     if( m_lastNode )
@@ -475,79 +540,101 @@ bool MULTI_DRAGGER::multidragWalkaround( std::vector<MDRAG_LINE>& aCompletedLine
         preWalkNode->Remove( l.originalLine );
     }
 
-    bool fail = false;
+    NODE* node = preWalkNode->Branch();
+    int   preferredAttempt = aWarmStart ? m_lastWalkaroundAttempt : -1;
 
-    NODE* tmpNodes[2];
-    int totalLength[2];
+    m_lastWalkaroundAttempt = -1;
 
-    for( int attempt = 0; attempt < 2; attempt++ )
+    // Lines of different groups can't get in each other's way, so the walk order only matters
+    // within a group. Each group tries both orders (unless it is a single line) and keeps the
+    // shorter result; the walks of one group are obstacles for the groups walked after it.
+    for( const std::vector<int>& group : groupInteractingLines( aCompletedLines ) )
     {
-        NODE *node = tmpNodes[attempt] = preWalkNode->Branch();
-        totalLength[attempt] = 0;
-        fail = false;
-
-        for( int lidx = 0; lidx < aCompletedLines.size(); lidx++ )
+        int  attemptCount = group.size() > 1 ? 2 : 1;
+        int  firstAttempt = 0;
+        int  bestAttempt = -1;
+        int  bestLength = 0;
+        std::vector<LINE> bestWalks;
+
+        // When the cursor has barely moved since the last frame, the order that won then is
+        // very likely to win again: try it first and skip the other one if it succeeds.
+        if( attemptCount > 1 && preferredAttempt >= 0 )
+            firstAttempt = preferredAttempt;
+
+        for( int n = 0; n < attemptCount; n++ )
         {
-            MDRAG_LINE& l = aCompletedLines[attempt ? aCompletedLines.size() - 1 - lidx : lidx];
+            int   attempt = ( firstAttempt + n ) % 2;
+            NODE* tmpNode = node->Branch();
+            int   totalLength = 0;
+            bool  fail = false;
 
-            LINE walk( l.draggedLine );
-            auto result = tryWalkaround( node, l.draggedLine, walk );
+            std::vector<LINE> walks;
 
-            PNS_DBG( Dbg(), AddItem, &l.draggedLine, YELLOW, 100000, wxString::Format("dragged lidx=%d attempt=%d dd=%d isPrimary=%d", lidx, attempt, l.dragDist, l.isPrimaryLine?1:0) );
-            PNS_DBG( Dbg(), AddItem, &walk, BLUE, 100000, wxString::Format("walk    lidx=%d attempt=%d", lidx, attempt) );
+            for( int gidx = 0; gidx < (int) group.size(); gidx++ )
+            {
+                int         lidx = group[attempt ? group.size() - 1 - gidx : gidx];
+                MDRAG_LINE& l = aCompletedLines[lidx];
 
+                LINE walk( l.draggedLine );
+                auto result = tryWalkaround( tmpNode, l.draggedLine, walk );
 
-            if( result )
-            {
-                node->Add( walk );
-                totalLength[attempt] += walk.CLine().Length() - l.draggedLine.CLine().Length();
-                l.draggedLine = std::move( walk );
-            }
-            else
-            {
-                delete node;
-                tmpNodes[attempt] = nullptr;
-                fail = true;
-                break;
+                PNS_DBG( Dbg(), AddItem, &l.draggedLine, YELLOW, 100000, wxString::Format("dragged lidx=%d attempt=%d dd=%d isPrimary=%d", lidx, attempt, l.dragDist, l.isPrimaryLine?1:0) );
+                PNS_DBG( Dbg(), AddItem, &walk, BLUE, 100000, wxString::Format("walk    lidx=%d attempt=%d", lidx, attempt) );
+
+                if( !result )
+                {
+                    fail = true;
+                    break;
+                }
+
+                totalLength += walk.CLine().Length() - l.draggedLine.CLine().Length();
+                walks.push_back( walk );
+
+                // add a copy, the walk itself is kept unlinked for the final node
+                LINE linked( walk );
+                tmpNode->Add( linked );
             }
-        }
-    }
 
-    if( fail )
-        return false;
+            delete tmpNode;
 
+            if( fail )
+                continue;
 
-    bool rv = false;
+            if( bestAttempt < 0 || totalLength < bestLength )
+            {
+                bestAttempt = attempt;
+                bestLength = totalLength;
+                bestWalks = std::move( walks );
+            }
 
-    if( tmpNodes[0] && tmpNodes[1] )
-    {
-        if ( totalLength[0] < totalLength[1] )
+            if( n == 0 && attempt == preferredAttempt )
+                break;
+        }
+
+        if( bestAttempt < 0 )
         {
-            delete tmpNodes[1];
-            m_lastNode = tmpNodes[0];
-            rv = true;
+            delete node;
+            delete preWalkNode;
+            return false;
         }
-        else
+
+        if( attemptCount > 1 )
+            m_lastWalkaroundAttempt = bestAttempt;
+
+        for( int gidx = 0; gidx < (int) group.size(); gidx++ )
         {
-            delete tmpNodes[0];
-            m_lastNode = tmpNodes[1];
-            rv = true;
+            MDRAG_LINE& l = aCompletedLines[group[bestAttempt ? group.size() - 1 - gidx : gidx]];
+
+            l.draggedLine = std::move( bestWalks[gidx] );
+            node->Add( l.draggedLine );
         }
     }
-    else if ( tmpNodes[0] )
-    {
-        m_lastNode = tmpNodes[0];
-        rv = true;
-    }
-    else if ( tmpNodes[1] )
-    {
-        m_lastNode = tmpNodes[1];
-        rv = true;
-    }
+
+    m_lastNode = node;
 
     restoreLeaderSegments( aCompletedLines );
 
-    return rv;
+    return true;
 }
 
 
@@ -669,6 +756,10 @@ bool MULTI_DRAGGER::multidragShove( std::vector<MDRAG_LINE>& aCompletedLines )
 // this is called every time the user moves the mouse while dragging a set of multiple tracks
 bool MULTI_DRAGGER::Drag( const VECTOR2I& aP )
 {
+    // Moves that don't change the cursor position (e.g. a refresh) keep the last result
+    if( m_lastDragPoint && *m_lastDragPoint == aP && m_lastDragMode == Settings().Mode() )
+        return m_dragStatus;
+
     std::optional<LINE> primaryPreDrag, primaryDragged;
 
 
@@ -927,10 +1018,17 @@ bool MULTI_DRAGGER::Drag( const VECTOR2I& aP )
             break;
     }
 
+    // Small moves can start from the solution of the previous one
+    bool warmStart = m_lastDragPoint && primaryDragged
+                     && ( aP - *m_lastDragPoint ).EuclideanNorm() < primaryDragged->Width();
+
+    m_lastDragPoint = aP;
+    m_lastDragMode = Settings().Mode();
+
     switch( Settings().Mode() )
     {
         case RM_Walkaround:
-            m_dragStatus = multidragWalkaround ( completed );
+            m_dragStatus = multidragWalkaround( completed, warmStart );
             break;
 
         case RM_Shove:
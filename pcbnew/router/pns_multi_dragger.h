@@ -22,6 +22,7 @@
 #define __PNS_MULTI_DRAGGER_H
 
 #include <memory>
+#include <optional>
 #include <math/vector2d.h>
 
 #include "pns_node.h"
@@ -156,7 +157,15 @@ private:
 
     bool multidragMarkObstacles ( std::vector<MDRAG_LINE>& aCompletedLines );
     bool multidragShove ( std::vector<MDRAG_LINE>& aCompletedLines );
-    bool multidragWalkaround ( std::vector<MDRAG_LINE>& aCompletedLines );
+    bool multidragWalkaround( std::vector<MDRAG_LINE>& aCompletedLines, bool aWarmStart );
+
+    /**
+     * Split the lines into groups that can be walked independently of each other.
+     *
+     * @return the indices of the lines of each group, in their original order.
+     */
+    std::vector<std::vector<int>> groupInteractingLines( const std::vector<MDRAG_LINE>& aLines ) const;
+
     void restoreLeaderSegments( std::vector<MDRAG_LINE>& aCompletedLines );
     int findNewLeaderSegment( const MDRAG_LINE& aLine ) const;
     bool tryWalkaround( NODE* aNode, LINE& aOrig, LINE& aWalk );
@@ -176,6 +185,10 @@ private:
     SEG m_guide;
     std::unique_ptr<SHOVE> m_shove;
 
+    std::optional<VECTOR2I> m_lastDragPoint;
+    PNS_MODE                m_lastDragMode;
+    int                     m_lastWalkaroundAttempt; ///< Line order that won the last walkaround
+
 };
 
 }
@@ -20,10 +20,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <cassert>
 #include <utility>
 
+#include <math/util.h>
 #include <math/vector2d.h>
 
 #include <geometry/seg.h>
@@ -39,6 +42,7 @@
 #include "pns_node.h"
 #include "pns_via.h"
 #include "pns_solid.h"
+#include "pns_stats.h"
 #include "pns_joint.h"
 #include "pns_index.h"
 #include "pns_debug_decorator.h"
@@ -86,6 +90,7 @@ NODE::~NODE()
 #endif
 
     m_joints.clear();
+    m_jointGrid.m_valid = false;
 
     std::vector<const ITEM*> toDelete;
 
@@ -144,6 +149,7 @@ NODE* NODE::Branch()
 {
     NODE* child = new NODE;
 
+    STATS::Count( STATS::Get().m_branches );
     m_children.insert( child );
 
     child->m_depth = m_depth + 1;
@@ -724,6 +730,15 @@ bool NODE::QueryEdgeExclusions( const VECTOR2I& aPos ) const
 }
 
 
+void NODE::addOverride( ITEM* aItem )
+{
+    auto it = std::lower_bound( m_override.begin(), m_override.end(), aItem );
+
+    if( it == m_override.end() || *it != aItem )
+        m_override.insert( it, aItem );
+}
+
+
 void NODE::doRemove( ITEM* aItem )
 {
     bool holeRemoved = false; // fixme: better logic, I don't like this
@@ -732,10 +747,10 @@ void NODE::doRemove( ITEM* aItem )
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
     {
-        m_override.insert( aItem );
+        addOverride( aItem );
 
         if( aItem->HasHole() )
-            m_override.insert( aItem->Hole() );
+            addOverride( aItem->Hole() );
     }
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
@@ -818,6 +833,7 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
             if( aItem->LayersOverlap( &f->second ) )
             {
                 m_joints.erase( f );
+                m_jointGrid.m_valid = false;
                 split = true;
                 break;
             }
@@ -831,6 +847,7 @@ void NODE::rebuildJoint( const JOINT* aJoint, const ITEM* aItem )
         JOINT jtDummy( tag.pos, PNS_LAYER_RANGE(-1), tag.net );
 
         m_joints.insert( TagJointPair( tag, jtDummy ) );
+        m_jointGrid.m_valid = false;
         completelyErased = true;
     }
 
@@ -1318,6 +1335,8 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const PNS_LAYER_RANGE& aLayers, N
 
         for( f = range.first; f != range.second; ++f )
             m_joints.insert( *f );
+
+        m_jointGrid.m_valid = false;
     }
 
     // now insert and combine overlapping joints
@@ -1339,12 +1358,15 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const PNS_LAYER_RANGE& aLayers, N
             {
                 jt.Merge( f->second );
                 m_joints.erase( f );
+                m_jointGrid.m_valid = false;
                 merged = true;
                 break;
             }
         }
     } while( merged );
 
+    m_jointGrid.m_valid = false;
+
     return m_joints.insert( TagJointPair( tag, jt ) )->second;
 }
 
@@ -1676,6 +1698,61 @@ ARC* NODE::findRedundantArc( ARC* aArc )
 }
 
 
+void NODE::updateJointGrid()
+{
+    if( m_jointGrid.m_valid )
+        return;
+
+    m_jointGrid.m_cells.clear();
+    m_jointGrid.m_valid = true;
+
+    if( m_joints.empty() )
+        return;
+
+    BOX2I extents;
+    bool  first = true;
+
+    for( const JOINT_MAP::value_type& j : m_joints )
+    {
+        if( first )
+            extents = BOX2I( j.second.Pos(), VECTOR2I( 0, 0 ) );
+        else
+            extents.Merge( j.second.Pos() );
+
+        first = false;
+    }
+
+    // About one joint per cell on average, and no more rows or columns than joints when they
+    // are all lined up.
+    double count = (double) m_joints.size();
+    double area = (double) extents.GetWidth() * (double) extents.GetHeight();
+    double cellSize = std::max( std::sqrt( area / count ),
+                                std::max( extents.GetWidth(), extents.GetHeight() ) / count );
+
+    m_jointGrid.m_origin = extents.GetOrigin();
+    m_jointGrid.m_cellSize = std::max( 1, KiROUND( cellSize ) );
+    m_jointGrid.m_cols = (int64_t) extents.GetWidth() / m_jointGrid.m_cellSize + 1;
+    m_jointGrid.m_rows = (int64_t) extents.GetHeight() / m_jointGrid.m_cellSize + 1;
+
+    m_jointGrid.m_cells.reserve( m_joints.size() );
+
+    for( JOINT_MAP::value_type& j : m_joints )
+    {
+        VECTOR2L rel = VECTOR2L( j.second.Pos() ) - VECTOR2L( m_jointGrid.m_origin );
+        int64_t  cell = ( rel.y / m_jointGrid.m_cellSize ) * m_jointGrid.m_cols
+                        + rel.x / m_jointGrid.m_cellSize;
+
+        m_jointGrid.m_cells.emplace_back( cell, &j.second );
+    }
+
+    std::sort( m_jointGrid.m_cells.begin(), m_jointGrid.m_cells.end(),
+               []( const std::pair<int64_t, JOINT*>& a, const std::pair<int64_t, JOINT*>& b )
+               {
+                   return a.first < b.first;
+               } );
+}
+
+
 int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, PNS_LAYER_RANGE aLayerMask,
                        int aKindMask )
 {
@@ -1683,6 +1760,70 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, PNS_LAYE
 
     aJoints.clear();
 
+    auto queryGrid =
+            [&]( NODE* aNode, bool aSkipOverrides )
+            {
+                aNode->updateJointGrid();
+
+                const JOINT_GRID& grid = aNode->m_jointGrid;
+
+                if( grid.m_cells.empty() )
+                    return;
+
+                auto cellOf =
+                        [&]( int aCoord, int aOrigin, int64_t aCount )
+                        {
+                            int64_t c = ( (int64_t) aCoord - aOrigin ) / grid.m_cellSize;
+                            return std::clamp<int64_t>( c, 0, aCount - 1 );
+                        };
+
+                VECTOR2I boxEnd = aBox.GetEnd();
+
+                if( boxEnd.x < grid.m_origin.x || boxEnd.y < grid.m_origin.y )
+                    return;
+
+                int64_t col0 = cellOf( aBox.GetX(), grid.m_origin.x, grid.m_cols );
+                int64_t col1 = cellOf( boxEnd.x, grid.m_origin.x, grid.m_cols );
+                int64_t row0 = cellOf( aBox.GetY(), grid.m_origin.y, grid.m_rows );
+                int64_t row1 = cellOf( boxEnd.y, grid.m_origin.y, grid.m_rows );
+
+                auto cellLess =
+                        []( const std::pair<int64_t, JOINT*>& a, int64_t b )
+                        {
+                            return a.first < b;
+                        };
+
+                for( int64_t row = row0; row <= row1; ++row )
+                {
+                    auto it = std::lower_bound( grid.m_cells.begin(), grid.m_cells.end(),
+                                                row * grid.m_cols + col0, cellLess );
+
+                    for( ; it != grid.m_cells.end() && it->first <= row * grid.m_cols + col1; ++it )
+                    {
+                        JOINT* joint = it->second;
+
+                        if( aSkipOverrides && Overrides( joint ) )
+                            continue;
+
+                        if( !joint->Layers().Overlaps( aLayerMask ) )
+                            continue;
+
+                        if( aBox.Contains( joint->Pos() ) && joint->LinkCount( aKindMask ) )
+                        {
+                            aJoints.push_back( joint );
+                            n++;
+                        }
+                    }
+                }
+            };
+
+    if( isRoot() )
+    {
+        queryGrid( this, false );
+        return n;
+    }
+
+    // Branches only hold the few joints they changed
     for( JOINT_MAP::value_type& j : m_joints )
     {
         if( !j.second.Layers().Overlaps( aLayerMask ) )
@@ -1695,20 +1836,7 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, PNS_LAYE
         }
     }
 
-    if( isRoot() )
-        return n;
-
-    for( JOINT_MAP::value_type& j : m_root->m_joints )
-    {
-        if( !Overrides( &j.second ) && j.second.Layers().Overlaps( aLayerMask ) )
-        {
-            if( aBox.Contains( j.second.Pos() ) && j.second.LinkCount( aKindMask ) )
-            {
-                aJoints.push_back( &j.second );
-                n++;
-            }
-        }
-    }
+    queryGrid( m_root, true );
 
     return n;
 }
@@ -23,6 +23,7 @@
 #ifndef __PNS_NODE_H
 #define __PNS_NODE_H
 
+#include <algorithm>
 #include <vector>
 #include <list>
 #include <set>
@@ -296,6 +297,12 @@ public:
     int QueryColliding( const ITEM* aItem, OBSTACLES& aObstacles,
                         const COLLISION_SEARCH_OPTIONS& aOpts = COLLISION_SEARCH_OPTIONS() ) const;
 
+    /**
+     * Find the joints inside \a aBox.
+     *
+     * The joints of the root node are looked up through a grid index, so that the cost depends
+     * on the size of the box rather than on the size of the board.
+     */
     int QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints,
                      PNS_LAYER_RANGE aLayerMask = PNS_LAYER_RANGE::All(), int aKindMask = ITEM::ANY_T );
 
@@ -491,7 +498,7 @@ public:
     ///< Check if this branch contains an updated version of the m_item from the root branch.
     bool Overrides( ITEM* aItem ) const
     {
-        return m_override.find( aItem ) != m_override.end();
+        return std::binary_search( m_override.begin(), m_override.end(), aItem );
     }
 
     void FixupVirtualVias();
@@ -501,7 +508,7 @@ public:
         add( aItem, aAllowRedundant );
     }
 
-    const std::unordered_set<ITEM*>& GetOverrides() const
+    const std::vector<ITEM*>& GetOverrides() const
     {
         return m_override;
     }
@@ -539,6 +546,10 @@ private:
     void removeArcIndex( ARC* aVia );
 
     void doRemove( ITEM* aItem );
+    void addOverride( ITEM* aItem );
+
+    ///< (Re)build the grid index of m_joints if it was invalidated.
+    void updateJointGrid();
     void unlinkParent();
     void releaseChildren();
     void releaseGarbage();
@@ -570,12 +581,31 @@ private:
     JOINT_MAP       m_joints;           ///< hash table with the joints, linking the items. Joints
                                         ///< are hashed by their position, layer set and net.
 
+    /**
+     * Flat grid index over m_joints for area queries.  The joints are stored sorted by their
+     * row-major cell index, so the cells of one row of a query box are a contiguous range.
+     * Joints are held by pointer, which stays valid as long as they are not erased from
+     * m_joints; any insertion or erasure invalidates the grid.
+     */
+    struct JOINT_GRID
+    {
+        bool                                    m_valid = false;
+        VECTOR2I                                m_origin;
+        int                                     m_cellSize = 1;
+        int64_t                                 m_cols = 1;
+        int64_t                                 m_rows = 1;
+        std::vector<std::pair<int64_t, JOINT*>> m_cells;
+    };
+
+    JOINT_GRID      m_jointGrid;
+
     NODE*           m_parent;           ///< node this node was branched from
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    std::vector<ITEM*> m_override;      ///< root's items that have been changed in this node,
+                                        ///< sorted.  A flat set so that branching copies it
+                                        ///< in one go.
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
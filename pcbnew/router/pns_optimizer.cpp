@@ -23,6 +23,7 @@
 #include <geometry/shape_rect.h>
 #include <geometry/shape_simple.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "pns_arc.h"
@@ -558,21 +559,30 @@ bool OPTIMIZER::mergeFull( LINE* aLine )
 
     SHAPE_LINE_CHAIN current_path( line );
 
+    // Spans of the current step below this segment are known not to be worth merging
+    int firstSeg = 0;
+
     while( true )
     {
         int n_segs = current_path.SegmentCount();
         int max_step = n_segs - 2;
 
         if( step > max_step )
+        {
             step = max_step;
+            firstSeg = 0;
+        }
 
         if( step < 1 )
             break;
 
-        bool found_anything = mergeStep( aLine, current_path, step );
+        bool found_anything = mergeStep( aLine, current_path, step, firstSeg );
 
         if( !found_anything )
+        {
             step--;
+            firstSeg = 0;
+        }
 
         if( !step )
             break;
@@ -691,7 +701,8 @@ bool OPTIMIZER::Optimize( const LINE* aLine, LINE* aResult, LINE* aRoot )
 }
 
 
-bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step )
+bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step,
+                           int& aFirstSeg )
 {
     int n_segs = aCurrentPath.SegmentCount();
 
@@ -707,7 +718,7 @@ bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step
     DIRECTION_45 orig_end( aLine->CSegment( -1 ), is90mode );
 
 
-    for( int n = 0; n < n_segs - step; n++ )
+    for( int n = std::max( 0, aFirstSeg ); n < n_segs - step; n++ )
     {
         // Do not attempt to merge false segments that are part of an arc
         if( aCurrentPath.IsArcSegment( n )
@@ -753,6 +764,12 @@ bool OPTIMIZER::mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentPath, int step
         {
             n_segs = aCurrentPath.SegmentCount();
             aCurrentPath = *picked;
+
+            // The bypass, its collisions, the constraints and the change of corner cost of a
+            // span only depend on the span and its neighbouring segments.  The path is left
+            // untouched before segment n - 1 (which Simplify2() may merge with the bypass), so
+            // the spans of this step which were rejected there would be rejected again.
+            aFirstSeg = n - step - 2;
             return true;
         }
     }
@@ -173,7 +173,7 @@ private:
     bool mergeFull( LINE* aLine );
     bool mergeColinear( LINE* aLine );
     bool runSmartPads( LINE* aLine );
-    bool mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentLine, int step );
+    bool mergeStep( LINE* aLine, SHAPE_LINE_CHAIN& aCurrentLine, int step, int& aFirstSeg );
     bool fanoutCleanup( LINE * aLine );
     bool mergeDpSegments( DIFF_PAIR *aPair );
     bool mergeDpStep( DIFF_PAIR *aPair, bool aTryP, int step );
@@ -59,6 +59,8 @@ static ROUTER* theRouter;
 
 ROUTER::ROUTER()
 {
+    // Routers may be nested, e.g. a batch routing job run while the router tool exists
+    m_previousInstance = theRouter;
     theRouter = this;
 
     m_state = IDLE;
@@ -87,7 +89,10 @@ ROUTER* ROUTER::GetInstance()
 ROUTER::~ROUTER()
 {
     ClearWorld();
-    theRouter = nullptr;
+
+    if( theRouter == this )
+        theRouter = m_previousInstance;
+
     delete m_logger;
 }
 
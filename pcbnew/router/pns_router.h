@@ -273,6 +273,9 @@ private:
 
     wxString          m_toolStatusbarName;
     wxString          m_failureReason;
+
+    ///< Instance returned by GetInstance() before this one was created, restored on destruction
+    ROUTER*           m_previousInstance;
 };
 
 }
@@ -30,6 +30,7 @@
 
 #include "pns_line.h"
 #include "pns_linked_item.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -75,6 +76,8 @@ public:
 
     SEGMENT* Clone() const override;
 
+    PNS_POOLED_ITEM( SEGMENT )
+
     const SHAPE* Shape( int aLayer ) const override
     {
         return static_cast<const SHAPE*>( &m_seg );
@@ -19,12 +19,18 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <deque>
 #include <cassert>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <math/box2.h>
 
 #include <wx/log.h>
 
+#include <advanced_config.h>
+
 #include "pns_arc.h"
 #include "pns_line.h"
 #include "pns_node.h"
@@ -32,6 +38,7 @@
 #include "pns_walkaround.h"
 #include "pns_shove.h"
 #include "pns_solid.h"
+#include "pns_stats.h"
 #include "pns_optimizer.h"
 #include "pns_via.h"
 #include "pns_utils.h"
@@ -306,173 +313,198 @@ bool SHOVE::shoveLineFromLoneVia( const LINE& aCurLine, const LINE& aObstacleLin
 /*
  * Re-walk aObstacleLine around the given set of hulls, returning the result in aResultLine.
  */
-bool SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE& aObstacleLine, LINE& aResultLine,
-                                const HULL_SET& aHulls, bool aPermitAdjustingStart,
-                                bool aPermitAdjustingEnd )
+void SHOVE::walkLineToHullSet( int aAttempt, const LINE& aCurLine, const LINE& aObstacleLine,
+                               const HULL_SET& aHulls, bool aPermitAdjustingStart,
+                               bool aPermitAdjustingEnd, HULL_WALK& aWalk ) const
 {
     const int c_ENDPOINT_ON_HULL_THRESHOLD = 1000;
-    int attempt;
     bool permitAdjustingEndpoints = aPermitAdjustingStart || aPermitAdjustingEnd;
+    bool invertTraversal = ( aAttempt >= 2 );
+    bool clockwise = aAttempt % 2;
+    int vFirst = -1, vLast = -1;
+    SHAPE_LINE_CHAIN obs = aObstacleLine.CLine();
+    LINE l( aObstacleLine );
+    SHAPE_LINE_CHAIN path( l.CLine() );
 
-    PNS_DBG( Dbg(), BeginGroup, "shove-details", 1 );
+    aWalk.m_status = HULL_WALK_STATUS::FAILED;
 
-    for( attempt = 0; attempt < 4; attempt++ )
+    if( permitAdjustingEndpoints && l.SegmentCount() >= 1 )
     {
-        bool invertTraversal = ( attempt >= 2 );
-        bool clockwise = attempt % 2;
-        int vFirst = -1, vLast = -1;
-        SHAPE_LINE_CHAIN obs = aObstacleLine.CLine();
-        LINE l( aObstacleLine );
-        SHAPE_LINE_CHAIN path( l.CLine() );
-
-        if( permitAdjustingEndpoints && l.SegmentCount() >= 1 )
+        auto minDistP = [&]( VECTOR2I pref, int& mdist, int& minhull ) -> VECTOR2I
         {
-            auto minDistP = [&]( VECTOR2I pref, int& mdist, int& minhull ) -> VECTOR2I
+            int      min_dist = std::numeric_limits<int>::max();
+            VECTOR2I nearestP;
+
+            for( int i = 0; i < (int) aHulls.size(); i++ )
             {
-                int      min_dist = std::numeric_limits<int>::max();
-                VECTOR2I nearestP;
+                const SHAPE_LINE_CHAIN& hull =
+                        aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
+                int  dist;
+                const VECTOR2I p = hull.NearestPoint( pref, true );
 
-                for( int i = 0; i < (int) aHulls.size(); i++ )
-                {
-                    const SHAPE_LINE_CHAIN& hull =
-                            aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
-                    int  dist;
-                    const VECTOR2I p = hull.NearestPoint( pref, true );
+                if( hull.PointInside( pref ) )
+                    dist = 0;
+                else
+                    dist = ( p - pref ).EuclideanNorm();
 
-                    if( hull.PointInside( pref ) )
-                        dist = 0;
-                    else
-                        dist = ( p - pref ).EuclideanNorm();
+                if( dist < c_ENDPOINT_ON_HULL_THRESHOLD && dist < min_dist )
+                {
+                    bool reject = false;
 
-                    if( dist < c_ENDPOINT_ON_HULL_THRESHOLD && dist < min_dist )
+                    if( !reject )
                     {
-                        bool reject = false;
-
-                        if( !reject )
-                        {
-                            min_dist = dist;
-                            nearestP = p;
-                            minhull = invertTraversal ? aHulls.size() - 1 - i : i;
-                        }
+                        min_dist = dist;
+                        nearestP = p;
+                        minhull = invertTraversal ? aHulls.size() - 1 - i : i;
                     }
                 }
-                mdist = min_dist;
-                return nearestP;
-            };
-
-            int      minDist0, minDist1, minhull0, minhull1 ;
-            VECTOR2I p0 = minDistP( l.CPoint( 0 ), minDist0, minhull0 );
-            VECTOR2I p1 = minDistP( l.CLastPoint(), minDist1, minhull1 );
-
-            PNS_DBG( Dbg(), Message, wxString::Format( "mindists : %d %d hulls %d %d\n", minDist0, minDist1, minhull0, minhull1 ) );
-
-            if( minDist1 < c_ENDPOINT_ON_HULL_THRESHOLD && aPermitAdjustingEnd )
-            {
-                l.Line().Append( p1 );
-                obs = l.CLine();
-                path = l.CLine();
             }
+            mdist = min_dist;
+            return nearestP;
+        };
 
-            if( minDist0 < c_ENDPOINT_ON_HULL_THRESHOLD && aPermitAdjustingStart )
-            {
-                l.Line().Insert( 0, p0 );
-                obs = l.CLine();
-                path = l.CLine();
-            }
-        }
+        int      minDist0, minDist1, minhull0, minhull1 ;
+        VECTOR2I p0 = minDistP( l.CPoint( 0 ), minDist0, minhull0 );
+        VECTOR2I p1 = minDistP( l.CLastPoint(), minDist1, minhull1 );
 
+        PNS_DBG( Dbg(), Message, wxString::Format( "mindists : %d %d hulls %d %d\n", minDist0, minDist1, minhull0, minhull1 ) );
 
-        bool failWalk = false;
+        if( minDist1 < c_ENDPOINT_ON_HULL_THRESHOLD && aPermitAdjustingEnd )
+        {
+            l.Line().Append( p1 );
+            obs = l.CLine();
+            path = l.CLine();
+        }
 
-        for( int i = 0; i < (int) aHulls.size(); i++ )
+        if( minDist0 < c_ENDPOINT_ON_HULL_THRESHOLD && aPermitAdjustingStart )
         {
-            const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
+            l.Line().Insert( 0, p0 );
+            obs = l.CLine();
+            path = l.CLine();
+        }
+    }
 
-            PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
-            PNS_DBG( Dbg(), AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
+    for( int i = 0; i < (int) aHulls.size(); i++ )
+    {
+        const SHAPE_LINE_CHAIN& hull = aHulls[invertTraversal ? aHulls.size() - 1 - i : i];
 
-            if( !l.Walkaround( hull, path, clockwise ) )
-            {
-                PNS_DBG( Dbg(), Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
-                                                           hull.Format().c_str(),
-                                                           l.CLine().Format().c_str(),
-                                                           clockwise? 1 : 0) );
+        PNS_DBG( Dbg(), AddShape, &hull, YELLOW, 10000, wxString::Format( "hull[%d]", i ) );
+        PNS_DBG( Dbg(), AddShape, &path, WHITE, l.Width(), wxString::Format( "path[%d]", i ) );
+        PNS_DBG( Dbg(), AddShape, &obs, LIGHTGRAY, aObstacleLine.Width(),  wxString::Format( "obs[%d]", i ) );
 
-                failWalk = true;
-                break;
-            }
+        if( !l.Walkaround( hull, path, clockwise ) )
+        {
+            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "Fail-Walk %s %s %d\n" ),
+                                                       hull.Format().c_str(),
+                                                       l.CLine().Format().c_str(),
+                                                       clockwise? 1 : 0) );
 
-            path.Simplify2();
-            l.SetShape( path );
+            return;
         }
 
-        if( failWalk )
-            continue;
+        path.Simplify2();
+        l.SetShape( path );
+    }
 
-        for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+    for( int i = 0; i < std::min( path.PointCount(), obs.PointCount() ); i++ )
+    {
+        if( path.CPoint( i ) != obs.CPoint( i ) )
         {
-            if( path.CPoint( i ) != obs.CPoint( i ) )
-            {
-                vFirst = i;
-                break;
-            }
+            vFirst = i;
+            break;
         }
+    }
 
-        int k = obs.PointCount() - 1;
+    int k = obs.PointCount() - 1;
 
-        for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
+    for( int i = path.PointCount() - 1; i >= 0 && k >= 0; i--, k-- )
+    {
+        if( path.CPoint( i ) != obs.CPoint( k ) )
         {
-            if( path.CPoint( i ) != obs.CPoint( k ) )
-            {
-                vLast = i;
-                break;
-            }
+            vLast = i;
+            break;
         }
+    }
 
-        if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( obs ) )
-        {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vfirst-last" ),
-                                                       attempt ) );
-            continue;
-        }
+    if( ( vFirst < 0 || vLast < 0 ) && !path.CompareGeometry( obs ) )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vfirst-last" ),
+                                                   aAttempt ) );
+        return;
+    }
 
-        if( path.CLastPoint() != obs.CLastPoint() || path.CPoint( 0 ) != obs.CPoint( 0 ) )
-        {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vend-start\n" ),
-                                                       attempt ) );
-            continue;
-        }
+    if( path.CLastPoint() != obs.CLastPoint() || path.CPoint( 0 ) != obs.CPoint( 0 ) )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail vend-start\n" ),
+                                                   aAttempt ) );
+        return;
+    }
 
-        if( !checkShoveDirection( aCurLine, aObstacleLine, l ) )
-        {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail direction-check" ),
-                                                       attempt ) );
-            aResultLine.SetShape( l.CLine() );
-            continue;
-        }
+    aWalk.m_line = l;
+
+    if( !checkShoveDirection( aCurLine, aObstacleLine, l ) )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail direction-check" ),
+                                                   aAttempt ) );
+        aWalk.m_status = HULL_WALK_STATUS::WRONG_DIRECTION;
+        return;
+    }
+
+    if( path.SelfIntersecting() )
+    {
+        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail self-intersect" ),
+                                                   aAttempt ) );
+        aWalk.m_status = HULL_WALK_STATUS::SELF_INTERSECTING;
+        return;
+    }
+
+    aWalk.m_status = HULL_WALK_STATUS::OK;
+}
+
+
+bool SHOVE::shoveLineToHullSet( const LINE& aCurLine, const LINE& aObstacleLine, LINE& aResultLine,
+                                const HULL_SET& aHulls, bool aPermitAdjustingStart,
+                                bool aPermitAdjustingEnd )
+{
+    const int c_ATTEMPTS = 4;
+    HULL_WALK walks[c_ATTEMPTS];
+
+    // The attempts are independent, so they can be walked concurrently and then checked in
+    // order.  Debug output can't be interleaved, so it disables this.
+    bool parallel = ADVANCED_CFG::GetCfg().m_PNSParallelShove
+                        && !( Dbg() && Dbg()->IsDebugEnabled() );
+
+    PNS_DBG( Dbg(), BeginGroup, "shove-details", 1 );
+
+    if( parallel )
+    {
+        ParallelAttempts( c_ATTEMPTS,
+                [&]( int aAttempt )
+                {
+                    walkLineToHullSet( aAttempt, aCurLine, aObstacleLine, aHulls,
+                                       aPermitAdjustingStart, aPermitAdjustingEnd,
+                                       walks[aAttempt] );
+                } );
+    }
+
+    for( int attempt = 0; attempt < c_ATTEMPTS; attempt++ )
+    {
+        HULL_WALK& walk = walks[attempt];
 
-        if( path.SelfIntersecting() )
+        if( !parallel )
         {
-            PNS_DBG( Dbg(), Message, wxString::Format( wxT( "attempt %d fail self-intersect" ),
-                                                       attempt ) );
-            continue;
+            walkLineToHullSet( attempt, aCurLine, aObstacleLine, aHulls, aPermitAdjustingStart,
+                               aPermitAdjustingEnd, walk );
         }
 
-        bool colliding = l.Collide( &aCurLine, m_currentNode, l.Layer() );
+        if( walk.m_status == HULL_WALK_STATUS::WRONG_DIRECTION )
+            aResultLine.SetShape( walk.m_line.CLine() );
 
-      #if 0
-        if(( aCurLine.Marker() & MK_HEAD ) && !colliding )
-        {
-            const JOINT* jtStart = m_currentNode->FindJoint( aCurLine.CPoint( 0 ), &aCurLine );
+        if( walk.m_status != HULL_WALK_STATUS::OK )
+            continue;
 
-            for( ITEM* item : jtStart->LinkList() )
-            {
-                if( item->Collide( &l, m_currentNode, l.Layer() ) )
-                    colliding = true;
-            }
-        }
-      #endif
+        LINE& l = walk.m_line;
+        bool  colliding = l.Collide( &aCurLine, m_currentNode, l.Layer() );
 
         if( colliding )
         {
@@ -1908,6 +1940,7 @@ SHOVE::SHOVE_STATUS SHOVE::shoveMainLoop()
         st = shoveIteration( m_iter );
 
         m_iter++;
+        STATS::Count( STATS::Get().m_shoveIterations );
 
         if( st == SH_INCOMPLETE || timeLimit.Expired() || m_iter >= iterLimit )
         {
@@ -2080,9 +2113,17 @@ void SHOVE::runOptimizer( NODE* aNode )
 
     auto iface = Router()->GetInterface();
 
+    // A line the optimizer couldn't improve comes out the same from the next pass unless the
+    // optimization of another line changed its surroundings in the meantime.  Keep the areas
+    // touched by the optimizer and, for each line found optimal, how many of them it has seen.
+    std::vector<BOX2I>                 changedAreas;
+    std::vector<std::optional<size_t>> optimalSince( m_optimizerQueue.size() );
+    const int                          proximity = aNode->GetMaxClearance() + maxWidth;
+
     for( int pass = 0; pass < n_passes; pass++ )
     {
         std::reverse( m_optimizerQueue.begin(), m_optimizerQueue.end() );
+        std::reverse( optimalSince.begin(), optimalSince.end() );
 
         PNS_DBG( Dbg(), Message, wxString::Format( wxT( "optimize %d lines, pass %d"), (int)m_optimizerQueue.size(), (int)pass ) );
 
@@ -2102,11 +2143,29 @@ void SHOVE::runOptimizer( NODE* aNode )
                     continue;
             }
 
+            BOX2I lineArea = lineToOpt.CLine().BBox();
+            lineArea.Inflate( proximity );
+
+            if( optimalSince[i]
+                    && std::none_of( changedAreas.begin() + *optimalSince[i], changedAreas.end(),
+                                     [&]( const BOX2I& aArea )
+                                     {
+                                         return aArea.Intersects( lineArea );
+                                     } ) )
+            {
+                continue;
+            }
+
             LINE optimized;
             if( optimizer.Optimize( &lineToOpt, &optimized, rootLine ) )
             {
                 assert( optimized.LinkCount() == 0 );
 
+                BOX2I changedArea = lineToOpt.CLine().BBox();
+                changedArea.Merge( optimized.CLine().BBox() );
+                changedAreas.push_back( changedArea );
+                optimalSince[i].reset();
+
                 //PNS_DBG( Dbg(), AddShape, &lineToOpt.CLine(), BLUE, 0, wxT( "shove-pre-opt" ) );
                 //if( rootLine )
                   //  PNS_DBG( Dbg(), AddItem, rootLine, RED, 0, wxT( "shove-root-opt" ) );
@@ -2116,6 +2175,10 @@ void SHOVE::runOptimizer( NODE* aNode )
 
                 //PNS_DBG( Dbg(), AddShape, &optimized.CLine(), GREEN, 0, wxT( "shove-post-opt" ) );
             }
+            else
+            {
+                optimalSince[i] = changedAreas.size();
+            }
         }
     }
 }
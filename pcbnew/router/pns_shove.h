@@ -209,10 +209,33 @@ private:
 
     bool pruneLineFromOptimizerQueue( const LINE& aLine );
 
+    ///< Outcome of one way of walking a shoved line around a hull set, before collision checks
+    enum class HULL_WALK_STATUS
+    {
+        FAILED,             ///< walk failed or the line endpoints moved
+        WRONG_DIRECTION,
+        SELF_INTERSECTING,
+        OK
+    };
+
+    struct HULL_WALK
+    {
+        HULL_WALK_STATUS m_status = HULL_WALK_STATUS::FAILED;
+        LINE             m_line;
+    };
+
     bool shoveLineToHullSet( const LINE& aCurLine, const LINE& aObstacleLine, LINE& aResultLine,
                              const HULL_SET& aHulls, bool aPermitAdjustingStart = false,
                              bool aPermitAdjustingEnd = false );
 
+    /**
+     * Walk \a aObstacleLine around \a aHulls, in the direction and order given by \a aAttempt.
+     * This is pure geometry, so that the attempts can be run concurrently.
+     */
+    void walkLineToHullSet( int aAttempt, const LINE& aCurLine, const LINE& aObstacleLine,
+                            const HULL_SET& aHulls, bool aPermitAdjustingStart,
+                            bool aPermitAdjustingEnd, HULL_WALK& aWalk ) const;
+
     NODE* reduceSpringback( const ITEM_SET& aHeadSet );
 
     bool patchTadpoleVia( ITEM* nearest, LINE& current );
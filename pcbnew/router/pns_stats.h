@@ -0,0 +1,54 @@
+/*
+ * KiRouter - a push-and-(sometimes-)shove PCB router
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PNS_STATS_H
+#define PNS_STATS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace PNS {
+
+/**
+ * Process-wide counters of the work done by the router, read by the benchmarks.
+ *
+ * The counters are relaxed atomics bumped once per branch or algorithm iteration, which is
+ * noise next to the work they count.
+ */
+struct STATS
+{
+    std::atomic<uint64_t> m_branches{ 0 };
+    std::atomic<uint64_t> m_shoveIterations{ 0 };
+    std::atomic<uint64_t> m_walkaroundIterations{ 0 };
+
+    static STATS& Get()
+    {
+        static STATS stats;
+        return stats;
+    }
+
+    static void Count( std::atomic<uint64_t>& aCounter )
+    {
+        aCounter.fetch_add( 1, std::memory_order_relaxed );
+    }
+};
+
+}
+
+#endif // PNS_STATS_H
@@ -29,8 +29,13 @@
 #include <geometry/shape_arc.h>
 #include <geometry/shape_segment.h>
 #include <math/box2.h>
+#include <thread_pool.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <memory>
+#include <thread>
 
 namespace PNS {
 
@@ -39,6 +44,7 @@ const SHAPE_LINE_CHAIN OctagonalHull( const VECTOR2I& aP0, const VECTOR2I& aSize
 {
     SHAPE_LINE_CHAIN s;
 
+    s.ReservePoints( 8 );
     s.SetClosed( true );
 
     s.Append( aP0.x - aClearance, aP0.y - aClearance + aChamfer );
@@ -85,8 +91,10 @@ const SHAPE_LINE_CHAIN ArcHull( const SHAPE_ARC& aArc, int aClearance, int aWalk
     auto line = aArc.ConvertToPolyline( ARC_LOW_DEF );
 
     SHAPE_LINE_CHAIN s;
+    s.ReservePoints( 2 * line.PointCount() + 6 );
     s.SetClosed( true );
     std::vector<VECTOR2I> reverse_line;
+    reverse_line.reserve( line.PointCount() );
 
     auto     seg = line.Segment( 0 );
     VECTOR2I dir = seg.B - seg.A;
@@ -267,6 +275,7 @@ const SHAPE_LINE_CHAIN SegmentHull ( const SHAPE_SEGMENT& aSeg, int aClearance,
 
     SHAPE_LINE_CHAIN s;
 
+    s.ReservePoints( 8 );
     s.SetClosed( true );
 
     s.Append( b + p0 + pd );
@@ -338,6 +347,7 @@ const SHAPE_LINE_CHAIN ConvexHull( const SHAPE_SIMPLE& aConvex, int aClearance )
     MoveDiagonal( topleftline, vertices, aClearance );
 
     SHAPE_LINE_CHAIN octagon;
+    octagon.ReservePoints( 8 );
     octagon.SetClosed( true );
 
     octagon.Append( *leftline.IntersectLines( bottomleftline ) );
@@ -549,4 +559,43 @@ void NodeStats( DEBUG_DECORATOR* dbg, wxString label, PNS::NODE *node )
 }
 
 
+void ParallelAttempts( int aCount, const std::function<void( int )>& aTask )
+{
+    struct JOB
+    {
+        const std::function<void( int )>* m_task;
+        int                               m_count;
+        std::atomic<int>                  m_next = 0;
+        std::atomic<int>                  m_done = 0;
+    };
+
+    auto job = std::make_shared<JOB>();
+    job->m_task = &aTask;
+    job->m_count = aCount;
+
+    // Helpers which only start once all the work is claimed return without touching aTask,
+    // which may be gone by then.
+    auto work =
+            [job]()
+            {
+                for( int i = job->m_next++; i < job->m_count; i = job->m_next++ )
+                {
+                    ( *job->m_task )( i );
+                    job->m_done++;
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    int          helpers = std::min( aCount - 1, static_cast<int>( tp.get_thread_count() ) );
+
+    for( int i = 0; i < helpers; i++ )
+        tp.detach_task( work );
+
+    work();
+
+    while( job->m_done < aCount )
+        std::this_thread::yield();
+}
+
+
 }
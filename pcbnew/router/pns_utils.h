@@ -22,6 +22,8 @@
 #ifndef __PNS_UTILS_H
 #define __PNS_UTILS_H
 
+#include <functional>
+
 #include <math/vector2d.h>
 #include <math/box2.h>
 #include <geometry/shape_line_chain.h>
@@ -70,6 +72,12 @@ const SHAPE_LINE_CHAIN BuildHullForPrimitiveShape( const SHAPE* aShape, int aCle
 
 void NodeStats( DEBUG_DECORATOR* aDbg, wxString aLabel, NODE *aNode );
 
+/**
+ * Run \a aTask for the indices 0 to \a aCount - 1 on the thread pool.  The calling thread takes
+ * part in the work, so a busy pool only makes it slower rather than stalling it.
+ */
+void ParallelAttempts( int aCount, const std::function<void( int )>& aTask );
+
 }
 
 
@@ -33,6 +33,7 @@
 #include "pns_item.h"
 #include "pns_linked_item.h"
 #include "pns_hole.h"
+#include "pns_item_pool.h"
 
 namespace PNS {
 
@@ -307,6 +308,8 @@ public:
 
     VIA* Clone() const override;
 
+    PNS_POOLED_ITEM( VIA )
+
     const SHAPE_LINE_CHAIN Hull( int aClearance = 0, int aWalkaroundThickness = 0,
                                  int aLayer = -1 ) const override;
 
@@ -30,6 +30,7 @@
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
 #include "pns_solid.h"
+#include "pns_stats.h"
 
 
 namespace PNS {
@@ -358,6 +359,7 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
             break;
 
         m_iteration++;
+        STATS::Count( STATS::Get().m_walkaroundIterations );
     }
 
 
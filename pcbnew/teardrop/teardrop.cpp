@@ -23,6 +23,8 @@
  */
 
 
+#include <unordered_set>
+
 #include <confirm.h>
 
 #include <board_design_settings.h>
@@ -31,11 +33,11 @@
 #include <zone_filler.h>
 #include <board_commit.h>
 
+#include <connectivity/connectivity_algo.h>
 #include <connectivity/connectivity_data.h>
 #include <teardrop/teardrop.h>
-#include <drc/drc_rtree.h>
 #include <geometry/shape_line_chain.h>
-#include <geometry/rtree.h>
+#include <thread_pool.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <bezier_curves.h>
 
@@ -152,24 +154,6 @@ void TEARDROP_MANAGER::createAndAddTeardropWithMask( BOARD_COMMIT& aCommit,
 }
 
 
-bool TEARDROP_MANAGER::tryCreateTrackTeardrop( BOARD_COMMIT& aCommit,
-                                               const TEARDROP_PARAMETERS& aParams,
-                                               TEARDROP_MANAGER::TEARDROP_VARIANT aTeardropVariant,
-                                               PCB_TRACK* aTrack, BOARD_ITEM* aCandidate,
-                                               const VECTOR2I& aPos )
-{
-    std::vector<VECTOR2I> points;
-
-    if( computeTeardropPolygon( aParams, points, aTrack, aCandidate, aPos ) )
-    {
-        createAndAddTeardropWithMask( aCommit, aTeardropVariant, points, aTrack );
-        return true;
-    }
-
-    return false;
-}
-
-
 void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
                                         const std::vector<BOARD_ITEM*>* dirtyPadsAndVias,
                                         const std::set<PCB_TRACK*>* dirtyTracks )
@@ -226,8 +210,6 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
     // Init parameters:
     m_tolerance = pcbIUScale.mmToIU( 0.01 );
 
-    BuildTrackCaches();
-
     // Old teardrops must be removed, to ensure a clean teardrop rebuild
     if( aForceFullUpdate )
     {
@@ -240,120 +222,188 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
         m_board->BulkRemoveStaleTeardrops( aCommit );
     }
 
-    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::shared_ptr<CONNECTIVITY_DATA>    connectivity = m_board->GetConnectivity();
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> algo = connectivity->GetConnectivityAlgo();
+    std::unordered_set<BOARD_ITEM*>       dirtyItems;
+    std::vector<PCB_TRACK*>               tracks;
 
-    for( PCB_TRACK* track : m_board->Tracks() )
+    if( aForceFullUpdate )
     {
-        if( ! ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
-            continue;
-
-        std::vector<PAD*>     connectedPads;
-        std::vector<PCB_VIA*> connectedVias;
-
-        connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
-
-        bool forceUpdate = aForceFullUpdate || dirtyTracks->contains( track );
+        for( PCB_TRACK* track : m_board->Tracks() )
+        {
+            if( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T )
+                tracks.push_back( track );
+        }
+    }
+    else
+    {
+        // Only the tracks attached to a dirty item can get a new teardrop.  Items removed by
+        // the commit are no longer known by the connectivity and are skipped.
+        std::unordered_set<PCB_TRACK*> visited;
 
-        for( PAD* pad : connectedPads )
+        auto addTrack =
+                [&]( PCB_TRACK* aTrack )
+                {
+                    if( ( aTrack->Type() == PCB_TRACE_T || aTrack->Type() == PCB_ARC_T )
+                            && visited.insert( aTrack ).second )
+                    {
+                        tracks.push_back( aTrack );
+                    }
+                };
+
+        for( PCB_TRACK* track : *dirtyTracks )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, pad ) )
-                continue;
+            if( algo->ItemExists( track ) )
+                addTrack( track );
+        }
 
-            TEARDROP_PARAMETERS& tdParams = pad->GetTeardropParams();
-            VECTOR2I padSize = pad->GetSize( track->GetLayer() );
-            int annularWidth = std::min( padSize.x, padSize.y );
+        for( BOARD_ITEM* item : *dirtyPadsAndVias )
+        {
+            BOARD_CONNECTED_ITEM* padOrVia = static_cast<BOARD_CONNECTED_ITEM*>( item );
 
-            if( !tdParams.m_Enabled )
-                continue;
+            dirtyItems.insert( item );
 
-            // Ensure a teardrop shape can be built: track width must be < teardrop width and
-            // filter width
-            if( track->GetWidth() >= tdParams.m_TdMaxWidth
-                || track->GetWidth() >= annularWidth * tdParams.m_BestWidthRatio
-                || track->GetWidth() >= annularWidth * tdParams.m_WidthtoSizeFilterRatio )
+            if( algo->ItemExists( padOrVia ) )
             {
-                continue;
+                for( PCB_TRACK* track : connectivity->GetConnectedTracks( padOrVia ) )
+                    addTrack( track );
             }
+        }
+    }
 
-            bool startHitsPad = pad->HitTest( track->GetStart(), 0, track->GetLayer() );
-            bool endHitsPad = pad->HitTest( track->GetEnd(), 0, track->GetLayer() );
-
-            // The track is entirely inside the pad; cannot create a teardrop
-            if( startHitsPad && endHitsPad )
-                continue;
-
-            // Skip case where pad and the track are within a copper zone with the same net
-            // (and the pad can be connected to the zone)
-            if( !tdParams.m_TdOnPadsInZones && areItemsInSameZone( pad, track ) )
-                continue;
-
-            tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, track, pad, pad->GetPosition() );
+    // The shapes are computed in parallel; the zones are created afterwards, in track order
+    std::vector<std::vector<PENDING_TEARDROP>> pending( tracks.size() );
 
-            // A track can be connected to pad when just crossing it. So we can create 2 teardrops,
-            // one from pad to track start point and the other to track end point.
-            // However this is acceptable only if the pad position is inside the track.
-            // Otherwise the 2 teardrop shapes can be strange (and of course incorrect
-            if( !startHitsPad && !endHitsPad && track->HitTest( pad->GetPosition() ) )
+    auto tryComputeTeardrop =
+            [&]( const TEARDROP_PARAMETERS& aParams, PCB_TRACK* aTrack, PCB_TRACK* aShape,
+                 BOARD_ITEM* aOther, std::vector<PENDING_TEARDROP>& aOutput )
             {
-                PCB_TRACK reversed( *track );
-                reversed.SetStart( track->GetEnd() );
-                reversed.SetEnd( pad->GetPosition() );
-                tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, &reversed, pad, pad->GetPosition() );
-                reversed.SetStart( track->GetStart() );
-                tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, &reversed, pad, pad->GetPosition() );
-            }
-        }
+                std::vector<VECTOR2I> points;
 
-        for( PCB_VIA* via : connectedVias )
-        {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, via ) )
-                continue;
-
-            TEARDROP_PARAMETERS tdParams = via->GetTeardropParams();
-            int                 annularWidth = via->GetWidth( track->GetLayer() );
+                if( computeTeardropPolygon( aParams, points, aShape, aOther,
+                                            aOther->GetPosition() ) )
+                {
+                    aOutput.push_back( { aTrack, std::move( points ) } );
+                }
+            };
 
-            if( !tdParams.m_Enabled )
-                continue;
+    thread_pool& tp = GetKiCadThreadPool();
 
-            // Ensure a teardrop shape can be built: track width must be < teardrop width and
-            // filter width
-            if( track->GetWidth() >= tdParams.m_TdMaxWidth
-                || track->GetWidth() >= annularWidth * tdParams.m_BestWidthRatio
-                || track->GetWidth() >= annularWidth * tdParams.m_WidthtoSizeFilterRatio )
+    tp.submit_loop( size_t( 0 ), tracks.size(),
+            [&]( size_t aIdx )
             {
-                continue;
-            }
+                PCB_TRACK*                     track = tracks[aIdx];
+                std::vector<PENDING_TEARDROP>& output = pending[aIdx];
+                std::vector<PAD*>              connectedPads;
+                std::vector<PCB_VIA*>          connectedVias;
 
-            bool startHitsVia = via->HitTest( track->GetStart() );
-            bool endHitsVia = via->HitTest( track->GetEnd() );
+                connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
 
-            // The track is entirely inside the via; cannot create a teardrop
-            if( startHitsVia && endHitsVia )
-                continue;
+                bool forceUpdate = aForceFullUpdate || dirtyTracks->contains( track );
 
+                for( PAD* pad : connectedPads )
+                {
+                    if( !forceUpdate && !dirtyItems.contains( pad ) )
+                        continue;
+
+                    TEARDROP_PARAMETERS& tdParams = pad->GetTeardropParams();
+                    VECTOR2I padSize = pad->GetSize( track->GetLayer() );
+                    int annularWidth = std::min( padSize.x, padSize.y );
+
+                    if( !tdParams.m_Enabled )
+                        continue;
+
+                    // Ensure a teardrop shape can be built: track width must be < teardrop
+                    // width and filter width
+                    if( track->GetWidth() >= tdParams.m_TdMaxWidth
+                        || track->GetWidth() >= annularWidth * tdParams.m_BestWidthRatio
+                        || track->GetWidth() >= annularWidth * tdParams.m_WidthtoSizeFilterRatio )
+                    {
+                        continue;
+                    }
+
+                    bool startHitsPad = pad->HitTest( track->GetStart(), 0, track->GetLayer() );
+                    bool endHitsPad = pad->HitTest( track->GetEnd(), 0, track->GetLayer() );
+
+                    // The track is entirely inside the pad; cannot create a teardrop
+                    if( startHitsPad && endHitsPad )
+                        continue;
+
+                    // Skip case where pad and the track are within a copper zone with the same
+                    // net (and the pad can be connected to the zone)
+                    if( !tdParams.m_TdOnPadsInZones && areItemsInSameZone( pad, track ) )
+                        continue;
+
+                    tryComputeTeardrop( tdParams, track, track, pad, output );
+
+                    // A track can be connected to pad when just crossing it. So we can create 2
+                    // teardrops, one from pad to track start point and the other to track end
+                    // point.  However this is acceptable only if the pad position is inside the
+                    // track.  Otherwise the 2 teardrop shapes can be strange (and of course
+                    // incorrect
+                    if( !startHitsPad && !endHitsPad && track->HitTest( pad->GetPosition() ) )
+                    {
+                        PCB_TRACK reversed( *track );
+                        reversed.SetStart( track->GetEnd() );
+                        reversed.SetEnd( pad->GetPosition() );
+                        tryComputeTeardrop( tdParams, track, &reversed, pad, output );
+                        reversed.SetStart( track->GetStart() );
+                        tryComputeTeardrop( tdParams, track, &reversed, pad, output );
+                    }
+                }
 
-            tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, track, via,
-                                    via->GetPosition() );
+                for( PCB_VIA* via : connectedVias )
+                {
+                    if( !forceUpdate && !dirtyItems.contains( via ) )
+                        continue;
+
+                    TEARDROP_PARAMETERS tdParams = via->GetTeardropParams();
+                    int                 annularWidth = via->GetWidth( track->GetLayer() );
+
+                    if( !tdParams.m_Enabled )
+                        continue;
+
+                    // Ensure a teardrop shape can be built: track width must be < teardrop
+                    // width and filter width
+                    if( track->GetWidth() >= tdParams.m_TdMaxWidth
+                        || track->GetWidth() >= annularWidth * tdParams.m_BestWidthRatio
+                        || track->GetWidth() >= annularWidth * tdParams.m_WidthtoSizeFilterRatio )
+                    {
+                        continue;
+                    }
+
+                    bool startHitsVia = via->HitTest( track->GetStart() );
+                    bool endHitsVia = via->HitTest( track->GetEnd() );
+
+                    // The track is entirely inside the via; cannot create a teardrop
+                    if( startHitsVia && endHitsVia )
+                        continue;
+
+                    tryComputeTeardrop( tdParams, track, track, via, output );
+
+                    // A track can be connected to via when just crossing it. So we can create 2
+                    // teardrops, one from via to track start point and the other to track end
+                    // point.  However this is acceptable only if the via position is inside the
+                    // track.  Otherwise the 2 teardrop shapes can be strange (and of course
+                    // incorrect
+                    if( !startHitsVia && !endHitsVia && track->HitTest( via->GetPosition() ) )
+                    {
+                        PCB_TRACK reversed( *track );
+                        reversed.SetStart( track->GetEnd() );
+                        reversed.SetEnd( via->GetPosition() );
+                        tryComputeTeardrop( tdParams, track, &reversed, via, output );
+                        reversed.SetStart( track->GetStart() );
+                        tryComputeTeardrop( tdParams, track, &reversed, via, output );
+                    }
+                }
+            } ).wait();
 
-            // A track can be connected to via when just crossing it. So we can create 2 teardrops,
-            // one from via to track start point and the other to track end point.
-            // However this is acceptable only if the via position is inside the track.
-            // Otherwise the 2 teardrop shapes can be strange (and of course incorrect
-            if( !startHitsVia && !endHitsVia && track->HitTest( via->GetPosition() ) )
-            {
-                PCB_TRACK reversed( *track );
-                reversed.SetStart( track->GetEnd() );
-                reversed.SetEnd( via->GetPosition() );
-                tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, &reversed, via, via->GetPosition() );
-                reversed.SetStart( track->GetStart() );
-                tryCreateTrackTeardrop( aCommit, tdParams, TEARDROP_MANAGER::TD_TYPE_PADVIA, &reversed, via, via->GetPosition() );
-            }
-        }
-    }
+    addPendingTeardrops( aCommit, TEARDROP_MANAGER::TD_TYPE_PADVIA, pending );
 
     if( ( aForceFullUpdate || !dirtyTracks->empty() )
         && m_prmsList->GetParameters( TARGET_TRACK )->m_Enabled )
     {
+        BuildTrackCaches( aForceFullUpdate ? nullptr : dirtyTracks );
         AddTeardropsOnTracks( aCommit, dirtyTracks, aForceFullUpdate );
     }
 
@@ -362,6 +412,19 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
 }
 
 
+void TEARDROP_MANAGER::addPendingTeardrops( BOARD_COMMIT& aCommit,
+                                            TEARDROP_VARIANT aTeardropVariant,
+                                            std::vector<std::vector<PENDING_TEARDROP>>& aPending )
+{
+    for( std::vector<PENDING_TEARDROP>& teardrops : aPending )
+    {
+        for( PENDING_TEARDROP& teardrop : teardrops )
+            createAndAddTeardropWithMask( aCommit, aTeardropVariant, teardrop.m_Points,
+                                          teardrop.m_Track );
+    }
+}
+
+
 void TEARDROP_MANAGER::DeleteTrackToTrackTeardrops( BOARD_COMMIT& aCommit )
 {
     for( ZONE* zone : m_board->Zones() )
@@ -421,102 +484,122 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     TEARDROP_PARAMETERS                params = *m_prmsList->GetParameters( TARGET_TRACK );
 
-    // Explore groups (a group is a set of tracks on the same layer and the same net):
+    // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
+    params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
+    const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
+
+    // Groups (a group is a set of tracks on the same layer and the same net) are independent,
+    // so they are explored in parallel and the teardrops created afterwards.
+    std::vector<std::vector<PCB_TRACK*>*> groups;
+
     for( auto& grp : m_trackLookupList.GetBuffer() )
-    {
-        int layer, netcode;
-        TRACK_BUFFER::GetNetcodeAndLayerFromIndex( grp.first, &layer, &netcode );
+        groups.push_back( grp.second );
 
-        std::vector<PCB_TRACK*>* sublist = grp.second;
+    std::vector<std::vector<PENDING_TEARDROP>> pending( groups.size() );
+    thread_pool&                               tp = GetKiCadThreadPool();
 
-        if( sublist->size() <= 1 )  // We need at least 2 track segments
-            continue;
+    tp.submit_loop( size_t( 0 ), groups.size(),
+            [&]( size_t aIdx )
+            {
+                exploreTrackGroup( params, th, *groups[aIdx], aTracks, aForceFullUpdate,
+                                   pending[aIdx] );
+            } ).wait();
 
-        // The sort function to sort by increasing track widths
-        struct
-        {
-            bool operator()(PCB_TRACK* a, PCB_TRACK* b) const
-                { return a->GetWidth() < b->GetWidth(); }
-        } compareLess;
+    addPendingTeardrops( aCommit, TEARDROP_MANAGER::TD_TYPE_TRACKEND, pending );
+}
 
-        std::sort( sublist->begin(), sublist->end(), compareLess );
-        int min_width = sublist->front()->GetWidth();
-        int max_width = sublist->back()->GetWidth();
 
-        // Skip groups having the same track thickness
-        if( max_width == min_width )
-            continue;
+void TEARDROP_MANAGER::exploreTrackGroup( const TEARDROP_PARAMETERS& aParams, double aThreshold,
+                                          std::vector<PCB_TRACK*>& aGroup,
+                                          const std::set<PCB_TRACK*>* aTracks,
+                                          bool aForceFullUpdate,
+                                          std::vector<PENDING_TEARDROP>& aOutput ) const
+{
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
-        for( unsigned ii = 0; ii < sublist->size()-1; ii++ )
-        {
-            PCB_TRACK* track = (*sublist)[ii];
-            int        track_len = (int) track->GetLength();
-            bool       track_needs_update = aForceFullUpdate || alg::contains( *aTracks, track );
-            min_width = track->GetWidth();
+    if( aGroup.size() <= 1 )  // We need at least 2 track segments
+        return;
 
-            // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
-            params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
-            const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
-            min_width = KiROUND( min_width * th );
+    // The sort function to sort by increasing track widths
+    struct
+    {
+        bool operator()(PCB_TRACK* a, PCB_TRACK* b) const
+            { return a->GetWidth() < b->GetWidth(); }
+    } compareLess;
 
-            for( unsigned jj = ii+1; jj < sublist->size(); jj++ )
-            {
-                // Search candidates with thickness > curr thickness
-                PCB_TRACK* candidate = (*sublist)[jj];
+    std::sort( aGroup.begin(), aGroup.end(), compareLess );
+    int min_width = aGroup.front()->GetWidth();
+    int max_width = aGroup.back()->GetWidth();
 
-                if( min_width >= candidate->GetWidth() )
-                    continue;
+    // Skip groups having the same track thickness
+    if( max_width == min_width )
+        return;
 
-                // Cannot build a teardrop on a too short track segment.
-                // The min len is > candidate radius
-                if( track_len <= candidate->GetWidth() /2 )
-                    continue;
+    for( unsigned ii = 0; ii < aGroup.size()-1; ii++ )
+    {
+        PCB_TRACK* track = aGroup[ii];
+        int        track_len = (int) track->GetLength();
+        bool       track_needs_update = aForceFullUpdate || alg::contains( *aTracks, track );
+        min_width = KiROUND( track->GetWidth() * aThreshold );
 
-                // Now test end to end connection:
-                EDA_ITEM_FLAGS match_points;    // to return the end point EDA_ITEM_FLAGS:
-                                                // 0, STARTPOINT, ENDPOINT
+        for( unsigned jj = ii+1; jj < aGroup.size(); jj++ )
+        {
+            // Search candidates with thickness > curr thickness
+            PCB_TRACK* candidate = aGroup[jj];
 
-                VECTOR2I pos = candidate->GetStart();
-                match_points = track->IsPointOnEnds( pos, m_tolerance );
+            if( min_width >= candidate->GetWidth() )
+                continue;
 
-                if( !match_points )
-                {
-                    pos = candidate->GetEnd();
-                    match_points = track->IsPointOnEnds( pos, m_tolerance );
-                }
+            // Cannot build a teardrop on a too short track segment.
+            // The min len is > candidate radius
+            if( track_len <= candidate->GetWidth() /2 )
+                continue;
 
-                if( !match_points )
-                    continue;
+            // Now test end to end connection:
+            EDA_ITEM_FLAGS match_points;    // to return the end point EDA_ITEM_FLAGS:
+                                            // 0, STARTPOINT, ENDPOINT
 
-                if( !track_needs_update && alg::contains( *aTracks, candidate ) )
-                    continue;
+            VECTOR2I pos = candidate->GetStart();
+            match_points = track->IsPointOnEnds( pos, m_tolerance );
 
-                // Pads/vias have priority for teardrops; ensure there isn't one at our position
-                bool                  existingPadOrVia = false;
-                std::vector<PAD*>     connectedPads;
-                std::vector<PCB_VIA*> connectedVias;
+            if( !match_points )
+            {
+                pos = candidate->GetEnd();
+                match_points = track->IsPointOnEnds( pos, m_tolerance );
+            }
 
-                connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
+            if( !match_points )
+                continue;
 
-                for( PAD* pad : connectedPads )
-                {
-                    if( pad->HitTest( pos ) )
-                        existingPadOrVia = true;
-                }
+            if( !track_needs_update && alg::contains( *aTracks, candidate ) )
+                continue;
 
-                for( PCB_VIA* via : connectedVias )
-                {
-                    if( via->HitTest( pos ) )
-                        existingPadOrVia = true;
-                }
+            // Pads/vias have priority for teardrops; ensure there isn't one at our position
+            bool                  existingPadOrVia = false;
+            std::vector<PAD*>     connectedPads;
+            std::vector<PCB_VIA*> connectedVias;
 
-                if( existingPadOrVia )
-                    continue;
+            connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
 
-                tryCreateTrackTeardrop( aCommit, params, TEARDROP_MANAGER::TD_TYPE_TRACKEND, track, candidate, pos );
+            for( PAD* pad : connectedPads )
+            {
+                if( pad->HitTest( pos ) )
+                    existingPadOrVia = true;
+            }
+
+            for( PCB_VIA* via : connectedVias )
+            {
+                if( via->HitTest( pos ) )
+                    existingPadOrVia = true;
             }
+
+            if( existingPadOrVia )
+                continue;
+
+            std::vector<VECTOR2I> points;
+
+            if( computeTeardropPolygon( aParams, points, track, candidate, pos ) )
+                aOutput.push_back( { track, std::move( points ) } );
         }
     }
 }
-
-
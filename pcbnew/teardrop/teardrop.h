@@ -31,7 +31,6 @@
 #include <pad.h>
 #include <pcb_track.h>
 #include <zone.h>
-#include <drc/drc_rtree.h>
 #include "teardrop_parameters.h"
 
 
@@ -41,6 +40,16 @@ class TRACK_BUFFER
 public:
     TRACK_BUFFER() {}
 
+    ~TRACK_BUFFER() { Clear(); }
+
+    void Clear()
+    {
+        for( auto& [idx, tracks] : m_map_tracks )
+            delete tracks;
+
+        m_map_tracks.clear();
+    }
+
     /**
      * Add a track in buffer, in space grouping tracks having the same netcode and the same layer
      */
@@ -129,7 +138,13 @@ public:
     static int GetWidth( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer );
     static bool IsRound( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer );
 
-    void BuildTrackCaches();
+    /**
+     * Group the tracks by layer and net for the track to track teardrops.
+     *
+     * @param aDirtyTracks if not null, only the groups containing one of these tracks are
+     *                     built, as no other group can get a new teardrop.
+     */
+    void BuildTrackCaches( const std::set<PCB_TRACK*>* aDirtyTracks = nullptr );
 
 private:
     /**
@@ -192,10 +207,11 @@ private:
      * @param aMatchType returns the end point id 0, STARTPOINT, ENDPOINT
      * @param aTrackRef is the reference track
      * @param aEndpoint is the coordinate to test
-     * @param tracksRTree is an RTree containing the available tracks
+     * @param aOther is the via/pad/track the teardrop is built on.  Its connected tracks are
+     *               used when \a aTrackRef is a temporary copy unknown to the connectivity
      */
     PCB_TRACK* findTouchingTrack( EDA_ITEM_FLAGS& aMatchType, PCB_TRACK* aTrackRef,
-                                  const VECTOR2I& aEndPoint ) const;
+                                  const VECTOR2I& aEndPoint, BOARD_ITEM* aOther ) const;
 
     /**
      * Creates a teardrop (a ZONE item) from its polygonal shape, track netcode and layer
@@ -221,18 +237,30 @@ private:
                                        std::vector<VECTOR2I>& aPoints, PCB_TRACK* aTrack );
 
     /**
-     * Attempts to create a track-to-track teardrop
-     * @param aCommit the board commit to add the teardrop to
-     * @param aParams the teardrop parameters
-     * @param aTeardropVariant = variant of the teardrop( attached to a pad, or a track end )
-     * @param aTrack the source track
-     * @param aCandidate the target item
-     * @param aPos the connection position
-     * @return true if teardrop was created successfully
+     * A teardrop shape computed before its zone is created, so that shapes can be computed
+     * on the thread pool and the board only modified from the calling thread.
+     */
+    struct PENDING_TEARDROP
+    {
+        PCB_TRACK*            m_Track;      ///< The board track, never a temporary copy
+        std::vector<VECTOR2I> m_Points;
+    };
+
+    /**
+     * Compute the track to track teardrops of one group of tracks (same layer and net).
+     * Thread safe: only \a aGroup (sorted by width) and \a aOutput are modified.
+     * @param aThreshold is the minimal width ratio between the 2 tracks
+     * @param aTracks are the dirty tracks, unused if \a aForceFullUpdate is true
+     */
+    void exploreTrackGroup( const TEARDROP_PARAMETERS& aParams, double aThreshold,
+                            std::vector<PCB_TRACK*>& aGroup, const std::set<PCB_TRACK*>* aTracks,
+                            bool aForceFullUpdate, std::vector<PENDING_TEARDROP>& aOutput ) const;
+
+    /**
+     * Create the zones of \a aPending, in order.
      */
-    bool tryCreateTrackTeardrop( BOARD_COMMIT& aCommit, const TEARDROP_PARAMETERS& aParams,
-                                 TEARDROP_VARIANT aTeardropVariant, PCB_TRACK* aTrack,
-                                 BOARD_ITEM* aCandidate, const VECTOR2I& aPos );
+    void addPendingTeardrops( BOARD_COMMIT& aCommit, TEARDROP_VARIANT aTeardropVariant,
+                              std::vector<std::vector<PENDING_TEARDROP>>& aPending );
 
     /**
      * Set priority of created teardrops. smaller have bigger priority
@@ -266,7 +294,6 @@ private:
     TOOL_MANAGER*             m_toolManager;
     TEARDROP_PARAMETERS_LIST* m_prmsList;       // the teardrop parameters list, from the board design settings
 
-    DRC_RTREE                 m_tracksRTree;
     TRACK_BUFFER              m_trackLookupList;
     std::vector<ZONE*>        m_createdTdList;  // list of new created teardrops
 };
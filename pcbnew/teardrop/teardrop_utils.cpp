@@ -32,7 +32,8 @@
 #include <pad.h>
 #include <zone_filler.h>
 #include <board_commit.h>
-#include <drc/drc_rtree.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
 
 #include "teardrop.h"
 #include <geometry/convex_hull.h>
@@ -100,15 +101,27 @@ bool TEARDROP_MANAGER::IsRound( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer )
 }
 
 
-void TEARDROP_MANAGER::BuildTrackCaches()
+void TEARDROP_MANAGER::BuildTrackCaches( const std::set<PCB_TRACK*>* aDirtyTracks )
 {
+    m_trackLookupList.Clear();
+
+    std::set<std::pair<int, int>> dirtyGroups;
+
+    if( aDirtyTracks )
+    {
+        for( PCB_TRACK* track : *aDirtyTracks )
+            dirtyGroups.emplace( track->GetLayer(), track->GetNetCode() );
+    }
+
     for( PCB_TRACK* track : m_board->Tracks() )
     {
-        if( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T )
-        {
-            m_tracksRTree.Insert( track, track->GetLayer() );
-            m_trackLookupList.AddTrack( track, track->GetLayer(), track->GetNetCode() );
-        }
+        if( track->Type() != PCB_TRACE_T && track->Type() != PCB_ARC_T )
+            continue;
+
+        if( aDirtyTracks && !dirtyGroups.contains( { track->GetLayer(), track->GetNetCode() } ) )
+            continue;
+
+        m_trackLookupList.AddTrack( track, track->GetLayer(), track->GetNetCode() );
     }
 }
 
@@ -151,44 +164,65 @@ bool TEARDROP_MANAGER::areItemsInSameZone( BOARD_ITEM* aPadOrVia, PCB_TRACK* aTr
 
 
 PCB_TRACK* TEARDROP_MANAGER::findTouchingTrack( EDA_ITEM_FLAGS& aMatchType, PCB_TRACK* aTrackRef,
-                                                const VECTOR2I& aEndPoint ) const
+                                                const VECTOR2I& aEndPoint, BOARD_ITEM* aOther ) const
 {
-    int matches = 0;                    // Count of candidates: only 1 is acceptable
-    PCB_TRACK* candidate = nullptr;     // a reference to the track connected
+    std::shared_ptr<CONNECTIVITY_DATA>    connectivity = m_board->GetConnectivity();
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> algo = connectivity->GetConnectivityAlgo();
+    std::vector<PCB_TRACK*>               neighbours;
 
-    m_tracksRTree.QueryColliding( aTrackRef, aTrackRef->GetLayer(), aTrackRef->GetLayer(),
-            // Filter:
-            [&]( BOARD_ITEM* trackItem ) -> bool
-            {
-                return trackItem != aTrackRef;
-            },
-            // Visitor
-            [&]( BOARD_ITEM* trackItem ) -> bool
+    // Only the tracks connected to aTrackRef can touch its end.  ItemExists() is checked
+    // first, as this is called from worker threads and the lookup must not insert anything.
+    if( algo->ItemExists( aTrackRef ) )
+    {
+        neighbours = connectivity->GetConnectedTracks( aTrackRef );
+    }
+    else if( aOther && algo->ItemExists( static_cast<BOARD_CONNECTED_ITEM*>( aOther ) ) )
+    {
+        // aTrackRef is a temporary part of a track crossing aOther: the tracks touching it
+        // are those of the board track it comes from, itself connected to aOther
+        for( PCB_TRACK* track :
+             connectivity->GetConnectedTracks( static_cast<BOARD_CONNECTED_ITEM*>( aOther ) ) )
+        {
+            neighbours.push_back( track );
+
+            if( algo->ItemExists( track ) )
             {
-                PCB_TRACK* curr_track = static_cast<PCB_TRACK*>( trackItem );
+                for( PCB_TRACK* next : connectivity->GetConnectedTracks( track ) )
+                    neighbours.push_back( next );
+            }
+        }
+    }
 
-                // IsPointOnEnds() returns 0, EDA_ITEM_FLAGS::STARTPOINT or EDA_ITEM_FLAGS::ENDPOINT
-                if( EDA_ITEM_FLAGS match = curr_track->IsPointOnEnds( aEndPoint, m_tolerance ) )
-                {
-                    // if faced with a Y junction, choose the track longest segment as candidate
-                    matches++;
+    int matches = 0;                    // Count of candidates: only 1 is acceptable
+    PCB_TRACK* candidate = nullptr;     // a reference to the track connected
 
-                    if( matches > 1 )
-                    {
-                        double previous_len = candidate->GetLength();
-                        double curr_len = curr_track->GetLength();
+    for( PCB_TRACK* curr_track : neighbours )
+    {
+        if( curr_track == aTrackRef || curr_track == candidate || curr_track->Type() == PCB_VIA_T
+                || curr_track->GetLayer() != aTrackRef->GetLayer() )
+        {
+            continue;
+        }
 
-                        if( previous_len >= curr_len )
-                            return true;
-                    }
+        // IsPointOnEnds() returns 0, EDA_ITEM_FLAGS::STARTPOINT or EDA_ITEM_FLAGS::ENDPOINT
+        if( EDA_ITEM_FLAGS match = curr_track->IsPointOnEnds( aEndPoint, m_tolerance ) )
+        {
+            // if faced with a Y junction, choose the track longest segment as candidate
+            matches++;
 
-                    aMatchType = match;
-                    candidate = curr_track;
-                }
+            if( matches > 1 )
+            {
+                double previous_len = candidate->GetLength();
+                double curr_len = curr_track->GetLength();
 
-                return true;
-            },
-            0 );
+                if( previous_len >= curr_len )
+                    continue;
+            }
+
+            aMatchType = match;
+            candidate = curr_track;
+        }
+    }
 
     return candidate;
 }
@@ -592,7 +626,7 @@ bool TEARDROP_MANAGER::findAnchorPointsOnTrack( const TEARDROP_PARAMETERS& aPara
         {
             EDA_ITEM_FLAGS matchType;
 
-            PCB_TRACK* connected_track = findTouchingTrack( matchType, aTrack, end );
+            PCB_TRACK* connected_track = findTouchingTrack( matchType, aTrack, end, aOther );
 
             if( connected_track == nullptr )
                 break;
@@ -166,13 +166,13 @@ std::unique_ptr<DRC_ENGINE> BOARD_INSPECTION_TOOL::makeDRCEngine( bool* aCompile
     for( ZONE* zone : m_frame->GetBoard()->Zones() )
         zone->CacheBoundingBox();
 
+    FOOTPRINT::EnsureCourtyardCaches( m_frame->GetBoard()->Footprints() );
+
     for( FOOTPRINT* footprint : m_frame->GetBoard()->Footprints() )
     {
         for( ZONE* zone : footprint->Zones() )
             zone->CacheBoundingBox();
 
-        footprint->BuildCourtyardCaches();
-
         if( aCourtyardError && ( footprint->GetFlags() & MALFORMED_COURTYARDS ) != 0 )
             *aCourtyardError = true;
     }
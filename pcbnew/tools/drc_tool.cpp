@@ -172,13 +172,18 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
     m_drcEngine->SetProgressReporter( aProgressReporter );
 
+    // The handler runs under the engine's lock, so only collect the markers there.  They are
+    // staged together once the providers are done, which keeps runs producing a huge number
+    // of violations from serializing the providers on the commit bookkeeping.
+    std::vector<PCB_MARKER*> markers;
+
     m_drcEngine->SetViolationHandler(
             [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
                  const std::function<void( PCB_MARKER* )>& aPathGenerator )
             {
                 PCB_MARKER* marker = new PCB_MARKER( aItem, aPos, aLayer );
                 aPathGenerator( marker );
-                commit.Add( marker );
+                markers.push_back( marker );
             } );
 
     m_drcEngine->RunTests( m_editFrame->GetUserUnits(), aReportAllTrackErrors, aTestFootprints,
@@ -187,6 +192,9 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
     m_drcEngine->SetProgressReporter( nullptr );
     m_drcEngine->ClearViolationHandler();
 
+    for( PCB_MARKER* marker : markers )
+        commit.Add( marker );
+
     if( m_drcDialog )
     {
         m_drcDialog->SetDrcRun();
@@ -203,6 +211,59 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
     // update the m_drcDialog listboxes
     updatePointers( aProgressReporter->IsCancelled() );
+
+    // The full run has tested everything changed so far.
+    m_dirtyItems.clear();
+}
+
+
+int DRC_TOOL::RunIncrementalTests( const TOOL_EVENT& aEvent )
+{
+    if( m_drcRunning || m_dirtyItems.empty() )
+        return 0;
+
+    std::set<KIID>                          dirtyItems = std::move( m_dirtyItems );
+    std::vector<std::shared_ptr<DRC_ITEM>>  staleViolations;
+    BOARD_COMMIT                            commit( m_editFrame );
+
+    m_dirtyItems.clear();
+    m_drcRunning = true;
+
+    m_drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                 const std::function<void( PCB_MARKER* )>& aPathGenerator )
+            {
+                PCB_MARKER* marker = new PCB_MARKER( aItem, aPos, aLayer );
+                aPathGenerator( marker );
+                commit.Add( marker );
+            } );
+
+    bool updated = m_drcEngine->RunIncrementalTests( userUnits(), dirtyItems, staleViolations );
+
+    m_drcEngine->ClearViolationHandler();
+
+    if( updated )
+    {
+        std::set<const RC_ITEM*> stale;
+
+        for( const std::shared_ptr<DRC_ITEM>& violation : staleViolations )
+            stale.insert( violation.get() );
+
+        for( PCB_MARKER* marker : m_pcb->Markers() )
+        {
+            if( stale.count( marker->GetRCItem().get() ) )
+                commit.Remove( marker );
+        }
+
+        commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
+    }
+
+    m_drcRunning = false;
+
+    if( updated )
+        updatePointers( false );
+
+    return 0;
 }
 
 
@@ -392,6 +453,7 @@ void DRC_TOOL::FixDRCError( const std::shared_ptr<RC_ITEM>& aDRCItem )
 void DRC_TOOL::setTransitions()
 {
     Go( &DRC_TOOL::ShowDRCDialog,              PCB_ACTIONS::runDRC.MakeEvent() );
+    Go( &DRC_TOOL::RunIncrementalTests,        PCB_ACTIONS::runIncrementalDRC.MakeEvent() );
     Go( &DRC_TOOL::PrevMarker,                 ACTIONS::prevMarker.MakeEvent() );
     Go( &DRC_TOOL::NextMarker,                 ACTIONS::nextMarker.MakeEvent() );
     Go( &DRC_TOOL::ExcludeMarker,              ACTIONS::excludeMarker.MakeEvent() );
@@ -30,6 +30,7 @@
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
 #include <memory>
+#include <set>
 #include <vector>
 #include <tools/pcb_tool_base.h>
 
@@ -85,6 +86,19 @@ public:
     void RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones,
                    bool aReportAllTrackErrors, bool aTestFootprints );
 
+    /**
+     * Add \a aItems to the items to re-test by the next incremental DRC run.
+     */
+    void DirtyItems( const std::set<KIID>& aItems )
+    {
+        m_dirtyItems.insert( aItems.begin(), aItems.end() );
+    }
+
+    /**
+     * Re-test the dirty items and update the markers of the last DRC run.
+     */
+    int RunIncrementalTests( const TOOL_EVENT& aEvent );
+
     int PrevMarker( const TOOL_EVENT& aEvent );
     int NextMarker( const TOOL_EVENT& aEvent );
     int CrossProbe( const TOOL_EVENT& aEvent );
@@ -117,6 +131,7 @@ private:
     DIALOG_DRC*                 m_drcDialog;
     bool                        m_drcRunning;
     std::shared_ptr<DRC_ENGINE> m_drcEngine;
+    std::set<KIID>              m_dirtyItems;
 };
 
 
@@ -52,6 +52,7 @@
 #include <wx/log.h>
 #include <wx/richmsgdlg.h>
 #include <pgm_base.h>
+#include <thread_pool.h>
 
 
 #define MULTICHANNEL_EXTRA_DEBUG
@@ -554,16 +555,28 @@ int MULTICHANNEL_TOOL::CheckRACompatibility( ZONE *aRefZone )
 
     m_areas.m_compatMap.clear();
 
+    std::vector<RULE_AREA*> targets;
+
     for( RULE_AREA& ra : m_areas.m_areas )
     {
         if( ra.m_zone == m_areas.m_refRA->m_zone )
             continue;
 
         m_areas.m_compatMap[&ra] = RULE_AREA_COMPAT_DATA();
-
-        resolveConnectionTopology( m_areas.m_refRA, &ra, m_areas.m_compatMap[&ra] );
+        targets.push_back( &ra );
     }
 
+    // Each channel is matched against the reference on its own: the graphs are built per call
+    // and the board is only read, so the channels can be matched in parallel.
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.submit_loop( size_t( 0 ), targets.size(),
+            [&]( size_t aIdx )
+            {
+                resolveConnectionTopology( m_areas.m_refRA, targets[aIdx],
+                                           m_areas.m_compatMap.at( targets[aIdx] ) );
+            } ).wait();
+
     return 0;
 }
 
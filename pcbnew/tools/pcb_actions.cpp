@@ -464,6 +464,10 @@ TOOL_ACTION PCB_ACTIONS::runDRC( TOOL_ACTION_ARGS()
         .Tooltip( _( "Show the design rules checker window" ) )
         .Icon( BITMAPS::erc ) );
 
+TOOL_ACTION PCB_ACTIONS::runIncrementalDRC( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.DRCTool.runIncrementalDRC" )
+        .Scope( AS_CONTEXT ) );
+
 // PCB_DESIGN_BLOCK_CONTROL
 TOOL_ACTION PCB_ACTIONS::placeDesignBlock( TOOL_ACTION_ARGS()
         .Name( "pcbnew.InteractiveDrawing.placeDesignBlock" )
@@ -2476,6 +2480,16 @@ TOOL_ACTION PCB_ACTIONS::autoplaceOffboardComponents( TOOL_ACTION_ARGS()
         .FriendlyName( _( "Place Off-Board Footprints" ) )
         .Tooltip( _( "Performs automatic placement of components outside board area" ) ) );
 
+
+// PCB_OLLAMA_AGENT_TOOL
+//
+TOOL_ACTION PCB_ACTIONS::ollamaAgentRequest( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.OllamaAgentTool.request" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Ollama Agent Request" ) )
+        .Tooltip( _( "Send a request to the Ollama AI agent" ) )
+        .Icon( BITMAPS::tools ) );
+
 TOOL_ACTION PCB_ACTIONS::generatePlacementRuleAreas( TOOL_ACTION_ARGS()
         .Name( "pcbnew.Multichannel.generatePlacementRuleAreas" )
         .Scope( AS_GLOBAL )
@@ -459,6 +459,7 @@ public:
     static TOOL_ACTION removeUnusedPads;
 
     static TOOL_ACTION runDRC;
+    static TOOL_ACTION runIncrementalDRC;
 
     static TOOL_ACTION editFpInFpEditor;
     static TOOL_ACTION editLibFpInFpEditor;
@@ -599,6 +600,9 @@ public:
     static TOOL_ACTION autoplaceOffboardComponents;
     static TOOL_ACTION autoplaceSelectedComponents;
 
+    // Ollama agent
+    static TOOL_ACTION ollamaAgentRequest;
+
     // convert tool
     static TOOL_ACTION convertToPoly;
     static TOOL_ACTION convertToZone;
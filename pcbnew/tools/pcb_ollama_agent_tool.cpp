@@ -0,0 +1,1015 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pcb_ollama_agent_tool.h"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+
+#include <wx/log.h>
+#include <wx/tokenzr.h>
+
+#include <board.h>
+#include <board_commit.h>
+#include <board_design_settings.h>
+#include <confirm.h>
+#include <connectivity/connectivity_data.h>
+#include <core/profile.h>
+#include <dialogs/dialog_text_entry.h>
+#include <footprint.h>
+#include <geometry/packed_rtree.h>
+#include <geometry/shape.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_edit_frame.h>
+#include <pcb_free_area_finder.h>
+#include <pcb_marker.h>
+#include <pcb_track.h>
+#include <pcbnew_settings.h>
+#include <ratsnest/ratsnest_data.h>
+#include <rc_item.h>
+#include <tool/tool_manager.h>
+#include <tools/pcb_actions.h>
+#include <trace_helpers.h>
+
+using json = nlohmann::json;
+
+
+static wxString toMM( int aValue )
+{
+    return wxString::Format( wxS( "%.3f" ), pcbIUScale.IUTomm( aValue ) );
+}
+
+
+static wxString describeItem( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_PAD_T:
+    {
+        const PAD* pad = static_cast<const PAD*>( aItem );
+
+        if( const FOOTPRINT* fp = pad->GetParentFootprint() )
+            return fp->GetReference() + wxS( "." ) + pad->GetNumber();
+
+        return wxS( "pad " ) + pad->GetNumber();
+    }
+
+    case PCB_VIA_T:
+        return wxS( "via on " ) + static_cast<const PCB_VIA*>( aItem )->GetNetname();
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+        return wxS( "track on " ) + static_cast<const PCB_TRACK*>( aItem )->GetNetname();
+
+    case PCB_FOOTPRINT_T:
+        return static_cast<const FOOTPRINT*>( aItem )->GetReference();
+
+    default:
+        return aItem->GetClass();
+    }
+}
+
+
+PCB_OLLAMA_AGENT_TOOL::PCB_OLLAMA_AGENT_TOOL() :
+        PCB_TOOL_BASE( "pcbnew.OllamaAgentTool" ),
+        m_model( wxS( "qwen3:4b" ) ),
+        m_lastProblems( json::array() ),
+        m_maxFeedbackTurns( 2 )
+{
+}
+
+
+PCB_OLLAMA_AGENT_TOOL::~PCB_OLLAMA_AGENT_TOOL() = default;
+
+
+void PCB_OLLAMA_AGENT_TOOL::Reset( RESET_REASON aReason )
+{
+    if( aReason == MODEL_RELOAD )
+    {
+        m_freeArea.reset();
+        m_planItems.clear();
+        m_lastProblems = json::array();
+    }
+}
+
+
+OLLAMA_CLIENT* PCB_OLLAMA_AGENT_TOOL::GetOllama()
+{
+    if( !m_ollama )
+    {
+        try
+        {
+            m_ollama = std::make_unique<OLLAMA_CLIENT>();
+        }
+        catch( ... )
+        {
+            return nullptr;
+        }
+    }
+
+    return m_ollama.get();
+}
+
+
+int PCB_OLLAMA_AGENT_TOOL::ProcessRequest( const TOOL_EVENT& aEvent )
+{
+    wxString userRequest;
+
+    if( aEvent.HasParameter() )
+    {
+        userRequest = aEvent.Parameter<wxString>();
+    }
+    else
+    {
+        WX_TEXT_ENTRY_DIALOG dlg( frame(), _( "Ollama Agent Request" ), _( "Enter your request:" ),
+                                  wxEmptyString );
+
+        if( dlg.ShowModal() != wxID_OK )
+            return 0;
+
+        userRequest = dlg.GetValue();
+    }
+
+    if( userRequest.IsEmpty() )
+        return 0;
+
+    if( !GetOllama() )
+    {
+        DisplayError( frame(), _( "Failed to initialize Python agent client. Please check your "
+                                  "network configuration." ) );
+        return 0;
+    }
+
+    PROF_TIMER turnTimer;
+    // The board context goes first: it changes less than the request between turns, so the
+    // server can reuse the evaluated prompt prefix
+    wxString   prompt = GetBoardContext() + wxS( "\n\n" ) + userRequest;
+    wxString   response;
+
+    if( !m_ollama->ChatCompletion( m_model, prompt, response ) )
+    {
+        DisplayError( frame(), _( "Failed to communicate with Python agent server." ) );
+        return 0;
+    }
+
+    if( !ParseAndExecute( response ) )
+    {
+        if( m_lastToolError.IsEmpty() )
+            DisplayInfoMessage( frame(), _( "Agent response received but could not parse commands." ),
+                                _( "Ollama Agent" ) );
+        else
+            DisplayError( frame(), m_lastToolError );
+
+        return 0;
+    }
+
+    for( int turn = 0; turn < m_maxFeedbackTurns && !m_lastProblems.empty(); ++turn )
+        sendFeedback( m_lastProblems );
+
+    if( !m_lastProblems.empty() )
+    {
+        frame()->ShowInfoBarWarning( wxString::Format( _( "The agent's changes left %d problem(s); "
+                                                          "run DRC for details." ),
+                                                       (int) m_lastProblems.size() ) );
+    }
+
+    wxLogTrace( traceAgentProfile, wxS( "Agent turn: %0.1f ms" ), turnTimer.msecs() );
+    return 0;
+}
+
+
+void PCB_OLLAMA_AGENT_TOOL::sendFeedback( const json& aProblems )
+{
+    wxString prompt = GetBoardContext();
+
+    prompt << wxS( "\n\n" )
+           << _( "Your last changes were applied, but checking the items around them found "
+                 "these problems. Reply with TOOL lines that fix them." )
+           << wxS( "\n" ) << wxString::FromUTF8( aProblems.dump( 1 ) );
+
+    wxString response;
+
+    // Stop asking if the model doesn't answer with anything to execute
+    if( !m_ollama->ChatCompletion( m_model, prompt, response ) || !ParseAndExecute( response ) )
+        m_lastProblems = json::array();
+}
+
+
+wxString PCB_OLLAMA_AGENT_TOOL::GetBoardContext( size_t aMaxChars )
+{
+    BOARD*   brd = board();
+    wxString out;
+
+    out << wxS( "=== BOARD ===\n" ) << wxS( "Units: mm\n" );
+
+    BOX2I edges = brd->GetBoardEdgesBoundingBox();
+
+    if( edges.GetWidth() > 0 && edges.GetHeight() > 0 )
+    {
+        out << wxS( "Outline: " ) << toMM( edges.GetLeft() ) << wxS( " " ) << toMM( edges.GetTop() )
+            << wxS( " to " ) << toMM( edges.GetRight() ) << wxS( " " ) << toMM( edges.GetBottom() )
+            << wxS( "\n" );
+    }
+
+    out << wxS( "Copper layers:" );
+
+    for( PCB_LAYER_ID layer : LSET::AllCuMask( brd->GetCopperLayerCount() ).UIOrder() )
+        out << wxS( " " ) << brd->GetLayerName( layer );
+
+    out << wxS( "\nDefault track width: " )
+        << toMM( brd->GetDesignSettings().GetCurrentTrackWidth() ) << wxS( "\n" );
+
+    out << wxS( "\n=== FOOTPRINTS (ref value footprint x y rotation side) ===\n" );
+
+    std::vector<FOOTPRINT*> footprints( brd->Footprints().begin(), brd->Footprints().end() );
+
+    std::sort( footprints.begin(), footprints.end(),
+               []( const FOOTPRINT* a, const FOOTPRINT* b )
+               {
+                   return a->GetReference() < b->GetReference();
+               } );
+
+    for( FOOTPRINT* fp : footprints )
+    {
+        out << fp->GetReference() << wxS( " \"" ) << fp->GetValue() << wxS( "\" " )
+            << fp->GetFPIDAsString() << wxS( " " ) << toMM( fp->GetPosition().x ) << wxS( " " )
+            << toMM( fp->GetPosition().y ) << wxS( " " )
+            << wxString::Format( wxS( "%.1f" ), fp->GetOrientation().AsDegrees() )
+            << ( fp->GetSide() == B_Cu ? wxS( " back\n" ) : wxS( " front\n" ) );
+
+        if( aMaxChars && out.length() > aMaxChars )
+            return out.Left( aMaxChars );
+    }
+
+    // Net membership from the pads, unrouted connections from the ratsnest
+    std::map<wxString, std::vector<wxString>> netPads;
+    std::map<wxString, int>                   netCodes;
+
+    for( FOOTPRINT* fp : footprints )
+    {
+        for( PAD* pad : fp->Pads() )
+        {
+            if( pad->GetNetCode() <= 0 )
+                continue;
+
+            netPads[pad->GetNetname()].push_back( describeItem( pad ) );
+            netCodes[pad->GetNetname()] = pad->GetNetCode();
+        }
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = brd->GetConnectivity();
+
+    out << wxS( "\n=== NETS (name: pads, unrouted connections) ===\n" );
+
+    for( const auto& [name, pads] : netPads )
+    {
+        if( pads.size() < 2 )
+            continue;
+
+        int unrouted = 0;
+
+        if( RN_NET* net = connectivity->GetRatsnestForNet( netCodes[name] ) )
+            unrouted = (int) net->GetEdges().size();
+
+        out << name << wxS( ":" );
+
+        for( const wxString& pad : pads )
+            out << wxS( " " ) << pad;
+
+        out << wxString::Format( wxS( " (unrouted %d)\n" ), unrouted );
+
+        if( aMaxChars && out.length() > aMaxChars )
+            return out.Left( aMaxChars );
+    }
+
+    return out;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::ParseAndExecute( const wxString& aResponse )
+{
+    std::vector<std::pair<wxString, wxString>> commands;
+    wxStringTokenizer                          tokenizer( aResponse, wxS( "\n" ) );
+
+    m_lastToolError.clear();
+
+    while( tokenizer.HasMoreTokens() )
+    {
+        wxString line = tokenizer.GetNextToken().Trim().Trim( false );
+
+        if( !line.Upper().StartsWith( wxS( "TOOL" ) ) )
+            continue;
+
+        wxString rest = line.Mid( 4 ).Trim( false );
+        wxString toolName = rest.BeforeFirst( ' ' ).Trim();
+        wxString payload = rest.Contains( wxS( " " ) ) ? rest.AfterFirst( ' ' ).Trim( false )
+                                                       : wxString();
+
+        if( !toolName.IsEmpty() )
+            commands.emplace_back( toolName, payload );
+    }
+
+    if( commands.empty() )
+        return false;
+
+    return RunToolBatch( commands, _( "Ollama agent operation" ) );
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::RunToolCommand( const wxString& aToolName, const wxString& aPayload )
+{
+    return RunToolBatch( { { aToolName, aPayload } }, _( "Ollama agent operation" ) );
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::RunToolBatch( const std::vector<std::pair<wxString, wxString>>& aCommands,
+                                          const wxString& aMessage )
+{
+    BOARD_COMMIT commit( this );
+    json         results = json::array();
+    PROF_TIMER   executeTimer;
+
+    m_planItems.clear();
+    m_freeArea.reset();
+    m_lastProblems = json::array();
+
+    for( size_t ii = 0; ii < aCommands.size(); ++ii )
+    {
+        const auto& [toolName, payloadText] = aCommands[ii];
+        bool        ok = false;
+
+        m_lastToolError.clear();
+        m_lastToolResult.clear();
+
+        try
+        {
+            json payload = payloadText.IsEmpty() ? json::object()
+                                                 : json::parse( payloadText.ToStdString() );
+
+            ok = dispatchToolCommand( toolName, payload, commit );
+        }
+        catch( const json::exception& e )
+        {
+            m_lastToolError = wxString::Format( _( "%s payload parse error: %s" ), toolName,
+                                                wxString::FromUTF8( e.what() ) );
+        }
+
+        if( !ok )
+        {
+            wxString error = m_lastToolError.IsEmpty() ? _( "Tool execution failed" )
+                                                       : m_lastToolError;
+
+            // Items added by the plan are not on the board yet, so reverting doesn't free them
+            std::vector<BOARD_ITEM*> added;
+
+            for( BOARD_ITEM* item : m_planItems )
+            {
+                if( item->IsNew() )
+                    added.push_back( item );
+            }
+
+            commit.Revert();
+
+            for( BOARD_ITEM* item : added )
+                delete item;
+
+            m_planItems.clear();
+            m_freeArea.reset();
+
+            m_lastToolResult.clear();
+            m_lastToolError = wxString::Format( _( "Step %d (%s) failed; no changes were made: %s" ),
+                                                (int) ii + 1, toolName, error );
+            wxLogWarning( wxS( "[OllamaAgent] %s" ), m_lastToolError );
+            return false;
+        }
+
+        results.push_back( m_lastToolResult.ToUTF8().data() );
+    }
+
+    wxLogTrace( traceAgentProfile, wxS( "Agent plan execution: %0.1f ms" ), executeTimer.msecs() );
+
+    if( !commit.Empty() )
+    {
+        // A single push means a single connectivity update, undo entry and redraw for the plan
+        PROF_TIMER commitTimer;
+
+        commit.Push( aMessage );
+        m_lastProblems = CheckItems( m_planItems );
+        selectItems( m_planItems );
+
+        wxLogTrace( traceAgentProfile, wxS( "Agent plan commit and check: %0.1f ms" ),
+                    commitTimer.msecs() );
+    }
+
+    m_planItems.clear();
+    m_freeArea.reset();
+
+    json out;
+    out["results"] = results;
+    out["problems"] = m_lastProblems;
+
+    m_lastToolError.clear();
+    m_lastToolResult = wxString::FromUTF8( out.dump( 2 ) );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::dispatchToolCommand( const wxString& aToolName, const json& aPayload,
+                                                 BOARD_COMMIT& aCommit )
+{
+    if( !aPayload.is_object() )
+    {
+        m_lastToolError = _( "The payload must be a JSON object." );
+        return false;
+    }
+
+    if( aToolName.CmpNoCase( wxS( "pcb.move_footprint" ) ) == 0 )
+        return handleMoveFootprint( aPayload, aCommit );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.place_footprint" ) ) == 0 )
+        return handlePlaceFootprint( aPayload, aCommit );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.rotate_footprint" ) ) == 0 )
+        return handleRotateFootprint( aPayload, aCommit );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.add_track" ) ) == 0 )
+        return handleAddTrack( aPayload, aCommit );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.connect_pads" ) ) == 0 )
+        return handleConnectPads( aPayload, aCommit );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.get_net" ) ) == 0 )
+        return handleGetNet( aPayload );
+
+    if( aToolName.CmpNoCase( wxS( "pcb.get_drc" ) ) == 0 )
+        return handleGetDrc( aPayload );
+
+    m_lastToolError = wxString::Format( _( "Unknown tool requested: %s" ), aToolName );
+    return false;
+}
+
+
+FOOTPRINT* PCB_OLLAMA_AGENT_TOOL::findFootprint( const json& aPayload, const char* aKey )
+{
+    if( !aPayload.contains( aKey ) || !aPayload[aKey].is_string() )
+    {
+        m_lastToolError = wxString::Format( _( "A \"%s\" field is required." ), aKey );
+        return nullptr;
+    }
+
+    wxString   reference = wxString::FromUTF8( aPayload[aKey].get<std::string>() );
+    FOOTPRINT* footprint = board()->FindFootprintByReference( reference.Trim().Trim( false ) );
+
+    if( !footprint )
+        m_lastToolError = wxString::Format( _( "Footprint \"%s\" not found." ), reference );
+
+    return footprint;
+}
+
+
+PCB_FREE_AREA_FINDER& PCB_OLLAMA_AGENT_TOOL::freeAreaFinder()
+{
+    if( !m_freeArea )
+        m_freeArea = std::make_unique<PCB_FREE_AREA_FINDER>( board(), pcbIUScale.mmToIU( 0.25 ) );
+
+    return *m_freeArea;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleMoveFootprint( const json& aPayload, BOARD_COMMIT& aCommit )
+{
+    FOOTPRINT* footprint = findFootprint( aPayload, "reference" );
+
+    if( !footprint )
+        return false;
+
+    if( !aPayload.contains( "x" ) || !aPayload.contains( "y" ) )
+    {
+        m_lastToolError = _( "move_footprint requires \"x\" and \"y\" fields." );
+        return false;
+    }
+
+    aCommit.Modify( footprint );
+
+    footprint->SetPosition( VECTOR2I( pcbIUScale.mmToIU( aPayload.value( "x", 0.0 ) ),
+                                      pcbIUScale.mmToIU( aPayload.value( "y", 0.0 ) ) ) );
+
+    if( aPayload.contains( "rotation" ) )
+        footprint->SetOrientation( EDA_ANGLE( aPayload.value( "rotation", 0.0 ), DEGREES_T ) );
+
+    if( aPayload.contains( "side" ) )
+    {
+        PCB_LAYER_ID side = aPayload.value( "side", "front" ) == "back" ? B_Cu : F_Cu;
+
+        if( footprint->GetSide() != side )
+            footprint->Flip( footprint->GetPosition(), frame()->GetPcbNewSettings()->m_FlipDirection );
+    }
+
+    // Boxes indexed before the move are stale now
+    m_freeArea.reset();
+    m_planItems.push_back( footprint );
+
+    m_lastToolResult = wxString::Format( wxS( "Moved %s to %s %s" ), footprint->GetReference(),
+                                         toMM( footprint->GetPosition().x ),
+                                         toMM( footprint->GetPosition().y ) );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handlePlaceFootprint( const json& aPayload, BOARD_COMMIT& aCommit )
+{
+    FOOTPRINT* footprint = findFootprint( aPayload, "reference" );
+
+    if( !footprint )
+        return false;
+
+    VECTOR2I target = footprint->GetPosition();
+
+    if( aPayload.contains( "near" ) )
+    {
+        FOOTPRINT* anchor = findFootprint( aPayload, "near" );
+
+        if( !anchor )
+            return false;
+
+        target = anchor->GetPosition();
+    }
+    else if( aPayload.contains( "x" ) && aPayload.contains( "y" ) )
+    {
+        target = VECTOR2I( pcbIUScale.mmToIU( aPayload.value( "x", 0.0 ) ),
+                           pcbIUScale.mmToIU( aPayload.value( "y", 0.0 ) ) );
+    }
+    else if( BOX2I edges = board()->GetBoardEdgesBoundingBox(); edges.GetWidth() > 0 )
+    {
+        target = edges.Centre();
+    }
+
+    PCB_FREE_AREA_FINDER& finder = freeAreaFinder();
+    BOX2I                 box = PCB_FREE_AREA_FINDER::FootprintBox( footprint );
+
+    box.Move( target - footprint->GetPosition() );
+
+    int step = std::max<int>( pcbIUScale.mmToIU( 0.5 ),
+                              std::min( box.GetWidth(), box.GetHeight() ) / 2 );
+
+    finder.IgnoreFootprint( footprint );
+
+    std::optional<VECTOR2I> offset = finder.FindNearest( box, footprint->GetSide(), step, 50 );
+
+    finder.IgnoreFootprint( nullptr );
+
+    if( !offset )
+    {
+        m_lastToolError = wxString::Format( _( "No free area found for %s." ),
+                                            footprint->GetReference() );
+        return false;
+    }
+
+    aCommit.Modify( footprint );
+    footprint->SetPosition( target + *offset );
+
+    // Later placements of the plan must avoid it.  Its box at the old position stays in the
+    // index, which only makes the search a bit more conservative.
+    finder.AddObstacle( footprint );
+    m_planItems.push_back( footprint );
+
+    m_lastToolResult = wxString::Format( wxS( "Placed %s at %s %s" ), footprint->GetReference(),
+                                         toMM( footprint->GetPosition().x ),
+                                         toMM( footprint->GetPosition().y ) );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleRotateFootprint( const json& aPayload, BOARD_COMMIT& aCommit )
+{
+    FOOTPRINT* footprint = findFootprint( aPayload, "reference" );
+
+    if( !footprint )
+        return false;
+
+    EDA_ANGLE angle( aPayload.value( "angle", 90.0 ), DEGREES_T );
+
+    aCommit.Modify( footprint );
+    footprint->Rotate( footprint->GetPosition(), angle );
+
+    m_freeArea.reset();
+    m_planItems.push_back( footprint );
+
+    m_lastToolResult = wxString::Format( wxS( "Rotated %s to %.1f degrees" ),
+                                         footprint->GetReference(),
+                                         footprint->GetOrientation().AsDegrees() );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleAddTrack( const json& aPayload, BOARD_COMMIT& aCommit )
+{
+    BOARD* brd = board();
+
+    if( !aPayload.contains( "points" ) || !aPayload["points"].is_array()
+            || aPayload["points"].size() < 2 )
+    {
+        m_lastToolError = _( "add_track requires a \"points\" array of at least two [x, y] points." );
+        return false;
+    }
+
+    NETINFO_ITEM* net = nullptr;
+
+    if( aPayload.contains( "net" ) )
+    {
+        net = brd->FindNet( wxString::FromUTF8( aPayload.value( "net", "" ) ) );
+
+        if( !net )
+        {
+            m_lastToolError = wxString::Format( _( "Net \"%s\" not found." ),
+                                                wxString::FromUTF8( aPayload.value( "net", "" ) ) );
+            return false;
+        }
+    }
+
+    PCB_LAYER_ID layer = brd->GetLayerID( wxString::FromUTF8( aPayload.value( "layer", "F.Cu" ) ) );
+
+    if( !IsCopperLayer( layer ) || !brd->IsLayerEnabled( layer ) )
+    {
+        m_lastToolError = _( "\"layer\" must name an enabled copper layer." );
+        return false;
+    }
+
+    int width = brd->GetDesignSettings().GetCurrentTrackWidth();
+
+    if( aPayload.contains( "width" ) )
+        width = pcbIUScale.mmToIU( aPayload.value( "width", 0.0 ) );
+
+    std::vector<VECTOR2I> points;
+
+    for( const json& point : aPayload["points"] )
+    {
+        if( !point.is_array() || point.size() != 2 )
+        {
+            m_lastToolError = _( "Each point must be an [x, y] array." );
+            return false;
+        }
+
+        points.emplace_back( pcbIUScale.mmToIU( point[0].get<double>() ),
+                             pcbIUScale.mmToIU( point[1].get<double>() ) );
+    }
+
+    for( size_t ii = 1; ii < points.size(); ++ii )
+    {
+        if( points[ii] == points[ii - 1] )
+            continue;
+
+        PCB_TRACK* track = new PCB_TRACK( brd );
+
+        track->SetStart( points[ii - 1] );
+        track->SetEnd( points[ii] );
+        track->SetWidth( width );
+        track->SetLayer( layer );
+
+        if( net )
+            track->SetNet( net );
+
+        aCommit.Add( track );
+        m_planItems.push_back( track );
+    }
+
+    m_lastToolResult = wxString::Format( wxS( "Added %d segment(s) on %s" ),
+                                         (int) points.size() - 1, brd->GetLayerName( layer ) );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleConnectPads( const json& aPayload, BOARD_COMMIT& aCommit )
+{
+    auto findPad =
+            [&]( const char* aKey ) -> PAD*
+            {
+                wxString name = wxString::FromUTF8( aPayload.value( aKey, "" ) );
+                wxString reference = name.BeforeLast( '.' );
+                wxString number = name.AfterLast( '.' );
+
+                if( reference.IsEmpty() )
+                {
+                    m_lastToolError = wxString::Format( _( "\"%s\" must be a pad such as \"R1.2\"." ),
+                                                        aKey );
+                    return nullptr;
+                }
+
+                FOOTPRINT* fp = board()->FindFootprintByReference( reference );
+                PAD*       pad = fp ? fp->FindPadByNumber( number ) : nullptr;
+
+                if( !pad )
+                    m_lastToolError = wxString::Format( _( "Pad \"%s\" not found." ), name );
+
+                return pad;
+            };
+
+    PAD* from = findPad( "from" );
+    PAD* to = from ? findPad( "to" ) : nullptr;
+
+    if( !from || !to )
+        return false;
+
+    if( from->GetNetCode() != to->GetNetCode() )
+    {
+        m_lastToolError = wxString::Format( _( "%s and %s are on different nets." ),
+                                            describeItem( from ), describeItem( to ) );
+        return false;
+    }
+
+    json track = aPayload;
+    track["points"] = json::array( { { pcbIUScale.IUTomm( from->GetPosition().x ),
+                                       pcbIUScale.IUTomm( from->GetPosition().y ) },
+                                     { pcbIUScale.IUTomm( to->GetPosition().x ),
+                                       pcbIUScale.IUTomm( to->GetPosition().y ) } } );
+    track["net"] = from->GetNetname().ToStdString();
+
+    if( !track.contains( "layer" ) )
+    {
+        LSET common = from->GetLayerSet() & to->GetLayerSet() & LSET::AllCuMask();
+
+        if( common.none() )
+        {
+            m_lastToolError = wxString::Format( _( "%s and %s share no copper layer." ),
+                                                describeItem( from ), describeItem( to ) );
+            return false;
+        }
+
+        track["layer"] = board()->GetLayerName( common.Seq().front() ).ToStdString();
+    }
+
+    return handleAddTrack( track, aCommit );
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleGetNet( const json& aPayload )
+{
+    wxString      name = wxString::FromUTF8( aPayload.value( "net", "" ) );
+    NETINFO_ITEM* net = board()->FindNet( name );
+
+    if( !net || net->GetNetCode() <= 0 )
+    {
+        m_lastToolError = wxString::Format( _( "Net \"%s\" not found." ), name );
+        return false;
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = board()->GetConnectivity();
+    json                               out;
+    json                               pads = json::array();
+
+    for( BOARD_CONNECTED_ITEM* item : connectivity->GetNetItems( net->GetNetCode(), { PCB_PAD_T } ) )
+    {
+        PAD* pad = static_cast<PAD*>( item );
+
+        pads.push_back( { { "pad", describeItem( pad ).ToStdString() },
+                          { "x", pcbIUScale.IUTomm( pad->GetPosition().x ) },
+                          { "y", pcbIUScale.IUTomm( pad->GetPosition().y ) } } );
+    }
+
+    json unrouted = json::array();
+
+    if( RN_NET* rnNet = connectivity->GetRatsnestForNet( net->GetNetCode() ) )
+    {
+        for( const CN_EDGE& edge : rnNet->GetEdges() )
+        {
+            if( !edge.IsVisible() )
+                continue;
+
+            unrouted.push_back( { { pcbIUScale.IUTomm( edge.GetSourcePos().x ),
+                                    pcbIUScale.IUTomm( edge.GetSourcePos().y ) },
+                                  { pcbIUScale.IUTomm( edge.GetTargetPos().x ),
+                                    pcbIUScale.IUTomm( edge.GetTargetPos().y ) } } );
+        }
+    }
+
+    out["net"] = name.ToStdString();
+    out["pads"] = pads;
+    out["unrouted"] = unrouted;
+
+    m_lastToolResult = wxString::FromUTF8( out.dump() );
+    return true;
+}
+
+
+bool PCB_OLLAMA_AGENT_TOOL::handleGetDrc( const json& aPayload )
+{
+    size_t limit = aPayload.value( "limit", 50 );
+    json   markers = json::array();
+    size_t total = 0;
+
+    for( PCB_MARKER* marker : board()->Markers() )
+    {
+        if( marker->IsExcluded() )
+            continue;
+
+        if( ++total > limit )
+            continue;
+
+        std::shared_ptr<RC_ITEM> rcItem = marker->GetRCItem();
+
+        markers.push_back( { { "error", rcItem->GetErrorMessage( false ).ToStdString() },
+                             { "x", pcbIUScale.IUTomm( marker->GetPos().x ) },
+                             { "y", pcbIUScale.IUTomm( marker->GetPos().y ) } } );
+    }
+
+    json out;
+    out["markers"] = markers;
+    out["marker_count"] = total;
+    out["last_plan_problems"] = m_lastProblems;
+
+    m_lastToolResult = wxString::FromUTF8( out.dump() );
+    return true;
+}
+
+
+json PCB_OLLAMA_AGENT_TOOL::CheckItems( const std::vector<BOARD_ITEM*>& aItems )
+{
+    BOARD* brd = board();
+    json   problems = json::array();
+
+    std::vector<FOOTPRINT*>            footprints;
+    std::vector<BOARD_CONNECTED_ITEM*> copper;
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        if( item->Type() == PCB_FOOTPRINT_T )
+        {
+            FOOTPRINT* fp = static_cast<FOOTPRINT*>( item );
+
+            if( std::find( footprints.begin(), footprints.end(), fp ) != footprints.end() )
+                continue;
+
+            footprints.push_back( fp );
+
+            for( PAD* pad : fp->Pads() )
+                copper.push_back( pad );
+        }
+        else if( item->IsConnected() )
+        {
+            copper.push_back( static_cast<BOARD_CONNECTED_ITEM*>( item ) );
+        }
+    }
+
+    if( !footprints.empty() )
+    {
+        PCB_FREE_AREA_FINDER finder( brd, 0 );
+
+        for( FOOTPRINT* fp : footprints )
+        {
+            BOX2I box = PCB_FREE_AREA_FINDER::FootprintBox( fp );
+
+            finder.IgnoreFootprint( fp );
+
+            if( !finder.InsideBoard( box ) )
+            {
+                problems.push_back( { { "type", "outside_board" },
+                                      { "item", fp->GetReference().ToStdString() } } );
+            }
+            else if( !finder.IsFree( box, fp->GetSide() ) )
+            {
+                problems.push_back( { { "type", "courtyard_overlap" },
+                                      { "item", fp->GetReference().ToStdString() } } );
+            }
+        }
+    }
+
+    if( copper.empty() )
+        return problems;
+
+    // Only the copper around the changed items is indexed
+    int   maxClearance = brd->GetDesignSettings().GetBiggestClearanceValue();
+    BOX2I region = copper.front()->GetBoundingBox();
+
+    for( BOARD_CONNECTED_ITEM* item : copper )
+        region.Merge( item->GetBoundingBox() );
+
+    region.Inflate( maxClearance );
+
+    std::map<PCB_LAYER_ID, PACKED_RTREE<BOARD_CONNECTED_ITEM*>> trees;
+    LSET boardCu = LSET::AllCuMask( brd->GetCopperLayerCount() );
+
+    auto index =
+            [&]( BOARD_CONNECTED_ITEM* aItem )
+            {
+                BOX2I bbox = aItem->GetBoundingBox();
+
+                if( !bbox.Intersects( region ) )
+                    return;
+
+                for( PCB_LAYER_ID layer : aItem->GetLayerSet() & boardCu )
+                    trees[layer].Add( bbox, aItem );
+            };
+
+    for( PCB_TRACK* track : brd->Tracks() )
+        index( track );
+
+    for( FOOTPRINT* fp : brd->Footprints() )
+    {
+        for( PAD* pad : fp->Pads() )
+            index( pad );
+    }
+
+    for( auto& [layer, tree] : trees )
+        tree.Build();
+
+    std::set<std::pair<BOARD_ITEM*, BOARD_ITEM*>> reported;
+
+    for( BOARD_CONNECTED_ITEM* item : copper )
+    {
+        for( PCB_LAYER_ID layer : item->GetLayerSet() & boardCu )
+        {
+            auto treeIt = trees.find( layer );
+
+            if( treeIt == trees.end() )
+                continue;
+
+            std::shared_ptr<SHAPE> shape = item->GetEffectiveShape( layer );
+            int                    clearance = item->GetOwnClearance( layer );
+            BOX2I                  query = item->GetBoundingBox();
+
+            query.Inflate( maxClearance );
+
+            auto visitor =
+                    [&]( BOARD_CONNECTED_ITEM* aOther )
+                    {
+                        if( aOther == item )
+                            return true;
+
+                        if( aOther->GetNetCode() == item->GetNetCode() && item->GetNetCode() > 0 )
+                            return true;
+
+                        if( aOther->GetParentFootprint()
+                                && aOther->GetParentFootprint() == item->GetParentFootprint() )
+                        {
+                            return true;
+                        }
+
+                        std::pair<BOARD_ITEM*, BOARD_ITEM*> key( item, aOther );
+
+                        if( key.second < key.first )
+                            std::swap( key.first, key.second );
+
+                        if( reported.count( key ) )
+                            return true;
+
+                        int required = std::max( clearance, aOther->GetOwnClearance( layer ) );
+                        int actual = 0;
+
+                        if( shape->Collide( aOther->GetEffectiveShape( layer ).get(), required,
+                                            &actual ) )
+                        {
+                            reported.insert( key );
+                            problems.push_back( { { "type", "clearance" },
+                                                  { "item", describeItem( item ).ToStdString() },
+                                                  { "other", describeItem( aOther ).ToStdString() },
+                                                  { "layer", brd->GetLayerName( layer ).ToStdString() },
+                                                  { "actual_mm", pcbIUScale.IUTomm( actual ) },
+                                                  { "required_mm", pcbIUScale.IUTomm( required ) } } );
+                        }
+
+                        return true;
+                    };
+
+            treeIt->second.Search( query, visitor );
+        }
+    }
+
+    return problems;
+}
+
+
+void PCB_OLLAMA_AGENT_TOOL::selectItems( const std::vector<BOARD_ITEM*>& aItems )
+{
+    if( aItems.empty() )
+        return;
+
+    EDA_ITEMS items( aItems.begin(), aItems.end() );
+
+    m_toolMgr->RunAction( ACTIONS::selectionClear );
+    m_toolMgr->RunAction<EDA_ITEMS*>( ACTIONS::selectItems, &items );
+}
+
+
+void PCB_OLLAMA_AGENT_TOOL::setTransitions()
+{
+    Go( &PCB_OLLAMA_AGENT_TOOL::ProcessRequest, PCB_ACTIONS::ollamaAgentRequest.MakeEvent() );
+}
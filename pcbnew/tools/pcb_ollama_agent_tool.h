@@ -0,0 +1,146 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PCB_OLLAMA_AGENT_TOOL_H
+#define PCB_OLLAMA_AGENT_TOOL_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <ollama_client.h>
+#include <tools/pcb_tool_base.h>
+
+class BOARD_COMMIT;
+class BOARD_ITEM;
+class PCB_FREE_AREA_FINDER;
+
+
+/**
+ * Tool that lets an LLM agent edit the board: place, move and rotate footprints, route simple
+ * connections with straight tracks and query DRC results.
+ *
+ * A response is executed as a plan: every TOOL line of the response runs inside a single
+ * BOARD_COMMIT, so the plan costs one connectivity update, one undo entry and one redraw, and
+ * is reverted as a whole if a step fails.  Free areas for footprints are searched on packed
+ * R-trees of the footprint boxes instead of testing every footprint.
+ *
+ * After a plan is pushed, only the items it touched are checked (courtyard overlaps and copper
+ * clearance against the items around them) and the problems are sent back to the model.
+ */
+class PCB_OLLAMA_AGENT_TOOL : public PCB_TOOL_BASE
+{
+public:
+    PCB_OLLAMA_AGENT_TOOL();
+    ~PCB_OLLAMA_AGENT_TOOL() override;
+
+    /// @copydoc TOOL_INTERACTIVE::Reset()
+    void Reset( RESET_REASON aReason ) override;
+
+    /**
+     * Process a natural language request and execute the returned plan.
+     */
+    int ProcessRequest( const TOOL_EVENT& aEvent );
+
+    void setTransitions() override;
+
+    /**
+     * Get the Ollama client, creating it on first use.
+     */
+    OLLAMA_CLIENT* GetOllama();
+
+    wxString GetModel() const { return m_model; }
+
+    /**
+     * Describe the board for a prompt.
+     *
+     * Footprints take one line each and nets are listed with their pads and the number of
+     * connections still unrouted, taken from the connectivity data; tracks, zones and graphics
+     * are not listed.
+     *
+     * @param aMaxChars truncates the output when non-zero.
+     */
+    wxString GetBoardContext( size_t aMaxChars = 50000 );
+
+    /**
+     * Execute the TOOL lines of \a aResponse as a single plan.
+     */
+    bool ParseAndExecute( const wxString& aResponse );
+
+    /**
+     * Execute a list of (tool name, payload) commands as a single undoable change.
+     *
+     * If any command fails, everything done by the earlier ones is reverted and the last tool
+     * error names the failing step.  On success the last tool result is a JSON object holding
+     * the result of each command and the problems found around the changed items.
+     */
+    bool RunToolBatch( const std::vector<std::pair<wxString, wxString>>& aCommands,
+                       const wxString& aMessage );
+
+    /**
+     * Execute a single command in its own commit.
+     */
+    bool RunToolCommand( const wxString& aToolName, const wxString& aPayload );
+
+    wxString GetLastToolError() const { return m_lastToolError; }
+    wxString GetLastToolResult() const { return m_lastToolResult; }
+
+    /**
+     * Check the given items against what is around them: courtyard overlaps for footprints,
+     * and copper clearance to items of other nets for tracks and the pads of footprints.
+     *
+     * @return one JSON object per problem.
+     */
+    nlohmann::json CheckItems( const std::vector<BOARD_ITEM*>& aItems );
+
+private:
+    bool dispatchToolCommand( const wxString& aToolName, const nlohmann::json& aPayload,
+                              BOARD_COMMIT& aCommit );
+
+    bool handleMoveFootprint( const nlohmann::json& aPayload, BOARD_COMMIT& aCommit );
+    bool handlePlaceFootprint( const nlohmann::json& aPayload, BOARD_COMMIT& aCommit );
+    bool handleRotateFootprint( const nlohmann::json& aPayload, BOARD_COMMIT& aCommit );
+    bool handleAddTrack( const nlohmann::json& aPayload, BOARD_COMMIT& aCommit );
+    bool handleConnectPads( const nlohmann::json& aPayload, BOARD_COMMIT& aCommit );
+    bool handleGetNet( const nlohmann::json& aPayload );
+    bool handleGetDrc( const nlohmann::json& aPayload );
+
+    FOOTPRINT* findFootprint( const nlohmann::json& aPayload, const char* aKey );
+
+    /// Free area search for the current plan, built on first use.
+    PCB_FREE_AREA_FINDER& freeAreaFinder();
+
+    /// Send the problems of the last plan back to the model and execute its corrections.
+    void sendFeedback( const nlohmann::json& aProblems );
+
+    void selectItems( const std::vector<BOARD_ITEM*>& aItems );
+
+private:
+    std::unique_ptr<OLLAMA_CLIENT>        m_ollama;
+    std::unique_ptr<PCB_FREE_AREA_FINDER> m_freeArea;
+    std::vector<BOARD_ITEM*>              m_planItems;    ///< Items added or modified by the plan
+    wxString                              m_model;
+    wxString                              m_lastToolError;
+    wxString                              m_lastToolResult;
+    nlohmann::json                        m_lastProblems;
+    int                                   m_maxFeedbackTurns;
+};
+
+#endif // PCB_OLLAMA_AGENT_TOOL_H
@@ -28,6 +28,7 @@
 #include <cmath>
 #include <functional>
 #include <stack>
+#include <unordered_set>
 using namespace std::placeholders;
 
 #include <advanced_config.h>
@@ -760,8 +761,9 @@ bool PCB_SELECTION_TOOL::selectPoint( const VECTOR2I& aWhere, bool aOnDrag, bool
     if( m_enteredGroup && !m_enteredGroup->GetBoundingBox().Contains( aWhere ) )
         ExitGroup();
 
-    collector.Collect( board(), m_isFootprintEditor ? GENERAL_COLLECTOR::FootprintItems
-                                                    : GENERAL_COLLECTOR::AllBoardItems,
+    collector.Collect( board(), getView(),
+                       m_isFootprintEditor ? GENERAL_COLLECTOR::FootprintItems
+                                           : GENERAL_COLLECTOR::AllBoardItems,
                        aWhere, guide );
 
     // Remove unselectable items
@@ -1238,9 +1240,24 @@ void PCB_SELECTION_TOOL::SelectMultiple( KIGFX::PREVIEW::SELECTION_AREA& aArea,
     bool boxMode = (    selectionMode == SELECTION_MODE::INSIDE_RECTANGLE
                      || selectionMode == SELECTION_MODE::TOUCHING_RECTANGLE ) ? true : false;
 
-    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> candidates;
-    BOX2I selectionBox = aArea.ViewBBox();
-    view->Query( selectionBox, candidates ); // Get the list of nearby items
+    // An item is reported once per view layer it is drawn on; only keep the first hit
+    std::vector<BOARD_ITEM*>        candidates;
+    std::unordered_set<BOARD_ITEM*> seen;
+    BOX2I                           selectionBox = aArea.ViewBBox();
+
+    view->Query( selectionBox,
+            [&]( KIGFX::VIEW_ITEM* aItem ) -> bool
+            {
+                if( !aItem->IsBOARD_ITEM() )
+                    return true;
+
+                BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( aItem );
+
+                if( seen.insert( boardItem ).second )
+                    candidates.push_back( boardItem );
+
+                return true;
+            } );
 
     GENERAL_COLLECTOR collector;
     GENERAL_COLLECTOR padsCollector;
@@ -1286,15 +1303,13 @@ void PCB_SELECTION_TOOL::SelectMultiple( KIGFX::PREVIEW::SELECTION_AREA& aArea,
                                : aItem->HitTest( aArea.GetPoly(), containedMode );
             };
 
-    for( const auto& [item, layer] : candidates )
+    for( BOARD_ITEM* boardItem : candidates )
     {
-        if( !item->IsBOARD_ITEM() )
+        // Cheapest tests first; the exact hit test is only run on selectable items
+        if( containedMode && group_items.count( boardItem ) )
             continue;
 
-        BOARD_ITEM* boardItem = static_cast<BOARD_ITEM*>( item );
-
-        if( Selectable( boardItem ) && hitTest( boardItem )
-                && ( !containedMode || !group_items.count( boardItem ) ) )
+        if( Selectable( boardItem ) && hitTest( boardItem ) )
         {
             if( boardItem->Type() == PCB_PAD_T && !m_isFootprintEditor )
                 padsCollector.Append( boardItem );
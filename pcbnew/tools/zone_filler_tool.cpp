@@ -24,6 +24,7 @@
  */
 #include <cstdint>
 #include <thread>
+#include <advanced_config.h>
 #include <zone.h>
 #include <connectivity/connectivity_data.h>
 #include <board_commit.h>
@@ -43,6 +44,7 @@
 #include "pcb_actions.h"
 #include "zone_filler_tool.h"
 #include "zone_filler.h"
+#include "zone_fill_cache.h"
 #include "teardrop/teardrop.h"
 #include <core/profile.h>
 
@@ -100,7 +102,7 @@ void ZONE_FILLER_TOOL::CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRep
         commit.Revert();
     }
 
-    rebuildConnectivity();
+    rebuildConnectivity( toFill );
     refresh();
 
     m_fillInProgress = false;
@@ -169,11 +171,28 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
         m_filler->SetProgressReporter( reporter.get() );
     }
 
+    // Jobs refill boards on every run; reuse what the previous run filled
+    ZONE_FILL_CACHE fillCache;
+    wxString        fillCachePath;
+
+    if( aHeadless && ADVANCED_CFG::GetCfg().m_ZoneFillCache )
+        fillCachePath = ZONE_FILL_CACHE::CachePath( board() );
+
+    if( !fillCachePath.IsEmpty() )
+    {
+        // An unreadable cache is empty, which just means everything gets filled
+        fillCache.Load( fillCachePath );
+        m_filler->SetFillCache( &fillCache );
+    }
+
     if( m_filler->Fill( toFill ) )
     {
         if( m_filler->GetProgressReporter() )
             m_filler->GetProgressReporter()->AdvancePhase();
 
+        if( !fillCachePath.IsEmpty() )
+            fillCache.Save( fillCachePath );
+
         commit.Push( _( "Fill Zone(s)" ), SKIP_CONNECTIVITY | ZONE_FILL_OP );
         if( !aHeadless )
             frame->m_ZoneFillsDirty = false;
@@ -183,7 +202,7 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
         commit.Revert();
     }
 
-    rebuildConnectivity( aHeadless );
+    rebuildConnectivity( toFill, aHeadless );
 
     if( !aHeadless )
     {
@@ -210,8 +229,11 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 
     for( ZONE* zone : board()->Zones() )
     {
-        if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid ) )
+        if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid )
+                || m_dirtyZoneRegions.count( zone->m_Uuid ) )
+        {
             toFill.push_back( zone );
+        }
     }
 
     if( toFill.empty() )
@@ -223,6 +245,12 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     int64_t startTime = GetRunningMicroSecs();
     m_fillInProgress = true;
 
+    std::map<KIID, std::vector<BOX2I>> dirtyRegions;
+    std::swap( dirtyRegions, m_dirtyZoneRegions );
+
+    for( const KIID& id : m_dirtyZoneIDs )
+        dirtyRegions.erase( id );
+
     m_dirtyZoneIDs.clear();
 
     board()->IncrementTimeStamp();    // Clear caches
@@ -233,6 +261,15 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
 
+    // Zones which were only touched by small edits are refilled around those edits
+    for( ZONE* zone : toFill )
+    {
+        auto it = dirtyRegions.find( zone->m_Uuid );
+
+        if( it != dirtyRegions.end() && zone->IsFilled() )
+            m_filler->SetDirtyRegions( zone, it->second );
+    }
+
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
         WX_INFOBAR* infobar = frame->GetInfoBar();
@@ -275,7 +312,7 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     else
         commit.Revert();
 
-    rebuildConnectivity();
+    rebuildConnectivity( toFill );
     refresh();
 
     if( GetRunningMicroSecs() - startTime > 3000000 )   // 3 seconds
@@ -367,7 +404,7 @@ int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
         commit.Revert();
     }
 
-    rebuildConnectivity();
+    rebuildConnectivity( toFill );
     refresh();
 
     m_fillInProgress = false;
@@ -450,9 +487,13 @@ PROGRESS_REPORTER* ZONE_FILLER_TOOL::GetProgressReporter()
 }
 
 
-void ZONE_FILLER_TOOL::rebuildConnectivity( bool aHeadless )
+void ZONE_FILLER_TOOL::rebuildConnectivity( const std::vector<ZONE*>& aZones, bool aHeadless )
 {
-    board()->BuildConnectivity();
+    std::vector<BOARD_ITEM*> zones( aZones.begin(), aZones.end() );
+
+    if( board()->GetConnectivity()->ApplyChanges( board(), {}, {}, zones ) )
+        board()->UpdateRatsnestExclusions();
+
     m_toolMgr->PostEvent( EVENTS::ConnectivityChangedEvent );
     if( !aHeadless )
         canvas()->RedrawRatsnest();
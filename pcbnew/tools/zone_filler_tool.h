@@ -68,13 +68,23 @@ public:
         m_dirtyZoneIDs.insert( aZone->m_Uuid );
     }
 
+    /// Mark only the area \a aDamage of \a aZone as needing a refill.
+    void DirtyZone( ZONE* aZone, const BOX2I& aDamage )
+    {
+        m_dirtyZoneRegions[aZone->m_Uuid].push_back( aDamage );
+    }
+
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
 
 private:
     ///< Refocus on an idle event (used after the Progress Reporter messes up the focus).
     void singleShotRefocus( wxIdleEvent& );
 
-    void rebuildConnectivity( bool aHeadless = false );
+    /**
+     * Update the connectivity after filling \a aZones.  The filler rebuilds the connectivity
+     * before filling, so only the zones have changed since.
+     */
+    void rebuildConnectivity( const std::vector<ZONE*>& aZones, bool aHeadless = false );
     void refresh();
 
     ///< Set up handlers for various events.
@@ -85,6 +95,7 @@ private:
     bool                         m_fillInProgress;
 
     std::set<KIID>               m_dirtyZoneIDs;
+    std::map<KIID, std::vector<BOX2I>> m_dirtyZoneRegions;
 };
 
 #endif
@@ -45,7 +45,8 @@ TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit ) :
         m_dryRun( true ),
         m_itemsList( nullptr ),
         m_reporter( nullptr ),
-        m_filter( nullptr )
+        m_filter( nullptr ),
+        m_trackIndexValid( false )
 {
 }
 
@@ -67,6 +68,7 @@ void TRACKS_CLEANER::CleanupBoard( bool aDryRun,
 
     m_dryRun = aDryRun;
     m_itemsList = aItemsList;
+    m_trackIndexValid = false;
 
     if( m_reporter )
     {
@@ -174,56 +176,93 @@ bool TRACKS_CLEANER::filterItem( BOARD_CONNECTED_ITEM* aItem )
 }
 
 
+std::vector<PCB_TRACK*> TRACKS_CLEANER::getCandidateTracks()
+{
+    std::vector<PCB_TRACK*> tracks;
+
+    tracks.reserve( m_brd->Tracks().size() );
+
+    for( PCB_TRACK* track : m_brd->Tracks() )
+    {
+        if( !track->IsLocked() && !filterItem( track ) )
+            tracks.push_back( track );
+    }
+
+    return tracks;
+}
+
+
+void TRACKS_CLEANER::buildTrackIndex()
+{
+    if( m_trackIndexValid )
+        return;
+
+    m_trackIndex.clear();
+
+    for( PCB_TRACK* track : m_brd->Tracks() )
+        m_trackIndex.Insert( track, track->GetLayer() );
+
+    m_trackIndex.Build();
+    m_trackIndexValid = true;
+}
+
+
 void TRACKS_CLEANER::removeShortingTrackSegments()
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+    std::vector<PCB_TRACK*>            tracks = getCandidateTracks();
 
-    std::set<BOARD_ITEM *> toRemove;
+    // Number of items of another net each track is connected to.  The connectivity is only
+    // read here, so the tracks are tested in parallel and reported in board order afterwards.
+    std::vector<int> shorts( tracks.size(), 0 );
 
-    for( PCB_TRACK* segment : m_brd->Tracks() )
-    {
-        if( segment->IsLocked() || filterItem( segment ) )
-            continue;
+    thread_pool& tp = GetKiCadThreadPool();
 
-        for( PAD* testedPad : connectivity->GetConnectedPads( segment ) )
-        {
-            if( segment->GetNetCode() != testedPad->GetNetCode() )
+    tp.submit_loop( size_t( 0 ), tracks.size(),
+            [&]( size_t aIdx )
             {
-                std::shared_ptr<CLEANUP_ITEM> item;
+                PCB_TRACK* segment = tracks[aIdx];
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+                for( PAD* testedPad : connectivity->GetConnectedPads( segment ) )
+                {
+                    if( segment->GetNetCode() != testedPad->GetNetCode() )
+                        shorts[aIdx]++;
+                }
 
-                item->SetItems( segment );
-                m_itemsList->push_back( std::move( item ) );
+                for( PCB_TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
+                {
+                    if( segment->GetNetCode() != testedTrack->GetNetCode() )
+                        shorts[aIdx]++;
+                }
+            } ).wait();
 
-                toRemove.insert( segment );
-            }
-        }
+    std::set<BOARD_ITEM *> toRemove;
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        PCB_TRACK* segment = tracks[ii];
 
-        for( PCB_TRACK* testedTrack : connectivity->GetConnectedTracks( segment ) )
+        for( int jj = 0; jj < shorts[ii]; ++jj )
         {
-            if( segment->GetNetCode() != testedTrack->GetNetCode() )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
+            std::shared_ptr<CLEANUP_ITEM> item;
 
-                if( segment->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
+            if( segment->Type() == PCB_VIA_T )
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_VIA );
+            else
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_SHORTING_TRACK );
 
-                item->SetItems( segment );
-                m_itemsList->push_back( std::move( item ) );
+            item->SetItems( segment );
+            m_itemsList->push_back( std::move( item ) );
 
-                toRemove.insert( segment );
-            }
+            toRemove.insert( segment );
         }
     }
 
-    if( !m_dryRun )
+    if( !m_dryRun && !toRemove.empty() )
+    {
         removeItems( toRemove );
+        m_trackIndexValid = false;
+    }
 }
 
 
@@ -276,11 +315,16 @@ bool TRACKS_CLEANER::deleteDanglingTracks( bool aTrack, bool aVia )
     if( !aTrack && !aVia )
         return false;
 
+    // Ensure the connectivity is up to date.  Removing a dangling segment updates it, so later
+    // passes only need the clusters it touched repaired.
+    m_brd->BuildConnectivity();
+
     do // Iterate when at least one track is deleted
     {
+        if( item_erased )
+            m_brd->GetConnectivity()->RecalculateRatsnest();
+
         item_erased = false;
-        // Ensure the connectivity is up to date, especially after removing a dangling segment
-        m_brd->BuildConnectivity();
 
         // Keep a duplicate deque to all deleting in the primary
         std::deque<PCB_TRACK*> temp_tracks( m_brd->Tracks() );
@@ -318,6 +362,7 @@ bool TRACKS_CLEANER::deleteDanglingTracks( bool aTrack, bool aVia )
                 {
                     m_brd->Remove( track );
                     m_commit.Removed( track );
+                    m_trackIndexValid = false;
                     modified = true;
                 }
             }
@@ -330,45 +375,65 @@ bool TRACKS_CLEANER::deleteDanglingTracks( bool aTrack, bool aVia )
 
 void TRACKS_CLEANER::deleteTracksInPads()
 {
-    std::set<BOARD_ITEM*> toRemove;
-
     // Delete tracks that start and end on the same pad
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
+    std::vector<PCB_TRACK*>            tracks = getCandidateTracks();
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
-    {
-        if( track->IsLocked() || filterItem( track ) )
-            continue;
+    std::erase_if( tracks,
+                   []( PCB_TRACK* aTrack )
+                   {
+                       return aTrack->Type() == PCB_VIA_T;
+                   } );
 
-        if( track->Type() == PCB_VIA_T )
-            continue;
+    // Number of pads fully covering each track.  The polygon subtractions are the expensive
+    // part, and only read the board, so they run in parallel.
+    std::vector<int> coveringPads( tracks.size(), 0 );
 
-        // Mark track if connected to pads
-        for( PAD* pad : connectivity->GetConnectedPads( track ) )
-        {
-            if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
-            {
-                SHAPE_POLY_SET poly;
-                track->TransformShapeToPolygon( poly, track->GetLayer(), 0, track->GetMaxError(),
-                                                ERROR_INSIDE );
+    thread_pool& tp = GetKiCadThreadPool();
 
-                poly.BooleanSubtract( *pad->GetEffectivePolygon( track->GetLayer(), ERROR_INSIDE ) );
+    tp.submit_loop( size_t( 0 ), tracks.size(),
+            [&]( size_t aIdx )
+            {
+                PCB_TRACK* track = tracks[aIdx];
 
-                if( poly.IsEmpty() )
+                // Mark track if connected to pads
+                for( PAD* pad : connectivity->GetConnectedPads( track ) )
                 {
-                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
-                    item->SetItems( track );
-                    m_itemsList->push_back( std::move( item ) );
+                    if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
+                    {
+                        SHAPE_POLY_SET poly;
+                        track->TransformShapeToPolygon( poly, track->GetLayer(), 0,
+                                                        track->GetMaxError(), ERROR_INSIDE );
+
+                        poly.BooleanSubtract( *pad->GetEffectivePolygon( track->GetLayer(),
+                                                                         ERROR_INSIDE ) );
 
-                    toRemove.insert( track );
-                    track->SetFlags( IS_DELETED );
+                        if( poly.IsEmpty() )
+                            coveringPads[aIdx]++;
+                    }
                 }
-            }
+            } ).wait();
+
+    std::set<BOARD_ITEM*> toRemove;
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        for( int jj = 0; jj < coveringPads[ii]; ++jj )
+        {
+            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
+            item->SetItems( tracks[ii] );
+            m_itemsList->push_back( std::move( item ) );
+
+            toRemove.insert( tracks[ii] );
+            tracks[ii]->SetFlags( IS_DELETED );
         }
     }
 
-    if( !m_dryRun )
+    if( !m_dryRun && !toRemove.empty() )
+    {
         removeItems( toRemove );
+        m_trackIndexValid = false;
+    }
 }
 
 
@@ -378,19 +443,20 @@ void TRACKS_CLEANER::deleteTracksInPads()
 void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                               bool aDeleteDuplicateSegments, bool aMergeSegments )
 {
-    DRC_RTREE rtree;
-
     for( PCB_TRACK* track : m_brd->Tracks() )
-    {
         track->ClearFlags( IS_DELETED | SKIP_STRUCT );
-        rtree.Insert( track, track->GetLayer() );
-    }
 
+    // Only the duplicate tests need the index; a merge-only pass does not.  Items removed by
+    // this pass are flagged IS_DELETED, so the index stays usable by the next duplicate pass.
+    if( aDeleteDuplicateVias || aDeleteDuplicateSegments )
+        buildTrackIndex();
+
+    DRC_RTREE&            rtree = m_trackIndex;
     std::set<BOARD_ITEM*> toRemove;
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
+    for( PCB_TRACK* track : getCandidateTracks() )
     {
-        if( track->HasFlag( IS_DELETED ) || track->IsLocked() || filterItem( track ) )
+        if( track->HasFlag( IS_DELETED ) )
             continue;
 
         if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
@@ -607,10 +673,19 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
 
     if( aMergeSegments )
     {
+        while( !m_brd->BuildConnectivity() )
+            wxSafeYield();
+
+        // Merges update the connectivity of the segments they touch, so later passes only need
+        // the affected clusters repaired.
+        bool firstPass = true;
+
         do
         {
-            while( !m_brd->BuildConnectivity() )
-                wxSafeYield();
+            if( !firstPass )
+                m_brd->GetConnectivity()->RecalculateRatsnest();
+
+            firstPass = false;
 
             std::lock_guard lock( m_mutex );
             m_connectedItemsCache.clear();
@@ -784,6 +859,7 @@ bool TRACKS_CLEANER::mergeCollinearSegments( PCB_TRACK* aSeg1, PCB_TRACK* aSeg2
         m_commit.Modify( aSeg1 );
 
         *aSeg1 = dummy_seg;
+        m_trackIndexValid = false;
 
         m_brd->GetConnectivity()->Update( aSeg1 );
 
@@ -27,6 +27,7 @@
 #include <mutex>
 #include <pcb_track.h>
 #include <board.h>
+#include <drc/drc_rtree.h>
 
 class BOARD_COMMIT;
 class CLEANUP_ITEM;
@@ -65,6 +66,18 @@ public:
 private:
     bool filterItem( BOARD_CONNECTED_ITEM* aItem );
 
+    /**
+     * @return the unlocked tracks which pass the filter, in board order.  The filter is called
+     *         once per track and never from worker threads.
+     */
+    std::vector<PCB_TRACK*> getCandidateTracks();
+
+    /**
+     * Build the spatial index of the tracks if it is not up to date.  It is shared by the
+     * geometry cleanup passes and only rebuilt once track geometry changed.
+     */
+    void buildTrackIndex();
+
     /*
      * Removes track segments which are connected to more than one net (short circuits).
      */
@@ -129,6 +142,9 @@ private:
 
     std::function<bool( BOARD_CONNECTED_ITEM* aItem )>       m_filter;
     std::mutex m_mutex;
+
+    DRC_RTREE                                                m_trackIndex;
+    bool                                                     m_trackIndexValid;
 };
 
 
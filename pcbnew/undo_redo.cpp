@@ -32,6 +32,7 @@ using namespace std::placeholders;
 #include <pcb_track.h>
 #include <pcb_group.h>
 #include <pcb_shape.h>
+#include <zone.h>
 #include <pcb_generator.h>
 #include <footprint.h>
 #include <lset.h>
@@ -99,6 +100,96 @@ using namespace std::placeholders;
  */
 
 
+/**
+ * Rough number of bytes an undo copy or a deleted item keeps alive.  Zone fills still shared
+ * with another zone (see ZONE::CloneSharingFills()) are not counted.
+ */
+static size_t undoItemMemory( const EDA_ITEM* aItem )
+{
+    // A typical board item with its strings, caches and shape
+    constexpr size_t itemSize = 512;
+
+    size_t size = itemSize;
+
+    switch( aItem->Type() )
+    {
+    case PCB_ZONE_T:
+    {
+        const ZONE* zone = static_cast<const ZONE*>( aItem );
+
+        size += zone->Outline()->FullPointCount() * sizeof( VECTOR2I );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+            if( fill && fill.use_count() == 1 )
+                size += fill->FullPointCount() * sizeof( VECTOR2I );
+        }
+
+        break;
+    }
+
+    case PCB_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+
+        if( shape->GetShape() == SHAPE_T::POLY )
+            size += shape->GetPolyShape().FullPointCount() * sizeof( VECTOR2I );
+
+        break;
+    }
+
+    case PCB_FOOTPRINT_T:
+        static_cast<const FOOTPRINT*>( aItem )->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    size += undoItemMemory( aChild );
+                },
+                RECURSE_MODE::NO_RECURSE );
+
+        break;
+
+    default:
+        break;
+    }
+
+    return size;
+}
+
+
+static size_t undoCommandMemory( const PICKED_ITEMS_LIST& aCommand )
+{
+    size_t size = 0;
+
+    for( unsigned ii = 0; ii < aCommand.GetCount(); ii++ )
+    {
+        switch( aCommand.GetPickedItemStatus( ii ) )
+        {
+        case UNDO_REDO::CHANGED:
+            if( EDA_ITEM* image = aCommand.GetPickedItemLink( ii ) )
+                size += undoItemMemory( image );
+
+            break;
+
+        case UNDO_REDO::DELETED:
+            if( EDA_ITEM* item = aCommand.GetPickedItem( ii ) )
+                size += undoItemMemory( item );
+
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return size;
+}
+
+
 void PCB_BASE_EDIT_FRAME::saveCopyInUndoList( PICKED_ITEMS_LIST* commandToUndo,
                                               const PICKED_ITEMS_LIST& aItemsList,
                                               UNDO_REDO aCommandType )
@@ -145,6 +236,8 @@ void PCB_BASE_EDIT_FRAME::saveCopyInUndoList( PICKED_ITEMS_LIST* commandToUndo,
 
     if( commandToUndo->GetCount() )
     {
+        commandToUndo->SetMemoryEstimate( undoCommandMemory( *commandToUndo ) );
+
         /* Save the copy in undo list */
         PushCommandToUndoList( commandToUndo );
 
@@ -611,11 +611,11 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
     LENGTH_DELAY_CALCULATION*   calc = m_board->GetLengthCalculation();
     const std::vector<CN_ITEM*> conItems = relevantConnectivityItems();
 
-    // First assemble the LENGTH_CALCULATION_ITEMs for board items which match the nets we need to recompute
+    // First assemble the board items which match the nets we need to recompute
     // Precondition: conItems and aNetCodes are sorted in increasing netcode value
     // Functionality: This extracts any items from conItems which have a netcode which is present in aNetCodes
-    std::unordered_map<int, std::vector<LENGTH_DELAY_CALCULATION_ITEM>> netItemsMap;
-    std::vector<NETINFO_ITEM*>                                          foundNets;
+    std::unordered_map<int, std::vector<const BOARD_CONNECTED_ITEM*>> netItemsMap;
+    std::vector<NETINFO_ITEM*>                                        foundNets;
 
     auto itemItr = conItems.begin();
     auto netCodeItr = aNetCodes.begin();
@@ -631,8 +631,7 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
                 foundNets.emplace_back( *netCodeItr );
 
             // Take the item
-            LENGTH_DELAY_CALCULATION_ITEM lengthItem = calc->GetLengthCalculationItem( ( *itemItr )->Parent() );
-            netItemsMap[curItemNetCode].emplace_back( std::move( lengthItem ) );
+            netItemsMap[curItemNetCode].emplace_back( ( *itemItr )->Parent() );
             ++itemItr;
         }
         else if( curItemNetCode < curNetCode )
@@ -650,7 +649,7 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
     }
 
     // Now calculate the length statistics for each net. This includes potentially expensive path optimisations, so
-    // parallelize this work.
+    // parallelize this work.  Nets unchanged since the last refresh come from the calculator's cache.
     std::mutex   resultsMutex;
     thread_pool& tp = GetKiCadThreadPool();
 
@@ -665,11 +664,10 @@ PCB_NET_INSPECTOR_PANEL::calculateNets( const std::vector<NETINFO_ITEM*>& aNetCo
                                                       .OptimiseTracesInPads = true,
                                                       .InferViaInPad = false };
 
-                LENGTH_DELAY_STATS lengthDetails = calc->CalculateLengthDetails(
+                LENGTH_DELAY_STATS lengthDetails = calc->CalculateNetLengthDetails(
+                                        netCode,
                                         netItemsMap[netCode],
                                         opts,
-                                        nullptr,
-                                        nullptr,
                                         LENGTH_DELAY_LAYER_OPT::WITH_LAYER_DETAIL,
                                         m_showTimeDomainDetails ? LENGTH_DELAY_DOMAIN_OPT::WITH_DELAY_DETAIL
                                                                 : LENGTH_DELAY_DOMAIN_OPT::NO_DELAY_DETAIL );
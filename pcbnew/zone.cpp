@@ -36,6 +36,7 @@
 #include <zone.h>
 #include <footprint.h>
 #include <string_utils.h>
+#include <thread_pool.h>
 #include <properties/property_validators.h>
 #include <settings/color_settings.h>
 #include <settings/settings_manager.h>
@@ -100,6 +101,14 @@ ZONE::ZONE( const ZONE& aZone ) :
 }
 
 
+ZONE::ZONE( const ZONE& aZone, bool aShareFills ) :
+        BOARD_CONNECTED_ITEM( aZone ),
+        m_Poly( nullptr )
+{
+    InitDataFromSrcInCopyCtor( aZone, UNDEFINED_LAYER, aShareFills );
+}
+
+
 ZONE& ZONE::operator=( const ZONE& aOther )
 {
     BOARD_CONNECTED_ITEM::operator=( aOther );
@@ -126,7 +135,7 @@ ZONE::~ZONE()
 }
 
 
-void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone, PCB_LAYER_ID aLayer )
+void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone, PCB_LAYER_ID aLayer, bool aShareFills )
 {
     // members are expected non initialize in this.
     // InitDataFromSrcInCopyCtor() is expected to be called only from a copy constructor.
@@ -190,7 +199,9 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone, PCB_LAYER_ID aLayer )
 
                 std::shared_ptr<SHAPE_POLY_SET> fill = aZone.m_FilledPolysList.at( layer );
 
-                if( fill )
+                if( fill && aShareFills )
+                    m_FilledPolysList[layer] = fill;
+                else if( fill )
                     m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( *fill );
                 else
                     m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
@@ -227,6 +238,22 @@ ZONE* ZONE::Clone( PCB_LAYER_ID aLayer ) const
 }
 
 
+ZONE* ZONE::CloneSharingFills() const
+{
+    return new ZONE( *this, true );
+}
+
+
+void ZONE::detachFills()
+{
+    for( auto& [layer, fill] : m_FilledPolysList )
+    {
+        if( fill && fill.use_count() > 1 )
+            fill = std::make_shared<SHAPE_POLY_SET>( *fill );
+    }
+}
+
+
 void ZONE::Serialize( google::protobuf::Any& aContainer ) const
 {
     using namespace kiapi::board;
@@ -459,7 +486,9 @@ bool ZONE::UnFill()
     {
         change |= !pair.second->IsEmpty();
         m_insulatedIslands[pair.first].clear();
-        pair.second->RemoveAllContours();
+
+        // Don't clear a fill an undo image may still share
+        pair.second = std::make_shared<SHAPE_POLY_SET>();
     }
 
     m_isFilled = false;
@@ -985,6 +1014,8 @@ void ZONE::Move( const VECTOR2I& offset )
     HatchBorder();
 
     /* move fills */
+    detachFills();
+
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Move( offset );
 
@@ -1038,6 +1069,8 @@ void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
     HatchBorder();
 
     /* rotate filled areas: */
+    detachFills();
+
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Rotate( aAngle, aCentre );
 }
@@ -1080,6 +1113,7 @@ void ZONE::Mirror( const VECTOR2I& aMirrorRef, FLIP_DIRECTION aFlipDirection )
     m_Poly->Mirror( aMirrorRef, aFlipDirection );
 
     HatchBorder();
+    detachFills();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
         pair.second->Mirror( aMirrorRef, aFlipDirection );
@@ -1298,7 +1332,28 @@ void ZONE::swapData( BOARD_ITEM* aImage )
 {
     assert( aImage->Type() == PCB_ZONE_T );
 
-    std::swap( *static_cast<ZONE*>( this ), *static_cast<ZONE*>( aImage) );
+    ZONE* image = static_cast<ZONE*>( aImage );
+
+    // Same as std::swap(), but the fills change hands instead of being copied three times
+    ZONE temp( *this, true );
+
+    BOARD_CONNECTED_ITEM::operator=( *image );
+    InitDataFromSrcInCopyCtor( *image, UNDEFINED_LAYER, true );
+
+    image->BOARD_CONNECTED_ITEM::operator=( temp );
+    image->InitDataFromSrcInCopyCtor( temp, UNDEFINED_LAYER, true );
+}
+
+
+void ZONE::SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
+{
+    std::shared_ptr<SHAPE_POLY_SET> fill = std::make_shared<SHAPE_POLY_SET>( aPolysList );
+
+    // A refill usually leaves most islands untouched; keep their triangulation around
+    if( auto it = m_FilledPolysList.find( aLayer ); it != m_FilledPolysList.end() && it->second )
+        fill->ReuseTriangulationFrom( *it->second );
+
+    m_FilledPolysList[aLayer] = fill;
 }
 
 
@@ -1307,14 +1362,14 @@ void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
     if( aLayer == UNDEFINED_LAYER )
     {
         for( auto& [ layer, poly ] : m_FilledPolysList )
-            poly->CacheTriangulation();
+            poly->CacheTriangulation( true, false, KiCadParallelFor );
 
         m_Poly->CacheTriangulation( false );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ]->CacheTriangulation();
+            m_FilledPolysList[ aLayer ]->CacheTriangulation( true, false, KiCadParallelFor );
     }
 }
 
@@ -99,9 +99,13 @@ public:
     }
 
     /**
-     * Copy aZone data to me
+     * Copy aZone data to me.
+     *
+     * @param aShareFills take the same fill polygons as \a aZone instead of copies; they are
+     *                    copied on the first in-place change of either zone.
      */
-    void InitDataFromSrcInCopyCtor( const ZONE& aZone, PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
+    void InitDataFromSrcInCopyCtor( const ZONE& aZone, PCB_LAYER_ID aLayer = UNDEFINED_LAYER,
+                                    bool aShareFills = false );
 
     /**
      * For rule areas which exclude footprints (and therefore participate in courtyard conflicts
@@ -599,6 +603,10 @@ public:
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * The fill may be shared with an undo image (see CloneSharingFills()); replace it with
+     * SetFilledPolysList() rather than editing it, unless it was just created.
+     */
     SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
     {
         wxASSERT( m_FilledPolysList.count( aLayer ) );
@@ -614,10 +622,7 @@ public:
     /**
      * Set the list of filled polygons.
      */
-    void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
-    {
-        m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
-    }
+    void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList );
 
     /**
      * Check if a given filled polygon is an insulated island.
@@ -670,6 +675,14 @@ public:
     EDA_ITEM* Clone() const override;
     ZONE* Clone( PCB_LAYER_ID aLayer ) const;
 
+    /**
+     * Clone the zone for an undo image: the fill polygons, usually unchanged by an edit, are
+     * shared with this zone rather than copied.
+     *
+     * Both zones must not be used from different threads, as they share the fill caches.
+     */
+    ZONE* CloneSharingFills() const;
+
     /**
      * @return true if the zone is a teardrop area
      */
@@ -796,6 +809,12 @@ public:
 protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
+    /// Copy constructor optionally sharing the fills, see InitDataFromSrcInCopyCtor().
+    ZONE( const ZONE& aZone, bool aShareFills );
+
+    /// Give this zone its own copy of the fills it shares, before changing them in place.
+    void detachFills();
+
 protected:
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
@@ -0,0 +1,521 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "zone_fill_cache.h"
+
+#include <algorithm>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <footprint.h>
+#include <hash.h>
+#include <hash_eda.h>
+#include <kiplatform/io.h>
+#include <netclass.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <project.h>
+#include <project/project_local_settings.h>
+#include <wildcards_and_files_ext.h>
+#include <zone.h>
+
+#include <wx/datstrm.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+
+
+static const char     CACHE_MAGIC[] = "KICAD_ZONE_FILL_CACHE";
+static const uint32_t CACHE_VERSION = 1;
+
+
+namespace
+{
+
+/// An item a zone fill may depend on, with the hash of the properties that matter.
+struct ITEM_HASH
+{
+    BOX2I  bbox;
+    LSET   layers;
+    bool   allCopper;   ///< Holes knock out every copper layer, whatever the item's layers
+    size_t hash;
+};
+
+} // namespace
+
+
+static size_t hashOutline( const SHAPE_POLY_SET& aOutline )
+{
+    size_t ret = 0;
+
+    for( int ii = 0; ii < aOutline.OutlineCount(); ++ii )
+    {
+        hash_combine( ret, aOutline.HoleCount( ii ) );
+
+        for( auto it = aOutline.CIterateWithHoles( ii ); it; ++it )
+            hash_combine( ret, it->x, it->y );
+    }
+
+    return ret;
+}
+
+
+static size_t hashZone( const ZONE* aZone )
+{
+    size_t ret = hashOutline( *aZone->Outline() );
+
+    hash_combine( ret, std::hash<BASE_SET>{}( aZone->GetLayerSet() ), aZone->GetNetCode(),
+                  aZone->GetAssignedPriority(), aZone->GetIsRuleArea() );
+
+    if( aZone->GetIsRuleArea() )
+    {
+        hash_combine( ret, aZone->GetDoNotAllowZoneFills(), aZone->GetDoNotAllowVias(),
+                      aZone->GetDoNotAllowTracks(), aZone->GetDoNotAllowPads(),
+                      aZone->GetDoNotAllowFootprints() );
+        return ret;
+    }
+
+    hash_combine( ret, aZone->GetLocalClearance().value_or( -1 ), aZone->GetMinThickness(),
+                  static_cast<int>( aZone->GetFillMode() ), aZone->GetThermalReliefGap(),
+                  aZone->GetThermalReliefSpokeWidth(),
+                  static_cast<int>( aZone->GetPadConnection() ) );
+
+    hash_combine( ret, static_cast<int>( aZone->GetIslandRemovalMode() ),
+                  aZone->GetMinIslandArea(), aZone->GetCornerSmoothingType(),
+                  aZone->GetCornerRadius(), static_cast<int>( aZone->GetTeardropAreaType() ) );
+
+    if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+    {
+        hash_combine( ret, aZone->GetHatchThickness(), aZone->GetHatchGap(),
+                      aZone->GetHatchOrientation().AsDegrees(), aZone->GetHatchSmoothingLevel(),
+                      aZone->GetHatchSmoothingValue(), aZone->GetHatchHoleMinArea(),
+                      aZone->GetHatchBorderAlgorithm() );
+    }
+
+    return ret;
+}
+
+
+/// Settings that apply to every zone: clearance rules, fill accuracy and the board outline.
+static size_t hashBoard( const BOARD* aBoard )
+{
+    const BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+    size_t                       ret = 0;
+
+    hash_combine( ret, bds.m_MaxError, bds.m_MinClearance, bds.m_HoleClearance,
+                  bds.m_HoleToHoleMin, bds.m_CopperEdgeClearance );
+    hash_combine( ret, ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+    if( PROJECT* project = aBoard->GetProject() )
+        hash_combine( ret, project->GetLocalSettings().m_PrototypeZoneFill );
+
+    for( NETINFO_ITEM* net : aBoard->GetNetInfo() )
+    {
+        hash_combine( ret, net->GetNetCode(), net->GetNetname().ToStdString() );
+
+        if( NETCLASS* netclass = net->GetNetClass() )
+            hash_combine( ret, netclass->GetClearance() );
+    }
+
+    // Custom rules can change any clearance
+    wxFileName rulesFile( aBoard->GetFileName() );
+    rulesFile.SetExt( FILEEXT::DesignRulesFileExtension );
+
+    if( rulesFile.FileExists() )
+    {
+        wxFFile  file( rulesFile.GetFullPath(), wxT( "rb" ) );
+        wxString rules;
+
+        if( file.IsOpened() && file.ReadAll( &rules ) )
+            hash_combine( ret, rules.ToStdString() );
+    }
+
+    auto hashOutlineItem =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                if( aItem->IsOnLayer( Edge_Cuts ) || aItem->IsOnLayer( Margin ) )
+                {
+                    hash_combine( ret, hash_fp_item( aItem, HASH_POS | HASH_LAYER ),
+                                  aItem->GetBoundingBox().GetPosition().x,
+                                  aItem->GetBoundingBox().GetPosition().y );
+                }
+            };
+
+    for( const BOARD_ITEM* item : aBoard->Drawings() )
+    {
+        if( item->Type() == PCB_SHAPE_T )
+            hashOutlineItem( item );
+    }
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( const BOARD_ITEM* item : footprint->GraphicalItems() )
+        {
+            if( item->Type() == PCB_SHAPE_T )
+                hashOutlineItem( item );
+        }
+    }
+
+    return ret;
+}
+
+
+static size_t hashItem( const BOARD_ITEM* aItem )
+{
+    const int flags = HASH_POS | HASH_ROT | HASH_LAYER | HASH_NET;
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_FIELD_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+    case PCB_TABLE_T:
+    case PCB_SHAPE_T:
+    case PCB_BARCODE_T:
+        return hash_fp_item( aItem, flags );
+
+    case PCB_PAD_T:
+    {
+        const PAD* pad = static_cast<const PAD*>( aItem );
+        size_t     ret = hash_fp_item( aItem, flags );
+
+        // Pad overrides of the zone connection
+        hash_combine( ret, static_cast<int>( pad->GetLocalZoneConnection() ),
+                      pad->GetLocalClearance().value_or( -1 ),
+                      pad->GetLocalThermalGapOverride().value_or( -1 ),
+                      pad->GetLocalThermalSpokeWidthOverride().value_or( -1 ),
+                      pad->GetThermalSpokeAngle().AsDegrees() );
+        return ret;
+    }
+
+    case PCB_ZONE_T:
+        return hashZone( static_cast<const ZONE*>( aItem ) );
+
+    default:
+    {
+        // Dimensions and the like: their outline is all that matters
+        size_t ret = 0;
+        BOX2I  bbox = aItem->GetBoundingBox();
+
+        hash_combine( ret, static_cast<int>( aItem->Type() ),
+                      std::hash<BASE_SET>{}( aItem->GetLayerSet() ), bbox.GetX(), bbox.GetY(),
+                      bbox.GetWidth(), bbox.GetHeight() );
+        return ret;
+    }
+    }
+}
+
+
+static void collectItems( const BOARD* aBoard, std::vector<ITEM_HASH>& aItems )
+{
+    LSET copper = LSET::AllCuMask();
+
+    auto add =
+            [&]( const BOARD_ITEM* aItem, bool aAllCopper )
+            {
+                if( !aAllCopper && ( aItem->GetLayerSet() & copper ).none() )
+                    return;
+
+                aItems.push_back( { aItem->GetBoundingBox(), aItem->GetLayerSet(), aAllCopper,
+                                    hashItem( aItem ) } );
+            };
+
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+        add( track, track->Type() == PCB_VIA_T );
+
+    for( const BOARD_ITEM* item : aBoard->Drawings() )
+        add( item, false );
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( const PAD* pad : footprint->Pads() )
+            add( pad, pad->HasHole() );
+
+        for( const BOARD_ITEM* item : footprint->GraphicalItems() )
+            add( item, false );
+
+        for( const PCB_FIELD* field : footprint->GetFields() )
+        {
+            if( field->IsVisible() )
+                add( field, false );
+        }
+
+        for( const ZONE* zone : footprint->Zones() )
+            add( zone, false );
+    }
+}
+
+
+wxString ZONE_FILL_CACHE::CachePath( const BOARD* aBoard )
+{
+    if( aBoard->GetFileName().IsEmpty() )
+        return wxEmptyString;
+
+    wxFileName fn( aBoard->GetFileName() );
+    fn.SetName( fn.GetName() + wxT( "-fill-cache" ) );
+    fn.ClearExt();
+
+    return fn.GetFullPath();
+}
+
+
+std::map<std::pair<const ZONE*, PCB_LAYER_ID>, ZONE_FILL_CACHE::KEY>
+ZONE_FILL_CACHE::ComputeKeys( const BOARD* aBoard, const std::vector<ZONE*>& aZones )
+{
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, KEY> baseKeys;
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, KEY> keys;
+    std::vector<ITEM_HASH>                              items;
+    size_t                                              boardHash = hashBoard( aBoard );
+    int  reach = aBoard->GetDesignSettings().GetBiggestClearanceValue();
+
+    collectItems( aBoard, items );
+
+    // Other zones on the layer knock out of a fill (or get knocked out of), so their inputs are
+    // part of the key too.  Key all of them, not only the ones being filled.
+    auto zoneReach =
+            [&]( const ZONE* aZone )
+            {
+                BOX2I bbox = aZone->GetBoundingBox();
+                bbox.Inflate( reach + aZone->GetThermalReliefGap()
+                              + aZone->GetThermalReliefSpokeWidth() );
+                return bbox;
+            };
+
+    for( const ZONE* zone : aBoard->Zones() )
+    {
+        BOX2I  bbox = zoneReach( zone );
+        size_t zoneHash = hashZone( zone );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+        {
+            std::vector<size_t> hashes;
+
+            for( const ITEM_HASH& item : items )
+            {
+                if( ( item.allCopper || item.layers.test( layer ) ) && item.bbox.Intersects( bbox ) )
+                    hashes.push_back( item.hash );
+            }
+
+            // Make the key independent of the item order in the file
+            std::sort( hashes.begin(), hashes.end() );
+
+            size_t key = boardHash;
+            hash_combine( key, zoneHash, static_cast<int>( layer ) );
+
+            for( size_t hash : hashes )
+                hash_combine( key, hash );
+
+            baseKeys[{ zone, layer }] = key;
+        }
+    }
+
+    for( const ZONE* zone : aZones )
+    {
+        BOX2I bbox = zoneReach( zone );
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+        {
+            auto baseIt = baseKeys.find( { zone, layer } );
+
+            if( baseIt == baseKeys.end() )
+                continue;
+
+            std::vector<size_t> hashes;
+
+            for( const ZONE* other : aBoard->Zones() )
+            {
+                if( other == zone || !other->GetLayerSet().test( layer )
+                        || !zoneReach( other ).Intersects( bbox ) )
+                {
+                    continue;
+                }
+
+                hashes.push_back( baseKeys[{ other, layer }] );
+            }
+
+            std::sort( hashes.begin(), hashes.end() );
+
+            size_t key = baseIt->second;
+
+            for( size_t hash : hashes )
+                hash_combine( key, hash );
+
+            keys[{ zone, layer }] = key;
+        }
+    }
+
+    return keys;
+}
+
+
+bool ZONE_FILL_CACHE::Load( const wxString& aPath )
+{
+    m_entries.clear();
+
+    if( !wxFileName::FileExists( aPath ) )
+        return true;
+
+    wxFFileInputStream inStream( aPath );
+
+    if( !inStream.IsOk() )
+        return false;
+
+    wxDataInputStream data( inStream );
+
+    if( data.ReadString() != wxString( CACHE_MAGIC ) || data.Read32() != CACHE_VERSION )
+        return false;
+
+    uint64_t count = data.Read64();
+
+    for( uint64_t ii = 0; ii < count && inStream.IsOk(); ++ii )
+    {
+        KEY            key = data.Read64();
+        SHAPE_POLY_SET fill;
+        uint32_t       polygons = data.Read32();
+
+        for( uint32_t poly = 0; poly < polygons && inStream.IsOk(); ++poly )
+        {
+            uint32_t contours = data.Read32();
+
+            for( uint32_t contour = 0; contour < contours && inStream.IsOk(); ++contour )
+            {
+                uint32_t         points = data.Read32();
+                SHAPE_LINE_CHAIN chain;
+
+                for( uint32_t pt = 0; pt < points && inStream.IsOk(); ++pt )
+                {
+                    int x = static_cast<int32_t>( data.Read32() );
+                    int y = static_cast<int32_t>( data.Read32() );
+                    chain.Append( x, y );
+                }
+
+                chain.SetClosed( true );
+
+                if( contour == 0 )
+                    fill.AddOutline( chain );
+                else
+                    fill.AddHole( chain );
+            }
+        }
+
+        m_entries[key].fill = std::move( fill );
+    }
+
+    if( !inStream.IsOk() && !inStream.Eof() )
+    {
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool ZONE_FILL_CACHE::Save( const wxString& aPath ) const
+{
+    wxFileName tmpFileName = wxFileName::CreateTempFileName( aPath );
+
+    {
+        wxFFileOutputStream outStream( tmpFileName.GetFullPath() );
+
+        if( !outStream.IsOk() )
+            return false;
+
+        wxDataOutputStream data( outStream );
+        uint64_t           count = 0;
+
+        for( const auto& [key, entry] : m_entries )
+            count += entry.used ? 1 : 0;
+
+        data.WriteString( wxString( CACHE_MAGIC ) );
+        data.Write32( CACHE_VERSION );
+        data.Write64( count );
+
+        // Entries of fills which no longer exist are dropped, so the file does not grow with
+        // every edit.
+        for( const auto& [key, entry] : m_entries )
+        {
+            if( !entry.used )
+                continue;
+
+            data.Write64( key );
+            data.Write32( entry.fill.OutlineCount() );
+
+            for( int ii = 0; ii < entry.fill.OutlineCount(); ++ii )
+            {
+                const SHAPE_POLY_SET::POLYGON& polygon = entry.fill.CPolygon( ii );
+                data.Write32( polygon.size() );
+
+                for( const SHAPE_LINE_CHAIN& chain : polygon )
+                {
+                    data.Write32( chain.PointCount() );
+
+                    for( const VECTOR2I& pt : chain.CPoints() )
+                    {
+                        data.Write32( static_cast<uint32_t>( pt.x ) );
+                        data.Write32( static_cast<uint32_t>( pt.y ) );
+                    }
+                }
+            }
+        }
+
+        if( !outStream.Close() )
+        {
+            wxRemoveFile( tmpFileName.GetFullPath() );
+            return false;
+        }
+    }
+
+    // Preserve the permissions of the current file
+    KIPLATFORM::IO::DuplicatePermissions( aPath, tmpFileName.GetFullPath() );
+
+    if( !wxRenameFile( tmpFileName.GetFullPath(), aPath, true ) )
+    {
+        wxRemoveFile( tmpFileName.GetFullPath() );
+        return false;
+    }
+
+    return true;
+}
+
+
+const SHAPE_POLY_SET* ZONE_FILL_CACHE::Find( KEY aKey )
+{
+    auto it = m_entries.find( aKey );
+
+    if( it == m_entries.end() )
+        return nullptr;
+
+    it->second.used = true;
+    return &it->second.fill;
+}
+
+
+void ZONE_FILL_CACHE::Store( KEY aKey, const SHAPE_POLY_SET& aFill )
+{
+    ENTRY& entry = m_entries[aKey];
+
+    entry.fill = aFill.CloneDropTriangulation();
+    entry.used = true;
+}
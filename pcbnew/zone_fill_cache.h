@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZONE_FILL_CACHE_H
+#define ZONE_FILL_CACHE_H
+
+#include <map>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <layer_ids.h>
+#include <wx/string.h>
+
+class BOARD;
+class ZONE;
+
+
+/**
+ * Content-addressed store of zone fills, kept in a file next to the board.
+ *
+ * Fills are stored under a key hashing everything the fill of a zone layer depends on: the
+ * zone's outline and settings, the copper items and board outline its bounding box overlaps,
+ * the zones it overlaps and the clearance rules.  A fill found under the current key is
+ * exactly what a refill would produce, so it can be used instead of filling the zone again.
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    using KEY = size_t;
+
+    /// @return the cache file of \a aBoard, or an empty string if the board was never saved.
+    static wxString CachePath( const BOARD* aBoard );
+
+    /**
+     * Compute the keys of all layers of \a aZones.
+     *
+     * The keys of the whole board are computed in one go as the items overlapping each zone
+     * are shared between the zones.
+     */
+    static std::map<std::pair<const ZONE*, PCB_LAYER_ID>, KEY>
+    ComputeKeys( const BOARD* aBoard, const std::vector<ZONE*>& aZones );
+
+    /// Replace the contents of the cache with the file \a aPath.  A missing file is not an error.
+    bool Load( const wxString& aPath );
+
+    /// Write the entries stored or found since the last Load() to \a aPath.
+    bool Save( const wxString& aPath ) const;
+
+    /// @return the cached fill for \a aKey, or nullptr.
+    const SHAPE_POLY_SET* Find( KEY aKey );
+
+    void Store( KEY aKey, const SHAPE_POLY_SET& aFill );
+
+    bool IsEmpty() const { return m_entries.empty(); }
+
+private:
+    struct ENTRY
+    {
+        SHAPE_POLY_SET fill;
+        bool           used = false;   ///< Found or stored since the last Load()
+    };
+
+    std::map<KEY, ENTRY> m_entries;
+};
+
+#endif // ZONE_FILL_CACHE_H
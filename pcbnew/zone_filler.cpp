@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
 #include <future>
 #include <set>
 #include <core/kicad_algo.h>
@@ -54,11 +55,13 @@ static const wxChar traceZoneFiller[] = wxT( "KICAD_ZONE_FILLER" );
 #include <geometry/shape_poly_set.h>
 #include <geometry/convex_hull.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/vertex_set.h>
 #include <kidialog.h>
 #include <thread_pool.h>
 #include <math/util.h>      // for KiROUND
 #include "zone_filler.h"
+#include "zone_fill_cache.h"
 #include "project.h"
 #include "project/project_local_settings.h"
 #include "pcb_barcode.h"
@@ -211,7 +214,8 @@ ZONE_FILLER::ZONE_FILLER( BOARD* aBoard, COMMIT* aCommit ) :
         m_brdOutlinesValid( false ),
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_fillCache( nullptr )
 {
     m_maxError = aBoard->GetDesignSettings().m_MaxError;
 
@@ -232,6 +236,118 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
 }
 
 
+void ZONE_FILLER::SetDirtyRegions( const ZONE* aZone, const std::vector<BOX2I>& aRegions )
+{
+    std::vector<BOX2I>& regions = m_dirtyRegions[aZone];
+    regions.insert( regions.end(), aRegions.begin(), aRegions.end() );
+}
+
+
+void ZONE_FILLER::preparePartialFills( const std::vector<ZONE*>& aZones )
+{
+    m_partialFills.clear();
+
+    if( m_dirtyRegions.empty() || m_debugZoneFiller )
+        return;
+
+    for( ZONE* zone : aZones )
+    {
+        auto regionsIt = m_dirtyRegions.find( zone );
+
+        if( regionsIt == m_dirtyRegions.end() || !zone->IsFilled() || zone->NeedRefill() )
+            continue;
+
+        // Hatch patterns are aligned to the whole zone, so those are always refilled completely
+        if( !zone->IsOnCopperLayer() || zone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+            continue;
+
+        // Islands removed from the previous fill are not in it anymore, so an edit reconnecting
+        // one could not restore it.  Refill those zones completely.
+        if( zone->GetIslandRemovalMode() != ISLAND_REMOVAL_MODE::NEVER )
+            continue;
+
+        // The recomputed window needs the influence margin again so that its artificial edges
+        // do not reach into the part that is spliced back.
+        int margin = fillInfluence( zone );
+
+        BOX2I zoneBBox = zone->GetBoundingBox();
+        zoneBBox.Inflate( margin );
+
+        SHAPE_POLY_SET core;
+
+        for( BOX2I region : regionsIt->second )
+        {
+            region.Inflate( margin );
+
+            if( !region.Intersects( zoneBBox ) )
+                continue;
+
+            int outline = core.NewOutline();
+            core.Append( region.GetLeft(), region.GetTop(), outline );
+            core.Append( region.GetRight(), region.GetTop(), outline );
+            core.Append( region.GetRight(), region.GetBottom(), outline );
+            core.Append( region.GetLeft(), region.GetBottom(), outline );
+        }
+
+        core.Simplify();
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet() )
+        {
+            PARTIAL_FILL& partial = m_partialFills[{ zone, layer }];
+
+            partial.previousFill = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+            partial.unchanged = core.IsEmpty();
+
+            if( !partial.unchanged )
+            {
+                partial.core = core;
+                partial.window = core;
+                partial.window.Inflate( margin, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, m_maxError );
+                partial.windowBBox = partial.window.BBox();
+            }
+        }
+
+        wxLogTrace( traceZoneFiller, wxT( "Partial refill of zone %s: %zu dirty regions" ),
+                    zone->GetNetname(), regionsIt->second.size() );
+    }
+
+    m_dirtyRegions.clear();
+}
+
+
+bool ZONE_FILLER::fillFromCache( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys )
+{
+    auto keyIt = m_fillCacheKeys.find( { aZone, aLayer } );
+
+    if( keyIt == m_fillCacheKeys.end() )
+        return false;
+
+    std::lock_guard<std::mutex> lock( m_cacheMutex );
+
+    if( const SHAPE_POLY_SET* cached = m_fillCache->Find( keyIt->second ) )
+    {
+        // Cached fills already had their islands removed, which finds nothing more to remove
+        aFillPolys = *cached;
+        aZone->SetNeedRefill( false );
+
+        wxLogTrace( traceZoneFiller, wxT( "Zone %s layer %d: fill reused from cache" ),
+                    aZone->GetNetname(), static_cast<int>( aLayer ) );
+        return true;
+    }
+
+    return false;
+}
+
+
+int ZONE_FILLER::fillInfluence( const ZONE* aZone ) const
+{
+    // Clearance knockout, thermal reliefs, and the min-width deflate/re-inflate and
+    // nearby-polygon bridging.
+    return m_worstClearance + aZone->GetThermalReliefGap() + aZone->GetThermalReliefSpokeWidth()
+           + 2 * aZone->GetMinThickness() + m_maxError;
+}
+
+
 /**
  * Fills the given list of zones.
  *
@@ -295,12 +411,53 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
             zone->CacheBoundingBox();
 
         // Rules may depend on insideCourtyard() or other expressions
-        footprint->BuildCourtyardCaches();
+        footprint->EnsureCourtyardCaches();
         footprint->BuildNetTieCache();
     }
 
     LSET boardCuMask = LSET::AllCuMask( m_board->GetCopperLayerCount() );
 
+    // Index the zones by their boxes so that flashing each pad and via below only looks at the
+    // zones around it.  Items are board zone indices, so candidates can be visited in board
+    // order and ties between zones of the same priority resolve as before.
+    const ZONES&         boardZones = m_board->Zones();
+    PACKED_RTREE<size_t> fillZoneTree;
+    PACKED_RTREE<size_t> keepoutZoneTree;
+
+    for( size_t ii = 0; ii < boardZones.size(); ++ii )
+    {
+        ZONE* zone = boardZones[ii];
+
+        // Degenerate zones will cause trouble; skip them
+        if( zone->GetNumCorners() <= 2 )
+            continue;
+
+        if( !zone->GetIsRuleArea() )
+            fillZoneTree.Add( zone->GetBoundingBox(), ii );
+        else if( zone->HasKeepoutParametersSet() && zone->GetDoNotAllowZoneFills() )
+            keepoutZoneTree.Add( zone->GetBoundingBox(), ii );
+    }
+
+    fillZoneTree.Build();
+    keepoutZoneTree.Build();
+
+    auto zonesAround =
+            []( const PACKED_RTREE<size_t>& aTree, const BOX2I& aBox )
+            {
+                std::vector<size_t> found;
+
+                auto collect =
+                        [&]( size_t aIdx )
+                        {
+                            found.push_back( aIdx );
+                            return true;
+                        };
+
+                aTree.Search( aBox, collect );
+                std::sort( found.begin(), found.end() );
+                return found;
+            };
+
     auto findHighestPriorityZone =
             [&]( const BOX2I& bbox, PCB_LAYER_ID itemLayer, int netcode,
                  const std::function<bool( const ZONE* )>& testFn ) -> ZONE*
@@ -308,11 +465,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 unsigned highestPriority = 0;
                 ZONE*    highestPriorityZone = nullptr;
 
-                for( ZONE* zone : m_board->Zones() )
+                for( size_t idx : zonesAround( fillZoneTree, bbox ) )
                 {
-                    // Rule areas are not filled
-                    if( zone->GetIsRuleArea() )
-                        continue;
+                    ZONE* zone = boardZones[idx];
 
                     if( zone->GetAssignedPriority() < highestPriority )
                         continue;
@@ -320,10 +475,6 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                     if( !zone->IsOnLayer( itemLayer ) )
                         continue;
 
-                    // Degenerate zones will cause trouble; skip them
-                    if( zone->GetNumCorners() <= 2 )
-                        continue;
-
                     if( !zone->GetBoundingBox().Intersects( bbox ) )
                         continue;
 
@@ -345,24 +496,13 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
     auto isInPourKeepoutArea =
             [&]( const BOX2I& bbox, PCB_LAYER_ID itemLayer, const VECTOR2I& testPoint ) -> bool
             {
-                for( ZONE* zone : m_board->Zones() )
+                for( size_t idx : zonesAround( keepoutZoneTree, bbox ) )
                 {
-                    if( !zone->GetIsRuleArea() )
-                        continue;
-
-                    if( !zone->HasKeepoutParametersSet() )
-                        continue;
-
-                    if( !zone->GetDoNotAllowZoneFills() )
-                        continue;
+                    ZONE* zone = boardZones[idx];
 
                     if( !zone->IsOnLayer( itemLayer ) )
                         continue;
 
-                    // Degenerate zones will cause trouble; skip them
-                    if( zone->GetNumCorners() <= 2 )
-                        continue;
-
                     if( !zone->GetBoundingBox().Intersects( bbox ) )
                         continue;
 
@@ -473,6 +613,15 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         }
     }
 
+    // Checking fills must not trust the fills it is checking
+    if( !aCheck )
+        preparePartialFills( aZones );
+
+    m_fillCacheKeys.clear();
+
+    if( m_fillCache && !aCheck )
+        m_fillCacheKeys = ZONE_FILL_CACHE::ComputeKeys( m_board, aZones );
+
     for( ZONE* zone : aZones )
     {
         // Rule areas are not filled
@@ -581,8 +730,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
 
                     SHAPE_POLY_SET fillPolys;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
+                    if( !fillFromCache( zone, layer, fillPolys )
+                            && !fillSingleZone( zone, layer, fillPolys ) )
+                    {
                         return 0;
+                    }
 
                     zone->SetFilledPolysList( layer, fillPolys );
                 }
@@ -630,7 +782,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 [&, fillItem]()
                 {
                     return fill_lambda( fillItem );
-                } ), 0 ) );
+                }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) ), 0 ) );
     }
 
     while( !cancelled && finished != 2 * toFill.size() )
@@ -661,7 +813,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                                 [&, idx = ii]()
                                 {
                                     return fill_lambda( toFill[idx] );
-                                } );
+                                }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
                     }
                     else if( ret.second == 1 )
                     {
@@ -669,7 +821,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                                 [&, idx = ii]()
                                 {
                                     return tesselate_lambda( toFill[idx] );
-                                } );
+                                }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
                     }
                 }
             }
@@ -889,6 +1041,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 m_progressReporter->KeepRefreshing();
             }
 
+            // Partial fills only cached their refill window, and the space freed by the
+            // removed islands may lie outside of it; those get a complete fill instead.
+            for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : zonesToRefill )
+                m_partialFills.erase( fillItem );
+
             // Refill using cached pre-knockout fills - much faster than full refill
             // since we only need to re-apply the higher-priority zone knockout
             auto cached_refill_lambda =
@@ -898,8 +1055,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                         PCB_LAYER_ID layer = aFillItem.second;
                         SHAPE_POLY_SET fillPolys;
 
-                        if( !refillZoneFromCache( zone, layer, fillPolys ) )
+                        if( !refillZoneFromCache( zone, layer, fillPolys )
+                                && !fillSingleZone( zone, layer, fillPolys ) )
+                        {
                             return 0;
+                        }
 
                         wxLogTrace( traceZoneFiller,
                                     wxT( "Cached refill for zone %s: %d outlines, area %.0f" ),
@@ -920,7 +1080,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                         [&, fillItem]()
                         {
                             return cached_refill_lambda( fillItem );
-                        } ), 0 ) );
+                        }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) ), 0 ) );
             }
 
             while( !cancelled && refillFinished != 2 * zonesToRefill.size() )
@@ -950,7 +1110,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                                         [&, idx = ii]()
                                         {
                                             return cached_refill_lambda( zonesToRefill[idx] );
-                                        } );
+                                        }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
                             }
                             else if( ret.second == 1 )
                             {
@@ -958,7 +1118,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                                         [&, idx = ii]()
                                         {
                                             return tesselate_lambda( zonesToRefill[idx] );
-                                        } );
+                                        }, PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
                             }
                         }
                     }
@@ -1125,7 +1285,8 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
                 return retval;
             };
 
-    auto island_returns = tp.submit_blocks( 0, polys_to_check.size(), island_lambda );
+    auto island_returns = tp.submit_blocks( 0, polys_to_check.size(), island_lambda, 0,
+                                          PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
     cancelled = false;
 
     // Allow island removal threads to finish
@@ -1336,6 +1497,18 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE*>& aZones, bool aCheck, wxWindow*
         m_progressReporter->KeepRefreshing();
     }
 
+    // Cache the final fills, after island removal
+    if( m_fillCache )
+    {
+        for( const auto& [zone, layer] : toFill )
+        {
+            auto keyIt = m_fillCacheKeys.find( { zone, layer } );
+
+            if( keyIt != m_fillCacheKeys.end() && zone->HasFilledPolysForLayer( layer ) )
+                m_fillCache->Store( keyIt->second, *zone->GetFilledPolysList( layer ) );
+        }
+    }
+
     return true;
 }
 
@@ -1477,6 +1650,7 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aGap,
  * in spokes, which must be done later.
  */
 void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                          const BOX2I& aFillArea,
                                           SHAPE_POLY_SET& aFill,
                                           std::vector<BOARD_ITEM*>& aThermalConnectionPads,
                                           std::vector<PAD*>& aNoConnectionPads )
@@ -1488,6 +1662,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
     std::shared_ptr<SHAPE> padShape;
     int                    holeClearance;
     SHAPE_POLY_SET         holes;
+    const BOX2I&           zoneBBox = aFillArea;
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
@@ -1499,7 +1674,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
             BOX2I padBBox = pad->GetBoundingBox();
             padBBox.Inflate( m_worstClearance );
 
-            if( !padBBox.Intersects( aZone->GetBoundingBox() ) )
+            if( !padBBox.Intersects( zoneBBox ) )
                 continue;
 
             bool noConnection = pad->GetNetCode() != aZone->GetNetCode();
@@ -1648,7 +1823,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
                 BOX2I viaBBox = via->GetBoundingBox();
                 viaBBox.Inflate( m_worstClearance );
 
-                if( !viaBBox.Intersects( aZone->GetBoundingBox() ) )
+                if( !viaBBox.Intersects( zoneBBox ) )
                     continue;
 
                 bool noConnection = via->GetNetCode() != aZone->GetNetCode()
@@ -1718,6 +1893,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                             const BOX2I& aFillArea,
                                              const std::vector<PAD*>& aNoConnectionPads,
                                              SHAPE_POLY_SET& aHoles,
                                              bool aIncludeZoneClearances )
@@ -1734,7 +1910,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // A small extra clearance to be sure actual track clearances are not smaller than
     // requested clearance due to many approximations in calculations, like arc to segment
     // approx, rounding issues, etc.
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aFillArea;
     int   extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
@@ -2173,12 +2349,12 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
  * This is separated from buildCopperItemClearances to allow caching before zone knockouts.
  */
 void ZONE_FILLER::buildDifferentNetZoneClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                                   SHAPE_POLY_SET& aHoles )
+                                                   const BOX2I& aFillArea, SHAPE_POLY_SET& aHoles )
 {
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
     int extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aFillArea;
     zone_boundingbox.Inflate( m_worstClearance + extra_margin );
 
     auto evalRulesForItems =
@@ -2400,7 +2576,8 @@ void ZONE_FILLER::connect_nearby_polys( SHAPE_POLY_SET& aPolys, double aDistance
  */
 bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
                                   const SHAPE_POLY_SET& aSmoothedOutline,
-                                  const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys )
+                                  const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aFillArea,
+                                  SHAPE_POLY_SET& aFillPolys )
 {
     m_maxError = m_board->GetDesignSettings().m_MaxError;
 
@@ -2438,7 +2615,8 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout thermal reliefs.
      */
 
-    knockoutThermalReliefs( aZone, aLayer, aFillPolys, thermalConnectionPads, noConnectionPads );
+    knockoutThermalReliefs( aZone, aLayer, aFillArea, aFillPolys, thermalConnectionPads,
+                            noConnectionPads );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In2_Cu, wxT( "minus-thermal-reliefs" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -2467,7 +2645,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     // the fill before zone knockouts are applied (issue 21746).
     const bool iterativeRefill = ADVANCED_CFG::GetCfg().m_ZoneFillIterativeRefill;
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles,
+    buildCopperItemClearances( aZone, aLayer, aFillArea, noConnectionPads, clearanceHoles,
                                !iterativeRefill /* include zone clearances only if not iterative */ );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
@@ -2503,19 +2681,29 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes to speed
-    // things up a bit.
-    testAreas.BuildBBoxCaches();
+    // Spoke-end-testing is hugely expensive, so all the spoke ends are hit-tested against the
+    // zone body in one batch.
+    std::vector<VECTOR2I> spokeEnds;
+    std::vector<uint8_t>  spokeEndInZone;
+
+    spokeEnds.reserve( thermalSpokes.size() );
+
+    for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
+        spokeEnds.push_back( spoke.CPoint( 3 ) );
+
+    testAreas.ContainsPoints( spokeEnds, spokeEndInZone, 1 );
+
     int interval = 0;
 
     SHAPE_POLY_SET debugSpokes;
 
-    for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
+    for( size_t spokeIdx = 0; spokeIdx < thermalSpokes.size(); ++spokeIdx )
     {
-        const VECTOR2I& testPt = spoke.CPoint( 3 );
+        const SHAPE_LINE_CHAIN& spoke = thermalSpokes[spokeIdx];
+        const VECTOR2I&         testPt = spokeEnds[spokeIdx];
 
         // Hit-test against zone body
-        if( testAreas.Contains( testPt, -1, 1, USE_BBOX_CACHES ) )
+        if( spokeEndInZone[spokeIdx] )
         {
             if( m_debugZoneFiller )
                 debugSpokes.AddOutline( spoke );
@@ -2563,7 +2751,10 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      */
 
     if( half_min_width - epsilon > epsilon )
-        aFillPolys.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError );
+    {
+        aFillPolys.Deflate( half_min_width - epsilon, fastCornerStrategy, m_maxError,
+                            KiCadParallelFor );
+    }
 
     // Min-thickness is the web thickness.  On the other hand, a blob min-thickness by
     // min-thickness is not useful.  Since there's no obvious definition of web vs. blob, we
@@ -2622,7 +2813,10 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      */
 
     if( half_min_width - epsilon > epsilon )
-        aFillPolys.Inflate( half_min_width - epsilon, cornerStrategy, m_maxError, true );
+    {
+        aFillPolys.Inflate( half_min_width - epsilon, cornerStrategy, m_maxError, true,
+                            KiCadParallelFor );
+    }
 
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In15_Cu, wxT( "after-reinflating" ) );
 
@@ -2667,7 +2861,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
 
         // Now apply zone-to-zone knockouts for different-net zones
         SHAPE_POLY_SET zoneClearances;
-        buildDifferentNetZoneClearances( aZone, aLayer, zoneClearances );
+        buildDifferentNetZoneClearances( aZone, aLayer, aFillArea, zoneClearances );
 
         if( zoneClearances.OutlineCount() > 0 )
             aFillPolys.BooleanSubtract( zoneClearances );
@@ -2814,17 +3008,74 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
         aLayer = F_Cu;
     }
 
+    auto                partialIt = m_partialFills.find( { aZone, aLayer } );
+    const PARTIAL_FILL* partial = partialIt != m_partialFills.end() ? &partialIt->second : nullptr;
+
+    if( partial && partial->unchanged )
+    {
+        aFillPolys = partial->previousFill;
+        aZone->SetNeedRefill( false );
+        return true;
+    }
+
+    std::unique_lock<std::mutex> tileLock;
+
+    if( !partial && fillTileSize( aZone ) > 0 )
+    {
+        tileLock = std::unique_lock<std::mutex>( m_tiledFillMutex, std::try_to_lock );
+
+        // Another zone is being tiled; the caller will try again
+        if( !tileLock.owns_lock() )
+            return false;
+    }
+
     if( !aZone->BuildSmoothedPoly( maxExtents, aLayer, boardOutline, &smoothedPoly ) )
         return false;
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    if( aZone->IsOnCopperLayer() )
+    if( partial )
     {
-        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
+        // Only the window is recomputed, which also keeps the knockouts of everything outside
+        // of it out of the boolean operations.
+        smoothedPoly.BooleanIntersection( partial->window );
+        maxExtents.BooleanIntersection( partial->window );
+    }
+
+    if( aZone->IsOnCopperLayer() && tileLock.owns_lock() )
+    {
+        if( fillTiledCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
             aZone->SetNeedRefill( false );
     }
+    else if( aZone->IsOnCopperLayer() )
+    {
+        BOX2I fillArea = aZone->GetBoundingBox();
+
+        if( partial )
+            fillArea = fillArea.Intersect( partial->windowBBox );
+
+        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, fillArea,
+                            aFillPolys ) )
+        {
+            aZone->SetNeedRefill( false );
+        }
+
+        if( partial )
+        {
+            // Splice the recomputed core into the previous fill
+            SHAPE_POLY_SET kept = partial->previousFill.CloneDropTriangulation();
+            kept.BooleanSubtract( partial->core );
+
+            aFillPolys.BooleanIntersection( partial->core );
+            aFillPolys.BooleanAdd( kept );
+            aFillPolys.Fracture();
+
+            // The cached pre-knockout fill only covers the window
+            std::lock_guard<std::mutex> lock( m_cacheMutex );
+            m_preKnockoutFillCache.erase( { aZone, aLayer } );
+        }
+    }
     else
     {
         if( fillNonCopperZone( aZone, aLayer, smoothedPoly, aFillPolys ) )
@@ -2835,6 +3086,134 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
 }
 
 
+int ZONE_FILLER::fillTileSize( const ZONE* aZone ) const
+{
+    int tileSize = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ZoneFillTileSize );
+
+    // The worker filling the zone waits for its tiles, so they need other workers to run on
+    if( tileSize <= 0 || m_debugZoneFiller || GetKiCadThreadPool().get_thread_count() < 2 )
+        return 0;
+
+    // Hatch patterns are aligned to the whole zone
+    if( !aZone->IsOnCopperLayer() || aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+        return 0;
+
+    // Tiles smaller than their own margin would mostly recompute their neighbours
+    tileSize = std::max( tileSize, 4 * fillInfluence( aZone ) );
+
+    if( aZone->GetBoundingBox().GetSizeMax() <= tileSize )
+        return 0;
+
+    return tileSize;
+}
+
+
+bool ZONE_FILLER::fillTiledCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                       PCB_LAYER_ID aDebugLayer,
+                                       const SHAPE_POLY_SET& aSmoothedOutline,
+                                       const SHAPE_POLY_SET& aMaxExtents,
+                                       SHAPE_POLY_SET& aFillPolys )
+{
+    const int   tileSize = fillTileSize( aZone );
+    const int   margin = fillInfluence( aZone );
+    const BOX2I bbox = aSmoothedOutline.BBox();
+    const int   cols = ( bbox.GetWidth() + tileSize - 1 ) / tileSize;
+    const int   rows = ( bbox.GetHeight() + tileSize - 1 ) / tileSize;
+
+    auto rectPoly =
+            []( const BOX2I& aBox )
+            {
+                SHAPE_POLY_SET poly;
+                int            outline = poly.NewOutline();
+
+                poly.Append( aBox.GetLeft(), aBox.GetTop(), outline );
+                poly.Append( aBox.GetRight(), aBox.GetTop(), outline );
+                poly.Append( aBox.GetRight(), aBox.GetBottom(), outline );
+                poly.Append( aBox.GetLeft(), aBox.GetBottom(), outline );
+                return poly;
+            };
+
+    std::vector<BOX2I> tiles;
+
+    for( int row = 0; row < rows; ++row )
+    {
+        for( int col = 0; col < cols; ++col )
+        {
+            VECTOR2I origin( bbox.GetX() + col * tileSize, bbox.GetY() + row * tileSize );
+            BOX2I    tile( origin, VECTOR2I( tileSize, tileSize ) );
+
+            // Cores must abut exactly so that merging them leaves no seams
+            tiles.push_back( tile.Intersect( bbox ) );
+        }
+    }
+
+    std::vector<SHAPE_POLY_SET> tileFills( tiles.size() );
+    std::atomic<bool>           cancelled( false );
+
+    auto fillTile =
+            [&]( size_t aIndex )
+            {
+                if( cancelled )
+                    return;
+
+                // Each tile is filled with the full influence margin around it, so its core
+                // comes out the same as in an untiled fill.
+                BOX2I window = tiles[aIndex];
+                window.Inflate( margin );
+
+                SHAPE_POLY_SET windowPoly = rectPoly( window );
+                SHAPE_POLY_SET outline = aSmoothedOutline.CloneDropTriangulation();
+                SHAPE_POLY_SET extents = aMaxExtents.CloneDropTriangulation();
+
+                outline.BooleanIntersection( windowPoly );
+
+                if( outline.IsEmpty() )
+                    return;
+
+                extents.BooleanIntersection( windowPoly );
+
+                SHAPE_POLY_SET& tileFill = tileFills[aIndex];
+
+                if( !fillCopperZone( aZone, aLayer, aDebugLayer, outline, extents,
+                                     window.Intersect( aZone->GetBoundingBox() ), tileFill ) )
+                {
+                    cancelled = true;
+                    return;
+                }
+
+                tileFill.BooleanIntersection( rectPoly( tiles[aIndex] ) );
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    auto         returns = tp.submit_loop( 0, tiles.size(), fillTile, 0,
+                                           PoolPriority( TASK_PRIORITY::INTERACTIVE ) );
+    returns.wait();
+
+    // The pre-knockout fill cached by the last tile only covers that tile
+    {
+        std::lock_guard<std::mutex> lock( m_cacheMutex );
+        m_preKnockoutFillCache.erase( { aZone, aLayer } );
+    }
+
+    if( cancelled )
+        return false;
+
+    aFillPolys.RemoveAllContours();
+
+    for( const SHAPE_POLY_SET& tileFill : tileFills )
+        aFillPolys.Append( tileFill );
+
+    // Merge the polygons split at the tile edges
+    aFillPolys.Simplify();
+    aFillPolys.Fracture();
+
+    wxLogTrace( traceZoneFiller, wxT( "Zone %s layer %d filled in %zu tiles" ),
+                aZone->GetNetname(), static_cast<int>( aLayer ), tiles.size() );
+
+    return true;
+}
+
+
 /**
  * Function buildThermalSpokes
  */
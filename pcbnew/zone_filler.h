@@ -36,6 +36,7 @@ class PROGRESS_REPORTER;
 class BOARD;
 class COMMIT;
 class SHAPE_LINE_CHAIN;
+class ZONE_FILL_CACHE;
 
 
 class ZONE_FILLER
@@ -59,6 +60,21 @@ public:
      */
     bool Fill( const std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
+    /**
+     * Limit the next Fill() of an already filled zone to the areas around \a aRegions (usually
+     * the before and after bounding boxes of the items changed by a commit).
+     *
+     * Only the part of the fill that the regions can influence is recomputed; the rest of the
+     * existing fill is kept as is.  Zones without dirty regions are filled completely.
+     */
+    void SetDirtyRegions( const ZONE* aZone, const std::vector<BOX2I>& aRegions );
+
+    /**
+     * Reuse the fills of \a aCache whose inputs did not change, and store the new fills in it.
+     * Not used when checking fills.
+     */
+    void SetFillCache( ZONE_FILL_CACHE* aCache ) { m_fillCache = aCache; }
+
     bool IsDebug() const { return m_debugZoneFiller; }
 
 private:
@@ -70,11 +86,13 @@ private:
 
     void addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFill,
+    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aFillArea,
+                                 SHAPE_POLY_SET& aFill,
                                  std::vector<BOARD_ITEM*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
     void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                    const BOX2I& aFillArea,
                                     const std::vector<PAD*>& aNoConnectionPads,
                                     SHAPE_POLY_SET& aHoles,
                                     bool aIncludeZoneClearances = true );
@@ -84,7 +102,7 @@ private:
      * Separated from buildCopperItemClearances to allow caching before zone knockouts.
      */
     void buildDifferentNetZoneClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                          SHAPE_POLY_SET& aHoles );
+                                          const BOX2I& aFillArea, SHAPE_POLY_SET& aHoles );
 
     void subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                       SHAPE_POLY_SET& aRawFill );
@@ -98,11 +116,25 @@ private:
      * The filled copper area must be computed before
      * BuildFilledSolidAreasPolygons() call this function just after creating the
      *  filled copper area polygon (without clearance areas
-     * @param aPcb: the current board
+     * @param aFillArea is the area knockouts are collected from (the zone's bounding box, or
+     *                  the window of a partial or tiled fill).
      */
     bool fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
                          const SHAPE_POLY_SET& aSmoothedOutline,
-                         const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
+                         const SHAPE_POLY_SET& aMaxExtents, const BOX2I& aFillArea,
+                         SHAPE_POLY_SET& aFillPolys );
+
+    /**
+     * Fill a copper zone layer in tiles on the thread pool and merge the tiles.
+     *
+     * @return false if the fill was cancelled.
+     */
+    bool fillTiledCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
+                              const SHAPE_POLY_SET& aSmoothedOutline,
+                              const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
+
+    /// @return the tile size to fill \a aZone with, or 0 if it is to be filled as a whole.
+    int fillTileSize( const ZONE* aZone ) const;
 
     bool fillNonCopperZone( const ZONE* candidate, PCB_LAYER_ID aLayer,
                             const SHAPE_POLY_SET& aSmoothedOutline, SHAPE_POLY_SET& aFillPolys );
@@ -145,6 +177,21 @@ private:
      */
     bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
 
+    /**
+     * Work out which part of each zone layer with dirty regions has to be refilled, and keep
+     * the existing fill to splice the result into.  Must be called before the zones are unfilled.
+     */
+    void preparePartialFills( const std::vector<ZONE*>& aZones );
+
+    /**
+     * Distance over which a changed item can influence the fill of \a aZone.  Partial and
+     * tiled fills recompute this much around the area they keep.
+     */
+    int fillInfluence( const ZONE* aZone ) const;
+
+    /// Fill \a aZone on \a aLayer from the fill cache if its inputs did not change.
+    bool fillFromCache( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
+
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
      * in filled areas of aZone, giving to the filled polygons a fill style like a grid
@@ -177,6 +224,27 @@ private:
     // Key: (zone pointer, layer), Value: fill polygon before higher-priority zone knockout
     std::map<std::pair<const ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET> m_preKnockoutFillCache;
     mutable std::mutex                                             m_cacheMutex;
+
+    struct PARTIAL_FILL
+    {
+        SHAPE_POLY_SET previousFill;   ///< The fill before the refill
+        SHAPE_POLY_SET core;           ///< Area whose fill is replaced
+        SHAPE_POLY_SET window;         ///< Area that is actually recomputed (core plus margin)
+        BOX2I          windowBBox;
+        bool           unchanged;      ///< No dirty region reaches this layer of the zone
+    };
+
+    std::map<const ZONE*, std::vector<BOX2I>> m_dirtyRegions;
+
+    // Written before the fill threads start, read-only while they run
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, PARTIAL_FILL> m_partialFills;
+
+    ZONE_FILL_CACHE*                                             m_fillCache;
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, size_t>       m_fillCacheKeys;
+
+    // Only one zone is tiled at a time: its worker thread blocks until the tiles are done, and
+    // the remaining workers must be free to fill them.
+    std::mutex                                                   m_tiledFillMutex;
 };
 
 #endif
@@ -22,8 +22,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <algorithm>
 #include <memory>
 #include <optional>
+#include <unordered_set>
 #include <wx/dataview.h>
 #include <wx/debug.h>
 #include <wx/event.h>
@@ -79,6 +81,12 @@ DIALOG_ZONE_MANAGER::DIALOG_ZONE_MANAGER( PCB_BASE_FRAME* aParent ) :
     m_modelZonesOverview = new MODEL_ZONES_OVERVIEW( this, m_pcbFrame, m_zoneSettingsBag );
     m_viewZonesOverview->AssociateModel( m_modelZonesOverview.get() );
 
+    // Don't use GetBoundingBox(): the board would cache the boxes of the clones
+    for( ZONE* zone : m_zoneSettingsBag.GetClonedZoneList() )
+        m_clonedZoneTree.Add( zone->Outline()->BBox(), zone );
+
+    m_clonedZoneTree.Build();
+
 #if wxUSE_DRAG_AND_DROP
     m_viewZonesOverview->EnableDragSource( wxDF_UNICODETEXT );
     m_viewZonesOverview->EnableDropTarget( wxDF_UNICODETEXT );
@@ -360,6 +368,15 @@ void DIALOG_ZONE_MANAGER::OnUpdateDisplayedZonesClick( wxCommandEvent& aEvent )
     m_panelZoneProperties->TransferZoneSettingsFromWindow();
     m_zoneSettingsBag.UpdateClonedZones();
 
+    std::vector<ZONE*> toFill = zonesToRefill();
+
+    if( toFill.empty() )
+    {
+        m_zonePreviewNotebook->OnZoneSelectionChanged( m_panelZoneProperties->GetZone() );
+        m_isFillingZones = false;
+        return;
+    }
+
     BOARD* board = m_pcbFrame->GetBoard();
     board->IncrementTimeStamp();
 
@@ -379,9 +396,18 @@ void DIALOG_ZONE_MANAGER::OnUpdateDisplayedZonesClick( wxCommandEvent& aEvent )
     // in case this code is refactored to be a non-modal dialog in the future.
     const_cast<ZONES&>( board->Zones() ) = m_zoneSettingsBag.GetClonedZoneList();
 
-    m_zoneFillComplete = m_filler->Fill( board->Zones() );
+    m_zoneFillComplete = m_filler->Fill( toFill );
     board->BuildConnectivity();
 
+    // The zones to fill are unfilled first, so an aborted fill leaves them all out of date
+    for( ZONE* zone : toFill )
+    {
+        if( m_zoneFillComplete )
+            m_filledSettings[zone] << *zone;
+        else
+            m_filledSettings.erase( zone );
+    }
+
     m_zonePreviewNotebook->OnZoneSelectionChanged( m_panelZoneProperties->GetZone() );
 
     // Restore the original zones. The connectivity MUST be rebuilt to remove stale pointers to
@@ -393,6 +419,63 @@ void DIALOG_ZONE_MANAGER::OnUpdateDisplayedZonesClick( wxCommandEvent& aEvent )
 }
 
 
+std::vector<ZONE*> DIALOG_ZONE_MANAGER::zonesToRefill()
+{
+    const std::vector<ZONE*>& zones = m_zoneSettingsBag.GetClonedZoneList();
+    int                       maxClearance = m_pcbFrame->GetBoard()->GetMaxClearanceValue();
+    std::vector<ZONE*>        changed;
+    std::unordered_set<ZONE*> affected;
+
+    for( ZONE* zone : zones )
+    {
+        ZONE_SETTINGS settings;
+        settings << *zone;
+
+        auto it = m_filledSettings.find( zone );
+
+        if( it == m_filledSettings.end() || it->second != settings )
+            changed.push_back( zone );
+
+        maxClearance = std::max( maxClearance, zone->GetLocalClearance().value_or( 0 ) );
+    }
+
+    // A fill is knocked out by the other zones around it, so when a zone changes (including its
+    // priority) its neighbours on the layers it had or has now are refilled too.
+    for( ZONE* zone : changed )
+    {
+        LSET layers = zone->GetLayerSet();
+
+        if( auto it = m_filledSettings.find( zone ); it != m_filledSettings.end() )
+            layers |= it->second.m_Layers;
+
+        BOX2I box = zone->Outline()->BBox();
+        box.Inflate( maxClearance );
+
+        auto visitor =
+                [&]( ZONE* aOther )
+                {
+                    if( ( aOther->GetLayerSet() & layers ).any() )
+                        affected.insert( aOther );
+
+                    return true;
+                };
+
+        affected.insert( zone );
+        m_clonedZoneTree.Search( box, visitor );
+    }
+
+    std::vector<ZONE*> toRefill;
+
+    for( ZONE* zone : zones )
+    {
+        if( affected.count( zone ) )
+            toRefill.push_back( zone );
+    }
+
+    return toRefill;
+}
+
+
 void DIALOG_ZONE_MANAGER::OnZoneNameUpdate( wxCommandEvent& aEvent )
 {
     if( ZONE* zone = m_panelZoneProperties->GetZone() )
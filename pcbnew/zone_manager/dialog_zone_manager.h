@@ -26,6 +26,8 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 #include <wx/dataview.h>
 #include <wx/event.h>
 #include <wx/radiobut.h>
@@ -34,7 +36,9 @@
 #include <pcb_edit_frame.h>
 #include <pcbnew_settings.h>
 #include <zones.h>
+#include <zone_settings.h>
 #include <zone_settings_bag.h>
+#include <geometry/packed_rtree.h>
 #include <widgets/unit_binder.h>
 #include <zone.h>
 #include <pad.h>
@@ -103,6 +107,12 @@ private:
 
     void OnIdle( wxIdleEvent& aEvent );
 
+    /**
+     * @return the cloned zones whose preview fill may be out of date: the zones whose settings
+     *         changed since their last fill, and the zones sharing a layer with them nearby.
+     */
+    std::vector<ZONE*> zonesToRefill();
+
 private:
     PCB_BASE_FRAME*                       m_pcbFrame;
     ZONE_SETTINGS_BAG                     m_zoneSettingsBag;
@@ -113,4 +123,7 @@ private:
     std::unique_ptr<ZONE_FILLER>          m_filler;
     bool                                  m_isFillingZones;
     bool                                  m_zoneFillComplete;
+
+    PACKED_RTREE<ZONE*>                      m_clonedZoneTree;  ///< Outlines can't change here
+    std::unordered_map<ZONE*, ZONE_SETTINGS> m_filledSettings;  ///< Clone : settings at last fill
 };
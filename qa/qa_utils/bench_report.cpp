@@ -0,0 +1,241 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/bench_report.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#if defined( _WIN32 )
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <wx/string.h>
+
+#include <thread_pool.h>
+
+using json = nlohmann::json;
+
+
+namespace KI_TEST
+{
+
+size_t GetPeakRssKb()
+{
+#if defined( _WIN32 )
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( !GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        return 0;
+
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0;
+
+#if defined( __APPLE__ )
+    // Bytes on macOS, kB everywhere else
+    return static_cast<size_t>( usage.ru_maxrss ) / 1024;
+#else
+    return static_cast<size_t>( usage.ru_maxrss );
+#endif
+#endif
+}
+
+
+void BENCH_REPORT::BeginProject( const std::string& aName )
+{
+    m_projects.push_back( { aName, {} } );
+}
+
+
+bool BENCH_REPORT::RunStage( const std::string& aName,
+                             const std::function<bool( STAGE& )>& aFunc )
+{
+    if( m_projects.empty() )
+        BeginProject( std::string() );
+
+    STAGE& stage = m_projects.back().m_Stages.emplace_back();
+
+    stage.m_Name = aName;
+    stage.m_Timer.Start();
+    stage.m_Ok = aFunc( stage );
+    stage.m_Timer.Stop();
+    stage.m_Msecs = stage.m_Timer.msecs();
+    stage.m_PeakRssKb = GetPeakRssKb();
+
+    return stage.m_Ok;
+}
+
+
+bool BENCH_REPORT::AllStagesOk() const
+{
+    for( const PROJECT& project : m_projects )
+    {
+        for( const STAGE& stage : project.m_Stages )
+        {
+            if( !stage.m_Ok )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+json BENCH_REPORT::ToJson() const
+{
+    json projects = json::object();
+
+    for( const PROJECT& project : m_projects )
+    {
+        json   stages = json::array();
+        double total = 0.0;
+
+        for( const STAGE& stage : project.m_Stages )
+        {
+            json splits = json::array();
+
+            for( const auto& [name, msecs] : stage.m_Splits )
+                splits.push_back( { { "name", name }, { "ms", msecs } } );
+
+            stages.push_back( { { "name", stage.m_Name },
+                                { "ms", stage.m_Msecs },
+                                { "peak_rss_kb", stage.m_PeakRssKb },
+                                { "ok", stage.m_Ok },
+                                { "splits", splits } } );
+
+            total += stage.m_Msecs;
+        }
+
+        size_t peakRss = project.m_Stages.empty() ? 0 : project.m_Stages.back().m_PeakRssKb;
+
+        projects[project.m_Name] = { { "total_ms", total },
+                                     { "peak_rss_kb", peakRss },
+                                     { "stages", stages } };
+    }
+
+    return { { "threads", GetKiCadThreadPool().get_thread_count() },
+             { "projects", projects } };
+}
+
+
+bool BENCH_REPORT::Write( const std::string& aFileName ) const
+{
+    std::string text = ToJson().dump( 2 );
+
+    if( aFileName.empty() )
+    {
+        std::cout << text << std::endl;
+        return true;
+    }
+
+    std::ofstream out( aFileName );
+
+    return out.is_open() && ( out << text << std::endl );
+}
+
+
+std::optional<json> BENCH_REPORT::Read( const std::string& aFileName )
+{
+    std::ifstream in( aFileName );
+
+    if( !in.is_open() )
+        return std::nullopt;
+
+    try
+    {
+        return json::parse( in );
+    }
+    catch( const json::exception& )
+    {
+        return std::nullopt;
+    }
+}
+
+
+std::vector<std::string> BENCH_REPORT::CompareTo( const json& aBaseline, double aTolerance,
+                                                  double aMinMsecs ) const
+{
+    std::vector<std::string> regressions;
+
+    if( !aBaseline.contains( "projects" ) || !aBaseline["projects"].is_object() )
+        return regressions;
+
+    const json& baseProjects = aBaseline["projects"];
+
+    for( const PROJECT& project : m_projects )
+    {
+        if( !baseProjects.contains( project.m_Name ) )
+            continue;
+
+        const json& baseProject = baseProjects[project.m_Name];
+
+        for( const STAGE& stage : project.m_Stages )
+        {
+            if( !baseProject.contains( "stages" ) )
+                break;
+
+            const json& baseStages = baseProject["stages"];
+            auto        it = std::find_if( baseStages.begin(), baseStages.end(),
+                                           [&]( const json& aStage )
+                                           {
+                                               return aStage.value( "name", "" ) == stage.m_Name;
+                                           } );
+
+            if( it == baseStages.end() )
+                continue;
+
+            double baseMsecs = it->value( "ms", 0.0 );
+
+            if( stage.m_Msecs > baseMsecs * ( 1.0 + aTolerance )
+                    && stage.m_Msecs - baseMsecs >= aMinMsecs )
+            {
+                regressions.push_back( wxString::Format( "%s: %s took %.1f ms (baseline %.1f ms)",
+                                                         project.m_Name, stage.m_Name,
+                                                         stage.m_Msecs, baseMsecs )
+                                               .ToStdString() );
+            }
+        }
+
+        size_t peakRss = project.m_Stages.empty() ? 0 : project.m_Stages.back().m_PeakRssKb;
+        size_t baseRss = baseProject.value( "peak_rss_kb", size_t( 0 ) );
+
+        if( baseRss && peakRss > baseRss * ( 1.0 + aTolerance ) )
+        {
+            regressions.push_back( wxString::Format( "%s: peak RSS %zu kB (baseline %zu kB)",
+                                                     project.m_Name, peakRss, baseRss )
+                                           .ToStdString() );
+        }
+    }
+
+    return regressions;
+}
+
+} // namespace KI_TEST
@@ -0,0 +1,138 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_UTILS_BENCH_REPORT_H
+#define QA_UTILS_BENCH_REPORT_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <core/profile.h>
+
+namespace KI_TEST
+{
+
+/**
+ * @return the peak resident set size of the process so far, in kB (0 if unknown).
+ */
+size_t GetPeakRssKb();
+
+
+/**
+ * Stage timings of the end-to-end project benchmarks.
+ *
+ * For each project, the stages are kept in the order they ran with their wall time, the peak
+ * resident set size of the process at the end of the stage and an optional breakdown in named
+ * splits.  The report is written as JSON and can be compared with a report of an earlier run,
+ * so a build can be rejected when it is slower or larger than the baseline.
+ *
+ * The peak RSS is that of the whole process: it only grows from one stage to the next, and
+ * from one project to the next.  Compare runs made with the same project list.
+ */
+class BENCH_REPORT
+{
+public:
+    struct STAGE
+    {
+        /**
+         * Record the time since the previous split (or the stage start) under \a aName.
+         */
+        void Split( const std::string& aName ) { AddSplit( aName, m_Timer.msecs( true ) ); }
+
+        /**
+         * Record a time measured elsewhere, e.g. by the subsystem running the stage.
+         */
+        void AddSplit( const std::string& aName, double aMsecs )
+        {
+            m_Splits.emplace_back( aName, aMsecs );
+        }
+
+        std::string                                 m_Name;
+        PROF_TIMER                                  m_Timer;
+        double                                      m_Msecs = 0.0;
+        size_t                                      m_PeakRssKb = 0;
+        bool                                        m_Ok = true;
+        std::vector<std::pair<std::string, double>> m_Splits;
+    };
+
+    /**
+     * Start the stages of a new project.
+     */
+    void BeginProject( const std::string& aName );
+
+    /**
+     * Time \a aFunc as a stage of the current project.
+     *
+     * @return the result of \a aFunc, also recorded in the report.
+     */
+    bool RunStage( const std::string& aName, const std::function<bool( STAGE& )>& aFunc );
+
+    /**
+     * @return true if no stage failed.
+     */
+    bool AllStagesOk() const;
+
+    nlohmann::json ToJson() const;
+
+    /**
+     * Write the report to \a aFileName, or to stdout if it is empty.
+     */
+    bool Write( const std::string& aFileName ) const;
+
+    /**
+     * Read a report written by Write().
+     */
+    static std::optional<nlohmann::json> Read( const std::string& aFileName );
+
+    /**
+     * Compare with \a aBaseline, a report of an earlier run.
+     *
+     * A stage regresses when it takes more than \a aTolerance (a fraction) longer than in the
+     * baseline and at least \a aMinMsecs more, so very short stages do not fail on noise.  A
+     * project regresses when its peak RSS grows by more than \a aTolerance.  Projects and
+     * stages missing from the baseline are not compared.
+     *
+     * @return a description of each regression; empty when the run is within the tolerance.
+     */
+    std::vector<std::string> CompareTo( const nlohmann::json& aBaseline, double aTolerance,
+                                        double aMinMsecs ) const;
+
+private:
+    struct PROJECT
+    {
+        std::string        m_Name;
+        std::vector<STAGE> m_Stages;
+    };
+
+    std::vector<PROJECT> m_projects;
+};
+
+} // namespace KI_TEST
+
+#endif // QA_UTILS_BENCH_REPORT_H
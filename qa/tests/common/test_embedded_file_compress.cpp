@@ -23,6 +23,7 @@
 #include <mmh3_hash.h>
 #include <embedded_files.h>
 
+#include <memory>
 #include <random>
 using magic_enum::iostream_operators::operator<<;
 
@@ -137,4 +138,54 @@ BOOST_AUTO_TEST_CASE( DecompressAndDecode_ChecksumError )
     BOOST_CHECK_EQUAL(result, EMBEDDED_FILES::RETURN_CODE::CHECKSUM_ERROR);
 }
 
+BOOST_AUTO_TEST_CASE( DecompressOnFirstAccess )
+{
+    std::string data = "Decompressed only when needed";
+
+    // As loaded by the parser: the compressed data and the checksum only
+    auto makeLoadedFile =
+            [&]()
+            {
+                auto file = std::make_unique<EMBEDDED_FILES::EMBEDDED_FILE>();
+                file->name = "font.ttf";
+                file->decompressedData.assign( data.begin(), data.end() );
+                BOOST_REQUIRE( EMBEDDED_FILES::CompressAndEncode( *file ) == EMBEDDED_FILES::RETURN_CODE::OK );
+                file->decompressedData.clear();
+                return file;
+            };
+
+    std::unique_ptr<EMBEDDED_FILES::EMBEDDED_FILE> file = makeLoadedFile();
+
+    BOOST_CHECK( !file->IsDecompressed() );
+    BOOST_CHECK_EQUAL( EMBEDDED_FILES::EnsureDecompressed( *file ), EMBEDDED_FILES::RETURN_CODE::OK );
+    BOOST_CHECK( file->IsDecompressed() );
+    BOOST_CHECK( std::string( file->decompressedData.begin(), file->decompressedData.end() ) == data );
+
+    // The same content elsewhere, served from the cache, and a batch on the thread pool
+    std::vector<std::unique_ptr<EMBEDDED_FILES::EMBEDDED_FILE>> others;
+    std::vector<EMBEDDED_FILES::EMBEDDED_FILE*>                 batch;
+
+    for( int ii = 0; ii < 4; ++ii )
+    {
+        others.push_back( makeLoadedFile() );
+        batch.push_back( others.back().get() );
+    }
+
+    EMBEDDED_FILES::DecompressFiles( batch );
+
+    for( EMBEDDED_FILES::EMBEDDED_FILE* other : batch )
+    {
+        BOOST_CHECK( other->decompressedData == file->decompressedData );
+        BOOST_CHECK( other->Validate() );
+    }
+
+    // A corrupted file stays empty rather than serving the cache
+    std::unique_ptr<EMBEDDED_FILES::EMBEDDED_FILE> corrupted = makeLoadedFile();
+    corrupted->data_hash[0] = ( corrupted->data_hash[0] == 'x' ) ? 'y' : 'x';
+
+    BOOST_CHECK_EQUAL( EMBEDDED_FILES::EnsureDecompressed( *corrupted ),
+                       EMBEDDED_FILES::RETURN_CODE::CHECKSUM_ERROR );
+    BOOST_CHECK( corrupted->decompressedData.empty() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,7 +28,9 @@
 #include <locale_io.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <fmt/format.h>
 
 struct UnitFixture
 {
@@ -84,4 +86,57 @@ BOOST_AUTO_TEST_CASE( VECTOR2IUnitFormat )
 }
 
 
+/**
+ * Check that integer values at a power of ten scale are formatted the same as their floating
+ * point values were
+ */
+BOOST_AUTO_TEST_CASE( IntegerUnitFormat )
+{
+    LOCALE_IO   toggle;
+
+#ifdef EESCHEMA
+    const EDA_IU_SCALE& iuScale = schIUScale;
+#elif GERBVIEW
+    const EDA_IU_SCALE& iuScale = gerbIUScale;
+#elif PCBNEW
+    const EDA_IU_SCALE& iuScale = pcbIUScale;
+#endif
+
+    auto formatDouble =
+            []( double aValue )
+            {
+                if( aValue != 0.0 && fabs( aValue ) <= 0.0001 )
+                {
+                    std::string buf = fmt::format( "{:.10f}", aValue );
+
+                    while( buf.back() == '0' )
+                        buf.pop_back();
+
+                    if( buf.back() == '.' )
+                        buf.pop_back();
+
+                    return buf;
+                }
+
+                return fmt::format( "{:.10g}", aValue );
+            };
+
+    std::vector<int> values = { 0, 1, -1, 7, 10, 99, 100, -100, 101, 1000, 12345, 100000,
+                                1000001, -35000000, 123456789, std::numeric_limits<int>::min(),
+                                std::numeric_limits<int>::max() };
+
+    for( int value = -3000; value <= 3000; value += 7 )
+        values.push_back( value * 997 );
+
+    for( int value : values )
+    {
+        BOOST_TEST_CONTEXT( value )
+        {
+            BOOST_CHECK_EQUAL( EDA_UNIT_UTILS::FormatInternalUnits( iuScale, value ),
+                               formatDouble( value / iuScale.IU_PER_MM ) );
+        }
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,8 @@
 #include <kiid.h>
 #include <wx/string.h>
 #include <set>
+#include <thread>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE( Kiid )
 
@@ -79,6 +81,69 @@ BOOST_AUTO_TEST_CASE( KiidPathTest )
 }
 
 
+BOOST_AUTO_TEST_CASE( ThreadedGeneration )
+{
+    const size_t threadCount = 4;
+    const size_t perThread = 1000;
+
+    // Once seeded, each thread must still get its own sequence
+    KIID::SeedGenerator( 0l );
+
+    std::vector<std::vector<KIID>> ids( threadCount );
+    std::vector<std::thread>       threads;
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
+    {
+        threads.emplace_back(
+                [&ids, ii, perThread]()
+                {
+                    for( size_t jj = 0; jj < perThread; ++jj )
+                        ids[ii].emplace_back();
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    std::set<KIID> unique;
+
+    for( const std::vector<KIID>& threadIds : ids )
+        unique.insert( threadIds.begin(), threadIds.end() );
+
+    BOOST_CHECK_EQUAL( unique.size(), threadCount * perThread );
+}
+
+
+BOOST_AUTO_TEST_CASE( Hashing )
+{
+    // Legacy timestamps only differ in their last bytes
+    std::set<size_t> hashes;
+
+    for( timestamp_t ts = 0; ts < 1000; ++ts )
+        hashes.insert( KIID( ts ).Hash() );
+
+    BOOST_CHECK_EQUAL( hashes.size(), 1000 );
+
+    KIID a, b, c;
+
+    KIID_PATH path1;
+    KIID_PATH path2;
+
+    path1.push_back( a );
+    path1.push_back( b );
+    path2.push_back( a );
+    path2.push_back( b );
+
+    BOOST_CHECK( path1 == path2 );
+    BOOST_CHECK_EQUAL( path1.Hash(), path2.Hash() );
+
+    path2.push_back( c );
+
+    BOOST_CHECK( !( path1 == path2 ) );
+    BOOST_CHECK_NE( path1.Hash(), path2.Hash() );
+}
+
+
 BOOST_AUTO_TEST_CASE( LegacyTimestamp )
 {
     timestamp_t ts_a = 0xAABBCCDD;
@@ -0,0 +1,141 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <libraries/library_metadata_cache.h>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+
+/**
+ * A cache file name in the temporary directory, removed again at the end of the test.
+ */
+struct METADATA_CACHE_FIXTURE
+{
+    METADATA_CACHE_FIXTURE() : m_path( wxFileName::CreateTempFileName( wxT( "kicad_lmc" ) ) )
+    {
+        wxRemoveFile( m_path );
+    }
+
+    ~METADATA_CACHE_FIXTURE() { wxRemoveFile( m_path ); }
+
+    wxString m_path;
+};
+
+
+BOOST_AUTO_TEST_SUITE( LibraryMetadataCache )
+
+
+BOOST_FIXTURE_TEST_CASE( RoundTrip, METADATA_CACHE_FIXTURE )
+{
+    using ITEM = LIBRARY_METADATA_CACHE::ITEM;
+
+    std::vector<ITEM> footprints = { { wxS( "R_0603" ), wxS( "Resistor, 0603" ), wxS( "R res" ), 2, 2 },
+                                     { wxS( "SOT-23" ), wxEmptyString, wxS( "transistor" ), 4, 3 } };
+    std::vector<ITEM> symbols = { { wxS( "LM358" ), wxS( "Dual operational amplifier" ),
+                                    wxS( "opamp" ), 8, 0 } };
+
+    {
+        LIBRARY_METADATA_CACHE cache( m_path );
+
+        cache.SetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 10, footprints );
+        cache.SetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "/lib/amp.kicad_sym" ), 20, symbols );
+
+        // Libraries without a stamp are never stored
+        cache.SetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "db" ), 0, symbols );
+
+        BOOST_REQUIRE( cache.Save() );
+    }
+
+    LIBRARY_METADATA_CACHE cache( m_path );
+    std::vector<ITEM>      items;
+
+    BOOST_REQUIRE( cache.GetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 10, items ) );
+    BOOST_REQUIRE_EQUAL( items.size(), footprints.size() );
+
+    for( size_t ii = 0; ii < items.size(); ++ii )
+    {
+        BOOST_CHECK_EQUAL( items[ii].m_name, footprints[ii].m_name );
+        BOOST_CHECK_EQUAL( items[ii].m_description, footprints[ii].m_description );
+        BOOST_CHECK_EQUAL( items[ii].m_keywords, footprints[ii].m_keywords );
+        BOOST_CHECK_EQUAL( items[ii].m_count, footprints[ii].m_count );
+        BOOST_CHECK_EQUAL( items[ii].m_uniqueCount, footprints[ii].m_uniqueCount );
+    }
+
+    BOOST_REQUIRE( cache.GetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "/lib/amp.kicad_sym" ), 20, items ) );
+    BOOST_REQUIRE_EQUAL( items.size(), 1u );
+    BOOST_CHECK_EQUAL( items[0].m_description, symbols[0].m_description );
+
+    // A changed stamp, another type or an unknown path is a miss
+    BOOST_CHECK( !cache.GetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 11, items ) );
+    BOOST_CHECK( !cache.GetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "/lib/R.pretty" ), 10, items ) );
+    BOOST_CHECK( !cache.GetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "db" ), 0, items ) );
+
+    // Libraries that aren't replaced survive a rewrite with their records copied as they are
+    cache.SetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 11, { footprints[1] } );
+    BOOST_REQUIRE( cache.Save() );
+
+    LIBRARY_METADATA_CACHE reopened( m_path );
+
+    BOOST_REQUIRE( reopened.GetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 11, items ) );
+    BOOST_REQUIRE_EQUAL( items.size(), 1u );
+    BOOST_CHECK_EQUAL( items[0].m_name, wxS( "SOT-23" ) );
+
+    BOOST_REQUIRE( reopened.GetItems( LIBRARY_TABLE_TYPE::SYMBOL, wxS( "/lib/amp.kicad_sym" ), 20, items ) );
+    BOOST_CHECK_EQUAL( items[0].m_name, wxS( "LM358" ) );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DamagedFile, METADATA_CACHE_FIXTURE )
+{
+    {
+        LIBRARY_METADATA_CACHE cache( m_path );
+
+        cache.SetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 10,
+                        { { wxS( "R_0603" ), wxS( "Resistor" ), wxS( "R" ), 2, 2 } } );
+        BOOST_REQUIRE( cache.Save() );
+    }
+
+    // Cut the file in the middle of the library index
+    std::string contents;
+
+    {
+        wxFFile file( m_path, wxT( "rb" ) );
+        BOOST_REQUIRE( file.IsOpened() );
+
+        contents.resize( file.Length() );
+        BOOST_REQUIRE( file.Read( contents.data(), contents.size() ) == contents.size() );
+    }
+
+    {
+        wxFFile file( m_path, wxT( "wb" ) );
+        file.Write( contents.data(), contents.size() - 4 );
+    }
+
+    LIBRARY_METADATA_CACHE                    cache( m_path );
+    std::vector<LIBRARY_METADATA_CACHE::ITEM> items;
+
+    BOOST_CHECK( !cache.GetItems( LIBRARY_TABLE_TYPE::FOOTPRINT, wxS( "/lib/R.pretty" ), 10, items ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -154,4 +154,28 @@ BOOST_AUTO_TEST_CASE( Manager )
     BOOST_REQUIRE( manager.Rows( LIBRARY_TABLE_TYPE::FOOTPRINT ).size() == 146 );
 }
 
+BOOST_AUTO_TEST_CASE( ReferencedLibraries )
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "kicad_referenced_libs";
+    std::filesystem::remove_all( dir );
+    std::filesystem::create_directories( dir / "sub" );
+
+    std::ofstream( dir / "top.kicad_sch" ) << "(lib_id \"Device:R\")\n(lib_id \"power:GND\")\n"
+                                              "(property \"Footprint\" \"Resistor_SMD:R_0603\")";
+    std::ofstream( dir / "sub" / "child.kicad_sch" ) << "(lib_id \"MyLib:Part\") (lib_id \"NoNick\")";
+    std::ofstream( dir / "other.txt" ) << "(lib_id \"Ignored:Part\")";
+
+    std::set<wxString> symbols = LIBRARY_MANAGER_ADAPTER::ReferencedLibraries(
+            dir.string(), wxS( "*.kicad_sch" ), { "(lib_id \"" } );
+
+    BOOST_CHECK( symbols == std::set<wxString>( { wxS( "Device" ), wxS( "power" ), wxS( "MyLib" ) } ) );
+
+    std::set<wxString> footprints = LIBRARY_MANAGER_ADAPTER::ReferencedLibraries(
+            dir.string(), wxS( "*.kicad_sch" ), { "(property \"Footprint\" \"" } );
+
+    BOOST_CHECK( footprints == std::set<wxString>( { wxS( "Resistor_SMD" ) } ) );
+
+    std::filesystem::remove_all( dir );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -283,6 +283,36 @@ BOOST_AUTO_TEST_CASE( TypeCasting )
     BOOST_CHECK_EQUAL( D_to_C, dynamic_cast<C*>( ptr ) );
 }
 
+// Pre-resolved accessors, including a property of a secondary base class
+BOOST_AUTO_TEST_CASE( Accessor )
+{
+    ptr = &d;
+    ptr->Set( "A", 21 );
+    ptr->Set( "new", 7 );
+    ptr->Set( "point", wxPoint( 1, 2 ) );
+
+    PROPERTY_ACCESSOR a( TYPE_HASH( D ), propMgr.GetProperty( TYPE_HASH( D ), "A" ) );
+    PROPERTY_ACCESSOR n( TYPE_HASH( D ), propMgr.GetProperty( TYPE_HASH( D ), "new" ) );
+    PROPERTY_ACCESSOR p( TYPE_HASH( D ), propMgr.GetProperty( TYPE_HASH( D ), "point" ) );
+
+    BOOST_CHECK( a.IsValid() && n.IsValid() && p.IsValid() );
+
+    std::optional<double> value;
+
+    BOOST_CHECK( a.GetNumeric( ptr, value ) );
+    BOOST_CHECK_EQUAL( value.value_or( 0 ), 42 );
+
+    BOOST_CHECK( n.GetNumeric( ptr, value ) );
+    BOOST_CHECK_EQUAL( value.value_or( 0 ), 7 );
+
+    // Not numeric: only readable through wxAny
+    BOOST_CHECK( !p.GetNumeric( ptr, value ) );
+    BOOST_CHECK_EQUAL( p.Get( ptr ).As<wxPoint>(), wxPoint( 1, 2 ) );
+
+    PROPERTY_ACCESSOR c( TYPE_HASH( B ), propMgr.GetProperty( TYPE_HASH( D ), "new" ) );
+    BOOST_CHECK( !c.IsValid() );
+}
+
 BOOST_AUTO_TEST_CASE( EnumGlob )
 {
     PROPERTY_BASE* prop = propMgr.GetProperty( TYPE_HASH( D ), "enumGlob" );
@@ -0,0 +1,116 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for RC_JSON::STREAM_WRITER
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <iomanip>
+#include <sstream>
+
+// Code under test
+#include <rc_json_schema.h>
+
+
+BOOST_AUTO_TEST_SUITE( RcJsonStreamWriter )
+
+
+static RC_JSON::VIOLATION makeViolation( const wxString& aType, double aX )
+{
+    RC_JSON::VIOLATION violation;
+    violation.type = aType;
+    violation.description = wxS( "Clearance violation\n(second line)" );
+    violation.severity = wxS( "error" );
+    violation.excluded = false;
+    violation.items.push_back( { wxS( "uuid-a" ), wxS( "Track \"A\"" ), { aX, 2.5 } } );
+    violation.items.push_back( { wxS( "uuid-b" ), wxS( "Pad 1" ), { aX + 1.0, 2.5 } } );
+    return violation;
+}
+
+
+/**
+ * A streamed ERC report must match the one nlohmann::json writes for the whole document,
+ * including empty arrays and nested objects.
+ */
+BOOST_AUTO_TEST_CASE( MatchesDocumentDump )
+{
+    RC_JSON::ERC_REPORT report;
+    report.$schema = wxS( "https://schemas.kicad.org/erc.v1.json" );
+    report.source = wxS( "test.kicad_sch" );
+    report.date = wxS( "2026-01-01T00:00:00" );
+    report.kicad_version = wxS( "10.0.0" );
+    report.coordinate_units = wxS( "mm" );
+    report.included_severities = { wxS( "error" ), wxS( "warning" ) };
+    report.ignored_checks.push_back( { wxS( "pin_not_connected" ), wxS( "Pin not connected" ) } );
+
+    RC_JSON::ERC_SHEET root;
+    root.path = wxS( "/" );
+    root.uuid_path = wxS( "/abc" );
+    root.violations = { makeViolation( wxS( "a" ), 1.0 ), makeViolation( wxS( "b" ), 3.0 ) };
+
+    RC_JSON::ERC_SHEET empty;
+    empty.path = wxS( "/sub/" );
+    empty.uuid_path = wxS( "/abc/def" );
+
+    report.sheets = { root, empty };
+
+    std::ostringstream expected;
+    expected << std::setw( 4 ) << nlohmann::json( report ) << std::endl;
+
+    std::ostringstream     streamed;
+    RC_JSON::STREAM_WRITER writer( streamed );
+
+    writer.Member( "$schema", report.$schema );
+    writer.Member( "coordinate_units", report.coordinate_units );
+    writer.Member( "date", report.date );
+    writer.Member( "ignored_checks", report.ignored_checks );
+    writer.Member( "included_severities", report.included_severities );
+    writer.Member( "kicad_version", report.kicad_version );
+    writer.BeginArray( "sheets" );
+
+    for( const RC_JSON::ERC_SHEET& sheet : report.sheets )
+    {
+        writer.BeginObject();
+        writer.Member( "path", sheet.path );
+        writer.Member( "uuid_path", sheet.uuid_path );
+        writer.BeginArray( "violations" );
+
+        for( const RC_JSON::VIOLATION& violation : sheet.violations )
+            writer.Element( violation );
+
+        writer.Close();
+        writer.Close();
+    }
+
+    writer.Close();
+    writer.Member( "source", report.source );
+    writer.Close();
+
+    BOOST_CHECK_EQUAL( streamed.str(), expected.str() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,13 +28,99 @@
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
 // Code under test
+#include <dsnlexer.h>
 #include <richio.h>
 
+
+static const std::string c_sexpr = "(kicad_pcb (version 20240108)\n"
+                                   "  # a comment\n"
+                                   "\n"
+                                   "  (segment (start 1.5 -2) (end +3e2 4) (net \"a \\\"b\\\"\\x41\"))\n"
+                                   "  (layer F.Cu) 12345678901234567890)";
+
+
+/**
+ * Writes c_sexpr to a temporary file, removed again at the end of the test.
+ */
+struct MAPPED_FILE_FIXTURE
+{
+    MAPPED_FILE_FIXTURE() : m_path( wxFileName::CreateTempFileName( wxT( "kicad_richio" ) ) )
+    {
+        wxFFile file( m_path, wxT( "wb" ) );
+        file.Write( c_sexpr.data(), c_sexpr.size() );
+    }
+
+    ~MAPPED_FILE_FIXTURE() { wxRemoveFile( m_path ); }
+
+    wxString m_path;
+};
+
 /**
  * Declare the test suite
  */
 BOOST_AUTO_TEST_SUITE( RichIO )
 
 
+BOOST_FIXTURE_TEST_CASE( MappedReaderLines, MAPPED_FILE_FIXTURE )
+{
+    MAPPED_FILE_LINE_READER mapped( m_path );
+    STRING_LINE_READER      string( c_sexpr, wxT( "test" ) );
+
+    BOOST_CHECK_EQUAL( mapped.CountLines(), 5 );
+
+    // The copying API reads the same lines as any other reader
+    while( string.ReadLine() )
+    {
+        BOOST_REQUIRE( mapped.ReadLine() );
+        BOOST_CHECK_EQUAL( std::string( mapped.Line() ), std::string( string.Line() ) );
+        BOOST_CHECK_EQUAL( mapped.LineNumber(), string.LineNumber() );
+    }
+
+    BOOST_CHECK( !mapped.ReadLine() );
+
+    // and so do views, after a rewind
+    mapped.Rewind();
+
+    std::string joined;
+
+    for( std::string_view line = mapped.ReadLineView(); !line.empty();
+         line = mapped.ReadLineView() )
+    {
+        joined += line;
+    }
+
+    BOOST_CHECK_EQUAL( joined, c_sexpr );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( MappedReaderTokens, MAPPED_FILE_FIXTURE )
+{
+    MAPPED_FILE_LINE_READER mapped( m_path );
+    STRING_LINE_READER      string( c_sexpr, wxT( "test" ) );
+    DSNLEXER                mappedLexer( nullptr, 0, nullptr, &mapped );
+    DSNLEXER                stringLexer( nullptr, 0, nullptr, &string );
+
+    for( ;; )
+    {
+        int tok = stringLexer.NextTok();
+
+        BOOST_REQUIRE_EQUAL( mappedLexer.NextTok(), tok );
+        BOOST_CHECK_EQUAL( mappedLexer.CurLineNumber(), stringLexer.CurLineNumber() );
+        BOOST_CHECK_EQUAL( mappedLexer.CurOffset(), stringLexer.CurOffset() );
+
+        if( tok == DSN_EOF )
+            break;
+
+        BOOST_CHECK_EQUAL( std::string( mappedLexer.CurStrView() ), stringLexer.CurStr() );
+        BOOST_CHECK_EQUAL( mappedLexer.CurStr(), stringLexer.CurStr() );
+        BOOST_CHECK_EQUAL( std::string( mappedLexer.CurLine() ),
+                           std::string( stringLexer.CurLine() ) );
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
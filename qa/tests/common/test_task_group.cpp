@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <thread_pool.h>
+
+#include <atomic>
+#include <stdexcept>
+
+
+BOOST_AUTO_TEST_SUITE( TaskGroup )
+
+
+BOOST_AUTO_TEST_CASE( RunsAllTasks )
+{
+    std::atomic<int> count = 0;
+    TASK_GROUP       tasks;
+
+    for( int ii = 0; ii < 1000; ++ii )
+        tasks.Submit( [&]() { count++; } );
+
+    tasks.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), 1000 );
+}
+
+
+/**
+ * Groups waited for from inside pool tasks must not deadlock, even with more outer tasks
+ * than threads.
+ */
+BOOST_AUTO_TEST_CASE( NestedGroups )
+{
+    thread_pool&     tp = GetKiCadThreadPool();
+    std::atomic<int> count = 0;
+    TASK_GROUP       outer( TASK_PRIORITY::BACKGROUND );
+    const int        outerCount = static_cast<int>( 4 * tp.get_thread_count() );
+
+    for( int ii = 0; ii < outerCount; ++ii )
+    {
+        outer.Submit(
+                [&]()
+                {
+                    TASK_GROUP inner( TASK_PRIORITY::INTERACTIVE );
+
+                    for( int jj = 0; jj < 10; ++jj )
+                        inner.Submit( [&]() { count++; } );
+
+                    inner.Wait();
+                } );
+    }
+
+    outer.Wait();
+
+    BOOST_CHECK_EQUAL( count.load(), outerCount * 10 );
+}
+
+
+BOOST_AUTO_TEST_CASE( CancelDropsPendingTasks )
+{
+    std::atomic<int> count = 0;
+    TASK_GROUP       tasks;
+
+    tasks.Cancel();
+    tasks.Submit( [&]() { count++; } );
+    tasks.Wait();
+
+    BOOST_CHECK( tasks.IsCancelled() );
+    BOOST_CHECK_EQUAL( count.load(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( RethrowsTaskException )
+{
+    std::atomic<int> count = 0;
+    TASK_GROUP       tasks;
+
+    tasks.Submit( []() { throw std::runtime_error( "task failed" ); } );
+
+    for( int ii = 0; ii < 10; ++ii )
+        tasks.Submit( [&]() { count++; } );
+
+    BOOST_CHECK_THROW( tasks.Wait(), std::runtime_error );
+    BOOST_CHECK_EQUAL( count.load(), 10 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
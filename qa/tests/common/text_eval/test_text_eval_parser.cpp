@@ -456,6 +456,39 @@ BOOST_AUTO_TEST_CASE( RandomFunctions )
     BOOST_CHECK_NE( randomValue, randomValue2 );
 }
 
+/**
+ * Test that evaluating the same text again gives the same result and error state
+ */
+BOOST_AUTO_TEST_CASE( RepeatedEvaluation )
+{
+    EXPRESSION_EVALUATOR evaluator;
+
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "Total: @{2 * 3}" ), "Total: 6" );
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "Total: @{2 * 3}" ), "Total: 6" );
+
+    evaluator.Evaluate( "@{2 +}" );
+    BOOST_CHECK( evaluator.HasErrors() );
+
+    evaluator.Evaluate( "@{2 +}" );
+    BOOST_CHECK( evaluator.HasErrors() );
+
+    evaluator.Evaluate( "Total: @{2 * 3}" );
+    BOOST_CHECK( !evaluator.HasErrors() );
+
+    // The same text evaluates differently with other default units
+    EXPRESSION_EVALUATOR mmEvaluator( EDA_UNITS::MM );
+    EXPRESSION_EVALUATOR milsEvaluator( EDA_UNITS::MILS );
+
+    BOOST_CHECK_NE( mmEvaluator.Evaluate( "@{1in}" ), milsEvaluator.Evaluate( "@{1in}" ) );
+
+    // Stored variables are always looked up again
+    evaluator.SetVariable( wxS( "qty" ), 2.0 );
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{${qty} * 3}" ), "6" );
+
+    evaluator.SetVariable( wxS( "qty" ), 3.0 );
+    BOOST_CHECK_EQUAL( evaluator.Evaluate( "@{${qty} * 3}" ), "9" );
+}
+
 /**
  * Test error handling and edge cases
  */
@@ -0,0 +1,78 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one at
+ * http://www.gnu.org/licenses/
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <schematic_utils/schematic_file_util.h>
+
+#include <connection_graph.h>
+#include <schematic.h>
+#include <sch_screen.h>
+#include <erc/erc_settings.h>
+#include <erc/erc.h>
+#include <settings/settings_manager.h>
+#include <locale_io.h>
+
+
+struct ERC_CACHE_TEST_FIXTURE
+{
+    ERC_CACHE_TEST_FIXTURE()
+    { }
+
+    SETTINGS_MANAGER           m_settingsManager;
+    std::unique_ptr<SCHEMATIC> m_schematic;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( ERCCachedResultsMatch, ERC_CACHE_TEST_FIXTURE )
+{
+    LOCALE_IO dummy;
+
+    // A second run over an unchanged graph re-raises the cached markers, which must match the
+    // markers of the first run exactly
+    std::vector<wxString> tests = { "erc_pin_not_connected_basic",
+                                    "issue10430",
+                                    "issue7203" };
+
+    for( const wxString& test : tests )
+    {
+        KI_TEST::LoadSchematic( m_settingsManager, test, m_schematic );
+
+        SHEETLIST_ERC_ITEMS_PROVIDER errors( m_schematic.get() );
+        errors.SetSeverities( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING );
+
+        int firstCount = m_schematic->ConnectionGraph()->RunERC();
+        int firstMarkers = errors.GetCount();
+
+        SCH_SCREENS screens( m_schematic->Root() );
+        screens.DeleteAllMarkers( MARKER_BASE::MARKER_ERC, true );
+
+        errors.SetSeverities( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING );
+        BOOST_REQUIRE_EQUAL( errors.GetCount(), 0 );
+
+        int secondCount = m_schematic->ConnectionGraph()->RunERC();
+        errors.SetSeverities( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING );
+
+        BOOST_CHECK_MESSAGE( secondCount == firstCount && errors.GetCount() == firstMarkers,
+                             "Cached ERC of " << test.ToStdString() << " found " << secondCount
+                                              << " errors and " << errors.GetCount()
+                                              << " markers, expected " << firstCount << " and "
+                                              << firstMarkers );
+    }
+}
@@ -367,4 +367,39 @@ BOOST_AUTO_TEST_CASE( NetclassCacheInvalidation )
 }
 
 
+/**
+ * Test that plain net names, wildcard and regex patterns all resolve, and that changing the
+ * assignments after a lookup is taken into account.
+ */
+BOOST_AUTO_TEST_CASE( LiteralAndWildcardPatterns )
+{
+    NET_SETTINGS netSettings( nullptr, "" );
+
+    std::shared_ptr<NETCLASS> power = std::make_shared<NETCLASS>( wxS( "Power" ) );
+    std::shared_ptr<NETCLASS> fast = std::make_shared<NETCLASS>( wxS( "Fast" ) );
+
+    netSettings.SetNetclass( power->GetName(), power );
+    netSettings.SetNetclass( fast->GetName(), fast );
+
+    netSettings.SetNetclassPatternAssignment( wxS( "/VCC" ), wxS( "Power" ) );
+    netSettings.SetNetclassPatternAssignment( wxS( "/CLK*" ), wxS( "Fast" ) );
+    netSettings.SetNetclassPatternAssignment( wxS( "/SDA|/SCL" ), wxS( "Fast" ) );
+
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/VCC" ) )->GetName(), wxS( "Power" ) );
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/CLK_A" ) )->GetName(), wxS( "Fast" ) );
+
+    // As a regex, "/CLK*" also matches "/CL"; "/SCL" only matches through the alternative
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/CL" ) )->GetName(), wxS( "Fast" ) );
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/SCL" ) )->GetName(), wxS( "Fast" ) );
+
+    // A plain name is not a prefix
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/VCC2" ) )->GetName(),
+                       wxString( NETCLASS::Default ) );
+
+    netSettings.SetNetclassPatternAssignment( wxS( "/VCC2" ), wxS( "Power" ) );
+
+    BOOST_CHECK_EQUAL( netSettings.GetEffectiveNetClass( wxS( "/VCC2" ) )->GetName(), wxS( "Power" ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <set>
+
+#include <boost/test/unit_test.hpp>
+#include <eeschema_test_utils.h>
+
+#include <advanced_config.h>
+#include <lib_symbol.h>
+#include <sch_screen.h>
+#include <schematic.h>
+#include <wildcards_and_files_ext.h>
+
+
+class PARALLEL_SCHEMATIC_LOAD_FIXTURE : public KI_TEST::SCHEMATIC_TEST_FIXTURE
+{
+public:
+    /// The items and embedded symbols of every screen, by file name.
+    std::map<wxString, std::vector<wxString>> LoadScreens( const wxString& aName, bool aParallel )
+    {
+        ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+        bool          original = cfg.m_ParallelSchematicLoad;
+
+        cfg.m_ParallelSchematicLoad = aParallel;
+        LoadSchematic( wxFileName( KI_TEST::GetEeschemaTestDataDir(), aName,
+                                   FILEEXT::KiCadSchematicFileExtension ) );
+        cfg.m_ParallelSchematicLoad = original;
+
+        std::map<wxString, std::vector<wxString>>    screens;
+        std::map<SCH_SCREEN*, std::set<LIB_SYMBOL*>> libSymbolOwners;
+        SCH_SCREENS                                  allScreens( m_schematic->Root() );
+
+        for( SCH_SCREEN* screen = allScreens.GetFirst(); screen; screen = allScreens.GetNext() )
+        {
+            wxFileName             fn( screen->GetFileName() );
+            std::vector<wxString>& contents = screens[fn.GetFullName()];
+
+            for( SCH_ITEM* item : screen->Items() )
+                contents.push_back( item->m_Uuid.AsString() );
+
+            for( const auto& [name, libSymbol] : screen->GetLibSymbols() )
+            {
+                // Shared lib_symbols are copied, never owned by two screens
+                for( const auto& [otherScreen, otherSymbols] : libSymbolOwners )
+                    BOOST_CHECK( !otherSymbols.count( libSymbol ) );
+
+                libSymbolOwners[screen].insert( libSymbol );
+                contents.push_back( name + wxS( ":" ) + libSymbol->GetName() );
+            }
+
+            std::sort( contents.begin(), contents.end() );
+        }
+
+        return screens;
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ParallelSchematicLoad, PARALLEL_SCHEMATIC_LOAD_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( ParallelLoadMatchesSequential )
+{
+    std::map<wxString, std::vector<wxString>> sequential = LoadScreens( wxS( "issue13212" ),
+                                                                        false );
+    std::map<wxString, std::vector<wxString>> parallel = LoadScreens( wxS( "issue13212" ), true );
+
+    BOOST_REQUIRE_EQUAL( parallel.size(), sequential.size() );
+    BOOST_CHECK_GT( parallel.size(), 2 );
+
+    for( const auto& [fileName, contents] : sequential )
+    {
+        BOOST_TEST_CONTEXT( fileName.ToStdString() )
+        {
+            BOOST_REQUIRE( parallel.count( fileName ) );
+            BOOST_CHECK( parallel[fileName] == contents );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Test suite for SCH_AGENT_TOOL_CALL_PARSER
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <tools/sch_agent_tool_call_parser.h>
+
+
+using TOOL_CALL = SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL;
+
+
+BOOST_AUTO_TEST_SUITE( SchAgentToolCallParser )
+
+
+BOOST_AUTO_TEST_CASE( CallCompletesBeforeLineEnds )
+{
+    SCH_AGENT_TOOL_CALL_PARSER parser;
+    std::vector<TOOL_CALL>     calls;
+
+    parser.Feed( wxS( "Let me look.\nTOOL schematic.search_symbol {\"query\":" ), calls );
+    BOOST_CHECK( calls.empty() );
+
+    parser.Feed( wxS( "\"555\"}" ), calls );
+    BOOST_REQUIRE_EQUAL( calls.size(), 1 );
+    BOOST_CHECK_EQUAL( calls[0].name, wxS( "schematic.search_symbol" ) );
+    BOOST_CHECK_EQUAL( calls[0].payload, wxS( "{\"query\":\"555\"}" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( BracesInStringsAndNesting )
+{
+    SCH_AGENT_TOOL_CALL_PARSER parser;
+    std::vector<TOOL_CALL>     calls;
+
+    wxString text = wxS( "TOOL a.b {\"t\":\"}{\\\"\",\"n\":{\"x\":1}\n}\ntool c.d\n" );
+
+    // Feed one character at a time, as a slow stream would
+    for( wxUniChar c : text )
+        parser.Feed( wxString( c ), calls );
+
+    parser.Finish( calls );
+
+    BOOST_REQUIRE_EQUAL( calls.size(), 2 );
+    BOOST_CHECK_EQUAL( calls[0].payload, wxS( "{\"t\":\"}{\\\"\",\"n\":{\"x\":1}\n}" ) );
+    BOOST_CHECK_EQUAL( calls[1].name, wxS( "c.d" ) );
+    BOOST_CHECK( calls[1].payload.IsEmpty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( IgnoresProseAndTruncatedCalls )
+{
+    SCH_AGENT_TOOL_CALL_PARSER parser;
+    std::vector<TOOL_CALL>     calls;
+
+    parser.Feed( wxS( "The TOOL will {maybe} help\n# TOOL x.y\nTOOLING {x}\nTOOL e.f {\"a\":" ),
+                 calls );
+    parser.Finish( calls );
+
+    BOOST_CHECK( calls.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( KeepsOtherLinesInOrder )
+{
+    SCH_AGENT_TOOL_CALL_PARSER parser( true );
+    std::vector<TOOL_CALL>     calls;
+
+    parser.Feed( wxS( "WIRE 0 0 10 0\n# note\nTOOL a.b {\n  \"x\": 1\n}\n\nJUNCTION 10 0" ),
+                 calls );
+    parser.Finish( calls );
+
+    BOOST_REQUIRE_EQUAL( calls.size(), 3 );
+    BOOST_CHECK( calls[0].name.IsEmpty() );
+    BOOST_CHECK_EQUAL( calls[0].line, wxS( "WIRE 0 0 10 0" ) );
+    BOOST_CHECK_EQUAL( calls[1].name, wxS( "a.b" ) );
+    BOOST_CHECK_EQUAL( calls[1].payload, wxS( "{\n  \"x\": 1\n}" ) );
+    BOOST_CHECK_EQUAL( calls[2].line, wxS( "JUNCTION 10 0" ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
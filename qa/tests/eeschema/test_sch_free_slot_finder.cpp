@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Test suite for SCH_FREE_SLOT_FINDER
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <sch_junction.h>
+
+// Code under test
+#include <sch_free_slot_finder.h>
+
+
+class TEST_SCH_FREE_SLOT_FINDER_FIXTURE
+{
+public:
+    ~TEST_SCH_FREE_SLOT_FINDER_FIXTURE()
+    {
+        for( SCH_ITEM* item : m_items )
+            delete item;
+    }
+
+    SCH_JUNCTION* addJunction( const VECTOR2I& aPos )
+    {
+        SCH_JUNCTION* junction = new SCH_JUNCTION( aPos, 1000 );
+        m_items.push_back( junction );
+        m_tree.insert( junction );
+        return junction;
+    }
+
+    EE_RTREE               m_tree;
+    std::vector<SCH_ITEM*> m_items;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchFreeSlotFinder, TEST_SCH_FREE_SLOT_FINDER_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( EmptyTree )
+{
+    SCH_FREE_SLOT_FINDER finder( m_tree, { SCH_JUNCTION_T }, 0 );
+    BOX2I                box( VECTOR2I( 0, 0 ), VECTOR2I( 100, 100 ) );
+
+    BOOST_CHECK( finder.IsFree( box ) );
+    BOOST_CHECK( finder.FindNearest( box, 1000, 5 ) == VECTOR2I( 0, 0 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( FirstRing )
+{
+    addJunction( VECTOR2I( 0, 0 ) );
+
+    SCH_FREE_SLOT_FINDER finder( m_tree, { SCH_JUNCTION_T }, 0 );
+    BOX2I                box( VECTOR2I( -100, -100 ), VECTOR2I( 200, 200 ) );
+
+    BOOST_CHECK( !finder.IsFree( box ) );
+
+    std::optional<VECTOR2I> offset = finder.FindNearest( box, 10000, 5 );
+
+    BOOST_REQUIRE( offset.has_value() );
+    BOOST_CHECK_EQUAL( *offset, VECTOR2I( -10000, -10000 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( TypesAndIgnoredItem )
+{
+    SCH_JUNCTION* junction = addJunction( VECTOR2I( 0, 0 ) );
+    BOX2I         box( VECTOR2I( -100, -100 ), VECTOR2I( 200, 200 ) );
+
+    SCH_FREE_SLOT_FINDER otherTypes( m_tree, { SCH_SYMBOL_T }, 0 );
+    BOOST_CHECK( otherTypes.IsFree( box ) );
+
+    SCH_FREE_SLOT_FINDER finder( m_tree, { SCH_JUNCTION_T }, 0 );
+    finder.IgnoreItem( junction );
+    BOOST_CHECK( finder.IsFree( box ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( MarginAndExhaustion )
+{
+    // Ring of obstacles around the origin one grid step out
+    for( int dx = -1; dx <= 1; ++dx )
+    {
+        for( int dy = -1; dy <= 1; ++dy )
+            addJunction( VECTOR2I( dx * 10000, dy * 10000 ) );
+    }
+
+    BOX2I box( VECTOR2I( -100, -100 ), VECTOR2I( 200, 200 ) );
+
+    SCH_FREE_SLOT_FINDER finder( m_tree, { SCH_JUNCTION_T }, 0 );
+    BOOST_CHECK( !finder.FindNearest( box, 10000, 1 ).has_value() );
+
+    std::optional<VECTOR2I> offset = finder.FindNearest( box, 10000, 2 );
+    BOOST_REQUIRE( offset.has_value() );
+    BOOST_CHECK_EQUAL( *offset, VECTOR2I( -20000, -20000 ) );
+
+    // A large enough margin makes even the second ring collide
+    SCH_FREE_SLOT_FINDER wide( m_tree, { SCH_JUNCTION_T }, 5000 );
+    BOOST_CHECK( !wide.FindNearest( box, 10000, 2 ).has_value() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
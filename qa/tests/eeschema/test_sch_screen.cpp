@@ -30,6 +30,7 @@
 
 // Code under test
 #include <sch_screen.h>
+#include <sch_line.h>
 
 #include <qa_utils/uuid_test_utils.h>
 #include <qa_utils/wx_utils/wx_assert.h>
@@ -120,4 +121,53 @@ BOOST_AUTO_TEST_CASE( TestSharedByMultipleProjects )
 }
 
 
+/**
+ * Test the SCH_SCREEN::TestDanglingEnds() overload limited to a dirty area.
+ */
+BOOST_AUTO_TEST_CASE( TestDanglingEndsInArea )
+{
+    SCH_SCREEN screen;
+
+    auto addWire =
+            [&]( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+            {
+                SCH_LINE* wire = new SCH_LINE( aStart, LAYER_WIRE );
+                wire->SetEndPoint( aEnd );
+                screen.Append( wire );
+                return wire;
+            };
+
+    SCH_LINE* a = addWire( { 0, 0 }, { 1000, 0 } );
+    SCH_LINE* b = addWire( { 1000, 0 }, { 2000, 0 } );
+    SCH_LINE* c = addWire( { 10000, 0 }, { 11000, 0 } );
+    SCH_LINE* d = addWire( { 11000, 0 }, { 12000, 0 } );
+
+    screen.TestDanglingEnds();
+
+    BOOST_CHECK( !a->IsEndDangling() );
+    BOOST_CHECK( !b->IsStartDangling() );
+    BOOST_CHECK( !c->IsEndDangling() );
+
+    BOX2I dirtyArea = b->GetBoundingBox();
+
+    b->Move( { 0, 5000 } );
+    screen.Update( b );
+    dirtyArea.Merge( b->GetBoundingBox() );
+
+    // d moves outside the dirty area, so c must keep its stale state
+    d->Move( { 0, 5000 } );
+    screen.Update( d );
+
+    screen.TestDanglingEnds( dirtyArea );
+
+    BOOST_CHECK( a->IsEndDangling() );
+    BOOST_CHECK( b->IsStartDangling() );
+    BOOST_CHECK( !c->IsEndDangling() );
+
+    screen.TestDanglingEnds();
+
+    BOOST_CHECK( c->IsEndDangling() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * @file
+ * Test suite for SCH_WIRE_ROUTER
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <sch_junction.h>
+#include <sch_line.h>
+#include <sch_rtree.h>
+
+// Code under test
+#include <sch_wire_router.h>
+
+
+class TEST_SCH_WIRE_ROUTER_FIXTURE
+{
+public:
+    ~TEST_SCH_WIRE_ROUTER_FIXTURE()
+    {
+        for( SCH_ITEM* item : m_items )
+            delete item;
+    }
+
+    void addWire( const VECTOR2I& aStart, const VECTOR2I& aEnd )
+    {
+        SCH_LINE* wire = new SCH_LINE( aStart, LAYER_WIRE );
+        wire->SetEndPoint( aEnd );
+        m_items.push_back( wire );
+        m_tree.insert( wire );
+    }
+
+    void addJunction( const VECTOR2I& aPos )
+    {
+        SCH_JUNCTION* junction = new SCH_JUNCTION( aPos, 10 );
+        m_items.push_back( junction );
+        m_tree.insert( junction );
+    }
+
+    SCH_WIRE_ROUTER build()
+    {
+        SCH_WIRE_ROUTER router( GRID );
+        router.Build( m_tree, BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 2000, 2000 ) ) );
+        return router;
+    }
+
+    static constexpr int GRID = 100;
+
+    EE_RTREE               m_tree;
+    std::vector<SCH_ITEM*> m_items;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( SchWireRouter, TEST_SCH_WIRE_ROUTER_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( StraightAndBend )
+{
+    SCH_WIRE_ROUTER router = build();
+
+    std::vector<VECTOR2I> straight = router.Route( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ) );
+    BOOST_REQUIRE_EQUAL( straight.size(), 2 );
+    BOOST_CHECK_EQUAL( straight.back(), VECTOR2I( 1000, 0 ) );
+
+    // A single corner, never a staircase
+    std::vector<VECTOR2I> bend = router.Route( VECTOR2I( 0, 0 ), VECTOR2I( 500, 500 ) );
+    BOOST_REQUIRE_EQUAL( bend.size(), 3 );
+    BOOST_CHECK( bend[1] == VECTOR2I( 500, 0 ) || bend[1] == VECTOR2I( 0, 500 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( CoversOnlyGridPoints )
+{
+    SCH_WIRE_ROUTER router = build();
+
+    BOOST_CHECK( router.Covers( VECTOR2I( 0, 0 ), VECTOR2I( 2000, 2000 ) ) );
+    BOOST_CHECK( !router.Covers( VECTOR2I( 50, 0 ), VECTOR2I( 1000, 0 ) ) );
+    BOOST_CHECK( !router.Covers( VECTOR2I( 0, 0 ), VECTOR2I( 100000, 0 ) ) );
+    BOOST_CHECK( router.Route( VECTOR2I( 50, 0 ), VECTOR2I( 1000, 0 ) ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( AvoidsConnectionPoints )
+{
+    // A wire on the direct path and a junction: running along or through either would
+    // connect the new wire to them
+    addWire( VECTOR2I( 200, 0 ), VECTOR2I( 400, 0 ) );
+    addJunction( VECTOR2I( 700, 0 ) );
+
+    SCH_WIRE_ROUTER       router = build();
+    std::vector<VECTOR2I> path = router.Route( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ) );
+
+    BOOST_REQUIRE_EQUAL( path.size(), 4 );
+    BOOST_CHECK_NE( path[1].y, 0 );
+    BOOST_CHECK_EQUAL( path[1].y, path[2].y );
+}
+
+
+BOOST_AUTO_TEST_CASE( CrossesPerpendicularWire )
+{
+    addWire( VECTOR2I( 500, -1000 ), VECTOR2I( 500, 1000 ) );
+
+    SCH_WIRE_ROUTER       router = build();
+    std::vector<VECTOR2I> path = router.Route( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ) );
+
+    BOOST_CHECK_EQUAL( path.size(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( AddedWiresAreObstacles )
+{
+    SCH_WIRE_ROUTER router = build();
+
+    std::vector<VECTOR2I> first = router.Route( VECTOR2I( 0, 500 ), VECTOR2I( 1000, 500 ) );
+    BOOST_REQUIRE_EQUAL( first.size(), 2 );
+
+    router.AddWire( first[0], first[1] );
+
+    // The same route again must not overlap the first wire
+    std::vector<VECTOR2I> second = router.Route( VECTOR2I( 200, 500 ), VECTOR2I( 800, 500 ) );
+    BOOST_CHECK( second.empty() || second.size() > 2 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
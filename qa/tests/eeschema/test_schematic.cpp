@@ -79,4 +79,29 @@ BOOST_AUTO_TEST_CASE( TestSchematicIsComplexHierarchy )
 }
 
 
+BOOST_AUTO_TEST_CASE( TestSchematicHierarchySnapshot )
+{
+    LoadSchematic( SchematicQAPath( "netlists/complex_hierarchy/complex_hierarchy" ) );
+
+    std::shared_ptr<const SCH_SHEET_LIST> snapshot = m_schematic->HierarchySnapshot();
+    uint64_t                              generation = m_schematic->GetHierarchyGeneration();
+
+    BOOST_REQUIRE( snapshot );
+    BOOST_CHECK_EQUAL( snapshot->size(), m_schematic->Hierarchy().size() );
+
+    // Nothing changed, so the snapshot is kept
+    m_schematic->RefreshHierarchy();
+
+    BOOST_CHECK( m_schematic->HierarchySnapshot() == snapshot );
+    BOOST_CHECK_EQUAL( m_schematic->GetHierarchyGeneration(), generation );
+
+    // Sorted by page number, like Hierarchy()
+    SCH_SHEET_LIST sorted = *snapshot;
+    sorted.SortByPageNumbers();
+
+    for( size_t ii = 0; ii < sorted.size(); ++ii )
+        BOOST_CHECK( sorted[ii] == ( *snapshot )[ii] );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Test suite for SYMBOL_EMBEDDING_INDEX.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <libraries/symbol_embedding_index.h>
+
+#include <wx/filename.h>
+
+
+namespace
+{
+/**
+ * A stand-in for an embedding model: letter counts, so texts sharing letters are similar.
+ */
+struct LETTER_EMBEDDER
+{
+    bool operator()( const std::vector<wxString>& aTexts, std::vector<std::vector<float>>& aVectors )
+    {
+        calls++;
+        embedded += aTexts.size();
+
+        for( const wxString& text : aTexts )
+        {
+            std::vector<float> vector( 26, 0.0f );
+
+            for( wxUniChar c : text.Lower() )
+            {
+                if( c >= 'a' && c <= 'z' )
+                    vector[c - 'a'] += 1.0f;
+            }
+
+            aVectors.push_back( vector );
+        }
+
+        return true;
+    }
+
+    int    calls = 0;
+    size_t embedded = 0;
+};
+
+
+std::vector<float> embed( const wxString& aText )
+{
+    LETTER_EMBEDDER                 embedder;
+    std::vector<std::vector<float>> vectors;
+
+    embedder( { aText }, vectors );
+    return vectors.front();
+}
+} // namespace
+
+
+BOOST_AUTO_TEST_SUITE( SymbolEmbeddingIndex )
+
+
+BOOST_AUTO_TEST_CASE( NearestFirst )
+{
+    SYMBOL_EMBEDDING_INDEX index;
+    LETTER_EMBEDDER        embedder;
+
+    BOOST_REQUIRE( index.Update( { { wxS( "Lib:A" ), wxS( "aaaa" ) },
+                                   { wxS( "Lib:B" ), wxS( "bbbb" ) },
+                                   { wxS( "Lib:AB" ), wxS( "aab" ) } },
+                                 wxS( "letters" ), std::ref( embedder ) ) );
+
+    std::vector<SYMBOL_EMBEDDING_INDEX::MATCH> matches = index.Search( embed( wxS( "a" ) ), 2 );
+
+    BOOST_REQUIRE_EQUAL( matches.size(), 2 );
+    BOOST_CHECK_EQUAL( matches[0].key, wxS( "Lib:A" ) );
+    BOOST_CHECK_CLOSE( matches[0].score, 1.0f, 0.001 );
+    BOOST_CHECK_EQUAL( matches[1].key, wxS( "Lib:AB" ) );
+
+    // A query from another model (dimension) finds nothing
+    BOOST_CHECK( index.Search( std::vector<float>( 3, 1.0f ), 2 ).empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( ReusesUnchangedVectors )
+{
+    SYMBOL_EMBEDDING_INDEX index;
+    LETTER_EMBEDDER        embedder;
+
+    BOOST_REQUIRE( index.Update( { { wxS( "Lib:A" ), wxS( "aaaa" ) },
+                                   { wxS( "Lib:B" ), wxS( "bbbb" ) } },
+                                 wxS( "letters" ), std::ref( embedder ) ) );
+    BOOST_CHECK_EQUAL( embedder.embedded, 2 );
+
+    BOOST_REQUIRE( index.Update( { { wxS( "Lib:A" ), wxS( "aaaa" ) },
+                                   { wxS( "Lib:B" ), wxS( "cccc" ) },
+                                   { wxS( "Lib:C" ), wxS( "dddd" ) } },
+                                 wxS( "letters" ), std::ref( embedder ) ) );
+    BOOST_CHECK_EQUAL( embedder.embedded, 4 );
+    BOOST_CHECK_EQUAL( index.Size(), 3 );
+
+    // Another model invalidates everything
+    BOOST_REQUIRE( index.Update( { { wxS( "Lib:A" ), wxS( "aaaa" ) } }, wxS( "other" ),
+                                 std::ref( embedder ) ) );
+    BOOST_CHECK_EQUAL( embedder.embedded, 5 );
+
+    // A failed update leaves the index as it was
+    BOOST_CHECK( !index.Update( { { wxS( "Lib:Z" ), wxS( "zzzz" ) } }, wxS( "other" ),
+                                []( const std::vector<wxString>&, std::vector<std::vector<float>>& )
+                                {
+                                    return false;
+                                } ) );
+    BOOST_CHECK_EQUAL( index.Size(), 1 );
+    BOOST_CHECK_EQUAL( index.GetModel(), wxS( "other" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( PartitionedSearchAndCache )
+{
+    std::vector<SYMBOL_EMBEDDING_INDEX::DOCUMENT> docs;
+
+    // Enough documents to be partitioned, each with a distinct letter mix
+    for( int ii = 0; ii < 2000; ++ii )
+    {
+        wxString text;
+
+        for( int jj = 0; jj < 6; ++jj )
+            text << wxUniChar( 'a' + ( ii * ( jj + 7 ) + jj * jj ) % 26 );
+
+        docs.push_back( { wxString::Format( wxS( "Lib:S%d" ), ii ), text } );
+    }
+
+    SYMBOL_EMBEDDING_INDEX index;
+    LETTER_EMBEDDER        embedder;
+
+    BOOST_REQUIRE( index.Update( docs, wxS( "letters" ), std::ref( embedder ) ) );
+    BOOST_CHECK_EQUAL( embedder.calls,
+                       int( ( docs.size() + SYMBOL_EMBEDDING_INDEX::BATCH_SIZE - 1 )
+                            / SYMBOL_EMBEDDING_INDEX::BATCH_SIZE ) );
+
+    // The query's own document is in the list of its nearest centroid
+    std::vector<SYMBOL_EMBEDDING_INDEX::MATCH> matches = index.Search( embed( docs[123].text ), 1 );
+
+    BOOST_REQUIRE_EQUAL( matches.size(), 1 );
+    BOOST_CHECK_CLOSE( matches[0].score, 1.0f, 0.001 );
+
+    wxString cachePath = wxFileName::CreateTempFileName( wxS( "symbol_embedding_cache" ) );
+
+    BOOST_REQUIRE( index.WriteCacheToFile( cachePath ) );
+
+    SYMBOL_EMBEDDING_INDEX restored;
+
+    BOOST_REQUIRE( restored.ReadCacheFromFile( cachePath ) );
+    BOOST_CHECK_EQUAL( restored.Size(), docs.size() );
+    BOOST_CHECK_EQUAL( restored.GetModel(), wxS( "letters" ) );
+
+    std::vector<SYMBOL_EMBEDDING_INDEX::MATCH> again = restored.Search( embed( docs[123].text ), 1 );
+
+    BOOST_REQUIRE_EQUAL( again.size(), 1 );
+    BOOST_CHECK_EQUAL( again[0].key, matches[0].key );
+
+    // Nothing is embedded again after a restore
+    LETTER_EMBEDDER counter;
+
+    BOOST_REQUIRE( restored.Update( docs, wxS( "letters" ), std::ref( counter ) ) );
+    BOOST_CHECK_EQUAL( counter.calls, 0 );
+
+    wxRemoveFile( cachePath );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file
+ * Test suite for SYMBOL_SEARCH_INDEX.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <libraries/symbol_search_index.h>
+
+#include <wx/filename.h>
+
+
+BOOST_AUTO_TEST_SUITE( SymbolSearchIndex )
+
+
+BOOST_AUTO_TEST_CASE( Normalize )
+{
+    BOOST_CHECK_EQUAL( SYMBOL_SEARCH_INDEX::Normalize( wxS( "LM-0358" ) ), wxS( "lm358" ) );
+    BOOST_CHECK_EQUAL( SYMBOL_SEARCH_INDEX::Normalize( wxS( "R_0000" ) ), wxS( "r0" ) );
+    BOOST_CHECK_EQUAL( SYMBOL_SEARCH_INDEX::Normalize( wxS( "ATmega328P-AU" ) ),
+                       wxS( "atmega328pau" ) );
+    BOOST_CHECK_EQUAL( SYMBOL_SEARCH_INDEX::Normalize( wxS( "" ) ), wxS( "" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( Ranking )
+{
+    SYMBOL_SEARCH_INDEX index;
+
+    index.SetLibrary( wxS( "Device" ), 1, { wxS( "R" ), wxS( "R_Small" ), wxS( "C" ) } );
+    index.SetLibrary( wxS( "Interface_CAN_LIN" ), 1, { wxS( "MCP2551-I-P" ), wxS( "MCP2551-I-SN" ),
+                                                        wxS( "TJA1050" ) } );
+
+    std::vector<SYMBOL_SEARCH_INDEX::MATCH> matches = index.Search( wxS( "mcp2551" ), 10 );
+
+    BOOST_REQUIRE_EQUAL( matches.size(), 2 );
+    BOOST_CHECK_EQUAL( matches[0].name, wxS( "MCP2551-I-P" ) );
+    BOOST_CHECK_EQUAL( matches[0].score, 900 );
+    BOOST_CHECK_EQUAL( matches[1].name, wxS( "MCP2551-I-SN" ) );
+
+    // Exact match wins over prefix matches
+    matches = index.Search( wxS( "R" ), 10 );
+    BOOST_REQUIRE( !matches.empty() );
+    BOOST_CHECK_EQUAL( matches[0].name, wxS( "R" ) );
+    BOOST_CHECK_EQUAL( matches[0].score, 1000 );
+
+    // "lib:name" queries also match on the name part
+    matches = index.Search( wxS( "Foo:TJA1050" ), 10 );
+    BOOST_REQUIRE_EQUAL( matches.size(), 1 );
+    BOOST_CHECK_EQUAL( matches[0].library, wxS( "Interface_CAN_LIN" ) );
+
+    // Normalized matching ignores punctuation and leading zeros
+    matches = index.Search( wxS( "tja-01050" ), 10 );
+    BOOST_REQUIRE_EQUAL( matches.size(), 1 );
+    BOOST_CHECK_EQUAL( matches[0].score, 980 );
+
+    BOOST_CHECK_EQUAL( index.Search( wxS( "mcp" ), 1 ).size(), 1 );
+    BOOST_CHECK( index.Search( wxS( "nothing_like_this" ), 10 ).empty() );
+}
+
+
+/**
+ * The trigram prefilter must never drop a name that a full substring scan would have found.
+ */
+BOOST_AUTO_TEST_CASE( PrefilterMatchesScan )
+{
+    std::vector<wxString> names;
+
+    for( int ii = 0; ii < 500; ++ii )
+        names.push_back( wxString::Format( wxS( "PART_%03d_%c" ), ii, 'A' + ( ii % 26 ) ) );
+
+    SYMBOL_SEARCH_INDEX index;
+    index.SetLibrary( wxS( "Lib" ), 1, names );
+
+    for( const wxString& query : { wxS( "part_01" ), wxS( "7_b" ), wxS( "12" ), wxS( "art" ) } )
+    {
+        size_t expected = 0;
+
+        for( const wxString& name : names )
+        {
+            if( name.Lower().Contains( query )
+                || SYMBOL_SEARCH_INDEX::Normalize( name ).Contains(
+                        SYMBOL_SEARCH_INDEX::Normalize( query ) ) )
+            {
+                expected++;
+            }
+        }
+
+        BOOST_CHECK_EQUAL( index.Search( query, names.size() ).size(), expected );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( CacheRoundTrip )
+{
+    wxFileName cacheFile( wxFileName::CreateTempFileName( wxS( "sym-search-cache" ) ) );
+
+    SYMBOL_SEARCH_INDEX index;
+    index.SetLibrary( wxS( "Device" ), 1234, { wxS( "R" ), wxS( "C" ), wxS( "L" ) } );
+    index.SetLibrary( wxS( "Database" ), 0, { wxS( "DB_PART" ) } );
+    BOOST_CHECK( index.IsModified() );
+
+    index.WriteCacheToFile( cacheFile.GetFullPath() );
+    BOOST_CHECK( !index.IsModified() );
+
+    SYMBOL_SEARCH_INDEX restored;
+    restored.ReadCacheFromFile( cacheFile.GetFullPath() );
+
+    BOOST_CHECK( restored.HasLibrary( wxS( "Device" ) ) );
+
+    // Libraries without a timestamp cannot be validated and are not persisted
+    BOOST_CHECK( !restored.HasLibrary( wxS( "Database" ) ) );
+    BOOST_CHECK_EQUAL( restored.GetSymbolCount(), 3 );
+    BOOST_CHECK_EQUAL( restored.Search( wxS( "L" ), 10 ).size(), 1 );
+
+    wxRemoveFile( cacheFile.GetFullPath() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
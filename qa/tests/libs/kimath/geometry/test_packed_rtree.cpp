@@ -0,0 +1,145 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <algorithm>
+#include <random>
+
+#include <geometry/packed_rtree.h>
+
+
+static std::vector<int> search( const PACKED_RTREE<int>& aTree, const BOX2I& aBox )
+{
+    std::vector<int> found;
+
+    auto visitor =
+            [&]( int aItem ) -> bool
+            {
+                found.push_back( aItem );
+                return true;
+            };
+
+    aTree.Search( aBox, visitor );
+    std::sort( found.begin(), found.end() );
+
+    return found;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+BOOST_AUTO_TEST_CASE( EmptyAndSingle )
+{
+    PACKED_RTREE<int> tree;
+
+    tree.Build();
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ) ).empty() );
+
+    tree.Add( BOX2I( VECTOR2I( 5, 5 ), VECTOR2I( 2, 2 ) ), 42 );
+    BOOST_TEST( !tree.IsBuilt() );
+
+    tree.Build();
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ) )
+                == std::vector<int>{ 42 } );
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 20, 20 ), VECTOR2I( 10, 10 ) ) ).empty() );
+
+    // Touching boxes overlap, as in RTree
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 7, 7 ), VECTOR2I( 3, 3 ) ) )
+                == std::vector<int>{ 42 } );
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesBruteForce )
+{
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> pos( -1000000, 1000000 );
+    std::uniform_int_distribution<int> size( 0, 50000 );
+
+    std::vector<BOX2I> boxes;
+    PACKED_RTREE<int>  tree;
+
+    // Enough items for several node levels
+    for( int ii = 0; ii < 5000; ++ii )
+    {
+        boxes.emplace_back( VECTOR2I( pos( rng ), pos( rng ) ), VECTOR2I( size( rng ), size( rng ) ) );
+        tree.Add( boxes.back(), ii );
+    }
+
+    tree.Build();
+
+    BOOST_REQUIRE_EQUAL( tree.Size(), boxes.size() );
+
+    for( int query = 0; query < 200; ++query )
+    {
+        BOX2I box( VECTOR2I( pos( rng ), pos( rng ) ), VECTOR2I( 4 * size( rng ), 4 * size( rng ) ) );
+
+        std::vector<int> expected;
+
+        for( int ii = 0; ii < (int) boxes.size(); ++ii )
+        {
+            if( boxes[ii].GetLeft() <= box.GetRight() && boxes[ii].GetRight() >= box.GetLeft()
+                    && boxes[ii].GetTop() <= box.GetBottom()
+                    && boxes[ii].GetBottom() >= box.GetTop() )
+            {
+                expected.push_back( ii );
+            }
+        }
+
+        BOOST_TEST( search( tree, box ) == expected );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( StopAndRebuild )
+{
+    PACKED_RTREE<int> tree;
+
+    for( int ii = 0; ii < 100; ++ii )
+        tree.Add( BOX2I( VECTOR2I( ii * 10, 0 ), VECTOR2I( 5, 5 ) ), ii );
+
+    tree.Build();
+
+    int  visited = 0;
+    auto stopAtThree =
+            [&]( int ) -> bool
+            {
+                return ++visited < 3;
+            };
+
+    BOOST_TEST( tree.Search( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 10 ) ), stopAtThree ) == 3 );
+    BOOST_TEST( visited == 3 );
+
+    // Items added after a build are found once the tree is built again
+    tree.Add( BOX2I( VECTOR2I( 5000, 5000 ), VECTOR2I( 5, 5 ) ), 1000 );
+    tree.Build();
+
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 4990, 4990 ), VECTOR2I( 20, 20 ) ) )
+                == std::vector<int>{ 1000 } );
+    BOOST_TEST( search( tree, BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 10 ) ) ).size() == 100 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
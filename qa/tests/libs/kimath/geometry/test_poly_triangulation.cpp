@@ -15,6 +15,7 @@
 #include <trigo.h>
 #include <thread>
 #include <chrono>
+#include <functional>
 #include <future>
 
 #include <qa_utils/geometry/geometry.h>
@@ -616,6 +617,65 @@ BOOST_AUTO_TEST_CASE( SourceOutlineIndexTracking )
     BOOST_TEST( result.GetSourceOutlineIndex() == expectedOutlineIndex );
 }
 
+BOOST_AUTO_TEST_CASE( PartitionedTriangulationReuse )
+{
+    // Large enough to be split into several 1e7 grid cells
+    const int size = 35000000;
+
+    SHAPE_POLY_SET previous;
+    previous.AddOutline( createSquare( size ) );
+    previous.AddOutline( createSquare( size, VECTOR2I( 2 * size, 0 ) ) );
+    previous.CacheTriangulation();
+
+    BOOST_REQUIRE( previous.IsTriangulationUpToDate() );
+
+    // Only the second outline changes
+    SHAPE_POLY_SET poly;
+    poly.AddOutline( createSquare( size ) );
+    poly.AddOutline( createSquare( size, VECTOR2I( 3 * size, 0 ) ) );
+    poly.ReuseTriangulationFrom( previous );
+
+    std::vector<size_t> jobCounts;
+
+    SHAPE_POLY_SET::PARALLEL_FOR parallelFor =
+            [&]( size_t aCount, const std::function<void( size_t )>& aJob )
+            {
+                jobCounts.push_back( aCount );
+
+                std::vector<std::thread> threads;
+
+                for( size_t ii = 0; ii < aCount; ++ii )
+                    threads.emplace_back( aJob, ii );
+
+                for( std::thread& thread : threads )
+                    thread.join();
+            };
+
+    poly.CacheTriangulation( true, false, parallelFor );
+
+    BOOST_REQUIRE( poly.IsTriangulationUpToDate() );
+
+    // One outline job, then one job per grid cell of that outline
+    BOOST_REQUIRE( jobCounts.size() == 2 );
+    BOOST_TEST( jobCounts[0] == 1 );
+    BOOST_TEST( jobCounts[1] > 1 );
+
+    double area = 0.0;
+
+    for( unsigned ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = poly.TriangulatedPolygon( ii );
+
+        BOOST_TEST( tri->GetSourceOutlineIndex() >= 0 );
+        BOOST_TEST( tri->GetSourceOutlineIndex() < 2 );
+
+        for( const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI& t : tri->Triangles() )
+            area += t.Area();
+    }
+
+    BOOST_TEST( area == 2.0 * size * size, boost::test_tools::tolerance( 1e-6 ) );
+}
+
 // Performance regression tests
 BOOST_AUTO_TEST_CASE( PerformanceRegression )
 {
@@ -0,0 +1,133 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+#include <geometry/polygon_strip_index.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+
+static SHAPE_LINE_CHAIN randomStar( std::mt19937& aRng, int aPoints, int aRadius )
+{
+    std::uniform_int_distribution<int> radius( aRadius / 2, aRadius );
+    SHAPE_LINE_CHAIN                   chain;
+
+    for( int ii = 0; ii < aPoints; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aPoints;
+        int    r = radius( aRng );
+
+        chain.Append( KiROUND( r * cos( angle ) ), KiROUND( r * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PolygonStripIndex )
+
+
+BOOST_AUTO_TEST_CASE( MatchesPointInside )
+{
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( -1200, 1200 );
+
+    for( int pointCount : { 3, 4, 17, 250 } )
+    {
+        SHAPE_LINE_CHAIN    chain = randomStar( rng, pointCount, 1000 );
+        POLYGON_STRIP_INDEX index( chain );
+
+        for( int ii = 0; ii < 20000; ++ii )
+        {
+            VECTOR2I pt( coord( rng ), coord( rng ) );
+
+            BOOST_TEST_INFO( "point " << pt.x << ", " << pt.y );
+            BOOST_TEST( index.PointInside( pt ) == chain.PointInside( pt ) );
+        }
+
+        // Vertices and edge midpoints are where rounding matters
+        for( int ii = 0; ii < chain.PointCount(); ++ii )
+        {
+            const VECTOR2I& a = chain.CPoint( ii );
+            const VECTOR2I& b = chain.CPoint( ( ii + 1 ) % chain.PointCount() );
+            VECTOR2I        mid = ( a + b ) / 2;
+
+            BOOST_TEST( index.PointInside( a ) == chain.PointInside( a ) );
+            BOOST_TEST( index.PointInside( mid ) == chain.PointInside( mid ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( OpenAndDegenerate )
+{
+    SHAPE_LINE_CHAIN open( { VECTOR2I( 0, 0 ), VECTOR2I( 100, 0 ), VECTOR2I( 100, 100 ) } );
+    POLYGON_STRIP_INDEX openIndex( open );
+
+    BOOST_TEST( !openIndex.PointInside( VECTOR2I( 90, 10 ) ) );
+
+    SHAPE_LINE_CHAIN flat( { VECTOR2I( 0, 0 ), VECTOR2I( 100, 0 ), VECTOR2I( 50, 0 ) }, true );
+    POLYGON_STRIP_INDEX flatIndex( flat );
+
+    BOOST_TEST( !flatIndex.PointInside( VECTOR2I( 50, 0 ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( ContainsPointsMatchesContains )
+{
+    std::mt19937                       rng( 7 );
+    std::uniform_int_distribution<int> coord( -5000, 5000 );
+
+    SHAPE_POLY_SET poly;
+
+    poly.AddOutline( randomStar( rng, 40, 2000 ) );
+    poly.AddHole( randomStar( rng, 12, 600 ) );
+
+    SHAPE_LINE_CHAIN second = randomStar( rng, 30, 1000 );
+    second.Move( VECTOR2I( 3500, 3500 ) );
+    poly.AddOutline( second );
+
+    std::vector<VECTOR2I> points;
+
+    for( int ii = 0; ii < 20000; ++ii )
+        points.emplace_back( coord( rng ), coord( rng ) );
+
+    for( int accuracy : { 0, 1, 50 } )
+    {
+        std::vector<uint8_t> result;
+        poly.ContainsPoints( points, result, accuracy );
+
+        BOOST_REQUIRE_EQUAL( result.size(), points.size() );
+
+        for( size_t ii = 0; ii < points.size(); ++ii )
+            BOOST_TEST( bool( result[ii] ) == poly.Contains( points[ii], -1, accuracy ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
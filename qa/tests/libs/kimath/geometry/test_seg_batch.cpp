@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <random>
+
+#include <geometry/seg_batch.h>
+
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+
+BOOST_AUTO_TEST_CASE( SpecialCases )
+{
+    const SEG ref( { 0, 0 }, { 1000, 0 } );
+
+    // clang-format off
+    const std::vector<SEG> segs =
+    {
+        SEG( {  500, -500 }, {  500,  500 } ),  // crossing
+        SEG( { 2000,    0 }, { 3000,    0 } ),  // collinear, disjoint
+        SEG( {  500,    0 }, { 1500,    0 } ),  // collinear, overlapping
+        SEG( {  200,  300 }, {  200,  300 } ),  // zero length
+        SEG( { 1000,    0 }, { 1000,  800 } ),  // touching at an endpoint
+        SEG( {    0,  100 }, { 1000,  100 } ),  // parallel
+    };
+    // clang-format on
+
+    SEG_BATCH batch;
+
+    for( const SEG& seg : segs )
+        batch.Add( seg );
+
+    BOOST_REQUIRE_EQUAL( batch.Size(), segs.size() );
+
+    std::vector<double> distances;
+    batch.SquaredDistances( ref, distances );
+
+    for( size_t ii = 0; ii < segs.size(); ++ii )
+        BOOST_CHECK_CLOSE( distances[ii] + 1.0, (double) ref.SquaredDistance( segs[ii] ) + 1.0, 1e-6 );
+
+    // A zero-length reference behaves as a point
+    std::vector<double> pointDistances;
+    batch.SquaredDistances( SEG( { 200, 300 }, { 200, 300 } ), pointDistances );
+    BOOST_CHECK_EQUAL( pointDistances[3], 0.0 );
+    BOOST_CHECK_CLOSE( pointDistances[5], 200.0 * 200.0, 1e-6 );
+}
+
+
+BOOST_AUTO_TEST_CASE( CollideIsConservative )
+{
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( -100000, 100000 );
+    std::uniform_int_distribution<int> width( 0, 5000 );
+
+    for( int pass = 0; pass < 200; ++pass )
+    {
+        const SEG ref( { coord( rng ), coord( rng ) }, { coord( rng ), coord( rng ) } );
+        const int clearance = width( rng );
+
+        std::vector<SEG> segs;
+        std::vector<int> radii;
+        SEG_BATCH        batch;
+
+        for( int ii = 0; ii < 64; ++ii )
+        {
+            segs.emplace_back( VECTOR2I( coord( rng ), coord( rng ) ),
+                               VECTOR2I( coord( rng ), coord( rng ) ) );
+            radii.push_back( width( rng ) );
+            batch.Add( segs.back(), radii.back() );
+        }
+
+        std::vector<uint8_t> mask;
+        batch.Collide( ref, clearance, mask );
+
+        BOOST_REQUIRE_EQUAL( mask.size(), segs.size() );
+
+        for( size_t ii = 0; ii < segs.size(); ++ii )
+        {
+            if( ref.Collide( segs[ii], clearance + radii[ii] ) )
+                BOOST_CHECK( mask[ii] );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1677,4 +1677,32 @@ BOOST_AUTO_TEST_CASE( IntersectLineZeroLengthSegments )
     BOOST_CHECK_EQUAL( intersection, point );
 }
 
+BOOST_AUTO_TEST_CASE( ExactPredicatesLargeCoordinates )
+{
+    // Spans wider than an int, where B - A used to overflow
+    const int big = std::numeric_limits<int>::max() - 10;
+    SEG       diag( { -big, -big }, { big, big } );
+
+    BOOST_CHECK_EQUAL( diag.Side( { 0, 0 } ), 0 );
+    BOOST_CHECK_EQUAL( diag.Side( { 0, 1 } ), 1 );
+    BOOST_CHECK_EQUAL( diag.Side( { 1, 0 } ), -1 );
+
+    // A point 1 nm off a long, nearly axis-aligned segment
+    SEG longSeg( { -big, 0 }, { big, 1 } );
+
+    BOOST_CHECK_EQUAL( longSeg.SquaredDistance( VECTOR2I( 0, 2 ) ), 2 );
+    BOOST_CHECK_EQUAL( longSeg.SquaredDistance( VECTOR2I( 0, -1 ) ), 2 );
+
+    // Collisions with and without a reported distance agree at the clearance boundary
+    SEG a( { 0, 0 }, { 1000000000, 0 } );
+    SEG b( { 500000000, 300 }, { 500000000, 1000 } );
+    int actual = -1;
+
+    BOOST_CHECK( !a.Collide( b, 300 ) );
+    BOOST_CHECK( !a.Collide( b, 300, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 300 );
+    BOOST_CHECK( a.Collide( b, 301 ) );
+    BOOST_CHECK( a.Collide( b, 301, &actual ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1185,4 +1185,36 @@ BOOST_DATA_TEST_CASE( ArcToPolyline, boost::unit_test::data::make( ArcToPolyline
 }
 
 
+BOOST_AUTO_TEST_CASE( ArcToPolylineRepeated )
+{
+    // Converted often enough to come from the polyline cache the second time
+    const SHAPE_ARC arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000000, 0 ), EDA_ANGLE( 135.0, DEGREES_T ),
+                         20000 );
+
+    for( int accuracy : { 100, 1000, 100 } )
+    {
+        int firstError = 0;
+        int secondError = 0;
+
+        const SHAPE_LINE_CHAIN first = arc.ConvertToPolyline( accuracy, &firstError );
+        const SHAPE_LINE_CHAIN second = arc.ConvertToPolyline( accuracy, &secondError );
+
+        BOOST_TEST( first.PointCount() > 8 );
+        BOOST_CHECK( first.CPoints() == second.CPoints() );
+        BOOST_TEST( firstError == secondError );
+        BOOST_TEST( second.BBox() == first.BBox() );
+    }
+
+    // A moved arc must not get the polyline of the original
+    SHAPE_ARC moved( arc );
+    moved.Move( VECTOR2I( 10, 0 ) );
+
+    SHAPE_LINE_CHAIN expected = arc.ConvertToPolyline( 100 );
+    expected.Move( VECTOR2I( 10, 0 ) );
+
+    BOOST_TEST( moved.ConvertToPolyline( 100 ).CPoint( 0 ) == expected.CPoint( 0 ) );
+    BOOST_TEST( moved.ConvertToPolyline( 100 ).CLastPoint() == expected.CLastPoint() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
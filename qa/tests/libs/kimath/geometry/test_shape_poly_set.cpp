@@ -163,4 +163,45 @@ BOOST_AUTO_TEST_CASE( GetNeighbourIndexes_MultiOutline )
     BOOST_TEST( !ok );
 }
 
+
+BOOST_AUTO_TEST_CASE( GroupedInflate )
+{
+    // A row of squares, some of which merge once inflated
+    SHAPE_POLY_SET base_set;
+
+    for( int ii = 0; ii < 100; ++ii )
+    {
+        int x = ii * 3000 + ( ii % 3 == 0 ? 0 : 1500 );
+
+        SHAPE_LINE_CHAIN square( { VECTOR2I( x, 0 ), VECTOR2I( x + 1000, 0 ),
+                                   VECTOR2I( x + 1000, 1000 ), VECTOR2I( x, 1000 ) },
+                                 true );
+        base_set.AddOutline( square );
+    }
+
+    size_t groupCount = 0;
+
+    SHAPE_POLY_SET::PARALLEL_FOR serialFor =
+            [&]( size_t aCount, const std::function<void( size_t )>& aJob )
+            {
+                groupCount = aCount;
+
+                for( size_t ii = 0; ii < aCount; ++ii )
+                    aJob( ii );
+            };
+
+    for( int amount : { 300, -200 } )
+    {
+        SHAPE_POLY_SET expected = base_set.CloneDropTriangulation();
+        SHAPE_POLY_SET grouped = base_set.CloneDropTriangulation();
+
+        expected.Inflate( amount, CORNER_STRATEGY::ROUND_ALL_CORNERS, 10 );
+        grouped.Inflate( amount, CORNER_STRATEGY::ROUND_ALL_CORNERS, 10, false, serialFor );
+
+        BOOST_TEST( groupCount > 1 );
+        BOOST_TEST( grouped.OutlineCount() == expected.OutlineCount() );
+        BOOST_TEST( grouped.Area() == expected.Area() );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
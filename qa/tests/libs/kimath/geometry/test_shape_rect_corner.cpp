@@ -24,7 +24,9 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <boost/test/unit_test.hpp>
 
+#include <geometry/shape_circle.h>
 #include <geometry/shape_rect.h>
+#include <geometry/shape_segment.h>
 
 BOOST_AUTO_TEST_CASE( ShapeRectCornerRadius )
 {
@@ -32,3 +34,33 @@ BOOST_AUTO_TEST_CASE( ShapeRectCornerRadius )
     rect.SetRadius( 2 );
     BOOST_CHECK_EQUAL( rect.GetRadius(), 2 );
 }
+
+
+BOOST_AUTO_TEST_CASE( ShapeRectRoundedCollisions )
+{
+    SHAPE_RECT rect( VECTOR2I( 0, 0 ), 1000, 1000 );
+    rect.SetRadius( 200 );
+
+    int actual = 0;
+
+    // Corner arc centre is (800, 800): distance to the circle centre is 707.1
+    SHAPE_CIRCLE circle( VECTOR2I( 1300, 1300 ), 50 );
+    BOOST_CHECK( rect.Collide( &circle, 500, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 457 );
+    BOOST_CHECK( !rect.Collide( &circle, 450 ) );
+
+    SHAPE_SEGMENT segment( VECTOR2I( 1100, -500 ), VECTOR2I( 1100, 1500 ), 100 );
+    BOOST_CHECK( rect.Collide( &segment, 100, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 50 );
+    BOOST_CHECK( !rect.Collide( &segment, 50 ) );
+
+    SHAPE_RECT other( VECTOR2I( 1200, 1200 ), 500, 500 );
+    other.SetRadius( 100 );
+    BOOST_CHECK( rect.Collide( &other, 500, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 407 );
+    BOOST_CHECK( !rect.Collide( &other, 400 ) );
+
+    SHAPE_RECT overlapping( VECTOR2I( 900, 900 ), 500, 500 );
+    BOOST_CHECK( rect.Collide( &overlapping, 0, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 0 );
+}
@@ -126,4 +126,18 @@ BOOST_AUTO_TEST_CASE( test_rescale_int64 )
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( TestCompareProducts )
+{
+    BOOST_CHECK_EQUAL( CompareProducts( 2, 3, 1, 6 ), 0 );
+    BOOST_CHECK_EQUAL( CompareProducts( 2, 3, 1, 7 ), -1 );
+    BOOST_CHECK_EQUAL( CompareProducts( -2, 3, -1, 7 ), 1 );
+
+    // Products beyond 64 bits that differ only in the lowest bit
+    BOOST_CHECK_EQUAL( CompareProducts( INT64_MAX, INT64_MAX, INT64_MAX - 1, INT64_MAX ), 1 );
+    BOOST_CHECK_EQUAL( CompareProducts( INT64_MIN, INT64_MIN, INT64_MAX, INT64_MAX ), 1 );
+    BOOST_CHECK_EQUAL( CompareProducts( INT64_MIN, INT64_MAX, INT64_MAX, INT64_MIN ), 0 );
+    BOOST_CHECK_EQUAL( CompareProducts( INT64_MIN, 1, INT64_MAX, -1 ), -1 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,7 @@
 
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <wx/utils.h>
 
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <kinng.h>
@@ -34,4 +35,81 @@ BOOST_AUTO_TEST_CASE( CreateIPCResponder )
     KINNG_REQUEST_SERVER server( wxFileName::CreateTempFileName( "test-kinng" ).ToStdString() );
 }
 
+BOOST_AUTO_TEST_CASE( RequestReply )
+{
+    wxFileName socket( wxFileName::CreateTempFileName( "test-kinng" ) );
+    wxRemoveFile( socket.GetFullPath() );
+
+    std::string          url = "ipc://" + socket.GetFullPath().ToStdString();
+    KINNG_REQUEST_SERVER server( url );
+
+    server.SetCallback(
+            [&]( std::string* aRequest )
+            {
+                server.Reply( "reply to " + *aRequest );
+            } );
+
+    // The server starts listening on its own thread
+    KINNG_REQUEST_CLIENT client( url );
+    bool                 connected = false;
+
+    for( int attempt = 0; attempt < 50 && !connected; ++attempt )
+    {
+        connected = client.Connect();
+
+        if( !connected )
+            wxMilliSleep( 20 );
+    }
+
+    BOOST_REQUIRE( connected );
+
+    std::string reply;
+
+    BOOST_REQUIRE( client.Request( "first", reply, 5000 ) );
+    BOOST_CHECK_EQUAL( reply, "reply to first" );
+
+    BOOST_REQUIRE( client.Request( "second", reply, 5000 ) );
+    BOOST_CHECK_EQUAL( reply, "reply to second" );
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE( SharedMemoryReply )
+{
+    wxFileName socket( wxFileName::CreateTempFileName( "test-kinng" ) );
+    wxRemoveFile( socket.GetFullPath() );
+
+    std::string          url = "ipc://" + socket.GetFullPath().ToStdString();
+    KINNG_REQUEST_SERVER server( url );
+    const std::string    large( KINNG_REQUEST_SERVER::KINNG_SHM_THRESHOLD + 1, 'x' );
+
+    server.SetCallback(
+            [&]( std::string* aRequest )
+            {
+                server.Reply( *aRequest == "large" ? large : "small" );
+            } );
+
+    KINNG_REQUEST_CLIENT client( url );
+    bool                 connected = false;
+
+    for( int attempt = 0; attempt < 50 && !connected; ++attempt )
+    {
+        connected = client.Connect();
+
+        if( !connected )
+            wxMilliSleep( 20 );
+    }
+
+    BOOST_REQUIRE( connected );
+    BOOST_REQUIRE( client.EnableSharedMemory() );
+
+    std::string reply;
+
+    BOOST_REQUIRE( client.Request( "large", reply, 5000 ) );
+    BOOST_CHECK( reply == large );
+
+    BOOST_REQUIRE( client.Request( "small", reply, 5000 ) );
+    BOOST_CHECK_EQUAL( reply, "small" );
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -488,4 +488,41 @@ BOOST_AUTO_TEST_CASE( OverlapCases )
     }
 }
 
+
+/**
+ * Moving a footprint only translates its courtyard caches; editing the courtyard rebuilds them.
+ */
+BOOST_AUTO_TEST_CASE( CourtyardCacheLifetime )
+{
+    BOARD             board;
+    COURTYARD_TEST_FP fpDef{ "U1",
+                             { { { 0, 0 }, { 1000000, 1000000 }, 0, true } },
+                             { 0, 0 } };
+
+    std::unique_ptr<FOOTPRINT> footprint = MakeCourtyardTestFP( board, fpDef );
+
+    BOOST_CHECK( footprint->EnsureCourtyardCaches() );
+    BOOST_CHECK( !footprint->EnsureCourtyardCaches() );
+
+    BOX2I before = footprint->GetCourtyard( F_CrtYd ).BBox();
+    VECTOR2I delta( 2000000, 500000 );
+
+    footprint->Move( delta );
+
+    BOOST_CHECK( !footprint->EnsureCourtyardCaches() );
+    BOOST_CHECK_EQUAL( footprint->GetCourtyard( F_CrtYd ).BBox().GetOrigin(),
+                       before.GetOrigin() + delta );
+
+    for( BOARD_ITEM* item : footprint->GraphicalItems() )
+    {
+        if( item->GetLayer() == F_CrtYd )
+        {
+            item->Move( VECTOR2I( 0, 100000 ) );
+            break;
+        }
+    }
+
+    BOOST_CHECK( footprint->EnsureCourtyardCaches() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
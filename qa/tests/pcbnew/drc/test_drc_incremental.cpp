@@ -0,0 +1,176 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_test_provider.h>
+#include <settings/settings_manager.h>
+
+
+struct DRC_INCREMENTAL_TEST_FIXTURE
+{
+    DRC_INCREMENTAL_TEST_FIXTURE()
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( DRCIncrementalMatchesFullRun, DRC_INCREMENTAL_TEST_FIXTURE )
+{
+    std::vector<wxString> tests = { "issue1358", "issue2512", "intersectingzones" };
+
+    for( const wxString& testName : tests )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, testName, m_board );
+
+        BOARD_DESIGN_SETTINGS&                  bds = m_board->GetDesignSettings();
+        std::vector<std::shared_ptr<DRC_ITEM>>  violations;
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                     const std::function<void( PCB_MARKER* )>& aPathGenerator )
+                {
+                    violations.push_back( aItem );
+                } );
+
+        std::vector<std::shared_ptr<DRC_ITEM>> stale;
+
+        // No baseline yet
+        BOOST_CHECK( !bds.m_DRCEngine->RunIncrementalTests( EDA_UNITS::MM, {}, stale ) );
+
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+        // Touch every item of the incrementally tested violations: they must all be found again.
+        std::set<KIID> changed;
+        size_t         incrementalCount = 0;
+
+        for( const std::shared_ptr<DRC_ITEM>& violation : violations )
+        {
+            if( !violation->GetViolatingTest()
+                    || !violation->GetViolatingTest()->SupportsIncrementalTests() )
+                continue;
+
+            incrementalCount++;
+
+            for( const KIID& id : violation->GetIDs() )
+                changed.insert( id );
+        }
+
+        violations.clear();
+
+        BOOST_REQUIRE( bds.m_DRCEngine->RunIncrementalTests( EDA_UNITS::MM, changed, stale ) );
+        BOOST_CHECK_EQUAL( stale.size(), incrementalCount );
+        BOOST_CHECK_EQUAL( violations.size(), stale.size() );
+
+        // Deleting an item makes all its violations stale, whatever the test.
+        if( !m_board->Tracks().empty() )
+        {
+            PCB_TRACK* track = m_board->Tracks().front();
+            KIID       trackId = track->m_Uuid;
+
+            m_board->Remove( track );
+            delete track;
+
+            stale.clear();
+            violations.clear();
+
+            BOOST_REQUIRE( bds.m_DRCEngine->RunIncrementalTests( EDA_UNITS::MM, { trackId }, stale ) );
+
+            for( const std::shared_ptr<DRC_ITEM>& violation : violations )
+            {
+                for( const KIID& id : violation->GetIDs() )
+                    BOOST_CHECK( id != trackId );
+            }
+        }
+
+        bds.m_DRCEngine->ClearViolationHandler();
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DRCTestItemsFindsViolations, DRC_INCREMENTAL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue1358", m_board );
+
+    BOARD_DESIGN_SETTINGS&                  bds = m_board->GetDesignSettings();
+    std::vector<std::shared_ptr<DRC_ITEM>>  violations;
+
+    bds.m_DRCEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                 const std::function<void( PCB_MARKER* )>& aPathGenerator )
+            {
+                violations.push_back( aItem );
+            } );
+
+    bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+    std::vector<BOARD_ITEM*> items;
+    std::set<KIID>           ids;
+    size_t                   incrementalCount = 0;
+
+    for( const std::shared_ptr<DRC_ITEM>& violation : violations )
+    {
+        if( !violation->GetViolatingTest()
+                || !violation->GetViolatingTest()->SupportsIncrementalTests() )
+            continue;
+
+        incrementalCount++;
+
+        for( const KIID& id : violation->GetIDs() )
+        {
+            BOARD_ITEM* item = m_board->ResolveItem( id, true );
+
+            if( item && ids.insert( id ).second )
+                items.push_back( item );
+        }
+    }
+
+    violations.clear();
+
+    std::vector<std::shared_ptr<DRC_ITEM>> found;
+
+    BOOST_REQUIRE( bds.m_DRCEngine->TestItems( EDA_UNITS::MM, items, {},
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                 const std::function<void( PCB_MARKER* )>& aPathGenerator )
+            {
+                found.push_back( aItem );
+            } ) );
+
+    // The query reports to its own handler only, and leaves the full run's record alone
+    BOOST_CHECK( violations.empty() );
+    BOOST_CHECK_EQUAL( found.size(), incrementalCount );
+
+    std::vector<std::shared_ptr<DRC_ITEM>> stale;
+
+    BOOST_REQUIRE( bds.m_DRCEngine->RunIncrementalTests( EDA_UNITS::MM, ids, stale ) );
+    BOOST_CHECK_EQUAL( stale.size(), incrementalCount );
+
+    bds.m_DRCEngine->ClearViolationHandler();
+}
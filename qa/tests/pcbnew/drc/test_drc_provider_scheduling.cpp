@@ -0,0 +1,86 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <advanced_config.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_test_provider.h>
+#include <settings/settings_manager.h>
+
+
+struct DRC_PROVIDER_SCHEDULING_TEST_FIXTURE
+{
+    DRC_PROVIDER_SCHEDULING_TEST_FIXTURE()
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( DRCConcurrentProvidersMatchSerialRun, DRC_PROVIDER_SCHEDULING_TEST_FIXTURE )
+{
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    int           originalThreads = cfg.m_DRCProviderThreads;
+
+    // Restore config at end of scope to avoid polluting other tests
+    struct ScopeGuard { int& ref; int orig; ~ScopeGuard() { ref = orig; } } guard{ cfg.m_DRCProviderThreads, originalThreads };
+
+    std::vector<wxString> tests = { "issue1358", "issue2512", "intersectingzones" };
+
+    for( const wxString& testName : tests )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, testName, m_board );
+
+        BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+        std::multiset<int>     errorCodes;
+
+        bds.m_DRCEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                     const std::function<void( PCB_MARKER* )>& aPathGenerator )
+                {
+                    errorCodes.insert( aItem->GetErrorCode() );
+                } );
+
+        cfg.m_DRCProviderThreads = 1;
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+        std::multiset<int> serialCodes = errorCodes;
+
+        errorCodes.clear();
+        cfg.m_DRCProviderThreads = 0;
+        bds.m_DRCEngine->RunTests( EDA_UNITS::MM, true, false );
+
+        BOOST_CHECK_MESSAGE( errorCodes == serialCodes, testName );
+
+        // Every provider has its wall time reported
+        for( DRC_TEST_PROVIDER* provider : bds.m_DRCEngine->GetTestProviders() )
+            BOOST_CHECK( bds.m_DRCEngine->GetProviderTimes().count( provider->GetName() ) );
+
+        bds.m_DRCEngine->ClearViolationHandler();
+    }
+}
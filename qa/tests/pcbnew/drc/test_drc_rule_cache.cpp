@@ -0,0 +1,98 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <pcb_track.h>
+#include <reporter.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_rule_condition.h>
+#include <settings/settings_manager.h>
+
+
+struct DRC_RULE_CACHE_TEST_FIXTURE
+{
+    DRC_RULE_CACHE_TEST_FIXTURE()
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_AUTO_TEST_CASE( DRCRuleConditionClassOnly )
+{
+    // clang-format off
+    const std::vector<std::pair<wxString, bool>> cases =
+    {
+        { wxT( "A.NetClass == 'Power'" ),                            true  },
+        { wxT( "A.hasExactNetclass('HV') && B.NetClass != \"HV\"" ), true  },
+        { wxT( "A.hasComponentClass('Semis') || B.hasNetclass('x')" ), true },
+        { wxT( "A.NetName == '/VCC'" ),                              false },
+        { wxT( "A.insideArea('keepout')" ),                          false },
+        { wxT( "A.hasExactNetclass('HV') && A.Via_Type == 'Micro'" ), false },
+        { wxT( "AB.isCoupledDiffPair()" ),                           false },
+        { wxT( "A.Width > 0.2mm" ),                                  false },
+    };
+    // clang-format on
+
+    for( const auto& [expression, classOnly] : cases )
+    {
+        DRC_RULE_CONDITION condition( expression );
+        BOOST_CHECK_MESSAGE( condition.DependsOnlyOnClasses() == classOnly, expression );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DRCRuleCacheMatchesEvaluation, DRC_RULE_CACHE_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "multinetclasses_drc", m_board );
+
+    std::shared_ptr<DRC_ENGINE> engine = m_board->GetDesignSettings().m_DRCEngine;
+    const auto&                 tracks = m_board->Tracks();
+
+    BOOST_REQUIRE( engine );
+
+    // Passing a reporter bypasses the cache, so both must agree, including on repeated (cached)
+    // queries.
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        for( size_t ii = 0; ii < tracks.size(); ++ii )
+        {
+            for( size_t jj = ii + 1; jj < std::min( tracks.size(), ii + 16 ); ++jj )
+            {
+                PCB_LAYER_ID   layer = tracks[ii]->GetLayer();
+                DRC_CONSTRAINT cached = engine->EvalRules( CLEARANCE_CONSTRAINT, tracks[ii],
+                                                           tracks[jj], layer );
+                DRC_CONSTRAINT evaluated = engine->EvalRules( CLEARANCE_CONSTRAINT, tracks[ii],
+                                                              tracks[jj], layer,
+                                                              &NULL_REPORTER::GetInstance() );
+
+                BOOST_CHECK_EQUAL( cached.GetValue().Min(), evaluated.GetValue().Min() );
+                BOOST_CHECK( cached.GetParentRule() == evaluated.GetParentRule() );
+            }
+        }
+    }
+}
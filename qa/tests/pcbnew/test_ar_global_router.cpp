@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_shape.h>
+#include <autorouter/ar_global_router.h>
+
+
+static PAD* addPad( BOARD& aBoard, NETINFO_ITEM* aNet, const VECTOR2I& aPos, const VECTOR2I& aSize )
+{
+    FOOTPRINT* footprint = new FOOTPRINT( &aBoard );
+    PAD*       pad = new PAD( footprint );
+
+    footprint->SetPosition( aPos );
+    pad->SetAttribute( PAD_ATTRIB::SMD );
+    pad->SetLayerSet( PAD::SMDMask() );
+    pad->SetShape( PADSTACK::ALL_LAYERS, PAD_SHAPE::RECTANGLE );
+    pad->SetSize( PADSTACK::ALL_LAYERS, aSize );
+    pad->SetPosition( aPos );
+    pad->SetNet( aNet );
+    footprint->Add( pad );
+    aBoard.Add( footprint );
+
+    return pad;
+}
+
+
+BOOST_AUTO_TEST_SUITE( ArGlobalRouter )
+
+
+BOOST_AUTO_TEST_CASE( CellBitmap )
+{
+    AR_CELL_BITMAP bitmap;
+
+    bitmap.Resize( 7, 13 );
+    bitmap.Set( 0, 0 );
+    bitmap.Set( 4, 12 );
+    bitmap.Set( 6, 12 );
+
+    for( int row = 0; row < 7; row++ )
+    {
+        for( int col = 0; col < 13; col++ )
+        {
+            bool expected = ( row == 0 && col == 0 ) || ( row == 4 && col == 12 )
+                            || ( row == 6 && col == 12 );
+            BOOST_CHECK_EQUAL( bitmap.Test( row, col ), expected );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( GuideAvoidsObstacle )
+{
+    BOARD board;
+
+    PCB_SHAPE* outline = new PCB_SHAPE( &board, SHAPE_T::RECTANGLE );
+    outline->SetStart( VECTOR2I( 0, 0 ) );
+    outline->SetEnd( VECTOR2I( pcbIUScale.mmToIU( 30 ), pcbIUScale.mmToIU( 20 ) ) );
+    outline->SetLayer( Edge_Cuts );
+    board.Add( outline );
+
+    NETINFO_ITEM* net = new NETINFO_ITEM( &board, wxT( "N1" ), 1 );
+    NETINFO_ITEM* other = new NETINFO_ITEM( &board, wxT( "N2" ), 2 );
+    board.Add( net );
+    board.Add( other );
+
+    VECTOR2I padSize( pcbIUScale.mmToIU( 1 ), pcbIUScale.mmToIU( 1 ) );
+    PAD*     start = addPad( board, net, VECTOR2I( pcbIUScale.mmToIU( 5 ), pcbIUScale.mmToIU( 10 ) ),
+                             padSize );
+    PAD*     end = addPad( board, net, VECTOR2I( pcbIUScale.mmToIU( 25 ), pcbIUScale.mmToIU( 10 ) ),
+                           padSize );
+
+    // A wall between the two pads, on the top side only
+    PAD* wall = addPad( board, other, VECTOR2I( pcbIUScale.mmToIU( 15 ), pcbIUScale.mmToIU( 10 ) ),
+                        VECTOR2I( pcbIUScale.mmToIU( 1 ), pcbIUScale.mmToIU( 8 ) ) );
+
+    AR_GLOBAL_ROUTER router( &board );
+    router.SetGridSize( pcbIUScale.mmToIU( 0.5 ) );
+
+    BOOST_REQUIRE( router.BuildMatrix() );
+
+    std::vector<AR_GLOBAL_ROUTER::GUIDE> guides = router.Route( { { start, end } } );
+
+    BOOST_REQUIRE_EQUAL( guides.size(), 1 );
+    BOOST_REQUIRE( guides[0].m_found );
+    BOOST_CHECK_EQUAL( router.OverflowCount(), 0 );
+
+    const AR_GLOBAL_ROUTER::GUIDE& guide = guides[0];
+    BOX2I                          wallBox = wall->GetBoundingBox();
+
+    BOOST_CHECK( ( guide.m_points.front() - start->GetPosition() ).EuclideanNorm()
+                 <= pcbIUScale.mmToIU( 0.5 ) );
+    BOOST_CHECK( ( guide.m_points.back() - end->GetPosition() ).EuclideanNorm()
+                 <= pcbIUScale.mmToIU( 0.5 ) );
+
+    for( size_t ii = 0; ii < guide.m_points.size(); ii++ )
+    {
+        if( guide.m_sides[ii] == AR_SIDE_TOP )
+            BOOST_CHECK( !wallBox.Contains( guide.m_points[ii] ) );
+    }
+
+    // Going around the wall, or under it, needs at least one corner
+    BOOST_CHECK( !guide.Corners().empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <filesystem>
+#include <fstream>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <boost/test/unit_test.hpp>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <zone.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_sidecar.h>
+#include <settings/settings_manager.h>
+
+
+struct FILL_SIDECAR_FIXTURE
+{
+    FILL_SIDECAR_FIXTURE() :
+            m_cfg( const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() ) ),
+            m_original( m_cfg.m_BoardFillSidecar )
+    {
+        m_cfg.m_BoardFillSidecar = true;
+
+        m_path = std::filesystem::temp_directory_path() / "board_fill_sidecar.kicad_pcb";
+        m_sidecarPath = PCB_IO_KICAD_SEXPR_SIDECAR::FileNameFor( m_path.string() ).ToStdString();
+    }
+
+    ~FILL_SIDECAR_FIXTURE()
+    {
+        m_cfg.m_BoardFillSidecar = m_original;
+
+        std::filesystem::remove( m_path );
+        std::filesystem::remove( m_sidecarPath );
+    }
+
+    /// A board with a few filled zones, one of them on two layers with an island.
+    void SaveBoard()
+    {
+        BOARD board;
+
+        for( int ii = 0; ii < 3; ++ii )
+        {
+            ZONE* zone = new ZONE( &board );
+            int   x0 = ii * 20000000;
+
+            zone->SetLayerSet( ii == 0 ? LSET( { F_Cu, B_Cu } ) : LSET( { F_Cu } ) );
+
+            std::vector<VECTOR2I> outline = { VECTOR2I( x0, 0 ), VECTOR2I( x0 + 10000000, 0 ),
+                                              VECTOR2I( x0 + 10000000, 10000000 ),
+                                              VECTOR2I( x0, 10000000 ) };
+            zone->AddPolygon( outline );
+
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                SHAPE_POLY_SET fill;
+
+                fill.NewOutline();
+                fill.Append( x0 + 100000, 100000 );
+                fill.Append( x0 + 4900000, 100000 );
+                fill.Append( x0 + 4900000, 9900000 );
+                fill.Append( x0 + 100000, 9900000 );
+
+                fill.NewOutline();
+                fill.Append( x0 + 5100000, 100000 );
+                fill.Append( x0 + 9900000, 100000 );
+                fill.Append( x0 + 9900000, 9900000 + ii );
+
+                zone->SetFilledPolysList( layer, fill );
+                zone->SetIsIsland( layer, 1 );
+            }
+
+            zone->SetIsFilled( true );
+            board.Add( zone );
+        }
+
+        PCB_IO_KICAD_SEXPR io;
+        io.SaveBoard( m_path.string(), &board );
+    }
+
+    std::string ReadBoardText()
+    {
+        std::ifstream in( m_path, std::ios::binary );
+        return std::string( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+    }
+
+    std::unique_ptr<BOARD> LoadBoard()
+    {
+        PCB_IO_KICAD_SEXPR io;
+        return std::unique_ptr<BOARD>( io.LoadBoard( m_path.string(), nullptr ) );
+    }
+
+    static void CheckFills( const BOARD& aBoard )
+    {
+        BOOST_REQUIRE_EQUAL( aBoard.Zones().size(), 3 );
+
+        int ii = 0;
+
+        for( const ZONE* zone : aBoard.Zones() )
+        {
+            int x0 = ii * 20000000;
+
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                const std::shared_ptr<SHAPE_POLY_SET>& fill = zone->GetFilledPolysList( layer );
+
+                BOOST_REQUIRE_EQUAL( fill->OutlineCount(), 2 );
+                BOOST_CHECK_EQUAL( fill->COutline( 0 ).PointCount(), 4 );
+                BOOST_CHECK_EQUAL( fill->COutline( 1 ).CPoint( 2 ),
+                                   VECTOR2I( x0 + 9900000, 9900000 + ii ) );
+                BOOST_CHECK( !zone->IsIsland( layer, 0 ) );
+                BOOST_CHECK( zone->IsIsland( layer, 1 ) );
+            }
+
+            ii++;
+        }
+    }
+
+    ADVANCED_CFG&         m_cfg;
+    bool                  m_original;
+    std::filesystem::path m_path;
+    std::filesystem::path m_sidecarPath;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardFillSidecar, FILL_SIDECAR_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( MatchingSidecar )
+{
+    SaveBoard();
+
+    BOOST_REQUIRE( std::filesystem::exists( m_sidecarPath ) );
+
+    PCB_IO_KICAD_SEXPR_SIDECAR sidecar;
+
+    BOOST_CHECK( sidecar.Open( m_sidecarPath.string(), ReadBoardText() ) );
+
+    std::unique_ptr<BOARD> board = LoadBoard();
+
+    BOOST_REQUIRE( board );
+    CheckFills( *board );
+}
+
+
+BOOST_AUTO_TEST_CASE( StaleSidecarIsIgnored )
+{
+    SaveBoard();
+
+    // Any change to the board file invalidates its snapshot
+    {
+        std::ofstream out( m_path, std::ios::app );
+        out << "\n";
+    }
+
+    PCB_IO_KICAD_SEXPR_SIDECAR sidecar;
+
+    BOOST_CHECK( !sidecar.Open( m_sidecarPath.string(), ReadBoardText() ) );
+
+    std::unique_ptr<BOARD> board = LoadBoard();
+
+    BOOST_REQUIRE( board );
+    CheckFills( *board );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <connectivity/connectivity_data.h>
+#include <ratsnest/ratsnest_data.h>
+#include <settings/settings_manager.h>
+
+
+struct CONNECTIVITY_INCREMENTAL_TEST_FIXTURE
+{
+    CONNECTIVITY_INCREMENTAL_TEST_FIXTURE()
+    { }
+
+    SETTINGS_MANAGER       m_settingsManager;
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( ConnectivityApplyChangesMatchesBuild, CONNECTIVITY_INCREMENTAL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue8883", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::vector<BOARD_ITEM*>           added;
+    std::vector<BOARD_ITEM*>           modified;
+    int                                ii = 0;
+
+    // Moving tracks both splits and joins clusters
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() != PCB_TRACE_T || ( ii++ % 10 ) != 0 )
+            continue;
+
+        track->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), 0 ) );
+        modified.push_back( track );
+
+        if( added.size() < 5 )
+        {
+            PCB_TRACK* copy = static_cast<PCB_TRACK*>( track->Duplicate( false ) );
+            copy->Move( VECTOR2I( 0, pcbIUScale.mmToIU( 0.5 ) ) );
+            added.push_back( copy );
+        }
+    }
+
+    for( BOARD_ITEM* item : added )
+        m_board->Add( item, ADD_MODE::APPEND, true );
+
+    BOOST_REQUIRE( !modified.empty() );
+    BOOST_REQUIRE( connectivity->ApplyChanges( m_board.get(), added, {}, modified ) );
+
+    unsigned int              unconnected = connectivity->GetUnconnectedCount( false );
+    std::vector<unsigned int> nodeCounts;
+
+    for( int net = 1; net < connectivity->GetNetCount(); ++net )
+        nodeCounts.push_back( connectivity->GetRatsnestForNet( net )->GetNodeCount() );
+
+    BOOST_REQUIRE( m_board->BuildConnectivity() );
+    connectivity = m_board->GetConnectivity();
+
+    BOOST_CHECK_EQUAL( connectivity->GetUnconnectedCount( false ), unconnected );
+
+    for( int net = 1; net < connectivity->GetNetCount(); ++net )
+    {
+        BOOST_TEST_CONTEXT( "net " << net )
+        {
+            BOOST_REQUIRE( net - 1 < (int) nodeCounts.size() );
+            BOOST_CHECK_EQUAL( connectivity->GetRatsnestForNet( net )->GetNodeCount(),
+                               nodeCounts[net - 1] );
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+
+#include <filesystem>
+#include <fstream>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <boost/test/unit_test.hpp>
+
+#include <footprint.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <richio.h>
+
+
+// Two numbered copper pads sharing a number, an unnumbered pad, a paste-only pad and a NPTH hole
+static const char FOOTPRINT_TEXT[] =
+        "(footprint \"Test_Footprint\"\n"
+        "\t(version 20241229)\n"
+        "\t(generator \"pcbnew\")\n"
+        "\t(layer \"F.Cu\")\n"
+        "\t(descr \"A \\\"quoted\\\" description (with parentheses)\")\n"
+        "\t(tags \"test summary\")\n"
+        "\t(property \"Reference\" \"REF**\" (at 0 -2 0) (layer \"F.SilkS\")\n"
+        "\t\t(effects (font (size 1 1) (thickness 0.15)))\n"
+        "\t)\n"
+        "\t(fp_line (start -1 -1) (end 1 -1) (stroke (width 0.12) (type solid)) (layer \"F.SilkS\"))\n"
+        "\t(pad \"1\" smd roundrect (at -1 0) (size 1 1) (layers \"F.Cu\" \"F.Paste\" \"F.Mask\")"
+        " (roundrect_rratio 0.25))\n"
+        "\t(pad \"1\" thru_hole circle (at 0 0) (size 1.5 1.5) (drill 0.8) (layers \"*.Cu\" \"*.Mask\"))\n"
+        "\t(pad \"2\" smd rect (at 1 0) (size 1 1) (layers \"B.Cu\" \"B.Mask\"))\n"
+        "\t(pad \"\" smd rect (at 2 0) (size 1 1) (layers \"F.Cu\"))\n"
+        "\t(pad \"3\" smd rect (at 3 0) (size 1 1) (layers \"F.Paste\"))\n"
+        "\t(pad \"\" np_thru_hole circle (at 4 0) (size 1 1) (drill 1) (layers \"*.Cu\" \"*.Mask\"))\n"
+        "\t(embedded_fonts no)\n"
+        ")\n";
+
+
+BOOST_AUTO_TEST_SUITE( FootprintSummary )
+
+
+BOOST_AUTO_TEST_CASE( MatchesParsedFootprint )
+{
+    FOOTPRINT_SUMMARY summary;
+
+    {
+        STRING_VIEW_LINE_READER   reader( FOOTPRINT_TEXT, wxT( "summary" ) );
+        PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+        BOOST_REQUIRE( parser.ParseFootprintSummary( summary ) );
+    }
+
+    STRING_LINE_READER        reader( FOOTPRINT_TEXT, wxT( "footprint" ) );
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+    std::unique_ptr<FOOTPRINT> footprint( dynamic_cast<FOOTPRINT*>( parser.Parse() ) );
+
+    BOOST_REQUIRE( footprint );
+
+    BOOST_CHECK( summary.m_description == footprint->GetLibDescription() );
+    BOOST_CHECK( summary.m_keywords == footprint->GetKeywords() );
+    BOOST_CHECK_EQUAL( summary.m_padCount, footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ) );
+    BOOST_CHECK_EQUAL( summary.m_uniquePadCount,
+                       footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH ) );
+
+    BOOST_CHECK_EQUAL( summary.m_padCount, 5u );
+    BOOST_CHECK_EQUAL( summary.m_uniquePadCount, 2u );
+}
+
+
+BOOST_AUTO_TEST_CASE( RejectsOtherFiles )
+{
+    FOOTPRINT_SUMMARY summary;
+
+    std::string board = "(kicad_pcb (version 20241229) (generator \"pcbnew\"))";
+    std::string future = "(footprint \"F\" (version 99990101) (descr \"future\"))";
+    std::string truncated = "(footprint \"F\" (version 20241229) (pad \"1\" smd rect";
+
+    for( const std::string& text : { board, future, truncated } )
+    {
+        BOOST_TEST_CONTEXT( text )
+        {
+            STRING_VIEW_LINE_READER   reader( text, wxT( "summary" ) );
+            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+            bool ok = true;
+
+            try
+            {
+                ok = parser.ParseFootprintSummary( summary );
+            }
+            catch( const IO_ERROR& )
+            {
+                ok = false;
+            }
+
+            BOOST_CHECK( !ok );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( DeferredLibraryLoad )
+{
+    std::filesystem::path libPath = std::filesystem::temp_directory_path() / "summary_test.pretty";
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::create_directory( libPath );
+
+    {
+        std::ofstream out( libPath / "Test_Footprint.kicad_mod" );
+        out << FOOTPRINT_TEXT;
+    }
+
+    PCB_IO_KICAD_SEXPR io;
+    FOOTPRINT_SUMMARY  summary;
+    wxString           lib = libPath.string();
+
+    BOOST_REQUIRE( io.GetFootprintSummary( lib, wxT( "Test_Footprint" ), summary ) );
+    BOOST_CHECK( summary.m_keywords == wxT( "test summary" ) );
+
+    std::unique_ptr<FOOTPRINT> footprint( io.FootprintLoad( lib, wxT( "Test_Footprint" ) ) );
+
+    BOOST_REQUIRE( footprint );
+    BOOST_CHECK_EQUAL( footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ), summary.m_padCount );
+
+    std::filesystem::remove_all( libPath );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
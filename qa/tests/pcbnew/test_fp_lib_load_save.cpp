@@ -24,9 +24,13 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <boost/test/data/test_case.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 #include <board.h>
 #include <kiid.h>
 #include <footprint.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <settings/settings_manager.h>
@@ -86,4 +90,42 @@ BOOST_DATA_TEST_CASE( FpLibLoadSave, boost::unit_test::data::make( FpLibLoadSave
 
     KI_TEST::LoadAndTestFootprintFile( testCase.m_libraryPath, testCase.m_fpName, true,
                                         doFootprintTest, testCase.m_expectedFootprintVersion );
-}
\ No newline at end of file
+}
+
+/**
+ * Only the footprints saved by an older version are rewritten when upgrading a library.
+ */
+BOOST_AUTO_TEST_CASE( FpLibUpgrade )
+{
+    const std::filesystem::path libPath =
+            std::filesystem::temp_directory_path() / "fp_upgrade_tst.pretty";
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::create_directories( libPath );
+
+    auto writeFootprint =
+            [&]( const std::string& aName, int aVersion )
+            {
+                std::ofstream out( libPath / ( aName + ".kicad_mod" ) );
+                out << "(footprint \"" << aName << "\" (version " << aVersion
+                    << ") (generator \"pcbnew\") (layer \"F.Cu\"))\n";
+            };
+
+    writeFootprint( "Old", 20221018 );
+    writeFootprint( "Current", SEXPR_BOARD_FILE_VERSION );
+
+    auto upgrade =
+            [&]()
+            {
+                PCB_IO_KICAD_SEXPR io( CTL_FOR_LIBRARY );
+                FP_CACHE           fpLib( &io, wxString( libPath.string() ) );
+
+                fpLib.Load( true );
+                return fpLib.Upgrade( false );
+            };
+
+    BOOST_CHECK_EQUAL( upgrade(), 1 );
+    BOOST_CHECK_EQUAL( upgrade(), 0 );
+
+    std::filesystem::remove_all( libPath );
+}
@@ -91,7 +91,10 @@ const static std::vector<EXPR_TO_TEST> introspectionExpressions = {
     { "A.hasNetclass('HV_*')", false, VAL( 1.0 ) },
     { "A.type == 'Track' && B.type == 'Track' && A.layer == 'F.Cu'", false, VAL( 1.0 ) },
     { "(A.type == 'Track') && (B.type == 'Track') && (A.layer == 'F.Cu')", false, VAL( 1.0 ) },
-    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) }
+    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) },
+    { "A.layer == 'F.Cu' && !(B.layer != 'F.Cu')", false, VAL( 1.0 ) },
+    { "A.layer == '*.Cu' && A.Width == 10mil && B.Width >= 10mil + 10mil", false, VAL( 1.0 ) },
+    { "A.Netclass != 'HV_*' || A.Width < 1mm * 2", false, VAL( 1.0 ) }
 };
 
 
@@ -142,6 +145,10 @@ static bool testEvalExpr( const wxString& expr, const LIBEVAL::VALUE& expectedRe
         BOOST_CHECK_EQUAL( result->AsString(), expectedResult.AsString() );
     }
 
+    // Lowered expressions must give the same result as the interpreter
+    if( ucode.Optimize() )
+        BOOST_CHECK_EQUAL( ucode.RunAsDouble( &context ), result->AsDouble() );
+
     return ok;
 }
 
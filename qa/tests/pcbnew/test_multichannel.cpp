@@ -200,6 +200,18 @@ BOOST_FIXTURE_TEST_CASE( MultichannelToolRegressions, MULTICHANNEL_TEST_FIXTURE
 
         BOOST_ASSERT( refArea );
 
+        // The channels are matched against the reference in parallel, with the same outcome
+        // as the pairwise matches above
+        BOOST_CHECK_EQUAL( mtTool->CheckRACompatibility( refArea->m_zone ), 0 );
+
+        for( const auto& [targetArea, compatData] : ruleData->m_compatMap )
+        {
+            if( targetArea->m_ruleName.Contains( wxT( "io_drivers_fp" ) ) )
+                BOOST_CHECK_MESSAGE( compatData.m_isOk, targetArea->m_ruleName );
+            else
+                BOOST_CHECK( !compatData.m_isOk );
+        }
+
         const std::vector<wxString> targetAreaNames( { wxT( "io_drivers_fp/bank2/io78/" ),
                                                        wxT( "io_drivers_fp/bank1/io78/" ),
                                                        wxT( "io_drivers_fp/bank0/io01/" ) } );
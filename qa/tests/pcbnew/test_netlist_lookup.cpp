@@ -0,0 +1,82 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <netlist_reader/pcb_netlist.h>
+#include <lib_id.h>
+
+
+BOOST_AUTO_TEST_SUITE( NetlistLookup )
+
+
+static COMPONENT* addComponent( NETLIST& aNetlist, const wxString& aReference,
+                                const KIID_PATH& aSheetPath, const std::vector<KIID>& aUuids )
+{
+    COMPONENT* component = new COMPONENT( LIB_ID( wxT( "Lib" ), wxT( "Footprint" ) ), aReference,
+                                          wxT( "Value" ), aSheetPath, aUuids );
+    aNetlist.AddComponent( component );
+    return component;
+}
+
+
+BOOST_AUTO_TEST_CASE( Lookups )
+{
+    NETLIST   netlist;
+    KIID_PATH sheet;
+    KIID      unitA, unitB, other;
+
+    sheet.push_back( KIID() );
+
+    COMPONENT* u1 = addComponent( netlist, wxT( "U1" ), sheet, { unitA, unitB } );
+    COMPONENT* r1 = addComponent( netlist, wxT( "R1" ), sheet, { other } );
+
+    KIID_PATH pathB = sheet;
+    pathB.push_back( unitB );
+
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "U1" ) ) == u1 );
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "u1" ) ) == nullptr );
+    BOOST_CHECK( netlist.GetComponentByPath( pathB ) == u1 );
+    BOOST_CHECK( netlist.GetComponentByPath( KIID_PATH() ) == nullptr );
+    BOOST_CHECK( netlist.GetComponentByUuid( other ) == r1 );
+
+    // Components added after a lookup are found too, and the first one wins on duplicates
+    COMPONENT* r2 = addComponent( netlist, wxT( "R2" ), sheet, { KIID() } );
+    addComponent( netlist, wxT( "R1" ), sheet, { KIID() } );
+
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "R2" ) ) == r2 );
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "R1" ) ) == r1 );
+
+    // Sorting keeps the components, so they are still found
+    netlist.SortByReference();
+
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "U1" ) ) == u1 );
+    BOOST_CHECK( netlist.GetComponentByUuid( unitA ) == u1 );
+
+    netlist.Clear();
+
+    BOOST_CHECK( netlist.GetComponentByReference( wxT( "U1" ) ) == nullptr );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
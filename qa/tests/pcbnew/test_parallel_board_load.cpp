@@ -0,0 +1,107 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <filesystem>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <boost/test/unit_test.hpp>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <netinfo.h>
+#include <pcb_track.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <settings/settings_manager.h>
+
+
+static std::unique_ptr<BOARD> loadBoard( const std::filesystem::path& aPath, bool aParallel )
+{
+    ADVANCED_CFG& cfg = const_cast<ADVANCED_CFG&>( ADVANCED_CFG::GetCfg() );
+    bool          original = cfg.m_ParallelBoardLoad;
+
+    cfg.m_ParallelBoardLoad = aParallel;
+
+    PCB_IO_KICAD_SEXPR     io;
+    std::unique_ptr<BOARD> board( io.LoadBoard( aPath.string(), nullptr ) );
+
+    cfg.m_ParallelBoardLoad = original;
+    return board;
+}
+
+
+BOOST_AUTO_TEST_CASE( ParallelBoardLoadMatchesSequential )
+{
+    SETTINGS_MANAGER settingsManager;
+    BOARD            board;
+
+    std::vector<NETINFO_ITEM*> nets;
+
+    for( int ii = 0; ii < 50; ++ii )
+    {
+        nets.push_back( new NETINFO_ITEM( &board, wxString::Format( wxT( "NET%d" ), ii ) ) );
+        board.Add( nets.back(), ADD_MODE::APPEND, true );
+    }
+
+    // Enough tracks for the loader to split them between several parsers
+    for( int ii = 0; ii < 3000; ++ii )
+    {
+        PCB_TRACK* track = new PCB_TRACK( &board );
+
+        track->SetStart( VECTOR2I( ii * 100000, 0 ) );
+        track->SetEnd( VECTOR2I( ii * 100000, 5000000 ) );
+        track->SetWidth( 200000 );
+        track->SetLayer( ii % 2 ? B_Cu : F_Cu );
+        track->SetNet( nets[( ii * 7 ) % nets.size()] );
+        board.Add( track, ADD_MODE::APPEND, true );
+    }
+
+    const std::filesystem::path savePath = std::filesystem::temp_directory_path()
+                                           / "parallel_board_load.kicad_pcb";
+
+    std::filesystem::remove( savePath );
+    KI_TEST::DumpBoardToFile( board, savePath.string() );
+
+    std::unique_ptr<BOARD> sequential = loadBoard( savePath, false );
+    std::unique_ptr<BOARD> parallel = loadBoard( savePath, true );
+
+    std::filesystem::remove( savePath );
+
+    BOOST_REQUIRE( sequential );
+    BOOST_REQUIRE( parallel );
+    BOOST_CHECK_EQUAL( parallel->GetNetCount(), sequential->GetNetCount() );
+    BOOST_REQUIRE_EQUAL( parallel->Tracks().size(), sequential->Tracks().size() );
+
+    auto seqIt = sequential->Tracks().begin();
+
+    for( PCB_TRACK* track : parallel->Tracks() )
+    {
+        const PCB_TRACK* expected = *seqIt++;
+
+        BOOST_CHECK( track->m_Uuid == expected->m_Uuid );
+        BOOST_CHECK_EQUAL( track->GetStart(), expected->GetStart() );
+        BOOST_CHECK_EQUAL( track->GetEnd(), expected->GetEnd() );
+        BOOST_CHECK_EQUAL( track->GetLayer(), expected->GetLayer() );
+        BOOST_CHECK_EQUAL( track->GetNetCode(), expected->GetNetCode() );
+        BOOST_CHECK( track->GetNetname() == expected->GetNetname() );
+    }
+}
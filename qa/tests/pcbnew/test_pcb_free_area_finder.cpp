@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+
+// Code under test
+#include <pcb_free_area_finder.h>
+
+
+static FOOTPRINT* addFootprint( BOARD& aBoard, const VECTOR2I& aPos, int aSize )
+{
+    FOOTPRINT* footprint = new FOOTPRINT( &aBoard );
+    PAD*       pad = new PAD( footprint );
+
+    footprint->SetPosition( aPos );
+    pad->SetAttribute( PAD_ATTRIB::SMD );
+    pad->SetLayerSet( PAD::SMDMask() );
+    pad->SetShape( PADSTACK::ALL_LAYERS, PAD_SHAPE::RECTANGLE );
+    pad->SetSize( PADSTACK::ALL_LAYERS, VECTOR2I( aSize, aSize ) );
+    pad->SetPosition( aPos );
+    footprint->Add( pad );
+    aBoard.Add( footprint );
+
+    return footprint;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PcbFreeAreaFinder )
+
+
+BOOST_AUTO_TEST_CASE( EmptyBoard )
+{
+    BOARD                board;
+    PCB_FREE_AREA_FINDER finder( &board, 0 );
+    BOX2I                box( VECTOR2I( 0, 0 ), VECTOR2I( 100, 100 ) );
+
+    BOOST_CHECK( finder.IsFree( box, F_Cu ) );
+    BOOST_CHECK( finder.FindNearest( box, F_Cu, 1000, 5 ) == VECTOR2I( 0, 0 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( FirstRing )
+{
+    BOARD board;
+    int   size = pcbIUScale.mmToIU( 2 );
+    int   step = pcbIUScale.mmToIU( 5 );
+
+    addFootprint( board, VECTOR2I( 0, 0 ), size );
+
+    PCB_FREE_AREA_FINDER finder( &board, 0 );
+    BOX2I                box( VECTOR2I( -size / 2, -size / 2 ), VECTOR2I( size, size ) );
+
+    BOOST_CHECK( !finder.IsFree( box, F_Cu ) );
+
+    std::optional<VECTOR2I> offset = finder.FindNearest( box, F_Cu, step, 5 );
+
+    BOOST_REQUIRE( offset.has_value() );
+    BOOST_CHECK_EQUAL( *offset, VECTOR2I( -step, -step ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( SidesAndIgnored )
+{
+    BOARD      board;
+    int        size = pcbIUScale.mmToIU( 2 );
+    FOOTPRINT* front = addFootprint( board, VECTOR2I( 0, 0 ), size );
+    BOX2I      box( VECTOR2I( -size / 2, -size / 2 ), VECTOR2I( size, size ) );
+
+    PCB_FREE_AREA_FINDER finder( &board, 0 );
+
+    BOOST_CHECK( finder.IsFree( box, B_Cu ) );
+    BOOST_CHECK( !finder.IsFree( box, F_Cu ) );
+
+    finder.IgnoreFootprint( front );
+    BOOST_CHECK( finder.IsFree( box, F_Cu ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( MarginAndAddedObstacle )
+{
+    BOARD board;
+    int   size = pcbIUScale.mmToIU( 2 );
+    int   margin = pcbIUScale.mmToIU( 1 );
+
+    addFootprint( board, VECTOR2I( 0, 0 ), size );
+
+    PCB_FREE_AREA_FINDER finder( &board, margin );
+
+    // Half a margin away from the footprint
+    BOX2I near( VECTOR2I( size / 2 + margin / 2, -size / 2 ), VECTOR2I( size, size ) );
+    BOOST_CHECK( !finder.IsFree( near, F_Cu ) );
+
+    // Just over one margin away
+    BOX2I beside( VECTOR2I( size / 2 + margin + 100, -size / 2 ), VECTOR2I( size, size ) );
+    BOOST_CHECK( finder.IsFree( beside, F_Cu ) );
+
+    FOOTPRINT* placed = addFootprint( board, beside.Centre(), size );
+    finder.AddObstacle( placed );
+    BOOST_CHECK( !finder.IsFree( beside, F_Cu ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -29,8 +29,11 @@
 #include <pcbnew/pcb_track.h>
 #include <pcbnew/board.h>
 
+#include <router/pns_diff_pair.h>
+#include <router/pns_index.h>
 #include <router/pns_node.h>
 #include <router/pns_router.h>
+#include <router/pns_segment.h>
 #include <router/pns_item.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
@@ -505,3 +508,184 @@ BOOST_AUTO_TEST_CASE( PCBViaBackdrillCloneRetainsData )
     checkVia( *viaClone );
 }
 
+
+
+BOOST_FIXTURE_TEST_CASE( PNSQueryJoints, PNS_TEST_FIXTURE )
+{
+    std::unique_ptr<PNS::NODE> world( new PNS::NODE );
+    std::vector<VECTOR2I>      positions;
+
+    world->SetMaxClearance( 10000000 );
+    world->SetRuleResolver( &m_ruleResolver );
+
+    auto addVia =
+            [&]( const VECTOR2I& aPos, int aNet )
+            {
+                PNS::VIA* via = new PNS::VIA( aPos, PNS_LAYER_RANGE( F_Cu, B_Cu ), 50000, 10000 );
+                via->SetNet( (PNS::NET_HANDLE) (intptr_t) aNet );
+                world->AddRaw( via );
+                positions.push_back( aPos );
+            };
+
+    for( int ii = 0; ii < 20; ++ii )
+    {
+        for( int jj = 0; jj < 10; ++jj )
+            addVia( VECTOR2I( ii * 1270000 - 5000000, jj * 2540000 + ( ii % 3 ) * 100000 ), ii + 1 );
+    }
+
+    auto checkBox =
+            [&]( const BOX2I& aBox )
+            {
+                std::vector<PNS::JOINT*> joints;
+                int                      count = world->QueryJoints( aBox, joints );
+                size_t                   expected = 0;
+
+                for( const VECTOR2I& pos : positions )
+                {
+                    if( aBox.Contains( pos ) )
+                        expected++;
+                }
+
+                BOOST_CHECK_EQUAL( count, (int) expected );
+                BOOST_CHECK_EQUAL( joints.size(), expected );
+
+                for( PNS::JOINT* joint : joints )
+                    BOOST_CHECK( aBox.Contains( joint->Pos() ) );
+            };
+
+    checkBox( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 5000000, 5000000 ) ) );
+    checkBox( BOX2I( VECTOR2I( -5000000, 0 ), VECTOR2I( 0, 0 ) ) );
+    checkBox( BOX2I( VECTOR2I( -100000000, -100000000 ), VECTOR2I( 200000000, 200000000 ) ) );
+    checkBox( BOX2I( VECTOR2I( 90000000, 90000000 ), VECTOR2I( 1000, 1000 ) ) );
+
+    // Adding items must invalidate the index
+    addVia( VECTOR2I( 1000, 1000 ), 100 );
+    checkBox( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 5000000, 5000000 ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( PNSIndexQueryNet )
+{
+    PNS::INDEX                                 index;
+    std::vector<std::unique_ptr<PNS::SEGMENT>> segments;
+
+    for( int ii = 0; ii < 60; ++ii )
+    {
+        VECTOR2I start( ( ii % 10 ) * 1000000, ( ii / 10 ) * 1000000 );
+        auto     seg = std::make_unique<PNS::SEGMENT>( SEG( start, start + VECTOR2I( 500000, 0 ) ),
+                                                       (PNS::NET_HANDLE) (intptr_t) ( ii % 3 + 1 ) );
+
+        seg->SetWidth( 100000 );
+        seg->SetLayers( PNS_LAYER_RANGE( ii % 2 ? B_Cu : F_Cu ) );
+        index.Add( seg.get() );
+        segments.push_back( std::move( seg ) );
+    }
+
+    auto checkQuery =
+            [&]( PNS::NET_HANDLE aNet, const BOX2I& aArea, const PNS_LAYER_RANGE& aLayers )
+            {
+                std::set<PNS::ITEM*> found;
+                auto                 visitor = [&]( PNS::ITEM* aItem ) -> bool
+                                               {
+                                                   found.insert( aItem );
+                                                   return true;
+                                               };
+
+                int    count = index.QueryNet( aNet, aArea, aLayers, visitor );
+                size_t expected = 0;
+
+                for( const std::unique_ptr<PNS::SEGMENT>& seg : segments )
+                {
+                    if( !index.Contains( seg.get() ) || seg->Net() != aNet
+                            || !seg->Layers().Overlaps( aLayers )
+                            || !seg->Shape( -1 )->BBox().Intersects( aArea ) )
+                    {
+                        continue;
+                    }
+
+                    expected++;
+                    BOOST_CHECK( found.count( seg.get() ) );
+                }
+
+                BOOST_CHECK_EQUAL( count, (int) expected );
+                BOOST_CHECK_EQUAL( found.size(), expected );
+            };
+
+    BOX2I area( VECTOR2I( 0, 0 ), VECTOR2I( 3000000, 3000000 ) );
+
+    checkQuery( (PNS::NET_HANDLE) 1, area, PNS_LAYER_RANGE( F_Cu ) );
+    checkQuery( (PNS::NET_HANDLE) 2, area, PNS_LAYER_RANGE( F_Cu, B_Cu ) );
+    checkQuery( (PNS::NET_HANDLE) 3, BOX2I( VECTOR2I( -1000, -1000 ), VECTOR2I( 1, 1 ) ),
+                PNS_LAYER_RANGE( F_Cu ) );
+    checkQuery( (PNS::NET_HANDLE) 4, area, PNS_LAYER_RANGE( F_Cu, B_Cu ) );
+
+    // Removal swaps the last item of the net in place; the buckets must stay consistent
+    for( size_t ii = 0; ii < segments.size(); ii += 4 )
+        index.Remove( segments[ii].get() );
+
+    checkQuery( (PNS::NET_HANDLE) 1, area, PNS_LAYER_RANGE( F_Cu, B_Cu ) );
+    checkQuery( (PNS::NET_HANDLE) 2, area, PNS_LAYER_RANGE( B_Cu ) );
+
+    BOOST_CHECK_EQUAL( index.GetItemsForNet( (PNS::NET_HANDLE) 1 )->size(), 15 );
+}
+
+
+BOOST_AUTO_TEST_CASE( PNSFitGatewaysMatchesExhaustiveSearch )
+{
+    const int gap = 350000;
+
+    PNS::DP_GATEWAYS entries( gap );
+    entries.BuildGeneric( VECTOR2I( 0, 0 ), VECTOR2I( 0, gap ), true );
+
+    for( const VECTOR2I& cursor : { VECTOR2I( 5000000, 0 ), VECTOR2I( 3000000, 4000000 ),
+                                    VECTOR2I( -2000000, 7000000 ), VECTOR2I( 100000, -6000000 ) } )
+    {
+        PNS::DP_GATEWAYS targets( gap );
+        targets.SetFitVias( true, 600000, gap );
+        targets.BuildForCursor( cursor );
+
+        for( bool prefDiagonal : { false, true } )
+        {
+            // The search FitGateways() replaces: keep the last pair of the best score that builds
+            SHAPE_LINE_CHAIN expectedP, expectedN;
+            int              bestScore = -1000;
+            bool             expectedFound = false;
+
+            for( const PNS::DP_GATEWAY& g_entry : entries.CGateways() )
+            {
+                for( const PNS::DP_GATEWAY& g_target : targets.CGateways() )
+                {
+                    for( bool preferred : { false, true } )
+                    {
+                        int score = ( preferred ? 0 : -3 ) + g_entry.Priority() + g_target.Priority();
+
+                        if( score < bestScore )
+                            continue;
+
+                        PNS::DIFF_PAIR l( gap );
+
+                        if( l.BuildInitial( g_entry, g_target,
+                                            preferred ? prefDiagonal : !prefDiagonal ) )
+                        {
+                            expectedP = l.CP();
+                            expectedN = l.CN();
+                            bestScore = score;
+                            expectedFound = true;
+                        }
+                    }
+                }
+            }
+
+            PNS::DIFF_PAIR dp;
+            bool           found = entries.FitGateways( entries, targets, prefDiagonal, dp );
+
+            BOOST_REQUIRE_EQUAL( found, expectedFound );
+
+            if( found )
+            {
+                BOOST_CHECK( dp.CP().CPoints() == expectedP.CPoints() );
+                BOOST_CHECK( dp.CN().CPoints() == expectedN.CPoints() );
+            }
+        }
+    }
+}
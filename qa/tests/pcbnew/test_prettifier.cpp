@@ -139,3 +139,74 @@ BOOST_FIXTURE_TEST_CASE( BoardAndFootprintPrettifier, PRETTIFIER_TEST_FIXTURE )
 
     std::filesystem::remove_all( tempLibPath );
 }
+
+
+BOOST_AUTO_TEST_CASE( PrettifyInParts )
+{
+    std::string inPath = fmt::format( "{}prettifier/group_and_image.kicad_pcb",
+                                      KI_TEST::GetPcbnewTestDataDir() );
+
+    std::ifstream inFp;
+    inFp.open( inPath );
+    BOOST_REQUIRE( inFp.is_open() );
+
+    std::stringstream inBuf;
+    inBuf << inFp.rdbuf();
+    std::string inData = inBuf.str();
+
+    // The starts of the lists inside the outer list
+    std::vector<size_t> itemStarts;
+    int                 depth = 0;
+    bool                inQuote = false;
+
+    for( size_t ii = 0; ii < inData.size(); ++ii )
+    {
+        if( inData[ii] == '\\' )
+            ++ii;
+        else if( inData[ii] == '"' )
+            inQuote = !inQuote;
+        else if( !inQuote && inData[ii] == '(' && depth++ == 1 )
+            itemStarts.push_back( ii );
+        else if( !inQuote && inData[ii] == ')' )
+            depth--;
+    }
+
+    BOOST_REQUIRE_GE( itemStarts.size(), 3u );
+
+    for( KICAD_FORMAT::FORMAT_MODE mode : { KICAD_FORMAT::FORMAT_MODE::NORMAL,
+                                            KICAD_FORMAT::FORMAT_MODE::COMPACT_TEXT_PROPERTIES } )
+    {
+        std::string whole = inData;
+        KICAD_FORMAT::Prettify( whole, mode );
+
+        for( size_t partCount : { size_t( 2 ), size_t( 3 ), itemStarts.size() } )
+        {
+            BOOST_TEST_CONTEXT( partCount << " parts" )
+            {
+                std::string joined;
+                size_t      begin = 0;
+
+                for( size_t ii = 0; ii < partCount; ++ii )
+                {
+                    size_t end = ii + 1 < partCount
+                                        ? itemStarts[itemStarts.size() * ( ii + 1 ) / partCount]
+                                        : inData.size();
+
+                    KICAD_FORMAT::PRETTIFY_PART part = KICAD_FORMAT::PRETTIFY_PART::ITEMS;
+
+                    if( ii == 0 )
+                        part = KICAD_FORMAT::PRETTIFY_PART::BEGIN;
+                    else if( ii + 1 == partCount )
+                        part = KICAD_FORMAT::PRETTIFY_PART::END;
+
+                    std::string text = inData.substr( begin, end - begin );
+                    KICAD_FORMAT::PrettifyPart( text, part, mode );
+                    joined += text;
+                    begin = end;
+                }
+
+                BOOST_CHECK( joined == whole );
+            }
+        }
+    }
+}
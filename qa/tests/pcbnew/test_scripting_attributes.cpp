@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <python/scripting/pcbnew_scripting_helpers.h>
+
+
+BOOST_AUTO_TEST_SUITE( ScriptingAttributes )
+
+
+BOOST_AUTO_TEST_CASE( Tracks )
+{
+    BOARD board;
+
+    PCB_TRACK* track = new PCB_TRACK( &board );
+    track->SetStart( VECTOR2I( 100, 200 ) );
+    track->SetEnd( VECTOR2I( 300, 400 ) );
+    track->SetWidth( 250 );
+    track->SetLayer( B_Cu );
+    board.Add( track );
+
+    PCB_VIA* via = new PCB_VIA( &board );
+    via->SetPosition( VECTOR2I( 500, 600 ) );
+    via->SetLayerPair( F_Cu, B_Cu );
+    via->SetWidth( F_Cu, 800 );
+    via->SetDrill( 400 );
+    board.Add( via );
+
+    std::vector<int> attrs = GetTrackAttributes( &board );
+
+    BOOST_REQUIRE_EQUAL( attrs.size(), 2 * TRACK_ATTR_COUNT );
+
+    const int* row = attrs.data();
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_TYPE], PCB_TRACE_T );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_START_X], 100 );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_END_Y], 400 );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_WIDTH], 250 );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_LAYER], B_Cu );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_DRILL], 0 );
+
+    row += TRACK_ATTR_COUNT;
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_TYPE], PCB_VIA_T );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_END_X], 500 );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_WIDTH], 800 );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_LAYER], F_Cu );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_END_LAYER], B_Cu );
+    BOOST_CHECK_EQUAL( row[TRACK_ATTR_DRILL], 400 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Pads )
+{
+    BOARD      board;
+    FOOTPRINT* fp = new FOOTPRINT( &board );
+    PAD*       pad = new PAD( fp );
+
+    pad->SetSize( PADSTACK::ALL_LAYERS, VECTOR2I( 1000, 2000 ) );
+    pad->SetPosition( VECTOR2I( 10, 20 ) );
+    pad->SetOrientation( ANGLE_90 );
+    fp->Add( pad );
+    board.Add( fp );
+
+    std::vector<int> attrs = GetPadAttributes( &board );
+
+    BOOST_REQUIRE_EQUAL( attrs.size(), PAD_ATTR_COUNT );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_X], 10 );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_Y], 20 );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_SIZE_X], 1000 );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_SIZE_Y], 2000 );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_ORIENTATION], 900 );
+    BOOST_CHECK_EQUAL( attrs[PAD_ATTR_LAYER], F_Cu );
+
+    BOOST_CHECK( GetPadAttributes( nullptr ).empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
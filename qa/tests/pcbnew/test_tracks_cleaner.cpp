@@ -232,3 +232,40 @@ BOOST_DATA_TEST_CASE_F( TRACK_CLEANER_TEST_FIXTURE, TrackCleanerRegressionTests,
         BOOST_ERROR( wxString::Format( "Track cleaner regression: %s, failed", relPath ) );
     }
 }
+
+
+/*
+ * A filter restricts every pass to the accepted items: rejecting all items finds nothing, and
+ * accepting them all finds the same items as no filter.
+ */
+BOOST_FIXTURE_TEST_CASE( TrackCleanerFilteredSubset, TRACK_CLEANER_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "issue8883", m_board );
+    KI_TEST::FillZones( m_board.get() );
+    m_board->GetConnectivity()->RecalculateRatsnest();
+    m_board->UpdateRatsnestExclusions();
+
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    BOARD_COMMIT                                 commit( dummyTool );
+    TRACKS_CLEANER                               cleaner( m_board.get(), commit );
+    std::vector< std::shared_ptr<CLEANUP_ITEM> > unfilteredItems;
+    std::vector< std::shared_ptr<CLEANUP_ITEM> > rejectAllItems;
+    std::vector< std::shared_ptr<CLEANUP_ITEM> > acceptAllItems;
+
+    cleaner.CleanupBoard( true, &unfilteredItems, true, true, true, true, false, true );
+
+    cleaner.SetFilter( []( BOARD_CONNECTED_ITEM* aItem ) { return true; } );
+    cleaner.CleanupBoard( true, &rejectAllItems, true, true, true, true, false, true );
+
+    cleaner.SetFilter( []( BOARD_CONNECTED_ITEM* aItem ) { return false; } );
+    cleaner.CleanupBoard( true, &acceptAllItems, true, true, true, true, false, true );
+
+    BOOST_CHECK_EQUAL( unfilteredItems.size(), 81 );
+    BOOST_CHECK_EQUAL( rejectAllItems.size(), 0 );
+    BOOST_CHECK_EQUAL( acceptAllItems.size(), unfilteredItems.size() );
+}
@@ -80,4 +80,44 @@ BOOST_AUTO_TEST_CASE( RescuedLayers )
     BOOST_TEST( zone.IsOnCopperLayer() == false );
 }
 
+/**
+ * Undo images share the fills of their zone until either of them changes its fill.
+ */
+BOOST_AUTO_TEST_CASE( UndoImageSharesFills )
+{
+    ZONE zone( &m_board );
+
+    zone.SetLayer( F_Cu );
+
+    SHAPE_POLY_SET fill;
+    fill.NewOutline();
+    fill.Append( 0, 0 );
+    fill.Append( 1000, 0 );
+    fill.Append( 1000, 1000 );
+    fill.Append( 0, 1000 );
+    zone.SetFilledPolysList( F_Cu, fill );
+
+    std::unique_ptr<ZONE> image( zone.CloneSharingFills() );
+    SHAPE_POLY_SET*       zoneFill = zone.GetFill( F_Cu );
+
+    BOOST_CHECK( image->GetFill( F_Cu ) == zoneFill );
+
+    // Undo swaps the fills by pointer
+    zone.SwapItemData( image.get() );
+    BOOST_CHECK( image->GetFill( F_Cu ) == zoneFill );
+    zone.SwapItemData( image.get() );
+    BOOST_CHECK( zone.GetFill( F_Cu ) == zoneFill );
+
+    // Moving the image must not move the zone fill
+    image->Move( VECTOR2I( 5000, 0 ) );
+
+    BOOST_CHECK( image->GetFill( F_Cu ) != zoneFill );
+    BOOST_CHECK_EQUAL( zone.GetFill( F_Cu )->BBox().GetX(), 0 );
+    BOOST_CHECK_EQUAL( image->GetFill( F_Cu )->BBox().GetX(), 5000 );
+
+    // Nor unfilling the zone clear the image
+    zone.UnFill();
+    BOOST_CHECK_EQUAL( image->GetFill( F_Cu )->OutlineCount(), 1 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,10 @@
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_fill_cache.h>
+#include <zone_filler.h>
+#include <board_commit.h>
+#include <tool/tool_manager.h>
 #include <drc/drc_item.h>
 #include <settings/settings_manager.h>
 #include <geometry/shape_poly_set.h>
@@ -590,3 +594,154 @@ BOOST_FIXTURE_TEST_CASE( RegressionViaZoneNetShort, ZONE_FILL_TEST_FIXTURE )
                                            "is not fixed.",
                                            viasShortingZones ) );
 }
+
+
+BOOST_FIXTURE_TEST_CASE( ZoneFillCacheKeys, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+    KI_TEST::FillZones( m_board.get() );
+
+    std::vector<ZONE*> zones( m_board->Zones().begin(), m_board->Zones().end() );
+
+    auto keys = ZONE_FILL_CACHE::ComputeKeys( m_board.get(), zones );
+
+    BOOST_REQUIRE( !keys.empty() );
+    BOOST_CHECK( keys == ZONE_FILL_CACHE::ComputeKeys( m_board.get(), zones ) );
+
+    // Fills survive a round trip through the cache file
+    ZONE_FILL_CACHE cache;
+
+    for( const auto& [zoneLayer, key] : keys )
+        cache.Store( key, *zoneLayer.first->GetFilledPolysList( zoneLayer.second ) );
+
+    wxString path = wxFileName::CreateTempFileName( wxT( "zone_fill_cache" ) );
+    BOOST_REQUIRE( cache.Save( path ) );
+
+    ZONE_FILL_CACHE loaded;
+    BOOST_REQUIRE( loaded.Load( path ) );
+    wxRemoveFile( path );
+
+    for( const auto& [zoneLayer, key] : keys )
+    {
+        const SHAPE_POLY_SET* fill = loaded.Find( key );
+
+        BOOST_REQUIRE( fill );
+        BOOST_CHECK_EQUAL( fill->Area(),
+                           zoneLayer.first->GetFilledPolysList( zoneLayer.second )->Area() );
+    }
+
+    // Moving copper under a zone invalidates its fill
+    PCB_TRACK* track = m_board->Tracks().front();
+    track->Move( VECTOR2I( delta, delta ) );
+
+    auto movedKeys = ZONE_FILL_CACHE::ComputeKeys( m_board.get(), zones );
+    bool changed = false;
+
+    for( const auto& [zoneLayer, key] : keys )
+    {
+        if( zoneLayer.first->GetLayerSet().Contains( track->GetLayer() )
+                && zoneLayer.first->GetBoundingBox().Intersects( track->GetBoundingBox() ) )
+        {
+            changed |= movedKeys[zoneLayer] != key;
+        }
+    }
+
+    BOOST_CHECK( changed );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( PartialFillReconnectingEdit, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    // A zone away from the rest of the board, cut in two by a track of another net.  Only
+    // the left half is connected, by a short track of the zone net.
+    VECTOR2I origin( pcbIUScale.mmToIU( 500 ), pcbIUScale.mmToIU( 500 ) );
+
+    auto at =
+            [&]( double aX, double aY )
+            {
+                return origin + VECTOR2I( pcbIUScale.mmToIU( aX ), pcbIUScale.mmToIU( aY ) );
+            };
+
+    NETINFO_ITEM* gnd = new NETINFO_ITEM( m_board.get(), wxT( "PARTIAL_FILL_GND" ) );
+    NETINFO_ITEM* other = new NETINFO_ITEM( m_board.get(), wxT( "PARTIAL_FILL_WALL" ) );
+    m_board->Add( gnd );
+    m_board->Add( other );
+
+    ZONE* zone = new ZONE( m_board.get() );
+    zone->SetLayer( F_Cu );
+    zone->SetNet( gnd );
+    zone->AppendCorner( at( 0, 0 ), -1 );
+    zone->AppendCorner( at( 20, 0 ), -1 );
+    zone->AppendCorner( at( 20, 10 ), -1 );
+    zone->AppendCorner( at( 0, 10 ), -1 );
+    m_board->Add( zone );
+
+    PCB_TRACK* anchor = new PCB_TRACK( m_board.get() );
+    anchor->SetLayer( F_Cu );
+    anchor->SetNet( gnd );
+    anchor->SetWidth( pcbIUScale.mmToIU( 0.5 ) );
+    anchor->SetStart( at( 3, 5 ) );
+    anchor->SetEnd( at( 5, 5 ) );
+    m_board->Add( anchor );
+
+    PCB_TRACK* wall = new PCB_TRACK( m_board.get() );
+    wall->SetLayer( F_Cu );
+    wall->SetNet( other );
+    wall->SetWidth( pcbIUScale.mmToIU( 0.5 ) );
+    wall->SetEnd( at( 10, 11 ) );
+    m_board->Add( wall );
+
+    auto fill =
+            [&]( const std::vector<BOX2I>& aDirtyRegions )
+            {
+                m_board->BuildConnectivity();
+
+                TOOL_MANAGER toolMgr;
+                toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+                KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+                toolMgr.RegisterTool( dummyTool );
+
+                BOARD_COMMIT       commit( dummyTool );
+                ZONE_FILLER        filler( m_board.get(), &commit );
+                std::vector<ZONE*> toFill = { zone };
+
+                if( !aDirtyRegions.empty() )
+                    filler.SetDirtyRegions( zone, aDirtyRegions );
+
+                if( filler.Fill( toFill, false, nullptr ) )
+                {
+                    commit.Push( _( "Fill Zone(s)" ),
+                                 SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP | SKIP_CONNECTIVITY );
+                }
+
+                return zone->GetFilledPolysList( F_Cu )->Area();
+            };
+
+    for( ISLAND_REMOVAL_MODE mode : { ISLAND_REMOVAL_MODE::NEVER, ISLAND_REMOVAL_MODE::ALWAYS } )
+    {
+        BOOST_TEST_CONTEXT( "Island removal mode " << static_cast<int>( mode ) )
+        {
+            zone->SetIslandRemovalMode( mode );
+            wall->SetStart( at( 10, -1 ) );
+
+            double splitArea = fill( {} );
+
+            // Shorten the wall so that both halves of the zone meet again below it
+            BOX2I oldBBox = wall->GetBoundingBox();
+            wall->SetStart( at( 10, 5 ) );
+            BOX2I newBBox = wall->GetBoundingBox();
+
+            double partialArea = fill( { oldBBox, newBBox } );
+            double fullArea = fill( {} );
+
+            BOOST_CHECK_GT( fullArea, splitArea );
+            BOOST_CHECK_CLOSE( partialArea, fullArea, 0.01 );
+
+            if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
+                BOOST_CHECK_GT( fullArea, 1.5 * splitArea );
+        }
+    }
+}
@@ -24,10 +24,12 @@
 #include <qa_utils/wx_utils/unit_test_utils.h>
 #include <eeschema_test_utils.h>
 #include <sim/sim_library_spice.h>
+#include <sim/sim_lib_mgr.h>
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <fmt/core.h>
 #include <locale_io.h>
+#include <wx/ffile.h>
 
 
 class TEST_SIM_LIBRARY_SPICE_FIXTURE
@@ -1581,4 +1583,58 @@ BOOST_AUTO_TEST_CASE( InvalidBinaryFile )
 }
 
 
+// Libraries are shared between managers until one of their files is modified.
+BOOST_AUTO_TEST_CASE( LibraryCache )
+{
+    LOCALE_IO  toggle;
+    wxFileName fn( wxFileName::CreateTempFileName( wxT( "sim_lib_cache" ) ) );
+
+    auto writeLibrary =
+            [&]( const wxString& aContents )
+            {
+                wxFFile file( fn.GetFullPath(), wxT( "w" ) );
+                BOOST_REQUIRE( file.IsOpened() );
+                file.Write( aContents );
+            };
+
+    auto loadLibrary =
+            [&]( SIM_LIB_MGR& aMgr ) -> const SIM_LIBRARY*
+            {
+                NULL_REPORTER devnull;
+                aMgr.SetLibrary( fn.GetFullPath(), devnull );
+
+                auto libraries = aMgr.GetLibraries();
+                BOOST_REQUIRE_EQUAL( libraries.size(), 1 );
+
+                return &libraries.begin()->second.get();
+            };
+
+    writeLibrary( wxT( ".model D1 D(is=1n)\n" ) );
+
+    SIM_LIB_MGR        first( nullptr );
+    SIM_LIB_MGR        second( nullptr );
+    const SIM_LIBRARY* firstLib = loadLibrary( first );
+
+    BOOST_CHECK_EQUAL( loadLibrary( second ), firstLib );
+    BOOST_CHECK( firstLib->FindModel( "D1" ) );
+
+    writeLibrary( wxT( ".model D2 D(is=2n)\n" ) );
+
+    wxDateTime later = wxDateTime::Now() + wxTimeSpan::Minutes( 1 );
+    fn.SetTimes( &later, &later, nullptr );
+
+    SIM_LIB_MGR        third( nullptr );
+    const SIM_LIBRARY* thirdLib = loadLibrary( third );
+
+    BOOST_CHECK_NE( thirdLib, firstLib );
+    BOOST_CHECK( !thirdLib->FindModel( "D1" ) );
+    BOOST_CHECK( thirdLib->FindModel( "D2" ) );
+
+    // The first library is still alive for the managers holding it
+    BOOST_CHECK( firstLib->FindModel( "D1" ) );
+
+    wxRemoveFile( fn.GetFullPath() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,317 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Micro-benchmarks of the geometry kernel, run on polygon sets dumped with SHAPE_FILE_IO
+ * (for instance by the polygon_generator tool of qa_pcbnew_tools), so that they measure real
+ * zone, pad and track geometry.
+ *
+ * Usage: qa_common_tools geometry_benchmark [-r repetitions] dump_file...
+ */
+
+#include <geometry/seg.h>
+#include <geometry/shape_file_io.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+struct CORPUS
+{
+    std::vector<SHAPE_POLY_SET> m_Shapes;
+    SHAPE_POLY_SET              m_All;       ///< All shapes, not merged
+    SHAPE_POLY_SET              m_Merged;    ///< All shapes, merged and with holes
+    SHAPE_POLY_SET              m_HalfA;     ///< Every other shape, starting with the first
+    SHAPE_POLY_SET              m_HalfB;     ///< Every other shape, starting with the second
+    std::vector<SEG>            m_Segs;      ///< Edges of the merged outlines
+    std::vector<VECTOR2I>       m_Points;    ///< Random points in the merged bounding box
+};
+
+
+struct BENCHMARK
+{
+    const char*                          m_Name;
+    std::function<size_t( const CORPUS& )> m_Func;   ///< Returns a value depending on the work
+};
+
+
+bool loadCorpus( const std::vector<std::string>& aFiles, CORPUS& aCorpus )
+{
+    for( const std::string& file : aFiles )
+    {
+        SHAPE_FILE_IO io( file, SHAPE_FILE_IO::IOM_READ );
+
+        while( SHAPE* shape = io.Read() )
+        {
+            std::unique_ptr<SHAPE_POLY_SET> poly( static_cast<SHAPE_POLY_SET*>( shape ) );
+
+            if( poly->OutlineCount() )
+                aCorpus.m_Shapes.push_back( std::move( *poly ) );
+        }
+    }
+
+    if( aCorpus.m_Shapes.empty() )
+        return false;
+
+    for( size_t ii = 0; ii < aCorpus.m_Shapes.size(); ++ii )
+    {
+        const SHAPE_POLY_SET& shape = aCorpus.m_Shapes[ii];
+
+        aCorpus.m_All.Append( shape );
+        ( ii % 2 ? aCorpus.m_HalfB : aCorpus.m_HalfA ).Append( shape );
+    }
+
+    aCorpus.m_Merged = aCorpus.m_All.CloneDropTriangulation();
+    aCorpus.m_Merged.Simplify();
+
+    for( int ii = 0; ii < aCorpus.m_Merged.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& outline = aCorpus.m_Merged.COutline( ii );
+
+        for( int jj = 0; jj < outline.SegmentCount(); ++jj )
+            aCorpus.m_Segs.push_back( outline.CSegment( jj ) );
+    }
+
+    const BOX2I                        bbox = aCorpus.m_Merged.BBox();
+    std::mt19937                       rng( 1 );
+    std::uniform_int_distribution<int> x( bbox.GetLeft(), bbox.GetRight() );
+    std::uniform_int_distribution<int> y( bbox.GetTop(), bbox.GetBottom() );
+
+    for( int ii = 0; ii < 100000; ++ii )
+        aCorpus.m_Points.emplace_back( x( rng ), y( rng ) );
+
+    return true;
+}
+
+
+const std::vector<BENCHMARK> s_benchmarks = {
+    { "boolean_add",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result;
+          result.BooleanAdd( aCorpus.m_HalfA, aCorpus.m_HalfB );
+          return (size_t) result.FullPointCount();
+      } },
+    { "boolean_subtract",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result;
+          result.BooleanSubtract( aCorpus.m_HalfA, aCorpus.m_HalfB );
+          return (size_t) result.FullPointCount();
+      } },
+    { "simplify",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result = aCorpus.m_All.CloneDropTriangulation();
+          result.Simplify();
+          return (size_t) result.FullPointCount();
+      } },
+    { "fracture",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result = aCorpus.m_Merged.CloneDropTriangulation();
+          result.Fracture();
+          return (size_t) result.FullPointCount();
+      } },
+    { "inflate",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result = aCorpus.m_Merged.CloneDropTriangulation();
+          result.Inflate( 100000, CORNER_STRATEGY::ROUND_ALL_CORNERS, 5000 );
+          return (size_t) result.FullPointCount();
+      } },
+    { "deflate",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result = aCorpus.m_Merged.CloneDropTriangulation();
+          result.Deflate( 100000, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, 5000 );
+          return (size_t) result.FullPointCount();
+      } },
+    { "triangulate",
+      []( const CORPUS& aCorpus )
+      {
+          SHAPE_POLY_SET result = aCorpus.m_Merged.CloneDropTriangulation();
+          result.Fracture();
+          result.CacheTriangulation();
+
+          size_t triangles = 0;
+
+          for( unsigned ii = 0; ii < result.TriangulatedPolyCount(); ++ii )
+              triangles += result.TriangulatedPolygon( ii )->GetTriangleCount();
+
+          return triangles;
+      } },
+    { "chain_intersect",
+      []( const CORPUS& aCorpus )
+      {
+          size_t intersections = 0;
+
+          for( const SHAPE_POLY_SET& shape : aCorpus.m_Shapes )
+          {
+              SHAPE_LINE_CHAIN::INTERSECTIONS ips;
+
+              for( int ii = 0; ii < aCorpus.m_Merged.OutlineCount(); ++ii )
+              {
+                  const SHAPE_LINE_CHAIN& outline = aCorpus.m_Merged.COutline( ii );
+
+                  if( outline.BBox().Intersects( shape.BBox() ) )
+                      intersections += shape.COutline( 0 ).Intersect( outline, ips );
+              }
+          }
+
+          return intersections;
+      } },
+    { "seg_distance",
+      []( const CORPUS& aCorpus )
+      {
+          const std::vector<SEG>& segs = aCorpus.m_Segs;
+          SEG::ecoord             acc = 0;
+
+          for( size_t ii = 0; ii < segs.size(); ++ii )
+          {
+              for( size_t jj = ii + 1; jj < std::min( segs.size(), ii + 64 ); ++jj )
+                  acc += segs[ii].SquaredDistance( segs[jj] ) & 0xFF;
+          }
+
+          return (size_t) acc;
+      } },
+    { "seg_collide",
+      []( const CORPUS& aCorpus )
+      {
+          const std::vector<SEG>& segs = aCorpus.m_Segs;
+          size_t                  hits = 0;
+
+          for( size_t ii = 0; ii < segs.size(); ++ii )
+          {
+              for( size_t jj = ii + 1; jj < std::min( segs.size(), ii + 64 ); ++jj )
+                  hits += segs[ii].Collide( segs[jj], 200000 );
+          }
+
+          return hits;
+      } },
+    { "point_in_polygon",
+      []( const CORPUS& aCorpus )
+      {
+          size_t inside = 0;
+
+          for( const VECTOR2I& pt : aCorpus.m_Points )
+              inside += aCorpus.m_Merged.Contains( pt );
+
+          return inside;
+      } },
+    { "point_in_polygon_batch",
+      []( const CORPUS& aCorpus )
+      {
+          std::vector<uint8_t> result;
+          aCorpus.m_Merged.ContainsPoints( aCorpus.m_Points, result );
+          return (size_t) std::count( result.begin(), result.end(), 1 );
+      } },
+};
+
+
+enum GEOM_BENCH_RET_CODES
+{
+    NO_SHAPES = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+int geometry_benchmark_main( int argc, char* argv[] )
+{
+    int                      reps = 5;
+    std::vector<std::string> files;
+
+    for( int ii = 1; ii < argc; ++ii )
+    {
+        if( !strcmp( argv[ii], "-r" ) && ii + 1 < argc )
+            reps = std::max( 1, atoi( argv[++ii] ) );
+        else
+            files.emplace_back( argv[ii] );
+    }
+
+    if( files.empty() )
+    {
+        fprintf( stderr, "Usage: geometry_benchmark [-r repetitions] dump_file...\n" );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    CORPUS corpus;
+
+    if( !loadCorpus( files, corpus ) )
+    {
+        fprintf( stderr, "No polygon sets found\n" );
+        return GEOM_BENCH_RET_CODES::NO_SHAPES;
+    }
+
+    printf( "%zu shapes, %d points, %d merged outlines, %zu edges\n", corpus.m_Shapes.size(),
+            corpus.m_All.FullPointCount(), corpus.m_Merged.OutlineCount(), corpus.m_Segs.size() );
+
+    printf( "%-24s %12s %12s %16s\n", "benchmark", "min [ms]", "median [ms]", "result" );
+
+    for( const BENCHMARK& bench : s_benchmarks )
+    {
+        std::vector<double> times;
+        size_t              result = 0;
+
+        for( int ii = 0; ii < reps; ++ii )
+        {
+            auto start = std::chrono::steady_clock::now();
+            result = bench.m_Func( corpus );
+            auto end = std::chrono::steady_clock::now();
+
+            times.push_back( std::chrono::duration<double, std::milli>( end - start ).count() );
+        }
+
+        std::sort( times.begin(), times.end() );
+
+        // The result is printed so the work cannot be optimised away, and so that runs before
+        // and after a change can be checked to compute the same thing
+        printf( "%-24s %12.3f %12.3f %16zu\n", bench.m_Name, times.front(), times[times.size() / 2],
+                result );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+} // namespace
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "geometry_benchmark",
+        "Benchmark the geometry kernel on polygon sets dumped with SHAPE_FILE_IO",
+        geometry_benchmark_main,
+} );
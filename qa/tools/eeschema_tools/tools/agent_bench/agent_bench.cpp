@@ -0,0 +1,323 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file agent_bench.cpp
+ *
+ * Replays a recorded agent response against a schematic and reports per-tool latency
+ * percentiles and heap allocation counts.
+ *
+ * The recorded response is streamed in chunks by a mock LLM through the same incremental
+ * tool call parser the agent dialog uses, and the calls are run by SCH_OLLAMA_AGENT_TOOL.  Its
+ * handlers edit through the schematic editor frame, so the schematic is opened in a frame that
+ * is never shown; the program still needs a display (e.g. xvfb-run on a build server).
+ */
+
+#include <qa_utils/utility_registry.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <utility>
+
+#include <wx/cmdline.h>
+#include <wx/msgout.h>
+
+#include <common.h>
+#include <core/profile.h>
+#include <tools/sch_agent_tool_call_parser.h>
+
+#include "agent_bench_executor.h"
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+/**
+ * Counts the heap allocations made by the current thread while it is alive.
+ *
+ * Only the innermost scope of a thread counts.  Allocations made outside of a scope, or by
+ * other threads (the thread pool, wx), are not counted.
+ */
+class ALLOC_SCOPE
+{
+public:
+    ALLOC_SCOPE() :
+            m_outer( s_current )
+    {
+        s_current = this;
+    }
+
+    ~ALLOC_SCOPE() { s_current = m_outer; }
+
+    ALLOC_SCOPE( const ALLOC_SCOPE& ) = delete;
+    ALLOC_SCOPE& operator=( const ALLOC_SCOPE& ) = delete;
+
+    /// @return the allocations and the bytes allocated so far.
+    std::pair<size_t, size_t> Take() const { return { m_count, m_bytes }; }
+
+    /// Allocation hook, called for every allocation of the program.
+    static void OnAlloc( std::size_t aSize )
+    {
+        if( ALLOC_SCOPE* scope = s_current )
+        {
+            scope->m_count++;
+            scope->m_bytes += aSize;
+        }
+    }
+
+private:
+    ALLOC_SCOPE* m_outer;
+    size_t       m_count = 0;
+    size_t       m_bytes = 0;
+
+    static thread_local ALLOC_SCOPE* s_current;
+};
+
+
+thread_local ALLOC_SCOPE* ALLOC_SCOPE::s_current = nullptr;
+
+
+void* operator new( std::size_t aSize )
+{
+    ALLOC_SCOPE::OnAlloc( aSize );
+
+    if( void* ptr = std::malloc( aSize ? aSize : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+/**
+ * Samples of one measured operation.
+ */
+struct BENCH_STATS
+{
+    void Add( double aMicros, size_t aAllocs, size_t aBytes, bool aOk )
+    {
+        m_micros.push_back( aMicros );
+        m_allocs += aAllocs;
+        m_bytes += aBytes;
+        m_failures += aOk ? 0 : 1;
+    }
+
+    double Percentile( double aFraction ) const
+    {
+        if( m_micros.empty() )
+            return 0.0;
+
+        std::vector<double> sorted = m_micros;
+        std::sort( sorted.begin(), sorted.end() );
+
+        size_t idx = std::min( sorted.size() - 1, (size_t) ( aFraction * ( sorted.size() - 1 ) + 0.5 ) );
+        return sorted[idx];
+    }
+
+    std::vector<double> m_micros;
+    size_t              m_allocs = 0;
+    size_t              m_bytes = 0;
+    int                 m_failures = 0;
+};
+
+
+static void printStats( const std::string& aName, const BENCH_STATS& aStats )
+{
+    size_t calls = std::max<size_t>( 1, aStats.m_micros.size() );
+
+    std::cout << wxString::Format( "%-28s %6zu %10.1f %10.1f %10.1f %10.1f %10zu %12zu %6d",
+                                   aName, aStats.m_micros.size(), aStats.Percentile( 0.5 ),
+                                   aStats.Percentile( 0.9 ), aStats.Percentile( 0.99 ),
+                                   aStats.Percentile( 1.0 ), aStats.m_allocs / calls,
+                                   aStats.m_bytes / calls, aStats.m_failures )
+              << std::endl;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print every tool call" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "b", "batch", _( "run each turn as one batch instead of per tool" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "x", "context", _( "build the agent context on every turn" ).mb_str() },
+    { wxCMD_LINE_OPTION, "n", "repeat", _( "number of turns to replay (default 20)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "k", "chunk", _( "mock LLM chunk size in characters (default 16)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "schematic file" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "recorded agent response" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum AGENT_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    SCRIPT_FAILED
+};
+
+
+int agent_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program replays a recorded agent response (a sequence of "
+                               "TOOL lines) against a schematic through the agent tool and "
+                               "reports latency percentiles and allocations per tool." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    long       repeat = 20;
+    long       chunk = 16;
+
+    cl_parser.Found( "repeat", &repeat );
+    cl_parser.Found( "chunk", &chunk );
+
+    std::ifstream scriptFile( cl_parser.GetParam( 1 ).ToStdString() );
+
+    if( !scriptFile.is_open() )
+    {
+        std::cerr << "Unable to read " << cl_parser.GetParam( 1 ) << std::endl;
+        return AGENT_BENCH_RET_CODES::SCRIPT_FAILED;
+    }
+
+    std::stringstream script;
+    script << scriptFile.rdbuf();
+
+    if( !AGENT_BENCH_EXECUTOR::InitProgram( argc, argv ) )
+    {
+        std::cerr << "Unable to initialize the editor" << std::endl;
+        return AGENT_BENCH_RET_CODES::LOAD_FAILED;
+    }
+
+    AGENT_BENCH_EXECUTOR executor( cl_parser.Found( "batch" ) );
+
+    {
+        PROF_TIMER timer;
+
+        if( !executor.Open( cl_parser.GetParam( 0 ) ) )
+        {
+            std::cerr << "Unable to load " << cl_parser.GetParam( 0 ) << std::endl;
+            return AGENT_BENCH_RET_CODES::LOAD_FAILED;
+        }
+
+        std::cout << "Loaded in " << timer.msecs() << " ms" << std::endl;
+    }
+
+    MOCK_LLM                            llm( wxString::FromUTF8( script.str() ), chunk );
+    std::map<std::string, BENCH_STATS>  stats;
+
+    for( long turn = 0; turn < repeat; ++turn )
+    {
+        SCH_AGENT_TOOL_CALL_PARSER                          parser;
+        std::vector<SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL>  calls;
+
+        auto measure =
+                [&]( const std::string& aName, const std::function<bool()>& aFunc )
+                {
+                    ALLOC_SCOPE allocs;
+                    PROF_TIMER  timer;
+                    bool        ok = aFunc();
+                    double      micros = timer.SinceStart<BENCH_DURATION>().count();
+
+                    auto [count, bytes] = allocs.Take();
+                    stats[aName].Add( micros, count, bytes, ok );
+                };
+
+        if( cl_parser.Found( "context" ) )
+            measure( "[context]", [&]() { return !executor.Context().IsEmpty(); } );
+
+        measure( "[stream+parse]",
+                 [&]()
+                 {
+                     llm.Stream( [&]( const wxString& aChunk ) { parser.Feed( aChunk, calls ); } );
+                     parser.Finish( calls );
+                     return !calls.empty();
+                 } );
+
+        for( const SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL& call : calls )
+        {
+            if( verbose && turn == 0 )
+                std::cout << call.name << " " << call.payload << std::endl;
+
+            if( executor.IsBatch() )
+            {
+                executor.Execute( call.name, call.payload );
+            }
+            else
+            {
+                measure( call.name.Lower().ToStdString(),
+                         [&]() { return executor.Execute( call.name, call.payload ); } );
+            }
+        }
+
+        if( executor.IsBatch() )
+            measure( "[batch]", [&]() { return executor.Commit(); } );
+
+        executor.RevertTurn();
+    }
+
+    std::cout << wxString::Format( "%-28s %6s %10s %10s %10s %10s %10s %12s %6s", "tool", "calls",
+                                   "p50 us", "p90 us", "p99 us", "max us", "allocs", "bytes",
+                                   "failed" )
+              << std::endl;
+
+    bool ok = true;
+
+    for( const auto& [name, toolStats] : stats )
+    {
+        printStats( name, toolStats );
+        ok &= toolStats.m_failures == 0;
+    }
+
+    return ok ? KI_TEST::RET_CODES::OK : AGENT_BENCH_RET_CODES::SCRIPT_FAILED;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "agent_bench",
+                                                       "Replay agent tool calls against a schematic",
+                                                       agent_bench_main_func } );
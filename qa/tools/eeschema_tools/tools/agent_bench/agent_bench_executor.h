@@ -0,0 +1,212 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef AGENT_BENCH_EXECUTOR_H
+#define AGENT_BENCH_EXECUTOR_H
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+
+#include <eeschema_settings.h>
+#include <kiface_base.h>
+#include <kiway.h>
+#include <kiway_player.h>
+#include <pgm_base.h>
+#include <sch_edit_frame.h>
+#include <schematic.h>
+#include <settings/kicad_settings.h>
+#include <settings/settings_manager.h>
+#include <symbol_editor/symbol_editor_settings.h>
+#include <tool/tool_manager.h>
+#include <tools/sch_ollama_agent_tool.h>
+
+
+/**
+ * Stands in for the LLM server by streaming a recorded response in fixed size chunks.
+ */
+class MOCK_LLM
+{
+public:
+    MOCK_LLM( const wxString& aResponse, size_t aChunkSize ) :
+            m_response( aResponse ),
+            m_chunkSize( std::max<size_t>( 1, aChunkSize ) )
+    {
+    }
+
+    void Stream( const std::function<void( const wxString& )>& aOnChunk ) const
+    {
+        for( size_t pos = 0; pos < m_response.length(); pos += m_chunkSize )
+            aOnChunk( m_response.Mid( pos, m_chunkSize ) );
+    }
+
+private:
+    wxString m_response;
+    size_t   m_chunkSize;
+};
+
+
+/**
+ * Executes agent tool calls with SCH_OLLAMA_AGENT_TOOL, on a schematic opened in a schematic
+ * editor frame that is never shown.
+ *
+ * The handlers of the tool edit through their frame (current sheet, commits, undo list), so
+ * the calls run exactly as they do in the editor.  Each turn is rolled back through the undo
+ * list, which keeps repeated turns measuring the same design; a turn must therefore fit in the
+ * undo limit of the settings in use.  Symbols are looked up in the symbol libraries of the
+ * project, as in the editor.
+ */
+class AGENT_BENCH_EXECUTOR
+{
+public:
+    /**
+     * Set up what the editor frame needs from the program: a GUI application, the program
+     * settings and the eeschema settings.  Only the first call does anything.
+     */
+    static bool InitProgram( int aArgc, char** aArgv )
+    {
+        struct BENCH_PGM : public PGM_BASE
+        {
+            void MacOpenFile( const wxString& aFileName ) override {}
+        };
+
+        static bool initialized = false;
+        static bool ok = false;
+
+        if( initialized )
+            return ok;
+
+        initialized = true;
+
+        SetPgm( new BENCH_PGM() );
+        wxApp::SetInstance( new wxApp );
+
+        int argc = aArgc;
+
+        if( !wxEntryStart( argc, aArgv ) )
+            return false;
+
+        Pgm().InitPgm( false, true );
+
+        SETTINGS_MANAGER& mgr = Pgm().GetSettingsManager();
+
+        Kiface().InitSettings( new EESCHEMA_SETTINGS );
+        mgr.RegisterSettings( new KICAD_SETTINGS, false );
+        mgr.RegisterSettings( new SYMBOL_EDITOR_SETTINGS, false );
+        mgr.RegisterSettings( Kiface().KifaceSettings(), false );
+        mgr.Load();
+
+        ok = true;
+        return ok;
+    }
+
+    /**
+     * @param aBatch runs the calls of a turn as one change, with RunToolBatch(), when the turn
+     *               is committed; otherwise every call is committed by RunToolCommand().
+     */
+    AGENT_BENCH_EXECUTOR( bool aBatch ) :
+            m_kiway( KFCTL_STANDALONE ),
+            m_batch( aBatch )
+    {
+    }
+
+    ~AGENT_BENCH_EXECUTOR()
+    {
+        if( m_frame )
+        {
+            RevertTurn();
+            delete m_frame;
+        }
+    }
+
+    bool Open( const wxString& aFileName )
+    {
+        wxFileName fn( aFileName );
+        fn.MakeAbsolute();
+
+        m_frame = new SCH_EDIT_FRAME( &m_kiway, nullptr );
+
+        if( !m_frame->OpenProjectFiles( { fn.GetFullPath() }, KICTL_KICAD_ONLY ) )
+            return false;
+
+        m_tool = m_frame->GetToolManager()->GetTool<SCH_OLLAMA_AGENT_TOOL>();
+        m_undoCount = m_frame->GetUndoCommandCount();
+        return m_tool != nullptr;
+    }
+
+    SCHEMATIC& Schematic() { return m_frame->Schematic(); }
+
+    bool IsBatch() const { return m_batch; }
+
+    bool Execute( const wxString& aTool, const wxString& aPayload )
+    {
+        // Recorded responses may leave out the namespace of the schematic tools
+        wxString tool = aTool.Contains( wxS( "." ) ) ? aTool : wxS( "schematic." ) + aTool;
+
+        if( m_batch )
+        {
+            m_pending.emplace_back( tool, aPayload );
+            return true;
+        }
+
+        return m_tool->RunToolCommand( tool, aPayload );
+    }
+
+    /// Run the calls queued in batch mode.
+    bool Commit()
+    {
+        if( m_pending.empty() )
+            return true;
+
+        bool ok = m_tool->RunToolBatch( m_pending, wxS( "Agent bench" ) );
+
+        m_pending.clear();
+        return ok;
+    }
+
+    /// Undo everything done since the schematic was opened.
+    void RevertTurn()
+    {
+        m_pending.clear();
+
+        while( m_frame->GetUndoCommandCount() > m_undoCount )
+            m_frame->RollbackSchematicFromUndo();
+    }
+
+    wxString Context() { return m_tool->GetSchematicContextDelta(); }
+
+private:
+    KIWAY                                        m_kiway;
+    bool                                         m_batch;
+    SCH_EDIT_FRAME*                              m_frame = nullptr;
+    SCH_OLLAMA_AGENT_TOOL*                       m_tool = nullptr;
+    int                                          m_undoCount = 0;
+    std::vector<std::pair<wxString, wxString>>   m_pending;
+};
+
+#endif // AGENT_BENCH_EXECUTOR_H
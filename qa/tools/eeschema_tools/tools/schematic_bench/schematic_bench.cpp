@@ -0,0 +1,327 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file schematic_bench.cpp
+ *
+ * Runs the schematic side of a project end to end without an editor frame and reports the
+ * wall time, peak RSS and breakdown of each stage as JSON, optionally compared with a
+ * baseline.  It is the counterpart of board_bench in qa_pcbnew_tools: the two kifaces cannot
+ * be linked in the same program.
+ *
+ * The netlist is exported through EESCHEMA_JOBS_HANDLER, which loads its own copy of the
+ * schematic as kicad-cli does; the exported file can be passed to board_bench for the schematic
+ * parity tests.  ERC runs as the ERC job does, but without the symbol libraries, which are not
+ * available here: the library checks are ignored.  The agent session replays a recorded agent
+ * response through the agent tool, in a hidden editor frame, as agent_bench does.
+ */
+
+#include <qa_utils/bench_report.h>
+#include <qa_utils/utility_registry.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <cli/exit_codes.h>
+#include <common.h>
+#include <eeschema_helpers.h>
+#include <eeschema_jobs_handler.h>
+#include <erc/erc.h>
+#include <erc/erc_settings.h>
+#include <jobs/job_export_sch_netlist.h>
+#include <tools/sch_agent_tool_call_parser.h>
+
+#include "../agent_bench/agent_bench_executor.h"
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "a", "agent", _( "recorded agent response to replay" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "n", "turns", _( "number of agent turns to replay (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "d", "output-dir", _( "directory of the exported files (default: temporary)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON report to this file (default: stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "b", "baseline", _( "compare with the JSON report of an earlier run" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "t", "tolerance", _( "allowed slowdown in percent (default 10)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "m", "min-ms", _( "ignore slowdowns shorter than this (default 50)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "reference schematic files" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum SCHEMATIC_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    STAGE_FAILED,
+    WRITE_FAILED,
+    REGRESSION
+};
+
+
+static bool runErc( SCHEMATIC* aSchematic )
+{
+    ERC_SETTINGS& settings = aSchematic->ErcSettings();
+
+    settings.m_ERCSeverities[ERCE_LIB_SYMBOL_ISSUES] = RPT_SEVERITY_IGNORE;
+    settings.m_ERCSeverities[ERCE_LIB_SYMBOL_MISMATCH] = RPT_SEVERITY_IGNORE;
+
+    ERC_TESTER tester( aSchematic );
+    tester.RunTests( nullptr, nullptr, nullptr, &aSchematic->Project(), nullptr );
+
+    SHEETLIST_ERC_ITEMS_PROVIDER errors( aSchematic );
+    errors.SetSeverities( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING );
+
+    std::cerr << aSchematic->GetFileName() << ": " << errors.GetCount() << " ERC violations"
+              << std::endl;
+    return true;
+}
+
+
+/**
+ * Replay \a aTurns turns of a recorded agent response on \a aFileName, each turn as one
+ * batch.  The splits add up the time of each step over all the turns.
+ */
+static bool runAgentSession( const wxString& aFileName, const wxString& aResponse, long aTurns,
+                             KI_TEST::BENCH_REPORT::STAGE& aStage )
+{
+    AGENT_BENCH_EXECUTOR          executor( true );
+    MOCK_LLM                      llm( aResponse, 16 );
+    std::map<std::string, double> toolMsecs;
+    bool                          ok = true;
+
+    if( !executor.Open( aFileName ) )
+        return false;
+
+    toolMsecs["[open]"] = aStage.m_Timer.msecs();
+
+    for( long turn = 0; turn < aTurns; ++turn )
+    {
+        SCH_AGENT_TOOL_CALL_PARSER                         parser;
+        std::vector<SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL> calls;
+        PROF_TIMER                                         timer;
+
+        llm.Stream( [&]( const wxString& aChunk ) { parser.Feed( aChunk, calls ); } );
+        parser.Finish( calls );
+        toolMsecs["[stream+parse]"] += timer.msecs( true );
+
+        for( const SCH_AGENT_TOOL_CALL_PARSER::TOOL_CALL& call : calls )
+            executor.Execute( call.name, call.payload );
+
+        ok &= executor.Commit();
+        toolMsecs["[batch]"] += timer.msecs( true );
+
+        executor.RevertTurn();
+        toolMsecs["[revert]"] += timer.msecs( true );
+    }
+
+    for( const auto& [tool, msecs] : toolMsecs )
+        aStage.AddSplit( tool, msecs );
+
+    return ok;
+}
+
+
+int schematic_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program loads reference schematics, then builds "
+                               "connectivity, runs ERC, exports the netlist and replays an agent "
+                               "session, and reports the time and peak memory of each stage as "
+                               "JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString agentFile;
+    long     turns = 5;
+    wxString outputDir = wxFileName::GetTempDir() + wxFileName::GetPathSeparator()
+                         + wxS( "kicad_schematic_bench" );
+    wxString outputFile;
+    wxString baselineFile;
+    long     tolerance = 10;
+    long     minMsecs = 50;
+
+    cl_parser.Found( "agent", &agentFile );
+    cl_parser.Found( "turns", &turns );
+    cl_parser.Found( "output-dir", &outputDir );
+    cl_parser.Found( "output", &outputFile );
+    cl_parser.Found( "baseline", &baselineFile );
+    cl_parser.Found( "tolerance", &tolerance );
+    cl_parser.Found( "min-ms", &minMsecs );
+
+    if( cl_parser.GetParamCount() == 0 )
+    {
+        cl_parser.Usage();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString agentResponse;
+
+    if( !agentFile.IsEmpty() )
+    {
+        std::ifstream     in( agentFile.ToStdString() );
+        std::stringstream text;
+
+        if( !in.is_open() )
+        {
+            std::cerr << "Unable to read " << agentFile << std::endl;
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+        }
+
+        text << in.rdbuf();
+        agentResponse = wxString::FromUTF8( text.str() );
+
+        if( !AGENT_BENCH_EXECUTOR::InitProgram( argc, argv ) )
+        {
+            std::cerr << "Unable to initialize the editor" << std::endl;
+            return SCHEMATIC_BENCH_RET_CODES::LOAD_FAILED;
+        }
+    }
+
+    KI_TEST::BENCH_REPORT report;
+    int                   retCode = KI_TEST::RET_CODES::OK;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxString   filename = cl_parser.GetParam( ii );
+        wxFileName netlistFile( outputDir, wxFileName( filename ).GetName(), wxS( "net" ) );
+
+        report.BeginProject( filename.ToStdString() );
+
+        std::unique_ptr<SCHEMATIC> schematic;
+
+        if( !report.RunStage( "load",
+                              [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                              {
+                                  schematic.reset( EESCHEMA_HELPERS::LoadSchematic( filename, true,
+                                                                                    false, nullptr,
+                                                                                    false ) );
+                                  return schematic != nullptr;
+                              } ) )
+        {
+            std::cerr << "Unable to load " << filename << std::endl;
+            retCode = SCHEMATIC_BENCH_RET_CODES::LOAD_FAILED;
+            continue;
+        }
+
+        report.RunStage( "connectivity",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             schematic->ConnectionGraph()->Recalculate( schematic->Hierarchy(),
+                                                                        true );
+                             return true;
+                         } );
+
+        report.RunStage( "erc",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             return runErc( schematic.get() );
+                         } );
+
+        EESCHEMA_JOBS_HANDLER handler( nullptr );
+
+        report.RunStage( "netlist",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             JOB_EXPORT_SCH_NETLIST job;
+                             job.m_filename = filename;
+                             job.format = JOB_EXPORT_SCH_NETLIST::FORMAT::KICADSEXPR;
+                             job.SetConfiguredOutputPath( netlistFile.GetFullPath() );
+
+                             if( handler.JobExportNetlist( &job ) != CLI::EXIT_CODES::OK )
+                                 return false;
+
+                             std::cerr << "Netlist written to " << netlistFile.GetFullPath()
+                                       << std::endl;
+                             return true;
+                         } );
+
+        if( !agentResponse.IsEmpty() )
+        {
+            report.RunStage( "agent",
+                             [&]( KI_TEST::BENCH_REPORT::STAGE& aStage )
+                             {
+                                 return runAgentSession( filename, agentResponse, turns, aStage );
+                             } );
+        }
+    }
+
+    if( !report.AllStagesOk() && retCode == KI_TEST::RET_CODES::OK )
+        retCode = SCHEMATIC_BENCH_RET_CODES::STAGE_FAILED;
+
+    if( !report.Write( outputFile.ToStdString() ) )
+    {
+        std::cerr << "Unable to write " << outputFile << std::endl;
+        return SCHEMATIC_BENCH_RET_CODES::WRITE_FAILED;
+    }
+
+    if( !baselineFile.IsEmpty() )
+    {
+        std::optional<nlohmann::json> baseline =
+                KI_TEST::BENCH_REPORT::Read( baselineFile.ToStdString() );
+
+        if( !baseline )
+        {
+            std::cerr << "Unable to read " << baselineFile << std::endl;
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+        }
+
+        for( const std::string& regression : report.CompareTo( *baseline, tolerance / 100.0,
+                                                               minMsecs ) )
+        {
+            std::cerr << regression << std::endl;
+
+            if( retCode == KI_TEST::RET_CODES::OK )
+                retCode = SCHEMATIC_BENCH_RET_CODES::REGRESSION;
+        }
+    }
+
+    return retCode;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "schematic_bench",
+                                                       "Time the schematic stages of reference projects",
+                                                       schematic_bench_main_func } );
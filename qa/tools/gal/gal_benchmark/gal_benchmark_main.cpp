@@ -0,0 +1,427 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gal_benchmark_main.cpp
+ *
+ * Draws reference boards along fixed camera paths (zoom to fit, pan sweeps, deep zoom on the
+ * footprint with the most pads), toggles copper layers and forces a full recache, with the
+ * OpenGL and Cairo backends.  Reports frame time percentiles, the mean time of each drawing
+ * stage and the GPU memory in use as JSON.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+
+#include <wx/cmdline.h>
+#include <wx/frame.h>
+#include <wx/sizer.h>
+#include <wx/utils.h>
+
+#include <nlohmann/json.hpp>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <core/profile.h>
+#include <gal/frame_profiler.h>
+#include <gal/opengl/kiglew.h>
+#include <pcb_draw_panel_gal.h>
+#include <view/view.h>
+
+#include "pcb_test_frame.h"
+
+using json = nlohmann::json;
+
+
+/**
+ * Frame times and per stage timings of one scenario.
+ */
+struct FRAME_STATS
+{
+    void Add( double aFrameMsecs )
+    {
+        m_msecs.push_back( aFrameMsecs );
+
+        for( const auto& [stage, msecs] : KIGFX::FRAME_PROFILER::Get().GetLastFrameSummary() )
+            m_stageMsecs[stage] += msecs;
+    }
+
+    double Percentile( double aFraction ) const
+    {
+        if( m_msecs.empty() )
+            return 0.0;
+
+        std::vector<double> sorted = m_msecs;
+        std::sort( sorted.begin(), sorted.end() );
+
+        size_t idx = std::min( sorted.size() - 1, (size_t) ( aFraction * ( sorted.size() - 1 ) + 0.5 ) );
+        return sorted[idx];
+    }
+
+    json ToJson() const
+    {
+        json stages = json::object();
+
+        for( const auto& [stage, msecs] : m_stageMsecs )
+            stages[stage] = m_msecs.empty() ? 0.0 : msecs / m_msecs.size();
+
+        return { { "frames", m_msecs.size() },
+                 { "p50_ms", Percentile( 0.5 ) },
+                 { "p90_ms", Percentile( 0.9 ) },
+                 { "p99_ms", Percentile( 0.99 ) },
+                 { "max_ms", Percentile( 1.0 ) },
+                 { "stages_mean_ms", stages } };
+    }
+
+    std::vector<double>           m_msecs;
+    std::map<std::string, double> m_stageMsecs;
+};
+
+
+class GAL_BENCHMARK_FRAME : public wxFrame, public PCB_TEST_FRAME_BASE
+{
+public:
+    GAL_BENCHMARK_FRAME( const wxSize& aSize ) :
+            wxFrame( nullptr, wxID_ANY, wxT( "GAL benchmark" ), wxDefaultPosition, aSize )
+    {
+        LoadSettings();
+        createView( this, PCB_DRAW_PANEL_GAL::GAL_TYPE_OPENGL );
+
+        wxBoxSizer* sizer = new wxBoxSizer( wxVERTICAL );
+        sizer->Add( m_galPanel.get(), 1, wxEXPAND );
+        SetSizer( sizer );
+
+        Show( true );
+        Layout();
+    }
+
+    /**
+     * Redraw the whole view once.
+     *
+     * @return the frame time in milliseconds, or nothing if the canvas could not draw.
+     */
+    std::optional<double> DrawFrame()
+    {
+        m_galPanel->GetView()->MarkDirty();
+
+        // The canvas may need a few event loop runs before it can draw after being shown or
+        // after a backend switch
+        for( int attempt = 0; attempt < 100; ++attempt )
+        {
+            PROF_TIMER timer;
+
+            if( m_galPanel->DoRePaint() )
+                return timer.msecs();
+
+            wxYield();
+            wxMilliSleep( 10 );
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @return the video memory in use in kilobytes, when the OpenGL driver reports it.
+     */
+    std::optional<int> GetUsedGpuMemory()
+    {
+        if( m_galPanel->GetBackend() != PCB_DRAW_PANEL_GAL::GAL_TYPE_OPENGL )
+            return std::nullopt;
+
+        KIGFX::GAL_CONTEXT_LOCKER lock( m_galPanel->GetGAL() );
+
+        if( GLEW_NVX_gpu_memory_info )
+        {
+            GLint total = 0;
+            GLint available = 0;
+            glGetIntegerv( GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &total );
+            glGetIntegerv( GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available );
+            return total - available;
+        }
+
+        return std::nullopt;
+    }
+};
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "b", "backend", _( "opengl, cairo or both (default both)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "n", "frames", _( "number of frames of every camera path (default 60)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON report to this file (default: stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "reference board files" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum GAL_BENCHMARK_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    DRAW_FAILED,
+    WRITE_FAILED
+};
+
+
+static json benchmarkBoard( GAL_BENCHMARK_FRAME* aFrame, BOARD* aBoard, long aFrames, bool& aDrawFailed )
+{
+    PCB_DRAW_PANEL_GAL* panel = aFrame->GetPanel().get();
+    KIGFX::VIEW*        view = panel->GetView();
+    json                scenarios = json::object();
+
+    auto run =
+            [&]( const std::string& aName, long aCount, const std::function<void( long )>& aStep )
+            {
+                FRAME_STATS stats;
+
+                for( long ii = 0; ii < aCount; ++ii )
+                {
+                    aStep( ii );
+
+                    PROF_TIMER            timer;
+                    std::optional<double> frameTime = aFrame->DrawFrame();
+
+                    if( !frameTime )
+                    {
+                        aDrawFailed = true;
+                        return;
+                    }
+
+                    // Include the work done by the step itself, e.g. marking items for recache
+                    stats.Add( timer.msecs() );
+                }
+
+                scenarios[aName] = stats.ToJson();
+            };
+
+    BOX2D boardBox( aBoard->GetBoundingBox().GetOrigin(), aBoard->GetBoundingBox().GetSize() );
+
+    auto zoomFit =
+            [&]()
+            {
+                view->SetViewport( boardBox );
+            };
+
+    run( "zoom-fit", aFrames,
+         [&]( long )
+         {
+             zoomFit();
+         } );
+
+    // Sweep the board middle row and column at 4 times the zoom to fit scale
+    zoomFit();
+    double panScale = view->GetScale() * 4;
+
+    run( "pan-sweep", aFrames,
+         [&]( long aFrame )
+         {
+             double   t = (double) aFrame / std::max( 1L, aFrames - 1 );
+             VECTOR2D center;
+
+             if( aFrame % 2 )
+                 center = VECTOR2D( boardBox.GetX() + t * boardBox.GetWidth(), boardBox.Centre().y );
+             else
+                 center = VECTOR2D( boardBox.Centre().x, boardBox.GetY() + t * boardBox.GetHeight() );
+
+             view->SetScale( panScale );
+             view->SetCenter( center );
+         } );
+
+    // Deep zoom on the densest pad field, usually a BGA
+    FOOTPRINT* densest = nullptr;
+
+    for( FOOTPRINT* fp : aBoard->Footprints() )
+    {
+        if( !densest || fp->Pads().size() > densest->Pads().size() )
+            densest = fp;
+    }
+
+    if( densest && !densest->Pads().empty() )
+    {
+        BOX2I fpBox = densest->GetBoundingBox( false );
+        BOX2D deepBox( fpBox.GetOrigin(), fpBox.GetSize() );
+
+        run( "deep-zoom-pads", aFrames,
+             [&]( long aFrame )
+             {
+                 double t = (double) aFrame / std::max( 1L, aFrames - 1 );
+
+                 view->SetViewport( deepBox );
+                 view->SetScale( view->GetScale() * 4 );
+                 view->SetCenter( VECTOR2D( deepBox.GetX() + t * deepBox.GetWidth(),
+                                            deepBox.GetY() + t * deepBox.GetHeight() ) );
+             } );
+    }
+
+    // Hide and show again every copper layer
+    zoomFit();
+    LSEQ copperLayers = aBoard->GetEnabledLayers().CuStack();
+
+    run( "layer-toggle", copperLayers.size() * 2,
+         [&]( long aFrame )
+         {
+             view->SetLayerVisible( copperLayers[aFrame / 2], aFrame % 2 );
+         } );
+
+    run( "full-recache", std::max( 1L, aFrames / 10 ),
+         [&]( long )
+         {
+             view->UpdateAllItems( KIGFX::ALL );
+         } );
+
+    return scenarios;
+}
+
+
+int gal_benchmark_main_func( int argc, char* argv[] )
+{
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program draws boards along fixed camera paths and reports "
+                               "frame time percentiles, drawing stage timings and GPU memory "
+                               "use per backend as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long     frames = 60;
+    wxString backendName = wxT( "both" );
+    wxString outputFile;
+
+    cl_parser.Found( "frames", &frames );
+    cl_parser.Found( "backend", &backendName );
+    cl_parser.Found( "output", &outputFile );
+
+    std::vector<std::pair<std::string, PCB_DRAW_PANEL_GAL::GAL_TYPE>> backends;
+
+    if( backendName == wxT( "opengl" ) || backendName == wxT( "both" ) )
+        backends.emplace_back( "opengl", PCB_DRAW_PANEL_GAL::GAL_TYPE_OPENGL );
+
+    if( backendName == wxT( "cairo" ) || backendName == wxT( "both" ) )
+        backends.emplace_back( "cairo", PCB_DRAW_PANEL_GAL::GAL_TYPE_CAIRO );
+
+    if( backends.empty() || cl_parser.GetParamCount() == 0 )
+    {
+        cl_parser.Usage();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    // A fixed canvas size keeps the results comparable between runs
+    GAL_BENCHMARK_FRAME* frame = new GAL_BENCHMARK_FRAME( wxSize( 1600, 1000 ) );
+
+    KIGFX::FRAME_PROFILER::Get().SetEnabled( true );
+
+    json report = { { "frames", frames }, { "boards", json::object() } };
+    int  retCode = KI_TEST::RET_CODES::OK;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxString filename = cl_parser.GetParam( ii );
+        BOARD*   board = frame->LoadAndDisplayBoard( filename.ToStdString() );
+
+        if( !board )
+        {
+            std::cerr << "Unable to load " << filename << std::endl;
+            retCode = GAL_BENCHMARK_RET_CODES::LOAD_FAILED;
+            continue;
+        }
+
+        frame->SetBoard( std::shared_ptr<BOARD>( board ) );
+
+        json boardReport = json::object();
+
+        for( const auto& [name, type] : backends )
+        {
+            PCB_DRAW_PANEL_GAL* panel = frame->GetPanel().get();
+
+            if( !panel->SwitchBackend( type ) || panel->GetBackend() != type )
+            {
+                std::cerr << "Unable to use the " << name << " backend" << std::endl;
+                continue;
+            }
+
+            panel->StartDrawing();
+
+            bool drawFailed = false;
+            json result = { { "scenarios", benchmarkBoard( frame, board, frames, drawFailed ) },
+                            { "swap_interval", panel->GetGAL()->GetSwapInterval() } };
+
+            if( std::optional<int> gpuMemory = frame->GetUsedGpuMemory() )
+                result["gpu_memory_used_kb"] = *gpuMemory;
+
+            if( drawFailed )
+            {
+                std::cerr << "Unable to draw " << filename << " with " << name << std::endl;
+                retCode = GAL_BENCHMARK_RET_CODES::DRAW_FAILED;
+            }
+
+            boardReport[name] = result;
+        }
+
+        report["boards"][filename.ToStdString()] = boardReport;
+    }
+
+    std::string text = report.dump( 2 );
+
+    if( outputFile.IsEmpty() )
+    {
+        std::cout << text << std::endl;
+    }
+    else
+    {
+        std::ofstream out( outputFile.ToStdString() );
+
+        if( !out.is_open() || !( out << text << std::endl ) )
+        {
+            std::cerr << "Unable to write " << outputFile << std::endl;
+            retCode = GAL_BENCHMARK_RET_CODES::WRITE_FAILED;
+        }
+    }
+
+    // Closing the only window ends the application
+    frame->Destroy();
+
+    return retCode;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "gal_benchmark",
+        "Benchmark the GAL backends on reference boards",
+        gal_benchmark_main_func,
+} );
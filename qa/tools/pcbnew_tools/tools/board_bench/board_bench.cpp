@@ -0,0 +1,323 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file board_bench.cpp
+ *
+ * Runs the board side of a project end to end without an editor frame and reports the wall
+ * time, peak RSS and breakdown of each stage as JSON, optionally compared with a baseline.
+ *
+ * The stages use the same code as kicad-cli: the board is loaded by the scripting helper,
+ * zones are filled and DRC is run as the DRC job does, and the Gerber and STEP exports go
+ * through PCBNEW_JOBS_HANDLER.  The handler loads its own copy of the board, so the first
+ * export stage includes that load, as a kicad-cli jobset would.
+ *
+ * The netlist update of the board editor needs its frame.  When a netlist exported from the
+ * schematic is given (see schematic_bench in qa_eeschema_tools), it is read and DRC runs the
+ * schematic parity tests against it instead, as "kicad-cli pcb drc --schematic-parity" does.
+ */
+
+#include <qa_utils/bench_report.h>
+#include <qa_utils/utility_registry.h>
+
+#include <iostream>
+#include <memory>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <board.h>
+#include <board_commit.h>
+#include <board_design_settings.h>
+#include <cli/exit_codes.h>
+#include <common.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <jobs/job_export_pcb_3d.h>
+#include <jobs/job_export_pcb_gerbers.h>
+#include <netlist_reader/netlist_reader.h>
+#include <netlist_reader/pcb_netlist.h>
+#include <pcbnew_jobs_handler.h>
+#include <python/scripting/pcbnew_scripting_helpers.h>
+#include <richio.h>
+#include <tool/tool_manager.h>
+#include <zone.h>
+#include <zone_filler.h>
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "n", "netlist", _( "schematic netlist for the parity tests (one board only)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "d", "output-dir", _( "directory of the exported files (default: temporary)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON report to this file (default: stdout)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "b", "baseline", _( "compare with the JSON report of an earlier run" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_OPTION, "t", "tolerance", _( "allowed slowdown in percent (default 10)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "m", "min-ms", _( "ignore slowdowns shorter than this (default 50)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "reference board files" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum BOARD_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    STAGE_FAILED,
+    WRITE_FAILED,
+    REGRESSION
+};
+
+
+static bool fillZones( BOARD* aBoard, KI_TEST::BENCH_REPORT::STAGE& aStage )
+{
+    // BOARD_COMMIT finds the board through a tool manager
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( aBoard, nullptr, nullptr, nullptr, nullptr );
+
+    BOARD_COMMIT       commit( &toolMgr );
+    ZONE_FILLER        filler( aBoard, &commit );
+    std::vector<ZONE*> toFill( aBoard->Zones().begin(), aBoard->Zones().end() );
+
+    if( !filler.Fill( toFill ) )
+        return false;
+
+    aStage.Split( "fill" );
+
+    commit.Push( _( "Fill Zone(s)" ), SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP | SKIP_CONNECTIVITY );
+    aBoard->BuildConnectivity();
+
+    aStage.Split( "connectivity" );
+    return true;
+}
+
+
+static bool runDrc( BOARD* aBoard, NETLIST* aNetlist, KI_TEST::BENCH_REPORT::STAGE& aStage )
+{
+    std::shared_ptr<DRC_ENGINE> drcEngine = aBoard->GetDesignSettings().m_DRCEngine;
+
+    if( !drcEngine )
+        return false;
+
+    size_t violations = 0;
+
+    drcEngine->SetSchematicNetlist( aNetlist );
+    drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer,
+                 const std::function<void( PCB_MARKER* )>& aPathGenerator )
+            {
+                violations++;
+            } );
+
+    drcEngine->RunTests( EDA_UNITS::MM, true, aNetlist != nullptr );
+    drcEngine->ClearViolationHandler();
+    drcEngine->SetSchematicNetlist( nullptr );
+
+    for( const auto& [provider, msecs] : drcEngine->GetProviderTimes() )
+        aStage.AddSplit( provider.ToStdString(), msecs );
+
+    std::cerr << aBoard->GetFileName() << ": " << violations << " DRC violations" << std::endl;
+    return true;
+}
+
+
+int board_bench_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program loads reference boards, then builds connectivity, "
+                               "fills zones, runs DRC and exports Gerbers and STEP as kicad-cli "
+                               "would, and reports the time and peak memory of each stage as "
+                               "JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    wxString netlistFile;
+    wxString outputDir = wxFileName::GetTempDir() + wxFileName::GetPathSeparator()
+                         + wxS( "kicad_board_bench" );
+    wxString outputFile;
+    wxString baselineFile;
+    long     tolerance = 10;
+    long     minMsecs = 50;
+
+    cl_parser.Found( "netlist", &netlistFile );
+    cl_parser.Found( "output-dir", &outputDir );
+    cl_parser.Found( "output", &outputFile );
+    cl_parser.Found( "baseline", &baselineFile );
+    cl_parser.Found( "tolerance", &tolerance );
+    cl_parser.Found( "min-ms", &minMsecs );
+
+    if( cl_parser.GetParamCount() == 0
+            || ( !netlistFile.IsEmpty() && cl_parser.GetParamCount() > 1 ) )
+    {
+        cl_parser.Usage();
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    KI_TEST::BENCH_REPORT report;
+    int                   retCode = KI_TEST::RET_CODES::OK;
+
+    for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+    {
+        wxString   filename = cl_parser.GetParam( ii );
+        wxFileName outputBase( outputDir, wxFileName( filename ).GetName() );
+
+        report.BeginProject( filename.ToStdString() );
+
+        std::unique_ptr<BOARD>   board;
+        std::unique_ptr<NETLIST> netlist;
+
+        if( !report.RunStage( "load",
+                              [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                              {
+                                  board.reset( LoadBoard( filename, true ) );
+                                  return board != nullptr;
+                              } ) )
+        {
+            std::cerr << "Unable to load " << filename << std::endl;
+            retCode = BOARD_BENCH_RET_CODES::LOAD_FAILED;
+            continue;
+        }
+
+        report.RunStage( "connectivity",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             return board->BuildConnectivity();
+                         } );
+
+        report.RunStage( "zone_fill",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& aStage )
+                         {
+                             return fillZones( board.get(), aStage );
+                         } );
+
+        if( !netlistFile.IsEmpty() )
+        {
+            report.RunStage( "netlist",
+                             [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                             {
+                                 try
+                                 {
+                                     netlist = std::make_unique<NETLIST>();
+
+                                     KICAD_NETLIST_READER reader( new FILE_LINE_READER( netlistFile ),
+                                                                  netlist.get() );
+                                     reader.LoadNetlist();
+                                     return true;
+                                 }
+                                 catch( const IO_ERROR& ioe )
+                                 {
+                                     std::cerr << ioe.What() << std::endl;
+                                     netlist.reset();
+                                     return false;
+                                 }
+                             } );
+        }
+
+        report.RunStage( "drc",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& aStage )
+                         {
+                             return runDrc( board.get(), netlist.get(), aStage );
+                         } );
+
+        PCBNEW_JOBS_HANDLER handler( nullptr );
+
+        report.RunStage( "gerbers",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             JOB_EXPORT_PCB_GERBERS job;
+                             job.m_filename = filename;
+                             job.m_argLayers = wxString();
+                             job.m_useBoardPlotParams = true;
+                             job.SetConfiguredOutputPath( outputBase.GetFullPath()
+                                                          + wxS( "-gerbers" )
+                                                          + wxFileName::GetPathSeparator() );
+
+                             return handler.JobExportGerbers( &job ) == CLI::EXIT_CODES::OK;
+                         } );
+
+        report.RunStage( "step",
+                         [&]( KI_TEST::BENCH_REPORT::STAGE& )
+                         {
+                             JOB_EXPORT_PCB_3D job;
+                             job.m_filename = filename;
+                             job.SetStepFormat( EXPORTER_STEP_PARAMS::FORMAT::STEP );
+                             job.m_3dparams.m_Overwrite = true;
+                             job.SetConfiguredOutputPath( outputBase.GetFullPath()
+                                                          + wxS( ".step" ) );
+
+                             return handler.JobExportStep( &job ) == CLI::EXIT_CODES::OK;
+                         } );
+    }
+
+    if( !report.AllStagesOk() && retCode == KI_TEST::RET_CODES::OK )
+        retCode = BOARD_BENCH_RET_CODES::STAGE_FAILED;
+
+    if( !report.Write( outputFile.ToStdString() ) )
+    {
+        std::cerr << "Unable to write " << outputFile << std::endl;
+        return BOARD_BENCH_RET_CODES::WRITE_FAILED;
+    }
+
+    if( !baselineFile.IsEmpty() )
+    {
+        std::optional<nlohmann::json> baseline =
+                KI_TEST::BENCH_REPORT::Read( baselineFile.ToStdString() );
+
+        if( !baseline )
+        {
+            std::cerr << "Unable to read " << baselineFile << std::endl;
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+        }
+
+        for( const std::string& regression : report.CompareTo( *baseline, tolerance / 100.0,
+                                                               minMsecs ) )
+        {
+            std::cerr << regression << std::endl;
+
+            if( retCode == KI_TEST::RET_CODES::OK )
+                retCode = BOARD_BENCH_RET_CODES::REGRESSION;
+        }
+    }
+
+    return retCode;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "board_bench",
+                                                       "Time the board stages of reference projects",
+                                                       board_bench_main_func } );
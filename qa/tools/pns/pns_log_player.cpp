@@ -26,12 +26,15 @@
 #include "pns_log_player.h"
 
 #include <pcbnew_utils/board_test_utils.h>
+#include <router/pns_stats.h>
+#include <core/profile.h>
 
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
 
-PNS_LOG_PLAYER::PNS_LOG_PLAYER()
+PNS_LOG_PLAYER::PNS_LOG_PLAYER() :
+        m_debugEnabled( true )
 {
     SetReporter( &NULL_REPORTER::GetInstance() );
 }
@@ -58,6 +61,7 @@ void PNS_LOG_PLAYER::createRouter()
 
     m_debugDecorator = new PNS_TEST_DEBUG_DECORATOR( m_reporter );
     m_debugDecorator->Clear();
+    m_debugDecorator->SetDebugEnabled( m_debugEnabled );
     m_iface->SetDebugDecorator( m_debugDecorator );
 }
 
@@ -102,6 +106,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
 
+    m_eventStats.clear();
+
     m_router->SetMode( aLog->GetMode() );
 
     for( auto evt : aLog->Events() )
@@ -128,6 +134,17 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        STATS&      stats = STATS::Get();
+        EVENT_STATS evtStats;
+
+        evtStats.m_type = evt.type;
+        evtStats.m_allocations = m_allocationCounter ? m_allocationCounter() : 0;
+        evtStats.m_branches = stats.m_branches;
+        evtStats.m_shoveIterations = stats.m_shoveIterations;
+        evtStats.m_walkaroundIterations = stats.m_walkaroundIterations;
+
+        PROF_TIMER evtTimer;
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -225,6 +242,17 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        evtTimer.Stop();
+
+        evtStats.m_micros = evtTimer.SinceStart<std::chrono::microseconds>().count();
+        evtStats.m_allocations = ( m_allocationCounter ? m_allocationCounter() : 0 )
+                                 - evtStats.m_allocations;
+        evtStats.m_branches = stats.m_branches - evtStats.m_branches;
+        evtStats.m_shoveIterations = stats.m_shoveIterations - evtStats.m_shoveIterations;
+        evtStats.m_walkaroundIterations = stats.m_walkaroundIterations
+                                          - evtStats.m_walkaroundIterations;
+        m_eventStats.push_back( evtStats );
+
         PNS::NODE* node = nullptr;
 
 #if 0
@@ -23,6 +23,7 @@
 #ifndef __PNS_LOG_PLAYER_H
 #define __PNS_LOG_PLAYER_H
 
+#include <functional>
 #include <map>
 #include <pcbnew/board.h>
 
@@ -93,6 +94,20 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    /**
+     * Cost of replaying a single log event.  Counters are the difference of the process-wide
+     * PNS::STATS across the event.
+     */
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        uint64_t                m_micros = 0;
+        uint64_t                m_allocations = 0;
+        uint64_t                m_branches = 0;
+        uint64_t                m_shoveIterations = 0;
+        uint64_t                m_walkaroundIterations = 0;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -106,6 +121,23 @@ public:
 
     void SetTimeLimit( uint64_t microseconds ) { m_timeLimitUs = microseconds; }
 
+    /**
+     * Enable or disable the debug decorator of the replayed router.  Benchmarks disable it so
+     * that the debug geometry doesn't get timed along with the routing.
+     */
+    void SetDebugEnabled( bool aEnabled ) { m_debugEnabled = aEnabled; }
+
+    /**
+     * Set a function returning the number of heap allocations made so far, which is sampled
+     * around each event.  The player itself can't count them, the executable has to.
+     */
+    void SetAllocationCounter( std::function<uint64_t()> aCounter )
+    {
+        m_allocationCounter = std::move( aCounter );
+    }
+
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
@@ -120,6 +152,10 @@ private:
     std::unique_ptr<PNS::ROUTING_SETTINGS>      m_routingSettings;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    bool      m_debugEnabled;
+
+    std::function<uint64_t()> m_allocationCounter;
+    std::vector<EVENT_STATS>  m_eventStats;
 };
 
 #endif
@@ -0,0 +1,290 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright The KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file qa_pns_benchmark_main.cpp
+ *
+ * Replays the recorded router sessions of the PNS regression corpus headless, with the debug
+ * decorator disabled, and reports per event type latency percentiles, heap allocations, NODE
+ * branches and shove/walkaround iterations as JSON.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+
+#include <wx/cmdline.h>
+#include <wx/msgout.h>
+#include <wx/textfile.h>
+
+#include <nlohmann/json.hpp>
+
+#include <qa_utils/utility_registry.h>
+#include <pcbnew_utils/board_test_utils.h>
+#include <reporter.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+using json = nlohmann::json;
+
+
+// Count every heap allocation made by the program so each event can report its own.
+static std::atomic<uint64_t> g_allocations{ 0 };
+
+
+void* operator new( std::size_t aSize )
+{
+    g_allocations.fetch_add( 1, std::memory_order_relaxed );
+
+    if( void* ptr = std::malloc( aSize ? aSize : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+/**
+ * Samples of one event type of one test case.
+ */
+struct BENCH_STATS
+{
+    void Add( const PNS_LOG_PLAYER::EVENT_STATS& aEvent )
+    {
+        m_micros.push_back( aEvent.m_micros );
+        m_allocations += aEvent.m_allocations;
+        m_branches += aEvent.m_branches;
+        m_shoveIterations += aEvent.m_shoveIterations;
+        m_walkaroundIterations += aEvent.m_walkaroundIterations;
+    }
+
+    uint64_t Percentile( double aFraction ) const
+    {
+        if( m_micros.empty() )
+            return 0;
+
+        std::vector<uint64_t> sorted = m_micros;
+        std::sort( sorted.begin(), sorted.end() );
+
+        size_t idx = std::min( sorted.size() - 1, (size_t) ( aFraction * ( sorted.size() - 1 ) + 0.5 ) );
+        return sorted[idx];
+    }
+
+    json ToJson() const
+    {
+        return { { "count", m_micros.size() },
+                 { "p50_us", Percentile( 0.5 ) },
+                 { "p90_us", Percentile( 0.9 ) },
+                 { "p99_us", Percentile( 0.99 ) },
+                 { "max_us", Percentile( 1.0 ) },
+                 { "allocations", m_allocations },
+                 { "branches", m_branches },
+                 { "shove_iterations", m_shoveIterations },
+                 { "walkaround_iterations", m_walkaroundIterations } };
+    }
+
+    std::vector<uint64_t> m_micros;
+    uint64_t              m_allocations = 0;
+    uint64_t              m_branches = 0;
+    uint64_t              m_shoveIterations = 0;
+    uint64_t              m_walkaroundIterations = 0;
+};
+
+
+static std::string eventTypeName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE:     return "route-start";
+    case PNS::LOGGER::EVT_START_DRAG:      return "drag-start";
+    case PNS::LOGGER::EVT_START_MULTIDRAG: return "multidrag-start";
+    case PNS::LOGGER::EVT_FIX:             return "fix";
+    case PNS::LOGGER::EVT_UNFIX:           return "unfix";
+    case PNS::LOGGER::EVT_MOVE:            return "move";
+    case PNS::LOGGER::EVT_ABORT:           return "abort";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:      return "toggle-via";
+    default:                               return "unknown";
+    }
+}
+
+
+static std::vector<wxString> loadTestList( const wxString& aCorpusDir )
+{
+    std::vector<wxString> names;
+    wxTextFile            fp( aCorpusDir + wxT( "/tests.lst" ) );
+
+    if( !fp.Open() )
+        return names;
+
+    for( size_t ii = 0; ii < fp.GetLineCount(); ++ii )
+    {
+        wxString line = fp.GetLine( ii );
+
+        if( !line.Trim().Trim( false ).IsEmpty() )
+            names.push_back( line );
+    }
+
+    return names;
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "n", "repeat", _( "number of replays of every test case (default 5)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON report to this file (default: stdout, after the replay output)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr,
+            _( "corpus directory containing tests.lst (default: the pns_regressions test data)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum PNS_BENCHMARK_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    WRITE_FAILED
+};
+
+
+int main( int argc, char* argv[] )
+{
+    wxInitialize( argc, argv );
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program replays recorded router sessions and reports "
+                               "latency percentiles, allocations, node branches and algorithm "
+                               "iterations per event type as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long     repeat = 5;
+    wxString outputFile;
+    wxString corpusDir = KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions" );
+
+    cl_parser.Found( "repeat", &repeat );
+    cl_parser.Found( "output", &outputFile );
+
+    if( cl_parser.GetParamCount() > 0 )
+        corpusDir = cl_parser.GetParam( 0 );
+
+    std::vector<wxString> testNames = loadTestList( corpusDir );
+
+    if( testNames.empty() )
+    {
+        std::cerr << "Unable to load a test list from " << corpusDir << std::endl;
+        return PNS_BENCHMARK_RET_CODES::LOAD_FAILED;
+    }
+
+    json report = { { "corpus", corpusDir.ToStdString() },
+                    { "repeat", repeat },
+                    { "cases", json::object() } };
+
+    int loadFailures = 0;
+
+    for( const wxString& name : testNames )
+    {
+        PNS_LOG_FILE logFile;
+
+        if( !logFile.Load( wxFileName( corpusDir + wxT( "/" ) + name + wxT( "/pns" ) ),
+                           &NULL_REPORTER::GetInstance() ) )
+        {
+            std::cerr << "Unable to load test case " << name << std::endl;
+            loadFailures++;
+            continue;
+        }
+
+        std::map<std::string, BENCH_STATS> stats;
+        BENCH_STATS                        total;
+
+        for( long ii = 0; ii < repeat; ++ii )
+        {
+            PNS_LOG_PLAYER player;
+
+            player.SetDebugEnabled( false );
+            player.SetAllocationCounter( []() { return g_allocations.load(); } );
+            player.ReplayLog( &logFile, 0 );
+
+            for( const PNS_LOG_PLAYER::EVENT_STATS& evt : player.GetEventStats() )
+            {
+                stats[eventTypeName( evt.m_type )].Add( evt );
+                total.Add( evt );
+            }
+        }
+
+        json events = json::object();
+
+        for( const auto& [type, typeStats] : stats )
+            events[type] = typeStats.ToJson();
+
+        report["cases"][name.ToStdString()] = { { "events", events },
+                                                { "total", total.ToJson() } };
+    }
+
+    std::string text = report.dump( 2 );
+
+    if( outputFile.IsEmpty() )
+    {
+        std::cout << text << std::endl;
+    }
+    else
+    {
+        std::ofstream out( outputFile.ToStdString() );
+
+        if( !out.is_open() || !( out << text << std::endl ) )
+        {
+            std::cerr << "Unable to write " << outputFile << std::endl;
+            return PNS_BENCHMARK_RET_CODES::WRITE_FAILED;
+        }
+    }
+
+    wxUninitialize();
+
+    return loadFailures ? PNS_BENCHMARK_RET_CODES::LOAD_FAILED : KI_TEST::RET_CODES::OK;
+}